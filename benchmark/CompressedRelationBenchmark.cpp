@@ -0,0 +1,340 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/strings/str_cat.h>
+
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../benchmark/infrastructure/BenchmarkMeasurementContainer.h"
+#include "global/Constants.h"
+#include "global/RuntimeParameters.h"
+#include "index/CompressedRelation.h"
+#include "index/DecompressedBlockCache.h"
+#include "index/LocatedTriples.h"
+#include "util/CancellationHandle.h"
+#include "util/ConfigManager/ConfigManager.h"
+#include "util/ConfigManager/ConfigOption.h"
+#include "util/File.h"
+#include "util/Generator.h"
+#include "util/Log.h"
+#include "util/MemorySize/MemorySize.h"
+
+using namespace std::string_literals;
+
+namespace ad_benchmark {
+
+// Micro-benchmarks for the on-disk format of the permutations: A synthetic
+// permutation is written via the `CompressedRelationWriter` for each
+// combination of the block size, the number of columns, and the zstd
+// compression level. For each of these permutations, we measure the reading
+// and decompressing of all the blocks, and full lazy scans with different
+// numbers of worker threads on top of different numbers of located triples
+// (the delta triples of SPARQL updates).
+class CompressedRelationBenchmark : public BenchmarkInterface {
+  // The values of the configuration options.
+  size_t numRows_;
+  size_t numRowsPerRelation_;
+  std::vector<std::string> blockSizes_;
+  std::vector<size_t> numColumns_;
+  std::vector<size_t> compressionLevels_;
+  std::vector<float> deltaTripleFractions_;
+  std::vector<size_t> numThreads_;
+  std::string filename_;
+
+ public:
+  CompressedRelationBenchmark() {
+    ad_utility::ConfigManager& manager = getConfigManager();
+    manager.addOption("num-rows", "The number of rows of the permutations.",
+                      &numRows_, size_t{5'000'000});
+    manager.addOption("num-rows-per-relation",
+                      "The number of rows with the same first column. Large "
+                      "relations are stored in blocks of their own, small "
+                      "relations share their blocks.",
+                      &numRowsPerRelation_, size_t{10'000});
+    manager.addOption("block-sizes",
+                      "The uncompressed sizes of a single column of a block, "
+                      "for example \"8MB\".",
+                      &blockSizes_,
+                      std::vector<std::string>{"1MB", "8MB", "32MB"});
+    auto numColumns = manager.addOption(
+        "num-columns",
+        "The numbers of columns of the permutations, including the graph "
+        "column and the payload columns (at least 4).",
+        &numColumns_, std::vector<size_t>{4, 6});
+    manager.addValidator(
+        [](const std::vector<size_t>& values) {
+          return !values.empty() && ql::ranges::all_of(values, [](size_t v) {
+            return v >= 4;
+          });
+        },
+        "The numbers of columns must be at least 4.",
+        "The option \"num-columns\" must be a non-empty list of numbers that "
+        "are at least 4.",
+        numColumns);
+    auto compressionLevels = manager.addOption(
+        "compression-levels", "The zstd compression levels of the columns.",
+        &compressionLevels_, std::vector<size_t>{1, 3, 9});
+    manager.addValidator(
+        [](const std::vector<size_t>& values) {
+          return !values.empty() && ql::ranges::all_of(values, [](size_t v) {
+            return v >= 1 && v <= 22;
+          });
+        },
+        "The zstd compression levels must be between 1 and 22.",
+        "The option \"compression-levels\" must be a non-empty list of numbers "
+        "between 1 and 22.",
+        compressionLevels);
+    auto fractions = manager.addOption(
+        "delta-triple-fractions",
+        "The numbers of inserted delta triples, as a fraction of the number "
+        "of rows.",
+        &deltaTripleFractions_, std::vector<float>{0.0f, 0.001f, 0.01f, 0.1f});
+    manager.addValidator(
+        [](const std::vector<float>& values) {
+          return ql::ranges::all_of(values, [](float v) {
+            return v >= 0.0f && v <= 1.0f;
+          });
+        },
+        "The fractions of delta triples must be between 0 and 1.",
+        "The option \"delta-triple-fractions\" must be a list of numbers "
+        "between 0 and 1.",
+        fractions);
+    auto numThreads = manager.addOption(
+        "num-threads", "The numbers of worker threads of the lazy scans.",
+        &numThreads_, std::vector<size_t>{1, 2, 4, 8});
+    manager.addValidator(
+        [](const std::vector<size_t>& values) {
+          return !values.empty() && ql::ranges::all_of(values, [](size_t v) {
+            return v > 0;
+          });
+        },
+        "The numbers of threads must be positive.",
+        "The option \"num-threads\" must be a non-empty list of positive "
+        "numbers.",
+        numThreads);
+    manager.addOption("filename",
+                      "The file to which the permutations are written (one "
+                      "after the other). It is deleted at the end.",
+                      &filename_, "compressed-relation-benchmark.permutation"s);
+  }
+
+  std::string name() const final {
+    return "Reading, decompressing, and scanning compressed relations";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    // Otherwise, all but the first reads of a block would be served from the
+    // cache, without any decompression.
+    auto& blockCache = DecompressedBlockCache::get();
+    blockCache.setMaxSize(ad_utility::MemorySize::bytes(0));
+    blockCache.clear();
+
+    std::vector<std::string> rowNames;
+    for (const auto& blockSize : blockSizes_) {
+      for (auto numColumns : numColumns_) {
+        for (auto level : compressionLevels_) {
+          rowNames.push_back(absl::StrCat("block size ", blockSize, ", ",
+                                          numColumns, " columns, level ",
+                                          level));
+        }
+      }
+    }
+    auto& overview = results.addTable(
+        "Write, read, and decompress all blocks", rowNames,
+        {"Configuration", "Write (s)", "Compressed size (MB)",
+         "Compression ratio", "Blocks", "Read and decompress (s)",
+         "Decompressed throughput (MB/s)"});
+    overview.metadata().addKeyValuePair("Rows", numRows_);
+    overview.metadata().addKeyValuePair("Rows per relation",
+                                        numRowsPerRelation_);
+
+    auto originalLevel =
+        getRuntimeParameter<&RuntimeParameters::permutationCompressionLevel_>();
+    size_t row = 0;
+    for (const auto& blockSize : blockSizes_) {
+      for (auto numColumns : numColumns_) {
+        for (auto level : compressionLevels_) {
+          benchmarkConfiguration(
+              results, overview, row, rowNames.at(row),
+              ad_utility::MemorySize::parse(blockSize), numColumns, level);
+          ++row;
+        }
+      }
+    }
+    setRuntimeParameter<&RuntimeParameters::permutationCompressionLevel_>(
+        originalLevel);
+    ad_utility::deleteFile(filename_);
+    return results;
+  }
+
+ private:
+  // Write the permutation for a single configuration, and fill the `row` of
+  // the `overview` and a table with the lazy scans for this configuration.
+  void benchmarkConfiguration(BenchmarkResults& results, ResultTable& overview,
+                              size_t row, const std::string& configuration,
+                              ad_utility::MemorySize blockSize,
+                              size_t numColumns, size_t level) const {
+    AD_LOG_INFO << "Benchmarking " << configuration << std::endl;
+    setRuntimeParameter<&RuntimeParameters::permutationCompressionLevel_>(
+        level);
+    std::vector<CompressedBlockMetadata> blocks;
+    overview.addMeasurement(row, 1, [&]() {
+      blocks = writePermutation(numColumns, blockSize);
+    });
+    double uncompressedMegabytes =
+        ad_utility::MemorySize::bytes(numRows_ * numColumns * sizeof(Id))
+            .getMegabytes();
+    double compressedMegabytes =
+        ad_utility::MemorySize::bytes(std::filesystem::file_size(filename_))
+            .getMegabytes();
+    overview.setEntry(row, 2, static_cast<float>(compressedMegabytes));
+    overview.setEntry(row, 3,
+                      static_cast<float>(uncompressedMegabytes /
+                                         compressedMegabytes));
+    overview.setEntry(row, 4, blocks.size());
+
+    CompressedRelationReader reader{ad_utility::makeUnlimitedAllocator<Id>(),
+                                    ad_utility::File{filename_, "r"}};
+    // All the columns except for the first three, which are always read.
+    CompressedRelationReader::ColumnIndices additionalColumns;
+    for (size_t i = ADDITIONAL_COLUMN_GRAPH_ID; i < numColumns; ++i) {
+      additionalColumns.push_back(i);
+    }
+    overview.addMeasurement(row, 5, [&]() {
+      size_t numRowsRead = 0;
+      for (const auto& block : blocks) {
+        numRowsRead +=
+            reader.readBlockWithoutLocatedTriples(block, additionalColumns)
+                .numRows();
+      }
+      AD_CORRECTNESS_CHECK(numRowsRead == numRows_);
+    });
+    overview.setEntry(
+        row, 6,
+        static_cast<float>(uncompressedMegabytes /
+                           overview.getEntry<float>(row, 5)));
+
+    std::vector<std::string> rowNames;
+    for (auto fraction : deltaTripleFractions_) {
+      rowNames.push_back(absl::StrCat(fraction));
+    }
+    std::vector<std::string> columnNames{"Delta triple fraction",
+                                         "Delta triples", "Locate (s)"};
+    for (auto numThreads : numThreads_) {
+      columnNames.push_back(absl::StrCat("Scan, ", numThreads, " threads (s)"));
+    }
+    auto& scans = results.addTable(absl::StrCat("Lazy scans, ", configuration),
+                                   rowNames, columnNames);
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    auto originalNumThreads =
+        getRuntimeParameter<&RuntimeParameters::lazyIndexScanNumThreads_>();
+    for (size_t i = 0; i < deltaTripleFractions_.size(); ++i) {
+      auto deltaTriples = makeDeltaTriples(deltaTripleFractions_.at(i));
+      scans.setEntry(i, 1, deltaTriples.size());
+      LocatedTriplesPerBlock locatedTriples;
+      scans.addMeasurement(i, 2, [&]() {
+        auto located = LocatedTriple::locateTriplesInPermutation(
+            deltaTriples, blocks, {0, 1, 2, 3}, true, handle);
+        locatedTriples.add(located);
+        locatedTriples.setOriginalMetadata(blocks);
+        locatedTriples.updateAugmentedMetadata();
+      });
+      const auto& augmentedBlocks = locatedTriples.getAugmentedMetadata();
+      for (size_t j = 0; j < numThreads_.size(); ++j) {
+        setRuntimeParameter<&RuntimeParameters::lazyIndexScanNumThreads_>(
+            numThreads_.at(j));
+        scans.addMeasurement(i, 3 + j, [&]() {
+          size_t numRowsRead = 0;
+          for (const auto& block : reader.lazyScan(
+                   {std::nullopt, std::nullopt, std::nullopt}, augmentedBlocks,
+                   additionalColumns, handle, locatedTriples)) {
+            numRowsRead += block.numRows();
+          }
+          AD_CORRECTNESS_CHECK(numRowsRead == numRows_ + deltaTriples.size());
+        });
+      }
+    }
+    setRuntimeParameter<&RuntimeParameters::lazyIndexScanNumThreads_>(
+        originalNumThreads);
+  }
+
+  // The `Id` of the given number, which is used for all the columns.
+  static Id makeId(size_t value) {
+    return Id::makeFromVocabIndex(VocabIndex::make(value));
+  }
+
+  // Write the permutation with `numColumns` columns and the given `blockSize`
+  // to the `filename_` and return its blocks. The first column is the index of
+  // the relation, the second column is the index of the row in the relation,
+  // the third column is a pseudo-random value (less than `numRows_`), and all
+  // the other columns (including the graph column) have few distinct values,
+  // like the graphs and the payloads of a typical permutation.
+  std::vector<CompressedBlockMetadata> writePermutation(
+      size_t numColumns, ad_utility::MemorySize blockSize) const {
+    auto generator = [this, numColumns]() -> cppcoro::generator<
+                                              IdTableStatic<0>> {
+      constexpr size_t numRowsPerInputBlock = 100'000;
+      IdTableStatic<0> buffer{numColumns,
+                              ad_utility::makeUnlimitedAllocator<Id>()};
+      std::vector<Id> row(numColumns);
+      for (size_t i = 0; i < numRows_; ++i) {
+        row[0] = makeId(i / numRowsPerRelation_);
+        row[1] = makeId(i % numRowsPerRelation_);
+        row[2] = makeId((i * 2'654'435'761) % numRows_);
+        for (size_t column = 3; column < numColumns; ++column) {
+          row[column] = makeId((i / (column * 7)) % 16);
+        }
+        buffer.push_back(row);
+        if (buffer.numRows() == numRowsPerInputBlock) {
+          co_yield buffer;
+          buffer.clear();
+        }
+      }
+      if (!buffer.empty()) {
+        co_yield buffer;
+      }
+    };
+    CompressedRelationWriter::WriterAndCallback writerAndCallback{
+        std::make_unique<CompressedRelationWriter>(
+            numColumns, ad_utility::File{filename_, "w"}, blockSize),
+        [](ql::span<const CompressedRelationMetadata>) {}};
+    return CompressedRelationWriter::createPermutation(
+               std::move(writerAndCallback),
+               ad_utility::InputRangeTypeErased{generator()},
+               qlever::KeyOrder{0, 1, 2, 3}, {})
+        .blockMetadata_;
+  }
+
+  // Create the given `fraction` of `numRows_` inserted triples that are
+  // evenly distributed over the permutation. Each of them directly follows an
+  // existing triple (same first and second column, larger third column).
+  std::vector<IdTriple<0>> makeDeltaTriples(float fraction) const {
+    std::vector<IdTriple<0>> triples;
+    if (fraction <= 0.0f) {
+      return triples;
+    }
+    auto stride = std::max(
+        size_t{1}, static_cast<size_t>(std::round(1.0 / fraction)));
+    for (size_t i = 0; i < numRows_; i += stride) {
+      triples.push_back(IdTriple<0>{
+          {makeId(i / numRowsPerRelation_), makeId(i % numRowsPerRelation_),
+           makeId(numRows_ + i), makeId((i / 21) % 16)}});
+    }
+    return triples;
+  }
+};
+
+AD_REGISTER_BENCHMARK(CompressedRelationBenchmark);
+}  // namespace ad_benchmark
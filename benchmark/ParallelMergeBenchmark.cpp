@@ -3,10 +3,12 @@
 //
 
 #include <cmath>
+#include <queue>
 
 #include "../benchmark/infrastructure/Benchmark.h"
 #include "../test/util/IdTableHelpers.h"
 #include "util/Log.h"
+#include "util/LoserTree.h"
 #include "util/ParallelMultiwayMerge.h"
 
 namespace ad_benchmark {
@@ -48,6 +50,45 @@ class IdTableCompressedWriterBenchmark : public BenchmarkInterface {
     };
 
     results.addMeasurement("simple merge", run);
+
+    // Compare the sequential k-way merge of a `LoserTree` to the one of a
+    // binary heap for a moderate number of inputs, as they occur e.g. in the
+    // merge phase of the external sorter.
+    constexpr size_t numInputsSequential = 256;
+    std::vector<std::vector<size_t>> fewerInputs(
+        inputs.begin(), inputs.begin() + numInputsSequential);
+    auto runLoserTree = [&fewerInputs]() {
+      auto tree = ad_utility::makeLoserTree(fewerInputs, std::less<>{});
+      size_t result{};
+      while (!tree.empty()) {
+        result += tree.top();
+        tree.pop();
+      }
+      AD_LOG_INFO << "result was " << result << std::endl;
+    };
+    auto runHeap = [&fewerInputs]() {
+      using It = std::vector<size_t>::const_iterator;
+      using P = std::pair<It, It>;
+      auto greater = [](const P& a, const P& b) { return *a.first > *b.first; };
+      std::priority_queue<P, std::vector<P>, decltype(greater)> heap{greater};
+      for (const auto& input : fewerInputs) {
+        if (!input.empty()) {
+          heap.emplace(input.begin(), input.end());
+        }
+      }
+      size_t result{};
+      while (!heap.empty()) {
+        auto [it, end] = heap.top();
+        heap.pop();
+        result += *it;
+        if (++it != end) {
+          heap.emplace(it, end);
+        }
+      }
+      AD_LOG_INFO << "result was " << result << std::endl;
+    };
+    results.addMeasurement("loser tree merge of 256 inputs", runLoserTree);
+    results.addMeasurement("binary heap merge of 256 inputs", runHeap);
     return results;
   }
 };
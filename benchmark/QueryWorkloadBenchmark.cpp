@@ -0,0 +1,297 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../benchmark/infrastructure/BenchmarkMeasurementContainer.h"
+#include "global/RuntimeParameters.h"
+#include "libqlever/Qlever.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/ConfigManager/ConfigManager.h"
+#include "util/ConfigManager/ConfigOption.h"
+#include "util/File.h"
+#include "util/Log.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+#include "util/Timer.h"
+
+using namespace std::string_literals;
+
+namespace ad_benchmark {
+
+// An end-to-end benchmark of the query processing: An index is built via
+// `libqlever` (either for a given Turtle file, or for a synthetic dataset),
+// and a mix of queries is then executed by several concurrent clients. For
+// each number of clients, the throughput, the percentiles of the latencies,
+// and the peak memory usage of the query processing are reported, s.t. the
+// JSON output (see `--json`) can be used to track performance regressions.
+class QueryWorkloadBenchmark : public BenchmarkInterface {
+  // The values of the configuration options.
+  std::string inputFile_;
+  std::string indexBasename_;
+  size_t numSyntheticSubjects_;
+  std::string queryFile_;
+  std::vector<size_t> numClients_;
+  size_t numQueriesPerClient_;
+  std::string memoryLimit_;
+  bool disableCaching_;
+
+  struct Query {
+    std::string name_;
+    std::string query_;
+  };
+
+  // The latencies of all the executed queries of one run.
+  struct RunStatistics {
+    std::vector<double> latenciesInSeconds_;
+    size_t numFailed_ = 0;
+    double wallTimeInSeconds_ = 0;
+    ad_utility::MemorySize peakMemoryUsage_;
+  };
+
+ public:
+  QueryWorkloadBenchmark() {
+    ad_utility::ConfigManager& manager = getConfigManager();
+    manager.addOption("input-file",
+                      "The Turtle file for which the index is built. If "
+                      "empty, a synthetic dataset is generated.",
+                      &inputFile_, ""s);
+    manager.addOption("index-basename",
+                      "The basename of the files of the index (and of the "
+                      "synthetic dataset).",
+                      &indexBasename_, "query-workload-benchmark"s);
+    manager.addOption("num-synthetic-subjects",
+                      "The number of subjects of the synthetic dataset, each "
+                      "of which has five triples.",
+                      &numSyntheticSubjects_, size_t{100'000});
+    manager.addOption("query-file",
+                      "A file with one query per line, optionally preceded by "
+                      "a name and a tab (the format of `misc/query-sets`). If "
+                      "empty, a mix of queries for the synthetic dataset is "
+                      "used.",
+                      &queryFile_, ""s);
+    auto numClients = manager.addOption(
+        "num-clients",
+        "The numbers of concurrent clients, one run of the workload each.",
+        &numClients_, std::vector<size_t>{1, 2, 4, 8});
+    manager.addValidator(
+        [](const std::vector<size_t>& values) {
+          return !values.empty() && ql::ranges::all_of(values, [](size_t v) {
+            return v > 0;
+          });
+        },
+        "The numbers of clients must be positive.",
+        "The option \"num-clients\" must be a non-empty list of positive "
+        "numbers.",
+        numClients);
+    manager.addOption("num-queries-per-client",
+                      "The number of queries that each client executes in a "
+                      "run, cycling through the query mix.",
+                      &numQueriesPerClient_, size_t{20});
+    manager.addOption("memory-limit",
+                      "The memory limit for the index building and the "
+                      "query processing.",
+                      &memoryLimit_, "4GB"s);
+    manager.addOption("disable-caching",
+                      "Disable the query result cache, s.t. repeated queries "
+                      "are computed again.",
+                      &disableCaching_, true);
+  }
+
+  std::string name() const final { return "End-to-end query workload"; }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    auto memoryLimit = ad_utility::MemorySize::parse(memoryLimit_);
+    setRuntimeParameter<&RuntimeParameters::disableCaching_>(disableCaching_);
+
+    qlever::IndexBuilderConfig config;
+    config.baseName_ = indexBasename_;
+    config.memoryLimit_ = memoryLimit;
+    std::string inputFile = inputFile_;
+    if (inputFile.empty()) {
+      inputFile = absl::StrCat(indexBasename_, ".ttl");
+      results.addMeasurement("Generate the synthetic dataset",
+                             [this, &inputFile]() {
+                               writeSyntheticDataset(inputFile);
+                             });
+    }
+    config.inputFiles_.push_back(
+        {inputFile, qlever::Filetype::Turtle, std::nullopt});
+    results.addMeasurement("Build the index", [&config]() {
+      qlever::Qlever::buildIndex(config);
+    });
+
+    std::optional<qlever::Qlever> engine;
+    results.addMeasurement("Load the index", [&engine, &config]() {
+      engine.emplace(qlever::EngineConfig{config});
+    });
+
+    auto queries = queryFile_.empty() ? syntheticQueries() : readQueries();
+    std::vector<std::string> rowNames;
+    for (auto numClients : numClients_) {
+      rowNames.push_back(absl::StrCat(numClients, " clients"));
+    }
+    auto& table = results.addTable(
+        "Query workload", rowNames,
+        {"Clients", "Queries", "Failed", "Throughput (queries/s)",
+         "p50 latency (s)", "p99 latency (s)", "Max latency (s)",
+         "Peak memory (MB)"});
+    table.metadata().addKeyValuePair("Number of distinct queries",
+                                     queries.size());
+    table.metadata().addKeyValuePair("Queries per client",
+                                     numQueriesPerClient_);
+    for (size_t row = 0; row < numClients_.size(); ++row) {
+      auto statistics = runWorkload(engine.value(), queries, numClients_[row]);
+      auto& latencies = statistics.latenciesInSeconds_;
+      ql::ranges::sort(latencies);
+      size_t numQueries = latencies.size() + statistics.numFailed_;
+      table.setEntry(row, 1, numQueries);
+      table.setEntry(row, 2, statistics.numFailed_);
+      table.setEntry(row, 3,
+                     static_cast<float>(static_cast<double>(numQueries) /
+                                        statistics.wallTimeInSeconds_));
+      table.setEntry(row, 4, static_cast<float>(percentile(latencies, 0.5)));
+      table.setEntry(row, 5, static_cast<float>(percentile(latencies, 0.99)));
+      table.setEntry(row, 6, static_cast<float>(percentile(latencies, 1.0)));
+      table.setEntry(row, 7,
+                     static_cast<float>(
+                         statistics.peakMemoryUsage_.getMegabytes()));
+    }
+    return results;
+  }
+
+ private:
+  // The value at the given `fraction` of the sorted `values` (nearest rank),
+  // zero if there are no values.
+  static double percentile(const std::vector<double>& values,
+                           double fraction) {
+    if (values.empty()) {
+      return 0.0;
+    }
+    auto rank = static_cast<size_t>(
+        std::ceil(fraction * static_cast<double>(values.size())));
+    return values.at(std::clamp<size_t>(rank, 1, values.size()) - 1);
+  }
+
+  // Execute `numQueriesPerClient_` queries of the `queries` in each of
+  // `numClients` concurrent threads. The clients start at different positions
+  // of the query mix, s.t. different queries run at the same time.
+  RunStatistics runWorkload(qlever::Qlever& engine,
+                            const std::vector<Query>& queries,
+                            size_t numClients) const {
+    AD_LOG_INFO << "Running the workload with " << numClients << " clients"
+                << std::endl;
+    ad_utility::Synchronized<RunStatistics> statistics;
+    ad_utility::PeakMemoryUsageMeasurement peakMemoryUsage{
+        engine.allocator().getMemoryLeft()};
+    ad_utility::Timer wallTime{ad_utility::Timer::Started};
+    std::vector<std::thread> clients;
+    for (size_t client = 0; client < numClients; ++client) {
+      clients.emplace_back([this, &engine, &queries, &statistics, client]() {
+        for (size_t i = 0; i < numQueriesPerClient_; ++i) {
+          const auto& query = queries.at((client + i) % queries.size());
+          ad_utility::Timer timer{ad_utility::Timer::Started};
+          try {
+            engine.query(query.query_);
+            auto seconds = ad_utility::Timer::toSeconds(timer.value());
+            statistics.wlock()->latenciesInSeconds_.push_back(seconds);
+          } catch (const std::exception& e) {
+            AD_LOG_WARN << "Query \"" << query.name_
+                        << "\" failed: " << e.what() << std::endl;
+            ++statistics.wlock()->numFailed_;
+          }
+        }
+      });
+    }
+    for (auto& client : clients) {
+      client.join();
+    }
+    auto result = std::move(*statistics.wlock());
+    result.wallTimeInSeconds_ = ad_utility::Timer::toSeconds(wallTime.value());
+    result.peakMemoryUsage_ = peakMemoryUsage.stop();
+    return result;
+  }
+
+  // Write a dataset with `numSyntheticSubjects_` subjects, each with a class
+  // (out of ten), an integer value (out of 1000), a name, and two edges to
+  // pseudo-random other subjects.
+  void writeSyntheticDataset(const std::string& filename) const {
+    auto file = ad_utility::makeOfstream(filename);
+    file << "@prefix ex: <http://example.org/> .\n";
+    size_t n = numSyntheticSubjects_;
+    for (size_t i = 0; i < n; ++i) {
+      file << "ex:s" << i << " ex:type ex:class" << i % 10 << " ; ex:value "
+           << i % 1000 << " ; ex:name \"name " << i << "\" ; ex:knows ex:s"
+           << (i * 7919 + 1) % n << " , ex:s" << (i * 104729 + 3) % n
+           << " .\n";
+    }
+  }
+
+  // A mix of typical queries for the synthetic dataset: scans, joins,
+  // aggregations, filters, and sorting.
+  static std::vector<Query> syntheticQueries() {
+    std::string prefix = "PREFIX ex: <http://example.org/> ";
+    auto makeQuery = [&prefix](std::string name, std::string_view body) {
+      return Query{std::move(name), absl::StrCat(prefix, body)};
+    };
+    return {
+        makeQuery("scan", "SELECT ?s ?o WHERE { ?s ex:knows ?o }"),
+        makeQuery("join",
+                  "SELECT ?s ?name WHERE { ?s ex:type ex:class3 . "
+                  "?s ex:name ?name }"),
+        makeQuery("two-hop-count",
+                  "SELECT (COUNT(*) AS ?count) WHERE { ?a ex:knows ?b . "
+                  "?b ex:knows ?c }"),
+        makeQuery("group-by",
+                  "SELECT ?class (COUNT(?s) AS ?count) (AVG(?v) AS ?avg) "
+                  "WHERE { ?s ex:type ?class . ?s ex:value ?v } "
+                  "GROUP BY ?class"),
+        makeQuery("filter-order-by",
+                  "SELECT ?s ?v WHERE { ?s ex:value ?v FILTER(?v < 100) } "
+                  "ORDER BY DESC(?v) LIMIT 100"),
+        makeQuery("regex-filter",
+                  "SELECT ?s WHERE { ?s ex:name ?name "
+                  "FILTER(REGEX(?name, \"^name 12\")) }"),
+    };
+  }
+
+  // Read the queries from the `queryFile_`, see the description of the
+  // corresponding option.
+  std::vector<Query> readQueries() const {
+    std::vector<Query> queries;
+    auto file = ad_utility::makeIfstream(queryFile_);
+    std::string line;
+    while (std::getline(file, line)) {
+      if (line.empty()) {
+        continue;
+      }
+      auto tab = line.find('\t');
+      if (tab == std::string::npos) {
+        queries.push_back({absl::StrCat("query-", queries.size()), line});
+      } else {
+        queries.push_back({line.substr(0, tab), line.substr(tab + 1)});
+      }
+    }
+    AD_CONTRACT_CHECK(!queries.empty(), "The query file \"", queryFile_,
+                      "\" contains no queries.");
+    return queries;
+  }
+};
+
+AD_REGISTER_BENCHMARK(QueryWorkloadBenchmark);
+}  // namespace ad_benchmark
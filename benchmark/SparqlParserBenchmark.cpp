@@ -0,0 +1,66 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "index/EncodedIriManager.h"
+#include "parser/SparqlParserHelpers.h"
+#include "util/BlankNodeManager.h"
+#include "util/Log.h"
+
+namespace ad_benchmark {
+
+// Compare the parsing of typical small queries (as they are e.g. sent by an
+// autocompletion) with and without the `SLL` stage of the parser.
+class SparqlParserBenchmark : public BenchmarkInterface {
+  std::string name() const final {
+    return "Benchmarks for the SPARQL parser with and without the SLL stage";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    constexpr size_t numRepetitions = 1'000;
+    const std::vector<std::string> queries{
+        "SELECT ?x WHERE { ?x <http://example.org/p> <http://example.org/o> }",
+        "PREFIX wdt: <http://www.wikidata.org/prop/direct/> "
+        "PREFIX rdfs: <http://www.w3.org/2000/01/rdf-schema#> "
+        "SELECT ?x ?label WHERE { ?x wdt:P31 ?type . ?x rdfs:label ?label . "
+        "FILTER(STRSTARTS(?label, \"Frei\")) OPTIONAL { ?x wdt:P18 ?image } } "
+        "ORDER BY DESC(?label) LIMIT 10",
+        "SELECT ?x ?y WHERE { VALUES ?x { <a> <b> <c> } ?x <p> ?y . "
+        "FILTER(?y > 42 && ?y < 100) } LIMIT 100 OFFSET 20"};
+
+    EncodedIriManager encodedIriManager;
+    auto run = [&queries, &encodedIriManager](bool trySllPredictionFirst) {
+      size_t numChildren = 0;
+      for (size_t i = 0; i < numRepetitions; ++i) {
+        for (const auto& query : queries) {
+          ad_utility::BlankNodeManager blankNodeManager;
+          sparqlParserHelpers::ParserAndVisitor p{&blankNodeManager,
+                                                  &encodedIriManager, query};
+          p.trySllPredictionFirst_ = trySllPredictionFirst;
+          numChildren += p.parseTypesafe(&SparqlAutomaticParser::query)
+                             .resultOfParse_.children()
+                             .size();
+        }
+      }
+      AD_LOG_INFO << "Number of parsed graph patterns: " << numChildren
+                  << std::endl;
+    };
+
+    BenchmarkResults results{};
+    results.addMeasurement("LL prediction only", [&run]() { run(false); });
+    results.addMeasurement("SLL prediction with LL fallback",
+                           [&run]() { run(true); });
+    return results;
+  }
+};
+AD_REGISTER_BENCHMARK(SparqlParserBenchmark);
+}  // namespace ad_benchmark
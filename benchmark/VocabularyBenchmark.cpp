@@ -0,0 +1,375 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/strings/str_cat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../benchmark/infrastructure/BenchmarkMeasurementContainer.h"
+#include "backports/StartsWithAndEndsWith.h"
+#include "index/vocabulary/CompressedVocabulary.h"
+#include "index/vocabulary/CompressionWrappers.h"
+#include "index/vocabulary/PolymorphicVocabulary.h"
+#include "index/vocabulary/VocabularyInMemory.h"
+#include "index/vocabulary/VocabularyType.h"
+#include "index/vocabulary/VocabularyTypes.h"
+#include "util/ConfigManager/ConfigManager.h"
+#include "util/ConfigManager/ConfigOption.h"
+#include "util/File.h"
+#include "util/Log.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Timer.h"
+
+using namespace std::string_literals;
+
+namespace ad_benchmark {
+
+// Benchmarks for all the vocabulary implementations: For each
+// `VocabularyType` (via the `PolymorphicVocabulary`, as in the index), and for
+// the in-memory `CompressedVocabulary` with the alternative compression
+// wrappers, a vocabulary is built from the same words, and the time and memory
+// of the build and of the typical accesses (random lookups by index,
+// `lower_bound` and `upper_bound` for words and prefixes, and sequential
+// iteration) are measured.
+class VocabularyBenchmark : public BenchmarkInterface {
+  // The values of the configuration options.
+  std::string wordFile_;
+  size_t numSyntheticWords_;
+  size_t numLookups_;
+  std::string basename_;
+
+  // The (sorted and unique) words, and the random inputs of the lookups, which
+  // are the same for all the vocabularies.
+  struct Inputs {
+    std::vector<std::string> words_;
+    std::vector<uint64_t> randomIndices_;
+    std::vector<std::string> randomWords_;
+    std::vector<std::string> randomPrefixes_;
+  };
+
+ public:
+  VocabularyBenchmark() {
+    ad_utility::ConfigManager& manager = getConfigManager();
+    manager.addOption("word-file",
+                      "A file with one word per line (for example IRIs and "
+                      "literals from a real dataset, in any order). If empty, "
+                      "synthetic words with a distribution similar to the one "
+                      "of Wikidata are used.",
+                      &wordFile_, ""s);
+    manager.addOption("num-synthetic-words",
+                      "The number of synthetic words (before the removal of "
+                      "duplicates).",
+                      &numSyntheticWords_, size_t{2'000'000});
+    manager.addOption("num-lookups",
+                      "The number of random lookups of each kind.",
+                      &numLookups_, size_t{100'000});
+    manager.addOption("basename",
+                      "The prefix of the names of the vocabulary files, which "
+                      "are deleted after each vocabulary.",
+                      &basename_, "vocabulary-benchmark"s);
+  }
+
+  std::string name() const final {
+    return "Lookups and scans for all the vocabulary implementations";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    auto inputs = makeInputs();
+
+    using ad_utility::VocabularyType;
+    std::vector<std::string> rowNames;
+    for (auto type : VocabularyType::all()) {
+      rowNames.emplace_back(type.toString());
+    }
+    rowNames.emplace_back("in-memory-compressed (FSST)");
+    rowNames.emplace_back("in-memory-compressed (prefix)");
+    auto& table = results.addTable(
+        "Vocabularies", rowNames,
+        {"Vocabulary", "Build (s)", "Size on disk (MB)", "Open (s)",
+         "Memory after open (MB)", "operator[] (ns)", "lower_bound (ns)",
+         "upper_bound (ns)", "Prefix range (ns)",
+         "Sequential lookup (ns per word)"});
+    table.metadata().addKeyValuePair("Words", inputs.words_.size());
+    table.metadata().addKeyValuePair("Lookups", numLookups_);
+
+    size_t row = 0;
+    for (auto type : VocabularyType::all()) {
+      benchmarkVocabulary<PolymorphicVocabulary>(
+          table, row++, inputs,
+          [type](const std::string& filename) {
+            return PolymorphicVocabulary::makeDiskWriterPtr(filename, type);
+          },
+          [type](PolymorphicVocabulary& vocab, const std::string& filename) {
+            vocab.open(filename, type);
+          });
+    }
+    using namespace ad_utility::vocabulary;
+    benchmarkCompressedVocabulary<
+        CompressedVocabulary<VocabularyInMemory, FsstCompressionWrapper>>(
+        table, row++, inputs);
+    benchmarkCompressedVocabulary<
+        CompressedVocabulary<VocabularyInMemory, PrefixCompressionWrapper>>(
+        table, row++, inputs);
+    return results;
+  }
+
+ private:
+  // Run `benchmarkVocabulary` for a vocabulary type with a static
+  // `makeDiskWriterPtr(filename)` and a member function `open(filename)`.
+  template <typename Vocabulary>
+  void benchmarkCompressedVocabulary(ResultTable& table, size_t row,
+                                     const Inputs& inputs) const {
+    benchmarkVocabulary<Vocabulary>(
+        table, row, inputs,
+        [](const std::string& filename) {
+          return Vocabulary::makeDiskWriterPtr(filename);
+        },
+        [](Vocabulary& vocab, const std::string& filename) {
+          vocab.open(filename);
+        });
+  }
+
+  // Build a `Vocabulary` from the `inputs` using the writer that is returned
+  // by `makeWriter`, open it via `open`, and fill the `row` of the `table`.
+  template <typename Vocabulary, typename MakeWriter, typename Open>
+  void benchmarkVocabulary(ResultTable& table, size_t row,
+                           const Inputs& inputs, const MakeWriter& makeWriter,
+                           const Open& open) const {
+    auto filename = absl::StrCat(basename_, ".", row, ".vocabulary");
+    AD_LOG_INFO << "Benchmarking the vocabulary " << row << std::endl;
+    table.addMeasurement(row, 1, [&]() {
+      auto writer = makeWriter(filename);
+      for (const auto& word : inputs.words_) {
+        (*writer)(word, false);
+      }
+      writer->finish();
+    });
+    table.setEntry(
+        row, 2,
+        static_cast<float>(
+            ad_utility::MemorySize::bytes(sizeOfFilesWithPrefix(filename))
+                .getMegabytes()));
+
+    Vocabulary vocab;
+    auto memoryBeforeOpen = residentMemoryInBytes();
+    table.addMeasurement(row, 3, [&]() { open(vocab, filename); });
+    auto memoryAfterOpen = residentMemoryInBytes();
+    table.setEntry(row, 4,
+                   static_cast<float>(
+                       ad_utility::MemorySize::bytes(
+                           memoryAfterOpen - std::min(memoryBeforeOpen,
+                                                      memoryAfterOpen))
+                           .getMegabytes()));
+    AD_CORRECTNESS_CHECK(vocab.size() == inputs.words_.size());
+
+    // The results of all the lookups are accumulated in a checksum, s.t. they
+    // can't be optimized away.
+    size_t checksum = 0;
+    auto nanosecondsPerLookup = [](const ad_utility::Timer& timer,
+                                   size_t numLookups) {
+      auto nanoseconds =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(timer.value());
+      return static_cast<float>(
+          static_cast<double>(nanoseconds.count()) /
+          static_cast<double>(std::max(numLookups, size_t{1})));
+    };
+    ad_utility::Timer timer{ad_utility::Timer::Started};
+    for (auto index : inputs.randomIndices_) {
+      checksum += vocab[index].size();
+    }
+    table.setEntry(row, 5,
+                   nanosecondsPerLookup(timer, inputs.randomIndices_.size()));
+
+    timer.start();
+    for (const auto& word : inputs.randomWords_) {
+      checksum += vocab.lower_bound(word, ql::ranges::less{})
+                      .indexOrDefault(vocab.size());
+    }
+    table.setEntry(row, 6,
+                   nanosecondsPerLookup(timer, inputs.randomWords_.size()));
+
+    timer.start();
+    for (const auto& word : inputs.randomWords_) {
+      checksum += vocab.upper_bound(word, ql::ranges::less{})
+                      .indexOrDefault(vocab.size());
+    }
+    table.setEntry(row, 7,
+                   nanosecondsPerLookup(timer, inputs.randomWords_.size()));
+
+    // The range of the words with a given prefix is `[lower_bound(prefix),
+    // lower_bound(successor of the prefix))`.
+    timer.start();
+    for (const auto& prefix : inputs.randomPrefixes_) {
+      auto successor = prefix;
+      ++successor.back();
+      auto begin = vocab.lower_bound(prefix, ql::ranges::less{})
+                       .indexOrDefault(vocab.size());
+      auto end = vocab.lower_bound(successor, ql::ranges::less{})
+                     .indexOrDefault(vocab.size());
+      AD_CORRECTNESS_CHECK(begin < end);
+      checksum += end - begin;
+    }
+    table.setEntry(row, 8,
+                   nanosecondsPerLookup(timer, inputs.randomPrefixes_.size()));
+
+    // Sequential lookups in batches, as in the export of a query result that is
+    // sorted by the vocabulary index.
+    constexpr size_t batchSize = 1000;
+    std::vector<uint64_t> batch;
+    timer.start();
+    for (size_t begin = 0; begin < vocab.size(); begin += batchSize) {
+      batch.clear();
+      for (uint64_t i = begin; i < std::min(begin + batchSize, vocab.size());
+           ++i) {
+        batch.push_back(i);
+      }
+      for (const auto& word : ad_utility::vocabulary::lookupSorted(
+               vocab, ql::span<const uint64_t>{batch})) {
+        checksum += word.size();
+      }
+    }
+    table.setEntry(row, 9, nanosecondsPerLookup(timer, vocab.size()));
+    AD_LOG_INFO << "Checksum of the lookups: " << checksum << std::endl;
+
+    // On Linux, the files of an open vocabulary can be deleted.
+    deleteFilesWithPrefix(filename);
+  }
+
+  // Read the words from the `wordFile_` or create the synthetic words, and
+  // create the random inputs for the lookups.
+  Inputs makeInputs() const {
+    Inputs inputs;
+    auto& words = inputs.words_;
+    std::mt19937_64 randomEngine{42};
+    if (wordFile_.empty()) {
+      words = makeSyntheticWords(randomEngine);
+    } else {
+      auto file = ad_utility::makeIfstream(wordFile_);
+      std::string line;
+      while (std::getline(file, line)) {
+        if (!line.empty()) {
+          words.push_back(std::move(line));
+        }
+      }
+    }
+    ql::ranges::sort(words);
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    AD_CONTRACT_CHECK(!words.empty(), "There are no words to benchmark");
+
+    std::uniform_int_distribution<uint64_t> randomIndex{0, words.size() - 1};
+    for (size_t i = 0; i < numLookups_; ++i) {
+      inputs.randomIndices_.push_back(randomIndex(randomEngine));
+      const auto& word = words.at(randomIndex(randomEngine));
+      inputs.randomWords_.push_back(word);
+      // Mostly prefixes that end at a separator (for example the namespace of
+      // an IRI, or the first digits of a Wikidata ID), some of which match
+      // many words, and some only few.
+      auto prefixLength = std::max<size_t>(
+          1, std::min(word.size(), 8 + randomIndex(randomEngine) % 32));
+      inputs.randomPrefixes_.push_back(word.substr(0, prefixLength));
+    }
+    return inputs;
+  }
+
+  // Synthetic IRIs and literals with a distribution similar to the one of
+  // Wikidata: mostly entities with numeric IDs, some properties, some IRIs of
+  // other namespaces with names, and literals with language tags.
+  std::vector<std::string> makeSyntheticWords(
+      std::mt19937_64& randomEngine) const {
+    std::vector<std::string> words;
+    words.reserve(numSyntheticWords_);
+    // Zipf-like IDs: small IDs are more frequent than large ones.
+    std::exponential_distribution<double> idDistribution{1e-7};
+    std::uniform_int_distribution<size_t> kind{0, 99};
+    for (size_t i = 0; i < numSyntheticWords_; ++i) {
+      auto id = static_cast<uint64_t>(idDistribution(randomEngine));
+      auto k = kind(randomEngine);
+      if (k < 60) {
+        words.push_back(absl::StrCat("<http://www.wikidata.org/entity/Q", id,
+                                     ">"));
+      } else if (k < 70) {
+        words.push_back(absl::StrCat(
+            "<http://www.wikidata.org/prop/direct/P", id % 12'000, ">"));
+      } else if (k < 80) {
+        words.push_back(absl::StrCat(
+            "<http://www.wikidata.org/entity/statement/Q", id, "-",
+            absl::Hex(randomEngine()), ">"));
+      } else if (k < 90) {
+        words.push_back(absl::StrCat("<http://dbpedia.org/resource/Entity_",
+                                     id, "_", absl::Hex(id * 7919), ">"));
+      } else {
+        words.push_back(absl::StrCat("\"label of item ", id, "\"@",
+                                     k % 2 == 0 ? "en" : "de"));
+      }
+    }
+    return words;
+  }
+
+  // The total size of all the files whose names start with the `prefix`
+  // (the vocabularies consist of several files).
+  static size_t sizeOfFilesWithPrefix(const std::string& prefix) {
+    size_t size = 0;
+    forEachFileWithPrefix(prefix, [&size](const std::filesystem::path& path) {
+      size += std::filesystem::file_size(path);
+    });
+    return size;
+  }
+
+  // Delete all the files whose names start with the `prefix`.
+  static void deleteFilesWithPrefix(const std::string& prefix) {
+    forEachFileWithPrefix(prefix, [](const std::filesystem::path& path) {
+      ad_utility::deleteFile(path);
+    });
+  }
+
+  // Call `function` for the path of each regular file whose name starts with
+  // the `prefix`.
+  template <typename Function>
+  static void forEachFileWithPrefix(const std::string& prefix,
+                                    const Function& function) {
+    std::filesystem::path prefixPath{prefix};
+    auto directory = prefixPath.parent_path();
+    if (directory.empty()) {
+      directory = ".";
+    }
+    auto name = prefixPath.filename().string();
+    std::vector<std::filesystem::path> paths;
+    for (const auto& entry : std::filesystem::directory_iterator{directory}) {
+      if (entry.is_regular_file() &&
+          ql::starts_with(entry.path().filename().string(), name)) {
+        paths.push_back(entry.path());
+      }
+    }
+    ql::ranges::for_each(paths, function);
+  }
+
+  // The resident set size of this process (Linux only, zero elsewhere).
+  static size_t residentMemoryInBytes() {
+    std::ifstream statm{"/proc/self/statm"};
+    size_t totalPages = 0;
+    size_t residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) {
+      return 0;
+    }
+    return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  }
+};
+
+AD_REGISTER_BENCHMARK(VocabularyBenchmark);
+}  // namespace ad_benchmark
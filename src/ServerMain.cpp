@@ -52,6 +52,11 @@ int main(int argc, char** argv) {
   unsigned short port;
   NonNegative numSimultaneousQueries = 1;
   bool noMetricsLog = false;
+  std::string warmupFile;
+  size_t warmupNumQueries = 0;
+  ad_utility::MemorySize replicationLogMaxSize;
+  std::string replicateFrom;
+  size_t replicationPollIntervalMs = 1000;
 
   ad_utility::ParameterToProgramOptionFactory optionFactory{
       &globalRuntimeParameters};
@@ -93,6 +98,13 @@ int main(int argc, char** argv) {
           .getProgramOption<&RuntimeParameters::cacheMaxSizeSingleEntry_>(),
       "Maximum size for a single cache entry. That is, "
       "results larger than this will not be cached unless pinned.");
+  add("decompressed-block-cache-max-size",
+      optionFactory.getProgramOption<
+          &RuntimeParameters::decompressedBlockCacheMaxSize_>(),
+      "Maximum memory size of the cache for decompressed blocks of the "
+      "permutations, which is shared by all queries. Note that this cache is "
+      "not part of the memory limited by --memory-max-size. A value of zero "
+      "disables the cache.");
   add("cache-max-size-lazy-result,E",
       optionFactory
           .getProgramOption<&RuntimeParameters::cacheMaxSizeLazyResult_>(),
@@ -119,6 +131,12 @@ int main(int argc, char** argv) {
       po::bool_switch(&config.onlyPsoAndPos_),
       "Only load the PSO and POS permutations. This disables queries with "
       "predicate variables.");
+  add("lazy-load-permutations",
+      po::bool_switch(&config.lazyLoadPermutations_),
+      "Load the SPO, SOP, OPS, and OSP permutations only when they are first "
+      "used by a query (or before the first update). This reduces the startup "
+      "time and the memory consumption if these permutations are rarely "
+      "used.");
   add("default-query-timeout,s",
       optionFactory
           .getProgramOption<&RuntimeParameters::defaultQueryTimeout_>(),
@@ -150,6 +168,41 @@ int main(int argc, char** argv) {
   add("persist-updates", po::bool_switch(&config.persistUpdates_),
       "If set, then SPARQL UPDATES will be persisted on disk. Otherwise they "
       "will be lost when the engine is stopped");
+  add("warmup-file", po::value<std::string>(&warmupFile),
+      "A file with queries that are replayed in the background after the "
+      "start of the server (with their results pinned to the cache) while no "
+      "other query is running. Either the metrics log of a previous run "
+      "(`<basename>.metrics-log.jsonl`) or a text file with one query per "
+      "block of lines, separated by empty lines.");
+  add("warmup-num-queries", po::value<size_t>(&warmupNumQueries),
+      "Only replay the last this many distinct queries of the `warmup-file`. "
+      "The default of zero replays all of them.");
+  add("replication-log-max-size",
+      po::value<ad_utility::MemorySize>(&replicationLogMaxSize)
+          ->default_value(ad_utility::MemorySize::bytes(0)),
+      "If not zero, keep the most recent changes of the delta triples up to "
+      "this size in memory, from where read replicas of this server (see "
+      "`--replicate-from`) fetch and apply them.");
+  add("replicate-from", po::value<std::string>(&replicateFrom),
+      "Make this server a read replica of the primary server with this URL, "
+      "which must have the same index and a replication log (see "
+      "`--replication-log-max-size`). The replica must start with the same "
+      "updates as the primary had when it was started, and rejects SPARQL "
+      "updates.");
+  add("replication-poll-interval-ms",
+      po::value<size_t>(&replicationPollIntervalMs)->default_value(1000),
+      "The interval in milliseconds in which a read replica fetches the "
+      "changes from the primary.");
+  add("persist-named-results", po::bool_switch(&config.persistNamedResults_),
+      "If set, then the results that are pinned with a name (including their "
+      "geometry indexes) are written to disk whenever they change and are "
+      "restored when the engine is started again.");
+  add("result-cache-directory",
+      po::value<std::string>(&config.resultCacheDirectory_),
+      "If set, then the results of expensive queries are additionally stored "
+      "in files in this directory (on a local disk), from where they can be "
+      "reused after they have been evicted from the cache or after a restart "
+      "of the engine. This is only used while there are no SPARQL UPDATEs.");
   add("syntax-test-mode",
       optionFactory.getProgramOption<&RuntimeParameters::syntaxTestMode_>(),
       "Make several query patterns that are syntactially valid, but otherwise "
@@ -231,6 +284,19 @@ int main(int argc, char** argv) {
   try {
     Server server(port, numSimultaneousQueries, std::move(accessToken), config,
                   noAccessCheck);
+    // Read the queries for the warm-up before the metrics log is opened, which
+    // might be the same file.
+    if (!warmupFile.empty()) {
+      server.configureCacheWarmup(warmupFile, warmupNumQueries);
+    }
+    if (replicationLogMaxSize.getBytes() > 0) {
+      server.enableReplicationLog(replicationLogMaxSize);
+    }
+    if (!replicateFrom.empty()) {
+      server.configureReplicationFrom(
+          replicateFrom,
+          std::chrono::milliseconds{replicationPollIntervalMs});
+    }
     // Per-query jsonl metrics log, written next to the index files. On by
     // default; `--no-metrics-log` opts out.
     if (!noMetricsLog) {
@@ -0,0 +1,73 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+#ifndef QLEVER_SRC_BACKPORTS_ATOMIC_SHARED_PTR_H
+#define QLEVER_SRC_BACKPORTS_ATOMIC_SHARED_PTR_H
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace ql::backports {
+
+// Backport of C++20's `std::atomic<std::shared_ptr<T>>` for C++17 and for
+// standard libraries that don't implement it yet (e.g. libc++). It is
+// implemented using the `std::atomic_load` and `std::atomic_store` overloads
+// for `std::shared_ptr`, which have been available since C++11 (but are
+// deprecated in C++20 in favor of the specialization of `std::atomic`).
+template <typename T>
+class atomic_shared_ptr {
+ private:
+  std::shared_ptr<T> ptr_;
+
+ public:
+  atomic_shared_ptr() = default;
+  explicit atomic_shared_ptr(std::shared_ptr<T> ptr) : ptr_{std::move(ptr)} {}
+
+  // Deleted copy and move operations (same as `std::atomic`).
+  atomic_shared_ptr(const atomic_shared_ptr&) = delete;
+  atomic_shared_ptr& operator=(const atomic_shared_ptr&) = delete;
+  atomic_shared_ptr(atomic_shared_ptr&&) = delete;
+  atomic_shared_ptr& operator=(atomic_shared_ptr&&) = delete;
+
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+  std::shared_ptr<T> load(
+      std::memory_order order = std::memory_order_seq_cst) const noexcept {
+    return std::atomic_load_explicit(&ptr_, order);
+  }
+
+  void store(std::shared_ptr<T> desired,
+             std::memory_order order = std::memory_order_seq_cst) noexcept {
+    std::atomic_store_explicit(&ptr_, std::move(desired), order);
+  }
+
+  std::shared_ptr<T> exchange(
+      std::shared_ptr<T> desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return std::atomic_exchange_explicit(&ptr_, std::move(desired), order);
+  }
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+};
+
+}  // namespace ql::backports
+
+namespace ql {
+#if !defined(QLEVER_CPP_17) && defined(__cpp_lib_atomic_shared_ptr)
+// In C++20 mode, use the standard specialization if it is available.
+template <typename T>
+using atomic_shared_ptr = std::atomic<std::shared_ptr<T>>;
+#else
+// Otherwise, use the backport implementation.
+using ql::backports::atomic_shared_ptr;
+#endif
+}  // namespace ql
+
+#endif  // QLEVER_SRC_BACKPORTS_ATOMIC_SHARED_PTR_H
@@ -0,0 +1,309 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#include "engine/ArrowStreamWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+
+#include "util/Exception.h"
+
+namespace qlever::arrowExport {
+
+namespace {
+
+// The constants from the Arrow format definitions (`Schema.fbs` and
+// `Message.fbs`).
+constexpr int16_t METADATA_VERSION_V5 = 4;
+constexpr uint8_t MESSAGE_HEADER_SCHEMA = 1;
+constexpr uint8_t MESSAGE_HEADER_RECORD_BATCH = 3;
+constexpr uint8_t TYPE_UTF8 = 5;
+constexpr uint32_t CONTINUATION_MARKER = 0xFFFFFFFF;
+
+// Each message and each buffer of a message body is padded to a multiple of
+// this many bytes.
+constexpr size_t ALIGNMENT = 8;
+
+constexpr size_t roundUp(size_t size, size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+template <typename T>
+void appendBytes(std::string& target, T value) {
+  target.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// A minimal builder for FlatBuffers. In contrast to the official library,
+// the buffer is written front to back: Each object is written after the
+// object that refers to it (offsets in FlatBuffers always point forward),
+// and the vtable of each table is written directly before the table.
+// Positions are always relative to the start of the buffer, which is also
+// the reference for the alignment of all the values.
+class FlatBufferBuilder {
+  std::string buffer_;
+
+ public:
+  // A scalar field or an offset field of a table. The `slot_`
+  // is the index of the field in the table definition (the two fields of a
+  // union occupy one slot each). The value of an offset field is a
+  // placeholder that has to be set via `pointOffsetToHere`.
+  struct Field {
+    uint16_t slot_;
+    uint8_t size_;
+    uint64_t value_ = 0;
+  };
+  static Field offsetField(uint16_t slot) { return {slot, 4}; }
+
+  // Create a buffer that starts with the (placeholder) offset of the root
+  // table, so the root table has to be written next.
+  FlatBufferBuilder() { add<uint32_t>(0); }
+  static constexpr size_t ROOT_OFFSET_POSITION = 0;
+
+  // Add the `value` at the next position that is aligned to its size and
+  // return that position.
+  template <typename T>
+  size_t add(T value) {
+    align(sizeof(T));
+    size_t position = buffer_.size();
+    appendBytes(buffer_, value);
+    return position;
+  }
+
+  // Let the offset at `offsetPosition` point to the current end of the
+  // buffer.
+  void pointOffsetToHere(size_t offsetPosition) {
+    auto offset = static_cast<uint32_t>(buffer_.size() - offsetPosition);
+    std::memcpy(buffer_.data() + offsetPosition, &offset, sizeof(offset));
+  }
+
+  // Write a table with the given `fields` (in this order), let the offset at
+  // `offsetPosition` point to it, and return the positions of the fields.
+  std::vector<size_t> addTable(size_t offsetPosition,
+                               std::initializer_list<Field> fields) {
+    size_t numSlots = 0;
+    for (const Field& field : fields) {
+      numSlots = std::max<size_t>(numSlots, field.slot_ + 1);
+    }
+    size_t vtablePosition = add<uint16_t>(4 + 2 * numSlots);
+    add<uint16_t>(0);
+    for (size_t i = 0; i < numSlots; ++i) {
+      add<uint16_t>(0);
+    }
+    align(4);
+    size_t tablePosition = buffer_.size();
+    pointOffsetToHere(offsetPosition);
+    add<int32_t>(static_cast<int32_t>(tablePosition - vtablePosition));
+    std::vector<size_t> positions;
+    for (const Field& field : fields) {
+      size_t position = [&]() {
+        switch (field.size_) {
+          case 1:
+            return add(static_cast<uint8_t>(field.value_));
+          case 2:
+            return add(static_cast<uint16_t>(field.value_));
+          case 4:
+            return add(static_cast<uint32_t>(field.value_));
+          default:
+            AD_CORRECTNESS_CHECK(field.size_ == 8);
+            return add(field.value_);
+        }
+      }();
+      patch<uint16_t>(vtablePosition + 4 + 2 * field.slot_,
+                      position - tablePosition);
+      positions.push_back(position);
+    }
+    patch<uint16_t>(vtablePosition + 2, buffer_.size() - tablePosition);
+    return positions;
+  }
+
+  // Write the length of a vector with `numElements` elements, let the offset
+  // at `offsetPosition` point to it, and return the position of the first
+  // element. The elements directly follow the length, so the length is
+  // placed such that the elements are aligned to `elementAlignment`.
+  size_t addVector(size_t offsetPosition, size_t numElements,
+                   size_t elementAlignment) {
+    align(4);
+    while ((buffer_.size() + 4) % elementAlignment != 0) {
+      buffer_.push_back('\0');
+    }
+    pointOffsetToHere(offsetPosition);
+    add<uint32_t>(static_cast<uint32_t>(numElements));
+    return buffer_.size();
+  }
+
+  // Write a vector of tables and return the positions of the offsets to the
+  // tables, which have to be written next.
+  std::vector<size_t> addVectorOfTables(size_t offsetPosition,
+                                        size_t numElements) {
+    addVector(offsetPosition, numElements, 4);
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < numElements; ++i) {
+      positions.push_back(add<uint32_t>(0));
+    }
+    return positions;
+  }
+
+  // Write a vector of structs that consist of two 64-bit integers.
+  void addVectorOfPairs(size_t offsetPosition,
+                        const std::vector<std::pair<int64_t, int64_t>>& pairs) {
+    addVector(offsetPosition, pairs.size(), 8);
+    for (const auto& [first, second] : pairs) {
+      add(first);
+      add(second);
+    }
+  }
+
+  // Write a (null-terminated) string.
+  void addString(size_t offsetPosition, std::string_view string) {
+    addVector(offsetPosition, string.size(), 1);
+    buffer_.append(string);
+    buffer_.push_back('\0');
+  }
+
+  std::string finish() && { return std::move(buffer_); }
+
+ private:
+  void align(size_t alignment) {
+    buffer_.resize(roundUp(buffer_.size(), alignment), '\0');
+  }
+
+  template <typename T>
+  void patch(size_t position, size_t value) {
+    auto castValue = static_cast<T>(value);
+    std::memcpy(buffer_.data() + position, &castValue, sizeof(T));
+  }
+};
+
+// Write the `Message` table with the given header, the header itself has to
+// be written next, its offset is returned.
+size_t addMessage(FlatBufferBuilder& builder, uint8_t headerType,
+                  size_t bodyLength) {
+  auto positions =
+      builder.addTable(FlatBufferBuilder::ROOT_OFFSET_POSITION,
+                       {{0, 2, METADATA_VERSION_V5},
+                        {1, 1, headerType},
+                        FlatBufferBuilder::offsetField(2),
+                        {3, 8, bodyLength}});
+  return positions[2];
+}
+
+// Return the encapsulated message with the given `metadata` (a `Message`
+// FlatBuffer) and the `body`.
+std::string encapsulate(std::string metadata, std::string_view body) {
+  // The continuation marker and the length are followed by the metadata,
+  // which is padded such that the body is aligned.
+  metadata.resize(roundUp(metadata.size(), ALIGNMENT), '\0');
+  std::string result;
+  result.reserve(2 * sizeof(uint32_t) + metadata.size() + body.size());
+  appendBytes(result, CONTINUATION_MARKER);
+  appendBytes(result, static_cast<int32_t>(metadata.size()));
+  result.append(metadata);
+  result.append(body);
+  return result;
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+std::string makeSchemaMessage(const std::vector<std::string>& columnNames) {
+  FlatBufferBuilder builder;
+  size_t schemaOffset = addMessage(builder, MESSAGE_HEADER_SCHEMA, 0);
+  // The fields of the `Schema` table: 0 = endianness (little), 1 = fields.
+  auto schema = builder.addTable(
+      schemaOffset, {{0, 2, 0}, FlatBufferBuilder::offsetField(1)});
+  auto fieldOffsets = builder.addVectorOfTables(schema[1], columnNames.size());
+  for (size_t i = 0; i < columnNames.size(); ++i) {
+    // The fields of the `Field` table: 0 = name, 1 = nullable, 2 = the type
+    // of the `type` union, 3 = type, 5 = children.
+    auto field = builder.addTable(
+        fieldOffsets[i], {FlatBufferBuilder::offsetField(0),
+                          {1, 1, 1},
+                          {2, 1, TYPE_UTF8},
+                          FlatBufferBuilder::offsetField(3),
+                          FlatBufferBuilder::offsetField(5)});
+    builder.addString(field[0], columnNames[i]);
+    // The `Utf8` table has no fields.
+    builder.addTable(field[3], {});
+    // Arrow readers require the children to be present even if they are
+    // empty.
+    builder.addVectorOfTables(field[4], 0);
+  }
+  return encapsulate(std::move(builder).finish(), {});
+}
+
+// _____________________________________________________________________________
+std::string makeEndOfStreamMarker() {
+  std::string result;
+  appendBytes(result, CONTINUATION_MARKER);
+  appendBytes(result, int32_t{0});
+  return result;
+}
+
+// _____________________________________________________________________________
+RecordBatchBuilder::RecordBatchBuilder(size_t numColumns)
+    : columns_(numColumns) {}
+
+// _____________________________________________________________________________
+void RecordBatchBuilder::addValue(std::optional<std::string_view> value) {
+  AD_CONTRACT_CHECK(nextColumn_ < columns_.size());
+  Column& column = columns_[nextColumn_];
+  if (numRows_ % 8 == 0) {
+    column.validity_.push_back(0);
+  }
+  if (value.has_value()) {
+    AD_CONTRACT_CHECK(column.data_.size() + value->size() <=
+                          MAX_BYTES_PER_COLUMN,
+                      "The values of a column of an Arrow record batch are "
+                      "too large");
+    column.validity_.back() |= static_cast<uint8_t>(1u << (numRows_ % 8));
+    column.data_.append(value.value());
+  } else {
+    ++column.nullCount_;
+  }
+  column.offsets_.push_back(static_cast<int32_t>(column.data_.size()));
+  ++nextColumn_;
+}
+
+// _____________________________________________________________________________
+void RecordBatchBuilder::finishRow() {
+  AD_CONTRACT_CHECK(nextColumn_ == columns_.size());
+  nextColumn_ = 0;
+  ++numRows_;
+}
+
+// _____________________________________________________________________________
+std::string RecordBatchBuilder::finish() const {
+  AD_CONTRACT_CHECK(nextColumn_ == 0);
+  // The body consists of three buffers per column: the validity bitmap
+  // (omitted if there are no nulls), the offsets, and the data.
+  std::string body;
+  std::vector<std::pair<int64_t, int64_t>> buffers;
+  auto addBuffer = [&body, &buffers](const void* data, size_t size) {
+    buffers.emplace_back(body.size(), size);
+    body.append(static_cast<const char*>(data), size);
+    body.resize(roundUp(body.size(), ALIGNMENT), '\0');
+  };
+  std::vector<std::pair<int64_t, int64_t>> nodes;
+  for (const Column& column : columns_) {
+    nodes.emplace_back(numRows_, column.nullCount_);
+    addBuffer(column.validity_.data(),
+              column.nullCount_ == 0 ? 0 : column.validity_.size());
+    addBuffer(column.offsets_.data(), column.offsets_.size() * sizeof(int32_t));
+    addBuffer(column.data_.data(), column.data_.size());
+  }
+
+  FlatBufferBuilder builder;
+  size_t recordBatchOffset =
+      addMessage(builder, MESSAGE_HEADER_RECORD_BATCH, body.size());
+  // The fields of the `RecordBatch` table: 0 = length, 1 = nodes, 2 = buffers.
+  auto recordBatch = builder.addTable(
+      recordBatchOffset,
+      {{0, 8, numRows_}, FlatBufferBuilder::offsetField(1),
+       FlatBufferBuilder::offsetField(2)});
+  builder.addVectorOfPairs(recordBatch[1], nodes);
+  builder.addVectorOfPairs(recordBatch[2], buffers);
+  return encapsulate(std::move(builder).finish(), body);
+}
+
+}  // namespace qlever::arrowExport
@@ -0,0 +1,74 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_ENGINE_ARROWSTREAMWRITER_H
+#define QLEVER_SRC_ENGINE_ARROWSTREAMWRITER_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A minimal writer for the Apache Arrow IPC streaming format
+// (https://arrow.apache.org/docs/format/Columnar.html#ipc-streaming-format),
+// which can be read directly (without parsing) by pandas, Polars, DuckDB, and
+// all the other Arrow-based tools. A stream consists of a schema message,
+// followed by any number of record batch messages and the end-of-stream
+// marker. The (FlatBuffers-encoded) metadata is written by hand, so there is
+// no dependency on the Arrow libraries.
+//
+// All the columns are nullable `Utf8` columns. The streams are written in
+// little-endian byte order (the byte order of all the platforms that QLever
+// runs on).
+namespace qlever::arrowExport {
+
+// Return the schema message for columns with the given names.
+std::string makeSchemaMessage(const std::vector<std::string>& columnNames);
+
+// Return the end-of-stream marker, which has to be the last message.
+std::string makeEndOfStreamMarker();
+
+// Collect the values of a record batch row by row and serialize them as a
+// record batch message.
+class RecordBatchBuilder {
+ public:
+  // The maximal number of bytes of the strings of a single column of a record
+  // batch (the `Utf8` type uses 32-bit offsets).
+  static constexpr size_t MAX_BYTES_PER_COLUMN = (size_t{1} << 31) - 1;
+
+ private:
+  struct Column {
+    // The validity bitmap, bit `i` is set iff the value of row `i` is not
+    // null.
+    std::vector<uint8_t> validity_;
+    // The offsets of the values in `data_`, the first entry is always zero.
+    std::vector<int32_t> offsets_{0};
+    std::string data_;
+    size_t nullCount_ = 0;
+  };
+  std::vector<Column> columns_;
+  size_t numRows_ = 0;
+  // The column to which the next value is added.
+  size_t nextColumn_ = 0;
+
+ public:
+  explicit RecordBatchBuilder(size_t numColumns);
+
+  // Add the value of the next column of the current row, `std::nullopt` is
+  // exported as null.
+  void addValue(std::optional<std::string_view> value);
+
+  // Complete the current row, the values of all columns must have been added.
+  void finishRow();
+
+  size_t numRows() const { return numRows_; }
+
+  // Return the record batch message with all the rows that have been
+  // completed so far. The current row must not have any values.
+  std::string finish() const;
+};
+
+}  // namespace qlever::arrowExport
+
+#endif  // QLEVER_SRC_ENGINE_ARROWSTREAMWRITER_H
@@ -0,0 +1,275 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/BinaryExport.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <cstring>
+#include <limits>
+
+#include "engine/StringMapping.h"
+#include "util/Exception.h"
+
+namespace qlever::binary_export {
+
+namespace {
+// Append the `value` in little-endian byte order (the byte order of all the
+// platforms that QLever runs on).
+void appendInt(std::string& target, uint64_t value) {
+  char bytes[sizeof(value)];
+  std::memcpy(bytes, &value, sizeof(value));
+  target.append(bytes, sizeof(value));
+}
+
+void appendString(std::string& target, std::string_view value) {
+  appendInt(target, value.size());
+  target.append(value);
+}
+
+[[noreturn]] void throwMalformed(std::string_view reason) {
+  throw std::runtime_error(
+      absl::StrCat("The binary QLever export is malformed: ", reason));
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::string makeHeader(const std::vector<std::string>& columnNames,
+                       bool transfersVocabIds) {
+  std::string result{MAGIC};
+  appendInt(result, transfersVocabIds ? 1 : 0);
+  appendInt(result, columnNames.size());
+  for (const auto& name : columnNames) {
+    appendString(result, name);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string makeEndMarker() {
+  std::string result;
+  appendInt(result, 0);
+  return result;
+}
+
+// _____________________________________________________________________________
+UnencodedBatch prepareBatch(
+    const Index& index, const IdTable& idTable,
+    const std::vector<std::optional<ColumnIndex>>& columns, uint64_t beginRow,
+    uint64_t endRow, bool keepVocabIds) {
+  AD_CONTRACT_CHECK(beginRow < endRow && endRow <= idTable.numRows());
+  UnencodedBatch batch;
+  batch.numRows_ = endRow - beginRow;
+  StringMapping mapping;
+  batch.ids_.reserve(batch.numRows_ * columns.size());
+  for (const auto& column : columns) {
+    for (uint64_t row = beginRow; row < endRow; ++row) {
+      Id id = column.has_value() ? idTable(row, column.value())
+                                 : Id::makeUndefined();
+      auto datatype = id.getDatatype();
+      // The blank nodes are remapped by the receiver, all other IDs that are
+      // not trivial (and not kept) refer to strings.
+      bool isKept = datatype == Datatype::BlankNodeIndex ||
+                    (keepVocabIds && datatype == Datatype::VocabIndex);
+      if (!isDatatypeTrivial(datatype) && !isKept) {
+        id = mapping.remapId(id);
+      }
+      batch.ids_.push_back(id);
+    }
+  }
+  batch.strings_ = mapping.flush(index);
+  return batch;
+}
+
+// _____________________________________________________________________________
+std::string makeBatch(IncrementalStringMapping& dictionary,
+                      UnencodedBatch batch) {
+  AD_CONTRACT_CHECK(batch.numRows_ > 0);
+  auto delta = dictionary.add(std::move(batch.strings_));
+
+  std::string result;
+  appendInt(result, batch.numRows_);
+  appendInt(result, delta.clearsDictionary_ ? 1 : 0);
+  appendInt(result, delta.newStrings_.size());
+  for (const auto& string : delta.newStrings_) {
+    appendString(result, string);
+  }
+  for (Id id : batch.ids_) {
+    if (id.getDatatype() == Datatype::LocalVocabIndex) {
+      // Same as in `StringMapping::remapId`, but with the index of the
+      // string in the dictionary.
+      id = Id::makeFromLocalVocabIndex(reinterpret_cast<::LocalVocabIndex>(
+          delta.indices_.at(stringIndex(id)) << Id::numDatatypeBits));
+    }
+    appendInt(result, id.getBits());
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string makeBatch(IncrementalStringMapping& dictionary, const Index& index,
+                      const IdTable& idTable,
+                      const std::vector<std::optional<ColumnIndex>>& columns,
+                      uint64_t beginRow, uint64_t endRow, bool keepVocabIds) {
+  return makeBatch(dictionary, prepareBatch(index, idTable, columns, beginRow,
+                                            endRow, keepVocabIds));
+}
+
+// _____________________________________________________________________________
+size_t stringIndex(Id id) {
+  AD_CONTRACT_CHECK(id.getDatatype() == Datatype::LocalVocabIndex);
+  // The inverse of the remapping in `StringMapping::remapId`.
+  return reinterpret_cast<uint64_t>(id.getLocalVocabIndex()) >>
+         Id::numDatatypeBits;
+}
+
+// _____________________________________________________________________________
+void StreamParser::addBytes(std::string_view bytes) {
+  if (isFinished_ && !bytes.empty()) {
+    throwMalformed("there are bytes after the end marker");
+  }
+  buffer_.append(bytes);
+}
+
+// _____________________________________________________________________________
+std::optional<uint64_t> StreamParser::readInt(size_t& position) const {
+  uint64_t value;
+  if (buffer_.size() - position < sizeof(value)) {
+    return std::nullopt;
+  }
+  std::memcpy(&value, buffer_.data() + position, sizeof(value));
+  position += sizeof(value);
+  return value;
+}
+
+// _____________________________________________________________________________
+std::optional<std::string_view> StreamParser::readString(
+    size_t& position) const {
+  size_t nextPosition = position;
+  auto size = readInt(nextPosition);
+  if (!size.has_value() || buffer_.size() - nextPosition < size.value()) {
+    return std::nullopt;
+  }
+  std::string_view result{buffer_.data() + nextPosition, size.value()};
+  position = nextPosition + size.value();
+  return result;
+}
+
+// _____________________________________________________________________________
+void StreamParser::consumeUntil(size_t position) {
+  position_ = position;
+  // Only erase from the buffer when a significant part of it has been parsed
+  // to avoid quadratic behavior for streams with many small parts.
+  if (position_ > buffer_.size() / 2) {
+    buffer_.erase(0, position_);
+    position_ = 0;
+  }
+}
+
+// _____________________________________________________________________________
+bool StreamParser::parseHeader() {
+  if (buffer_.size() - position_ < MAGIC.size()) {
+    return false;
+  }
+  if (std::string_view{buffer_}.substr(position_, MAGIC.size()) != MAGIC) {
+    throwMalformed("the stream doesn't start with the expected magic bytes");
+  }
+  size_t position = position_ + MAGIC.size();
+  auto transfersVocabIds = readInt(position);
+  auto numColumns = readInt(position);
+  if (!numColumns.has_value()) {
+    return false;
+  }
+  if (transfersVocabIds.value() > 1) {
+    throwMalformed(
+        "the flag for transferring the vocabulary IDs is neither 0 nor 1");
+  }
+  std::vector<std::string> columnNames;
+  for (uint64_t i = 0; i < numColumns.value(); ++i) {
+    auto name = readString(position);
+    if (!name.has_value()) {
+      return false;
+    }
+    columnNames.emplace_back(name.value());
+  }
+  transfersVocabIds_ = transfersVocabIds.value() == 1;
+  columnNames_ = std::move(columnNames);
+  consumeUntil(position);
+  return true;
+}
+
+// _____________________________________________________________________________
+std::optional<Batch> StreamParser::nextBatch() {
+  if (isFinished_ || (!columnNames_.has_value() && !parseHeader())) {
+    return std::nullopt;
+  }
+  size_t position = position_;
+  auto numRows = readInt(position);
+  if (!numRows.has_value()) {
+    return std::nullopt;
+  }
+  if (numRows.value() == 0) {
+    isFinished_ = true;
+    consumeUntil(position);
+    if (position_ != buffer_.size()) {
+      throwMalformed("there are bytes after the end marker");
+    }
+    return std::nullopt;
+  }
+  const size_t numColumns = columnNames_->size();
+  if (numColumns > 0 &&
+      numRows.value() > std::numeric_limits<uint64_t>::max() /
+                            sizeof(Id::T) / numColumns) {
+    throwMalformed("the number of rows of a batch is too large");
+  }
+
+  auto clearsDictionary = readInt(position);
+  auto numStrings = readInt(position);
+  if (!numStrings.has_value()) {
+    return std::nullopt;
+  }
+  if (clearsDictionary.value() > 1) {
+    throwMalformed("the flag for clearing the dictionary is neither 0 nor 1");
+  }
+  Batch batch;
+  batch.numRows_ = numRows.value();
+  batch.clearsDictionary_ = clearsDictionary.value() == 1;
+  for (uint64_t i = 0; i < numStrings.value(); ++i) {
+    auto string = readString(position);
+    if (!string.has_value()) {
+      return std::nullopt;
+    }
+    batch.strings_.emplace_back(string.value());
+  }
+  const size_t numIds = batch.numRows_ * numColumns;
+  if ((buffer_.size() - position) / sizeof(Id::T) < numIds) {
+    return std::nullopt;
+  }
+  const size_t dictionarySize =
+      (batch.clearsDictionary_ ? 0 : dictionarySize_) + batch.strings_.size();
+  batch.ids_.reserve(numIds);
+  for (size_t i = 0; i < numIds; ++i) {
+    Id id = Id::fromBits(readInt(position).value());
+    auto datatype = id.getDatatype();
+    if (datatype == Datatype::LocalVocabIndex) {
+      if (stringIndex(id) >= dictionarySize) {
+        throwMalformed("an ID refers to a string that doesn't exist");
+      }
+    } else if (!isDatatypeTrivial(datatype) &&
+               datatype != Datatype::BlankNodeIndex &&
+               !(transfersVocabIds_ && datatype == Datatype::VocabIndex)) {
+      throwMalformed("an ID has a datatype that can't be exchanged");
+    }
+    batch.ids_.push_back(id);
+  }
+  dictionarySize_ = dictionarySize;
+  consumeUntil(position);
+  return batch;
+}
+}  // namespace qlever::binary_export
@@ -0,0 +1,185 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_BINARYEXPORT_H
+#define QLEVER_SRC_ENGINE_BINARYEXPORT_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "engine/StringMapping.h"
+#include "engine/idTable/IdTable.h"
+#include "global/Id.h"
+
+// Forward declaration
+class Index;
+
+// The binary exchange format for query results between QLever instances
+// (media type `application/qlever-export+octet-stream`), which is e.g. used
+// for `SERVICE` requests to another QLever. It avoids the costly formatting
+// and parsing of the SPARQL JSON format: all the IDs of datatypes that are
+// `isDatatypeTrivial` (numbers, dates, booleans, ...) are transferred as is,
+// and the strings (IRIs and literals) via a dictionary that is built
+// incrementally, s.t. each string is only transferred once.
+//
+// A stream consists of the following parts, all integers are 64-bit unsigned
+// integers in little-endian byte order, all strings are prefixed with their
+// size:
+//
+// 1. The header: The `MAGIC` bytes, a flag (0 or 1) whether the IDs of the
+//    vocabulary are transferred as is (see below), the number of columns, and
+//    the names of the columns (the variables without the leading question
+//    mark).
+// 2. Any number of batches: The number of rows (which is never zero), a flag
+//    (0 or 1) whether the dictionary is cleared before this batch, the number
+//    of strings followed by the strings in their string representation (see
+//    `LiteralOrIri::toStringRepresentation`), which are appended to the
+//    dictionary, and the IDs, column by column. An ID of type
+//    `LocalVocabIndex` refers to a string of the dictionary (see
+//    `stringIndex`). The IDs of blank nodes are only unique within a single
+//    result.
+// 3. The end marker: A zero (instead of the number of rows of a batch). A
+//    stream without the end marker is incomplete, e.g. because the sender
+//    failed in the middle of the export.
+//
+// The sender clears the dictionary when it becomes too large (see
+// `IncrementalStringMapping`), so the sender and the receiver can process
+// arbitrarily large results batch by batch with bounded memory.
+//
+// If the receiver uses the same vocabulary as the sender (e.g. several QLever
+// instances that serve parts of the same dataset, but were built with the
+// same global vocabulary), it can send its index ID as the URL parameter
+// `INDEX_ID_PARAMETER`. If the ID matches the index ID of the sender, the IDs
+// of type `VocabIndex` are then transferred as is and only the strings of the
+// local vocabulary are transferred via the dictionary.
+namespace qlever::binary_export {
+
+// The first bytes of each stream, the last byte is the version of the format.
+inline constexpr std::string_view MAGIC{"QLVRBIN\x03", 8};
+
+// The URL parameter with the index ID of the receiver, see above.
+inline constexpr std::string_view INDEX_ID_PARAMETER{"qlever-index-id"};
+
+// Return the header of a stream with columns with the given names. If
+// `transfersVocabIds` is true, the IDs of the vocabulary are transferred as is.
+std::string makeHeader(const std::vector<std::string>& columnNames,
+                       bool transfersVocabIds = false);
+
+// Return the end marker, which has to be the last part of each stream.
+std::string makeEndMarker();
+
+// The rows `[beginRow, endRow)` of an `IdTable` with the strings already
+// resolved, but not yet added to the dictionary of the stream. An ID of type
+// `LocalVocabIndex` refers to a string of the `strings_` of this batch.
+struct UnencodedBatch {
+  uint64_t numRows_ = 0;
+  std::vector<std::string> strings_;
+  // The IDs column by column.
+  std::vector<Id> ids_;
+};
+
+// Return the `UnencodedBatch` for the rows `[beginRow, endRow)` of the
+// `idTable`, which must not be empty. The batch has one column for each
+// element of `columns`, which is the column of the `idTable` or
+// `std::nullopt` for a column that is undefined in all rows. If
+// `keepVocabIds` is true, the IDs of type `VocabIndex` are not resolved (this
+// has to match the header of the stream). This is the expensive part of the
+// export, and can be called concurrently for several batches.
+UnencodedBatch prepareBatch(
+    const Index& index, const IdTable& idTable,
+    const std::vector<std::optional<ColumnIndex>>& columns, uint64_t beginRow,
+    uint64_t endRow, bool keepVocabIds = false);
+
+// Return the encoded `batch`, its strings are added to the `dictionary`. The
+// batches of a stream have to be encoded in order with the same dictionary.
+std::string makeBatch(IncrementalStringMapping& dictionary,
+                      UnencodedBatch batch);
+
+// Convenience overload of the two functions above.
+std::string makeBatch(IncrementalStringMapping& dictionary, const Index& index,
+                      const IdTable& idTable,
+                      const std::vector<std::optional<ColumnIndex>>& columns,
+                      uint64_t beginRow, uint64_t endRow,
+                      bool keepVocabIds = false);
+
+// Return the index of the string in the dictionary that the `id` (which has
+// to be of type `LocalVocabIndex`) of a parsed batch refers to.
+size_t stringIndex(Id id);
+
+// A single batch of a stream.
+struct Batch {
+  size_t numRows_ = 0;
+  // If true, the dictionary has to be cleared before the `strings_` are
+  // appended to it.
+  bool clearsDictionary_ = false;
+  // The strings that are appended to the dictionary.
+  std::vector<std::string> strings_;
+  // The IDs column by column, see `operator()` for the access.
+  std::vector<Id> ids_;
+
+  Id operator()(size_t row, size_t column) const {
+    return ids_[column * numRows_ + row];
+  }
+};
+
+// Parse a stream that is received in parts of arbitrary size. The parser
+// doesn't store the dictionary, this is up to the consumer of the batches.
+class StreamParser {
+  // The bytes that have been received but not yet parsed.
+  std::string buffer_;
+  size_t position_ = 0;
+  std::optional<std::vector<std::string>> columnNames_;
+  bool transfersVocabIds_ = false;
+  bool isFinished_ = false;
+  // The number of strings in the dictionary, to validate the IDs.
+  size_t dictionarySize_ = 0;
+
+ public:
+  // Append the next part of the stream.
+  void addBytes(std::string_view bytes);
+
+  // Return the complete next batch and remove it from the buffer. Return
+  // `std::nullopt` if the next batch is incomplete (then more bytes have to be
+  // added) or if the end marker has been reached. Throw if the stream is
+  // malformed.
+  std::optional<Batch> nextBatch();
+
+  // The names of the columns, available as soon as the header has been
+  // parsed.
+  const std::optional<std::vector<std::string>>& columnNames() const {
+    return columnNames_;
+  }
+
+  // True iff the IDs of the vocabulary of the sender are transferred as is.
+  // Only valid after the header has been parsed.
+  bool transfersVocabIds() const { return transfersVocabIds_; }
+
+  // True iff the end of the stream has been parsed.
+  bool isFinished() const { return isFinished_; }
+
+ private:
+  // Parse the header if it is complete. Return false if more bytes are
+  // required.
+  bool parseHeader();
+
+  // Read an integer or a string at `position` and advance the `position`.
+  // Return `std::nullopt` (and leave the `position` as is) if the buffer is
+  // too short.
+  std::optional<uint64_t> readInt(size_t& position) const;
+  std::optional<std::string_view> readString(size_t& position) const;
+
+  // Remove the parsed bytes from the front of the buffer.
+  void consumeUntil(size_t position);
+};
+}  // namespace qlever::binary_export
+
+#endif  // QLEVER_SRC_ENGINE_BINARYEXPORT_H
@@ -7,6 +7,7 @@
 #include "engine/Bind.h"
 
 #include "engine/CallFixedSize.h"
+#include "engine/ChunkedEvaluation.h"
 #include "engine/ExistsJoin.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
@@ -54,6 +55,19 @@ void Bind::onLimitOffsetChanged(const LimitOffsetClause& limitOffset) {
   _subtree->applyLimitOffset(limitOffset);
 }
 
+// _____________________________________________________________________________
+bool Bind::addRuntimeJoinFilter(
+    const Variable& variable, std::shared_ptr<const RuntimeJoinFilter> filter) {
+  if (variable == _bind._target || !getLimitOffset().isUnconstrained() ||
+      !_subtree->getRootOperation()->addRuntimeJoinFilter(variable,
+                                                          std::move(filter))) {
+    return false;
+  }
+  disableStoringInCache();
+  return true;
+}
+
+// _____________________________________________________________________________
 float Bind::getMultiplicity(size_t col) {
   // this is the newly added column
   if (col == getResultWidth() - 1) {
@@ -127,9 +141,16 @@ Result Bind::computeResult(bool requestLaziness) {
   std::shared_ptr<const Result> subRes = _subtree->getResult(requestLaziness);
   AD_LOG_DEBUG << "Got input to Bind operation." << std::endl;
 
-  auto applyBind = [this](IdTable idTable, LocalVocab* localVocab) {
-    return computeExpressionBind(localVocab, std::move(idTable),
-                                 _bind._expression.getPimpl());
+  // Large tables are split into chunks that are evaluated concurrently (see
+  // `ChunkedEvaluation.h`).
+  auto applyBind = [this](auto&& idTable, LocalVocab* localVocab) {
+    return qlever::chunkedEvaluation::evaluateInParallelChunks(
+        AD_FWD(idTable), *localVocab,
+        [this](auto&& chunk, LocalVocab& chunkLocalVocab) {
+          return computeExpressionBind(&chunkLocalVocab,
+                                       AD_FWD(chunk).moveOrClone(),
+                                       _bind._expression.getPimpl());
+        });
   };
 
   if (subRes->isFullyMaterialized()) {
@@ -159,15 +180,19 @@ Result Bind::computeResult(bool requestLaziness) {
     // via`shared_ptr`s, so the following is also efficient if the BIND adds no
     // new words.
     LocalVocab localVocab = subRes->getCopyOfLocalVocab();
-    IdTable result = applyBind(subRes->cloneIdTable(), &localVocab);
+    IdTable result = applyBind(subRes->idTable(), &localVocab);
     AD_LOG_DEBUG << "BIND result computation done." << std::endl;
     return {std::move(result), resultSortedOn(), std::move(localVocab)};
   }
 
+  // The blocks are processed independently of each other, so they can be
+  // processed concurrently.
+  auto sortedOn = resultSortedOn();
   return {
-      Result::LazyResult(ad_utility::CachingTransformInputRange(
+      transformLazyResult(
           subRes->idTables(),
-          [applyBind = std::move(applyBind)](auto& idTableAndVocab) mutable {
+          [applyBind = std::move(applyBind)](
+              Result::IdTableVocabPair& idTableAndVocab) {
             // The `LocalVocab` disallows inserts if it doesn't own its
             // `primaryWordSet` exclusively. We clone the local vocab to enforce
             // this invariant in all cases
@@ -176,18 +201,34 @@ Result Bind::computeResult(bool requestLaziness) {
                 applyBind(std::move(idTableAndVocab.idTable_), &localVocab);
             return Result::IdTableVocabPair(std::move(resultTable),
                                             std::move(localVocab));
-          })),
-      resultSortedOn()};
+          },
+          !sortedOn.empty()),
+      std::move(sortedOn)};
 }
 
 // _____________________________________________________________________________
 IdTable Bind::computeExpressionBind(
     LocalVocab* localVocab, IdTable idTable,
     const sparqlExpression::SparqlExpression* expression) const {
+  return computeExpressionBind(*getExecutionContext(),
+                               _subtree->getVariableColumns(),
+                               cancellationHandle_, deadline_, localVocab,
+                               std::move(idTable), expression);
+}
+
+// _____________________________________________________________________________
+IdTable Bind::computeExpressionBind(
+    const QueryExecutionContext& qec,
+    const VariableToColumnMap& variableColumns,
+    const ad_utility::SharedCancellationHandle& cancellationHandle,
+    std::chrono::steady_clock::time_point deadline, LocalVocab* localVocab,
+    IdTable idTable, const sparqlExpression::SparqlExpression* expression) {
   sparqlExpression::EvaluationContext evaluationContext(
-      *getExecutionContext(), _subtree->getVariableColumns(),
-      idTable.asStaticView<0>(), getExecutionContext()->getAllocator(),
-      *localVocab, cancellationHandle_, deadline_);
+      qec, variableColumns, idTable.asStaticView<0>(), qec.getAllocator(),
+      *localVocab, cancellationHandle, deadline);
+  auto checkCancellation = [&cancellationHandle]() {
+    cancellationHandle->throwIfCancelled();
+  };
 
   sparqlExpression::ExpressionResult expressionResult =
       expression->evaluate(&evaluationContext);
@@ -201,15 +242,14 @@ IdTable Bind::computeExpressionBind(
     constexpr static bool isStrongId = std::is_same_v<T, Id>;
 
     if constexpr (isVariable) {
-      auto columnIndex =
-          getInternallyVisibleVariableColumns().at(singleResult).columnIndex_;
+      auto columnIndex = variableColumns.at(singleResult).columnIndex_;
       auto inputColumn = idTable.getColumn(columnIndex);
       AD_CORRECTNESS_CHECK(inputColumn.size() == outputColumn.size());
       ad_utility::chunkedCopy(inputColumn, outputColumn.begin(), CHUNK_SIZE,
-                              [this]() { checkCancellation(); });
+                              checkCancellation);
     } else if constexpr (isStrongId) {
       ad_utility::chunkedFill(outputColumn, singleResult, CHUNK_SIZE,
-                              [this]() { checkCancellation(); });
+                              checkCancellation);
     } else {
       constexpr bool isConstant = sparqlExpression::isConstantResult<T>;
 
@@ -224,7 +264,7 @@ IdTable Bind::computeExpressionBind(
                   std::move(*it), *localVocab);
           checkCancellation();
           ad_utility::chunkedFill(outputColumn, constantId, CHUNK_SIZE,
-                                  [this]() { checkCancellation(); });
+                                  checkCancellation);
         }
       } else {
         size_t i = 0;
@@ -28,6 +28,9 @@ class Bind : public Operation {
 
  public:
   const parsedQuery::Bind& bind() const { return _bind; }
+  const std::shared_ptr<QueryExecutionTree>& getSubtree() const {
+    return _subtree;
+  }
   [[nodiscard]] std::string getDescriptor() const override;
   [[nodiscard]] size_t getResultWidth() const override;
   std::vector<QueryExecutionTree*> getChildren() override;
@@ -35,6 +38,12 @@ class Bind : public Operation {
   LimitOffsetHandling handlesLimitOffset() const override;
   void onLimitOffsetChanged(const LimitOffsetClause& limitOffset) override;
 
+  // A runtime join filter is pushed to the `_subtree`, unless it is for the
+  // variable that is bound by this operation.
+  bool addRuntimeJoinFilter(
+      const Variable& variable,
+      std::shared_ptr<const RuntimeJoinFilter> filter) override;
+
  private:
   bool canResultBeCachedImpl() const override { return isExpressionCacheable_; }
   std::unique_ptr<Operation> cloneImpl() const override;
@@ -58,6 +67,19 @@ class Bind : public Operation {
       LocalVocab* localVocab, IdTable idTable,
       const sparqlExpression::SparqlExpression* expression) const;
 
+ public:
+  // Evaluate the `expression` on the rows of the `idTable`, the columns of
+  // which are described by the `variableColumns`, and append the results as a
+  // new column. Words that are not contained in the vocabulary are added to
+  // the `localVocab`. This is also used by the `Filter`s that evaluate the
+  // `BIND`s directly below them (see `Filter.h`).
+  static IdTable computeExpressionBind(
+      const QueryExecutionContext& qec,
+      const VariableToColumnMap& variableColumns,
+      const ad_utility::SharedCancellationHandle& cancellationHandle,
+      std::chrono::steady_clock::time_point deadline, LocalVocab* localVocab,
+      IdTable idTable, const sparqlExpression::SparqlExpression* expression);
+
   [[nodiscard]] VariableToColumnMap computeVariableToColumnMap() const override;
 };
 
@@ -0,0 +1,126 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/CacheWarmup.h"
+
+#include <absl/strings/ascii.h>
+#include <absl/strings/str_join.h>
+
+#include <algorithm>
+#include <optional>
+#include <thread>
+
+#include "util/File.h"
+#include "util/HashSet.h"
+#include "util/Log.h"
+
+// _____________________________________________________________________________
+void to_json(nlohmann::json& json, const CacheWarmup::Progress& progress) {
+  json = {{"num-queries", progress.numQueries_},
+          {"num-done", progress.numDone_},
+          {"num-failed", progress.numFailed_},
+          {"finished", progress.finished_}};
+}
+
+// _____________________________________________________________________________
+CacheWarmup::CacheWarmup(std::vector<std::string> queries,
+                         ExecuteQuery executeQuery, IsIdle isIdle)
+    : queries_{std::move(queries)} {
+  AD_LOG_INFO << "Replaying " << queries_.size()
+              << " queries in the background to warm up the cache"
+              << std::endl;
+  thread_ = ad_utility::JThread{[this, executeQuery = std::move(executeQuery),
+                                 isIdle = std::move(isIdle)]() {
+    for (const auto& query : queries_) {
+      while (!stopRequested_ && !isIdle()) {
+        std::this_thread::sleep_for(idlePollInterval_);
+      }
+      if (stopRequested_) {
+        return;
+      }
+      try {
+        executeQuery(query);
+      } catch (const std::exception& e) {
+        AD_LOG_WARN << "A query of the cache warm-up failed: " << e.what()
+                    << std::endl;
+        ++numFailed_;
+      }
+      ++numDone_;
+    }
+    finished_ = true;
+    AD_LOG_INFO << "The cache warm-up is finished, " << numFailed_ << " of "
+                << queries_.size() << " queries failed" << std::endl;
+  }};
+}
+
+// _____________________________________________________________________________
+CacheWarmup::~CacheWarmup() { stopRequested_ = true; }
+
+// _____________________________________________________________________________
+auto CacheWarmup::progress() const -> Progress {
+  return {queries_.size(), numDone_, numFailed_, finished_};
+}
+
+// _____________________________________________________________________________
+std::vector<std::string> CacheWarmup::readQueries(std::istream& input,
+                                                  size_t maxNumQueries) {
+  std::vector<std::string> queries;
+  std::optional<bool> isEventLog;
+  std::vector<std::string> block;
+  auto endBlock = [&queries, &block]() {
+    if (!block.empty()) {
+      queries.push_back(absl::StrJoin(block, "\n"));
+      block.clear();
+    }
+  };
+  std::string line;
+  while (std::getline(input, line)) {
+    auto stripped = absl::StripAsciiWhitespace(line);
+    if (stripped.empty()) {
+      endBlock();
+      continue;
+    }
+    if (!isEventLog.has_value()) {
+      isEventLog = stripped.front() == '{';
+    }
+    if (!isEventLog.value()) {
+      block.push_back(line);
+      continue;
+    }
+    // Lines that are not valid JSON (e.g. the last line of a log that was
+    // truncated by a crash) are skipped.
+    auto event = nlohmann::json::parse(stripped, nullptr, false);
+    if (event.is_object() && event.value("event", "") == "start" &&
+        event.contains("query") && event["query"].is_string()) {
+      queries.push_back(event["query"].get<std::string>());
+    }
+  }
+  endBlock();
+
+  // Keep only the last occurrence of each query.
+  ad_utility::HashSet<std::string> seen;
+  std::vector<std::string> result;
+  for (auto it = queries.rbegin(); it != queries.rend(); ++it) {
+    if (seen.insert(*it).second) {
+      result.push_back(std::move(*it));
+    }
+  }
+  if (maxNumQueries != 0 && result.size() > maxNumQueries) {
+    result.resize(maxNumQueries);
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+// _____________________________________________________________________________
+std::vector<std::string> CacheWarmup::readQueries(
+    const std::filesystem::path& file, size_t maxNumQueries) {
+  auto input = ad_utility::makeIfstream(file);
+  return readQueries(input, maxNumQueries);
+}
@@ -0,0 +1,88 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_CACHEWARMUP_H
+#define QLEVER_SRC_ENGINE_CACHEWARMUP_H
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "util/jthread.h"
+#include "util/json.h"
+
+// Replay a list of queries in a background thread after the start of the
+// server, s.t. the first users don't hit a cold cache (and a cold page cache
+// of the operating system). The queries are executed one after the other, and
+// only while the server doesn't run any other query (see `isIdle`), s.t. the
+// normal traffic is accepted immediately and is not slowed down by the
+// warm-up. The results of the warm-up queries are pinned to the cache by the
+// `executeQuery` function of the `Server`.
+class CacheWarmup {
+ public:
+  // Execute a single query. Exceptions are logged and count as failed queries.
+  using ExecuteQuery = std::function<void(const std::string&)>;
+  // Return true iff a warm-up query may be executed now.
+  using IsIdle = std::function<bool()>;
+
+  // The time to wait before `isIdle` is checked again.
+  static constexpr std::chrono::milliseconds idlePollInterval_{100};
+
+  // The progress of the warm-up, reported by the `stats` command.
+  struct Progress {
+    size_t numQueries_ = 0;
+    size_t numDone_ = 0;
+    size_t numFailed_ = 0;
+    bool finished_ = false;
+
+    friend void to_json(nlohmann::json& json, const Progress& progress);
+  };
+
+ private:
+  std::vector<std::string> queries_;
+  std::atomic<size_t> numDone_ = 0;
+  std::atomic<size_t> numFailed_ = 0;
+  std::atomic<bool> finished_ = false;
+  std::atomic<bool> stopRequested_ = false;
+  // Declared last, s.t. it is joined (in the destructor) before the other
+  // members are destroyed.
+  ad_utility::JThread thread_;
+
+ public:
+  // Start replaying the `queries` in a new thread.
+  CacheWarmup(std::vector<std::string> queries, ExecuteQuery executeQuery,
+              IsIdle isIdle);
+
+  // Stop the warm-up after the currently running query and wait for it.
+  ~CacheWarmup();
+
+  CacheWarmup(const CacheWarmup&) = delete;
+  CacheWarmup& operator=(const CacheWarmup&) = delete;
+
+  Progress progress() const;
+
+  // Read the queries for the warm-up from the `input`, which is either an
+  // event log written by the `QueryEventLog` (one JSON object per line, of
+  // which the `start` events contain the queries), or a text file with one
+  // query per block of lines, separated by empty lines. The format is
+  // determined by the first non-empty line. Repeated queries are only replayed
+  // once, at the position of their last occurrence. If `maxNumQueries` is
+  // not zero, only the last `maxNumQueries` of the remaining queries are
+  // returned.
+  static std::vector<std::string> readQueries(std::istream& input,
+                                              size_t maxNumQueries);
+  static std::vector<std::string> readQueries(const std::filesystem::path& file,
+                                              size_t maxNumQueries);
+};
+
+#endif  // QLEVER_SRC_ENGINE_CACHEWARMUP_H
@@ -11,6 +11,9 @@
 #include "engine/CartesianProductJoin.h"
 
 #include "engine/CallFixedSize.h"
+#include "global/RuntimeParameters.h"
+#include "util/ParallelExecutor.h"
+#include "util/ThreadBudget.h"
 #include "util/Views.h"
 
 namespace {
@@ -234,7 +237,11 @@ CPP_template_def(typename R)(requires ql::ranges::random_access_range<R>)
         "have mistyped a variable name."};
   }
 
-  if (totalSizeIncludingLimit != 0) {
+  if (totalSizeIncludingLimit == 0) {
+    return result;
+  }
+  // Write the rows `[beginRow, endRow)` of the `result`.
+  auto writeRows = [&](size_t beginRow, size_t endRow) {
     // A `groupSize` of N means that each row of the current result is copied N
     // times adjacent to each other.
     size_t groupSize = 1;
@@ -247,13 +254,37 @@ CPP_template_def(typename R)(requires ql::ranges::random_access_range<R>)
                                ? lastTableOffset * groupSize
                                : 0;
       for (const auto& inputCol : input.getColumns()) {
-        decltype(auto) resultCol = result.getColumn(resultColIdx);
-        writeResultColumn(resultCol, inputCol, groupSize, offset - extraOffset);
+        auto resultCol = result.getColumn(resultColIdx)
+                             .subspan(beginRow, endRow - beginRow);
+        writeResultColumn(resultCol, inputCol, groupSize,
+                          offset - extraOffset + beginRow);
         ++resultColIdx;
       }
       groupSize *= input.numRows();
     }
+  };
+
+  // The rows of a large result are written by several threads, each of which
+  // writes a contiguous range of rows.
+  auto threads = ad_utility::globalThreadBudget().reserve(std::min(
+      totalSizeIncludingLimit / minNumRowsPerThread_,
+      getRuntimeParameter<&RuntimeParameters::cartesianProductNumThreads_>()));
+  const size_t numThreads = threads.numThreads();
+  if (numThreads <= 1) {
+    writeRows(0, totalSizeIncludingLimit);
+    return result;
   }
+  const size_t numRowsPerThread =
+      (totalSizeIncludingLimit + numThreads - 1) / numThreads;
+  std::vector<std::packaged_task<void()>> tasks;
+  for (size_t beginRow = 0; beginRow < totalSizeIncludingLimit;
+       beginRow += numRowsPerThread) {
+    size_t endRow =
+        std::min(beginRow + numRowsPerThread, totalSizeIncludingLimit);
+    tasks.emplace_back(
+        [&writeRows, beginRow, endRow]() { writeRows(beginRow, endRow); });
+  }
+  ad_utility::runTasksInParallel(std::move(tasks));
   return result;
 }
 
@@ -263,14 +294,19 @@ std::pair<std::vector<std::shared_ptr<const Result>>,
 CartesianProductJoin::calculateSubResults(bool requestLaziness) {
   AD_CONTRACT_CHECK(!forbiddenToRecompute_, recomputeMessage);
   std::vector<std::shared_ptr<const Result>> subResults;
-  // We don't need to fully materialize the child results if we have a LIMIT
-  // specified and an OFFSET of 0.
-  // TODO<joka921> We could in theory also apply this optimization if a
-  // non-zero OFFSET is specified, but this would make the algorithm more
-  // complicated.
-  std::optional<LimitOffsetClause> limitIfPresent = getLimitOffset();
-  if (!getLimitOffset()._limit.has_value() || getLimitOffset()._offset != 0) {
-    limitIfPresent = std::nullopt;
+  // We don't need to fully materialize the child results if we have a LIMIT.
+  // The first `LIMIT + OFFSET` rows of the product only depend on the first
+  // rows of each child (see below), so the children get a LIMIT of at most
+  // `LIMIT + OFFSET` and no OFFSET.
+  std::optional<LimitOffsetClause> limitIfPresent = std::nullopt;
+  if (const auto& limitOffset = getLimitOffset();
+      limitOffset._limit.has_value()) {
+    uint64_t limit = limitOffset._limit.value();
+    uint64_t upperBound =
+        limit > std::numeric_limits<uint64_t>::max() - limitOffset._offset
+            ? std::numeric_limits<uint64_t>::max()
+            : limit + limitOffset._offset;
+    limitIfPresent = LimitOffsetClause{upperBound};
   }
 
   std::shared_ptr<const Result> lazyResult = nullptr;
@@ -409,6 +445,11 @@ Result::LazyResult CartesianProductJoin::createLazyConsumer(
     limit -= producedTableSize;
     offset += producedTableSize;
     producedTableSize = 0;
+    // Once the LIMIT is reached, stop consuming the lazy input, s.t. it is not
+    // computed any further.
+    if (limit == 0) {
+      return Result::IdTableLoopControl::makeBreak();
+    }
 
     auto& [idTable, localVocab] = idTableVocabPair;
     // Replace the placeholder table and update the view in-place.
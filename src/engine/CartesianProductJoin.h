@@ -24,6 +24,9 @@ class CartesianProductJoin : public Operation {
  private:
   Children children_;
   size_t chunkSize_;
+  // The minimal number of rows of the result that are written by a single
+  // thread, because starting threads doesn't pay off for fewer.
+  static constexpr size_t minNumRowsPerThread_ = 1 << 16;
   // If `true` calls to `computeResult` and `cloneImpl` will result in an
   // exception. This is because this flag indicates that a limit has been
   // dynamically applied to the children of this operation and we currently have
@@ -68,7 +68,9 @@ bool isVariableContainedInGraphPatternOperation(
                                                p::TextSearchQuery,
                                                p::NamedCachedResult,
                                                p::MaterializedViewQuery,
-                                               p::ExternalValuesQuery>) {
+                                               p::ExternalValuesQuery,
+                                               p::GraphAnalyticsQuery,
+                                               p::WindowFunctionsQuery>) {
       // For `MagicServiceQuery`s disable the pattern trick. This might slow
       // things down more than necessary but is never wrong. In the future this
       // could potentially be enabled for certain magic service queries.
@@ -0,0 +1,95 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_CHUNKEDEVALUATION_H
+#define QLEVER_SRC_ENGINE_CHUNKEDEVALUATION_H
+
+#include <algorithm>
+#include <future>
+#include <vector>
+
+#include "backports/concepts.h"
+#include "engine/idTable/IdTable.h"
+#include "global/RuntimeParameters.h"
+#include "index/LocalVocab.h"
+#include "util/Forward.h"
+#include "util/ParallelExecutor.h"
+#include "util/ThreadBudget.h"
+#include "util/TypeTraits.h"
+
+namespace qlever::chunkedEvaluation {
+
+// Return the number of threads with which an expression should be evaluated
+// on `numRows` rows: At most `expression-num-threads`, and each thread gets at
+// least `expression-min-rows-per-thread` rows.
+inline size_t maxNumThreads(size_t numRows) {
+  size_t minRowsPerThread = std::max<size_t>(
+      1, getRuntimeParameter<
+             &RuntimeParameters::expressionMinRowsPerThread_>());
+  return std::min(
+      getRuntimeParameter<&RuntimeParameters::expressionNumThreads_>(),
+      numRows / minRowsPerThread);
+}
+
+// Evaluate `evaluateChunk(auto&& chunk, LocalVocab& localVocab) -> IdTable`
+// (for example, a `BIND` or a `FILTER`, which compute each row independently
+// of the others) on contiguous chunks of the rows of the `input`, using
+// multiple threads of the `globalThreadBudget()` (see `maxNumThreads`), and
+// return the concatenation of the results. Each chunk is an `IdTable&&` and
+// gets its own `LocalVocab`, all of which are merged into the `localVocab`
+// afterwards. If only a single thread is used, `evaluateChunk` is directly
+// called on the (forwarded) `input` and the `localVocab`.
+CPP_template(typename Table, typename F)(
+    requires ad_utility::SimilarTo<Table, IdTable>) IdTable
+    evaluateInParallelChunks(Table&& input, LocalVocab& localVocab,
+                             const F& evaluateChunk) {
+  size_t numRequested = maxNumThreads(input.numRows());
+  if (numRequested <= 1) {
+    return evaluateChunk(AD_FWD(input), localVocab);
+  }
+  auto threads = ad_utility::globalThreadBudget().reserve(numRequested);
+  const size_t numChunks = threads.numThreads();
+  if (numChunks <= 1) {
+    return evaluateChunk(AD_FWD(input), localVocab);
+  }
+
+  const size_t numRows = input.numRows();
+  std::vector<IdTable> results;
+  results.reserve(numChunks);
+  for (size_t i = 0; i < numChunks; ++i) {
+    results.emplace_back(input.numColumns(), input.getAllocator());
+  }
+  std::vector<LocalVocab> localVocabs(numChunks);
+  std::vector<std::packaged_task<void()>> tasks;
+  for (size_t i = 0; i < numChunks; ++i) {
+    tasks.emplace_back([&, i]() {
+      IdTable chunk{input.numColumns(), input.getAllocator()};
+      chunk.insertAtEnd(input, numRows * i / numChunks,
+                        numRows * (i + 1) / numChunks);
+      results[i] = evaluateChunk(std::move(chunk), localVocabs[i]);
+    });
+  }
+  ad_utility::runTasksInParallel(std::move(tasks));
+
+  IdTable result = std::move(results.front());
+  size_t totalSize = 0;
+  for (const auto& chunkResult : results) {
+    totalSize += chunkResult.numRows();
+  }
+  result.reserve(totalSize);
+  for (size_t i = 1; i < numChunks; ++i) {
+    result.insertAtEnd(results[i]);
+  }
+  localVocab.mergeWith(localVocabs);
+  return result;
+}
+
+}  // namespace qlever::chunkedEvaluation
+
+#endif  // QLEVER_SRC_ENGINE_CHUNKEDEVALUATION_H
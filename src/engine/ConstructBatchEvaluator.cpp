@@ -52,9 +52,8 @@ EvaluatedVariableValues ConstructBatchEvaluator::evaluateVariableByColumn(
   const size_t numRows = ctx.numRows();
 
   // Build a `(rowInBatch, Id)` index vector and sort by `Id`. This ensures
-  // that `VocabIndex` IDs form a contiguous, sorted block (see
-  // `idsToStringAndType`), converting vocabulary lookups from random-access
-  // reads to sequential reads for I/O locality.
+  // that `VocabIndex` IDs form a contiguous, sorted block, so the bulk
+  // vocabulary lookup in `idsToStringAndType` doesn't have to sort them again.
   auto sortedIndices = ::ranges::to_vector(::ranges::views::enumerate(col));
 
   ql::ranges::sort(sortedIndices, {}, ad_utility::second);
@@ -81,8 +80,8 @@ EvaluatedVariableValues ConstructBatchEvaluator::evaluateVariableByColumn(
   }
 
   // Phase 2: batch-resolve cache misses. `missIds` is deduplicated and sorted
-  // (inherited from `sortedIndices`), satisfying the `idsToStringAndType`
-  // precondition for sequential VocabIndex I/O.
+  // (inherited from `sortedIndices`), so all the vocabulary words are read in
+  // a single sequential pass.
   auto missResolved =
       ql::exportIds::idsToStringAndType(index, missIds, localVocab);
   for (auto&& [id, resolved, rows] :
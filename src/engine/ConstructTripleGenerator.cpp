@@ -13,6 +13,9 @@
 #include "engine/ConstructBatchEvaluator.h"
 #include "engine/ConstructTemplatePreprocessor.h"
 #include "engine/ConstructTripleInstantiator.h"
+#include "global/RuntimeParameters.h"
+#include "util/Synchronized.h"
+#include "util/ThreadSafeQueue.h"
 #include "util/Views.h"
 
 namespace qlever::constructExport {
@@ -88,6 +91,96 @@ InputRangeTypeErased<EvaluatedTriple> ConstructTripleGenerator::evaluateTables(
   return InputRangeTypeErased(std::move(pipeline));
 }
 
+//______________________________________________________________________________
+InputRangeTypeErased<std::string>
+ConstructTripleGenerator::formatTablesInParallel(
+    const Triples& templateTriples, const VariableToColumnMap& variableColumns,
+    const Index& index, CancellationHandle cancellationHandle,
+    InputRangeTypeErased<TableWithRange> rowIndices, size_t rowOffset,
+    ad_utility::MediaType mediaType, size_t numThreads) {
+  auto preprocessedTemplate =
+      std::make_shared<const PreprocessedConstructTemplate>(
+          ConstructTemplatePreprocessor::preprocess(templateTriples,
+                                                    variableColumns));
+  // An `IdCache` must not be used by multiple threads at the same time, so
+  // each batch takes a cache from this pool for the time of its evaluation.
+  // As in `evaluateTables`, the caches are reused across batches and tables.
+  auto idCaches =
+      std::make_shared<ad_utility::Synchronized<std::vector<IdCache>>>();
+
+  auto processTable = [preprocessedTemplate, idCaches, &index,
+                       cancellationHandle, mediaType, numThreads,
+                       accumulatedRowOffset =
+                           rowOffset](const TableWithRange& table) mutable {
+    const size_t numRowsOfTable = ql::ranges::size(table.view_);
+    const size_t tableRowOffset = accumulatedRowOffset;
+    accumulatedRowOffset += numRowsOfTable;
+    const size_t firstRow =
+        numRowsOfTable == 0 ? 0 : *ql::ranges::begin(table.view_);
+    const size_t numBatches = (numRowsOfTable + BATCH_SIZE - 1) / BATCH_SIZE;
+
+    // Instantiate and format the batch with the given index. This is called
+    // concurrently by the worker threads.
+    auto formatBatch = [&table, preprocessedTemplate, idCaches, &index,
+                        cancellationHandle, mediaType, tableRowOffset,
+                        firstRow, numRowsOfTable](size_t batchIndex) {
+      const size_t batchBegin = firstRow + batchIndex * BATCH_SIZE;
+      const size_t batchEnd =
+          std::min(batchBegin + BATCH_SIZE, firstRow + numRowsOfTable);
+      IdCache cache = [&]() {
+        auto lock = idCaches->wlock();
+        if (lock->empty()) {
+          return makeIdCache(*preprocessedTemplate);
+        }
+        IdCache result = std::move(lock->back());
+        lock->pop_back();
+        return result;
+      }();
+      auto triples = computeBatch(
+          table.tableWithVocab_, ql::views::iota(batchBegin, batchEnd),
+          *preprocessedTemplate, index, cache, tableRowOffset,
+          cancellationHandle);
+      idCaches->wlock()->push_back(std::move(cache));
+      std::string formattedBatch;
+      for (const auto& triple : triples) {
+        formattedBatch.append(formatTriple(triple, mediaType));
+      }
+      return formattedBatch;
+    };
+
+    // Starting threads doesn't pay off for a single batch.
+    if (numBatches <= 1) {
+      return ad_utility::OwningView{InputRangeTypeErased<std::string>{
+          ql::views::iota(size_t{0}, numBatches) |
+          ql::views::transform(std::move(formatBatch))}};
+    }
+    auto nextBatch = std::make_shared<std::atomic<size_t>>(0);
+    auto producer = [formatBatch = std::move(formatBatch), nextBatch,
+                     numBatches]()
+        -> std::optional<std::pair<size_t, std::string>> {
+      size_t batchIndex = (*nextBatch)++;
+      if (batchIndex >= numBatches) {
+        return std::nullopt;
+      }
+      return std::pair{batchIndex, formatBatch(batchIndex)};
+    };
+    size_t numWorkers = std::min(numThreads, numBatches);
+    return ad_utility::OwningView{
+        ad_utility::data_structures::queueManager<
+            ad_utility::data_structures::OrderedThreadSafeQueue<std::string>>(
+            NUM_BUFFERED_BATCHES_PER_THREAD * numWorkers, numWorkers,
+            std::move(producer))};
+  };
+
+  // Batches of which all triples were dropped (because of unbound variables)
+  // yield an empty string.
+  auto isNonEmpty = [](const std::string& str) { return !str.empty(); };
+  auto pipeline = allView(std::move(rowIndices)) |
+                  ql::views::transform(std::move(processTable)) |
+                  ql::views::join | ql::views::filter(isNonEmpty);
+  return InputRangeTypeErased(std::move(pipeline));
+}
+
 //______________________________________________________________________________
 InputRangeTypeErased<std::string>
 ConstructTripleGenerator::generateFormattedTriples(
@@ -95,6 +188,14 @@ ConstructTripleGenerator::generateFormattedTriples(
     const Index& index, CancellationHandle cancellationhandle,
     InputRangeTypeErased<TableWithRange> rowIndices, size_t rowOffset,
     ad_utility::MediaType mediaType) {
+  const size_t numThreads =
+      getRuntimeParameter<&RuntimeParameters::constructExportNumThreads_>();
+  if (numThreads > 1) {
+    return formatTablesInParallel(templateTriples, variableColums, index,
+                                  std::move(cancellationhandle),
+                                  std::move(rowIndices), rowOffset, mediaType,
+                                  numThreads);
+  }
   auto evaluatedTriples =
       evaluateTables(templateTriples, variableColums, index, cancellationhandle,
                      std::move(rowIndices), rowOffset);
@@ -42,9 +42,16 @@ class ConstructTripleGenerator {
   // the number of entries in the `IdCache` for each variable in the construct
   // clause template.
   static constexpr size_t CACHE_ENTRIES_PER_VARIABLE = 2048;
+  // The number of formatted batches per worker thread that may be buffered
+  // by `formatTablesInParallel` before the workers have to wait for the
+  // consumer.
+  static constexpr size_t NUM_BUFFERED_BATCHES_PER_THREAD = 2;
 
   // Instantiates `templateTriples` for each row in `rowIndices` and returns a
-  // lazy range of triples serialized according to `mediaType`.
+  // lazy range of triples serialized according to `mediaType`. If the runtime
+  // parameter `construct-export-num-threads` is larger than one, the triples
+  // are instantiated and formatted by `formatTablesInParallel`, and each
+  // element of the range contains all the triples of one batch.
   static InputRangeTypeErased<std::string> generateFormattedTriples(
       const Triples& templateTriples, const VariableToColumnMap& variableColums,
       const Index& index, CancellationHandle cancellationhandle,
@@ -73,6 +80,20 @@ class ConstructTripleGenerator {
       ad_utility::InputRangeTypeErased<TableWithRange> rowIndices,
       size_t rowOffset);
 
+  // Like `evaluateTables`, but additionally formats the triples and
+  // concatenates the formatted triples of each batch into a single string.
+  // The batches of a table are processed by `numThreads` worker threads
+  // concurrently, while the strings are yielded in the original order. At
+  // most `NUM_BUFFERED_BATCHES_PER_THREAD * numThreads` batches are buffered,
+  // so the memory consumption doesn't depend on the size of the result.
+  // Cancellation is checked at the start of each batch.
+  static InputRangeTypeErased<std::string> formatTablesInParallel(
+      const Triples& templateTriples,
+      const VariableToColumnMap& variableColumns, const Index& index,
+      CancellationHandle cancellationhandle,
+      ad_utility::InputRangeTypeErased<TableWithRange> rowIndices,
+      size_t rowOffset, ad_utility::MediaType mediaType, size_t numThreads);
+
   FRIEND_TEST(MakeIdCache, emptyTemplate);
   FRIEND_TEST(MakeIdCache, singleVariable);
   FRIEND_TEST(MakeIdCache, multipleVariables);
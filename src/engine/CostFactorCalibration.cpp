@@ -0,0 +1,319 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/CostFactorCalibration.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+
+#include "engine/HashJoin.h"
+#include "engine/Join.h"
+#include "engine/Operation.h"
+#include "engine/RuntimeInformation.h"
+#include "util/File.h"
+#include "util/Log.h"
+
+namespace {
+constexpr std::string_view buildCostKey = "HASH_JOIN_BUILD_COST_PER_ROW";
+constexpr std::string_view probeCostKey = "HASH_JOIN_PROBE_COST_PER_ROW";
+constexpr std::string_view sizeCorrectionKey =
+    "JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR";
+
+// The kind of an operation, which is the first word of its descriptor.
+std::string operationKind(const Operation& operation) {
+  auto descriptor = operation.getDescriptor();
+  return descriptor.substr(0, descriptor.find(' '));
+}
+
+// The default value of the cost factor with the given `key`.
+double defaultCostFactor(std::string_view key) {
+  static const QueryPlanningCostFactors defaults;
+  return defaults.getCostFactor(std::string{key});
+}
+
+// Multiply all the `sums` by the `decay_`, and add one to the `numSamples`.
+template <typename... Sums>
+void decayAndCount(double& numSamples, Sums&... sums) {
+  numSamples = numSamples * CostFactorCalibration::decay_ + 1;
+  ((sums *= CostFactorCalibration::decay_), ...);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void to_json(nlohmann::json& json,
+             const CostFactorCalibration::OperationStatistics& statistics) {
+  json = {{"num-samples", statistics.numSamples_},
+          {"operation-time-us", statistics.operationTimeMicroseconds_},
+          {"own-cost-estimate", statistics.ownCostEstimate_},
+          {"sum-log-size-ratio", statistics.sumLogSizeRatio_}};
+}
+
+// _____________________________________________________________________________
+void from_json(const nlohmann::json& json,
+               CostFactorCalibration::OperationStatistics& statistics) {
+  statistics.numSamples_ = json.at("num-samples");
+  statistics.operationTimeMicroseconds_ = json.at("operation-time-us");
+  statistics.ownCostEstimate_ = json.at("own-cost-estimate");
+  statistics.sumLogSizeRatio_ = json.at("sum-log-size-ratio");
+}
+
+// _____________________________________________________________________________
+void to_json(nlohmann::json& json,
+             const CostFactorCalibration::Statistics& statistics) {
+  auto operations = nlohmann::json::object();
+  for (const auto& [kind, operation] : statistics.operations_) {
+    operations[kind] = operation;
+  }
+  json = {{"operations", std::move(operations)},
+          {"num-join-samples", statistics.numJoinSamples_},
+          {"join-time-us", statistics.joinTimeMicroseconds_},
+          {"join-num-rows", statistics.joinNumRows_},
+          {"num-hash-join-samples", statistics.numHashJoinSamples_},
+          {"hash-join-cost-times-time", statistics.hashJoinCostTimesTime_},
+          {"hash-join-cost-times-result", statistics.hashJoinCostTimesResult_},
+          {"hash-join-cost-squared", statistics.hashJoinCostSquared_},
+          {"num-join-size-samples", statistics.numJoinSizeSamples_},
+          {"sum-log-join-size-correction",
+           statistics.sumLogJoinSizeCorrection_}};
+}
+
+// _____________________________________________________________________________
+void from_json(const nlohmann::json& json,
+               CostFactorCalibration::Statistics& statistics) {
+  statistics.operations_.clear();
+  for (const auto& [kind, operation] : json.at("operations").items()) {
+    statistics.operations_[kind] =
+        operation.get<CostFactorCalibration::OperationStatistics>();
+  }
+  statistics.numJoinSamples_ = json.at("num-join-samples");
+  statistics.joinTimeMicroseconds_ = json.at("join-time-us");
+  statistics.joinNumRows_ = json.at("join-num-rows");
+  statistics.numHashJoinSamples_ = json.at("num-hash-join-samples");
+  statistics.hashJoinCostTimesTime_ = json.at("hash-join-cost-times-time");
+  statistics.hashJoinCostTimesResult_ = json.at("hash-join-cost-times-result");
+  statistics.hashJoinCostSquared_ = json.at("hash-join-cost-squared");
+  statistics.numJoinSizeSamples_ = json.at("num-join-size-samples");
+  statistics.sumLogJoinSizeCorrection_ =
+      json.at("sum-log-join-size-correction");
+}
+
+// _____________________________________________________________________________
+void CostFactorCalibration::recordQuery(const QueryExecutionTree& qet) {
+  auto isCompleted = [](const RuntimeInformation& runtimeInfo) {
+    return runtimeInfo.status_ ==
+           RuntimeInformation::Status::fullyMaterializedCompleted;
+  };
+  std::vector<const QueryExecutionTree*> stack{&qet};
+  while (!stack.empty()) {
+    const Operation& operation = *stack.back()->getRootOperation();
+    stack.pop_back();
+    auto children = operation.getChildren();
+    stack.insert(stack.end(), children.begin(), children.end());
+
+    // The operation time of an operation with lazily computed children also
+    // contains (part of) the time of the children.
+    const auto& runtimeInfo = operation.runtimeInfo();
+    if (!isCompleted(runtimeInfo) ||
+        runtimeInfo.cacheStatus_ != ad_utility::CacheStatus::computed ||
+        !ql::ranges::all_of(children, [&](const QueryExecutionTree* child) {
+          return isCompleted(child->getRootOperation()->runtimeInfo());
+        })) {
+      continue;
+    }
+    size_t costOfChildren = 0;
+    for (const auto* child : children) {
+      costOfChildren += child->getRootOperation()->runtimeInfo().costEstimate_;
+    }
+    recordOperation(operationKind(operation), runtimeInfo.getOperationTime(),
+                    runtimeInfo.costEstimate_ -
+                        std::min(costOfChildren, runtimeInfo.costEstimate_),
+                    runtimeInfo.sizeEstimate_, runtimeInfo.numRows_);
+
+    const auto* hashJoin = dynamic_cast<const HashJoin*>(&operation);
+    if ((hashJoin == nullptr && dynamic_cast<const Join*>(&operation) ==
+                                    nullptr) ||
+        children.size() != 2) {
+      continue;
+    }
+    bool leftIsBuildSide = hashJoin == nullptr || hashJoin->leftIsBuildSide();
+    auto numRows = [&children](size_t i) {
+      return children.at(i)->getRootOperation()->runtimeInfo().numRows_;
+    };
+    recordJoin({hashJoin != nullptr, runtimeInfo.getOperationTime(),
+                numRows(leftIsBuildSide ? 0 : 1),
+                numRows(leftIsBuildSide ? 1 : 0), runtimeInfo.numRows_,
+                runtimeInfo.sizeEstimate_,
+                operation.getExecutionContext()->getCostFactor(
+                    std::string{sizeCorrectionKey})});
+  }
+  persistIfDue();
+}
+
+// _____________________________________________________________________________
+void CostFactorCalibration::recordOperation(const std::string& kind,
+                                            Microseconds operationTime,
+                                            size_t ownCostEstimate,
+                                            size_t sizeEstimate,
+                                            size_t actualSize) {
+  auto statistics = statistics_.wlock();
+  auto& operation = statistics->operations_[kind];
+  decayAndCount(operation.numSamples_, operation.operationTimeMicroseconds_,
+                operation.ownCostEstimate_, operation.sumLogSizeRatio_);
+  operation.operationTimeMicroseconds_ +=
+      static_cast<double>(operationTime.count());
+  operation.ownCostEstimate_ += static_cast<double>(ownCostEstimate);
+  operation.sumLogSizeRatio_ +=
+      std::log(static_cast<double>(actualSize + 1) /
+               static_cast<double>(sizeEstimate + 1));
+}
+
+// _____________________________________________________________________________
+void CostFactorCalibration::recordJoin(const JoinSample& sample) {
+  auto statistics = statistics_.wlock();
+  auto& s = *statistics;
+  auto time = static_cast<double>(sample.operationTime_.count());
+  auto numRowsResult = static_cast<double>(sample.numRowsResult_);
+  if (sample.isHashJoin_) {
+    double cost = defaultCostFactor(buildCostKey) *
+                      static_cast<double>(sample.numRowsBuild_) +
+                  defaultCostFactor(probeCostKey) *
+                      static_cast<double>(sample.numRowsProbe_);
+    decayAndCount(s.numHashJoinSamples_, s.hashJoinCostTimesTime_,
+                  s.hashJoinCostTimesResult_, s.hashJoinCostSquared_);
+    s.hashJoinCostTimesTime_ += cost * time;
+    s.hashJoinCostTimesResult_ += cost * numRowsResult;
+    s.hashJoinCostSquared_ += cost * cost;
+  } else {
+    decayAndCount(s.numJoinSamples_, s.joinTimeMicroseconds_, s.joinNumRows_);
+    s.joinTimeMicroseconds_ += time;
+    s.joinNumRows_ += static_cast<double>(sample.numRowsBuild_ +
+                                          sample.numRowsProbe_) +
+                      numRowsResult;
+  }
+  if (sample.sizeCorrectionFactor_ > 0) {
+    double uncorrectedEstimate = static_cast<double>(sample.sizeEstimate_) /
+                                 sample.sizeCorrectionFactor_;
+    decayAndCount(s.numJoinSizeSamples_, s.sumLogJoinSizeCorrection_);
+    s.sumLogJoinSizeCorrection_ +=
+        std::log((numRowsResult + 1) / (uncorrectedEstimate + 1));
+  }
+}
+
+// _____________________________________________________________________________
+std::vector<std::pair<std::string, double>>
+CostFactorCalibration::fittedCostFactors() const {
+  std::vector<std::pair<std::string, double>> result;
+  auto s = statistics_.copy();
+  if (s.numJoinSamples_ >= minNumSamples_ &&
+      s.numHashJoinSamples_ >= minNumSamples_ && s.joinNumRows_ > 0 &&
+      s.joinTimeMicroseconds_ > 0 && s.hashJoinCostSquared_ > 0) {
+    // The time of a single unit of cost.
+    double timePerRow = s.joinTimeMicroseconds_ / s.joinNumRows_;
+    double scale =
+        (s.hashJoinCostTimesTime_ / timePerRow - s.hashJoinCostTimesResult_) /
+        s.hashJoinCostSquared_;
+    scale = std::clamp(scale, 0.1, 10.0);
+    for (auto key : {buildCostKey, probeCostKey}) {
+      result.emplace_back(key, scale * defaultCostFactor(key));
+    }
+  }
+  if (s.numJoinSizeSamples_ >= minNumSamples_) {
+    double correction =
+        std::exp(s.sumLogJoinSizeCorrection_ / s.numJoinSizeSamples_);
+    result.emplace_back(sizeCorrectionKey, std::clamp(correction, 0.1, 2.0));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void CostFactorCalibration::applyTo(
+    QueryPlanningCostFactors& costFactors) const {
+  for (const auto& [key, value] : fittedCostFactors()) {
+    costFactors.setCostFactor(key, value);
+  }
+}
+
+// _____________________________________________________________________________
+nlohmann::json CostFactorCalibration::toJson() const {
+  auto statistics = statistics_.copy();
+  auto operations = nlohmann::json::object();
+  for (const auto& [kind, operation] : statistics.operations_) {
+    if (operation.numSamples_ <= 0) {
+      continue;
+    }
+    operations[kind] = {
+        {"num-samples", operation.numSamples_},
+        {"mean-operation-time-ms",
+         operation.operationTimeMicroseconds_ / operation.numSamples_ / 1000},
+        {"mean-own-cost-estimate",
+         operation.ownCostEstimate_ / operation.numSamples_},
+        {"time-per-cost-unit-us",
+         operation.ownCostEstimate_ > 0
+             ? operation.operationTimeMicroseconds_ / operation.ownCostEstimate_
+             : 0.0},
+        {"mean-actual-to-estimated-size",
+         std::exp(operation.sumLogSizeRatio_ / operation.numSamples_)}};
+  }
+  auto factors = nlohmann::json::object();
+  for (const auto& [key, value] : fittedCostFactors()) {
+    factors[key] = value;
+  }
+  return {{"operations", std::move(operations)},
+          {"fitted-cost-factors", std::move(factors)}};
+}
+
+// _____________________________________________________________________________
+void CostFactorCalibration::setPersistenceFile(std::string filename) {
+  if (std::filesystem::exists(filename)) {
+    try {
+      auto file = ad_utility::makeIfstream(filename);
+      auto json = nlohmann::json::parse(file);
+      *statistics_.wlock() = json.get<Statistics>();
+      AD_LOG_INFO << "Read the statistics for the calibration of the cost "
+                     "factors from \""
+                  << filename << "\"" << std::endl;
+    } catch (const std::exception& e) {
+      AD_LOG_WARN << "Could not read the statistics for the calibration of "
+                     "the cost factors from \""
+                  << filename << "\": " << e.what() << std::endl;
+    }
+  }
+  filename_ = std::move(filename);
+}
+
+// _____________________________________________________________________________
+void CostFactorCalibration::persist() const {
+  if (!filename_.has_value()) {
+    return;
+  }
+  nlohmann::json json = statistics_.copy();
+  ad_utility::makeOfstream(filename_.value()) << json.dump(2) << std::endl;
+}
+
+// _____________________________________________________________________________
+void CostFactorCalibration::persistIfDue() {
+  if (numQueriesSinceLastPersist_.fetch_add(1) + 1 < persistInterval_) {
+    return;
+  }
+  numQueriesSinceLastPersist_ = 0;
+  try {
+    persist();
+  } catch (const std::exception& e) {
+    AD_LOG_WARN << "Could not write the statistics for the calibration of "
+                   "the cost factors: "
+                << e.what() << std::endl;
+  }
+}
+
+// _____________________________________________________________________________
+void CostFactorCalibration::clear() {
+  *statistics_.wlock() = Statistics{};
+  numQueriesSinceLastPersist_ = 0;
+}
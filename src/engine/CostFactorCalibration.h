@@ -0,0 +1,155 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_COSTFACTORCALIBRATION_H
+#define QLEVER_SRC_ENGINE_COSTFACTORCALIBRATION_H
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "engine/QueryExecutionTree.h"
+#include "engine/QueryPlanningCostFactors.h"
+#include "util/HashMap.h"
+#include "util/Synchronized.h"
+#include "util/json.h"
+
+// Fit some of the `QueryPlanningCostFactors` to the hardware and the data
+// from the runtimes of the executed queries, s.t. the query planner adapts
+// to them (the default factors are static). The fit is enabled by the runtime
+// parameter `cost-factor-calibration`.
+//
+// For each executed query, `recordQuery` visits all the operations that were
+// fully materialized and actually computed (not read from the cache), and
+// accumulates their operation times, the estimated costs (without the costs
+// of the children), and the estimated and actual sizes by the kind of the
+// operation (the first word of the descriptor). All the sums are decayed
+// exponentially, s.t. the fit follows changes of the workload.
+//
+// Currently, the following factors are fitted (once there are at least
+// `minNumSamples_` samples for them):
+//
+// * `HASH_JOIN_BUILD_COST_PER_ROW` and `HASH_JOIN_PROBE_COST_PER_ROW`: The time
+//   per row of a `Join` (the cost of a `Join` is one per row of the inputs and
+//   the result) is the unit of the cost. The time of a `HashJoin` minus the
+//   time for its result rows is fitted (least squares) to a multiple of the
+//   (default) build and probe costs, the ratio of which is kept.
+//
+// * `JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR`: The geometric mean of the ratios
+//   of the actual sizes of the joins to their estimated sizes without the
+//   correction factor.
+//
+// The statistics can be persisted to a file, s.t. they survive a restart.
+class CostFactorCalibration {
+ public:
+  using Microseconds = std::chrono::microseconds;
+
+  // The weight of the previous samples when a new sample is added.
+  static constexpr double decay_ = 0.999;
+  // The minimal (decayed) number of samples for a fit.
+  static constexpr double minNumSamples_ = 20;
+  // The number of recorded queries after which the statistics are written to
+  // the file (if any).
+  static constexpr size_t persistInterval_ = 100;
+
+  // The statistics of the operations of one kind.
+  struct OperationStatistics {
+    double numSamples_ = 0;
+    double operationTimeMicroseconds_ = 0;
+    double ownCostEstimate_ = 0;
+    // The sum of `log((actual size + 1) / (estimated size + 1))`.
+    double sumLogSizeRatio_ = 0;
+
+    friend void to_json(nlohmann::json& json,
+                        const OperationStatistics& statistics);
+    friend void from_json(const nlohmann::json& json,
+                          OperationStatistics& statistics);
+  };
+
+  // A single computed `Join` or `HashJoin`.
+  struct JoinSample {
+    bool isHashJoin_ = false;
+    Microseconds operationTime_{0};
+    size_t numRowsBuild_ = 0;
+    size_t numRowsProbe_ = 0;
+    size_t numRowsResult_ = 0;
+    size_t sizeEstimate_ = 0;
+    // The `JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR` that was used for the
+    // `sizeEstimate_`.
+    double sizeCorrectionFactor_ = 1.0;
+  };
+
+  // The (decayed) sums from which the factors are fitted.
+  struct Statistics {
+    ad_utility::HashMap<std::string, OperationStatistics> operations_;
+    // The joins: The time and the number of rows of the inputs and the result.
+    double numJoinSamples_ = 0;
+    double joinTimeMicroseconds_ = 0;
+    double joinNumRows_ = 0;
+    // The hash joins: With `x` the default cost of the build and probe rows,
+    // and `t` the time, the sums of `x * t`, `x * (number of result rows)`,
+    // and `x * x`.
+    double numHashJoinSamples_ = 0;
+    double hashJoinCostTimesTime_ = 0;
+    double hashJoinCostTimesResult_ = 0;
+    double hashJoinCostSquared_ = 0;
+    // The sum of `log(actual size / uncorrected estimated size)` of all joins.
+    double numJoinSizeSamples_ = 0;
+    double sumLogJoinSizeCorrection_ = 0;
+
+    friend void to_json(nlohmann::json& json, const Statistics& statistics);
+    friend void from_json(const nlohmann::json& json, Statistics& statistics);
+  };
+
+ private:
+  ad_utility::Synchronized<Statistics> statistics_;
+  // The file to which the statistics are persisted.
+  std::optional<std::string> filename_;
+  std::atomic<size_t> numQueriesSinceLastPersist_ = 0;
+
+ public:
+  // Record the computed operations of the `qet` after it has been executed.
+  void recordQuery(const QueryExecutionTree& qet);
+
+  // Record a single computed operation of the given `kind`.
+  void recordOperation(const std::string& kind, Microseconds operationTime,
+                       size_t ownCostEstimate, size_t sizeEstimate,
+                       size_t actualSize);
+
+  // Record a single computed join.
+  void recordJoin(const JoinSample& sample);
+
+  // The factors that have enough samples to be fitted.
+  std::vector<std::pair<std::string, double>> fittedCostFactors() const;
+
+  // Set the fitted factors in the `costFactors`, keep the others.
+  void applyTo(QueryPlanningCostFactors& costFactors) const;
+
+  // The statistics and the fitted factors, for the `cost-factor-calibration`
+  // command of the server.
+  nlohmann::json toJson() const;
+
+  // Read the statistics from the file with the given name if it exists, and
+  // from now on periodically write them to this file.
+  void setPersistenceFile(std::string filename);
+
+  // Write the statistics to the persistence file (if any).
+  void persist() const;
+
+  // Remove all the statistics.
+  void clear();
+
+ private:
+  // Write the statistics to the file every `persistInterval_` queries.
+  void persistIfDue();
+};
+
+#endif  // QLEVER_SRC_ENGINE_COSTFACTORCALIBRATION_H
@@ -4,9 +4,16 @@
 
 #include "engine/CountAvailablePredicates.h"
 
+#include <future>
+
 #include "engine/CallFixedSize.h"
 #include "engine/IndexScan.h"
+#include "global/RuntimeParameters.h"
 #include "index/IndexImpl.h"
+#include "util/HashMap.h"
+#include "util/ParallelExecutor.h"
+#include "util/ThreadBudget.h"
+#include "util/TypeIdentity.h"
 
 // _____________________________________________________________________________
 CountAvailablePredicates::CountAvailablePredicates(
@@ -155,13 +162,190 @@ Result CountAvailablePredicates::computeResult(
   }
 }
 
+namespace {
+// Each thread counts the patterns of at least this many input rows.
+constexpr size_t PATTERN_TRICK_MIN_ROWS_PER_THREAD = 500'000;
+
+// If the predicate Ids of the counted patterns (more precisely, their bits)
+// lie in a range of at most this size, the predicates are counted in a dense
+// array instead of a hash map.
+constexpr uint64_t DENSE_PREDICATE_COUNTS_MAX_RANGE = 1'000'000;
+
+// The number of subjects for each pattern index. The pattern indices are
+// contiguous, so for large inputs the counts are stored in a dense array,
+// which is much cheaper than a hash map for the increment per input row. For
+// small inputs, a hash map avoids allocating an entry for all patterns.
+using DensePatternCounts = std::vector<size_t>;
+using SparsePatternCounts = ad_utility::HashMap<size_t, size_t>;
+
+// The counts of the patterns of a part of the input.
+template <typename PatternCounts>
+struct PartialPatternCounts {
+  PatternCounts counts_;
+  size_t numEntitiesWithPatterns_ = 0;
+  // Set to true if a pattern index was found that is neither a valid index
+  // nor `Pattern::NoPattern`.
+  bool illegalPatternIndexFound_ = false;
+
+  // Count the pattern with the given `patternIndex`. Subjects without a
+  // pattern are not counted.
+  void add(int64_t patternIndex, size_t numPatterns) {
+    if (patternIndex < 0 || static_cast<size_t>(patternIndex) >= numPatterns) {
+      illegalPatternIndexFound_ |= patternIndex != Pattern::NoPattern;
+      return;
+    }
+    ++counts_[static_cast<size_t>(patternIndex)];
+    ++numEntitiesWithPatterns_;
+  }
+
+  // Add the counts of `other` to this.
+  void merge(const PartialPatternCounts& other) {
+    if constexpr (std::is_same_v<PatternCounts, DensePatternCounts>) {
+      for (size_t i = 0; i < counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+      }
+    } else {
+      for (const auto& [patternIndex, count] : other.counts_) {
+        counts_[patternIndex] += count;
+      }
+    }
+    numEntitiesWithPatterns_ += other.numEntitiesWithPatterns_;
+    illegalPatternIndexFound_ |= other.illegalPatternIndexFound_;
+  }
+
+  // Call `function(patternIndex, count)` for each counted pattern.
+  template <typename F>
+  void forEach(const F& function) const {
+    if constexpr (std::is_same_v<PatternCounts, DensePatternCounts>) {
+      for (size_t i = 0; i < counts_.size(); ++i) {
+        if (counts_[i] > 0) {
+          function(i, counts_[i]);
+        }
+      }
+    } else {
+      for (const auto& [patternIndex, count] : counts_) {
+        function(patternIndex, count);
+      }
+    }
+  }
+};
+
+// Count the patterns of the distinct subjects in the rows of the `input` in
+// parallel. The input is split into contiguous parts, which are counted by
+// different threads, and the counts of the parts are merged at the end. Each
+// subject is counted only once, also if its rows span two parts, because a row
+// is skipped if its subject is the same as in the previous row.
+template <typename PatternCounts, size_t WIDTH>
+PartialPatternCounts<PatternCounts> countPatternsInParallel(
+    const IdTableView<WIDTH>& input, size_t subjectColumnIdx,
+    size_t patternColumnIdx, size_t numPatterns, size_t* numThreadsUsed) {
+  decltype(auto) subjectColumn = input.getColumn(subjectColumnIdx);
+  decltype(auto) patternColumn = input.getColumn(patternColumnIdx);
+  size_t maxNumThreads = std::max(
+      size_t{1},
+      getRuntimeParameter<&RuntimeParameters::patternTrickNumThreads_>());
+  auto threads = ad_utility::globalThreadBudget().reserve(std::min(
+      maxNumThreads, input.size() / PATTERN_TRICK_MIN_ROWS_PER_THREAD));
+  const size_t numThreads = threads.numThreads();
+  *numThreadsUsed = numThreads;
+
+  std::vector<PartialPatternCounts<PatternCounts>> partialCounts(numThreads);
+  auto countPart = [&](size_t t) {
+    auto& partialCount = partialCounts[t];
+    if constexpr (std::is_same_v<PatternCounts, DensePatternCounts>) {
+      partialCount.counts_.resize(numPatterns, 0);
+    }
+    size_t end = input.size() * (t + 1) / numThreads;
+    for (size_t i = input.size() * t / numThreads; i < end; ++i) {
+      if (i > 0 && subjectColumn[i] == subjectColumn[i - 1]) {
+        continue;
+      }
+      partialCount.add(patternColumn[i].getInt(), numPatterns);
+    }
+  };
+  if (numThreads == 1) {
+    countPart(0);
+  } else {
+    std::vector<std::packaged_task<void()>> tasks;
+    for (size_t t = 0; t < numThreads; ++t) {
+      tasks.emplace_back([&countPart, t]() { countPart(t); });
+    }
+    ad_utility::runTasksInParallel(std::move(tasks));
+  }
+  for (size_t t = 1; t < numThreads; ++t) {
+    partialCounts[0].merge(partialCounts[t]);
+  }
+  return std::move(partialCounts[0]);
+}
+
+// Statistics about the translation of the pattern counts.
+struct PredicateCountStatistics {
+  // The number of distinct predicates in the counted patterns.
+  size_t numPatternPredicates_ = 0;
+  // The number of predicates counted with patterns.
+  size_t numPredicatesSubsumedInPatterns_ = 0;
+};
+
+// Translate the `patternCounts` to the counts of their predicates and write
+// one row `{predicate, count}` for each predicate to the `result`.
+template <typename PatternCounts>
+PredicateCountStatistics writePredicateCounts(
+    const PartialPatternCounts<PatternCounts>& patternCounts,
+    const CompactVectorOfStrings<Id>& patterns, IdTableStatic<2>& result) {
+  PredicateCountStatistics statistics;
+  Id::T minBits = std::numeric_limits<Id::T>::max();
+  Id::T maxBits = 0;
+  patternCounts.forEach([&](size_t patternIndex, size_t count) {
+    const auto& pattern = patterns[patternIndex];
+    statistics.numPatternPredicates_ += pattern.size();
+    statistics.numPredicatesSubsumedInPatterns_ += pattern.size() * count;
+    for (Id predicate : pattern) {
+      minBits = std::min(minBits, predicate.getBits());
+      maxBits = std::max(maxBits, predicate.getBits());
+    }
+  });
+  if (minBits > maxBits) {
+    return statistics;
+  }
+
+  if (maxBits - minBits < DENSE_PREDICATE_COUNTS_MAX_RANGE) {
+    std::vector<size_t> predicateCounts(maxBits - minBits + 1, 0);
+    patternCounts.forEach([&](size_t patternIndex, size_t count) {
+      for (Id predicate : patterns[patternIndex]) {
+        predicateCounts[predicate.getBits() - minBits] += count;
+      }
+    });
+    for (size_t i = 0; i < predicateCounts.size(); ++i) {
+      if (predicateCounts[i] > 0) {
+        result.push_back({Id::fromBits(minBits + i),
+                          Id::makeFromInt(predicateCounts[i])});
+      }
+    }
+  } else {
+    ad_utility::HashMap<Id, size_t> predicateCounts;
+    patternCounts.forEach([&](size_t patternIndex, size_t count) {
+      for (Id predicate : patterns[patternIndex]) {
+        predicateCounts[predicate] += count;
+      }
+    });
+    result.reserve(predicateCounts.size());
+    for (const auto& [predicate, count] : predicateCounts) {
+      result.push_back({predicate, Id::makeFromInt(count)});
+    }
+  }
+  return statistics;
+}
+}  // namespace
+
 // _____________________________________________________________________________
 void CountAvailablePredicates::computePatternTrickAllEntities(
     IdTable* dynResult, const CompactVectorOfStrings<Id>& patterns) const {
   IdTableStatic<2> result = std::move(*dynResult).toStatic<2>();
   AD_LOG_DEBUG << "For all entities." << std::endl;
-  ad_utility::HashMap<Id, size_t> predicateCounts;
-  ad_utility::HashMap<size_t, size_t> patternCounts;
+  // The `ql:has-pattern` relation contains each subject once, so there are at
+  // least as many rows as patterns in use, and the dense counts are cheap.
+  PartialPatternCounts<DensePatternCounts> patternCounts;
+  patternCounts.counts_.resize(patterns.size(), 0);
   const auto& index = getExecutionContext()->getIndex().getImpl();
   auto scanSpec =
       ScanSpecificationAsTripleComponent{
@@ -176,146 +360,59 @@ void CountAvailablePredicates::computePatternTrickAllEntities(
   for (const auto& idTable : fullHasPattern) {
     for (const auto& patternId : idTable.getColumn(1)) {
       AD_CORRECTNESS_CHECK(patternId.getDatatype() == Datatype::Int);
-      patternCounts[patternId.getInt()]++;
+      patternCounts.add(patternId.getInt(), patterns.size());
     }
   }
+  AD_CORRECTNESS_CHECK(!patternCounts.illegalPatternIndexFound_);
 
-  AD_LOG_DEBUG << "Using " << patternCounts.size()
-               << " patterns for computing the result" << std::endl;
-  for (const auto& [patternIdx, count] : patternCounts) {
-    AD_CORRECTNESS_CHECK(patternIdx < patterns.size());
-    for (const auto& predicate : patterns[patternIdx]) {
-      predicateCounts[predicate] += count;
-    }
-  }
-  result.reserve(predicateCounts.size());
-  for (const auto& [predicateId, count] : predicateCounts) {
-    result.push_back({predicateId, Id::makeFromInt(count)});
-  }
+  AD_LOG_DEBUG << "Using " << patternCounts.numEntitiesWithPatterns_
+               << " entities with patterns for computing the result"
+               << std::endl;
+  writePredicateCounts(patternCounts, patterns, result);
   *dynResult = std::move(result).toDynamic();
 }
 
-/**
- * @ brief A Hashmap from T to size_t which additionally supports merging of
- * Hashmaps
- *
- * publicly inherits from ad_utility::HashMap<T, size_t> and additionally
- * provides operator%= which merges Hashmaps by adding the values for
- * corresponding keys. This is needed for the parallel pattern trick
- *
- */
-template <typename T>
-class MergeableHashMap : public ad_utility::HashMap<T, size_t> {
- public:
-  MergeableHashMap& operator%=(const MergeableHashMap& rhs) {
-    for (const auto& [key, value] : rhs) {
-      (*this)[key] += value;
-    }
-    return *this;
-  }
-};
-
 // _____________________________________________________________________________
 template <size_t WIDTH>
 void CountAvailablePredicates::computePatternTrick(
     const IdTableView<0>& dynInput, IdTable* dynResult,
     const CompactVectorOfStrings<Id>& patterns, const size_t subjectColumnIdx,
     const size_t patternColumnIdx, RuntimeInformation& runtimeInfo) {
+  using namespace ad_utility::use_type_identity;
   const IdTableView<WIDTH> input = dynInput.asStaticView<WIDTH>();
   IdTableStatic<2> result = std::move(*dynResult).toStatic<2>();
   AD_LOG_DEBUG << "For " << input.size() << " entities in column "
                << subjectColumnIdx << std::endl;
 
-  MergeableHashMap<Id> predicateCounts;
-  MergeableHashMap<size_t> patternCounts;
-
-  // declare openmp reductions which aggregate Hashmaps by adding the values for
-  // corresponding keys
-#pragma omp declare reduction( \
-        MergeHashmapsId : MergeableHashMap<Id> : omp_out %= omp_in)
-#pragma omp declare reduction( \
-        MergeHashmapsSizeT : MergeableHashMap<size_t> : omp_out %= omp_in)
-
   // These variables are used to gather additional statistics
   size_t numEntitiesWithPatterns = 0;
   // the number of distinct predicates in patterns
   size_t numPatternPredicates = 0;
   // the number of predicates counted without patterns
   size_t numListPredicates = 0;
-
-  if (input.size() > 0) {  // avoid strange OpenMP segfaults on GCC
-    decltype(auto) subjectColumn = input.getColumn(subjectColumnIdx);
-    decltype(auto) patternColumn = input.getColumn(patternColumnIdx);
-#pragma omp parallel
-#pragma omp single
-#pragma omp taskloop grainsize(500000) default(none)                           \
-    reduction(MergeHashmapsId : predicateCounts)                               \
-    reduction(MergeHashmapsSizeT : patternCounts)                              \
-    reduction(+ : numEntitiesWithPatterns) reduction(+ : numPatternPredicates) \
-    reduction(+ : numListPredicates)                                           \
-    shared(input, subjectColumn, patternColumn)
-    for (size_t i = 0; i < input.size(); ++i) {
-      // Skip over elements with the same subject (don't count them twice)
-      Id subjectId = subjectColumn[i];
-      if (i > 0 && subjectId == subjectColumn[i - 1]) {
-        continue;
-      }
-      patternCounts[patternColumn[i].getInt()]++;
-    }
-  }
-  AD_LOG_DEBUG << "Using " << patternCounts.size()
-               << " patterns for computing the result." << std::endl;
   // the number of predicates counted with patterns
   size_t numPredicatesSubsumedInPatterns = 0;
-  // resolve the patterns to predicate counts
-
-  AD_LOG_DEBUG << "Converting PatternMap to vector" << std::endl;
-  // flatten into a vector, to make iterable
-  const std::vector<std::pair<size_t, size_t>> patternVec(patternCounts.begin(),
-                                                          patternCounts.end());
-
-  AD_LOG_DEBUG << "Start translating pattern counts to predicate counts"
-               << std::endl;
-  bool illegalPatternIndexFound = false;
-  if (patternVec.begin() !=
-      patternVec.end()) {  // avoid segfaults with OpenMP on GCC
-#pragma omp parallel
-#pragma omp single
-#pragma omp taskloop grainsize(100000) default(none)                           \
-    reduction(MergeHashmapsId : predicateCounts)                               \
-    reduction(+ : numPredicatesSubsumedInPatterns)                             \
-    reduction(+ : numEntitiesWithPatterns) reduction(+ : numPatternPredicates) \
-    reduction(+ : numListPredicates) shared(patternVec, patterns)              \
-    reduction(|| : illegalPatternIndexFound)
-    // TODO<joka921> When we use iterators (`patternVec.begin()`) for the loop,
-    // there is a strange warning on clang15 when OpenMP is activated. Find out
-    // whether this is a known issue and whether this will be fixed in later
-    // versions of clang.
-    for (size_t i = 0; i != patternVec.size(); ++i) {
-      auto [patternIndex, patternCount] = patternVec[i];
-      // TODO<joka921> As soon as we have a better way of handling the
-      // parallelism, the following block can become a simple AD_CONTRACT_CHECK.
-      if (patternIndex >= patterns.size()) {
-        if (patternIndex != Pattern::NoPattern) {
-          illegalPatternIndexFound = true;
-        }
-        continue;
-      }
-      const auto& pattern = patterns[patternIndex];
-      numPatternPredicates += pattern.size();
-      for (const auto& predicate : pattern) {
-        predicateCounts[predicate] += patternCount;
-        numPredicatesSubsumedInPatterns += patternCount;
-      }
-    }
-  }
-  AD_CONTRACT_CHECK(!illegalPatternIndexFound);
-  AD_LOG_DEBUG << "Finished translating pattern counts to predicate counts"
-               << std::endl;
-  // write the predicate counts to the result
-  result.reserve(predicateCounts.size());
-  for (const auto& it : predicateCounts) {
-    result.push_back({it.first, Id::makeFromInt(it.second)});
+  size_t numThreads = 1;
+
+  // Count the patterns and resolve them to predicate counts.
+  auto countPatternsAndPredicates = [&](auto patternCountsType) {
+    using PatternCounts = typename decltype(patternCountsType)::type;
+    auto patternCounts = countPatternsInParallel<PatternCounts>(
+        input, subjectColumnIdx, patternColumnIdx, patterns.size(),
+        &numThreads);
+    AD_CONTRACT_CHECK(!patternCounts.illegalPatternIndexFound_);
+    numEntitiesWithPatterns = patternCounts.numEntitiesWithPatterns_;
+    AD_LOG_DEBUG << "Start translating pattern counts to predicate counts"
+                 << std::endl;
+    auto statistics = writePredicateCounts(patternCounts, patterns, result);
+    numPatternPredicates = statistics.numPatternPredicates_;
+    numPredicatesSubsumedInPatterns =
+        statistics.numPredicatesSubsumedInPatterns_;
+  };
+  if (patterns.size() <= input.size()) {
+    countPatternsAndPredicates(ti<DensePatternCounts>);
+  } else {
+    countPatternsAndPredicates(ti<SparsePatternCounts>);
   }
   AD_LOG_DEBUG << "Finished writing results" << std::endl;
 
@@ -362,6 +459,7 @@ void CountAvailablePredicates::computePatternTrick(
   runtimeInfo.addDetail("costWithoutPatterns", costWithoutPatterns);
   runtimeInfo.addDetail("costWithPatterns", costWithPatterns);
   runtimeInfo.addDetail("costRatio", costRatio * 100);
+  runtimeInfo.addDetail("numThreads", numThreads);
   *dynResult = std::move(result).toDynamic();
 }
 
@@ -88,6 +88,9 @@ class CountAvailablePredicates : public Operation {
    *                      relations should be counted.
    * @param patternColumnIdx The column containing the pattern IDs (previously
    * obtained via a scan of the `ql:has-pattern` predicate.
+   *
+   * Large inputs are split into parts whose patterns are counted concurrently
+   * (see the runtime parameter `pattern-trick-num-threads`).
    */
   template <size_t I>
   static void computePatternTrick(const IdTableView<0>& input, IdTable* result,
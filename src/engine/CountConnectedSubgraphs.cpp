@@ -4,6 +4,7 @@
 
 #include "engine/CountConnectedSubgraphs.h"
 
+#include <bit>
 #include <bitset>
 
 #include "util/BitUtils.h"
@@ -39,44 +40,14 @@ size_t countSubgraphs(const Graph& graph, size_t budget) {
 static uint64_t computeNeighbors(const Graph& graph, uint64_t nodes,
                                  uint64_t ignored) {
   uint64_t neighbors{};
-  for (size_t i = 0; i < 64; ++i) {
-    bool set = nodes & (1ULL << i);
-    if (set) {
-      neighbors |= graph[i].neighbors_;
-    }
+  // Only visit the bits that are set, by repeatedly clearing the lowest one.
+  for (; nodes != 0; nodes &= nodes - 1) {
+    neighbors |= graph[std::countr_zero(nodes)].neighbors_;
   }
   neighbors &= (~ignored);
   return neighbors;
 }
 
-// For a number `i` from 0 .. 2^`neighbors.size()` - 1, return the `i`th
-// subset of the elements of `neighbors`. All elements in `neighbors` have
-// to be from 0..63 so that the final result can be expressed as a bitmap.
-static uint64_t subsetIndexToBitmap(size_t i,
-                                    const std::vector<uint8_t>& neighbors) {
-  // Note: This can probably be done more efficiently using bit fiddling, but it
-  // is efficient enough for now.
-  uint64_t subset = 0;
-  for (size_t k = 0; k < neighbors.size(); ++k) {
-    if (1ULL << k & i) {
-      subset |= (1ULL << neighbors[k]);
-    }
-  }
-  return subset;
-}
-
-// Convert a bitset to a vector of the indices of the bits that are set. For
-// example, `13` (`1101` as bits) will be converted to `[0, 2, 3]`;
-static std::vector<uint8_t> bitsetToVector(uint64_t bitset) {
-  std::vector<uint8_t> result;
-  for (uint8_t i = 0; i < 64; ++i) {
-    if (bitset & (1ULL << i)) {
-      result.push_back(i);
-    }
-  }
-  return result;
-};
-
 // _____________________________________________________________________________
 std::string toBitsetString(uint64_t x) {
   auto res = std::bitset<64>{x}.to_string();
@@ -95,21 +66,21 @@ size_t countSubgraphsRecursively(const Graph& graph, uint64_t nodes,
   // ignored
   uint64_t neighbors = computeNeighbors(graph, nodes, ignored);
 
-  std::vector<uint8_t> neighborsAsVector = bitsetToVector(neighbors);
-
   // This is the recursion level which handles all the subsets of the neigrbors,
   // and the above recursion levels deal with `nodes`, so we have to exclude
   // them further down.
   auto newIgnored = ignored | neighbors | nodes;
 
-  //   Iterate over all Subsets of the neighbors
-  size_t upperBound = 1ULL << neighborsAsVector.size();
-  for (size_t i = 1; i < upperBound; ++i) {
+  // Iterate over all non-empty subsets of the neighbors. `(subset - neighbors)
+  // & neighbors` is the next subset in the order of the binary numbers (when
+  // only the bits of `neighbors` are considered), so no memory has to be
+  // allocated for the enumeration. For `neighbors == 0` there is no subset.
+  for (uint64_t subset = neighbors & (~neighbors + 1); subset != 0;
+       subset = (subset - neighbors) & neighbors) {
     ++count;
     if (count > budget) {
       return budget + 1;
     }
-    auto subset = subsetIndexToBitmap(i, neighborsAsVector);
     count = countSubgraphsRecursively(graph, nodes | subset, newIgnored, count,
                                       budget);
   }
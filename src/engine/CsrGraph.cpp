@@ -0,0 +1,314 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/CsrGraph.h"
+
+#include <future>
+#include <numeric>
+
+#include "backports/algorithm.h"
+#include "global/RuntimeParameters.h"
+#include "util/ParallelExecutor.h"
+
+using ad_utility::MemorySize;
+using NodeIndex = CsrGraph::NodeIndex;
+
+namespace {
+// Fill the `offsets` and the `adjacent` nodes of a CSR representation of the
+// `edges`, where each edge is stored at its source (`bySource == true`) or at
+// its target.
+void buildAdjacency(size_t numNodes,
+                    const std::vector<std::pair<NodeIndex, NodeIndex>>& edges,
+                    bool bySource, std::vector<uint64_t>& offsets,
+                    std::vector<NodeIndex>& adjacent) {
+  offsets.assign(numNodes + 1, 0);
+  for (const auto& [source, target] : edges) {
+    ++offsets[(bySource ? source : target) + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  adjacent.resize(edges.size());
+  std::vector<uint64_t> next(offsets.begin(), offsets.end() - 1);
+  for (const auto& [source, target] : edges) {
+    auto from = bySource ? source : target;
+    adjacent[next[from]++] = bySource ? target : source;
+  }
+}
+
+// Split the range `[0, size)` into at most `numThreads` ranges of consecutive
+// elements and call `function(threadIndex, begin, end)` for each of them
+// concurrently. The `threadIndex` is smaller than `numThreads`.
+template <typename F>
+void forEachRangeInParallel(size_t size, size_t numThreads,
+                            const F& function) {
+  numThreads = std::max(size_t{1}, std::min(numThreads, size));
+  if (numThreads == 1) {
+    function(size_t{0}, size_t{0}, size);
+    return;
+  }
+  const size_t chunkSize = (size + numThreads - 1) / numThreads;
+  std::vector<std::packaged_task<void()>> tasks;
+  for (size_t i = 0; i * chunkSize < size; ++i) {
+    tasks.emplace_back([&function, i, chunkSize, size]() {
+      function(i, i * chunkSize, std::min((i + 1) * chunkSize, size));
+    });
+  }
+  ad_utility::runTasksInParallel(std::move(tasks));
+}
+}  // namespace
+
+// _____________________________________________________________________________
+CsrGraph::CsrGraph(const IdTable& table, ColumnIndex sourceColumn,
+                   ColumnIndex targetColumn) {
+  auto sources = table.getColumn(sourceColumn);
+  auto targets = table.getColumn(targetColumn);
+  auto isEdge = [&sources, &targets](size_t row) {
+    return !sources[row].isUndefined() && !targets[row].isUndefined();
+  };
+  nodes_.reserve(2 * table.numRows());
+  for (size_t row = 0; row < table.numRows(); ++row) {
+    if (isEdge(row)) {
+      nodes_.push_back(sources[row]);
+      nodes_.push_back(targets[row]);
+    }
+  }
+  ql::ranges::sort(nodes_);
+  nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+  nodes_.shrink_to_fit();
+
+  std::vector<std::pair<NodeIndex, NodeIndex>> edges;
+  edges.reserve(table.numRows());
+  auto indexOf = [this](Id id) {
+    return static_cast<NodeIndex>(
+        ql::ranges::lower_bound(nodes_, id) - nodes_.begin());
+  };
+  for (size_t row = 0; row < table.numRows(); ++row) {
+    if (isEdge(row)) {
+      edges.emplace_back(indexOf(sources[row]), indexOf(targets[row]));
+    }
+  }
+  buildAdjacency(nodes_.size(), edges, true, successorOffsets_, successors_);
+  buildAdjacency(nodes_.size(), edges, false, predecessorOffsets_,
+                 predecessors_);
+}
+
+// _____________________________________________________________________________
+std::optional<NodeIndex> CsrGraph::findNode(Id id) const {
+  auto it = ql::ranges::lower_bound(nodes_, id);
+  if (it == nodes_.end() || *it != id) {
+    return std::nullopt;
+  }
+  return static_cast<NodeIndex>(it - nodes_.begin());
+}
+
+// _____________________________________________________________________________
+MemorySize CsrGraph::memorySize() const {
+  size_t numOffsets = successorOffsets_.size() + predecessorOffsets_.size();
+  size_t numAdjacent = successors_.size() + predecessors_.size();
+  return MemorySize::bytes(sizeof(CsrGraph) + nodes_.size() * sizeof(Id) +
+                           numOffsets * sizeof(uint64_t) +
+                           numAdjacent * sizeof(NodeIndex));
+}
+
+// _____________________________________________________________________________
+std::vector<double> csrGraph::pageRank(const CsrGraph& graph,
+                                       size_t numIterations,
+                                       double dampingFactor,
+                                       size_t numThreads) {
+  const size_t numNodes = graph.numNodes();
+  numThreads = std::max(numThreads, size_t{1});
+  if (numNodes == 0) {
+    return {};
+  }
+  std::vector<double> rank(numNodes, 1.0 / static_cast<double>(numNodes));
+  std::vector<double> nextRank(numNodes);
+  // The share of the rank of each node that each of its successors gets.
+  std::vector<double> contribution(numNodes);
+  std::vector<double> danglingRanks(numThreads);
+  for (size_t iteration = 0; iteration < numIterations; ++iteration) {
+    ql::ranges::fill(danglingRanks, 0.0);
+    forEachRangeInParallel(
+        numNodes, numThreads, [&](size_t thread, size_t begin, size_t end) {
+          for (NodeIndex node = begin; node < end; ++node) {
+            auto numSuccessors = graph.successors(node).size();
+            if (numSuccessors == 0) {
+              danglingRanks[thread] += rank[node];
+              contribution[node] = 0;
+            } else {
+              contribution[node] =
+                  rank[node] / static_cast<double>(numSuccessors);
+            }
+          }
+        });
+    double danglingRank =
+        std::accumulate(danglingRanks.begin(), danglingRanks.end(), 0.0);
+    double baseRank = ((1.0 - dampingFactor) + dampingFactor * danglingRank) /
+                      static_cast<double>(numNodes);
+    // Each thread only writes the ranks of its own nodes, so we can pull the
+    // contributions of the predecessors without synchronization.
+    forEachRangeInParallel(
+        numNodes, numThreads, [&](size_t, size_t begin, size_t end) {
+          for (NodeIndex node = begin; node < end; ++node) {
+            double sum = 0;
+            for (auto predecessor : graph.predecessors(node)) {
+              sum += contribution[predecessor];
+            }
+            nextRank[node] = baseRank + dampingFactor * sum;
+          }
+        });
+    std::swap(rank, nextRank);
+  }
+  return rank;
+}
+
+// _____________________________________________________________________________
+std::vector<NodeIndex> csrGraph::connectedComponents(const CsrGraph& graph,
+                                                     size_t numThreads) {
+  const size_t numNodes = graph.numNodes();
+  // The parent of each node is never larger than the node itself, so the root
+  // of each tree is its smallest node.
+  std::vector<std::atomic<NodeIndex>> parents(numNodes);
+  for (NodeIndex node = 0; node < numNodes; ++node) {
+    parents[node].store(node, std::memory_order_relaxed);
+  }
+  // Find the root of the `node` and halve the path on the way, which is safe
+  // because the grandparent is also an ancestor.
+  auto findRoot = [&parents](NodeIndex node) {
+    while (true) {
+      NodeIndex parent = parents[node].load();
+      if (parent == node) {
+        return node;
+      }
+      NodeIndex grandparent = parents[parent].load();
+      if (grandparent != parent) {
+        parents[node].compare_exchange_weak(parent, grandparent);
+      }
+      node = grandparent;
+    }
+  };
+  // Link the larger of the two roots to the smaller one. If the larger root
+  // has been linked concurrently by another thread, try again.
+  auto unite = [&parents, &findRoot](NodeIndex a, NodeIndex b) {
+    while (true) {
+      a = findRoot(a);
+      b = findRoot(b);
+      if (a == b) {
+        return;
+      }
+      if (a < b) {
+        std::swap(a, b);
+      }
+      NodeIndex expected = a;
+      if (parents[a].compare_exchange_strong(expected, b)) {
+        return;
+      }
+    }
+  };
+  forEachRangeInParallel(numNodes, numThreads,
+                         [&](size_t, size_t begin, size_t end) {
+                           for (NodeIndex node = begin; node < end; ++node) {
+                             for (auto successor : graph.successors(node)) {
+                               unite(node, successor);
+                             }
+                           }
+                         });
+  std::vector<NodeIndex> components(numNodes);
+  forEachRangeInParallel(numNodes, numThreads,
+                         [&](size_t, size_t begin, size_t end) {
+                           for (NodeIndex node = begin; node < end; ++node) {
+                             components[node] = findRoot(node);
+                           }
+                         });
+  return components;
+}
+
+// _____________________________________________________________________________
+std::vector<std::optional<size_t>> csrGraph::kHopNeighborhood(
+    const CsrGraph& graph, const std::vector<NodeIndex>& startNodes,
+    size_t maxNumHops, size_t numThreads) {
+  const size_t numNodes = graph.numNodes();
+  numThreads = std::max(numThreads, size_t{1});
+  std::vector<std::optional<size_t>> numHops(numNodes);
+  // The flag for each node is set by the (single) thread that visits it
+  // first, so only this thread writes its number of hops.
+  std::vector<std::atomic<bool>> isVisited(numNodes);
+  std::vector<NodeIndex> frontier;
+  for (auto node : startNodes) {
+    AD_CONTRACT_CHECK(node < numNodes);
+    if (!isVisited[node].exchange(true)) {
+      numHops[node] = 0;
+      frontier.push_back(node);
+    }
+  }
+  for (size_t hop = 1; hop <= maxNumHops && !frontier.empty(); ++hop) {
+    std::vector<std::vector<NodeIndex>> nextFrontiers(numThreads);
+    forEachRangeInParallel(
+        frontier.size(), numThreads,
+        [&](size_t thread, size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            for (auto successor : graph.successors(frontier[i])) {
+              if (!isVisited[successor].exchange(true)) {
+                numHops[successor] = hop;
+                nextFrontiers[thread].push_back(successor);
+              }
+            }
+          }
+        });
+    frontier.clear();
+    for (const auto& nextFrontier : nextFrontiers) {
+      frontier.insert(frontier.end(), nextFrontier.begin(),
+                      nextFrontier.end());
+    }
+  }
+  return numHops;
+}
+
+// _____________________________________________________________________________
+CsrGraphCache::CsrGraphCache(MemorySize maxSize)
+    : cache_{ad_utility::size_t_max, maxSize, maxSize} {}
+
+// _____________________________________________________________________________
+CsrGraphCache& CsrGraphCache::get() {
+  static CsrGraphCache cache{
+      getRuntimeParameter<&RuntimeParameters::csrGraphCacheMaxSize_>()};
+  return cache;
+}
+
+// _____________________________________________________________________________
+auto CsrGraphCache::lookup(const std::string& key) -> GraphPtr {
+  return (*cache_.wlock())[key];
+}
+
+// _____________________________________________________________________________
+auto CsrGraphCache::insert(const std::string& key, CsrGraph graph)
+    -> GraphPtr {
+  auto graphPtr = std::make_shared<CsrGraph>(std::move(graph));
+  auto lock = cache_.wlock();
+  // The graph might have been built concurrently by another query, in this
+  // case we keep the cached one.
+  if (auto cached = (*lock)[key]) {
+    return cached;
+  }
+  lock->insert(key, graphPtr);
+  return graphPtr;
+}
+
+// _____________________________________________________________________________
+void CsrGraphCache::setMaxSize(MemorySize maxSize) {
+  auto lock = cache_.wlock();
+  lock->setMaxSize(maxSize);
+  lock->setMaxSizeSingleEntry(maxSize);
+}
+
+// _____________________________________________________________________________
+void CsrGraphCache::clear() { cache_.wlock()->clearAll(); }
+
+// _____________________________________________________________________________
+size_t CsrGraphCache::numEntries() const {
+  return cache_.rlock()->numNonPinnedEntries();
+}
@@ -0,0 +1,158 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_CSRGRAPH_H
+#define QLEVER_SRC_ENGINE_CSRGRAPH_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "backports/span.h"
+#include "engine/idTable/IdTable.h"
+#include "global/Id.h"
+#include "util/Cache.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+// A directed graph in the compressed sparse row (CSR) format, built from two
+// columns (the sources and the targets of the edges) of an `IdTable`. The
+// nodes are the distinct defined `Id`s of both columns, sorted, and are
+// identified by their index in this order. For each node, the indices of its
+// successors are stored contiguously in `successors_`, the range of node `i`
+// starts at `successorOffsets_[i]` and ends at `successorOffsets_[i + 1]`. The
+// same holds for the predecessors, s.t. the algorithms can follow the edges
+// in both directions.
+class CsrGraph {
+ public:
+  using NodeIndex = uint64_t;
+
+ private:
+  std::vector<Id> nodes_;
+  std::vector<uint64_t> successorOffsets_;
+  std::vector<NodeIndex> successors_;
+  std::vector<uint64_t> predecessorOffsets_;
+  std::vector<NodeIndex> predecessors_;
+
+ public:
+  // Create an empty graph.
+  CsrGraph() : successorOffsets_{0}, predecessorOffsets_{0} {}
+
+  // Build the graph from the edges in the given columns of the `table`. Rows
+  // in which one of the columns is undefined are ignored.
+  CsrGraph(const IdTable& table, ColumnIndex sourceColumn,
+           ColumnIndex targetColumn);
+
+  size_t numNodes() const { return nodes_.size(); }
+  size_t numEdges() const { return successors_.size(); }
+
+  // The `Id` of the node with the given `index`, and the sorted `Id`s of all
+  // the nodes.
+  Id nodeId(NodeIndex index) const { return nodes_.at(index); }
+  const std::vector<Id>& nodes() const { return nodes_; }
+
+  // The index of the node with the given `id`, or `std::nullopt` if the `id`
+  // is not a node of the graph.
+  std::optional<NodeIndex> findNode(Id id) const;
+
+  // The targets of the edges that start at `node`, and the sources of the
+  // edges that end at `node`.
+  ql::span<const NodeIndex> successors(NodeIndex node) const {
+    return {successors_.data() + successorOffsets_[node],
+            successors_.data() + successorOffsets_[node + 1]};
+  }
+  ql::span<const NodeIndex> predecessors(NodeIndex node) const {
+    return {predecessors_.data() + predecessorOffsets_[node],
+            predecessors_.data() + predecessorOffsets_[node + 1]};
+  }
+
+  // The memory that is used by the graph, for the `CsrGraphCache`.
+  ad_utility::MemorySize memorySize() const;
+};
+
+// Parallel algorithms on a `CsrGraph`. All of them split the nodes into
+// `numThreads` ranges of consecutive nodes which are processed concurrently,
+// and return a value per node (in the order of `CsrGraph::nodes`), s.t. the
+// results don't depend on the number of threads (up to floating point
+// rounding for `pageRank`).
+namespace csrGraph {
+
+// The PageRank of each node, computed by `numIterations` iterations of the
+// power method with the given `dampingFactor`. The rank of nodes without
+// outgoing edges is distributed evenly over all nodes, s.t. the ranks always
+// sum up to one.
+std::vector<double> pageRank(const CsrGraph& graph, size_t numIterations,
+                             double dampingFactor, size_t numThreads);
+
+// The weakly connected components (the edges are followed in both
+// directions). Each node is mapped to the smallest index of a node in its
+// component. The components are computed by a concurrent union-find that
+// always links the larger root to the smaller one.
+std::vector<CsrGraph::NodeIndex> connectedComponents(const CsrGraph& graph,
+                                                     size_t numThreads);
+
+// The number of hops (following the direction of the edges) from the closest
+// of the `startNodes` to each node, or `std::nullopt` if the node can't be
+// reached with at most `maxNumHops` hops. The frontier of each level of the
+// breadth-first search is expanded in parallel.
+std::vector<std::optional<size_t>> kHopNeighborhood(
+    const CsrGraph& graph, const std::vector<CsrGraph::NodeIndex>& startNodes,
+    size_t maxNumHops, size_t numThreads);
+}  // namespace csrGraph
+
+// A process-wide, size-bounded LRU cache of `CsrGraph`s. The key is the cache
+// key of the subtree that computes the edges together with the columns of the
+// sources and targets, s.t. repeated analyses of the same edges (for example
+// the triples of the same predicate) neither have to evaluate the subtree nor
+// have to build the graph again. The cache keys of the subtrees contain the
+// snapshot of the located triples, so the cached graphs stay valid across
+// updates (but they are cleared anyway to free their memory).
+class CsrGraphCache {
+ public:
+  using GraphPtr = std::shared_ptr<const CsrGraph>;
+
+ private:
+  struct GraphSizeGetter {
+    ad_utility::MemorySize operator()(const CsrGraph& graph) const {
+      return graph.memorySize();
+    }
+  };
+  using Cache =
+      ad_utility::HeapBasedLRUCache<std::string, CsrGraph, GraphSizeGetter>;
+  ad_utility::Synchronized<Cache> cache_;
+
+ public:
+  explicit CsrGraphCache(ad_utility::MemorySize maxSize);
+
+  // The process-wide instance. Its size is the value of the runtime parameter
+  // `csr-graph-cache-max-size`.
+  static CsrGraphCache& get();
+
+  // Return the cached graph for `key`, or `nullptr` if it is not contained.
+  GraphPtr lookup(const std::string& key);
+
+  // Insert the `graph` for `key` and return it. If the `graph` is too large
+  // for the cache, it is returned without being inserted.
+  GraphPtr insert(const std::string& key, CsrGraph graph);
+
+  // Change the maximum size, least recently used graphs are evicted if
+  // necessary.
+  void setMaxSize(ad_utility::MemorySize maxSize);
+
+  // Remove all the graphs from the cache.
+  void clear();
+
+  size_t numEntries() const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_CSRGRAPH_H
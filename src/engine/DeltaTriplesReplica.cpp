@@ -0,0 +1,146 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/DeltaTriplesReplica.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <thread>
+
+#include "util/Log.h"
+
+// _____________________________________________________________________________
+void to_json(nlohmann::json& json, const DeltaTriplesReplica::Status& status) {
+  json = {{"applied-sequence-number", status.appliedSequenceNumber_},
+          {"primary-sequence-number", status.primarySequenceNumber_},
+          {"lag", status.lag()},
+          {"time-since-last-sync-ms", status.timeSinceLastSync_.count()},
+          {"error", status.error_}};
+}
+
+// _____________________________________________________________________________
+DeltaTriplesReplica::DeltaTriplesReplica(
+    DeltaTriplesManager& deltaTriplesManager, const LocalVocabContext& context,
+    FetchRecords fetchRecords, std::chrono::milliseconds pollInterval)
+    : deltaTriplesManager_{deltaTriplesManager},
+      context_{context},
+      fetchRecords_{std::move(fetchRecords)},
+      lastSync_{std::chrono::steady_clock::now().time_since_epoch().count()} {
+  deltaTriplesManager_.modify<void>(
+      [this](DeltaTriples& deltaTriples) {
+        for (Id::T bits : deltaTriples.localBlankNodes()) {
+          blankNodeMap_.emplace(bits, Id::fromBits(bits));
+        }
+      },
+      false, false);
+  thread_ = ad_utility::JThread{[this, pollInterval]() {
+    while (!stopRequested_) {
+      auto nextSync = std::chrono::steady_clock::now() + pollInterval;
+      while (!stopRequested_ && std::chrono::steady_clock::now() < nextSync) {
+        std::this_thread::sleep_for(stopPollInterval_);
+      }
+      if (stopRequested_ || !error_.rlock()->empty()) {
+        continue;
+      }
+      try {
+        synchronize();
+      } catch (const std::exception& e) {
+        AD_LOG_ERROR << "The replication of the updates from the primary "
+                        "failed and is stopped: "
+                     << e.what() << std::endl;
+        *error_.wlock() = e.what();
+      }
+    }
+  }};
+}
+
+// _____________________________________________________________________________
+DeltaTriplesReplica::~DeltaTriplesReplica() { stopRequested_ = true; }
+
+// _____________________________________________________________________________
+size_t DeltaTriplesReplica::synchronize() {
+  std::lock_guard lock{synchronizeMutex_};
+  auto records = DeltaTriplesReplicationLog::deserialize(
+      fetchRecords_(appliedSequenceNumber_));
+  primarySequenceNumber_ = records.latestSequenceNumber_;
+  uint64_t expected = appliedSequenceNumber_ + 1;
+  for (const auto& record : records.records_) {
+    if (record.sequenceNumber_ != expected++) {
+      throw std::runtime_error(absl::StrCat(
+          "The primary sent the record with sequence number ",
+          record.sequenceNumber_, " instead of ", expected - 1));
+    }
+  }
+  if (!records.records_.empty()) {
+    deltaTriplesManager_.modify<void>([this, &records](
+                                          DeltaTriples& deltaTriples) {
+      for (const auto& record : records.records_) {
+        applyRecord(deltaTriples, record);
+      }
+    });
+    appliedSequenceNumber_ = records.records_.back().sequenceNumber_;
+  }
+  lastSync_ = std::chrono::steady_clock::now().time_since_epoch().count();
+  return records.records_.size();
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesReplica::applyRecord(
+    DeltaTriples& deltaTriples,
+    const DeltaTriplesReplicationLog::Record& record) {
+  if (record.clearsDeltaTriples_) {
+    deltaTriples.clear();
+    blankNodeMap_.clear();
+  }
+  // The local vocab entries are copied to the local vocab of the
+  // `deltaTriples` when the triples are inserted.
+  LocalVocab localVocab;
+  auto entries =
+      DeltaTriplesWriteAheadLog::decodeRecord(record.content_, localVocab,
+                                              context_);
+  // The local blank nodes of the primary are consistently mapped to local
+  // blank nodes of the replica across all the records.
+  const auto minLocalBlankNode = context_.getBlankNodeManager()->minIndex_;
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  for (auto& entry : entries) {
+    for (auto& triple : entry.triples_) {
+      for (Id& id : triple.ids()) {
+        if (id.getDatatype() == Datatype::BlankNodeIndex &&
+            id.getBlankNodeIndex().get() >= minLocalBlankNode) {
+          auto [it, isNew] = blankNodeMap_.try_emplace(id.getBits(), id);
+          if (isNew) {
+            it->second = deltaTriples.makeLocalBlankNode();
+          }
+          id = it->second;
+        }
+      }
+    }
+    // `insertTriples` and `deleteTriples` require the triples to be sorted,
+    // and the order of the local vocab entries has changed.
+    auto& triples = entry.triples_;
+    ql::ranges::sort(triples);
+    triples.erase(std::unique(triples.begin(), triples.end()), triples.end());
+    if (entry.insertOrDelete_) {
+      deltaTriples.insertTriples(cancellationHandle, std::move(triples));
+    } else {
+      deltaTriples.deleteTriples(cancellationHandle, std::move(triples));
+    }
+  }
+}
+
+// _____________________________________________________________________________
+auto DeltaTriplesReplica::status() const -> Status {
+  auto lastSync = std::chrono::steady_clock::time_point{
+      std::chrono::steady_clock::duration{lastSync_.load()}};
+  return {appliedSequenceNumber_, primarySequenceNumber_,
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - lastSync),
+          *error_.rlock()};
+}
@@ -0,0 +1,110 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_DELTATRIPLESREPLICA_H
+#define QLEVER_SRC_ENGINE_DELTATRIPLESREPLICA_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "index/DeltaTriples.h"
+#include "index/DeltaTriplesReplicationLog.h"
+#include "util/HashMap.h"
+#include "util/Synchronized.h"
+#include "util/jthread.h"
+#include "util/json.h"
+
+// Keep the delta triples of a read replica in sync with those of a primary
+// server with the same index. A background thread regularly fetches the new
+// records of the `DeltaTriplesReplicationLog` of the primary and applies the
+// IDs of their triples directly, so the replica doesn't have to parse or
+// execute the SPARQL updates itself. The replica has to start with the same
+// delta triples as the primary had when it was started (e.g. a copy of its
+// index and its persisted updates), because the replication log only contains
+// the changes since then.
+//
+// If the replica can't catch up (because the primary has been restarted, or
+// has dropped records that the replica has not fetched yet), the
+// replication stops with an error, which is reported by `status`.
+class DeltaTriplesReplica {
+ public:
+  // Fetch the serialized `DeltaTriplesReplicationLog::Records` after the given
+  // sequence number from the primary. Throws if the request fails.
+  using FetchRecords = std::function<std::string(uint64_t sequenceNumber)>;
+
+  // The time to wait until `stopRequested_` is checked again.
+  static constexpr std::chrono::milliseconds stopPollInterval_{10};
+
+  // The state of the replication, reported by the `stats` command and the
+  // metrics.
+  struct Status {
+    uint64_t appliedSequenceNumber_ = 0;
+    uint64_t primarySequenceNumber_ = 0;
+    // The time since the last successful synchronization with the primary.
+    std::chrono::milliseconds timeSinceLastSync_{0};
+    std::string error_;
+
+    // The number of records of the primary that have not been applied yet.
+    uint64_t lag() const {
+      return primarySequenceNumber_ - appliedSequenceNumber_;
+    }
+
+    friend void to_json(nlohmann::json& json, const Status& status);
+  };
+
+ private:
+  DeltaTriplesManager& deltaTriplesManager_;
+  const LocalVocabContext& context_;
+  FetchRecords fetchRecords_;
+  // The local blank nodes of the primary (by the bits of their IDs) and the
+  // corresponding local blank nodes of the replica. The local blank nodes of
+  // the initial delta triples are the same on the primary and the replica.
+  ad_utility::HashMap<Id::T, Id> blankNodeMap_;
+  // Serializes the calls to `synchronize`.
+  std::mutex synchronizeMutex_;
+  std::atomic<uint64_t> appliedSequenceNumber_ = 0;
+  std::atomic<uint64_t> primarySequenceNumber_ = 0;
+  std::atomic<std::chrono::steady_clock::rep> lastSync_;
+  ad_utility::Synchronized<std::string> error_;
+  std::atomic<bool> stopRequested_ = false;
+  // Declared last, s.t. it is joined (in the destructor) before the other
+  // members are destroyed.
+  ad_utility::JThread thread_;
+
+ public:
+  // Start a thread that calls `synchronize` every `pollInterval`.
+  DeltaTriplesReplica(DeltaTriplesManager& deltaTriplesManager,
+                      const LocalVocabContext& context,
+                      FetchRecords fetchRecords,
+                      std::chrono::milliseconds pollInterval);
+
+  // Stop the replication and wait for the thread.
+  ~DeltaTriplesReplica();
+
+  DeltaTriplesReplica(const DeltaTriplesReplica&) = delete;
+  DeltaTriplesReplica& operator=(const DeltaTriplesReplica&) = delete;
+
+  // Fetch the new records from the primary and apply them, all of them with a
+  // single call to `DeltaTriplesManager::modify`. Return the number of applied
+  // records. Throws if the records can't be fetched or applied.
+  size_t synchronize();
+
+  Status status() const;
+
+ private:
+  // Apply the `record` to the `deltaTriples`.
+  void applyRecord(DeltaTriples& deltaTriples,
+                   const DeltaTriplesReplicationLog::Record& record);
+};
+
+#endif  // QLEVER_SRC_ENGINE_DELTATRIPLESREPLICA_H
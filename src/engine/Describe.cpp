@@ -9,6 +9,9 @@
 #include "engine/ExplicitIdTableOperation.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
+#include "global/RuntimeParameters.h"
+#include "util/ParallelExecutor.h"
+#include "util/ThreadBudget.h"
 
 // _____________________________________________________________________________
 Describe::Describe(QueryExecutionContext* qec,
@@ -95,7 +98,7 @@ VariableToColumnMap Describe::computeVariableToColumnMap() const {
           {V("?object"), col(2)}};
 }
 
-// A helper function for the recursive BFS. Return those `Id`s from `input` (an
+// A helper function for the BFS. Return those `Id`s from `input` (an
 // `IdTable` with one column) that are blank nodes and not in `alreadySeen`,
 // with duplicates removed. The returned `Id`s are added to `alreadySeen`.
 template <typename Allocator>
@@ -122,30 +125,76 @@ static IdTable getNewBlankNodes(
 }
 
 // _____________________________________________________________________________
-void Describe::recursivelyAddBlankNodes(
-    IdTable& finalResult, LocalVocab& localVocab,
-    ad_utility::HashSetWithMemoryLimit<Id>& alreadySeen, IdTable blankNodes) {
-  AD_CORRECTNESS_CHECK(blankNodes.numColumns() == 1);
+Result::LazyResult Describe::computeRounds(const Result& resultOfWhereClause) {
+  using LC = Result::IdTableLoopControl;
+  LocalVocab localVocab;
+  auto resources = getIdsToDescribe(resultOfWhereClause, localVocab);
+  // The `localVocab` accumulates the local vocab IDs of all rounds, because
+  // the blank nodes of a round are the subjects of the next round.
+  auto get = [self = this, localVocab = std::move(localVocab),
+              resources = std::move(resources),
+              alreadySeen = ad_utility::HashSetWithMemoryLimit<Id>{
+                  allocator()}]() mutable {
+    // If there are no more resources to explore, we are done.
+    if (resources.empty()) {
+      return LC::makeBreak();
+    }
+    auto triples = self->expandResources(std::move(resources), localVocab);
+    resources =
+        getNewBlankNodes(self->allocator(), alreadySeen, triples.getColumn(2));
+    self->checkCancellation();
+    return LC::yieldValue(
+        Result::IdTableVocabPair{std::move(triples), localVocab.clone()});
+  };
+  return Result::LazyResult{
+      ad_utility::InputRangeFromLoopControlGet{std::move(get)}};
+}
+
+// _____________________________________________________________________________
+IdTable Describe::expandResources(IdTable resources,
+                                  LocalVocab& localVocab) const {
+  AD_CORRECTNESS_CHECK(resources.numColumns() == 1);
+  // Sort the resources, s.t. the `Join` doesn't have to sort them, and the
+  // chunks below are disjoint ranges of subjects.
+  auto column = resources.getColumn(0);
+  ql::ranges::sort(column);
+  resources.resize(std::unique(column.begin(), column.end()) - column.begin());
 
-  // If there are no more `blankNodes` to explore, we are done.
-  if (blankNodes.empty()) {
-    return;
+  const size_t numResources = resources.numRows();
+  auto threads = ad_utility::globalThreadBudget().reserve(std::min(
+      (numResources + minNumResourcesPerThread_ - 1) /
+          minNumResourcesPerThread_,
+      getRuntimeParameter<&RuntimeParameters::describeNumThreads_>()));
+  const size_t numThreads = threads.numThreads();
+  if (numThreads <= 1) {
+    return makeAndExecuteJoinWithFullIndex(std::move(resources), localVocab);
   }
 
-  // Expand the `blankNodes` by joining them with the full index and add the
-  // resulting triples to the `finalResult`.
-  //
-  // TODO<joka921> Make the result of DESCRIBE lazy, then we can avoid the
-  // additional copy here.
-  auto table =
-      makeAndExecuteJoinWithFullIndex(std::move(blankNodes), localVocab);
-  finalResult.insertAtEnd(table);
+  const size_t chunkSize = (numResources + numThreads - 1) / numThreads;
+  std::vector<std::optional<IdTable>> results(numThreads);
+  std::vector<LocalVocab> localVocabs(numThreads);
+  std::vector<std::packaged_task<void()>> tasks;
+  for (size_t i = 0; i * chunkSize < numResources; ++i) {
+    tasks.emplace_back([this, i, chunkSize, &resources, &results,
+                        &localVocabs]() {
+      IdTable chunk{1, allocator()};
+      chunk.insertAtEnd(resources, i * chunkSize,
+                        std::min((i + 1) * chunkSize, resources.numRows()));
+      results.at(i) =
+          makeAndExecuteJoinWithFullIndex(std::move(chunk), localVocabs.at(i));
+    });
+  }
+  ad_utility::runTasksInParallel(std::move(tasks));
 
-  // Compute the set of newly found blank nodes and recurse.
-  auto newBlankNodes =
-      getNewBlankNodes(allocator(), alreadySeen, table.getColumn(2));
-  recursivelyAddBlankNodes(finalResult, localVocab, alreadySeen,
-                           std::move(newBlankNodes));
+  // The chunks are disjoint, so the concatenation has no duplicates.
+  IdTable result{getResultWidth(), allocator()};
+  for (size_t i = 0; i < numThreads; ++i) {
+    if (results.at(i).has_value()) {
+      result.insertAtEnd(results.at(i).value());
+      localVocab.mergeWith(localVocabs.at(i));
+    }
+  }
+  return result;
 }
 
 // _____________________________________________________________________________
@@ -165,7 +214,7 @@ IdTable Describe::makeAndExecuteJoinWithFullIndex(
       VariableToColumnMap{
           {subjectVar,
            ColumnIndexAndTypeInfo{0, ColumnIndexAndTypeInfo::AlwaysDefined}}},
-      std::vector<ColumnIndex>{}, LocalVocab{},
+      std::vector<ColumnIndex>{0}, LocalVocab{},
       absl::StrCat("INTERNAL DESCRIBE ", uniqueCounter++));
   SparqlTripleSimple triple{subjectVar, V{"?predicate"}, V{"?object"}};
   auto activeGraphs = describe_.datasetClauses_.activeDefaultGraphs();
@@ -233,27 +282,23 @@ IdTable Describe::getIdsToDescribe(const Result& result,
 }
 
 // _____________________________________________________________________________
-Result Describe::computeResult([[maybe_unused]] bool requestLaziness) {
-  LocalVocab localVocab;
+Result Describe::computeResult(bool requestLaziness) {
   // Compute the results of the WHERE clause and extract the `Id`s to describe.
   //
   // TODO<joka921> Would we benefit from computing `resultOfWhereClause` lazily?
   // Probably not, because we have to deduplicate the whole input anyway.
   auto resultOfWhereClause = subtree_->getResult();
-  auto idsAsTable = getIdsToDescribe(*resultOfWhereClause, localVocab);
-
-  // Get all triples with the `Id`s as subject.
-  auto resultTable =
-      makeAndExecuteJoinWithFullIndex(std::move(idsAsTable), localVocab);
-
-  // Recursively follow all blank nodes.
-  ad_utility::HashSetWithMemoryLimit<Id> alreadySeen{allocator()};
-  auto blankNodes =
-      getNewBlankNodes(allocator(), alreadySeen, resultTable.getColumn(2));
-  recursivelyAddBlankNodes(resultTable, localVocab, alreadySeen,
-                           std::move(blankNodes));
-
-  return {std::move(resultTable), resultSortedOn(), std::move(localVocab)};
+  auto rounds = computeRounds(*resultOfWhereClause);
+  if (requestLaziness) {
+    return {std::move(rounds), resultSortedOn()};
+  }
+  IdTable result{getResultWidth(), allocator()};
+  LocalVocab localVocab;
+  for (auto& pair : rounds) {
+    result.insertAtEnd(pair.idTable_);
+    localVocab.mergeWith(pair.localVocab_);
+  }
+  return {std::move(result), resultSortedOn(), std::move(localVocab)};
 }
 
 // _____________________________________________________________________________
@@ -24,6 +24,10 @@ class Describe : public Operation {
   // The specification of the DESCRIBE clause.
   parsedQuery::Describe describe_;
 
+  // The minimal number of resources of a round that are expanded by a
+  // single thread, because starting threads doesn't pay off for fewer.
+  size_t minNumResourcesPerThread_ = 10'000;
+
  public:
   // Create a new DESCRIBE operation.
   Describe(QueryExecutionContext* qec,
@@ -33,6 +37,10 @@ class Describe : public Operation {
   // Getter for testing.
   const auto& getDescribe() const { return describe_; }
 
+  void setMinNumResourcesPerThreadForTesting(size_t value) {
+    minNumResourcesPerThread_ = value;
+  }
+
   // The following functions override those from the base class `Operation`.
   std::vector<QueryExecutionTree*> getChildren() override;
   std::string getCacheKeyImpl() const override;
@@ -53,22 +61,28 @@ class Describe : public Operation {
   Result computeResult(bool requestLaziness) override;
   VariableToColumnMap computeVariableToColumnMap() const override;
 
-  // Add all triples where the subject is one of the `blankNodes` (an `IdTable`
-  // with one column) to the `finalResult`. Recursively continue for all newly
-  // found blank nodes (objects of the newly found triples, which are not
-  // contained in `alreadySeen`). This is a recursive implementation of
-  // breadth-first-search (BFS) where `blankNodes` is the set of start nodes,
-  // and `alreadySeen` is the set of nodes which have already been explored,
-  // which is needed to handle cycles in the graph.
-  void recursivelyAddBlankNodes(
-      IdTable& finalResult, LocalVocab& localVocab,
-      ad_utility::HashSetWithMemoryLimit<Id>& alreadySeen, IdTable blankNodes);
-
-  // Join the `input` (an `IdTable` with one column) with the full index on the
-  // subject column. The result has three columns: the subject, predicate, and
-  // object of each triple, where the subject is contained in `input`. This
-  // includes delta triples with local vocab IDs, which are added to the
-  // `localVocab`.
+  // Lazily compute the triples of the DESCRIBE, with one `IdTable` per round
+  // of a breadth-first-search (BFS): The first round contains all triples
+  // where the subject is one of the resources to describe (see
+  // `getIdsToDescribe`). Each following round contains all triples where the
+  // subject is one of the blank nodes that were newly found as objects in the
+  // previous round (blank nodes which have already been explored are skipped,
+  // which is needed to handle cycles in the graph).
+  Result::LazyResult computeRounds(const Result& resultOfWhereClause);
+
+  // Return all triples where the subject is one of the `resources` (an
+  // `IdTable` with one column, the order and duplicates of which don't
+  // matter). The resources are sorted and split into chunks of consecutive
+  // resources, each of which is joined with the full index by a single thread
+  // (see `describe-num-threads`), so each chunk only reads the blocks of the
+  // index that contain its resources.
+  IdTable expandResources(IdTable resources, LocalVocab& localVocab) const;
+
+  // Join the `input` (an `IdTable` with one column, which must be sorted) with
+  // the full index on the subject column. The result has three columns: the
+  // subject, predicate, and object of each triple, where the subject is
+  // contained in `input`. This includes delta triples with local vocab IDs,
+  // which are added to the `localVocab`.
   IdTable makeAndExecuteJoinWithFullIndex(IdTable input,
                                           LocalVocab& localVocab) const;
 
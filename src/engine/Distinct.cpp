@@ -11,10 +11,17 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/Sort.h"
+#include "global/RuntimeParameters.h"
+#include "util/HashSet.h"
 
 using std::endl;
 using std::string;
 
+// `DISTINCT` is one of the hottest operations, so it is instantiated for more
+// widths than most other operations.
+static constexpr int maxWidth = MAX_NUM_COLUMNS_STATIC_ID_TABLE_HOT_OPERATORS;
+
 // _____________________________________________________________________________
 size_t Distinct::getResultWidth() const { return subtree_->getResultWidth(); }
 
@@ -24,10 +31,104 @@ Distinct::Distinct(QueryExecutionContext* qec,
                    const std::vector<ColumnIndex>& keepIndices)
     : Operation{qec}, subtree_{std::move(subtree)}, keepIndices_{keepIndices} {
   AD_CORRECTNESS_CHECK(subtree_);
-  subtree_ = QueryExecutionTree::createSortedTreeAnyPermutation(
-      std::move(subtree_), keepIndices_);
+  auto sortedSubtree = QueryExecutionTree::createSortedTreeAnyPermutation(
+      subtree_, keepIndices_);
+  // Only an explicit `Sort` is avoided by the hash-based distinct, other ways
+  // to obtain a sorted input (e.g. a different permutation of an `IndexScan`)
+  // are cheap.
+  useHashDistinct_ =
+      sortedSubtree != subtree_ &&
+      std::dynamic_pointer_cast<const Sort>(
+          sortedSubtree->getRootOperation()) != nullptr &&
+      isHashDistinctSuitable();
+  if (!useHashDistinct_) {
+    subtree_ = std::move(sortedSubtree);
+  }
+}
+
+// _____________________________________________________________________________
+bool Distinct::isHashDistinctSuitable() const {
+  auto maxNumRows =
+      getRuntimeParameter<&RuntimeParameters::hashDistinctMaxNumRows_>();
+  if (maxNumRows == 0) {
+    return false;
+  }
+  // The number of distinct rows is at most the product of the numbers of
+  // distinct values in the individual columns, and at most the size of the
+  // input.
+  auto size = static_cast<double>(subtree_->getSizeEstimate());
+  double numDistinctRows = 1.0;
+  for (ColumnIndex col : keepIndices_) {
+    numDistinctRows *= std::max(1.0, size / subtree_->getMultiplicity(col));
+    numDistinctRows = std::min(numDistinctRows, size);
+  }
+  return numDistinctRows <= static_cast<double>(maxNumRows);
 }
 
+// The rows (restricted to the `keepIndices_`) that have been seen so far by
+// the hash-based distinct. The rows are stored contiguously in `rows_`, and
+// `rowIndices_` is a hash set of the indices of these rows that hashes and
+// compares the referenced rows. The hash set refers to the state via a
+// pointer, so the state can neither be copied nor moved.
+struct Distinct::HashDistinctState {
+  // A row in `rows_` that can be hashed using `absl::Hash`.
+  struct RowView {
+    const Id* begin_;
+    size_t size_;
+    template <typename H>
+    friend H AbslHashValue(H h, const RowView& row) {
+      return H::combine_contiguous(std::move(h), row.begin_, row.size_);
+    }
+  };
+  struct Hash {
+    const HashDistinctState* state_;
+    size_t operator()(size_t row) const {
+      return absl::Hash<RowView>{}(state_->getRow(row));
+    }
+  };
+  struct Equal {
+    const HashDistinctState* state_;
+    bool operator()(size_t a, size_t b) const {
+      auto rowA = state_->getRow(a);
+      auto rowB = state_->getRow(b);
+      return std::equal(rowA.begin_, rowA.begin_ + rowA.size_, rowB.begin_);
+    }
+  };
+
+  size_t numColumns_;
+  size_t numRows_ = 0;
+  std::vector<Id, ad_utility::AllocatorWithLimit<Id>> rows_;
+  ad_utility::HashSetWithMemoryLimit<size_t, Hash, Equal> rowIndices_;
+
+  HashDistinctState(size_t numColumns,
+                    const ad_utility::AllocatorWithLimit<Id>& allocator)
+      : numColumns_{numColumns},
+        rows_{allocator},
+        rowIndices_{0, Hash{this}, Equal{this},
+                    ad_utility::AllocatorWithLimit<size_t>{allocator}} {}
+  HashDistinctState(const HashDistinctState&) = delete;
+  HashDistinctState& operator=(const HashDistinctState&) = delete;
+
+  RowView getRow(size_t row) const {
+    return {rows_.data() + row * numColumns_, numColumns_};
+  }
+
+  // Add the `columns` of the `row` to the state. Return false iff these
+  // values have been seen before.
+  template <typename Row>
+  bool insert(const Row& row, const std::vector<ColumnIndex>& columns) {
+    for (ColumnIndex col : columns) {
+      rows_.push_back(row[col]);
+    }
+    if (rowIndices_.insert(numRows_).second) {
+      ++numRows_;
+      return true;
+    }
+    rows_.resize(rows_.size() - numColumns_);
+    return false;
+  }
+};
+
 // _____________________________________________________________________________
 string Distinct::getCacheKeyImpl() const {
   return absl::StrCat("DISTINCT (", subtree_->getCacheKey(), ") (",
@@ -46,7 +147,6 @@ VariableToColumnMap Distinct::computeVariableToColumnMap() const {
 template <size_t WIDTH>
 Result::LazyResult Distinct::lazyDistinct(Result::LazyResult input,
                                           bool yieldOnce) const {
-  using namespace ad_utility;
   auto getDistinctResult =
       [this,
        previousRow = std::optional<typename IdTableStatic<WIDTH>::row_type>{
@@ -58,6 +158,30 @@ Result::LazyResult Distinct::lazyDistinct(Result::LazyResult input,
         return result;
       };
 
+  return transformLazyDistinct(std::move(input), yieldOnce,
+                               std::move(getDistinctResult));
+}
+
+// _____________________________________________________________________________
+template <size_t WIDTH>
+Result::LazyResult Distinct::lazyHashDistinct(Result::LazyResult input,
+                                              bool yieldOnce) const {
+  auto getDistinctResult =
+      [this, state = std::make_shared<HashDistinctState>(keepIndices_.size(),
+                                                         allocator())](
+          IdTable&& idTable) {
+        return this->hashDistinct<WIDTH>(std::move(idTable), *state);
+      };
+  return transformLazyDistinct(std::move(input), yieldOnce,
+                               std::move(getDistinctResult));
+}
+
+// _____________________________________________________________________________
+template <typename F>
+Result::LazyResult Distinct::transformLazyDistinct(Result::LazyResult input,
+                                                   bool yieldOnce,
+                                                   F getDistinctResult) const {
+  using namespace ad_utility;
   if (yieldOnce) {
     return Result::LazyResult{lazySingleValueRange(
         [getDistinctResult,
@@ -95,9 +219,18 @@ Result Distinct::computeResult(bool requestLaziness) {
 
   AD_LOG_DEBUG << "Distinct result computation..." << endl;
   size_t width = subtree_->getResultWidth();
+  if (useHashDistinct_) {
+    runtimeInfo().addDetail("hash-distinct", true);
+  }
   if (subRes->isFullyMaterialized()) {
-    IdTable idTable =
-        ad_utility::callFixedSizeVi(width, [&, self = this](auto width) {
+    IdTable idTable = ad_utility::callFixedSizeVi<maxWidth>(
+        width, [&, self = this](auto width) {
+          if (self->useHashDistinct_) {
+            HashDistinctState state{self->keepIndices_.size(),
+                                    self->allocator()};
+            return self->hashDistinct<width>(subRes->idTable().clone(),
+                                             state);
+          }
           return self->outOfPlaceDistinct<width>(subRes->idTable());
         });
     AD_LOG_DEBUG << "Distinct result computation done." << endl;
@@ -105,8 +238,12 @@ Result Distinct::computeResult(bool requestLaziness) {
             subRes->getSharedLocalVocab()};
   }
 
-  auto generator =
-      ad_utility::callFixedSizeVi(width, [&, self = this](auto width) {
+  auto generator = ad_utility::callFixedSizeVi<maxWidth>(
+      width, [&, self = this](auto width) {
+        if (self->useHashDistinct_) {
+          return self->lazyHashDistinct<width>(subRes->idTables(),
+                                               !requestLaziness);
+        }
         return self->lazyDistinct<width>(subRes->idTables(), !requestLaziness);
       });
   return requestLaziness
@@ -176,6 +313,32 @@ IdTable Distinct::distinct(
   return std::move(result).toDynamic();
 }
 
+// _____________________________________________________________________________
+template <size_t WIDTH>
+IdTable Distinct::hashDistinct(IdTable dynInput,
+                               HashDistinctState& state) const {
+  AD_CONTRACT_CHECK(keepIndices_.size() <= dynInput.numColumns());
+  AD_LOG_DEBUG << "Hash distinct on " << dynInput.size() << " elements.\n";
+  IdTableStatic<WIDTH> result = std::move(dynInput).toStatic<WIDTH>();
+  auto dest = result.begin();
+  size_t numProcessedRows = 0;
+  for (auto it = result.begin(); it != result.end(); ++it) {
+    if (state.insert(*it, keepIndices_)) {
+      if (dest != it) {
+        *dest = std::move(*it);
+      }
+      ++dest;
+    }
+    if (++numProcessedRows % static_cast<size_t>(CHUNK_SIZE) == 0) {
+      checkCancellation();
+    }
+  }
+  result.erase(dest, result.end());
+  checkCancellation();
+  AD_LOG_DEBUG << "Hash distinct done.\n";
+  return std::move(result).toDynamic();
+}
+
 // _____________________________________________________________________________
 template <size_t WIDTH>
 IdTable Distinct::outOfPlaceDistinct(const IdTable& dynInput) const {
@@ -219,14 +382,18 @@ IdTable Distinct::outOfPlaceDistinct(const IdTable& dynInput) const {
 
 // _____________________________________________________________________________
 std::unique_ptr<Operation> Distinct::cloneImpl() const {
-  return std::make_unique<Distinct>(_executionContext, subtree_->clone(),
-                                    keepIndices_);
+  // Copy the operation (instead of calling the constructor) to keep the
+  // decision about the hash-based distinct.
+  auto copy = std::make_unique<Distinct>(*this);
+  copy->subtree_ = subtree_->clone();
+  return copy;
 }
 
 // ____________________________________________________________________________
 IdTable Distinct::outOfPlaceDistinctForTesting(const IdTable& input) const {
   size_t width = input.numColumns();
-  return ad_utility::callFixedSizeVi(width, [&, self = this](auto width) {
-    return self->outOfPlaceDistinct<width>(input);
-  });
+  return ad_utility::callFixedSizeVi<maxWidth>(
+      width, [&, self = this](auto width) {
+        return self->outOfPlaceDistinct<width>(input);
+      });
 }
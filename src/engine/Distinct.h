@@ -16,6 +16,13 @@ class Distinct : public Operation {
  private:
   std::shared_ptr<QueryExecutionTree> subtree_;
   std::vector<ColumnIndex> keepIndices_;
+  // If true, the `subtree_` is not sorted on the `keepIndices_` and the
+  // distinct rows are determined using a hash set (see
+  // `RuntimeParameters::hashDistinctMaxNumRows_`).
+  bool useHashDistinct_ = false;
+
+  // The state of the hash-based distinct, defined in `Distinct.cpp`.
+  struct HashDistinctState;
 
  public:
   static constexpr int64_t CHUNK_SIZE = 100'000;
@@ -37,6 +44,10 @@ class Distinct : public Operation {
     return keepIndices_;
   }
 
+  // Return true iff the distinct rows are determined using a hash set instead
+  // of sorting the input.
+  bool usesHashDistinct() const { return useHashDistinct_; }
+
   // Non-template wrapper around `outOfPlaceDistinct` for use in unit tests.
   // Dispatches to the right WIDTH via `callFixedSizeVi`.
   IdTable outOfPlaceDistinctForTesting(const IdTable& input) const;
@@ -97,6 +108,30 @@ class Distinct : public Operation {
   // if they're actually unique.
   template <size_t WIDTH>
   IdTable outOfPlaceDistinct(const IdTable& dynInput) const;
+
+  // Return true iff the result of the (unsorted) `subtree_` is estimated to
+  // have few enough distinct rows for the hash-based distinct.
+  bool isHashDistinctSuitable() const;
+
+  // Hash-based variant of `lazyDistinct` for inputs that are not sorted. Each
+  // `IdTable` of the result contains the rows of the corresponding `IdTable`
+  // of the `input` that have not been seen before (in the same order).
+  template <size_t WIDTH>
+  Result::LazyResult lazyHashDistinct(Result::LazyResult input,
+                                      bool yieldOnce) const;
+
+  // Remove all the rows from `dynInput` that are contained in the `state`,
+  // and add the remaining rows to the `state`.
+  template <size_t WIDTH>
+  IdTable hashDistinct(IdTable dynInput, HashDistinctState& state) const;
+
+  // Apply `getDistinctResult` (a function from `IdTable&&` to `IdTable`) to
+  // the `IdTables`s yielded by `input`. The `yieldOnce` flag has the same
+  // meaning as for `lazyDistinct`.
+  template <typename F>
+  Result::LazyResult transformLazyDistinct(Result::LazyResult input,
+                                           bool yieldOnce,
+                                           F getDistinctResult) const;
 };
 
 #endif  // QLEVER_SRC_ENGINE_DISTINCT_H
@@ -283,6 +283,17 @@ ExecuteUpdate::computeGraphUpdateQuads(
 // _____________________________________________________________________________
 void ExecuteUpdate::sortAndRemoveDuplicates(
     std::vector<IdTriple<>>& container) {
+  // Comparing `Id`s of new local vocab entries requires their position in the
+  // vocabulary, which is looked up in bulk before sorting.
+  std::vector<LocalVocabIndex> localVocabEntries;
+  for (const auto& triple : container) {
+    for (Id id : triple.ids()) {
+      if (id.getDatatype() == Datatype::LocalVocabIndex) {
+        localVocabEntries.push_back(id.getLocalVocabIndex());
+      }
+    }
+  }
+  LocalVocabEntry::computePositionsInVocab(localVocabEntries);
   ql::ranges::sort(container);
   container.erase(std::unique(container.begin(), container.end()),
                   container.end());
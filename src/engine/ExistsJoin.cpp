@@ -6,12 +6,15 @@
 
 #include "backports/three_way_comparison.h"
 #include "engine/CallFixedSize.h"
+#include "engine/IndexScan.h"
 #include "engine/JoinHelpers.h"
+#include "engine/JoinWithIndexScanHelpers.h"
 #include "engine/QueryPlanner.h"
 #include "engine/Result.h"
 #include "engine/Sort.h"
 #include "engine/sparqlExpressions/ExistsExpression.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
+#include "global/RuntimeParameters.h"
 #include "util/ChunkedForLoop.h"
 #include "util/JoinAlgorithms/IndexNestedLoopJoin.h"
 #include "util/JoinAlgorithms/JoinAlgorithms.h"
@@ -119,6 +122,17 @@ Result ExistsJoin::computeResult(bool requestLaziness) {
   // The lazy exists join implementation does only work if there's just a single
   // join column. This might be extended in the future.
   bool lazyJoinIsSupported = joinColumns_.size() == 1;
+
+  // If the right child is an `IndexScan` (which is then sorted on the join
+  // column), only read the blocks that are relevant for the left child.
+  if (getRuntimeParameter<&RuntimeParameters::prefilteredExistsJoin_>() &&
+      lazyJoinIsSupported && joinColumns_.at(0).at(1) == 0) {
+    if (auto indexScan =
+            std::dynamic_pointer_cast<IndexScan>(right_->getRootOperation())) {
+      return existsJoinWithIndexScan(left_->getResult(requestLaziness),
+                                     std::move(indexScan), requestLaziness);
+    }
+  }
   auto leftRes = left_->getResult(requestLaziness &&
                                   (noJoinNecessary || lazyJoinIsSupported));
   auto rightRes = right_->getResult(!noJoinNecessary && lazyJoinIsSupported);
@@ -414,6 +428,9 @@ struct LazyExistsJoinImpl
   // consumed, we can fast-forward and skip expensive checks.
   FastForwardState allRowsFromLeftExist_ = FastForwardState::Unknown;
 
+  // Called once when the left range has been completely consumed.
+  std::function<void()> onLeftExhausted_;
+
   // Convert result to an owned range of `IdTableVocabPair`s. This is used for
   // the left side.
   static Result::LazyResult toOwnedRange(
@@ -442,16 +459,17 @@ struct LazyExistsJoinImpl
 
   // Construct an instance of `LazyExistsJoinImpl` with the given left and right
   // join columns as well as the respective results.
-  explicit LazyExistsJoinImpl(std::shared_ptr<const Result> left,
-                              std::shared_ptr<const Result> right,
-                              ColumnIndex leftJoinColumn,
-                              ColumnIndex rightJoinColumn)
+  explicit LazyExistsJoinImpl(
+      std::shared_ptr<const Result> left, std::shared_ptr<const Result> right,
+      ColumnIndex leftJoinColumn, ColumnIndex rightJoinColumn,
+      std::function<void()> onLeftExhausted = ad_utility::noop)
       : left_{std::move(left)},
         right_{std::move(right)},
         leftRange_{toOwnedRange(left_)},
         rightRange_{toRangeView(right_)},
         leftJoinColumn_{leftJoinColumn},
-        rightJoinColumn_{rightJoinColumn} {}
+        rightJoinColumn_{rightJoinColumn},
+        onLeftExhausted_{std::move(onLeftExhausted)} {}
 
   // Fetch and store the next non-empty result from `rightRange_` in
   // `currentRight_`.
@@ -518,6 +536,9 @@ struct LazyExistsJoinImpl
     }
 
     auto result = leftRange_.get();
+    if (!result.has_value() && onLeftExhausted_) {
+      std::exchange(onLeftExhausted_, nullptr)();
+    }
 
     if (result.has_value()) {
       auto& idTable = result.value().idTable_;
@@ -567,6 +588,52 @@ Result ExistsJoin::lazyExistsJoin(std::shared_ptr<const Result> left,
                       resultSortedOn()};
 }
 
+// _____________________________________________________________________________
+Result ExistsJoin::existsJoinWithIndexScan(std::shared_ptr<const Result> left,
+                                           std::shared_ptr<IndexScan> rightScan,
+                                           bool requestLaziness) {
+  // Currently only supports a single join column.
+  AD_CORRECTNESS_CHECK(joinColumns_.size() == 1);
+  auto [leftCol, rightCol] = joinColumns_.at(0);
+  // The blocks of the scan are filtered by their first column.
+  AD_CORRECTNESS_CHECK(rightCol == 0);
+  AD_CONTRACT_CHECK(left->isFullyMaterialized() || requestLaziness);
+  if (left->isFullyMaterialized() && left->idTable().empty()) {
+    rightScan->updateRuntimeInformationWhenOptimizedOut();
+    IdTable result = left->idTable().clone();
+    result.addEmptyColumn();
+    return {std::move(result), resultSortedOn(), left->getSharedLocalVocab()};
+  }
+
+  // A fully materialized left side is treated as a single block. The rows of
+  // the left side must not be filtered, because the rows without a match are
+  // also part of the result.
+  Result::LazyResult leftRange =
+      left->isFullyMaterialized()
+          ? Result::LazyResult{std::array{Result::IdTableVocabPair{
+                left->idTable().clone(), left->getCopyOfLocalVocab()}}}
+          : left->idTables();
+  auto [leftSide, indexScanSide] =
+      rightScan->prefilterTables(std::move(leftRange), leftCol, false);
+  auto sortedOn = left->sortedBy();
+  left.reset();
+
+  auto setScanStatus = [rightScan]() {
+    qlever::joinWithIndexScanHelpers::setScanStatusToLazilyCompleted(
+        *rightScan);
+  };
+  Result::LazyResult generator{LazyExistsJoinImpl{
+      std::make_shared<const Result>(std::move(leftSide), std::move(sortedOn)),
+      std::make_shared<const Result>(std::move(indexScanSide),
+                                     rightScan->getResultSortedOn()),
+      leftCol, rightCol, std::move(setScanStatus)}};
+
+  return requestLaziness
+             ? Result{std::move(generator), resultSortedOn()}
+             : Result{ad_utility::getSingleElement(std::move(generator)),
+                      resultSortedOn()};
+}
+
 // _____________________________________________________________________________
 CPP_template_def(typename Range)(
     requires ql::ranges::input_range<Range>&& ql::ranges::sized_range<Range>&&
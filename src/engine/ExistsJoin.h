@@ -8,6 +8,8 @@
 #include "engine/Operation.h"
 #include "engine/QueryExecutionTree.h"
 
+class IndexScan;
+
 // The implementation of an "EXISTS join", which we use to realize the semantics
 // of the SPARQL `EXISTS` function. The join takes two subtrees as input, and
 // returns the left subtree with an additional boolean column that is `true` iff
@@ -116,6 +118,15 @@ class ExistsJoin : public Operation {
                         std::shared_ptr<const Result> right,
                         bool requestLaziness);
 
+  // Compute the exists join of `left` and the `rightScan` (which is the right
+  // child of this operation) on a single join column. Only the blocks of the
+  // scan that can contain the join values of `left` are read from disk (all
+  // the blocks if the join column of `left` contains UNDEF values). The result
+  // is lazy iff `requestLaziness` is true.
+  Result existsJoinWithIndexScan(std::shared_ptr<const Result> left,
+                                 std::shared_ptr<IndexScan> rightScan,
+                                 bool requestLaziness);
+
   // Helper function to modify the `IdTable` such that it gains a column
   // signaling if the values exist on the right or not.
   CPP_template(typename Range)(
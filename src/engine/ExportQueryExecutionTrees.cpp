@@ -22,6 +22,8 @@
 
 #include "backports/StartsWithAndEndsWith.h"
 #include "backports/algorithm.h"
+#include "engine/ArrowStreamWriter.h"
+#include "engine/BinaryExport.h"
 #include "engine/ConstructTripleGenerator.h"
 #include "global/RuntimeParameters.h"
 #include "index/EncodedIriManager.h"
@@ -29,6 +31,8 @@
 #include "index/IndexImpl.h"
 #include "rdfTypes/RdfEscaping.h"
 #include "util/ConstexprUtils.h"
+#include "util/StringBufferPool.h"
+#include "util/ThreadSafeQueue.h"
 #include "util/ValueIdentity.h"
 #include "util/http/MediaTypes.h"
 #include "util/json.h"
@@ -317,7 +321,8 @@ nlohmann::json idTableToQLeverJSONRow(
     }
     const auto& currentId = data(rowIndex, opt->columnIndex_);
     const auto& optionalStringAndXsdType = ql::exportIds::idToStringAndType(
-        qet.getQec()->getIndex(), currentId, localVocab);
+        qet.getQec()->getIndex(), currentId, localVocab, ql::identity{},
+        &qet.getQec()->vocabDecodeCache());
     if (!optionalStringAndXsdType.has_value()) {
       row.emplace_back(nullptr);
       continue;
@@ -444,6 +449,116 @@ ExportQueryExecutionTrees::selectQueryResultBindingsToQLeverJSON(
       resultSize, std::move(cancellationHandle)));
 }
 
+// _____________________________________________________________________________
+// The number of rows of a SELECT result that are formatted together by
+// `formatRowsInChunks`.
+static constexpr size_t EXPORT_CHUNK_SIZE = 1024;
+// The number of rows of a record batch of the Arrow export. Arrow-based tools
+// work best with large batches.
+static constexpr size_t ARROW_RECORD_BATCH_SIZE = 1 << 16;
+// The number of rows of a batch of the binary QLever export.
+static constexpr size_t BINARY_EXPORT_BATCH_SIZE = 1 << 14;
+
+using StringAndType = std::optional<std::pair<std::string, const char*>>;
+
+// The strings of all the `Id`s in the given `columns` of a contiguous chunk of
+// rows of an `IdTable`. The distinct `Id`s are sorted by their bits and
+// converted by a single call of `toStrings`, which typically calls
+// `ql::exportIds::idsToStringAndType`. That way the accesses to the on-disk
+// vocabulary are sequential, and `Id`s that occur in multiple rows of the
+// chunk are only converted once.
+class ChunkStrings {
+  std::vector<Id> ids_;
+  std::vector<StringAndType> strings_;
+
+ public:
+  template <typename ToStrings>
+  ChunkStrings(const IdTable& idTable, uint64_t beginRow, uint64_t endRow,
+               const std::vector<ColumnIndex>& columns,
+               const ToStrings& toStrings) {
+    ids_.reserve((endRow - beginRow) * columns.size());
+    for (ColumnIndex column : columns) {
+      auto col = idTable.getColumn(column);
+      ids_.insert(ids_.end(), col.begin() + beginRow, col.begin() + endRow);
+    }
+    // Comparing the bits is cheaper than the comparison of `Id`s (which
+    // compares the strings of `LocalVocabIndex` entries) and still sorts the
+    // `VocabIndex` IDs by their position in the vocabulary.
+    ql::ranges::sort(ids_, {}, &Id::getBits);
+    auto haveSameBits = [](Id a, Id b) { return a.getBits() == b.getBits(); };
+    ids_.erase(std::unique(ids_.begin(), ids_.end(), haveSameBits),
+               ids_.end());
+    strings_ = toStrings(ql::span<const Id>{ids_});
+    AD_CORRECTNESS_CHECK(strings_.size() == ids_.size());
+  }
+
+  // Return the string of the `id`, which must be contained in the chunk.
+  const StringAndType& operator()(Id id) const {
+    auto it = ql::ranges::lower_bound(ids_, id.getBits(), {}, &Id::getBits);
+    AD_CORRECTNESS_CHECK(it != ids_.end() && it->getBits() == id.getBits());
+    return strings_[it - ids_.begin()];
+  }
+};
+
+// Format the rows of the `table` in chunks of `chunkSize` rows and return the
+// formatted chunks in the order of the rows. The chunk of the rows
+// `[beginRow, endRow)` is formatted by `formatChunk(table.tableWithVocab_,
+// beginRow, endRow)`. If `numThreads > 1`, the chunks are formatted
+// concurrently by worker threads, so `formatChunk` has to be thread-safe. At
+// most two chunks per thread are buffered. Note that the `table` has to stay
+// valid until the returned range has been fully consumed or destroyed.
+template <typename FormatChunk,
+          typename Chunk = std::invoke_result_t<
+              const FormatChunk&, const TableConstRefWithVocab&, uint64_t,
+              uint64_t>>
+static InputRangeTypeErased<Chunk> formatRowsInChunks(
+    const TableWithRange& table, size_t numThreads,
+    const FormatChunk& formatChunk, size_t chunkSize = EXPORT_CHUNK_SIZE) {
+  const uint64_t numRows = ql::ranges::size(table.view_);
+  const uint64_t firstRow = numRows == 0 ? 0 : *ql::ranges::begin(table.view_);
+  const size_t numChunks = (numRows + chunkSize - 1) / chunkSize;
+  auto formatChunkWithIndex = [&table, &formatChunk, firstRow, numRows,
+                               chunkSize](size_t chunkIndex) {
+    const uint64_t beginRow = firstRow + chunkIndex * chunkSize;
+    const uint64_t endRow =
+        std::min<uint64_t>(beginRow + chunkSize, firstRow + numRows);
+    return formatChunk(table.tableWithVocab_, beginRow, endRow);
+  };
+
+  // Starting threads doesn't pay off for a single chunk.
+  if (numThreads <= 1 || numChunks <= 1) {
+    return InputRangeTypeErased<Chunk>{
+        ql::views::iota(size_t{0}, numChunks) |
+        ql::views::transform(std::move(formatChunkWithIndex))};
+  }
+  auto nextChunk = std::make_shared<std::atomic<size_t>>(0);
+  auto producer = [formatChunkWithIndex = std::move(formatChunkWithIndex),
+                   nextChunk, numChunks]()
+      -> std::optional<std::pair<size_t, Chunk>> {
+    size_t chunkIndex = (*nextChunk)++;
+    if (chunkIndex >= numChunks) {
+      return std::nullopt;
+    }
+    return std::pair{chunkIndex, formatChunkWithIndex(chunkIndex)};
+  };
+  const size_t numWorkers = std::min(numThreads, numChunks);
+  return ad_utility::data_structures::queueManager<
+      ad_utility::data_structures::OrderedThreadSafeQueue<Chunk>>(
+      2 * numWorkers, numWorkers, std::move(producer));
+}
+
+// Return the column indices of the defined columns among the `columns`.
+static std::vector<ColumnIndex> getDefinedColumnIndices(
+    const QueryExecutionTree::ColumnIndicesAndTypes& columns) {
+  std::vector<ColumnIndex> result;
+  for (const auto& column : columns) {
+    if (column.has_value()) {
+      result.push_back(column->columnIndex_);
+    }
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 template <ad_utility::MediaType format>
 STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream(
@@ -505,43 +620,60 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream(
   constexpr auto& escapeFunction = format == MediaType::tsv
                                        ? RdfEscaping::escapeForTsv
                                        : RdfEscaping::escapeForCsv;
-  uint64_t resultSize = 0;
-  for (const auto& [pair, range] :
-       getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t i : range) {
+  const auto& index = qet.getQec()->getIndex();
+  auto* decodeCache = &qet.getQec()->vocabDecodeCache();
+  const auto definedColumns = getDefinedColumnIndices(selectedColumnIndices);
+  auto formatChunk = [&index, decodeCache, &selectedColumnIndices,
+                      &definedColumns, &cancellationHandle](
+                         const TableConstRefWithVocab& pair, uint64_t beginRow,
+                         uint64_t endRow) {
+    cancellationHandle->throwIfCancelled();
+    ChunkStrings strings{
+        pair.idTable(), beginRow, endRow, definedColumns,
+        [&index, decodeCache, &pair](ql::span<const Id> ids) {
+          return ql::exportIds::idsToStringAndType<format == MediaType::csv>(
+              index, ids, pair.localVocab(), escapeFunction, decodeCache);
+        }};
+    std::string chunk;
+    for (uint64_t i = beginRow; i < endRow; ++i) {
       for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
         if (selectedColumnIndices[j].has_value()) {
           const auto& val = selectedColumnIndices[j].value();
-          Id id = pair.idTable()(i, val.columnIndex_);
-          auto optionalStringAndType =
-              ql::exportIds::idToStringAndType<format == MediaType::csv>(
-                  qet.getQec()->getIndex(), id, pair.localVocab(),
-                  escapeFunction);
+          const auto& optionalStringAndType =
+              strings(pair.idTable()(i, val.columnIndex_));
           if (optionalStringAndType.has_value()) [[likely]] {
-            STREAMABLE_YIELD(optionalStringAndType.value().first);
+            chunk.append(optionalStringAndType.value().first);
           }
         }
         if (j + 1 < selectedColumnIndices.size()) {
-          STREAMABLE_YIELD(separator);
+          chunk.push_back(separator);
         }
       }
-      STREAMABLE_YIELD('\n');
-      cancellationHandle->throwIfCancelled();
+      chunk.push_back('\n');
+    }
+    return chunk;
+  };
+  const size_t numThreads =
+      getRuntimeParameter<&RuntimeParameters::selectExportNumThreads_>();
+  uint64_t resultSize = 0;
+  for (const TableWithRange& table :
+       getRowIndices(limitAndOffset, *result, resultSize)) {
+    for (const std::string& chunk :
+         formatRowsInChunks(table, numThreads, formatChunk)) {
+      STREAMABLE_YIELD(chunk);
     }
   }
   AD_LOG_DEBUG << "Done creating readable result.\n";
 }
 
 // _____________________________________________________________________________
-// Convert a single ID to an XML binding of the given `variable`.
-template <typename IndexType, typename LocalVocabType>
-static std::string idToXMLBinding(std::string_view variable, Id id,
-                                  const IndexType& index,
-                                  const LocalVocabType& localVocab) {
+// Convert the string of a single ID (as returned by
+// `ql::exportIds::idToStringAndType`) to an XML binding of the given
+// `variable`.
+static std::string stringAndTypeToXMLBinding(
+    std::string_view variable, const StringAndType& optionalValue) {
   using namespace std::string_view_literals;
   using namespace std::string_literals;
-  const auto& optionalValue =
-      ql::exportIds::idToStringAndType(index, id, localVocab);
   if (!optionalValue.has_value()) {
     return ""s;
   }
@@ -640,21 +772,42 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
   auto selectedColumnIndices =
       qet.selectedVariablesToColumnIndices(selectClause, false);
   // TODO<joka921> we could prefilter for the nonexisting variables.
-  uint64_t resultSize = 0;
-  for (const auto& [pair, range] :
-       getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t i : range) {
-      STREAMABLE_YIELD("\n  <result>");
+  const auto& index = qet.getQec()->getIndex();
+  auto* decodeCache = &qet.getQec()->vocabDecodeCache();
+  const auto definedColumns = getDefinedColumnIndices(selectedColumnIndices);
+  auto formatChunk = [&index, decodeCache, &selectedColumnIndices,
+                      &definedColumns, &cancellationHandle](
+                         const TableConstRefWithVocab& pair, uint64_t beginRow,
+                         uint64_t endRow) {
+    cancellationHandle->throwIfCancelled();
+    ChunkStrings strings{pair.idTable(), beginRow, endRow, definedColumns,
+                         [&index, decodeCache, &pair](ql::span<const Id> ids) {
+                           return ql::exportIds::idsToStringAndType(
+                               index, ids, pair.localVocab(), ql::identity{},
+                               decodeCache);
+                         }};
+    std::string chunk;
+    for (uint64_t i = beginRow; i < endRow; ++i) {
+      chunk.append("\n  <result>");
       for (auto& selectedColIdx : selectedColumnIndices) {
         if (selectedColIdx.has_value()) {
           const auto& val = selectedColIdx.value();
-          Id id = pair.idTable()(i, val.columnIndex_);
-          STREAMABLE_YIELD(idToXMLBinding(
-              val.variable_, id, qet.getQec()->getIndex(), pair.localVocab()));
+          chunk.append(stringAndTypeToXMLBinding(
+              val.variable_, strings(pair.idTable()(i, val.columnIndex_))));
         }
       }
-      STREAMABLE_YIELD("\n  </result>");
-      cancellationHandle->throwIfCancelled();
+      chunk.append("\n  </result>");
+    }
+    return chunk;
+  };
+  const size_t numThreads =
+      getRuntimeParameter<&RuntimeParameters::selectExportNumThreads_>();
+  uint64_t resultSize = 0;
+  for (const TableWithRange& table :
+       getRowIndices(limitAndOffset, *result, resultSize)) {
+    for (const std::string& chunk :
+         formatRowsInChunks(table, numThreads, formatChunk)) {
+      STREAMABLE_YIELD(chunk);
     }
   }
   STREAMABLE_YIELD("\n</results>");
@@ -688,38 +841,56 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
       qet.selectedVariablesToColumnIndices(selectClause, false);
   ql::erase(columns, std::nullopt);
 
-  auto getBinding = [&](const TableConstRefWithVocab& pair, const uint64_t& i) {
-    auto binding = nlohmann::ordered_json::object();
-    for (const auto& column : columns) {
-      auto optionalStringAndType = ql::exportIds::idToStringAndType(
-          qet.getQec()->getIndex(), pair.idTable()(i, column->columnIndex_),
-          pair.localVocab());
-      if (optionalStringAndType.has_value()) [[likely]] {
-        const auto& [stringValue, xsdType] = optionalStringAndType.value();
-        binding[column->variable_] =
-            stringAndTypeToBinding(stringValue, xsdType);
+  const auto& index = qet.getQec()->getIndex();
+  auto* decodeCache = &qet.getQec()->vocabDecodeCache();
+  const auto definedColumns = getDefinedColumnIndices(columns);
+  // Format the bindings of the rows of a chunk, separated by commas. Note
+  // that when `columns` is empty, we have to output an empty set of bindings
+  // per row.
+  auto formatChunk = [&index, decodeCache, &columns, &definedColumns,
+                      &cancellationHandle](const TableConstRefWithVocab& pair,
+                                           uint64_t beginRow, uint64_t endRow) {
+    cancellationHandle->throwIfCancelled();
+    ChunkStrings strings{pair.idTable(), beginRow, endRow, definedColumns,
+                         [&index, decodeCache, &pair](ql::span<const Id> ids) {
+                           return ql::exportIds::idsToStringAndType(
+                               index, ids, pair.localVocab(), ql::identity{},
+                               decodeCache);
+                         }};
+    std::string chunk;
+    for (uint64_t i = beginRow; i < endRow; ++i) {
+      if (i != beginRow) [[likely]] {
+        chunk.push_back(',');
       }
+      auto binding = nlohmann::ordered_json::object();
+      for (const auto& column : columns) {
+        const auto& optionalStringAndType =
+            strings(pair.idTable()(i, column->columnIndex_));
+        if (optionalStringAndType.has_value()) [[likely]] {
+          const auto& [stringValue, xsdType] = optionalStringAndType.value();
+          binding[column->variable_] =
+              stringAndTypeToBinding(stringValue, xsdType);
+        }
+      }
+      chunk.append(binding.dump());
     }
-    return binding.dump();
+    return chunk;
   };
 
-  // Iterate over the result and yield the bindings. Note that when `columns`
-  // is empty, we have to output an empty set of bindings per row.
-  bool isFirstRow = true;
+  // Iterate over the result and yield the bindings.
+  const size_t numThreads =
+      getRuntimeParameter<&RuntimeParameters::selectExportNumThreads_>();
+  bool isFirstChunk = true;
   uint64_t resultSize = 0;
-  for (const auto& [pair, range] :
+  for (const TableWithRange& table :
        getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t i : range) {
-      if (!isFirstRow) [[likely]] {
+    for (const std::string& chunk :
+         formatRowsInChunks(table, numThreads, formatChunk)) {
+      if (!isFirstChunk) [[likely]] {
         STREAMABLE_YIELD(",");
       }
-      if (columns.empty()) {
-        STREAMABLE_YIELD("{}");
-      } else {
-        STREAMABLE_YIELD(getBinding(pair, i));
-      }
-      cancellationHandle->throwIfCancelled();
-      isFirstRow = false;
+      STREAMABLE_YIELD(chunk);
+      isFirstChunk = false;
     }
   }
 
@@ -736,19 +907,129 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
   STREAMABLE_RETURN;
 }
 
+// _____________________________________________________________________________
+template <>
+STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
+    ad_utility::MediaType::arrowStream>(
+    const QueryExecutionTree& qet,
+    const parsedQuery::SelectClause& selectClause,
+    LimitOffsetClause limitAndOffset, CancellationHandle cancellationHandle,
+    [[maybe_unused]] const ad_utility::Timer& requestTimer,
+    [[maybe_unused]] STREAMABLE_YIELDER_TYPE streamableYielder) {
+  namespace arrow = qlever::arrowExport;
+  // This call triggers the possibly expensive computation of the query result
+  // unless the result is already cached.
+  std::shared_ptr<const Result> result = qet.getResult(true);
+  result->logResultSize();
+
+  // The column names don't include the question mark.
+  auto columnNames = selectClause.getSelectedVariablesAsStrings();
+  ql::ranges::for_each(columnNames,
+                       [](std::string& var) { var = var.substr(1); });
+  STREAMABLE_YIELD(arrow::makeSchemaMessage(columnNames));
+
+  // Each chunk of rows becomes one record batch. The values are the same
+  // strings as for the TSV export (but without the escaping), variables that
+  // are not bound by the query and undefined values are exported as null.
+  auto selectedColumnIndices =
+      qet.selectedVariablesToColumnIndices(selectClause, true);
+  const auto& index = qet.getQec()->getIndex();
+  auto* decodeCache = &qet.getQec()->vocabDecodeCache();
+  const auto definedColumns = getDefinedColumnIndices(selectedColumnIndices);
+  auto formatChunk = [&index, decodeCache, &selectedColumnIndices,
+                      &definedColumns, &cancellationHandle](
+                         const TableConstRefWithVocab& pair, uint64_t beginRow,
+                         uint64_t endRow) {
+    cancellationHandle->throwIfCancelled();
+    ChunkStrings strings{pair.idTable(), beginRow, endRow, definedColumns,
+                         [&index, decodeCache, &pair](ql::span<const Id> ids) {
+                           return ql::exportIds::idsToStringAndType(
+                               index, ids, pair.localVocab(), ql::identity{},
+                               decodeCache);
+                         }};
+    arrow::RecordBatchBuilder recordBatch{selectedColumnIndices.size()};
+    for (uint64_t i = beginRow; i < endRow; ++i) {
+      for (const auto& column : selectedColumnIndices) {
+        std::optional<std::string_view> value;
+        if (column.has_value()) {
+          const auto& stringAndType =
+              strings(pair.idTable()(i, column->columnIndex_));
+          if (stringAndType.has_value()) {
+            value = stringAndType->first;
+          }
+        }
+        recordBatch.addValue(value);
+      }
+      recordBatch.finishRow();
+    }
+    return recordBatch.finish();
+  };
+  const size_t numThreads =
+      getRuntimeParameter<&RuntimeParameters::selectExportNumThreads_>();
+  uint64_t resultSize = 0;
+  for (const TableWithRange& table :
+       getRowIndices(limitAndOffset, *result, resultSize)) {
+    for (const std::string& recordBatch : formatRowsInChunks(
+             table, numThreads, formatChunk, ARROW_RECORD_BATCH_SIZE)) {
+      STREAMABLE_YIELD(recordBatch);
+    }
+  }
+  STREAMABLE_YIELD(arrow::makeEndOfStreamMarker());
+}
+
 // _____________________________________________________________________________
 template <>
 STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
     ad_utility::MediaType::binaryQleverExport>(
-    [[maybe_unused]] const QueryExecutionTree& qet,
-    [[maybe_unused]] const parsedQuery::SelectClause& selectClause,
-    [[maybe_unused]] LimitOffsetClause limitAndOffset,
-    [[maybe_unused]] CancellationHandle cancellationHandle,
+    const QueryExecutionTree& qet,
+    const parsedQuery::SelectClause& selectClause,
+    LimitOffsetClause limitAndOffset, CancellationHandle cancellationHandle,
     [[maybe_unused]] const ad_utility::Timer& requestTimer,
     [[maybe_unused]] STREAMABLE_YIELDER_TYPE streamableYielder) {
-  throw std::runtime_error(
-      "The binary export of QLever results is not yet implemented, please have "
-      "a little patience");
+  namespace binary = qlever::binary_export;
+  // This call triggers the possibly expensive computation of the query result
+  // unless the result is already cached.
+  std::shared_ptr<const Result> result = qet.getResult(true);
+  result->logResultSize();
+
+  // The column names don't include the question mark.
+  auto columnNames = selectClause.getSelectedVariablesAsStrings();
+  ql::ranges::for_each(columnNames,
+                       [](std::string& var) { var = var.substr(1); });
+  const bool keepVocabIds = qet.getQec()->binaryExportKeepsVocabIds_;
+  STREAMABLE_YIELD(binary::makeHeader(columnNames, keepVocabIds));
+
+  // Variables that are not bound by the query are exported as undefined
+  // columns.
+  std::vector<std::optional<ColumnIndex>> columns;
+  for (const auto& column :
+       qet.selectedVariablesToColumnIndices(selectClause, true)) {
+    columns.push_back(column.has_value()
+                          ? std::optional{column->columnIndex_}
+                          : std::nullopt);
+  }
+  const auto& index = qet.getQec()->getIndex();
+  // The strings of the batches are resolved concurrently, but the batches
+  // have to be added to the dictionary of the stream in order.
+  auto formatChunk = [&index, &columns, &cancellationHandle, keepVocabIds](
+                         const TableConstRefWithVocab& pair, uint64_t beginRow,
+                         uint64_t endRow) {
+    cancellationHandle->throwIfCancelled();
+    return binary::prepareBatch(index, pair.idTable(), columns, beginRow,
+                                endRow, keepVocabIds);
+  };
+  const size_t numThreads =
+      getRuntimeParameter<&RuntimeParameters::selectExportNumThreads_>();
+  binary::IncrementalStringMapping dictionary;
+  uint64_t resultSize = 0;
+  for (const TableWithRange& table :
+       getRowIndices(limitAndOffset, *result, resultSize)) {
+    for (auto& batch : formatRowsInChunks(
+             table, numThreads, formatChunk, BINARY_EXPORT_BATCH_SIZE)) {
+      STREAMABLE_YIELD(binary::makeBatch(dictionary, std::move(batch)));
+    }
+  }
+  STREAMABLE_YIELD(binary::makeEndMarker());
 }
 
 // _____________________________________________________________________________
@@ -762,12 +1043,14 @@ ExportQueryExecutionTrees::constructQueryResultToStream(
     [[maybe_unused]] STREAMABLE_YIELDER_TYPE streamableYielder) {
   using enum MediaType;
   static constexpr std::array supportedFormats{
-      octetStream, csv,        tsv,    sparqlXml,
-      sparqlJson,  qleverJson, turtle, binaryQleverExport};
+      octetStream, csv,    tsv,         sparqlXml, sparqlJson,
+      qleverJson,  turtle, binaryQleverExport, arrowStream};
   static_assert(ad_utility::contains(supportedFormats, format));
 
   if constexpr (format == octetStream || format == binaryQleverExport) {
     AD_THROW("Binary export is not supported for CONSTRUCT queries");
+  } else if constexpr (format == arrowStream) {
+    AD_THROW("Arrow export is not supported for CONSTRUCT queries");
   } else if constexpr (format == sparqlXml) {
     AD_THROW("XML export is currently not supported for CONSTRUCT queries");
   } else if constexpr (format == sparqlJson) {
@@ -820,7 +1103,10 @@ ExportQueryExecutionTrees::convertStreamGeneratorForChunkedTransfer(
         }
 
         try {
-          std::string output{*it};
+          // Copy the chunk into a recycled buffer, s.t. the large chunks
+          // don't have to be allocated (and page faulted) again and again.
+          std::string output = streams::httpResponseBufferPool().get();
+          output.append(*it);
           ++it;
           return LoopControl::yieldValue(std::move(output));
         } catch (const std::exception& e) {
@@ -883,15 +1169,15 @@ ExportQueryExecutionTrees::computeResult(
   using enum MediaType;
 
   static constexpr std::array supportedTypes{
-      csv,       tsv,        octetStream, turtle,
-      sparqlXml, sparqlJson, qleverJson,  binaryQleverExport};
+      csv,        tsv,        octetStream,        turtle,     sparqlXml,
+      sparqlJson, qleverJson, binaryQleverExport, arrowStream};
   AD_CORRECTNESS_CHECK(ad_utility::contains(supportedTypes, mediaType));
 
 #ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
-  auto inner =
-      ad_utility::ConstexprSwitch<csv, tsv, octetStream, turtle, sparqlXml,
-                                  sparqlJson, qleverJson, binaryQleverExport>{}(
-          compute, mediaType);
+  auto inner = ad_utility::ConstexprSwitch<csv, tsv, octetStream, turtle,
+                                           sparqlXml, sparqlJson, qleverJson,
+                                           binaryQleverExport, arrowStream>{}(
+      compute, mediaType);
 
   return [](auto range) -> cppcoro::generator<std::string> {
     for (auto&& item : range) {
@@ -901,7 +1187,8 @@ ExportQueryExecutionTrees::computeResult(
 
 #else
   ad_utility::ConstexprSwitch<csv, tsv, octetStream, turtle, sparqlXml,
-                              sparqlJson, qleverJson>{}(compute, mediaType);
+                              sparqlJson, qleverJson, arrowStream>{}(
+      compute, mediaType);
 #endif
 }
 
@@ -990,9 +1277,16 @@ ExportQueryExecutionTrees::computeResultAsQLeverJSON(
   // The `resultsize` is equal to `resultSizeTotal`. It is included for
   // backwards compatibility, in particular, because the QLever UI uses it
   // at many places.
+  auto& runtimeInfoWholeQuery =
+      qet.getRootOperation()->getRuntimeInfoWholeQuery();
+  auto decodeCacheStatistics = qet.getQec()->vocabDecodeCache().getStatistics();
+  runtimeInfoWholeQuery.numVocabDecodeCacheHits =
+      decodeCacheStatistics.numHits_;
+  runtimeInfoWholeQuery.numVocabDecodeCacheMisses =
+      decodeCacheStatistics.numMisses_;
   nlohmann::json jsonSuffix;
-  jsonSuffix["runtimeInformation"]["meta"] = nlohmann::ordered_json(
-      qet.getRootOperation()->getRuntimeInfoWholeQuery());
+  jsonSuffix["runtimeInformation"]["meta"] =
+      nlohmann::ordered_json(runtimeInfoWholeQuery);
   jsonSuffix["runtimeInformation"]["query_execution_tree"] =
       nlohmann::ordered_json(runtimeInformation);
   jsonSuffix["resultSizeExported"] = numBindingsExported;
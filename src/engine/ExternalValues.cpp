@@ -40,17 +40,13 @@ ExternalValues::ExternalValues(QueryExecutionContext* qec,
 
 // ____________________________________________________________________________
 std::string ExternalValues::getCacheKeyImpl() const {
-  // ExternalValues must only be used with caching disabled.
-  throw std::runtime_error(
-      "ExternalValues does not support cache keys. "
-      "Caching must be disabled when using externally specified values.");
+  // The key contains the values, s.t. results that were computed for other
+  // values are not reused.
+  return absl::StrCat("EXTERNAL ", Values::getCacheKeyImpl());
 }
 
 // ____________________________________________________________________________
 Result ExternalValues::computeResult(bool requestLaziness) {
-  AD_CONTRACT_CHECK(getExecutionContext()->disableCaching(),
-                    "ExternalValues can only be used when caching is disabled. "
-                    "Set the runtime parameter `disable-caching` to true.");
   return Values::computeResult(requestLaziness);
 }
 
@@ -22,9 +22,13 @@ struct ExternalValuesQuery;
 // SERVICE. It can be used via `libqlever` to implement repeated queries that
 // only differ in the contents of VALUES clauses without having to repeat the
 // query parsing and planning. For an example usage of this feature end-to-end
-// see `QLeverTest.cpp`. Note: `ExternalValues` can currently only be
-// used if caching is disabled (else an exception will be thrown from the
-// `getCacheKey` and `computeResult` member function).
+// see `QLeverTest.cpp`. The cache key contains the current values, s.t. the
+// results of the subtrees that don't depend on the values stay cached while
+// the subtrees that contain the `ExternalValues` are recomputed for new
+// values. Note: The cache keys of the subtrees are stored in the
+// `QueryExecutionTree`s, so when caching is enabled,
+// `QueryExecutionTree::updateCacheKeysRecursively` has to be called for the
+// root of the tree after `updateValues`.
 class ExternalValues : private Values, virtual public Operation {
  private:
   std::string name_;
@@ -56,7 +60,8 @@ class ExternalValues : private Values, virtual public Operation {
   // in the new values match the existing variables.
   void updateValues(parsedQuery::SparqlValues newValues);
 
-  // Override to ensure external values are never cached.
+  // The result of the values itself is cheap to compute and changes often, so
+  // it is never stored in the cache (the results of its ancestors may be).
   bool canResultBeCachedImpl() const override { return false; }
 
   // Override to ensure external values are never considered empty.
@@ -6,48 +6,184 @@
 
 #include "engine/Filter.h"
 
+#include <iterator>
+#include <numeric>
 #include <sstream>
 
 #include "backports/algorithm.h"
+#include "engine/Bind.h"
 #include "engine/CallFixedSize.h"
+#include "engine/ChunkedEvaluation.h"
 #include "engine/ExistsJoin.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/StripColumns.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
 #include "global/RuntimeParameters.h"
+#include "util/HashSet.h"
 
 using std::endl;
 
 // _____________________________________________________________________________
-size_t Filter::getResultWidth() const { return _subtree->getResultWidth(); }
+size_t Filter::getResultWidth() const { return outputColumns_.size(); }
 
 // _____________________________________________________________________________
 Filter::Filter(QueryExecutionContext* qec,
                std::shared_ptr<QueryExecutionTree> subtree,
-               sparqlExpression::SparqlExpressionPimpl expression)
+               sparqlExpression::SparqlExpressionPimpl expression,
+               std::optional<std::set<Variable>> variablesToKeep,
+               std::vector<parsedQuery::Bind> binds)
     : Operation(qec),
       _subtree(std::move(subtree)),
-      _expression{std::move(expression)} {
+      _expression{std::move(expression)},
+      variablesToKeep_{std::move(variablesToKeep)} {
   _subtree = ExistsJoin::addExistsJoinsToSubtree(
       _expression, std::move(_subtree), getExecutionContext(),
       cancellationHandle_);
+  fuseBinds(std::move(binds));
+  filterKernel_ =
+      sparqlExpression::FilterKernel::fromExpression(*_expression.getPimpl());
   if (getRuntimeParameter<&RuntimeParameters::enablePrefilterOnIndexScans_>()) {
     setPrefilterExpressionForChildren();
   }
+
+  // The columns of the `binds_` are appended to the columns of the `_subtree`.
+  inputVariableColumns_ = _subtree->getVariableColumns();
+  const size_t subtreeWidth = _subtree->getResultWidth();
+  for (size_t i = 0; i < binds_.size(); ++i) {
+    using enum ColumnIndexAndTypeInfo::UndefStatus;
+    const auto& bind = binds_[i];
+    auto status = bind._expression.isResultAlwaysDefined(inputVariableColumns_)
+                      ? AlwaysDefined
+                      : PossiblyUndefined;
+    auto [it, wasNew] = inputVariableColumns_.insert(
+        {bind._target, {subtreeWidth + i, status}});
+    AD_CORRECTNESS_CHECK(wasNew);
+  }
+
+  if (variablesToKeep_.has_value()) {
+    for (const auto& [variable, columnInfo] : inputVariableColumns_) {
+      if (ad_utility::contains(variablesToKeep_.value(), variable)) {
+        outputColumns_.push_back(columnInfo.columnIndex_);
+      }
+    }
+    ql::ranges::sort(outputColumns_);
+  } else {
+    outputColumns_.resize(subtreeWidth + binds_.size());
+    std::iota(outputColumns_.begin(), outputColumns_.end(), ColumnIndex{0});
+  }
+  if (numBindsForExpression_ == binds_.size()) {
+    columnsAfterFilter_ = outputColumns_;
+  } else {
+    columnsAfterFilter_.resize(subtreeWidth + numBindsForExpression_);
+    std::iota(columnsAfterFilter_.begin(), columnsAfterFilter_.end(),
+              ColumnIndex{0});
+  }
+}
+
+// _____________________________________________________________________________
+void Filter::fuseBinds(std::vector<parsedQuery::Bind> binds) {
+  // The `ExistsJoin`s for the `EXISTS` in the `_expression` are at the root of
+  // the `_subtree`, so no `BIND`s are fused in this case.
+  std::vector<parsedQuery::Bind> allBinds;
+  if (_expression.getExistsExpressions().empty() &&
+      getRuntimeParameter<&RuntimeParameters::enableBindFilterFusion_>()) {
+    while (const auto* bind =
+               dynamic_cast<const Bind*>(_subtree->getRootOperation().get())) {
+      if (!bind->canResultBeCached() ||
+          !bind->getLimitOffset().isUnconstrained()) {
+        break;
+      }
+      allBinds.push_back(bind->bind());
+      _subtree = bind->getSubtree();
+    }
+    ql::ranges::reverse(allBinds);
+  }
+  ql::ranges::move(binds, std::back_inserter(allBinds));
+
+  // A `BIND` is needed by the `_expression` if its target is used by the
+  // `_expression` or by another `BIND` that is needed. As a `BIND` can only
+  // use the targets of the previous ones, moving the needed ones to the front
+  // (in their original order) doesn't change the result.
+  ad_utility::HashSet<Variable> neededVariables;
+  for (const Variable* variable : _expression.containedVariables()) {
+    neededVariables.insert(*variable);
+  }
+  std::vector<bool> isNeeded(allBinds.size(), false);
+  for (size_t i = allBinds.size(); i-- > 0;) {
+    if (!neededVariables.contains(allBinds[i]._target)) {
+      continue;
+    }
+    isNeeded[i] = true;
+    for (const Variable* variable :
+         allBinds[i]._expression.containedVariables()) {
+      neededVariables.insert(*variable);
+    }
+  }
+  for (bool needed : {true, false}) {
+    for (size_t i = 0; i < allBinds.size(); ++i) {
+      if (isNeeded[i] == needed) {
+        binds_.push_back(std::move(allBinds[i]));
+      }
+    }
+    if (needed) {
+      numBindsForExpression_ = binds_.size();
+    }
+  }
+}
+
+// _____________________________________________________________________________
+IdTable Filter::appendBindColumns(IdTable idTable, size_t begin, size_t end,
+                                  LocalVocab* localVocab) const {
+  for (size_t i = begin; i < end; ++i) {
+    AD_CORRECTNESS_CHECK(idTable.numColumns() ==
+                         inputVariableColumns_.at(binds_[i]._target)
+                             .columnIndex_);
+    idTable = Bind::computeExpressionBind(
+        *getExecutionContext(), inputVariableColumns_, cancellationHandle_,
+        deadline_, localVocab, std::move(idTable),
+        binds_[i]._expression.getPimpl());
+    checkCancellation();
+  }
+  return idTable;
+}
+
+// _____________________________________________________________________________
+float Filter::getMultiplicity(size_t col) {
+  ColumnIndex column = outputColumns_.at(col);
+  if (column >= _subtree->getResultWidth()) {
+    // TODO<joka921> get a better multiplicity estimate for BINDs, see
+    // `Bind::getMultiplicity`.
+    return 1;
+  }
+  return _subtree->getMultiplicity(column);
 }
 
 // _____________________________________________________________________________
 std::string Filter::getCacheKeyImpl() const {
   std::ostringstream os;
   os << "FILTER " << _subtree->getCacheKey();
-  os << " with " << _expression.getCacheKey(_subtree->getVariableColumns());
+  for (const auto& bind : binds_) {
+    os << " BIND " << bind._expression.getCacheKey(inputVariableColumns_);
+  }
+  os << " with " << _expression.getCacheKey(inputVariableColumns_);
+  if (variablesToKeep_.has_value()) {
+    os << " keeping columns " << absl::StrJoin(outputColumns_, ",");
+  }
   return std::move(os).str();
 }
 
 //______________________________________________________________________________
 std::string Filter::getDescriptor() const {
-  return absl::StrCat("Filter ", _expression.getDescriptor());
+  if (binds_.empty()) {
+    return absl::StrCat("Filter ", _expression.getDescriptor());
+  }
+  return absl::StrCat(
+      "Filter ", _expression.getDescriptor(), " with ",
+      absl::StrJoin(binds_, ", ", [](std::string* out, const auto& bind) {
+        absl::StrAppend(out, bind.getDescriptor());
+      }));
 }
 
 //______________________________________________________________________________
@@ -70,35 +206,64 @@ Result Filter::computeResult(bool requestLaziness) {
   checkCancellation();
 
   if (subRes->isFullyMaterialized()) {
-    IdTable result = filterIdTable(subRes->sortedBy(), subRes->idTable());
+    if (!binds_.empty()) {
+      // The `binds_` might add words to the local vocab.
+      LocalVocab localVocab = subRes->getCopyOfLocalVocab();
+      IdTable result =
+          filterIdTable(subRes->sortedBy(), subRes->idTable(), &localVocab);
+      return {std::move(result), resultSortedOn(), std::move(localVocab)};
+    }
+    IdTable result =
+        filterIdTable(subRes->sortedBy(), subRes->idTable(), nullptr);
     AD_LOG_DEBUG << "Filter result computation done." << endl;
 
     return {std::move(result), resultSortedOn(), subRes->getSharedLocalVocab()};
   }
 
   if (requestLaziness) {
+    // The blocks are filtered independently of each other, so they can be
+    // processed concurrently.
+    auto filterBlock = [this, subRes](Result::IdTableVocabPair& pair) {
+      if (!binds_.empty()) {
+        // The `LocalVocab` disallows inserts if it doesn't own its
+        // `primaryWordSet` exclusively, see `Bind::computeResult`.
+        LocalVocab localVocab = pair.localVocab_.clone();
+        IdTable filteredTable = this->filterIdTable(
+            subRes->sortedBy(), std::move(pair.idTable_), &localVocab);
+        return Result::IdTableVocabPair{std::move(filteredTable),
+                                        std::move(localVocab)};
+      }
+      IdTable filteredTable =
+          this->filterIdTable(subRes->sortedBy(), pair.idTable_, nullptr);
+      return Result::IdTableVocabPair{std::move(filteredTable),
+                                      std::move(pair.localVocab_)};
+    };
+    auto sortedOn = resultSortedOn();
     return {Result::LazyResult{
-                ad_utility::OwningView{ad_utility::CachingTransformInputRange{
-                    subRes->idTables(),
-                    [this, subRes](auto& idTableVocabPair) {
-                      IdTable filteredTable = this->filterIdTable(
-                          subRes->sortedBy(), idTableVocabPair.idTable_);
-                      return Result::IdTableVocabPair{
-                          std::move(filteredTable),
-                          std::move(idTableVocabPair.localVocab_)};
-                    }}} |
-
+                ad_utility::OwningView{transformLazyResult(
+                    subRes->idTables(), std::move(filterBlock),
+                    !sortedOn.empty())} |
                 ql::views::filter(
                     [](const auto& pair) { return !pair.idTable_.empty(); })},
-            subRes->sortedBy()};
+            std::move(sortedOn)};
   }
 
   // If we receive a generator of IdTables, we need to materialize it into a
   // single IdTable.
-  size_t width = getSubtree().get()->getResultWidth();
+  size_t width = getResultWidth();
   IdTable result{width, getExecutionContext()->getAllocator()};
 
   LocalVocab resultLocalVocab{};
+  if (!binds_.empty()) {
+    // The `binds_` have to be evaluated for each block separately.
+    for (Result::IdTableVocabPair& pair : subRes->idTables()) {
+      resultLocalVocab.mergeWith(pair.localVocab_);
+      result.insertAtEnd(filterIdTable(
+          subRes->sortedBy(), std::move(pair.idTable_), &resultLocalVocab));
+      checkCancellation();
+    }
+    return {std::move(result), resultSortedOn(), std::move(resultLocalVocab)};
+  }
   ad_utility::callFixedSizeVi(
       width, [this, &subRes, &result, &resultLocalVocab](auto WIDTH) {
         for (Result::IdTableVocabPair& pair : subRes->idTables()) {
@@ -116,16 +281,44 @@ Result Filter::computeResult(bool requestLaziness) {
 // _____________________________________________________________________________
 CPP_template_def(typename Table)(requires ad_utility::SimilarTo<Table, IdTable>)
     IdTable Filter::filterIdTable(std::vector<ColumnIndex> sortedBy,
-                                  Table&& idTable) const {
-  size_t width = idTable.numColumns();
-  IdTable result{width, getExecutionContext()->getAllocator()};
+                                  Table&& idTable,
+                                  LocalVocab* localVocab) const {
+  AD_CORRECTNESS_CHECK(binds_.empty() || localVocab != nullptr);
+  size_t width = columnsAfterFilter_.size();
+  auto filterChunk = [this, width, &sortedBy](auto&& chunk,
+                                              LocalVocab& chunkLocalVocab) {
+    IdTable result{width, getExecutionContext()->getAllocator()};
+    auto impl = [this, &result, &sortedBy](auto WIDTH, auto&& input) {
+      return this->computeFilterImpl<WIDTH>(result, AD_FWD(input), sortedBy);
+    };
+    if (binds_.empty()) {
+      ad_utility::callFixedSizeVi(
+          width, [&impl, &chunk](auto WIDTH) { impl(WIDTH, AD_FWD(chunk)); });
+      return result;
+    }
 
-  auto impl = [this, &result, &idTable, &sortedBy](auto WIDTH) {
-    return this->computeFilterImpl<WIDTH>(result, AD_FWD(idTable),
-                                          std::move(sortedBy));
+    // Evaluate the `binds_` that are needed by the `_expression` on all rows,
+    // then filter, and then evaluate the remaining `binds_` on the rows that
+    // passed the filter.
+    IdTable input = appendBindColumns(AD_FWD(chunk).moveOrClone(), 0,
+                                      numBindsForExpression_, &chunkLocalVocab);
+    ad_utility::callFixedSizeVi(
+        width, [&impl, &input](auto WIDTH) { impl(WIDTH, std::move(input)); });
+    if (numBindsForExpression_ < binds_.size()) {
+      result = appendBindColumns(std::move(result), numBindsForExpression_,
+                                 binds_.size(), &chunkLocalVocab);
+      result.setColumnSubset(outputColumns_);
+    }
+    return result;
   };
-  ad_utility::callFixedSizeVi(width, impl);
-  return result;
+
+  // Large tables are split into chunks that are filtered concurrently (see
+  // `ChunkedEvaluation.h`). Without `binds_`, no words are added to the local
+  // vocab.
+  LocalVocab unusedLocalVocab;
+  return qlever::chunkedEvaluation::evaluateInParallelChunks(
+      AD_FWD(idTable), localVocab != nullptr ? *localVocab : unusedLocalVocab,
+      filterChunk);
 }
 
 // _____________________________________________________________________________
@@ -134,11 +327,11 @@ CPP_template_def(int WIDTH, typename Table)(
     computeFilterImpl(IdTable& dynamicResultTable, Table&& inputTable,
                       std::vector<ColumnIndex> sortedBy) const {
   LocalVocab dummyLocalVocab{};
-  AD_CONTRACT_CHECK(inputTable.numColumns() == WIDTH || WIDTH == 0);
+  AD_CONTRACT_CHECK(columnsAfterFilter_.size() == WIDTH || WIDTH == 0);
   IdTableStatic<WIDTH> resultTable =
       std::move(dynamicResultTable).toStatic<static_cast<size_t>(WIDTH)>();
   sparqlExpression::EvaluationContext evaluationContext(
-      *getExecutionContext(), _subtree->getVariableColumns(),
+      *getExecutionContext(), inputVariableColumns_,
       inputTable.template asStaticView<0>(),
       getExecutionContext()->getAllocator(), dummyLocalVocab,
       cancellationHandle_, deadline_);
@@ -146,8 +339,47 @@ CPP_template_def(int WIDTH, typename Table)(
   // TODO<joka921> This should be a mandatory argument to the
   // EvaluationContext constructor.
   evaluationContext._columnsByWhichResultIsSorted = std::move(sortedBy);
+  // The expression is evaluated on all the columns of the `inputTable`, but
+  // only the `columnsAfterFilter_` are copied to the result.
   const auto input =
-      evaluationContext._inputTable.asStaticView<static_cast<size_t>(WIDTH)>();
+      inputTable.asColumnSubsetView(columnsAfterFilter_)
+          .template asStaticView<static_cast<size_t>(WIDTH)>();
+
+  // Return the complete `inputTable` restricted to the `columnsAfterFilter_`,
+  // which is moved if possible.
+  auto completeInput = [this, &inputTable]() -> IdTable {
+    if (columnsAfterFilter_.size() == inputTable.numColumns()) {
+      return AD_FWD(inputTable).moveOrClone();
+    }
+    if constexpr (std::is_lvalue_reference_v<Table>) {
+      return inputTable.asColumnSubsetView(columnsAfterFilter_).clone();
+    } else {
+      IdTable table = std::move(inputTable);
+      table.setColumnSubset(columnsAfterFilter_);
+      return table;
+    }
+  };
+
+  // If the expression has one of the shapes that are supported by the
+  // `FilterKernel`, directly compute the selected rows and copy them column by
+  // column.
+  std::optional<sparqlExpression::FilterKernel::Selection> selection;
+  if (filterKernel_.has_value() &&
+      getRuntimeParameter<&RuntimeParameters::enableFilterKernels_>()) {
+    selection = filterKernel_->computeSelection(&evaluationContext);
+  }
+  if (selection.has_value()) {
+    checkCancellation();
+    if (resultTable.empty() && selection->size() == inputTable.size()) {
+      dynamicResultTable = completeInput();
+      return;
+    }
+    resultTable.insertSubsetAtEnd(input, selection.value());
+    checkCancellation();
+    dynamicResultTable = std::move(resultTable).toDynamic();
+    return;
+  }
+
   sparqlExpression::ExpressionResult expressionResult =
       _expression.getPimpl()->evaluate(&evaluationContext);
 
@@ -159,7 +391,8 @@ CPP_template_def(int WIDTH, typename Table)(
   // https://github.com/llvm/llvm-project/issues/61267
   auto computeResult = CPP_template_lambda(
       this, &resultTable = resultTable, &input, &inputTable,
-      &dynamicResultTable, &evaluationContext)(typename T)(T && singleResult)(
+      &dynamicResultTable, &evaluationContext,
+      &completeInput)(typename T)(T && singleResult)(
       requires sparqlExpression::SingleExpressionResult<T>) {
     if constexpr (std::is_same_v<T, ad_utility::SetOfIntervals>) {
       AD_CONTRACT_CHECK(input.size() == evaluationContext.size());
@@ -179,13 +412,13 @@ CPP_template_def(int WIDTH, typename Table)(
         // The binary filter contains all elements of the input, and we have
         // no previous results, so we can simply copy or move the complete
         // table.
-        dynamicResultTable = AD_FWD(inputTable).moveOrClone();
+        dynamicResultTable = completeInput();
         return;
       }
       checkCancellation();
       for (auto [intervalBegin, intervalEnd] : singleResult._intervals) {
         intervalEnd = std::min(intervalEnd, input.size());
-        resultTable.insertAtEnd(inputTable, intervalBegin, intervalEnd);
+        resultTable.insertAtEnd(input, intervalBegin, intervalEnd);
         checkCancellation();
       }
       AD_CORRECTNESS_CHECK(resultTable.size() == totalSize);
@@ -250,5 +483,82 @@ size_t Filter::getCostEstimate() {
 // _____________________________________________________________________________
 std::unique_ptr<Operation> Filter::cloneImpl() const {
   return std::make_unique<Filter>(_executionContext, _subtree->clone(),
-                                  _expression);
+                                  _expression, variablesToKeep_, binds_);
+}
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> Filter::resultSortedOn() const {
+  auto sortedOn = _subtree->resultSortedOn();
+  if (!variablesToKeep_.has_value()) {
+    return sortedOn;
+  }
+  // The result is sorted by the prefix of the sort columns that are kept.
+  std::vector<ColumnIndex> result;
+  for (ColumnIndex column : sortedOn) {
+    auto it = ql::ranges::find(outputColumns_, column);
+    if (it == outputColumns_.end()) {
+      break;
+    }
+    result.push_back(static_cast<ColumnIndex>(it - outputColumns_.begin()));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap Filter::computeVariableToColumnMap() const {
+  if (!variablesToKeep_.has_value()) {
+    return inputVariableColumns_;
+  }
+  VariableToColumnMap result;
+  for (const auto& [variable, columnInfo] : inputVariableColumns_) {
+    auto it = ql::ranges::find(outputColumns_, columnInfo.columnIndex_);
+    if (it != outputColumns_.end()) {
+      auto& info = result[variable];
+      info = columnInfo;
+      info.columnIndex_ = static_cast<ColumnIndex>(it - outputColumns_.begin());
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<std::shared_ptr<QueryExecutionTree>>
+Filter::makeTreeWithStrippedColumns(const std::set<Variable>& variables) const {
+  std::set<Variable> subtreeVariables = variables;
+  for (const Variable* variable : _expression.containedVariables()) {
+    subtreeVariables.insert(*variable);
+  }
+  for (const auto& bind : binds_) {
+    for (const Variable* variable : bind._expression.containedVariables()) {
+      subtreeVariables.insert(*variable);
+    }
+  }
+  for (const auto& bind : binds_) {
+    subtreeVariables.erase(bind._target);
+  }
+  // Only strip the columns of the `_subtree` if this can be done without an
+  // additional `StripColumns` operation, because that would copy all the rows,
+  // including the ones that are removed by this filter.
+  auto subtree = QueryExecutionTree::makeTreeWithStrippedColumns(
+      _subtree, subtreeVariables);
+  if (subtree != _subtree &&
+      dynamic_cast<const StripColumns*>(subtree->getRootOperation().get())) {
+    subtree = _subtree;
+  }
+  return ad_utility::makeExecutionTree<Filter>(
+      getExecutionContext(), std::move(subtree), _expression, variables,
+      binds_);
+}
+
+// _____________________________________________________________________________
+bool Filter::addRuntimeJoinFilter(
+    const Variable& variable, std::shared_ptr<const RuntimeJoinFilter> filter) {
+  if (!getLimitOffset().isUnconstrained() ||
+      !_subtree->isVariableCovered(variable) ||
+      !_subtree->getRootOperation()->addRuntimeJoinFilter(variable,
+                                                          std::move(filter))) {
+    return false;
+  }
+  disableStoringInCache();
+  return true;
 }
@@ -7,26 +7,63 @@
 #ifndef QLEVER_SRC_ENGINE_FILTER_H
 #define QLEVER_SRC_ENGINE_FILTER_H
 
+#include <optional>
+#include <set>
 #include <utility>
 #include <vector>
 
 #include "engine/Operation.h"
 #include "engine/QueryExecutionTree.h"
-
+#include "engine/sparqlExpressions/FilterKernels.h"
+#include "parser/GraphPatternOperation.h"
+
+// A FILTER. If the `_subtree` is a chain of `BIND`s, these are evaluated as
+// part of the filter (see `fuseBinds`), s.t. each block is processed in a
+// single pass and only the rows that pass the filter are written (once), and
+// the `BIND`s that are not needed by the `_expression` are only evaluated for
+// these rows.
 class Filter : public Operation {
   using PrefilterVariablePair = sparqlExpression::PrefilterExprVariablePair;
 
  private:
   std::shared_ptr<QueryExecutionTree> _subtree;
   sparqlExpression::SparqlExpressionPimpl _expression;
+  // The specialized implementation of the `_expression` if it has one of the
+  // supported shapes (see `FilterKernels.h`).
+  std::optional<sparqlExpression::FilterKernel> filterKernel_;
+  // If set, only the columns of these variables are part of the result. The
+  // other columns of the `_subtree` (e.g. the ones that are only needed to
+  // evaluate the `_expression`) are never copied. This is set by
+  // `makeTreeWithStrippedColumns`.
+  std::optional<std::set<Variable>> variablesToKeep_;
+  // The `BIND`s that are evaluated on the rows of the `_subtree`, in this
+  // order. The first `numBindsForExpression_` of them are needed to evaluate
+  // the `_expression` and are evaluated for all the rows, the remaining ones
+  // only for the rows that pass the filter.
+  std::vector<parsedQuery::Bind> binds_;
+  size_t numBindsForExpression_ = 0;
+  // The columns of the `_subtree`, followed by the columns of the `binds_`.
+  VariableToColumnMap inputVariableColumns_;
+  // The columns of the `_subtree` and the `binds_` that are part of the result
+  // (in this order).
+  std::vector<ColumnIndex> outputColumns_;
+  // The columns that are copied for the rows that pass the filter. These are
+  // the `outputColumns_`, unless there are `binds_` that are evaluated after
+  // the filter, which might need the other columns.
+  std::vector<ColumnIndex> columnsAfterFilter_;
 
  public:
   size_t getResultWidth() const override;
 
  public:
+  // The `binds` are evaluated on the `subtree` before the `expression` (after
+  // the `BIND`s at the root of the `subtree`, which are also fused into this
+  // filter).
   Filter(QueryExecutionContext* qec,
          std::shared_ptr<QueryExecutionTree> subtree,
-         sparqlExpression::SparqlExpressionPimpl expression);
+         sparqlExpression::SparqlExpressionPimpl expression,
+         std::optional<std::set<Variable>> variablesToKeep = std::nullopt,
+         std::vector<parsedQuery::Bind> binds = {});
 
  private:
   std::string getCacheKeyImpl() const override;
@@ -34,9 +71,21 @@ class Filter : public Operation {
  public:
   std::string getDescriptor() const override;
 
-  std::vector<ColumnIndex> resultSortedOn() const override {
-    return _subtree->resultSortedOn();
-  }
+  std::vector<ColumnIndex> resultSortedOn() const override;
+
+  // Strip the columns of all the variables that are neither contained in the
+  // `variables` nor in the `_expression` from the `_subtree` (if the root of
+  // the `_subtree` can do so without copying), and only copy the columns of
+  // the `variables` to the result.
+  std::optional<std::shared_ptr<QueryExecutionTree>>
+  makeTreeWithStrippedColumns(
+      const std::set<Variable>& variables) const override;
+
+  // The rows that are removed by a runtime join filter don't have to be
+  // evaluated by the `_expression`, so the filter is pushed to the `_subtree`.
+  bool addRuntimeJoinFilter(
+      const Variable& variable,
+      std::shared_ptr<const RuntimeJoinFilter> filter) override;
 
  private:
   uint64_t getSizeEstimateBeforeLimit() override;
@@ -45,22 +94,19 @@ class Filter : public Operation {
   size_t getCostEstimate() override;
 
   std::shared_ptr<QueryExecutionTree> getSubtree() const { return _subtree; };
+  const std::vector<parsedQuery::Bind>& getBinds() const { return binds_; }
   std::vector<QueryExecutionTree*> getChildren() override {
     return {_subtree.get()};
   }
 
   bool knownEmptyResult() override { return _subtree->knownEmptyResult(); }
 
-  float getMultiplicity(size_t col) override {
-    return _subtree->getMultiplicity(col);
-  }
+  float getMultiplicity(size_t col) override;
 
  private:
   std::unique_ptr<Operation> cloneImpl() const override;
 
-  VariableToColumnMap computeVariableToColumnMap() const override {
-    return _subtree->getVariableColumns();
-  }
+  VariableToColumnMap computeVariableToColumnMap() const override;
 
   // The method is directly invoked with the construction of this `Filter`
   // object. Its implementation retrieves <PrefilterExpression, Variable> pairs
@@ -70,6 +116,20 @@ class Filter : public Operation {
   // be updated.
   void setPrefilterExpressionForChildren();
 
+  // If the root of the `_subtree` is a `BIND` (and the runtime parameter
+  // `enable-bind-filter-fusion` is set), replace the `_subtree` by the child of
+  // the `BIND`, and evaluate the `BIND` as part of this filter, until the root
+  // is not a `BIND` anymore (unless the `_expression` contains `EXISTS`).
+  // Then append the `binds`, and order all of them
+  // s.t. the ones that are needed by the `_expression` come first.
+  void fuseBinds(std::vector<parsedQuery::Bind> binds);
+
+  // Evaluate the `binds_` in the range `[begin, end)` on the `idTable` (which
+  // must contain the columns of all the previous `binds_`) and append their
+  // results as new columns.
+  IdTable appendBindColumns(IdTable idTable, size_t begin, size_t end,
+                            LocalVocab* localVocab) const;
+
   Result computeResult(bool requestLaziness) override;
 
   // Perform the actual filter operation of the data provided.
@@ -80,10 +140,12 @@ class Filter : public Operation {
                                                   std::vector<ColumnIndex>
                                                       sortedBy) const;
 
-  // Run `computeFilterImpl` on the provided IdTable
+  // Run `computeFilterImpl` on the provided IdTable (and evaluate the `binds_`,
+  // the words of which are added to the `localVocab`).
   CPP_template(typename Table)(
       requires ad_utility::SimilarTo<Table, IdTable>) IdTable
-      filterIdTable(std::vector<ColumnIndex> sortedBy, Table&& idTable) const;
+      filterIdTable(std::vector<ColumnIndex> sortedBy, Table&& idTable,
+                    LocalVocab* localVocab) const;
 };
 
 #endif  // QLEVER_SRC_ENGINE_FILTER_H
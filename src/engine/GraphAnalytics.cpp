@@ -0,0 +1,236 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/GraphAnalytics.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "engine/CsrGraph.h"
+#include "engine/QueryExecutionTree.h"
+#include "global/RuntimeParameters.h"
+#include "util/ThreadBudget.h"
+
+// _____________________________________________________________________________
+std::string GraphAnalyticsConfiguration::toString() const {
+  std::ostringstream os;
+  switch (algorithm_) {
+    case GraphAnalyticsAlgorithm::PAGE_RANK:
+      // Use the full precision, s.t. different damping factors have different
+      // cache keys.
+      os << "Algorithm: PageRank, iterations: " << numIterations_
+         << ", damping factor: "
+         << std::setprecision(std::numeric_limits<double>::max_digits10)
+         << dampingFactor_ << '\n';
+      break;
+    case GraphAnalyticsAlgorithm::CONNECTED_COMPONENTS:
+      os << "Algorithm: Connected components" << '\n';
+      break;
+    case GraphAnalyticsAlgorithm::K_HOP_NEIGHBORHOOD:
+      os << "Algorithm: k-hop neighborhood, hops: " << maxNumHops_
+         << ", start: ";
+      for (auto id : startNodes_) {
+        os << id << ", ";
+      }
+      os << '\n';
+      break;
+  }
+  os << "Source: " << source_.toSparql() << '\n';
+  os << "Target: " << target_.toSparql() << '\n';
+  os << "Node: " << node_.toSparql() << '\n';
+  os << "Value: " << value_.toSparql() << '\n';
+  return std::move(os).str();
+}
+
+// _____________________________________________________________________________
+GraphAnalytics::GraphAnalytics(QueryExecutionContext* qec,
+                               std::shared_ptr<QueryExecutionTree> subtree,
+                               GraphAnalyticsConfiguration config)
+    : Operation(qec), subtree_(std::move(subtree)), config_(std::move(config)) {
+  AD_CORRECTNESS_CHECK(subtree_ != nullptr);
+  for (const auto& variable : {config_.source_, config_.target_}) {
+    if (!subtree_->isVariableCovered(variable)) {
+      throw std::runtime_error(absl::StrCat(
+          "The variable ", variable.toSparql(),
+          " of the graph analytics service is not bound by its graph "
+          "pattern"));
+    }
+  }
+  if (config_.node_ == config_.value_) {
+    throw std::runtime_error(
+        "The <node> and the <value> of the graph analytics service must be "
+        "different variables");
+  }
+}
+
+// _____________________________________________________________________________
+std::string GraphAnalytics::getCacheKeyImpl() const {
+  return absl::StrCat("GRAPH ANALYTICS\n", config_.toString(),
+                      "Edges:\n", getGraphCacheKey());
+}
+
+// _____________________________________________________________________________
+std::string GraphAnalytics::getGraphCacheKey() const {
+  return absl::StrCat(subtree_->getCacheKey(), "\nsource column: ",
+                      subtree_->getVariableColumn(config_.source_),
+                      ", target column: ",
+                      subtree_->getVariableColumn(config_.target_));
+}
+
+// _____________________________________________________________________________
+std::string GraphAnalytics::getDescriptor() const {
+  switch (config_.algorithm_) {
+    case GraphAnalyticsAlgorithm::PAGE_RANK:
+      return "GraphAnalytics PageRank";
+    case GraphAnalyticsAlgorithm::CONNECTED_COMPONENTS:
+      return "GraphAnalytics connected components";
+    case GraphAnalyticsAlgorithm::K_HOP_NEIGHBORHOOD:
+      return "GraphAnalytics k-hop neighborhood";
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+size_t GraphAnalytics::getCostEstimate() {
+  // Each iteration of PageRank touches all the edges once.
+  size_t numPasses =
+      config_.algorithm_ == GraphAnalyticsAlgorithm::PAGE_RANK
+          ? std::max(config_.numIterations_, size_t{1})
+          : 1;
+  return subtree_->getCostEstimate() +
+         numPasses * subtree_->getSizeEstimate();
+}
+
+// _____________________________________________________________________________
+uint64_t GraphAnalytics::getSizeEstimateBeforeLimit() {
+  // There is one row per node, and each edge has at most two nodes.
+  return subtree_->getSizeEstimate();
+}
+
+// _____________________________________________________________________________
+float GraphAnalytics::getMultiplicity(size_t col) {
+  // Each node occurs only once, the values might occur more often.
+  return col == 0 || config_.algorithm_ == GraphAnalyticsAlgorithm::PAGE_RANK
+             ? 1.0f
+             : subtree_->getMultiplicity(
+                   subtree_->getVariableColumn(config_.source_));
+}
+
+// _____________________________________________________________________________
+bool GraphAnalytics::knownEmptyResult() {
+  return subtree_->knownEmptyResult() ||
+         (config_.algorithm_ == GraphAnalyticsAlgorithm::K_HOP_NEIGHBORHOOD &&
+          config_.startNodes_.empty());
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap GraphAnalytics::computeVariableToColumnMap() const {
+  VariableToColumnMap map;
+  map[config_.node_] = makeAlwaysDefinedColumn(0);
+  map[config_.value_] = makeAlwaysDefinedColumn(1);
+  return map;
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<Operation> GraphAnalytics::cloneImpl() const {
+  auto copy = std::make_unique<GraphAnalytics>(*this);
+  copy->subtree_ = subtree_->clone();
+  return copy;
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const CsrGraph> GraphAnalytics::getGraph(
+    LocalVocab& localVocab) {
+  auto& cache = CsrGraphCache::get();
+  auto cacheKey = getGraphCacheKey();
+  if (auto graph = cache.lookup(cacheKey)) {
+    runtimeInfo().addDetail("graph-from-cache", true);
+    subtree_->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    return graph;
+  }
+  runtimeInfo().addDetail("graph-from-cache", false);
+  auto subResult = subtree_->getResult();
+  checkCancellation();
+  CsrGraph graph{subResult->idTable(),
+                 subtree_->getVariableColumn(config_.source_),
+                 subtree_->getVariableColumn(config_.target_)};
+  // The `Id`s of a local vocabulary are only valid together with this
+  // vocabulary, so such graphs can't be shared between queries.
+  if (!subResult->localVocab().empty()) {
+    localVocab = subResult->getCopyOfLocalVocab();
+    return std::make_shared<const CsrGraph>(std::move(graph));
+  }
+  return cache.insert(cacheKey, std::move(graph));
+}
+
+// _____________________________________________________________________________
+IdTable GraphAnalytics::runAlgorithm(const CsrGraph& graph) const {
+  const size_t numNodes = graph.numNodes();
+  auto threads = ad_utility::globalThreadBudget().reserve(std::min(
+      std::max((numNodes + minNumNodesPerThread_ - 1) / minNumNodesPerThread_,
+               size_t{1}),
+      getRuntimeParameter<&RuntimeParameters::graphAnalyticsNumThreads_>()));
+  const size_t numThreads = std::max(threads.numThreads(), size_t{1});
+
+  IdTable result{getResultWidth(), allocator()};
+  auto addRow = [&result](Id node, Id value) {
+    result.push_back({node, value});
+  };
+  switch (config_.algorithm_) {
+    case GraphAnalyticsAlgorithm::PAGE_RANK: {
+      auto ranks = csrGraph::pageRank(graph, config_.numIterations_,
+                                      config_.dampingFactor_, numThreads);
+      result.reserve(numNodes);
+      for (size_t node = 0; node < numNodes; ++node) {
+        addRow(graph.nodeId(node), Id::makeFromDouble(ranks[node]));
+      }
+      break;
+    }
+    case GraphAnalyticsAlgorithm::CONNECTED_COMPONENTS: {
+      auto components = csrGraph::connectedComponents(graph, numThreads);
+      result.reserve(numNodes);
+      for (size_t node = 0; node < numNodes; ++node) {
+        addRow(graph.nodeId(node), graph.nodeId(components[node]));
+      }
+      break;
+    }
+    case GraphAnalyticsAlgorithm::K_HOP_NEIGHBORHOOD: {
+      std::vector<CsrGraph::NodeIndex> startNodes;
+      for (auto id : config_.startNodes_) {
+        if (auto node = graph.findNode(id)) {
+          startNodes.push_back(node.value());
+        }
+      }
+      auto numHops = csrGraph::kHopNeighborhood(
+          graph, startNodes, config_.maxNumHops_, numThreads);
+      for (size_t node = 0; node < numNodes; ++node) {
+        if (numHops[node].has_value()) {
+          addRow(graph.nodeId(node),
+                 Id::makeFromInt(static_cast<int64_t>(numHops[node].value())));
+        }
+      }
+      break;
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+Result GraphAnalytics::computeResult([[maybe_unused]] bool requestLaziness) {
+  LocalVocab localVocab;
+  auto graph = getGraph(localVocab);
+  runtimeInfo().addDetail("num-nodes", graph->numNodes());
+  runtimeInfo().addDetail("num-edges", graph->numEdges());
+  checkCancellation();
+  IdTable result = runAlgorithm(*graph);
+  return {std::move(result), resultSortedOn(), std::move(localVocab)};
+}
@@ -0,0 +1,111 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_GRAPHANALYTICS_H
+#define QLEVER_SRC_ENGINE_GRAPHANALYTICS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "engine/Operation.h"
+#include "global/Id.h"
+#include "rdfTypes/Variable.h"
+
+class CsrGraph;
+
+enum class GraphAnalyticsAlgorithm {
+  PAGE_RANK,
+  CONNECTED_COMPONENTS,
+  K_HOP_NEIGHBORHOOD
+};
+
+// The parameters of a `GraphAnalytics` operation. The parameters that don't
+// belong to the `algorithm_` are ignored.
+struct GraphAnalyticsConfiguration {
+  GraphAnalyticsAlgorithm algorithm_;
+  // The variables of the sources and targets of the edges in the child.
+  Variable source_;
+  Variable target_;
+  // The variables of the result, the node and its computed value.
+  Variable node_;
+  Variable value_;
+  // The parameters of `PAGE_RANK`.
+  size_t numIterations_ = 20;
+  double dampingFactor_ = 0.85;
+  // The parameters of `K_HOP_NEIGHBORHOOD`.
+  std::vector<Id> startNodes_;
+  size_t maxNumHops_ = 1;
+
+  std::string toString() const;
+};
+
+// Run a graph algorithm on the graph that is formed by the edges from the
+// `source_` to the `target_` column of the `subtree`, and return one row
+// `(node, value)` per node, sorted by the node:
+//
+// * `PAGE_RANK`: The PageRank of the node, as a double.
+// * `CONNECTED_COMPONENTS`: The smallest node of the weakly connected
+//   component of the node.
+// * `K_HOP_NEIGHBORHOOD`: The number of hops from the closest start node, as
+//   an integer. Only the nodes that are reachable within `maxNumHops_` hops
+//   are contained in the result.
+//
+// The graph is stored in the `CsrGraphCache`, s.t. further analyses of the
+// same edges neither have to compute the `subtree` nor have to build the graph
+// again. The algorithms run in parallel, the number of threads is given by
+// the runtime parameter `graph-analytics-num-threads`.
+class GraphAnalytics : public Operation {
+ public:
+  // Graphs with fewer nodes per thread are processed by fewer threads.
+  static constexpr size_t minNumNodesPerThread_ = 1 << 14;
+
+ private:
+  std::shared_ptr<QueryExecutionTree> subtree_;
+  GraphAnalyticsConfiguration config_;
+
+ public:
+  GraphAnalytics(QueryExecutionContext* qec,
+                 std::shared_ptr<QueryExecutionTree> subtree,
+                 GraphAnalyticsConfiguration config);
+
+  const GraphAnalyticsConfiguration& getConfig() const { return config_; }
+
+  std::vector<QueryExecutionTree*> getChildren() override {
+    return {subtree_.get()};
+  }
+
+  std::string getCacheKeyImpl() const override;
+  std::string getDescriptor() const override;
+  size_t getResultWidth() const override { return 2; }
+  size_t getCostEstimate() override;
+  uint64_t getSizeEstimateBeforeLimit() override;
+  float getMultiplicity(size_t col) override;
+  bool knownEmptyResult() override;
+  std::vector<ColumnIndex> resultSortedOn() const override { return {0}; }
+
+  // The key of the graph of this operation in the `CsrGraphCache`.
+  std::string getGraphCacheKey() const;
+
+ private:
+  std::unique_ptr<Operation> cloneImpl() const override;
+  Result computeResult(bool requestLaziness) override;
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+  // Get the graph from the `CsrGraphCache`, or compute the `subtree_` and
+  // build the graph. If the result of the `subtree_` has a non-empty local
+  // vocabulary, the graph is not cached, and the `localVocab` is set to a
+  // copy of the local vocabulary.
+  std::shared_ptr<const CsrGraph> getGraph(LocalVocab& localVocab);
+
+  // Run the algorithm on the `graph` and write the result rows.
+  IdTable runAlgorithm(const CsrGraph& graph) const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_GRAPHANALYTICS_H
@@ -6,6 +6,7 @@
 #include "engine/GraphStoreProtocol.h"
 
 #include "parser/Tokenizer.h"
+#include "util/ProgressBar.h"
 #include "util/http/beast.h"
 
 // ____________________________________________________________________________
@@ -32,18 +33,16 @@ void GraphStoreProtocol::throwNotYetImplementedHTTPMethod(
 
 // ____________________________________________________________________________
 std::vector<TurtleTriple> GraphStoreProtocol::parseTriples(
-    const std::string& body, ad_utility::MediaType contentType) {
+    const std::string& body, ad_utility::MediaType contentType,
+    const EncodedIriManager* encodedIriManager) {
   using Re2Parser = RdfStringParser<TurtleParser<Tokenizer>>;
   switch (contentType) {
     case ad_utility::MediaType::turtle:
     case ad_utility::MediaType::ntriples: {
-      // TODO<joka921> We could pass in the actual manager here,
-      // then the resulting triples could (possibly) be already much
-      // smaller. This will be done in a future version where we pass the state
-      // of the underlying index more consistently to all parsing and update
-      // functions.
-      EncodedIriManager encodedIriManager;
-      auto parser = Re2Parser(&encodedIriManager);
+      EncodedIriManager emptyEncodedIriManager;
+      auto parser = Re2Parser(encodedIriManager != nullptr
+                                  ? encodedIriManager
+                                  : &emptyEncodedIriManager);
       parser.setInputStream(body);
       return parser.parseAndReturnAllTriples();
     }
@@ -53,10 +52,13 @@ std::vector<TurtleTriple> GraphStoreProtocol::parseTriples(
   }
 }
 
-// ____________________________________________________________________________
-updateClause::GraphUpdate::Triples GraphStoreProtocol::convertTriples(
-    const GraphOrDefault& graph, std::vector<TurtleTriple>&& triples,
-    Quads::BlankNodeAdder& blankNodeAdder) {
+namespace {
+// Convert the `triples` from `TurtleTriple` to `SparqlTripleSimpleWithGraph`
+// with the given `graph`, and append them to the `result`.
+void appendConvertedTriples(const GraphOrDefault& graph,
+                            std::vector<TurtleTriple>&& triples,
+                            Quads::BlankNodeAdder& blankNodeAdder,
+                            std::vector<SparqlTripleSimpleWithGraph>& result) {
   SparqlTripleSimpleWithGraph::Graph tripleGraph{std::monostate{}};
   if (std::holds_alternative<GraphRef>(graph)) {
     tripleGraph = std::get<GraphRef>(graph);
@@ -69,19 +71,78 @@ updateClause::GraphUpdate::Triples GraphStoreProtocol::convertTriples(
       return std::move(tc);
     }
   };
-  auto transformTurtleTriple = [&tripleGraph,
-                                &transformTc](TurtleTriple&& triple) {
+  result.reserve(result.size() + triples.size());
+  for (auto& triple : triples) {
     AD_CORRECTNESS_CHECK(triple.graphIri_.isId() &&
                          triple.graphIri_.getId() ==
                              qlever::specialIds().at(DEFAULT_GRAPH_IRI));
+    result.emplace_back(transformTc(std::move(triple.subject_)),
+                        transformTc(std::move(triple.predicate_)),
+                        transformTc(std::move(triple.object_)), tripleGraph);
+  }
+}
+}  // namespace
 
-    return SparqlTripleSimpleWithGraph(
-        transformTc(std::move(triple.subject_)),
-        transformTc(std::move(triple.predicate_)),
-        transformTc(std::move(triple.object_)), tripleGraph);
+// ____________________________________________________________________________
+updateClause::GraphUpdate::Triples GraphStoreProtocol::convertTriples(
+    const GraphOrDefault& graph, std::vector<TurtleTriple>&& triples,
+    Quads::BlankNodeAdder& blankNodeAdder) {
+  std::vector<SparqlTripleSimpleWithGraph> result;
+  appendConvertedTriples(graph, std::move(triples), blankNodeAdder, result);
+  return {std::move(result), blankNodeAdder.localVocab_.clone()};
+}
+
+// ____________________________________________________________________________
+updateClause::GraphUpdate::Triples GraphStoreProtocol::parseAndConvertTriples(
+    const std::string& body, ad_utility::MediaType contentType,
+    const GraphOrDefault& graph, Quads::BlankNodeAdder& blankNodeAdder,
+    const EncodedIriManager* encodedIriManager) {
+  if (body.size() < MIN_SIZE_FOR_PARALLEL_PARSING_OF_GSP_BODIES()) {
+    return convertTriples(graph,
+                          parseTriples(body, contentType, encodedIriManager),
+                          blankNodeAdder);
+  }
+  if (contentType != ad_utility::MediaType::turtle &&
+      contentType != ad_utility::MediaType::ntriples) {
+    throwUnsupportedMediatype(toString(contentType));
+  }
+  EncodedIriManager emptyEncodedIriManager;
+  if (encodedIriManager == nullptr) {
+    encodedIriManager = &emptyEncodedIriManager;
+  }
+
+  // Feed the body to the parallel parser in blocks. The buffer of the parser
+  // only reads the bytes, so the `const_cast` is safe.
+  auto byteSpans = [](const std::string& input, size_t blocksize)
+      -> ParallelBufferFromByteSpans::ByteSpans {
+    auto* data = reinterpret_cast<std::byte*>(const_cast<char*>(input.data()));
+    for (size_t i = 0; i < input.size(); i += blocksize) {
+      co_yield ql::span<std::byte>{data + i,
+                                   std::min(blocksize, input.size() - i)};
+    }
   };
-  return {ad_utility::transform(std::move(triples), transformTurtleTriple),
-          blankNodeAdder.localVocab_.clone()};
+  size_t blocksize = BLOCKSIZE_TURTLE_PARSING_OF_DATA_UPDATES.getBytes();
+  RdfParallelParser<TurtleParser<Tokenizer>> parser{
+      std::make_unique<ParallelBufferFromByteSpans>(
+          blocksize, byteSpans(body, blocksize)),
+      encodedIriManager};
+
+  AD_LOG_INFO << "Parsing the Graph Store Protocol request body of "
+              << ad_utility::MemorySize::bytes(body.size()).asString()
+              << " ..." << std::endl;
+  size_t numTriplesParsed = 0;
+  ad_utility::ProgressBar progressBar{numTriplesParsed, "Triples parsed: "};
+  std::vector<SparqlTripleSimpleWithGraph> result;
+  while (auto batch = parser.getBatch()) {
+    numTriplesParsed += batch->size();
+    appendConvertedTriples(graph, std::move(batch).value(), blankNodeAdder,
+                           result);
+    if (progressBar.update()) {
+      AD_LOG_INFO << progressBar.getProgressString() << std::flush;
+    }
+  }
+  AD_LOG_INFO << progressBar.getFinalProgressString() << std::flush;
+  return {std::move(result), blankNodeAdder.localVocab_.clone()};
 }
 
 // ____________________________________________________________________________
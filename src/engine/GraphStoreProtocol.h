@@ -8,6 +8,8 @@
 #ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
 #include <gtest/gtest_prod.h>
 
+#include <atomic>
+
 #include "engine/HttpError.h"
 #include "parser/ParsedQuery.h"
 #include "parser/Quads.h"
@@ -17,6 +19,14 @@
 #include "util/http/ResponseMiddleware.h"
 #include "util/http/UrlParser.h"
 
+// Request bodies of the Graph Store Protocol with at least this many bytes are
+// parsed in parallel (see `GraphStoreProtocol::parseAndConvertTriples`). It is
+// not const, so we can set it to a much lower value for unit tests.
+inline std::atomic<size_t>& MIN_SIZE_FOR_PARALLEL_PARSING_OF_GSP_BODIES() {
+  static std::atomic<size_t> value = 10'000'000;
+  return value;
+}
+
 // Transform SPARQL Graph Store Protocol requests to their equivalent
 // ParsedQuery (SPARQL Query or Update).
 class GraphStoreProtocol {
@@ -85,8 +95,11 @@ class GraphStoreProtocol {
   }
 
   // Parse the triples from the request body according to the content type.
+  // IRIs that can be encoded by the `encodedIriManager` (if not `nullptr`) are
+  // directly folded into IDs.
   static std::vector<TurtleTriple> parseTriples(
-      const std::string& body, ad_utility::MediaType contentType);
+      const std::string& body, ad_utility::MediaType contentType,
+      const EncodedIriManager* encodedIriManager = nullptr);
   FRIEND_TEST(GraphStoreProtocolTest, parseTriples);
 
   // Transforms the triples from `TurtleTriple` to `SparqlTripleSimpleWithGraph`
@@ -96,6 +109,18 @@ class GraphStoreProtocol {
       Quads::BlankNodeAdder& blankNodeAdder);
   FRIEND_TEST(GraphStoreProtocolTest, convertTriples);
 
+  // The combination of `parseTriples` and `convertTriples`. Bodies with at
+  // least `MIN_SIZE_FOR_PARALLEL_PARSING_OF_GSP_BODIES()` bytes (typically bulk
+  // loads of large N-Triples files) are parsed by the parallel Turtle parser,
+  // and the triples are converted batch by batch, s.t. the unconverted triples
+  // of the complete body are never in memory at the same time. The progress of
+  // the parsing is logged.
+  static updateClause::GraphUpdate::Triples parseAndConvertTriples(
+      const std::string& body, ad_utility::MediaType contentType,
+      const GraphOrDefault& graph, Quads::BlankNodeAdder& blankNodeAdder,
+      const EncodedIriManager* encodedIriManager = nullptr);
+  FRIEND_TEST(GraphStoreProtocolTest, parseAndConvertTriples);
+
   // Creates a `ResponseMiddleware` that sets the `Location` of the response to
   // the IRI and the HTTP status to `201 Created`.
   static ResponseMiddleware makePostNewGraphMiddleware(
@@ -137,14 +162,13 @@ class GraphStoreProtocol {
       transformPost(const RequestT& rawRequest, const GraphOrDefault& graph,
                     const Index& index) {
     throwIfRequestBodyEmpty(rawRequest);
-    auto triples =
-        parseTriples(rawRequest.body(), extractMediatype(rawRequest));
     Quads::BlankNodeAdder bn{{}, {}, index.getBlankNodeManager()};
     auto insertIntoNewGraph = mustInsertIntoNewGraph(rawRequest, graph);
     const GraphOrDefault effectiveGraph =
         insertIntoNewGraph ? generateNewGraphIri() : graph;
-    auto convertedTriples =
-        convertTriples(effectiveGraph, std::move(triples), bn);
+    auto convertedTriples = parseAndConvertTriples(
+        rawRequest.body(), extractMediatype(rawRequest), effectiveGraph, bn,
+        &index.encodedIriManager());
     updateClause::GraphUpdate up{std::move(convertedTriples), {}};
     ParsedQuery res;
     res._clause = parsedQuery::UpdateClause{std::move(up)};
@@ -170,10 +194,10 @@ class GraphStoreProtocol {
       transformTsop(const RequestT& rawRequest, const GraphOrDefault& graph,
                     const Index& index) {
     throwIfRequestBodyEmpty(rawRequest);
-    auto triples =
-        parseTriples(rawRequest.body(), extractMediatype(rawRequest));
     Quads::BlankNodeAdder bn{{}, {}, index.getBlankNodeManager()};
-    auto convertedTriples = convertTriples(graph, std::move(triples), bn);
+    auto convertedTriples = parseAndConvertTriples(
+        rawRequest.body(), extractMediatype(rawRequest), graph, bn,
+        &index.encodedIriManager());
     updateClause::GraphUpdate up{{}, std::move(convertedTriples)};
     ParsedQuery res;
     res._clause = parsedQuery::UpdateClause{std::move(up)};
@@ -219,10 +243,10 @@ class GraphStoreProtocol {
         index.getBlankNodeManager(), &index.encodedIriManager(), getDrop()));
     drop._originalString = stringRepresentation;
 
-    auto triples =
-        parseTriples(rawRequest.body(), extractMediatype(rawRequest));
     Quads::BlankNodeAdder bn{{}, {}, index.getBlankNodeManager()};
-    auto convertedTriples = convertTriples(graph, std::move(triples), bn);
+    auto convertedTriples = parseAndConvertTriples(
+        rawRequest.body(), extractMediatype(rawRequest), graph, bn,
+        &index.encodedIriManager());
     updateClause::GraphUpdate up{std::move(convertedTriples), {}};
     ParsedQuery insertData;
     // Interpretation of the very vague GSP 5.3:
@@ -54,45 +54,37 @@ template struct ExtremumAggregationData<valueIdComparators::Comparison::GT>;
 // _____________________________________________________________________________
 void GroupConcatAggregationData::addValueImpl(
     const std::optional<ad_utility::triple_component::Literal>& val) {
-  if (first_) {
-    first_ = false;
-  } else {
-    currentValue_.append(separator_);
-  }
-  if (val.has_value()) {
-    currentValue_.append(asStringViewUnsafe(val.value().getContent()));
-  } else {
-    undefined_ = true;
-  }
+  builder_.append(val, separator_);
 }
 
 // _____________________________________________________________________________
 [[nodiscard]] ValueId GroupConcatAggregationData::calculateResult(
     const LocalVocabContext& context, LocalVocab* localVocab) const {
-  if (undefined_) {
+  using sparqlExpression::detail::GroupConcatBuilder;
+  auto literal = GroupConcatBuilder{builder_}.finish();
+  if (!literal.has_value()) {
     return ValueId::makeUndefined();
   }
-  using namespace ad_utility::triple_component;
   auto localVocabIndex = localVocab->getIndexAndAddIfNotContained(
-      LocalVocabEntry::literalWithNormalizedContent(
-          asNormalizedStringViewUnsafe(currentValue_), context));
+      LocalVocabEntry{std::move(literal.value()), context});
   return ValueId::makeFromLocalVocabIndex(localVocabIndex);
 }
 
 // _____________________________________________________________________________
 GroupConcatAggregationData::GroupConcatAggregationData(
     std::string_view separator)
-    : separator_{separator} {
-  currentValue_.reserve(20000);
-}
+    : separator_{separator} {}
 
 // _____________________________________________________________________________
-void GroupConcatAggregationData::reset() {
-  undefined_ = false;
-  first_ = true;
-  currentValue_.clear();
+void GroupConcatAggregationData::mergeWith(
+    GroupConcatAggregationData&& other,
+    [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+  builder_.append(std::move(other.builder_), separator_);
 }
 
+// _____________________________________________________________________________
+void GroupConcatAggregationData::reset() { builder_.clear(); }
+
 // _____________________________________________________________________________
 [[nodiscard]] ValueId SampleAggregationData::calculateResult(
     [[maybe_unused]] const LocalVocabContext& context,
@@ -104,3 +96,10 @@ void GroupConcatAggregationData::reset() {
   return sparqlExpression::detail::idOrLiteralOrIriToId(value_.value(),
                                                         localVocab);
 }
+
+// _____________________________________________________________________________
+[[nodiscard]] ValueId ApproxCountDistinctAggregationData::calculateResult(
+    [[maybe_unused]] const LocalVocabContext& context,
+    [[maybe_unused]] const LocalVocab* localVocab) const {
+  return ValueId::makeFromInt(sketch_.estimate());
+}
@@ -9,6 +9,8 @@
 #define QLEVER_SRC_ENGINE_GROUPBYHASHMAPOPTIMIZATION_H
 
 #include "engine/sparqlExpressions/AggregateExpression.h"
+#include "engine/sparqlExpressions/ApproxCountDistinctExpression.h"
+#include "engine/sparqlExpressions/GroupConcatBuilder.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
 
@@ -48,6 +50,15 @@ struct AvgAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       [[maybe_unused]] const LocalVocab* localVocab) const;
 
+  // Merge the partial aggregate `other` (computed on a different part of the
+  // input) into this one.
+  void mergeWith(AvgAggregationData&& other,
+                 [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    error_ |= other.error_;
+    sum_ += other.sum_;
+    count_ += other.count_;
+  }
+
   void reset() { *this = AvgAggregationData{}; }
 };
 
@@ -67,6 +78,12 @@ struct CountAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       [[maybe_unused]] const LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void mergeWith(CountAggregationData&& other,
+                 [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    count_ += other.count_;
+  }
+
   void reset() { *this = CountAggregationData{}; }
 };
 
@@ -94,6 +111,14 @@ struct ExtremumAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void mergeWith(ExtremumAggregationData&& other,
+                 const sparqlExpression::EvaluationContext* ctx) {
+    if (other.firstValueSet_) {
+      addValue(other.currentValue_, ctx);
+    }
+  }
+
   void reset() { *this = ExtremumAggregationData{}; }
 };
 
@@ -137,6 +162,15 @@ struct SumAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       [[maybe_unused]] const LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void mergeWith(SumAggregationData&& other,
+                 [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    error_ |= other.error_;
+    intSumValid_ &= other.intSumValid_;
+    sum_ += other.sum_;
+    intSum_ += other.intSum_;
+  }
+
   void reset() { *this = SumAggregationData{}; }
 };
 
@@ -144,16 +178,16 @@ struct SumAggregationData {
 struct GroupConcatAggregationData {
   using ValueGetter =
       sparqlExpression::detail::LiteralValueGetterWithoutStrFunction;
-  bool undefined_ = false;
-  bool first_ = true;
-  std::string currentValue_;
+  // Each group starts without any preallocated memory, the builder grows
+  // with the actual length of its values.
+  sparqlExpression::detail::GroupConcatBuilder builder_;
   std::string_view separator_;
 
   // _____________________________________________________________________________
   template <typename T>
   void addValue(T&& value, const sparqlExpression::EvaluationContext* ctx) {
     // No need to compute anything in this case.
-    if (undefined_) {
+    if (builder_.isUndefined()) {
       return;
     }
     auto val = ValueGetter{}(AD_FWD(value), ctx);
@@ -169,6 +203,11 @@ struct GroupConcatAggregationData {
 
   explicit GroupConcatAggregationData(std::string_view separator);
 
+  // Append the values of `other` (which must have been computed on a later
+  // part of the input) to the values of this object.
+  void mergeWith(GroupConcatAggregationData&& other,
+                 const sparqlExpression::EvaluationContext*);
+
   void reset();
 };
 
@@ -189,7 +228,41 @@ struct SampleAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       LocalVocab* localVocab) const;
 
+  // The sample of the first part of the input takes precedence, s.t. the result
+  // is the same as for the sequential computation.
+  void mergeWith(SampleAggregationData&& other,
+                 [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    if (!value_.has_value()) {
+      value_ = std::move(other.value_);
+    }
+  }
+
   void reset() { *this = SampleAggregationData{}; }
 };
 
+// Data to perform the `ql:approxCountDistinct` aggregation using the HashMap
+// optimization.
+struct ApproxCountDistinctAggregationData {
+  sparqlExpression::detail::DistinctCountSketch sketch_;
+
+  // _____________________________________________________________________________
+  void addValue(const sparqlExpression::IdOrLocalVocabEntry& value,
+                [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    sketch_.add(value);
+  }
+
+  // _____________________________________________________________________________
+  [[nodiscard]] ValueId calculateResult(
+      [[maybe_unused]] const LocalVocabContext& context,
+      [[maybe_unused]] const LocalVocab* localVocab) const;
+
+  // _____________________________________________________________________________
+  void mergeWith(ApproxCountDistinctAggregationData&& other,
+                 [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    sketch_.mergeWith(other.sketch_);
+  }
+
+  void reset() { *this = ApproxCountDistinctAggregationData{}; }
+};
+
 #endif  // QLEVER_SRC_ENGINE_GROUPBYHASHMAPOPTIMIZATION_H
@@ -18,6 +18,7 @@
 #include "engine/Sort.h"
 #include "engine/StripColumns.h"
 #include "engine/sparqlExpressions/AggregateExpression.h"
+#include "engine/sparqlExpressions/ApproxCountDistinctExpression.h"
 #include "engine/sparqlExpressions/CountStarExpression.h"
 #include "engine/sparqlExpressions/GroupConcatExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
@@ -33,6 +34,8 @@
 #include "parser/Alias.h"
 #include "util/Exception.h"
 #include "util/HashSet.h"
+#include "util/ParallelExecutor.h"
+#include "util/ThreadBudget.h"
 #include "util/Timer.h"
 
 namespace groupBy::detail {
@@ -165,11 +168,22 @@ class LazyGroupByRange
         parent_->createEvaluationContext(currentLocalVocab_,
                                          idTable.asStaticView<0>());
 
+    // The first group might continue a group from the previous blocks, so
+    // it is processed directly. The following complete groups are collected,
+    // s.t. they can be aggregated concurrently.
+    std::vector<std::pair<size_t, size_t>> groups;
     size_t lastBlockStart = parent_->searchBlockBoundaries(
-        [this, &evaluationContext](size_t a, size_t b) {
-          onBlockChange(a, b, evaluationContext);
+        [this, &evaluationContext, &groups](size_t a, size_t b) {
+          if (groupSplitAcrossTables_) {
+            onBlockChange(a, b, evaluationContext);
+          } else {
+            groups.emplace_back(a, b);
+          }
         },
         idTable.asStaticView<IN_WIDTH>(), currentGroupBlock_);
+    parent_->template processBlocks<OUT_WIDTH>(
+        resultTable_, aggregates_, evaluationContext,
+        idTable.asStaticView<0>(), groups, &currentLocalVocab_, groupByCols_);
     groupSplitAcrossTables_ = true;
     lazyGroupBy_->processBlock(evaluationContext, lastBlockStart,
                                idTable.size());
@@ -401,6 +415,11 @@ float GroupByImpl::getMultiplicity([[maybe_unused]] size_t col) {
 }
 
 uint64_t GroupByImpl::getSizeEstimateBeforeLimit() {
+  return estimateNumberOfGroups();
+}
+
+// _____________________________________________________________________________
+uint64_t GroupByImpl::estimateNumberOfGroups() const {
   if (_groupByVariables.empty()) {
     return 1;
   }
@@ -508,9 +527,16 @@ IdTable GroupByImpl::doGroupBy(const IdTableView<0>& inTable,
   for (size_t col : groupByCols) {
     currentGroupBlock.push_back(std::pair<size_t, Id>(col, input(0, col)));
   }
-  size_t lastBlockStart =
-      searchBlockBoundaries(processNextBlock, input, currentGroupBlock);
-  processNextBlock(lastBlockStart, input.size());
+  // Collect the groups first, s.t. they can be aggregated concurrently.
+  std::vector<std::pair<size_t, size_t>> groups;
+  size_t lastBlockStart = searchBlockBoundaries(
+      [&groups](size_t blockStart, size_t blockEnd) {
+        groups.emplace_back(blockStart, blockEnd);
+      },
+      input, currentGroupBlock);
+  groups.emplace_back(lastBlockStart, input.size());
+  processBlocks<OUT_WIDTH>(result, aggregates, evaluationContext, inTable,
+                           groups, outLocalVocab, groupByCols);
   return std::move(result).toDynamic();
 }
 
@@ -562,6 +588,28 @@ Result GroupByImpl::computeResult(bool requestLaziness) {
         {alias._expression, varColMap.at(alias._target).columnIndex_});
   }
 
+  // Report the error bound of approximate aggregates in the runtime
+  // information (which is part of the metadata of the query result).
+  using sparqlExpression::ApproxCountDistinctExpression;
+  using sparqlExpression::SparqlExpression;
+  auto containsApproximateAggregate = [](const auto& self,
+                                         const SparqlExpression& expr) -> bool {
+    if (dynamic_cast<const ApproxCountDistinctExpression*>(&expr)) {
+      return true;
+    }
+    return ql::ranges::any_of(expr.children(), [&self](const auto& child) {
+      return self(self, *child);
+    });
+  };
+  if (ql::ranges::any_of(_aliases, [&](const Alias& alias) {
+        return containsApproximateAggregate(containsApproximateAggregate,
+                                            *alias._expression.getPimpl());
+      })) {
+    runtimeInfo().addDetail(
+        "approxCountDistinctRelativeStandardError",
+        ApproxCountDistinctExpression::relativeStandardError());
+  }
+
   // Check if optimization for explicitly sorted child can be applied
   auto metadataForUnsequentialData =
       checkIfHashMapOptimizationPossible(aggregates);
@@ -622,12 +670,26 @@ Result GroupByImpl::computeResult(bool requestLaziness) {
     // Now call `computeWithHashMap` and return the result. It expects a range
     // of results, so if the result is fully materialized, we create an array
     // with a single element.
-    if (subresult->isFullyMaterialized()) {
-      const auto idTableView = subresult->idTableView();
-      return computeWithHashMap(std::array{
-          std::pair{idTableView, std::cref(subresult->localVocab())}});
-    } else {
-      return computeWithHashMap(subresult->idTables());
+    try {
+      if (subresult->isFullyMaterialized()) {
+        const auto idTableView = subresult->idTableView();
+        return computeWithHashMap(std::array{
+            std::pair{idTableView, std::cref(subresult->localVocab())}});
+      } else {
+        return computeWithHashMap(subresult->idTables());
+      }
+    } catch (const ad_utility::detail::AllocationExceedsLimitException&) {
+      // The hash map (or its result) doesn't fit into memory. Fall back to
+      // sorting the input (the `Sort` spills to disk if the input is large)
+      // and grouping the sorted input, which requires much less memory.
+      runtimeInfo().addDetail("hash-map-exceeded-memory-limit", true);
+      AD_LOG_INFO << "The hash map for the GROUP BY exceeded the memory "
+                     "limit, sorting the input instead"
+                  << std::endl;
+      subresult.reset();
+      metadataForUnsequentialData =
+          computeUnsequentialProcessingMetadata(aggregates, _groupByVariables);
+      subresult = _subtree->getResult(metadataForUnsequentialData.has_value());
     }
   }
 
@@ -677,9 +739,11 @@ size_t GroupByImpl::searchBlockBoundaries(const T& onBlockChange,
                                           const IdTableView<COLS>& idTable,
                                           GroupBlock& currentGroupBlock) const {
   size_t blockStart = 0;
+  ad_utility::AmortizedCancellationCheck checkCancellationAmortized{
+      [this]() { checkCancellation(); }};
 
   for (size_t pos = 0; pos < idTable.size(); pos++) {
-    checkCancellation();
+    checkCancellationAmortized();
     bool rowMatchesCurrentBlock =
         // TODO<joka921> ql::ranges has problems with the local lambda, find out
         // what's wrong.
@@ -719,6 +783,71 @@ void GroupByImpl::processBlock(
   }
 }
 
+// _____________________________________________________________________________
+template <size_t OUT_WIDTH>
+void GroupByImpl::processBlocks(
+    IdTableStatic<OUT_WIDTH>& output, const std::vector<Aggregate>& aggregates,
+    sparqlExpression::EvaluationContext& evaluationContext,
+    const IdTableView<0>& input,
+    ql::span<const std::pair<size_t, size_t>> groups, LocalVocab* localVocab,
+    const vector<size_t>& groupByCols) const {
+  if (groups.empty()) {
+    return;
+  }
+  const size_t firstRow = groups.front().first;
+  const size_t numRows = groups.back().second - firstRow;
+  const size_t maxNumThreads = std::max<size_t>(
+      1, getRuntimeParameter<&RuntimeParameters::groupBySortedNumThreads_>());
+  auto threads = ad_utility::globalThreadBudget().reserve(
+      std::min({maxNumThreads, groups.size(),
+                numRows / GROUP_BY_SORTED_MIN_ROWS_PER_THREAD}));
+  const size_t numThreads = threads.numThreads();
+  if (numThreads <= 1) {
+    for (const auto& [blockStart, blockEnd] : groups) {
+      processBlock<OUT_WIDTH>(output, aggregates, evaluationContext,
+                              blockStart, blockEnd, localVocab, groupByCols);
+    }
+    return;
+  }
+
+  // Split the groups into `numThreads` contiguous chunks with roughly the same
+  // number of rows. A chunk starts with the first group that starts at or
+  // after its share of the rows, so no group is split between two chunks.
+  std::vector<size_t> chunkBegins;
+  for (size_t t = 0; t < numThreads; ++t) {
+    size_t row = firstRow + numRows * t / numThreads;
+    chunkBegins.push_back(static_cast<size_t>(
+        ql::ranges::lower_bound(groups, row, {},
+                                &std::pair<size_t, size_t>::first) -
+        groups.begin()));
+  }
+  chunkBegins.push_back(groups.size());
+
+  std::vector<IdTableStatic<OUT_WIDTH>> partialResults;
+  partialResults.reserve(numThreads);
+  for (size_t t = 0; t < numThreads; ++t) {
+    partialResults.emplace_back(output.numColumns(), output.getAllocator());
+  }
+  std::vector<LocalVocab> partialVocabs(numThreads);
+  std::vector<std::packaged_task<void()>> tasks;
+  for (size_t t = 0; t < numThreads; ++t) {
+    tasks.emplace_back([&, t]() {
+      auto& vocab = partialVocabs[t];
+      auto threadContext = createEvaluationContext(vocab, input);
+      for (size_t i = chunkBegins[t]; i < chunkBegins[t + 1]; ++i) {
+        processBlock<OUT_WIDTH>(partialResults[t], aggregates, threadContext,
+                                groups[i].first, groups[i].second, &vocab,
+                                groupByCols);
+      }
+    });
+  }
+  ad_utility::runTasksInParallel(std::move(tasks));
+  for (size_t t = 0; t < numThreads; ++t) {
+    localVocab->mergeWith(partialVocabs[t]);
+    output.insertAtEnd(partialResults[t]);
+  }
+}
+
 // _____________________________________________________________________________
 template <size_t OUT_WIDTH>
 void GroupByImpl::processEmptyImplicitGroup(
@@ -762,9 +891,7 @@ std::optional<IdTable> GroupByImpl::computeGroupByForSingleIndexScan() const {
     return std::nullopt;
   }
 
-  if (indexScan->numVariables() <= 1 ||
-      !indexScan->graphsToFilter().areAllGraphsAllowed() ||
-      !_groupByVariables.empty()) {
+  if (indexScan->numVariables() == 0 || !_groupByVariables.empty()) {
     return std::nullopt;
   }
 
@@ -773,18 +900,31 @@ std::optional<IdTable> GroupByImpl::computeGroupByForSingleIndexScan() const {
   if (!varAndDistinctness.has_value()) {
     return std::nullopt;
   }
-
-  // Distinct counts are only supported for triples with three variables without
-  // a GRAPH variable and if no `LIMIT`/`OFFSET` clauses are present.
+  const auto& var = varAndDistinctness.value().variable_;
+  const auto& permutedTriple = indexScan->getPermutedTriple();
+  bool allGraphsAllowed = indexScan->graphsToFilter().areAllGraphsAllowed();
+  bool hasAdditionalVariables = !indexScan->additionalVariables().empty();
+
+  // Distinct counts are only supported without a GRAPH variable and if no
+  // `LIMIT`/`OFFSET` clauses are present, for a triple with three variables,
+  // for the first variable of a triple with two variables (the distinct values
+  // of which are read from the metadata of the relation), or for a triple
+  // with a single variable (the rows of which are all distinct).
   bool countIsDistinct = varAndDistinctness.value().isDistinct_;
-  if (countIsDistinct && (indexScan->numVariables() != 3 ||
-                          !indexScan->additionalVariables().empty() ||
-                          !indexScan->getLimitOffset().isUnconstrained())) {
-    return std::nullopt;
+  if (countIsDistinct) {
+    size_t numVariables = indexScan->numVariables();
+    bool isSupported =
+        !hasAdditionalVariables &&
+        indexScan->getLimitOffset().isUnconstrained() &&
+        (numVariables == 1 ||
+         (numVariables == 2 && allGraphsAllowed &&
+          *permutedTriple[1] == var) ||
+         (numVariables == 3 && allGraphsAllowed));
+    if (!isSupported) {
+      return std::nullopt;
+    }
   }
 
-  const auto& var = varAndDistinctness.value().variable_;
-
   // Helpers for exporting the result as an `IdTable`.
   auto idTableFromInt = [this](size_t count) {
     IdTable table{1, getExecutionContext()->getAllocator()};
@@ -801,7 +941,28 @@ std::optional<IdTable> GroupByImpl::computeGroupByForSingleIndexScan() const {
     return idTableFromInt(0);
   }
 
-  if (indexScan->numVariables() != 3) {
+  // With a constant graph restriction, the exact size only reflects the
+  // result of the scan if there is no GRAPH variable, because it doesn't
+  // distinguish between equal triples from different graphs.
+  if (!allGraphsAllowed && hasAdditionalVariables) {
+    return std::nullopt;
+  }
+
+  if (indexScan->numVariables() == 2 && countIsDistinct) {
+    // The distinct values of the first variable and their counts are
+    // determined from the metadata of the relation and the located triples,
+    // without decompressing the blocks in the middle of the relation.
+    std::optional<Id> col0Id = permutedTriple[0]->toValueId(getIndex());
+    if (!col0Id.has_value()) {
+      return idTableFromInt(0);
+    }
+    auto distinctIdsAndCounts =
+        indexScan->permutation().getDistinctCol1IdsAndCounts(
+            col0Id.value(), cancellationHandle_, locatedTriplesState(), {});
+    return idTableFromInt(distinctIdsAndCounts.numRows());
+  }
+
+  if (indexScan->numVariables() != 3 || !allGraphsAllowed) {
     return countFromExactSize();
   }
 
@@ -841,10 +1002,15 @@ std::optional<IdTable> GroupByImpl::computeGroupByForSingleIndexScan() const {
       });
   bool hasCrossGraphDuplicates =
       !isMaterializedView && !hasGraphVariable &&
-      ql::ranges::any_of(locTriples.getAugmentedMetadata(),
-                         [](const CompressedBlockMetadata& block) {
-                           return block.containsDuplicatesWithDifferentGraphs_;
-                         });
+      ql::ranges::any_of(
+          indexScan->permutation().getAugmentedMetadataForPermutation(
+              locatedTriplesState()),
+          [](const BlockMetadataRange& blocks) {
+            return ql::ranges::any_of(
+                blocks, [](const CompressedBlockMetadata& block) {
+                  return block.containsDuplicatesWithDifferentGraphs_;
+                });
+          });
 
   if (hasLocatedTriples || hasCrossGraphDuplicates) {
     return countFromExactSize();
@@ -1195,9 +1361,29 @@ GroupByImpl::checkIfHashMapOptimizationPossible(
   if (!std::dynamic_pointer_cast<const Sort>(_subtree->getRootOperation())) {
     return std::nullopt;
   }
+  if (!getRuntimeParameter<&RuntimeParameters::groupByHashMapEnabled_>() &&
+      !isHashMapEstimatedToBeCheaperThanSort()) {
+    return std::nullopt;
+  }
   return computeUnsequentialProcessingMetadata(aliases, _groupByVariables);
 }
 
+// _____________________________________________________________________________
+bool GroupByImpl::isHashMapEstimatedToBeCheaperThanSort() const {
+  if (!getRuntimeParameter<&RuntimeParameters::groupByHashMapCostBased_>() ||
+      _groupByVariables.empty()) {
+    return false;
+  }
+  const auto* qec = getExecutionContext();
+  auto inputSize = static_cast<double>(_subtree->getSizeEstimate());
+  if (inputSize < qec->getCostFactor("GROUP_BY_HASH_MAP_MIN_INPUT_SIZE")) {
+    return false;
+  }
+  auto numGroups = static_cast<double>(estimateNumberOfGroups());
+  return numGroups <=
+         inputSize * qec->getCostFactor("GROUP_BY_HASH_MAP_MAX_GROUPS_RATIO");
+}
+
 // _____________________________________________________________________________
 std::variant<std::vector<GroupByImpl::ParentAndChildIndex>,
              GroupByImpl::OccurAsRoot>
@@ -1285,6 +1471,9 @@ GroupByImpl::isSupportedAggregate(sparqlExpression::SparqlExpression* expr) {
   // NOTE: The STDEV function is not suitable for lazy and hash map
   // optimizations.
   if (dynamic_cast<SampleExpression*>(expr)) return H{SAMPLE};
+  if (dynamic_cast<ApproxCountDistinctExpression*>(expr)) {
+    return H{APPROX_COUNT_DISTINCT};
+  }
 
   // `expr` is an unsupported aggregate
   return std::nullopt;
@@ -1480,6 +1669,14 @@ GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::getHashEntries(
     hashEntries.push_back(iterator->second);
   }
 
+  resizeAggregationVectors();
+  return hashEntries;
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::HashMapAggregationData<
+    NUM_GROUP_COLUMNS>::resizeAggregationVectors() {
   // CPP_template_lambda(capture)(typenames...)(arg)(requires ...)`
   auto resizeVectors = CPP_template_lambda()(typename T)(
       T & arg, size_t numberOfGroups,
@@ -1507,8 +1704,41 @@ GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::getHashEntries(
         aggregation);
     ++idx;
   }
+}
 
-  return hashEntries;
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::mergeWith(
+    HashMapAggregationData&& other,
+    const sparqlExpression::EvaluationContext* evaluationContext) {
+  AD_CONTRACT_CHECK(aggregationData_.size() == other.aggregationData_.size());
+  // For each group of `other`, find (or create) the corresponding group in
+  // this object.
+  std::vector<size_t> targetIndices(other.getNumberOfGroups());
+  for (const auto& [key, index] : other.map_) {
+    auto [iterator, wasAdded] = map_.try_emplace(key, getNumberOfGroups());
+    targetIndices.at(index) = iterator->second;
+  }
+  resizeAggregationVectors();
+
+  for (auto&& [target, source] :
+       ::ranges::views::zip(aggregationData_, other.aggregationData_)) {
+    std::visit(
+        [&targetIndices, evaluationContext](auto& targetVector,
+                                            auto& sourceVector) {
+          using T = std::decay_t<decltype(targetVector)>;
+          if constexpr (std::is_same_v<T,
+                                       std::decay_t<decltype(sourceVector)>>) {
+            for (size_t i = 0; i < sourceVector.size(); ++i) {
+              targetVector.at(targetIndices[i])
+                  .mergeWith(std::move(sourceVector[i]), evaluationContext);
+            }
+          } else {
+            AD_FAIL();
+          }
+        },
+        target, source);
+  }
 }
 
 // _____________________________________________________________________________
@@ -1772,6 +2002,63 @@ static constexpr auto makeProcessGroupsVisitor =
       };
     };
 
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::aggregateRowsForHashMapOptimization(
+    const std::vector<HashMapAliasInformation>& aggregateAliases,
+    const std::vector<size_t>& columnIndices,
+    HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData,
+    sparqlExpression::EvaluationContext& evaluationContext, size_t beginRow,
+    size_t endRow, ad_utility::Timer& lookupTimer,
+    ad_utility::Timer& aggregationTimer) const {
+  const auto& inputTable = evaluationContext._inputTable;
+  // Process (up to) `GROUP_BY_HASH_MAP_BLOCK_SIZE` rows at a time.
+  for (size_t i = beginRow; i < endRow; i += GROUP_BY_HASH_MAP_BLOCK_SIZE) {
+    checkCancellation();
+
+    evaluationContext._beginIndex = i;
+    evaluationContext._endIndex =
+        std::min(i + GROUP_BY_HASH_MAP_BLOCK_SIZE, endRow);
+
+    auto currentBlockSize = evaluationContext.size();
+
+    // Perform HashMap lookup once for all groups in current block
+    using U = typename HashMapAggregationData<
+        NUM_GROUP_COLUMNS>::template ArrayOrVector<ql::span<const Id>>;
+    U groupValues;
+    resizeIfVector(groupValues, columnIndices.size());
+
+    // TODO<C++23> use views::enumerate
+    size_t j = 0;
+    for (auto& idx : columnIndices) {
+      groupValues[j] = inputTable.getColumn(idx).subspan(
+          evaluationContext._beginIndex, currentBlockSize);
+      ++j;
+    }
+    lookupTimer.cont();
+    auto hashEntries = aggregationData.getHashEntries(groupValues);
+    lookupTimer.stop();
+
+    aggregationTimer.cont();
+    for (auto& aggregateAlias : aggregateAliases) {
+      for (auto& aggregate : aggregateAlias.aggregateInfo_) {
+        sparqlExpression::ExpressionResult expressionResult =
+            GroupByImpl::evaluateChildExpressionOfAggregateFunction(
+                aggregate, evaluationContext);
+
+        auto& aggregationDataVariant =
+            aggregationData.getAggregationDataVariant(
+                aggregate.aggregateDataIndex_);
+
+        std::visit(makeProcessGroupsVisitor(currentBlockSize,
+                                            &evaluationContext, hashEntries),
+                   std::move(expressionResult), aggregationDataVariant);
+      }
+    }
+    aggregationTimer.stop();
+  }
+}
+
 // _____________________________________________________________________________
 template <size_t NUM_GROUP_COLUMNS, typename SubResults>
 Result GroupByImpl::computeGroupByForHashMapOptimization(
@@ -1786,10 +2073,28 @@ Result GroupByImpl::computeGroupByForHashMapOptimization(
       getExecutionContext()->getAllocator(), aggregateAliases,
       columnIndices.size());
 
+  const size_t maxNumThreads = std::max<size_t>(
+      1, getRuntimeParameter<&RuntimeParameters::groupByHashMapNumThreads_>());
+
+  // Create an `EvaluationContext` for the given input block.
+  auto makeEvaluationContext = [this](IdTableView<0> inputTable,
+                                      LocalVocab& vocab) {
+    sparqlExpression::EvaluationContext evaluationContext(
+        *getExecutionContext(), _subtree->getVariableColumns(), inputTable,
+        getExecutionContext()->getAllocator(), vocab, cancellationHandle_,
+        deadline_);
+    evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
+        _groupByVariables.begin(), _groupByVariables.end()};
+    evaluationContext._isPartOfGroupBy = true;
+    return evaluationContext;
+  };
+
   // Process the input blocks (pairs of `IdTable` and `LocalVocab`) one after
   // the other.
   ad_utility::Timer lookupTimer{ad_utility::Timer::Stopped};
   ad_utility::Timer aggregationTimer{ad_utility::Timer::Stopped};
+  ad_utility::Timer parallelAggregationTimer{ad_utility::Timer::Stopped};
+  size_t numThreadsUsed = 1;
   for (const auto& [inputTableRef, inputLocalVocabRef] : subresults) {
     const auto inputTable = inputTableRef.template asStaticView<0>();
     const LocalVocab& inputLocalVocab = inputLocalVocabRef;
@@ -1800,65 +2105,65 @@ Result GroupByImpl::computeGroupByForHashMapOptimization(
     // local vocabs, no deduplication is performed.
     localVocab.mergeWith(inputLocalVocab);
     // Setup the `EvaluationContext` for this input block.
-    sparqlExpression::EvaluationContext evaluationContext(
-        *getExecutionContext(), _subtree->getVariableColumns(), inputTable,
-        getExecutionContext()->getAllocator(), localVocab, cancellationHandle_,
-        deadline_);
-    evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
-        _groupByVariables.begin(), _groupByVariables.end()};
-    evaluationContext._isPartOfGroupBy = true;
+    auto evaluationContext = makeEvaluationContext(inputTable, localVocab);
+
+    auto threads = ad_utility::globalThreadBudget().reserve(
+        std::min(maxNumThreads,
+                 inputTable.size() / GROUP_BY_HASH_MAP_MIN_ROWS_PER_THREAD));
+    const size_t numThreads = threads.numThreads();
+    if (numThreads <= 1) {
+      aggregateRowsForHashMapOptimization(
+          aggregateAliases, columnIndices, aggregationData, evaluationContext,
+          0, inputTable.size(), lookupTimer, aggregationTimer);
+      continue;
+    }
 
-    // Iterate of the rows of this input block. Process (up to)
-    // `GROUP_BY_HASH_MAP_BLOCK_SIZE` rows at a time.
-    for (size_t i = 0; i < inputTable.size();
-         i += GROUP_BY_HASH_MAP_BLOCK_SIZE) {
-      checkCancellation();
-
-      evaluationContext._beginIndex = i;
-      evaluationContext._endIndex =
-          std::min(i + GROUP_BY_HASH_MAP_BLOCK_SIZE, inputTable.size());
-
-      auto currentBlockSize = evaluationContext.size();
-
-      // Perform HashMap lookup once for all groups in current block
-      using U = typename HashMapAggregationData<
-          NUM_GROUP_COLUMNS>::template ArrayOrVector<ql::span<const Id>>;
-      U groupValues;
-      resizeIfVector(groupValues, columnIndices.size());
-
-      // TODO<C++23> use views::enumerate
-      size_t j = 0;
-      for (auto& idx : columnIndices) {
-        groupValues[j] = inputTable.getColumn(idx).subspan(
-            evaluationContext._beginIndex, currentBlockSize);
-        ++j;
-      }
-      lookupTimer.cont();
-      auto hashEntries = aggregationData.getHashEntries(groupValues);
-      lookupTimer.stop();
-
-      aggregationTimer.cont();
-      for (auto& aggregateAlias : aggregateAliases) {
-        for (auto& aggregate : aggregateAlias.aggregateInfo_) {
-          sparqlExpression::ExpressionResult expressionResult =
-              GroupByImpl::evaluateChildExpressionOfAggregateFunction(
-                  aggregate, evaluationContext);
-
-          auto& aggregationDataVariant =
-              aggregationData.getAggregationDataVariant(
-                  aggregate.aggregateDataIndex_);
-
-          std::visit(makeProcessGroupsVisitor(currentBlockSize,
-                                              &evaluationContext, hashEntries),
-                     std::move(expressionResult), aggregationDataVariant);
-        }
-      }
-      aggregationTimer.stop();
+    // Split the input block into `numThreads` contiguous parts, aggregate each
+    // part into a separate hash map and local vocab, and then merge the
+    // partial results in the order of the parts. This order (together with the
+    // contiguity of the parts) guarantees the same results for `GROUP_CONCAT`
+    // and `SAMPLE` as the sequential computation.
+    numThreadsUsed = std::max(numThreadsUsed, numThreads);
+    parallelAggregationTimer.cont();
+    std::vector<HashMapAggregationData<NUM_GROUP_COLUMNS>> partialData;
+    std::vector<LocalVocab> partialVocabs(numThreads);
+    partialData.reserve(numThreads);
+    for (size_t t = 0; t < numThreads; ++t) {
+      partialData.emplace_back(getExecutionContext()->getAllocator(),
+                               aggregateAliases, columnIndices.size());
+    }
+    std::vector<std::packaged_task<void()>> tasks;
+    for (size_t t = 0; t < numThreads; ++t) {
+      tasks.emplace_back([&, t]() {
+        auto& vocab = partialVocabs[t];
+        vocab.mergeWith(inputLocalVocab);
+        auto threadContext = makeEvaluationContext(inputTable, vocab);
+        ad_utility::Timer threadLookupTimer{ad_utility::Timer::Stopped};
+        ad_utility::Timer threadAggregationTimer{ad_utility::Timer::Stopped};
+        aggregateRowsForHashMapOptimization(
+            aggregateAliases, columnIndices, partialData[t], threadContext,
+            inputTable.size() * t / numThreads,
+            inputTable.size() * (t + 1) / numThreads, threadLookupTimer,
+            threadAggregationTimer);
+      });
     }
+    ad_utility::runTasksInParallel(std::move(tasks));
+    for (size_t t = 0; t < numThreads; ++t) {
+      // The merge might compare values from the partial local vocab, so it has
+      // to be merged first.
+      localVocab.mergeWith(partialVocabs[t]);
+      aggregationData.mergeWith(std::move(partialData[t]), &evaluationContext);
+    }
+    parallelAggregationTimer.stop();
   }
 
   runtimeInfo().addDetail("timeMapLookup", lookupTimer.msecs());
   runtimeInfo().addDetail("timeAggregation", aggregationTimer.msecs());
+  if (numThreadsUsed > 1) {
+    runtimeInfo().addDetail("numThreadsForAggregation", numThreadsUsed);
+    runtimeInfo().addDetail("timeParallelAggregationAndMerge",
+                            parallelAggregationTimer.msecs());
+  }
   IdTable resultTable =
       createResultFromHashMap(aggregationData, aggregateAliases, &localVocab);
   return {std::move(resultTable), resultSortedOn(), std::move(localVocab)};
@@ -23,10 +23,17 @@
 #include "engine/sparqlExpressions/SparqlExpressionPimpl.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
 #include "parser/Alias.h"
+#include "util/Timer.h"
 #include "util/TypeIdentity.h"
 
 // Block size for when using the hash map optimization
 static constexpr size_t GROUP_BY_HASH_MAP_BLOCK_SIZE = 262144;
+// When using the hash map optimization with multiple threads, each thread
+// aggregates at least this many rows of an input block.
+static constexpr size_t GROUP_BY_HASH_MAP_MIN_ROWS_PER_THREAD = 100'000;
+// When aggregating the groups of a sorted input with multiple threads, each
+// thread aggregates the groups of at least this many rows.
+static constexpr size_t GROUP_BY_SORTED_MIN_ROWS_PER_THREAD = 100'000;
 
 namespace groupBy::detail {
 template <size_t IN_WIDTH, size_t OUT_WIDTH>
@@ -135,6 +142,22 @@ class GroupByImpl : public Operation {
                     size_t blockStart, size_t blockEnd, LocalVocab* localVocab,
                     const vector<size_t>& groupByCols) const;
 
+  // Process the complete `groups` (intervals [start, stop) of rows of the
+  // sorted `input`, in ascending order) and append one row per group to the
+  // `output`, like calling `processBlock` for each of them. If the groups
+  // span many rows, they are split into contiguous chunks of whole groups,
+  // which are aggregated concurrently (see `group-by-sorted-num-threads`),
+  // each into its own table and `LocalVocab`. The tables are then appended in
+  // order, so the result is the same as that of the sequential computation.
+  template <size_t OUT_WIDTH>
+  void processBlocks(IdTableStatic<OUT_WIDTH>& output,
+                     const std::vector<Aggregate>& aggregates,
+                     sparqlExpression::EvaluationContext& evaluationContext,
+                     const IdTableView<0>& input,
+                     ql::span<const std::pair<size_t, size_t>> groups,
+                     LocalVocab* localVocab,
+                     const vector<size_t>& groupByCols) const;
+
   // Handle queries like `SELECT (COUNT(?x) AS ?c) WHERE {...}` with conditions
   // that result in an empty result set with implicit GROUP BY where we have to
   // return a single line as a result.
@@ -191,11 +214,14 @@ class GroupByImpl : public Operation {
   //     ?x <somePredicate> ?y
   //   }
   //
-  // The single triple must contain two or three variables, and the fixed value
+  // The single triple must contain at least one variable, and the fixed value
   // in the two variable case might also be the subject or object of the triple.
-  // The COUNT may be computed on any of the variables in the triple. If the
-  // query has that form, the result of the query (which consists of one line)
-  // is computed and returned. If not, an empty optional is returned.
+  // The COUNT may be computed on any of the variables in the triple, and the
+  // triple may be restricted to constant graphs. The result is computed from
+  // the metadata of the permutation, only the blocks that are affected by
+  // located triples or the graph restriction are read. If the query has that
+  // form, the result of the query (which consists of one line) is computed and
+  // returned. If not, an empty optional is returned.
   std::optional<IdTable> computeGroupByForSingleIndexScan() const;
 
   // Check if the query represented by this GROUP BY is of the following form:
@@ -259,7 +285,8 @@ class GroupByImpl : public Operation {
     MAX,
     SUM,
     GROUP_CONCAT,
-    SAMPLE
+    SAMPLE,
+    APPROX_COUNT_DISTINCT
   };
 
   // `GROUP_CONCAT` requires additional data.
@@ -338,7 +365,8 @@ class GroupByImpl : public Operation {
   using AggregationData =
       std::variant<AvgAggregationData, CountAggregationData, MinAggregationData,
                    MaxAggregationData, SumAggregationData,
-                   GroupConcatAggregationData, SampleAggregationData>;
+                   GroupConcatAggregationData, SampleAggregationData,
+                   ApproxCountDistinctAggregationData>;
 
   using AggregationDataVectors =
       ad_utility::LiftedVariant<AggregationData,
@@ -382,6 +410,7 @@ class GroupByImpl : public Operation {
           addIf(ti<SumAggregationData>, SUM);
           addIf(ti<GroupConcatAggregationData>, GROUP_CONCAT);
           addIf(ti<SampleAggregationData>, SAMPLE);
+          addIf(ti<ApproxCountDistinctAggregationData>, APPROX_COUNT_DISTINCT);
 
           AD_CORRECTNESS_CHECK(aggregationData_.size() ==
                                aggregationDataSize + 1);
@@ -396,6 +425,15 @@ class GroupByImpl : public Operation {
     std::vector<size_t> getHashEntries(
         const ArrayOrVector<ql::span<const Id>>& groupByCols);
 
+    // Merge the groups and partial aggregation results of `other`, which has
+    // to be constructed from the same aliases, into this object. The values of
+    // `other` are treated as if they were added after the values of this
+    // object (relevant for `GROUP_CONCAT` and `SAMPLE`). The
+    // `evaluationContext` is needed to compare the values for `MIN` and `MAX`.
+    void mergeWith(
+        HashMapAggregationData&& other,
+        const sparqlExpression::EvaluationContext* evaluationContext);
+
     // Return the index of `id`.
     [[nodiscard]] size_t getIndex(const ArrayOrVector<Id>& ids) const {
       return map_.at(ids);
@@ -425,6 +463,9 @@ class GroupByImpl : public Operation {
     size_t numOfGroupedColumns_;
 
    private:
+    // Resize the vectors of aggregation data to the current number of groups.
+    void resizeAggregationVectors();
+
     // Allocator used for creating new vectors.
     const ad_utility::AllocatorWithLimit<Id>& alloc_;
     // Maps `Id` to vector offsets.
@@ -435,6 +476,19 @@ class GroupByImpl : public Operation {
     std::vector<HashMapAggregateTypeWithData> aggregateTypeWithData_;
   };
 
+  // Helper of `computeGroupByForHashMapOptimization`: Aggregate the rows
+  // `[beginRow, endRow)` of the input of the `evaluationContext` into the
+  // `aggregationData`. The `lookupTimer` and `aggregationTimer` are continued
+  // for the respective parts of the work.
+  template <size_t NUM_GROUP_COLUMNS>
+  void aggregateRowsForHashMapOptimization(
+      const std::vector<HashMapAliasInformation>& aggregateAliases,
+      const std::vector<size_t>& columnIndices,
+      HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData,
+      sparqlExpression::EvaluationContext& evaluationContext, size_t beginRow,
+      size_t endRow, ad_utility::Timer& lookupTimer,
+      ad_utility::Timer& aggregationTimer) const;
+
   // Returns the aggregation results between `beginIndex` and `endIndex`
   // of the aggregates stored at `dataIndex`,
   // based on the groups stored in the first column of `resultTable`
@@ -503,11 +557,24 @@ class GroupByImpl : public Operation {
 
   // Check if hash map optimization is applicable. This is the case when
   // the following conditions hold true:
-  // - Runtime parameter is set
+  // - Runtime parameter is set or the hash map is estimated to be cheaper than
+  //   sorting (see `isHashMapEstimatedToBeCheaperThanSort`)
   // - Child operation is SORT
   std::optional<HashMapOptimizationData> checkIfHashMapOptimizationPossible(
       std::vector<Aggregate>& aggregates) const;
 
+  // Return true if the `group-by-hash-map-cost-based` runtime parameter is set
+  // and the size estimates of the input suggest that the hash map
+  // optimization is cheaper than sorting the input. This is the case if the
+  // input is large (cost factor `GROUP_BY_HASH_MAP_MIN_INPUT_SIZE`) and the
+  // estimated number of groups is small relative to the size of the input
+  // (cost factor `GROUP_BY_HASH_MAP_MAX_GROUPS_RATIO`). Requires that the
+  // root of the `_subtree` is a `Sort`.
+  bool isHashMapEstimatedToBeCheaperThanSort() const;
+
+  // Estimate the number of groups, see `getSizeEstimateBeforeLimit`.
+  uint64_t estimateNumberOfGroups() const;
+
   // Extract values from `expressionResult` and store them in the rows of
   // `resultTable` specified by the indices in `evaluationContext`, in column
   // `outCol`.
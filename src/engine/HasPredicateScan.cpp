@@ -6,12 +6,14 @@
 #include "engine/HasPredicateScan.h"
 
 #include "engine/AddCombinedRowToTable.h"
-#include "engine/CallFixedSize.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/PermutationSelector.h"
+#include "global/RuntimeParameters.h"
 #include "index/IndexImpl.h"
 #include "util/JoinAlgorithms/JoinColumnMapping.h"
+#include "util/ParallelExecutor.h"
+#include "util/ThreadBudget.h"
 
 // Assert that the `type` is a valid value for the `ScanType` enum.
 static void checkType(HasPredicateScan::ScanType type) {
@@ -254,17 +256,27 @@ size_t HasPredicateScan::getCostEstimate() {
 }
 
 // ___________________________________________________________________________
-Result HasPredicateScan::computeResult([[maybe_unused]] bool requestLaziness) {
+Result HasPredicateScan::computeResult(bool requestLaziness) {
   IdTable idTable{getExecutionContext()->getAllocator()};
   idTable.setNumColumns(getResultWidth());
 
   const CompactVectorOfStrings<Id>& patterns = getIndex().getPatterns();
 
+  if (type_ == ScanType::SUBQUERY_S) {
+    // The `subtree_` already is the join of the subquery with the
+    // `ql:has-pattern` scan, so only the patterns have to be expanded.
+    return expandAllBlocks(subtree().getResult(requestLaziness),
+                           subtreeColIdx(), requestLaziness);
+  }
+
   // Note: The variable names don't matter because we directly process the
   // result here.
   auto scan = makePatternScan(
       getExecutionContext(), TripleComponent{Variable{"?_s"}}, Variable{"?_o"});
   auto result = scan->getResult(true);
+  if (type_ == ScanType::FULL_SCAN) {
+    return expandAllBlocks(std::move(result), 1, requestLaziness);
+  }
   // The `callback` is invoked with a single-value span of the `idTable` if the
   // result is fully materialized, because it expects a range of `IdTable`s.
   // Because of caching we can potentially get a fully materialized result here.
@@ -298,22 +310,104 @@ Result HasPredicateScan::computeResult([[maybe_unused]] bool requestLaziness) {
     case ScanType::FREE_O:
       computeFreeO(&idTable, subject_, patterns);
       return {std::move(idTable), resultSortedOn(), LocalVocab{}};
+    default:
+      AD_FAIL();
+  }
+}
 
-    case ScanType::FULL_SCAN:
-      runOnResult([this, &idTable, &patterns](auto hasPattern) {
-        computeFullScan(&idTable, hasPattern, patterns,
-                        getIndex().getNumDistinctSubjectPredicatePairs());
-      });
-      return {std::move(idTable), resultSortedOn(), LocalVocab{}};
-    case ScanType::SUBQUERY_S:
+// ___________________________________________________________________________
+Result HasPredicateScan::expandAllBlocks(std::shared_ptr<const Result> input,
+                                         ColumnIndex patternColumn,
+                                         bool requestLaziness) {
+  // The `input` is captured to keep its blocks alive.
+  auto expandBlock = [this, input, patternColumn](const IdTable& block) {
+    return expandPatterns(
+        block, patternColumn, getIndex().getPatterns(),
+        getRuntimeParameter<&RuntimeParameters::hasPredicateScanNumThreads_>(),
+        allocator());
+  };
+  if (input->isFullyMaterialized()) {
+    return {expandBlock(input->idTable()), resultSortedOn(),
+            input->getSharedLocalVocab()};
+  }
+  if (requestLaziness) {
+    auto sortedOn = resultSortedOn();
+    return {transformLazyResult(
+                input->idTables(),
+                [expandBlock](Result::IdTableVocabPair& pair) {
+                  return Result::IdTableVocabPair{expandBlock(pair.idTable_),
+                                                  std::move(pair.localVocab_)};
+                },
+                !sortedOn.empty()),
+            std::move(sortedOn)};
+  }
+  IdTable result{getResultWidth(), allocator()};
+  if (type_ == ScanType::FULL_SCAN) {
+    result.reserve(getIndex().getNumDistinctSubjectPredicatePairs());
+  }
+  LocalVocab localVocab;
+  for (Result::IdTableVocabPair& pair : input->idTables()) {
+    checkCancellation();
+    result.insertAtEnd(expandBlock(pair.idTable_));
+    localVocab.mergeWith(pair.localVocab_);
+  }
+  return {std::move(result), resultSortedOn(), std::move(localVocab)};
+}
 
-      auto width = static_cast<int>(idTable.numColumns());
-      auto doCompute = [this, &idTable, &patterns](auto width) {
-        return computeSubqueryS<width>(&idTable, patterns);
-      };
-      return ad_utility::callFixedSizeVi(width, doCompute);
+// ___________________________________________________________________________
+IdTable HasPredicateScan::expandPatterns(
+    const IdTable& input, ColumnIndex patternColumn,
+    const CompactVectorOfStrings<Id>& patterns, size_t maxNumThreads,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  decltype(auto) patternIds = input.getColumn(patternColumn);
+  auto getPattern = [&patterns, &patternIds](size_t row) {
+    return patterns[patternIds[row].getInt()];
+  };
+  // The first row of the result that belongs to each row of the `input`.
+  std::vector<size_t> offsets;
+  offsets.reserve(input.numRows() + 1);
+  size_t numResultRows = 0;
+  for (size_t row : ad_utility::integerRange(input.numRows())) {
+    offsets.push_back(numResultRows);
+    numResultRows += getPattern(row).size();
   }
-  AD_FAIL();
+  offsets.push_back(numResultRows);
+
+  IdTable result{input.numColumns(), allocator};
+  result.resize(numResultRows);
+  auto threads = ad_utility::globalThreadBudget().reserve(
+      std::min(std::max(maxNumThreads, size_t{1}),
+               input.numRows() / minNumRowsPerThread_));
+  const size_t numThreads = threads.numThreads();
+
+  // Write the result rows of the `t`-th part of the `input`, column by column.
+  auto expandPart = [&](size_t t) {
+    size_t begin = input.numRows() * t / numThreads;
+    size_t end = input.numRows() * (t + 1) / numThreads;
+    for (auto col : ad_utility::integerRange(input.numColumns())) {
+      decltype(auto) inputColumn = input.getColumn(col);
+      decltype(auto) resultColumn = result.getColumn(col);
+      for (size_t row = begin; row < end; ++row) {
+        auto target = resultColumn.begin() + offsets[row];
+        if (col == patternColumn) {
+          ql::ranges::copy(getPattern(row), target);
+        } else {
+          std::fill(target, resultColumn.begin() + offsets[row + 1],
+                    inputColumn[row]);
+        }
+      }
+    }
+  };
+  if (numThreads == 1) {
+    expandPart(0);
+  } else {
+    std::vector<std::packaged_task<void()>> tasks;
+    for (size_t t = 0; t < numThreads; ++t) {
+      tasks.emplace_back([&expandPart, t]() { expandPart(t); });
+    }
+    ad_utility::runTasksInParallel(std::move(tasks));
+  }
+  return result;
 }
 
 // ___________________________________________________________________________
@@ -359,44 +453,6 @@ void HasPredicateScan::computeFreeO(
   }
 }
 
-// ___________________________________________________________________________
-template <typename HasPattern>
-void HasPredicateScan::computeFullScan(
-    IdTable* resultTable, HasPattern& hasPattern,
-    const CompactVectorOfStrings<Id>& patterns, size_t resultSize) {
-  IdTableStatic<2> result = std::move(*resultTable).toStatic<2>();
-  result.reserve(resultSize);
-  for (const auto& block : hasPattern) {
-    auto patternColumn = block.getColumn(1);
-    auto subjects = block.getColumn(0);
-    for (size_t i : ad_utility::integerRange(block.numRows())) {
-      const auto& pattern = patterns[patternColumn[i].getInt()];
-      for (const auto& predicate : pattern) {
-        result.push_back({subjects[i], predicate});
-      }
-    }
-  }
-  *resultTable = std::move(result).toDynamic();
-}
-
-// ___________________________________________________________________________
-template <int WIDTH>
-Result HasPredicateScan::computeSubqueryS(
-    IdTable* dynResult, const CompactVectorOfStrings<Id>& patterns) {
-  auto subresult = subtree().getResult();
-  auto patternCol = subtreeColIdx();
-  auto result = std::move(*dynResult).toStatic<WIDTH>();
-  for (const auto& row : subresult->idTable().asStaticView<WIDTH>()) {
-    const auto& pattern = patterns[row[patternCol].getInt()];
-    for (auto predicate : pattern) {
-      result.push_back(row);
-      result.back()[patternCol] = predicate;
-    }
-  }
-  return {std::move(result).toDynamic(), resultSortedOn(),
-          subresult->getSharedLocalVocab()};
-}
-
 // ___________________________________________________________________________
 const TripleComponent& HasPredicateScan::getObject() const { return object_; }
 
@@ -103,19 +103,31 @@ class HasPredicateScan : public Operation {
   void computeFreeO(IdTable* resultTable, TripleComponent subject,
                     const CompactVectorOfStrings<Id>& patterns) const;
 
-  template <typename HasPattern>
-  void computeFullScan(IdTable* resultTable, HasPattern& hasPattern,
-                       const CompactVectorOfStrings<Id>& patterns,
-                       size_t resultSize);
-
-  template <int WIDTH>
-  Result computeSubqueryS(IdTable* result,
-                          const CompactVectorOfStrings<Id>& patterns);
+  // Blocks with fewer rows per thread are expanded by fewer threads.
+  static constexpr size_t minNumRowsPerThread_ = 100'000;
+
+  // Return a copy of the `input`, where each row is repeated once per
+  // predicate of the pattern in its `patternColumn`, and the pattern is
+  // replaced by the predicate. The output position of each row is computed
+  // upfront, s.t. large inputs can be split between up to `maxNumThreads`
+  // threads that write disjoint parts of the result.
+  static IdTable expandPatterns(
+      const IdTable& input, ColumnIndex patternColumn,
+      const CompactVectorOfStrings<Id>& patterns, size_t maxNumThreads,
+      const ad_utility::AllocatorWithLimit<Id>& allocator);
 
  private:
   std::unique_ptr<Operation> cloneImpl() const override;
 
-  Result computeResult([[maybe_unused]] bool requestLaziness) override;
+  // The `FULL_SCAN` and the `SUBQUERY_S` are computed lazily if
+  // `requestLaziness` is true, one block of the `ql:has-pattern` scan or of the
+  // `subtree_` at a time.
+  Result computeResult(bool requestLaziness) override;
+
+  // Expand the patterns in the `patternColumn` of each block of the `input`
+  // (see `expandPatterns`), lazily if `requestLaziness` is true.
+  Result expandAllBlocks(std::shared_ptr<const Result> input,
+                         ColumnIndex patternColumn, bool requestLaziness);
 
   [[nodiscard]] VariableToColumnMap computeVariableToColumnMap() const override;
 
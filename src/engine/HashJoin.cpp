@@ -0,0 +1,288 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/HashJoin.h"
+
+#include <sstream>
+
+#include "engine/AddCombinedRowToTable.h"
+#include "engine/JoinHelpers.h"
+#include "util/HashMap.h"
+
+using namespace qlever::joinHelpers;
+
+// _____________________________________________________________________________
+HashJoin::HashJoin(QueryExecutionContext* qec,
+                   std::shared_ptr<QueryExecutionTree> left,
+                   std::shared_ptr<QueryExecutionTree> right,
+                   ColumnIndex leftJoinColumn, ColumnIndex rightJoinColumn)
+    : Operation{qec},
+      left_{std::move(left)},
+      right_{std::move(right)},
+      leftJoinColumn_{leftJoinColumn},
+      rightJoinColumn_{rightJoinColumn},
+      joinVariable_{"?notSet"} {
+  AD_CONTRACT_CHECK(left_ && right_);
+  joinVariable_ =
+      left_->getVariableAndInfoByColumnIndex(leftJoinColumn_).first;
+  AD_CONTRACT_CHECK(
+      joinVariable_ ==
+      right_->getVariableAndInfoByColumnIndex(rightJoinColumn_).first);
+  leftIsBuildSide_ = left_->getSizeEstimate() <= right_->getSizeEstimate();
+}
+
+// _____________________________________________________________________________
+std::string HashJoin::getDescriptor() const {
+  return "HashJoin on " + joinVariable_.name();
+}
+
+// _____________________________________________________________________________
+std::string HashJoin::getCacheKeyImpl() const {
+  // The build side is part of the cache key, because it determines the order
+  // of the result.
+  std::ostringstream os;
+  os << "HASH JOIN build side " << (leftIsBuildSide_ ? "left" : "right")
+     << "\n"
+     << left_->getCacheKey() << " join-column: [" << leftJoinColumn_ << "]\n";
+  os << "|X|\n"
+     << right_->getCacheKey() << " join-column: [" << rightJoinColumn_ << "]";
+  return std::move(os).str();
+}
+
+// _____________________________________________________________________________
+size_t HashJoin::getResultWidth() const {
+  return left_->getResultWidth() + right_->getResultWidth() - 1;
+}
+
+// _____________________________________________________________________________
+size_t HashJoin::getCostEstimate() {
+  const auto& build = leftIsBuildSide_ ? left_ : right_;
+  const auto& probe = leftIsBuildSide_ ? right_ : left_;
+  auto buildCost = static_cast<double>(build->getSizeEstimate()) *
+                   getExecutionContext()->getCostFactor(
+                       "HASH_JOIN_BUILD_COST_PER_ROW");
+  auto probeCost = static_cast<double>(probe->getSizeEstimate()) *
+                   getExecutionContext()->getCostFactor(
+                       "HASH_JOIN_PROBE_COST_PER_ROW");
+  return getSizeEstimateBeforeLimit() + static_cast<size_t>(buildCost) +
+         static_cast<size_t>(probeCost) + left_->getCostEstimate() +
+         right_->getCostEstimate();
+}
+
+// _____________________________________________________________________________
+uint64_t HashJoin::getSizeEstimateBeforeLimit() {
+  if (!sizeEstimate_.has_value()) {
+    computeSizeEstimateAndMultiplicities();
+  }
+  return sizeEstimate_.value();
+}
+
+// _____________________________________________________________________________
+float HashJoin::getMultiplicity(size_t col) {
+  if (!sizeEstimate_.has_value()) {
+    computeSizeEstimateAndMultiplicities();
+  }
+  return multiplicities_.at(col);
+}
+
+// _____________________________________________________________________________
+void HashJoin::computeSizeEstimateAndMultiplicities() {
+  multiplicities_.clear();
+  auto sizeLeft = static_cast<double>(left_->getSizeEstimate());
+  auto sizeRight = static_cast<double>(right_->getSizeEstimate());
+  if (sizeLeft == 0 || sizeRight == 0) {
+    sizeEstimate_ = 0;
+    multiplicities_.resize(getResultWidth(), 1.0f);
+    return;
+  }
+  double multiplicityLeft = left_->getMultiplicity(leftJoinColumn_);
+  double multiplicityRight = right_->getMultiplicity(rightJoinColumn_);
+  double numDistinct =
+      std::max(1.0, std::min(sizeLeft / multiplicityLeft,
+                             sizeRight / multiplicityRight));
+  double corrFactor = getExecutionContext()->getCostFactor(
+      "JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR");
+  sizeEstimate_ = std::max(
+      uint64_t{1}, static_cast<uint64_t>(corrFactor * multiplicityLeft *
+                                         multiplicityRight * numDistinct));
+
+  for (auto i = ColumnIndex{0}; i < left_->getResultWidth(); ++i) {
+    multiplicities_.push_back(static_cast<float>(std::max(
+        1.0, left_->getMultiplicity(i) * multiplicityRight * corrFactor)));
+  }
+  for (auto i = ColumnIndex{0}; i < right_->getResultWidth(); ++i) {
+    if (i != rightJoinColumn_) {
+      multiplicities_.push_back(static_cast<float>(std::max(
+          1.0, right_->getMultiplicity(i) * multiplicityLeft * corrFactor)));
+    }
+  }
+}
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> HashJoin::resultSortedOn() const {
+  const auto& probe = leftIsBuildSide_ ? right_ : left_;
+  ColumnIndex probeJoinColumn =
+      leftIsBuildSide_ ? rightJoinColumn_ : leftJoinColumn_;
+  auto toResultColumn = [this,
+                         probeJoinColumn](ColumnIndex col) -> ColumnIndex {
+    if (!leftIsBuildSide_) {
+      return col;
+    }
+    // The probe side is the right child.
+    if (col == probeJoinColumn) {
+      return leftJoinColumn_;
+    }
+    return left_->getResultWidth() + col -
+           static_cast<size_t>(col > probeJoinColumn);
+  };
+  bool mightContainUndef =
+      probe->getVariableColumns().at(joinVariable_).mightContainUndef_ !=
+      ColumnIndexAndTypeInfo::AlwaysDefined;
+  std::vector<ColumnIndex> sortedOn;
+  for (ColumnIndex col : probe->resultSortedOn()) {
+    if (col == probeJoinColumn && mightContainUndef) {
+      break;
+    }
+    sortedOn.push_back(toResultColumn(col));
+  }
+  return sortedOn;
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap HashJoin::computeVariableToColumnMap() const {
+  return makeVarToColMapForJoinOperation(
+      left_->getVariableColumns(), right_->getVariableColumns(),
+      {{leftJoinColumn_, rightJoinColumn_}}, BinOpType::Join,
+      left_->getResultWidth());
+}
+
+// _____________________________________________________________________________
+bool HashJoin::columnOriginatesFromGraphOrUndef(
+    const Variable& variable) const {
+  AD_CONTRACT_CHECK(getExternallyVisibleVariableColumns().contains(variable));
+  if (variable == joinVariable_) {
+    return doesJoinProduceGuaranteedGraphValuesOrUndef(left_, right_, variable);
+  }
+  return Operation::columnOriginatesFromGraphOrUndef(variable);
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<Operation> HashJoin::cloneImpl() const {
+  auto copy = std::make_unique<HashJoin>(*this);
+  copy->left_ = left_->clone();
+  copy->right_ = right_->clone();
+  return copy;
+}
+
+// _____________________________________________________________________________
+ad_utility::JoinColumnMapping HashJoin::getJoinColumnMapping() const {
+  return ad_utility::JoinColumnMapping{{{leftJoinColumn_, rightJoinColumn_}},
+                                       left_->getResultWidth(),
+                                       right_->getResultWidth()};
+}
+
+// _____________________________________________________________________________
+Result HashJoin::computeResult(bool requestLaziness) {
+  if (knownEmptyResult()) {
+    left_->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    right_->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    return {IdTable{getResultWidth(), allocator()}, resultSortedOn(),
+            LocalVocab{}};
+  }
+  const auto& build = leftIsBuildSide_ ? left_ : right_;
+  const auto& probe = leftIsBuildSide_ ? right_ : left_;
+  std::shared_ptr<const Result> buildResult = build->getResult();
+  checkCancellation();
+  if (buildResult->idTable().empty()) {
+    probe->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    return {IdTable{getResultWidth(), allocator()}, resultSortedOn(),
+            LocalVocab{}};
+  }
+  std::shared_ptr<const Result> probeResult = probe->getResult(true);
+  runtimeInfo().addDetail("build side", leftIsBuildSide_ ? "left" : "right");
+
+  auto joinColumnMapping = getJoinColumnMapping();
+  auto resultPermutation = joinColumnMapping.permutationResult();
+  auto action = [this, buildResult = std::move(buildResult),
+                 probeResult = std::move(probeResult),
+                 joinColumnMapping = std::move(joinColumnMapping)](
+                    std::function<void(IdTable&, LocalVocab&)> yieldTable) {
+    // After the permutation, the join column is the first column of both
+    // inputs.
+    const auto& buildPermutation = leftIsBuildSide_
+                                       ? joinColumnMapping.permutationLeft()
+                                       : joinColumnMapping.permutationRight();
+    const auto& probePermutation = leftIsBuildSide_
+                                       ? joinColumnMapping.permutationRight()
+                                       : joinColumnMapping.permutationLeft();
+    auto buildView = asSingleTableView(*buildResult, buildPermutation);
+    const auto& buildTable = buildView[0];
+
+    // The rows of the build side for each join value. The rows with UNDEF
+    // values match all the rows of the probe side, so they are stored
+    // separately.
+    ad_utility::HashMap<Id, std::vector<size_t>> rowsForValue;
+    std::vector<size_t> undefRows;
+    for (size_t i = 0; i < buildTable.size(); ++i) {
+      Id id = buildTable[i];
+      if (id.isUndefined()) {
+        undefRows.push_back(i);
+      } else {
+        rowsForValue[id].push_back(i);
+      }
+    }
+    checkCancellation();
+
+    ad_utility::AddCombinedRowToIdTable rowAdder{
+        1, IdTable{getResultWidth(), allocator()}, cancellationHandle_, true,
+        CHUNK_SIZE, std::move(yieldTable)};
+    auto addRow = [this, &rowAdder](size_t buildRow, size_t probeRow) {
+      if (leftIsBuildSide_) {
+        rowAdder.addRow(buildRow, probeRow);
+      } else {
+        rowAdder.addRow(probeRow, buildRow);
+      }
+    };
+    auto probeBlocks = resultToView(*probeResult, probePermutation);
+    std::visit(
+        [&](auto& blocks) {
+          for (const auto& block : blocks) {
+            if (leftIsBuildSide_) {
+              rowAdder.setInput(buildTable, block);
+            } else {
+              rowAdder.setInput(block, buildTable);
+            }
+            for (size_t i = 0; i < block.size(); ++i) {
+              Id id = block[i];
+              if (id.isUndefined()) {
+                for (size_t j = 0; j < buildTable.size(); ++j) {
+                  addRow(j, i);
+                }
+                continue;
+              }
+              if (auto it = rowsForValue.find(id); it != rowsForValue.end()) {
+                for (size_t j : it->second) {
+                  addRow(j, i);
+                }
+              }
+              for (size_t j : undefRows) {
+                addRow(j, i);
+              }
+            }
+            checkCancellation();
+          }
+        },
+        probeBlocks);
+    auto localVocab = std::move(rowAdder.localVocab());
+    return Result::IdTableVocabPair{std::move(rowAdder).resultTable(),
+                                    std::move(localVocab)};
+  };
+  return createResultFromAction(requestLaziness, std::move(action),
+                                resultSortedOn(), std::move(resultPermutation));
+}
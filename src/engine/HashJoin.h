@@ -0,0 +1,102 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_HASHJOIN_H
+#define QLEVER_SRC_ENGINE_HASHJOIN_H
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+#include "util/JoinAlgorithms/JoinColumnMapping.h"
+
+// A join of two inputs on a single column that, unlike `Join`, doesn't require
+// its inputs to be sorted. The smaller input according to the size estimates
+// (the "build side") is fully materialized and its rows are stored in a hash
+// map with the join values as keys. The larger input (the "probe side") is
+// then read lazily, and each of its rows is looked up in the hash map. This
+// avoids sorting the inputs, which is expensive for a large input that is not
+// sorted on the join column, for example the result of a `GROUP BY`, `BIND`,
+// or `SERVICE`.
+//
+// The columns of the result are the same as for a `Join` (all the columns of
+// the left child, followed by the non-join columns of the right child). The
+// rows are in the order of the probe side, so the result is sorted like the
+// probe side (see `resultSortedOn`).
+class HashJoin : public Operation {
+ private:
+  std::shared_ptr<QueryExecutionTree> left_;
+  std::shared_ptr<QueryExecutionTree> right_;
+  ColumnIndex leftJoinColumn_;
+  ColumnIndex rightJoinColumn_;
+  Variable joinVariable_;
+  // True iff the left child is the build side.
+  bool leftIsBuildSide_;
+
+  std::optional<uint64_t> sizeEstimate_;
+  std::vector<float> multiplicities_;
+
+ public:
+  HashJoin(QueryExecutionContext* qec, std::shared_ptr<QueryExecutionTree> left,
+           std::shared_ptr<QueryExecutionTree> right,
+           ColumnIndex leftJoinColumn, ColumnIndex rightJoinColumn);
+
+  bool leftIsBuildSide() const { return leftIsBuildSide_; }
+
+  std::vector<QueryExecutionTree*> getChildren() override {
+    return {left_.get(), right_.get()};
+  }
+
+  std::string getDescriptor() const override;
+
+  size_t getResultWidth() const override;
+
+  // The cost of the join is dominated by inserting the rows of the build side
+  // into the hash map and by the lookups of the rows of the probe side (see
+  // the `HASH_JOIN_...` factors in `QueryPlanningCostFactors`).
+  size_t getCostEstimate() override;
+
+  float getMultiplicity(size_t col) override;
+
+  bool knownEmptyResult() override {
+    return left_->knownEmptyResult() || right_->knownEmptyResult();
+  }
+
+  bool columnOriginatesFromGraphOrUndef(
+      const Variable& variable) const override;
+
+ private:
+  std::string getCacheKeyImpl() const override;
+
+  // The same basic estimate as for a `Join`. It is computed together with the
+  // multiplicities.
+  uint64_t getSizeEstimateBeforeLimit() override;
+
+  void computeSizeEstimateAndMultiplicities();
+
+  // The sorted columns of the probe side (translated to the columns of the
+  // result), up to the join column if the probe side might contain UNDEF
+  // values in the join column (for these rows, the join value of the result is
+  // taken from the build side).
+  std::vector<ColumnIndex> resultSortedOn() const override;
+
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+  std::unique_ptr<Operation> cloneImpl() const override;
+
+  // The result is lazy if `requestLaziness` is true. In this case, only the
+  // build side is materialized.
+  Result computeResult(bool requestLaziness) override;
+
+  ad_utility::JoinColumnMapping getJoinColumnMapping() const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_HASHJOIN_H
@@ -225,35 +225,46 @@ IndexScan::getUpdatedQueryExecutionTreeWithPrefilterApplied(
     return std::nullopt;
   }
 
-  // Get the variable by which this `IndexScan` is sorted, and its
-  // corresponding column index. If there is no variable, we cannot apply
-  // prefiltering (and there typically is no need to).
-  auto sortedVarAndColIndex =
-      getSortedVariableAndMetadataColumnIndexForPrefiltering();
-  if (!sortedVarAndColIndex.has_value()) {
+  // Get the variables of this `IndexScan` together with their corresponding
+  // column index. If there is no variable, we cannot apply prefiltering (and
+  // there typically is no need to).
+  auto varsAndColIndices =
+      getVariablesAndMetadataColumnIndicesForPrefiltering();
+  if (varsAndColIndices.empty()) {
     return std::nullopt;
   }
 
-  // Return a new `IndexScan` with updated `scanSpecAndBlocks_`, by
-  // intersecting its block ranges with the block ranges from the applicable
-  // prefilters.
-  const auto& [sortedVar, colIndex] = sortedVarAndColIndex.value();
-  auto it =
-      ql::ranges::find(prefilterVariablePairs, sortedVar, ad_utility::second);
-  if (it != prefilterVariablePairs.end()) {
-    const auto& blockMetadataRanges =
+  // Intersect the current block ranges with the block ranges from the
+  // applicable prefilters. The first variable is the one by which the blocks
+  // are sorted, so we can prefilter it via the `firstTriple_` and
+  // `lastTriple_` of the blocks. For the other variables, we have to use the
+  // per-block column statistics.
+  auto blockSpan = getScanSpecAndBlocks().getBlockMetadataSpan();
+  std::optional<BlockMetadataRanges> blockMetadataRanges;
+  for (const auto& [var, colIndex] : varsAndColIndices) {
+    auto it = ql::ranges::find(prefilterVariablePairs, var, ad_utility::second);
+    if (it == prefilterVariablePairs.end()) {
+      continue;
+    }
+    const auto& prefilter = *it->first;
+    bool isSortedVar = var == varsAndColIndices.front().first;
+    auto relevantRanges =
+        isSortedVar ? prefilter.evaluate(getLocalVocabContext(), blockSpan,
+                                         colIndex)
+                    : prefilter.evaluateWithColumnStatistics(
+                          getLocalVocabContext(), blockSpan, colIndex);
+    blockMetadataRanges =
         prefilterExpressions::detail::logicalOps::getIntersectionOfBlockRanges(
-            it->first->evaluate(getLocalVocabContext(),
-                                getScanSpecAndBlocks().getBlockMetadataSpan(),
-                                colIndex),
-            scanSpecAndBlocks_.blockMetadata_);
-
-    return makeCopyWithPrefilteredScanSpecAndBlocks(
-        {scanSpecAndBlocks_.scanSpec_, blockMetadataRanges});
+            relevantRanges,
+            blockMetadataRanges.value_or(scanSpecAndBlocks_.blockMetadata_));
   }
 
   // If no prefilter applies, return `std::nullopt`.
-  return std::nullopt;
+  if (!blockMetadataRanges.has_value()) {
+    return std::nullopt;
+  }
+  return makeCopyWithPrefilteredScanSpecAndBlocks(
+      {scanSpecAndBlocks_.scanSpec_, std::move(blockMetadataRanges.value())});
 }
 
 // _____________________________________________________________________________
@@ -317,10 +328,11 @@ Result::LazyResult IndexScan::chunkedIndexScan() const {
 }
 
 // _____________________________________________________________________________
-IdTable IndexScan::materializedIndexScan() const {
-  IdTable idTable = permutation().scan(scanSpecAndBlocks_, additionalColumns(),
-                                       cancellationHandle_,
-                                       locatedTriplesState(), getLimitOffset());
+IdTable IndexScan::materializedIndexScan(
+    LazyScanMetadata* scanMetadata) const {
+  IdTable idTable = permutation().scan(
+      scanSpecAndBlocks_, getAdditionalColumnsToRead(), cancellationHandle_,
+      locatedTriplesState(), getLimitOffset(), scanMetadata);
   AD_LOG_DEBUG << "IndexScan result computation done.\n";
   checkCancellation();
   idTable = makeApplyColumnSubset()(std::move(idTable));
@@ -331,10 +343,103 @@ IdTable IndexScan::materializedIndexScan() const {
 // _____________________________________________________________________________
 Result IndexScan::computeResult(bool requestLaziness) {
   AD_LOG_DEBUG << "IndexScan result computation...\n";
+  if (runtimeJoinFilter_ != nullptr) {
+    return computeResultWithRuntimeJoinFilter(requestLaziness);
+  }
   if (requestLaziness) {
     return {chunkedIndexScan(), resultSortedOn()};
   }
-  return {materializedIndexScan(), getResultSortedOn(), LocalVocab{}};
+  LazyScanMetadata metadata;
+  auto idTable = materializedIndexScan(&metadata);
+  runtimeInfo().numBytesRead_ = metadata.numBytesRead_;
+  runtimeInfo().numBytesDecompressed_ = metadata.numBytesDecompressed_;
+  return {std::move(idTable), getResultSortedOn(), LocalVocab{}};
+}
+
+// _____________________________________________________________________________
+Result IndexScan::computeResultWithRuntimeJoinFilter(bool requestLaziness) {
+  AD_CORRECTNESS_CHECK(getLimitOffset().isUnconstrained());
+  runtimeInfo().addDetail("runtime-join-filter-size",
+                          runtimeJoinFilter_->keys().size());
+  // Only read the blocks that can contain matching rows, and remove the other
+  // rows from these blocks.
+  Result::LazyResult blocks{ad_utility::CachingTransformInputRange(
+      lazyScanForJoinOfColumnWithScan(runtimeJoinFilter_->keys()),
+      [filter = runtimeJoinFilter_,
+       column = runtimeJoinFilterColumn_](auto& table) {
+        filter->filterRows(table, column);
+        return Result::IdTableVocabPair{std::move(table), LocalVocab{}};
+      })};
+  if (requestLaziness) {
+    return {std::move(blocks), resultSortedOn()};
+  }
+  IdTable idTable{getResultWidth(), allocator()};
+  for (auto& pair : blocks) {
+    idTable.insertAtEnd(pair.idTable_);
+    checkCancellation();
+  }
+  return {std::move(idTable), getResultSortedOn(), LocalVocab{}};
+}
+
+// _____________________________________________________________________________
+bool IndexScan::addRuntimeJoinFilter(
+    const Variable& variable, std::shared_ptr<const RuntimeJoinFilter> filter) {
+  if (numVariables_ == 0 || runtimeJoinFilter_ != nullptr ||
+      !getLimitOffset().isUnconstrained()) {
+    return false;
+  }
+  // The blocks are only sorted by the first variable of the permuted triple.
+  const TripleComponent& first = *getPermutedTriple().at(3 - numVariables_);
+  if (!first.isVariable() || first.getVariable() != variable) {
+    return false;
+  }
+  // The `variable` might have been stripped from the result.
+  const auto& columns = getExternallyVisibleVariableColumns();
+  auto it = columns.find(variable);
+  if (it == columns.end()) {
+    return false;
+  }
+  runtimeJoinFilter_ = std::move(filter);
+  runtimeJoinFilterColumn_ = it->second.columnIndex_;
+  disableStoringInCache();
+  return true;
+}
+
+// _____________________________________________________________________________
+const ad_utility::HyperLogLog* IndexScan::getDistinctValueSketch(
+    ColumnIndex col) const {
+  auto permutationType = permutation().permutation();
+  if (numVariables_ != 2 || !additionalColumns_.empty() ||
+      (permutationType != Permutation::Enum::PSO &&
+       permutationType != Permutation::Enum::POS) ||
+      subject_ == object_) {
+    return nullptr;
+  }
+  // Custom permutations (e.g. materialized views) have no statistics.
+  const auto& index = getIndex().getImpl();
+  if (permutation_.get() != &index.getPermutation(permutationType)) {
+    return nullptr;
+  }
+  const auto& predicateId = scanSpecAndBlocks_.scanSpec_.col0Id();
+  if (!predicateId.has_value()) {
+    return nullptr;
+  }
+  const auto* sketches =
+      index.predicateStatistics().getSketches(predicateId.value());
+  if (sketches == nullptr) {
+    return nullptr;
+  }
+  const auto& columns = getExternallyVisibleVariableColumns();
+  auto isColumnOf = [&columns, col](const TripleComponent& tc) {
+    auto it = columns.find(tc.getVariable());
+    return it != columns.end() && it->second.columnIndex_ == col;
+  };
+  if (isColumnOf(subject_)) {
+    return &sketches->subjects_;
+  } else if (isColumnOf(object_)) {
+    return &sketches->objects_;
+  }
+  return nullptr;
 }
 
 // _____________________________________________________________________________
@@ -378,11 +483,41 @@ size_t IndexScan::getExactSize() const {
                                            locatedTriplesState());
 }
 
+// _____________________________________________________________________________
+size_t IndexScan::computeNumRowsOfBlocksToRead() const {
+  if (numVariables() == 3 && !scanSpecAndBlocksIsPrefiltered_) {
+    return permutation().numTriples();
+  }
+  size_t numRows = 0;
+  for (const auto& block : scanSpecAndBlocks_.getBlockMetadataView()) {
+    numRows += block.numRows_;
+  }
+  return numRows;
+}
+
 // _____________________________________________________________________________
 size_t IndexScan::getCostEstimate() {
   // If we have a limit present, we only have to read the first
   // `limit + offset` elements.
-  return getLimitOffset().upperBound(getSizeEstimateBeforeLimit());
+  size_t sizeEstimate = getSizeEstimateBeforeLimit();
+  size_t numRowsOfResult = getLimitOffset().upperBound(sizeEstimate);
+
+  // The cost is dominated by the decompression of the blocks, which contain
+  // all the rows of the result, but the first and the last block can contain
+  // more rows. This makes the cost estimate for the same triple depend on the
+  // chosen permutation, and it punishes scans for which the result is spread
+  // over many (partial) blocks.
+  if (!numRowsOfBlocksToRead_.has_value()) {
+    numRowsOfBlocksToRead_ = computeNumRowsOfBlocksToRead();
+  }
+  size_t numRowsToRead = std::max(sizeEstimate, numRowsOfBlocksToRead_.value());
+  if (numRowsOfResult < sizeEstimate) {
+    // With a limit, only the first blocks are read.
+    numRowsToRead = static_cast<size_t>(
+        static_cast<double>(numRowsToRead) *
+        (static_cast<double>(numRowsOfResult) / sizeEstimate));
+  }
+  return std::max(numRowsOfResult, numRowsToRead);
 }
 
 // _____________________________________________________________________________
@@ -438,16 +573,21 @@ ScanSpecificationAsTripleComponent IndexScan::getScanSpecificationTc() const {
 }
 
 // _____________________________________________________________________________
-std::optional<std::pair<Variable, ColumnIndex>>
-IndexScan::getSortedVariableAndMetadataColumnIndexForPrefiltering() const {
-  if (numVariables_ < 1) {
-    return std::nullopt;
-  }
+std::vector<std::pair<Variable, ColumnIndex>>
+IndexScan::getVariablesAndMetadataColumnIndicesForPrefiltering() const {
+  std::vector<std::pair<Variable, ColumnIndex>> result;
   const auto& permutedTriple = getPermutedTriple();
-  size_t colIdx = 3 - numVariables_;
-  const auto& tripleComp = permutedTriple.at(colIdx);
-  AD_CORRECTNESS_CHECK(tripleComp->isVariable());
-  return std::make_pair(tripleComp->getVariable(), colIdx);
+  for (size_t colIdx = 3 - numVariables_; colIdx < 3; ++colIdx) {
+    const auto& tripleComp = permutedTriple.at(colIdx);
+    AD_CORRECTNESS_CHECK(tripleComp->isVariable());
+    // If the same variable occurs multiple times in the triple, only the first
+    // (sorted) occurrence is relevant.
+    const auto& var = tripleComp->getVariable();
+    if (ql::ranges::find(result, var, ad_utility::first) == result.end()) {
+      result.emplace_back(var, colIdx);
+    }
+  }
+  return result;
 }
 
 // ___________________________________________________________________________
@@ -458,7 +598,8 @@ Permutation::ScanSpecAndBlocks IndexScan::getScanSpecAndBlocks() const {
 
 // _____________________________________________________________________________
 CompressedRelationReader::IdTableGeneratorInputRange IndexScan::getLazyScan(
-    std::optional<std::vector<CompressedBlockMetadata>> blocks) const {
+    std::optional<std::vector<CompressedBlockMetadata>> blocks,
+    std::optional<ql::span<const Id>> firstColumnKeys) const {
   // If there is a LIMIT or OFFSET clause that constrains the scan
   // (which can happen with an explicit subquery), we cannot use the prefiltered
   // blocks, as we currently have no mechanism to include limits and offsets
@@ -466,8 +607,9 @@ CompressedRelationReader::IdTableGeneratorInputRange IndexScan::getLazyScan(
   auto filteredBlocks =
       getLimitOffset().isUnconstrained() ? std::move(blocks) : std::nullopt;
   auto lazyScanAllCols = permutation().lazyScan(
-      scanSpecAndBlocks_, filteredBlocks, additionalColumns(),
-      cancellationHandle_, locatedTriplesState(), getLimitOffset());
+      scanSpecAndBlocks_, filteredBlocks, getAdditionalColumnsToRead(),
+      cancellationHandle_, locatedTriplesState(), getLimitOffset(),
+      firstColumnKeys);
 
   return CompressedRelationReader::IdTableGeneratorInputRange{
       ad_utility::CachingTransformInputRange<
@@ -557,9 +699,9 @@ IndexScan::lazyScanForJoinOfColumnWithScan(
   if (!metaBlocks.has_value() || joinColumn.empty()) {
     return {};
   }
+  bool hasUndef = joinColumn.front().isUndefined();
   auto matchingBlocks =
       [&]() -> std::optional<std::vector<CompressedBlockMetadata>> {
-    bool hasUndef = joinColumn.front().isUndefined();
     if (hasUndef) {
       return std::nullopt;
     }
@@ -567,7 +709,14 @@ IndexScan::lazyScanForJoinOfColumnWithScan(
         joinColumn, metaBlocks.value());
     return std::move(blocks.matchingBlocks_);
   }();
-  auto result = getLazyScan(std::move(matchingBlocks));
+  // Blocks that contain none of the entries of the `joinColumn` have no join
+  // partners, so their remaining columns don't have to be decompressed. With
+  // UNDEF values in the `joinColumn`, every row has a join partner.
+  std::optional<ql::span<const Id>> firstColumnKeys = std::nullopt;
+  if (!hasUndef) {
+    firstColumnKeys = joinColumn;
+  }
+  auto result = getLazyScan(std::move(matchingBlocks), firstColumnKeys);
   result.details().numBlocksAll_ = metaBlocks.value().sizeBlockMetadata_;
   return result;
 }
@@ -583,6 +732,8 @@ void IndexScan::updateRuntimeInfoForLazyScan(
   rti.addDetail("num-blocks-read", metadata.numBlocksRead_);
   rti.addDetail("num-blocks-all", metadata.numBlocksAll_);
   rti.addDetail("num-elements-read", metadata.numElementsRead_);
+  rti.numBytesRead_ = metadata.numBytesRead_;
+  rti.numBytesDecompressed_ = metadata.numBytesDecompressed_;
 
   // Add more details, but only if the respective value is non-zero.
   auto updateIfPositive = [&rti](const auto& value, const std::string& key) {
@@ -595,6 +746,8 @@ void IndexScan::updateRuntimeInfoForLazyScan(
   updateIfPositive(metadata.numBlocksPostprocessed_,
                    "num-blocks-postprocessed");
   updateIfPositive(metadata.numBlocksWithUpdate_, "num-blocks-with-update");
+  updateIfPositive(metadata.numBlocksWithOnlyFirstColumnDecompressed_,
+                   "num-blocks-only-first-column-decompressed");
   signalQueryUpdate(sendPriority);
 }
 
@@ -1054,6 +1207,42 @@ std::vector<ColumnIndex> IndexScan::getSubsetForStrippedColumns() const {
   return result;
 }
 
+// _____________________________________________________________________________
+std::vector<ColumnIndex> IndexScan::getAdditionalColumnsToRead() const {
+  if (!varsToKeep_.has_value()) {
+    return additionalColumns_;
+  }
+  std::vector<ColumnIndex> result;
+  for (size_t i = 0; i < additionalColumns_.size(); ++i) {
+    if (varsToKeep_.value().contains(additionalVariables_.at(i))) {
+      result.push_back(additionalColumns_.at(i));
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> IndexScan::getSubsetForStrippedColumnsOfReadColumns()
+    const {
+  AD_CORRECTNESS_CHECK(varsToKeep_.has_value());
+  const auto& v = varsToKeep_.value();
+  std::vector<ColumnIndex> result;
+  size_t idx = 0;
+  for (const auto& el : getPermutedTriple()) {
+    if (el->isVariable()) {
+      if (v.contains(el->getVariable())) {
+        result.push_back(idx);
+      }
+      ++idx;
+    }
+  }
+  // The additional columns that are read are exactly the ones that are kept.
+  for (size_t i = 0; i < getAdditionalColumnsToRead().size(); ++i) {
+    result.push_back(idx + i);
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 VariableToColumnMap IndexScan::computePermutationColumnIndices() const {
   VariableToColumnMap map;
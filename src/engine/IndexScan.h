@@ -8,8 +8,10 @@
 #include <string>
 
 #include "engine/Operation.h"
+#include "engine/RuntimeJoinFilter.h"
 #include "index/DeltaTriples.h"
 #include "util/HashMap.h"
+#include "util/HyperLogLog.h"
 
 class SparqlTriple;
 class SparqlTripleSimple;
@@ -34,6 +36,8 @@ class IndexScan final : public Operation {
   size_t numVariables_;
   size_t sizeEstimate_;
   bool sizeEstimateIsExact_;
+  // Computed lazily by `getCostEstimate`.
+  std::optional<size_t> numRowsOfBlocksToRead_;
   std::vector<float> multiplicity_;
 
   // Additional columns (e.g. patterns) that are being retrieved in addition to
@@ -48,6 +52,12 @@ class IndexScan final : public Operation {
   using VarsToKeep = std::optional<ad_utility::HashSet<Variable>>;
   VarsToKeep varsToKeep_;
 
+  // If set, only the rows whose entry in the `runtimeJoinFilterColumn_` is
+  // contained in the filter are part of the result (see
+  // `addRuntimeJoinFilter`). The filter is not copied by `clone()`.
+  std::shared_ptr<const RuntimeJoinFilter> runtimeJoinFilter_;
+  ColumnIndex runtimeJoinFilterColumn_ = 0;
+
  public:
   IndexScan(QueryExecutionContext* qec, PermutationPtr permutation,
             LocatedTriplesSharedState locatedTriplesSharedState,
@@ -169,6 +179,21 @@ class IndexScan final : public Operation {
     return multiplicity_[col];
   }
 
+  // Return the sketch of the distinct values of the result column `col` from
+  // the `PredicateStatistics` of the index, or `nullptr` if there is none.
+  // This is currently only the case for scans with a fixed predicate and two
+  // distinct variables for the subject and object (e.g. `?x <p> ?y`). The
+  // sketch ignores the delta triples and the graph filter.
+  const ad_utility::HyperLogLog* getDistinctValueSketch(ColumnIndex col) const;
+
+  // Return true iff the result of this scan is guaranteed to be unaffected by
+  // the delta triples, i.e. by updates. This is only determined for scans with
+  // at most two variables, for which this holds iff none of the relevant
+  // blocks contains located triples.
+  bool isUnaffectedByUpdates() const {
+    return numVariables_ < 3 && sizeEstimateIsExact_;
+  }
+
   // Return the internal flag for testing purposes.
   bool sizeEstimateIsExactForTesting() const { return sizeEstimateIsExact_; }
 
@@ -188,6 +213,14 @@ class IndexScan final : public Operation {
                                          sizeof(Id)) > maxCacheableSize;
   }
 
+  // Accept the `filter` if the `variable` is the first variable of the
+  // scan (by which the result is sorted), and if no LIMIT or OFFSET has been
+  // applied. Only the blocks that can contain rows that match the `filter`
+  // are then read, and the other rows of these blocks are removed.
+  bool addRuntimeJoinFilter(
+      const Variable& variable,
+      std::shared_ptr<const RuntimeJoinFilter> filter) override;
+
   // An index scan applies LIMIT and OFFSET directly while scanning.
   [[nodiscard]] LimitOffsetHandling handlesLimitOffset() const override {
     return LimitOffsetHandling::FULL;
@@ -239,6 +272,14 @@ class IndexScan final : public Operation {
   // is not a lot of redundant triples in different graphs in the data set.
   std::pair<bool, size_t> computeSizeEstimate() const;
 
+  // Return the total number of rows of the blocks that this scan has to read
+  // and decompress. This is typically more than the size of the result,
+  // because the first and the last block may contain other triples, which is
+  // why it differs between the permutations for the same triple. For full
+  // index scans, this is simply the number of triples of the permutation (see
+  // `computeSizeEstimate` above).
+  size_t computeNumRowsOfBlocksToRead() const;
+
   std::string getCacheKeyImpl() const override;
 
   // If `ScanSpecAndBlocks` contains prefiltered `BlockMetadataRanges`, the
@@ -255,15 +296,21 @@ class IndexScan final : public Operation {
 
   // Return the (lazy) `IdTable` for this `IndexScan` in chunks.
   Result::LazyResult chunkedIndexScan() const;
-  // Get the `IdTable` for this `IndexScan` in one piece.
-  IdTable materializedIndexScan() const;
-
-  // Returns the first sorted 'Variable' with corresponding `ColumnIndex`. If
-  // `numVariables_` is 0, `std::nullopt` is returned. The returned
-  // `ColumnIndex` corresponds to the `CompressedBlockMetadata` blocks, NOT to a
-  // column of the resulting `IdTable`.
-  std::optional<std::pair<Variable, ColumnIndex>>
-  getSortedVariableAndMetadataColumnIndexForPrefiltering() const;
+  // Get the `IdTable` for this `IndexScan` in one piece. If `scanMetadata` is
+  // not null, the metadata of the scan is stored there.
+  IdTable materializedIndexScan(
+      CompressedRelationReader::LazyScanMetadata* scanMetadata = nullptr) const;
+  // Compute the result if the `runtimeJoinFilter_` is set.
+  Result computeResultWithRuntimeJoinFilter(bool requestLaziness);
+
+  // Return the `Variable`s of the scan triple with their corresponding
+  // `ColumnIndex`, in the order of the columns. The first `Variable` is the one
+  // by which the blocks are sorted. If `numVariables_` is 0, the result is
+  // empty. The returned `ColumnIndex` corresponds to the
+  // `CompressedBlockMetadata` blocks, NOT to a column of the resulting
+  // `IdTable`.
+  std::vector<std::pair<Variable, ColumnIndex>>
+  getVariablesAndMetadataColumnIndicesForPrefiltering() const;
 
   // Access the `ScanSpecAndBlocks` associated with this `IndexScan` via the
   // `Permutation` class.
@@ -271,9 +318,11 @@ class IndexScan final : public Operation {
 
   // Helper functions for the public `getLazyScanFor...` methods and
   // `chunkedIndexScan` (see above).
+  // If `firstColumnKeys` are specified, the rows whose first column is not one
+  // of these keys might be omitted (see `Permutation::lazyScan`).
   CompressedRelationReader::IdTableGeneratorInputRange getLazyScan(
-      std::optional<std::vector<CompressedBlockMetadata>> blocks =
-          std::nullopt) const;
+      std::optional<std::vector<CompressedBlockMetadata>> blocks = std::nullopt,
+      std::optional<ql::span<const Id>> firstColumnKeys = std::nullopt) const;
   std::optional<Permutation::MetadataAndBlocks> getMetadataForScan() const;
 
   // If the `varsToKeep_` member is set, meaning that this `IndexScan` only
@@ -282,19 +331,29 @@ class IndexScan final : public Operation {
   // get the final result. Throws if `varsToKee_` is `nullopt`.
   std::vector<ColumnIndex> getSubsetForStrippedColumns() const;
 
-  // Return a lambda that takes an `idTable` that has the result without any
-  // columns stripped, and applies the column subset that leads to the correct
-  // stripping of the columns. This function can also be used if no columns are
-  // stripped and hence `varsToKeep_` is `nullopt`.
-  // Note: In theory, we could inform the underlying `CompressedRelationReader`
-  // of the required columns to not read the stripped columns at all. But in
-  // practice the effect would be limited, because the reader has to read all
-  // columns in many cases anyway (e.g. because of UPDATEs or GRAPH duplicate
-  // filtering etc.)
+  // Return the `additionalColumns_` that are not stripped away. Only these are
+  // read and decompressed by the underlying `CompressedRelationReader` (which
+  // still reads the graph column if required for the `graphsToFilter_`).
+  std::vector<ColumnIndex> getAdditionalColumnsToRead() const;
+
+  // Like `getSubsetForStrippedColumns`, but for the result of the
+  // `CompressedRelationReader`, which only contains the additional columns
+  // from `getAdditionalColumnsToRead`.
+  std::vector<ColumnIndex> getSubsetForStrippedColumnsOfReadColumns() const;
+
+  // Return a lambda that takes an `idTable` that has the result as read by
+  // the `CompressedRelationReader` (with all the columns of the permuted
+  // triple and the `getAdditionalColumnsToRead`), and applies the column
+  // subset that leads to the correct stripping of the columns. This function
+  // can also be used if no columns are stripped and hence `varsToKeep_` is
+  // `nullopt`. The columns of the triple are always read, because the reader
+  // needs them anyway in many cases (e.g. for UPDATEs or GRAPH duplicate
+  // filtering).
   auto makeApplyColumnSubset() const {
     bool hasSubset = varsToKeep_.has_value();
-    auto cols =
-        hasSubset ? std::optional{getSubsetForStrippedColumns()} : std::nullopt;
+    auto cols = hasSubset
+                    ? std::optional{getSubsetForStrippedColumnsOfReadColumns()}
+                    : std::nullopt;
     return [cols = std::move(cols)](auto&& table) {
       if (cols.has_value()) {
         table.setColumnSubset(cols.value());
@@ -19,16 +19,19 @@
 #include "engine/IndexScan.h"
 #include "engine/JoinHelpers.h"
 #include "engine/OperationBindPushDownImpl.h"
+#include "engine/RuntimeJoinFilter.h"
 #include "engine/Service.h"
 #include "global/Constants.h"
 #include "global/Id.h"
 #include "global/RuntimeParameters.h"
+#include "global/ValueIdComparators.h"
 #include "util/Algorithm.h"
 #include "util/Exception.h"
 #include "util/Generators.h"
 #include "util/HashMap.h"
 #include "util/Iterators.h"
 #include "util/JoinAlgorithms/JoinAlgorithms.h"
+#include "util/JoinAlgorithms/SimdZipperJoin.h"
 
 using namespace qlever::joinHelpers;
 using namespace qlever::joinWithIndexScanHelpers;
@@ -156,11 +159,17 @@ Result Join::computeResult(bool requestLaziness) {
     _right->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
     return createEmptyResult();
   }
+  leftRes = prefetchIfLazy(std::move(leftRes));
 
   // Note: If only one of the children is a scan, then we have made sure in the
   // constructor that it is the right child.
   auto rightIndexScan =
       std::dynamic_pointer_cast<IndexScan>(_right->getRootOperation());
+  // A direct `IndexScan` as the right child is handled below, so the filter is
+  // only useful if the scan is deeper inside of the `_right` child.
+  if (!rightIndexScan && !rightResIfCached) {
+    addRuntimeJoinFilterToRightChild(leftRes);
+  }
   if (rightIndexScan && !rightResIfCached) {
     if (leftRes->isFullyMaterialized()) {
       return computeResultForIndexScanAndIdTable<false>(
@@ -173,6 +182,7 @@ Result Join::computeResult(bool requestLaziness) {
   std::shared_ptr<const Result> rightRes =
       rightResIfCached ? rightResIfCached : _right->getResult(true);
   checkCancellation();
+  rightRes = prefetchIfLazy(std::move(rightRes));
   if (leftRes->isFullyMaterialized() && rightRes->isFullyMaterialized()) {
     return computeResultForTwoMaterializedInputs(std::move(leftRes),
                                                  std::move(rightRes));
@@ -180,6 +190,61 @@ Result Join::computeResult(bool requestLaziness) {
   return lazyJoin(std::move(leftRes), std::move(rightRes), requestLaziness);
 }
 
+// _____________________________________________________________________________
+std::shared_ptr<const Result> Join::prefetchIfLazy(
+    std::shared_ptr<const Result> result) const {
+  // With the prefetching, the runtime information of the child is updated by
+  // another thread, so it must not be sent to the client concurrently.
+  if (getExecutionContext()->areWebsocketUpdatesEnabled()) {
+    return result;
+  }
+  return prefetchLazyResult(
+      std::move(result),
+      getRuntimeParameter<&RuntimeParameters::lazyJoinPrefetchQueueSize_>());
+}
+
+// _____________________________________________________________________________
+void Join::addRuntimeJoinFilterToRightChild(
+    const std::shared_ptr<const Result>& leftResult) {
+  if (!leftResult->isFullyMaterialized()) {
+    return;
+  }
+  const IdTable& idTable = leftResult->idTable();
+  size_t maxSize =
+      getRuntimeParameter<&RuntimeParameters::runtimeJoinFilterMaxSize_>();
+  // The blocks of an `IndexScan` can't be skipped if there are UNDEF values,
+  // which are the first values of the sorted join column.
+  if (idTable.empty() || idTable.numRows() > maxSize ||
+      idTable.at(0, _leftJoinCol).isUndefined()) {
+    return;
+  }
+  auto filter = std::make_shared<const RuntimeJoinFilter>(leftResult,
+                                                          _leftJoinCol);
+  if (_right->getRootOperation()->addRuntimeJoinFilter(_joinVar,
+                                                       std::move(filter))) {
+    runtimeInfo().addDetail("runtime-join-filter-size", idTable.numRows());
+  }
+}
+
+// _____________________________________________________________________________
+bool Join::addRuntimeJoinFilter(
+    const Variable& variable, std::shared_ptr<const RuntimeJoinFilter> filter) {
+  if (!getLimitOffset().isUnconstrained()) {
+    return false;
+  }
+  bool isApplied = false;
+  for (const auto& child : {_left, _right}) {
+    if (child->getVariableColumnOrNullopt(variable).has_value()) {
+      isApplied |=
+          child->getRootOperation()->addRuntimeJoinFilter(variable, filter);
+    }
+  }
+  if (isApplied) {
+    disableStoringInCache();
+  }
+  return isApplied;
+}
+
 // _____________________________________________________________________________
 VariableToColumnMap Join::computeVariableToColumnMap() const {
   return makeVarToColMapForJoinOperation(
@@ -225,6 +290,36 @@ size_t Join::getCostEstimate() {
          costOfSubtree(_right);
 }
 
+// _____________________________________________________________________________
+std::optional<size_t> Join::estimateNumDistinctInResultFromSketches(
+    size_t nofDistinctLeft, size_t nofDistinctRight) const {
+  if (!_executionContext) {
+    return std::nullopt;
+  }
+  size_t nofDistinctMin = std::min(nofDistinctLeft, nofDistinctRight);
+  if (static_cast<double>(nofDistinctMin) <
+      _executionContext->getCostFactor(
+          "JOIN_SIZE_ESTIMATE_MIN_DISTINCT_FOR_SKETCHES")) {
+    return std::nullopt;
+  }
+  auto getSketch = [](const QueryExecutionTree& tree, ColumnIndex joinColumn)
+      -> const ad_utility::HyperLogLog* {
+    auto scan = dynamic_cast<const IndexScan*>(tree.getRootOperation().get());
+    return scan ? scan->getDistinctValueSketch(joinColumn) : nullptr;
+  };
+  const auto* sketchLeft = getSketch(*_left, _leftJoinCol);
+  const auto* sketchRight = getSketch(*_right, _rightJoinCol);
+  if (sketchLeft == nullptr || sketchRight == nullptr) {
+    return std::nullopt;
+  }
+  // The sketches are computed on the whole index, so the number of values in
+  // the intersection can't be larger than the number of distinct values of the
+  // (possibly smaller) inputs.
+  auto intersection = static_cast<size_t>(
+      ad_utility::HyperLogLog::estimateIntersection(*sketchLeft, *sketchRight));
+  return std::clamp(intersection, size_t{1}, nofDistinctMin);
+}
+
 // _____________________________________________________________________________
 void Join::computeSizeEstimateAndMultiplicities() {
   _multiplicities.clear();
@@ -243,6 +338,11 @@ void Join::computeSizeEstimateAndMultiplicities() {
                                      _right->getMultiplicity(_rightJoinCol)));
 
   size_t nofDistinctInResult = std::min(nofDistinctLeft, nofDistinctRight);
+  if (auto fromSketches = estimateNumDistinctInResultFromSketches(
+          nofDistinctLeft, nofDistinctRight);
+      fromSketches.has_value()) {
+    nofDistinctInResult = fromSketches.value();
+  }
 
   double adaptSizeLeft =
       _left->getSizeEstimate() *
@@ -300,6 +400,20 @@ void Join::computeSizeEstimateAndMultiplicities() {
 
 void Join::join(const IdTableView<0>& a, const IdTableView<0>& b,
                 IdTable* result) const {
+  bool joinedInParallel = joinPartitionsInParallel(
+      a, b, _leftJoinCol, _rightJoinCol, result,
+      [this](const IdTableView<0>& partA, const IdTableView<0>& partB,
+             IdTable* partResult) {
+        joinSequentially(partA, partB, partResult);
+      });
+  if (!joinedInParallel) {
+    joinSequentially(a, b, result);
+  }
+}
+
+// ______________________________________________________________________________
+void Join::joinSequentially(const IdTableView<0>& a, const IdTableView<0>& b,
+                            IdTable* result) const {
   AD_LOG_DEBUG << "Performing join between two tables.\n";
   AD_LOG_DEBUG << "A: width = " << a.numColumns() << ", size = " << a.size()
                << "\n";
@@ -339,6 +453,20 @@ void Join::join(const IdTableView<0>& a, const IdTableView<0>& b,
 
   auto cancellationCallback = [this]() { checkCancellation(); };
 
+  // Without local vocab entries (the common case of join columns that only
+  // contain `VocabIndex`es or only `Int`s), the `Id`s can be compared by their
+  // bits, for which the join algorithms are instantiated separately.
+  bool compareByBits =
+      valueIdComparators::containsNoLocalVocabIndex(joinColumnL) &&
+      valueIdComparators::containsNoLocalVocabIndex(joinColumnR);
+  auto withLessThan = [compareByBits](const auto& function) {
+    if (compareByBits) {
+      function(valueIdComparators::LessByBitsWithoutLocalVocab{});
+    } else {
+      function(ql::ranges::less{});
+    }
+  };
+
   // Determine whether we should use the galloping join optimization.
   if (a.size() / b.size() > GALLOP_THRESHOLD && numUndefA == 0 &&
       numUndefB == 0) {
@@ -347,12 +475,22 @@ void Join::join(const IdTableView<0>& a, const IdTableView<0>& b,
     auto inverseAddRow = [&addRow](const auto& rowA, const auto& rowB) {
       addRow(rowB, rowA);
     };
-    ad_utility::gallopingJoin(joinColumnR, joinColumnL, ql::ranges::less{},
-                              inverseAddRow, {}, cancellationCallback);
+    withLessThan([&](const auto& lessThan) {
+      ad_utility::gallopingJoin(joinColumnR, joinColumnL, lessThan,
+                                inverseAddRow, {}, cancellationCallback);
+    });
   } else if (b.size() / a.size() > GALLOP_THRESHOLD && numUndefA == 0 &&
              numUndefB == 0) {
-    ad_utility::gallopingJoin(joinColumnL, joinColumnR, ql::ranges::less{},
-                              addRow, {}, cancellationCallback);
+    withLessThan([&](const auto& lessThan) {
+      ad_utility::gallopingJoin(joinColumnL, joinColumnR, lessThan, addRow, {},
+                                cancellationCallback);
+    });
+  } else if (numUndefA == 0 && numUndefB == 0 && compareByBits) {
+    // Without UNDEF values and local vocab entries, the join columns can be
+    // compared on their bits, which allows for the vectorized join kernel (see
+    // `simdZipperJoin::isApplicable`).
+    ad_utility::simdZipperJoin::zipperJoin(joinColumnL, joinColumnR, addRow,
+                                           cancellationCallback);
   } else {
     auto findSmallerUndefRangeLeft = [undefRangeA](auto&&...) {
       return ad_utility::IteratorRange{undefRangeA.first, undefRangeA.second};
@@ -361,19 +499,20 @@ void Join::join(const IdTableView<0>& a, const IdTableView<0>& b,
       return ad_utility::IteratorRange{undefRangeB.first, undefRangeB.second};
     };
 
-    auto numOutOfOrder = [&]() {
+    size_t numOutOfOrder = 0;
+    withLessThan([&](const auto& lessThan) {
       if (numUndefB == 0 && numUndefA == 0) {
-        return ad_utility::zipperJoinWithUndef(
-            joinColumnL, joinColumnR, ql::ranges::less{}, addRow,
-            ad_utility::noop, ad_utility::noop, {}, cancellationCallback);
+        numOutOfOrder = ad_utility::zipperJoinWithUndef(
+            joinColumnL, joinColumnR, lessThan, addRow, ad_utility::noop,
+            ad_utility::noop, {}, cancellationCallback);
 
       } else {
-        return ad_utility::zipperJoinWithUndef(
-            joinColumnL, joinColumnR, ql::ranges::less{}, addRow,
+        numOutOfOrder = ad_utility::zipperJoinWithUndef(
+            joinColumnL, joinColumnR, lessThan, addRow,
             findSmallerUndefRangeLeft, findSmallerUndefRangeRight, {},
             cancellationCallback);
       }
-    }();
+    });
     AD_CORRECTNESS_CHECK(numOutOfOrder == 0);
   }
   *result = std::move(rowAdder).resultTable();
@@ -66,6 +66,15 @@ class Join : public Operation {
 
   void computeSizeEstimateAndMultiplicities();
 
+  // If both children are `IndexScan`s with distinct-value sketches for their
+  // join columns (see `IndexScan::getDistinctValueSketch`), estimate the
+  // number of distinct join values in the result from the intersection of the
+  // sketches. This is more precise than the default estimate (the minimum of
+  // `nofDistinctLeft` and `nofDistinctRight`) for correlated predicates.
+  // Return `std::nullopt` if the sketches can't be used.
+  std::optional<size_t> estimateNumDistinctInResultFromSketches(
+      size_t nofDistinctLeft, size_t nofDistinctRight) const;
+
   float getMultiplicity(size_t col) override;
 
   std::vector<QueryExecutionTree*> getChildren() override {
@@ -75,6 +84,13 @@ class Join : public Operation {
   bool columnOriginatesFromGraphOrUndef(
       const Variable& variable) const override;
 
+  // Push the `filter` into all the children that contain the `variable`. This
+  // is correct, because each row of the result contains the values of the
+  // `variable` of the rows of the children from which it was created.
+  bool addRuntimeJoinFilter(
+      const Variable& variable,
+      std::shared_ptr<const RuntimeJoinFilter> filter) override;
+
   /**
    * @brief Joins IdTables a and b on join column jc2, returning
    * the result in dynRes. Creates a cross product for matching rows.
@@ -93,6 +109,12 @@ class Join : public Operation {
   void join(const IdTableView<0>& a, const IdTableView<0>& b,
             IdTable* result) const;
 
+  // The sequential implementation of `join` above. Large inputs are split
+  // into partitions of the join values that are joined in parallel by this
+  // function (see `joinHelpers::joinPartitionsInParallel`).
+  void joinSequentially(const IdTableView<0>& a, const IdTableView<0>& b,
+                        IdTable* result) const;
+
  public:
   // Fallback implementation of a join that is used when at least one of the two
   // inputs is not fully materialized. This represents the general case where we
@@ -124,6 +146,20 @@ class Join : public Operation {
 
   Result computeResult(bool requestLaziness) override;
 
+  // Return the `result` of a child, the blocks of which are computed
+  // concurrently to the join if it is lazy (see `prefetchLazyResult`). This is
+  // disabled if the runtime information is sent to the client during the
+  // computation.
+  std::shared_ptr<const Result> prefetchIfLazy(
+      std::shared_ptr<const Result> result) const;
+
+  // If the fully materialized `leftResult` is small enough (see the runtime
+  // parameter `runtime-join-filter-max-size`), push the values of its join
+  // column as a `RuntimeJoinFilter` into the `_right` child, which has not
+  // been computed yet.
+  void addRuntimeJoinFilterToRightChild(
+      const std::shared_ptr<const Result>& leftResult);
+
   VariableToColumnMap computeVariableToColumnMap() const override;
 
   std::optional<std::shared_ptr<QueryExecutionTree>>
@@ -9,7 +9,9 @@
 
 #include <absl/functional/function_ref.h>
 
+#include <algorithm>
 #include <array>
+#include <future>
 #include <optional>
 #include <vector>
 
@@ -20,19 +22,28 @@
 #include "engine/Result.h"
 #include "engine/Sort.h"
 #include "engine/idTable/IdTable.h"
+#include "global/RuntimeParameters.h"
 #include "index/CompressedRelation.h"
 #include "index/Permutation.h"
+#include "util/AsyncStream.h"
 #include "util/Exception.h"
 #include "util/Generators.h"
 #include "util/InputRangeUtils.h"
 #include "util/Iterators.h"
 #include "util/JoinAlgorithms/JoinColumnMapping.h"
+#include "util/ParallelExecutor.h"
+#include "util/SpanTracer.h"
+#include "util/ThreadBudget.h"
 #include "util/TypeTraits.h"
 
 namespace qlever::joinHelpers {
 
 static constexpr size_t CHUNK_SIZE = 100'000;
 
+// The minimal number of input rows (of both inputs together) per thread for
+// which `joinPartitionsInParallel` below uses multiple threads.
+static constexpr size_t PARALLEL_JOIN_MIN_ROWS_PER_THREAD = 100'000;
+
 using namespace ad_utility;
 
 // Forward declaration for `getRowAdderForJoin`.
@@ -130,6 +141,39 @@ inline std::variant<LazyInputView<1>, MaterializedInputView> resultToView(
   return convertGenerator(result.idTables(), permutation);
 }
 
+// Return a lazy result with the same blocks as the lazy `result`, which are
+// computed ahead of time by a separate thread and buffered in a queue of at
+// most `queueSize` blocks. This way, the pipeline of the `result` runs
+// concurrently to its consumer (for example, the loop of a lazy join that
+// alternately pulls blocks from both of its inputs). A fully materialized
+// `result` is returned unchanged, as well as a lazy one if the `queueSize` is
+// zero or if no thread is left in the `globalThreadBudget()`.
+inline std::shared_ptr<const Result> prefetchLazyResult(
+    std::shared_ptr<const Result> result, size_t queueSize) {
+  if (result->isFullyMaterialized() || queueSize == 0) {
+    return result;
+  }
+  // One thread for the consumer and one for the prefetching, which stay
+  // reserved as long as the blocks are consumed.
+  auto threads = std::make_shared<ad_utility::ThreadBudget::Reservation>(
+      ad_utility::globalThreadBudget().reserve(2));
+  if (threads->numThreads() < 2) {
+    return result;
+  }
+  // The spans of the prefetching thread are recorded with the tracer of the
+  // consumer.
+  ad_utility::InputRangeFromGetCallable blocks{
+      [blocks = result->idTables(),
+       tracer = ad_utility::timer::SpanTracer::active(),
+       threads = std::move(threads)]() mutable {
+        ad_utility::timer::SpanTracer::Activation activation{tracer};
+        return blocks.get();
+      }};
+  return std::make_shared<const Result>(
+      ad_utility::streams::runStreamAsync(std::move(blocks), queueSize),
+      result->sortedBy());
+}
+
 // Part of the implementation of `createResult`. This function is called when
 // the result should be yielded lazily.
 // Action is a lambda that itself runs the join operation in a blocking
@@ -286,6 +330,92 @@ tryGetResultsForLeftIndexNestedLoopJoin(
   auto rightRes = computeResultSkipChild(sort, true);
   return std::optional{std::pair{std::move(leftRes), std::move(rightRes)}};
 }
+
+// Compute the join of the fully materialized `left` and `right` input, which
+// are sorted by their `leftJoinColumn` and `rightJoinColumn`, in parallel and
+// append it to the `result`. To this end, both inputs are split into
+// partitions with the same ranges of join values. The boundaries of these
+// ranges are evenly spaced values (splitters) from the join column of the
+// larger input. The partitions are joined concurrently via
+// `joinPartition(leftPart, rightPart, &partResult)` and the results are
+// concatenated in the order of the partitions. The result is thus the same as
+// that of a single call `joinPartition(left, right, result)`, provided that
+// matching rows always have the same value in the join columns.
+//
+// Return false without changing the `result` if the join should be computed
+// sequentially, because the inputs are too small, there is only one thread
+// available, or there are UNDEF values in the join columns (these match the
+// values of all the partitions, so they are conservatively not split).
+template <typename JoinPartition>
+bool joinPartitionsInParallel(const IdTableView<0>& left,
+                              const IdTableView<0>& right,
+                              ColumnIndex leftJoinColumn,
+                              ColumnIndex rightJoinColumn, IdTable* result,
+                              const JoinPartition& joinPartition) {
+  if (left.empty() || right.empty()) {
+    return false;
+  }
+  auto joinColumnL = left.getColumn(leftJoinColumn);
+  auto joinColumnR = right.getColumn(rightJoinColumn);
+  // The UNDEF values are right at the start of the sorted join columns.
+  if (joinColumnL.front().isUndefined() || joinColumnR.front().isUndefined()) {
+    return false;
+  }
+  size_t maxNumThreads = std::max(
+      size_t{1}, getRuntimeParameter<&RuntimeParameters::joinNumThreads_>());
+  size_t numRows = left.size() + right.size();
+  auto threads = ad_utility::globalThreadBudget().reserve(
+      std::min(maxNumThreads, numRows / PARALLEL_JOIN_MIN_ROWS_PER_THREAD));
+  const size_t numThreads = threads.numThreads();
+  if (numThreads <= 1) {
+    return false;
+  }
+
+  // Partition `t` consists of the rows `[boundariesL[t], boundariesL[t + 1])`
+  // of the left and `[boundariesR[t], boundariesR[t + 1])` of the right input.
+  const auto& larger =
+      joinColumnL.size() >= joinColumnR.size() ? joinColumnL : joinColumnR;
+  std::vector<size_t> boundariesL{0};
+  std::vector<size_t> boundariesR{0};
+  for (size_t t = 1; t < numThreads; ++t) {
+    Id splitter = larger[larger.size() * t / numThreads];
+    boundariesL.push_back(ql::ranges::lower_bound(joinColumnL, splitter) -
+                          joinColumnL.begin());
+    boundariesR.push_back(ql::ranges::lower_bound(joinColumnR, splitter) -
+                          joinColumnR.begin());
+  }
+  boundariesL.push_back(joinColumnL.size());
+  boundariesR.push_back(joinColumnR.size());
+
+  std::vector<IdTable> partialResults;
+  partialResults.reserve(numThreads);
+  std::vector<std::packaged_task<void()>> tasks;
+  for (size_t t = 0; t < numThreads; ++t) {
+    partialResults.emplace_back(result->numColumns(), result->getAllocator());
+    // Partitions that are empty on one side (e.g. because of equal splitters)
+    // have an empty result.
+    if (boundariesL[t] == boundariesL[t + 1] ||
+        boundariesR[t] == boundariesR[t + 1]) {
+      continue;
+    }
+    tasks.emplace_back([&, t]() {
+      joinPartition(left.asRowRangeView(boundariesL[t], boundariesL[t + 1]),
+                    right.asRowRangeView(boundariesR[t], boundariesR[t + 1]),
+                    &partialResults[t]);
+    });
+  }
+  ad_utility::runTasksInParallel(std::move(tasks));
+
+  size_t totalSize = 0;
+  for (const auto& partialResult : partialResults) {
+    totalSize += partialResult.size();
+  }
+  result->reserve(result->size() + totalSize);
+  for (const auto& partialResult : partialResults) {
+    result->insertAtEnd(partialResult);
+  }
+  return true;
+}
 }  // namespace qlever::joinHelpers
 
 #endif  // JOINHELPERS_H
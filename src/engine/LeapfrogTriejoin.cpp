@@ -0,0 +1,397 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/LeapfrogTriejoin.h"
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include "util/Algorithm.h"
+#include "util/HashMap.h"
+#include "util/StringUtils.h"
+
+namespace {
+// Return the first position in `[begin, end)` of the sorted `column` at which
+// `isBefore` is false, or `end` if there is no such position. The search
+// gallops from `begin` with exponentially growing steps before it switches to
+// a binary search, so it is cheap if the position is close to `begin`.
+template <typename IsBefore>
+size_t gallop(ql::span<const Id> column, size_t begin, size_t end,
+              const IsBefore& isBefore) {
+  size_t low = begin;
+  size_t high = begin;
+  size_t step = 1;
+  while (high < end && isBefore(column[high])) {
+    low = high + 1;
+    high = std::min(end, high + step);
+    step *= 2;
+  }
+  return std::partition_point(column.begin() + low, column.begin() + high,
+                              isBefore) -
+         column.begin();
+}
+}  // namespace
+
+// The state of the recursive `joinAtDepth`.
+struct LeapfrogTriejoin::JoinState {
+  // The sorted columns of a single child, and the currently matching ranges.
+  struct Relation {
+    ql::span<const Id> firstColumn_;
+    ql::span<const Id> secondColumn_;
+    // The rows that match the current value of the first variable.
+    size_t beginMatching_ = 0;
+    size_t endMatching_ = 0;
+    // The number of rows that match the current values of both variables.
+    size_t multiplicity_ = 0;
+  };
+  std::vector<Relation> relations_;
+  // For each depth, the indices of the relations that contain the variable of
+  // this depth, together with `true` iff it is their second variable.
+  std::vector<std::vector<std::pair<size_t, bool>>> participants_;
+  // The values of the currently bound variables.
+  std::vector<Id> row_;
+  IdTable result_;
+};
+
+// ____________________________________________________________________________
+LeapfrogTriejoin::LeapfrogTriejoin(QueryExecutionContext* qec,
+                                   Children children,
+                                   std::vector<Variable> variableOrder)
+    : Operation{qec}, variableOrder_{std::move(variableOrder)} {
+  AD_CONTRACT_CHECK(!children.empty());
+  ad_utility::HashMap<Variable, size_t> indexOfVariable;
+  for (size_t i = 0; i < variableOrder_.size(); ++i) {
+    AD_CONTRACT_CHECK(indexOfVariable.emplace(variableOrder_[i], i).second,
+                      "The variable order must not contain duplicates.");
+  }
+  std::vector<bool> isContained(variableOrder_.size(), false);
+  for (auto& child : children) {
+    AD_CONTRACT_CHECK(child != nullptr);
+    AD_CONTRACT_CHECK(child->getResultWidth() == 2);
+    const auto& variableColumns = child->getVariableColumns();
+    AD_CONTRACT_CHECK(variableColumns.size() == 2);
+    ChildVariables variables;
+    size_t k = 0;
+    for (const auto& [variable, columnInfo] : variableColumns) {
+      AD_CONTRACT_CHECK(columnInfo.mightContainUndef_ ==
+                        ColumnIndexAndTypeInfo::AlwaysDefined);
+      auto it = indexOfVariable.find(variable);
+      AD_CONTRACT_CHECK(it != indexOfVariable.end(),
+                        "Variable ", variable.name(),
+                        " is not contained in the variable order.");
+      variables.variableIndices_[k] = it->second;
+      variables.columns_[k] = columnInfo.columnIndex_;
+      isContained[it->second] = true;
+      ++k;
+    }
+    if (variables.variableIndices_[0] > variables.variableIndices_[1]) {
+      std::swap(variables.variableIndices_[0], variables.variableIndices_[1]);
+      std::swap(variables.columns_[0], variables.columns_[1]);
+    }
+    children_.push_back(QueryExecutionTree::createSortedTree(
+        std::move(child), {variables.columns_[0], variables.columns_[1]}));
+    childVariables_.push_back(variables);
+  }
+  AD_CONTRACT_CHECK(ql::ranges::all_of(isContained, std::identity{}),
+                    "Each variable must be contained in one of the children.");
+}
+
+// ____________________________________________________________________________
+std::vector<Variable> LeapfrogTriejoin::computeVariableOrder(
+    const std::vector<std::array<Variable, 2>>& variables) {
+  // All the distinct variables in the order of their first occurrence, which
+  // is used to break ties deterministically.
+  std::vector<Variable> distinctVariables;
+  for (const auto& pair : variables) {
+    for (const auto& variable : pair) {
+      if (!ad_utility::contains(distinctVariables, variable)) {
+        distinctVariables.push_back(variable);
+      }
+    }
+  }
+  std::vector<Variable> order;
+  auto isChosen = [&order](const Variable& variable) {
+    return ad_utility::contains(order, variable);
+  };
+  // The number of relations that contain the `variable` and (in the first
+  // element) the number of those that also contain an already chosen variable.
+  auto getDegrees = [&](const Variable& variable) {
+    std::pair<size_t, size_t> degrees{0, 0};
+    for (const auto& [first, second] : variables) {
+      if (first != variable && second != variable) {
+        continue;
+      }
+      ++degrees.second;
+      if (isChosen(first == variable ? second : first)) {
+        ++degrees.first;
+      }
+    }
+    return degrees;
+  };
+  while (order.size() < distinctVariables.size()) {
+    std::optional<Variable> best;
+    std::pair<size_t, size_t> bestDegrees;
+    for (const auto& variable : distinctVariables) {
+      if (isChosen(variable)) {
+        continue;
+      }
+      auto degrees = getDegrees(variable);
+      if (!best.has_value() || degrees > bestDegrees) {
+        best = variable;
+        bestDegrees = degrees;
+      }
+    }
+    order.push_back(std::move(best.value()));
+  }
+  return order;
+}
+
+// ____________________________________________________________________________
+std::vector<QueryExecutionTree*> LeapfrogTriejoin::getChildren() {
+  std::vector<QueryExecutionTree*> result;
+  ql::ranges::copy(
+      children_ | ql::views::transform([](auto& ptr) { return ptr.get(); }),
+      std::back_inserter(result));
+  return result;
+}
+
+// ____________________________________________________________________________
+std::string LeapfrogTriejoin::getDescriptor() const {
+  return "LeapfrogTriejoin on " +
+         ad_utility::lazyStrJoin(
+             ql::views::transform(variableOrder_, &Variable::name), " ");
+}
+
+// ____________________________________________________________________________
+std::string LeapfrogTriejoin::getCacheKeyImpl() const {
+  // The names of the variables are not part of the cache key, only the
+  // mapping of the columns of the children to the result columns.
+  std::ostringstream os;
+  os << "LEAPFROG TRIEJOIN with " << variableOrder_.size() << " columns";
+  for (size_t i = 0; i < children_.size(); ++i) {
+    const auto& [indices, columns] = childVariables_[i];
+    os << "\nchild " << i << " columns " << columns[0] << " " << columns[1]
+       << " to " << indices[0] << " " << indices[1] << ": "
+       << children_[i]->getCacheKey();
+  }
+  return std::move(os).str();
+}
+
+// ____________________________________________________________________________
+size_t LeapfrogTriejoin::getCostEstimate() {
+  size_t cost = getSizeEstimate();
+  for (const auto& child : children_) {
+    cost += child->getCostEstimate() + child->getSizeEstimate();
+  }
+  return cost;
+}
+
+// ____________________________________________________________________________
+uint64_t LeapfrogTriejoin::getSizeEstimateBeforeLimit() {
+  if (sizeEstimate_.has_value()) {
+    return sizeEstimate_.value();
+  }
+  std::vector<size_t> degrees(variableOrder_.size(), 0);
+  for (const auto& variables : childVariables_) {
+    ++degrees[variables.variableIndices_[0]];
+    ++degrees[variables.variableIndices_[1]];
+  }
+  double logEstimate = 0;
+  for (size_t i = 0; i < children_.size(); ++i) {
+    auto size = children_[i]->getSizeEstimate();
+    if (size == 0) {
+      sizeEstimate_ = 0;
+      return 0;
+    }
+    const auto& indices = childVariables_[i].variableIndices_;
+    double weight = std::max(1.0 / static_cast<double>(degrees[indices[0]]),
+                             1.0 / static_cast<double>(degrees[indices[1]]));
+    logEstimate += weight * std::log(static_cast<double>(size));
+  }
+  double estimate = std::exp(logEstimate);
+  constexpr auto maxEstimate = std::numeric_limits<uint64_t>::max();
+  sizeEstimate_ = estimate >= static_cast<double>(maxEstimate)
+                      ? maxEstimate
+                      : static_cast<uint64_t>(estimate);
+  return sizeEstimate_.value();
+}
+
+// ____________________________________________________________________________
+float LeapfrogTriejoin::getMultiplicity(size_t col) {
+  AD_CONTRACT_CHECK(col < variableOrder_.size());
+  // The number of distinct values of a variable is at most the number of
+  // distinct values in each of the children that contain it.
+  double numDistinct = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < children_.size(); ++i) {
+    const auto& [indices, columns] = childVariables_[i];
+    for (size_t k = 0; k < 2; ++k) {
+      if (indices[k] != col) {
+        continue;
+      }
+      auto size = static_cast<double>(children_[i]->getSizeEstimate());
+      numDistinct = std::min(
+          numDistinct, size / children_[i]->getMultiplicity(columns[k]));
+    }
+  }
+  numDistinct = std::max(1.0, numDistinct);
+  return static_cast<float>(std::max(
+      1.0, static_cast<double>(getSizeEstimate()) / numDistinct));
+}
+
+// ____________________________________________________________________________
+bool LeapfrogTriejoin::knownEmptyResult() {
+  return ql::ranges::any_of(children_, [](const auto& child) {
+    return child->knownEmptyResult();
+  });
+}
+
+// ____________________________________________________________________________
+std::vector<ColumnIndex> LeapfrogTriejoin::resultSortedOn() const {
+  std::vector<ColumnIndex> sortedOn;
+  for (size_t i = 0; i < variableOrder_.size(); ++i) {
+    sortedOn.push_back(i);
+  }
+  return sortedOn;
+}
+
+// ____________________________________________________________________________
+VariableToColumnMap LeapfrogTriejoin::computeVariableToColumnMap() const {
+  VariableToColumnMap map;
+  for (size_t i = 0; i < variableOrder_.size(); ++i) {
+    map[variableOrder_[i]] = makeAlwaysDefinedColumn(i);
+  }
+  return map;
+}
+
+// ____________________________________________________________________________
+std::unique_ptr<Operation> LeapfrogTriejoin::cloneImpl() const {
+  Children children;
+  for (const auto& child : children_) {
+    children.push_back(child->clone());
+  }
+  return std::make_unique<LeapfrogTriejoin>(
+      _executionContext, std::move(children), variableOrder_);
+}
+
+// ____________________________________________________________________________
+Result LeapfrogTriejoin::computeResult([[maybe_unused]] bool requestLaziness) {
+  std::vector<std::shared_ptr<const Result>> subResults;
+  for (const auto& child : children_) {
+    subResults.push_back(child->getResult());
+    checkCancellation();
+    if (subResults.back()->idTable().empty()) {
+      return {IdTable{getResultWidth(), allocator()}, resultSortedOn(),
+              LocalVocab{}};
+    }
+  }
+
+  JoinState state{{},
+                  std::vector<std::vector<std::pair<size_t, bool>>>(
+                      variableOrder_.size()),
+                  std::vector<Id>(variableOrder_.size(), Id::makeUndefined()),
+                  IdTable{getResultWidth(), allocator()}};
+  for (size_t i = 0; i < children_.size(); ++i) {
+    const auto& [indices, columns] = childVariables_[i];
+    const auto& idTable = subResults[i]->idTable();
+    state.relations_.push_back({idTable.getColumn(columns[0]),
+                                idTable.getColumn(columns[1])});
+    state.participants_[indices[0]].emplace_back(i, false);
+    state.participants_[indices[1]].emplace_back(i, true);
+  }
+  joinAtDepth(state, 0);
+
+  auto localVocab = Result::getMergedLocalVocab(
+      subResults | ql::views::transform([](const auto& result) {
+        return std::cref(*result);
+      }));
+  return {std::move(state.result_), resultSortedOn(),
+          std::move(localVocab)};
+}
+
+// ____________________________________________________________________________
+void LeapfrogTriejoin::joinAtDepth(JoinState& state, size_t depth) const {
+  if (depth == variableOrder_.size()) {
+    size_t numCopies = 1;
+    for (const auto& relation : state.relations_) {
+      numCopies *= relation.multiplicity_;
+    }
+    for (size_t i = 0; i < numCopies; ++i) {
+      state.result_.push_back(state.row_);
+    }
+    return;
+  }
+
+  // The column and the current range of each participating relation. A
+  // relation for which this is the first variable participates with its
+  // complete first column, and a relation for which this is the second
+  // variable with the range that matches the current value of the first one.
+  const auto& participants = state.participants_[depth];
+  const size_t numParticipants = participants.size();
+  std::vector<ql::span<const Id>> columns;
+  std::vector<size_t> positions;
+  std::vector<size_t> ends;
+  for (auto [relationIndex, isSecond] : participants) {
+    const auto& relation = state.relations_[relationIndex];
+    if (isSecond) {
+      columns.push_back(relation.secondColumn_);
+      positions.push_back(relation.beginMatching_);
+      ends.push_back(relation.endMatching_);
+    } else {
+      columns.push_back(relation.firstColumn_);
+      positions.push_back(0);
+      ends.push_back(relation.firstColumn_.size());
+    }
+  }
+  std::vector<size_t> matchingEnds(numParticipants);
+
+  // The leapfrog search: Seek all the columns to the largest of their current
+  // values until they all agree.
+  while (true) {
+    if (depth < 2) {
+      checkCancellation();
+    }
+    Id maxValue = columns[0][positions[0]];
+    for (size_t i = 1; i < numParticipants; ++i) {
+      maxValue = std::max(maxValue, columns[i][positions[i]]);
+    }
+    bool allEqual = true;
+    for (size_t i = 0; i < numParticipants; ++i) {
+      positions[i] = gallop(columns[i], positions[i], ends[i],
+                            [maxValue](Id id) { return id < maxValue; });
+      if (positions[i] == ends[i]) {
+        return;
+      }
+      allEqual = allEqual && columns[i][positions[i]] == maxValue;
+    }
+    if (!allEqual) {
+      continue;
+    }
+
+    state.row_[depth] = maxValue;
+    for (size_t i = 0; i < numParticipants; ++i) {
+      matchingEnds[i] = gallop(columns[i], positions[i], ends[i],
+                               [maxValue](Id id) { return !(maxValue < id); });
+      auto& relation = state.relations_[participants[i].first];
+      if (participants[i].second) {
+        relation.multiplicity_ = matchingEnds[i] - positions[i];
+      } else {
+        relation.beginMatching_ = positions[i];
+        relation.endMatching_ = matchingEnds[i];
+      }
+    }
+    joinAtDepth(state, depth + 1);
+    for (size_t i = 0; i < numParticipants; ++i) {
+      positions[i] = matchingEnds[i];
+      if (positions[i] == ends[i]) {
+        return;
+      }
+    }
+  }
+}
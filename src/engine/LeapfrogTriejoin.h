@@ -0,0 +1,111 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_LEAPFROGTRIEJOIN_H
+#define QLEVER_SRC_ENGINE_LEAPFROGTRIEJOIN_H
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+
+// A worst-case optimal join of several binary relations (typically index
+// scans like `?x <p> ?y`) on all their variables at once, using the Leapfrog
+// Triejoin algorithm (Veldhuizen, 2014). For cyclic patterns like triangles
+// (`?a <p> ?b . ?b <p> ?c . ?c <p> ?a`), the size of the intermediate results
+// of this algorithm is bounded by the size of the final result, while a
+// sequence of binary joins might first compute a (much larger) result for a
+// path of the pattern.
+//
+// The variables are bound one after the other in a fixed order (the
+// `variableOrder`, which is also the order of the result columns). Each child
+// is sorted by its variable that comes first in this order, and then by the
+// other one, s.t. it can be used as a trie of depth two. For each variable,
+// the sorted values of all children that contain it are intersected by
+// galloping (or binary) searches, and for each common value, the next variable
+// is bound recursively.
+class LeapfrogTriejoin : public Operation {
+ public:
+  using Children = std::vector<std::shared_ptr<QueryExecutionTree>>;
+
+ private:
+  // For each child, the indices of its two variables in the `variableOrder_`
+  // (the first one is the smaller index) and the corresponding columns of the
+  // child.
+  struct ChildVariables {
+    std::array<size_t, 2> variableIndices_;
+    std::array<ColumnIndex, 2> columns_;
+  };
+
+  Children children_;
+  std::vector<Variable> variableOrder_;
+  std::vector<ChildVariables> childVariables_;
+  std::optional<uint64_t> sizeEstimate_;
+
+  // The state of the computation, see `LeapfrogTriejoin.cpp`.
+  struct JoinState;
+
+ public:
+  // Each of the `children` must have exactly two distinct variables, which
+  // are both contained in the `variableOrder`, and must not contain UNDEF
+  // values. Each variable of the `variableOrder` must be contained in at
+  // least one of the children. The children are sorted as described above if
+  // necessary.
+  LeapfrogTriejoin(QueryExecutionContext* qec, Children children,
+                   std::vector<Variable> variableOrder);
+
+  // Compute an order of the variables of the binary relations with the given
+  // `variables` that is suitable for the join: Start with a variable that is
+  // contained in the most relations and then always choose the next variable
+  // with the most relations that connect it to the already chosen ones.
+  static std::vector<Variable> computeVariableOrder(
+      const std::vector<std::array<Variable, 2>>& variables);
+
+  const std::vector<Variable>& variableOrder() const { return variableOrder_; }
+
+  std::vector<QueryExecutionTree*> getChildren() override;
+
+  std::string getDescriptor() const override;
+
+  size_t getResultWidth() const override { return variableOrder_.size(); }
+
+  size_t getCostEstimate() override;
+
+  float getMultiplicity(size_t col) override;
+
+  bool knownEmptyResult() override;
+
+ private:
+  std::string getCacheKeyImpl() const override;
+
+  // The result is an upper bound on the size of the join that is derived from
+  // the AGM bound for a fractional edge cover in which each child gets the
+  // weight `max(1 / deg(x), 1 / deg(y))` for its variables `x` and `y` (where
+  // `deg` is the number of children that contain a variable).
+  uint64_t getSizeEstimateBeforeLimit() override;
+
+  // The result is sorted by all the columns (in the `variableOrder_`).
+  std::vector<ColumnIndex> resultSortedOn() const override;
+
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+  std::unique_ptr<Operation> cloneImpl() const override;
+
+  Result computeResult([[maybe_unused]] bool requestLaziness) override;
+
+  // Bind the variable with the index `depth` to all the values that are
+  // contained in all children with this variable (in the current ranges of
+  // the `state`), and recursively bind the next variables.
+  void joinAtDepth(JoinState& state, size_t depth) const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_LEAPFROGTRIEJOIN_H
@@ -8,6 +8,8 @@
 #include "engine/Load.h"
 
 #include "global/RuntimeParameters.h"
+#include "parser/ParallelBuffer.h"
+#include "parser/RdfParser.h"
 #include "util/http/HttpUtils.h"
 
 // _____________________________________________________________________________
@@ -101,8 +103,7 @@ Result Load::computeResult(bool requestLaziness) {
 }
 
 // _____________________________________________________________________________
-Result Load::computeResultImpl([[maybe_unused]] bool requestLaziness) {
-  // TODO<qup42> implement lazy loading; requires modifications to the parser
+Result Load::computeResultImpl(bool requestLaziness) {
   ad_utility::httpUtils::Url url{
       asStringViewUnsafe(loadClause_.iri_.getContent())};
   AD_LOG_INFO << "Loading RDF dataset from " << url.asString() << std::endl;
@@ -139,27 +140,68 @@ Result Load::computeResultImpl([[maybe_unused]] bool requestLaziness) {
         "Unsupported `Content-Type` of response: \"", response.contentType_,
         "\". Supported `Content-Type`s are ", supportedMediatypes));
   }
-  using Re2Parser = RdfStringParser<TurtleParser<Tokenizer>>;
-  const auto& encodedIriManager = getIndex().encodedIriManager();
-  auto parser = Re2Parser(&encodedIriManager);
-  std::string body;
-  for (const auto& bytes : response.body_) {
-    body.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  // The body is parsed while it is being downloaded (by the parallel parser's
+  // thread that reads the input), and the triples are converted to IDs batch
+  // by batch.
+  auto parser = std::make_unique<RdfParallelParser<TurtleParser<Tokenizer>>>(
+      std::make_unique<ParallelBufferFromByteSpans>(
+          getRuntimeParameter<&RuntimeParameters::loadParserBlocksize_>()
+              .getBytes(),
+          std::move(response.body_)),
+      &getIndex().encodedIriManager());
+  Result::LazyResult batches = parseTriplesLazily(std::move(parser));
+  // A `LOAD SILENT` either loads all the triples or none (if there is an
+  // error), so its result is always computed completely.
+  if (requestLaziness && !loadClause_.silent_) {
+    return {std::move(batches), resultSortedOn()};
   }
-  parser.setInputStream(body);
-  LocalVocab lv;
   IdTable result{getResultWidth(), getExecutionContext()->getAllocator()};
-  auto toId = [this, &lv](TripleComponent&& tc) {
-    return std::move(tc).toValueId(getIndex(), lv);
-  };
-  for (auto& triple : parser.parseAndReturnAllTriples()) {
-    result.push_back(
-        std::array{toId(std::move(triple.subject_)),
-                   toId(TripleComponent(std::move(triple.predicate_))),
-                   toId(std::move(triple.object_))});
-    checkCancellation();
+  LocalVocab localVocab;
+  for (auto& pair : batches) {
+    result.insertAtEnd(pair.idTable_);
+    localVocab.mergeWith(pair.localVocab_);
   }
-  return Result{std::move(result), resultSortedOn(), std::move(lv)};
+  return {std::move(result), resultSortedOn(), std::move(localVocab)};
+}
+
+// _____________________________________________________________________________
+Result::LazyResult Load::parseTriplesLazily(
+    std::unique_ptr<RdfParserBase> parser) {
+  using LC = Result::IdTableLoopControl;
+  auto get = [self = this, parser = std::move(parser)]() {
+    auto batch = [&]() {
+      try {
+        return parser->getBatch();
+      } catch (const std::exception&) {
+        // The parallel parser reports all errors (also those of the download)
+        // as a `std::runtime_error`, so a cancellation has to be detected
+        // separately.
+        self->checkCancellation();
+        throw;
+      }
+    }();
+    if (!batch.has_value()) {
+      return LC::makeBreak();
+    }
+    LocalVocab localVocab;
+    IdTable idTable{self->getResultWidth(),
+                    self->getExecutionContext()->getAllocator()};
+    idTable.reserve(batch->size());
+    auto toId = [self, &localVocab](TripleComponent&& tc) {
+      return std::move(tc).toValueId(self->getIndex(), localVocab);
+    };
+    for (auto& triple : batch.value()) {
+      idTable.push_back(
+          std::array{toId(std::move(triple.subject_)),
+                     toId(TripleComponent(std::move(triple.predicate_))),
+                     toId(std::move(triple.object_))});
+    }
+    self->checkCancellation();
+    return LC::yieldValue(
+        Result::IdTableVocabPair{std::move(idTable), std::move(localVocab)});
+  };
+  return Result::LazyResult{
+      ad_utility::InputRangeFromLoopControlGet{std::move(get)}};
 }
 
 // _____________________________________________________________________________
@@ -14,8 +14,13 @@
 #include "parser/ParsedQuery.h"
 #include "util/http/HttpClient.h"
 
+// Forward declaration
+class RdfParserBase;
+
 // This class implements the SPARQL UPDATE `LOAD` operation. It reads a turtle
-// document from a remote URL via HTTP and converts it to an `IdTable`.
+// document from a remote URL via HTTP and converts it to an `IdTable`. The
+// document is parsed in parallel while it is downloaded, and if a lazy result
+// is requested, the triples are yielded in blocks as soon as they are parsed.
 class Load final : public Operation {
  public:
   static constexpr std::array<ad_utility::MediaType, 2> SUPPORTED_MEDIATYPES{
@@ -77,6 +82,10 @@ class Load final : public Operation {
   // Actually compute the result for `computeResult()`.
   Result computeResultImpl(bool requestLaziness);
 
+  // Convert the triples of the `parser` batch by batch. Each batch of the
+  // parser becomes one `IdTable` with its own `LocalVocab`.
+  Result::LazyResult parseTriplesLazily(std::unique_ptr<RdfParserBase> parser);
+
   VariableToColumnMap computeVariableToColumnMap() const override;
 
   // Throws an error message, providing the first 100 bytes of the result as
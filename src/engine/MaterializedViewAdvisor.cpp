@@ -0,0 +1,140 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/MaterializedViewAdvisor.h"
+
+#include <algorithm>
+
+#include "engine/Operation.h"
+#include "engine/RuntimeInformation.h"
+#include "global/Id.h"
+#include "global/RuntimeParameters.h"
+
+// _____________________________________________________________________________
+auto MaterializedViewAdvisor::Candidate::savedTime() const -> Microseconds {
+  if (numComputations_ == 0) {
+    return Microseconds{0};
+  }
+  return totalComputationTime_ / numComputations_ * (numComputations_ - 1);
+}
+
+// _____________________________________________________________________________
+ad_utility::MemorySize MaterializedViewAdvisor::Candidate::estimatedSize()
+    const {
+  return ad_utility::MemorySize::bytes(numRows_ * numCols_ * sizeof(Id));
+}
+
+// _____________________________________________________________________________
+void to_json(nlohmann::json& json,
+             const MaterializedViewAdvisor::Candidate& candidate) {
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+  json = {
+      {"cache-key", candidate.cacheKey_},
+      {"descriptor", candidate.descriptor_},
+      {"example-query", candidate.exampleQuery_},
+      {"num-computations", candidate.numComputations_},
+      {"total-computation-time-ms",
+       duration_cast<milliseconds>(candidate.totalComputationTime_).count()},
+      {"saved-time-ms",
+       duration_cast<milliseconds>(candidate.savedTime()).count()},
+      {"num-rows", candidate.numRows_},
+      {"num-cols", candidate.numCols_},
+      {"estimated-size", candidate.estimatedSize().asString()},
+  };
+}
+
+// _____________________________________________________________________________
+void MaterializedViewAdvisor::recordQuery(const QueryExecutionTree& qet,
+                                          std::string_view query) {
+  size_t maxNumCandidates = getRuntimeParameter<
+      &RuntimeParameters::materializedViewAdvisorMaxNumCandidates_>();
+  if (maxNumCandidates == 0) {
+    return;
+  }
+  auto candidates = candidates_.wlock();
+  std::vector<const QueryExecutionTree*> stack{&qet};
+  while (!stack.empty()) {
+    const QueryExecutionTree& tree = *stack.back();
+    stack.pop_back();
+    const Operation& operation = *tree.getRootOperation();
+    auto children = operation.getChildren();
+    stack.insert(stack.end(), children.begin(), children.end());
+
+    // Leaves like index scans are cheap to recompute, and subtrees that were
+    // read from the cache or not computed at all don't count.
+    const auto& runtimeInfo = operation.runtimeInfo();
+    bool completed =
+        runtimeInfo.status_ ==
+            RuntimeInformation::Status::fullyMaterializedCompleted ||
+        runtimeInfo.status_ ==
+            RuntimeInformation::Status::lazilyMaterializedCompleted;
+    if (children.empty() || !completed ||
+        runtimeInfo.cacheStatus_ != ad_utility::CacheStatus::computed) {
+      continue;
+    }
+
+    auto it = candidates->find(tree.getCacheKey());
+    if (it == candidates->end()) {
+      if (candidates->size() >= maxNumCandidates) {
+        continue;
+      }
+      Candidate candidate;
+      candidate.descriptor_ = operation.getDescriptor();
+      candidate.exampleQuery_ = std::string{query};
+      it = candidates->emplace(tree.getCacheKey(), std::move(candidate)).first;
+    }
+    Candidate& candidate = it->second;
+    ++candidate.numComputations_;
+    candidate.totalComputationTime_ += runtimeInfo.totalTime_;
+    candidate.numRows_ = runtimeInfo.numRows_;
+    candidate.numCols_ = runtimeInfo.numCols_;
+  }
+}
+
+// _____________________________________________________________________________
+auto MaterializedViewAdvisor::recommendations(
+    ad_utility::MemorySize diskBudget, size_t maxNumRecommendations) const
+    -> std::vector<Candidate> {
+  std::vector<Candidate> candidates;
+  for (const auto& [cacheKey, candidate] : *candidates_.rlock()) {
+    if (candidate.numComputations_ >= 2) {
+      candidates.push_back(candidate);
+      candidates.back().cacheKey_ = cacheKey;
+    }
+  }
+  ql::ranges::sort(candidates, [](const Candidate& a, const Candidate& b) {
+    return a.savedTime() > b.savedTime();
+  });
+
+  // Greedily choose the candidates with the largest saved time that still fit
+  // into the budget.
+  std::vector<Candidate> result;
+  ad_utility::MemorySize remainingBudget = diskBudget;
+  for (auto& candidate : candidates) {
+    if (result.size() >= maxNumRecommendations) {
+      break;
+    }
+    auto size = candidate.estimatedSize();
+    if (size > remainingBudget) {
+      continue;
+    }
+    remainingBudget -= size;
+    result.push_back(std::move(candidate));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+size_t MaterializedViewAdvisor::numCandidates() const {
+  return candidates_.rlock()->size();
+}
+
+// _____________________________________________________________________________
+void MaterializedViewAdvisor::clear() { candidates_.wlock()->clear(); }
@@ -0,0 +1,87 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_MATERIALIZEDVIEWADVISOR_H
+#define QLEVER_SRC_ENGINE_MATERIALIZEDVIEWADVISOR_H
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "engine/QueryExecutionTree.h"
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+#include "util/json.h"
+
+// Collect statistics about the subtrees of the executed queries to recommend
+// the subtrees that would be worth precomputing, for example as a
+// materialized view or as a pinned named result.
+//
+// For each executed query, `recordQuery` visits all the non-leaf operations
+// that were actually computed (and not read from the cache), and accumulates
+// their computation times by the cache key of the operation. A subtree that
+// was computed more than once (because it didn't fit in the cache or because
+// it was evicted in the meantime) is a candidate. The candidates are ranked by
+// the time that would have been saved if the result had been precomputed,
+// which is the time of all the computations but the first.
+//
+// The number of distinct subtrees that are tracked is limited by the runtime
+// parameter `materialized-view-advisor-max-num-candidates`. When this limit is
+// reached, only the statistics of the subtrees that are already tracked are
+// updated. A value of zero disables the recording.
+class MaterializedViewAdvisor {
+ public:
+  using Microseconds = std::chrono::microseconds;
+
+  // The statistics of a single subtree.
+  struct Candidate {
+    std::string cacheKey_;
+    std::string descriptor_;
+    // The first query in which the subtree was computed.
+    std::string exampleQuery_;
+    size_t numComputations_ = 0;
+    Microseconds totalComputationTime_{0};
+    // The size of the result of the last computation.
+    size_t numRows_ = 0;
+    size_t numCols_ = 0;
+
+    // The time that would have been saved (see above).
+    Microseconds savedTime() const;
+
+    // The estimated size of the precomputed result.
+    ad_utility::MemorySize estimatedSize() const;
+
+    friend void to_json(nlohmann::json& json, const Candidate& candidate);
+  };
+
+ private:
+  ad_utility::Synchronized<ad_utility::HashMap<std::string, Candidate>>
+      candidates_;
+
+ public:
+  // Record the computed subtrees of the `qet` after it has been executed for
+  // the query with the given text.
+  void recordQuery(const QueryExecutionTree& qet, std::string_view query);
+
+  // Return the candidates that were computed at least twice, by decreasing
+  // saved time, but at most `maxNumRecommendations` of them, and only as many
+  // as fit into the `diskBudget` together.
+  std::vector<Candidate> recommendations(ad_utility::MemorySize diskBudget,
+                                         size_t maxNumRecommendations) const;
+
+  // The number of tracked subtrees.
+  size_t numCandidates() const;
+
+  // Remove all the statistics.
+  void clear();
+};
+
+#endif  // QLEVER_SRC_ENGINE_MATERIALIZEDVIEWADVISOR_H
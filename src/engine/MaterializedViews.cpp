@@ -16,6 +16,7 @@
 #include <nlohmann/json.hpp>
 #include <stdexcept>
 
+#include "backports/algorithm.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/MaterializedViewsQueryAnalysis.h"
@@ -23,6 +24,7 @@
 #include "engine/QueryExecutionTree.h"
 #include "engine/VariableToColumnMap.h"
 #include "engine/idTable/CompressedExternalIdTable.h"
+#include "global/Constants.h"
 #include "index/DeltaTriples.h"
 #include "index/ExternalSortFunctors.h"
 #include "libqlever/Qlever.h"
@@ -415,6 +417,9 @@ MaterializedView::MaterializedView(std::string onDiskBase, std::string name)
     // Compute the `BIND`-to-column map.
     coveredBinds_ = materializedViewsQueryAnalysis::extractBindExpressions(
         parsedQuery_.value(), varToColMap_);
+    dependentPredicates_ =
+        materializedViewsQueryAnalysis::extractDependentPredicates(
+            parsedQuery_.value());
   }
 
   // Read the permutation and set its type to `MATERIALIZED_VIEW`. This
@@ -449,6 +454,7 @@ void MaterializedViewsManager::loadView(const std::string& name) const {
   auto view = std::make_shared<MaterializedView>(onDiskBase_, name);
   view->connectPermutationBackReference();
   lock->views_.insert({name, view});
+  ++lock->version_;
   // If we would analyze the view at the time of writing and (de)serialize an
   // analysis result here, we could not extend query analysis without rewriting
   // all views. Therefore query analysis is performed when loading views.
@@ -467,6 +473,7 @@ void MaterializedViewsManager::unloadViewIfLoaded(
   }
   lock->queryPatternCache_.removeView(lock->views_.at(name));
   lock->views_.erase(name);
+  ++lock->version_;
 }
 
 // _____________________________________________________________________________
@@ -481,6 +488,135 @@ bool MaterializedViewsManager::isViewLoaded(const std::string& name) const {
   return loadedViews_.rlock()->views_.contains(name);
 }
 
+// _____________________________________________________________________________
+std::string MaterializedViewsManager::getTransitiveClosureViewName(
+    std::string_view predicate, bool forward) {
+  // View names may only contain alphanumerics and hyphens, so we identify the
+  // predicate by a hash. The hash has to be stable across runs, so we use the
+  // 64-bit FNV-1a hash instead of `absl::Hash`. Collisions are detected by
+  // `getTransitiveClosureView` via the stored query.
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char c : predicate) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+  }
+  return absl::StrCat("transitive-closure-", absl::Hex(hash, absl::kZeroPad16),
+                      forward ? "-forward" : "-backward");
+}
+
+// _____________________________________________________________________________
+std::string MaterializedViewsManager::getTransitiveClosureViewQuery(
+    std::string_view predicate, bool forward) {
+  AD_CONTRACT_CHECK(
+      predicate.size() > 2 && predicate.front() == '<' &&
+          predicate.back() == '>',
+      "The predicate of a precomputed transitive closure must be a full IRI "
+      "in angle brackets, but was ",
+      predicate);
+  return absl::StrCat(
+      forward ? "SELECT ?start ?target" : "SELECT ?target ?start",
+      " { ?start ", predicate, "+ ?target }");
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const MaterializedView>
+MaterializedViewsManager::getTransitiveClosureView(std::string_view predicate,
+                                                   bool forward) const {
+  return getPrecomputedView(getTransitiveClosureViewName(predicate, forward),
+                            getTransitiveClosureViewQuery(predicate, forward));
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const MaterializedView>
+MaterializedViewsManager::getPrecomputedView(
+    const std::string& name, std::string_view expectedQuery) const {
+  if (!isViewLoaded(name) &&
+      !std::filesystem::exists(
+          absl::StrCat(MaterializedView::getFilenameBase(onDiskBase_, name),
+                       ".viewinfo.json"))) {
+    return nullptr;
+  }
+  auto view = getView(name);
+  if (view->originalQuery() != expectedQuery) {
+    return nullptr;
+  }
+  return view;
+}
+
+// _____________________________________________________________________________
+std::string MaterializedViewsManager::getFacetStatisticsViewName(
+    FacetStatistics statistics) {
+  return statistics == FacetStatistics::ClassPredicate
+             ? "facet-statistics-class-predicate"
+             : "facet-statistics-predicate-object";
+}
+
+// _____________________________________________________________________________
+std::string MaterializedViewsManager::getFacetStatisticsViewQuery(
+    FacetStatistics statistics) {
+  if (statistics == FacetStatistics::ClassPredicate) {
+    return absl::StrCat(
+        "SELECT ?class ?predicate (COUNT(DISTINCT ?subject) AS ?count) { "
+        "?subject <",
+        RDF_PREFIX,
+        "type> ?class . ?subject ?predicate ?object } "
+        "GROUP BY ?class ?predicate");
+  }
+  return "SELECT ?predicate ?object (COUNT(?subject) AS ?count) { "
+         "?subject ?predicate ?object } GROUP BY ?predicate ?object";
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const MaterializedView>
+MaterializedViewsManager::getFacetStatisticsView(
+    FacetStatistics statistics) const {
+  return getPrecomputedView(getFacetStatisticsViewName(statistics),
+                            getFacetStatisticsViewQuery(statistics));
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<IndexScan> MaterializedViewsManager::makeFacetStatisticsScan(
+    QueryExecutionContext* qec, const ParsedQuery& parsed) const {
+  auto facetQuery =
+      materializedViewsQueryAnalysis::analyzeFacetStatisticsQuery(parsed);
+  if (!facetQuery.has_value()) {
+    return nullptr;
+  }
+  auto view = getFacetStatisticsView(facetQuery->statistics_);
+  if (view == nullptr) {
+    return nullptr;
+  }
+  return view->makeIndexScan(
+      qec, parsedQuery::MaterializedViewQuery{
+               view->name(), std::move(facetQuery->columns_)});
+}
+
+// _____________________________________________________________________________
+bool MaterializedView::isUnaffectedByUpdates(QueryExecutionContext* qec) const {
+  if (qec->locatedTriplesState()
+          .getLocatedTriplesForPermutation(Permutation::PSO)
+          .numTriples() == 0) {
+    return true;
+  }
+  if (!dependentPredicates_.has_value()) {
+    return false;
+  }
+  // The view is unaffected iff none of the blocks of the scans for its
+  // predicates contains located triples. A predicate that is not contained in
+  // the vocabulary might have been added by an update.
+  const auto& index = qec->getIndex().getImpl();
+  return ql::ranges::all_of(
+      dependentPredicates_.value(), [qec, &index](const std::string& iri) {
+        TripleComponent predicate{TripleComponent::Iri::fromIriref(iri)};
+        if (!predicate.toValueId(index).has_value()) {
+          return false;
+        }
+        IndexScan scan{qec, Permutation::PSO,
+                       SparqlTripleSimple{Variable{"?s"}, std::move(predicate),
+                                          Variable{"?o"}}};
+        return scan.isUnaffectedByUpdates();
+      });
+}
+
 // _____________________________________________________________________________
 void MaterializedView::throwIfScanColumnMissing(
     const std::optional<TripleComponent>& s) const {
@@ -684,8 +820,17 @@ std::vector<MaterializedViewJoinReplacement>
 MaterializedViewsManager::makeJoinReplacementIndexScans(
     QueryExecutionContext* qec,
     const parsedQuery::BasicGraphPattern& triples) const {
-  return loadedViews_.rlock()->queryPatternCache_.makeJoinReplacementIndexScans(
-      qec, triples);
+  auto replacements =
+      loadedViews_.rlock()->queryPatternCache_.makeJoinReplacementIndexScans(
+          qec, triples);
+  // Don't rewrite to views that are stale because of updates, because
+  // otherwise the result of the query would depend on the chosen plan.
+  ql::erase_if(replacements, [qec](const auto& replacement) {
+    auto view = replacement.indexScan_->permutation().materializedView();
+    AD_CORRECTNESS_CHECK(view != nullptr);
+    return !view->isUnaffectedByUpdates(qec);
+  });
+  return replacements;
 }
 
 // _____________________________________________________________________________
@@ -160,6 +160,12 @@ class MaterializedView : public std::enable_shared_from_this<MaterializedView> {
   // the target column index.
   materializedViewsQueryAnalysis::BindExpressionAndTargetCol coveredBinds_;
 
+  // The predicates that the rows of the view depend on, or `std::nullopt` if
+  // the view might depend on any triple of the index (see
+  // `extractDependentPredicates`). This is used to detect that the view is
+  // stale after an update.
+  std::optional<ad_utility::HashSet<std::string>> dependentPredicates_;
+
   using AdditionalScanColumns = SparqlTripleSimple::AdditionalScanColumns;
 
   // Helper to create an empty `LocatedTriplesState` for `IndexScan`s as
@@ -255,6 +261,15 @@ class MaterializedView : public std::enable_shared_from_this<MaterializedView> {
   std::optional<size_t> lookupBindTargetColumn(
       const std::string& bindCacheKey) const;
 
+  // Return true iff the rows of this view are guaranteed to be unaffected by
+  // the current delta triples of the `qec`, that is, iff none of the updates
+  // since the view was written touched a triple with one of the predicates the
+  // view depends on. Otherwise, the view is stale and must not be used to
+  // rewrite a query, because the result would diverge from the result with the
+  // updates. Views for which the query is unknown or depends on arbitrary
+  // triples are stale after any update.
+  bool isUnaffectedByUpdates(QueryExecutionContext* qec) const;
+
   // Dummy variables for internal use.
   static const Variable& dummyPredicate();
   static const Variable& dummyObject();
@@ -262,6 +277,7 @@ class MaterializedView : public std::enable_shared_from_this<MaterializedView> {
 
 // Shorthand for query rewriting helper class.
 using materializedViewsQueryAnalysis::MaterializedViewJoinReplacement;
+using materializedViewsQueryAnalysis::FacetStatistics;
 
 // The `MaterializedViewsManager` is part of the `QueryExecutionContext` and is
 // used to manage the currently loaded `MaterializedViews` in a `Server` or
@@ -274,6 +290,8 @@ class MaterializedViewsManager {
   struct LoadedViews {
     ad_utility::HashMap<std::string, std::shared_ptr<MaterializedView>> views_;
     materializedViewsQueryAnalysis::QueryPatternCache queryPatternCache_;
+    // Incremented whenever a view is loaded or unloaded, see `version()`.
+    size_t version_ = 0;
   };
 
   mutable ad_utility::Synchronized<LoadedViews> loadedViews_;
@@ -300,6 +318,11 @@ class MaterializedViewsManager {
   // otherwise. It is `const` for the same reason described above.
   void unloadViewIfLoaded(const std::string& name) const;
 
+  // A number that changes whenever the set of loaded views changes. It is used
+  // to invalidate query plans that were created for a different set of views
+  // (see `QueryPlanCache`).
+  size_t version() const { return loadedViews_.rlock()->version_; }
+
   // Load the given view if it is not already loaded and return it. This pointer
   // is never `nullptr`. If the view does not exist, the function throws.
   std::shared_ptr<const MaterializedView> getView(
@@ -334,6 +357,50 @@ class MaterializedViewsManager {
       ad_utility::MemorySize memoryLimit = ad_utility::MemorySize::gigabytes(4),
       ad_utility::AllocatorWithLimit<Id> allocator =
           ad_utility::makeUnlimitedAllocator<Id>()) const;
+
+  // The transitive closure of a predicate `<p>` (e.g. a hierarchy predicate
+  // like `wdt:P279`) can be precomputed at index build time. It is stored as
+  // two materialized views, one with the pairs `(start, target)` of
+  // `?start <p>+ ?target` sorted by `start` (`forward == true`) and one with
+  // the same pairs swapped, sorted by `target` (`forward == false`). The
+  // following functions return the name and the query of these views. The
+  // `predicate` must be a full IRI in angle brackets.
+  static std::string getTransitiveClosureViewName(std::string_view predicate,
+                                                  bool forward);
+  static std::string getTransitiveClosureViewQuery(std::string_view predicate,
+                                                   bool forward);
+
+  // Return the view with the precomputed transitive closure of the
+  // `predicate` in the given direction (see above) or `nullptr` if it was not
+  // precomputed for this index.
+  std::shared_ptr<const MaterializedView> getTransitiveClosureView(
+      std::string_view predicate, bool forward) const;
+
+  // The facet statistics for faceted browsing (see `FacetStatistics`) can
+  // also be precomputed at index build time. Each kind of statistics is stored
+  // as a materialized view, the name and query of which are returned by the
+  // following functions. The first two columns of the view are the grouped
+  // values, the third column is the count.
+  static std::string getFacetStatisticsViewName(FacetStatistics statistics);
+  static std::string getFacetStatisticsViewQuery(FacetStatistics statistics);
+
+  // Return the view with the precomputed `statistics` or `nullptr` if they
+  // were not precomputed for this index.
+  std::shared_ptr<const MaterializedView> getFacetStatisticsView(
+      FacetStatistics statistics) const;
+
+  // If the `GROUP BY` of the `parsed` query can be answered by a scan of the
+  // precomputed facet statistics (see `analyzeFacetStatisticsQuery`), return
+  // this scan, else `nullptr`.
+  std::shared_ptr<IndexScan> makeFacetStatisticsScan(
+      QueryExecutionContext* qec, const ParsedQuery& parsed) const;
+
+ private:
+  // Return the view with the given `name` if it exists and was written with
+  // the `expectedQuery`, else `nullptr`. This is used for the views that are
+  // precomputed at index build time.
+  std::shared_ptr<const MaterializedView> getPrecomputedView(
+      const std::string& name, std::string_view expectedQuery) const;
 };
 
 #endif  // QLEVER_SRC_ENGINE_MATERIALIZEDVIEWS_H_
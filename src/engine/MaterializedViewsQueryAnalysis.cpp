@@ -9,11 +9,14 @@
 
 #include "engine/MaterializedViewsQueryAnalysis.h"
 
+#include <absl/strings/str_cat.h>
+
 #include <algorithm>
 #include <optional>
 #include <variant>
 
 #include "backports/algorithm.h"
+#include "global/Constants.h"
 #include "engine/IndexScan.h"
 #include "engine/MaterializedViews.h"
 #include "engine/VariableToColumnMap.h"
@@ -21,6 +24,7 @@
 #include "parser/PropertyPath.h"
 #include "parser/SparqlParser.h"
 #include "util/Exception.h"
+#include "util/HashSet.h"
 #include "util/VariantRangeFilter.h"
 
 namespace materializedViewsQueryAnalysis {
@@ -475,4 +479,147 @@ BindExpressionAndTargetCol extractBindExpressions(
   return map;
 }
 
+// _____________________________________________________________________________
+std::optional<FacetStatisticsQuery> analyzeFacetStatisticsQuery(
+    const ParsedQuery& parsed) {
+  // The query has to consist of a single basic graph pattern with one or two
+  // triples and a single alias for the count.
+  if (!parsed.hasSelectClause() || !parsed._rootGraphPattern._filters.empty() ||
+      parsed._rootGraphPattern._graphPatterns.size() != 1) {
+    return std::nullopt;
+  }
+  const auto* bgp = std::get_if<parsedQuery::BasicGraphPattern>(
+      &parsed._rootGraphPattern._graphPatterns.front());
+  const auto& aliases = parsed.selectClause().getAliases();
+  if (bgp == nullptr || bgp->_triples.empty() || bgp->_triples.size() > 2 ||
+      aliases.size() != 1) {
+    return std::nullopt;
+  }
+  auto countedVariable = aliases.front()._expression.getVariableForCount();
+  if (!countedVariable.has_value()) {
+    return std::nullopt;
+  }
+  const Variable& count = aliases.front()._target;
+  const Variable& subject = countedVariable->variable_;
+
+  // The triple `?subject ?predicate ?object` (with a variable or fixed
+  // predicate), the subject of which is the counted variable.
+  const SparqlTriple* predicateTriple = nullptr;
+  // The triple `?subject rdf:type ?class` (with a variable or fixed class).
+  const SparqlTriple* classTriple = nullptr;
+  static const std::string rdfType = absl::StrCat("<", RDF_PREFIX, "type>");
+  for (const auto& triple : bgp->_triples) {
+    if (!triple.additionalScanColumns_.empty() || !triple.s_.isVariable() ||
+        triple.s_.getVariable() != subject) {
+      return std::nullopt;
+    }
+    if (triple.getPredicateVariable().has_value() && triple.o_.isVariable()) {
+      predicateTriple = &triple;
+    } else if (bgp->_triples.size() == 2 &&
+               triple.getSimplePredicate() == rdfType) {
+      classTriple = &triple;
+    } else if (bgp->_triples.size() == 1 &&
+               triple.getSimplePredicate().has_value() &&
+               triple.o_.isVariable()) {
+      predicateTriple = &triple;
+    } else {
+      return std::nullopt;
+    }
+  }
+  if (predicateTriple == nullptr ||
+      (bgp->_triples.size() == 2 && classTriple == nullptr)) {
+    return std::nullopt;
+  }
+
+  // Return the predicate of the `triple` as a `TripleComponent`.
+  auto getPredicate = [](const SparqlTriple& triple) -> TripleComponent {
+    if (auto variable = triple.getPredicateVariable()) {
+      return variable.value();
+    }
+    return TripleComponent::Iri::fromIriref(
+        triple.getSimplePredicate().value());
+  };
+  TripleComponent predicate = getPredicate(*predicateTriple);
+  const Variable& object = predicateTriple->o_.getVariable();
+
+  // The variables of the triples have to be pairwise distinct, and the
+  // query has to be grouped by exactly the variables among the first two
+  // columns of the view.
+  auto checkVariablesAndGroupBy =
+      [&parsed, &count](const std::vector<TripleComponent>& viewColumns,
+                        const std::vector<Variable>& otherVariables) {
+        ad_utility::HashSet<Variable> variables{count};
+        std::vector<Variable> expectedGroupBy;
+        for (const auto& column : viewColumns) {
+          if (column.isVariable()) {
+            expectedGroupBy.push_back(column.getVariable());
+            variables.insert(column.getVariable());
+          }
+        }
+        variables.insert(otherVariables.begin(), otherVariables.end());
+        if (variables.size() !=
+            1 + expectedGroupBy.size() + otherVariables.size()) {
+          return false;
+        }
+        auto groupBy = parsed._groupByVariables;
+        std::sort(groupBy.begin(), groupBy.end());
+        std::sort(expectedGroupBy.begin(), expectedGroupBy.end());
+        return groupBy == expectedGroupBy;
+      };
+
+  using RequestedColumns =
+      parsedQuery::MaterializedViewQuery::RequestedColumns;
+  if (classTriple != nullptr) {
+    // The view counts the distinct subjects.
+    if (!countedVariable->isDistinct_ || !predicate.isVariable()) {
+      return std::nullopt;
+    }
+    const TripleComponent& cls = classTriple->o_;
+    if (!(cls.isVariable() || cls.isIri()) ||
+        !checkVariablesAndGroupBy({cls, predicate}, {subject, object})) {
+      return std::nullopt;
+    }
+    return FacetStatisticsQuery{
+        FacetStatistics::ClassPredicate,
+        RequestedColumns{{Variable{"?class"}, cls},
+                         {Variable{"?predicate"}, std::move(predicate)},
+                         {Variable{"?count"}, TripleComponent{count}}}};
+  }
+  // The view counts the subjects (each triple once).
+  if (countedVariable->isDistinct_ ||
+      !checkVariablesAndGroupBy({predicate, TripleComponent{object}},
+                                {subject})) {
+    return std::nullopt;
+  }
+  return FacetStatisticsQuery{
+      FacetStatistics::PredicateObject,
+      RequestedColumns{{Variable{"?predicate"}, std::move(predicate)},
+                       {Variable{"?object"}, TripleComponent{object}},
+                       {Variable{"?count"}, TripleComponent{count}}}};
+}
+
+// _____________________________________________________________________________
+std::optional<ad_utility::HashSet<std::string>> extractDependentPredicates(
+    const ParsedQuery& parsed) {
+  ad_utility::HashSet<std::string> predicates;
+  for (const auto& graphPattern : parsed._rootGraphPattern._graphPatterns) {
+    if (std::holds_alternative<parsedQuery::Bind>(graphPattern) ||
+        std::holds_alternative<parsedQuery::Values>(graphPattern)) {
+      // These don't read any triples from the index.
+      continue;
+    }
+    if (!std::holds_alternative<parsedQuery::BasicGraphPattern>(graphPattern)) {
+      return std::nullopt;
+    }
+    for (const auto& triple : graphPattern.getBasic()._triples) {
+      auto predicate = triple.getSimplePredicate();
+      if (!predicate.has_value()) {
+        return std::nullopt;
+      }
+      predicates.emplace(predicate.value());
+    }
+  }
+  return predicates;
+}
+
 }  // namespace materializedViewsQueryAnalysis
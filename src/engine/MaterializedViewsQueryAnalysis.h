@@ -157,6 +157,43 @@ class QueryPatternCache {
 std::vector<parsedQuery::GraphPatternOperation> graphPatternInvariantFilter(
     const ParsedQuery& parsed);
 
+// The kinds of "facet statistics" for faceted browsing, which can be
+// precomputed at index build time (see `IndexBuilderConfig::facetStatistics_`)
+// and are stored as materialized views (see
+// `MaterializedViewsManager::getFacetStatisticsViewQuery`).
+enum class FacetStatistics {
+  // The number of distinct subjects for each pair of a class (the object of an
+  // `rdf:type` triple of the subject) and a predicate of the subject.
+  ClassPredicate,
+  // The number of subjects for each pair of a predicate and an object, that
+  // is the histogram of the objects of each predicate.
+  PredicateObject
+};
+
+// A `GROUP BY` query that can be answered by a scan of the view with the
+// given `statistics_`. The `columns_` map the columns of this view to the
+// variables or fixed values of the query.
+struct FacetStatisticsQuery {
+  FacetStatistics statistics_;
+  parsedQuery::MaterializedViewQuery::RequestedColumns columns_;
+};
+
+// Check if the `parsed` query is one of the following queries (with arbitrary
+// variable names) and return the corresponding `FacetStatisticsQuery`:
+//
+// SELECT ?class ?p (COUNT(DISTINCT ?s) AS ?count) {
+//   ?s rdf:type ?class . ?s ?p ?o } GROUP BY ?class ?p
+// SELECT ?p ?o (COUNT(?s) AS ?count) { ?s ?p ?o } GROUP BY ?p ?o
+//
+// In both queries, the first grouped variable may also be a fixed IRI, which
+// is then not grouped by. The query may have additional clauses that are
+// applied after the `GROUP BY` (like `HAVING`, `ORDER BY`, and `LIMIT`), which
+// makes the top-k objects of a predicate cheap to compute. The caller has to
+// make sure that the query is evaluated on the default graph and that the
+// index is unaffected by updates, because the views don't reflect them.
+std::optional<FacetStatisticsQuery> analyzeFacetStatisticsQuery(
+    const ParsedQuery& parsed);
+
 // Hash map for the `BIND`-to-column map.
 using BindExpressionAndTargetCol = ad_utility::HashMap<std::string, size_t>;
 
@@ -165,6 +202,15 @@ using BindExpressionAndTargetCol = ad_utility::HashMap<std::string, size_t>;
 BindExpressionAndTargetCol extractBindExpressions(
     const ParsedQuery& parsed, const VariableToColumnMap& varToColMap);
 
+// Return the set of predicates (as IRI strings) that the result of the query of
+// a materialized view depends on, that is, the fixed predicates of the triples
+// of its basic graph patterns. Return `std::nullopt` if the result might
+// depend on any triple of the index, for example because of a variable
+// predicate, a property path, or a graph pattern other than a basic graph
+// pattern, `BIND`, or `VALUES`.
+std::optional<ad_utility::HashSet<std::string>> extractDependentPredicates(
+    const ParsedQuery& parsed);
+
 }  // namespace materializedViewsQueryAnalysis
 
 #endif  // QLEVER_SRC_ENGINE_MATERIALIZEDVIEWSQUERYANALYSIS_H_
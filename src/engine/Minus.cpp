@@ -5,10 +5,13 @@
 #include "engine/Minus.h"
 
 #include "engine/CallFixedSize.h"
+#include "engine/IndexScan.h"
 #include "engine/JoinHelpers.h"
+#include "engine/JoinWithIndexScanHelpers.h"
 #include "engine/MinusRowHandler.h"
 #include "engine/Service.h"
 #include "engine/Sort.h"
+#include "global/RuntimeParameters.h"
 #include "util/Algorithm.h"
 #include "util/Exception.h"
 #include "util/JoinAlgorithms/IndexNestedLoopJoin.h"
@@ -56,6 +59,17 @@ Result Minus::computeResult(bool requestLaziness) {
   // join column. This might be extended in the future.
   bool lazyJoinIsSupported = _matchedColumns.size() == 1;
 
+  // If the right child is an `IndexScan` (which is then sorted on the join
+  // column), only read the blocks that are relevant for the left child.
+  if (getRuntimeParameter<&RuntimeParameters::prefilteredMinus_>() &&
+      lazyJoinIsSupported && _matchedColumns.at(0).at(1) == 0) {
+    if (auto indexScan =
+            std::dynamic_pointer_cast<IndexScan>(_right->getRootOperation())) {
+      return minusWithIndexScan(_left->getResult(true), std::move(indexScan),
+                                requestLaziness);
+    }
+  }
+
   auto leftResult = _left->getResult(lazyJoinIsSupported);
   auto rightResult = _right->getResult(lazyJoinIsSupported);
 
@@ -366,6 +380,68 @@ Result Minus::lazyMinusJoin(std::shared_ptr<const Result> left,
   }
 }
 
+// _____________________________________________________________________________
+Result Minus::minusWithIndexScan(std::shared_ptr<const Result> left,
+                                 std::shared_ptr<IndexScan> rightScan,
+                                 bool requestLaziness) {
+  AD_CORRECTNESS_CHECK(_matchedColumns.size() == 1);
+  ColumnIndex leftJoinColumn = _matchedColumns.at(0).at(0);
+  // The blocks of the scan are joined directly, so the join column has to be
+  // the first column.
+  AD_CORRECTNESS_CHECK(_matchedColumns.at(0).at(1) == 0);
+
+  // The same permutation as in `lazyMinusJoin`.
+  std::vector<ColumnIndex> permutation;
+  permutation.resize(_left->getResultWidth());
+  ql::ranges::copy(ad_utility::integerRange(permutation.size()),
+                   permutation.begin());
+  std::swap(permutation.at(0), permutation.at(leftJoinColumn));
+
+  using namespace qlever::joinHelpers;
+  using namespace ad_utility::use_value_identity;
+  auto getAction = [&](auto leftIsMaterializedV) {
+    static constexpr bool leftIsMaterialized = leftIsMaterializedV;
+    return [this, left = std::move(left), rightScan = std::move(rightScan),
+            permutation, leftJoinColumn](
+               std::function<void(IdTable&, LocalVocab&)> yieldTable) {
+      ad_utility::MinusRowHandler rowAdder{
+          _matchedColumns.size(), IdTable{getResultWidth(), allocator()},
+          cancellationHandle_, std::move(yieldTable)};
+      auto join = [&rowAdder](auto leftRange, auto rightRange) {
+        ad_utility::zipperJoinForBlocksWithPotentialUndef(
+            std::move(leftRange), std::move(rightRange), std::less{}, rowAdder,
+            {}, {}, ad_utility::MinusJoinTag{});
+      };
+      if constexpr (leftIsMaterialized) {
+        auto rightBlocks = rightScan->lazyScanForJoinOfColumnWithScan(
+            left->idTable().getColumn(leftJoinColumn));
+        join(asSingleTableView(*left, permutation),
+             convertGeneratorFromScan(std::move(rightBlocks), *rightScan));
+      } else {
+        // The rows of `left` must not be filtered, because the rows without a
+        // match are exactly the result of the `MINUS`.
+        auto [leftSide, indexScanSide] = rightScan->prefilterTables(
+            left->idTables(), leftJoinColumn, false);
+        join(convertGenerator(std::move(leftSide), permutation),
+             convertGenerator(std::move(indexScanSide)));
+      }
+      qlever::joinWithIndexScanHelpers::setScanStatusToLazilyCompleted(
+          *rightScan);
+      auto localVocab = std::move(rowAdder.localVocab());
+      return Result::IdTableVocabPair{std::move(rowAdder).resultTable(),
+                                      std::move(localVocab)};
+    };
+  };
+
+  auto createResult = [&](auto leftIsMaterialized) {
+    return createResultFromAction(requestLaziness,
+                                  getAction(leftIsMaterialized),
+                                  resultSortedOn(), std::move(permutation));
+  };
+  return left->isFullyMaterialized() ? createResult(vi<true>)
+                                     : createResult(vi<false>);
+}
+
 // _____________________________________________________________________________
 std::optional<std::shared_ptr<QueryExecutionTree>>
 Minus::makeTreeWithStrippedColumns(const std::set<Variable>& variables) const {
@@ -11,6 +11,8 @@
 #include "engine/Operation.h"
 #include "engine/QueryExecutionTree.h"
 
+class IndexScan;
+
 class Minus : public Operation {
  private:
   std::shared_ptr<QueryExecutionTree> _left;
@@ -116,6 +118,15 @@ class Minus : public Operation {
                        std::shared_ptr<const Result> right,
                        bool requestLaziness);
 
+  // Compute the minus join of `left` and the `rightScan` (which is the right
+  // child of this operation) on a single join column. Only the blocks of the
+  // scan that can contain the join values of `left` are read from disk (all
+  // the blocks if the join column of `left` contains UNDEF values). Both
+  // `left` and the result may be lazy.
+  Result minusWithIndexScan(std::shared_ptr<const Result> left,
+                            std::shared_ptr<IndexScan> rightScan,
+                            bool requestLaziness);
+
   Result computeResult(bool requestLaziness) override;
 
   VariableToColumnMap computeVariableToColumnMap() const override;
@@ -209,6 +209,30 @@ void MultiColumnJoin::computeMultiColumnJoin(
     const IdTableView<0>& left, const IdTableView<0>& right,
     const std::vector<std::array<ColumnIndex, 2>>& joinColumns,
     IdTable* result) {
+  // The inputs are sorted lexicographically by the join columns, so they can
+  // be partitioned by the values of the first join column. Matching rows
+  // always have the same value in this column if it contains no UNDEF values
+  // (which is checked by `joinPartitionsInParallel`). UNDEF values in the
+  // other join columns are handled within the partitions.
+  auto [leftCol, rightCol] = joinColumns.at(0);
+  bool joinedInParallel = qlever::joinHelpers::joinPartitionsInParallel(
+      left, right, leftCol, rightCol, result,
+      [this, &joinColumns](const IdTableView<0>& leftPart,
+                           const IdTableView<0>& rightPart,
+                           IdTable* partResult) {
+        computeMultiColumnJoinSequentially(leftPart, rightPart, joinColumns,
+                                           partResult);
+      });
+  if (!joinedInParallel) {
+    computeMultiColumnJoinSequentially(left, right, joinColumns, result);
+  }
+}
+
+// _____________________________________________________________________________
+void MultiColumnJoin::computeMultiColumnJoinSequentially(
+    const IdTableView<0>& left, const IdTableView<0>& right,
+    const std::vector<std::array<ColumnIndex, 2>>& joinColumns,
+    IdTable* result) {
   // check for trivial cases
   if (left.empty() || right.empty()) {
     return;
@@ -70,6 +70,15 @@ class MultiColumnJoin : public Operation {
       IdTable* resultMightBeUnsorted);
 
  private:
+  // The sequential implementation of `computeMultiColumnJoin` above. Large
+  // inputs are split into partitions of the values of the first join column
+  // that are joined in parallel by this function (see
+  // `joinHelpers::joinPartitionsInParallel`).
+  void computeMultiColumnJoinSequentially(
+      const IdTableView<0>& left, const IdTableView<0>& right,
+      const std::vector<std::array<ColumnIndex, 2>>& joinColumns,
+      IdTable* result);
+
   std::unique_ptr<Operation> cloneImpl() const override;
 
   Result computeResult([[maybe_unused]] bool requestLaziness) override;
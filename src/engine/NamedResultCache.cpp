@@ -47,13 +47,20 @@ void NamedResultCache::store(const Key& name, Value result) {
   // present to avoid this behavior.
   lock->erase(name);
   lock->insert(name, std::move(result));
+  ++version_;
 }
 
 // _____________________________________________________________________________
-void NamedResultCache::erase(const Key& name) { cache_.wlock()->erase(name); }
+void NamedResultCache::erase(const Key& name) {
+  cache_.wlock()->erase(name);
+  ++version_;
+}
 
 // _____________________________________________________________________________
-void NamedResultCache::clear() { cache_.wlock()->clearAll(); }
+void NamedResultCache::clear() {
+  cache_.wlock()->clearAll();
+  ++version_;
+}
 
 // _____________________________________________________________________________
 size_t NamedResultCache::numEntries() const {
@@ -7,6 +7,7 @@
 #ifndef QLEVER_SRC_ENGINE_NAMEDRESULTCACHE_H
 #define QLEVER_SRC_ENGINE_NAMEDRESULTCACHE_H
 
+#include <atomic>
 #include <boost/optional.hpp>
 
 #include "engine/ExplicitIdTableOperation.h"
@@ -65,6 +66,8 @@ class NamedResultCache {
   // `Synchronized` wrapper, and manually have to make sure that we logically
   // don't violate the constness.
   mutable ad_utility::Synchronized<Cache> cache_;
+  // Incremented by each change of the contents, see `version()`.
+  std::atomic<size_t> version_ = 0;
 
  public:
   // Store the given `result` under the given `name`. If a result with the same
@@ -81,6 +84,11 @@ class NamedResultCache {
   // Get the number of cached results.
   size_t numEntries() const;
 
+  // A number that changes whenever a result is stored or erased. It is used to
+  // invalidate query plans that refer to the cached results (see
+  // `QueryPlanCache`).
+  size_t version() const { return version_; }
+
   // Get a pointer to the cached result with the given `name`. If no such
   // result exists, throw an exception.
   std::shared_ptr<const Value> get(const Key& name) const;
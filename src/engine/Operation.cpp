@@ -15,11 +15,16 @@
 #include "engine/NamedResultCache.h"
 #include "engine/OperationBindPushDownImpl.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/QueryResultDiskCache.h"
+#include "engine/SharedLazyResults.h"
 #include "engine/SpatialJoinCachedIndex.h"
 #include "engine/VariableToColumnMap.h"
 #include "global/RuntimeParameters.h"
 #include "parser/GraphPatternOperation.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
+#include "util/SpanTracer.h"
+#include "util/ThreadBudget.h"
+#include "util/ThreadSafeQueue.h"
 #include "util/TransparentFunctors.h"
 
 using namespace std::chrono_literals;
@@ -48,6 +53,21 @@ void mergeStats(LocalVocabTracking& stats, const LocalVocab& vocab) {
     ++stats.nonEmptyVocabs_;
   }
 }
+
+// The status of an operation after its lazy result has been consumed.
+RuntimeInformation::Status statusOfConsumedLazyResult(
+    Result::GeneratorState state) {
+  using enum Result::GeneratorState;
+  switch (state) {
+    case FINISHED:
+      return RuntimeInformation::lazilyMaterializedCompleted;
+    case CANCELLED:
+      return RuntimeInformation::cancelled;
+    default:
+      AD_CORRECTNESS_CHECK(state == FAILED);
+      return RuntimeInformation::failed;
+  }
+}
 }  // namespace
 
 //______________________________________________________________________________
@@ -120,6 +140,20 @@ void Operation::recursivelySetTimeConstraint(
   });
 }
 
+// _____________________________________________________________________________
+void Operation::recursivelySetExecutionContext(QueryExecutionContext* qec) {
+  AD_CONTRACT_CHECK(qec != nullptr);
+  _executionContext = qec;
+  _runtimeInfo = std::make_shared<RuntimeInformation>();
+  _rootRuntimeInfo = _runtimeInfo;
+  _runtimeInfoWholeQuery = RuntimeInformationWholeQuery{};
+  for (auto* child : getChildren()) {
+    if (child) {
+      child->recursivelySetExecutionContext(qec);
+    }
+  }
+}
+
 // _____________________________________________________________________________
 void Operation::updateRuntimeStats(bool applyToLimit, uint64_t numRows,
                                    uint64_t numCols,
@@ -151,8 +185,20 @@ Result Operation::runComputation(const ad_utility::Timer& timer,
   runtimeInfo().status_ =
       RuntimeInformation::Status::fullyMaterializedInProgress;
   signalQueryUpdate(RuntimeInformation::SendPriority::Always);
-  Result result =
-      computeResult(computationMode == ComputationMode::LAZY_IF_SUPPORTED);
+  auto cpuTimeAtStart = ad_utility::currentThreadCpuTime();
+  ad_utility::PeakMemoryUsageMeasurement peakMemoryUsage{
+      allocator().getMemoryLeft()};
+  Result result = [this, computationMode]() {
+    // For a lazy result, the span only contains the setup of the computation.
+    ad_utility::timer::TraceSpan span{
+        "operation", ad_utility::timer::SpanTracer::active() != nullptr
+                         ? getDescriptor()
+                         : std::string{}};
+    return computeResult(computationMode ==
+                         ComputationMode::LAZY_IF_SUPPORTED);
+  }();
+  runtimeInfo().cpuTime_ = ad_utility::currentThreadCpuTime() - cpuTimeAtStart;
+  runtimeInfo().peakMemoryUsage_ = peakMemoryUsage.stop();
   AD_CONTRACT_CHECK(computationMode == ComputationMode::LAZY_IF_SUPPORTED ||
                     result.isFullyMaterialized());
 
@@ -217,18 +263,7 @@ Result Operation::runComputation(const ad_utility::Timer& timer,
           signalQueryUpdate(RuntimeInformation::SendPriority::IfDue);
         },
         [this](Result::GeneratorState state) {
-          runtimeInfo().status_ = [state]() {
-            using enum Result::GeneratorState;
-            switch (state) {
-              case FINISHED:
-                return RuntimeInformation::lazilyMaterializedCompleted;
-              case CANCELLED:
-                return RuntimeInformation::cancelled;
-              default:
-                AD_CORRECTNESS_CHECK(state == FAILED);
-                return RuntimeInformation::failed;
-            }
-          }();
+          runtimeInfo().status_ = statusOfConsumedLazyResult(state);
           signalQueryUpdate(RuntimeInformation::SendPriority::Always);
         });
   }
@@ -258,12 +293,105 @@ Result Operation::runComputation(const ad_utility::Timer& timer,
   return result;
 }
 
+// _____________________________________________________________________________
+const QueryResultDiskCache* Operation::resultDiskCacheIfApplicable() const {
+  const auto* diskCache = _executionContext->resultDiskCache();
+  if (diskCache == nullptr || !canResultBeCached()) {
+    return nullptr;
+  }
+  // The cache keys only identify the delta triples within the current run of
+  // the engine, see `QueryResultDiskCache.h`. Each delta triple is contained
+  // in all the permutations, so it suffices to check one of them.
+  const auto& state = _executionContext->locatedTriplesState();
+  bool hasDeltaTriples =
+      state.getLocatedTriplesForPermutation<false>(Permutation::PSO)
+              .numTriples() > 0 ||
+      state.getLocatedTriplesForPermutation<true>(Permutation::PSO)
+              .numTriples() > 0;
+  return hasDeltaTriples ? nullptr : diskCache;
+}
+
+// _____________________________________________________________________________
+std::optional<Result> Operation::joinSharedLazyResult(
+    SharedLazyResults& sharedLazyResults, const QueryCacheKey& cacheKey) {
+  // If the shared result is lost before this operation has read any of it,
+  // the result is computed by this operation itself. Then the rows are
+  // already counted by `runComputation`.
+  auto isComputedHere = std::make_shared<bool>(false);
+  auto fallback = [this, isComputedHere]() {
+    *isComputedHere = true;
+    ad_utility::Timer timer{ad_utility::Timer::Started};
+    Result result = runComputation(timer, ComputationMode::LAZY_IF_SUPPORTED);
+    if (!result.isFullyMaterialized()) {
+      return result.idTables();
+    }
+    std::optional<Result::IdTableVocabPair> pair{
+        std::in_place, result.idTable().clone(), result.localVocab().clone()};
+    return Result::LazyResult{ad_utility::InputRangeFromGetCallable{
+        [pair = std::move(pair)]() mutable {
+          return std::exchange(pair, std::nullopt);
+        }}};
+  };
+  auto lazyResult = sharedLazyResults.join(cacheKey, std::move(fallback));
+  if (!lazyResult.has_value()) {
+    return std::nullopt;
+  }
+  auto& rti = runtimeInfo();
+  rti.status_ = RuntimeInformation::lazilyMaterializedInProgress;
+  rti.addDetail("shared-with-concurrent-query", true);
+  Result result{std::move(lazyResult).value(), getResultSortedOn()};
+  result.runOnNewChunkComputed(
+      [this, isComputedHere](const Result::IdTableVocabPair& pair,
+                             std::chrono::microseconds duration) {
+        if (!*isComputedHere) {
+          updateRuntimeStats(false, pair.idTable_.numRows(),
+                             pair.idTable_.numColumns(), duration);
+          signalQueryUpdate(RuntimeInformation::SendPriority::IfDue);
+        }
+      },
+      [this](Result::GeneratorState state) {
+        runtimeInfo().status_ = statusOfConsumedLazyResult(state);
+        signalQueryUpdate(RuntimeInformation::SendPriority::Always);
+      });
+  return result;
+}
+
 // _____________________________________________________________________________
 CacheValue Operation::runComputationAndPrepareForCache(
     const ad_utility::Timer& timer, ComputationMode computationMode,
     const QueryCacheKey& cacheKey, bool pinned, bool isRoot) {
   auto& cache = _executionContext->getQueryTreeCache();
+  // Identical queries that run at the same time share the lazy result of their
+  // root operation, see `SharedLazyResults.h`.
+  auto* sharedLazyResults = _executionContext->sharedLazyResults();
+  const auto maxReplaySize =
+      getRuntimeParameter<&RuntimeParameters::lazyResultSharingMaxSize_>();
+  const bool shareLazyResult =
+      isRoot && sharedLazyResults != nullptr && canResultBeCached() &&
+      computationMode == ComputationMode::LAZY_IF_SUPPORTED &&
+      maxReplaySize > 0_B;
+  if (shareLazyResult) {
+    if (auto result = joinSharedLazyResult(*sharedLazyResults, cacheKey)) {
+      return CacheValue{std::move(result).value(), runtimeInfo()};
+    }
+  }
+  const auto* diskCache = resultDiskCacheIfApplicable();
+  if (diskCache != nullptr) {
+    if (auto result = diskCache->load(cacheKey.key_, allocator())) {
+      runtimeInfo().addDetail("loaded-from-disk-cache", true);
+      return CacheValue{std::move(result).value(), runtimeInfo()};
+    }
+  }
   auto result = runComputation(timer, computationMode);
+  // Only the results of expensive computations are written to disk.
+  if (diskCache != nullptr && QueryResultDiskCache::canBeStored(result) &&
+      timer.msecs() >=
+          std::chrono::milliseconds{getRuntimeParameter<
+              &RuntimeParameters::resultCacheDiskMinComputationTime_>()}) {
+    diskCache->store(
+        cacheKey.key_, result,
+        getRuntimeParameter<&RuntimeParameters::resultCacheDiskMaxSize_>());
+  }
   auto maxSize =
       isRoot ? cache.getMaxSizeSingleEntry()
              : std::min(getRuntimeParameter<
@@ -287,10 +415,13 @@ CacheValue Operation::runComputationAndPrepareForCache(
          cacheKey](Result aggregatedResult) {
           auto copy = *runtimeInfo;
           copy.status_ = RuntimeInformation::Status::fullyMaterializedCompleted;
-          cache.tryInsertIfNotPresent(
-              false, cacheKey,
-              std::make_shared<CacheValue>(std::move(aggregatedResult),
-                                           std::move(copy)));
+          auto cacheValue = std::make_shared<CacheValue>(
+              std::move(aggregatedResult), std::move(copy));
+          if (getRuntimeParameter<
+                  &RuntimeParameters::compressCachedResults_>()) {
+            cacheValue->compress(false);
+          }
+          cache.tryInsertIfNotPresent(false, cacheKey, std::move(cacheValue));
         });
   }
   if (result.isFullyMaterialized()) {
@@ -298,9 +429,21 @@ CacheValue Operation::runComputationAndPrepareForCache(
     auto resultNumCols = result.idTable().numColumns();
     AD_LOG_DEBUG << "Computed result of size " << resultNumRows << " x "
                  << resultNumCols << std::endl;
+  } else if (shareLazyResult) {
+    auto sortedBy = result.sortedBy();
+    result = Result{
+        sharedLazyResults->share(cacheKey, result.idTables(), maxReplaySize),
+        std::move(sortedBy)};
   }
 
-  return CacheValue{std::move(result), runtimeInfo()};
+  CacheValue cacheValue{std::move(result), runtimeInfo()};
+  if (canResultBeCached() &&
+      getRuntimeParameter<&RuntimeParameters::compressCachedResults_>()) {
+    // The query that computed the result directly uses the uncompressed
+    // result.
+    cacheValue.compress(true);
+  }
+  return cacheValue;
 }
 
 // ________________________________________________________________________
@@ -323,8 +466,8 @@ std::shared_ptr<const Result> Operation::getResult(
     signalQueryUpdate(RuntimeInformation::SendPriority::Always);
   }
   auto& cache = _executionContext->getQueryTreeCache();
-  const QueryCacheKey cacheKey = {
-      getCacheKey(), _executionContext->locatedTriplesState().index_};
+  const QueryCacheKey cacheKey =
+      _executionContext->makeQueryCacheKey(getCacheKey());
   const bool pinFinalResultButNotSubtrees =
       _executionContext->_pinResult && isRoot;
   const bool pinResult =
@@ -370,7 +513,7 @@ std::shared_ptr<const Result> Operation::getResult(
     };
 
     auto suitedForCache = [](const CacheValue& cacheValue) {
-      return cacheValue.resultTable().isFullyMaterialized();
+      return cacheValue.isFullyMaterialized();
     };
 
     bool onlyReadFromCache = computationMode == ComputationMode::ONLY_IF_CACHED;
@@ -391,10 +534,10 @@ std::shared_ptr<const Result> Operation::getResult(
       return nullptr;
     }
 
-    if (result._resultPointer->resultTable().isFullyMaterialized()) {
+    auto resultPtr = result._resultPointer->resultTablePtr();
+    if (resultPtr->isFullyMaterialized()) {
       AD_CORRECTNESS_CHECK(
-          result._resultPointer->resultTable().idTable().numColumns() ==
-              getResultWidth(),
+          resultPtr->idTable().numColumns() == getResultWidth(),
           result._cacheStatus == ad_utility::CacheStatus::computed
               ? "This should never happen, non-matching result widths should "
                 "have been caught earlier"
@@ -406,10 +549,10 @@ std::shared_ptr<const Result> Operation::getResult(
 
     // Pin result to the named result cache if requested.
     if (pinResultWithName) {
-      storeToNamedResultCache(result._resultPointer->resultTable());
+      storeToNamedResultCache(*resultPtr);
     }
 
-    return result._resultPointer->resultTablePtr();
+    return resultPtr;
   } catch (ad_utility::CancellationException& e) {
     e.setOperation(getDescriptor());
     runtimeInfo().status_ = RuntimeInformation::Status::cancelled;
@@ -453,6 +596,32 @@ std::chrono::milliseconds Operation::remainingTime() const {
       0ms, std::chrono::duration_cast<std::chrono::milliseconds>(interval));
 }
 
+// _____________________________________________________________________________
+Result::LazyResult Operation::transformLazyResult(
+    Result::LazyResult input,
+    std::function<Result::IdTableVocabPair(Result::IdTableVocabPair&)>
+        transformation,
+    bool keepOrder) {
+  auto threads = std::make_shared<ad_utility::ThreadBudget::Reservation>(
+      ad_utility::globalThreadBudget().reserve(
+          getRuntimeParameter<&RuntimeParameters::lazyPipelineNumThreads_>()));
+  size_t numThreads = threads->numThreads();
+  if (numThreads <= 1) {
+    return Result::LazyResult{ad_utility::CachingTransformInputRange{
+        std::move(input), std::move(transformation)}};
+  }
+  // The threads stay reserved as long as the transformation exists, that is,
+  // as long as the lazy result is consumed.
+  transformation = [threads = std::move(threads),
+                    inner = std::move(transformation)](
+                       Result::IdTableVocabPair& pair) { return inner(pair); };
+  // Buffer a few blocks per thread, s.t. the workers don't have to wait for
+  // the consumer all the time.
+  return ad_utility::data_structures::parallelTransform(
+      std::move(input), std::move(transformation), numThreads, 2 * numThreads,
+      keepOrder);
+}
+
 // _____________________________________________________________________________
 void Operation::storeToNamedResultCache(const Result& result) {
   // The query result is to be pinned in the named query cache.
@@ -536,11 +705,11 @@ void Operation::updateRuntimeInformationOnSuccess(
 void Operation::updateRuntimeInformationOnSuccess(
     const QueryResultCache::ResultAndCacheStatus& resultAndCacheStatus,
     Milliseconds duration) {
-  const auto& result = resultAndCacheStatus._resultPointer->resultTable();
-  AD_CONTRACT_CHECK(result.isFullyMaterialized());
-  updateRuntimeInformationOnSuccess(
-      result.idTable().size(), resultAndCacheStatus._cacheStatus, duration,
-      resultAndCacheStatus._resultPointer->runtimeInfo());
+  const auto& cacheValue = *resultAndCacheStatus._resultPointer;
+  AD_CONTRACT_CHECK(cacheValue.isFullyMaterialized());
+  updateRuntimeInformationOnSuccess(cacheValue.numRows(),
+                                    resultAndCacheStatus._cacheStatus,
+                                    duration, cacheValue.runtimeInfo());
 }
 
 // _____________________________________________________________________________
@@ -629,7 +798,7 @@ void Operation::createRuntimeInfoFromEstimates(
   _runtimeInfo->multiplicityEstimates_ = multiplicityEstimates;
 
   auto cachedResult = _executionContext->getQueryTreeCache().getIfContained(
-      {getCacheKey(), locatedTriplesState().index_});
+      _executionContext->makeQueryCacheKey(getCacheKey()));
   if (cachedResult.has_value()) {
     const auto& [resultPointer, cacheStatus] = cachedResult.value();
     _runtimeInfo->cacheStatus_ = cacheStatus;
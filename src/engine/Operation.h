@@ -9,6 +9,7 @@
 #include <absl/cleanup/cleanup.h>
 #include <gtest/gtest_prod.h>
 
+#include <functional>
 #include <memory>
 
 #include "engine/QueryExecutionContext.h"
@@ -26,6 +27,7 @@
 // forward declaration needed to break dependencies
 class QueryExecutionTree;
 class ExternalValues;
+class RuntimeJoinFilter;
 namespace parsedQuery {
 struct Bind;
 }
@@ -302,6 +304,11 @@ class Operation {
   void recursivelySetTimeConstraint(
       std::chrono::steady_clock::time_point deadline);
 
+  // Let this operation and all its descendants use the given `qec` and reset
+  // their runtime information. This is used to execute a (cloned) query plan
+  // that was created for a different query, see `QueryPlanCache`.
+  void recursivelySetExecutionContext(QueryExecutionContext* qec);
+
   // Optimization for lazy operations where the very nature of the operation
   // makes it unlikely to ever fit in cache when completely materialized.
   virtual bool unlikelyToFitInCache(
@@ -431,6 +438,21 @@ class Operation {
     return std::nullopt;
   };
 
+  // Try to push the `filter` for the values of the `variable` (see
+  // `RuntimeJoinFilter.h`) down to an `IndexScan` in this subtree, which then
+  // only yields the rows whose value for the `variable` is one of the keys of
+  // the `filter`. Return true iff the filter was applied. This is only allowed
+  // if all rows that are filtered out are guaranteed to be removed afterwards
+  // anyway (typically by the join that created the `filter`), and must be
+  // called before the result of this operation is computed. Operations that
+  // apply a filter must no longer store their result in the cache, because
+  // it is in general incomplete. The default is to not apply the filter.
+  virtual bool addRuntimeJoinFilter(
+      [[maybe_unused]] const Variable& variable,
+      [[maybe_unused]] std::shared_ptr<const RuntimeJoinFilter> filter) {
+    return false;
+  }
+
  protected:
   // The QueryExecutionContext for this particular element.
   // No ownership.
@@ -457,6 +479,19 @@ class Operation {
 
   std::chrono::milliseconds remainingTime() const;
 
+  // Apply the `transformation` to all the blocks of the lazy `input`. If the
+  // runtime parameter `lazy-pipeline-num-threads` is greater than one, the
+  // blocks are transformed concurrently by that many threads (see
+  // `parallelTransform` in `ThreadSafeQueue.h`), so the `transformation` must
+  // not modify any shared state. If `keepOrder` is true, the transformed blocks
+  // are yielded in the order of the `input`, which is required if the result
+  // is sorted.
+  static Result::LazyResult transformLazyResult(
+      Result::LazyResult input,
+      std::function<Result::IdTableVocabPair(Result::IdTableVocabPair&)>
+          transformation,
+      bool keepOrder);
+
   /// Pointer to the cancellation handle of this operation.
   SharedCancellationHandle cancellationHandle_ =
       std::make_shared<SharedCancellationHandle::element_type>();
@@ -512,12 +547,23 @@ class Operation {
                         ComputationMode computationMode);
 
   // Call `runComputation` and transform it into a value that could be inserted
-  // into the cache.
+  // into the cache. The result is read from (or written to) the on-disk tier of
+  // the cache if applicable.
   CacheValue runComputationAndPrepareForCache(const ad_utility::Timer& timer,
                                               ComputationMode computationMode,
                                               const QueryCacheKey& cacheKey,
                                               bool pinned, bool isRoot);
 
+  // Return the on-disk tier of the cache if it can be used for the result of
+  // this operation, else `nullptr`.
+  const QueryResultDiskCache* resultDiskCacheIfApplicable() const;
+
+  // Return a result that reads the lazy result for the `cacheKey` that is
+  // currently computed by a concurrent query, or `std::nullopt` if there is no
+  // such result that can still be joined.
+  std::optional<Result> joinSharedLazyResult(
+      SharedLazyResults& sharedLazyResults, const QueryCacheKey& cacheKey);
+
   // Create and store the complete runtime information for this operation after
   // it has either been successfully computed or read from the cache.
   virtual void updateRuntimeInformationOnSuccess(
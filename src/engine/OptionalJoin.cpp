@@ -15,6 +15,7 @@
 #include "global/RuntimeParameters.h"
 #include "index/IdTableUtils.h"
 #include "util/Algorithm.h"
+#include "util/InputRangeUtils.h"
 #include "util/JoinAlgorithms/IndexNestedLoopJoin.h"
 #include "util/JoinAlgorithms/JoinAlgorithms.h"
 
@@ -174,6 +175,10 @@ Result OptionalJoin::computeResult(bool requestLaziness) {
 
   AD_LOG_DEBUG << "OptionalJoin subresult computation done." << std::endl;
 
+  if (auto res = tryJoinWithAtMostOneRightRow(leftResult, rightResult)) {
+    return std::move(res).value();
+  }
+
   if (!leftResult->isFullyMaterialized() ||
       !rightResult->isFullyMaterialized()) {
     return lazyOptionalJoin(std::move(leftResult), std::move(rightResult),
@@ -528,6 +533,115 @@ Result OptionalJoin::lazyOptionalJoin(std::shared_ptr<const Result> left,
   return createResultFromAction(requestLaziness, std::move(action),
                                 resultSortedOn(), std::move(resultPermutation));
 }
+// _____________________________________________________________________________
+std::optional<Result> OptionalJoin::tryJoinWithAtMostOneRightRow(
+    const std::shared_ptr<const Result>& left,
+    const std::shared_ptr<const Result>& right) {
+  if (!right->isFullyMaterialized() || right->idTable().numRows() > 1) {
+    return std::nullopt;
+  }
+  const auto& rightTable = right->idTable();
+  const bool rightIsEmpty = rightTable.empty();
+
+  // The join column `col` of the `left` result can't contain UNDEF values.
+  auto leftColumnIsAlwaysDefined = [&](ColumnIndex col) {
+    if (left->isFullyMaterialized()) {
+      return ql::ranges::none_of(left->idTable().getColumn(col),
+                                 &Id::isUndefined);
+    }
+    return ql::ranges::any_of(
+        _left->getVariableColumns() | ql::views::values,
+        [col](const ColumnIndexAndTypeInfo& info) {
+          return info.columnIndex_ == col &&
+                 info.mightContainUndef_ ==
+                     ColumnIndexAndTypeInfo::AlwaysDefined;
+        });
+  };
+  // The join columns in which the `left` rows have to match the right row,
+  // together with the corresponding value of the right row. An UNDEF value in
+  // the right row matches all the `left` rows.
+  std::vector<std::pair<ColumnIndex, Id>> columnsToMatch;
+  if (!rightIsEmpty) {
+    for (auto [leftCol, rightCol] : _joinColumns) {
+      Id rightValue = rightTable(0, rightCol);
+      if (rightValue.isUndefined()) {
+        continue;
+      }
+      if (!leftColumnIsAlwaysDefined(leftCol)) {
+        return std::nullopt;
+      }
+      columnsToMatch.emplace_back(leftCol, rightValue);
+    }
+  }
+  runtimeInfo().addDetail("right-has-at-most-one-row", true);
+
+  // The columns of the `left` result that are part of the result (in the
+  // order of the result) and the values for the remaining columns of the
+  // result if a row matches.
+  ad_utility::JoinColumnMapping joinColMap{
+      _joinColumns, _left->getResultWidth(), _right->getResultWidth(),
+      keepJoinColumns_};
+  const size_t numJoinColumns = _joinColumns.size();
+  std::vector<ColumnIndex> leftColumns;
+  if (keepJoinColumns_) {
+    ql::ranges::copy(ad_utility::integerRange(_left->getResultWidth()),
+                     std::back_inserter(leftColumns));
+  } else {
+    ql::ranges::copy(joinColMap.permutationLeft() |
+                         ql::views::drop(numJoinColumns),
+                     std::back_inserter(leftColumns));
+  }
+  std::vector<Id> rightValues;
+  for (auto col :
+       joinColMap.permutationRight() | ql::views::drop(numJoinColumns)) {
+    rightValues.push_back(rightIsEmpty ? Id::makeUndefined()
+                                       : rightTable(0, col));
+  }
+
+  auto extendBlock = [this, leftColumns = std::move(leftColumns),
+                      rightValues = std::move(rightValues),
+                      columnsToMatch = std::move(columnsToMatch),
+                      rightIsEmpty](const IdTable& block) {
+    IdTable result{getResultWidth(), allocator()};
+    result.resize(block.numRows());
+    for (size_t i = 0; i < leftColumns.size(); ++i) {
+      ql::ranges::copy(block.getColumn(leftColumns[i]),
+                       result.getColumn(i).begin());
+    }
+    std::vector<char> matches(block.numRows(), !rightIsEmpty);
+    for (auto [col, value] : columnsToMatch) {
+      decltype(auto) column = block.getColumn(col);
+      for (size_t row = 0; row < block.numRows(); ++row) {
+        matches[row] &= static_cast<char>(column[row] == value);
+      }
+    }
+    for (size_t i = 0; i < rightValues.size(); ++i) {
+      decltype(auto) column = result.getColumn(leftColumns.size() + i);
+      for (size_t row = 0; row < block.numRows(); ++row) {
+        column[row] = matches[row] ? rightValues[i] : Id::makeUndefined();
+      }
+    }
+    checkCancellation();
+    return result;
+  };
+
+  if (left->isFullyMaterialized()) {
+    return Result{extendBlock(left->idTable()), resultSortedOn(),
+                  Result::getMergedLocalVocab(*left, *right)};
+  }
+  return Result{
+      Result::LazyResult{ad_utility::CachingTransformInputRange{
+          left->idTables(),
+          [extendBlock = std::move(extendBlock),
+           rightLocalVocab = right->getCopyOfLocalVocab()](
+              Result::IdTableVocabPair& pair) {
+            pair.localVocab_.mergeWith(rightLocalVocab);
+            return Result::IdTableVocabPair{extendBlock(pair.idTable_),
+                                            std::move(pair.localVocab_)};
+          }}},
+      resultSortedOn()};
+}
+
 // _____________________________________________________________________________
 Result OptionalJoin::optionalJoinWithIndexScan(
     std::shared_ptr<const Result> left, std::shared_ptr<IndexScan> rightScan,
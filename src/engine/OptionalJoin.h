@@ -93,6 +93,17 @@ class OptionalJoin : public Operation {
                           std::shared_ptr<const Result> right,
                           bool requestLaziness);
 
+  // Compute the result if the `right` result is fully materialized and has at
+  // most one row: Each row of the `left` result is extended by the values of
+  // the right row if they are compatible, and by UNDEF values otherwise. This
+  // keeps the order of the `left` result, and a lazy `left` result is
+  // processed block by block. Return `std::nullopt` if the `right` result has
+  // more rows, or if a defined value in a join column of the right row could
+  // replace an UNDEF value of the `left` result.
+  std::optional<Result> tryJoinWithAtMostOneRightRow(
+      const std::shared_ptr<const Result>& left,
+      const std::shared_ptr<const Result>& right);
+
   // Compute the result for the result from the `left` subtree
   // and the `rightScan`. This function applied block prefiltering for the
   // `rightScan`. This function currently only supports single-column OPTIONAL
@@ -5,6 +5,9 @@
 
 #include "engine/OrderBy.h"
 
+#include <cmath>
+#include <limits>
+#include <optional>
 #include <sstream>
 
 #include "engine/CallFixedSize.h"
@@ -65,6 +68,9 @@ std::string OrderBy::getDescriptor() const {
 // _____________________________________________________________________________
 Result OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
   using std::endl;
+  if (getLimitOffset()._limit.has_value()) {
+    return computeTopK();
+  }
   AD_LOG_DEBUG << "Getting sub-result for OrderBy result computation..."
                << endl;
   std::shared_ptr<const Result> subRes = subtree_->getResult();
@@ -77,8 +83,108 @@ Result OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
 
   AD_LOG_DEBUG << "OrderBy result computation..." << endl;
   IdTable idTable = subRes->idTable().clone();
+  sortTable(idTable);
+  AD_LOG_DEBUG << "OrderBy result computation done." << endl;
+  return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
+}
+
+namespace {
+using Bits = Id::T;
+using RadixSortKey = IdTableUtils::RadixSortKey;
+constexpr Bits dataMask = ValueId::maxIndex;
+constexpr Bits dataSignBit = Bits{1} << (ValueId::numDataBits - 1);
+
+// The keys for the `Id`s of a single sort column, s.t. the (unsigned) order of
+// the keys is the order of `compareIds` with `CompareByType`. The datatype bits
+// are left untouched, so `Id`s of different datatypes are ordered by their
+// datatype. The sort columns that contain a single numeric datatype get the
+// `intKey` or `doubleKey`, the other sort columns are ordered by their bits.
+Bits bitsKey(Id id) { return id.getBits(); }
 
-  size_t width = idTable.numColumns();
+// Flip the sign bit of the two's complement representation of an `Int`.
+Bits intKey(Id id) {
+  Bits bits = id.getBits();
+  return id.getDatatype() == Datatype::Int ? bits ^ dataSignBit : bits;
+}
+
+// Flip the sign bit of positive and all bits of negative `Double`s. NaN is
+// larger than all other values (see `makeComparatorForNans`).
+Bits doubleKey(Id id) {
+  Bits bits = id.getBits();
+  if (id.getDatatype() != Datatype::Double) {
+    return bits;
+  }
+  Bits datatypeBits = bits & ~dataMask;
+  if (std::isnan(id.getDouble())) {
+    return datatypeBits | dataMask;
+  }
+  Bits data = bits & dataMask;
+  data = (data & dataSignBit) ? (~data & dataMask) : (data | dataSignBit);
+  return datatypeBits | data;
+}
+
+template <RadixSortKey key>
+Bits descendingKey(Id id) {
+  return ~key(id);
+}
+
+// Return the key function for a sort `column` (see above), or `std::nullopt` if
+// the order of the `column` cannot be expressed by the keys of the single
+// `Id`s. This is the case if it contains `LocalVocabIndex` entries (which are
+// ordered by their strings), dates, or numbers of different datatypes.
+std::optional<RadixSortKey> getOrderByKey(ql::span<const Id> column,
+                                          bool isDescending) {
+  uint32_t datatypes = 0;
+  for (Id id : column) {
+    datatypes |= uint32_t{1} << static_cast<int>(id.getDatatype());
+  }
+  auto contains = [datatypes](Datatype datatype) {
+    return (datatypes & (uint32_t{1} << static_cast<int>(datatype))) != 0;
+  };
+  using enum Datatype;
+  if (contains(LocalVocabIndex) || contains(Date) ||
+      (contains(Int) && contains(Double))) {
+    return std::nullopt;
+  }
+  if (contains(Int)) {
+    return isDescending ? &descendingKey<intKey> : &intKey;
+  } else if (contains(Double)) {
+    return isDescending ? &descendingKey<doubleKey> : &doubleKey;
+  }
+  return isDescending ? &descendingKey<bitsKey> : &bitsKey;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+bool OrderBy::tryRadixSort(IdTable& idTable) const {
+  if (idTable.numRows() < IdTableUtils::minNumRowsForRadixSort ||
+      sortIndices_.size() > 3) {
+    return false;
+  }
+  std::vector<ColumnIndex> sortCols;
+  std::vector<RadixSortKey> keyFunctions;
+  for (const auto& [column, isDescending] : sortIndices_) {
+    auto keyFunction = getOrderByKey(idTable.getColumn(column), isDescending);
+    if (!keyFunction.has_value()) {
+      return false;
+    }
+    sortCols.push_back(column);
+    keyFunctions.push_back(keyFunction.value());
+  }
+  IdTableUtils::radixSort(idTable, sortCols, keyFunctions);
+  return true;
+}
+
+// _____________________________________________________________________________
+void OrderBy::sortTable(IdTable& idTable) {
+  // Large tables, the sort columns of which can be ordered by keys of the
+  // single `Id`s, are sorted via a parallel radix sort by these keys.
+  if (tryRadixSort(idTable)) {
+    runtimeInfo().addDetail("is-radix-sort", true);
+    cancellationHandle_->resetWatchDogState();
+    checkCancellation();
+    return;
+  }
 
   // TODO<joka921> Measure (as soon as we have the benchmark merged)
   // whether it is beneficial to manually instantiate the comparison when
@@ -120,14 +226,71 @@ Result OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
   // We cannot use the `CALL_FIXED_SIZE` macro here because the `sort` function
   // is templated not only on the integer `I` (which the `callFixedSize`
   // function deals with) but also on the `comparison`.
-  ad_utility::callFixedSizeVi(width, [&idTable, &comparison](auto I) {
-    IdTableUtils::sort<I>(&idTable, comparison);
-  });
+  ad_utility::callFixedSizeVi(idTable.numColumns(),
+                              [&idTable, &comparison](auto I) {
+                                IdTableUtils::sort<I>(&idTable, comparison);
+                              });
   // We can't check during sort, so reset status here
   cancellationHandle_->resetWatchDogState();
   checkCancellation();
-  AD_LOG_DEBUG << "OrderBy result computation done." << endl;
-  return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
+}
+
+// _____________________________________________________________________________
+Result OrderBy::computeTopK() {
+  const auto& limitOffset = getLimitOffset();
+  // The number of rows that have to be kept to apply the `LIMIT` and `OFFSET`
+  // after sorting.
+  const uint64_t k =
+      limitOffset.upperBound(std::numeric_limits<uint64_t>::max());
+  runtimeInfo().addDetail("top-k", k);
+  if (k == 0) {
+    return {IdTable{getResultWidth(), allocator()}, resultSortedOn(),
+            LocalVocab{}};
+  }
+
+  // The candidates for the top `k` rows. Whenever the buffer contains at least
+  // `2k` rows, it is sorted and truncated to `k` rows. This requires `O(k)`
+  // memory and `O(n log k)` time (each sort of `2k` rows removes `k` rows).
+  IdTable buffer{getResultWidth(), allocator()};
+  const uint64_t maxBufferSize =
+      k > std::numeric_limits<uint64_t>::max() / 2 ? k : 2 * k;
+  auto sortAndTruncate = [this, &buffer, k]() {
+    sortTable(buffer);
+    if (buffer.numRows() > k) {
+      buffer.resize(k);
+    }
+  };
+  auto addBlock = [&](const IdTable& block) {
+    for (size_t begin = 0; begin < block.numRows();) {
+      size_t end = std::min<uint64_t>(
+          block.numRows(), begin + (maxBufferSize - buffer.numRows()));
+      buffer.insertAtEnd(block, begin, end);
+      begin = end;
+      if (buffer.numRows() >= maxBufferSize) {
+        sortAndTruncate();
+      }
+    }
+    checkCancellation();
+  };
+
+  std::shared_ptr<const Result> subRes = subtree_->getResult(true);
+  LocalVocab localVocab;
+  if (subRes->isFullyMaterialized()) {
+    addBlock(subRes->idTable());
+    localVocab = subRes->getCopyOfLocalVocab();
+  } else {
+    for (auto& pair : subRes->idTables()) {
+      addBlock(pair.idTable_);
+      localVocab.mergeWith(pair.localVocab_);
+    }
+  }
+  sortAndTruncate();
+
+  // Apply the `OFFSET`, the `LIMIT` has already been applied by the
+  // truncation.
+  size_t offset = limitOffset.actualOffset(buffer.numRows());
+  buffer.erase(buffer.begin(), buffer.begin() + offset);
+  return {std::move(buffer), resultSortedOn(), std::move(localVocab)};
 }
 
 // ___________________________________________________________________
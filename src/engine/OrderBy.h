@@ -63,9 +63,11 @@ class OrderBy : public Operation {
 
   size_t getCostEstimate() override {
     size_t size = getSizeEstimateBeforeLimit();
+    // With a `LIMIT`, only the top `k` rows have to be kept sorted (see
+    // `computeTopK`), which results in `n * log(k)` comparisons.
+    size_t k = getLimitOffset().upperBound(size);
     size_t logSize = std::max(
-        size_t(1), static_cast<size_t>(logb(
-                       static_cast<double>(getSizeEstimateBeforeLimit()))));
+        size_t(1), static_cast<size_t>(logb(static_cast<double>(k))));
     size_t nlogn = size * logSize;
     size_t subcost = subtree_->getCostEstimate();
     return nlogn + subcost;
@@ -73,6 +75,13 @@ class OrderBy : public Operation {
 
   bool knownEmptyResult() override { return subtree_->knownEmptyResult(); }
 
+  // An `ORDER BY` with a `LIMIT` only keeps the top `LIMIT + OFFSET` rows
+  // while consuming its input (see `computeTopK`). The `LIMIT` must not be
+  // propagated to the subtree, because all of its rows have to be considered.
+  LimitOffsetHandling handlesLimitOffset() const override {
+    return LimitOffsetHandling::FULL;
+  }
+
   size_t getResultWidth() const override;
 
   std::vector<QueryExecutionTree*> getChildren() override {
@@ -84,6 +93,20 @@ class OrderBy : public Operation {
 
   Result computeResult([[maybe_unused]] bool requestLaziness) override;
 
+  // Compute the result if a `LIMIT` is specified. The (possibly lazy) input is
+  // consumed block by block and only the top `LIMIT + OFFSET` rows are kept,
+  // s.t. the memory usage is proportional to the `LIMIT` and not to the size
+  // of the input.
+  Result computeTopK();
+
+  // Sort the `idTable` according to the `sortIndices_`.
+  void sortTable(IdTable& idTable);
+
+  // Sort the `idTable` via `IdTableUtils::radixSort` if it is large enough and
+  // the order of each of the sort columns can be expressed by a key of the
+  // single `Id`s. Return false (and leave the `idTable` unchanged) otherwise.
+  bool tryRadixSort(IdTable& idTable) const;
+
   VariableToColumnMap computeVariableToColumnMap() const override {
     return subtree_->getVariableColumns();
   }
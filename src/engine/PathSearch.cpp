@@ -4,6 +4,8 @@
 
 #include "engine/PathSearch.h"
 
+#include <atomic>
+#include <future>
 #include <optional>
 #include <unordered_map>
 #include <variant>
@@ -15,8 +17,11 @@
 #include "engine/CallFixedSize.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/VariableToColumnMap.h"
+#include "global/RuntimeParameters.h"
 #include "util/Algorithm.h"
 #include "util/AllocatorWithLimit.h"
+#include "util/ParallelExecutor.h"
+#include "util/ThreadBudget.h"
 
 using namespace pathSearch;
 
@@ -61,6 +66,18 @@ std::vector<Id> BinSearchWrapper::getEdgeProperties(const Edge& edge) const {
   return edgeProperties;
 }
 
+// _____________________________________________________________________________
+ReverseEdges BinSearchWrapper::getReverseEdges(
+    const ad_utility::AllocatorWithLimit<Id>& allocator) const {
+  ReverseEdges reverseEdges{allocator};
+  reverseEdges.reserve(table_.numRows());
+  for (size_t row = 0; row < table_.numRows(); row++) {
+    reverseEdges.emplace_back(table_(row, endCol_), table_(row, startCol_));
+  }
+  ql::ranges::sort(reverseEdges);
+  return reverseEdges;
+}
+
 // _____________________________________________________________________________
 Edge BinSearchWrapper::makeEdgeFromRow(size_t row) const {
   Edge edge;
@@ -332,7 +349,12 @@ PathSearch::handleSearchSides() const {
 PathsLimited PathSearch::findPaths(
     const Id& source, const std::unordered_set<uint64_t>& targets,
     const BinSearchWrapper& binSearch,
-    std::optional<uint64_t> numPathsPerTarget) const {
+    std::optional<uint64_t> numPathsPerTarget,
+    const NodeSet* nodesReachingTargets) const {
+  auto canReachTarget = [nodesReachingTargets](const Edge& edge) {
+    return nodesReachingTargets == nullptr ||
+           ad_utility::contains(*nodesReachingTargets, edge.end_.getBits());
+  };
   std::vector<Edge> edgeStack;
   Path currentPath{EdgesLimited(allocator())};
   std::unordered_map<
@@ -346,7 +368,9 @@ PathsLimited PathSearch::findPaths(
 
   visited.insert(source.getBits());
   for (auto edge : binSearch.outgoingEdes(source)) {
-    edgeStack.push_back(std::move(edge));
+    if (canReachTarget(edge)) {
+      edgeStack.push_back(std::move(edge));
+    }
   }
 
   while (!edgeStack.empty()) {
@@ -377,7 +401,8 @@ PathsLimited PathSearch::findPaths(
     }
 
     for (const auto& outgoingEdge : binSearch.outgoingEdes(edge.end_)) {
-      if (!ad_utility::contains(visited, outgoingEdge.end_.getBits())) {
+      if (!ad_utility::contains(visited, outgoingEdge.end_.getBits()) &&
+          canReachTarget(outgoingEdge)) {
         edgeStack.push_back(outgoingEdge);
       }
     }
@@ -386,32 +411,106 @@ PathsLimited PathSearch::findPaths(
   return result;
 }
 
+// _____________________________________________________________________________
+NodeSet PathSearch::findNodesReachingTargets(
+    ql::span<const Id> targets, const ReverseEdges& reverseEdges) const {
+  NodeSet result{allocator()};
+  std::vector<Id> queue;
+  for (auto target : targets) {
+    if (result.insert(target.getBits()).second) {
+      queue.push_back(target);
+    }
+  }
+  auto getEnd = [](const std::pair<Id, Id>& edge) { return edge.first; };
+  for (size_t next = 0; next < queue.size(); next++) {
+    checkCancellation();
+    auto incoming =
+        ql::ranges::equal_range(reverseEdges, queue[next], {}, getEnd);
+    for (const auto& edge : incoming) {
+      if (result.insert(edge.second.getBits()).second) {
+        queue.push_back(edge.second);
+      }
+    }
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 PathsLimited PathSearch::allPaths(
     ql::span<const Id> sources, ql::span<const Id> targets,
     const BinSearchWrapper& binSearch, bool cartesian,
     std::optional<uint64_t> numPathsPerTarget) const {
-  PathsLimited paths{allocator()};
-  Path path{EdgesLimited(allocator())};
+  bool pairwise = !cartesian && sources.size() == targets.size();
+  // Searching backwards from the targets requires the edges in reverse
+  // direction, which we only compute if there are targets.
+  ReverseEdges reverseEdges{allocator()};
+  if (!targets.empty()) {
+    reverseEdges = binSearch.getReverseEdges(allocator());
+  }
 
-  if (cartesian || sources.size() != targets.size()) {
-    std::unordered_set<uint64_t> targetSet;
+  std::unordered_set<uint64_t> targetSet;
+  std::optional<NodeSet> nodesReachingTargets;
+  if (!pairwise) {
     for (auto target : targets) {
       targetSet.insert(target.getBits());
     }
-    for (auto source : sources) {
-      for (const auto& path :
-           findPaths(source, targetSet, binSearch, numPathsPerTarget)) {
-        paths.push_back(path);
-      }
+    if (!targets.empty()) {
+      nodesReachingTargets = findNodesReachingTargets(targets, reverseEdges);
     }
-  } else {
+  }
+
+  std::vector<PathsLimited> pathsPerSource(sources.size(),
+                                           PathsLimited{allocator()});
+  auto search = [&](size_t i) {
+    if (!pairwise) {
+      pathsPerSource[i] = findPaths(
+          sources[i], targetSet, binSearch, numPathsPerTarget,
+          nodesReachingTargets.has_value() ? &nodesReachingTargets.value()
+                                           : nullptr);
+      return;
+    }
+    auto target = targets.subspan(i, 1);
+    NodeSet nodesReachingTarget =
+        findNodesReachingTargets(target, reverseEdges);
+    pathsPerSource[i] =
+        findPaths(sources[i], {target.front().getBits()}, binSearch,
+                  numPathsPerTarget, &nodesReachingTarget);
+  };
+
+  auto threads = ad_utility::globalThreadBudget().reserve(std::min(
+      sources.size(),
+      getRuntimeParameter<&RuntimeParameters::pathSearchNumThreads_>()));
+  size_t numThreads = threads.numThreads();
+  if (numThreads <= 1) {
     for (size_t i = 0; i < sources.size(); i++) {
-      for (const auto& path : findPaths(sources[i], {targets[i].getBits()},
-                                        binSearch, numPathsPerTarget)) {
-        paths.push_back(path);
-      }
+      search(i);
+    }
+  } else {
+    runtimeInfo().addDetail("Number of threads", numThreads);
+    // Each thread repeatedly takes the next source that hasn't been searched
+    // yet, which balances the load if some sources have many more paths than
+    // others.
+    std::atomic<size_t> nextSource = 0;
+    std::vector<std::packaged_task<void()>> threads;
+    for (size_t t = 0; t < numThreads; t++) {
+      threads.emplace_back([&search, &nextSource, &sources]() {
+        try {
+          for (size_t i = nextSource++; i < sources.size(); i = nextSource++) {
+            search(i);
+          }
+        } catch (...) {
+          // Make the other threads stop as soon as possible.
+          nextSource = sources.size();
+          throw;
+        }
+      });
     }
+    ad_utility::runTasksInParallel(std::move(threads));
+  }
+
+  PathsLimited paths{allocator()};
+  for (auto& pathsOfSource : pathsPerSource) {
+    ql::ranges::move(pathsOfSource, std::back_inserter(paths));
   }
   return paths;
 }
@@ -7,6 +7,8 @@
 
 #include <memory>
 #include <optional>
+#include <unordered_set>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -50,6 +52,17 @@ struct Path {
 
 using PathsLimited = std::vector<Path, ad_utility::AllocatorWithLimit<Path>>;
 
+// All edges of the graph as `(end, start)` pairs, sorted by the end node. Used
+// to search the graph backwards, starting from the targets.
+using ReverseEdges =
+    std::vector<std::pair<Id, Id>,
+                ad_utility::AllocatorWithLimit<std::pair<Id, Id>>>;
+
+// A set of nodes, represented by the bits of their `Id`s.
+using NodeSet =
+    std::unordered_set<uint64_t, std::hash<uint64_t>, std::equal_to<uint64_t>,
+                       ad_utility::AllocatorWithLimit<uint64_t>>;
+
 /**
  * @class BinSearchWrapper
  * @brief Encapsulates logic for binary search of edges in
@@ -84,6 +97,12 @@ class BinSearchWrapper {
 
   std::vector<Id> getEdgeProperties(const Edge& edge) const;
 
+  /**
+   * @brief Returns all edges in reverse direction, sorted by their end node.
+   */
+  ReverseEdges getReverseEdges(
+      const ad_utility::AllocatorWithLimit<Id>& allocator) const;
+
  private:
   Edge makeEdgeFromRow(size_t row) const;
 };
@@ -260,16 +279,34 @@ class PathSearch : public Operation {
 
   /**
    * @brief Finds paths based on the configured algorithm.
+   * @param nodesReachingTargets If not `nullptr`, only nodes from this set are
+   * visited. All other nodes can't be part of a path to one of the `targets`.
    * @return A vector of paths.
    */
   pathSearch::PathsLimited findPaths(
       const Id& source, const std::unordered_set<uint64_t>& targets,
       const pathSearch::BinSearchWrapper& binSearch,
-      std::optional<uint64_t> numPathsPerTarget) const;
+      std::optional<uint64_t> numPathsPerTarget,
+      const pathSearch::NodeSet* nodesReachingTargets) const;
+
+  /**
+   * @brief Finds all nodes from which at least one of the `targets` can be
+   * reached (including the targets themselves) by a breadth-first search
+   * that follows the `reverseEdges` backwards from the targets.
+   */
+  pathSearch::NodeSet findNodesReachingTargets(
+      ql::span<const Id> targets,
+      const pathSearch::ReverseEdges& reverseEdges) const;
 
   /**
    * @brief Finds all paths in the graph.
-   * @return A vector of all paths.
+   *
+   * If targets are given, the search from the sources is restricted to the
+   * nodes from which a target can be reached, which are determined first by a
+   * backward search from the targets. The searches from the different sources
+   * are independent and run in parallel, the number of threads is given by
+   * the runtime parameter `path-search-num-threads`.
+   * @return A vector of all paths, ordered by their source.
    */
   pathSearch::PathsLimited allPaths(
       ql::span<const Id> sources, ql::span<const Id> targets,
@@ -66,12 +66,66 @@ void QueryExecutionContext::signalQueryUpdate(
     // would be more intuitive), because it would overflow in the first step.
     // The current code only overflows if we are near the end of (representable)
     // time.
-    return (lastWebsocketUpdate_ + websocketUpdateInterval()) <= now;
+    auto interval = std::max<std::chrono::steady_clock::duration>(
+        websocketUpdateInterval_,
+        minIntervalPerSerializationTime * lastWebsocketUpdateDuration_);
+    return (lastWebsocketUpdate_ + interval) <= now;
   };
 
   if (sendPriority == RuntimeInformation::SendPriority::Always ||
       enoughTimeSinceLastUpdate()) {
     lastWebsocketUpdate_ = now;
     updateCallback_(nlohmann::ordered_json(runtimeInformation).dump());
+    lastWebsocketUpdateDuration_ = std::chrono::steady_clock::now() - now;
   }
 }
+
+// _____________________________________________________________________________
+void CacheValue::compress(bool keepUncompressedUntilFirstUse) {
+  if (isCompressed() || !result_->isFullyMaterialized()) {
+    return;
+  }
+  const auto& idTable = result_->idTable();
+  CompressedIdTable compressedTable{idTable};
+  if (compressedTable.size() >= getSize(idTable)) {
+    return;
+  }
+  compressed_.reset(new Compressed{
+      std::move(compressedTable),
+      Result{IdTable{idTable.numColumns(), idTable.getAllocator()},
+             result_->sortedBy(), result_->getSharedLocalVocab()}});
+  compressed_->uncompressed_ = result_;
+  if (keepUncompressedUntilFirstUse) {
+    compressed_->keptUntilFirstUse_ = std::move(result_);
+  }
+  result_.reset();
+}
+
+// _____________________________________________________________________________
+size_t CacheValue::numRows() const {
+  AD_CONTRACT_CHECK(isFullyMaterialized());
+  return isCompressed() ? compressed_->idTable_.numRows()
+                        : result_->idTable().numRows();
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const Result> CacheValue::resultTablePtr() const {
+  if (!isCompressed()) {
+    return result_;
+  }
+  // The lock also makes sure that a result that is requested by several
+  // queries at the same time is only decompressed once.
+  std::lock_guard lock{compressed_->mutex_};
+  if (compressed_->keptUntilFirstUse_ != nullptr) {
+    return std::exchange(compressed_->keptUntilFirstUse_, nullptr);
+  }
+  if (auto uncompressed = compressed_->uncompressed_.lock()) {
+    return uncompressed;
+  }
+  const auto& metadata = compressed_->metadata_;
+  auto uncompressed = std::make_shared<const Result>(
+      compressed_->idTable_.decompress(), metadata.sortedBy(),
+      metadata.getSharedLocalVocab());
+  compressed_->uncompressed_ = uncompressed;
+  return uncompressed;
+}
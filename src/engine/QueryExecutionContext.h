@@ -6,30 +6,51 @@
 #ifndef QLEVER_SRC_ENGINE_QUERYEXECUTIONCONTEXT_H
 #define QLEVER_SRC_ENGINE_QUERYEXECUTIONCONTEXT_H
 
+#include <absl/hash/hash.h>
 #include <gtest/gtest_prod.h>
 
+#include <array>
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 
 #include "backports/three_way_comparison.h"
 #include "engine/QueryPlanningCostFactors.h"
 #include "engine/Result.h"
 #include "engine/RuntimeInformation.h"
 #include "engine/SortPerformanceEstimator.h"
+#include "engine/idTable/CompressedIdTable.h"
 #include "global/Id.h"
 #include "index/DeltaTriples.h"
 #include "index/Index.h"
+#include "index/VocabDecodeCache.h"
 #include "util/Cache.h"
 #include "util/ConcurrentCache.h"
 
 // The value of the `QueryResultCache` below. It consists of a `Result` together
-// with its `RuntimeInfo`.
+// with its `RuntimeInfo`. A fully materialized result can optionally be
+// compressed (see `compress` below) to fit more results into the cache.
 class CacheValue {
  private:
   std::shared_ptr<Result> result_;
   RuntimeInformation runtimeInfo_;
 
+  // The state of a compressed value.
+  struct Compressed {
+    CompressedIdTable idTable_;
+    // A `Result` with an empty `IdTable` (with the same number of columns)
+    // that stores the `sortedBy` and the local vocab of the original result.
+    Result metadata_;
+    std::mutex mutex_;
+    // The uncompressed result as long as it is used outside the cache.
+    std::weak_ptr<const Result> uncompressed_;
+    // See `compress(keepUncompressedUntilFirstUse)` below.
+    std::shared_ptr<const Result> keptUntilFirstUse_;
+  };
+  std::unique_ptr<Compressed> compressed_;
+
  public:
   explicit CacheValue(Result result, RuntimeInformation runtimeInfo)
       : result_{std::make_shared<Result>(std::move(result))},
@@ -40,12 +61,34 @@ class CacheValue {
   CacheValue& operator=(CacheValue&&) = default;
   CacheValue& operator=(const CacheValue&) = delete;
 
-  const Result& resultTable() const noexcept { return *result_; }
+  // Compress the result if it is fully materialized and the compressed
+  // representation is smaller. Afterward, only the compressed representation
+  // is owned by the cache, and the result is decompressed again when it is
+  // requested via `resultTablePtr` and isn't used elsewhere at that time. If
+  // `keepUncompressedUntilFirstUse` is true, the uncompressed result is kept
+  // until the first call to `resultTablePtr` (for the query that computed the
+  // result).
+  void compress(bool keepUncompressedUntilFirstUse);
 
-  std::shared_ptr<const Result> resultTablePtr() const noexcept {
-    return result_;
+  bool isCompressed() const { return compressed_ != nullptr; }
+
+  bool isFullyMaterialized() const {
+    return isCompressed() || result_->isFullyMaterialized();
   }
 
+  // The number of rows of a fully materialized result.
+  size_t numRows() const;
+
+  // Access the result, which must not be compressed. Use `resultTablePtr` for
+  // values that might be compressed.
+  const Result& resultTable() const {
+    AD_CONTRACT_CHECK(!isCompressed());
+    return *result_;
+  }
+
+  // Return the result, decompress it if necessary.
+  std::shared_ptr<const Result> resultTablePtr() const;
+
   const RuntimeInformation& runtimeInfo() const noexcept {
     return runtimeInfo_;
   }
@@ -58,13 +101,26 @@ class CacheValue {
   // Calculates the `MemorySize` taken up by an instance of `CacheValue`.
   struct SizeGetter {
     ad_utility::MemorySize operator()(const CacheValue& cacheValue) const {
-      if (const auto& resultPtr = cacheValue.result_; resultPtr) {
+      if (cacheValue.isCompressed()) {
+        return cacheValue.compressed_->idTable_.size();
+      } else if (const auto& resultPtr = cacheValue.result_; resultPtr) {
         return getSize(resultPtr->idTable());
       } else {
         return 0_B;
       }
     }
   };
+
+  // The cost of recomputing the `CacheValue`, which is the time (in
+  // milliseconds) that it took to compute it. Used for the eviction policy of
+  // the `QueryResultCache`.
+  struct CostGetter {
+    double operator()(const CacheValue& cacheValue) const {
+      return std::chrono::duration<double, std::milli>{
+          cacheValue.runtimeInfo().totalTime_}
+          .count();
+    }
+  };
 };
 
 // The key for the `QueryResultCache` below. It consists of a `string` (the
@@ -73,28 +129,60 @@ class CacheValue {
 // That way, two identical trees with different snapshot indices will have a
 // different cache key. This has the (desired!) effect that UPDATE requests
 // correctly invalidate preexisting cache results.
+//
+// The string keys of large queries can be several KB long. To make hashing and
+// comparing the keys cheap (which happens several times for each lookup in the
+// cache), a 128-bit fingerprint of the string is computed once on
+// construction, and only the fingerprint is used for hashing and comparison.
+// The string itself is kept for debugging output and for the on-disk cache.
 struct QueryCacheKey {
+  using Fingerprint = std::array<uint64_t, 2>;
   std::string key_;
   size_t locatedTriplesSnapshotIndex_;
+  Fingerprint fingerprint_;
+
+  // The `indexInstanceId` distinguishes the results for different indices in
+  // a cache that is shared between them (see `Index::getInstanceId`).
+  QueryCacheKey(std::string key, size_t locatedTriplesSnapshotIndex,
+                uint64_t indexInstanceId = 0)
+      : key_{std::move(key)},
+        locatedTriplesSnapshotIndex_{locatedTriplesSnapshotIndex},
+        fingerprint_{computeFingerprint(key_, indexInstanceId)} {}
+
+  // Two (seeded) 64-bit hashes of the `key` and the `indexInstanceId`, which
+  // together are collision-free for all practical purposes.
+  static Fingerprint computeFingerprint(std::string_view key,
+                                        uint64_t indexInstanceId = 0) {
+    return {absl::HashOf(key, indexInstanceId),
+            absl::HashOf(key, indexInstanceId, uint64_t{0x9e3779b97f4a7c15})};
+  }
 
-  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(QueryCacheKey, key_,
+  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(QueryCacheKey, fingerprint_,
                                               locatedTriplesSnapshotIndex_)
 
   template <typename H>
   friend H AbslHashValue(H h, const QueryCacheKey& key) {
-    return H::combine(std::move(h), key.key_, key.locatedTriplesSnapshotIndex_);
+    return H::combine(std::move(h), key.fingerprint_[0],
+                      key.locatedTriplesSnapshotIndex_);
   }
 };
 
 // Threadsafe LRU cache for (partial) query results, that
 // checks on insertion, if the result is currently being computed
 // by another query.
-using QueryResultCache = ad_utility::ConcurrentCache<
-    ad_utility::LRUCache<QueryCacheKey, CacheValue, CacheValue::SizeGetter>>;
+using QueryResultCache =
+    ad_utility::ConcurrentCache<ad_utility::GDSFCache<QueryCacheKey, CacheValue,
+                                                      CacheValue::SizeGetter,
+                                                      CacheValue::CostGetter>>;
 
 // Forward declaration because of cyclic dependency
 class NamedResultCache;
+class QueryResultDiskCache;
+class SharedLazyResults;
 class MaterializedViewsManager;
+namespace ad_utility::timer {
+class SpanTracer;
+}
 
 // Execution context for queries. Holds a `std::shared_ptr` to the `Index`
 // and `MaterializedViewsManager` to ensure that they stay alive as long as
@@ -123,6 +211,14 @@ class QueryExecutionContext
     return *locatedTriplesSharedState_;
   }
 
+  // Return the key for the result with the given `cacheKey` in the
+  // `getQueryTreeCache()`, which depends on the current located triples and the
+  // index (the cache can be shared between several indices).
+  QueryCacheKey makeQueryCacheKey(std::string cacheKey) const {
+    return {std::move(cacheKey), locatedTriplesState().index_,
+            getIndex().getInstanceId()};
+  }
+
   LocatedTriplesSharedState locatedTriplesSharedState() const {
     return locatedTriplesSharedState_;
   }
@@ -152,14 +248,23 @@ class QueryExecutionContext
     return _costFactors.getCostFactor(key);
   };
 
+  QueryPlanningCostFactors& getCostFactors() { return _costFactors; }
+
   const ad_utility::AllocatorWithLimit<Id>& getAllocator() const {
     return _allocator;
   }
 
+  // The cache of the vocabulary words that are decoded by the query that is
+  // executed with this context, see `VocabDecodeCache.h`.
+  VocabDecodeCache& vocabDecodeCache() const { return *vocabDecodeCache_; }
+
   // Serialize the given `runtimeInformation` to a JSON string and send it
   // using `updateCallback_`. If `sendPriority` is set to `IfDue`, this only
   // happens if the last update was sent more than `websocketUpdateInterval_`
-  // ago; if it is set to `Always`, the update is always sent.
+  // ago; if it is set to `Always`, the update is always sent. For large query
+  // plans, the interval is increased such that the serialization takes at most
+  // a small fraction of the time of the query (see
+  // `minIntervalPerSerializationTime`).
   void signalQueryUpdate(const RuntimeInformation& runtimeInformation,
                          RuntimeInformation::SendPriority sendPriority) const;
 
@@ -185,6 +290,35 @@ class QueryExecutionContext
   // Access the cache for explicitly named query.
   NamedResultCache& namedResultCache() { return *namedResultCache_; }
 
+  // The optional on-disk tier of the query result cache (`nullptr` if there is
+  // none), see `QueryResultDiskCache.h`.
+  const QueryResultDiskCache* resultDiskCache() const {
+    return resultDiskCache_.get();
+  }
+  void setResultDiskCache(
+      std::shared_ptr<const QueryResultDiskCache> resultDiskCache) {
+    resultDiskCache_ = std::move(resultDiskCache);
+  }
+
+  // The lazy results that are shared between concurrent queries (`nullptr` if
+  // there is no sharing), see `SharedLazyResults.h`.
+  SharedLazyResults* sharedLazyResults() const {
+    return sharedLazyResults_.get();
+  }
+  void setSharedLazyResults(
+      std::shared_ptr<SharedLazyResults> sharedLazyResults) {
+    sharedLazyResults_ = std::move(sharedLazyResults);
+  }
+
+  // The tracer of the query that is executed using this context, `nullptr` if
+  // the query is not traced (see `SpanTracer.h`).
+  const std::shared_ptr<ad_utility::timer::SpanTracer>& spanTracer() const {
+    return spanTracer_;
+  }
+  void setSpanTracer(std::shared_ptr<ad_utility::timer::SpanTracer> tracer) {
+    spanTracer_ = std::move(tracer);
+  }
+
   // Get a reference to the `MaterializedViewsManager`.
   const MaterializedViewsManager& materializedViewsManager() const {
     return *materializedViewsManager_;
@@ -228,6 +362,8 @@ class QueryExecutionContext
   QueryResultCache* const _subtreeCache;
   // allocators are copied but hold shared state
   ad_utility::AllocatorWithLimit<Id> _allocator;
+  std::unique_ptr<VocabDecodeCache> vocabDecodeCache_ =
+      VocabDecodeCache::makeFromRuntimeParameter();
   QueryPlanningCostFactors _costFactors;
   SortPerformanceEstimator _sortPerformanceEstimator;
   std::function<void(std::string)> updateCallback_;
@@ -241,6 +377,11 @@ class QueryExecutionContext
   // value during query execution.
   bool areWebsocketUpdatesEnabled_ = areWebSocketUpdatesEnabled();
 
+  // If true, the binary export of the result transfers the IDs of the
+  // vocabulary as is, because the receiver uses the same vocabulary (see
+  // `BinaryExport.h`).
+  bool binaryExportKeepsVocabIds_ = false;
+
  private:
   // Store the value of the `websocketUpdateInterval` runtime parameter, for
   // the same reasons as above.
@@ -250,6 +391,11 @@ class QueryExecutionContext
   // The cache for named results.
   NamedResultCache* namedResultCache_;
 
+  // See `resultDiskCache()` above.
+  std::shared_ptr<const QueryResultDiskCache> resultDiskCache_;
+  std::shared_ptr<SharedLazyResults> sharedLazyResults_;
+  std::shared_ptr<ad_utility::timer::SpanTracer> spanTracer_;
+
   // Name (and optional variable for geometry index) under which the result of
   // the query that is executed using this context should be cached. When
   // `std::nullopt`, the result is not cached.
@@ -266,6 +412,14 @@ class QueryExecutionContext
   // limiting the update frequency when `sendPriority` is `IfDue`.
   mutable std::chrono::steady_clock::time_point lastWebsocketUpdate_ =
       std::chrono::steady_clock::time_point::min();
+
+  // The time it took to serialize and send the last websocket update.
+  mutable std::chrono::steady_clock::duration lastWebsocketUpdateDuration_{0};
+
+  // The time between two updates with `sendPriority` `IfDue` is at least this
+  // factor times the duration of the last update, s.t. at most 10% of the
+  // time of the query is spent on sending updates.
+  static constexpr int minIntervalPerSerializationTime = 10;
 };
 
 #endif  // QLEVER_SRC_ENGINE_QUERYEXECUTIONCONTEXT_H
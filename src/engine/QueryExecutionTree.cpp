@@ -154,13 +154,25 @@ void QueryExecutionTree::readFromCache() {
     return;
   }
   auto& cache = qec_->getQueryTreeCache();
-  auto res =
-      cache.getIfContained({getCacheKey(), qec_->locatedTriplesState().index_});
+  auto res = cache.getIfContained(qec_->makeQueryCacheKey(getCacheKey()));
   if (res.has_value()) {
     cachedResult_ = res->_resultPointer->resultTablePtr();
   }
 }
 
+// _____________________________________________________________________________
+void QueryExecutionTree::updateCacheKeysRecursively() {
+  AD_CONTRACT_CHECK(rootOperation_);
+  for (auto* child : rootOperation_->getChildren()) {
+    if (child) {
+      child->updateCacheKeysRecursively();
+    }
+  }
+  updateCacheKeyAndSizeEstimate();
+  cachedResult_ = nullptr;
+  readFromCache();
+}
+
 // ________________________________________________________________________________________________________________
 std::shared_ptr<QueryExecutionTree>
 QueryExecutionTree::createSortedTreeAnyPermutation(
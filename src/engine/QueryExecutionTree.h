@@ -103,6 +103,12 @@ class QueryExecutionTree {
 
   size_t getSizeEstimate();
 
+  // Replace the size estimate by the `actualSize` of the result, which has
+  // already been computed (see `QueryPlanner::useActualSizesOfChildren`).
+  void setSizeEstimateToActualSize(size_t actualSize) {
+    sizeEstimate_ = actualSize;
+  }
+
   float getMultiplicity(size_t col) const {
     return rootOperation_->getMultiplicity(col);
   }
@@ -160,6 +166,20 @@ class QueryExecutionTree {
     }
   }
 
+  // Let all the operations of this tree use the given `qec`, see
+  // `Operation::recursivelySetExecutionContext`.
+  void recursivelySetExecutionContext(QueryExecutionContext* qec) {
+    qec_ = qec;
+    if (rootOperation_) {
+      rootOperation_->recursivelySetExecutionContext(qec);
+    }
+  }
+
+  // Recompute the cache keys and the size estimates of this tree and all its
+  // subtrees (bottom up). This is required when the result of an operation in
+  // the tree has changed after its creation (see `ExternalValues`).
+  void updateCacheKeysRecursively();
+
   bool& isRoot() noexcept { return isRoot_; }
   [[nodiscard]] const bool& isRoot() const noexcept { return isRoot_; }
 
@@ -0,0 +1,201 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/QueryPlanCache.h"
+
+#include <absl/strings/ascii.h>
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <array>
+
+#include "engine/MaterializedViews.h"
+#include "engine/NamedResultCache.h"
+#include "global/RuntimeParameters.h"
+
+namespace {
+// Append the `value` to the `key` s.t. the boundaries between the values of a
+// key are unambiguous.
+void appendToKey(std::string& key, std::string_view value) {
+  absl::StrAppend(&key, value.size(), ":", value);
+}
+
+// Append the sorted string representations of the `graphs`.
+void appendGraphsToKey(std::string& key,
+                       const DatasetClauses::Graphs& graphs) {
+  if (!graphs.has_value()) {
+    key.push_back('*');
+    return;
+  }
+  std::vector<std::string> sortedGraphs;
+  for (const auto& graph : graphs.value()) {
+    sortedGraphs.push_back(graph.toRdfLiteral());
+  }
+  ql::ranges::sort(sortedGraphs);
+  absl::StrAppend(&key, sortedGraphs.size(), "|");
+  for (const auto& graph : sortedGraphs) {
+    appendToKey(key, graph);
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+QueryPlanCache::QueryPlanCache(
+    std::shared_ptr<QueryExecutionContext> templateQec)
+    : templateQec_{std::move(templateQec)} {
+  AD_CONTRACT_CHECK(templateQec_ != nullptr);
+}
+
+// _____________________________________________________________________________
+bool QueryPlanCache::isCacheable(std::string_view queryText) {
+  // The functions whose values are determined during the parsing. Occurrences
+  // that are part of a longer name (e.g. `known(`) are ignored, all other
+  // false positives only prevent the caching.
+  static constexpr std::array<std::string_view, 5> functions{
+      "now", "rand", "uuid", "struuid", "bnode"};
+  auto text = absl::AsciiStrToLower(queryText);
+  auto isNameChar = [](char c) {
+    return absl::ascii_isalnum(static_cast<unsigned char>(c)) || c == '_';
+  };
+  for (std::string_view function : functions) {
+    for (auto pos = text.find(function); pos != std::string::npos;
+         pos = text.find(function, pos + 1)) {
+      if (pos > 0 && isNameChar(text[pos - 1])) {
+        continue;
+      }
+      auto next = text.find_first_not_of(" \t\r\n", pos + function.size());
+      if (next != std::string::npos && text[next] == '(') {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// _____________________________________________________________________________
+std::optional<std::string> QueryPlanCache::parseKey(
+    std::string_view queryText,
+    const std::vector<DatasetClause>& datasetClauses) {
+  if (!isCacheable(queryText)) {
+    return std::nullopt;
+  }
+  std::string key;
+  appendToKey(key, absl::StripAsciiWhitespace(queryText));
+  for (const auto& clause : datasetClauses) {
+    key.push_back(clause.isNamed_ ? 'N' : 'D');
+    appendToKey(key, clause.dataset_.toStringRepresentation());
+  }
+  return key;
+}
+
+// _____________________________________________________________________________
+std::optional<std::string> QueryPlanCache::planKey(const ParsedQuery& query) {
+  if (query.hasUpdateClause() || !isCacheable(query._originalString)) {
+    return std::nullopt;
+  }
+  std::string key;
+  appendToKey(key, absl::StripAsciiWhitespace(query._originalString));
+  appendGraphsToKey(key, query.datasetClauses_.activeDefaultGraphs());
+  appendGraphsToKey(key, query.datasetClauses_.namedGraphs());
+  return key;
+}
+
+// _____________________________________________________________________________
+bool QueryPlanCache::updateMaxNumEntries() const {
+  auto maxNumEntries =
+      getRuntimeParameter<&RuntimeParameters::queryPlanCacheMaxNumEntries_>();
+  parsedQueries_.wlock()->setMaxNumEntries(maxNumEntries);
+  plans_.wlock()->setMaxNumEntries(maxNumEntries);
+  return maxNumEntries > 0;
+}
+
+// _____________________________________________________________________________
+auto QueryPlanCache::planVersion(QueryExecutionContext& qec) -> PlanVersion {
+  return {qec.locatedTriplesState().index_,
+          qec.materializedViewsManager().version(),
+          qec.namedResultCache().version()};
+}
+
+// _____________________________________________________________________________
+std::optional<ParsedQuery> QueryPlanCache::getParsedQuery(
+    const std::string& key) const {
+  auto lock = parsedQueries_.wlock();
+  auto parsedQuery = (*lock)[key];
+  if (parsedQuery == nullptr) {
+    return std::nullopt;
+  }
+  return *parsedQuery;
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::storeParsedQuery(const std::string& key,
+                                      const ParsedQuery& parsedQuery) const {
+  if (!updateMaxNumEntries()) {
+    return;
+  }
+  auto lock = parsedQueries_.wlock();
+  // The underlying cache throws if the key is already present, which happens
+  // if the same query was parsed concurrently.
+  lock->erase(key);
+  lock->insert(key, parsedQuery);
+}
+
+// _____________________________________________________________________________
+auto QueryPlanCache::getPlan(const std::string& key,
+                             QueryExecutionContext& qec) const
+    -> std::optional<Plan> {
+  auto version = planVersion(qec);
+  std::optional<Plan> result;
+  {
+    auto lock = plans_.wlock();
+    auto cachedPlan = (*lock)[key];
+    if (cachedPlan == nullptr) {
+      return std::nullopt;
+    }
+    if (cachedPlan->version_ != version) {
+      // The plan was created for an older state and is not used anymore (the
+      // updates and the loading of views only move forward). Erasing it also
+      // releases the snapshot of the delta triples that it refers to.
+      lock->erase(key);
+      return std::nullopt;
+    }
+    // The cloning has to happen under the lock, because it reads the template
+    // tree that is shared between all the users of the cache.
+    result.emplace(Plan{cachedPlan->parsedQuery_,
+                        std::move(*cachedPlan->queryExecutionTree_->clone())});
+  }
+  result->queryExecutionTree_.recursivelySetExecutionContext(&qec);
+  return result;
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::storePlan(const std::string& key,
+                               const ParsedQuery& parsedQuery,
+                               const QueryExecutionTree& queryExecutionTree,
+                               QueryExecutionContext& qec) const {
+  if (!updateMaxNumEntries()) {
+    return;
+  }
+  auto tree = queryExecutionTree.clone();
+  tree->recursivelySetExecutionContext(templateQec_.get());
+  auto lock = plans_.wlock();
+  lock->erase(key);
+  lock->insert(key, CachedPlan{planVersion(qec), parsedQuery, std::move(tree)});
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::clear() const {
+  parsedQueries_.wlock()->clearAll();
+  plans_.wlock()->clearAll();
+}
+
+// _____________________________________________________________________________
+size_t QueryPlanCache::numPlans() const {
+  return plans_.rlock()->numNonPinnedEntries();
+}
@@ -0,0 +1,149 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_QUERYPLANCACHE_H
+#define QLEVER_SRC_ENGINE_QUERYPLANCACHE_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "backports/three_way_comparison.h"
+#include "engine/QueryExecutionContext.h"
+#include "engine/QueryExecutionTree.h"
+#include "parser/ParsedQuery.h"
+#include "parser/sparqlParser/DatasetClause.h"
+#include "util/Cache.h"
+#include "util/Synchronized.h"
+
+// Cache the parsed queries and the query plans of recently executed queries,
+// s.t. a query that is sent again skips the parsing and the query planning,
+// which can take a significant amount of time for complex queries.
+//
+// The key of both caches is the text of the query (with leading and trailing
+// whitespace removed) together with the dataset clauses that are not part of
+// the text. Queries that only differ in other ways (e.g. in the values of
+// constants) are different keys. A cached plan is only reused for a query with
+// the same snapshot of the delta triples, the same set of loaded materialized
+// views, and the same contents of the `NamedResultCache` as the query for
+// which it was created, because all of these influence the planning. Queries
+// with functions that have to yield a different result for each execution
+// (like `NOW()` or `RAND()`, whose values are fixed during the parsing) are
+// never cached.
+//
+// The number of cached queries is limited by the runtime parameter
+// `query-plan-cache-max-num-entries`.
+class QueryPlanCache {
+ public:
+  // The state that a query plan depends on in addition to the query.
+  struct PlanVersion {
+    size_t locatedTriplesSnapshotIndex_;
+    size_t materializedViewsVersion_;
+    size_t namedResultCacheVersion_;
+    QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(PlanVersion,
+                                                locatedTriplesSnapshotIndex_,
+                                                materializedViewsVersion_,
+                                                namedResultCacheVersion_)
+  };
+
+  // A planned query as it is returned by `getPlan`.
+  struct Plan {
+    ParsedQuery parsedQuery_;
+    QueryExecutionTree queryExecutionTree_;
+  };
+
+ private:
+  struct CachedPlan {
+    PlanVersion version_;
+    ParsedQuery parsedQuery_;
+    // Uses the `templateQec_` and is only cloned, but never executed.
+    std::shared_ptr<QueryExecutionTree> queryExecutionTree_;
+  };
+
+  // Each entry has the same size, the caches are only limited by the number of
+  // their entries.
+  struct EntrySizeGetter {
+    template <typename T>
+    ad_utility::MemorySize operator()(const T&) const {
+      return ad_utility::MemorySize::bytes(1);
+    }
+  };
+  using ParseCache =
+      ad_utility::LRUCache<std::string, ParsedQuery, EntrySizeGetter>;
+  using PlanCache =
+      ad_utility::LRUCache<std::string, CachedPlan, EntrySizeGetter>;
+
+  // The cached query plans must not refer to the execution context of the
+  // query for which they were created, because that context belongs to a
+  // single query (and e.g. reports its progress). They are therefore moved to
+  // this context, which is never used for an actual computation.
+  std::shared_ptr<QueryExecutionContext> templateQec_;
+
+  // The lookup functions have to update the LRU structures of the caches, so
+  // the caches have to be `mutable` to allow for a `const` interface.
+  mutable ad_utility::Synchronized<ParseCache> parsedQueries_;
+  mutable ad_utility::Synchronized<PlanCache> plans_;
+
+ public:
+  explicit QueryPlanCache(std::shared_ptr<QueryExecutionContext> templateQec);
+
+  // Return false if the query with the given text must not be cached (see
+  // above). This is a textual check that errs on the side of not caching.
+  static bool isCacheable(std::string_view queryText);
+
+  // The key for the parse cache, computed from the text of the query and the
+  // dataset clauses that were specified via the URL parameters. Returns
+  // `std::nullopt` if the query is not `isCacheable`.
+  static std::optional<std::string> parseKey(
+      std::string_view queryText,
+      const std::vector<DatasetClause>& datasetClauses);
+
+  // The key for the plan cache, computed from a parsed (but not yet planned)
+  // query. Returns `std::nullopt` if the query can't be cached.
+  static std::optional<std::string> planKey(const ParsedQuery& query);
+
+  // Return a copy of the parsed query for the `key`, or `std::nullopt` if it
+  // isn't cached.
+  std::optional<ParsedQuery> getParsedQuery(const std::string& key) const;
+
+  // Store a copy of the `parsedQuery` (which must not have been planned yet)
+  // for the `key`.
+  void storeParsedQuery(const std::string& key,
+                        const ParsedQuery& parsedQuery) const;
+
+  // If a plan for the `key` that is valid for the `qec` is cached, return a
+  // copy of it that uses the `qec` and has a fresh runtime information.
+  // Otherwise return `std::nullopt`.
+  std::optional<Plan> getPlan(const std::string& key,
+                              QueryExecutionContext& qec) const;
+
+  // Store a copy of the `parsedQuery` (after the planning) and the
+  // `queryExecutionTree` that was created for it using the `qec`.
+  void storePlan(const std::string& key, const ParsedQuery& parsedQuery,
+                 const QueryExecutionTree& queryExecutionTree,
+                 QueryExecutionContext& qec) const;
+
+  // Remove all the cached queries and plans.
+  void clear() const;
+
+  // The number of cached plans.
+  size_t numPlans() const;
+
+ private:
+  // The version of the state that the plans for the `qec` depend on.
+  static PlanVersion planVersion(QueryExecutionContext& qec);
+
+  // Read the `query-plan-cache-max-num-entries` runtime parameter and apply it
+  // to both caches. Return false if the caching is disabled.
+  bool updateMaxNumEntries() const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_QUERYPLANCACHE_H
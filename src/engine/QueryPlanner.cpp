@@ -28,10 +28,13 @@
 #include "engine/Distinct.h"
 #include "engine/ExternalValues.h"
 #include "engine/Filter.h"
+#include "engine/GraphAnalytics.h"
 #include "engine/GroupBy.h"
 #include "engine/HasPredicateScan.h"
+#include "engine/HashJoin.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
+#include "engine/LeapfrogTriejoin.h"
 #include "engine/Load.h"
 #include "engine/MaterializedViews.h"
 #include "engine/Minus.h"
@@ -54,6 +57,7 @@
 #include "engine/TransitivePathBase.h"
 #include "engine/Union.h"
 #include "engine/Values.h"
+#include "engine/WindowFunctions.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/RelationalExpressions.h"
@@ -70,6 +74,8 @@
 #include "rdfTypes/Variable.h"
 #include "util/CompilerWarnings.h"
 #include "util/Exception.h"
+#include "util/Random.h"
+#include "util/Timer.h"
 
 namespace p = parsedQuery;
 namespace {
@@ -143,10 +149,16 @@ std::vector<SubtreePlan> QueryPlanner::createExecutionTrees(ParsedQuery& pq,
   // from the list of where clause triples. Otherwise, the ql:has-predicate
   // triple will be handled using a `HasPredicateScan`.
 
+  // A `GROUP BY` that can be answered by the precomputed facet statistics
+  // replaces the graph pattern, the `GROUP BY`, and the pattern trick.
+  auto facetStatisticsPlan = getFacetStatisticsPlan(pq);
+  const bool useFacetStatistics = facetStatisticsPlan.has_value();
+
   using checkUsePatternTrick::PatternTrickTuple;
   const auto patternTrickTuple =
-      _enablePatternTrick ? checkUsePatternTrick::checkUsePatternTrick(&pq)
-                          : std::nullopt;
+      _enablePatternTrick && !useFacetStatistics
+          ? checkUsePatternTrick::checkUsePatternTrick(&pq)
+          : std::nullopt;
 
   // Do GROUP BY if one of the following applies:
   // 1. There is an explicit group by
@@ -170,13 +182,20 @@ std::vector<SubtreePlan> QueryPlanner::createExecutionTrees(ParsedQuery& pq,
 
   // Optimize the graph pattern tree
   std::vector<std::vector<SubtreePlan>> plans;
-  plans.push_back(optimize(&pq._rootGraphPattern));
+  if (useFacetStatistics) {
+    plans.push_back({std::move(facetStatisticsPlan).value()});
+  } else {
+    plans.push_back(optimize(&pq._rootGraphPattern));
+  }
   checkCancellation();
 
   // Add the query level modifications
 
-  // GROUP BY (Either the pattern trick or a "normal" GROUP BY)
-  if (patternTrickTuple.has_value()) {
+  // GROUP BY (Either the pattern trick or a "normal" GROUP BY, unless the
+  // facet statistics are used)
+  if (useFacetStatistics) {
+    // The scan of the facet statistics already is the result of the GROUP BY.
+  } else if (patternTrickTuple.has_value()) {
     plans.emplace_back(getPatternTrickRow(pq.selectClause(), plans,
                                           patternTrickTuple.value()));
   } else if (doGroupBy) {
@@ -377,6 +396,26 @@ std::vector<SubtreePlan> QueryPlanner::getPatternTrickRow(
   return added;
 }
 
+// _____________________________________________________________________________
+std::optional<SubtreePlan> QueryPlanner::getFacetStatisticsPlan(
+    const ParsedQuery& pq) const {
+  if (_qec == nullptr ||
+      !getRuntimeParameter<
+          &RuntimeParameters::enableMaterializedViewQueryRewrite_>() ||
+      activeGraphVariable_.has_value() ||
+      activeDatasetClauses_.activeDefaultGraphs().has_value()) {
+    return std::nullopt;
+  }
+  auto scan =
+      _qec->materializedViewsManager().makeFacetStatisticsScan(_qec, pq);
+  // The precomputed statistics don't reflect the updates.
+  if (scan == nullptr ||
+      !scan->permutation().materializedView()->isUnaffectedByUpdates(_qec)) {
+    return std::nullopt;
+  }
+  return makeSubtreePlan<IndexScan>(std::move(scan));
+}
+
 // _____________________________________________________________________________
 std::vector<SubtreePlan> QueryPlanner::getHavingRow(
     const ParsedQuery& pq, const vector<vector<SubtreePlan>>& dpTab) const {
@@ -1673,11 +1712,59 @@ std::vector<SubtreePlan> QueryPlanner::runGreedyPlanningOnConnectedComponent(
     const FiltersAndOptionalSubstitutes& filters,
     const TextLimitVec& textLimits, const TripleGraph& tg,
     ReplacementPlans&& replacementPlans) const {
+  const bool hasReplacementPlans = !replacementPlans.empty();
+  const auto timeBudget = getRuntimeParameter<
+      &RuntimeParameters::queryPlanningImprovementTimeBudget_>();
+  if (timeForPlanImprovement_ >= timeBudget) {
+    return runGreedyPlanningImpl(std::move(connectedComponent), filters,
+                                 textLimits, tg, hasReplacementPlans, nullptr);
+  }
+  auto result = runGreedyPlanningImpl(connectedComponent, filters, textLimits,
+                                      tg, hasReplacementPlans, nullptr);
+  if (result.size() != 1) {
+    return result;
+  }
+
+  // Repeat the greedy planning with random choices among the cheapest
+  // candidates of each step and keep the cheapest complete plan, until the
+  // time budget (which is shared by all the components of the query) is used
+  // up. The fixed seed makes the planning reproducible for a fixed number of
+  // rounds.
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  ad_utility::SlowRandomIntGenerator<size_t> randomGenerator{
+      0, 3, ad_utility::RandomSeed::make(42)};
+  size_t numRounds = 0;
+  size_t numImprovements = 0;
+  while (timeForPlanImprovement_ + timer.msecs() < timeBudget) {
+    auto candidate =
+        runGreedyPlanningImpl(connectedComponent, filters, textLimits, tg,
+                              hasReplacementPlans, &randomGenerator);
+    ++numRounds;
+    if (candidate.size() == 1 && candidate.front().getCostEstimate() <
+                                     result.front().getCostEstimate()) {
+      result = std::move(candidate);
+      ++numImprovements;
+    }
+  }
+  timeForPlanImprovement_ += timer.msecs();
+  AD_LOG_DEBUG << "Randomized greedy planning improved the plan "
+               << numImprovements << " times in " << numRounds << " rounds"
+               << std::endl;
+  return result;
+}
+
+// _____________________________________________________________________________
+std::vector<SubtreePlan> QueryPlanner::runGreedyPlanningImpl(
+    std::vector<SubtreePlan> connectedComponent,
+    const FiltersAndOptionalSubstitutes& filters,
+    const TextLimitVec& textLimits, const TripleGraph& tg,
+    bool hasReplacementPlans,
+    ad_utility::SlowRandomIntGenerator<size_t>* randomGenerator) const {
   applyFiltersIfPossible<FilterMode::ReplaceUnfiltered>(connectedComponent,
                                                         filters);
   applyTextLimitsIfPossible(connectedComponent, textLimits, true);
   const size_t numSeeds =
-      findUniqueNodeIds(connectedComponent, !replacementPlans.empty());
+      findUniqueNodeIds(connectedComponent, hasReplacementPlans);
   if (numSeeds <= 1) {
     // Only 0 or 1 nodes in the input, nothing to plan.
     return connectedComponent;
@@ -1697,7 +1784,7 @@ std::vector<SubtreePlan> QueryPlanner::runGreedyPlanningOnConnectedComponent(
   // reinforces the above pre-/postconditions. Exception: if `isFirstStep` then
   // `cache` and `nextResult` must be empty, and the first step of greedy
   // planning is performed, which also establishes the pre-/postconditions.
-  auto greedyStep = [this, &tg, &filters, &textLimits,
+  auto greedyStep = [this, &tg, &filters, &textLimits, randomGenerator,
                      currentPlans = std::move(connectedComponent),
                      cache = Plans{}](Plans& nextBestPlan, bool isFirstStep,
                                       bool isLastStep) mutable {
@@ -1721,9 +1808,13 @@ std::vector<SubtreePlan> QueryPlanner::runGreedyPlanningOnConnectedComponent(
     ql::ranges::move(nextBestPlan, std::back_inserter(currentPlans));
 
     // All candidates for the next greedy step are in the `cache`, choose the
-    // cheapest one, remove it from the cache and make it the `nextResult`
+    // cheapest one (or with a `randomGenerator` one of the cheapest ones),
+    // remove it from the cache and make it the `nextResult`
     {
-      auto smallestIdxNew = findSmallestExecutionTree(cache);
+      auto smallestIdxNew =
+          randomGenerator != nullptr
+              ? chooseRandomSmallExecutionTree(cache, *randomGenerator)
+              : findSmallestExecutionTree(cache);
       auto& cheapestNewTree = cache.at(smallestIdxNew);
       std::swap(cheapestNewTree, cache.back());
       nextBestPlan.clear();
@@ -1773,11 +1864,52 @@ QueryPlanner::FiltersAndOptionalSubstitutes QueryPlanner::seedFilterSubstitutes(
   return plans;
 };
 
+// _____________________________________________________________________________
+void QueryPlanner::useActualSizesOfChildren(
+    const vector<vector<SubtreePlan>>& children, size_t numTriples) const {
+  const double threshold =
+      getRuntimeParameter<&RuntimeParameters::reoptimizationThreshold_>();
+  // Without any joins, there is nothing to re-optimize.
+  if (threshold <= 0 || _qec == nullptr || _qec->disableCaching() ||
+      children.size() + numTriples < 2) {
+    return;
+  }
+  for (const auto& candidates : children) {
+    if (candidates.empty()) {
+      continue;
+    }
+    auto& qet = *candidates.at(findCheapestExecutionTree(candidates))._qet;
+    auto rootOperation = qet.getRootOperation();
+    // The estimates of index scans are exact anyway, and results that can't
+    // be cached would have to be computed twice.
+    if (dynamic_cast<const IndexScan*>(rootOperation.get()) != nullptr ||
+        !rootOperation->canResultBeCached()) {
+      continue;
+    }
+    rootOperation->recursivelySetCancellationHandle(cancellationHandle_);
+    const auto estimate = static_cast<double>(qet.getSizeEstimate());
+    const size_t actualSize = qet.getResult()->idTable().numRows();
+    checkCancellation();
+    const auto actual = static_cast<double>(actualSize);
+    if (std::max(estimate, actual) <=
+        threshold * std::max(1.0, std::min(estimate, actual))) {
+      continue;
+    }
+    AD_LOG_DEBUG << "Re-optimizing with the actual size " << actualSize
+                 << " instead of the estimate " << estimate << " for "
+                 << qet.getRootOperation()->getDescriptor() << std::endl;
+    for (const auto& candidate : candidates) {
+      candidate._qet->setSizeEstimateToActualSize(actualSize);
+    }
+  }
+}
+
 // _____________________________________________________________________________
 std::vector<std::vector<SubtreePlan>> QueryPlanner::fillDpTab(
     const QueryPlanner::TripleGraph& tg, vector<SparqlFilter> filters,
     TextLimitMap& textLimits, const vector<vector<SubtreePlan>>& children,
     ReplacementPlans replacementPlans) {
+  useActualSizesOfChildren(children, tg._nodeMap.size());
   auto [initialPlans, additionalFilters] =
       seedWithScansAndText(tg, children, textLimits);
   ql::ranges::move(additionalFilters, std::back_inserter(filters));
@@ -2206,6 +2338,26 @@ size_t QueryPlanner::findCheapestExecutionTree(
   return ql::ranges::min_element(lastRow, compare) - lastRow.begin();
 };
 
+// _____________________________________________________________________________
+size_t QueryPlanner::chooseRandomSmallExecutionTree(
+    const std::vector<SubtreePlan>& plans,
+    ad_utility::SlowRandomIntGenerator<size_t>& randomGenerator) {
+  AD_CONTRACT_CHECK(!plans.empty());
+  // The `randomGenerator` yields values in `[0, 3]`, so the smallest plan is
+  // chosen with probability 1/2, and the second and third smallest with
+  // probability 1/4 each.
+  size_t rank = std::max(size_t{1}, randomGenerator()) - 1;
+  std::vector<size_t> indices(plans.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = i;
+  }
+  rank = std::min(rank, indices.size() - 1);
+  ql::ranges::nth_element(
+      indices, indices.begin() + rank, ql::ranges::less{},
+      [&plans](size_t i) { return plans[i].getSizeEstimate(); });
+  return indices[rank];
+}
+
 // _________________________________________________________________________________
 size_t QueryPlanner::findSmallestExecutionTree(
     const std::vector<SubtreePlan>& lastRow) {
@@ -2337,6 +2489,13 @@ std::vector<SubtreePlan> QueryPlanner::createJoinCandidates(
   mergeSubtreePlanIds(plan, a, b);
   candidates.push_back(std::move(plan));
 
+  // A `HashJoin` doesn't have to sort its inputs. Its result has a different
+  // order than that of the `Join`, so the cheaper of the two is chosen among
+  // the plans that are needed for the order of the result.
+  if (auto opt = createHashJoin(a, b, jcs)) {
+    candidates.push_back(std::move(opt.value()));
+  }
+
   return candidates;
 }
 
@@ -2611,9 +2770,8 @@ auto QueryPlanner::createMaterializedViewJoinReplacements(
     const parsedQuery::BasicGraphPattern& triples) const -> ReplacementPlans {
   ReplacementPlans plans;
 
-  // Check if the user allows query rewriting.
-  // TODO<ullingerc> Do we want to forcefully disable query rewriting if delta
-  // triples are present in the current index to prevent diverging results?
+  // Check if the user allows query rewriting. Views that are stale because of
+  // updates are never used (see `makeJoinReplacementIndexScans`).
   if (!getRuntimeParameter<
           &RuntimeParameters::enableMaterializedViewQueryRewrite_>()) {
     return plans;
@@ -2645,6 +2803,145 @@ auto QueryPlanner::createMaterializedViewJoinReplacements(
   return plans;
 }
 
+// _____________________________________________________________________________
+auto QueryPlanner::createWorstCaseOptimalJoinReplacements(
+    const parsedQuery::BasicGraphPattern& triples) const -> ReplacementPlans {
+  ReplacementPlans plans;
+  if (!getRuntimeParameter<&RuntimeParameters::useWorstCaseOptimalJoin_>() ||
+      _qec == nullptr || activeGraphVariable_.has_value()) {
+    return plans;
+  }
+
+  // A triple can be part of a `LeapfrogTriejoin` if its predicate is a fixed
+  // IRI (which is not one of the special predicates) and its subject and
+  // object are two distinct variables. The ids of the nodes of the query graph
+  // are the indices of the triples, so only the first 64 triples are used.
+  auto isEligible = [](const SparqlTriple& triple) {
+    auto predicate = triple.getSimplePredicate();
+    if (!predicate.has_value() || !triple.s_.isVariable() ||
+        !triple.o_.isVariable() || triple.s_ == triple.o_ ||
+        !triple.additionalScanColumns_.empty()) {
+      return false;
+    }
+    std::array<std::string_view, 4> specialPrefixes{
+        QLEVER_INTERNAL_PREFIX_IRI_WITHOUT_CLOSING_BRACKET, MAX_DIST_IN_METERS,
+        NEAREST_NEIGHBORS, MATERIALIZED_VIEW_IRI_WITHOUT_CLOSING_BRACKET};
+    return ql::ranges::none_of(specialPrefixes, [&](std::string_view prefix) {
+      return ql::starts_with(predicate.value(), prefix);
+    });
+  };
+  const auto& allTriples = triples._triples;
+  std::vector<size_t> eligible;
+  for (size_t i = 0; i < std::min(allTriples.size(), size_t{64}); ++i) {
+    if (isEligible(allTriples[i])) {
+      eligible.push_back(i);
+    }
+  }
+
+  // Compute the connected components of the eligible triples (with a
+  // union-find on the triple indices).
+  std::vector<size_t> parent(allTriples.size());
+  for (size_t i = 0; i < parent.size(); ++i) {
+    parent[i] = i;
+  }
+  auto findRoot = [&parent](size_t i) {
+    while (parent[i] != i) {
+      i = parent[i] = parent[parent[i]];
+    }
+    return i;
+  };
+  ad_utility::HashMap<Variable, size_t> tripleOfVariable;
+  for (size_t i : eligible) {
+    for (const auto* component : {&allTriples[i].s_, &allTriples[i].o_}) {
+      auto [it, isNew] = tripleOfVariable.emplace(component->getVariable(), i);
+      if (!isNew) {
+        parent[findRoot(i)] = findRoot(it->second);
+      }
+    }
+  }
+  std::vector<std::vector<size_t>> components;
+  ad_utility::HashMap<size_t, size_t> componentOfRoot;
+  for (size_t i : eligible) {
+    auto [it, isNew] =
+        componentOfRoot.emplace(findRoot(i), components.size());
+    if (isNew) {
+      components.emplace_back();
+    }
+    components.at(it->second).push_back(i);
+  }
+
+  for (const auto& component : components) {
+    std::vector<std::array<Variable, 2>> variables;
+    for (size_t i : component) {
+      variables.push_back(
+          {allTriples[i].s_.getVariable(), allTriples[i].o_.getVariable()});
+    }
+    auto variableOrder = LeapfrogTriejoin::computeVariableOrder(variables);
+    // A connected pattern with fewer triples than variables is a tree, for
+    // which the binary joins are already worst-case optimal.
+    if (component.size() < 3 || component.size() < variableOrder.size()) {
+      continue;
+    }
+    auto position = [&variableOrder](const TripleComponent& term) {
+      return ql::ranges::find(variableOrder, term.getVariable()) -
+             variableOrder.begin();
+    };
+    LeapfrogTriejoin::Children children;
+    uint64_t idsOfIncludedNodes = 0;
+    for (size_t i : component) {
+      const auto& triple = allTriples[i];
+      auto permutation = position(triple.s_) < position(triple.o_)
+                             ? Permutation::PSO
+                             : Permutation::POS;
+      auto simpleTriple = triple.getSimple();
+      children.push_back(ad_utility::makeExecutionTree<IndexScan>(
+          _qec,
+          qlever::getPermutationForTriple(permutation, _qec->getIndex(),
+                                          simpleTriple),
+          _qec->locatedTriplesSharedState(), simpleTriple, getActiveGraphs()));
+      idsOfIncludedNodes |= (1ULL << i);
+    }
+    auto plan = makeSubtreePlan<LeapfrogTriejoin>(_qec, std::move(children),
+                                                  std::move(variableOrder));
+    plan._idsOfIncludedNodes = idsOfIncludedNodes;
+    if (plans.size() < component.size()) {
+      plans.resize(component.size());
+    }
+    plans.at(component.size() - 1).push_back(std::move(plan));
+  }
+  return plans;
+}
+
+// _____________________________________________________________________________
+std::optional<SubtreePlan> QueryPlanner::createHashJoin(
+    const SubtreePlan& a, const SubtreePlan& b, const JoinColumns& jcs) const {
+  AD_CORRECTNESS_CHECK(jcs.size() == 1);
+  if (!getRuntimeParameter<&RuntimeParameters::useHashJoin_>()) {
+    return std::nullopt;
+  }
+  auto [columnA, columnB] = jcs[0];
+  // If both inputs are already sorted on the join column, the `Join` doesn't
+  // need to sort and is always cheaper.
+  auto isSortedOnJoinColumn = [](const SubtreePlan& plan, ColumnIndex column) {
+    const auto& sortedOn = plan._qet->resultSortedOn();
+    return !sortedOn.empty() && sortedOn.front() == column;
+  };
+  if (isSortedOnJoinColumn(a, columnA) && isSortedOnJoinColumn(b, columnB)) {
+    return std::nullopt;
+  }
+  // The smaller input is stored in a hash map, which must not become too
+  // large.
+  auto buildSize =
+      std::min(a._qet->getSizeEstimate(), b._qet->getSizeEstimate());
+  if (static_cast<double>(buildSize) >
+      _qec->getCostFactor("HASH_JOIN_MAX_BUILD_SIZE")) {
+    return std::nullopt;
+  }
+  auto plan = makeSubtreePlan<HashJoin>(_qec, a._qet, b._qet, columnA, columnB);
+  mergeSubtreePlanIds(plan, a, b);
+  return plan;
+}
+
 // ______________________________________________________________________________________
 auto QueryPlanner::createJoinWithHasPredicateScan(
     const SubtreePlan& a, const SubtreePlan& b,
@@ -3142,6 +3439,10 @@ void QueryPlanner::GraphPatternPlanner::graphPatternOperationVisitor(Arg& arg) {
     visitTextSearch(arg);
   } else if constexpr (std::is_same_v<T, p::ExternalValuesQuery>) {
     visitExternalValues(arg);
+  } else if constexpr (std::is_same_v<T, p::GraphAnalyticsQuery>) {
+    visitGraphAnalytics(arg);
+  } else if constexpr (std::is_same_v<T, p::WindowFunctionsQuery>) {
+    visitWindowFunctions(arg);
   } else if constexpr (std::is_same_v<T, p::NamedCachedResult>) {
     visitNamedCachedResult(arg);
   } else if constexpr (std::is_same_v<T, p::MaterializedViewQuery>) {
@@ -3368,6 +3669,47 @@ void QueryPlanner::GraphPatternPlanner::visitExternalValues(
   visitGroupOptionalOrMinus(std::vector{std::move(candidate)});
 }
 
+// _______________________________________________________________
+void QueryPlanner::GraphPatternPlanner::visitGraphAnalytics(
+    parsedQuery::GraphAnalyticsQuery& graphAnalyticsQuery) {
+  auto config = graphAnalyticsQuery.toGraphAnalyticsConfiguration(
+      planner_._qec->getIndex());
+
+  // The graph analytics service requires a child graph pattern for the edges.
+  AD_CORRECTNESS_CHECK(graphAnalyticsQuery.childGraphPattern_.has_value());
+  std::vector<SubtreePlan> candidatesIn =
+      planner_.optimize(&graphAnalyticsQuery.childGraphPattern_.value());
+  std::vector<SubtreePlan> candidatesOut;
+
+  for (auto& sub : candidatesIn) {
+    auto graphAnalytics =
+        std::make_shared<GraphAnalytics>(qec_, std::move(sub._qet), config);
+    candidatesOut.push_back(
+        makeSubtreePlan<GraphAnalytics>(std::move(graphAnalytics)));
+  }
+  visitGroupOptionalOrMinus(std::move(candidatesOut));
+}
+
+// _______________________________________________________________
+void QueryPlanner::GraphPatternPlanner::visitWindowFunctions(
+    parsedQuery::WindowFunctionsQuery& windowFunctionsQuery) {
+  auto config = windowFunctionsQuery.toWindowFunctionsConfiguration();
+
+  // The window functions service requires a child graph pattern for the rows.
+  AD_CORRECTNESS_CHECK(windowFunctionsQuery.childGraphPattern_.has_value());
+  std::vector<SubtreePlan> candidatesIn =
+      planner_.optimize(&windowFunctionsQuery.childGraphPattern_.value());
+  std::vector<SubtreePlan> candidatesOut;
+
+  for (auto& sub : candidatesIn) {
+    auto windowFunctions =
+        std::make_shared<WindowFunctions>(qec_, std::move(sub._qet), config);
+    candidatesOut.push_back(
+        makeSubtreePlan<WindowFunctions>(std::move(windowFunctions)));
+  }
+  visitGroupOptionalOrMinus(std::move(candidatesOut));
+}
+
 // _____________________________________________________________________________
 void QueryPlanner::GraphPatternPlanner::visitNamedCachedResult(
     const parsedQuery::NamedCachedResult& arg) {
@@ -3442,6 +3784,15 @@ void QueryPlanner::GraphPatternPlanner::visitSubquery(
 void QueryPlanner::GraphPatternPlanner::optimizeCommutatively() {
   auto replacementPlans =
       planner_.createMaterializedViewJoinReplacements(candidateTriples_);
+  auto worstCaseOptimalJoinPlans =
+      planner_.createWorstCaseOptimalJoinReplacements(candidateTriples_);
+  if (replacementPlans.size() < worstCaseOptimalJoinPlans.size()) {
+    replacementPlans.resize(worstCaseOptimalJoinPlans.size());
+  }
+  for (size_t i = 0; i < worstCaseOptimalJoinPlans.size(); ++i) {
+    ql::ranges::move(worstCaseOptimalJoinPlans[i],
+                     std::back_inserter(replacementPlans[i]));
+  }
   auto tg = planner_.createTripleGraph(&candidateTriples_);
   auto lastRow =
       planner_
@@ -8,6 +8,7 @@
 #define QLEVER_SRC_ENGINE_QUERYPLANNER_H
 
 #include <boost/optional.hpp>
+#include <chrono>
 #include <vector>
 
 #include "engine/CheckUsePatternTrick.h"
@@ -16,6 +17,7 @@
 #include "parser/GraphPatternOperation.h"
 #include "parser/ParsedQuery.h"
 #include "parser/data/Types.h"
+#include "util/Random.h"
 
 class QueryPlanner {
   using TextLimitMap =
@@ -51,6 +53,12 @@ class QueryPlanner {
   QueryExecutionTree createExecutionTree(ParsedQuery& pq,
                                          bool isSubquery = false);
 
+  // The time that was spent on the randomized improvement of the greedy query
+  // plans for large connected components.
+  std::chrono::milliseconds timeForPlanImprovement() const {
+    return timeForPlanImprovement_;
+  }
+
   class TripleGraph {
    public:
     TripleGraph();
@@ -275,6 +283,10 @@ class QueryPlanner {
   // be reported as part of the query result if desired.
   std::vector<std::string> warnings_;
 
+  // The time that has been spent on improving greedy plans so far (see
+  // `runGreedyPlanningOnConnectedComponent`).
+  mutable std::chrono::milliseconds timeForPlanImprovement_{0};
+
   std::vector<QueryPlanner::SubtreePlan> optimize(
       ParsedQuery::GraphPattern* rootPattern);
 
@@ -431,6 +443,15 @@ class QueryPlanner {
   static std::optional<SubtreePlan> createJoinWithPathSearch(
       const SubtreePlan& a, const SubtreePlan& b, const JoinColumns& jcs);
 
+  // Used internally by `createJoinCandidates` for joins on a single column. If
+  // the runtime parameter `use-hash-join` is set, at least one of `a` and `b`
+  // is not sorted on the join column, and the smaller one is small enough for
+  // a hash map, return a `HashJoin` of `a` and `b`. Else return
+  // `std::nullopt`.
+  std::optional<SubtreePlan> createHashJoin(const SubtreePlan& a,
+                                            const SubtreePlan& b,
+                                            const JoinColumns& jcs) const;
+
   // Helper that returns `true` for each of the subtree plans `a` and `b` iff
   // the subtree plan is a spatial join and it is not yet fully constructed
   // (it does not have both children set)
@@ -457,6 +478,13 @@ class QueryPlanner {
   ReplacementPlans createMaterializedViewJoinReplacements(
       const parsedQuery::BasicGraphPattern& triples) const;
 
+  // Helper that generates `LeapfrogTriejoin` query plans for the cyclic
+  // connected components (like triangles) of the `triples` with fixed
+  // predicates, if the runtime parameter `use-worst-case-optimal-join` is set.
+  // The result has the same format as for the helper directly above.
+  ReplacementPlans createWorstCaseOptimalJoinReplacements(
+      const parsedQuery::BasicGraphPattern& triples) const;
+
   vector<SubtreePlan> getOrderByRow(
       const ParsedQuery& pq,
       const std::vector<std::vector<SubtreePlan>>& dpTab) const;
@@ -474,6 +502,15 @@ class QueryPlanner {
       const vector<vector<SubtreePlan>>& dpTab,
       const checkUsePatternTrick::PatternTrickTuple& patternTrickTuple);
 
+  // If the graph pattern and the `GROUP BY` of the `pq` can be answered by a
+  // scan of the facet statistics that were precomputed at index build time
+  // (see `MaterializedViewsManager::makeFacetStatisticsScan`), return the plan
+  // for this scan. This requires the runtime parameter
+  // `enable-materialized-view-query-rewrite`, the default graph, and an index
+  // that is unaffected by updates.
+  std::optional<SubtreePlan> getFacetStatisticsPlan(
+      const ParsedQuery& pq) const;
+
   vector<SubtreePlan> getHavingRow(
       const ParsedQuery& pq, const vector<vector<SubtreePlan>>& dpTab) const;
 
@@ -585,6 +622,18 @@ class QueryPlanner {
       TextLimitMap& textLimits, const vector<vector<SubtreePlan>>& children,
       ReplacementPlans replacementPlans);
 
+  // Helper for `fillDpTab` for the adaptive re-optimization (see the runtime
+  // parameter `reoptimization-threshold`): Compute the result of the cheapest
+  // candidate of each of the `children` (the already planned subtrees that
+  // are not triples, e.g. subqueries). If its actual size differs from the
+  // size estimate by more than the threshold factor, use the actual size as
+  // the size estimate of all the candidates, s.t. the joins with the
+  // remaining `numTriples` triples are planned with the true cardinality. The
+  // computed results are stored in the cache and thus reused during the
+  // execution.
+  void useActualSizesOfChildren(
+      const vector<vector<SubtreePlan>>& children, size_t numTriples) const;
+
   // Internal subroutine of `fillDpTab` that  only works on a single connected
   // component of the input. Throws if the subtrees in the `connectedComponent`
   // are not in fact connected (via their variables).
@@ -598,12 +647,27 @@ class QueryPlanner {
   // Same as `runDynamicProgrammingOnConnectedComponent`, but uses a greedy
   // algorithm that always greedily chooses the smallest result of the possible
   // join operations using the "Greedy Operator Ordering (GOO)" algorithm.
+  // As long as the runtime parameter
+  // `query-planning-improvement-time-budget` is not used up, the greedy
+  // planning is then repeated with randomized choices, and the cheapest of
+  // the resulting plans is returned.
   std::vector<QueryPlanner::SubtreePlan> runGreedyPlanningOnConnectedComponent(
       std::vector<SubtreePlan> connectedComponent,
       const FiltersAndOptionalSubstitutes& filters,
       const TextLimitVec& textLimits, const TripleGraph& tg,
       ReplacementPlans&& replacementPlans) const;
 
+  // A single run of the greedy planning for
+  // `runGreedyPlanningOnConnectedComponent`. If a `randomGenerator` is given,
+  // each step chooses one of the smallest candidates at random (see
+  // `chooseRandomSmallExecutionTree`) instead of the smallest one.
+  std::vector<QueryPlanner::SubtreePlan> runGreedyPlanningImpl(
+      std::vector<SubtreePlan> connectedComponent,
+      const FiltersAndOptionalSubstitutes& filters,
+      const TextLimitVec& textLimits, const TripleGraph& tg,
+      bool hasReplacementPlans,
+      ad_utility::SlowRandomIntGenerator<size_t>* randomGenerator) const;
+
   // Return the number of connected subgraphs is the `graph`, or `budget + 1`,
   // if the number of subgraphs is `> budget`. This is used to analyze the
   // complexity of the query graph and to choose between the DP and the greedy
@@ -681,6 +745,8 @@ class QueryPlanner {
     void visitSpatialSearch(parsedQuery::SpatialQuery& config);
     void visitTextSearch(const parsedQuery::TextSearchQuery& config);
     void visitExternalValues(const parsedQuery::ExternalValuesQuery& config);
+    void visitGraphAnalytics(parsedQuery::GraphAnalyticsQuery& config);
+    void visitWindowFunctions(parsedQuery::WindowFunctionsQuery& config);
     void visitNamedCachedResult(const parsedQuery::NamedCachedResult& config);
     void visitMaterializedViewQuery(
         const parsedQuery::MaterializedViewQuery& viewQuery);
@@ -731,6 +797,12 @@ class QueryPlanner {
       const std::vector<SubtreePlan>& lastRow) const;
   static size_t findSmallestExecutionTree(
       const std::vector<SubtreePlan>& lastRow);
+  // Return the index of one of the three smallest plans in `plans`, chosen at
+  // random using the `randomGenerator` (which has to yield values in
+  // `[0, 3]`). Used by the randomized greedy planning.
+  static size_t chooseRandomSmallExecutionTree(
+      const std::vector<SubtreePlan>& plans,
+      ad_utility::SlowRandomIntGenerator<size_t>& randomGenerator);
   static size_t findUniqueNodeIds(
       const std::vector<SubtreePlan>& connectedComponent,
       bool allowReplacementPlans = false);
@@ -22,10 +22,29 @@ QueryPlanningCostFactors::QueryPlanningCostFactors() : _factors() {
   _factors["HASH_MAP_OPERATION_COST"] = 50.0;
   _factors["JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR"] = 0.7;
   _factors["DUMMY_JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR"] = 0.7;
+  // The distinct-value sketches of the `PredicateStatistics` are only used for
+  // the join size estimate if both sides have at least this many distinct
+  // values in the join column. For fewer values, the relative error of the
+  // sketches is too large to improve on the default estimate.
+  _factors["JOIN_SIZE_ESTIMATE_MIN_DISTINCT_FOR_SKETCHES"] = 1000;
 
   // Assume that a random disk seek is 100 times more expensive than an
   // average `O(1)` access to a single ID.
   _factors["DISK_RANDOM_ACCESS_COST"] = 100;
+
+  // A GROUP BY uses a hash map instead of sorting its input if the input has
+  // at least this many rows and the estimated number of groups is at most
+  // this fraction of the input size (see `group-by-hash-map-cost-based`).
+  _factors["GROUP_BY_HASH_MAP_MIN_INPUT_SIZE"] = 100'000;
+  _factors["GROUP_BY_HASH_MAP_MAX_GROUPS_RATIO"] = 0.01;
+
+  // The cost per row of the build side and of the probe side of a `HashJoin`,
+  // compared to the cost of one for each row of a `Join` (which also needs
+  // sorted inputs). The build side of a `HashJoin` has at most
+  // `HASH_JOIN_MAX_BUILD_SIZE` rows (according to the size estimate).
+  _factors["HASH_JOIN_BUILD_COST_PER_ROW"] = 4.0;
+  _factors["HASH_JOIN_PROBE_COST_PER_ROW"] = 2.0;
+  _factors["HASH_JOIN_MAX_BUILD_SIZE"] = 1'000'000;
 }
 
 // _____________________________________________________________________________
@@ -58,3 +77,11 @@ void QueryPlanningCostFactors::readFromFile(const std::string& fileName) {
 double QueryPlanningCostFactors::getCostFactor(const std::string& key) const {
   return _factors.find(key)->second;
 }
+
+// _____________________________________________________________________________
+void QueryPlanningCostFactors::setCostFactor(const std::string& key,
+                                             double value) {
+  auto it = _factors.find(key);
+  AD_CONTRACT_CHECK(it != _factors.end(), "Unknown cost factor \"", key, "\"");
+  it->second = value;
+}
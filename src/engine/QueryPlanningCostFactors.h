@@ -16,6 +16,8 @@ class QueryPlanningCostFactors {
   QueryPlanningCostFactors();
   void readFromFile(const std::string& fileName);
   double getCostFactor(const std::string& key) const;
+  // Overwrite the value of the (existing) factor with the given `key`.
+  void setCostFactor(const std::string& key, double value);
 
  private:
   ad_utility::HashMap<std::string, double> _factors;
@@ -0,0 +1,193 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/QueryResultDiskCache.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "util/Log.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/TripleSerializer.h"
+
+namespace {
+// The extension of the files with the stored results.
+constexpr std::string_view fileExtension = ".result";
+}  // namespace
+
+// _____________________________________________________________________________
+QueryResultDiskCache::QueryResultDiskCache(std::filesystem::path directory,
+                                           std::string indexId)
+    : directory_{std::move(directory)}, indexId_{std::move(indexId)} {
+  std::filesystem::create_directories(directory_);
+}
+
+// _____________________________________________________________________________
+bool QueryResultDiskCache::canBeStored(const Result& result) {
+  return result.isFullyMaterialized() && result.localVocab().empty() &&
+         result.localVocab().getOwnedLocalBlankNodeBlocks().empty();
+}
+
+// _____________________________________________________________________________
+std::filesystem::path QueryResultDiskCache::pathForKey(
+    const std::string& cacheKey) const {
+  // The file contains the complete `cacheKey`, so a collision of the hashes
+  // only leads to a cache miss.
+  auto hash = std::hash<std::string>{}(cacheKey);
+  return directory_ /
+         absl::StrCat(absl::Hex(hash, absl::kZeroPad16), fileExtension);
+}
+
+// _____________________________________________________________________________
+void QueryResultDiskCache::store(const std::string& cacheKey,
+                                 const Result& result,
+                                 ad_utility::MemorySize maxSize) const {
+  AD_CONTRACT_CHECK(canBeStored(result));
+  auto path = pathForKey(cacheKey);
+  if (std::filesystem::exists(path)) {
+    return;
+  }
+  // Write to a temporary file first, s.t. a concurrent `load` (or a crash)
+  // never sees an incomplete file.
+  static std::atomic<size_t> tmpFileCounter = 0;
+  auto tmpPath = path;
+  tmpPath += absl::StrCat(".tmp", tmpFileCounter++);
+  try {
+    {
+      ad_utility::serialization::FileWriteSerializer serializer{
+          tmpPath.string()};
+      ad_utility::detail::writeHeader(serializer);
+      serializer << cacheKey;
+      serializer << indexId_;
+      serializer << result.sortedBy();
+      const auto& idTable = result.idTable();
+      serializer << idTable.numRows();
+      serializer << idTable.numColumns();
+      for (const auto& col : idTable.getColumns()) {
+        ad_utility::detail::serializeIds(serializer, col);
+      }
+    }
+    std::filesystem::rename(tmpPath, path);
+  } catch (const std::exception& e) {
+    std::error_code ec;
+    std::filesystem::remove(tmpPath, ec);
+    AD_LOG_WARN << "Could not write a result to the disk cache in "
+                << directory_ << ": " << e.what() << std::endl;
+    return;
+  }
+  removeLeastRecentlyUsed(maxSize);
+}
+
+// _____________________________________________________________________________
+std::optional<Result> QueryResultDiskCache::load(
+    const std::string& cacheKey, const Allocator& allocator) const {
+  auto path = pathForKey(cacheKey);
+  if (!std::filesystem::exists(path)) {
+    return std::nullopt;
+  }
+  try {
+    ad_utility::serialization::FileReadSerializer serializer{path.string()};
+    ad_utility::detail::readHeader(serializer);
+    auto key = ad_utility::detail::readValue<std::string>(serializer);
+    if (key != cacheKey) {
+      // A collision of the hashes of two different keys.
+      return std::nullopt;
+    }
+    auto indexId = ad_utility::detail::readValue<std::string>(serializer);
+    if (indexId != indexId_) {
+      // The result was written for a different index.
+      std::filesystem::remove(path);
+      return std::nullopt;
+    }
+    auto sortedBy =
+        ad_utility::detail::readValue<std::vector<ColumnIndex>>(serializer);
+    auto numRows = ad_utility::detail::readValue<size_t>(serializer);
+    auto numColumns = ad_utility::detail::readValue<size_t>(serializer);
+    IdTable idTable{numColumns, allocator};
+    idTable.resize(numRows);
+    for (auto&& col : idTable.getColumns()) {
+      ad_utility::detail::deserializeIds(serializer, {}, col);
+    }
+    // Mark the file as recently used for `removeLeastRecentlyUsed`.
+    std::error_code ec;
+    std::filesystem::last_write_time(
+        path, std::filesystem::file_time_type::clock::now(), ec);
+    return Result{std::move(idTable), std::move(sortedBy), LocalVocab{}};
+  } catch (const std::exception& e) {
+    // A file that can't be read (e.g. because it has been written by a
+    // different version of QLever) is removed.
+    AD_LOG_WARN << "Could not read the result from the disk cache file "
+                << path << ", the file is removed: " << e.what() << std::endl;
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    return std::nullopt;
+  }
+}
+
+// _____________________________________________________________________________
+void QueryResultDiskCache::removeLeastRecentlyUsed(
+    ad_utility::MemorySize maxSize) const {
+  std::lock_guard lock{evictionMutex_};
+  struct StoredFile {
+    std::filesystem::path path_;
+    std::filesystem::file_time_type lastUsed_;
+    size_t size_;
+  };
+  std::vector<StoredFile> files;
+  size_t totalSize = 0;
+  std::error_code ec;
+  for (const auto& entry :
+       std::filesystem::directory_iterator{directory_, ec}) {
+    if (entry.path().extension().string() != fileExtension) {
+      continue;
+    }
+    files.push_back(StoredFile{entry.path(), entry.last_write_time(ec),
+                               entry.file_size(ec)});
+    totalSize += files.back().size_;
+  }
+  ql::ranges::sort(files, std::less{}, &StoredFile::lastUsed_);
+  for (const auto& file : files) {
+    if (totalSize <= maxSize.getBytes()) {
+      break;
+    }
+    std::filesystem::remove(file.path_, ec);
+    totalSize -= file.size_;
+  }
+}
+
+// _____________________________________________________________________________
+void QueryResultDiskCache::clear() const {
+  std::lock_guard lock{evictionMutex_};
+  std::error_code ec;
+  for (const auto& entry :
+       std::filesystem::directory_iterator{directory_, ec}) {
+    if (entry.path().extension().string() == fileExtension) {
+      std::filesystem::remove(entry.path(), ec);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+ad_utility::MemorySize QueryResultDiskCache::sizeOnDisk() const {
+  size_t totalSize = 0;
+  std::error_code ec;
+  for (const auto& entry :
+       std::filesystem::directory_iterator{directory_, ec}) {
+    if (entry.path().extension().string() == fileExtension) {
+      totalSize += entry.file_size(ec);
+    }
+  }
+  return ad_utility::MemorySize::bytes(totalSize);
+}
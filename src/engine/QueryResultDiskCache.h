@@ -0,0 +1,84 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_QUERYRESULTDISKCACHE_H
+#define QLEVER_SRC_ENGINE_QUERYRESULTDISKCACHE_H
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "engine/Result.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/MemorySize/MemorySize.h"
+
+// An optional second tier of the query result cache (the `QueryResultCache`
+// in `QueryExecutionContext.h`), which stores the results of expensive
+// operations in files in a directory on a local disk. The results thus survive
+// a restart of the engine and their eviction from the (in-memory) cache, and
+// are loaded when they are requested again.
+//
+// Each result is stored in a separate file together with its cache key and the
+// ID of the index (see `Index::getIndexId`). A file that was written for
+// a different index (or with a different format version) is a miss and is
+// removed. The files are written with the serialization functions from
+// `TripleSerializer.h` that are also used for the `NamedResultCache`.
+//
+// The cache key of an operation currently doesn't identify the located delta
+// triples across restarts, so the cache must only be used for queries on an
+// index without any delta triples. Results with a non-empty local vocab are
+// currently not stored.
+class QueryResultDiskCache {
+ public:
+  using Allocator = ad_utility::AllocatorWithLimit<Id>;
+
+ private:
+  std::filesystem::path directory_;
+  std::string indexId_;
+  // Serializes the removal of files when the size limit is exceeded.
+  mutable std::mutex evictionMutex_;
+
+ public:
+  // Create the cache for the index with the given `indexId`. The `directory`
+  // is created if it doesn't exist yet. Results from a previous run (with the
+  // same index) are reused.
+  QueryResultDiskCache(std::filesystem::path directory, std::string indexId);
+
+  // Return true iff the `result` can be stored by this cache.
+  static bool canBeStored(const Result& result);
+
+  // Write the `result` for the given `cacheKey` to disk (unless it is already
+  // stored). Afterward, remove the least recently used files while the total
+  // size exceeds `maxSize`. Errors are logged, but not thrown, because the
+  // disk tier is only an optimization.
+  void store(const std::string& cacheKey, const Result& result,
+             ad_utility::MemorySize maxSize) const;
+
+  // Read the result for the given `cacheKey`, or return `std::nullopt` if it
+  // isn't stored.
+  std::optional<Result> load(const std::string& cacheKey,
+                             const Allocator& allocator) const;
+
+  // Remove all stored results.
+  void clear() const;
+
+  // The total size of all the stored results.
+  ad_utility::MemorySize sizeOnDisk() const;
+
+ private:
+  // The file for the given `cacheKey`.
+  std::filesystem::path pathForKey(const std::string& cacheKey) const;
+
+  // Remove the least recently used files until their total size is at most
+  // `maxSize`.
+  void removeLeastRecentlyUsed(ad_utility::MemorySize maxSize) const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_QUERYRESULTDISKCACHE_H
@@ -0,0 +1,254 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/QueryScheduler.h"
+
+#include <absl/cleanup/cleanup.h>
+#include <absl/strings/str_cat.h>
+
+#include "global/Constants.h"
+#include "global/RuntimeParameters.h"
+#include "util/Exception.h"
+
+namespace net = boost::asio;
+using ad_utility::MemorySize;
+using Priority = QueryScheduler::Priority;
+
+namespace {
+// The maximal number of running queries with the given `priority` (zero means
+// no limit).
+size_t maxNumRunningForPriority(Priority priority) {
+  switch (priority) {
+    case Priority::Interactive:
+      return getRuntimeParameter<
+          &RuntimeParameters::queryMaxRunningInteractive_>();
+    case Priority::Default:
+      return getRuntimeParameter<&RuntimeParameters::queryMaxRunningDefault_>();
+    case Priority::Background:
+      return getRuntimeParameter<
+          &RuntimeParameters::queryMaxRunningBackground_>();
+  }
+  AD_FAIL();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+Priority QueryScheduler::priorityFromString(std::string_view name) {
+  for (auto priority :
+       {Priority::Interactive, Priority::Default, Priority::Background}) {
+    if (name == toString(priority)) {
+      return priority;
+    }
+  }
+  throw std::runtime_error{absl::StrCat(
+      "Invalid value \"", name,
+      "\" for the parameter \"priority\". Allowed values are \"interactive\", "
+      "\"default\", and \"background\"")};
+}
+
+// _____________________________________________________________________________
+std::string_view QueryScheduler::toString(Priority priority) {
+  switch (priority) {
+    case Priority::Interactive:
+      return "interactive";
+    case Priority::Default:
+      return "default";
+    case Priority::Background:
+      return "background";
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+void to_json(nlohmann::json& json,
+             const QueryScheduler::QueuedQueryInfo& info) {
+  json = {
+      {"query", info.query_},
+      {"status", "queued"},
+      {"priority", QueryScheduler::toString(info.priority_)},
+      {"estimated-memory", info.estimatedMemory_.asString()},
+      {"queued-at", ad_utility::websocket::epochMillis(info.queuedAt_)},
+  };
+}
+
+// _____________________________________________________________________________
+QueryScheduler::QueryScheduler(size_t maxNumRunning,
+                               std::function<MemorySize()> getFreeMemory)
+    : maxNumRunning_{maxNumRunning},
+      getFreeMemory_{std::move(getFreeMemory)} {}
+
+// _____________________________________________________________________________
+auto QueryScheduler::Ticket::operator=(Ticket&& other) noexcept -> Ticket& {
+  if (this != &other) {
+    if (scheduler_ != nullptr) {
+      scheduler_->release(priority_, reservedMemory_);
+    }
+    scheduler_ = std::exchange(other.scheduler_, nullptr);
+    priority_ = other.priority_;
+    reservedMemory_ = other.reservedMemory_;
+  }
+  return *this;
+}
+
+// _____________________________________________________________________________
+QueryScheduler::Ticket::~Ticket() {
+  if (scheduler_ != nullptr) {
+    scheduler_->release(priority_, reservedMemory_);
+  }
+}
+
+// _____________________________________________________________________________
+auto QueryScheduler::admitWaitingQueries(State& state)
+    -> std::vector<std::shared_ptr<net::steady_timer>> {
+  // All the modifications of the `state` end with this function.
+  absl::Cleanup publishCounts{[this, &state]() {
+    numRunningWithoutLock_.store(state.numRunningTotal_,
+                                 std::memory_order_relaxed);
+    numWaitingWithoutLock_.store(state.waiting_.size(),
+                                 std::memory_order_relaxed);
+  }};
+  std::vector<std::shared_ptr<net::steady_timer>> admitted;
+  if (state.waiting_.empty()) {
+    return admitted;
+  }
+  std::array<size_t, NUM_PRIORITIES> maxRunning;
+  for (size_t i = 0; i < NUM_PRIORITIES; ++i) {
+    maxRunning[i] = maxNumRunningForPriority(static_cast<Priority>(i));
+  }
+  const bool memoryAware =
+      getRuntimeParameter<&RuntimeParameters::memoryAwareQueryAdmission_>();
+
+  for (size_t i = 0; i < NUM_PRIORITIES; ++i) {
+    const auto priority = static_cast<Priority>(i);
+    for (auto it = state.waiting_.begin(); it != state.waiting_.end();) {
+      auto& waiter = **it;
+      if (waiter.info_.priority_ != priority) {
+        ++it;
+        continue;
+      }
+      if (maxNumRunning_ != 0 && state.numRunningTotal_ >= maxNumRunning_) {
+        return admitted;
+      }
+      if (maxRunning[i] != 0 && state.numRunning_[i] >= maxRunning[i]) {
+        // The other waiting queries with this priority can't be admitted
+        // either, but the ones with a lower priority can.
+        break;
+      }
+      const auto& estimate = waiter.info_.estimatedMemory_;
+      if (memoryAware && state.numRunningTotal_ > 0) {
+        auto freeMemory = getFreeMemory_();
+        auto available = freeMemory > state.reservedMemory_
+                             ? freeMemory - state.reservedMemory_
+                             : MemorySize::bytes(0);
+        if (estimate > available) {
+          return admitted;
+        }
+      }
+      waiter.admitted_ = true;
+      ++state.numRunning_[i];
+      ++state.numRunningTotal_;
+      state.reservedMemory_ += estimate;
+      admitted.push_back(waiter.timer_);
+      it = state.waiting_.erase(it);
+    }
+  }
+  return admitted;
+}
+
+// _____________________________________________________________________________
+void QueryScheduler::wakeUp(
+    std::vector<std::shared_ptr<net::steady_timer>> timers) {
+  for (auto& timer : timers) {
+    auto executor = timer->get_executor();
+    net::dispatch(executor, [timer = std::move(timer)]() { timer->cancel(); });
+  }
+}
+
+// _____________________________________________________________________________
+void QueryScheduler::release(Priority priority, MemorySize reservedMemory) {
+  wakeUp(state_.withWriteLock([&](State& state) {
+    const auto i = static_cast<size_t>(priority);
+    AD_CORRECTNESS_CHECK(state.numRunning_[i] > 0 &&
+                         state.numRunningTotal_ > 0);
+    --state.numRunning_[i];
+    --state.numRunningTotal_;
+    state.reservedMemory_ -= reservedMemory;
+    return admitWaitingQueries(state);
+  }));
+}
+
+// _____________________________________________________________________________
+net::awaitable<QueryScheduler::Ticket> QueryScheduler::admit(
+    ad_utility::websocket::QueryId queryId, std::string_view query,
+    Priority priority, MemorySize estimatedMemory,
+    ad_utility::SharedCancellationHandle cancellationHandle) {
+  auto executor = co_await net::this_coro::executor;
+  auto waiter = std::make_shared<Waiter>(
+      Waiter{QueuedQueryInfo{std::move(queryId), std::string{query}, priority,
+                             estimatedMemory, std::chrono::system_clock::now()},
+             std::make_shared<net::steady_timer>(executor), false});
+  wakeUp(state_.withWriteLock([&](State& state) {
+    state.waiting_.push_back(waiter);
+    // Typically only the `waiter` itself is admitted here, but the limits might
+    // have been changed since the last call.
+    return admitWaitingQueries(state);
+  }));
+  // If the coroutine is left without returning the `Ticket` (because the query
+  // was cancelled, or the coroutine was destroyed), undo the waiting.
+  bool ticketReturned = false;
+  absl::Cleanup withdrawOnExit{[this, &waiter, &ticketReturned]() {
+    if (!ticketReturned) {
+      withdraw(*waiter);
+    }
+  }};
+
+  auto isAdmitted = [this, &waiter]() {
+    return state_.withReadLock(
+        [&waiter](const State&) { return waiter->admitted_; });
+  };
+  while (!isAdmitted()) {
+    // The timer is cancelled when the query is admitted. Because we are on a
+    // strand, this can't happen between the above check and the waiting. The
+    // timeout is only used to check the `cancellationHandle` regularly.
+    waiter->timer_->expires_after(DESIRED_CANCELLATION_CHECK_INTERVAL);
+    co_await waiter->timer_->async_wait(net::as_tuple(net::use_awaitable));
+    cancellationHandle->throwIfCancelled();
+  }
+  ticketReturned = true;
+  co_return Ticket{this, priority, estimatedMemory};
+}
+
+// _____________________________________________________________________________
+void QueryScheduler::withdraw(Waiter& waiter) {
+  wakeUp(state_.withWriteLock([this, &waiter](State& state) {
+    if (waiter.admitted_) {
+      const auto i = static_cast<size_t>(waiter.info_.priority_);
+      --state.numRunning_[i];
+      --state.numRunningTotal_;
+      state.reservedMemory_ -= waiter.info_.estimatedMemory_;
+    } else {
+      state.waiting_.remove_if(
+          [&waiter](const auto& other) { return other.get() == &waiter; });
+    }
+    // The withdrawn query might have blocked other queries.
+    return admitWaitingQueries(state);
+  }));
+}
+
+// _____________________________________________________________________________
+auto QueryScheduler::getQueuedQueries() const
+    -> std::vector<QueuedQueryInfo> {
+  return state_.withReadLock([](const State& state) {
+    std::vector<QueuedQueryInfo> result;
+    for (const auto& waiter : state.waiting_) {
+      result.push_back(waiter->info_);
+    }
+    return result;
+  });
+}
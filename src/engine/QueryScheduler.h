@@ -0,0 +1,170 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_QUERYSCHEDULER_H
+#define QLEVER_SRC_ENGINE_QUERYSCHEDULER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "util/CancellationHandle.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+#include "util/http/beast.h"
+#include "util/http/websocket/QueryId.h"
+#include "util/json.h"
+
+// Admission control for the queries of the `Server`. Before a query is
+// executed, it has to obtain a `Ticket` from the scheduler, which it keeps
+// until its result has been sent. The scheduler admits a waiting query only
+// if
+// 1. Fewer than `maxNumRunning` queries are running in total.
+// 2. Fewer than the configured limit (see the runtime parameters
+//    `query-max-running-<priority>`) of queries with the same priority are
+//    running.
+// 3. If the runtime parameter `memory-aware-query-admission` is set: The
+//    estimated memory of the query fits into the free memory of the
+//    allocator (minus the estimates of the other running queries), or no
+//    other query is running.
+// The waiting queries are admitted in the order of their priority and then in
+// the order of their arrival. A query that can't be admitted because of (1) or
+// (3) also blocks the queries behind it, s.t. large queries don't starve.
+class QueryScheduler {
+ public:
+  // The priority classes, from the highest to the lowest priority.
+  enum class Priority { Interactive, Default, Background };
+  static constexpr size_t NUM_PRIORITIES = 3;
+
+  // Conversion from and to the names that are used for the URL parameter
+  // `priority` and the runtime parameters. `fromString` throws on an invalid
+  // name.
+  static Priority priorityFromString(std::string_view name);
+  static std::string_view toString(Priority priority);
+
+  // The information about a waiting query, see `getQueuedQueries`.
+  struct QueuedQueryInfo {
+    ad_utility::websocket::QueryId queryId_;
+    std::string query_;
+    Priority priority_;
+    ad_utility::MemorySize estimatedMemory_;
+    std::chrono::system_clock::time_point queuedAt_;
+
+    friend void to_json(nlohmann::json& json, const QueuedQueryInfo& info);
+  };
+
+ private:
+  struct Waiter {
+    QueuedQueryInfo info_;
+    // Is cancelled to wake up the waiting coroutine once it is admitted.
+    std::shared_ptr<boost::asio::steady_timer> timer_;
+    bool admitted_ = false;
+  };
+
+  struct State {
+    std::array<size_t, NUM_PRIORITIES> numRunning_{};
+    size_t numRunningTotal_ = 0;
+    ad_utility::MemorySize reservedMemory_;
+    std::list<std::shared_ptr<Waiter>> waiting_;
+  };
+
+  size_t maxNumRunning_;
+  std::function<ad_utility::MemorySize()> getFreeMemory_;
+  ad_utility::Synchronized<State> state_;
+  // Copies of the number of running and waiting queries in the `state_`, s.t.
+  // they can be read without taking the lock. They are updated at the end of
+  // each modification of the `state_`, see `admitWaitingQueries`.
+  std::atomic<size_t> numRunningWithoutLock_ = 0;
+  std::atomic<size_t> numWaitingWithoutLock_ = 0;
+
+ public:
+  // A running query. On destruction (or when moved from), the query is no
+  // longer running and the next waiting queries can be admitted.
+  class Ticket {
+    QueryScheduler* scheduler_;
+    Priority priority_;
+    ad_utility::MemorySize reservedMemory_;
+
+    friend class QueryScheduler;
+    Ticket(QueryScheduler* scheduler, Priority priority,
+           ad_utility::MemorySize reservedMemory)
+        : scheduler_{scheduler},
+          priority_{priority},
+          reservedMemory_{reservedMemory} {}
+
+   public:
+    Ticket(Ticket&& other) noexcept
+        : scheduler_{std::exchange(other.scheduler_, nullptr)},
+          priority_{other.priority_},
+          reservedMemory_{other.reservedMemory_} {}
+    Ticket& operator=(Ticket&& other) noexcept;
+    Ticket(const Ticket&) = delete;
+    Ticket& operator=(const Ticket&) = delete;
+    ~Ticket();
+  };
+
+  // At most `maxNumRunning` queries (zero means no limit) are running at the
+  // same time. `getFreeMemory` returns the currently free memory of the
+  // allocator that is used by the queries.
+  QueryScheduler(size_t maxNumRunning,
+                 std::function<ad_utility::MemorySize()> getFreeMemory);
+
+  // Wait until the query can be admitted and return its `Ticket`. While
+  // waiting, the `cancellationHandle` is checked regularly. Must be called on a
+  // strand (like all the coroutines of the `HttpServer`), because the timer
+  // that is used for the waiting is not threadsafe.
+  boost::asio::awaitable<Ticket> admit(
+      ad_utility::websocket::QueryId queryId, std::string_view query,
+      Priority priority, ad_utility::MemorySize estimatedMemory,
+      ad_utility::SharedCancellationHandle cancellationHandle);
+
+  // A snapshot of the currently waiting queries, in the order of their
+  // arrival.
+  std::vector<QueuedQueryInfo> getQueuedQueries() const;
+
+  // The number of currently running queries.
+  size_t numRunning() const { return state_.rlock()->numRunningTotal_; }
+
+  // The number of running and waiting queries, without taking the lock (e.g.
+  // for the `/metrics` endpoint of the server). The values might be outdated
+  // by concurrent modifications.
+  size_t numRunningWithoutLock() const {
+    return numRunningWithoutLock_.load(std::memory_order_relaxed);
+  }
+  size_t numWaitingWithoutLock() const {
+    return numWaitingWithoutLock_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Admit as many waiting queries as possible (see the class comment) and
+  // return the timers of the admitted queries, which have to be cancelled
+  // after the lock on the `state` has been released.
+  std::vector<std::shared_ptr<boost::asio::steady_timer>> admitWaitingQueries(
+      State& state);
+
+  // Wake up the coroutines that wait for the `timers`.
+  static void wakeUp(
+      std::vector<std::shared_ptr<boost::asio::steady_timer>> timers);
+
+  // Called by the destructor of the `Ticket`.
+  void release(Priority priority, ad_utility::MemorySize reservedMemory);
+
+  // Remove the `waiter` from the queue, or release its slot if it has already
+  // been admitted, but the `Ticket` was never handed out.
+  void withdraw(Waiter& waiter);
+};
+
+#endif  // QLEVER_SRC_ENGINE_QUERYSCHEDULER_H
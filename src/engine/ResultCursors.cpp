@@ -0,0 +1,116 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/ResultCursors.h"
+
+#include <absl/strings/str_cat.h>
+
+// _____________________________________________________________________________
+ad_utility::MemorySize ResultCursors::CursorResult::memorySize() const {
+  return ad_utility::MemorySize::bytes(table_->numRows() *
+                                       table_->numColumns() * sizeof(Id));
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<ExplicitIdTableOperation>
+ResultCursors::CursorResult::toOperation(QueryExecutionContext* qec,
+                                         std::string_view cursorId) const {
+  return std::make_shared<ExplicitIdTableOperation>(
+      qec, table_, variables_, sortedOn_, localVocab_.clone(),
+      absl::StrCat("Cursor ", cursorId));
+}
+
+// _____________________________________________________________________________
+std::string ResultCursors::create(CursorResult result,
+                                  ad_utility::MemorySize memoryBudget) {
+  AD_CONTRACT_CHECK(result.beginRow_ <= result.endRow_ &&
+                    result.endRow_ <= result.table_->numRows());
+  auto size = result.memorySize();
+  auto state = state_.wlock();
+  if (state->memoryInUse_ + size > memoryBudget) {
+    throw std::runtime_error(absl::StrCat(
+        "The result of the query (", size.asString(),
+        ") does not fit into the memory that is left for cursors (",
+        (memoryBudget - std::min(memoryBudget, state->memoryInUse_))
+            .asString(),
+        "), close other cursors or use LIMIT and OFFSET instead"));
+  }
+  std::string id = state->generateId_();
+  size_t beginRow = result.beginRow_;
+  state->cursors_.emplace(
+      id, Cursor{std::make_shared<const CursorResult>(std::move(result)),
+                 beginRow, Clock::now()});
+  state->memoryInUse_ += size;
+  return id;
+}
+
+// _____________________________________________________________________________
+auto ResultCursors::fetch(const std::string& cursorId, size_t maxNumRows)
+    -> Page {
+  auto state = state_.wlock();
+  auto it = state->cursors_.find(cursorId);
+  if (it == state->cursors_.end()) {
+    throw std::runtime_error(absl::StrCat(
+        "There is no cursor with ID \"", cursorId,
+        "\", it might have been exhausted, closed, or expired"));
+  }
+  auto& cursor = it->second;
+  size_t endRow = cursor.result_->endRow_;
+  Page page{cursor.result_, cursor.nextRow_,
+            cursor.nextRow_ + std::min(maxNumRows, endRow - cursor.nextRow_)};
+  page.hasMoreRows_ = page.endRow_ < endRow;
+  if (page.hasMoreRows_) {
+    cursor.nextRow_ = page.endRow_;
+    cursor.lastAccess_ = Clock::now();
+  } else {
+    remove(*state, it);
+  }
+  return page;
+}
+
+// _____________________________________________________________________________
+bool ResultCursors::close(const std::string& cursorId) {
+  auto state = state_.wlock();
+  auto it = state->cursors_.find(cursorId);
+  if (it == state->cursors_.end()) {
+    return false;
+  }
+  remove(*state, it);
+  return true;
+}
+
+// _____________________________________________________________________________
+void ResultCursors::removeIdleCursors(Clock::duration idleTimeout) {
+  auto now = Clock::now();
+  auto state = state_.wlock();
+  for (auto it = state->cursors_.begin(); it != state->cursors_.end();) {
+    // Advance the iterator before the cursor is erased.
+    auto current = it++;
+    if (now - current->second.lastAccess_ >= idleTimeout) {
+      remove(*state, current);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+size_t ResultCursors::numCursors() const {
+  return state_.rlock()->cursors_.size();
+}
+
+// _____________________________________________________________________________
+ad_utility::MemorySize ResultCursors::memoryInUse() const {
+  return state_.rlock()->memoryInUse_;
+}
+
+// _____________________________________________________________________________
+void ResultCursors::remove(State& state,
+                           decltype(State::cursors_)::iterator it) {
+  state.memoryInUse_ -= it->second.result_->memorySize();
+  state.cursors_.erase(it);
+}
@@ -0,0 +1,113 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_RESULTCURSORS_H
+#define QLEVER_SRC_ENGINE_RESULTCURSORS_H
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "engine/ExplicitIdTableOperation.h"
+#include "engine/idTable/IdTable.h"
+#include "parser/ParsedQuery.h"
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Random.h"
+#include "util/Synchronized.h"
+
+// The server-side cursors over the results of queries, s.t. a client can page
+// through a large result (see the URL parameter `cursor-page-size` and the
+// command `fetch-cursor` of the `Server`) without the query being recomputed
+// (or its result being scanned up to the offset) for each page, as it would be
+// for repeated queries with `LIMIT` and `OFFSET`.
+//
+// A cursor holds the fully materialized result of a query and the position of
+// the next page. It is removed when its last page has been fetched, when it is
+// closed explicitly, or when it has not been used for some time. The results
+// of all the cursors must fit into a memory budget.
+class ResultCursors {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // The result of a query to which a cursor refers.
+  struct CursorResult {
+    // The query, for the export of the pages.
+    ParsedQuery parsedQuery_;
+    std::shared_ptr<const IdTable> table_;
+    VariableToColumnMap variables_;
+    std::vector<ColumnIndex> sortedOn_;
+    LocalVocab localVocab_;
+    // The range of the rows of the `table_` that belong to the result (the
+    // `LIMIT` and `OFFSET` of the query might not have been applied to the
+    // `table_` yet).
+    size_t beginRow_ = 0;
+    size_t endRow_ = 0;
+
+    // The size of the `table_`.
+    ad_utility::MemorySize memorySize() const;
+
+    // An operation that yields the `table_`, which can be used to export a
+    // page of the result.
+    std::shared_ptr<ExplicitIdTableOperation> toOperation(
+        QueryExecutionContext* qec, std::string_view cursorId) const;
+  };
+
+  // The next page of a cursor: The rows `[beginRow_, endRow_)` of the `result_`
+  // of the cursor, and whether there are more rows after the page.
+  struct Page {
+    std::shared_ptr<const CursorResult> result_;
+    size_t beginRow_ = 0;
+    size_t endRow_ = 0;
+    bool hasMoreRows_ = false;
+  };
+
+ private:
+  struct Cursor {
+    std::shared_ptr<const CursorResult> result_;
+    // The first row of the next page.
+    size_t nextRow_ = 0;
+    Clock::time_point lastAccess_;
+  };
+  struct State {
+    ad_utility::HashMap<std::string, Cursor> cursors_;
+    ad_utility::MemorySize memoryInUse_ = ad_utility::MemorySize::bytes(0);
+    ad_utility::UuidGenerator generateId_;
+  };
+  ad_utility::Synchronized<State> state_;
+
+ public:
+  // Create a cursor for the `result` and return its ID. Throw if the results
+  // of all the cursors would exceed the `memoryBudget`.
+  std::string create(CursorResult result, ad_utility::MemorySize memoryBudget);
+
+  // Return the next page (with at most `maxNumRows` rows) of the cursor with
+  // the given ID and advance the cursor. The cursor is removed if the page is
+  // its last page. Throw if there is no such cursor.
+  Page fetch(const std::string& cursorId, size_t maxNumRows);
+
+  // Remove the cursor with the given ID. Return false if there is no such
+  // cursor.
+  bool close(const std::string& cursorId);
+
+  // Remove all the cursors that have not been used for at least the
+  // `idleTimeout`.
+  void removeIdleCursors(Clock::duration idleTimeout);
+
+  // The number of open cursors and the memory of their results.
+  size_t numCursors() const;
+  ad_utility::MemorySize memoryInUse() const;
+
+ private:
+  // Remove the cursor the iterator of which is `it`.
+  static void remove(State& state, decltype(State::cursors_)::iterator it);
+};
+
+#endif  // QLEVER_SRC_ENGINE_RESULTCURSORS_H
@@ -78,6 +78,15 @@ void RuntimeInformation::writeToStream(std::ostream& out, size_t indent) const {
       << '\n';
   out << indentStr(indent) << "operation_time: " << toMs(getOperationTime())
       << " ms" << '\n';
+  out << indentStr(indent) << "cpu_time: " << toMs(cpuTime_) << " ms" << '\n';
+  if (peakMemoryUsage_.getBytes() > 0) {
+    out << indentStr(indent)
+        << "peak_memory_usage: " << peakMemoryUsage_.asString() << '\n';
+  }
+  if (numBytesRead_ > 0) {
+    out << indentStr(indent) << "bytes_read: " << numBytesRead_
+        << ", bytes_decompressed: " << numBytesDecompressed_ << '\n';
+  }
   out << indentStr(indent) << "status: " << toString(status_) << '\n';
   out << indentStr(indent)
       << "cache_status: " << ad_utility::toString(cacheStatus_) << '\n';
@@ -156,6 +165,37 @@ std::chrono::microseconds RuntimeInformation::getOperationTime() const {
   }
 }
 
+// __________________________________________________________________________
+std::chrono::microseconds RuntimeInformation::getOperationCpuTime() const {
+  if (cacheStatus_ != ad_utility::CacheStatus::computed) {
+    return cpuTime_;
+  }
+  auto timesOfChildren =
+      children_ | ql::views::transform(&RuntimeInformation::cpuTime_);
+  return std::max(0us, cpuTime_ - ::ranges::accumulate(timesOfChildren, 0us));
+}
+
+// __________________________________________________________________________
+auto RuntimeInformation::getSubtreeCounters() const -> SubtreeCounters {
+  SubtreeCounters counters;
+  counters.numBytesRead_ = numBytesRead_;
+  counters.numBytesDecompressed_ = numBytesDecompressed_;
+  if (cacheStatus_ == ad_utility::CacheStatus::cachedNotPinned ||
+      cacheStatus_ == ad_utility::CacheStatus::cachedPinned) {
+    ++counters.numCacheHits_;
+  } else if (cacheStatus_ == ad_utility::CacheStatus::computed) {
+    ++counters.numCacheMisses_;
+  }
+  for (const auto& child : children_) {
+    auto childCounters = child->getSubtreeCounters();
+    counters.numBytesRead_ += childCounters.numBytesRead_;
+    counters.numBytesDecompressed_ += childCounters.numBytesDecompressed_;
+    counters.numCacheHits_ += childCounters.numCacheHits_;
+    counters.numCacheMisses_ += childCounters.numCacheMisses_;
+  }
+  return counters;
+}
+
 // __________________________________________________________________________
 size_t RuntimeInformation::getOperationCostEstimate() const {
   size_t result = costEstimate_;
@@ -199,6 +239,7 @@ void to_json(nlohmann::ordered_json& j,
 
 // ________________________________________________________________________________________________________________
 void to_json(nlohmann::ordered_json& j, const RuntimeInformation& rti) {
+  auto subtreeCounters = rti.getSubtreeCounters();
   j = nlohmann::ordered_json{
       {"description", rti.descriptor_},
       {"result_rows", rti.numRows_},
@@ -208,6 +249,15 @@ void to_json(nlohmann::ordered_json& j, const RuntimeInformation& rti) {
       {"operation_time", toMs(rti.getOperationTime())},
       {"original_total_time", toMs(rti.originalTotalTime_)},
       {"original_operation_time", toMs(rti.originalOperationTime_)},
+      {"cpu_time", toMs(rti.cpuTime_)},
+      {"operation_cpu_time", toMs(rti.getOperationCpuTime())},
+      {"peak_memory_usage", rti.peakMemoryUsage_.getBytes()},
+      {"bytes_read", rti.numBytesRead_},
+      {"bytes_decompressed", rti.numBytesDecompressed_},
+      {"subtree_bytes_read", subtreeCounters.numBytesRead_},
+      {"subtree_bytes_decompressed", subtreeCounters.numBytesDecompressed_},
+      {"subtree_cache_hits", subtreeCounters.numCacheHits_},
+      {"subtree_cache_misses", subtreeCounters.numCacheMisses_},
       {"cache_status", ad_utility::toString(rti.cacheStatus_)},
       {"details", rti.details_},
       {"estimated_total_cost", rti.costEstimate_},
@@ -222,7 +272,10 @@ void to_json(nlohmann::ordered_json& j, const RuntimeInformation& rti) {
 void to_json(nlohmann::ordered_json& j,
              const RuntimeInformationWholeQuery& rti) {
   j = nlohmann::ordered_json{
-      {"time_query_planning", rti.timeQueryPlanning.count()}};
+      {"time_query_planning", rti.timeQueryPlanning.count()},
+      {"time_query_plan_improvement", rti.timeQueryPlanImprovement.count()},
+      {"vocab_decode_cache_hits", rti.numVocabDecodeCacheHits},
+      {"vocab_decode_cache_misses", rti.numVocabDecodeCacheMisses}};
 }
 
 // __________________________________________________________________________
@@ -13,6 +13,7 @@
 #include "engine/VariableToColumnMap.h"
 #include "parser/data/LimitOffsetClause.h"
 #include "util/ConcurrentCache.h"
+#include "util/MemorySize/MemorySize.h"
 #include "util/json.h"
 
 /// A class to store information about the status of an operation (result size,
@@ -58,6 +59,28 @@ class RuntimeInformation {
   Microseconds originalTotalTime_ = ZERO;
   Microseconds originalOperationTime_ = ZERO;
 
+  /// The CPU time of the thread that computed this operation. Like the
+  /// `totalTime_`, this includes the computation of the children (unless they
+  /// were computed on a different thread). The work of other threads (e.g. of
+  /// a parallel sort) is not included. For a lazily computed result, only the
+  /// time until the generator was returned is included, the computation of
+  /// the single chunks counts for the operation that consumes them.
+  Microseconds cpuTime_ = ZERO;
+
+  /// The number of bytes that were read from the index files (possibly from
+  /// the page cache of the operating system), and the number of bytes that
+  /// they were decompressed to. These are only set for the operations that
+  /// directly read from the index (e.g. `IndexScan`) and don't include the
+  /// children, see `getSubtreeCounters`.
+  size_t numBytesRead_ = 0;
+  size_t numBytesDecompressed_ = 0;
+
+  /// The peak of the memory that was allocated from the memory limit of the
+  /// query engine during the computation of this operation (including the
+  /// children), relative to the memory that was allocated at its start, see
+  /// `ad_utility::PeakMemoryUsageMeasurement` for the details.
+  ad_utility::MemorySize peakMemoryUsage_;
+
   /// The estimated cost, size, and column multiplicities of the operation.
   size_t costEstimate_ = 0;
   size_t sizeEstimate_ = 0;
@@ -106,6 +129,21 @@ class RuntimeInformation {
   /// the time spent computing the children, but always positive.
   [[nodiscard]] Microseconds getOperationTime() const;
 
+  /// Get the CPU time spent computing the operation. This is the `cpuTime_`
+  /// minus the CPU time of the children, but always positive.
+  [[nodiscard]] Microseconds getOperationCpuTime() const;
+
+  /// Counters that are summed up over all the operations of a subtree.
+  struct SubtreeCounters {
+    size_t numBytesRead_ = 0;
+    size_t numBytesDecompressed_ = 0;
+    // The number of operations the result of which was read from the cache
+    // or computed.
+    size_t numCacheHits_ = 0;
+    size_t numCacheMisses_ = 0;
+  };
+  [[nodiscard]] SubtreeCounters getSubtreeCounters() const;
+
   /// Get the cost estimate for this operation. This is the total cost estimate
   /// minus the sum of the cost estimates of all children.
   [[nodiscard]] size_t getOperationCostEstimate() const;
@@ -154,6 +192,13 @@ struct RuntimeInformationWholeQuery {
   // The time spent during query planning (this does not include the time spent
   // on `IndexScan`s that were executed during the query planning).
   std::chrono::milliseconds timeQueryPlanning = RuntimeInformation::ZERO;
+  // The part of the `timeQueryPlanning` that was spent on improving the greedy
+  // query plans for large queries (see `QueryPlanner.h`).
+  std::chrono::milliseconds timeQueryPlanImprovement = RuntimeInformation::ZERO;
+  // The number of hits and misses of the `VocabDecodeCache` of the query,
+  // i.e. how often the decompression of a vocabulary word could be avoided.
+  size_t numVocabDecodeCacheHits = 0;
+  size_t numVocabDecodeCacheMisses = 0;
   /// Output as json. The signature of this function is mandated by the json
   /// library to allow for implicit conversion.
   friend void to_json(nlohmann::ordered_json& j,
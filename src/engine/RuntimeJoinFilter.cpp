@@ -0,0 +1,54 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/RuntimeJoinFilter.h"
+
+#include <algorithm>
+
+#include "util/Exception.h"
+
+// _____________________________________________________________________________
+RuntimeJoinFilter::RuntimeJoinFilter(std::shared_ptr<const Result> result,
+                                     ColumnIndex column)
+    : result_{std::move(result)} {
+  AD_CONTRACT_CHECK(result_ != nullptr && result_->isFullyMaterialized());
+  keys_ = result_->idTable().getColumn(column);
+  AD_CONTRACT_CHECK(keys_.empty() || !keys_.front().isUndefined());
+  AD_EXPENSIVE_CHECK(ql::ranges::is_sorted(keys_));
+}
+
+// _____________________________________________________________________________
+bool RuntimeJoinFilter::contains(Id id) const {
+  return std::binary_search(keys_.begin(), keys_.end(), id);
+}
+
+// _____________________________________________________________________________
+void RuntimeJoinFilter::filterRows(IdTable& idTable, ColumnIndex column) const {
+  decltype(auto) col = idTable.getColumn(column);
+  IdTable result{idTable.numColumns(), idTable.getAllocator()};
+  // Copy the maximal ranges of matching rows.
+  size_t begin = 0;
+  while (begin < col.size()) {
+    if (!contains(col[begin])) {
+      ++begin;
+      continue;
+    }
+    size_t end = begin + 1;
+    while (end < col.size() && contains(col[end])) {
+      ++end;
+    }
+    if (begin == 0 && end == col.size()) {
+      // All the rows match, nothing has to be copied.
+      return;
+    }
+    result.insertAtEnd(idTable, begin, end);
+    begin = end;
+  }
+  idTable = std::move(result);
+}
@@ -0,0 +1,46 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_RUNTIMEJOINFILTER_H
+#define QLEVER_SRC_ENGINE_RUNTIMEJOINFILTER_H
+
+#include <memory>
+
+#include "engine/Result.h"
+#include "engine/idTable/IdTable.h"
+#include "global/Id.h"
+
+// The set of values of the join column of the (small) materialized input of a
+// `Join`. It is pushed into the other input of the join before that input is
+// computed (see `Operation::addRuntimeJoinFilter`), s.t. an `IndexScan` deep
+// inside of the other input can skip the blocks and rows that can't have a
+// join partner, before they are processed by the operations above it (for
+// example by a `FILTER` or a `BIND`).
+class RuntimeJoinFilter {
+  // Keeps the `keys_` alive.
+  std::shared_ptr<const Result> result_;
+  ql::span<const Id> keys_;
+
+ public:
+  // The `column` of the fully materialized `result` is used as the set of
+  // keys. It must be sorted and must not contain UNDEF values.
+  RuntimeJoinFilter(std::shared_ptr<const Result> result, ColumnIndex column);
+
+  // The sorted keys (possibly with duplicates).
+  ql::span<const Id> keys() const { return keys_; }
+
+  // Return true iff the `id` is one of the keys.
+  bool contains(Id id) const;
+
+  // Remove all the rows of the `idTable` whose entry in the `column` is not one
+  // of the keys. The order of the remaining rows is preserved.
+  void filterRows(IdTable& idTable, ColumnIndex column) const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_RUNTIMEJOINFILTER_H
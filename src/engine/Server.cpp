@@ -10,14 +10,19 @@
 #include "engine/Server.h"
 
 #include <absl/functional/bind_front.h>
+#include <absl/strings/numbers.h>
 #include <absl/strings/str_cat.h>
 #include <absl/strings/str_join.h>
 
+#include <sstream>
 #include <string>
 #include <variant>
 #include <vector>
 
 #include "CompilationInfo.h"
+#include "engine/BinaryExport.h"
+#include "engine/CacheWarmup.h"
+#include "engine/CsrGraph.h"
 #include "engine/ExecuteUpdate.h"
 #include "engine/ExportQueryExecutionTrees.h"
 #include "engine/GraphStoreProtocol.h"
@@ -25,9 +30,12 @@
 #include "engine/MaterializedViews.h"
 #include "engine/QueryExecutionContext.h"
 #include "engine/QueryPlanner.h"
+#include "engine/ServerMetrics.h"
 #include "engine/SparqlProtocol.h"
 #include "engine/UpdateMetadata.h"
 #include "global/RuntimeParameters.h"
+#include "index/CompressedRelation.h"
+#include "index/DecompressedBlockCache.h"
 #include "index/IndexImpl.h"
 #include "index/IndexRebuilder.h"
 #include "libqlever/Qlever.h"
@@ -38,8 +46,10 @@
 #include "util/MemorySize/MemorySize.h"
 #include "util/ParseableDuration.h"
 #include "util/QueryEventLog.h"
+#include "util/SpanTracer.h"
 #include "util/TimeTracer.h"
 #include "util/TypeTraits.h"
+#include "util/http/HttpClient.h"
 #include "util/http/HttpServer.h"
 #include "util/http/HttpUtils.h"
 #include "util/http/websocket/MessageSender.h"
@@ -51,16 +61,49 @@ template <typename T>
 using Awaitable = Server::Awaitable<T>;
 using ad_utility::MediaType;
 
+namespace {
+// Return the value of the URL parameter `cursor`, throw if it is missing.
+std::string requireCursorId(
+    const ad_utility::url_parser::ParamValueMap& parameters) {
+  auto cursorId =
+      ad_utility::url_parser::getParameterCheckAtMostOnce(parameters, "cursor");
+  if (!cursorId.has_value()) {
+    throw std::runtime_error(
+        "The ID of the cursor must be specified via the URL parameter "
+        "`cursor`");
+  }
+  return std::move(cursorId).value();
+}
+
+// Yield the `chunks` and keep the `owner` alive until they have all been
+// yielded (the `chunks` typically refer to the `owner`).
+template <typename Owner>
+cppcoro::generator<std::string> keepAlive(
+    std::shared_ptr<Owner> owner, cppcoro::generator<std::string> chunks) {
+  // Move the `chunks` into a local variable, s.t. they are destroyed before
+  // the `owner`.
+  auto ownedChunks = std::move(chunks);
+  for (auto& chunk : ownedChunks) {
+    co_yield chunk;
+  }
+}
+}  // namespace
+
 // __________________________________________________________________________
 Server::Server(unsigned short port, size_t numThreads, std::string accessToken,
                const qlever::EngineConfig& config, bool noAccessCheck)
     : qlever_(config),
+      memoryLimit_(config.memoryLimit_.value_or(DEFAULT_MEM_FOR_QUERIES)),
       numThreads_(numThreads),
       port_(port),
       accessToken_(std::move(accessToken)),
       noAccessCheck_(noAccessCheck),
-      queryThreadPool_{numThreads} {
+      queryThreadPool_{numThreads},
+      queryScheduler_{numThreads,
+                      [this]() { return allocator().amountMemoryLeft(); }} {
   AD_LOG_INFO << "Initializing server ..." << std::endl;
+  costFactorCalibration_.setPersistenceFile(config.baseName_ +
+                                            ".cost-factor-calibration.json");
 
   if (noAccessCheck_) {
     AD_LOG_INFO << "No access token required for restricted API calls"
@@ -87,6 +130,59 @@ void Server::configureQueryEventLog(const std::filesystem::path& path) {
   queryRegistry_.addOnEnd(std::move(logEvent));
 }
 
+// _____________________________________________________________________________
+void Server::configureCacheWarmup(const std::filesystem::path& file,
+                                  size_t maxNumQueries) {
+  AD_CONTRACT_CHECK(cacheWarmup_ == nullptr,
+                    "The cache warm-up may only be configured once.");
+  auto executeQuery = [this](const std::string& query) {
+    auto qec = qlever().createQueryExecutionContext(
+        [](std::string) {}, /*pinSubtrees=*/true, /*pinResult=*/true);
+    auto parsedQuery =
+        SparqlParser::parseQuery(&index().encodedIriManager(), query, {});
+    QueryPlanner qp{qec.get(),
+                    std::make_shared<ad_utility::CancellationHandle<>>()};
+    auto qet = qp.createExecutionTree(parsedQuery);
+    qet.isRoot() = true;
+    [[maybe_unused]] auto result = qet.getResult();
+  };
+  // A warm-up query is only started while no other query is running.
+  auto isIdle = [this]() { return queryScheduler_.numRunning() == 0; };
+  cacheWarmup_ = std::make_unique<CacheWarmup>(
+      CacheWarmup::readQueries(file, maxNumQueries), std::move(executeQuery),
+      std::move(isIdle));
+}
+
+// _____________________________________________________________________________
+void Server::configureReplicationFrom(const std::string& primaryUrl,
+                                      std::chrono::milliseconds pollInterval) {
+  AD_CONTRACT_CHECK(replica_ == nullptr,
+                    "The replication may only be configured once.");
+  auto fetchRecords = [primaryUrl](uint64_t sequenceNumber) {
+    ad_utility::httpUtils::Url url{absl::StrCat(
+        primaryUrl, "?cmd=replication-log&since=", sequenceNumber)};
+    auto response = ad_utility::httpUtils::sendHttpOrHttpsRequest(
+        url, std::make_shared<ad_utility::CancellationHandle<>>(),
+        http::verb::get, "", "text/plain",
+        ad_utility::toString(MediaType::octetStream));
+    std::string body;
+    for (const auto& bytes : response.body_) {
+      body.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    }
+    if (response.status_ != http::status::ok) {
+      throw std::runtime_error(absl::StrCat(
+          "The primary responded with HTTP status code ",
+          static_cast<int>(response.status_), ": ", body));
+    }
+    return body;
+  };
+  AD_LOG_INFO << "Replicating the updates of the primary server at "
+              << primaryUrl << std::endl;
+  replica_ = std::make_unique<DeltaTriplesReplica>(
+      index().deltaTriplesManager(), index().getImpl(),
+      std::move(fetchRecords), pollInterval);
+}
+
 // _____________________________________________________________________________
 void Server::run() {
   using namespace ad_utility::httpUtils;
@@ -94,7 +190,9 @@ void Server::run() {
   // Function that handles a request asynchronously, will be passed as argument
   // to `HttpServer` below.
   auto httpSessionHandler =
-      [this](auto request, auto&& send) -> boost::asio::awaitable<void> {
+      [this](auto request, auto&& send,
+             std::shared_ptr<ClientConnection> connection)
+      -> boost::asio::awaitable<void> {
     // Version of send with maximally permissive CORS header (which allows the
     // client that receives the response to do with it what it wants).
     // NOTE: For POST and GET requests, the "allow origin" header is sufficient,
@@ -127,7 +225,8 @@ void Server::run() {
     std::optional<std::string> exceptionErrorMsg;
     std::optional<boost::beast::http::status> httpResponseStatus;
     try {
-      co_await process(request, sendWithAccessControlHeaders);
+      co_await process(request, sendWithAccessControlHeaders,
+                       std::move(connection));
     } catch (const HttpError& e) {
       httpResponseStatus = e.status();
       exceptionErrorMsg = e.what();
@@ -291,8 +390,17 @@ auto Server::prepareOperation(
         (*sharedMessageSender)(std::move(json));
       },
       pinSubtrees, pinResult);
+  if (getRuntimeParameter<&RuntimeParameters::costFactorCalibration_>()) {
+    costFactorCalibration_.applyTo(qec->getCostFactors());
+  }
   configurePinnedResultWithName(pinResultWithName, pinNamedGeoIndex,
                                 accessTokenOk, *qec);
+  // A receiver with the same index gets the IDs of the vocabulary as is.
+  qec->binaryExportKeepsVocabIds_ =
+      ad_utility::url_parser::checkParameter(
+          params, qlever::binary_export::INDEX_ID_PARAMETER,
+          index().getIndexId())
+          .has_value();
   return std::make_tuple(std::move(qec), std::move(cancellationHandle),
                          std::move(cancelTimeoutOnDestruction));
 }
@@ -322,7 +430,9 @@ void Server::configurePinnedResultWithName(
 // _____________________________________________________________________________
 CPP_template_def(typename RequestT, typename ResponseT)(
     requires ad_utility::httpUtils::HttpRequest<RequestT>)
-    Awaitable<void> Server::process(RequestT& request, ResponseT&& send) {
+    Awaitable<void> Server::process(
+        RequestT& request, ResponseT&& send,
+        std::shared_ptr<ad_utility::httpUtils::ClientConnection> connection) {
   using namespace ad_utility::httpUtils;
 
   // Log some basic information about the request. Start with an empty line so
@@ -387,16 +497,19 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   } else if (auto cmd = checkParameter("cmd", "clear-cache")) {
     logCommand(cmd, "clear the cache (unpinned elements only)");
     cache().clearUnpinnedOnly();
+    queryPlanCache_.clear();
     response = createJsonResponse(composeCacheStatsJson(), request);
   } else if (auto cmd = checkParameter("cmd", "clear-cache-complete")) {
     requireValidAccessToken("clear-cache-complete");
     logCommand(cmd, "clear cache completely (including unpinned elements)");
     cache().clearAll();
+    queryPlanCache_.clear();
     response = createJsonResponse(composeCacheStatsJson(), request);
   } else if (auto cmd = checkParameter("cmd", "clear-named-cache")) {
     requireValidAccessToken("clear-named-cache");
     logCommand(cmd, "clear the cache for named results");
     namedResultCache().clear();
+    qlever().persistNamedResultCacheIfChanged();
     response = createJsonResponse(composeCacheStatsJson(), request);
   } else if (auto cmd = checkParameter("cmd", "clear-delta-triples")) {
     requireValidAccessToken("clear-delta-triples");
@@ -456,6 +569,34 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     logCommand(cmd, "get server settings");
     response = createJsonResponse(
         json(globalRuntimeParameters.rlock()->toMap()), request);
+  } else if (auto cmd = checkParameter("cmd", "replication-log")) {
+    // The records are fetched by the read replicas in short intervals, so
+    // they are not logged.
+    auto replicationLog = index().deltaTriplesManager().replicationLog();
+    if (replicationLog == nullptr) {
+      throw HttpError(http::status::not_found,
+                      "The replication log is not enabled on this server");
+    }
+    auto since = checkParameter("since", std::nullopt);
+    uint64_t sequenceNumber = 0;
+    if (!since.has_value() ||
+        !absl::SimpleAtoi(since.value(), &sequenceNumber)) {
+      throw HttpError(http::status::bad_request,
+                      "The parameter \"since\" with the last applied "
+                      "sequence number is required");
+    }
+    auto records = replicationLog->recordsSince(sequenceNumber);
+    if (!records.has_value()) {
+      throw HttpError(
+          http::status::gone,
+          absl::StrCat("The records after sequence number ", sequenceNumber,
+                       " are not available (anymore), the latest sequence "
+                       "number is ",
+                       replicationLog->latestSequenceNumber()));
+    }
+    response = createOkResponse(
+        DeltaTriplesReplicationLog::serialize(records.value()), request,
+        MediaType::octetStream);
   } else if (auto cmd = checkParameter("cmd", "get-index-id")) {
     logCommand(cmd, "get index ID");
     response =
@@ -467,7 +608,45 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     for (auto& [key, value] : queryRegistry_.getActiveQueries()) {
       json[nlohmann::json(key)] = std::move(value);
     }
+    // The queries that wait for their execution additionally show their
+    // status and priority.
+    for (auto& queued : queryScheduler_.getQueuedQueries()) {
+      json[nlohmann::json(queued.queryId_)].update(nlohmann::json(queued));
+    }
     response = createJsonResponse(json, request);
+  } else if (auto cmd = checkParameter("cmd", "query-traces")) {
+    requireValidAccessToken("query-traces");
+    logCommand(cmd, "get the traces of recent queries");
+    response = createJsonResponse(composeQueryTracesJson(), request);
+  } else if (auto cmd =
+                 checkParameter("cmd", "materialized-view-recommendations")) {
+    requireValidAccessToken("materialized-view-recommendations");
+    logCommand(cmd, "recommend materialized views");
+    auto diskBudget = getRuntimeParameter<
+        &RuntimeParameters::materializedViewAdvisorDiskBudget_>();
+    if (auto budget = checkParameter("disk-budget", std::nullopt)) {
+      diskBudget = ad_utility::MemorySize::parse(budget.value());
+    }
+    size_t maxNumRecommendations = 10;
+    if (auto num = checkParameter("num-recommendations", std::nullopt)) {
+      maxNumRecommendations = std::stoul(num.value());
+    }
+    response = createJsonResponse(
+        json(materializedViewAdvisor_.recommendations(diskBudget,
+                                                      maxNumRecommendations)),
+        request);
+  } else if (auto cmd = checkParameter("cmd", "cost-factor-calibration")) {
+    requireValidAccessToken("cost-factor-calibration");
+    logCommand(cmd, "get the calibration of the cost factors");
+    response = createJsonResponse(costFactorCalibration_.toJson(), request);
+  } else if (auto cmd = checkParameter("cmd", "fetch-cursor")) {
+    logCommand(cmd, "fetch the next page of a cursor");
+    response = createCursorPage(request, parameters,
+                                requireCursorId(parameters), requestTimer);
+  } else if (auto cmd = checkParameter("cmd", "close-cursor")) {
+    logCommand(cmd, "close a cursor");
+    bool closed = resultCursors_.close(requireCursorId(parameters));
+    response = createJsonResponse(json{{"cursor-closed", closed}}, request);
   } else if (auto cmd = checkParameter("cmd", "rebuild-index")) {
     requireValidAccessToken("rebuild-index");
 
@@ -565,6 +744,12 @@ CPP_template_def(typename RequestT, typename ResponseT)(
                                 request, MediaType::textPlain);
   }
 
+  // Metrics in the text format of Prometheus.
+  if (parsedHttpRequest.path_ == "/metrics") {
+    response =
+        createOkResponse(composeMetrics(), request, MediaType::textPlain);
+  }
+
   // Set description of KB index.
   if (auto description = checkParameter("index-description", std::nullopt)) {
     requireValidAccessToken("index-description");
@@ -591,6 +776,8 @@ CPP_template_def(typename RequestT, typename ResponseT)(
                   << " to value \"" << value.value() << "\"" << std::endl;
       globalRuntimeParameters.wlock()->setFromString(
           key, std::string{value.value()});
+      // Many runtime parameters influence the query planning.
+      queryPlanCache_.clear();
       response = createJsonResponse(
           json(globalRuntimeParameters.rlock()->toMap()), request);
     }
@@ -602,11 +789,13 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   std::optional<PlannedQuery> plannedQuery;
   auto visitOperation =
       [&checkParameter, &accessTokenOk, &request, &send, &parameters,
-       &requestTimer, &plannedQuery, this](
+       &requestTimer, &plannedQuery, &connection, this](
           std::vector<ParsedQuery> operations, std::string operationName,
           const std::string operationString,
           std::function<bool(const ParsedQuery&)> expectedOperation,
-          const std::string msg, SharedTimeTracer tracer) -> Awaitable<void> {
+          const std::string msg, SharedTimeTracer tracer,
+          std::shared_ptr<ad_utility::timer::SpanTracer> spanTracer =
+              nullptr) -> Awaitable<void> {
     auto timeLimit = co_await verifyUserSubmittedQueryTimeout(
         checkParameter("timeout", std::nullopt), accessTokenOk, request, send);
     if (!timeLimit.has_value()) {
@@ -621,6 +810,7 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     // Grab the shared handle before `messageSender` is moved below.
     using enum ad_utility::websocket::QueryStatus;
     auto queryStatus = messageSender.sharedStatus();
+    auto queryId = messageSender.getQueryId();
     // Outside the `try`: `qecPtr` owns the id whose destructor writes the
     // `end` event, so the status must be set before it unwinds.
     auto [qecPtr, cancellationHandle, cancelTimeoutOnDestruction] =
@@ -628,6 +818,7 @@ CPP_template_def(typename RequestT, typename ResponseT)(
                          std::move(messageSender), parameters,
                          timeLimit.value(), accessTokenOk, clientIp);
     auto& qec = *qecPtr;
+    qec.setSpanTracer(std::move(spanTracer));
     try {
       if (!ql::ranges::all_of(operations, expectedOperation)) {
         throw std::runtime_error(absl::StrCat(
@@ -642,9 +833,24 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         ParsedQuery query = std::move(operations[0]);
         AD_CORRECTNESS_CHECK(query.hasSelectClause() || query.hasAskClause() ||
                              query.hasConstructClause());
+        auto priority = determineQueryPriority(parameters, accessTokenOk);
+        // Cancel the query if the client closes the connection, because
+        // nobody is waiting for its result anymore.
+        using enum ad_utility::CancellationState;
+        if (connection &&
+            getRuntimeParameter<
+                &RuntimeParameters::cancelOnClientDisconnect_>()) {
+          connection->onClose(
+              [handle = std::weak_ptr{cancellationHandle}]() {
+                if (auto pointer = handle.lock()) {
+                  pointer->cancel(MANUAL);
+                }
+              });
+        }
         co_await processQuery(parameters, std::move(query), requestTimer,
                               cancellationHandle, qec, std::move(request), send,
-                              timeLimit.value(), plannedQuery);
+                              timeLimit.value(), plannedQuery, queryId,
+                              priority);
       }
       queryStatus->store(OK);
       co_return;
@@ -655,18 +861,44 @@ CPP_template_def(typename RequestT, typename ResponseT)(
       throw;
     }
   };
-  auto visitQuery = [this, &visitOperation](Query query) -> Awaitable<void> {
-    // We need to copy the query string because `visitOperation` below also
-    // needs it.
-    auto parsedQuery = SparqlParser::parseQuery(
-        &index().encodedIriManager(), query.query_, query.datasetClauses_);
+  auto visitQuery = [this, &visitOperation,
+                     &checkParameter](Query query) -> Awaitable<void> {
+    using ad_utility::timer::SpanTracer;
+    std::shared_ptr<SpanTracer> spanTracer;
+    if (checkParameter("trace", "true").has_value() ||
+        SpanTracer::sample(getRuntimeParameter<
+                           &RuntimeParameters::queryTraceSamplingRate_>())) {
+      spanTracer = std::make_shared<SpanTracer>(getRuntimeParameter<
+          &RuntimeParameters::queryTraceMaxNumSpansPerThread_>());
+    }
+    ParsedQuery parsedQuery;
+    {
+      SpanTracer::Activation activation{spanTracer.get()};
+      ad_utility::timer::TraceSpan span{"parsing"};
+      // We need to copy the query string because `visitOperation` below also
+      // needs it.
+      auto parseKey =
+          QueryPlanCache::parseKey(query.query_, query.datasetClauses_);
+      auto cachedQuery = parseKey.has_value()
+                             ? queryPlanCache_.getParsedQuery(parseKey.value())
+                             : std::nullopt;
+      if (cachedQuery.has_value()) {
+        parsedQuery = std::move(cachedQuery).value();
+      } else {
+        parsedQuery = SparqlParser::parseQuery(
+            &index().encodedIriManager(), query.query_, query.datasetClauses_);
+        if (parseKey.has_value()) {
+          queryPlanCache_.storeParsedQuery(parseKey.value(), parsedQuery);
+        }
+      }
+    }
     auto dummy = std::make_shared<ad_utility::timer::TimeTracer>("dummy");
     return visitOperation(
         {std::move(parsedQuery)}, "SPARQL query", std::move(query.query_),
         std::not_fn(&ParsedQuery::hasUpdateClause),
         "SPARQL QUERY was requested via the HTTP request, but the "
         "following update was sent instead of an query: ",
-        dummy);
+        dummy, std::move(spanTracer));
   };
   auto visitUpdate = [this, &visitOperation, &requireValidAccessToken](
                          Update update) -> Awaitable<void> {
@@ -750,15 +982,46 @@ std::pair<bool, bool> Server::determineResultPinning(
   return {pinSubresults, pinResult};
 }
 
+// ____________________________________________________________________________
+QueryScheduler::Priority Server::determineQueryPriority(
+    const ad_utility::url_parser::ParamValueMap& params, bool accessTokenOk) {
+  auto name = ad_utility::url_parser::getParameterCheckAtMostOnce(
+      params, "priority");
+  if (!name.has_value()) {
+    return QueryScheduler::Priority::Default;
+  }
+  auto priority = QueryScheduler::priorityFromString(name.value());
+  if (priority == QueryScheduler::Priority::Interactive && !accessTokenOk) {
+    throw std::runtime_error(
+        "The priority \"interactive\" requires a valid access token");
+  }
+  return priority;
+}
+
 // ____________________________________________________________________________
 Server::PlannedQuery Server::planQuery(
     ParsedQuery&& operation, const ad_utility::Timer& requestTimer,
     TimeLimit timeLimit, QueryExecutionContext& qec,
     ad_utility::SharedCancellationHandle handle) const {
-  QueryPlanner qp(&qec, handle);
-  auto executionTree = qp.createExecutionTree(operation);
-  PlannedQuery plannedQuery{std::move(operation), std::move(executionTree),
-                            qec};
+  auto planKey = QueryPlanCache::planKey(operation);
+  auto cachedPlan = planKey.has_value()
+                        ? queryPlanCache_.getPlan(planKey.value(), qec)
+                        : std::nullopt;
+  std::chrono::milliseconds timeForPlanImprovement{0};
+  if (!cachedPlan.has_value()) {
+    QueryPlanner qp(&qec, handle);
+    auto executionTree = qp.createExecutionTree(operation);
+    timeForPlanImprovement = qp.timeForPlanImprovement();
+    if (planKey.has_value()) {
+      queryPlanCache_.storePlan(planKey.value(), operation, executionTree, qec);
+    }
+    cachedPlan.emplace(QueryPlanCache::Plan{std::move(operation),
+                                            std::move(executionTree)});
+  } else {
+    AD_LOG_INFO << "Reusing the cached query plan" << std::endl;
+  }
+  PlannedQuery plannedQuery{std::move(cachedPlan->parsedQuery_),
+                            std::move(cachedPlan->queryExecutionTree_), qec};
   handle->throwIfCancelled();
   // Set some additional attributes on the `PlannedQuery`.
   plannedQuery.queryExecutionTree()
@@ -773,6 +1036,7 @@ Server::PlannedQuery Server::planQuery(
   auto& runtimeInfoWholeQuery =
       qet.getRootOperation()->getRuntimeInfoWholeQuery();
   runtimeInfoWholeQuery.timeQueryPlanning = timeForQueryPlanning;
+  runtimeInfoWholeQuery.timeQueryPlanImprovement = timeForPlanImprovement;
   AD_LOG_INFO << "Query planning done in " << timeForQueryPlanning.count()
               << " ms" << std::endl;
   AD_LOG_TRACE << qet.getCacheKey() << std::endl;
@@ -830,9 +1094,96 @@ nlohmann::json Server::composeStatsJson() const {
   result["num-text-records"] = index().getNofTextRecords();
   result["num-word-occurrences"] = index().getNofWordPostings();
   result["num-entity-occurrences"] = index().getNofEntityPostings();
+  if (cacheWarmup_ != nullptr) {
+    result["cache-warmup"] = cacheWarmup_->progress();
+  }
+  if (replica_ != nullptr) {
+    result["replication"] = replica_->status();
+  }
   return result;
 }
 
+// _____________________________________________________________________________
+std::string Server::composeMetrics() const {
+  std::ostringstream os;
+  metrics_.write(os);
+  auto write = [&os](std::string_view name, std::string_view type,
+                     std::string_view help, double value) {
+    ServerMetrics::writeMetric(os, name, type, help, value);
+  };
+  write("qlever_queries_running", "gauge",
+        "The number of queries that are currently executed.",
+        static_cast<double>(queryScheduler_.numRunningWithoutLock()));
+  write("qlever_queries_waiting", "gauge",
+        "The number of queries that wait for their admission.",
+        static_cast<double>(queryScheduler_.numWaitingWithoutLock()));
+
+  auto cacheStatistics = cache().getStatistics();
+  write("qlever_result_cache_hits_total", "counter",
+        "The number of lookups in the query result cache that were hits.",
+        static_cast<double>(cacheStatistics.numHits_));
+  write("qlever_result_cache_misses_total", "counter",
+        "The number of lookups in the query result cache that were misses.",
+        static_cast<double>(cacheStatistics.numMisses_));
+  auto numLookups = cacheStatistics.numHits_ + cacheStatistics.numMisses_;
+  write("qlever_result_cache_hit_ratio", "gauge",
+        "The fraction of the lookups in the query result cache that were hits.",
+        numLookups == 0 ? 0.0
+                        : static_cast<double>(cacheStatistics.numHits_) /
+                              static_cast<double>(numLookups));
+  const auto& blockCache = DecompressedBlockCache::get();
+  write("qlever_decompressed_block_cache_hits_total", "counter",
+        "The number of lookups in the cache of decompressed blocks that were "
+        "hits.",
+        static_cast<double>(blockCache.numHits()));
+  write("qlever_decompressed_block_cache_misses_total", "counter",
+        "The number of lookups in the cache of decompressed blocks that were "
+        "misses.",
+        static_cast<double>(blockCache.numMisses()));
+
+  auto memoryLeft = allocator().amountMemoryLeft();
+  auto memoryUsed = memoryLimit_.getBytes() > memoryLeft.getBytes()
+                        ? memoryLimit_.getBytes() - memoryLeft.getBytes()
+                        : 0;
+  write("qlever_query_memory_limit_bytes", "gauge",
+        "The memory limit for the processing of queries.",
+        static_cast<double>(memoryLimit_.getBytes()));
+  write("qlever_query_memory_used_bytes", "gauge",
+        "The memory that is currently used for the processing of queries.",
+        static_cast<double>(memoryUsed));
+
+  // Each delta triple is contained in all the permutations, so it suffices to
+  // count one of them.
+  auto locatedTriples =
+      index().deltaTriplesManager().getCurrentLocatedTriplesSharedState();
+  write("qlever_delta_triples", "gauge",
+        "The number of inserted and deleted triples that are not yet part of "
+        "the index.",
+        static_cast<double>(
+            locatedTriples
+                ->getLocatedTriplesForPermutation<false>(Permutation::PSO)
+                .numTriples()));
+  write("qlever_lazy_scan_blocking_seconds_total", "counter",
+        "The total time that lazy index scans waited for blocks to be read "
+        "and decompressed.",
+        static_cast<double>(
+            CompressedRelationReader::totalLazyScanBlockingTime().load(
+                std::memory_order_relaxed)) /
+            1e6);
+  if (replica_ != nullptr) {
+    auto status = replica_->status();
+    write("qlever_replication_lag_records", "gauge",
+          "The number of records of the replication log of the primary that "
+          "have not yet been applied by this replica.",
+          static_cast<double>(status.lag()));
+    write("qlever_replication_seconds_since_last_sync", "gauge",
+          "The time since this replica has last synchronized with the "
+          "primary.",
+          static_cast<double>(status.timeSinceLastSync_.count()) / 1e3);
+  }
+  return std::move(os).str();
+}
+
 // _______________________________________
 nlohmann::json Server::composeCacheStatsJson() const {
   nlohmann::json result;
@@ -844,6 +1195,15 @@ nlohmann::json Server::composeCacheStatsJson() const {
   // converter.
   result["cache-size-unpinned"] = cache().nonPinnedSize().getBytes();
   result["cache-size-pinned"] = cache().pinnedSize().getBytes();
+
+  auto blockCacheStats = DecompressedBlockCache::get().getStatistics();
+  auto& blockCache = result["decompressed-block-cache"];
+  blockCache["num-entries"] = blockCacheStats.numEntries_;
+  blockCache["num-hits"] = blockCacheStats.numHits_;
+  blockCache["num-misses"] = blockCacheStats.numMisses_;
+  blockCache["num-evictions"] = blockCacheStats.numEvictions_;
+  blockCache["size"] = blockCacheStats.size_.getBytes();
+  blockCache["max-size"] = blockCacheStats.maxSize_.getBytes();
   return result;
 }
 
@@ -866,6 +1226,53 @@ CPP_template_def(typename RequestT)(
   return std::move(queryId.value());
 }
 
+// _____________________________________________________________________________
+cppcoro::generator<std::string> Server::traceChunks(
+    cppcoro::generator<std::string> chunks,
+    std::shared_ptr<ad_utility::timer::SpanTracer> tracer) {
+  using ad_utility::timer::SpanTracer;
+  using ad_utility::timer::TraceSpan;
+  // The result is computed lazily while the chunks are created. The tracer
+  // is only activated while a chunk is created, because the thread might
+  // change at the `co_yield`.
+  auto it = [&chunks, &tracer]() {
+    SpanTracer::Activation activation{tracer.get()};
+    TraceSpan span{"export"};
+    return chunks.begin();
+  }();
+  while (it != chunks.end()) {
+    co_yield std::move(*it);
+    SpanTracer::Activation activation{tracer.get()};
+    TraceSpan span{"export"};
+    ++it;
+  }
+}
+
+// _____________________________________________________________________________
+void Server::storeQueryTrace(
+    const ad_utility::websocket::QueryId& queryId, std::string_view query,
+    std::shared_ptr<ad_utility::timer::SpanTracer> tracer) {
+  auto traces = recentQueryTraces_.wlock();
+  traces->push_back({nlohmann::json(queryId).get<std::string>(),
+                     ad_utility::truncateOperationString(query),
+                     std::move(tracer)});
+  while (traces->size() > maxNumRecentQueryTraces_) {
+    traces->pop_front();
+  }
+}
+
+// _____________________________________________________________________________
+nlohmann::json Server::composeQueryTracesJson() const {
+  auto traceEvents = nlohmann::json::array();
+  auto traces = recentQueryTraces_.rlock();
+  for (size_t i = 0; i < traces->size(); ++i) {
+    const auto& trace = traces->at(i);
+    trace.tracer_->appendChromeTraceEvents(
+        traceEvents, i + 1, absl::StrCat(trace.queryId_, ": ", trace.query_));
+  }
+  return {{"traceEvents", std::move(traceEvents)}, {"displayTimeUnit", "ms"}};
+}
+
 // _____________________________________________________________________________
 CPP_template_def(typename RequestT, typename ResponseT)(
     requires ad_utility::httpUtils::HttpRequest<RequestT>)
@@ -877,6 +1284,9 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   auto responseGenerator = ExportQueryExecutionTrees::computeResult(
       plannedQuery.parsedQuery(), qet, mediaType, requestTimer,
       std::move(cancellationHandle));
+  if (const auto& tracer = qet.getQec()->spanTracer()) {
+    responseGenerator = traceChunks(std::move(responseGenerator), tracer);
+  }
 
   auto response = ad_utility::httpUtils::createOkResponse(
       std::move(responseGenerator), request, mediaType);
@@ -915,6 +1325,96 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   }
 }
 
+// _____________________________________________________________________________
+Awaitable<std::string> Server::createCursor(
+    const PlannedQuery& plannedQuery,
+    SharedCancellationHandle cancellationHandle) {
+  const auto& parsedQuery = plannedQuery.parsedQuery();
+  if (parsedQuery.hasAskClause()) {
+    throw std::runtime_error(
+        "Cursors are only supported for SELECT and CONSTRUCT queries");
+  }
+  const auto& qet = plannedQuery.queryExecutionTree();
+  auto coroutine = computeInNewThread(
+      queryThreadPool_, [&qet]() { return qet.getResult(false); },
+      cancellationHandle);
+  std::shared_ptr<const Result> result = co_await std::move(coroutine);
+
+  // The `LIMIT` and the `OFFSET` of the query are applied when the pages are
+  // exported, unless the root operation has already applied them (see
+  // `ExportQueryExecutionTrees::compensateForLimitOffsetClause`).
+  LimitOffsetClause limitOffset = parsedQuery._limitOffset;
+  if (qet.handlesLimitOffset() != LimitOffsetHandling::NONE) {
+    limitOffset._offset = 0;
+  }
+  const auto& table = result->idTable();
+  size_t numRows = table.numRows();
+  ResultCursors::CursorResult cursorResult{
+      parsedQuery,
+      std::shared_ptr<const IdTable>{result, &table},
+      qet.getVariableColumns(),
+      qet.resultSortedOn(),
+      result->localVocab().clone(),
+      limitOffset.actualOffset(numRows),
+      limitOffset.upperBound(numRows)};
+
+  // The results of the cursors count against the memory of the cache that is
+  // not used by pinned results.
+  auto cacheMaxSize = getRuntimeParameter<&RuntimeParameters::cacheMaxSize_>();
+  auto pinnedSize = cache().pinnedSize();
+  resultCursors_.removeIdleCursors(
+      getRuntimeParameter<&RuntimeParameters::cursorIdleTimeout_>());
+  co_return resultCursors_.create(
+      std::move(cursorResult),
+      cacheMaxSize - std::min(cacheMaxSize, pinnedSize));
+}
+
+// _____________________________________________________________________________
+CPP_template_def(typename RequestT)(
+    requires ad_utility::httpUtils::HttpRequest<RequestT>)
+    ad_utility::httpUtils::http::response<
+        ad_utility::httpUtils::streamable_body> Server::
+        createCursorPage(const RequestT& request,
+                         const ad_utility::url_parser::ParamValueMap& params,
+                         const std::string& cursorId,
+                         const ad_utility::Timer& requestTimer) {
+  auto pageSize = ad_utility::url_parser::getParameterCheckAtMostOnce(
+      params, "cursor-page-size");
+  if (!pageSize.has_value()) {
+    throw std::runtime_error(
+        "The number of rows of the page of a cursor must be specified via the "
+        "URL parameter `cursor-page-size`");
+  }
+  resultCursors_.removeIdleCursors(
+      getRuntimeParameter<&RuntimeParameters::cursorIdleTimeout_>());
+  auto page = resultCursors_.fetch(cursorId, std::stoul(pageSize.value()));
+  const auto& result = *page.result_;
+
+  // Export the rows of the page from an operation that yields the result.
+  ParsedQuery parsedQuery = result.parsedQuery_;
+  auto& limitOffset = parsedQuery._limitOffset;
+  limitOffset._limit = page.endRow_ - page.beginRow_;
+  limitOffset._offset = page.beginRow_;
+  limitOffset.exportLimit_ = std::nullopt;
+  auto qec = qlever().createQueryExecutionContext();
+  QueryExecutionTree qet{qec.get(), result.toOperation(qec.get(), cursorId)};
+  auto plannedPage =
+      std::make_shared<PlannedQuery>(std::move(parsedQuery), std::move(qet),
+                                     *qec);
+  MediaType mediaType = chooseBestFittingMediaType(
+      determineMediaTypes(params, request), plannedPage->parsedQuery());
+  auto chunks = ExportQueryExecutionTrees::computeResult(
+      plannedPage->parsedQuery(), plannedPage->queryExecutionTree(), mediaType,
+      requestTimer, std::make_shared<ad_utility::CancellationHandle<>>());
+  auto response = ad_utility::httpUtils::createOkResponse(
+      keepAlive(plannedPage, std::move(chunks)), request, mediaType);
+  if (page.hasMoreRows_) {
+    response.set("QLever-Cursor", cursorId);
+    response.set(http::field::access_control_expose_headers, "QLever-Cursor");
+  }
+  return response;
+}
+
 // ____________________________________________________________________________
 CPP_template_def(typename RequestT)(
     requires ad_utility::httpUtils::HttpRequest<RequestT>)
@@ -942,6 +1442,8 @@ CPP_template_def(typename RequestT)(
     mediaType = MediaType::turtle;
   } else if (checkParameter(params, "action", "binary_export")) {
     mediaType = MediaType::octetStream;
+  } else if (checkParameter(params, "action", "arrow_export")) {
+    mediaType = MediaType::arrowStream;
   }
 
   std::string_view acceptHeader = request.base()[http::field::accept];
@@ -990,7 +1492,8 @@ ad_utility::MediaType Server::chooseBestFittingMediaType(
                                        MediaType::qleverJson,
                                        MediaType::sparqlXml,
                                        MediaType::sparqlJson,
-                                       MediaType::binaryQleverExport};
+                                       MediaType::binaryQleverExport,
+                                       MediaType::arrowStream};
         return ad_utility::contains(supportedMediaTypes, mediaType);
       }
       std::array supportedMediaTypes{MediaType::csv, MediaType::tsv,
@@ -1014,7 +1517,9 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         ParsedQuery&& query, const ad_utility::Timer& requestTimer,
         ad_utility::SharedCancellationHandle cancellationHandle,
         QueryExecutionContext& qec, const RequestT& request, ResponseT&& send,
-        TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery) {
+        TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery,
+        const ad_utility::websocket::QueryId& queryId,
+        QueryScheduler::Priority priority) {
   AD_CORRECTNESS_CHECK(!query.hasUpdateClause());
 
   auto mediaTypes = determineMediaTypes(params, request);
@@ -1038,6 +1543,9 @@ CPP_template_def(typename RequestT, typename ResponseT)(
       queryThreadPool_,
       [this, &query, &requestTimer, &timeLimit, &qec,
        &cancellationHandle]() -> std::optional<PlannedQuery> {
+        ad_utility::timer::SpanTracer::Activation activation{
+            qec.spanTracer().get()};
+        ad_utility::timer::TraceSpan span{"planning"};
         return this->planQuery(std::move(query), requestTimer, timeLimit, qec,
                                cancellationHandle);
       },
@@ -1060,12 +1568,57 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   // offset is not applied twice when exporting the query.
   adjustParsedQueryLimitOffset(plannedQuery.value(), mediaType, params);
 
+  // Wait until the scheduler admits the query. The memory estimate is the size
+  // of the result as estimated by the query planner, which is only a coarse
+  // approximation of the memory that is required during the computation.
+  const size_t numRows = qet.getSizeEstimate();
+  const size_t bytesPerRow = qet.getResultWidth() * sizeof(Id);
+  auto estimatedMemory =
+      bytesPerRow == 0 ||
+              numRows <= ad_utility::MemorySize::max().getBytes() / bytesPerRow
+          ? ad_utility::MemorySize::bytes(numRows * bytesPerRow)
+          : ad_utility::MemorySize::max();
+  auto admission = queryScheduler_.admit(
+      queryId, plannedQuery.value().parsedQuery()._originalString, priority,
+      estimatedMemory, cancellationHandle);
+  auto ticket = co_await std::move(admission);
+
   // This actually processes the query and sends the result in the
-  // requested format.
-  co_await sendStreamableResponse(request, AD_FWD(send), mediaType,
-                                  plannedQuery.value(),
-                                  plannedQuery.value().queryExecutionTree(),
-                                  requestTimer, cancellationHandle);
+  // requested format. With a cursor, only the first page of the result is
+  // sent, the other pages are fetched with separate requests.
+  if (ad_utility::url_parser::getParameterCheckAtMostOnce(params,
+                                                          "cursor-page-size")
+          .has_value()) {
+    auto cursorId =
+        co_await createCursor(plannedQuery.value(), cancellationHandle);
+    co_await send(createCursorPage(request, params, cursorId, requestTimer));
+  } else {
+    co_await sendStreamableResponse(request, AD_FWD(send), mediaType,
+                                    plannedQuery.value(),
+                                    plannedQuery.value().queryExecutionTree(),
+                                    requestTimer, cancellationHandle);
+  }
+  metrics_.recordRequest(ServerMetrics::OperationType::Query, mediaType,
+                         requestTimer.value());
+  if (qec.spanTracer() != nullptr) {
+    storeQueryTrace(queryId, plannedQuery.value().parsedQuery()._originalString,
+                    qec.spanTracer());
+  }
+  // Persist the result that was pinned by this query.
+  if (qec.pinResultWithName().has_value()) {
+    auto persist = computeInNewThread(
+        queryThreadPool_,
+        [this] { this->qlever().persistNamedResultCacheIfChanged(); },
+        cancellationHandle);
+    co_await std::move(persist);
+  }
+  materializedViewAdvisor_.recordQuery(
+      plannedQuery.value().queryExecutionTree(),
+      plannedQuery.value().parsedQuery()._originalString);
+  if (getRuntimeParameter<&RuntimeParameters::costFactorCalibration_>()) {
+    costFactorCalibration_.recordQuery(
+        plannedQuery.value().queryExecutionTree());
+  }
   // Print the runtime info. This needs to be done after the query
   // was computed.
   AD_LOG_INFO << "Done processing query and sending result"
@@ -1102,8 +1655,15 @@ nlohmann::ordered_json Server::createResponseMetadataForUpdate(
       plannedQuery.parsedQuery()._originalString);
   response["status"] = "OK";
   response["warnings"] = warnings;
-  response["runtimeInformation"]["meta"] = nlohmann::ordered_json(
-      qet.getRootOperation()->getRuntimeInfoWholeQuery());
+  auto& runtimeInfoWholeQuery =
+      qet.getRootOperation()->getRuntimeInfoWholeQuery();
+  auto decodeCacheStatistics = qet.getQec()->vocabDecodeCache().getStatistics();
+  runtimeInfoWholeQuery.numVocabDecodeCacheHits =
+      decodeCacheStatistics.numHits_;
+  runtimeInfoWholeQuery.numVocabDecodeCacheMisses =
+      decodeCacheStatistics.numMisses_;
+  response["runtimeInformation"]["meta"] =
+      nlohmann::ordered_json(runtimeInfoWholeQuery);
   response["runtimeInformation"]["query_execution_tree"] =
       nlohmann::ordered_json(qet.getRootOperation()->runtimeInfo());
   auto setIfHasValue = [&response, &updateMetadata](
@@ -1160,6 +1720,12 @@ UpdateMetadata Server::processUpdateImpl(
   // part of the cache key).
   cache().clearAll();
   namedResultCache().clear();
+  qlever().persistNamedResultCacheIfChanged();
+  // The cached graphs stay valid, but they are not used anymore.
+  CsrGraphCache::get().clear();
+  // The cached query plans can't be used anymore either, but they still refer
+  // to the old snapshot of the delta triples.
+  queryPlanCache_.clear();
   tracer.endTrace("clearCache");
 
   return updateMetadata;
@@ -1177,6 +1743,11 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   outerTracer->beginTrace("waitingForUpdateThread");
   AD_CORRECTNESS_CHECK(ql::ranges::all_of(
       updates, [](const ParsedQuery& p) { return p.hasUpdateClause(); }));
+  if (replica_ != nullptr) {
+    throw std::runtime_error(
+        "This server is a read replica, updates have to be sent to the "
+        "primary server");
+  }
 
   auto responseMiddlewares =
       ad_utility::RvalueView(
@@ -1189,65 +1760,67 @@ CPP_template_def(typename RequestT, typename ResponseT)(
 
   // If multiple updates are part of a single request, those have to run
   // atomically. This is ensured, because the updates below are run on the
-  // `updateThreadPool_`, which only has a single thread.
+  // `updateThreadPool_`, which only has a single thread. The updates of
+  // several requests might be executed together as a single modification of
+  // the delta triples, see `executePendingUpdates` for details.
   static_assert(UPDATE_THREAD_POOL_SIZE == 1);
+  auto pendingUpdate = std::make_shared<PendingUpdate>();
+  pendingUpdate->execute_ =
+      [this, &cancellationHandle, &plannedUpdate, &updates, &requestTimer,
+       &timeLimit, &qec, &metadatas](DeltaTriples& deltaTriples,
+                                     bool isFirstOfBatch) {
+        qec.setLocatedTriplesForEvaluation(
+            deltaTriples.getLocatedTriplesSharedStateReference());
+        json results = json::array();
+        for (auto&& [i, update] : ranges::views::enumerate(updates)) {
+          auto tracer = ad_utility::timer::TimeTracer("update");
+          // The augmented metadata is invalidated by any update. It is
+          // only updated automatically at the end of modify. Updates with
+          // non-empty graph patterns need the augmented metadata. Update
+          // the augmented metadata before executing those updates.
+          tracer.beginTrace("updateMetadata");
+          if ((i != 0 || !isFirstOfBatch) &&
+              !update._rootGraphPattern._graphPatterns.empty()) {
+            deltaTriples.updateAugmentedMetadata();
+          }
+          tracer.endTrace("updateMetadata");
+          tracer.beginTrace("planning");
+          plannedUpdate = planQuery(std::move(update), requestTimer, timeLimit,
+                                    qec, cancellationHandle);
+          tracer.endTrace("planning");
+          tracer.beginTrace("execution");
+          // Update the delta triples.
+          // Use `this` explicitly to silence false-positive
+          // errors on captured `this` being unused.
+          auto updateMetadata = this->processUpdateImpl(
+              plannedUpdate.value(), cancellationHandle, deltaTriples, tracer);
+          tracer.endTrace("execution");
+
+          tracer.endTrace("update");
+          results.push_back(createResponseMetadataForUpdate(
+              index(), *deltaTriples.getLocatedTriplesSharedStateReference(),
+              *plannedUpdate, plannedUpdate->queryExecutionTree(),
+              updateMetadata, tracer));
+          metadatas.push_back(std::move(updateMetadata));
+
+          AD_LOG_INFO << "Done processing update, total time was "
+                      << requestTimer.msecs().count() << " ms" << std::endl;
+          AD_LOG_DEBUG << "Runtime Info:\n"
+                       << plannedUpdate->queryExecutionTree()
+                              .getRootOperation()
+                              ->runtimeInfo()
+                              .toString()
+                       << std::endl;
+        }
+        return results;
+      };
+  pendingUpdates_.wlock()->push_back(pendingUpdate);
   auto coroutine = computeInNewThread(
       updateThreadPool_,
-      [this, &requestTimer, &cancellationHandle, &updates, &qec, &timeLimit,
-       &plannedUpdate, outerTracer, &metadatas]() {
-        outerTracer->endTrace("waitingForUpdateThread");
-        return index().deltaTriplesManager().modify<json>(
-            [this, &cancellationHandle, &plannedUpdate, &updates, &requestTimer,
-             &timeLimit, &qec, &metadatas](DeltaTriples& deltaTriples) {
-              qec.setLocatedTriplesForEvaluation(
-                  deltaTriples.getLocatedTriplesSharedStateReference());
-              json results = json::array();
-              for (auto&& [i, update] : ranges::views::enumerate(updates)) {
-                auto tracer = ad_utility::timer::TimeTracer("update");
-                // The augmented metadata is invalidated by any update. It is
-                // only updated automatically at the end of modify. Updates with
-                // non-empty graph patterns need the augmented metadata. Update
-                // the augmented metadata before executing those updates.
-                tracer.beginTrace("updateMetadata");
-                if (i != 0 &&
-                    !update._rootGraphPattern._graphPatterns.empty()) {
-                  deltaTriples.updateAugmentedMetadata();
-                }
-                tracer.endTrace("updateMetadata");
-                tracer.beginTrace("planning");
-                plannedUpdate = planQuery(std::move(update), requestTimer,
-                                          timeLimit, qec, cancellationHandle);
-                tracer.endTrace("planning");
-                tracer.beginTrace("execution");
-                // Update the delta triples.
-                // Use `this` explicitly to silence false-positive
-                // errors on captured `this` being unused.
-                auto updateMetadata = this->processUpdateImpl(
-                    plannedUpdate.value(), cancellationHandle, deltaTriples,
-                    tracer);
-                tracer.endTrace("execution");
-
-                tracer.endTrace("update");
-                results.push_back(createResponseMetadataForUpdate(
-                    index(),
-                    *deltaTriples.getLocatedTriplesSharedStateReference(),
-                    *plannedUpdate, plannedUpdate->queryExecutionTree(),
-                    updateMetadata, tracer));
-                metadatas.push_back(std::move(updateMetadata));
-
-                AD_LOG_INFO << "Done processing update, total time was "
-                            << requestTimer.msecs().count() << " ms"
-                            << std::endl;
-                AD_LOG_DEBUG << "Runtime Info:\n"
-                             << plannedUpdate->queryExecutionTree()
-                                    .getRootOperation()
-                                    ->runtimeInfo()
-                                    .toString()
-                             << std::endl;
-              }
-              return results;
-            },
-            true, true, *outerTracer);
+      [this, &pendingUpdate, outerTracer]() {
+        // Use `this` explicitly to silence false-positive errors on the
+        // captured `this` being unused.
+        return this->executePendingUpdates(*pendingUpdate, *outerTracer);
       },
       cancellationHandle);
   auto operations = co_await std::move(coroutine);
@@ -1264,6 +1837,8 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     response = middleware.applyUpdate(std::move(response), metadatas);
   }
   co_await send(std::move(response));
+  metrics_.recordRequest(ServerMetrics::OperationType::Update, MediaType::json,
+                         requestTimer.value());
   co_return;
 }
 
@@ -1379,9 +1954,18 @@ CPP_template_def(typename Function,
   std::promise<std::function<void()>> cancelTimerPromise{};
   auto cancelTimerFuture = cancelTimerPromise.get_future();
 
+  // The posted task is always run by the thread pool (also if the awaitable is
+  // cancelled), so the task counts of the metrics are always balanced.
+  ServerMetrics::ThreadPoolTasks& tasks = &threadPool == &updateThreadPool_
+                                              ? metrics_.updateThreadPool_
+                                              : metrics_.queryThreadPool_;
+  ++tasks.numQueued_;
   auto inner = [function = std::move(function),
-                cancelTimerFuture =
-                    std::move(cancelTimerFuture)]() mutable -> T {
+                cancelTimerFuture = std::move(cancelTimerFuture),
+                &tasks]() mutable -> T {
+    --tasks.numQueued_;
+    ++tasks.numRunning_;
+    absl::Cleanup decrementRunning{[&tasks]() { --tasks.numRunning_; }};
     // Ensure future is ready by the time this is called.
     AD_CORRECTNESS_CHECK(cancelTimerFuture.wait_for(std::chrono::milliseconds{
                              0}) == std::future_status::ready);
@@ -1506,6 +2090,90 @@ Awaitable<void> Server::rebuildIndex(const std::string& indexBaseName) {
   co_await std::move(coroutine);
 }
 
+// _____________________________________________________________________________
+json Server::executePendingUpdates(PendingUpdate& pendingUpdate,
+                                   ad_utility::timer::TimeTracer& tracer) {
+  // All the `pendingUpdates_` have their own task on the `updateThreadPool_`.
+  // The first of these tasks executes as many of them as allowed together, the
+  // tasks of the other ones then only have to report the result. The
+  // `pendingUpdate` must be one of the `pendingUpdates_` if it hasn't been
+  // executed yet, so the loop always terminates.
+  tracer.endTrace("waitingForUpdateThread");
+  auto isDone = [](const PendingUpdate& update) {
+    return update.result_.has_value() || update.exception_ != nullptr;
+  };
+  while (!isDone(pendingUpdate)) {
+    auto maxBatchSize = std::max(
+        size_t{1}, getRuntimeParameter<
+                       &RuntimeParameters::updateGroupCommitMaxRequests_>());
+    std::vector<std::shared_ptr<PendingUpdate>> batch;
+    pendingUpdates_.withWriteLock([&batch, maxBatchSize](auto& queue) {
+      while (!queue.empty() && batch.size() < maxBatchSize) {
+        batch.push_back(std::move(queue.front()));
+        queue.pop_front();
+      }
+    });
+    AD_CORRECTNESS_CHECK(!batch.empty());
+    bool automaticVacuumIsDue = false;
+    try {
+      // The failure of one of the updates doesn't affect the other updates of
+      // the same batch, because each update runs on the result of the
+      // previous ones anyway.
+      index().deltaTriplesManager().modify<void>(
+          [&batch, &automaticVacuumIsDue](DeltaTriples& deltaTriples) {
+            for (auto&& [i, update] : ranges::views::enumerate(batch)) {
+              try {
+                update->result_ = update->execute_(deltaTriples, i == 0);
+              } catch (...) {
+                update->exception_ = std::current_exception();
+              }
+            }
+            automaticVacuumIsDue = deltaTriples.isAutomaticVacuumDue();
+          },
+          true, true, tracer);
+    } catch (...) {
+      // Writing the updates to disk or publishing the new snapshot failed.
+      for (auto& update : batch) {
+        update->result_.reset();
+        update->exception_ = std::current_exception();
+      }
+    }
+    if (automaticVacuumIsDue) {
+      scheduleAutomaticVacuum();
+    }
+  }
+  if (pendingUpdate.exception_) {
+    std::rethrow_exception(pendingUpdate.exception_);
+  }
+  return std::move(pendingUpdate.result_.value());
+}
+
+// _____________________________________________________________________________
+void Server::scheduleAutomaticVacuum() {
+  if (automaticVacuumScheduled_.exchange(true)) {
+    return;
+  }
+  // The vacuuming runs on the `updateThreadPool_` after all the updates that
+  // have been submitted so far. It is thus serialized with the updates, and
+  // queries that have already acquired a snapshot of the delta triples are not
+  // affected by it.
+  net::post(updateThreadPool_, [this] {
+    automaticVacuumScheduled_ = false;
+    AD_LOG_INFO << "Vacuuming the delta triples automatically ..."
+                << std::endl;
+    try {
+      auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+      auto stats = index().deltaTriplesManager().modify<nlohmann::json>(
+          [handle](auto& deltaTriples) { return deltaTriples.vacuum(handle); });
+      AD_LOG_INFO << "Done vacuuming the delta triples: " << stats.dump()
+                  << std::endl;
+    } catch (const std::exception& e) {
+      AD_LOG_ERROR << "Automatic vacuuming of the delta triples failed: "
+                   << e.what() << std::endl;
+    }
+  });
+}
+
 // For helper function `Server::onlyForTestingProcess`
 using StreamedResponse = http::response<ad_utility::httpUtils::streamable_body>;
 using SimpleRequest = http::request<http::string_body>;
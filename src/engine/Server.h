@@ -10,16 +10,28 @@
 #ifndef QLEVER_SRC_ENGINE_SERVER_H
 #define QLEVER_SRC_ENGINE_SERVER_H
 
+#include <deque>
+#include <exception>
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
+#include "engine/CacheWarmup.h"
+#include "engine/CostFactorCalibration.h"
+#include "engine/DeltaTriplesReplica.h"
 #include "engine/ExecuteUpdate.h"
+#include "engine/MaterializedViewAdvisor.h"
 #include "engine/MaterializedViews.h"
 #include "engine/NamedResultCache.h"
 #include "engine/QueryExecutionContext.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/QueryPlanCache.h"
+#include "engine/QueryScheduler.h"
+#include "engine/ResultCursors.h"
+#include "engine/ServerMetrics.h"
 #include "engine/SortPerformanceEstimator.h"
 #include "index/IdTableUtils.h"
 #include "index/Index.h"
@@ -27,7 +39,10 @@
 #include "util/AllocatorWithLimit.h"
 #include "util/MemorySize/MemorySize.h"
 #include "util/ParseException.h"
+#include "util/SpanTracer.h"
+#include "util/Synchronized.h"
 #include "util/TypeTraits.h"
+#include "util/http/ClientConnection.h"
 #include "util/http/HttpUtils.h"
 #include "util/http/streamable_body.h"
 #include "util/http/websocket/MessageSender.h"
@@ -70,9 +85,36 @@ class Server {
   // write one JSONL line per query event to it. Call once, after construction.
   void configureQueryEventLog(const std::filesystem::path& path);
 
+  // Replay the queries from the given `file` (see `CacheWarmup::readQueries`
+  // for the format) in the background after the construction, with their
+  // results and subtrees pinned to the cache. If `maxNumQueries` is not zero,
+  // only the last `maxNumQueries` distinct queries are replayed. Call at most
+  // once, after construction.
+  void configureCacheWarmup(const std::filesystem::path& file,
+                            size_t maxNumQueries);
+
+  // Keep the recent changes of the delta triples up to the `maxSize` for the
+  // read replicas of this server (see `DeltaTriplesReplicationLog`).
+  void enableReplicationLog(ad_utility::MemorySize maxSize) {
+    index().deltaTriplesManager().enableReplicationLog(maxSize);
+  }
+
+  // Make this server a read replica of the primary server at `primaryUrl`
+  // (which must use the same index), see `DeltaTriplesReplica`. SPARQL
+  // updates are then rejected. Call at most once, after construction.
+  void configureReplicationFrom(const std::string& primaryUrl,
+                                std::chrono::milliseconds pollInterval);
+
   // Get server statistics.
   json composeStatsJson() const;
   json composeCacheStatsJson() const;
+  // The traces of the recently traced queries in the trace event format of
+  // Chrome, each query is shown as a separate process.
+  json composeQueryTracesJson() const;
+  // Get the metrics in the text format of Prometheus, for the `/metrics`
+  // endpoint. Doesn't take any of the locks that are held during the
+  // processing of queries.
+  std::string composeMetrics() const;
 
   // Helper struct bundling a parsed query with a query execution tree.
   // As the `QueryExecutionTree` stores a raw pointer to the
@@ -110,6 +152,22 @@ class Server {
 
  private:
   qlever::Qlever qlever_;
+  // The parsed queries and query plans of recent queries.
+  QueryPlanCache queryPlanCache_{qlever_.createQueryExecutionContext()};
+  // Statistics about the computed subtrees of the queries, used for the
+  // `materialized-view-recommendations` command.
+  MaterializedViewAdvisor materializedViewAdvisor_;
+  // The statistics for the fit of the cost factors to the runtimes of the
+  // executed queries, see the runtime parameter `cost-factor-calibration`.
+  CostFactorCalibration costFactorCalibration_;
+  // The cursors over the results of the queries with the URL parameter
+  // `cursor-page-size` (see `ResultCursors.h`).
+  ResultCursors resultCursors_;
+  // The metrics for the `/metrics` endpoint. Declared before the thread pools,
+  // s.t. it outlives the tasks that update it.
+  ServerMetrics metrics_;
+  // The memory limit for the query processing, reported at `/metrics`.
+  ad_utility::MemorySize memoryLimit_;
   const size_t numThreads_;
   unsigned short port_;
   std::string accessToken_;
@@ -121,9 +179,28 @@ class Server {
   std::weak_ptr<ad_utility::websocket::QueryHub> queryHub_;
 
   boost::asio::static_thread_pool queryThreadPool_;
+  // Decides when a planned query is executed (see `QueryScheduler.h`).
+  QueryScheduler queryScheduler_;
   // The update thread pool size has to be `1` s.t. UPDATE operations are run
   // atomically under all circumstances.
   static constexpr size_t UPDATE_THREAD_POOL_SIZE = 1;
+  // An update request that is waiting to be executed on the
+  // `updateThreadPool_`. `execute_` performs all its updates on the given
+  // delta triples. Its bool argument is true iff it is the first request of a
+  // batch (which means that the augmented metadata is up to date).
+  struct PendingUpdate {
+    std::function<json(DeltaTriples&, bool)> execute_;
+    std::optional<json> result_;
+    std::exception_ptr exception_;
+  };
+  // The update requests that have not yet been executed, in the order in
+  // which they were submitted.
+  ad_utility::Synchronized<std::deque<std::shared_ptr<PendingUpdate>>>
+      pendingUpdates_;
+  // Indicates if an automatic vacuuming of the delta triples has been
+  // scheduled, but not yet started, see `scheduleAutomaticVacuum`. Declared
+  // before the `updateThreadPool_` that accesses it.
+  std::atomic_bool automaticVacuumScheduled_{false};
   boost::asio::static_thread_pool updateThreadPool_{UPDATE_THREAD_POOL_SIZE};
 
   /// Executor with a single thread that is used to run timers asynchronously.
@@ -133,6 +210,25 @@ class Server {
   // triggering this twice.
   std::atomic_bool rebuildInProgress_{false};
 
+  // The traces of the most recent queries that were traced, see `SpanTracer.h`
+  // and the `query-traces` command.
+  struct QueryTrace {
+    std::string queryId_;
+    std::string query_;
+    std::shared_ptr<ad_utility::timer::SpanTracer> tracer_;
+  };
+  static constexpr size_t maxNumRecentQueryTraces_ = 20;
+  ad_utility::Synchronized<std::deque<QueryTrace>> recentQueryTraces_;
+
+  // The replay of queries after the start of the server, see
+  // `configureCacheWarmup`. Declared after all the members that it uses, s.t.
+  // its thread is stopped before they are destroyed.
+  std::unique_ptr<CacheWarmup> cacheWarmup_;
+
+  // The replication of the updates of a primary server, see
+  // `configureReplicationFrom`. Declared last for the same reason.
+  std::unique_ptr<DeltaTriplesReplica> replica_;
+
   template <typename T>
   using Awaitable = boost::asio::awaitable<T>;
 
@@ -168,9 +264,14 @@ class Server {
   /// \param req The HTTP request.
   /// \param send The action that sends a http:response. (see the
   ///             `HttpServer.h` for documentation).
+  /// \param connection The connection of the client (if known), a query is
+  ///                   cancelled if it is closed.
   CPP_template(typename RequestT, typename ResponseT)(
       requires ad_utility::httpUtils::HttpRequest<RequestT>)
-      Awaitable<void> process(RequestT& request, ResponseT&& send);
+      Awaitable<void> process(
+          RequestT& request, ResponseT&& send,
+          std::shared_ptr<ad_utility::httpUtils::ClientConnection> connection =
+              nullptr);
 
   // Helper function for unit tests, calls `process` with the given request and
   // returns the response that would have been sent.
@@ -204,7 +305,9 @@ class Server {
           ParsedQuery&& query, const ad_utility::Timer& requestTimer,
           ad_utility::SharedCancellationHandle cancellationHandle,
           QueryExecutionContext& qec, const RequestT& request, ResponseT&& send,
-          TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery);
+          TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery,
+          const ad_utility::websocket::QueryId& queryId,
+          QueryScheduler::Priority priority);
   // For an executed update create a JSON with some stats on the update (timing,
   // number of changed triples, etc.).
   static nlohmann::ordered_json createResponseMetadataForUpdate(
@@ -237,6 +340,12 @@ class Server {
   static std::pair<bool, bool> determineResultPinning(
       const ad_utility::url_parser::ParamValueMap& params);
   FRIEND_TEST(ServerTest, determineResultPinning);
+  // Determine the priority of a query from the URL parameter `priority`. The
+  // priority `interactive` requires a valid access token. Throws if the
+  // parameter is invalid.
+  static QueryScheduler::Priority determineQueryPriority(
+      const ad_utility::url_parser::ParamValueMap& params, bool accessTokenOk);
+  FRIEND_TEST(ServerTest, determineQueryPriority);
   //  Prepare the execution of an operation
   auto prepareOperation(std::string_view operationName,
                         std::string_view operationSPARQL,
@@ -352,6 +461,17 @@ class Server {
           std::optional<std::string_view> userTimeout, bool accessTokenOk,
           const RequestT& request, ResponseT& send) const;
 
+  // Activate the `tracer` and record a span while each of the `chunks` is
+  // created (which is where the result of a query is computed).
+  static cppcoro::generator<std::string> traceChunks(
+      cppcoro::generator<std::string> chunks,
+      std::shared_ptr<ad_utility::timer::SpanTracer> tracer);
+
+  // Keep the `tracer` of a processed query for the `query-traces` command.
+  void storeQueryTrace(const ad_utility::websocket::QueryId& queryId,
+                       std::string_view query,
+                       std::shared_ptr<ad_utility::timer::SpanTracer> tracer);
+
   /// Send response for the streamable media types (tsv, csv, octet-stream,
   /// turtle, sparqlJson, qleverJson).
   CPP_template(typename RequestT, typename ResponseT)(
@@ -362,6 +482,26 @@ class Server {
           const QueryExecutionTree& qet, const ad_utility::Timer& requestTimer,
           SharedCancellationHandle cancellationHandle) const;
 
+  // Compute the fully materialized result of the `plannedQuery`, create a
+  // cursor for it, and return the ID of the cursor. Throws for ASK queries and
+  // if the memory that is left for cursors doesn't suffice.
+  Awaitable<std::string> createCursor(
+      const PlannedQuery& plannedQuery,
+      SharedCancellationHandle cancellationHandle);
+
+  // Create the response with the next page of the cursor with the given ID,
+  // the number of rows of which is given by the URL parameter
+  // `cursor-page-size`. The media type is determined from the `request` like
+  // for a query. If the cursor has more rows after this page, its ID is sent
+  // in the header `QLever-Cursor`.
+  CPP_template(typename RequestT)(
+      requires ad_utility::httpUtils::HttpRequest<RequestT>)
+      ad_utility::httpUtils::http::response<
+          ad_utility::httpUtils::streamable_body> createCursorPage(
+          const RequestT& request,
+          const ad_utility::url_parser::ParamValueMap& params,
+          const std::string& cursorId, const ad_utility::Timer& requestTimer);
+
   // Given a name and query, compute the query result and write a new
   // materialized view of this result to disk. This assumes that the access
   // token has already been checked.
@@ -378,6 +518,22 @@ class Server {
   // other build is currently in progress.
   Awaitable<void> rebuildIndex(const std::string& indexBaseName);
 
+  // Execute the `pendingUpdate` (which must have been added to the
+  // `pendingUpdates_` before) and return its result, or rethrow its exception.
+  // Must be called on the `updateThreadPool_`. The update requests that are
+  // queued at that time are executed together (up to
+  // `update-group-commit-max-requests` of them), such that all of them result
+  // in a single new snapshot and a single write of the delta triples to disk.
+  json executePendingUpdates(PendingUpdate& pendingUpdate,
+                             ad_utility::timer::TimeTracer& tracer);
+
+  // Schedule a vacuuming of the delta triples on the `updateThreadPool_`
+  // unless one is already scheduled. This is called after an update if
+  // `DeltaTriples::isAutomaticVacuumDue()`, s.t. the number of redundant delta
+  // triples (and thus the overhead of the queries) doesn't keep growing under
+  // a constant stream of updates.
+  void scheduleAutomaticVacuum();
+
   // Getters for the `Qlever` instance, as well as its data members.
   qlever::Qlever& qlever() { return qlever_; }
   const qlever::Qlever& qlever() const { return qlever_; }
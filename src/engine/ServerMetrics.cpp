@@ -0,0 +1,136 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/ServerMetrics.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_format.h>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace {
+// Join the `labels` and the `extraLabel` with a comma and put them in braces,
+// return the empty string if both are empty.
+std::string formatLabels(std::string_view labels, std::string_view extraLabel) {
+  if (labels.empty() && extraLabel.empty()) {
+    return "";
+  }
+  std::string_view separator =
+      labels.empty() || extraLabel.empty() ? "" : ",";
+  return absl::StrCat("{", labels, separator, extraLabel, "}");
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void LatencyHistogram::observe(std::chrono::microseconds duration) {
+  double seconds = std::chrono::duration<double>(duration).count();
+  auto bucket = static_cast<size_t>(
+      std::lower_bound(bucketBounds_.begin(), bucketBounds_.end(), seconds) -
+      bucketBounds_.begin());
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  sumMicroseconds_.fetch_add(static_cast<uint64_t>(duration.count()),
+                             std::memory_order_relaxed);
+}
+
+// _____________________________________________________________________________
+uint64_t LatencyHistogram::count() const {
+  uint64_t result = 0;
+  for (const auto& bucket : buckets_) {
+    result += bucket.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void LatencyHistogram::write(std::ostream& os, std::string_view name,
+                             std::string_view labels) const {
+  // The buckets of Prometheus are cumulative.
+  uint64_t cumulativeCount = 0;
+  for (size_t i = 0; i < buckets_.size(); ++i) {
+    cumulativeCount += buckets_[i].load(std::memory_order_relaxed);
+    std::string bound = i < bucketBounds_.size()
+                            ? absl::StrFormat("%g", bucketBounds_[i])
+                            : "+Inf";
+    os << name << "_bucket"
+       << formatLabels(labels, absl::StrCat("le=\"", bound, "\"")) << ' '
+       << cumulativeCount << '\n';
+  }
+  auto sumMicroseconds = sumMicroseconds_.load(std::memory_order_relaxed);
+  os << name << "_sum" << formatLabels(labels, "") << ' '
+     << absl::StrFormat("%.6f", static_cast<double>(sumMicroseconds) / 1e6)
+     << '\n';
+  os << name << "_count" << formatLabels(labels, "") << ' ' << cumulativeCount
+     << '\n';
+}
+
+// _____________________________________________________________________________
+void ServerMetrics::recordRequest(OperationType operationType,
+                                  ad_utility::MediaType mediaType,
+                                  std::chrono::microseconds duration) {
+  requestDurations_.at(static_cast<size_t>(operationType))
+      .at(static_cast<size_t>(mediaType))
+      .observe(duration);
+}
+
+// _____________________________________________________________________________
+void ServerMetrics::write(std::ostream& os) const {
+  constexpr std::string_view name = "qlever_request_duration_seconds";
+  os << "# HELP " << name
+     << " The time from the arrival of a SPARQL request until its response "
+        "was completely sent.\n";
+  os << "# TYPE " << name << " histogram\n";
+  for (size_t i = 0; i < numOperationTypes_; ++i) {
+    std::string_view operation =
+        static_cast<OperationType>(i) == OperationType::Query ? "query"
+                                                              : "update";
+    for (size_t j = 0; j < numMediaTypes_; ++j) {
+      const auto& histogram = requestDurations_[i][j];
+      if (histogram.count() == 0) {
+        continue;
+      }
+      const auto& mediaType =
+          ad_utility::toString(static_cast<ad_utility::MediaType>(j));
+      histogram.write(os, name,
+                      absl::StrCat("operation=\"", operation,
+                                   "\",media_type=\"", mediaType, "\""));
+    }
+  }
+
+  // All the lines of a metric have to be consecutive.
+  auto writeThreadPools = [&os, this](std::string_view name,
+                                      std::string_view help, auto member) {
+    os << "# HELP " << name << ' ' << help << '\n';
+    os << "# TYPE " << name << " gauge\n";
+    for (auto [pool, tasks] : {std::pair{"query", &queryThreadPool_},
+                               std::pair{"update", &updateThreadPool_}}) {
+      os << name << "{pool=\"" << pool << "\"} "
+         << std::invoke(member, *tasks).load(std::memory_order_relaxed)
+         << '\n';
+    }
+  };
+  writeThreadPools("qlever_thread_pool_queued_tasks",
+                   "The number of tasks that wait for a free thread of the "
+                   "thread pool.",
+                   &ThreadPoolTasks::numQueued_);
+  writeThreadPools("qlever_thread_pool_running_tasks",
+                   "The number of tasks that are currently running on the "
+                   "thread pool.",
+                   &ThreadPoolTasks::numRunning_);
+}
+
+// _____________________________________________________________________________
+void ServerMetrics::writeMetric(std::ostream& os, std::string_view name,
+                                std::string_view type, std::string_view help,
+                                double value) {
+  os << "# HELP " << name << ' ' << help << '\n';
+  os << "# TYPE " << name << ' ' << type << '\n';
+  os << name << ' ' << absl::StrFormat("%.17g", value) << '\n';
+}
@@ -0,0 +1,96 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_SERVERMETRICS_H
+#define QLEVER_SRC_ENGINE_SERVERMETRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+#include "util/http/MediaTypes.h"
+
+// A histogram of durations with fixed buckets, which can be updated and read
+// concurrently without any locks.
+class LatencyHistogram {
+ public:
+  // The upper bounds of the buckets in seconds (the default buckets of the
+  // Prometheus client libraries, extended up to the usual query timeouts).
+  static constexpr std::array<double, 14> bucketBounds_{
+      0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5,
+      1,     2.5,  5,     10,   30,  60,  300};
+
+ private:
+  // The number of durations per bucket (not cumulative). The last bucket
+  // contains the durations that are larger than all the bounds.
+  std::array<std::atomic<uint64_t>, bucketBounds_.size() + 1> buckets_{};
+  std::atomic<uint64_t> sumMicroseconds_ = 0;
+
+ public:
+  void observe(std::chrono::microseconds duration);
+
+  // The total number of observed durations.
+  uint64_t count() const;
+
+  // Write the `_bucket`, `_sum`, and `_count` lines of the histogram in the
+  // text format of Prometheus. The `labels` (without the braces, possibly
+  // empty) are added to each line.
+  void write(std::ostream& os, std::string_view name,
+             std::string_view labels) const;
+};
+
+// The metrics of the `Server` that are collected while the server is running
+// and exposed at the `/metrics` endpoint in the text format of Prometheus (and
+// OpenMetrics). All the members can be updated from any thread without taking
+// a lock, s.t. neither the recording nor the scraping of the metrics contends
+// with the execution of the queries.
+class ServerMetrics {
+ public:
+  enum class OperationType { Query, Update };
+
+  // The number of tasks of a thread pool that are waiting for a free thread
+  // or are currently running.
+  struct ThreadPoolTasks {
+    std::atomic<size_t> numQueued_ = 0;
+    std::atomic<size_t> numRunning_ = 0;
+  };
+  ThreadPoolTasks queryThreadPool_;
+  ThreadPoolTasks updateThreadPool_;
+
+ private:
+  static constexpr size_t numOperationTypes_ = 2;
+  static constexpr size_t numMediaTypes_ =
+      static_cast<size_t>(ad_utility::MediaType::arrowStream) + 1;
+  // The durations of the requests, by the operation type and the media type of
+  // the response.
+  std::array<std::array<LatencyHistogram, numMediaTypes_>, numOperationTypes_>
+      requestDurations_;
+
+ public:
+  // Record a successfully processed request.
+  void recordRequest(OperationType operationType,
+                     ad_utility::MediaType mediaType,
+                     std::chrono::microseconds duration);
+
+  // Write the histograms of the request durations (only the ones of the
+  // combinations of operation and media type that occurred) and the tasks of
+  // the thread pools.
+  void write(std::ostream& os) const;
+
+  // Write a single metric without labels, with its `# HELP` and `# TYPE`
+  // lines. The `type` is either `counter` or `gauge`.
+  static void writeMetric(std::ostream& os, std::string_view name,
+                          std::string_view type, std::string_view help,
+                          double value);
+};
+
+#endif  // QLEVER_SRC_ENGINE_SERVERMETRICS_H
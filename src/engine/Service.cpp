@@ -9,6 +9,10 @@
 #include <absl/strings/str_cat.h>
 #include <absl/strings/str_join.h>
 
+#include <algorithm>
+#include <boost/url/parse.hpp>
+#include <boost/url/url.hpp>
+
 #include "backports/StartsWithAndEndsWith.h"
 #include "engine/CallFixedSize.h"
 #include "engine/ExportQueryExecutionTrees.h"
@@ -22,11 +26,28 @@
 #include "util/HashMap.h"
 #include "util/HashSet.h"
 #include "util/StringUtils.h"
+#include "util/ThreadSafeQueue.h"
 #include "util/http/HttpUtils.h"
+#include "util/http/MediaTypes.h"
 
 namespace {
 // CTRE regex patterns for C++17 compatibility
 constexpr ctll::fixed_string selectPatternRegex = "[ \t\r\n]*SELECT";
+
+// The maximal number of rows of a sibling result that is pushed into a
+// SERVICE. Sibling results with more than `service-max-value-rows` rows are
+// split into several requests (bind join), unless this is disabled by setting
+// `service-max-value-rows` to zero.
+size_t maxSiblingRows() {
+  const size_t maxValueRows =
+      getRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>();
+  if (maxValueRows == 0) {
+    return 0;
+  }
+  return std::max(
+      maxValueRows,
+      getRuntimeParameter<&RuntimeParameters::serviceBindJoinMaxRows_>());
+}
 }  // namespace
 
 // ____________________________________________________________________________
@@ -111,13 +132,18 @@ std::string Service::pushDownValues(std::string_view pattern,
 }
 
 // _____________________________________________________________________________
-std::string Service::getGraphPattern() const {
+std::vector<std::string> Service::getGraphPatterns() const {
   // Try to simplify the Service Query using it's sibling Operation.
   const auto& graphPattern = parsedServiceClause_.graphPatternAsString_;
-  if (auto valuesClause = getSiblingValuesClause(); valuesClause.has_value()) {
-    return pushDownValues(graphPattern, valuesClause.value());
+  auto valuesClauses = getSiblingValuesClauses();
+  if (valuesClauses.empty()) {
+    return {graphPattern};
+  }
+  std::vector<std::string> graphPatterns;
+  for (const auto& valuesClause : valuesClauses) {
+    graphPatterns.push_back(pushDownValues(graphPattern, valuesClause));
   }
-  return graphPattern;
+  return graphPatterns;
 }
 
 // _____________________________________________________________________________
@@ -164,13 +190,56 @@ void Service::throwIfIriNotWhitelisted() {
 
 // ____________________________________________________________________________
 Result Service::computeResultImpl(bool requestLaziness) {
-  // Get the URL of the SPARQL endpoint.
   if (getRuntimeParameter<&RuntimeParameters::syntaxTestMode_>()) {
     return makeNeutralElementResultForSilentFail();
   }
 
   throwIfIriNotWhitelisted();
 
+  auto graphPatterns = getGraphPatterns();
+  if (graphPatterns.size() == 1) {
+    auto generator = fetchResult(graphPatterns.front(), !requestLaziness);
+    return requestLaziness
+               ? Result{std::move(generator), resultSortedOn()}
+               : Result{ad_utility::getSingleElement(std::move(generator)),
+                        resultSortedOn()};
+  }
+
+  // The values of the sibling have been split into several batches (bind
+  // join), for each of which a separate request is sent. The join with the
+  // values distributes over the union of the batches, so the union of the
+  // results of the requests is the result for all the values.
+  runtimeInfo().addDetail("num-bind-join-requests", graphPatterns.size());
+  const size_t numThreads = std::clamp<size_t>(
+      getRuntimeParameter<
+          &RuntimeParameters::serviceBindJoinNumParallelRequests_>(),
+      1, graphPatterns.size());
+  auto sharedPatterns = std::make_shared<const std::vector<std::string>>(
+      std::move(graphPatterns));
+  auto fetchBatch = [this, sharedPatterns](size_t& i) {
+    return ad_utility::getSingleElement(
+        fetchResult(sharedPatterns->at(i), true));
+  };
+  // The results are yielded in the order in which they arrive.
+  Result::LazyResult generator{ad_utility::data_structures::parallelTransform(
+      ad_utility::InputRangeTypeErased{
+          ql::views::iota(size_t{0}, sharedPatterns->size())},
+      std::move(fetchBatch), numThreads, numThreads, false)};
+  if (requestLaziness) {
+    return {std::move(generator), resultSortedOn()};
+  }
+  IdTable idTable{getResultWidth(), getExecutionContext()->getAllocator()};
+  LocalVocab localVocab;
+  for (auto& pair : generator) {
+    idTable.insertAtEnd(pair.idTable_);
+    localVocab.mergeWith(pair.localVocab_);
+  }
+  return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
+}
+
+// ____________________________________________________________________________
+Result::LazyResult Service::fetchResult(const std::string& graphPattern,
+                                        bool singleIdTable) const {
   ad_utility::httpUtils::Url serviceUrl{
       asStringViewUnsafe(parsedServiceClause_.serviceIri_.getContent())};
 
@@ -182,7 +251,7 @@ Result Service::computeResultImpl(bool requestLaziness) {
           : absl::StrJoin(variables, " ", Variable::AbslFormatter);
   std::string serviceQuery =
       absl::StrCat(parsedServiceClause_.prologue_, "\nSELECT ",
-                   variablesForSelectClause, " ", getGraphPattern());
+                   variablesForSelectClause, " ", graphPattern);
   AD_LOG_INFO << "Sending SERVICE query to remote endpoint "
               << "(protocol: " << serviceUrl.protocolAsString()
               << ", host: " << serviceUrl.host()
@@ -195,10 +264,35 @@ Result Service::computeResultImpl(bool requestLaziness) {
   // `service-max-redirects`.
   const size_t maxRedirects =
       getRuntimeParameter<&RuntimeParameters::serviceMaxRedirects_>();
+  // Endpoints that don't support the binary format of QLever fall back to
+  // SPARQL JSON because of its lower quality value.
+  const std::string& binaryMediaType =
+      ad_utility::toString(ad_utility::MediaType::binaryQleverExport);
+  const bool acceptBinary =
+      getRuntimeParameter<&RuntimeParameters::serviceBinaryResults_>();
+  // If the remote QLever uses the same vocabulary, it sends the IDs of the
+  // vocabulary as is, see `BinaryExport.h`.
+  const bool acceptVocabIds =
+      acceptBinary &&
+      getRuntimeParameter<&RuntimeParameters::serviceVocabularyIds_>();
+  if (acceptVocabIds) {
+    auto url = boost::urls::parse_uri(
+        asStringViewUnsafe(parsedServiceClause_.serviceIri_.getContent()));
+    if (url.has_value()) {
+      boost::urls::url withIndexId{url.value()};
+      withIndexId.params().append(boost::urls::param_view{
+          qlever::binary_export::INDEX_ID_PARAMETER,
+          std::string_view{getIndex().getIndexId()}});
+      serviceUrl = ad_utility::httpUtils::Url{withIndexId.buffer()};
+    }
+  }
+  std::string acceptHeader =
+      acceptBinary ? absl::StrCat(binaryMediaType,
+                                  ", application/sparql-results+json;q=0.9")
+                   : "application/sparql-results+json";
   HttpOrHttpsResponse response = getResultFunction_(
       serviceUrl, cancellationHandle_, boost::beast::http::verb::post,
-      serviceQuery, "application/sparql-query",
-      "application/sparql-results+json", maxRedirects);
+      serviceQuery, "application/sparql-query", acceptHeader, maxRedirects);
 
   auto throwErrorWithContext = [this, &response](std::string_view sv) {
     this->throwErrorWithContext(sv, std::move(response).readResponseHead(100));
@@ -211,8 +305,12 @@ Result Service::computeResultImpl(bool requestLaziness) {
         static_cast<int>(response.status_), ", ",
         toStd(boost::beast::http::obsolete_reason(response.status_))));
   }
-  if (!ql::starts_with(ad_utility::utf8ToLower(response.contentType_),
-                       "application/sparql-results+json")) {
+  auto contentType = ad_utility::utf8ToLower(response.contentType_);
+  if (acceptBinary && ql::starts_with(contentType, binaryMediaType)) {
+    return computeResultFromBinaryExport(std::move(response.body_),
+                                         singleIdTable, acceptVocabIds);
+  }
+  if (!ql::starts_with(contentType, "application/sparql-results+json")) {
     throwErrorWithContext(absl::StrCat(
         "QLever requires the endpoint of a SERVICE to send the result as "
         "'application/sparql-results+json' but the endpoint sent '",
@@ -233,12 +331,7 @@ Result Service::computeResultImpl(bool requestLaziness) {
   // Note: The `body`-generator also keeps the complete response connection
   // alive, so we have no lifetime issue here(see `HttpRequest::send` for
   // details).
-  auto generator =
-      computeResultLazily(expVariableKeys, std::move(body), !requestLaziness);
-  return requestLaziness
-             ? Result{std::move(generator), resultSortedOn()}
-             : Result{ad_utility::getSingleElement(std::move(generator)),
-                      resultSortedOn()};
+  return computeResultLazily(expVariableKeys, std::move(body), singleIdTable);
 }
 
 template <size_t I>
@@ -370,9 +463,157 @@ Result::LazyResult Service::computeResultLazily(
 }
 
 // ____________________________________________________________________________
-std::optional<std::string> Service::getSiblingValuesClause() const {
+void Service::writeBinaryBatch(const qlever::binary_export::Batch& batch,
+                               BinaryImportState& state, IdTable& idTable,
+                               LocalVocab& localVocab) const {
+  // Each string of the stream is converted only once.
+  if (batch.clearsDictionary_) {
+    state.dictionary_.clear();
+    state.dictionaryVocab_ = LocalVocab{};
+  }
+  LocalVocab newWords;
+  state.dictionary_.reserve(state.dictionary_.size() + batch.strings_.size());
+  for (const auto& string : batch.strings_) {
+    auto literalOrIri =
+        ad_utility::triple_component::LiteralOrIri::fromStringRepresentation(
+            string);
+    TripleComponent tc =
+        literalOrIri.isLiteral()
+            ? TripleComponent{std::move(literalOrIri.getLiteral())}
+            : TripleComponent{std::move(literalOrIri.getIri())};
+    state.dictionary_.push_back(std::move(tc).toValueId(getIndex(), newWords));
+  }
+  // The words are only added to `newWords`, the word sets of the
+  // `dictionaryVocab_` and the `localVocab` are shared and never modified.
+  state.dictionaryVocab_.mergeWith(newWords);
+  localVocab.mergeWith(newWords);
+  checkCancellation();
+
+  auto* blankNodeManager = getIndex().getBlankNodeManager();
+  auto convert = [&](Id id) {
+    switch (id.getDatatype()) {
+      case Datatype::LocalVocabIndex:
+        return state.dictionary_.at(qlever::binary_export::stringIndex(id));
+      case Datatype::BlankNodeIndex: {
+        auto [it, wasNew] = state.blankNodeMap_.try_emplace(id.getBits(), Id());
+        if (wasNew) {
+          it->second = Id::makeFromBlankNodeIndex(
+              state.blankNodeVocab_.getBlankNodeIndex(blankNodeManager));
+        }
+        return it->second;
+      }
+      case Datatype::VocabIndex:
+        // Only sent by a QLever with the same vocabulary (see
+        // `BinaryExport.h`), but check that the ID is valid nevertheless.
+        if (id.getVocabIndex().get() >= getIndex().getVocab().size()) {
+          throw std::runtime_error(
+              "The binary result contains an ID that is not part of the "
+              "vocabulary");
+        }
+        return id;
+      default:
+        // All the other IDs are trivial (see `BinaryExport.h`).
+        return id;
+    }
+  };
+
+  const size_t firstRow = idTable.numRows();
+  idTable.resize(firstRow + batch.numRows_);
+  for (size_t colIdx = 0; colIdx < state.columns_.size(); ++colIdx) {
+    auto column = idTable.getColumn(colIdx);
+    for (size_t row = 0; row < batch.numRows_; ++row) {
+      column[firstRow + row] = convert(batch(row, state.columns_[colIdx]));
+    }
+    checkCancellation();
+  }
+  if (!state.blankNodeMap_.empty()) {
+    localVocab.mergeWith(state.blankNodeVocab_);
+  }
+}
+
+// ____________________________________________________________________________
+Result::LazyResult Service::computeResultFromBinaryExport(
+    cppcoro::generator<ql::span<std::byte>> body, bool singleIdTable,
+    bool acceptsVocabIds) {
+  using LC = Result::IdTableLoopControl;
+  auto get = [service = this, singleIdTable, acceptsVocabIds,
+              inputRange = moveToCachingInputRange(std::move(body)),
+              parser = qlever::binary_export::StreamParser{},
+              state = BinaryImportState{}, localVocab = LocalVocab{},
+              idTable = IdTable{getResultWidth(),
+                                getExecutionContext()->getAllocator()},
+              columnsChecked = false]() mutable {
+    auto throwError = [service](std::string_view msg) {
+      throw std::runtime_error(absl::StrCat(
+          "Error while executing a SERVICE request to ",
+          service->parsedServiceClause_.serviceIri_.toStringRepresentation(),
+          ": ", msg));
+    };
+    // The blank nodes of the chunks are owned by the `blankNodeVocab_`.
+    auto makeChunk = [&]() {
+      if (!state.blankNodeMap_.empty()) {
+        localVocab.mergeWith(state.blankNodeVocab_);
+      }
+      Result::IdTableVocabPair pair{std::move(idTable), std::move(localVocab)};
+      idTable = IdTable{service->getResultWidth(),
+                        service->getExecutionContext()->getAllocator()};
+      // The following batches may refer to the strings of the dictionary.
+      localVocab = LocalVocab{};
+      localVocab.mergeWith(state.dictionaryVocab_);
+      return pair;
+    };
+
+    while (!parser.isFinished()) {
+      auto batch = parser.nextBatch();
+      if (!columnsChecked && parser.columnNames().has_value()) {
+        if (parser.transfersVocabIds() && !acceptsVocabIds) {
+          throwError(
+              "Binary result contains IDs of the vocabulary of the endpoint, "
+              "which were not requested");
+        }
+        // Find the column of each visible variable.
+        const auto& columnNames = parser.columnNames().value();
+        for (const auto& variable :
+             service->parsedServiceClause_.visibleVariables_) {
+          auto it = ql::ranges::find(columnNames, variable.name().substr(1));
+          if (it == columnNames.end()) {
+            throwError(absl::StrCat("Binary result does not contain the "
+                                    "expected variable ",
+                                    variable.name()));
+          }
+          state.columns_.push_back(it - columnNames.begin());
+        }
+        columnsChecked = true;
+      }
+      if (batch.has_value()) {
+        service->writeBinaryBatch(batch.value(), state, idTable, localVocab);
+        if (!singleIdTable) {
+          return LC::yieldValue(makeChunk());
+        }
+      } else if (!parser.isFinished()) {
+        auto bytes = inputRange.get();
+        if (!bytes.has_value()) {
+          throwError("Binary result is incomplete (end marker missing)");
+        }
+        parser.addBytes(std::string_view{
+            reinterpret_cast<const char*>(bytes->data()), bytes->size()});
+        service->checkCancellation();
+      }
+    }
+
+    if (singleIdTable) {
+      return LC::breakWithValue(makeChunk());
+    }
+    return LC::makeBreak();
+  };
+  return Result::LazyResult{
+      ad_utility::InputRangeFromLoopControlGet{std::move(get)}};
+}
+
+// ____________________________________________________________________________
+std::vector<std::string> Service::getSiblingValuesClauses() const {
   if (!siblingInfo_.has_value()) {
-    return std::nullopt;
+    return {};
   }
   const auto& [siblingResult, siblingVars, _] = siblingInfo_.value();
   AD_CORRECTNESS_CHECK(siblingResult != nullptr);
@@ -410,8 +651,10 @@ std::optional<std::string> Service::getSiblingValuesClause() const {
     return row;
   };
 
+  // The rows are deduplicated across all the batches, s.t. the batches are a
+  // partition of the distinct rows.
   ad_utility::HashSet<std::string> rowSet;
-  std::string values = " { ";
+  std::vector<std::string> rows;
   for (size_t rowIndex = 0; rowIndex < siblingResult->idTable().size();
        ++rowIndex) {
     std::string row = createValueRow(rowIndex);
@@ -419,12 +662,32 @@ std::optional<std::string> Service::getSiblingValuesClause() const {
       continue;
     }
     rowSet.insert(row);
-
-    absl::StrAppend(&values, row, " ");
+    rows.push_back(std::move(row));
     checkCancellation();
   }
 
-  return "VALUES " + vars + values + "} . ";
+  // Larger sibling results than `service-max-value-rows` (which are only
+  // stored by `precomputeSiblingResult` for a bind join) are split into
+  // batches of that size. The value zero means that the sibling result is
+  // never pushed into the SERVICE automatically, so there is no limit for the
+  // sibling results that are set manually.
+  const size_t maxValueRows =
+      getRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>();
+  const size_t batchSize =
+      maxValueRows == 0 ? std::max<size_t>(rows.size(), 1) : maxValueRows;
+  std::vector<std::string> valuesClauses;
+  size_t begin = 0;
+  do {
+    size_t end = std::min(begin + batchSize, rows.size());
+    std::string values = absl::StrCat("VALUES ", vars, " { ");
+    for (size_t i = begin; i < end; ++i) {
+      absl::StrAppend(&values, rows[i], " ");
+    }
+    absl::StrAppend(&values, "} . ");
+    valuesClauses.push_back(std::move(values));
+    begin = end;
+  } while (begin < rows.size());
+  return valuesClauses;
 }
 
 // ____________________________________________________________________________
@@ -631,10 +894,9 @@ void Service::precomputeSiblingResult(std::shared_ptr<Operation> left,
       false, requestLaziness ? ComputationMode::LAZY_IF_SUPPORTED
                              : ComputationMode::FULLY_MATERIALIZED);
 
+  const size_t maxValueRows = maxSiblingRows();
   if (siblingResult->isFullyMaterialized()) {
-    bool resultIsSmall =
-        siblingResult->idTable().size() <=
-        getRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>();
+    bool resultIsSmall = siblingResult->idTable().size() <= maxValueRows;
     if (resultIsSmall) {
       service->siblingInfo_.emplace(
           siblingResult, sibling->getExternallyVisibleVariableColumns(),
@@ -655,8 +917,6 @@ void Service::precomputeSiblingResult(std::shared_ptr<Operation> left,
   // keep and pass an iterator to the sibling result if the max row threshold
   // is exceeded
   auto generator = moveToCachingInputRange(siblingResult->idTables());
-  const size_t maxValueRows =
-      getRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>();
   while (auto pairOpt = generator.get()) {
     auto& pair = pairOpt.value();
     rows += pair.idTable_.size();
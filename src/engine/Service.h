@@ -9,6 +9,7 @@
 #ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
 
 #include "backports/functional.h"
+#include "engine/BinaryExport.h"
 #include "engine/Operation.h"
 #include "engine/VariableToColumnMap.h"
 #include "parser/ParsedQuery.h"
@@ -17,7 +18,9 @@
 
 // The SERVICE operation. Sends a query to the remote endpoint specified by the
 // service IRI, gets the result as JSON, parses it, and writes it into a result
-// table.
+// table. If the runtime parameter `service-binary-results` is set, the binary
+// format of QLever (see `BinaryExport.h`) is requested in addition, which
+// remote QLever instances can send much more efficiently.
 //
 // TODO: The current implementation works, but is preliminary in several
 // respects:
@@ -47,7 +50,7 @@ class Service : public Operation {
   // The function used to obtain the result from the remote endpoint.
   SendRequestType getResultFunction_;
 
-  // Optional sibling information to be used in `getSiblingValuesClause`.
+  // Optional sibling information to be used in `getSiblingValuesClauses`.
   std::optional<SiblingInfo> siblingInfo_;
 
   // Counter to generate fresh ids for each instance of the class.
@@ -92,7 +95,7 @@ class Service : public Operation {
       ad_utility::HashMap<std::string, Id>& blankNodeMap,
       LocalVocab* localVocab) const;
 
-  // Create a value for the VALUES-clause used in `getSiblingValuesClause` from
+  // Create a value for the VALUES-clause used in `getSiblingValuesClauses` from
   // id. If the id is of type blank node `std::nullopt` is returned.
   static std::optional<std::string> idToValueForValuesClause(
       const Index& index, Id id, const LocalVocab& localVocab);
@@ -116,9 +119,11 @@ class Service : public Operation {
   static std::string pushDownValues(std::string_view pattern,
                                     std::string_view values);
 
-  // Return the optimized graph pattern derived from `parsedServiceClause_` and
-  // an optional derived sibling.
-  std::string getGraphPattern() const;
+  // Return the optimized graph patterns derived from `parsedServiceClause_` and
+  // an optional derived sibling. There is more than one graph pattern if the
+  // values of the sibling are sent in several batches (see
+  // `getSiblingValuesClauses`), one request is sent per graph pattern.
+  std::vector<std::string> getGraphPatterns() const;
 
   // Compute the result using `getResultFunction_` and `siblingInfo_`.
   Result computeResult(bool requestLaziness) override;
@@ -126,8 +131,17 @@ class Service : public Operation {
   // Actually compute the result for the function above.
   Result computeResultImpl(bool requestLaziness);
 
-  // Get a VALUES clause that contains the values of the siblingTree's result.
-  std::optional<std::string> getSiblingValuesClause() const;
+  // Send the query with the given `graphPattern` to the remote endpoint and
+  // return the (lazily parsed) result. If `singleIdTable` is set, the result
+  // is yielded as one `IdTable`.
+  Result::LazyResult fetchResult(const std::string& graphPattern,
+                                 bool singleIdTable);
+
+  // Get the VALUES clauses that contain the values of the siblingTree's
+  // result. The distinct rows of the values are split into batches of at most
+  // `service-max-value-rows` rows, one clause per batch. Return an empty
+  // vector if there is no sibling.
+  std::vector<std::string> getSiblingValuesClauses() const;
 
   // Create result for silent fail.
   Result makeNeutralElementResultForSilentFail() const;
@@ -162,11 +176,43 @@ class Service : public Operation {
       const std::vector<std::string> vars,
       ad_utility::LazyJsonParser::Generator body, bool singleIdTable);
 
+  // The state of `computeResultFromBinaryExport` that is shared between the
+  // batches of a result.
+  struct BinaryImportState {
+    // For each visible variable, the column of the received result.
+    std::vector<size_t> columns_;
+    // The blank nodes of the remote result are identified by their IDs and
+    // mapped to new local blank nodes, which are allocated by the
+    // `blankNodeVocab_` s.t. they are consistent across all the batches.
+    ad_utility::HashMap<Id::T, Id> blankNodeMap_;
+    LocalVocab blankNodeVocab_;
+    // The IDs of the strings of the dictionary of the stream. The strings
+    // that are not contained in the index are owned by the
+    // `dictionaryVocab_`, which is merged into the local vocab of each chunk.
+    std::vector<Id> dictionary_;
+    LocalVocab dictionaryVocab_;
+  };
+
+  // Append the rows of the `batch` of a binary result to the `idTable`, the
+  // strings are added to the `localVocab`.
+  void writeBinaryBatch(const qlever::binary_export::Batch& batch,
+                        BinaryImportState& state, IdTable& idTable,
+                        LocalVocab& localVocab) const;
+
+  // Like `computeResultLazily`, but for a result in the binary format of
+  // QLever. If `acceptsVocabIds` is false, a result that transfers the IDs of
+  // the vocabulary as is (see `BinaryExport.h`) is an error.
+  Result::LazyResult computeResultFromBinaryExport(
+      cppcoro::generator<ql::span<std::byte>> body, bool singleIdTable,
+      bool acceptsVocabIds = false);
+
   FRIEND_TEST(ServiceTest, computeResult);
   FRIEND_TEST(ServiceTest, computeResultWrapSubqueriesWithSibling);
   FRIEND_TEST(ServiceTest, precomputeSiblingResultDoesNotWorkWithCaching);
   FRIEND_TEST(ServiceTest, precomputeSiblingResultDoesNotWorkWithLimit);
   FRIEND_TEST(ServiceTest, precomputeSiblingResult);
+  FRIEND_TEST(ServiceTest, bindJoin);
+  FRIEND_TEST(ServiceTest, computeResultFromBinaryExport);
 };
 #else
 // In the C++17 mode, where the If we disable the `Service` operation isled,
@@ -0,0 +1,256 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/SharedLazyResults.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "util/Exception.h"
+#include "util/Iterators.h"
+
+namespace sharedLazyResults::detail {
+
+// _____________________________________________________________________________
+std::optional<size_t> SharedLazyResultState::tryAddConsumer() {
+  std::lock_guard lock{mutex_};
+  if (!isJoinable_) {
+    return std::nullopt;
+  }
+  positions_.emplace_back(0);
+  return positions_.size() - 1;
+}
+
+// _____________________________________________________________________________
+auto SharedLazyResultState::next(size_t consumerId, bool isOwner,
+                                 std::optional<Chunk>& result) -> SourceStatus {
+  std::unique_lock lock{mutex_};
+  while (true) {
+    const size_t position = positions_.at(consumerId).value();
+    if (position < firstChunkIndex_ + chunks_.size()) {
+      result = takeChunk(consumerId);
+      return SourceStatus::Available;
+    }
+    if (sourceIsFinished_) {
+      return SourceStatus::Finished;
+    }
+    if (sourceIsLost_) {
+      if (isOwner && error_) {
+        std::rethrow_exception(error_);
+      }
+      return SourceStatus::Lost;
+    }
+    if (producing_) {
+      sourceChanged_.wait(lock);
+      continue;
+    }
+
+    // Pull the next chunk from the `source_`. The lock is released while doing
+    // so, s.t. the other consumers can meanwhile read the buffered chunks.
+    producing_ = true;
+    lock.unlock();
+    std::optional<Chunk> chunk;
+    std::exception_ptr error;
+    try {
+      chunk = source_.get();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    if (!chunk.has_value()) {
+      // The source is either exhausted or broken. Destroying it might run some
+      // callbacks (e.g. for the runtime information), so we don't hold the
+      // lock for it.
+      [[maybe_unused]] auto finished = std::move(source_);
+    }
+    lock.lock();
+    producing_ = false;
+    if (error) {
+      error_ = error;
+      sourceIsLost_ = true;
+    } else if (!chunk.has_value()) {
+      sourceIsFinished_ = true;
+    } else {
+      auto size = CacheValue::getSize(chunk.value().idTable_);
+      bufferedSize_ += size;
+      chunks_.push_back(BufferedChunk{std::move(chunk).value(), size});
+      if (bufferedSize_ > maxReplaySize_) {
+        isJoinable_ = false;
+      }
+      removeConsumedChunks();
+    }
+    sourceChanged_.notify_all();
+  }
+}
+
+// _____________________________________________________________________________
+auto SharedLazyResultState::takeChunk(size_t consumerId) -> Chunk {
+  size_t& position = positions_.at(consumerId).value();
+  const size_t index = position;
+  ++position;
+  auto& chunk = chunks_.at(index - firstChunkIndex_).chunk_;
+  auto isBefore = [index](const std::optional<size_t>& otherPosition) {
+    return otherPosition.has_value() && otherPosition.value() <= index;
+  };
+  bool isNeededByOthers =
+      isJoinable_ || ql::ranges::any_of(positions_, isBefore);
+  Chunk result = isNeededByOthers
+                     ? Chunk{chunk.idTable_.clone(), chunk.localVocab_.clone()}
+                     : std::move(chunk);
+  removeConsumedChunks();
+  return result;
+}
+
+// _____________________________________________________________________________
+void SharedLazyResultState::removeConsumedChunks() {
+  if (isJoinable_) {
+    return;
+  }
+  size_t minPosition = firstChunkIndex_ + chunks_.size();
+  for (const auto& position : positions_) {
+    if (position.has_value()) {
+      minPosition = std::min(minPosition, position.value());
+    }
+  }
+  while (firstChunkIndex_ < minPosition) {
+    bufferedSize_ -= chunks_.front().size_;
+    chunks_.pop_front();
+    ++firstChunkIndex_;
+  }
+}
+
+// _____________________________________________________________________________
+void SharedLazyResultState::removeConsumer(size_t consumerId, bool isOwner) {
+  // Declared before the lock, s.t. the `source_` is destroyed after the lock
+  // has been released (see `next` for the reason).
+  Result::LazyResult sourceToDestroy;
+  std::unique_lock lock{mutex_};
+  positions_.at(consumerId).reset();
+  if (isOwner) {
+    // The `source_` must not outlive the query of the owner, so we wait for a
+    // concurrent `next` to finish reading from it.
+    sourceChanged_.wait(lock, [this]() { return !producing_; });
+    isJoinable_ = false;
+    if (!sourceIsFinished_ && !sourceIsLost_) {
+      sourceIsLost_ = true;
+      sourceToDestroy = std::move(source_);
+    }
+  }
+  removeConsumedChunks();
+  sourceChanged_.notify_all();
+}
+}  // namespace sharedLazyResults::detail
+
+namespace {
+using sharedLazyResults::detail::SharedLazyResultState;
+
+// A single consumer of a shared lazy result.
+class SharedLazyResultConsumer
+    : public ad_utility::InputRangeFromGet<Result::IdTableVocabPair> {
+  std::shared_ptr<SharedLazyResultState> state_;
+  size_t consumerId_;
+  bool isOwner_;
+  // Only used by consumers that are not the owner, see
+  // `SharedLazyResults::join`.
+  std::function<Result::LazyResult()> fallback_;
+  std::optional<Result::LazyResult> fallbackResult_;
+  bool hasYieldedChunk_ = false;
+
+ public:
+  SharedLazyResultConsumer(std::shared_ptr<SharedLazyResultState> state,
+                           size_t consumerId, bool isOwner,
+                           std::function<Result::LazyResult()> fallback)
+      : state_{std::move(state)},
+        consumerId_{consumerId},
+        isOwner_{isOwner},
+        fallback_{std::move(fallback)} {}
+
+  SharedLazyResultConsumer(const SharedLazyResultConsumer&) = delete;
+  SharedLazyResultConsumer& operator=(const SharedLazyResultConsumer&) =
+      delete;
+
+  ~SharedLazyResultConsumer() override {
+    state_->removeConsumer(consumerId_, isOwner_);
+  }
+
+  std::optional<Result::IdTableVocabPair> get() override {
+    if (fallbackResult_.has_value()) {
+      return fallbackResult_->get();
+    }
+    using enum SharedLazyResultState::SourceStatus;
+    std::optional<Result::IdTableVocabPair> chunk;
+    switch (state_->next(consumerId_, isOwner_, chunk)) {
+      case Available:
+        hasYieldedChunk_ = true;
+        return chunk;
+      case Finished:
+        return std::nullopt;
+      default:
+        AD_CORRECTNESS_CHECK(!isOwner_);
+        if (hasYieldedChunk_) {
+          throw std::runtime_error(
+              "The computation of a lazy result that was shared with a "
+              "concurrent query was stopped before it was complete");
+        }
+        fallbackResult_ = fallback_();
+        return fallbackResult_->get();
+    }
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+Result::LazyResult SharedLazyResults::share(
+    const QueryCacheKey& key, Result::LazyResult lazyResult,
+    ad_utility::MemorySize maxReplaySize) {
+  auto state = std::make_shared<State>(std::move(lazyResult), maxReplaySize);
+  auto ownerId = state->tryAddConsumer().value();
+  {
+    auto lock = results_.wlock();
+    absl::erase_if(*lock,
+                   [](const auto& entry) { return entry.second.expired(); });
+    (*lock)[key] = state;
+  }
+  return Result::LazyResult{std::make_unique<SharedLazyResultConsumer>(
+      std::move(state), ownerId, true, nullptr)};
+}
+
+// _____________________________________________________________________________
+std::optional<Result::LazyResult> SharedLazyResults::join(
+    const QueryCacheKey& key, std::function<Result::LazyResult()> fallback) {
+  std::shared_ptr<State> state;
+  {
+    auto lock = results_.wlock();
+    auto it = lock->find(key);
+    if (it == lock->end()) {
+      return std::nullopt;
+    }
+    state = it->second.lock();
+    if (state == nullptr) {
+      lock->erase(it);
+      return std::nullopt;
+    }
+  }
+  auto consumerId = state->tryAddConsumer();
+  if (!consumerId.has_value()) {
+    return std::nullopt;
+  }
+  return Result::LazyResult{std::make_unique<SharedLazyResultConsumer>(
+      std::move(state), consumerId.value(), false, std::move(fallback))};
+}
+
+// _____________________________________________________________________________
+size_t SharedLazyResults::numShared() const {
+  auto lock = results_.rlock();
+  return static_cast<size_t>(
+      ql::ranges::count_if(*lock, [](const auto& entry) {
+        return !entry.second.expired();
+      }));
+}
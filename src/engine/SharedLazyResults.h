@@ -0,0 +1,153 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_SHAREDLAZYRESULTS_H
+#define QLEVER_SRC_ENGINE_SHAREDLAZYRESULTS_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "engine/QueryExecutionContext.h"
+#include "engine/Result.h"
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+namespace sharedLazyResults::detail {
+// The state of a single lazy result that is shared between several consumers.
+// The chunks of the `source` are pulled by whichever consumer first needs
+// them, and are kept in a buffer until all consumers have read them. As long
+// as the first chunk is still in the buffer and the buffer is at most
+// `maxReplaySize` large, additional consumers can join and get all the chunks
+// from the beginning. Afterward, the chunks that have been read by all the
+// consumers are removed from the buffer.
+//
+// The first consumer is the "owner" of the shared result. The `source` belongs
+// to the query of the owner (it refers to its operations and its execution
+// context), so it is destroyed at the latest when the owner is destroyed. The
+// other consumers can then still read the buffered chunks, but not the rest of
+// the result, see `SharedLazyResults::join` for how this is handled.
+class SharedLazyResultState {
+ public:
+  using Chunk = Result::IdTableVocabPair;
+
+  // The outcome of a call to `next`.
+  enum class SourceStatus { Available, Finished, Lost };
+
+ private:
+  struct BufferedChunk {
+    Chunk chunk_;
+    ad_utility::MemorySize size_;
+  };
+
+  std::mutex mutex_;
+  // Notified whenever a new chunk has been pulled from the `source_` or the
+  // source has finished (successfully or not).
+  std::condition_variable sourceChanged_;
+  // Is only accessed by the consumer that has set `producing_`, or after all
+  // consumers have stopped producing.
+  Result::LazyResult source_;
+  bool producing_ = false;
+  bool sourceIsFinished_ = false;
+  // Set if the `source_` has thrown an exception, or if it was destroyed
+  // before it was fully consumed.
+  std::exception_ptr error_;
+  bool sourceIsLost_ = false;
+
+  std::deque<BufferedChunk> chunks_;
+  // The index of `chunks_.front()` in the complete result.
+  size_t firstChunkIndex_ = 0;
+  ad_utility::MemorySize bufferedSize_ = ad_utility::MemorySize::bytes(0);
+  ad_utility::MemorySize maxReplaySize_;
+  bool isJoinable_ = true;
+
+  // The index of the next chunk of each consumer, `std::nullopt` for consumers
+  // that have been removed.
+  std::vector<std::optional<size_t>> positions_;
+
+ public:
+  SharedLazyResultState(Result::LazyResult source,
+                        ad_utility::MemorySize maxReplaySize)
+      : source_{std::move(source)}, maxReplaySize_{maxReplaySize} {}
+
+  // Add a new consumer that starts at the beginning of the result and return
+  // its ID, or `std::nullopt` if the beginning of the result is no longer
+  // buffered.
+  std::optional<size_t> tryAddConsumer();
+
+  // Get the next chunk for the consumer with the given `consumerId` and store
+  // it in `result`. While the `source` is being read by another consumer,
+  // block until the next chunk is available. If the `source` has thrown an
+  // exception and the consumer is the owner, that exception is rethrown.
+  SourceStatus next(size_t consumerId, bool isOwner,
+                    std::optional<Chunk>& result);
+
+  // Remove the consumer with the given `consumerId`. If it is the owner and
+  // the `source` has not been fully consumed yet, the `source` is destroyed.
+  void removeConsumer(size_t consumerId, bool isOwner);
+
+ private:
+  // Return the chunk at the position of the given consumer and advance the
+  // position. The chunk is moved out of the buffer if no other consumer can
+  // read it anymore, otherwise it is copied. Requires that `mutex_` is locked.
+  Chunk takeChunk(size_t consumerId);
+
+  // Remove the chunks that have been read by all the consumers and can no
+  // longer be replayed for new consumers. Requires that `mutex_` is locked.
+  void removeConsumedChunks();
+};
+}  // namespace sharedLazyResults::detail
+
+// Share lazily computed results between concurrently running queries. The
+// `ConcurrentCache` only deduplicates computations whose (fully materialized)
+// result is stored in the cache. A lazy result that is too large for the cache
+// would thus be computed again for each query that requests it, even if these
+// queries run at the same time. Instead, the first query can `share` its lazy
+// result, and identical queries can `join` it, s.t. the result is computed
+// only once and then read by all of them.
+class SharedLazyResults {
+ public:
+  using State = sharedLazyResults::detail::SharedLazyResultState;
+
+ private:
+  // The states are owned by the consumers, so the entries expire when all
+  // consumers of a shared result have been destroyed.
+  ad_utility::Synchronized<
+      ad_utility::HashMap<QueryCacheKey, std::weak_ptr<State>>>
+      results_;
+
+ public:
+  // Make the `lazyResult` for the `key` available for other queries and return
+  // the lazy result that has to be consumed instead of it by the calling
+  // query. With `maxReplaySize`, the size of the chunks that are buffered for
+  // queries that join later is bounded (the replay buffer).
+  Result::LazyResult share(const QueryCacheKey& key,
+                           Result::LazyResult lazyResult,
+                           ad_utility::MemorySize maxReplaySize);
+
+  // If a lazy result for the `key` is currently shared and its beginning is
+  // still buffered, return a lazy result that yields all of its chunks.
+  // Otherwise, return `std::nullopt`. If the query that shares the result
+  // stops before the result is complete (e.g. because it was cancelled), the
+  // joined result is computed again by calling the `fallback` if it hasn't
+  // yielded any chunk yet. If it has, an exception is thrown.
+  std::optional<Result::LazyResult> join(
+      const QueryCacheKey& key, std::function<Result::LazyResult()> fallback);
+
+  // The number of shared results that are currently consumed.
+  size_t numShared() const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_SHAREDLAZYRESULTS_H
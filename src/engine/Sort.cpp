@@ -91,19 +91,32 @@ Result Sort::computeResult(bool requestLaziness) {
   // Always request lazy input to avoid premature materialization.
   std::shared_ptr<const Result> input = subtree_->getResult(true);
 
+  // If the in-memory sort exceeds the memory limit (the allocations for the
+  // copy of the input or for the radix sort fail), fall back to the external
+  // sort instead of failing the query.
+  auto onMemoryLimitExceeded = [this]() {
+    runtimeInfo().addDetail("in-memory-sort-exceeded-memory-limit", true);
+    AD_LOG_INFO << "The in-memory sort exceeded the memory limit, sorting "
+                   "externally instead"
+                << std::endl;
+  };
+
   // For fully materialized input, we know the size upfront.
   if (input->isFullyMaterialized()) {
     const IdTable& inputTable = input->idTable();
+    LocalVocab localVocab = input->getCopyOfLocalVocab();
     if (inputTable.numRows() <= maxNumRowsToBeSortedInMemory) {
-      return computeResultInMemory(inputTable.clone(),
-                                   input->getCopyOfLocalVocab());
-    } else {
-      LocalVocab localVocab = input->getCopyOfLocalVocab();
-      ql::span<const IdTable> inputTableSpan{&inputTable, 1};
-      return computeResultExternal({}, std::move(localVocab),
-                                   inputTableSpan.begin(), inputTableSpan.end(),
-                                   std::move(input), requestLaziness);
+      try {
+        return computeResultInMemory(inputTable.clone(),
+                                     std::move(localVocab));
+      } catch (const ad_utility::detail::AllocationExceedsLimitException&) {
+        onMemoryLimitExceeded();
+      }
     }
+    ql::span<const IdTable> inputTableSpan{&inputTable, 1};
+    return computeResultExternal({}, std::move(localVocab),
+                                 inputTableSpan.begin(), inputTableSpan.end(),
+                                 std::move(input), requestLaziness);
   }
 
   // For lazy input, collect blocks until we exceed the threshold. Note that we
@@ -129,19 +142,28 @@ Result Sort::computeResult(bool requestLaziness) {
         idTables.end(), std::move(input), requestLaziness);
   }
 
-  // Stayed under threshold: concatenate and sort in-memory.
-  IdTable combined{numColumns, allocator()};
-  combined.reserve(totalRows);
-  for (auto& block : collectedBlocks) {
-    combined.insertAtEnd(block);
+  // Stayed under threshold: concatenate and sort in-memory. The
+  // `collectedBlocks` stay valid, so we can still sort externally if this
+  // exceeds the memory limit.
+  try {
+    IdTable combined{numColumns, allocator()};
+    combined.reserve(totalRows);
+    for (auto& block : collectedBlocks) {
+      combined.insertAtEnd(block);
+    }
+    return computeResultInMemory(std::move(combined),
+                                 std::move(mergedLocalVocab));
+  } catch (const ad_utility::detail::AllocationExceedsLimitException&) {
+    onMemoryLimitExceeded();
   }
-  return computeResultInMemory(std::move(combined),
-                               std::move(mergedLocalVocab));
+  return computeResultExternal(
+      std::move(collectedBlocks), std::move(mergedLocalVocab), std::move(it),
+      idTables.end(), std::move(input), requestLaziness);
 }
 
 // _____________________________________________________________________________
 Result Sort::computeResultInMemory(IdTable idTable,
-                                   LocalVocab localVocab) const {
+                                   LocalVocab&& localVocab) const {
   runtimeInfo().addDetail("is-external", "false");
 
   getExecutionContext()->getSortPerformanceEstimator().throwIfEstimateTooLong(
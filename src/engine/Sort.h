@@ -105,8 +105,11 @@ class Sort : public Operation {
 
   virtual Result computeResult(bool requestLaziness) override;
 
-  // Sort in memory, using `IdTableUtils::sort`.
-  Result computeResultInMemory(IdTable idTable, LocalVocab localVocab) const;
+  // Sort in memory, using `IdTableUtils::sort`. The `localVocab` is only moved
+  // from if the sort succeeds, so the caller can still use it for an external
+  // sort if the in-memory sort exceeds the memory limit.
+  Result computeResultInMemory(IdTable idTable,
+                               LocalVocab&& localVocab) const;
 
   // Sort externally, using `CompressedExternalIdTableSorter`, using the value
   // of `sort-in-memory-threshold` as memory limit.
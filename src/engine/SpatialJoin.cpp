@@ -16,6 +16,7 @@
 #include <absl/functional/bind_front.h>
 #include <absl/strings/charconv.h>
 
+#include <cmath>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -36,6 +37,7 @@
 #include "engine/idTable/IdTable.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
+#include "engine/sparqlExpressions/PrefilterExpressionIndex.h"
 #include "engine/sparqlExpressions/SparqlExpressionPimpl.h"
 #include "global/Constants.h"
 #include "global/RuntimeParameters.h"
@@ -459,6 +461,68 @@ VariableToColumnMap SpatialJoin::getVarColMapPayloadVars() const {
   return newVarColMap;
 }
 
+// ____________________________________________________________________________
+std::optional<std::shared_ptr<QueryExecutionTree>>
+SpatialJoin::prefilterRightChildByLatitude(const QueryExecutionTree& childRight,
+                                           const IdTable& idTableLeft,
+                                           ColumnIndex joinColLeft,
+                                           const Variable& joinVarRight) const {
+  auto maxDist = getMaxDist();
+  const auto* libSpatialJoinConfig =
+      std::get_if<LibSpatialJoinConfig>(&config_.task_);
+  bool usesMaxDist =
+      libSpatialJoinConfig == nullptr ||
+      libSpatialJoinConfig->joinType_ == SpatialJoinType::WITHIN_DIST;
+  if (!getRuntimeParameter<
+          &RuntimeParameters::spatialJoinPrefilterIndexScans_>() ||
+      !maxDist.has_value() || !usesMaxDist || idTableLeft.empty()) {
+    return std::nullopt;
+  }
+
+  // The range of the latitudes of the points on the left side. Other
+  // geometries are only available as WKT literals, for which we would have to
+  // compute the bounding box first.
+  double minLat = std::numeric_limits<double>::max();
+  double maxLat = std::numeric_limits<double>::lowest();
+  for (Id id : idTableLeft.getColumn(joinColLeft)) {
+    if (id.isUndefined()) {
+      continue;
+    }
+    if (id.getDatatype() != Datatype::GeoPoint) {
+      return std::nullopt;
+    }
+    double lat = id.getGeoPoint().getLat();
+    minLat = std::min(minLat, lat);
+    maxLat = std::max(maxLat, lat);
+  }
+  if (minLat > maxLat) {
+    return std::nullopt;
+  }
+
+  double extension =
+      prefilterExpressions::LatitudeRangeExpression::maxLatitudeDifference(
+          maxDist.value());
+  minLat = std::max(minLat - extension, -90.0);
+  maxLat = std::min(maxLat + extension, 90.0);
+  if (minLat == -90.0 && maxLat == 90.0) {
+    return std::nullopt;
+  }
+
+  std::vector<PrefilterVariablePair> prefilters;
+  prefilters.emplace_back(
+      std::make_unique<prefilterExpressions::LatitudeRangeExpression>(minLat,
+                                                                      maxLat),
+      joinVarRight);
+  auto result =
+      childRight.getUpdatedQueryExecutionTreeWithPrefilterApplied(
+          std::move(prefilters));
+  if (result.has_value()) {
+    runtimeInfo().addDetail("prefilter-latitude-range",
+                            absl::StrCat("[", minLat, ", ", maxLat, "]"));
+  }
+  return result;
+}
+
 // ____________________________________________________________________________
 PreparedSpatialJoinParams SpatialJoin::prepareJoin() const {
   auto getIdTable = [](std::shared_ptr<QueryExecutionTree> child) {
@@ -475,12 +539,17 @@ PreparedSpatialJoinParams SpatialJoin::prepareJoin() const {
   auto joinVarLeft = swapSides ? config_.right_ : config_.left_;
   auto joinVarRight = swapSides ? config_.left_ : config_.right_;
 
-  // Input tables.
+  // Input tables. The left child is computed first, s.t. its geometries can be
+  // used to prefilter the right child.
   auto [idTableLeft, resultLeft] = getIdTable(childLeft);
+  ColumnIndex leftJoinCol = childLeft->getVariableColumn(joinVarLeft);
+  if (auto prefiltered = prefilterRightChildByLatitude(
+          *childRight, *idTableLeft, leftJoinCol, joinVarRight)) {
+    childRight = std::move(prefiltered.value());
+  }
   auto [idTableRight, resultRight] = getIdTable(childRight);
 
   // Input table columns for the join.
-  ColumnIndex leftJoinCol = childLeft->getVariableColumn(joinVarLeft);
   ColumnIndex rightJoinCol = childRight->getVariableColumn(joinVarRight);
 
   // Column indices of precomputed bounding boxes, if applicable.
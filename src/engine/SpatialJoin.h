@@ -191,6 +191,17 @@ class SpatialJoin : public Operation {
   // helper function, to initialize various required objects for both algorithms
   PreparedSpatialJoinParams prepareJoin() const;
 
+  // If the join is restricted by a maximum distance and all geometries of the
+  // `joinColLeft` of `idTableLeft` are points, return the `childRight` with a
+  // `LatitudeRangeExpression` prefilter applied, s.t. the blocks of an
+  // `IndexScan` that can't contain a join partner are not read. Otherwise, or
+  // if the `childRight` doesn't support the prefilter, return `std::nullopt`.
+  std::optional<std::shared_ptr<QueryExecutionTree>>
+  prefilterRightChildByLatitude(const QueryExecutionTree& childRight,
+                                const IdTable& idTableLeft,
+                                ColumnIndex joinColLeft,
+                                const Variable& joinVarRight) const;
+
   std::shared_ptr<QueryExecutionTree> childLeft_ = nullptr;
   std::shared_ptr<QueryExecutionTree> childRight_ = nullptr;
 
@@ -22,7 +22,9 @@
 #include <spatialjoin/Sweeper.h>
 #include <util/geo/Geo.h>
 
+#include <atomic>
 #include <cmath>
+#include <future>
 #include <set>
 
 #include "backports/three_way_comparison.h"
@@ -38,6 +40,8 @@
 #include "util/Exception.h"
 #include "util/GeoConverters.h"
 #include "util/GeoSparqlHelpers.h"
+#include "util/ParallelExecutor.h"
+#include "util/ThreadBudget.h"
 
 using namespace BoostGeometryNamespace;
 using namespace geometryConverters;
@@ -349,6 +353,82 @@ void SpatialJoinAlgorithms::addResultTableEntry(
   }
 }
 
+// ____________________________________________________________________________
+template <typename MakeProbe>
+void SpatialJoinAlgorithms::probeIndexInParallel(
+    IdTable& result, size_t numRows, const MakeProbe& makeProbe) const {
+  // The number of rows that are probed by a thread at once. This balances the
+  // load between the threads (the number of pairs per row can vary a lot)
+  // while keeping the synchronization overhead low.
+  static constexpr size_t chunkSize = 1'000;
+  const size_t numChunks = (numRows + chunkSize - 1) / chunkSize;
+  std::vector<std::vector<ResultPair>> pairsPerChunk(numChunks);
+  std::atomic<size_t> nextChunk = 0;
+  auto probeChunks = [this, &makeProbe, &pairsPerChunk, &nextChunk, numRows,
+                      numChunks]() {
+    auto probe = makeProbe();
+    for (size_t chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++) {
+      throwIfCancelled();
+      auto& pairs = pairsPerChunk[chunk];
+      size_t end = std::min(numRows, (chunk + 1) * chunkSize);
+      for (size_t row = chunk * chunkSize; row < end; ++row) {
+        probe(row, pairs);
+      }
+    }
+  };
+
+  ad_utility::Timer timerProbe{ad_utility::Timer::Started};
+  auto threads = ad_utility::globalThreadBudget().reserve(
+      std::min(getNumThreads(), numChunks));
+  const size_t numThreads = threads.numThreads();
+  if (numThreads <= 1) {
+    probeChunks();
+  } else {
+    std::vector<std::packaged_task<void()>> tasks;
+    for (size_t t = 0; t < numThreads; ++t) {
+      tasks.emplace_back([&probeChunks, &nextChunk, numChunks]() {
+        try {
+          probeChunks();
+        } catch (...) {
+          // Make the other threads stop as soon as possible.
+          nextChunk = numChunks;
+          throw;
+        }
+      });
+    }
+    ad_utility::runTasksInParallel(std::move(tasks));
+  }
+  timerProbe.stop();
+
+  // Add the pairs to the result in the order of the rows.
+  ad_utility::Timer timerWrite{ad_utility::Timer::Started};
+  size_t numPairs = 0;
+  for (const auto& pairs : pairsPerChunk) {
+    numPairs += pairs.size();
+  }
+  result.reserve(result.numRows() + numPairs);
+  for (auto& pairs : pairsPerChunk) {
+    throwIfCancelled();
+    for (const auto& [rowLeft, rowRight, distance] : pairs) {
+      addResultTableEntry(&result, params_.idTableLeft_, params_.idTableRight_,
+                          rowLeft, rowRight, Id::makeFromDouble(distance));
+    }
+    // Free the memory of the pairs as soon as possible.
+    pairs = {};
+  }
+  timerWrite.stop();
+
+  if (spatialJoin_.has_value()) {
+    auto& runtimeInfo = spatialJoin_.value()->runtimeInfo();
+    runtimeInfo.addDetail("num-threads-for-index-queries",
+                          std::max(numThreads, size_t{1}));
+    runtimeInfo.addDetail("time for index queries",
+                          timerProbe.msecs().count());
+    runtimeInfo.addDetail("time for result writing",
+                          timerWrite.msecs().count());
+  }
+}
+
 // ____________________________________________________________________________
 Result SpatialJoinAlgorithms::BaselineAlgorithm() {
 #ifdef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
@@ -473,7 +553,8 @@ Result SpatialJoinAlgorithms::LibspatialjoinAlgorithm() {
               joinType, rightCacheName, bbLeft, bbRight] = params_;
   // Setup.
   IdTable result{numColumns, qec_->getAllocator()};
-  size_t NUM_THREADS = getNumThreads();
+  auto threads = ad_utility::globalThreadBudget().reserve(getNumThreads());
+  size_t NUM_THREADS = threads.numThreads();
   std::vector<std::vector<std::pair<size_t, size_t>>> results(NUM_THREADS);
   std::vector<std::vector<double>> resultDists(NUM_THREADS);
   auto joinTypeVal = joinType.value_or(SpatialJoinType::INTERSECTS);
@@ -633,42 +714,46 @@ Result SpatialJoinAlgorithms::S2geometryAlgorithm() {
   }
   // Performs a nearest neighbor search on the index and returns the closest
   // points that satisfy the criteria given by `maxDist_` and `maxResults_`.
-
-  // Construct a query object with the given constraints
-  auto s2query = S2ClosestPointQuery<size_t>{&s2index};
-
-  if (maxResults.has_value()) {
-    s2query.mutable_options()->set_max_results(
-        static_cast<int>(maxResults.value()));
-  }
-  if (maxDist.has_value()) {
-    s2query.mutable_options()->set_inclusive_max_distance(S2Earth::ToAngle(
-        util::units::Meters(static_cast<float>(maxDist.value()))));
-  }
-
+  // The index can be queried concurrently, but the query objects are not
+  // thread-safe, so each thread constructs its own one.
   auto searchTable = indexOfRight ? idTableLeft : idTableRight;
   auto searchJoinCol = indexOfRight ? leftJoinCol : rightJoinCol;
-  // Use the index to lookup the points of the other table
-  for (size_t searchRow = 0; searchRow < searchTable->size(); searchRow++) {
-    auto p = getPoint(searchTable, searchRow, searchJoinCol);
-    if (!p.has_value()) {
-      continue;
+  auto makeProbe = [&s2index, maxResults = params_.maxResults_,
+                    maxDist = params_.maxDist_, searchTable, searchJoinCol,
+                    indexOfRight]() {
+    // Construct a query object with the given constraints
+    auto s2query = std::make_unique<S2ClosestPointQuery<size_t>>(&s2index);
+    if (maxResults.has_value()) {
+      s2query->mutable_options()->set_max_results(
+          static_cast<int>(maxResults.value()));
     }
-    auto s2target =
-        S2ClosestPointQuery<size_t>::PointTarget{toS2Point(p.value())};
-
-    for (const auto& neighbor : s2query.FindClosestPoints(&s2target)) {
-      // In this loop we only receive points that already satisfy the given
-      // criteria
-      auto indexRow = neighbor.data();
-      auto dist = S2Earth::ToKm(neighbor.distance());
-
-      auto rowLeft = indexOfRight ? searchRow : indexRow;
-      auto rowRight = indexOfRight ? indexRow : searchRow;
-      addResultTableEntry(&result, idTableLeft, idTableRight, rowLeft, rowRight,
-                          Id::makeFromDouble(dist));
+    if (maxDist.has_value()) {
+      s2query->mutable_options()->set_inclusive_max_distance(S2Earth::ToAngle(
+          util::units::Meters(static_cast<float>(maxDist.value()))));
     }
-  }
+    return [s2query = std::move(s2query), searchTable, searchJoinCol,
+            indexOfRight](size_t searchRow, std::vector<ResultPair>& pairs) {
+      auto p = getPoint(searchTable, searchRow, searchJoinCol);
+      if (!p.has_value()) {
+        return;
+      }
+      auto s2target =
+          S2ClosestPointQuery<size_t>::PointTarget{toS2Point(p.value())};
+
+      for (const auto& neighbor : s2query->FindClosestPoints(&s2target)) {
+        // In this loop we only receive points that already satisfy the given
+        // criteria
+        auto indexRow = neighbor.data();
+        auto dist = S2Earth::ToKm(neighbor.distance());
+
+        auto rowLeft = indexOfRight ? searchRow : indexRow;
+        auto rowRight = indexOfRight ? indexRow : searchRow;
+        pairs.push_back(ResultPair{rowLeft, rowRight, dist});
+      }
+    };
+  };
+  // Use the index to lookup the points of the other table
+  probeIndexInParallel(result, searchTable->size(), makeProbe);
 
   return Result(std::move(result), std::vector<ColumnIndex>{},
                 Result::getMergedLocalVocab(*resultLeft, *resultRight));
@@ -687,48 +772,44 @@ Result SpatialJoinAlgorithms::S2PointPolylineAlgorithm() {
   AD_CORRECTNESS_CHECK(s2index.has_value());
   AD_CORRECTNESS_CHECK(!maxResults.has_value() && maxDist.has_value());
 
-  // Construct a query object with the given constraints
   auto s2indexPtr = s2index.value().getIndex();
-  auto s2query = S2ClosestEdgeQuery{s2indexPtr.get()};
-  s2query.mutable_options()->set_inclusive_max_distance(S2Earth::ToAngle(
-      util::units::Meters(static_cast<float>(maxDist.value()))));
-
   ad_utility::Timer timerAll{ad_utility::Timer::Started};
-  ad_utility::Timer timerS2{ad_utility::Timer::Stopped};
-  ad_utility::Timer timerWrite{ad_utility::Timer::Stopped};
 
+  // The index can be queried concurrently, but the query objects are not
+  // thread-safe, so each thread constructs its own one.
+  const auto& cachedIndex = s2index.value();
+  auto makeProbe = [&s2indexPtr, &cachedIndex, maxDist = params_.maxDist_,
+                    idTableLeft = params_.idTableLeft_,
+                    leftJoinCol = params_.leftJoinCol_]() {
+    // Construct a query object with the given constraints
+    auto s2query = std::make_unique<S2ClosestEdgeQuery>(s2indexPtr.get());
+    s2query->mutable_options()->set_inclusive_max_distance(S2Earth::ToAngle(
+        util::units::Meters(static_cast<float>(maxDist.value()))));
+    return [s2query = std::move(s2query), &cachedIndex, idTableLeft,
+            leftJoinCol](size_t rowLeft, std::vector<ResultPair>& pairs) {
+      auto p = getPoint(idTableLeft, rowLeft, leftJoinCol);
+      if (!p.has_value()) {
+        return;
+      }
+      auto s2target = S2ClosestEdgeQuery::PointTarget{toS2Point(p.value())};
+
+      ad_utility::HashMap<size_t, double> deduplicatedSet{};
+      auto res = s2query->FindClosestEdges(&s2target);
+
+      for (const auto& neighbor : res) {
+        // In this loop we only receive points that already satisfy the given
+        // criteria
+        auto indexRow = cachedIndex.getRow(neighbor.shape_id());
+        auto dist = S2Earth::ToKm(neighbor.distance());
+        deduplicatedSet[indexRow] = dist;
+      }
+      for (auto [indexRow, dist] : deduplicatedSet) {
+        pairs.push_back(ResultPair{rowLeft, indexRow, dist});
+      }
+    };
+  };
   // Use the index to lookup the points of the other table
-  for (size_t rowLeft = 0; rowLeft < idTableLeft->size(); rowLeft++) {
-    auto p = getPoint(idTableLeft, rowLeft, leftJoinCol);
-    if (!p.has_value()) {
-      continue;
-    }
-    auto s2target = S2ClosestEdgeQuery::PointTarget{toS2Point(p.value())};
-
-    ad_utility::HashMap<size_t, double> deduplicatedSet{};
-    timerS2.cont();
-    auto res = s2query.FindClosestEdges(&s2target);
-
-    for (const auto& neighbor : res) {
-      // In this loop we only receive points that already satisfy the given
-      // criteria
-      auto indexRow = s2index.value().getRow(neighbor.shape_id());
-      auto dist = S2Earth::ToKm(neighbor.distance());
-      deduplicatedSet[indexRow] = dist;
-    }
-    timerS2.stop();
-    timerWrite.cont();
-    for (auto [indexRow, dist] : deduplicatedSet) {
-      auto rowRight = indexRow;
-      addResultTableEntry(&result, idTableLeft, idTableRight, rowLeft, rowRight,
-                          Id::makeFromDouble(dist));
-    }
-    timerWrite.stop();
-  }
-  spatialJoin_.value()->runtimeInfo().addDetail("time for s2 queries",
-                                                timerS2.msecs().count());
-  spatialJoin_.value()->runtimeInfo().addDetail("time for result writing",
-                                                timerWrite.msecs().count());
+  probeIndexInParallel(result, idTableLeft->size(), makeProbe);
   spatialJoin_.value()->runtimeInfo().addDetail("time total",
                                                 timerAll.msecs().count());
 
@@ -246,6 +246,25 @@ class SpatialJoinAlgorithms {
                            const IdTableView<0>* resultRight, size_t rowLeft,
                            size_t rowRight, Id distance) const;
 
+  // A pair of rows of the left and the right child that is part of the result
+  // of the spatial join, together with the distance of their geometries.
+  struct ResultPair {
+    size_t rowLeft_;
+    size_t rowRight_;
+    double distance_;
+  };
+
+  // Helper function, which probes an index with all the rows `[0, numRows)`
+  // of the other child and adds the found pairs to the `result`. For this,
+  // `makeProbe()` is called once per thread and has to return a callable
+  // `probe(row, pairs)`, which appends the pairs for the `row` to `pairs`.
+  // The rows are split into chunks, which are probed concurrently by up to
+  // `getNumThreads()` threads. The pairs are added in the order of the rows,
+  // s.t. the result doesn't depend on the number of threads.
+  template <typename MakeProbe>
+  void probeIndexInParallel(IdTable& result, size_t numRows,
+                            const MakeProbe& makeProbe) const;
+
   // This helper function calculates the bounding boxes based on a box, where
   // definitely no match can occur. This means every element in the anti
   // bounding box is guaranteed to be more than 'maxDistanceInMeters' away from
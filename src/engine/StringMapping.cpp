@@ -34,18 +34,20 @@ Id StringMapping::remapId(Id id) {
   // datatypes that semantically point to strings (so literals/IRIs that can't
   // be directly encoded into the ID). All other IDs have to be serialized by
   // different mechanism.
-  static constexpr std::array allowedDatatypes{VocabIndex, LocalVocabIndex,
-                                               TextRecordIndex, WordVocabIndex};
+  static constexpr std::array allowedDatatypes{VocabIndex,      LocalVocabIndex,
+                                               TextRecordIndex, WordVocabIndex,
+                                               EncodedVal};
   AD_EXPENSIVE_CHECK(ad_utility::contains(allowedDatatypes, id.getDatatype()));
 
   // A static assertion that each datatype is either `trivial`, or `allowed`
   // (see above), or `BlankNodeIndex` (which also requires special handling and
-  // remapping, but cannot be handled by the `StringMapping`.
+  // remapping, but cannot be handled by the `StringMapping`). `EncodedVal`s
+  // are IRIs that are encoded directly into the ID, but the encoding depends
+  // on the index, so they are also exported as strings.
   static constexpr auto checkDatatypes = []() {
     auto checkType = [](Datatype datatype) {
       return ad_utility::contains(allowedDatatypes, datatype) ||
-             isDatatypeTrivial(datatype) || datatype == BlankNodeIndex ||
-             datatype == EncodedVal;
+             isDatatypeTrivial(datatype) || datatype == BlankNodeIndex;
     };
     for (size_t i = 0; i <= static_cast<size_t>(MaxValue); ++i) {
       if (!checkType(static_cast<Datatype>(i))) {
@@ -64,4 +66,25 @@ Id StringMapping::remapId(Id id) {
       distinctIndex << Id::numDatatypeBits));
 }
 
+// _____________________________________________________________________________
+IncrementalStringMapping::Delta IncrementalStringMapping::add(
+    std::vector<std::string> strings) {
+  Delta delta;
+  if (dictionarySize_ > maxDictionarySize_) {
+    dictionary_.clear();
+    dictionarySize_ = ad_utility::MemorySize::bytes(0);
+    delta.clearsDictionary_ = true;
+  }
+  delta.indices_.reserve(strings.size());
+  for (auto& string : strings) {
+    auto [it, isNew] = dictionary_.try_emplace(string, dictionary_.size());
+    if (isNew) {
+      dictionarySize_ += ad_utility::MemorySize::bytes(string.size());
+      delta.newStrings_.push_back(std::move(string));
+    }
+    delta.indices_.push_back(it->second);
+  }
+  return delta;
+}
+
 }  // namespace qlever::binary_export
@@ -15,6 +15,7 @@
 
 #include "global/Id.h"
 #include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
 
 // Forward declaration
 class Index;
@@ -57,6 +58,48 @@ class StringMapping {
   // Const access to the string mapping.
   const auto& stringMappingForTesting() const { return stringMapping_; }
 };
+
+// The dictionary of the strings of a whole stream of batches, s.t. each
+// string is only transferred once, together with the first batch in which it
+// occurs (see `BinaryExport.h`). The strings of a batch are first collected
+// by a `StringMapping` (which can be done for several batches concurrently),
+// and then added to the dictionary in the order of the batches. To bound the
+// memory of the sender and the receiver, the dictionary is cleared before a
+// batch if the total size of its strings exceeds the `maxDictionarySize_`.
+class IncrementalStringMapping {
+  // The index of each string in the dictionary.
+  ad_utility::HashMap<std::string, uint64_t> dictionary_;
+  // The total size of the strings in the `dictionary_`.
+  ad_utility::MemorySize dictionarySize_ = ad_utility::MemorySize::bytes(0);
+  ad_utility::MemorySize maxDictionarySize_;
+
+ public:
+  static constexpr ad_utility::MemorySize defaultMaxDictionarySize =
+      ad_utility::MemorySize::megabytes(64);
+
+  explicit IncrementalStringMapping(
+      ad_utility::MemorySize maxDictionarySize = defaultMaxDictionarySize)
+      : maxDictionarySize_{maxDictionarySize} {}
+
+  // The result of adding the strings of a batch to the dictionary.
+  struct Delta {
+    // True iff the dictionary was cleared before the `newStrings_` were
+    // added.
+    bool clearsDictionary_ = false;
+    // The strings that were not yet contained in the dictionary, in the order
+    // of their indices in the dictionary.
+    std::vector<std::string> newStrings_;
+    // The index in the dictionary of each of the added strings.
+    std::vector<uint64_t> indices_;
+  };
+
+  // Add the `strings` of a batch (which have to be distinct) to the
+  // dictionary.
+  Delta add(std::vector<std::string> strings);
+
+  // The number of strings in the dictionary.
+  size_t size() const { return dictionary_.size(); }
+};
 }  // namespace qlever::binary_export
 
 #endif  // QLEVER_SRC_ENGINE_STRING_MAPPING_H
@@ -4,6 +4,11 @@
 
 #include "engine/TextLimit.h"
 
+#include <algorithm>
+#include <set>
+
+#include "util/HashMap.h"
+
 // _____________________________________________________________________________
 TextLimit::TextLimit(QueryExecutionContext* qec, const size_t limit,
                      std::shared_ptr<QueryExecutionTree> child,
@@ -21,26 +26,52 @@ TextLimit::TextLimit(QueryExecutionContext* qec, const size_t limit,
 
 // _____________________________________________________________________________
 Result TextLimit::computeResult([[maybe_unused]] bool requestLaziness) {
-  std::shared_ptr<const Result> childRes = child_->getResult();
+  std::shared_ptr<const Result> childRes = child_->getResult(true);
 
   if (limit_ == 0) {
-    return {IdTable(childRes->idTable().numColumns(),
-                    getExecutionContext()->getAllocator()),
-            resultSortedOn(), childRes->getSharedLocalVocab()};
+    return {IdTable(getResultWidth(), getExecutionContext()->getAllocator()),
+            resultSortedOn(), LocalVocab{}};
   }
 
-  IdTable idTable = childRes->idTable().clone();
+  // The rows that can be part of the result. For a lazy input, the rows that
+  // are not are regularly pruned while the input is read, s.t. the input
+  // never has to be fully materialized.
+  IdTable idTable{getResultWidth(), getExecutionContext()->getAllocator()};
+  LocalVocab localVocab;
+  size_t numInputRows = 0;
+  if (childRes->isFullyMaterialized()) {
+    numInputRows = childRes->idTable().numRows();
+    idTable = pruneRowsOfWorseTexts(childRes->idTable());
+    localVocab = childRes->getCopyOfLocalVocab();
+  } else {
+    // Prune when the number of rows has doubled since the last pruning, s.t.
+    // the amortized cost of the pruning is linear in the size of the input.
+    static constexpr size_t minNumRowsForPruning = 100'000;
+    size_t numRowsAfterLastPruning = 0;
+    for (auto& [block, blockVocab] : childRes->idTables()) {
+      numInputRows += block.numRows();
+      idTable.insertAtEnd(block);
+      localVocab.mergeWith(blockVocab);
+      if (idTable.numRows() >
+          2 * numRowsAfterLastPruning + minNumRowsForPruning) {
+        idTable = pruneRowsOfWorseTexts(idTable);
+        numRowsAfterLastPruning = idTable.numRows();
+      }
+      checkCancellation();
+    }
+    idTable = pruneRowsOfWorseTexts(idTable);
+  }
+  if (idTable.numRows() < numInputRows) {
+    runtimeInfo().addDetail("num-pruned-rows",
+                            numInputRows - idTable.numRows());
+  }
+  checkCancellation();
 
   // TODO<joka921> Let the SORT class handle this. This requires descending
   // sorting for positive integers though.
   auto compareScores = [this](const auto& lhs, const auto& rhs) {
-    size_t lhsScore = 0;
-    size_t rhsScore = 0;
-    ql::ranges::for_each(scoreColumns_,
-                         [&lhs, &rhs, &lhsScore, &rhsScore](const auto& col) {
-                           lhsScore += lhs[col].getInt();
-                           rhsScore += rhs[col].getInt();
-                         });
+    size_t lhsScore = getTotalScore(lhs);
+    size_t rhsScore = getTotalScore(rhs);
     if (lhsScore > rhsScore) {
       return 1;
     } else if (lhsScore < rhsScore) {
@@ -117,8 +148,46 @@ Result TextLimit::computeResult([[maybe_unused]] bool requestLaziness) {
     lastRecordAdded = true;
   }
 
-  return {std::move(resIdTable), resultSortedOn(),
-          childRes->getSharedLocalVocab()};
+  return {std::move(resIdTable), resultSortedOn(), std::move(localVocab)};
+}
+
+// _____________________________________________________________________________
+IdTable TextLimit::pruneRowsOfWorseTexts(const IdTable& input) const {
+  // The best `limit_` distinct pairs of (score, text record) for each
+  // combination of entities. The `begin()` of each set is the worst pair that
+  // can still be part of the result.
+  using ScoreAndText = std::pair<size_t, Id>;
+  ad_utility::HashMap<std::vector<Id>, size_t> groupIndices;
+  std::vector<std::set<ScoreAndText>> bestPairs;
+  std::vector<size_t> groupOfRow;
+  groupOfRow.reserve(input.numRows());
+  std::vector<Id> entities;
+  for (const auto& row : input) {
+    entities.clear();
+    for (auto col : entityColumns_) {
+      entities.push_back(row[col]);
+    }
+    auto [it, isNew] = groupIndices.try_emplace(entities, bestPairs.size());
+    if (isNew) {
+      bestPairs.emplace_back();
+    }
+    auto& best = bestPairs[it->second];
+    best.emplace(getTotalScore(row), row[textRecordColumn_]);
+    if (best.size() > limit_) {
+      best.erase(best.begin());
+    }
+    groupOfRow.push_back(it->second);
+  }
+
+  IdTable remaining{input.numColumns(), getExecutionContext()->getAllocator()};
+  for (size_t i = 0; i < input.numRows(); ++i) {
+    const auto& row = input[i];
+    if (ScoreAndText{getTotalScore(row), row[textRecordColumn_]} >=
+        *bestPairs[groupOfRow[i]].begin()) {
+      remaining.push_back(row);
+    }
+  }
+  return remaining;
 }
 
 // _____________________________________________________________________________
@@ -67,6 +67,25 @@ class TextLimit : public Operation {
 
   Result computeResult([[maybe_unused]] bool requestLaziness) override;
 
+  // The sum of the scores of the `row` that is used to rank the texts.
+  template <typename Row>
+  size_t getTotalScore(const Row& row) const {
+    size_t score = 0;
+    for (auto col : scoreColumns_) {
+      score += row[col].getInt();
+    }
+    return score;
+  }
+
+  // Return the rows of the `input` that can be part of the result: For each
+  // combination of entities, only the rows with one of the `limit_` best
+  // distinct pairs of (score, text record) are kept, because each text record
+  // in the result is a run of such pairs. The rows that are removed are also
+  // never part of the result if more rows are added to the `input`, so this
+  // can be applied repeatedly while the input is read. The memory per
+  // combination of entities is bounded by `limit_`.
+  IdTable pruneRowsOfWorseTexts(const IdTable& input) const;
+
   std::vector<QueryExecutionTree*> getChildren() override {
     return {child_.get()};
   }
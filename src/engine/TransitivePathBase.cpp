@@ -19,6 +19,7 @@
 #include "engine/Filter.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
+#include "engine/MaterializedViews.h"
 #include "engine/MultiColumnJoin.h"
 #include "engine/TransitivePathBinSearch.h"
 #include "engine/TransitivePathHashMap.h"
@@ -27,6 +28,7 @@
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "global/RuntimeParameters.h"
+#include "index/IndexImpl.h"
 #include "util/Exception.h"
 
 // _____________________________________________________________________________
@@ -312,6 +314,40 @@ size_t TransitivePathBase::numJoinColumnsWith(
   }
 }
 
+// _____________________________________________________________________________
+std::shared_ptr<const MaterializedView>
+TransitivePathBase::getPrecomputedClosure(
+    const TransitivePathSide& startSide) const {
+  if (!getRuntimeParameter<
+          &RuntimeParameters::usePrecomputedTransitiveClosures_>() ||
+      minDist_ > 1 || maxDist_ != std::numeric_limits<size_t>::max() ||
+      graphVariable_.has_value()) {
+    return nullptr;
+  }
+  auto scan =
+      std::dynamic_pointer_cast<IndexScan>(subtree_->getRootOperation());
+  if (scan == nullptr || scan->numVariables() != 2 ||
+      !scan->additionalColumns().empty() || !scan->predicate().isIri() ||
+      scan->subject() == scan->object() ||
+      !scan->graphsToFilter().areAllGraphsAllowed() ||
+      !scan->isUnaffectedByUpdates()) {
+    return nullptr;
+  }
+  // Scans of custom permutations (e.g. materialized views) are not covered by
+  // the precomputed closures.
+  const auto& permutation = scan->permutation();
+  if (&permutation !=
+      &getIndex().getImpl().getPermutation(permutation.permutation())) {
+    return nullptr;
+  }
+  bool forward = startSide.subCol_ ==
+                 subtree_->getVariableColumn(scan->subject().getVariable());
+  return getExecutionContext()
+      ->materializedViewsManager()
+      .getTransitiveClosureView(
+          scan->predicate().getIri().toStringRepresentation(), forward);
+}
+
 // _____________________________________________________________________________
 std::string TransitivePathBase::getDescriptor() const {
   std::ostringstream os;
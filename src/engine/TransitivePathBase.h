@@ -118,6 +118,8 @@ struct NodeWithTargets {
 
 using NodeGenerator = cppcoro::generator<NodeWithTargets>;
 
+class MaterializedView;
+
 /**
  * @class TransitivePathBase
  * @brief A common base class for different implementations of the Transitive
@@ -247,6 +249,17 @@ class TransitivePathBase : public Operation {
   size_t numJoinColumnsWith(const std::shared_ptr<QueryExecutionTree>& tree,
                             ColumnIndex joinColumn) const;
 
+  // Return the materialized view with the precomputed transitive closure that
+  // can be used instead of a graph search to compute the hull of each node on
+  // the `startSide`, or `nullptr` if there is none. This is the case if the
+  // subtree is a scan `?a <p> ?b` of all graphs that is not affected by
+  // updates, the closure of `<p>` was precomputed at index build time, there
+  // is no graph variable, and the path has no upper bound and a lower bound
+  // of at most one (like `<p>*` or `<p>+`). The paths of length zero are not
+  // contained in the closure and have to be added separately.
+  std::shared_ptr<const MaterializedView> getPrecomputedClosure(
+      const TransitivePathSide& startSide) const;
+
  public:
   std::string getDescriptor() const override;
 
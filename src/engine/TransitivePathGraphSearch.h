@@ -98,8 +98,10 @@ Set depthFirstSearch(const GraphSearchProblem<T>& gsp,
     stack.emplace_back(gsp.startNode_);
   }
 
+  ad_utility::AmortizedCancellationCheck checkCancellation{
+      [&ep]() { ep.checkCancellation("Depth-first search"); }};
   while (!stack.empty()) {
-    ep.checkCancellation("Depth-first search");
+    checkCancellation();
     Id node = stack.back();
     stack.pop_back();
 
@@ -150,8 +152,10 @@ Set depthFirstSearchWithLimit(const GraphSearchProblem<T>& gsp,
 
   stack.emplace_back(gsp.startNode_, 0);
 
+  ad_utility::AmortizedCancellationCheck checkCancellation{
+      [&ep]() { ep.checkCancellation("Depth-first search (with limits)"); }};
   while (!stack.empty()) {
-    ep.checkCancellation("Depth-first search (with limits)");
+    checkCancellation();
 
     auto [node, dist] = stack.back();
     stack.pop_back();
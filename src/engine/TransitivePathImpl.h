@@ -9,15 +9,27 @@
 #ifndef QLEVER_SRC_ENGINE_TRANSITIVEPATHIMPL_H
 #define QLEVER_SRC_ENGINE_TRANSITIVEPATHIMPL_H
 
+#include <atomic>
+#include <future>
 #include <utility>
+#include <vector>
 
+#include "engine/MaterializedViews.h"
 #include "engine/TransitivePathBase.h"
 #include "engine/TransitivePathGraphSearch.h"
+#include "global/RuntimeParameters.h"
 #include "util/Iterators.h"
+#include "util/ParallelExecutor.h"
+#include "util/ThreadBudget.h"
 #include "util/Timer.h"
 
 using IdWithGraphs = absl::InlinedVector<std::pair<Id, Id>, 1>;
 
+// When the transitive hulls of many start nodes are computed by multiple
+// threads, each thread gets this many start nodes per batch on average. The
+// threads are started once per batch, so this amortizes their startup cost.
+static constexpr size_t TRANSITIVE_PATH_START_NODES_PER_THREAD_AND_BATCH = 64;
+
 namespace detail {
 
 // Helper struct that allows to group a read-only view of a column of a table
@@ -77,6 +89,15 @@ class TransitivePathImpl : public TransitivePathBase {
   using TableColumnWithVocab = detail::TableColumnWithVocab<
       ad_utility::InputRangeTypeErased<ZippedType>>;
 
+  // A single graph search of `transitiveHull`: the start node with its graph,
+  // the target (if any), and the row of the start node in its table.
+  struct HullTask {
+    Id startNode_;
+    Id graphId_;
+    std::optional<Id> targetId_;
+    size_t row_;
+  };
+
  public:
   using TransitivePathBase::TransitivePathBase;
 
@@ -108,7 +129,8 @@ class TransitivePathImpl : public TransitivePathBase {
 
     NodeGenerator hull = transitiveHull(
         std::move(edges), sub->getCopyOfLocalVocab(), std::move(nodes),
-        startSide.value_, targetSide.value_, yieldOnce);
+        startSide.value_, targetSide.value_, yieldOnce,
+        getPrecomputedClosure(startSide));
 
     const auto& [tree, joinColumn] = startSide.treeAndCol_.value();
     size_t numberOfPayloadColumns =
@@ -152,7 +174,8 @@ class TransitivePathImpl : public TransitivePathBase {
 
     NodeGenerator hull = transitiveHull(
         std::move(edges), sub->getCopyOfLocalVocab(), ql::span{&tableInfo, 1},
-        startSide.value_, targetSide.value_, yieldOnce);
+        startSide.value_, targetSide.value_, yieldOnce,
+        getPrecomputedClosure(startSide));
 
     // We don't pass a payload table, so our `inputWidth` is 0.
     auto result = fillTableWithHull(std::move(hull), startSide.outputCol_,
@@ -218,13 +241,16 @@ class TransitivePathImpl : public TransitivePathBase {
    * code. When set to true, this will prevent yielding the same LocalVocab over
    * and over again to make merging faster (because merging with an empty
    * LocalVocab is a no-op).
+   * @param closure If not `nullptr`, the hulls are looked up in this
+   * precomputed transitive closure instead of being computed by a graph
+   * search (see `getPrecomputedClosure`).
    * @return Map Maps each Id to its connected Ids in the transitive hull
    */
   CPP_template(typename Node)(requires ql::ranges::range<Node>) NodeGenerator
       transitiveHull(T edges, LocalVocab edgesVocab, Node startNodes,
                      TripleComponent start, TripleComponent target,
-                     bool yieldOnce) const {
-    using namespace qlever::graphSearch;
+                     bool yieldOnce,
+                     std::shared_ptr<const MaterializedView> closure) const {
     ad_utility::Timer timer{ad_utility::Timer::Stopped};
     // `targetId` is only ever used for comparisons, and never stored in the
     // result, so we use a separate local vocabulary.
@@ -240,10 +266,24 @@ class TransitivePathImpl : public TransitivePathBase {
         !targetId.has_value() && graphVariable_ == target.getVariable();
     bool startsWithGraphVariable =
         start.isVariable() && graphVariable_ == start.getVariable();
+    const size_t numThreads = std::max(
+        size_t{1},
+        getRuntimeParameter<&RuntimeParameters::transitivePathNumThreads_>());
+    const size_t batchSize =
+        numThreads == 1
+            ? 1
+            : numThreads * TRANSITIVE_PATH_START_NODES_PER_THREAD_AND_BATCH;
+    if (numThreads > 1) {
+      runtimeInfo().addDetail("Number of threads", numThreads);
+    }
+    if (closure != nullptr) {
+      runtimeInfo().addDetail("Precomputed closure", closure->name());
+    }
     for (auto&& tableColumn : startNodes) {
       timer.cont();
       LocalVocab mergedVocab = std::move(tableColumn.vocab_);
       mergedVocab.mergeWith(edgesVocab);
+      std::vector<HullTask> tasks;
       for (const auto& [currentRow, pair] :
            ::ranges::views::enumerate(tableColumn.startNodes_)) {
         for (const auto& [startNode, graphId] :
@@ -253,41 +293,149 @@ class TransitivePathImpl : public TransitivePathBase {
           if (startsWithGraphVariable && startNode != graphId) {
             continue;
           }
+          std::optional<Id> target = targetId;
           if (sameVariableOnBothSides) {
-            targetId = startNode;
+            target = startNode;
           } else if (endsWithGraphVariable) {
-            targetId = graphId;
+            target = graphId;
           }
-          edges.setGraphId(graphId);
-
-          // Pick the appropriate graph search strategy and run it.
-          GraphSearchProblem<T> gsp(edges, startNode, targetId, minDist_,
-                                    maxDist_);
-          GraphSearchExecutionParams ep(cancellationHandle_, allocator());
-          Set connectedNodes = runOptimalGraphSearch(gsp, ep);
-
-          if (!connectedNodes.empty()) {
-            runtimeInfo().addDetail("Hull time", timer.msecs());
-            timer.stop();
-            co_yield NodeWithTargets{startNode,
-                                     graphId,
-                                     std::move(connectedNodes),
-                                     mergedVocab.clone(),
-                                     tableColumn.payload_,
-                                     static_cast<size_t>(currentRow)};
-            timer.cont();
-            // Reset vocab to prevent merging the same vocab over and over
-            // again.
-            if (yieldOnce) {
-              mergedVocab = LocalVocab{};
-            }
+          tasks.push_back(HullTask{startNode, graphId, target,
+                                   static_cast<size_t>(currentRow)});
+        }
+      }
+
+      // Process the tasks in batches of consecutive tasks with the same graph,
+      // because the active graph of the `edges` can only be changed between
+      // the batches.
+      size_t batchBegin = 0;
+      while (batchBegin < tasks.size()) {
+        size_t batchEnd = batchBegin + 1;
+        while (batchEnd < tasks.size() && batchEnd - batchBegin < batchSize &&
+               tasks[batchEnd].graphId_ == tasks[batchBegin].graphId_) {
+          ++batchEnd;
+        }
+        edges.setGraphId(tasks[batchBegin].graphId_);
+        auto batch =
+            ql::span{tasks}.subspan(batchBegin, batchEnd - batchBegin);
+        // The threads are only reserved while the hulls of the batch are
+        // computed (the temporary reservation lives until the end of the
+        // statement), and not while the consumer processes the results.
+        std::vector<Set> hulls = computeHulls(
+            edges, batch,
+            ad_utility::globalThreadBudget().reserve(numThreads).numThreads(),
+            closure.get());
+        for (size_t i = 0; i < batch.size(); ++i) {
+          if (hulls[i].empty()) {
+            continue;
+          }
+          runtimeInfo().addDetail("Hull time", timer.msecs());
+          timer.stop();
+          co_yield NodeWithTargets{batch[i].startNode_,
+                                   batch[i].graphId_,
+                                   std::move(hulls[i]),
+                                   mergedVocab.clone(),
+                                   tableColumn.payload_,
+                                   batch[i].row_};
+          timer.cont();
+          // Reset vocab to prevent merging the same vocab over and over
+          // again.
+          if (yieldOnce) {
+            mergedVocab = LocalVocab{};
           }
         }
+        batchBegin = batchEnd;
       }
       timer.stop();
     }
   }
 
+  /**
+   * @brief Run the graph searches for all the `tasks`, which all have to
+   * belong to the currently active graph of the `edges`.
+   *
+   * If `numThreads > 1`, the searches are distributed among that many
+   * threads, each of which repeatedly takes the next task that hasn't been
+   * started yet. This balances the load even if the sizes of the hulls are
+   * very different, which is typical for hierarchies like `wdt:P279*`. The
+   * `edges` are only read by the threads. If a precomputed `closure` is
+   * given, the hulls are looked up in it instead.
+   *
+   * @return The resulting sets, in the same order as the `tasks`.
+   */
+  std::vector<qlever::graphSearch::Set> computeHulls(
+      T& edges, ql::span<const HullTask> tasks, size_t numThreads,
+      const MaterializedView* closure) const {
+    using namespace qlever::graphSearch;
+    GraphSearchExecutionParams ep(cancellationHandle_, allocator());
+    std::vector<Set> result(tasks.size(), Set{allocator()});
+    auto search = [this, &edges, &tasks, &ep, &result, closure](size_t i) {
+      const auto& task = tasks[i];
+      if (closure != nullptr) {
+        result[i] = lookupHullInClosure(*closure, task);
+        return;
+      }
+      GraphSearchProblem<T> gsp(edges, task.startNode_, task.targetId_,
+                                minDist_, maxDist_);
+      result[i] = runOptimalGraphSearch(gsp, ep);
+    };
+    numThreads = std::min(numThreads, tasks.size());
+    if (numThreads <= 1) {
+      for (size_t i = 0; i < tasks.size(); ++i) {
+        search(i);
+      }
+      return result;
+    }
+    std::atomic<size_t> nextTask = 0;
+    std::vector<std::packaged_task<void()>> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+      threads.emplace_back([&search, &nextTask, &tasks]() {
+        try {
+          for (size_t i = nextTask++; i < tasks.size(); i = nextTask++) {
+            search(i);
+          }
+        } catch (...) {
+          // Make the other threads stop as soon as possible.
+          nextTask = tasks.size();
+          throw;
+        }
+      });
+    }
+    ad_utility::runTasksInParallel(std::move(threads));
+    return result;
+  }
+
+  // Return the hull of the `task` by reading all targets of its start node
+  // from the precomputed transitive `closure`. As the closure only contains
+  // the paths of length at least one, the start node itself is added if
+  // `minDist_ == 0`.
+  qlever::graphSearch::Set lookupHullInClosure(const MaterializedView& closure,
+                                               const HullTask& task) const {
+    qlever::graphSearch::Set result{allocator()};
+    auto isTarget = [&task](Id id) {
+      return !task.targetId_.has_value() || id == task.targetId_.value();
+    };
+    if (minDist_ == 0 && isTarget(task.startNode_)) {
+      result.insert(task.startNode_);
+    }
+    // The closure only contains `Id`s from the vocabulary of the index.
+    if (task.startNode_.getDatatype() == Datatype::LocalVocabIndex) {
+      return result;
+    }
+    const auto& permutation = *closure.permutation();
+    auto locatedTriples = closure.locatedTriplesState();
+    auto scanSpecAndBlocks = permutation.getScanSpecAndBlocks(
+        ScanSpecification{task.startNode_, std::nullopt, std::nullopt},
+        *locatedTriples);
+    IdTable targets = permutation.scan(scanSpecAndBlocks, {},
+                                       cancellationHandle_, *locatedTriples);
+    for (Id target : targets.getColumn(0)) {
+      if (isTarget(target)) {
+        result.insert(target);
+      }
+    }
+    return result;
+  }
+
   /**
    * @brief Prepare a Map and a nodes vector for the transitive hull
    * computation.
@@ -7,10 +7,15 @@
 // Copyright 2025, Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
 #include "engine/Union.h"
 
+#include <future>
+
 #include "backports/span.h"
 #include "engine/CallFixedSize.h"
 #include "engine/SortedUnionImpl.h"
+#include "global/RuntimeParameters.h"
 #include "util/ChunkedForLoop.h"
+#include "util/ThreadBudget.h"
+#include "util/jthread.h"
 
 const size_t Union::NO_COLUMN = std::numeric_limits<size_t>::max();
 
@@ -226,12 +231,40 @@ size_t Union::getCostEstimate() {
          timeEstimate;
 }
 
+// _____________________________________________________________________________
+std::array<std::shared_ptr<const Result>, 2> Union::computeChildResults(
+    bool requestLaziness) {
+  auto compute = [this, requestLaziness](size_t i) {
+    return _subtrees[i]->getResult(requestLaziness);
+  };
+  // The runtime information of the whole query is serialized for the
+  // websocket updates, which is not safe while another thread modifies it.
+  if (!getRuntimeParameter<&RuntimeParameters::parallelUnion_>() ||
+      getExecutionContext()->areWebsocketUpdatesEnabled()) {
+    auto subRes1 = compute(0);
+    return {std::move(subRes1), compute(1)};
+  }
+  // The calling thread computes the left child, so one additional thread is
+  // needed for the right child.
+  auto reservation = ad_utility::globalThreadBudget().reserve(2);
+  if (reservation.numThreads() < 2) {
+    auto subRes1 = compute(0);
+    return {std::move(subRes1), compute(1)};
+  }
+  std::packaged_task<std::shared_ptr<const Result>()> task{
+      [&compute]() { return compute(1); }};
+  auto future = task.get_future();
+  ad_utility::JThread thread{std::move(task)};
+  auto subRes1 = compute(0);
+  auto subRes2 = future.get();
+  runtimeInfo().addDetail("children-computed-in-parallel", true);
+  return {std::move(subRes1), std::move(subRes2)};
+}
+
+// _____________________________________________________________________________
 Result Union::computeResult(bool requestLaziness) {
   AD_LOG_DEBUG << "Union result computation..." << std::endl;
-  std::shared_ptr<const Result> subRes1 =
-      _subtrees[0]->getResult(requestLaziness);
-  std::shared_ptr<const Result> subRes2 =
-      _subtrees[1]->getResult(requestLaziness);
+  auto [subRes1, subRes2] = computeChildResults(requestLaziness);
 
   // If first sort column is not present in left child, we can fall back to the
   // cheap computation because it orders the left child first.
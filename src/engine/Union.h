@@ -97,6 +97,12 @@ class Union : public Operation {
 
   Result computeResult(bool requestLaziness) override;
 
+  // Compute the results of both children. The children are computed
+  // concurrently (the right child in a separate thread) if this is enabled via
+  // `RuntimeParameters::parallelUnion_` and a thread is available.
+  std::array<std::shared_ptr<const Result>, 2> computeChildResults(
+      bool requestLaziness);
+
   VariableToColumnMap computeVariableToColumnMap() const override;
 
   // Compute the permutation of the `IdTable` being yielded for the left or
@@ -9,9 +9,15 @@
 #include <absl/strings/str_cat.h>
 #include <absl/strings/str_join.h>
 
+#include <future>
+
 #include "engine/CallFixedSize.h"
+#include "global/RuntimeParameters.h"
+#include "index/IdTableUtils.h"
 #include "util/Exception.h"
 #include "util/HashSet.h"
+#include "util/ParallelExecutor.h"
+#include "util/ThreadBudget.h"
 
 // ____________________________________________________________________________
 Values::Values(QueryExecutionContext* qec, SparqlValues parsedValues)
@@ -20,12 +26,17 @@ Values::Values(QueryExecutionContext* qec, SparqlValues parsedValues)
       ql::ranges::all_of(parsedValues_._values, [&](const auto& row) {
         return row.size() == parsedValues_._variables.size();
       }));
+  sortResult_ =
+      !parsedValues_._variables.empty() &&
+      parsedValues_._values.size() >=
+          getRuntimeParameter<&RuntimeParameters::valuesSortMinNumRows_>();
 }
 
 // ____________________________________________________________________________
 std::string Values::getCacheKeyImpl() const {
   return absl::StrCat("VALUES (", parsedValues_.variablesToString(), ") { ",
-                      parsedValues_.valuesToString(), " }");
+                      parsedValues_.valuesToString(), " }",
+                      sortResult_ ? " SORTED" : "");
 }
 
 // ____________________________________________________________________________
@@ -40,7 +51,14 @@ size_t Values::getResultWidth() const {
 }
 
 // ____________________________________________________________________________
-std::vector<ColumnIndex> Values::resultSortedOn() const { return {}; }
+std::vector<ColumnIndex> Values::resultSortedOn() const {
+  if (!sortResult_) {
+    return {};
+  }
+  std::vector<ColumnIndex> sortedOn(getResultWidth());
+  std::iota(sortedOn.begin(), sortedOn.end(), 0);
+  return sortedOn;
+}
 
 // ____________________________________________________________________________
 VariableToColumnMap Values::computeVariableToColumnMap() const {
@@ -119,6 +137,10 @@ Result Values::computeResult([[maybe_unused]] bool requestLaziness) {
   ad_utility::callFixedSizeVi(resWidth, [&, self = this](auto width) {
     return self->writeValues<width>(&idTable, &localVocab);
   });
+  if (sortResult_) {
+    checkCancellation();
+    IdTableUtils::sort(idTable, resultSortedOn());
+  }
   return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
 }
 
@@ -126,26 +148,80 @@ Result Values::computeResult([[maybe_unused]] bool requestLaziness) {
 template <size_t I>
 void Values::writeValues(IdTable* idTablePtr, LocalVocab* localVocab) {
   IdTableStatic<I> idTable = std::move(*idTablePtr).toStatic<I>();
-  idTable.resize(parsedValues_._values.size());
-  size_t rowIdx = 0;
-  std::vector<size_t> numLocalVocabPerColumn(idTable.numColumns());
-  for (auto& row : parsedValues_._values) {
-    for (size_t colIdx = 0; colIdx < idTable.numColumns(); colIdx++) {
-      const TripleComponent& tc = row[colIdx];
-      // TODO<joka921> We don't want to move, but also don't want to
-      // unconditionally copy.
-      Id id = TripleComponent{tc}.toValueId(getIndex(), *localVocab);
-      idTable(rowIdx, colIdx) = id;
-      if (id.getDatatype() == Datatype::LocalVocabIndex) {
-        ++numLocalVocabPerColumn[colIdx];
+  const auto& rows = parsedValues_._values;
+  const size_t numRows = rows.size();
+  const size_t numColumns = idTable.numColumns();
+  idTable.resize(numRows);
+
+  // Look up the values of the rows `[begin, end)` in the vocabulary (this only
+  // reads the vocabulary, so it can be done concurrently), and return the
+  // positions and bounds of those that are not contained in it.
+  using Bounds = std::pair<VocabIndex, VocabIndex>;
+  using Missing = std::tuple<size_t, size_t, Bounds>;
+  const IndexImpl& index = getIndex().getImpl();
+  auto lookUpRows = [this, &rows, &idTable, &index, numColumns](size_t begin,
+                                                                size_t end) {
+    std::vector<Missing> missing;
+    for (size_t rowIdx = begin; rowIdx < end; ++rowIdx) {
+      for (size_t colIdx = 0; colIdx < numColumns; ++colIdx) {
+        auto idOrBounds = rows[rowIdx][colIdx].toValueIdOrBounds(index);
+        if (const auto* id = std::get_if<Id>(&idOrBounds)) {
+          idTable(rowIdx, colIdx) = *id;
+        } else {
+          missing.emplace_back(rowIdx, colIdx, std::get<Bounds>(idOrBounds));
+        }
+      }
+      if (rowIdx % minNumRowsPerThread_ == 0) {
+        checkCancellation();
       }
     }
-    rowIdx++;
+    return missing;
+  };
+
+  const size_t maxNumThreads = std::max<size_t>(
+      1, getRuntimeParameter<&RuntimeParameters::valuesNumThreads_>());
+  auto threads = ad_utility::globalThreadBudget().reserve(
+      std::min(maxNumThreads, numRows / minNumRowsPerThread_));
+  const size_t numThreads = threads.numThreads();
+  std::vector<std::vector<Missing>> missingPerThread(numThreads);
+  if (numThreads <= 1) {
+    missingPerThread[0] = lookUpRows(0, numRows);
+  } else {
+    std::vector<std::packaged_task<void()>> tasks;
+    for (size_t t = 0; t < numThreads; ++t) {
+      tasks.emplace_back([&, t]() {
+        missingPerThread[t] = lookUpRows(numRows * t / numThreads,
+                                         numRows * (t + 1) / numThreads);
+      });
+    }
+    ad_utility::runTasksInParallel(std::move(tasks));
   }
-  AD_CORRECTNESS_CHECK(rowIdx == parsedValues_._values.size());
-  AD_LOG_INFO << "Number of tuples in VALUES clause: " << rowIdx << std::endl;
+
+  // Add the values that are not contained in the vocabulary to the local
+  // vocabulary (in the order of the rows, s.t. equal values get the same
+  // `Id`).
+  std::vector<size_t> numLocalVocabPerColumn(numColumns);
+  using LiteralOrIri = ad_utility::triple_component::LiteralOrIri;
+  for (const auto& missing : missingPerThread) {
+    for (const auto& [rowIdx, colIdx, bounds] : missing) {
+      const TripleComponent& tc = rows[rowIdx][colIdx];
+      AD_CORRECTNESS_CHECK(tc.isLiteral() || tc.isIri());
+      auto word = tc.isLiteral() ? LiteralOrIri{tc.getLiteral()}
+                                 : LiteralOrIri{tc.getIri()};
+      idTable(rowIdx, colIdx) =
+          Id::makeFromLocalVocabIndex(localVocab->getIndexAndAddIfNotContained(
+              LocalVocabEntry(std::move(word),
+                              Id::makeFromVocabIndex(bounds.first),
+                              Id::makeFromVocabIndex(bounds.second), index)));
+      ++numLocalVocabPerColumn[colIdx];
+    }
+  }
+  AD_LOG_INFO << "Number of tuples in VALUES clause: " << numRows << std::endl;
   AD_LOG_INFO << "Number of entries in local vocabulary per column: "
               << absl::StrJoin(numLocalVocabPerColumn, ", ") << std::endl;
+  if (numThreads > 1) {
+    runtimeInfo().addDetail("num-threads", numThreads);
+  }
   *idTablePtr = std::move(idTable).toDynamic();
 }
 
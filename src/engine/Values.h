@@ -10,12 +10,23 @@
 #include "engine/Operation.h"
 #include "parser/ParsedQuery.h"
 
+// The operation for a VALUES clause. The IRIs and literals are looked up in
+// the vocabulary in parallel (see `values-num-threads`). Large VALUES clauses
+// (see `values-sort-min-num-rows`) are sorted by all their columns, and report
+// this in `resultSortedOn`, s.t. they can be joined without a `Sort`.
 class Values : virtual public Operation {
   using SparqlValues = parsedQuery::SparqlValues;
 
+ public:
+  // VALUES clauses with fewer rows per thread are looked up by fewer threads.
+  static constexpr size_t minNumRowsPerThread_ = 10'000;
+
  private:
   std::vector<float> multiplicities_;
   SparqlValues parsedValues_;
+  // True if the result is sorted by all columns. This is determined when the
+  // operation is created, because `resultSortedOn` must not change later.
+  bool sortResult_ = false;
 
  protected:
   // Accessors for the parsed values.
@@ -62,10 +73,9 @@ class Values : virtual public Operation {
   // Compute the per-column multiplicity of the parsed values.
   void computeMultiplicities();
 
-  // Write `parsedValues_` to the given result object.
-  //
-  // NOTE: this moves the values out of `parsedValues_` (to save a string copy
-  // for those values that end up in the local vocabulary).
+  // Write `parsedValues_` to the given result object. The values are first
+  // looked up in the vocabulary (concurrently for large VALUES clauses), the
+  // values that are not contained in it are then added to the `localVocab`.
   template <size_t I>
   void writeValues(IdTable* idTablePtr, LocalVocab* localVocab);
 };
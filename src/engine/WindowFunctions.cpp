@@ -0,0 +1,454 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/WindowFunctions.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+
+#include <sstream>
+
+#include "engine/QueryExecutionTree.h"
+#include "util/Algorithm.h"
+#include "util/HashSet.h"
+#include "util/Iterators.h"
+
+namespace {
+// The name of the `function` in the descriptor and the cache key.
+std::string_view getName(WindowFunction function) {
+  switch (function) {
+    case WindowFunction::ROW_NUMBER:
+      return "ROW_NUMBER";
+    case WindowFunction::RANK:
+      return "RANK";
+    case WindowFunction::RUNNING_SUM:
+      return "RUNNING_SUM";
+    case WindowFunction::RUNNING_COUNT:
+      return "RUNNING_COUNT";
+    case WindowFunction::LAG:
+      return "LAG";
+    case WindowFunction::LEAD:
+      return "LEAD";
+  }
+  AD_FAIL();
+}
+
+// Return true if the result of the `function` is never unbound.
+bool isAlwaysDefined(WindowFunction function) {
+  return function == WindowFunction::ROW_NUMBER ||
+         function == WindowFunction::RANK ||
+         function == WindowFunction::RUNNING_COUNT;
+}
+
+// Add the `value` to the running sum of the `state`.
+void addToSum(WindowFunctions::State& state, Id value) {
+  switch (value.getDatatype()) {
+    case Datatype::Undefined:
+      return;
+    case Datatype::Int:
+      if (state.sumIsDouble_) {
+        state.doubleSum_ += static_cast<double>(value.getInt());
+      } else {
+        state.intSum_ += value.getInt();
+      }
+      return;
+    case Datatype::Double:
+      if (!state.sumIsDouble_) {
+        state.sumIsDouble_ = true;
+        state.doubleSum_ = static_cast<double>(state.intSum_);
+      }
+      state.doubleSum_ += value.getDouble();
+      return;
+    default:
+      // Like `SUM`, the sum of a non-numeric value is an error.
+      state.sumIsUndefined_ = true;
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::string WindowFunctionsConfiguration::toString() const {
+  std::ostringstream os;
+  auto appendVariables = [&os](std::string_view name,
+                               const std::vector<Variable>& variables) {
+    os << name << ":";
+    for (const auto& variable : variables) {
+      os << ' ' << variable.toSparql();
+    }
+    os << '\n';
+  };
+  appendVariables("Partition by", partitionBy_);
+  appendVariables("Order by", orderBy_);
+  if (value_.has_value()) {
+    os << "Value: " << value_->toSparql() << '\n';
+  }
+  os << "Offset: " << offset_ << '\n';
+  for (const auto& [function, variable] : functions_) {
+    os << getName(function) << ": " << variable.toSparql() << '\n';
+  }
+  return std::move(os).str();
+}
+
+// The lazy result of a `WindowFunctions` operation, which computes the
+// functions block by block. The rows for which the `LEAD` is not known yet
+// are kept in `pending_` and are prepended to the next block.
+class WindowFunctions::LazyWindowFunctionsRange
+    : public ad_utility::InputRangeFromGet<Result::IdTableVocabPair> {
+  const WindowFunctions& parent_;
+  Result::LazyResult input_;
+  std::optional<Result::LazyResult::iterator> iterator_ = std::nullopt;
+  State state_;
+  IdTable pending_;
+  // The `LAG` and `LEAD` values might come from earlier blocks, so all the
+  // local vocabularies of the input seen so far are kept alive.
+  LocalVocab carriedVocab_;
+  bool done_ = false;
+
+ public:
+  LazyWindowFunctionsRange(const WindowFunctions& parent,
+                           Result::LazyResult input)
+      : parent_{parent},
+        input_{std::move(input)},
+        pending_{parent.getResultWidth(), parent.allocator()} {}
+
+  std::optional<Result::IdTableVocabPair> get() override {
+    const bool copiesValues = parent_.copiesValuesBetweenRows();
+    while (!done_) {
+      if (iterator_) {
+        ++iterator_.value();
+      } else {
+        iterator_ = input_.begin();
+      }
+      if (*iterator_ == input_.end()) {
+        done_ = true;
+        if (pending_.empty()) {
+          return std::nullopt;
+        }
+        parent_.fillLeadColumns(pending_, true);
+        return Result::IdTableVocabPair{std::move(pending_),
+                                        carriedVocab_.clone()};
+      }
+      auto& [idTable, localVocab] = *iterator_.value();
+      if (idTable.empty()) {
+        continue;
+      }
+      parent_.appendFunctionColumns(idTable, state_);
+      if (!copiesValues) {
+        return Result::IdTableVocabPair{std::move(idTable),
+                                        std::move(localVocab)};
+      }
+      carriedVocab_.mergeWith(localVocab);
+      IdTable block = std::move(idTable);
+      if (!pending_.empty()) {
+        pending_.insertAtEnd(block);
+        block = std::move(pending_);
+      }
+      size_t numComplete = parent_.fillLeadColumns(block, false);
+      pending_ = IdTable{parent_.getResultWidth(), parent_.allocator()};
+      pending_.insertAtEnd(block, numComplete);
+      if (numComplete == 0) {
+        continue;
+      }
+      block.resize(numComplete);
+      return Result::IdTableVocabPair{std::move(block), carriedVocab_.clone()};
+    }
+    return std::nullopt;
+  }
+};
+
+// _____________________________________________________________________________
+WindowFunctions::WindowFunctions(QueryExecutionContext* qec,
+                                 std::shared_ptr<QueryExecutionTree> subtree,
+                                 WindowFunctionsConfiguration config)
+    : Operation(qec), subtree_(std::move(subtree)), config_(std::move(config)) {
+  AD_CORRECTNESS_CHECK(subtree_ != nullptr);
+  auto getColumn = [this](const Variable& variable) {
+    if (!subtree_->isVariableCovered(variable)) {
+      throw std::runtime_error(absl::StrCat(
+          "The variable ", variable.toSparql(),
+          " of the window functions service is not bound by its graph "
+          "pattern"));
+    }
+    return subtree_->getVariableColumn(variable);
+  };
+  auto addKeyColumn = [this, &getColumn](const Variable& variable) {
+    auto column = getColumn(variable);
+    if (!ad_utility::contains(keyColumns_, column)) {
+      keyColumns_.push_back(column);
+    }
+  };
+  ql::ranges::for_each(config_.partitionBy_, addKeyColumn);
+  partitionColumns_ = keyColumns_;
+  ql::ranges::for_each(config_.orderBy_, addKeyColumn);
+  if (config_.value_.has_value()) {
+    valueColumn_ = getColumn(config_.value_.value());
+  }
+
+  if (config_.functions_.empty()) {
+    throw std::runtime_error(
+        "The window functions service requires at least one function");
+  }
+  if (config_.offset_ == 0) {
+    throw std::runtime_error(
+        "The offset of the window functions service must be positive");
+  }
+  ad_utility::HashSet<Variable> targets;
+  for (const auto& [function, variable] : config_.functions_) {
+    // `RUNNING_COUNT` without a `<value>` counts the rows.
+    if (!valueColumn_.has_value() && function != WindowFunction::ROW_NUMBER &&
+        function != WindowFunction::RANK &&
+        function != WindowFunction::RUNNING_COUNT) {
+      throw std::runtime_error(absl::StrCat(
+          "The window function ", getName(function),
+          " requires the parameter <value>"));
+    }
+    if (subtree_->isVariableCovered(variable) ||
+        !targets.insert(variable).second) {
+      throw std::runtime_error(absl::StrCat(
+          "The variable ", variable.toSparql(),
+          " for the result of a window function is already bound"));
+    }
+  }
+
+  subtree_ = QueryExecutionTree::createSortedTree(std::move(subtree_),
+                                                  keyColumns_);
+}
+
+// _____________________________________________________________________________
+std::string WindowFunctions::getCacheKeyImpl() const {
+  std::ostringstream os;
+  os << "WINDOW FUNCTIONS partition columns: "
+     << absl::StrJoin(partitionColumns_, " ")
+     << ", key columns: " << absl::StrJoin(keyColumns_, " ")
+     << ", value column: "
+     << (valueColumn_.has_value() ? absl::StrCat(valueColumn_.value()) : "-")
+     << ", offset: " << config_.offset_ << ", functions:";
+  for (const auto& [function, variable] : config_.functions_) {
+    os << ' ' << getName(function);
+  }
+  os << '\n' << subtree_->getCacheKey();
+  return std::move(os).str();
+}
+
+// _____________________________________________________________________________
+std::string WindowFunctions::getDescriptor() const {
+  return absl::StrCat(
+      "WindowFunctions ",
+      absl::StrJoin(config_.functions_, ", ",
+                    [](std::string* out, const auto& functionAndVariable) {
+                      absl::StrAppend(out, getName(functionAndVariable.first));
+                    }));
+}
+
+// _____________________________________________________________________________
+size_t WindowFunctions::getResultWidth() const {
+  return subtree_->getResultWidth() + config_.functions_.size();
+}
+
+// _____________________________________________________________________________
+size_t WindowFunctions::getCostEstimate() {
+  return subtree_->getCostEstimate() + subtree_->getSizeEstimate();
+}
+
+// _____________________________________________________________________________
+uint64_t WindowFunctions::getSizeEstimateBeforeLimit() {
+  return subtree_->getSizeEstimate();
+}
+
+// _____________________________________________________________________________
+float WindowFunctions::getMultiplicity(size_t col) {
+  if (col < subtree_->getResultWidth()) {
+    return subtree_->getMultiplicity(col);
+  }
+  // The row numbers, ranks and running aggregates are mostly distinct.
+  return 1.0f;
+}
+
+// _____________________________________________________________________________
+bool WindowFunctions::knownEmptyResult() {
+  return subtree_->knownEmptyResult();
+}
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> WindowFunctions::resultSortedOn() const {
+  // The columns of the functions are appended at the end.
+  return subtree_->resultSortedOn();
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap WindowFunctions::computeVariableToColumnMap() const {
+  auto map = subtree_->getVariableColumns();
+  using enum ColumnIndexAndTypeInfo::UndefStatus;
+  ColumnIndex column = subtree_->getResultWidth();
+  for (const auto& [function, variable] : config_.functions_) {
+    map[variable] = ColumnIndexAndTypeInfo{
+        column++,
+        isAlwaysDefined(function) ? AlwaysDefined : PossiblyUndefined};
+  }
+  return map;
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<Operation> WindowFunctions::cloneImpl() const {
+  auto copy = std::make_unique<WindowFunctions>(*this);
+  copy->subtree_ = subtree_->clone();
+  return copy;
+}
+
+// _____________________________________________________________________________
+bool WindowFunctions::copiesValuesBetweenRows() const {
+  return ql::ranges::any_of(config_.functions_, [](const auto& function) {
+    return function.first == WindowFunction::LAG ||
+           function.first == WindowFunction::LEAD;
+  });
+}
+
+// _____________________________________________________________________________
+void WindowFunctions::appendFunctionColumns(IdTable& block,
+                                            State& state) const {
+  const size_t inputWidth = subtree_->getResultWidth();
+  const size_t numPartitionColumns = partitionColumns_.size();
+  const size_t offset = config_.offset_;
+  const bool storesPreviousValues =
+      ql::ranges::any_of(config_.functions_, [](const auto& function) {
+        return function.first == WindowFunction::LAG;
+      });
+  for (size_t i = 0; i < config_.functions_.size(); ++i) {
+    block.addEmptyColumn();
+  }
+  state.previousKey_.resize(keyColumns_.size());
+
+  // Return true if the key columns `[begin, end)` of the `row` are the same as
+  // those of the previous row.
+  auto keyMatches = [&block, &state, this](size_t row, size_t begin,
+                                           size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      if (block(row, keyColumns_[i]) != state.previousKey_[i]) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  for (size_t row = 0; row < block.numRows(); ++row) {
+    bool isNewPartition =
+        !state.hasPreviousRow_ || !keyMatches(row, 0, numPartitionColumns);
+    if (isNewPartition) {
+      state.rowNumber_ = 0;
+      state.count_ = 0;
+      state.intSum_ = 0;
+      state.doubleSum_ = 0;
+      state.sumIsDouble_ = false;
+      state.sumIsUndefined_ = false;
+      state.previousValues_.clear();
+    }
+    bool isNewOrderKey =
+        isNewPartition ||
+        !keyMatches(row, numPartitionColumns, keyColumns_.size());
+    ++state.rowNumber_;
+    if (isNewOrderKey) {
+      state.rank_ = state.rowNumber_;
+    }
+    Id value = valueColumn_.has_value() ? block(row, valueColumn_.value())
+                                        : Id::makeUndefined();
+    if (!valueColumn_.has_value() || !value.isUndefined()) {
+      ++state.count_;
+    }
+    addToSum(state, value);
+
+    for (size_t i = 0; i < config_.functions_.size(); ++i) {
+      Id& result = block(row, inputWidth + i);
+      switch (config_.functions_[i].first) {
+        case WindowFunction::ROW_NUMBER:
+          result = Id::makeFromInt(state.rowNumber_);
+          break;
+        case WindowFunction::RANK:
+          result = Id::makeFromInt(state.rank_);
+          break;
+        case WindowFunction::RUNNING_SUM:
+          result = state.sumIsUndefined_ ? Id::makeUndefined()
+                   : state.sumIsDouble_  ? Id::makeFromDouble(state.doubleSum_)
+                                         : Id::makeFromInt(state.intSum_);
+          break;
+        case WindowFunction::RUNNING_COUNT:
+          result = Id::makeFromInt(state.count_);
+          break;
+        case WindowFunction::LAG:
+          result = state.previousValues_.size() == offset
+                       ? state.previousValues_.front()
+                       : Id::makeUndefined();
+          break;
+        case WindowFunction::LEAD:
+          // Computed by `fillLeadColumns`.
+          result = Id::makeUndefined();
+          break;
+      }
+    }
+
+    if (storesPreviousValues) {
+      state.previousValues_.push_back(value);
+      if (state.previousValues_.size() > offset) {
+        state.previousValues_.pop_front();
+      }
+    }
+    for (size_t i = 0; i < keyColumns_.size(); ++i) {
+      state.previousKey_[i] = block(row, keyColumns_[i]);
+    }
+    state.hasPreviousRow_ = true;
+    if (row % CHUNK_SIZE == 0) {
+      checkCancellation();
+    }
+  }
+}
+
+// _____________________________________________________________________________
+size_t WindowFunctions::fillLeadColumns(IdTable& block,
+                                        bool isLastBlock) const {
+  const size_t numRows = block.numRows();
+  const size_t offset = config_.offset_;
+  const size_t numComplete =
+      isLastBlock ? numRows : (numRows > offset ? numRows - offset : 0);
+  auto isSamePartition = [&block, this](size_t rowA, size_t rowB) {
+    return ql::ranges::all_of(partitionColumns_, [&](ColumnIndex column) {
+      return block(rowA, column) == block(rowB, column);
+    });
+  };
+  const size_t inputWidth = subtree_->getResultWidth();
+  for (size_t i = 0; i < config_.functions_.size(); ++i) {
+    if (config_.functions_[i].first != WindowFunction::LEAD) {
+      continue;
+    }
+    for (size_t row = 0; row < numComplete; ++row) {
+      size_t next = row + offset;
+      block(row, inputWidth + i) =
+          next < numRows && isSamePartition(row, next)
+              ? block(next, valueColumn_.value())
+              : Id::makeUndefined();
+    }
+    checkCancellation();
+  }
+  return numComplete;
+}
+
+// _____________________________________________________________________________
+Result WindowFunctions::computeResult(bool requestLaziness) {
+  std::shared_ptr<const Result> subResult =
+      subtree_->getResult(requestLaziness);
+  if (subResult->isFullyMaterialized()) {
+    IdTable result = subResult->idTable().clone();
+    State state;
+    appendFunctionColumns(result, state);
+    fillLeadColumns(result, true);
+    return {std::move(result), resultSortedOn(),
+            subResult->getSharedLocalVocab()};
+  }
+  return {Result::LazyResult{
+              LazyWindowFunctionsRange{*this, subResult->idTables()}},
+          resultSortedOn()};
+}
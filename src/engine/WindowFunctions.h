@@ -0,0 +1,147 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_WINDOWFUNCTIONS_H
+#define QLEVER_SRC_ENGINE_WINDOWFUNCTIONS_H
+
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "engine/Operation.h"
+#include "global/Id.h"
+#include "rdfTypes/Variable.h"
+
+enum class WindowFunction {
+  ROW_NUMBER,
+  RANK,
+  RUNNING_SUM,
+  RUNNING_COUNT,
+  LAG,
+  LEAD
+};
+
+// The parameters of a `WindowFunctions` operation.
+struct WindowFunctionsConfiguration {
+  // The rows are partitioned by the values of these variables (no variables
+  // means a single partition), and ordered (ascending) by the values of the
+  // `orderBy_` variables within each partition.
+  std::vector<Variable> partitionBy_;
+  std::vector<Variable> orderBy_;
+  // The argument of `RUNNING_SUM`, `RUNNING_COUNT`, `LAG` and `LEAD`. Only
+  // `RUNNING_COUNT` can be used without it.
+  std::optional<Variable> value_;
+  // The distance of the rows that are looked at by `LAG` and `LEAD`.
+  size_t offset_ = 1;
+  // The functions and the variables that are bound to their results.
+  std::vector<std::pair<WindowFunction, Variable>> functions_;
+
+  std::string toString() const;
+};
+
+// Compute window functions over the partitions of the rows of the `subtree`,
+// and append one column per function. The `subtree` is sorted by the
+// `partitionBy_` and then by the `orderBy_` variables, so the rows of one
+// partition are adjacent, and each row can be computed in a single pass with
+// a state whose size only depends on the `offset_` (and not on the size of
+// the partition, as it would with the self-joins that are otherwise needed
+// to express these functions):
+//
+// * `ROW_NUMBER`: The position of the row in its partition, starting at 1.
+// * `RANK`: The `ROW_NUMBER` of the first row of the partition with the same
+//   `orderBy_` values (with gaps after ties, like `RANK` in SQL).
+// * `RUNNING_SUM`: The sum of the numeric `value_`s of the partition up to
+//   and including this row. Unbound if one of them is not numeric.
+// * `RUNNING_COUNT`: The number of bound `value_`s (or of all rows if there is
+//   no `value_`) of the partition up to and including this row.
+// * `LAG` and `LEAD`: The `value_` of the row that is `offset_` rows before
+//   (after) this row in the same partition, unbound if there is none.
+//
+// The result is computed lazily if the `subtree` is lazy. For `LEAD`, the
+// last `offset_` rows of each block are held back until the next block is
+// available.
+class WindowFunctions : public Operation {
+ public:
+  // The number of rows after which the cancellation is checked.
+  static constexpr size_t CHUNK_SIZE = 10'000;
+
+  // The values that are carried from one row (and block) to the next one.
+  struct State {
+    bool hasPreviousRow_ = false;
+    // The values of the `partitionBy_` and then the `orderBy_` columns of the
+    // previous row.
+    std::vector<Id> previousKey_;
+    int64_t rowNumber_ = 0;
+    int64_t rank_ = 0;
+    int64_t count_ = 0;
+    int64_t intSum_ = 0;
+    double doubleSum_ = 0;
+    bool sumIsDouble_ = false;
+    bool sumIsUndefined_ = false;
+    // The last `offset_` values of the partition, for `LAG`.
+    std::deque<Id> previousValues_;
+  };
+
+ private:
+  std::shared_ptr<QueryExecutionTree> subtree_;
+  WindowFunctionsConfiguration config_;
+  std::vector<ColumnIndex> partitionColumns_;
+  // The `partitionColumns_` followed by the columns of the `orderBy_`.
+  std::vector<ColumnIndex> keyColumns_;
+  std::optional<ColumnIndex> valueColumn_;
+
+  class LazyWindowFunctionsRange;
+
+ public:
+  // The `subtree` is sorted by the `partitionBy_` and `orderBy_` variables if
+  // it isn't already.
+  WindowFunctions(QueryExecutionContext* qec,
+                  std::shared_ptr<QueryExecutionTree> subtree,
+                  WindowFunctionsConfiguration config);
+
+  const WindowFunctionsConfiguration& getConfig() const { return config_; }
+
+  std::vector<QueryExecutionTree*> getChildren() override {
+    return {subtree_.get()};
+  }
+
+  std::string getCacheKeyImpl() const override;
+  std::string getDescriptor() const override;
+  size_t getResultWidth() const override;
+  size_t getCostEstimate() override;
+  uint64_t getSizeEstimateBeforeLimit() override;
+  float getMultiplicity(size_t col) override;
+  bool knownEmptyResult() override;
+  std::vector<ColumnIndex> resultSortedOn() const override;
+
+ private:
+  std::unique_ptr<Operation> cloneImpl() const override;
+  Result computeResult(bool requestLaziness) override;
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+  // Append the columns of the functions to the `block` and compute them for
+  // all rows, starting with the `state`, except for the `LEAD` columns.
+  void appendFunctionColumns(IdTable& block, State& state) const;
+
+  // Compute the `LEAD` columns of the rows of the `block` for which the row
+  // `offset_` rows later is contained in the `block`, or for all rows if
+  // `isLastBlock` is true. Return the number of these rows, which are a
+  // prefix of the `block`.
+  size_t fillLeadColumns(IdTable& block, bool isLastBlock) const;
+
+  // Return true if one of the functions is `LAG` or `LEAD`, the only ones that
+  // copy values (which might be contained in a local vocabulary) from other
+  // rows.
+  bool copiesValuesBetweenRows() const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_WINDOWFUNCTIONS_H
@@ -20,6 +20,7 @@
 #include "util/File.h"
 #include "util/InputRangeUtils.h"
 #include "util/Iterators.h"
+#include "util/LoserTree.h"
 #include "util/MemorySize/MemorySize.h"
 #include "util/TransparentFunctors.h"
 #include "util/Views.h"
@@ -40,6 +41,10 @@ using namespace ad_utility::memory_literals;
 static constexpr ad_utility::MemorySize DEFAULT_BLOCKSIZE_EXTERNAL_ID_TABLE =
     500_kB;
 
+// The default number of threads that are used in the merge phase of the
+// `CompressedExternalIdTableSorter` (see below).
+static constexpr size_t DEFAULT_NUM_MERGE_THREADS_EXTERNAL_ID_TABLE = 4;
+
 // A class that stores a sequence of `IdTable`s in a file. Each `IdTable` is
 // compressed blockwise. Typically, the blocksize is much smaller than the size
 // of a single `IdTable`, such that there are multiple blocks per `IdTable`.
@@ -172,7 +177,10 @@ class CompressedExternalIdTableWriter {
   }
 
   // Return a vector of generators where the `i-th` generator generates the
-  // `i-th` IdTable that was stored. The IdTables are yielded row by row.
+  // `i-th` IdTable that was stored. The IdTables are yielded row by row. These
+  // generators are consumed concurrently (e.g. by the merge phase of the
+  // `CompressedExternalIdTableSorter`), so each of them decompresses its next
+  // block on a single background thread, see `makeGeneratorForIdTable`.
   template <size_t N = 0>
   auto getAllRowGenerators() {
     file_.wlock()->flush();
@@ -204,22 +212,36 @@ class CompressedExternalIdTableWriter {
   // Get the row generator for a single IdTable, specified by the `index`.
   template <size_t N = 0>
   auto makeGeneratorForRows(size_t index) {
-    return ql::views::join(
-        ad_utility::OwningView{makeGeneratorForIdTable<N>(index)});
+    return ql::views::join(ad_utility::OwningView{
+        makeGeneratorForIdTable<N>(index, DecompressColumnsInParallel::False)});
   }
 
   // Get the block generator for a single IdTable, specified by the `index`.
+  // The next block is always read and decompressed in the background while the
+  // current block is being consumed. If `decompressColumnsInParallel` is
+  // `False`, the background thread decompresses the columns of a block
+  // sequentially. This is preferable when many generators are consumed
+  // concurrently, because otherwise each block of each generator would spawn
+  // one thread per column.
+  enum class DecompressColumnsInParallel : bool { False, True };
   template <size_t NumCols = 0>
   InputRangeTypeErased<IdTableStatic<NumCols>> makeGeneratorForIdTable(
-      size_t index) {
+      size_t index, DecompressColumnsInParallel decompressColumnsInParallel =
+                        DecompressColumnsInParallel::True) {
     size_t firstBlock = startOfSingleIdTables_.at(index);
     size_t lastBlock{index + 1 < startOfSingleIdTables_.size()
                          ? startOfSingleIdTables_.at(index + 1)
                          : blocksPerColumn_.at(0).size()};
-    auto readBlocks = ql::views::iota(firstBlock, lastBlock) |
-                      ql::views::transform([this](auto blockIdx) {
-                        return this->template readBlock<NumCols>(blockIdx);
-                      });
+    auto readBlocks =
+        ql::views::iota(firstBlock, lastBlock) |
+        ql::views::transform(
+            [this, decompressColumnsInParallel](auto blockIdx) {
+              return decompressColumnsInParallel ==
+                             DecompressColumnsInParallel::True
+                         ? this->template readBlock<NumCols>(blockIdx)
+                         : this->template readBlockSequential<NumCols>(
+                               blockIdx);
+            });
     ++numActiveGenerators_;
     auto callback = [this]() noexcept { --numActiveGenerators_; };
     using namespace ad_utility;
@@ -236,7 +258,10 @@ class CompressedExternalIdTableWriter {
                                  IdTableStatic<NumCols>& block) {
     decltype(auto) col = block.getColumn(columnIdx);
     const auto& metaData = blocksPerColumn_.at(columnIdx).at(blockIdx);
-    std::vector<char> compressed(metaData.compressedSize_);
+    // The buffer for the compressed bytes is reused for all the blocks that
+    // are decompressed by the same thread.
+    thread_local std::vector<char> compressed;
+    compressed.resize(metaData.compressedSize_);
     auto numBytesRead = file_.wlock()->read(
         compressed.data(), metaData.compressedSize_, metaData.offsetInFile_);
     AD_CORRECTNESS_CHECK(numBytesRead >= 0 &&
@@ -630,6 +655,9 @@ class CompressedExternalIdTableSorter
   // See the `moveResultOnMerge()` getter function for documentation.
   bool moveResultOnMerge_ = true;
 
+  // See the `numMergeThreads()` getter function for documentation.
+  size_t numMergeThreads_ = DEFAULT_NUM_MERGE_THREADS_EXTERNAL_ID_TABLE;
+
  public:
   // Constructor.
   CompressedExternalIdTableSorter(
@@ -672,6 +700,12 @@ class CompressedExternalIdTableSorter
     return moveResultOnMerge_;
   }
 
+  // The maximal number of threads that merge disjoint groups of the presorted
+  // blocks in parallel during the merge phase. The results of these groups are
+  // then merged by one additional thread. A value of `0` or `1` means that all
+  // the blocks are merged by a single thread.
+  size_t& numMergeThreads() { return numMergeThreads_; }
+
   // Transition from the input phase, where `push()` can be called, to the
   // output phase and return a generator that yields the sorted elements one by
   // one. Either this function or the following function must be called exactly
@@ -726,12 +760,14 @@ class CompressedExternalIdTableSorter
   struct SortState
       : ad_utility::InputRangeMixin<SortState<RowGenVectorType, CompType>> {
     using RowGenType = ql::ranges::range_value_t<RowGenVectorType>;
-    using RowIteratorPair = std::pair<ql::ranges::iterator_t<RowGenType>,
-                                      ql::ranges::sentinel_t<RowGenType>>;
+    using Tree = LoserTree<ql::ranges::iterator_t<RowGenType>,
+                           ql::ranges::sentinel_t<RowGenType>, CompType>;
 
-    std::vector<RowIteratorPair> priorityQueue_;
+    std::optional<Tree> loserTree_;
     bool isFinished_ = false;
     IdTableStatic<NumStaticCols> result_;
+    // If not `nullptr`, it is checked that all the elements of the `sorter_`
+    // have been merged.
     CompressedExternalIdTableSorter* sorter_;
     CompType comp_;
     RowGenVectorType rowGenerators_;
@@ -750,12 +786,7 @@ class CompressedExternalIdTableSorter
           blockSizeOutput_{blockSize} {}
 
     void start() {
-      for (auto& gen : rowGenerators_) {
-        priorityQueue_.emplace_back(gen.begin(), gen.end());
-        const auto& b = priorityQueue_.back();
-        AD_CORRECTNESS_CHECK(b.first != b.second);
-      }
-      ql::ranges::make_heap(priorityQueue_, comp_);
+      loserTree_.emplace(makeLoserTree(rowGenerators_, comp_));
       // Without that call, `begin() != end()` would always hold (even for empty
       // sorters), and `*begin()` would always yield an empty block (even for
       // non-empty sorters).
@@ -764,10 +795,13 @@ class CompressedExternalIdTableSorter
 
     bool isFinished() {
       if (isFinished_) {
-        AD_CORRECTNESS_CHECK(numPopped_ == sorter_->numElementsPushed_, [this] {
-          return absl::StrCat("numPopped: ", numPopped_, "num elements pushed:",
-                              sorter_->numElementsPushed_);
-        });
+        AD_CORRECTNESS_CHECK(
+            sorter_ == nullptr || numPopped_ == sorter_->numElementsPushed_,
+            [this] {
+              return absl::StrCat("numPopped: ", numPopped_,
+                                  "num elements pushed:",
+                                  sorter_->numElementsPushed_);
+            });
         return true;
       } else {
         return false;
@@ -778,16 +812,10 @@ class CompressedExternalIdTableSorter
     void next() {
       result_.clear();
       result_.reserve(blockSizeOutput_);
-      while (!priorityQueue_.empty() && result_.size() < blockSizeOutput_) {
-        ql::ranges::pop_heap(priorityQueue_, comp_);
-        auto& min = priorityQueue_.back();
-        result_.push_back(*min.first);
-        ++(min.first);
-        if (min.first == min.second) {
-          priorityQueue_.pop_back();
-        } else {
-          ql::ranges::push_heap(priorityQueue_, comp_);
-        }
+      auto& tree = loserTree_.value();
+      while (!tree.empty() && result_.size() < blockSizeOutput_) {
+        result_.push_back(tree.top());
+        tree.pop();
       }
       numPopped_ += result_.numRows();
       isFinished_ = result_.empty();
@@ -839,27 +867,62 @@ class CompressedExternalIdTableSorter
     auto rowGenerators =
         this->writer_.template getAllRowGenerators<NumStaticCols>();
 
-    const size_t blockSizeOutput =
-        blocksize.value_or(computeBlockSizeForMergePhase(rowGenerators.size()));
+    // Each merge thread gets at least two of the presorted blocks.
+    const size_t numGroups =
+        std::min(numMergeThreads_, rowGenerators.size() / 2);
+    const size_t blockSizeOutput = blocksize.value_or(
+        computeBlockSizeForMergePhase(rowGenerators.size(), numGroups > 1));
 
-    auto projection = [](const auto& el) -> decltype(auto) {
-      return *el.first;
-    };
-    auto directComp = ad_utility::makeAssignableLambda(
-        [projection, comparator = this->comparator_](const auto& a,
-                                                     const auto& b) {
-          return comparator(projection(b), projection(a));
-        });
+    if (numGroups <= 1) {
+      return mergeRowGenerators<N>(std::move(rowGenerators), blockSizeOutput,
+                                   this);
+    }
 
+    // Merge `numGroups` disjoint groups of the blocks in parallel, and then
+    // merge the results of the groups. The intermediate blocks of all the
+    // groups together (three per group: one that is being filled, one in the
+    // queue, and one that is being consumed) require about as much memory as
+    // a single output block.
+    using RowGenerator = ql::ranges::range_value_t<decltype(rowGenerators)>;
+    const size_t blockSizeGroups =
+        std::max(size_t{1}, blockSizeOutput / (3 * numGroups));
+    std::vector<RowGenerator> mergedGroups;
+    mergedGroups.reserve(numGroups);
+    auto groupBegin = rowGenerators.begin();
+    for (size_t i = 0; i < numGroups; ++i) {
+      auto groupEnd =
+          rowGenerators.begin() + (i + 1) * rowGenerators.size() / numGroups;
+      std::vector<RowGenerator> group(std::make_move_iterator(groupBegin),
+                                      std::make_move_iterator(groupEnd));
+      groupBegin = groupEnd;
+      auto mergedGroup = ad_utility::streams::runStreamAsync(
+          mergeRowGenerators<NumStaticCols>(std::move(group), blockSizeGroups,
+                                            nullptr),
+          1);
+      mergedGroups.push_back(
+          ql::views::join(ad_utility::OwningView{std::move(mergedGroup)}));
+    }
+    return mergeRowGenerators<N>(std::move(mergedGroups), blockSizeOutput,
+                                 this);
+  }
+
+  // Merge the `rowGenerators` (each of which has to be sorted) into a single
+  // sorted range of blocks with `blockSizeOutput` rows each. If `sorter` is not
+  // `nullptr`, then it is checked that the result contains all the elements
+  // that were pushed to the `sorter`.
+  template <size_t N, typename RowGenerators>
+  ad_utility::InputRangeTypeErased<IdTableStatic<N>> mergeRowGenerators(
+      RowGenerators rowGenerators, size_t blockSizeOutput,
+      CompressedExternalIdTableSorter* sorter) {
     auto toStatic = [](auto& table) -> IdTableStatic<N> {
       return std::move(table).template toStatic<N>();
     };
     using namespace ad_utility;
     return InputRangeTypeErased{CachingTransformInputRange{
-        SortState<decltype(rowGenerators), decltype(directComp)>{
+        SortState<RowGenerators, Comparator>{
             this->writer_.numColumns(), this->writer_.allocator(),
-            std::move(directComp), std::move(rowGenerators), blockSizeOutput,
-            this},
+            this->comparator_, std::move(rowGenerators), blockSizeOutput,
+            sorter},
         toStatic}};
   }
 
@@ -879,8 +942,11 @@ class CompressedExternalIdTableSorter
 
   // Compute the size of the blocks that are yielded in the output phase. It is
   // computed from the total memory limit and the amount of memory required to
-  // store one decompressed block from each presorted input.
-  size_t computeBlockSizeForMergePhase(size_t numBlocksToMerge) {
+  // store one decompressed block from each presorted input. If
+  // `mergeInParallel` is true, the memory for the intermediate blocks of the
+  // parallel merge (about one output block) is also taken into account.
+  size_t computeBlockSizeForMergePhase(size_t numBlocksToMerge,
+                                       bool mergeInParallel = false) {
     const size_t numColumns = this->numColumns_;
     MemorySize requiredMemoryForInputBlocks =
         numBlocksToMerge * numColumns * this->writer_.blockSizeUncompressed();
@@ -900,7 +966,7 @@ class CompressedExternalIdTableSorter
       // Don't use a too large output size.
       auto blockSizeOutputMemory =
           std::min((this->memory_ - requiredMemoryForInputBlocks) /
-                       numBufferedOutputBlocks_,
+                       (numBufferedOutputBlocks_ + (mergeInParallel ? 1 : 0)),
                    maxOutputBlocksize_);
 
       size_t blockSizeForOutput =
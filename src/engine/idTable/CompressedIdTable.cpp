@@ -0,0 +1,174 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/idTable/CompressedIdTable.h"
+
+#include <absl/numeric/bits.h>
+
+#include <algorithm>
+
+#include "util/BitPacking.h"
+#include "util/Exception.h"
+
+namespace {
+// The number of bits that are required to store the `value`.
+uint8_t numBitsFor(uint64_t value) {
+  return static_cast<uint8_t>(absl::bit_width(value));
+}
+}  // namespace
+
+// _____________________________________________________________________________
+CompressedIdTable::CompressedIdTable(const IdTable& idTable)
+    : numRows_{idTable.numRows()},
+      numColumns_{idTable.numColumns()},
+      allocator_{idTable.getAllocator()} {
+  for (size_t col = 0; col < numColumns_; ++col) {
+    auto column = idTable.getColumn(col);
+    for (size_t begin = 0; begin < numRows_; begin += BLOCK_SIZE) {
+      blocks_.push_back(compressBlock(
+          column.subspan(begin, std::min(BLOCK_SIZE, numRows_ - begin))));
+    }
+  }
+}
+
+// _____________________________________________________________________________
+auto CompressedIdTable::compressBlock(ql::span<const Id> ids) -> Block {
+  Block block;
+  const size_t n = ids.size();
+  block.numRows_ = n;
+  auto bits = [&ids](size_t i) { return ids[i].getBits(); };
+
+  bool isSorted = true;
+  uint64_t maxDelta = 0;
+  uint64_t min = bits(0);
+  uint64_t max = bits(0);
+  for (size_t i = 1; i < n; ++i) {
+    if (bits(i) < bits(i - 1)) {
+      isSorted = false;
+    } else {
+      maxDelta = std::max(maxDelta, bits(i) - bits(i - 1));
+    }
+    min = std::min(min, bits(i));
+    max = std::max(max, bits(i));
+  }
+  std::vector<uint64_t> distinct(n);
+  for (size_t i = 0; i < n; ++i) {
+    distinct[i] = bits(i);
+  }
+  if (!isSorted) {
+    ql::ranges::sort(distinct);
+  }
+  distinct.erase(std::unique(distinct.begin(), distinct.end()),
+                 distinct.end());
+
+  // The sizes of the different encodings in bits.
+  const uint8_t deltaBits = numBitsFor(maxDelta);
+  const uint8_t frameOfReferenceBits = numBitsFor(max - min);
+  const uint8_t dictionaryBits = numBitsFor(distinct.size() - 1);
+  const size_t rawSize = n * 64;
+  const size_t deltaSize = isSorted ? n * deltaBits : rawSize;
+  const size_t frameOfReferenceSize = n * frameOfReferenceBits;
+  const size_t dictionarySize = distinct.size() * 64 + n * dictionaryBits;
+  const size_t bestSize =
+      std::min({rawSize, deltaSize, frameOfReferenceSize, dictionarySize});
+
+  if (bestSize == rawSize) {
+    block.encoding_ = Encoding::Raw;
+    block.numBits_ = 64;
+    block.packed_ = ad_utility::bitPack(n, 64, bits);
+  } else if (bestSize == deltaSize) {
+    block.encoding_ = Encoding::Delta;
+    block.numBits_ = deltaBits;
+    block.base_ = bits(0);
+    block.packed_ = ad_utility::bitPack(n, deltaBits, [&bits](size_t i) {
+      return i == 0 ? 0 : bits(i) - bits(i - 1);
+    });
+  } else if (bestSize == frameOfReferenceSize) {
+    block.encoding_ = Encoding::FrameOfReference;
+    block.numBits_ = frameOfReferenceBits;
+    block.base_ = min;
+    block.packed_ =
+        ad_utility::bitPack(n, frameOfReferenceBits,
+                            [&bits, min](size_t i) { return bits(i) - min; });
+  } else {
+    block.encoding_ = Encoding::Dictionary;
+    block.numBits_ = dictionaryBits;
+    block.packed_ =
+        ad_utility::bitPack(n, dictionaryBits, [&bits, &distinct](size_t i) {
+          return static_cast<uint64_t>(
+              ql::ranges::lower_bound(distinct, bits(i)) - distinct.begin());
+        });
+    block.dictionary_ = std::move(distinct);
+  }
+  return block;
+}
+
+// _____________________________________________________________________________
+void CompressedIdTable::decompressBlock(const Block& block,
+                                        ql::span<Id> target) {
+  AD_CORRECTNESS_CHECK(target.size() == block.numRows_);
+  auto value = [&block](size_t i) {
+    return ad_utility::bitUnpack(
+        reinterpret_cast<const char*>(block.packed_.data()), block.numBits_, i);
+  };
+  switch (block.encoding_) {
+    case Encoding::Raw:
+      for (size_t i = 0; i < target.size(); ++i) {
+        target[i] = Id::fromBits(block.packed_[i]);
+      }
+      return;
+    case Encoding::Delta: {
+      uint64_t current = block.base_;
+      for (size_t i = 0; i < target.size(); ++i) {
+        current += value(i);
+        target[i] = Id::fromBits(current);
+      }
+      return;
+    }
+    case Encoding::FrameOfReference:
+      for (size_t i = 0; i < target.size(); ++i) {
+        target[i] = Id::fromBits(block.base_ + value(i));
+      }
+      return;
+    case Encoding::Dictionary:
+      for (size_t i = 0; i < target.size(); ++i) {
+        target[i] = Id::fromBits(block.dictionary_[value(i)]);
+      }
+      return;
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+IdTable CompressedIdTable::decompress() const {
+  IdTable result{numColumns_, allocator_};
+  result.resize(numRows_);
+  auto blockIt = blocks_.begin();
+  for (size_t col = 0; col < numColumns_; ++col) {
+    auto column = result.getColumn(col);
+    for (size_t begin = 0; begin < numRows_; begin += BLOCK_SIZE) {
+      AD_CORRECTNESS_CHECK(blockIt != blocks_.end());
+      decompressBlock(*blockIt, column.subspan(begin, blockIt->numRows_));
+      ++blockIt;
+    }
+  }
+  AD_CORRECTNESS_CHECK(blockIt == blocks_.end());
+  return result;
+}
+
+// _____________________________________________________________________________
+ad_utility::MemorySize CompressedIdTable::size() const {
+  size_t numBytes = sizeof(*this);
+  for (const auto& block : blocks_) {
+    numBytes += sizeof(Block) +
+                (block.dictionary_.size() + block.packed_.size()) *
+                    sizeof(uint64_t);
+  }
+  return ad_utility::MemorySize::bytes(numBytes);
+}
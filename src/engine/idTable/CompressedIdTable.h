@@ -0,0 +1,86 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_IDTABLE_COMPRESSEDIDTABLE_H
+#define QLEVER_SRC_ENGINE_IDTABLE_COMPRESSEDIDTABLE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "backports/span.h"
+#include "engine/idTable/IdTable.h"
+#include "global/Id.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/MemorySize/MemorySize.h"
+
+// A compressed in-memory representation of an `IdTable`, used to store large
+// results in the query result cache. Each column is split into blocks of
+// `BLOCK_SIZE` rows, and for each block the smallest of the following
+// encodings is chosen:
+// 1. `Delta`: For a sorted block, the differences between consecutive `Id`s
+//    are bit-packed.
+// 2. `Dictionary`: For a block with few distinct `Id`s, the sorted distinct
+//    `Id`s are stored once, and the indices into this dictionary are
+//    bit-packed.
+// 3. `FrameOfReference`: The differences to the smallest `Id` of the block are
+//    bit-packed (the `Id`s of a block often have the same datatype and similar
+//    values, so the differences require much less than 64 bits).
+// 4. `Raw`: The `Id`s are stored uncompressed.
+class CompressedIdTable {
+ public:
+  using Allocator = ad_utility::AllocatorWithLimit<Id>;
+  static constexpr size_t BLOCK_SIZE = 1 << 16;
+
+  enum class Encoding : uint8_t { Raw, Delta, Dictionary, FrameOfReference };
+
+  // A single block of a single column.
+  struct Block {
+    Encoding encoding_ = Encoding::Raw;
+    size_t numRows_ = 0;
+    uint8_t numBits_ = 0;
+    // The first `Id` (for `Delta`) or the smallest `Id` (for
+    // `FrameOfReference`) of the block.
+    uint64_t base_ = 0;
+    // The distinct `Id`s of the block (only for `Dictionary`).
+    std::vector<uint64_t> dictionary_;
+    // The bit-packed values (or the raw bits of the `Id`s for `Raw`).
+    std::vector<uint64_t> packed_;
+  };
+
+ private:
+  size_t numRows_ = 0;
+  size_t numColumns_ = 0;
+  // The blocks of the first column, followed by the blocks of the second
+  // column, etc.
+  std::vector<Block> blocks_;
+  Allocator allocator_;
+
+ public:
+  // Compress the `idTable`. The `allocator` of the `idTable` is also used by
+  // `decompress`.
+  explicit CompressedIdTable(const IdTable& idTable);
+
+  size_t numRows() const { return numRows_; }
+  size_t numColumns() const { return numColumns_; }
+
+  // The memory that is required by the compressed representation.
+  ad_utility::MemorySize size() const;
+
+  // Return the uncompressed `IdTable`.
+  IdTable decompress() const;
+
+  // Access the blocks for testing.
+  const std::vector<Block>& blocksForTesting() const { return blocks_; }
+
+ private:
+  static Block compressBlock(ql::span<const Id> ids);
+  static void decompressBlock(const Block& block, ql::span<Id> target);
+};
+
+#endif  // QLEVER_SRC_ENGINE_IDTABLE_COMPRESSEDIDTABLE_H
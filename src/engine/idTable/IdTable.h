@@ -612,6 +612,21 @@ class IdTable {
         std::move(viewSpans), columnIndices.size(), numRows_, allocator_};
   }
 
+  // Obtain a dynamic and const view to the rows `[beginRow, endRow)` of this
+  // IdTable (with all the columns).
+  CPP_template(typename = void)(requires isDynamic)
+      IdTable<T, 0, ColumnStorage, IsView::True> asRowRangeView(
+          size_t beginRow, size_t endRow) const {
+    AD_CONTRACT_CHECK(beginRow <= endRow && endRow <= numRows());
+    ViewSpans viewSpans;
+    viewSpans.reserve(numColumns());
+    for (auto idx : ad_utility::integerRange(numColumns())) {
+      viewSpans.push_back(getColumn(idx).subspan(beginRow, endRow - beginRow));
+    }
+    return IdTable<T, 0, ColumnStorage, IsView::True>{
+        std::move(viewSpans), numColumns_, endRow - beginRow, allocator_};
+  }
+
   // Modify the table, such that it contains only the specified `subset` of the
   // original columns in the specified order. Each index in the `subset`
   // must be `< numColumns()` and must appear at most once in the subset.
@@ -782,8 +797,7 @@ class IdTable {
   // this IdTable. The order of the inserted rows is the same as in `indices`.
   // The `table` must be some kind of `IdTable`.
   template <typename Table>
-  void insertSubsetAtEnd(const Table& table,
-                         const std::vector<size_t>& indices) {
+  void insertSubsetAtEnd(const Table& table, ql::span<const size_t> indices) {
     AD_CORRECTNESS_CHECK(table.numColumns() == numColumns());
     const size_t numInserted = indices.size();
     if (numInserted == 0) return;
@@ -0,0 +1,128 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/sparqlExpressions/ApproxCountDistinctExpression.h"
+
+#include <absl/hash/hash.h>
+#include <absl/strings/str_cat.h>
+
+#include <cmath>
+
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "util/OverloadCallOperator.h"
+
+namespace sparqlExpression {
+
+namespace detail {
+
+// _____________________________________________________________________________
+void DistinctCountSketch::add(const IdOrLocalVocabEntry& value) {
+  // The hash of an `Id` with datatype `LocalVocabIndex` depends on the contents
+  // of the entry, so a `LocalVocabEntry` is hashed via such an `Id`.
+  auto id = std::visit(
+      ad_utility::OverloadCallOperator{
+          [](const Id& id) { return id; },
+          [](const LocalVocabEntry& entry) {
+            return Id::makeFromLocalVocabIndex(&entry);
+          }},
+      value);
+  if (id.isUndefined()) {
+    return;
+  }
+  addHash(absl::HashOf(id));
+}
+
+// _____________________________________________________________________________
+void DistinctCountSketch::addHash(uint64_t hash) {
+  if (sketch_ != nullptr) {
+    sketch_->add(hash);
+    return;
+  }
+  exactHashes_.insert(hash);
+  if (exactHashes_.size() > maxNumExactHashes) {
+    sketch_ = ad_utility::make_copyable_unique<Sketch>();
+    for (uint64_t exactHash : exactHashes_) {
+      sketch_->add(exactHash);
+    }
+    exactHashes_ = {};
+  }
+}
+
+// _____________________________________________________________________________
+void DistinctCountSketch::mergeWith(const DistinctCountSketch& other) {
+  if (other.sketch_ == nullptr) {
+    for (uint64_t hash : other.exactHashes_) {
+      addHash(hash);
+    }
+    return;
+  }
+  if (sketch_ == nullptr) {
+    sketch_ = ad_utility::make_copyable_unique<Sketch>(*other.sketch_);
+    for (uint64_t hash : exactHashes_) {
+      sketch_->add(hash);
+    }
+    exactHashes_ = {};
+  } else {
+    sketch_->merge(*other.sketch_);
+  }
+}
+
+// _____________________________________________________________________________
+int64_t DistinctCountSketch::estimate() const {
+  if (sketch_ == nullptr) {
+    return static_cast<int64_t>(exactHashes_.size());
+  }
+  return std::llround(sketch_->estimate());
+}
+
+}  // namespace detail
+
+// _____________________________________________________________________________
+ApproxCountDistinctExpression::ApproxCountDistinctExpression(bool,
+                                                             Ptr&& child)
+    : child_{std::move(child)} {
+  setIsInsideAggregate();
+}
+
+// _____________________________________________________________________________
+ExpressionResult ApproxCountDistinctExpression::evaluate(
+    EvaluationContext* context) const {
+  auto impl = [context](auto&& el)
+      -> CPP_ret(ExpressionResult)(
+          requires SingleExpressionResult<decltype(el)>) {
+    detail::DistinctCountSketch sketch;
+    auto generator =
+        detail::makeGenerator(AD_FWD(el), context->size(), context);
+    size_t i = 0;
+    for (const auto& value : generator) {
+      sketch.add(value);
+      if (++i % 10'000 == 0) {
+        context->cancellationHandle_->throwIfCancelled();
+      }
+    }
+    return Id::makeFromInt(sketch.estimate());
+  };
+  return std::visit(impl, child_->evaluate(context));
+}
+
+// _____________________________________________________________________________
+std::string ApproxCountDistinctExpression::getCacheKey(
+    const VariableToColumnMap& varColMap) const {
+  return absl::StrCat("[ APPROX_COUNT_DISTINCT ]",
+                      child_->getCacheKey(varColMap));
+}
+
+// _____________________________________________________________________________
+SparqlExpression::Ptr makeApproxCountDistinctExpression(
+    SparqlExpression::Ptr child) {
+  return std::make_unique<ApproxCountDistinctExpression>(false,
+                                                         std::move(child));
+}
+
+}  // namespace sparqlExpression
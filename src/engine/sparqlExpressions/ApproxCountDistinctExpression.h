@@ -0,0 +1,100 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_APPROXCOUNTDISTINCTEXPRESSION_H
+#define QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_APPROXCOUNTDISTINCTEXPRESSION_H
+
+#include <cstdint>
+#include <string>
+
+#include "engine/sparqlExpressions/SparqlExpression.h"
+#include "util/CopyableUniquePtr.h"
+#include "util/HashSet.h"
+#include "util/HyperLogLog.h"
+
+namespace sparqlExpression {
+
+namespace detail {
+// Estimate the number of distinct values that have been added. The first
+// `maxNumExactHashes` distinct values are stored exactly (by their hashes), so
+// the count of small groups is exact and cheap. Afterwards, a HyperLogLog
+// sketch with 16 KiB is used, the relative standard error of which is below
+// 1%.
+class DistinctCountSketch {
+ public:
+  using Sketch = ad_utility::BasicHyperLogLog<14>;
+  static constexpr size_t maxNumExactHashes = 512;
+
+ private:
+  ad_utility::HashSet<uint64_t> exactHashes_;
+  ad_utility::CopyableUniquePtr<Sketch> sketch_;
+
+ public:
+  // Add the `value`. UNDEF values are ignored (like for `COUNT(DISTINCT)`).
+  // Equal values are counted once, also if one of them is an `Id` and the
+  // other one a `LocalVocabEntry`, or if they are from different local
+  // vocabs.
+  void add(const IdOrLocalVocabEntry& value);
+
+  // Merge the `other` sketch into this one.
+  void mergeWith(const DistinctCountSketch& other);
+
+  // The estimated number of distinct values, rounded to an integer.
+  int64_t estimate() const;
+
+  // True iff `estimate()` is the exact number of distinct values.
+  bool isExact() const { return sketch_ == nullptr; }
+
+ private:
+  void addHash(uint64_t hash);
+};
+}  // namespace detail
+
+// The `ql:approxCountDistinct(?x)` aggregate, which estimates
+// `COUNT(DISTINCT ?x)` with a `DistinctCountSketch`. This requires much less
+// memory and time than the exact computation for large groups, at the cost of
+// a relative error of about 1% (see `relativeStandardError`).
+class ApproxCountDistinctExpression : public SparqlExpression {
+ private:
+  Ptr child_;
+
+ public:
+  // The first parameter is the `DISTINCT` bool that is always there on the
+  // constructor for all aggregate expressions. The values are always
+  // deduplicated, so it is ignored.
+  ApproxCountDistinctExpression(bool, Ptr&& child);
+
+  ExpressionResult evaluate(EvaluationContext* context) const override;
+
+  // The relative standard error of the estimate for large groups.
+  static double relativeStandardError() {
+    return detail::DistinctCountSketch::Sketch::relativeStandardError();
+  }
+
+  // The deduplication is done by the sketch, so we return "not distinct",
+  // which allows for the hash map optimization in GROUP BY.
+  AggregateStatus isAggregate() const override {
+    return AggregateStatus::NonDistinctAggregate;
+  }
+
+  [[nodiscard]] std::string getCacheKey(
+      const VariableToColumnMap& varColMap) const override;
+
+ private:
+  // ___________________________________________________________________________
+  ql::span<Ptr> childrenImpl() override { return {&child_, 1}; }
+};
+
+// Create an `ApproxCountDistinctExpression` (used by the parser).
+SparqlExpression::Ptr makeApproxCountDistinctExpression(
+    SparqlExpression::Ptr child);
+
+}  // namespace sparqlExpression
+
+#endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_APPROXCOUNTDISTINCTEXPRESSION_H
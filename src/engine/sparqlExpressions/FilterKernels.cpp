@@ -0,0 +1,356 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#include "engine/sparqlExpressions/FilterKernels.h"
+
+#include <typeindex>
+
+#include "backports/algorithm.h"
+#include "engine/sparqlExpressions/LiteralExpression.h"
+#include "engine/sparqlExpressions/NaryExpression.h"
+#include "engine/sparqlExpressions/RelationalExpressionHelpers.h"
+#include "engine/sparqlExpressions/RelationalExpressions.h"
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "util/ConstexprUtils.h"
+#include "util/ValueIdentity.h"
+
+namespace sparqlExpression {
+
+namespace {
+
+using valueIdComparators::Comparison;
+using Condition = FilterKernel::Condition;
+using Selection = FilterKernel::Selection;
+
+// The cancellation is checked whenever this many rows have been processed.
+constexpr size_t CANCELLATION_CHECK_INTERVAL = 1 << 16;
+
+// The types of the `&&`, `BOUND`, and `isIRI` expressions are hidden in their
+// respective `.cpp` files, so we compare the type of an expression to the type
+// of a dummy expression that is created by the same factory function (as it
+// is also done in `ConditionalExpressions.cpp`).
+std::type_index typeOf(const SparqlExpression::Ptr& expression) {
+  const SparqlExpression& expressionRef = *expression;
+  return typeid(expressionRef);
+}
+
+SparqlExpression::Ptr makeDummyVariable() {
+  return std::make_unique<VariableExpression>(Variable{"?dummy"});
+}
+
+struct ExpressionTypes {
+  std::type_index and_;
+  std::type_index bound_;
+  std::type_index isIri_;
+};
+
+const ExpressionTypes& getExpressionTypes() {
+  static const ExpressionTypes types{
+      typeOf(makeAndExpression(makeDummyVariable(), makeDummyVariable())),
+      typeOf(makeBoundExpression(makeDummyVariable())),
+      typeOf(makeIsIriExpression(makeDummyVariable()))};
+  return types;
+}
+
+// Return the comparison if the `expression` is a `RelationalExpression`.
+std::optional<Comparison> getComparison(const SparqlExpression& expression) {
+  using enum Comparison;
+  if (dynamic_cast<const LessThanExpression*>(&expression)) {
+    return LT;
+  } else if (dynamic_cast<const LessEqualExpression*>(&expression)) {
+    return LE;
+  } else if (dynamic_cast<const EqualExpression*>(&expression)) {
+    return EQ;
+  } else if (dynamic_cast<const NotEqualExpression*>(&expression)) {
+    return NE;
+  } else if (dynamic_cast<const GreaterEqualExpression*>(&expression)) {
+    return GE;
+  } else if (dynamic_cast<const GreaterThanExpression*>(&expression)) {
+    return GT;
+  }
+  return std::nullopt;
+}
+
+// Return the variable if the only child of the `expression` is a variable.
+std::optional<Variable> getVariableOfOnlyChild(
+    const SparqlExpression& expression) {
+  auto children = expression.children();
+  if (children.size() != 1) {
+    return std::nullopt;
+  }
+  return children[0]->getVariableOrNullopt();
+}
+
+// Return the content of the `expression` if it is a string literal without a
+// language tag and without a datatype.
+std::optional<std::string> getPlainStringLiteral(
+    const SparqlExpression* expression) {
+  const auto* literal =
+      dynamic_cast<const StringLiteralExpression*>(expression);
+  if (!literal || literal->value().hasLanguageTag() ||
+      literal->value().hasDatatype()) {
+    return std::nullopt;
+  }
+  return std::string{asStringViewUnsafe(literal->value().getContent())};
+}
+
+// Append the conditions of the `expression` to the `conditions`. Return false
+// if the `expression` is not a conjunction of supported conditions.
+bool addConditions(const SparqlExpression& expression,
+                   std::vector<Condition>& conditions) {
+  const auto& types = getExpressionTypes();
+  std::type_index type = typeid(expression);
+  if (type == types.and_) {
+    return ql::ranges::all_of(
+        expression.children(), [&conditions](const auto& child) {
+          return addConditions(*child, conditions);
+        });
+  }
+  if (type == types.bound_ || type == types.isIri_) {
+    auto variable = getVariableOfOnlyChild(expression);
+    if (!variable.has_value()) {
+      return false;
+    }
+    if (type == types.bound_) {
+      conditions.emplace_back(FilterKernel::IsBound{std::move(*variable)});
+    } else {
+      conditions.emplace_back(FilterKernel::IsIri{std::move(*variable)});
+    }
+    return true;
+  }
+
+  auto comparison = getComparison(expression);
+  if (!comparison.has_value()) {
+    return false;
+  }
+  auto children = expression.children();
+  AD_CORRECTNESS_CHECK(children.size() == 2);
+  const SparqlExpression* left = children[0].get();
+  const SparqlExpression* right = children[1].get();
+  auto leftVariable = left->getVariableOrNullopt();
+  auto rightVariable = right->getVariableOrNullopt();
+  if (leftVariable.has_value() && rightVariable.has_value()) {
+    conditions.emplace_back(FilterKernel::CompareVariables{
+        comparison.value(), std::move(*leftVariable),
+        std::move(*rightVariable)});
+    return true;
+  }
+  if (leftVariable.has_value() && right->isConstantExpression()) {
+    conditions.emplace_back(FilterKernel::CompareWithConstant{
+        comparison.value(), std::move(*leftVariable), right});
+    return true;
+  }
+  if (rightVariable.has_value() && left->isConstantExpression()) {
+    conditions.emplace_back(FilterKernel::CompareWithConstant{
+        getComparisonForSwappedArguments(comparison.value()),
+        std::move(*rightVariable), left});
+    return true;
+  }
+
+  // `LANG(?x) = "en"` or `"en" = LANG(?x)`.
+  if (comparison.value() != Comparison::EQ) {
+    return false;
+  }
+  for (auto [lang, literal] :
+       {std::pair{left, right}, std::pair{right, left}}) {
+    auto variable = getVariableFromLangExpression(lang);
+    auto language = getPlainStringLiteral(literal);
+    if (variable.has_value() && language.has_value()) {
+      conditions.emplace_back(FilterKernel::LanguageEquals{
+          std::move(*variable), std::move(*language)});
+      return true;
+    }
+  }
+  return false;
+}
+
+// Return the `Id` of the `result` of a constant expression, or `std::nullopt`
+// if it is neither an `Id` nor a string. The `Id` of a string that is not
+// contained in the vocabulary refers to the `result`, which thus has to
+// outlive the `Id`.
+std::optional<Id> getConstantId(const ExpressionResult& result,
+                                const EvaluationContext* context) {
+  if (const auto* id = std::get_if<Id>(&result)) {
+    return *id;
+  } else if (const auto* value = std::get_if<IdOrLocalVocabEntry>(&result)) {
+    return makeValueId(*value, context);
+  }
+  return std::nullopt;
+}
+
+// Call `function(comparison)`, where the `comparison` is passed as a
+// compile-time constant (`ValueIdentity`), s.t. the comparison is resolved at
+// compile time in the inner loops.
+template <typename Function>
+void callWithConstexprComparison(Comparison comparison,
+                                 const Function& function) {
+  using enum Comparison;
+  ad_utility::ConstexprSwitch<LT, LE, EQ, NE, GE, GT>{}(
+      ad_utility::ApplyAsValueIdentity{function}, comparison);
+}
+
+// Return true iff `a <Comp> b` is true (the result is false for `Id`s of
+// incompatible types, like in the generic evaluation of the
+// `RelationalExpression`s).
+template <Comparison Comp>
+bool compareIsTrue(Id a, Id b) {
+  using namespace valueIdComparators;
+  return compareIds<ComparisonForIncompatibleTypes::AlwaysUndef>(a, b, Comp) ==
+         ComparisonResult::True;
+}
+
+// Keep only those rows of the `selection` for which `predicate(row)` is true.
+// For the first condition, the `selection` is empty and all the rows of the
+// `context` are considered.
+template <typename Predicate>
+void refineSelection(Selection& selection, bool isFirstCondition,
+                     const EvaluationContext* context,
+                     const Predicate& predicate) {
+  auto checkCancellation = [context](size_t i) {
+    if (i % CANCELLATION_CHECK_INTERVAL == 0) {
+      context->cancellationHandle_->throwIfCancelled();
+    }
+  };
+  if (isFirstCondition) {
+    AD_CORRECTNESS_CHECK(selection.empty());
+    for (size_t row = 0; row < context->size(); ++row) {
+      checkCancellation(row);
+      if (predicate(row)) {
+        selection.push_back(row);
+      }
+    }
+    return;
+  }
+  size_t numSelected = 0;
+  for (size_t i = 0; i < selection.size(); ++i) {
+    checkCancellation(i);
+    size_t row = selection[i];
+    if (predicate(row)) {
+      selection[numSelected++] = row;
+    }
+  }
+  selection.resize(numSelected);
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<FilterKernel> FilterKernel::fromExpression(
+    const SparqlExpression& expression) {
+  std::vector<Condition> conditions;
+  if (!addConditions(expression, conditions)) {
+    return std::nullopt;
+  }
+  return FilterKernel{std::move(conditions)};
+}
+
+// _____________________________________________________________________________
+std::optional<FilterKernel::Selection> FilterKernel::computeSelection(
+    EvaluationContext* context) const {
+  if (conditions_.size() == 1) {
+    if (const auto* comparison =
+            std::get_if<CompareWithConstant>(&conditions_.front());
+        comparison && context->isResultSortedBy(comparison->variable_)) {
+      return std::nullopt;
+    }
+  }
+  auto isBound = [context](const Variable& variable) {
+    return context->getColumnIndexForVariable(variable).has_value();
+  };
+
+  // First check that the kernel can be used for all the conditions and
+  // evaluate the constants. The results are stored in `constantResults`
+  // (which is never reallocated), because the `Id`s in `constants` may refer
+  // to them.
+  std::vector<ExpressionResult> constantResults;
+  constantResults.reserve(conditions_.size());
+  std::vector<Id> constants;
+  for (const auto& condition : conditions_) {
+    bool isSupported = std::visit(
+        [&](const auto& cond) {
+          using T = std::decay_t<decltype(cond)>;
+          if constexpr (std::is_same_v<T, CompareVariables>) {
+            constants.push_back(Id::makeUndefined());
+            return isBound(cond.left_) && isBound(cond.right_);
+          } else if constexpr (std::is_same_v<T, CompareWithConstant>) {
+            if (!isBound(cond.variable_)) {
+              return false;
+            }
+            constantResults.push_back(cond.constant_->evaluate(context));
+            auto id = getConstantId(constantResults.back(), context);
+            constants.push_back(id.value_or(Id::makeUndefined()));
+            return id.has_value();
+          } else {
+            constants.push_back(Id::makeUndefined());
+            return isBound(cond.variable_);
+          }
+        },
+        condition);
+    if (!isSupported) {
+      return std::nullopt;
+    }
+  }
+
+  // Then refine the selection condition by condition.
+  Selection selection{context->_allocator};
+  for (size_t i = 0; i < conditions_.size(); ++i) {
+    auto refine = [&selection, isFirst = i == 0, context](const auto& pred) {
+      refineSelection(selection, isFirst, context, pred);
+    };
+    auto getColumn = [context](const Variable& variable) {
+      return detail::getIdsFromVariable(variable, context);
+    };
+    auto applyCondition = [&](const auto& cond) {
+      using T = std::decay_t<decltype(cond)>;
+      if constexpr (std::is_same_v<T, CompareWithConstant>) {
+        callWithConstexprComparison(
+            cond.comparison_, [&, column = getColumn(cond.variable_),
+                               constant = constants[i]](auto comparison) {
+              constexpr Comparison comp = decltype(comparison)::value;
+              refine([column, constant](size_t row) {
+                return compareIsTrue<comp>(column[row], constant);
+              });
+            });
+      } else if constexpr (std::is_same_v<T, CompareVariables>) {
+        callWithConstexprComparison(
+            cond.comparison_,
+            [&, left = getColumn(cond.left_),
+             right = getColumn(cond.right_)](auto comparison) {
+              constexpr Comparison comp = decltype(comparison)::value;
+              refine([left, right](size_t row) {
+                return compareIsTrue<comp>(left[row], right[row]);
+              });
+            });
+      } else if constexpr (std::is_same_v<T, IsBound>) {
+        refine([column = getColumn(cond.variable_)](size_t row) {
+          return column[row] != Id::makeUndefined();
+        });
+      } else if constexpr (std::is_same_v<T, IsIri>) {
+        refine([column = getColumn(cond.variable_), context](size_t row) {
+          Id id = column[row];
+          switch (id.getDatatype()) {
+            case Datatype::VocabIndex:
+            case Datatype::LocalVocabIndex:
+            case Datatype::EncodedVal:
+              return detail::IsIriValueGetter{}(id, context) ==
+                     Id::makeFromBool(true);
+            default:
+              return false;
+          }
+        });
+      } else {
+        static_assert(std::is_same_v<T, LanguageEquals>);
+        refine([column = getColumn(cond.variable_), context,
+                &language = cond.language_](size_t row) {
+          auto tag = detail::LanguageTagValueGetter{}(column[row], context);
+          return tag.has_value() && tag.value() == language;
+        });
+      }
+    };
+    std::visit(applyCondition, conditions_[i]);
+  }
+  return selection;
+}
+
+}  // namespace sparqlExpression
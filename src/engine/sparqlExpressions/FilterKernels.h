@@ -0,0 +1,98 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_FILTERKERNELS_H
+#define QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_FILTERKERNELS_H
+
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "engine/sparqlExpressions/SparqlExpression.h"
+#include "global/ValueIdComparators.h"
+
+namespace sparqlExpression {
+
+// Specialized implementations ("kernels") for the most common shapes of
+// `FILTER` expressions, namely conjunctions (`&&`) of
+//   * `?x <op> constant` (and `constant <op> ?x`), where `<op>` is one of the
+//     six relational operators,
+//   * `?x <op> ?y`,
+//   * `BOUND(?x)`,
+//   * `isIRI(?x)`,
+//   * `LANG(?x) = "language"`.
+// Instead of materializing the (boolean) result of each subexpression and
+// then evaluating the conjunction, each condition is checked directly on the
+// column of its variable, and the indices of the rows that pass all the
+// conditions so far (the "selection") are refined condition by condition. The
+// conditions are monomorphized (e.g. the comparison is a template parameter
+// of the inner loop), and the later conditions only touch the rows that
+// passed the earlier ones. The result is always the same as the one of the
+// generic evaluation of the expression.
+class FilterKernel {
+ public:
+  using Comparison = valueIdComparators::Comparison;
+
+  // `?variable <comparison> constant`. `constant_` points into the expression
+  // from which the kernel was created, and is evaluated when the kernel is
+  // applied.
+  struct CompareWithConstant {
+    Comparison comparison_;
+    Variable variable_;
+    const SparqlExpression* constant_;
+  };
+  // `?left <comparison> ?right`.
+  struct CompareVariables {
+    Comparison comparison_;
+    Variable left_;
+    Variable right_;
+  };
+  // `BOUND(?variable)`.
+  struct IsBound {
+    Variable variable_;
+  };
+  // `isIRI(?variable)`.
+  struct IsIri {
+    Variable variable_;
+  };
+  // `LANG(?variable) = "language"`.
+  struct LanguageEquals {
+    Variable variable_;
+    std::string language_;
+  };
+  using Condition = std::variant<CompareWithConstant, CompareVariables,
+                                 IsBound, IsIri, LanguageEquals>;
+
+  // The indices of the selected rows (relative to the `_beginIndex` of the
+  // `EvaluationContext`), in ascending order.
+  using Selection = std::vector<size_t, ad_utility::AllocatorWithLimit<size_t>>;
+
+ private:
+  std::vector<Condition> conditions_;
+
+  explicit FilterKernel(std::vector<Condition> conditions)
+      : conditions_{std::move(conditions)} {}
+
+ public:
+  // Return the kernel for the `expression`, or `std::nullopt` if the
+  // `expression` is not a conjunction of the shapes listed above. The
+  // `expression` must outlive the returned kernel.
+  static std::optional<FilterKernel> fromExpression(
+      const SparqlExpression& expression);
+
+  // Return the rows of the input of the `context` that pass the filter. If
+  // the kernel can't be used for this particular input, `std::nullopt` is
+  // returned and the expression has to be evaluated the usual way. This is
+  // the case if one of the variables is not bound, if one of the constants
+  // is not a single `Id` or string, or if the expression consists of a
+  // single comparison with the column by which the input is sorted (which is
+  // evaluated even more efficiently using binary search).
+  std::optional<Selection> computeSelection(EvaluationContext* context) const;
+
+  const std::vector<Condition>& conditions() const { return conditions_; }
+};
+
+}  // namespace sparqlExpression
+
+#endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_FILTERKERNELS_H
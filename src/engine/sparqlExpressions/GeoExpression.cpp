@@ -267,11 +267,17 @@ std::optional<GeoFunctionCall> getGeoFunctionExpressionParameters(
   return std::nullopt;
 }
 
-// _____________________________________________________________________________
-std::optional<GeoDistanceCall> getGeoDistanceExpressionParameters(
+// The two geometry arguments of a distance function and the unit of
+// measurement of the distance.
+using DistanceArguments =
+    std::tuple<const SparqlExpression*, const SparqlExpression*,
+               UnitOfMeasurement>;
+
+// If the `expr` is a call to one of the distance functions (with a fixed unit
+// of measurement), return its arguments, else `std::nullopt`.
+static std::optional<DistanceArguments> getDistanceArguments(
     const SparqlExpression& expr) {
   using namespace ad_utility::use_type_identity;
-  using DistArgs = std::tuple<Variable, Variable, UnitOfMeasurement>;
 
   // Helper lambda to extract a unit of measurement from a SparqlExpression (IRI
   // or literal with xsd:anyURI datatype)
@@ -294,9 +300,9 @@ std::optional<GeoDistanceCall> getGeoDistanceExpressionParameters(
     return std::nullopt;
   };
 
-  // Helper lambda to extract the variables and the distance unit from a
+  // Helper lambda to extract the arguments and the distance unit from a
   // distance function call
-  auto extractArguments = [&](auto ti) -> std::optional<DistArgs> {
+  auto extractArguments = [&](auto ti) -> std::optional<DistanceArguments> {
     // Check if the argument is a distance function expression
     using T = typename decltype(ti)::type;
     auto distExpr = dynamic_cast<const T*>(&expr);
@@ -304,16 +310,6 @@ std::optional<GeoDistanceCall> getGeoDistanceExpressionParameters(
       return std::nullopt;
     }
 
-    // Extract variables
-    auto p1 = distExpr->children()[0]->getVariableOrNullopt();
-    if (!p1.has_value()) {
-      return std::nullopt;
-    }
-    auto p2 = distExpr->children()[1]->getVariableOrNullopt();
-    if (!p2.has_value()) {
-      return std::nullopt;
-    }
-
     // Extract unit
     auto unit = UnitOfMeasurement::KILOMETERS;
     if constexpr (std::is_same_v<T, MetricDistExpression>) {
@@ -327,23 +323,74 @@ std::optional<GeoDistanceCall> getGeoDistanceExpressionParameters(
       unit = unitOrNullopt.value();
     }
 
-    return DistArgs{p1.value(), p2.value(), unit};
+    return DistanceArguments{distExpr->children()[0].get(),
+                             distExpr->children()[1].get(), unit};
   };
 
   // Try all possible distance expression types
-  auto distVars = extractArguments(ti<DistExpression>);
-  if (!distVars.has_value()) {
-    distVars = extractArguments(ti<MetricDistExpression>);
+  auto distArgs = extractArguments(ti<DistExpression>);
+  if (!distArgs.has_value()) {
+    distArgs = extractArguments(ti<MetricDistExpression>);
+  }
+  if (!distArgs.has_value()) {
+    distArgs = extractArguments(ti<DistWithUnitExpression>);
+  }
+  return distArgs;
+}
+
+// _____________________________________________________________________________
+std::optional<GeoDistanceCall> getGeoDistanceExpressionParameters(
+    const SparqlExpression& expr) {
+  auto distArgs = getDistanceArguments(expr);
+  if (!distArgs.has_value()) {
+    return std::nullopt;
+  }
+  const auto& [arg1, arg2, unit] = distArgs.value();
+
+  // Extract variables
+  auto p1 = arg1->getVariableOrNullopt();
+  if (!p1.has_value()) {
+    return std::nullopt;
+  }
+  auto p2 = arg2->getVariableOrNullopt();
+  if (!p2.has_value()) {
+    return std::nullopt;
+  }
+
+  return GeoDistanceCall{
+      {SpatialJoinType::WITHIN_DIST, p1.value(), p2.value()}, unit};
+}
+
+// _____________________________________________________________________________
+std::optional<GeoDistanceToPoint> getGeoDistanceToConstantPoint(
+    const SparqlExpression& expr) {
+  auto distArgs = getDistanceArguments(expr);
+  if (!distArgs.has_value()) {
+    return std::nullopt;
   }
-  if (!distVars.has_value()) {
-    distVars = extractArguments(ti<DistWithUnitExpression>);
+  auto [arg1, arg2, unit] = distArgs.value();
+
+  // The distance is symmetric, so the variable can be either argument.
+  if (!arg1->getVariableOrNullopt().has_value()) {
+    std::swap(arg1, arg2);
   }
-  if (!distVars.has_value()) {
+  auto variable = arg1->getVariableOrNullopt();
+  const auto* pointExpr = dynamic_cast<const IdExpression*>(arg2);
+  if (!variable.has_value() || pointExpr == nullptr ||
+      pointExpr->value().getDatatype() != Datatype::GeoPoint) {
     return std::nullopt;
   }
+  return GeoDistanceToPoint{variable.value(), pointExpr->value().getGeoPoint(),
+                            unit};
+}
 
-  const auto& [v1, v2, unit] = distVars.value();
-  return GeoDistanceCall{{SpatialJoinType::WITHIN_DIST, v1, v2}, unit};
+// _____________________________________________________________________________
+std::optional<Variable> getVariableFromLatitudeExpression(
+    const SparqlExpression& expr) {
+  if (dynamic_cast<const LatitudeExpression*>(&expr) == nullptr) {
+    return std::nullopt;
+  }
+  return expr.children()[0]->getVariableOrNullopt();
 }
 
 }  // namespace sparqlExpression
@@ -0,0 +1,116 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_GROUPCONCATBUILDER_H
+#define QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_GROUPCONCATBUILDER_H
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "backports/span.h"
+#include "rdfTypes/Literal.h"
+
+namespace sparqlExpression::detail {
+
+// Incrementally build the result of a `GROUP_CONCAT`. The contents are
+// directly appended to the internal representation of the resulting literal
+// (see `Literal::fromStringRepresentation`), s.t. `finish` can move the
+// buffer into the literal without copying the (possibly very long) result.
+class GroupConcatBuilder {
+ private:
+  using Literal = ad_utility::triple_component::Literal;
+  // The opening quote followed by the contents that have been appended so far.
+  std::string representation_{"\""};
+  bool empty_ = true;
+  bool undefined_ = false;
+
+ public:
+  // Return true iff one of the appended values was undefined, in which case
+  // the result is undefined.
+  bool isUndefined() const { return undefined_; }
+  // Return true iff no value has been appended yet.
+  bool isEmpty() const { return empty_; }
+
+  // Append the content of the `literal`, preceded by the `separator` if it is
+  // not the first value. Return false iff the result is undefined afterward.
+  bool append(const std::optional<Literal>& literal,
+              std::string_view separator) {
+    appendSeparator(separator);
+    if (!literal.has_value()) {
+      undefined_ = true;
+      return false;
+    }
+    representation_.append(asStringViewUnsafe(literal.value().getContent()));
+    return !undefined_;
+  }
+
+  // Append the contents of `other` (which must have been built from a later
+  // part of the input).
+  void append(GroupConcatBuilder&& other, std::string_view separator) {
+    if (other.empty_ || undefined_) {
+      return;
+    }
+    if (empty_) {
+      *this = std::move(other);
+      return;
+    }
+    appendSeparator(separator);
+    undefined_ |= other.undefined_;
+    representation_.append(std::string_view{other.representation_}.substr(1));
+  }
+
+  // Ensure that the `literals` (and the separators between them) can be
+  // appended without reallocation. The capacity grows at least geometrically,
+  // s.t. repeated calls for small batches stay cheap.
+  void reserveFor(ql::span<const std::optional<Literal>> literals,
+                  std::string_view separator) {
+    size_t required = representation_.size();
+    for (const auto& literal : literals) {
+      required += separator.size();
+      if (literal.has_value()) {
+        required += literal.value().getContent().size();
+      }
+    }
+    if (required > representation_.capacity()) {
+      representation_.reserve(
+          std::max(required, 2 * representation_.capacity()));
+    }
+  }
+
+  // Return the resulting literal, or `std::nullopt` if it is undefined.
+  std::optional<Literal> finish() && {
+    if (undefined_) {
+      return std::nullopt;
+    }
+    representation_.push_back('"');
+    return Literal::fromStringRepresentation(std::move(representation_));
+  }
+
+  // Start again with an empty result.
+  void clear() {
+    representation_.resize(1);
+    empty_ = true;
+    undefined_ = false;
+  }
+
+ private:
+  void appendSeparator(std::string_view separator) {
+    if (empty_) {
+      empty_ = false;
+    } else {
+      representation_.append(separator);
+    }
+  }
+};
+
+}  // namespace sparqlExpression::detail
+
+#endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_GROUPCONCATBUILDER_H
@@ -6,6 +6,8 @@
 
 #include <absl/strings/str_cat.h>
 
+#include "engine/sparqlExpressions/GroupConcatBuilder.h"
+
 // __________________________________________________________________________
 sparqlExpression::GroupConcatExpression::GroupConcatExpression(
     bool distinct, Ptr&& child, std::string separator)
@@ -22,28 +24,46 @@ sparqlExpression::GroupConcatExpression::evaluate(
   auto impl = [this, context](auto&& el)
       -> CPP_ret(ExpressionResult)(
           requires SingleExpressionResult<decltype(el)>) {
-    bool undefined = false;
-    std::string result;
-    auto groupConcatImpl = [this, &result, context,
-                            &undefined](auto generator) {
-      // TODO<joka921> Make this a configurable constant.
-      result.reserve(20000);
-      bool firstIteration = true;
-      for (auto& inp : generator) {
-        auto literal = detail::LiteralValueGetterWithoutStrFunction{}(
-            std::move(inp), context);
-        if (firstIteration) {
-          firstIteration = false;
-        } else {
-          result.append(separator_);
+    detail::GroupConcatBuilder builder;
+    auto appendLiteral =
+        [this, &builder](
+            const std::optional<ad_utility::triple_component::Literal>&
+                literal) { return builder.append(literal, separator_); };
+    auto groupConcatImpl = [this, context, &appendLiteral,
+                            &builder](auto generator) {
+      using Value = ql::ranges::range_value_t<decltype(generator)>;
+      if constexpr (ad_utility::isSimilar<Value, Id>) {
+        // Convert the `Id`s in chunks, s.t. the words from the vocabulary are
+        // retrieved with one bulk lookup per chunk, and the result grows by
+        // (at least) the exact size of each chunk instead of a fixed guess.
+        std::vector<Id> chunk;
+        chunk.reserve(CHUNK_SIZE);
+        auto appendChunk = [this, &chunk, &appendLiteral, &builder,
+                            context]() {
+          auto literals =
+              detail::LiteralValueGetterWithoutStrFunction{}.getValues(chunk,
+                                                                       context);
+          chunk.clear();
+          context->cancellationHandle_->throwIfCancelled();
+          builder.reserveFor(literals, separator_);
+          return ql::ranges::all_of(literals, appendLiteral);
+        };
+        for (const Id& id : generator) {
+          chunk.push_back(id);
+          if (chunk.size() == CHUNK_SIZE && !appendChunk()) {
+            return;
+          }
         }
-        if (literal.has_value()) {
-          result.append(asStringViewUnsafe(literal.value().getContent()));
-        } else {
-          undefined = true;
-          return;
+        appendChunk();
+      } else {
+        for (auto& inp : generator) {
+          auto literal = detail::LiteralValueGetterWithoutStrFunction{}(
+              std::move(inp), context);
+          if (!appendLiteral(literal)) {
+            return;
+          }
+          context->cancellationHandle_->throwIfCancelled();
         }
-        context->cancellationHandle_->throwIfCancelled();
       }
     };
     auto generator =
@@ -55,11 +75,13 @@ sparqlExpression::GroupConcatExpression::evaluate(
     } else {
       groupConcatImpl(std::move(generator));
     }
-    if (undefined) {
+    // The result is moved into the `LocalVocabEntry` without copying it.
+    auto literal = std::move(builder).finish();
+    if (!literal.has_value()) {
       return Id::makeUndefined();
     }
-    return IdOrLocalVocabEntry{LocalVocabEntry::literalWithNormalizedContent(
-        asNormalizedStringViewUnsafe(result), context->getLocalVocabContext())};
+    return IdOrLocalVocabEntry{LocalVocabEntry{
+        std::move(literal.value()), context->getLocalVocabContext()}};
   };
 
   auto childRes = child_->evaluate(context);
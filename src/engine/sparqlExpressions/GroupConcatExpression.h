@@ -16,6 +16,9 @@ class GroupConcatExpression : public SparqlExpression {
   bool distinct_;
 
  public:
+  // The number of `Id`s that are converted to strings at once.
+  static constexpr size_t CHUNK_SIZE = 1024;
+
   GroupConcatExpression(bool distinct, Ptr&& child, std::string separator);
 
   ExpressionResult evaluate(EvaluationContext* context) const override;
@@ -161,6 +161,8 @@ SparqlExpression::Ptr makeConvertToDateExpression(SparqlExpression::Ptr child);
 
 // Implemented in RdfTermExpressions.cpp
 SparqlExpression::Ptr makeDatatypeExpression(SparqlExpression::Ptr child);
+std::optional<Variable> getVariableFromDatatypeExpression(
+    const SparqlExpression* child);
 
 // Implemented in LangExpression.cpp
 SparqlExpression::Ptr makeLangExpression(SparqlExpression::Ptr child);
@@ -3,13 +3,26 @@
 //  Author: Johannes Kalmbach <kalmbacj@cs.uni-freiburg.de>
 #include "engine/sparqlExpressions/NaryExpressionImpl.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "engine/sparqlExpressions/VectorizedExpressionHelpers.h"
 #include "global/RuntimeParameters.h"
 
 namespace sparqlExpression {
 namespace detail {
+// The arithmetic expressions below are evaluated by the columnar fast path
+// from `VectorizedExpressionHelpers.h` if both operands are columns or
+// constant `Id`s. The first argument of `VEC` is the function on the decoded
+// `int64_t` or `double` values.
+template <typename TypedFunction, typename ScalarFunction, typename ValueGetter>
+using VEC = SpecializedFunction<
+    vectorized::VectorizedBinaryFunction<TypedFunction, ScalarFunction,
+                                         ValueGetter>,
+    vectorized::AreAllIdColumnsOrConstants>;
+
 // Multiplication.
 using Multiply = MakeNumericExpression<std::multiplies<>>;
-NARY_EXPRESSION(MultiplyExpression, 2, FV<Multiply, NumericValueGetter>);
+NARY_EXPRESSION(MultiplyExpression, 2, FV<Multiply, NumericValueGetter>,
+                VEC<NumericIdWrapper<std::multiplies<>>, Multiply,
+                    NumericValueGetter>);
 
 // Division.
 //
@@ -30,11 +43,15 @@ struct DivideImpl {
 
 using Divide1 = MakeNumericExpression<DivideImpl, true>;
 NARY_EXPRESSION(DivideExpressionByZeroIsUndef, 2,
-                FV<Divide1, NumericValueGetter>);
+                FV<Divide1, NumericValueGetter>,
+                VEC<NumericIdWrapper<DivideImpl, true>, Divide1,
+                    NumericValueGetter>);
 
 using Divide2 = MakeNumericExpression<DivideImpl, false>;
 NARY_EXPRESSION(DivideExpressionByZeroIsNan, 2,
-                FV<Divide2, NumericValueGetter>);
+                FV<Divide2, NumericValueGetter>,
+                VEC<NumericIdWrapper<DivideImpl, false>, Divide2,
+                    NumericValueGetter>);
 
 // _____________________________________________________________________________
 // Addition.
@@ -74,7 +91,8 @@ struct AddImpl {
     return Id::makeUndefined();
   }
 };
-NARY_EXPRESSION(AddExpression, 2, FV<AddImpl, NumericOrDateValueGetter>);
+NARY_EXPRESSION(AddExpression, 2, FV<AddImpl, NumericOrDateValueGetter>,
+                VEC<AddImpl, AddImpl, NumericOrDateValueGetter>);
 
 // _____________________________________________________________________________
 // Subtraction.
@@ -115,7 +133,8 @@ struct SubtractImpl {
   }
 };
 NARY_EXPRESSION(SubtractExpression, 2,
-                FV<SubtractImpl, NumericOrDateValueGetter>);
+                FV<SubtractImpl, NumericOrDateValueGetter>,
+                VEC<SubtractImpl, SubtractImpl, NumericOrDateValueGetter>);
 
 // _____________________________________________________________________________
 // Power.
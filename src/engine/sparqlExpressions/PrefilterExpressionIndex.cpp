@@ -13,6 +13,9 @@
 
 #include <absl/functional/bind_front.h>
 
+#include <cmath>
+
+#include "global/Constants.h"
 #include "global/ValueIdComparators.h"
 #include "index/IndexImpl.h"
 #include "util/ConstexprMap.h"
@@ -406,6 +409,88 @@ BlockMetadataRanges PrefilterExpression::evaluate(
   return result;
 }
 
+//______________________________________________________________________________
+// Return pairs of `Id`s such that for each pair, both `Id`s have the same
+// datatype (or are both vocab/local vocab entries, which are sorted in mixed
+// order), and such that the union of all the pairs (interpreted as closed
+// intervals) covers all the values described by `stats`. Return `std::nullopt`
+// if no such pairs can be determined, because the column contains local vocab
+// entries together with other datatypes (we cannot synthesize the bounds of
+// `LocalVocabIndex` `Id`s).
+static std::optional<std::vector<std::pair<Id, Id>>>
+getSingleDatatypeBoundsFromStatistics(
+    const CompressedBlockMetadata::ColumnStatistics& stats) {
+  using enum Datatype;
+  auto isVocab = [](Datatype type) {
+    return ad_utility::contains(ValueId::stringTypes_, type);
+  };
+  auto minType = stats.min_.getDatatype();
+  auto maxType = stats.max_.getDatatype();
+  if (minType == maxType || (isVocab(minType) && isVocab(maxType))) {
+    return std::vector{std::pair{stats.min_, stats.max_}};
+  }
+  if (stats.containsDatatype(LocalVocabIndex)) {
+    return std::nullopt;
+  }
+  std::vector<std::pair<Id, Id>> result;
+  for (size_t i = 0; i <= static_cast<size_t>(Datatype::MaxValue); ++i) {
+    auto type = static_cast<Datatype>(i);
+    if (!stats.containsDatatype(type)) {
+      continue;
+    }
+    // The smallest and largest possible `Id`s for the `type`.
+    const auto typeBits = static_cast<uint64_t>(i) << ValueId::numDataBits;
+    Id lower = type == minType ? stats.min_ : Id::fromBits(typeBits);
+    Id upper = type == maxType
+                   ? stats.max_
+                   : Id::fromBits(typeBits | ValueId::maxIndex);
+    if (type == Undefined) {
+      lower = upper = Id::makeUndefined();
+    }
+    result.emplace_back(lower, upper);
+  }
+  return result;
+}
+
+//______________________________________________________________________________
+BlockMetadataRanges PrefilterExpression::evaluateWithColumnStatistics(
+    const LocalVocabContext& context, BlockMetadataSpan blockRange,
+    size_t evaluationColumn) const {
+  AD_CONTRACT_CHECK(evaluationColumn < 3);
+  AccessValueIdFromBlockMetadata accessValueIdOp(evaluationColumn);
+  // Return true iff the closed interval `[lower, upper]` of `Id`s possibly
+  // contains values that match this expression. For this purpose, we evaluate
+  // the expression on a single artificial block with these bounds.
+  auto isRelevant = [&](Id lower, Id upper) {
+    std::array<CompressedBlockMetadata, 1> artificialBlock;
+    auto& block = artificialBlock.front();
+    block.firstTriple_ = {lower, lower, lower, Id::makeUndefined()};
+    block.lastTriple_ = {upper, upper, upper, Id::makeUndefined()};
+    BlockMetadataSpan span{artificialBlock};
+    ValueIdSubrange idRange{ValueIdIt{&span, 0, accessValueIdOp},
+                            ValueIdIt{&span, 2, accessValueIdOp}};
+    return !evaluateImpl(context, idRange, span, false).empty();
+  };
+
+  BlockMetadataRanges result;
+  for (auto it = blockRange.begin(); it != blockRange.end(); ++it) {
+    const auto& statistics = it->columnStatistics_;
+    bool relevant = true;
+    if (statistics.has_value()) {
+      auto bounds = getSingleDatatypeBoundsFromStatistics(
+          statistics.value().at(evaluationColumn));
+      relevant = !bounds.has_value() ||
+                 ql::ranges::any_of(bounds.value(), [&](const auto& bound) {
+                   return isRelevant(bound.first, bound.second);
+                 });
+    }
+    if (relevant) {
+      detail::mergeBlockRangeWithRanges(result, {it, std::next(it)});
+    }
+  }
+  return result;
+}
+
 //______________________________________________________________________________
 ValueId PrefilterExpression::getValueIdFromIdOrLocalVocabEntry(
     const IdOrLocalVocabEntry& referenceValue, LocalVocab& vocab) {
@@ -501,6 +586,270 @@ BlockMetadataRanges PrefixRegexExpression::evaluateImpl(
       .evaluateImpl(context, idRange, blockRange, getTotalComplement);
 }
 
+// SECTION LATITUDE-RANGE
+
+//______________________________________________________________________________
+LatitudeRangeExpression::LatitudeRangeExpression(double minLatitude,
+                                                 double maxLatitude,
+                                                 bool isNegated)
+    : minLatitude_(minLatitude),
+      maxLatitude_(maxLatitude),
+      isNegated_(isNegated) {
+  AD_CONTRACT_CHECK(-90.0 <= minLatitude_ && minLatitude_ <= maxLatitude_ &&
+                    maxLatitude_ <= 90.0);
+}
+
+//______________________________________________________________________________
+double LatitudeRangeExpression::maxLatitudeDifference(double maxDistMeters) {
+  // Two points with a distance of at most `maxDist` meters differ in their
+  // latitude by at most `maxDist / earthRadius` (in radians). We use the polar
+  // radius (the smallest radius of the earth) and a margin of one percent plus
+  // the precision of the `GeoPoint` encoding to be on the safe side, no matter
+  // which approximation of the earth is used for computing the distances.
+  constexpr double polarRadiusMeters = 6'356'752.0;
+  return 1.01 * maxDistMeters / polarRadiusMeters * 180.0 / M_PI + 1e-6;
+}
+
+//______________________________________________________________________________
+std::unique_ptr<PrefilterExpression>
+LatitudeRangeExpression::logicalComplement() const {
+  return make<LatitudeRangeExpression>(minLatitude_, maxLatitude_, !isNegated_);
+}
+
+//______________________________________________________________________________
+bool LatitudeRangeExpression::operator==(
+    const PrefilterExpression& other) const {
+  const auto* otherLatitudeRange =
+      dynamic_cast<const LatitudeRangeExpression*>(&other);
+  if (!otherLatitudeRange) {
+    return false;
+  }
+  return isNegated_ == otherLatitudeRange->isNegated_ &&
+         minLatitude_ == otherLatitudeRange->minLatitude_ &&
+         maxLatitude_ == otherLatitudeRange->maxLatitude_;
+}
+
+//______________________________________________________________________________
+std::unique_ptr<PrefilterExpression> LatitudeRangeExpression::clone() const {
+  return make<LatitudeRangeExpression>(*this);
+}
+
+//______________________________________________________________________________
+std::string LatitudeRangeExpression::asString(
+    [[maybe_unused]] size_t depth) const {
+  return absl::StrCat(
+      "Prefilter LatitudeRangeExpression with range [", minLatitude_, ", ",
+      maxLatitude_,
+      "].\nExpression is negated: ", isNegated_ ? "true.\n" : "false.\n");
+}
+
+//______________________________________________________________________________
+BlockMetadataRanges LatitudeRangeExpression::evaluateImpl(
+    const LocalVocabContext& context, const ValueIdSubrange& idRange,
+    BlockMetadataSpan blockRange, bool getTotalComplement) const {
+  // The complement contains all the values that are neither literals nor
+  // `GeoPoint`s in the range. It can't be expressed via the datatype-specific
+  // `RelationalExpression`s, so all the blocks are considered relevant.
+  if (isNegated_) {
+    return {BlockMetadataRange{blockRange.begin(), blockRange.end()}};
+  }
+  // The `Id`s of `GeoPoint`s are ordered by their latitude first, so all the
+  // points with a latitude in the range lie between these two `Id`s.
+  auto lowerId = Id::makeFromGeoPoint(GeoPoint{minLatitude_, -180.0});
+  auto upperId = Id::makeFromGeoPoint(GeoPoint{maxLatitude_, 180.0});
+  // The literals from the (local) vocabulary precede all the IRIs.
+  LocalVocab localVocab{};
+  auto beginIdIri = getValueIdFromIdOrLocalVocabEntry(
+      LVE::fromStringRepresentation("<>", context), localVocab);
+  // Prefilter `lowerId <= ?var <= upperId || ?var < beginIdIri`.
+  return OrExpression(make<AndExpression>(make<GreaterEqualExpression>(lowerId),
+                                          make<LessEqualExpression>(upperId)),
+                      make<LessThanExpression>(beginIdIri))
+      .evaluateImpl(context, idRange, blockRange, getTotalComplement);
+}
+
+//______________________________________________________________________________
+static BlockMetadataRanges getRangesForDatatypes(const ValueIdSubrange& idRange,
+                                                 BlockMetadataSpan blockRange,
+                                                 const bool isNegated,
+                                                 ql::span<Datatype> datatypes);
+
+// Return the blocks that contain an `Id` from one of the (half-open)
+// `indexRanges` of the vocabulary or a local vocab entry within these ranges.
+static BlockMetadataRanges getRangesForVocabIndexRanges(
+    const LocalVocabContext& context, const ValueIdSubrange& idRange,
+    BlockMetadataSpan blockRange,
+    const std::vector<std::pair<VocabIndex, VocabIndex>>& indexRanges) {
+  BlockMetadataRanges result;
+  for (const auto& [begin, end] : indexRanges) {
+    // The upper bound is inclusive, because a local vocab entry that is larger
+    // than all the words in the range has the position `end`.
+    auto expression = make<AndExpression>(
+        make<GreaterEqualExpression>(Id::makeFromVocabIndex(begin)),
+        make<LessEqualExpression>(Id::makeFromVocabIndex(end)));
+    auto ranges =
+        expression->evaluateImpl(context, idRange, blockRange, false);
+    result = detail::logicalOps::mergeRelevantBlockItRanges<true>(result,
+                                                                  ranges);
+  }
+  return result;
+}
+
+// Return the blocks that contain a literal from the (local) vocabulary or an
+// `Id` of one of the `inlinedDatatypes`.
+static BlockMetadataRanges getRangesForLiterals(
+    const LocalVocabContext& context, const ValueIdSubrange& idRange,
+    BlockMetadataSpan blockRange, ql::span<Datatype> inlinedDatatypes) {
+  // The literals from the (local) vocabulary precede all the IRIs, except for
+  // those with a language tag if the vocabulary stores them separately.
+  auto nonInlinedRanges =
+      make<LessThanExpression>(LVE::fromStringRepresentation("<>", context))
+          ->evaluateImpl(context, idRange, blockRange, false);
+  if (auto languageRanges =
+          context.getVocab().getIndexRangesForLanguageTag("*");
+      languageRanges.has_value()) {
+    nonInlinedRanges = detail::logicalOps::mergeRelevantBlockItRanges<true>(
+        nonInlinedRanges,
+        getRangesForVocabIndexRanges(context, idRange, blockRange,
+                                     languageRanges.value()));
+  }
+  if (inlinedDatatypes.empty()) {
+    return nonInlinedRanges;
+  }
+  return detail::logicalOps::mergeRelevantBlockItRanges<true>(
+      getRangesForDatatypes(idRange, blockRange, false, inlinedDatatypes),
+      nonInlinedRanges);
+}
+
+// SECTION LANGUAGE-TAG
+
+//______________________________________________________________________________
+std::unique_ptr<PrefilterExpression> LanguageTagExpression::logicalComplement()
+    const {
+  return make<LanguageTagExpression>(language_, !isNegated_);
+}
+
+//______________________________________________________________________________
+bool LanguageTagExpression::operator==(const PrefilterExpression& other) const {
+  const auto* otherLanguageTag =
+      dynamic_cast<const LanguageTagExpression*>(&other);
+  if (!otherLanguageTag) {
+    return false;
+  }
+  return isNegated_ == otherLanguageTag->isNegated_ &&
+         language_ == otherLanguageTag->language_;
+}
+
+//______________________________________________________________________________
+std::unique_ptr<PrefilterExpression> LanguageTagExpression::clone() const {
+  return make<LanguageTagExpression>(*this);
+}
+
+//______________________________________________________________________________
+std::string LanguageTagExpression::asString(
+    [[maybe_unused]] size_t depth) const {
+  return absl::StrCat(
+      "Prefilter LanguageTagExpression with language \"", language_,
+      "\".\nExpression is negated: ", isNegated_ ? "true.\n" : "false.\n");
+}
+
+//______________________________________________________________________________
+BlockMetadataRanges LanguageTagExpression::evaluateImpl(
+    const LocalVocabContext& context, const ValueIdSubrange& idRange,
+    BlockMetadataSpan blockRange,
+    [[maybe_unused]] bool getTotalComplement) const {
+  // The complement also contains all the IRIs, blank nodes, etc. (for which
+  // the language tag is undefined, which can't be expressed via the prefilter
+  // `Id` ranges), as well as the literals with other language tags, which are
+  // interleaved with the ones with the `language_` in the vocabulary.
+  if (isNegated_) {
+    return {BlockMetadataRange{blockRange.begin(), blockRange.end()}};
+  }
+  // Literals with a language tag are never inlined into the `Id`. If the
+  // vocabulary stores them in partitions by their language tag, only the
+  // partitions for the `language_` are relevant, and `*` stands for all of
+  // them (as used for `LANGMATCHES`).
+  if (!language_.empty()) {
+    if (auto languageRanges =
+            context.getVocab().getIndexRangesForLanguageTag(language_);
+        languageRanges.has_value()) {
+      return getRangesForVocabIndexRanges(context, idRange, blockRange,
+                                          languageRanges.value());
+    }
+    return getRangesForLiterals(context, idRange, blockRange, {});
+  }
+  std::array datatypes{Datatype::Int, Datatype::Double, Datatype::Date,
+                       Datatype::Bool, Datatype::GeoPoint};
+  return getRangesForLiterals(context, idRange, blockRange, datatypes);
+}
+
+// SECTION DATATYPE
+
+//______________________________________________________________________________
+std::unique_ptr<PrefilterExpression> DatatypeExpression::logicalComplement()
+    const {
+  return make<DatatypeExpression>(datatypeIri_, !isNegated_);
+}
+
+//______________________________________________________________________________
+bool DatatypeExpression::operator==(const PrefilterExpression& other) const {
+  const auto* otherDatatype = dynamic_cast<const DatatypeExpression*>(&other);
+  if (!otherDatatype) {
+    return false;
+  }
+  return isNegated_ == otherDatatype->isNegated_ &&
+         datatypeIri_ == otherDatatype->datatypeIri_;
+}
+
+//______________________________________________________________________________
+std::unique_ptr<PrefilterExpression> DatatypeExpression::clone() const {
+  return make<DatatypeExpression>(*this);
+}
+
+//______________________________________________________________________________
+std::string DatatypeExpression::asString([[maybe_unused]] size_t depth) const {
+  return absl::StrCat(
+      "Prefilter DatatypeExpression with datatype <", datatypeIri_,
+      ">.\nExpression is negated: ", isNegated_ ? "true.\n" : "false.\n");
+}
+
+//______________________________________________________________________________
+std::vector<Datatype> DatatypeExpression::getInlinedDatatypes(
+    std::string_view datatypeIri) {
+  // This has to be consistent with the `DatatypeValueGetter`.
+  if (datatypeIri == XSD_INT_TYPE) {
+    return {Datatype::Int};
+  } else if (datatypeIri == XSD_DOUBLE_TYPE) {
+    return {Datatype::Double};
+  } else if (datatypeIri == XSD_BOOLEAN_TYPE) {
+    return {Datatype::Bool};
+  } else if (datatypeIri == GEO_WKT_LITERAL) {
+    return {Datatype::GeoPoint};
+  } else if (datatypeIri == XSD_DATE_TYPE || datatypeIri == XSD_DATETIME_TYPE ||
+             datatypeIri == XSD_GYEAR_TYPE ||
+             datatypeIri == XSD_GYEARMONTH_TYPE ||
+             datatypeIri == XSD_DAYTIME_DURATION_TYPE) {
+    return {Datatype::Date};
+  }
+  return {};
+}
+
+//______________________________________________________________________________
+BlockMetadataRanges DatatypeExpression::evaluateImpl(
+    const LocalVocabContext& context, const ValueIdSubrange& idRange,
+    BlockMetadataSpan blockRange,
+    [[maybe_unused]] bool getTotalComplement) const {
+  // The complement also contains all the IRIs, blank nodes, etc. (for which
+  // the datatype is undefined, which can't be expressed via the prefilter `Id`
+  // ranges), as well as the literals with other datatypes, which are
+  // interleaved with the ones with the `datatypeIri_` in the vocabulary.
+  if (isNegated_) {
+    return {BlockMetadataRange{blockRange.begin(), blockRange.end()}};
+  }
+  auto datatypes = getInlinedDatatypes(datatypeIri_);
+  return getRangesForLiterals(context, idRange, blockRange, datatypes);
+}
+
 // SECTION RELATIONAL OPERATIONS
 
 //______________________________________________________________________________
@@ -136,6 +136,16 @@ class PrefilterExpression {
                                BlockMetadataSpan blockRange,
                                size_t evaluationColumn) const;
 
+  // Prefilter the blocks from `blockRange` using their per-column statistics
+  // (see `CompressedBlockMetadataNoBlockIndex::columnStatistics_`) for column
+  // `evaluationColumn`. In contrast to `evaluate` above, the blocks don't have
+  // to be sorted by `evaluationColumn`, such that this can be used to
+  // prefilter on arbitrary columns of a scan. Blocks without statistics are
+  // always considered relevant.
+  BlockMetadataRanges evaluateWithColumnStatistics(
+      const LocalVocabContext& context, BlockMetadataSpan blockRange,
+      size_t evaluationColumn) const;
+
   // `evaluateImpl` is internally used for the actual pre-filter procedure.
   // `ValueIdSubrange idRange` enables indirect access to all `ValueId`s at
   // column index `evaluationColumn` over the containerized `ql::span<const
@@ -188,6 +198,106 @@ class PrefixRegexExpression : public PrefilterExpression {
                                    bool getTotalComplement) const override;
 };
 
+// `LatitudeRangeExpression` prefilters the blocks that possibly contain a
+// geometry within the latitude range `[minLatitude, maxLatitude]`. This is used
+// by the `SpatialJoin` to skip blocks of an `IndexScan` that can't contain a
+// join partner. The relevant blocks are those that contain a `GeoPoint` with a
+// latitude in the range or a literal from the (local) vocabulary, because the
+// latter might be a WKT literal of an arbitrary geometry. Note: The longitude
+// can't be used for prefiltering, because the `Id`s of `GeoPoint`s are sorted
+// by their latitude first. The negation of this expression considers all
+// blocks relevant.
+class LatitudeRangeExpression : public PrefilterExpression {
+ private:
+  double minLatitude_;
+  double maxLatitude_;
+  bool isNegated_;
+
+ public:
+  explicit LatitudeRangeExpression(double minLatitude, double maxLatitude,
+                                   bool isNegated = false);
+
+  // Return an upper bound (in degrees) for the difference of the latitudes of
+  // two points with a distance of at most `maxDistMeters`.
+  static double maxLatitudeDifference(double maxDistMeters);
+
+  std::unique_ptr<PrefilterExpression> logicalComplement() const override;
+  bool operator==(const PrefilterExpression& other) const override;
+  std::unique_ptr<PrefilterExpression> clone() const override;
+  std::string asString(size_t depth) const override;
+
+ private:
+  BlockMetadataRanges evaluateImpl(const LocalVocabContext& context,
+                                   const ValueIdSubrange& idRange,
+                                   BlockMetadataSpan blockRange,
+                                   bool getTotalComplement) const override;
+};
+
+// `LanguageTagExpression` prefilters the blocks that possibly contain a
+// literal with the language tag `language_` (`LANG(?var) = "en"`), where `*`
+// stands for any non-empty language tag (`LANGMATCHES(LANG(?var), "en")`).
+// The vocabulary orders the literals by their content and not by their
+// language tag, so the relevant blocks are those that contain a literal from
+// the (local) vocabulary, unless the vocabulary stores the literals in
+// partitions by their language tag (see `SplitLanguageVocabulary`), in which
+// case only the blocks with `Id`s from the matching partitions are relevant.
+// For the empty `language_` (literals without a language tag), the blocks with
+// inlined literals (numbers, dates, etc.) are relevant as well. The negation
+// of this expression considers all blocks relevant.
+class LanguageTagExpression : public PrefilterExpression {
+ private:
+  std::string language_;
+  bool isNegated_;
+
+ public:
+  explicit LanguageTagExpression(std::string language, bool isNegated = false)
+      : language_(std::move(language)), isNegated_(isNegated) {}
+
+  std::unique_ptr<PrefilterExpression> logicalComplement() const override;
+  bool operator==(const PrefilterExpression& other) const override;
+  std::unique_ptr<PrefilterExpression> clone() const override;
+  std::string asString(size_t depth) const override;
+
+ private:
+  BlockMetadataRanges evaluateImpl(const LocalVocabContext& context,
+                                   const ValueIdSubrange& idRange,
+                                   BlockMetadataSpan blockRange,
+                                   bool getTotalComplement) const override;
+};
+
+// `DatatypeExpression` prefilters the blocks that possibly contain a value for
+// which `DATATYPE(?var) = <datatypeIri_>` holds (the IRI is stored without
+// the angle brackets). The relevant blocks are those that contain a literal
+// from the (local) vocabulary, and those that contain an inlined value whose
+// datatype might be the `datatypeIri_` (e.g. `Datatype::Date` for `xsd:date`,
+// see `getInlinedDatatypes`). The negation of this expression considers all
+// blocks relevant.
+class DatatypeExpression : public PrefilterExpression {
+ private:
+  std::string datatypeIri_;
+  bool isNegated_;
+
+ public:
+  explicit DatatypeExpression(std::string datatypeIri, bool isNegated = false)
+      : datatypeIri_(std::move(datatypeIri)), isNegated_(isNegated) {}
+
+  std::unique_ptr<PrefilterExpression> logicalComplement() const override;
+  bool operator==(const PrefilterExpression& other) const override;
+  std::unique_ptr<PrefilterExpression> clone() const override;
+  std::string asString(size_t depth) const override;
+
+  // Return the datatypes of the inlined `Id`s the `DATATYPE` of which might be
+  // the `datatypeIri`.
+  static std::vector<Datatype> getInlinedDatatypes(
+      std::string_view datatypeIri);
+
+ private:
+  BlockMetadataRanges evaluateImpl(const LocalVocabContext& context,
+                                   const ValueIdSubrange& idRange,
+                                   BlockMetadataSpan blockRange,
+                                   bool getTotalComplement) const override;
+};
+
 // Helper struct for a compact class implementation regarding the logical
 // operations `AND` and `OR`. `NOT` is implemented separately given that the
 // expression is unary (single child expression).
@@ -215,6 +325,7 @@ class LogicalExpression : public PrefilterExpression {
   // Declare `PrefixRegexExpression` as a friend because its `evaluateImpl`
   // requires access to the `evaluateImpl` declared here.
   friend class PrefixRegexExpression;
+  friend class LatitudeRangeExpression;
   BlockMetadataRanges evaluateImpl(const LocalVocabContext& context,
                                    const ValueIdSubrange& idRange,
                                    BlockMetadataSpan blockRange,
@@ -7,6 +7,7 @@
 
 #include "engine/SpatialJoinConfig.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
+#include "rdfTypes/GeoPoint.h"
 #include "rdfTypes/Variable.h"
 #include "util/UnitOfMeasurement.h"
 
@@ -48,6 +49,25 @@ struct GeoDistanceCall : public GeoFunctionCall {
 std::optional<GeoDistanceCall> getGeoDistanceExpressionParameters(
     const SparqlExpression& expr);
 
+// Helper struct for `getGeoDistanceToConstantPoint`
+struct GeoDistanceToPoint {
+  Variable variable_;
+  GeoPoint point_;
+  UnitOfMeasurement unit_;
+};
+
+// If the `expr` is a distance function (see
+// `getGeoDistanceExpressionParameters`) between a variable and a constant
+// `POINT` (in any order), return the variable, the point, and the unit of the
+// distance. Also implemented in `GeoExpression.cpp`.
+std::optional<GeoDistanceToPoint> getGeoDistanceToConstantPoint(
+    const SparqlExpression& expr);
+
+// If the `expr` is `geof:latitude(?var)`, return `?var`. Also implemented in
+// `GeoExpression.cpp`.
+std::optional<Variable> getVariableFromLatitudeExpression(
+    const SparqlExpression& expr);
+
 }  // namespace sparqlExpression
 
 #endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_QUERYREWRITEEXPRESSIONHELPERS_H
@@ -28,4 +28,17 @@ Expr makeDatatypeExpression(Expr child) {
   return std::make_unique<GetDatatype>(std::move(child));
 }
 
+// Return the `Variable` if `expPtr` points to a `DATATYPE(?variable)`
+// expression, and `std::nullopt` otherwise.
+std::optional<Variable> getVariableFromDatatypeExpression(
+    const SparqlExpression* expPtr) {
+  const auto* datatypeExpr = dynamic_cast<const GetDatatype*>(expPtr);
+  if (!datatypeExpr) {
+    return std::nullopt;
+  }
+  auto children = datatypeExpr->children();
+  AD_CORRECTNESS_CHECK(children.size() == 1);
+  return children[0]->getVariableOrNullopt();
+}
+
 }  // namespace sparqlExpression
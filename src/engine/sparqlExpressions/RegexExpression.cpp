@@ -6,6 +6,7 @@
 
 #include "engine/sparqlExpressions/RegexExpression.h"
 
+#include <absl/strings/ascii.h>
 #include <re2/re2.h>
 
 #include "backports/StartsWithAndEndsWith.h"
@@ -15,7 +16,11 @@
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
 #include "engine/sparqlExpressions/StringExpressionsHelper.h"
+#include "global/RuntimeParameters.h"
 #include "global/ValueIdComparators.h"
+#include "util/HashMap.h"
+#include "util/ParallelExecutor.h"
+#include "util/ThreadBudget.h"
 
 using namespace std::literals;
 
@@ -81,8 +86,320 @@ struct RegexImpl {
   }
 };
 
-using RegexExpression =
-    string_expressions::StringExpressionImpl<2, RegexImpl, RegexValueGetter>;
+// Return the position of the `]` that closes the character class which starts
+// at `regex[pos]`, or `std::string_view::npos` if there is none.
+static size_t findEndOfCharacterClass(std::string_view regex, size_t pos) {
+  size_t i = pos + 1;
+  // A `]` directly at the beginning (also after a `^`) is a literal.
+  if (i < regex.size() && regex[i] == '^') {
+    ++i;
+  }
+  if (i < regex.size() && regex[i] == ']') {
+    ++i;
+  }
+  while (i < regex.size()) {
+    if (regex[i] == '\\') {
+      i += 2;
+    } else if (regex.substr(i, 2) == "[:") {
+      // A named class like `[:alpha:]` inside of the character class.
+      auto end = regex.find(":]", i + 2);
+      if (end == std::string_view::npos) {
+        return end;
+      }
+      i = end + 2;
+    } else if (regex[i] == ']') {
+      return i;
+    } else {
+      ++i;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// Return the position of the `)` that closes the group which starts at
+// `regex[pos]`, or `std::string_view::npos` if there is none.
+static size_t findEndOfGroup(std::string_view regex, size_t pos) {
+  size_t depth = 0;
+  size_t i = pos;
+  while (i < regex.size()) {
+    char c = regex[i];
+    if (c == '\\') {
+      i += 2;
+      continue;
+    }
+    if (c == '[') {
+      i = findEndOfCharacterClass(regex, i);
+      if (i == std::string_view::npos) {
+        return i;
+      }
+    } else if (c == '(') {
+      ++depth;
+    } else if (c == ')' && --depth == 0) {
+      return i;
+    }
+    ++i;
+  }
+  return std::string_view::npos;
+}
+
+// _____________________________________________________________________________
+std::optional<std::string> getRequiredLiteral(std::string_view regex) {
+  // The flags of `REGEX` are passed to RE2 as a group `(?flags:regex)` around
+  // the complete regex, which can be removed if the flags don't make the match
+  // case-insensitive.
+  if (ql::starts_with(regex, "(?") &&
+      findEndOfGroup(regex, 0) == regex.size() - 1) {
+    auto colon = regex.find(':');
+    if (colon != std::string_view::npos &&
+        regex.substr(2, colon - 2).find_first_not_of("msU") ==
+            std::string_view::npos) {
+      return getRequiredLiteral(
+          regex.substr(colon + 1, regex.size() - colon - 2));
+    }
+  }
+
+  // The regex is split into runs of literal characters, the longest run is
+  // returned. Everything that is not a plain literal (groups, character
+  // classes, quantifiers, ...) ends the current run.
+  std::string current;
+  std::string longest;
+  auto endRun = [&current, &longest]() {
+    if (current.size() > longest.size()) {
+      longest = current;
+    }
+    current.clear();
+  };
+  // Remove the last (possibly multi-byte UTF-8) character from the current
+  // run, because a quantifier makes it optional.
+  auto removeLastCharacter = [&current]() {
+    while (!current.empty() &&
+           (static_cast<unsigned char>(current.back()) & 0xC0) == 0x80) {
+      current.pop_back();
+    }
+    if (!current.empty()) {
+      current.pop_back();
+    }
+  };
+
+  size_t i = 0;
+  while (i < regex.size()) {
+    char c = regex[i];
+    if (c == '\\') {
+      if (i + 1 == regex.size()) {
+        return std::nullopt;
+      }
+      char escaped = regex[i + 1];
+      i += 2;
+      if (!absl::ascii_isalnum(static_cast<unsigned char>(escaped))) {
+        current.push_back(escaped);
+        continue;
+      }
+      // Escapes like `\d` match a single character that is not known, but
+      // escapes like `\x41`, `\pL`, or `\Q...\E` have arguments that must not
+      // be read as literals.
+      if (std::string_view{"dDwWsSbBAz"}.find(escaped) ==
+          std::string_view::npos) {
+        return std::nullopt;
+      }
+      endRun();
+      continue;
+    }
+    switch (c) {
+      case '(': {
+        auto end = findEndOfGroup(regex, i);
+        if (end == std::string_view::npos) {
+          return std::nullopt;
+        }
+        // Flags like `(?i)` also apply to the rest of the regex.
+        if (regex.substr(i, 2) == "(?" &&
+            regex.substr(i, regex.find_first_of(":)", i) - i).find('i') !=
+                std::string_view::npos) {
+          return std::nullopt;
+        }
+        endRun();
+        i = end + 1;
+        continue;
+      }
+      case '[': {
+        auto end = findEndOfCharacterClass(regex, i);
+        if (end == std::string_view::npos) {
+          return std::nullopt;
+        }
+        endRun();
+        i = end + 1;
+        continue;
+      }
+      case '|':
+        // Each alternative has its own literals.
+        return std::nullopt;
+      case '*':
+      case '?':
+        removeLastCharacter();
+        endRun();
+        break;
+      case '{': {
+        removeLastCharacter();
+        endRun();
+        auto end = regex.find('}', i);
+        if (end == std::string_view::npos) {
+          return std::nullopt;
+        }
+        i = end + 1;
+        continue;
+      }
+      case '+':
+      case '.':
+      case '^':
+      case '$':
+        endRun();
+        break;
+      default:
+        current.push_back(c);
+    }
+    ++i;
+  }
+  endRun();
+  if (longest.empty()) {
+    return std::nullopt;
+  }
+  return longest;
+}
+
+// A `REGEX` with a constant regex on the values of a variable. The regex is
+// matched only once per distinct `Id` of the variable, and strings which don't
+// contain the required literal of the regex (see `getRequiredLiteral`) are
+// rejected by a plain substring search before running RE2 (literals from the
+// vocabulary are even rejected without decoding them if there is a
+// `VocabularyNgramIndex`). If there are many distinct `Id`s, they are matched
+// in parallel.
+template <typename StringGetter>
+struct RegexOnDistinctIds {
+  static constexpr size_t minNumDistinctIdsPerThread = 10'000;
+
+  CPP_template(typename Regex)(requires isConstantResult<Regex>)
+      ExpressionResult
+      operator()(EvaluationContext* context, const ::Variable& variable,
+                 const Regex& regex) const {
+    VectorWithMemoryLimit<Id> result{context->_allocator};
+    result.resize(context->size(), Id::makeUndefined());
+    std::shared_ptr<RE2> pattern = RegexValueGetter{}(regex, context);
+    if (!pattern || !pattern->ok()) {
+      return result;
+    }
+    auto ids = getIdsFromVariable(variable, context);
+    ad_utility::HashMap<Id, size_t> indexOfId;
+    std::vector<Id> distinctIds;
+    for (size_t i = 0; i < ids.size(); ++i) {
+      if (i > 0 && ids[i] == ids[i - 1]) {
+        continue;
+      }
+      if (indexOfId.try_emplace(ids[i], distinctIds.size()).second) {
+        distinctIds.push_back(ids[i]);
+      }
+    }
+
+    const auto literal = getRequiredLiteral(pattern->pattern());
+    std::optional<string_expressions::SubstringPrefilter> prefilter;
+    if (literal.has_value()) {
+      constexpr bool literalsWithDatatypeAreUndefined =
+          ad_utility::isSimilar<StringGetter, LiteralFromIdGetter>;
+      prefilter.emplace(context, literal.value(),
+                        literalsWithDatatypeAreUndefined);
+    }
+    std::vector<Id> matches(distinctIds.size());
+    auto matchRange = [&](size_t begin, size_t end) {
+      context->cancellationHandle_->throwIfCancelled();
+      for (size_t i = begin; i < end; ++i) {
+        if (prefilter.has_value()) {
+          if (auto match = prefilter->getResultIfNotACandidate(distinctIds[i]);
+              match.has_value()) {
+            matches[i] = match.value();
+            continue;
+          }
+        }
+        auto string = StringGetter{}(distinctIds[i], context);
+        if (string.has_value() && literal.has_value() &&
+            std::string_view{string.value()}.find(literal.value()) ==
+                std::string_view::npos) {
+          matches[i] = Id::makeFromBool(false);
+        } else {
+          matches[i] = RegexImpl{}(string, pattern);
+        }
+      }
+    };
+    auto threads = ad_utility::globalThreadBudget().reserve(
+        std::min(getRuntimeParameter<&RuntimeParameters::regexNumThreads_>(),
+                 distinctIds.size() / minNumDistinctIdsPerThread));
+    const size_t numThreads = threads.numThreads();
+    if (numThreads == 1) {
+      matchRange(0, distinctIds.size());
+    } else {
+      std::vector<std::packaged_task<void()>> tasks;
+      for (size_t t = 0; t < numThreads; ++t) {
+        tasks.emplace_back([&matchRange, &distinctIds, numThreads, t]() {
+          matchRange(distinctIds.size() * t / numThreads,
+                     distinctIds.size() * (t + 1) / numThreads);
+        });
+      }
+      ad_utility::runTasksInParallel(std::move(tasks));
+    }
+    context->cancellationHandle_->throwIfCancelled();
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+      result[i] = i > 0 && ids[i] == ids[i - 1]
+                      ? result[i - 1]
+                      : matches[indexOfId.at(ids[i])];
+    }
+    return result;
+  }
+};
+
+// The check for the `RegexOnDistinctIds`.
+struct IsVariableAndConstant {
+  template <typename String, typename Regex>
+  constexpr bool operator()(const String&, const Regex&) const {
+    return ad_utility::isSimilar<String, ::Variable> &&
+           isConstantResult<Regex>;
+  }
+};
+
+template <typename StringGetter>
+using RegexOnStrings =
+    NARY<2, FV<RegexImpl, StringGetter, RegexValueGetter>,
+         SpecializedFunction<RegexOnDistinctIds<StringGetter>,
+                             IsVariableAndConstant>>;
+
+// The general `REGEX` expression. As for the expressions from
+// `StringExpressionsHelper.h`, a `STR()` around the first argument is
+// replaced by the `StringValueGetter`.
+class RegexExpression : public SparqlExpression {
+ private:
+  Ptr impl_;
+
+ public:
+  RegexExpression(Ptr child, Ptr regex) {
+    AD_CORRECTNESS_CHECK(child != nullptr);
+    if (child->isStrExpression()) {
+      auto childrenOfStr = std::move(*child).moveChildrenOut();
+      AD_CORRECTNESS_CHECK(childrenOfStr.size() == 1);
+      impl_ = std::make_unique<RegexOnStrings<StringValueGetter>>(
+          std::move(childrenOfStr.at(0)), std::move(regex));
+    } else {
+      impl_ = std::make_unique<RegexOnStrings<LiteralFromIdGetter>>(
+          std::move(child), std::move(regex));
+    }
+  }
+
+  ExpressionResult evaluate(EvaluationContext* context) const override {
+    return impl_->evaluate(context);
+  }
+  std::string getCacheKey(const VariableToColumnMap& varColMap) const override {
+    return impl_->getCacheKey(varColMap);
+  }
+
+ private:
+  ql::span<Ptr> childrenImpl() override { return impl_->children(); }
+};
 
 }  // namespace sparqlExpression::detail
 
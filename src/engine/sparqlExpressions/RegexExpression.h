@@ -8,7 +8,9 @@
 #include <gtest/gtest_prod.h>
 #include <re2/re2.h>
 
+#include <optional>
 #include <string>
+#include <string_view>
 
 #include "engine/sparqlExpressions/SparqlExpression.h"
 
@@ -77,6 +79,16 @@ class PrefixRegexExpression : public SparqlExpression {
   FRIEND_TEST(RegexExpression, makePrefixMatchExpression);
 };
 
+namespace detail {
+// Return the longest string that is contained in every string that matches the
+// `regex` (as a partial match with RE2), or `std::nullopt` if no such string
+// is found. The analysis is conservative: Regexes with alternatives at the
+// top level, case-insensitive matching, or unusual escapes have no required
+// literal. This is used to reject most of the non-matching strings of a
+// `REGEX` by a cheap substring search instead of running RE2.
+std::optional<std::string> getRequiredLiteral(std::string_view regex);
+}  // namespace detail
+
 SparqlExpression::Ptr makeRegexExpression(SparqlExpression::Ptr string,
                                           SparqlExpression::Ptr regex,
                                           SparqlExpression::Ptr flags);
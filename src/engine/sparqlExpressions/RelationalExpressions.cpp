@@ -10,6 +10,7 @@
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/RelationalExpressionHelpers.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "engine/sparqlExpressions/VectorizedExpressionHelpers.h"
 #include "util/GeoSparqlHelpers.h"
 #include "util/LambdaHelpers.h"
 #include "util/TypeTraits.h"
@@ -131,8 +132,6 @@ CPP_template(Comparison Comp, typename S1, typename S2)(
       sparqlExpression::detail::getResultSize(*context, value1, value2);
   constexpr static bool resultIsConstant =
       (isConstantResult<S1> && isConstantResult<S2>);
-  VectorWithMemoryLimit<Id> result{context->_allocator};
-  result.reserve(resultSize);
 
   // TODO<joka921> Make this simpler by factoring out the whole binary search
   // stuff.
@@ -168,6 +167,32 @@ CPP_template(Comparison Comp, typename S1, typename S2)(
     }
   }
 
+  // If both operands are columns or constant `Id`s (e.g. `?x * 2 > ?y`), use
+  // the columnar fast path, which compares the decoded numeric values in
+  // batches. The `idFunction` is the same comparison that is performed by the
+  // generic loop below.
+  if constexpr (sparqlExpression::detail::vectorized::IdColumnOrConstant<
+                    std::decay_t<S1>> &&
+                sparqlExpression::detail::vectorized::IdColumnOrConstant<
+                    std::decay_t<S2>> &&
+                !resultIsConstant) {
+    namespace vectorized = sparqlExpression::detail::vectorized;
+    auto typedFunction = [](auto x, auto y) {
+      return Id::makeFromBool(applyComparison<Comp>(x, y));
+    };
+    auto idFunction = [](Id x, Id y) {
+      return toValueId(valueIdComparators::compareIds<
+                       valueIdComparators::ComparisonForIncompatibleTypes::
+                           AlwaysUndef>(x, y, Comp));
+    };
+    return vectorized::evaluateOnIdsInBatches(
+        vectorized::makeIdSequence(value1, context),
+        vectorized::makeIdSequence(value2, context), resultSize, context,
+        typedFunction, idFunction);
+  }
+
+  VectorWithMemoryLimit<Id> result{context->_allocator};
+  result.reserve(resultSize);
   auto [generatorA, generatorB] =
       getGenerators(AD_FWD(value1), AD_FWD(value2), resultSize, context);
   auto itA = generatorA.begin();
@@ -441,6 +466,110 @@ static std::optional<std::pair<Variable, bool>> getOptVariableAndIsYear(
   return std::nullopt;
 }
 
+// _____________________________________________________________________________
+// If `child0` is `LANG(?var)` and `child1` a string literal, or `child0` is
+// `DATATYPE(?var)` and `child1` an IRI, return the `LanguageTagExpression`
+// or `DatatypeExpression` for `?var` that prefilters `child0 = child1`.
+static std::vector<PrefilterExprVariablePair>
+getLanguageTagOrDatatypePrefilter(const SparqlExpression* child0,
+                                  const SparqlExpression* child1) {
+  std::vector<PrefilterExprVariablePair> prefilterVec;
+  if (auto optVar = getVariableFromLangExpression(child0); optVar) {
+    if (const auto* langPtr =
+            dynamic_cast<const StringLiteralExpression*>(child1)) {
+      prefilterVec.emplace_back(
+          std::make_unique<prefilterExpressions::LanguageTagExpression>(
+              std::string{asStringViewUnsafe(langPtr->value().getContent())}),
+          std::move(optVar.value()));
+    }
+  } else if (auto optVar = getVariableFromDatatypeExpression(child0); optVar) {
+    if (const auto* iriPtr = dynamic_cast<const IriExpression*>(child1)) {
+      prefilterVec.emplace_back(
+          std::make_unique<prefilterExpressions::DatatypeExpression>(
+              std::string{asStringViewUnsafe(iriPtr->value().getContent())}),
+          std::move(optVar.value()));
+    }
+  }
+  return prefilterVec;
+}
+
+// _____________________________________________________________________________
+// If `child0 comp child1` (or `child1 comp child0` if `reversed`) restricts the
+// latitude of a `GeoPoint` variable to a range, return the corresponding
+// `LatitudeRangeExpression`. This is the case if `child1` is a numeric
+// constant and `child0` is either `geof:latitude(?var)`, or the distance (see
+// `getGeoDistanceToConstantPoint`) between `?var` and a constant point which
+// has to be at most `child1`. The `Id`s of `GeoPoint`s are sorted by their
+// latitude, so the prefilter turns such a `FILTER` into a scan of only the
+// blocks in the corresponding range.
+template <Comparison comp>
+static std::vector<PrefilterExprVariablePair> getLatitudeRangePrefilter(
+    const SparqlExpression* child0, const SparqlExpression* child1,
+    bool reversed) {
+  const auto* constantExpr = dynamic_cast<const IdExpression*>(child1);
+  if (constantExpr == nullptr) {
+    return {};
+  }
+  auto constant = constantExpr->value();
+  if (constant.getDatatype() != Datatype::Int &&
+      constant.getDatatype() != Datatype::Double) {
+    return {};
+  }
+  double value = constant.getDatatype() == Datatype::Int
+                     ? static_cast<double>(constant.getInt())
+                     : constant.getDouble();
+  if (std::isnan(value)) {
+    return {};
+  }
+  Comparison effectiveComp =
+      reversed ? getComparisonForSwappedArguments(comp) : comp;
+  if (effectiveComp == Comparison::NE) {
+    return {};
+  }
+
+  // A margin for the precision of the `GeoPoint` encoding.
+  constexpr double epsilon = 1e-6;
+  double minLat = -90.0;
+  double maxLat = 90.0;
+  std::optional<Variable> variable;
+  if (auto latitudeVariable = getVariableFromLatitudeExpression(*child0)) {
+    variable = std::move(latitudeVariable);
+    if (effectiveComp != Comparison::GT && effectiveComp != Comparison::GE) {
+      maxLat = value + epsilon;
+    }
+    if (effectiveComp != Comparison::LT && effectiveComp != Comparison::LE) {
+      minLat = value - epsilon;
+    }
+  } else if (auto distance = getGeoDistanceToConstantPoint(*child0)) {
+    // Only an upper bound for the distance restricts the latitude.
+    if (effectiveComp == Comparison::GT || effectiveComp == Comparison::GE) {
+      return {};
+    }
+    double maxDistMeters =
+        ad_utility::detail::valueInUnitToKilometer(value, distance->unit_) *
+        1000;
+    double extension =
+        prefilterExpressions::LatitudeRangeExpression::maxLatitudeDifference(
+            std::max(maxDistMeters, 0.0));
+    variable = std::move(distance->variable_);
+    minLat = distance->point_.getLat() - extension;
+    maxLat = distance->point_.getLat() + extension;
+  } else {
+    return {};
+  }
+  minLat = std::clamp(minLat, -90.0, 90.0);
+  maxLat = std::clamp(maxLat, -90.0, 90.0);
+  if (minLat == -90.0 && maxLat == 90.0) {
+    return {};
+  }
+  std::vector<PrefilterExprVariablePair> prefilterVec;
+  prefilterVec.emplace_back(
+      std::make_unique<prefilterExpressions::LatitudeRangeExpression>(minLat,
+                                                                      maxLat),
+      std::move(variable.value()));
+  return prefilterVec;
+}
+
 // _____________________________________________________________________________
 template <Comparison comp>
 std::vector<PrefilterExprVariablePair>
@@ -463,6 +592,27 @@ RelationalExpression<comp>::getPrefilterExpressionForMetadata(
     return prefilterExpressions::detail::makePrefilterExpressionVec<comp>(
         optReferenceValue.value(), variable, reversed, prefilterDate);
   };
+  // `LANG(?x) = "en"` and `DATATYPE(?x) = xsd:date` (in both directions). For
+  // `!=`, all blocks would be relevant, so no prefilter is created.
+  if constexpr (comp == Comparison::EQ) {
+    auto prefilterVec = getLanguageTagOrDatatypePrefilter(child0, child1);
+    if (prefilterVec.empty()) {
+      prefilterVec = getLanguageTagOrDatatypePrefilter(child1, child0);
+    }
+    if (!prefilterVec.empty()) {
+      return prefilterVec;
+    }
+  }
+  // `geof:latitude(?x) < 50` and `geof:distance(?x, POINT(...)) <= 10` (in
+  // both directions).
+  auto latitudePrefilter =
+      getLatitudeRangePrefilter<comp>(child0, child1, false);
+  if (latitudePrefilter.empty()) {
+    latitudePrefilter = getLatitudeRangePrefilter<comp>(child1, child0, true);
+  }
+  if (!latitudePrefilter.empty()) {
+    return latitudePrefilter;
+  }
   // Option 1:
   // RelationalExpression containing a VariableExpression as the first child
   // and an IdExpression, IdExpression or IriExpression as the second child.
@@ -299,9 +299,13 @@ CPP_template(typename Operation, typename... Operands)(requires(
 }
 
 // Return a lambda that takes a `LocalVocabEntry` and converts it to an `Id` by
-// adding it to the `localVocab`.
+// adding it to the `localVocab`. Short literals that can be encoded directly
+// into an `Id` are not added to the `localVocab`.
 inline auto makeStringResultGetter(LocalVocab* localVocab) {
   return [localVocab](const LocalVocabEntry& entry) {
+    if (auto encoded = entry.encodedShortLiteral(); encoded.has_value()) {
+      return ValueId::fromBits(encoded.value().get());
+    }
     auto localVocabIndex = localVocab->getIndexAndAddIfNotContained(entry);
     return ValueId::makeFromLocalVocabIndex(localVocabIndex);
   };
@@ -309,15 +309,20 @@ struct SpecializedFunction {
   }
 
   // Evaluate the function on the `operands`. Return std::nullopt if the
-  // function cannot be evaluated on the `operands`
+  // function cannot be evaluated on the `operands`. Functions that need the
+  // `context` (for example to access the input table) take it as their first
+  // argument.
   template <typename... Operands>
   std::optional<ExpressionResult> evaluateIfOperandsAreValid(
-      Operands&&... operands) {
+      EvaluationContext* context, Operands&&... operands) {
     if (!areAllOperandsValid<Operands...>(operands...)) {
       return std::nullopt;
     } else {
       if constexpr (ql::concepts::invocable<Function, Operands&&...>) {
         return Function{}(std::forward<Operands>(operands)...);
+      } else if constexpr (ql::concepts::invocable<Function, EvaluationContext*,
+                                                   Operands&&...>) {
+        return Function{}(context, std::forward<Operands>(operands)...);
       } else {
         AD_FAIL();
       }
@@ -341,13 +346,14 @@ constexpr bool isAnySpecializedFunctionPossible(SpecializedFunctionsTuple&& tup,
 /// function exists, return `std::nullopt`.
 template <typename SpecializedFunctionsTuple, typename... Operands>
 std::optional<ExpressionResult> evaluateOnSpecializedFunctionsIfPossible(
-    SpecializedFunctionsTuple&& tup, Operands&&... operands) {
+    SpecializedFunctionsTuple&& tup, EvaluationContext* context,
+    Operands&&... operands) {
   std::optional<ExpressionResult> result = std::nullopt;
 
   auto writeToResult = [&](auto f) {
     if (!result) {
-      result =
-          f.evaluateIfOperandsAreValid(std::forward<Operands>(operands)...);
+      result = f.evaluateIfOperandsAreValid(
+          context, std::forward<Operands>(operands)...);
     }
   };
 
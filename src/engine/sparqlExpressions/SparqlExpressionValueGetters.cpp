@@ -90,9 +90,15 @@ auto EffectiveBooleanValueGetter::operator()(
     case Datatype::Undefined:
     case Datatype::BlankNodeIndex:
       return Undef;
-    case Datatype::EncodedVal:
-      // This assumes that we never use this for empty IRIs.
+    case Datatype::EncodedVal: {
+      // This assumes that we never use this for empty IRIs. Encoded short
+      // literals can be empty.
+      const auto& manager = context->_qec.getIndex().encodedIriManager();
+      if (manager.isShortLiteral(id)) {
+        return manager.toString(id).size() > 2 ? True : False;
+      }
       return True;
+    }
     case Datatype::VocabIndex: {
       auto index = id.getVocabIndex();
       // TODO<joka921> We could precompute whether the empty literal or empty
@@ -134,7 +140,8 @@ std::optional<std::string> StringValueGetter::operator()(
   }
   // `true` means that we remove the quotes and angle brackets.
   auto optionalStringAndType = ql::exportIds::idToStringAndType<true>(
-      context->_qec.getIndex(), id, context->_localVocab);
+      context->_qec.getIndex(), id, context->_localVocab, ql::identity{},
+      &context->_qec.vocabDecodeCache());
   if (optionalStringAndType.has_value()) {
     return std::move(optionalStringAndType.value().first);
   } else {
@@ -147,7 +154,8 @@ std::optional<ad_utility::triple_component::Literal>
 LiteralValueGetterWithStrFunction::operator()(
     Id id, const EvaluationContext* context) const {
   return ql::exportIds::idToLiteral(context->_qec.getIndex(), id,
-                                    context->_localVocab);
+                                    context->_localVocab, false,
+                                    &context->_qec.vocabDecodeCache());
 }
 
 // ____________________________________________________________________________
@@ -157,12 +165,22 @@ LiteralValueGetterWithStrFunction::operator()(const LiteralOrIri& s,
   return ql::exportIds::handleIriOrLiteral(s, false);
 }
 
+// ____________________________________________________________________________
+auto LiteralValueGetterWithStrFunction::getValues(
+    ql::span<const ValueId> ids, const EvaluationContext* context) const
+    -> std::vector<Value> {
+  return ql::exportIds::idsToLiterals(context->_qec.getIndex(), ids,
+                                      context->_localVocab, false,
+                                      &context->_qec.vocabDecodeCache());
+}
+
 // ____________________________________________________________________________
 std::optional<ad_utility::triple_component::Literal>
 LiteralValueGetterWithoutStrFunction::operator()(
     Id id, const EvaluationContext* context) const {
   return ql::exportIds::idToLiteral(context->_qec.getIndex(), id,
-                                    context->_localVocab, true);
+                                    context->_localVocab, true,
+                                    &context->_qec.vocabDecodeCache());
 }
 
 // ____________________________________________________________________________
@@ -172,6 +190,15 @@ LiteralValueGetterWithoutStrFunction::operator()(
   return ql::exportIds::handleIriOrLiteral(s, true);
 }
 
+// ____________________________________________________________________________
+auto LiteralValueGetterWithoutStrFunction::getValues(
+    ql::span<const ValueId> ids, const EvaluationContext* context) const
+    -> std::vector<Value> {
+  return ql::exportIds::idsToLiterals(context->_qec.getIndex(), ids,
+                                      context->_localVocab, true,
+                                      &context->_qec.vocabDecodeCache());
+}
+
 // ____________________________________________________________________________
 std::optional<std::string> ReplacementStringGetter::operator()(
     Id id, const EvaluationContext* context) const {
@@ -238,8 +265,11 @@ Id IsSomethingValueGetter<isSomethingFunction, prefix>::operator()(
                               ql::starts_with(word.value().first, prefix));
     }
     case Datatype::EncodedVal:
-      // We currently only encode IRIs.
-      return Id::makeFromBool(prefix == isIriPrefix);
+      // We currently only encode IRIs and short literals.
+      return Id::makeFromBool(
+          context->_qec.getIndex().encodedIriManager().isShortLiteral(id)
+              ? prefix == isLiteralPrefix
+              : prefix == isIriPrefix);
     case Datatype::Bool:
     case Datatype::Int:
     case Datatype::Double:
@@ -265,7 +295,8 @@ template struct sparqlExpression::detail::IsSomethingValueGetter<
 std::optional<std::string> LiteralFromIdGetter::operator()(
     ValueId id, const EvaluationContext* context) const {
   auto optionalStringAndType = ql::exportIds::idToStringAndType<true, true>(
-      context->_qec.getIndex(), id, context->_localVocab);
+      context->_qec.getIndex(), id, context->_localVocab, ql::identity{},
+      &context->_qec.vocabDecodeCache());
   if (optionalStringAndType.has_value()) {
     return std::move(optionalStringAndType.value().first);
   } else {
@@ -344,7 +375,8 @@ OptIri DatatypeValueGetter::operator()(ValueId id,
     case LocalVocabIndex:
     case VocabIndex:
       return (*this)(ql::exportIds::getLiteralOrIriFromVocabIndex(
-                         context->_qec.getIndex(), id, context->_localVocab),
+                         context->_qec.getIndex(), id, context->_localVocab,
+                         &context->_qec.vocabDecodeCache()),
                      context);
     case Undefined:
     case BlankNodeIndex:
@@ -393,7 +425,8 @@ UnitOfMeasurement UnitOfMeasurementValueGetter::operator()(
       id, [&context](const ValueId& value) -> UnitOfMeasurement {
         // Get string content of ValueId
         auto str = ql::exportIds::idToLiteralOrIri(
-            context->_qec.getIndex(), value, context->_localVocab, true);
+            context->_qec.getIndex(), value, context->_localVocab, true,
+            &context->_qec.vocabDecodeCache());
         // Use LiteralOrIri overload for actual computation
         if (str.has_value()) {
           return UnitOfMeasurementValueGetter{}(str.value(), context);
@@ -433,7 +466,8 @@ std::optional<ad_utility::GeoPointOrWkt> GeoPointOrWktValueGetter::operator()(
     case VocabIndex:
     case LocalVocabIndex: {
       auto lit = ql::exportIds::getLiteralOrIriFromVocabIndex(
-          context->_qec.getIndex(), id, context->_localVocab);
+          context->_qec.getIndex(), id, context->_localVocab,
+          &context->_qec.vocabDecodeCache());
       return GeoPointOrWktValueGetter{}(lit, context);
     }
     case Bool:
@@ -474,7 +508,8 @@ CPP_template(typename T, typename ValueGetter)(
     case VocabIndex:
       return valueGetter(
           ql::exportIds::getLiteralOrIriFromVocabIndex(
-              context->_qec.getIndex(), id, context->_localVocab),
+              context->_qec.getIndex(), id, context->_localVocab,
+              &context->_qec.vocabDecodeCache()),
           context);
     case TextRecordIndex:
     case WordVocabIndex:
@@ -590,7 +625,8 @@ CPP_template_out_def(typename RequestedInfo)(
         // No precomputed geometry info available: we have to fetch and parse
         // the string.
         auto lit = ql::exportIds::getLiteralOrIriFromVocabIndex(
-            context->_qec.getIndex(), id, context->_localVocab);
+            context->_qec.getIndex(), id, context->_localVocab,
+            &context->_qec.vocabDecodeCache());
         return GeometryInfoValueGetter{}(lit, context);
       }
     }
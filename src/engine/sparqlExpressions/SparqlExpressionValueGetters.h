@@ -194,6 +194,11 @@ struct LiteralValueGetterWithStrFunction
 
   std::optional<ad_utility::triple_component::Literal> operator()(
       const LiteralOrIri& s, const EvaluationContext*) const;
+
+  // Get the values for all the `ids` at once, see
+  // `ql::exportIds::idsToLiterals`.
+  std::vector<Value> getValues(ql::span<const ValueId> ids,
+                               const EvaluationContext* context) const;
 };
 
 // Same as above but only literals no datatype are
@@ -208,6 +213,11 @@ struct LiteralValueGetterWithoutStrFunction
 
   std::optional<ad_utility::triple_component::Literal> operator()(
       const LiteralOrIri& s, const EvaluationContext*) const;
+
+  // Get the values for all the `ids` at once, see
+  // `ql::exportIds::idsToLiterals`.
+  std::vector<Value> getValues(ql::span<const ValueId> ids,
+                               const EvaluationContext* context) const;
 };
 // Boolean value getter that checks whether the given `Id` is a `ValueId` of the
 // given `datatype`.
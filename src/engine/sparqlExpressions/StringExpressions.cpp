@@ -10,10 +10,13 @@
 
 #include "backports/StartsWithAndEndsWith.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
+#include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/NaryExpressionImpl.h"
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/StringExpressionsHelper.h"
 #include "engine/sparqlExpressions/VariadicExpression.h"
 #include "index/EncodedIriManager.h"
+#include "index/IndexImpl.h"
 #include "parser/RdfParser.h"
 #include "util/ParsedUri.h"
 #include "util/StringUtils.h"
@@ -54,6 +57,32 @@ void concatOrSetLiteral(
   }
 }
 
+// _____________________________________________________________________________
+SubstringPrefilter::SubstringPrefilter(const EvaluationContext* context,
+                                       std::string_view substring,
+                                       bool literalsWithDatatypeAreUndefined)
+    : index_{&context->_qec.getIndex().getImpl()},
+      candidates_{index_->vocabularyNgramIndex().getCandidates(substring)},
+      literalsWithDatatypeAreUndefined_{literalsWithDatatypeAreUndefined} {}
+
+// _____________________________________________________________________________
+std::optional<Id> SubstringPrefilter::getResultIfNotACandidate(Id id) const {
+  if (candidates_ == nullptr || id.getDatatype() != Datatype::VocabIndex) {
+    return std::nullopt;
+  }
+  auto vocabIndex = id.getVocabIndex();
+  if (!index_->getVocab().isLiteral(vocabIndex) ||
+      std::binary_search(candidates_->begin(), candidates_->end(),
+                         vocabIndex.get())) {
+    return std::nullopt;
+  }
+  if (literalsWithDatatypeAreUndefined_ &&
+      index_->vocabularyNgramIndex().hasDatatype(vocabIndex.get())) {
+    return Id::makeUndefined();
+  }
+  return Id::makeFromBool(false);
+}
+
 // String functions.
 struct StrImpl {
   IdOrLiteralOrIri operator()(std::optional<std::string> s) const {
@@ -286,9 +315,62 @@ struct ContainsImpl {
   }
 };
 
+// CONTAINS with a variable and a constant substring. The result is computed
+// only once for consecutive equal `Id`s, and the literals from the vocabulary
+// that can't contain the substring are ruled out by the `SubstringPrefilter`.
+template <typename StringGetter>
+struct ContainsWithPrefilter {
+  CPP_template(typename Pattern)(requires isConstantResult<Pattern>)
+      ExpressionResult
+      operator()(EvaluationContext* context, const ::Variable& variable,
+                 const Pattern& pattern) const {
+    auto substring = StringValueGetter{}(pattern, context);
+    constexpr bool literalsWithDatatypeAreUndefined =
+        ad_utility::isSimilar<StringGetter, LiteralFromIdGetter>;
+    std::optional<SubstringPrefilter> prefilter;
+    if (substring.has_value()) {
+      prefilter.emplace(context, substring.value(),
+                        literalsWithDatatypeAreUndefined);
+    }
+    auto ids = getIdsFromVariable(variable, context);
+    VectorWithMemoryLimit<Id> result{context->_allocator};
+    result.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+      if (i > 0 && ids[i] == ids[i - 1]) {
+        result.push_back(result.back());
+        continue;
+      }
+      auto id = prefilter.has_value()
+                    ? prefilter->getResultIfNotACandidate(ids[i])
+                    : std::nullopt;
+      result.push_back(id.has_value()
+                           ? id.value()
+                           : LiftStringFunction<ContainsImpl>{}(
+                                 StringGetter{}(ids[i], context), substring));
+    }
+    return result;
+  }
+};
+
+// The check for the `ContainsWithPrefilter`.
+struct IsVariableAndConstant {
+  template <typename String, typename Pattern>
+  constexpr bool operator()(const String&, const Pattern&) const {
+    return ad_utility::isSimilar<String, ::Variable> &&
+           isConstantResult<Pattern>;
+  }
+};
+
+template <typename StringGetter>
+using ContainsOnStrings =
+    NARY<2,
+         FV<LiftStringFunction<ContainsImpl>, StringGetter, StringValueGetter>,
+         SpecializedFunction<ContainsWithPrefilter<StringGetter>,
+                             IsVariableAndConstant>>;
+
 using ContainsExpression =
-    StringExpressionImpl<2, LiftStringFunction<ContainsImpl>,
-                         StringValueGetter>;
+    StringExpressionWithStrImpl<ContainsOnStrings<StringValueGetter>,
+                                ContainsOnStrings<LiteralFromIdGetter>>;
 
 // STRAFTER / STRBEFORE
 template <bool isStrAfter>
@@ -557,7 +639,39 @@ struct LangMatching {
   }
 };
 
-using LangMatches = StringExpressionImpl<2, LangMatching, StringValueGetter>;
+using LangMatchesImpl =
+    StringExpressionImpl<2, LangMatching, StringValueGetter>;
+
+// `LANGMATCHES(LANG(?var), "range")` can only be true for literals with a
+// (non-empty) language tag, which is used for prefiltering.
+class LangMatches : public LangMatchesImpl {
+ public:
+  using LangMatchesImpl::LangMatchesImpl;
+  std::vector<PrefilterExprVariablePair> getPrefilterExpressionForMetadata(
+      [[maybe_unused]] const LocalVocabContext& context,
+      [[maybe_unused]] bool isNegated) const override {
+    std::vector<PrefilterExprVariablePair> prefilterVec;
+    const auto& children = this->children();
+    AD_CORRECTNESS_CHECK(children.size() == 2);
+
+    auto var = getVariableFromLangExpression(children[0].get());
+    if (!var.has_value()) {
+      return prefilterVec;
+    }
+    auto languageRange = getLiteralFromLiteralExpression(children[1].get());
+    if (!languageRange.has_value() ||
+        asStringViewUnsafe(languageRange.value().getContent()).empty()) {
+      return prefilterVec;
+    }
+
+    // A language range also matches the more specific language tags (e.g.
+    // `en` matches `en-GB`), so all language tags are relevant.
+    prefilterVec.emplace_back(
+        std::make_unique<prefilterExpressions::LanguageTagExpression>("*"),
+        var.value());
+    return prefilterVec;
+  }
+};
 
 // STRING WITH LANGUAGE TAG
 struct StrLangTag {
@@ -6,32 +6,24 @@
 #define QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_STRINGEXPRESSIONSHELPER_H
 
 #include "engine/sparqlExpressions/NaryExpressionImpl.h"
+#include "index/VocabularyNgramIndex.h"
 
 namespace sparqlExpression::detail::string_expressions {
 
-// Template for an expression that works on string literals. The arguments are
-// the same as those to `NaryExpression` with the difference that the value
-// getter is deduced automatically. If the child of the expression is the
-// `STR()` expression, then the `StringValueGetter` will be used (which also
-// returns string values for IRIs, numeric literals, etc.), otherwise the
-// `LiteralFromIdGetter` is used (which returns `std::nullopt` for these cases).
-template <typename ValueGetterWithStr, typename ValueGetterWithoutStr, size_t N,
-          typename Function, typename... AdditionalNonStringValueGetters>
-class StringExpressionImplImpl : public SparqlExpression {
+// Template for an expression that works on string literals. If the child of
+// the expression is the `STR()` expression, then the `STR()` is removed and
+// the `ExpressionWithStr` is used (which has to use the `StringValueGetter`
+// or a similar value getter that also returns string values for IRIs, numeric
+// literals, etc.), otherwise the `ExpressionWithoutStr` is used.
+template <typename ExpressionWithStr, typename ExpressionWithoutStr>
+class StringExpressionWithStrImpl : public SparqlExpression {
  private:
-  using ExpressionWithStr = NARY<
-      N, FV<Function, ValueGetterWithStr, AdditionalNonStringValueGetters...>>;
-  using ExpressionWithoutStr = NARY<N, FV<Function, ValueGetterWithoutStr,
-                                          AdditionalNonStringValueGetters...>>;
-
   Ptr impl_;
 
  public:
   CPP_template(typename... C)(
-      requires(concepts::same_as<C, SparqlExpression::Ptr>&&...)
-          CPP_and(sizeof...(C) + 1 ==
-                  N)) explicit StringExpressionImplImpl(Ptr child,
-                                                        C... children) {
+      requires(concepts::same_as<C, SparqlExpression::Ptr>&&...))
+      explicit StringExpressionWithStrImpl(Ptr child, C... children) {
     AD_CORRECTNESS_CHECK(child != nullptr);
     if (child->isStrExpression()) {
       auto childrenOfStr = std::move(*child).moveChildrenOut();
@@ -55,6 +47,20 @@ class StringExpressionImplImpl : public SparqlExpression {
   ql::span<Ptr> childrenImpl() override { return impl_->children(); }
 };
 
+// Template for an expression that works on string literals. The arguments are
+// the same as those to `NaryExpression` with the difference that the value
+// getter is deduced automatically. If the child of the expression is the
+// `STR()` expression, then the `StringValueGetter` will be used (which also
+// returns string values for IRIs, numeric literals, etc.), otherwise the
+// `LiteralFromIdGetter` is used (which returns `std::nullopt` for these cases).
+template <typename ValueGetterWithStr, typename ValueGetterWithoutStr, size_t N,
+          typename Function, typename... AdditionalNonStringValueGetters>
+using StringExpressionImplImpl = StringExpressionWithStrImpl<
+    NARY<N,
+         FV<Function, ValueGetterWithStr, AdditionalNonStringValueGetters...>>,
+    NARY<N, FV<Function, ValueGetterWithoutStr,
+               AdditionalNonStringValueGetters...>>>;
+
 // Impl class for expressions that work on plain strings.
 template <size_t N, typename Function,
           typename... AdditionalNonStringValueGetters>
@@ -70,6 +76,31 @@ using LiteralExpressionImpl =
     StringExpressionImplImpl<LiteralValueGetterWithStrFunction,
                              LiteralValueGetterWithoutStrFunction, N, Function,
                              AdditionalNonStringValueGetters...>;
+
+// Evaluate a string function that is false for all the strings that don't
+// contain the `substring` (e.g. `CONTAINS` or a `REGEX` that requires the
+// `substring`) without decoding the literals from the vocabulary that can't
+// contain the `substring` according to the `VocabularyNgramIndex`. Nothing
+// can be ruled out if the index was not built, or if the `substring` is too
+// short.
+class SubstringPrefilter {
+ private:
+  const IndexImpl* index_;
+  std::shared_ptr<const VocabularyNgramIndex::VocabIndices> candidates_;
+  // If true, the result for literals with a datatype is undefined instead of
+  // false, as for the `LiteralFromIdGetter`.
+  bool literalsWithDatatypeAreUndefined_;
+
+ public:
+  SubstringPrefilter(const EvaluationContext* context,
+                     std::string_view substring,
+                     bool literalsWithDatatypeAreUndefined);
+
+  // Return the result of the string function for the `id` if it is a literal
+  // from the vocabulary that can't contain the `substring`, and `std::nullopt`
+  // if the string function has to be evaluated.
+  std::optional<Id> getResultIfNotACandidate(Id id) const;
+};
 }  // namespace sparqlExpression::detail::string_expressions
 
 #endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_STRINGEXPRESSIONSHELPER_H
@@ -0,0 +1,198 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_VECTORIZEDEXPRESSIONHELPERS_H
+#define QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_VECTORIZEDEXPRESSIONHELPERS_H
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "engine/sparqlExpressions/SparqlExpressionTypes.h"
+
+// A columnar fast path for binary expressions on numeric values (like
+// `?x * 2` or `?x * 2 > ?y`). The `Id`s of both operands are processed in
+// batches of `BATCH_SIZE` rows. The `Int` and `Double` values of a batch are
+// first decoded into plain arrays, on which the actual operation is then
+// computed in a tight loop (that can be auto-vectorized by the compiler). A
+// batch that contains any other values (e.g. `UNDEF`, dates, or strings) is
+// evaluated element by element with the ordinary (dynamic) implementation of
+// the expression, so the results are always the same.
+namespace sparqlExpression::detail::vectorized {
+
+// The number of rows that are decoded and processed at once.
+constexpr size_t BATCH_SIZE = 1024;
+
+// The operands on which the vectorized evaluation works: a column of the
+// input, the result of a previous expression that is not constant, or a
+// constant `Id`.
+template <typename T>
+CPP_concept IdColumnOrConstant =
+    ad_utility::SimilarToAny<T, ::Variable, VectorWithMemoryLimit<Id>, Id>;
+
+// The check for a `SpecializedFunction` that uses the vectorized evaluation.
+// If all the operands are constants, there is nothing to gain, so the
+// ordinary evaluation is used.
+struct AreAllIdColumnsOrConstants {
+  template <typename... Ts>
+  constexpr bool operator()(const Ts&...) const {
+    return (... && IdColumnOrConstant<std::decay_t<Ts>>) &&
+           !(... && isConstantResult<std::decay_t<Ts>>);
+  }
+};
+
+// The `Id`s of an operand, which are either stored contiguously or are all
+// equal to a single constant.
+class IdSequence {
+  ql::span<const Id> ids_;
+  Id constant_ = Id::makeUndefined();
+  bool isConstant_;
+
+ public:
+  explicit IdSequence(ql::span<const Id> ids)
+      : ids_{ids}, isConstant_{false} {}
+  explicit IdSequence(Id constant) : constant_{constant}, isConstant_{true} {}
+
+  bool isConstant() const { return isConstant_; }
+  Id operator[](size_t i) const { return isConstant_ ? constant_ : ids_[i]; }
+};
+
+// Return the `IdSequence` for one of the operands.
+CPP_template(typename T)(requires IdColumnOrConstant<T>) IdSequence
+    makeIdSequence(const T& operand, const EvaluationContext* context) {
+  if constexpr (ad_utility::isSimilar<T, ::Variable>) {
+    return IdSequence{getIdsFromVariable(operand, context)};
+  } else if constexpr (ad_utility::isSimilar<T, Id>) {
+    return IdSequence{operand};
+  } else {
+    AD_CONTRACT_CHECK(operand.size() == context->size());
+    return IdSequence{ql::span<const Id>{operand}};
+  }
+}
+
+// The numeric values of a batch of `Id`s, decoded into plain arrays.
+class NumericBatch {
+  std::array<int64_t, BATCH_SIZE> ints_;
+  std::array<double, BATCH_SIZE> doubles_;
+  // The `ints_` are only valid if all the values are integers, the `doubles_`
+  // are only valid if all the values are integers or doubles.
+  bool allInts_ = false;
+  bool allDoubles_ = false;
+  bool allNumeric_ = false;
+  // A constant operand only has to be decoded once.
+  bool isDecodedConstant_ = false;
+
+ public:
+  // Decode the `Id`s `sequence[begin, begin + size)`.
+  void decode(const IdSequence& sequence, size_t begin, size_t size) {
+    AD_CORRECTNESS_CHECK(size <= BATCH_SIZE);
+    if (isDecodedConstant_) {
+      return;
+    }
+    if (sequence.isConstant()) {
+      // Decode the full batch, s.t. it can be used for all the batches.
+      size = BATCH_SIZE;
+      isDecodedConstant_ = true;
+    }
+    size_t numInts = 0;
+    size_t numDoubles = 0;
+    for (size_t i = 0; i < size; ++i) {
+      auto datatype = sequence[begin + i].getDatatype();
+      numInts += datatype == Datatype::Int;
+      numDoubles += datatype == Datatype::Double;
+    }
+    allInts_ = numInts == size;
+    allDoubles_ = numDoubles == size;
+    allNumeric_ = numInts + numDoubles == size;
+    if (allInts_) {
+      for (size_t i = 0; i < size; ++i) {
+        ints_[i] = sequence[begin + i].getInt();
+        doubles_[i] = static_cast<double>(ints_[i]);
+      }
+    } else if (allNumeric_) {
+      for (size_t i = 0; i < size; ++i) {
+        Id id = sequence[begin + i];
+        doubles_[i] = id.getDatatype() == Datatype::Int
+                          ? static_cast<double>(id.getInt())
+                          : id.getDouble();
+      }
+    }
+  }
+
+  bool allInts() const { return allInts_; }
+  bool allDoubles() const { return allDoubles_; }
+  bool allNumeric() const { return allNumeric_; }
+  const int64_t* ints() const { return ints_.data(); }
+  const double* doubles() const { return doubles_.data(); }
+};
+
+// Evaluate a binary operation on the `Id`s of `a` and `b`, with `size` many
+// results. `typedFunction` is called on two `int64_t`s or two `double`s and
+// returns an `Id`. When both values of a row are integers, it is called on
+// the integers, otherwise (if at least one of the values is a double) on the
+// values converted to `double`, which has to be consistent with
+// `idFunction`. `idFunction` is called on the two `Id`s of the rows of all the
+// batches that contain non-numeric values.
+template <typename TypedFunction, typename IdFunction>
+VectorWithMemoryLimit<Id> evaluateOnIdsInBatches(
+    const IdSequence& a, const IdSequence& b, size_t size,
+    const EvaluationContext* context, const TypedFunction& typedFunction,
+    const IdFunction& idFunction) {
+  VectorWithMemoryLimit<Id> result{context->_allocator};
+  result.resize(size);
+  // The batches are large, so they are not allocated on the stack.
+  auto batchA = std::make_unique<NumericBatch>();
+  auto batchB = std::make_unique<NumericBatch>();
+  for (size_t begin = 0; begin < size; begin += BATCH_SIZE) {
+    context->cancellationHandle_->throwIfCancelled();
+    size_t batchSize = std::min(BATCH_SIZE, size - begin);
+    batchA->decode(a, begin, batchSize);
+    batchB->decode(b, begin, batchSize);
+    Id* target = result.data() + begin;
+    if (batchA->allInts() && batchB->allInts()) {
+      const int64_t* x = batchA->ints();
+      const int64_t* y = batchB->ints();
+      for (size_t i = 0; i < batchSize; ++i) {
+        target[i] = typedFunction(x[i], y[i]);
+      }
+    } else if (batchA->allNumeric() && batchB->allNumeric() &&
+               (batchA->allDoubles() || batchB->allDoubles())) {
+      const double* x = batchA->doubles();
+      const double* y = batchB->doubles();
+      for (size_t i = 0; i < batchSize; ++i) {
+        target[i] = typedFunction(x[i], y[i]);
+      }
+    } else {
+      for (size_t i = 0; i < batchSize; ++i) {
+        target[i] = idFunction(a[begin + i], b[begin + i]);
+      }
+    }
+  }
+  return result;
+}
+
+// A `Function` for a `SpecializedFunction` (with the check
+// `AreAllIdColumnsOrConstants`) that evaluates a binary numeric expression
+// with `evaluateOnIdsInBatches`. `TypedFunction` is as described there, while
+// `ScalarFunction` and `ValueGetter` are the function and the value getter of
+// the ordinary evaluation, which is used for the non-numeric batches.
+template <typename TypedFunction, typename ScalarFunction, typename ValueGetter>
+struct VectorizedBinaryFunction {
+  CPP_template(typename A, typename B)(
+      requires IdColumnOrConstant<std::decay_t<A>> CPP_and
+          IdColumnOrConstant<std::decay_t<B>>) ExpressionResult
+  operator()(EvaluationContext* context, const A& a, const B& b) const {
+    auto idFunction = [context](Id x, Id y) -> Id {
+      return ScalarFunction{}(ValueGetter{}(x, context),
+                              ValueGetter{}(y, context));
+    };
+    return evaluateOnIdsInBatches(makeIdSequence(a, context),
+                                  makeIdSequence(b, context), context->size(),
+                                  context, TypedFunction{}, idFunction);
+  }
+};
+
+}  // namespace sparqlExpression::detail::vectorized
+
+#endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_VECTORIZEDEXPRESSIONHELPERS_H
@@ -285,11 +285,40 @@ constexpr inline int DEFAULT_MAX_NUM_COLUMNS_STATIC_ID_TABLE = 1;
 constexpr inline int DEFAULT_MAX_NUM_COLUMNS_STATIC_ID_TABLE = 5;
 #endif
 
+// The maximal number of columns for which the hottest operations that
+// dispatch on a single width (sorting an `IdTable` and `DISTINCT`) use the
+// `static` implementation. Typical intermediate results have more columns than
+// `DEFAULT_MAX_NUM_COLUMNS_STATIC_ID_TABLE`, and these operations only require
+// one instantiation per width. The value can be set at build time via the
+// CMake option `MAX_NUM_COLUMNS_STATIC_ID_TABLE_HOT_OPERATORS` (e.g. to the
+// widths that are frequent in a profile of the actual workload).
+#if defined(QLEVER_MAX_NUM_COLUMNS_STATIC_ID_TABLE_HOT_OPERATORS)
+constexpr inline int MAX_NUM_COLUMNS_STATIC_ID_TABLE_HOT_OPERATORS =
+    QLEVER_MAX_NUM_COLUMNS_STATIC_ID_TABLE_HOT_OPERATORS;
+#elif defined(QLEVER_CHEAPER_COMPILATION)
+constexpr inline int MAX_NUM_COLUMNS_STATIC_ID_TABLE_HOT_OPERATORS =
+    DEFAULT_MAX_NUM_COLUMNS_STATIC_ID_TABLE;
+#else
+constexpr inline int MAX_NUM_COLUMNS_STATIC_ID_TABLE_HOT_OPERATORS = 10;
+#endif
+
 // Interval in which an enabled watchdog would check if
 // `CancellationHandle::throwIfCancelled` is called regularly.
 constexpr inline std::chrono::milliseconds DESIRED_CANCELLATION_CHECK_INTERVAL{
     50};
 
+// The limits of the pool of idle connections of the HTTP client (see
+// `ConnectionPool.h`), separately for HTTP and HTTPS. Many servers close idle
+// connections after a few seconds, so it doesn't pay off to keep them longer.
+constexpr inline size_t HTTP_CLIENT_MAX_NUM_IDLE_CONNECTIONS = 16;
+constexpr inline std::chrono::seconds HTTP_CLIENT_IDLE_TIMEOUT{10};
+
+// The HTTP client reads the body of a response in chunks of this size, and up
+// to the given number of chunks ahead of the consumer (see
+// `HttpClientImpl::sendRequest`).
+constexpr inline size_t HTTP_CLIENT_BODY_CHUNK_SIZE = 1 << 16;
+constexpr inline size_t HTTP_CLIENT_NUM_BODY_CHUNKS_TO_READ_AHEAD = 16;
+
 // In all permutations, the graph ID of the triple is stored as the fourth
 // entry. During the index building it is important that this is the first
 // column after the "actual" triple.
@@ -326,6 +355,8 @@ using parallel_tag = int;
 }  // namespace ad_utility
 #endif
 constexpr inline size_t NUM_SORT_THREADS = 4;
+// The number of independently locked shards of the cache for query results.
+constexpr inline size_t NUM_QUERY_RESULT_CACHE_SHARDS = 16;
 /// ANSI escape sequence for bold text in the console
 constexpr inline std::string_view EMPH_ON = "\033[1m";
 /// ANSI escape sequence to print "normal" text again in the console.
@@ -10,6 +10,8 @@
 
 #include "backports/algorithm.h"
 #include "util/Algorithm.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/ThreadBudget.h"
 
 // _____________________________________________________________________________
 RuntimeParameters::RuntimeParameters() {
@@ -25,40 +27,110 @@ RuntimeParameters::RuntimeParameters() {
   add(cacheMaxNumEntries_);
   add(cacheMaxSize_);
   add(cacheMaxSizeSingleEntry_);
+  add(resultCacheDiskMinComputationTime_);
+  add(resultCacheDiskMaxSize_);
+  add(decompressedBlockCacheMaxSize_);
+  add(csrGraphCacheMaxSize_);
+  add(vocabDecodeCacheMaxSize_);
   add(lazyIndexScanQueueSize_);
   add(lazyIndexScanNumThreads_);
+  add(lazyIndexScanConcurrentReads_);
+  add(lazyIndexScanMaxNumPrefetchedBlocks_);
+  add(lazyPipelineNumThreads_);
+  add(lazyJoinPrefetchQueueSize_);
   add(lazyIndexScanMaxSizeMaterialization_);
+  add(runtimeJoinFilterMaxSize_);
+  add(useWorstCaseOptimalJoin_);
+  add(joinNumThreads_);
+  add(useHashJoin_);
+  add(hashDistinctMaxNumRows_);
+  add(textScanNumThreads_);
   add(useBinsearchTransitivePath_);
+  add(transitivePathNumThreads_);
+  add(usePrecomputedTransitiveClosures_);
+  add(pathSearchNumThreads_);
+  add(cartesianProductNumThreads_);
+  add(describeNumThreads_);
+  add(graphAnalyticsNumThreads_);
+  add(valuesNumThreads_);
+  add(valuesSortMinNumRows_);
+  add(expressionNumThreads_);
+  add(expressionMinRowsPerThread_);
+  add(constructExportNumThreads_);
+  add(selectExportNumThreads_);
+  add(responseCompressionNumThreads_);
+  add(cancelOnClientDisconnect_);
+  add(cursorIdleTimeout_);
+  add(patternTrickNumThreads_);
+  add(hasPredicateScanNumThreads_);
+  add(regexNumThreads_);
   add(groupByHashMapEnabled_);
+  add(groupByHashMapNumThreads_);
+  add(groupBySortedNumThreads_);
+  add(groupByHashMapCostBased_);
   add(groupByDisableIndexScanOptimizations_);
   add(serviceMaxValueRows_);
+  add(serviceBindJoinMaxRows_);
+  add(serviceBindJoinNumParallelRequests_);
   add(serviceMaxRedirects_);
   add(queryPlanningBudget_);
+  add(queryPlanningImprovementTimeBudget_);
+  add(reoptimizationThreshold_);
+  add(queryPlanCacheMaxNumEntries_);
   add(throwOnUnboundVariables_);
   add(cacheMaxSizeLazyResult_);
+  add(compressCachedResults_);
+  add(lazyResultSharingMaxSize_);
+  add(queryMaxRunningInteractive_);
+  add(queryMaxRunningDefault_);
+  add(queryMaxRunningBackground_);
+  add(memoryAwareQueryAdmission_);
+  add(queryMaxMemory_);
   add(websocketUpdatesEnabled_);
   add(smallIndexScanSizeEstimateDivisor_);
   add(zeroCostEstimateForCachedSubtree_);
   add(requestBodyLimit_);
   add(cacheServiceResults_);
+  add(serviceBinaryResults_);
+  add(serviceVocabularyIds_);
+  add(loadParserBlocksize_);
   add(syntaxTestMode_);
   add(divisionByZeroIsUndef_);
   add(enablePrefilterOnIndexScans_);
+  add(enableFilterKernels_);
+  add(enableBindFilterFusion_);
   add(spatialJoinMaxNumThreads_);
   add(spatialJoinPrefilterMaxSize_);
+  add(spatialJoinPrefilterIndexScans_);
   add(enableDistributiveUnion_);
+  add(parallelUnion_);
   add(treatDefaultGraphAsNamedGraph_);
   add(sparqlResultsJsonWithTime_);
   add(materializedViewWriterMemory_);
   add(defaultQueryTimeout_);
   add(sortInMemoryThreshold_);
   add(prefilteredOptionalJoin_);
+  add(prefilteredMinus_);
+  add(prefilteredExistsJoin_);
   add(enableMaterializedViewQueryRewrite_);
+  add(materializedViewAdvisorMaxNumCandidates_);
+  add(materializedViewAdvisorDiskBudget_);
+  add(costFactorCalibration_);
   add(serviceAllowedIriPrefixes_);
   add(permutationWriterNumThreads_);
+  add(permutationCompressionLevel_);
+  add(permutationMaxBlocksizeFactor_);
+  add(permutationTripleBloomFilterBitsPerTriple_);
+  add(updateGroupCommitMaxRequests_);
   add(vacuumMinimumBlockSize_);
+  add(vacuumAfterNumDeltaTriples_);
   add(disableCaching_);
   add(logLevel_);
+  add(useTransparentHugePages_);
+  add(allocationPoolMaxSize_);
+  add(threadBudget_);
+  add(queryTraceSamplingRate_);
+  add(queryTraceMaxNumSpansPerThread_);
 
   // Propagate runtime log level changes immediately to the global atomic in
   // Log.h. The action fires once immediately on registration, so the atomic is
@@ -66,6 +138,33 @@ RuntimeParameters::RuntimeParameters() {
   logLevel_.setOnUpdateAction(
       [](LogLevel level) { ad_utility::setRuntimeLogLevel(level); });
 
+  // Same for the use of transparent huge pages by the `AllocatorWithLimit`.
+  useTransparentHugePages_.setOnUpdateAction(
+      [](bool value) { ad_utility::setUseTransparentHugePages(value); });
+  allocationPoolMaxSize_.setOnUpdateAction([](ad_utility::MemorySize value) {
+    ad_utility::detail::allocationPool().setMaxSize(value);
+  });
+  threadBudget_.setOnUpdateAction([](size_t value) {
+    ad_utility::globalThreadBudget().setCapacity(value);
+  });
+
+  permutationCompressionLevel_.setParameterConstraint(
+      [](size_t value, std::string_view parameterName) {
+        if (value < 1 || value > 22) {
+          throw std::runtime_error{
+              absl::StrCat("Parameter ", parameterName,
+                           " must be between 1 and 22, was ", value)};
+        }
+      });
+
+  permutationMaxBlocksizeFactor_.setParameterConstraint(
+      [](size_t value, std::string_view parameterName) {
+        if (value < 1) {
+          throw std::runtime_error{absl::StrCat(
+              "Parameter ", parameterName, " must be at least 1, was ", value)};
+        }
+      });
+
   defaultQueryTimeout_.setParameterConstraint(
       [](std::chrono::seconds value, std::string_view parameterName) {
         if (value <= std::chrono::seconds{0}) {
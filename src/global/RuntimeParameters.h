@@ -51,19 +51,189 @@ struct RuntimeParameters {
                                     "cache-max-size"};
   MemorySizeParameter cacheMaxSizeSingleEntry_{
       ad_utility::MemorySize::gigabytes(5), "cache-max-size-single-entry"};
+  // The on-disk tier of the query result cache (see `QueryResultDiskCache.h`),
+  // which is only used if a directory for it has been specified when starting
+  // the engine. Only results whose computation took at least the given time are
+  // written to disk, and the least recently used files are removed when the
+  // total size of the tier exceeds its maximal size.
+  Duration<std::chrono::milliseconds> resultCacheDiskMinComputationTime_{
+      std::chrono::seconds(10), "result-cache-disk-min-computation-time"};
+  MemorySizeParameter resultCacheDiskMaxSize_{
+      ad_utility::MemorySize::gigabytes(100), "result-cache-disk-max-size"};
+  // The maximum size of the process-wide cache of decompressed blocks of the
+  // permutations (see `DecompressedBlockCache.h`). A value of zero disables
+  // the cache.
+  MemorySizeParameter decompressedBlockCacheMaxSize_{
+      ad_utility::MemorySize::gigabytes(1),
+      "decompressed-block-cache-max-size"};
+  // The maximum size of the process-wide cache of the graphs that are built
+  // by the graph analytics service (see `CsrGraph.h`).
+  MemorySizeParameter csrGraphCacheMaxSize_{
+      ad_utility::MemorySize::gigabytes(1), "csr-graph-cache-max-size"};
+  // The maximum size of the per-query cache of decoded vocabulary words (see
+  // `VocabDecodeCache.h`). A value of zero disables the cache.
+  MemorySizeParameter vocabDecodeCacheMaxSize_{
+      ad_utility::MemorySize::megabytes(64), "vocab-decode-cache-max-size"};
   SizeT lazyIndexScanQueueSize_{20, "lazy-index-scan-queue-size"};
   SizeT lazyIndexScanNumThreads_{10, "lazy-index-scan-num-threads"};
+  // If set, the worker threads of a lazy index scan read their blocks from
+  // disk concurrently, s.t. up to `lazy-index-scan-num-threads` reads are in
+  // flight at the same time. This is beneficial on fast SSDs (NVMe), while on
+  // rotating disks the serialized reads avoid the contention of the file.
+  Bool lazyIndexScanConcurrentReads_{false, "lazy-index-scan-concurrent-reads"};
+  // The maximum number of blocks that a lazy index scan asks the operating
+  // system to prefetch (via `posix_fadvise`) ahead of the blocks that are
+  // currently read. The actual number adapts to the speed of the consumer of
+  // the scan. A value of zero disables the prefetching.
+  SizeT lazyIndexScanMaxNumPrefetchedBlocks_{
+      32, "lazy-index-scan-max-num-prefetched-blocks"};
   Duration<std::chrono::seconds> defaultQueryTimeout_{std::chrono::seconds(30),
                                                       "default-query-timeout"};
+  // The number of threads that concurrently process the blocks of a lazy
+  // result in stateless operations like `FILTER` and `BIND` (see
+  // `Operation::transformLazyResult`). A value of one processes the blocks
+  // in the thread of the consumer.
+  SizeT lazyPipelineNumThreads_{1, "lazy-pipeline-num-threads"};
+  // The number of blocks of a lazy input of a join that are computed ahead of
+  // time by a separate thread, s.t. the pipelines of both inputs run
+  // concurrently to the join (see `joinHelpers::prefetchLazyResult`). A value
+  // of zero computes the blocks in the thread of the join.
+  SizeT lazyJoinPrefetchQueueSize_{2, "lazy-join-prefetch-queue-size"};
   SizeT lazyIndexScanMaxSizeMaterialization_{
       1'000'000, "lazy-index-scan-max-size-materialization"};
+  // If the materialized input of a join has at most this many rows, the
+  // values of its join column are pushed into the other input as a filter
+  // (see `RuntimeJoinFilter.h`). A value of zero disables these filters.
+  SizeT runtimeJoinFilterMaxSize_{100'000, "runtime-join-filter-max-size"};
+  // If set, cyclic basic graph patterns (like triangles) are additionally
+  // planned with a worst-case optimal join (see `LeapfrogTriejoin.h`), which
+  // is used if its estimated cost is lower than that of the binary joins.
+  Bool useWorstCaseOptimalJoin_{false, "use-worst-case-optimal-join"};
+  // The maximum number of threads that compute a join of two large and fully
+  // materialized inputs on disjoint ranges of the join values. Inputs with
+  // UNDEF values in the (first) join column are always joined sequentially.
+  SizeT joinNumThreads_{4, "join-num-threads"};
+  // If set, the query planner also considers a `HashJoin` for joins on a
+  // single column, where at least one of the inputs is not sorted on the join
+  // column and the smaller input is not too large (see the `HASH_JOIN_...`
+  // cost factors in `QueryPlanningCostFactors`).
+  Bool useHashJoin_{false, "use-hash-join"};
+  // If not zero, a `DISTINCT` on an input that is not sorted on the distinct
+  // columns doesn't sort its input if the estimated number of distinct rows is
+  // at most this value. Instead, the distinct rows that have been seen so far
+  // are stored in a hash set, and the input is processed lazily.
+  SizeT hashDistinctMaxNumRows_{0, "hash-distinct-max-num-rows"};
+  // The number of threads that concurrently read and decompress the blocks of
+  // a text index scan for a prefix (like `astro*`), which for short prefixes
+  // can span many blocks. A value of one reads the blocks sequentially.
+  SizeT textScanNumThreads_{4, "text-scan-num-threads"};
   Bool useBinsearchTransitivePath_{true, "use-binsearch-transitive-path"};
+  // The maximum number of threads that compute the transitive hulls of the
+  // start nodes of a transitive path (each hull is computed by a single
+  // thread).
+  SizeT transitivePathNumThreads_{4, "transitive-path-num-threads"};
+  // If true, the transitive hulls of transitive paths like `?x <p>* ?y` are
+  // read from the transitive closure of `<p>` if it was precomputed at index
+  // build time (see `IndexBuilderConfig::transitiveClosurePredicates_`).
+  Bool usePrecomputedTransitiveClosures_{
+      true, "use-precomputed-transitive-closures"};
+  // The maximum number of threads that search the paths from the different
+  // sources of a `PathSearch` (the paths from a single source are found by a
+  // single thread).
+  SizeT pathSearchNumThreads_{4, "path-search-num-threads"};
+  // The maximum number of threads that write the rows of a large Cartesian
+  // product (see `CartesianProductJoin`).
+  SizeT cartesianProductNumThreads_{4, "cartesian-product-num-threads"};
+  // The maximum number of threads that expand the resources of a single round
+  // of a DESCRIBE query (see `Describe::expandResources`). Only rounds with
+  // many resources are split between threads.
+  SizeT describeNumThreads_{4, "describe-num-threads"};
+  // The maximum number of threads that run the algorithms of the graph
+  // analytics service (see `GraphAnalytics`).
+  SizeT graphAnalyticsNumThreads_{4, "graph-analytics-num-threads"};
+  // The maximum number of threads that look up the IRIs and literals of a
+  // VALUES clause in the vocabulary. Only large VALUES clauses are split
+  // between threads.
+  SizeT valuesNumThreads_{4, "values-num-threads"};
+  // VALUES clauses with at least this many rows are sorted by all their
+  // columns, s.t. they can be joined without an additional `Sort`.
+  SizeT valuesSortMinNumRows_{1'000, "values-sort-min-num-rows"};
+  // The maximum number of threads that evaluate the expression of a `BIND` or
+  // `FILTER` on (chunks of) a single large input table, and the minimal number
+  // of rows per thread (see `ChunkedEvaluation.h`).
+  SizeT expressionNumThreads_{4, "expression-num-threads"};
+  SizeT expressionMinRowsPerThread_{100'000,
+                                    "expression-min-rows-per-thread"};
+  // The number of threads that instantiate and format the triples of a
+  // CONSTRUCT query for the export in parallel. With a value of one, the
+  // triples are instantiated by the exporting thread itself.
+  SizeT constructExportNumThreads_{4, "construct-export-num-threads"};
+  // The number of threads that convert the rows of the result of a SELECT
+  // query to strings for the TSV, CSV, SPARQL JSON, and SPARQL XML export.
+  // With a value of one, the rows are converted by the exporting thread
+  // itself (but still in chunks).
+  SizeT selectExportNumThreads_{4, "select-export-num-threads"};
+  // The number of threads that compress the chunks of a response if the
+  // client accepts a compressed response (`Accept-Encoding` is `zstd`, `gzip`,
+  // or `deflate`).
+  SizeT responseCompressionNumThreads_{4, "response-compression-num-threads"};
+  // If set, a query is cancelled as soon as the client closes the connection
+  // over which it was sent.
+  Bool cancelOnClientDisconnect_{true, "cancel-on-client-disconnect"};
+  // A cursor over the result of a query (see `ResultCursors.h`) is removed if
+  // no page has been fetched from it for this time.
+  Duration<std::chrono::seconds> cursorIdleTimeout_{std::chrono::minutes(5),
+                                                    "cursor-idle-timeout"};
+  // The maximum number of threads that count the patterns of the subjects of
+  // a large input of the pattern trick (see `CountAvailablePredicates`).
+  SizeT patternTrickNumThreads_{4, "pattern-trick-num-threads"};
+  // The maximum number of threads that expand the patterns of a large block of
+  // subjects of `ql:has-predicate` (see `HasPredicateScan`).
+  SizeT hasPredicateScanNumThreads_{4, "has-predicate-scan-num-threads"};
+  // The maximum number of threads that match a constant `REGEX` against the
+  // distinct values of a variable, if there are many of them.
+  SizeT regexNumThreads_{4, "regex-num-threads"};
   Bool groupByHashMapEnabled_{false, "group-by-hash-map-enabled"};
+  // The maximum number of threads that aggregate the input of a GROUP BY with
+  // the hash map optimization. Only large inputs are split between threads.
+  SizeT groupByHashMapNumThreads_{4, "group-by-hash-map-num-threads"};
+  // The maximum number of threads that aggregate the groups of a GROUP BY with
+  // a sorted input. Only inputs with many rows are split between threads.
+  SizeT groupBySortedNumThreads_{4, "group-by-sorted-num-threads"};
+  // If set, a GROUP BY also uses the hash map optimization when
+  // `group-by-hash-map-enabled` is not set, but the size estimates suggest that
+  // it is cheaper than sorting the input (see the `GROUP_BY_HASH_MAP_...` cost
+  // factors in `QueryPlanningCostFactors`).
+  Bool groupByHashMapCostBased_{true, "group-by-hash-map-cost-based"};
   Bool groupByDisableIndexScanOptimizations_{
       false, "group-by-disable-index-scan-optimizations"};
   SizeT serviceMaxValueRows_{10'000, "service-max-value-rows"};
+  // Sibling results of a `SERVICE` with more than `service-max-value-rows`
+  // rows, but at most this many rows, are pushed into the `SERVICE` in
+  // batches of `service-max-value-rows` rows, one request per batch (bind
+  // join). At most `service-bind-join-num-parallel-requests` of these
+  // requests are sent concurrently.
+  SizeT serviceBindJoinMaxRows_{1'000'000, "service-bind-join-max-rows"};
+  SizeT serviceBindJoinNumParallelRequests_{
+      4, "service-bind-join-num-parallel-requests"};
   SizeT serviceMaxRedirects_{1, "service-max-redirects"};
   SizeT queryPlanningBudget_{1500, "query-planning-budget"};
+  // If a connected component of a query is too large for the dynamic
+  // programming (see `query-planning-budget`), the greedy query planner
+  // repeats its planning with randomized choices and keeps the cheapest plan
+  // until this much time has been spent for the query. A value of zero only
+  // uses the deterministic greedy plan.
+  Duration<std::chrono::milliseconds> queryPlanningImprovementTimeBudget_{
+      std::chrono::milliseconds(0), "query-planning-improvement-time-budget"};
+  // If positive, the subtrees of a group graph pattern that are not triples
+  // (e.g. subqueries) are computed during the query planning. If the actual
+  // size of such a subtree differs from its size estimate by more than this
+  // factor, the remaining joins are planned with the actual size. The computed
+  // results are reused via the cache. A value of zero disables this.
+  Double reoptimizationThreshold_{0.0, "reoptimization-threshold"};
+  // The maximal number of queries for which the parsed query and the query plan
+  // are cached (see `QueryPlanCache.h`). A value of zero disables the cache.
+  SizeT queryPlanCacheMaxNumEntries_{1000, "query-plan-cache-max-num-entries"};
   Bool throwOnUnboundVariables_{false, "throw-on-unbound-variables"};
 
   // Control up until which size lazy results should be cached. Caching
@@ -71,6 +241,36 @@ struct RuntimeParameters {
   MemorySizeParameter cacheMaxSizeLazyResult_{
       ad_utility::MemorySize::megabytes(5), "cache-max-size-lazy-result"};
 
+  // If true, fully materialized results are compressed before they are
+  // inserted into the query result cache, and decompressed when they are reused
+  // (see `CacheValue::compress` and `CompressedIdTable.h`). This fits more
+  // results into the cache at the cost of the (de)compression.
+  Bool compressCachedResults_{false, "compress-cached-results"};
+
+  // Identical queries that run at the same time share a lazily computed result
+  // (see `SharedLazyResults.h`). This is the maximal size of the chunks that
+  // are buffered for queries that start while the result is already being
+  // consumed. A value of zero disables the sharing.
+  MemorySizeParameter lazyResultSharingMaxSize_{
+      ad_utility::MemorySize::megabytes(100), "lazy-result-sharing-max-size"};
+
+  // The maximal number of queries with the respective priority (see the URL
+  // parameter `priority` and `QueryScheduler.h`) that are executed at the same
+  // time. Further queries wait until a running query has finished. A value of
+  // zero means no limit (apart from the number of threads of the server).
+  SizeT queryMaxRunningInteractive_{0, "query-max-running-interactive"};
+  SizeT queryMaxRunningDefault_{0, "query-max-running-default"};
+  SizeT queryMaxRunningBackground_{0, "query-max-running-background"};
+  // If true, a query is only started if the memory that the query planner
+  // estimates for its result is still free, or if no other query is running.
+  Bool memoryAwareQueryAdmission_{false, "memory-aware-query-admission"};
+  // The maximal amount of memory that a single query may allocate (as part of
+  // the memory limit of the whole server). When it is exceeded, operations
+  // that can fall back to a variant which needs less memory (e.g. the external
+  // sort) do so, all others fail. A value of zero means no per-query limit.
+  MemorySizeParameter queryMaxMemory_{ad_utility::MemorySize::bytes(0),
+                                      "query-max-memory"};
+
   // Control if websockets are enable to post live query updates, and if they
   // are control the throttle of how many request can be sent at once.
   Bool websocketUpdatesEnabled_{true, "websocket-updates-enabled"};
@@ -92,9 +292,24 @@ struct RuntimeParameters {
   // which has the downside that the sibling optimization where VALUES are
   // dynamically pushed into `SERVICE` is no longer used.
   Bool cacheServiceResults_{false, "cache-service-results"};
+  // If set to `true`, `SERVICE` requests accept the binary result format of
+  // QLever (with the SPARQL JSON format as a fallback for other endpoints).
+  // Disabled by default because QLever instances that don't implement this
+  // format yet fail for such requests.
+  Bool serviceBinaryResults_{false, "service-binary-results"};
+  // If set to `true` (together with `service-binary-results`), `SERVICE`
+  // requests ask the remote endpoint to send the IDs of the vocabulary as is,
+  // which it does iff it has the same index ID. Only enable this if the
+  // endpoints with the same index ID were built with the same vocabulary,
+  // e.g. for several QLever instances that serve parts of the same dataset.
+  Bool serviceVocabularyIds_{false, "service-vocabulary-ids"};
   // If set to `true`, we expect the contents of URLs loaded via a LOAD to
   // not change over time. This enables caching of LOAD operations.
   Bool cacheLoadResults_{false, "cache-load-results"};
+  // The size of the blocks in which the body of a `LOAD` is parsed. For a lazy
+  // `LOAD`, this is roughly also the size of the yielded blocks.
+  MemorySizeParameter loadParserBlocksize_{
+      ad_utility::MemorySize::megabytes(10), "load-parser-blocksize"};
   // If set to `true`, several exceptions will silently be ignored and a
   // dummy result will be returned instead.
   // This mode should only be activated when running the syntax tests of
@@ -116,15 +331,36 @@ struct RuntimeParameters {
   // prefilter-free baseline, or for debugging, as wrong results may be
   // related to the `PrefilterExpression`s.
   Bool enablePrefilterOnIndexScans_{true, "enable-prefilter-on-index-scans"};
+  // If set to `true`, `FILTER` expressions that are conjunctions of simple
+  // conditions (like `?x < 42`, `?x = ?y`, `BOUND(?x)`, `isIRI(?x)`, and
+  // `LANG(?x) = "en"`) are evaluated by specialized kernels (see
+  // `FilterKernels.h`). If set to `false`, the generic expression evaluation is
+  // always used, which is useful as a baseline and for debugging.
+  Bool enableFilterKernels_{true, "enable-filter-kernels"};
+  // If set to `true`, the `BIND`s directly below a `FILTER` are evaluated as
+  // part of the `FILTER` (see `Filter.h`) instead of by separate `Bind`
+  // operations.
+  Bool enableBindFilterFusion_{true, "enable-bind-filter-fusion"};
   // The maximum number of threads to be used in `SpatialJoinAlgorithms`.
   SizeT spatialJoinMaxNumThreads_{8, "spatial-join-max-num-threads"};
   // The maximum size of the `prefilterBox` for
   // `SpatialJoinAlgorithms::libspatialjoinParse()`.
   SizeT spatialJoinPrefilterMaxSize_{2'500, "spatial-join-prefilter-max-size"};
+  // If set to `true`, a `SpatialJoin` with a maximum distance whose left side
+  // consists of points only prefilters the blocks of an `IndexScan` on its
+  // right side by the range of latitudes that can contain a join partner.
+  Bool spatialJoinPrefilterIndexScans_{true,
+                                       "spatial-join-prefilter-index-scans"};
   // Push joins into both children of unions if this leads to a cheaper
   // cost-estimate.
   Bool enableDistributiveUnion_{true, "enable-distributive-union"};
 
+  // If set, the two children of a `UNION` are computed concurrently if a
+  // thread is available in the thread budget (see `threadBudget_`). This is
+  // only done if no websocket updates are sent for the query, because the
+  // runtime information is not synchronized between threads.
+  Bool parallelUnion_{true, "parallel-union"};
+
   // If set, the query `SELECT * { GRAPH ?g { ?s ?p ?o } }` will return
   // triples from the default graph, otherwise it will follow the
   // behaviour defined by the SPARQL standard which filters them out.
@@ -146,11 +382,32 @@ struct RuntimeParameters {
 
   Bool prefilteredOptionalJoin_{true, "prefiltered-optional-join"};
 
+  // If set, a `MINUS` with an `IndexScan` as its right child only reads the
+  // blocks of the scan that can contain the join values of the left child.
+  Bool prefilteredMinus_{true, "prefiltered-minus"};
+  // The same for an `EXISTS` with an `IndexScan` as its right child.
+  Bool prefilteredExistsJoin_{true, "prefiltered-exists-join"};
+
   // If set, the query planner checks if suitable materialized views are loaded
   // to substitute more expensive query plans.
   Bool enableMaterializedViewQueryRewrite_{
       true, "enable-materialized-view-query-rewrite"};
 
+  // The maximum number of distinct subtrees for which the server collects
+  // statistics to recommend materialized views (see
+  // `MaterializedViewAdvisor.h`). A value of zero disables the statistics.
+  SizeT materializedViewAdvisorMaxNumCandidates_{
+      10'000, "materialized-view-advisor-max-num-candidates"};
+  // The default for the total size of the recommended materialized views.
+  MemorySizeParameter materializedViewAdvisorDiskBudget_{
+      ad_utility::MemorySize::gigabytes(10),
+      "materialized-view-advisor-disk-budget"};
+
+  // If set, the server fits some of the cost factors of the query planner to
+  // the runtimes of the executed queries (see `CostFactorCalibration.h`), and
+  // uses the fitted factors for the following queries.
+  Bool costFactorCalibration_{false, "cost-factor-calibration"};
+
   // A list of IRI prefixes that are allowed as `SERVICE` endpoints. If empty
   // (the default), all IRIs are allowed. If non-empty, `SERVICE` requests to
   // IRIs that do not start with any of the given prefixes are rejected.
@@ -169,15 +426,72 @@ struct RuntimeParameters {
   // Even though this influences the logic of regular index building,
   // `qlever-index`doesn't expose a CLI flag to set this parameter.
   SizeT permutationWriterNumThreads_{2, "permutation-writer-num-threads"};
+  // The zstd compression level of the columns of the blocks of the
+  // permutations. Higher levels lead to smaller files, but to a slower index
+  // build (the decompression speed hardly depends on the level).
+  SizeT permutationCompressionLevel_{3, "permutation-compression-level"};
+  // The blocks of large relations grow with the size of the relation, up to
+  // this factor times the regular blocksize of the permutations. Larger blocks
+  // mean fewer metadata entries and a better compression for huge relations
+  // like `rdf:type`, while the first blocks of each relation keep the regular
+  // size, s.t. point lookups in smaller relations are not affected. A value of
+  // 1 disables the growth.
+  SizeT permutationMaxBlocksizeFactor_{1, "permutation-max-blocksize-factor"};
+  // The number of bits per triple of the Bloom filters over the triples of
+  // each block of the permutations. They allow fully bound scans (e.g. `ASK`
+  // queries or `FILTER EXISTS` with a fully bound triple) to skip blocks
+  // without decompressing them, at the cost of this many bits of (in-memory)
+  // metadata per triple. A value of 0 disables the filters. The parameter is
+  // only used when building an index.
+  SizeT permutationTripleBloomFilterBitsPerTriple_{
+      0, "permutation-triple-bloom-filter-bits-per-triple"};
+
+  // The maximal number of queued update requests that are executed together
+  // ("group commit"), which results in a single new snapshot of the delta
+  // triples and a single write of the delta triples to disk for all of them.
+  // Only requests that are already waiting for the previous updates to finish
+  // are grouped, so the latency of an update is never increased. A value of 1
+  // disables the grouping.
+  SizeT updateGroupCommitMaxRequests_{1, "update-group-commit-max-requests"};
 
   // Only blocks of this size or larger will be considered for vacuuming.
   SizeT vacuumMinimumBlockSize_{100, "vacuum-minimum-block-size"};
 
+  // If nonzero, the delta triples are vacuumed automatically in the background
+  // as soon as at least this many (external) delta triples have been added
+  // since the last vacuuming. A value of 0 disables the automatic vacuuming.
+  SizeT vacuumAfterNumDeltaTriples_{0, "vacuum-after-num-delta-triples"};
+
   // The runtime log level. Messages with a higher level are suppressed. The
   // compile-time level (CMake LOGLEVEL) still applies as an upper bound.
   LogLevelParameter logLevel_{LogLevel{ad_utility::detail::defaultLogLevel},
                               "log-level"};
 
+  // If true, large allocations (in particular the columns of large `IdTable`s,
+  // e.g. in the result cache) are backed by transparent huge pages, which
+  // reduces the number of TLB misses of large joins and sorts.
+  Bool useTransparentHugePages_{false, "use-transparent-huge-pages"};
+
+  // The maximum size of the process-wide pool of freed large memory blocks
+  // (see `AllocationPool.h`), from which the `IdTable`s of lazy pipelines,
+  // which typically all have the same size, are allocated without page faults.
+  // A value of zero disables the pool.
+  MemorySizeParameter allocationPoolMaxSize_{
+      ad_utility::MemorySize::megabytes(512), "allocation-pool-max-size"};
+
+  // The total number of threads that the parallel parts of all concurrently
+  // running queries may use (see `ThreadBudget.h`). The per-operation limits
+  // (e.g. `group-by-hash-map-num-threads`) are then only upper bounds. A value
+  // of zero means the number of hardware threads.
+  SizeT threadBudget_{0, "thread-budget"};
+
+  // The fraction of the queries that are traced (see `SpanTracer.h`) without
+  // being requested via the `trace` URL parameter, and the capacity of the
+  // ring buffer of the spans per thread of a traced query.
+  Double queryTraceSamplingRate_{0.01, "query-trace-sampling-rate"};
+  SizeT queryTraceMaxNumSpansPerThread_{
+      10'000, "query-trace-max-num-spans-per-thread"};
+
   // ___________________________________________________________________________
   // IMPORTANT NOTE: IF YOU ADD PARAMETERS ABOVE, ALSO REGISTER THEM IN THE
   // CONSTRUCTOR, S.T. THEY CAN ALSO BE ACCESSED VIA THE RUNTIME INTERFACE.
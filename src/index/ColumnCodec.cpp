@@ -0,0 +1,328 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/ColumnCodec.h"
+
+#include <absl/numeric/bits.h>
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include "util/BitPacking.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/Exception.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeVector.h"
+
+namespace qlever::columnCodec {
+
+namespace {
+// The bitpacked codecs start with a base value, followed by the number of
+// values (in the upper 56 bits) and the number of bits per value (in the lower
+// 8 bits).
+constexpr size_t headerSize = 2 * sizeof(uint64_t);
+
+// The zigzag encoding of the (wrapping) difference `a - b`, s.t. small
+// negative differences are small numbers.
+uint64_t zigzagDifference(uint64_t a, uint64_t b) {
+  auto difference = static_cast<int64_t>(a - b);
+  return (static_cast<uint64_t>(difference) << 1) ^
+         static_cast<uint64_t>(difference >> 63);
+}
+
+// The inverse of `zigzagDifference`: return `a` given `b`.
+uint64_t addZigzagDifference(uint64_t b, uint64_t zigzag) {
+  return b + ((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+}
+
+uint8_t numBitsFor(uint64_t value) {
+  return static_cast<uint8_t>(absl::bit_width(value));
+}
+
+// Append the raw bytes of the `value` to the `bytes`.
+template <typename T>
+void append(std::vector<char>& bytes, const T& value) {
+  auto position = bytes.size();
+  bytes.resize(position + sizeof(T));
+  std::memcpy(bytes.data() + position, &value, sizeof(T));
+}
+
+// Read the `T` at the `position` of the `bytes`.
+template <typename T>
+T read(ql::span<const char> bytes, size_t position) {
+  AD_CORRECTNESS_CHECK(position + sizeof(T) <= bytes.size());
+  T value;
+  std::memcpy(&value, bytes.data() + position, sizeof(T));
+  return value;
+}
+
+// Encode the header and the `numValues` values returned by `getValue(i)` with
+// `numBits` bits each.
+template <typename F>
+std::vector<char> encodeBitPacked(uint64_t base, uint8_t numBits,
+                                  size_t numValues, const F& getValue) {
+  std::vector<char> bytes;
+  append(bytes, base);
+  append(bytes, uint64_t{numValues} << 8 | numBits);
+  auto packed = ad_utility::bitPack(numValues, numBits, getValue);
+  auto position = bytes.size();
+  bytes.resize(position + packed.size() * sizeof(uint64_t));
+  std::memcpy(bytes.data() + position, packed.data(),
+              packed.size() * sizeof(uint64_t));
+  return bytes;
+}
+
+// Decode the header of a bitpacked codec, check that the `bytes` contain
+// exactly `numValues` values, and call `f(base, unpack)`, where `unpack(i)`
+// returns the `i`-th packed value.
+template <typename F>
+void decodeBitPacked(ql::span<const char> bytes, size_t numValues,
+                     const F& f) {
+  auto base = read<uint64_t>(bytes, 0);
+  auto numValuesAndBits = read<uint64_t>(bytes, sizeof(uint64_t));
+  auto numBits = static_cast<uint8_t>(numValuesAndBits & 0xFF);
+  AD_CORRECTNESS_CHECK(numValuesAndBits >> 8 == numValues);
+  AD_CORRECTNESS_CHECK(numBits <= 64);
+  AD_CORRECTNESS_CHECK(
+      bytes.size() ==
+      headerSize + ad_utility::numBitPackedWords(numValues, numBits) *
+                       sizeof(uint64_t));
+  const char* packed = bytes.data() + headerSize;
+  f(base, [packed, numBits](size_t i) {
+    return ad_utility::bitUnpack(packed, numBits, i);
+  });
+}
+
+// The statistics of a column that determine the sizes of the lightweight
+// codecs.
+struct Statistics {
+  size_t numRuns_ = 1;
+  uint64_t maxZigzagDifference_ = 0;
+  uint64_t min_;
+  uint64_t max_;
+
+  explicit Statistics(ql::span<const Id> column)
+      : min_{column[0].getBits()}, max_{column[0].getBits()} {
+    for (size_t i = 1; i < column.size(); ++i) {
+      auto bits = column[i].getBits();
+      auto previous = column[i - 1].getBits();
+      numRuns_ += bits != previous;
+      maxZigzagDifference_ =
+          std::max(maxZigzagDifference_, zigzagDifference(bits, previous));
+      min_ = std::min(min_, bits);
+      max_ = std::max(max_, bits);
+    }
+  }
+
+  // The size of the encoding of the column with `codec` in bytes.
+  size_t size(ColumnCodec codec, size_t numValues) const {
+    switch (codec) {
+      case ColumnCodec::RunLength:
+        return numRuns_ * 2 * sizeof(uint64_t);
+      case ColumnCodec::DeltaBitPacked:
+        return headerSize +
+               ad_utility::numBitPackedWords(
+                   numValues - 1, numBitsFor(maxZigzagDifference_)) *
+                   sizeof(uint64_t);
+      case ColumnCodec::FrameOfReference:
+        return headerSize + ad_utility::numBitPackedWords(
+                                numValues, numBitsFor(max_ - min_)) *
+                                sizeof(uint64_t);
+      case ColumnCodec::Zstd:
+      case ColumnCodec::ZstdWithDictionary:
+        break;
+    }
+    AD_FAIL();
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+std::vector<char> encodeWith(ColumnCodec codec, ql::span<const Id> column,
+                             int zstdCompressionLevel,
+                             const ZstdDictionary* dictionary) {
+  auto bits = [&column](size_t i) { return column[i].getBits(); };
+  switch (codec) {
+    case ColumnCodec::Zstd:
+      return ZstdWrapper::compress(column.data(), column.size() * sizeof(Id),
+                                   zstdCompressionLevel);
+    case ColumnCodec::ZstdWithDictionary:
+      AD_CONTRACT_CHECK(dictionary != nullptr);
+      return dictionary->compress(column.data(), column.size() * sizeof(Id));
+    case ColumnCodec::RunLength: {
+      std::vector<char> bytes;
+      for (size_t begin = 0; begin < column.size();) {
+        size_t end = begin + 1;
+        while (end < column.size() && bits(end) == bits(begin)) {
+          ++end;
+        }
+        append(bytes, bits(begin));
+        append(bytes, uint64_t{end - begin});
+        begin = end;
+      }
+      return bytes;
+    }
+    case ColumnCodec::DeltaBitPacked: {
+      AD_CONTRACT_CHECK(!column.empty());
+      Statistics statistics{column};
+      return encodeBitPacked(
+          bits(0), numBitsFor(statistics.maxZigzagDifference_),
+          column.size() - 1, [&bits](size_t i) {
+            return zigzagDifference(bits(i + 1), bits(i));
+          });
+    }
+    case ColumnCodec::FrameOfReference: {
+      AD_CONTRACT_CHECK(!column.empty());
+      Statistics statistics{column};
+      auto min = statistics.min_;
+      return encodeBitPacked(min, numBitsFor(statistics.max_ - min),
+                             column.size(),
+                             [&bits, min](size_t i) { return bits(i) - min; });
+    }
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+EncodedColumn encode(ql::span<const Id> column, int zstdCompressionLevel,
+                     const ZstdDictionary* dictionary) {
+  EncodedColumn zstd{
+      ColumnCodec::Zstd,
+      encodeWith(ColumnCodec::Zstd, column, zstdCompressionLevel)};
+  if (column.empty()) {
+    return zstd;
+  }
+  if (dictionary != nullptr) {
+    auto withDictionary = encodeWith(ColumnCodec::ZstdWithDictionary, column,
+                                     zstdCompressionLevel, dictionary);
+    if (withDictionary.size() < zstd.bytes_.size()) {
+      zstd = {ColumnCodec::ZstdWithDictionary, std::move(withDictionary)};
+    }
+  }
+  Statistics statistics{column};
+  auto best = ColumnCodec::RunLength;
+  for (auto codec :
+       {ColumnCodec::DeltaBitPacked, ColumnCodec::FrameOfReference}) {
+    if (statistics.size(codec, column.size()) <
+        statistics.size(best, column.size())) {
+      best = codec;
+    }
+  }
+  if (static_cast<double>(statistics.size(best, column.size())) >
+      maxSizeRatioOfLightweightCodecs *
+          static_cast<double>(zstd.bytes_.size())) {
+    return zstd;
+  }
+  return {best, encodeWith(best, column, zstdCompressionLevel)};
+}
+
+// _____________________________________________________________________________
+void decode(ColumnCodec codec, ql::span<const char> bytes, ql::span<Id> result,
+            const ZstdDictionary* dictionary) {
+  switch (codec) {
+    case ColumnCodec::Zstd: {
+      auto numBytes = ZstdWrapper::decompressToBuffer(
+          bytes.data(), bytes.size(), result.data(),
+          result.size() * sizeof(Id));
+      AD_CORRECTNESS_CHECK(numBytes == result.size() * sizeof(Id));
+      return;
+    }
+    case ColumnCodec::ZstdWithDictionary: {
+      if (dictionary == nullptr) {
+        throw std::runtime_error{
+            "A column of a permutation was compressed with a ZSTD dictionary, "
+            "but the dictionaries of the permutation are missing"};
+      }
+      auto numBytes = dictionary->decompressToBuffer(
+          bytes.data(), bytes.size(), result.data(),
+          result.size() * sizeof(Id));
+      AD_CORRECTNESS_CHECK(numBytes == result.size() * sizeof(Id));
+      return;
+    }
+    case ColumnCodec::RunLength: {
+      AD_CORRECTNESS_CHECK(bytes.size() % (2 * sizeof(uint64_t)) == 0);
+      size_t numDecoded = 0;
+      for (size_t position = 0; position < bytes.size();
+           position += 2 * sizeof(uint64_t)) {
+        auto id = Id::fromBits(read<uint64_t>(bytes, position));
+        auto length = read<uint64_t>(bytes, position + sizeof(uint64_t));
+        AD_CORRECTNESS_CHECK(numDecoded + length <= result.size());
+        std::fill_n(result.begin() + numDecoded, length, id);
+        numDecoded += length;
+      }
+      AD_CORRECTNESS_CHECK(numDecoded == result.size());
+      return;
+    }
+    case ColumnCodec::DeltaBitPacked:
+      AD_CORRECTNESS_CHECK(!result.empty());
+      decodeBitPacked(bytes, result.size() - 1,
+                      [&result](uint64_t current, const auto& unpack) {
+                        result[0] = Id::fromBits(current);
+                        for (size_t i = 1; i < result.size(); ++i) {
+                          current = addZigzagDifference(current, unpack(i - 1));
+                          result[i] = Id::fromBits(current);
+                        }
+                      });
+      return;
+    case ColumnCodec::FrameOfReference:
+      decodeBitPacked(bytes, result.size(),
+                      [&result](uint64_t min, const auto& unpack) {
+                        for (size_t i = 0; i < result.size(); ++i) {
+                          result[i] = Id::fromBits(min + unpack(i));
+                        }
+                      });
+      return;
+  }
+  throw std::runtime_error{
+      absl::StrCat("Unknown codec ", static_cast<int>(codec),
+                   " of a compressed column, the index was probably built "
+                   "with a newer version of QLever")};
+}
+
+// _____________________________________________________________________________
+std::string getDictionariesFilename(const std::string& permutationFilename) {
+  return permutationFilename + ".zstd-dictionaries";
+}
+
+// _____________________________________________________________________________
+void writeDictionaries(const ZstdDictionaries& dictionaries,
+                       const std::string& filename) {
+  // A column without a dictionary is stored as an empty dictionary.
+  std::vector<std::vector<char>> bytes;
+  for (const auto& dictionary : dictionaries) {
+    bytes.push_back(dictionary.has_value() ? dictionary->bytes()
+                                           : std::vector<char>{});
+  }
+  ad_utility::serialization::FileWriteSerializer writer{filename};
+  writer << bytes;
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const ZstdDictionaries> readDictionaries(
+    const std::string& filename) {
+  if (!std::filesystem::exists(filename)) {
+    return nullptr;
+  }
+  std::vector<std::vector<char>> bytes;
+  ad_utility::serialization::FileReadSerializer reader{filename};
+  reader >> bytes;
+  auto dictionaries = std::make_shared<ZstdDictionaries>();
+  for (auto& dictionary : bytes) {
+    if (dictionary.empty()) {
+      dictionaries->emplace_back(std::nullopt);
+    } else {
+      dictionaries->emplace_back(std::move(dictionary));
+    }
+  }
+  return dictionaries;
+}
+
+}  // namespace qlever::columnCodec
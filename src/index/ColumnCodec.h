@@ -0,0 +1,114 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_COLUMNCODEC_H
+#define QLEVER_SRC_INDEX_COLUMNCODEC_H
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "backports/span.h"
+#include "global/Id.h"
+#include "util/CompressionUsingZstd/ZstdDictionary.h"
+
+namespace qlever::columnCodec {
+
+// The encodings of the columns of the blocks of a permutation. Apart from the
+// generic `Zstd`, these are lightweight encodings that are much faster to
+// decode, and often also smaller for the (sorted and repetitive) columns of
+// the permutations. The values are stored in the index, so they must not be
+// changed.
+enum class ColumnCodec : uint8_t {
+  // The raw `Id`s, compressed with ZSTD. This is the encoding of all columns
+  // of indices that were built before the other codecs were introduced.
+  Zstd = 0,
+  // Pairs of an `Id` and the number of its consecutive repetitions. Good for
+  // the first column of a block (which contains only few distinct `Id`s) and
+  // the graph column (which is often constant).
+  RunLength = 1,
+  // The first `Id`, followed by the differences of consecutive `Id`s (in the
+  // zigzag encoding, s.t. small negative differences are small as well),
+  // bitpacked with the smallest possible bit width. Good for sorted columns.
+  DeltaBitPacked = 2,
+  // The minimal `Id`, followed by the differences of all `Id`s to it,
+  // bitpacked with the smallest possible bit width (also known as frame of
+  // reference). Good for unsorted columns with `Id`s from a small range.
+  FrameOfReference = 3,
+  // The raw `Id`s, compressed with ZSTD using the dictionary of the column
+  // (see `ZstdDictionaries` below). Good for small blocks.
+  ZstdWithDictionary = 4,
+};
+
+// The ZSTD dictionaries of a permutation, one per column. Columns without
+// a dictionary are `std::nullopt`.
+using ZstdDictionaries = std::vector<std::optional<ZstdDictionary>>;
+
+// Only columns with at most this number of `Id`s are used for training and
+// compressed with the dictionaries, larger columns are compressed well enough
+// without one.
+constexpr inline size_t maxNumIdsForDictionary = 16'384;
+
+// The maximal size of a single dictionary in bytes.
+constexpr inline size_t maxDictionarySize = 16 * 1024;
+
+// The dictionaries of a permutation are trained on the columns of this number
+// of small blocks.
+constexpr inline size_t numSampleBlocksForDictionaries = 64;
+
+// The result of `encode`.
+struct EncodedColumn {
+  ColumnCodec codec_;
+  std::vector<char> bytes_;
+};
+
+// A lightweight codec is only chosen if its result is at most this factor
+// larger than the result of `Zstd`, because decoding it is much cheaper.
+constexpr inline double maxSizeRatioOfLightweightCodecs = 1.25;
+
+// Encode the `column` with the codec that is best suited (see above). Empty
+// columns are always encoded with `Zstd`. The `zstdCompressionLevel` is used
+// for the `Zstd` codec. If a `dictionary` is specified, then the
+// `ZstdWithDictionary` codec is tried as well.
+EncodedColumn encode(ql::span<const Id> column, int zstdCompressionLevel,
+                     const ZstdDictionary* dictionary = nullptr);
+
+// Encode the `column` with the given `codec`. The `dictionary` is required
+// for the `ZstdWithDictionary` codec.
+std::vector<char> encodeWith(ColumnCodec codec, ql::span<const Id> column,
+                             int zstdCompressionLevel,
+                             const ZstdDictionary* dictionary = nullptr);
+
+// Decode the `bytes` that were encoded with the `codec` to the `result`, the
+// size of which has to be the number of encoded `Id`s. Throw if the `bytes`
+// don't contain exactly this number of `Id`s, or if the `codec` is
+// `ZstdWithDictionary` and no `dictionary` is specified.
+void decode(ColumnCodec codec, ql::span<const char> bytes, ql::span<Id> result,
+            const ZstdDictionary* dictionary = nullptr);
+
+// The name of the file that stores the dictionaries of the permutation that is
+// stored in the file with the `permutationFilename`.
+std::string getDictionariesFilename(const std::string& permutationFilename);
+
+// Write the `dictionaries` to the file with the `filename`.
+void writeDictionaries(const ZstdDictionaries& dictionaries,
+                       const std::string& filename);
+
+// Read the dictionaries from the file with the `filename`. Return `nullptr` if
+// the file doesn't exist (which is the case for permutations without
+// dictionaries, in particular all permutations that were built before the
+// dictionaries were introduced).
+std::shared_ptr<const ZstdDictionaries> readDictionaries(
+    const std::string& filename);
+
+}  // namespace qlever::columnCodec
+
+#endif  // QLEVER_SRC_INDEX_COLUMNCODEC_H
@@ -6,6 +6,8 @@
 
 #include "index/CompressedRelation.h"
 
+#include <bit>
+#include <filesystem>
 #include <thread>
 
 #include "engine/idTable/CompressedExternalIdTable.h"
@@ -17,8 +19,10 @@
 #include "index/GraphComputation.h"
 #include "index/IdTableUtils.h"
 #include "index/LocatedTriples.h"
-#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/Algorithm.h"
 #include "util/Iterators.h"
+#include "util/SpanTracer.h"
+#include "util/ThreadBudget.h"
 #include "util/ThreadSafeQueue.h"
 #include "util/Timer.h"
 #include "util/TypeTraits.h"
@@ -85,6 +89,115 @@ CompressedBlockMetadataNoBlockIndex::getOffsetAndCompressedSizeForColumn(
   return offsetsAndCompressedSize_.value().at(columnIndex);
 }
 
+// _____________________________________________________________________________
+auto CompressedBlockMetadataNoBlockIndex::ColumnStatistics::fromColumn(
+    ql::span<const Id> column) -> ColumnStatistics {
+  AD_CONTRACT_CHECK(!column.empty());
+  // This function is called during the index building, where there are no
+  // local vocab entries, so we can compare the `Id`s by their bits, which is
+  // much cheaper.
+  ColumnStatistics result{column.front(), column.front(), 0};
+  for (Id id : column) {
+    if (id.compareWithoutLocalVocab(result.min_) < 0) {
+      result.min_ = id;
+    } else if (id.compareWithoutLocalVocab(result.max_) > 0) {
+      result.max_ = id;
+    }
+    result.datatypeBitmask_ |= uint64_t{1}
+                               << static_cast<size_t>(id.getDatatype());
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void CompressedBlockMetadataNoBlockIndex::ColumnStatistics::add(Id id) {
+  min_ = std::min(min_, id);
+  max_ = std::max(max_, id);
+  datatypeBitmask_ |= uint64_t{1} << static_cast<size_t>(id.getDatatype());
+}
+
+// _____________________________________________________________________________
+auto CompressedBlockMetadataNoBlockIndex::GraphBloomFilter::fromColumn(
+    ql::span<const Id> column) -> GraphBloomFilter {
+  GraphBloomFilter result;
+  result.bits_.fill(0);
+  for (Id graph : column) {
+    result.add(graph);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void CompressedBlockMetadataNoBlockIndex::GraphBloomFilter::add(Id graph) {
+  auto bit = bitIndex(graph);
+  bits_[bit / 64] |= uint64_t{1} << (bit % 64);
+}
+
+// _____________________________________________________________________________
+bool CompressedBlockMetadataNoBlockIndex::GraphBloomFilter::mayContain(
+    Id graph) const {
+  auto bit = bitIndex(graph);
+  return (bits_[bit / 64] >> (bit % 64)) & 1u;
+}
+
+// _____________________________________________________________________________
+auto CompressedBlockMetadataNoBlockIndex::TripleBloomFilter::fromBlock(
+    const IdTable& block, size_t bitsPerTriple) -> TripleBloomFilter {
+  // Use a power of two for the number of bits, s.t. the bit index can be
+  // computed with a mask instead of a division.
+  size_t numWords =
+      std::bit_ceil(std::max<size_t>(1, block.numRows() * bitsPerTriple / 64));
+  TripleBloomFilter result;
+  result.bits_.resize(numWords, 0);
+  for (const auto& row : block) {
+    result.add(row[0], row[1], row[2]);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+template <typename F>
+void CompressedBlockMetadataNoBlockIndex::TripleBloomFilter::forEachBit(
+    Id col0, Id col1, Id col2, const F& f) const {
+  // The finalizer of the `splitmix64` generator.
+  auto mix = [](uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  };
+  uint64_t hash =
+      mix(mix(mix(col0.getBits()) ^ col1.getBits()) ^ col2.getBits());
+  uint64_t h1 = hash;
+  // An odd step never maps two of the hash functions to the same bit.
+  uint64_t h2 = (hash >> 32) | 1u;
+  uint64_t mask = bits_.size() * 64 - 1;
+  for (size_t i = 0; i < numHashFunctions; ++i) {
+    uint64_t bit = (h1 + i * h2) & mask;
+    f(bit / 64, bit % 64);
+  }
+}
+
+// _____________________________________________________________________________
+void CompressedBlockMetadataNoBlockIndex::TripleBloomFilter::add(Id col0,
+                                                                 Id col1,
+                                                                 Id col2) {
+  AD_CORRECTNESS_CHECK(!bits_.empty());
+  forEachBit(col0, col1, col2, [this](size_t word, size_t bit) {
+    bits_[word] |= uint64_t{1} << bit;
+  });
+}
+
+// _____________________________________________________________________________
+bool CompressedBlockMetadataNoBlockIndex::TripleBloomFilter::mayContain(
+    Id col0, Id col1, Id col2) const {
+  AD_CORRECTNESS_CHECK(!bits_.empty());
+  bool result = true;
+  forEachBit(col0, col1, col2, [this, &result](size_t word, size_t bit) {
+    result &= static_cast<bool>((bits_[word] >> bit) & 1u);
+  });
+  return result;
+}
+
 // Return true iff the `triple` is contained in the `scanSpec`. For example, the
 // triple ` 42 0 3 ` is contained in the specs `U U U`, `42 U U` and `42 0 U` ,
 // but not in `42 2 U` where `U` means "scan for all possible values".
@@ -160,10 +273,23 @@ CompressedRelationReader::asyncParallelBlockGenerator(
     ad_utility::Timer popTimer_{
         ad_utility::timer::Timer::InitialStatus::Stopped};
     std::mutex blockIteratorMutex_;
+    // The threads of the `queue_`, reserved from the global thread budget.
+    // Declared before the `queue_`, s.t. they are only released after the
+    // threads of the `queue_` have been joined.
+    std::optional<ad_utility::ThreadBudget::Reservation> threads_;
     ad_utility::InputRangeTypeErased<
         std::optional<DecompressedBlockAndMetadata>>
         queue_;
     bool needsStart_{true};
+    bool concurrentReads_{false};
+    // The blocks in `[blockMetadataIterator_, prefetchEnd_)` have already been
+    // prefetched. Guarded by the `blockIteratorMutex_`.
+    T prefetchEnd_;
+    // The number of blocks after `blockMetadataIterator_` that are prefetched.
+    // It adapts to the speed of the consumer (see `adaptPrefetching`) and is
+    // at most `maxNumBlocksToPrefetch_`.
+    std::atomic<size_t> numBlocksToPrefetch_{0};
+    size_t maxNumBlocksToPrefetch_{0};
 
     Generator(T beginBlock, T endBlock, const ScanImplConfig& scanConfig,
               CancellationHandle cancellationHandle,
@@ -175,14 +301,27 @@ CompressedRelationReader::asyncParallelBlockGenerator(
           scanConfig_{scanConfig},
           cancellationHandle_{cancellationHandle},
           limitOffset_{limitOffset},
-          reader_{reader} {}
+          reader_{reader},
+          prefetchEnd_{beginBlock} {}
 
     void start() {
-      auto numThreads{
-          getRuntimeParameter<&RuntimeParameters::lazyIndexScanNumThreads_>()};
+      threads_.emplace(ad_utility::globalThreadBudget().reserve(
+          getRuntimeParameter<&RuntimeParameters::lazyIndexScanNumThreads_>()));
+      auto numThreads = threads_->numThreads();
       auto queueSize{
           getRuntimeParameter<&RuntimeParameters::lazyIndexScanQueueSize_>()};
-      auto producer{std::bind(&Generator::readAndDecompressBlock, this)};
+      concurrentReads_ = getRuntimeParameter<
+          &RuntimeParameters::lazyIndexScanConcurrentReads_>();
+      maxNumBlocksToPrefetch_ = getRuntimeParameter<
+          &RuntimeParameters::lazyIndexScanMaxNumPrefetchedBlocks_>();
+      numBlocksToPrefetch_ = std::min<size_t>(maxNumBlocksToPrefetch_, 1);
+      // The blocks are read and decompressed by the threads of the `queue_`,
+      // which record their spans with the tracer of the consumer.
+      auto producer = [this,
+                       tracer = ad_utility::timer::SpanTracer::active()]() {
+        ad_utility::timer::SpanTracer::Activation activation{tracer};
+        return readAndDecompressBlock();
+      };
 
       // Prepare queue for reading and decompressing blocks concurrently using
       // `numThreads` threads.
@@ -192,6 +331,42 @@ CompressedRelationReader::asyncParallelBlockGenerator(
           queueSize, numThreads, producer);
     }
 
+    // Prefetch the next `numBlocksToPrefetch_` blocks after the
+    // `blockMetadataIterator_` that have not been prefetched yet. Must be
+    // called while holding the `blockIteratorMutex_`.
+    void prefetchNextBlocks() {
+      auto numBlocksLeft =
+          static_cast<size_t>(endBlock_ - blockMetadataIterator_);
+      auto prefetchTarget =
+          blockMetadataIterator_ +
+          std::min<size_t>(numBlocksToPrefetch_, numBlocksLeft);
+      prefetchEnd_ = std::max(prefetchEnd_, blockMetadataIterator_);
+      for (; prefetchEnd_ < prefetchTarget; ++prefetchEnd_) {
+        if (cancellationHandle_->isCancelled()) {
+          return;
+        }
+        if (!scanConfig_.graphFilter_.canBlockBeSkipped(*prefetchEnd_)) {
+          reader_->prefetchBlock(*prefetchEnd_, scanConfig_.scanColumns_);
+        }
+      }
+    }
+
+    // Adapt the number of prefetched blocks to the speed of the consumer: If
+    // the consumer had to wait for the next block (the scan is I/O bound), we
+    // prefetch more blocks, else we slowly reduce the number of prefetched
+    // blocks to not waste the page cache.
+    void adaptPrefetching(ad_utility::Timer::Duration waitingTime) {
+      static constexpr auto maxWaitingTimeWithoutIoStall =
+          std::chrono::microseconds{100};
+      size_t numBlocks = numBlocksToPrefetch_;
+      if (waitingTime > maxWaitingTimeWithoutIoStall) {
+        numBlocks = std::min(2 * numBlocks + 1, maxNumBlocksToPrefetch_);
+      } else if (numBlocks > 1) {
+        --numBlocks;
+      }
+      numBlocksToPrefetch_ = numBlocks;
+    }
+
     std::optional<
         std::pair<size_t, std::optional<DecompressedBlockAndMetadata>>>
     readAndDecompressBlock() {
@@ -211,21 +386,27 @@ CompressedRelationReader::asyncParallelBlockGenerator(
       // the iterator.
       auto myIndex = static_cast<size_t>(blockMetadataIterator_ - beginBlock_);
       ++blockMetadataIterator_;
+      prefetchNextBlocks();
       if (scanConfig_.graphFilter_.canBlockBeSkipped(blockMetadata)) {
         return std::pair{myIndex, std::nullopt};
       }
-      // Note: the reading of the blockMetadata could also happen without
-      // holding the lock. We still perform it inside the lock to avoid
-      // contention of the file. On a fast SSD we could possibly change this,
-      // but this has to be investigated.
-      auto compressedBlock = reader_->readCompressedBlockFromFile(
+      // Note: By default, the reading of the block happens inside the lock to
+      // avoid contention of the file. On fast SSDs, the device is only
+      // saturated if many reads are in flight at the same time, which is
+      // achieved by reading concurrently from all the worker threads (the
+      // reads use `pread` and are therefore thread-safe).
+      if (concurrentReads_) {
+        lock.unlock();
+      }
+      auto compressedBlock = reader_->readBlockFromCacheOrFile(
           blockMetadata, scanConfig_.scanColumns_);
 
-      lock.unlock();
+      if (lock.owns_lock()) {
+        lock.unlock();
+      }
       auto decompressedBlockAndMetadata =
-          reader_->decompressAndPostprocessBlock(compressedBlock,
-                                                 blockMetadata.numRows_,
-                                                 scanConfig_, blockMetadata);
+          reader_->decompressAndPostprocessBlock(compressedBlock, scanConfig_,
+                                                 blockMetadata);
       return std::pair{myIndex,
                        std::optional{std::move(decompressedBlockAndMetadata)}};
     };
@@ -239,9 +420,14 @@ CompressedRelationReader::asyncParallelBlockGenerator(
       // available. Stop when all the blocks have been yielded or the LIMIT of
       // the query is reached. Keep track of various statistics.
       while (true) {
+        auto waitingTimeBefore = popTimer_.value();
         popTimer_.cont();
         auto&& item{queue_.get()};  // copy elision
         popTimer_.stop();
+        auto waitingTime = popTimer_.value() - waitingTimeBefore;
+        adaptPrefetching(waitingTime);
+        totalLazyScanBlockingTime().fetch_add(waitingTime.count(),
+                                              std::memory_order_relaxed);
 
         details().blockingTime_ = popTimer_.msecs();
 
@@ -358,16 +544,32 @@ bool CompressedRelationReader::FilterDuplicatesAndGraphs::postprocessBlock(
   return filteredByGraph || filteredByDuplicates;
 }
 
+// _____________________________________________________________________________
+bool CompressedRelationReader::FilterDuplicatesAndGraphs::mayModifyBlock(
+    const CompressedBlockMetadata& blockMetadata) const {
+  return blockNeedsFilteringByGraph(blockMetadata) ||
+         blockMetadata.containsDuplicatesWithDifferentGraphs_;
+}
+
 // ______________________________________________________________________________
 bool CompressedRelationReader::FilterDuplicatesAndGraphs::canBlockBeSkipped(
     const CompressedBlockMetadata& block) const {
   if (graphFilter_.areAllGraphsAllowed()) {
     return false;
   }
-  if (!block.graphInfo_.has_value()) {
+  if (block.graphInfo_.has_value()) {
+    return ql::ranges::none_of(block.graphInfo_.value(),
+                               isGraphAllowedLambda());
+  }
+  // The block contains many graphs, but if only a few graphs are allowed,
+  // they might all be missing from the Bloom filter.
+  const auto* whitelist = graphFilter_.getWhitelist();
+  if (whitelist == nullptr) {
     return false;
   }
-  return ql::ranges::none_of(block.graphInfo_.value(), isGraphAllowedLambda());
+  return ql::ranges::none_of(*whitelist, [&block](Id graph) {
+    return block.graphBloomFilter_.mayContain(graph);
+  });
 }
 
 // _____________________________________________________________________________
@@ -378,7 +580,8 @@ CompressedRelationReader::lazyScan(
     ColumnIndices additionalColumns,
     const CancellationHandle& cancellationHandle,
     const LocatedTriplesPerBlock& locatedTriplesPerBlock,
-    const LimitOffsetClause& limitOffset) const {
+    const LimitOffsetClause& limitOffset,
+    std::optional<ql::span<const Id>> firstColumnKeys) const {
   AD_CONTRACT_CHECK(cancellationHandle);
 
   if (relevantBlockMetadata.empty()) {
@@ -536,6 +739,12 @@ CompressedRelationReader::lazyScan(
 
   auto config =
       getScanConfig(scanSpec, additionalColumns, locatedTriplesPerBlock);
+  // The keys can only be applied if the first scanned column is a column of
+  // the triple and not one of the `additionalColumns`. With a LIMIT or OFFSET,
+  // the skipped rows would wrongly not be counted.
+  if (!scanSpec.col2Id().has_value() && limitOffset.isUnconstrained()) {
+    config.firstColumnKeys_ = firstColumnKeys;
+  }
 
   return IdTableGeneratorInputRange{Generator{
       scanSpec, std::move(relevantBlockMetadata), additionalColumns,
@@ -547,10 +756,8 @@ IdTable CompressedRelationReader::readBlockWithoutLocatedTriples(
     CompressedBlockMetadata block, ColumnIndices additionalColumns) const {
   auto config = getScanConfig({std::nullopt, std::nullopt, std::nullopt},
                               std::move(additionalColumns), {});
-  CompressedBlock compressedColumns =
-      readCompressedBlockFromFile(block, config.scanColumns_);
-  auto decompressedBlock = decompressBlock(compressedColumns, block.numRows_);
-  return decompressedBlock;
+  auto compressedColumns = readBlockFromCacheOrFile(block, config.scanColumns_);
+  return decompressBlock(compressedColumns, block, config.scanColumns_);
 }
 
 // _____________________________________________________________________________
@@ -635,51 +842,78 @@ auto CompressedRelationReader::getBlocksForJoin(
     return getRelevantIdFromTriple(block.lastTriple_, metadataAndBlocks) < id;
   };
 
-  std::vector<CompressedBlockMetadata> result;
-  const auto& mdView = metadataAndBlocks.getBlockMetadataView();
-
+  // The blocks are traversed range by range, and the current position is
+  // `blockIt` in `ranges[rangeIdx]`. `rangeIdx == ranges.size()` means that all
+  // the blocks have been handled.
+  const auto& ranges = metadataAndBlocks.blockMetadata_;
+  size_t rangeIdx = 0;
+  BlockMetadataIt blockIt = ranges.front().begin();
   auto [colIt, colEnd] = getBeginAndEnd(joinColumn);
-  auto [blockIt, blockEnd] = getBeginAndEnd(mdView);
   GetBlocksForJoinResult res;
 
-  // Manually count the number of blocks that have been fully processed in the
-  // `mdView`. This includes blocks that are returned as part of the result as
-  // well as blocks that are completely skipped, because they are
-  // `< joinColumn.back()` but don't match any of the entries in the
-  // `joinColumn`.
-  auto& blockIdx = res.numHandledBlocks;
-  while (true) {
+  // Skip all the blocks from the current position for which `pred` is true,
+  // which is a prefix of the remaining blocks, as the blocks are sorted, and
+  // call `onSkippedBlocks(begin, end)` for the skipped blocks of each range.
+  // The search is exponential, so the cost only grows logarithmically with the
+  // number of skipped blocks. This is important if the `joinColumn` is much
+  // smaller than the number of blocks (e.g. for a small `VALUES` clause that
+  // is joined with a large relation). Additionally, count the number of
+  // blocks that have been fully processed. This includes blocks that are
+  // returned as part of the result as well as blocks that are completely
+  // skipped, because they are `< joinColumn.back()` but don't match any of the
+  // entries in the `joinColumn`.
+  auto skipBlocksWhile = [&](const auto& pred, const auto& onSkippedBlocks) {
+    while (rangeIdx < ranges.size()) {
+      auto rangeEnd = ranges[rangeIdx].end();
+      auto next = ad_utility::gallopingPartitionPoint(blockIt, rangeEnd, pred);
+      onSkippedBlocks(blockIt, next);
+      res.numHandledBlocks += static_cast<size_t>(next - blockIt);
+      blockIt = next;
+      if (next != rangeEnd) {
+        return;
+      }
+      ++rangeIdx;
+      if (rangeIdx < ranges.size()) {
+        blockIt = ranges[rangeIdx].begin();
+      }
+    }
+  };
+  auto noBlocks = [](const CompressedBlockMetadata&) { return false; };
+  // Skip the empty ranges at the beginning.
+  skipBlocksWhile(noBlocks, ad_utility::noop);
+
+  while (rangeIdx < ranges.size()) {
     // Skip all IDs in the `joinColumn` that are strictly smaller than any
     // block that hasn't been handled so far.
-    while (colIt != colEnd && idLessThanBlock(*colIt, *blockIt)) {
-      ++colIt;
-    }
+    colIt = ad_utility::gallopingPartitionPoint(
+        colIt, colEnd, [&blockIt, &idLessThanBlock](Id id) {
+          return idLessThanBlock(id, *blockIt);
+        });
     if (colIt == colEnd) {
       return res;
     }
 
     // At this point, `*blockIt <= *colIt`.
     // Now skip all blocks that are `< *colIt`.
-    while (blockIt != blockEnd && blockLessThanId(*blockIt, *colIt)) {
-      ++blockIt;
-      ++blockIdx;
-    }
-    if (blockIt == blockEnd) {
-      return res;
-    }
+    skipBlocksWhile(
+        [&colIt, &blockLessThanId](const CompressedBlockMetadata& block) {
+          return blockLessThanId(block, *colIt);
+        },
+        ad_utility::noop);
+
     // Now it holds that `*blockIt >= *colIt`. As the entries in the
     // `joinColumn` as well as the blocks are sorted, it suffices to
     // additionally find the values where `*blockIt <= *colIt` to find
     // possibly matching blocks.
-    while (blockIt != blockEnd && !idLessThanBlock(*colIt, *blockIt)) {
-      res.matchingBlocks_.push_back(*blockIt);
-      ++blockIt;
-      ++blockIdx;
-    }
-    if (blockIt == blockEnd) {
-      return res;
-    }
+    skipBlocksWhile(
+        [&colIt, &idLessThanBlock](const CompressedBlockMetadata& block) {
+          return !idLessThanBlock(*colIt, block);
+        },
+        [&res](BlockMetadataIt begin, BlockMetadataIt end) {
+          res.matchingBlocks_.insert(res.matchingBlocks_.end(), begin, end);
+        });
   }
+  return res;
 }
 
 // _____________________________________________________________________________
@@ -765,7 +999,8 @@ IdTable CompressedRelationReader::scan(
     ColumnIndicesRef additionalColumns,
     const CancellationHandle& cancellationHandle,
     const LocatedTriplesPerBlock& locatedTriplesPerBlock,
-    const LimitOffsetClause& limitOffset) const {
+    const LimitOffsetClause& limitOffset,
+    LazyScanMetadata* scanMetadata) const {
   const auto& scanSpec = scanSpecAndBlocks.scanSpec_;
   auto columnIndices = prepareColumnIndices(scanSpec, additionalColumns);
   IdTable result(columnIndices.size(), allocator_);
@@ -780,14 +1015,18 @@ IdTable CompressedRelationReader::scan(
   }
   result.reserve(upperBoundSize);
 
-  for (const auto& block : lazyScan(
-           scanSpec,
-           convertBlockMetadataRangesToVector(scanSpecAndBlocks.blockMetadata_),
-           {additionalColumns.begin(), additionalColumns.end()},
-           cancellationHandle, locatedTriplesPerBlock, limitOffset)) {
+  auto blocks = lazyScan(
+      scanSpec,
+      convertBlockMetadataRangesToVector(scanSpecAndBlocks.blockMetadata_),
+      {additionalColumns.begin(), additionalColumns.end()}, cancellationHandle,
+      locatedTriplesPerBlock, limitOffset);
+  for (const auto& block : blocks) {
     result.insertAtEnd(block);
   }
   cancellationHandle->throwIfCancelled();
+  if (scanMetadata != nullptr) {
+    *scanMetadata = blocks.details();
+  }
   return result;
 }
 
@@ -953,7 +1192,11 @@ std::pair<size_t, size_t> CompressedRelationReader::getResultSizeImpl(
       ql::ranges::subrange{beginBlock, endBlock}, [&](const auto& block) {
         const auto [ins, del] =
             locatedTriplesPerBlock.numTriples(block.blockIndex_);
-        if (!exactSize || (ins == 0 && del == 0)) {
+        // A block without located triples doesn't have to be read if the
+        // graph filter and the elimination of duplicates from different graphs
+        // don't change it.
+        if (!exactSize || (ins == 0 && del == 0 &&
+                           !config.graphFilter_.mayModifyBlock(block))) {
           inserted += ins;
           deleted += del;
           numResults += block.numRows_;
@@ -1132,31 +1375,133 @@ void CompressedRelationWriter::writeBufferedRelationsToSingleBlock() {
   smallRelationsBuffer_.reserve(2 * blocksize());
 }
 
+namespace {
+// The pool of buffers for compressed columns of the current thread (see
+// `CompressedOrCachedBlock`), and its maximal size.
+constexpr size_t maxNumPooledColumnBuffers = 16;
+std::vector<std::vector<char>>& columnBufferPool() {
+  thread_local std::vector<std::vector<char>> pool;
+  return pool;
+}
+}  // namespace
+
 // _____________________________________________________________________________
-CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
+CompressedRelationReader::CompressedOrCachedBlock::~CompressedOrCachedBlock() {
+  auto& pool = columnBufferPool();
+  for (auto& buffer : compressedColumns_) {
+    if (pool.size() >= maxNumPooledColumnBuffers) {
+      return;
+    }
+    if (buffer.capacity() > 0) {
+      buffer.clear();
+      pool.push_back(std::move(buffer));
+    }
+  }
+}
+
+// _____________________________________________________________________________
+auto CompressedRelationReader::readBlockFromCacheOrFile(
     const CompressedBlockMetadata& blockMetaData,
-    ColumnIndicesRef columnIndices) const {
-  CompressedBlock compressedBuffer;
-  compressedBuffer.resize(columnIndices.size());
+    ColumnIndicesRef columnIndices) const -> CompressedOrCachedBlock {
+  ad_utility::timer::TraceSpan span{"scan", "readBlock"};
+  auto& cache = DecompressedBlockCache::get();
+  CompressedOrCachedBlock result;
+  result.compressedColumns_.resize(columnIndices.size());
+  result.cachedColumns_.resize(columnIndices.size());
   // TODO<C++23> Use `ql::views::zip`
-  for (size_t i = 0; i < compressedBuffer.size(); ++i) {
+  for (size_t i = 0; i < columnIndices.size(); ++i) {
     const auto& offset =
         blockMetaData.getOffsetAndCompressedSizeForColumn(columnIndices[i]);
-    auto& currentCol = compressedBuffer[i];
+    // Empty columns (e.g. of empty blocks) are not stored in the cache.
+    if (offset.compressedSize_ > 0) {
+      result.cachedColumns_[i] =
+          cache.lookup({fileIdForCache_, offset.offsetInFile_});
+    }
+    if (result.cachedColumns_[i] != nullptr) {
+      continue;
+    }
+    auto& currentCol = result.compressedColumns_[i];
+    if (auto& pool = columnBufferPool(); !pool.empty()) {
+      currentCol = std::move(pool.back());
+      pool.pop_back();
+    }
     currentCol.resize(offset.compressedSize_);
     file_.read(currentCol.data(), offset.compressedSize_, offset.offsetInFile_);
   }
-  return compressedBuffer;
+  return result;
+}
+
+// _____________________________________________________________________________
+void CompressedRelationReader::prefetchBlock(
+    const CompressedBlockMetadata& blockMetaData,
+    ColumnIndicesRef columnIndices) const {
+  for (auto columnIndex : columnIndices) {
+    const auto& offset =
+        blockMetaData.getOffsetAndCompressedSizeForColumn(columnIndex);
+    if (offset.compressedSize_ > 0) {
+      file_.adviseWillNeed(offset.offsetInFile_, offset.compressedSize_);
+    }
+  }
+}
+
+// ____________________________________________________________________________
+// Return true iff the sorted `column` contains at least one of the sorted
+// `keys`.
+static bool containsAnyKey(ql::span<const Id> column,
+                           ql::span<const Id> keys) {
+  if (column.empty()) {
+    return false;
+  }
+  // Only the keys in the range of the `column` are relevant.
+  auto keyIt = ql::ranges::lower_bound(keys, column.front());
+  auto keyEnd = ql::ranges::upper_bound(keys, column.back());
+  auto colIt = column.begin();
+  while (colIt != column.end() && keyIt < keyEnd) {
+    if (*colIt < *keyIt) {
+      ++colIt;
+    } else if (*keyIt < *colIt) {
+      ++keyIt;
+    } else {
+      return true;
+    }
+  }
+  return false;
 }
 
 // ____________________________________________________________________________
 DecompressedBlock CompressedRelationReader::decompressBlock(
-    const CompressedBlock& compressedBlock, size_t numRowsToRead) const {
-  DecompressedBlock decompressedBlock{compressedBlock.size(), allocator_};
+    const CompressedOrCachedBlock& block,
+    const CompressedBlockMetadata& blockMetaData,
+    ColumnIndicesRef columnIndices,
+    std::optional<ql::span<const Id>> firstColumnKeys) const {
+  ad_utility::timer::TraceSpan span{"scan", "decompressBlock"};
+  auto& cache = DecompressedBlockCache::get();
+  const size_t numRowsToRead = blockMetaData.numRows_;
+  DecompressedBlock decompressedBlock{columnIndices.size(), allocator_};
   decompressedBlock.resize(numRowsToRead);
-  for (size_t i = 0; i < compressedBlock.size(); ++i) {
+  for (size_t i = 0; i < columnIndices.size(); ++i) {
     auto col = decompressedBlock.getColumn(i);
-    decompressColumn(compressedBlock[i], numRowsToRead, col.data());
+    if (const auto& cachedColumn = block.cachedColumns_[i]) {
+      AD_CORRECTNESS_CHECK(cachedColumn->size() == numRowsToRead);
+      ql::ranges::copy(*cachedColumn, col.begin());
+    } else {
+      const auto& offset =
+          blockMetaData.getOffsetAndCompressedSizeForColumn(columnIndices[i]);
+      decompressColumn(block.compressedColumns_[i], offset.codec_,
+                       getDictionary(columnIndices[i]), numRowsToRead,
+                       col.data());
+      if (cache.isEnabled() && offset.compressedSize_ > 0) {
+        cache.insert({fileIdForCache_, offset.offsetInFile_},
+                     DecompressedBlockCache::Column(col.begin(), col.end()));
+      }
+    }
+    // Late decompression: Only decompress the remaining columns if the first
+    // column contains at least one of the `firstColumnKeys`.
+    if (i == 0 && firstColumnKeys.has_value() &&
+        !containsAnyKey(col, firstColumnKeys.value())) {
+      decompressedBlock.clear();
+      return decompressedBlock;
+    }
   }
   return decompressedBlock;
 }
@@ -1164,10 +1509,20 @@ DecompressedBlock CompressedRelationReader::decompressBlock(
 // ____________________________________________________________________________
 DecompressedBlockAndMetadata
 CompressedRelationReader::decompressAndPostprocessBlock(
-    const CompressedBlock& compressedBlock, size_t numRowsToRead,
+    const CompressedOrCachedBlock& block,
     const CompressedRelationReader::ScanImplConfig& scanConfig,
     const CompressedBlockMetadata& metadata) const {
-  auto decompressedBlock = decompressBlock(compressedBlock, numRowsToRead);
+  // The late decompression (see `ScanImplConfig::firstColumnKeys_`) is not
+  // applied to blocks with updates, because the located triples can change
+  // the first column.
+  auto firstColumnKeys =
+      scanConfig.locatedTriples_.containsTriples(metadata.blockIndex_)
+          ? std::nullopt
+          : scanConfig.firstColumnKeys_;
+  auto decompressedBlock = decompressBlock(
+      block, metadata, scanConfig.scanColumns_, firstColumnKeys);
+  bool onlyFirstColumnDecompressed =
+      firstColumnKeys.has_value() && decompressedBlock.empty();
   auto [numIndexColumns, includeGraphColumn] =
       prepareLocatedTriples(scanConfig.scanColumns_);
   bool hasUpdates = false;
@@ -1186,19 +1541,37 @@ CompressedRelationReader::decompressAndPostprocessBlock(
     // extra column.
     scanConfig.graphFilter_.deleteGraphColumnIfNecessary(decompressedBlock);
   }
-  return {std::move(decompressedBlock), wasPostprocessed, hasUpdates};
+  size_t numBytesRead = 0;
+  size_t numBytesDecompressed = 0;
+  for (size_t i = 0; i < block.compressedColumns_.size(); ++i) {
+    if (!block.cachedColumns_[i]) {
+      numBytesRead += block.compressedColumns_[i].size();
+      if (i == 0 || !onlyFirstColumnDecompressed) {
+        numBytesDecompressed += metadata.numRows_ * sizeof(Id);
+      }
+    }
+  }
+  return {std::move(decompressedBlock), wasPostprocessed, hasUpdates,
+          numBytesRead, numBytesDecompressed, onlyFirstColumnDecompressed};
 }
 
 // ____________________________________________________________________________
-template <typename Iterator>
 void CompressedRelationReader::decompressColumn(
-    const std::vector<char>& compressedBlock, size_t numRowsToRead,
-    Iterator iterator) {
-  auto numBytesActuallyRead = ZstdWrapper::decompressToBuffer(
-      compressedBlock.data(), compressedBlock.size(), iterator,
-      numRowsToRead * sizeof(*iterator));
-  static_assert(sizeof(Id) == sizeof(*iterator));
-  AD_CORRECTNESS_CHECK(numRowsToRead * sizeof(Id) == numBytesActuallyRead);
+    const std::vector<char>& compressedBlock,
+    qlever::columnCodec::ColumnCodec codec, const ZstdDictionary* dictionary,
+    size_t numRowsToRead, Id* result) {
+  qlever::columnCodec::decode(codec, compressedBlock, {result, numRowsToRead},
+                              dictionary);
+}
+
+// ____________________________________________________________________________
+const ZstdDictionary* CompressedRelationReader::getDictionary(
+    ColumnIndex columnIndex) const {
+  if (dictionaries_ == nullptr || columnIndex >= dictionaries_->size()) {
+    return nullptr;
+  }
+  const auto& dictionary = (*dictionaries_)[columnIndex];
+  return dictionary.has_value() ? &dictionary.value() : nullptr;
 }
 
 // ____________________________________________________________________________
@@ -1209,23 +1582,77 @@ CompressedRelationReader::readAndDecompressBlock(
   if (scanConfig.graphFilter_.canBlockBeSkipped(blockMetaData)) {
     return std::nullopt;
   }
-  CompressedBlock compressedColumns =
-      readCompressedBlockFromFile(blockMetaData, scanConfig.scanColumns_);
-  const auto numRowsToRead = blockMetaData.numRows_;
-  return decompressAndPostprocessBlock(compressedColumns, numRowsToRead,
-                                       scanConfig, blockMetaData);
+  auto compressedColumns =
+      readBlockFromCacheOrFile(blockMetaData, scanConfig.scanColumns_);
+  return decompressAndPostprocessBlock(compressedColumns, scanConfig,
+                                       blockMetaData);
 }
 
 // ____________________________________________________________________________
 CompressedBlockMetadata::OffsetAndCompressedSize
-CompressedRelationWriter::compressAndWriteColumn(ql::span<const Id> column) {
-  std::vector<char> compressedBlock = ZstdWrapper::compress(
-      (void*)(column.data()), column.size() * sizeof(column[0]));
+CompressedRelationWriter::compressAndWriteColumn(
+    ql::span<const Id> column, const ZstdDictionary* dictionary) {
+  auto [codec, compressedBlock] =
+      qlever::columnCodec::encode(column, compressionLevel_, dictionary);
   auto compressedSize = compressedBlock.size();
   auto file = outfile_.wlock();
   auto offsetInFile = file->tell();
   file->write(compressedBlock.data(), compressedBlock.size());
-  return {offsetInFile, compressedSize};
+  return {offsetInFile, compressedSize, codec};
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const qlever::columnCodec::ZstdDictionaries>
+CompressedRelationWriter::addSampleAndGetDictionaries(const IdTable& block) {
+  using namespace qlever::columnCodec;
+  if (block.numRows() > maxNumIdsForDictionary) {
+    return nullptr;
+  }
+  auto training = dictionaryTraining_.wlock();
+  if (training->dictionaries_ != nullptr ||
+      training->numSampleBlocks_ >= numSampleBlocksForDictionaries) {
+    return training->dictionaries_;
+  }
+  auto& samples = training->samplesPerColumn_;
+  samples.resize(block.numColumns());
+  for (size_t i = 0; i < block.numColumns(); ++i) {
+    auto column = block.getColumn(i);
+    auto begin = reinterpret_cast<const char*>(column.data());
+    samples[i].emplace_back(begin, begin + column.size() * sizeof(Id));
+  }
+  if (++training->numSampleBlocks_ < numSampleBlocksForDictionaries) {
+    return nullptr;
+  }
+  // We have enough samples, train the dictionaries. This happens only once per
+  // permutation, so it is fine to hold the lock while doing so.
+  auto dictionaries = std::make_shared<ZstdDictionaries>();
+  bool hasDictionary = false;
+  for (const auto& samplesOfColumn : samples) {
+    dictionaries->push_back(ZstdDictionary::train(
+        samplesOfColumn, maxDictionarySize, compressionLevel_));
+    hasDictionary |= dictionaries->back().has_value();
+  }
+  samples.clear();
+  samples.shrink_to_fit();
+  if (hasDictionary) {
+    training->dictionaries_ = std::move(dictionaries);
+  }
+  return training->dictionaries_;
+}
+
+// _____________________________________________________________________________
+void CompressedRelationWriter::writeDictionaries(
+    const std::string& permutationFilename) {
+  auto filename =
+      qlever::columnCodec::getDictionariesFilename(permutationFilename);
+  auto dictionaries = dictionaryTraining_.wlock()->dictionaries_;
+  if (dictionaries != nullptr) {
+    qlever::columnCodec::writeDictionaries(*dictionaries, filename);
+  } else if (std::filesystem::exists(filename)) {
+    // The file is from a previous build of an index with the same name, and
+    // would otherwise be used for this permutation.
+    ad_utility::deleteFile(filename);
+  }
 }
 
 // _____________________________________________________________________________
@@ -1236,9 +1663,14 @@ void CompressedRelationWriter::compressAndWriteBlock(Id firstCol0Id,
   auto timer = blockWriteQueueTimer_.startMeasurement();
   blockWriteQueue_.push([this, block = std::move(block), firstCol0Id,
                          lastCol0Id, invokeCallback]() mutable {
+    auto dictionaries = addSampleAndGetDictionaries(block);
     std::vector<CompressedBlockMetadata::OffsetAndCompressedSize> offsets;
-    for (const auto& column : block.getColumns()) {
-      offsets.push_back(compressAndWriteColumn(column));
+    for (size_t i = 0; i < block.numColumns(); ++i) {
+      const ZstdDictionary* dictionary = nullptr;
+      if (dictionaries != nullptr && (*dictionaries)[i].has_value()) {
+        dictionary = &(*dictionaries)[i].value();
+      }
+      offsets.push_back(compressAndWriteColumn(block.getColumn(i), dictionary));
     }
     AD_CORRECTNESS_CHECK(!offsets.empty());
     auto numRows = block.numRows();
@@ -1248,13 +1680,28 @@ void CompressedRelationWriter::compressAndWriteBlock(Id firstCol0Id,
     AD_CORRECTNESS_CHECK(lastCol0Id == last[0]);
 
     auto [hasDuplicates, graphInfo] = getGraphInfo(block);
+    std::optional<CompressedBlockMetadata::TripleBloomFilter>
+        tripleBloomFilter;
+    if (tripleBloomFilterBitsPerTriple_ > 0) {
+      tripleBloomFilter = CompressedBlockMetadata::TripleBloomFilter::fromBlock(
+          block, tripleBloomFilterBitsPerTriple_);
+    }
+    using Stats = CompressedBlockMetadata::ColumnStatistics;
+    CompressedBlockMetadata::ColumnStatisticsPerColumn columnStatistics{
+        Stats::fromColumn(block.getColumn(0)),
+        Stats::fromColumn(block.getColumn(1)),
+        Stats::fromColumn(block.getColumn(2))};
     blockBuffer_.wlock()->emplace_back(CompressedBlockMetadataNoBlockIndex{
         std::move(offsets),
         numRows,
         {first[0], first[1], first[2], first[3]},
         {last[0], last[1], last[2], last[3]},
         std::move(graphInfo),
-        hasDuplicates});
+        hasDuplicates,
+        columnStatistics,
+        CompressedBlockMetadata::GraphBloomFilter::fromColumn(
+            block.getColumn(ADDITIONAL_COLUMN_GRAPH_ID)),
+        std::move(tripleBloomFilter)});
     if (invokeCallback && smallBlocksCallback_) {
       std::invoke(smallBlocksCallback_, std::move(block));
     }
@@ -1283,11 +1730,44 @@ CompressedRelationReader::convertBlockMetadataRangesToVector(
 }
 
 // _____________________________________________________________________________
-BlockMetadataRanges CompressedRelationReader::getRelevantBlocks(
-    const ScanSpecification& scanSpec,
-    const BlockMetadataRanges& blockMetadata) {
-  // Get all the blocks  that possibly might contain our pair of col0Id and
-  // col1Id
+BlockMetadataSearchIndex::BlockMetadataSearchIndex(BlockMetadataSpan blocks) {
+  auto getKeys = [&blocks](auto member) {
+    std::vector<Key> keys;
+    keys.reserve(blocks.size());
+    for (const auto& block : blocks) {
+      const PermutedTriple& triple = std::invoke(member, block);
+      keys.push_back({triple.col0Id_, triple.col1Id_, triple.col2Id_});
+    }
+    return keys;
+  };
+  firstTriples_ = ad_utility::EytzingerArray<Key>{
+      getKeys(&CompressedBlockMetadata::firstTriple_)};
+  lastTriples_ = ad_utility::EytzingerArray<Key>{
+      getKeys(&CompressedBlockMetadata::lastTriple_)};
+}
+
+// _____________________________________________________________________________
+size_t BlockMetadataSearchIndex::firstBlockNotBefore(
+    const PermutedTriple& triple) const {
+  return lastTriples_.partitionPoint([tie = triple.tieWithoutGraph()](
+                                         const Key& last) {
+    return last.tie() < tie;
+  });
+}
+
+// _____________________________________________________________________________
+size_t BlockMetadataSearchIndex::firstBlockAfter(
+    const PermutedTriple& triple) const {
+  return firstTriples_.partitionPoint([tie = triple.tieWithoutGraph()](
+                                          const Key& first) {
+    return !(tie < first.tie());
+  });
+}
+
+// Return a `CompressedBlockMetadata` whose `firstTriple_` and `lastTriple_`
+// are the smallest and the largest triple that match the `scanSpec`.
+static CompressedBlockMetadata getSearchKeyForScanSpec(
+    const ScanSpecification& scanSpec) {
   CompressedBlockMetadata key;
 
   auto setOrDefault = [&scanSpec](auto getterA, auto getterB, auto& triple,
@@ -1307,6 +1787,47 @@ BlockMetadataRanges CompressedRelationReader::getRelevantBlocks(
   // We currently don't filter by the graph ID here.
   key.firstTriple_.graphId_ = Id::min();
   key.lastTriple_.graphId_ = Id::max();
+  return key;
+}
+
+// For a fully bound `scanSpec`, remove the blocks from the `resultBlocks`
+// which according to their `TripleBloomFilter` definitely don't contain the
+// triple. There typically is only a single block left, so splitting the
+// ranges is cheap.
+static BlockMetadataRanges removeBlocksWithoutFullyBoundTriple(
+    const ScanSpecification& scanSpec, BlockMetadataRanges resultBlocks) {
+  if (!scanSpec.col2Id().has_value()) {
+    return resultBlocks;
+  }
+  Id col0 = scanSpec.col0Id().value();
+  Id col1 = scanSpec.col1Id().value();
+  Id col2 = scanSpec.col2Id().value();
+  auto mayContainTriple = [&](const CompressedBlockMetadata& block) {
+    return !block.tripleBloomFilter_.has_value() ||
+           block.tripleBloomFilter_->mayContain(col0, col1, col2);
+  };
+  BlockMetadataRanges filteredBlocks;
+  for (const auto& range : resultBlocks) {
+    auto it = range.begin();
+    while (it != range.end()) {
+      it = std::find_if(it, range.end(), mayContainTriple);
+      auto endOfSubrange = std::find_if_not(it, range.end(), mayContainTriple);
+      if (it != endOfSubrange) {
+        filteredBlocks.emplace_back(it, endOfSubrange);
+      }
+      it = endOfSubrange;
+    }
+  }
+  return filteredBlocks;
+}
+
+// _____________________________________________________________________________
+BlockMetadataRanges CompressedRelationReader::getRelevantBlocks(
+    const ScanSpecification& scanSpec,
+    const BlockMetadataRanges& blockMetadata) {
+  // Get all the blocks  that possibly might contain our pair of col0Id and
+  // col1Id
+  CompressedBlockMetadata key = getSearchKeyForScanSpec(scanSpec);
 
   // This comparator only returns true if a block stands completely before
   // another block without any overlap. In other words, the last triple of `a`
@@ -1330,7 +1851,26 @@ BlockMetadataRanges CompressedRelationReader::getRelevantBlocks(
           resultBlocks.emplace_back(result.begin(), result.end());
         }
       });
-  return resultBlocks;
+  return removeBlocksWithoutFullyBoundTriple(scanSpec, std::move(resultBlocks));
+}
+
+// _____________________________________________________________________________
+BlockMetadataRanges CompressedRelationReader::getRelevantBlocks(
+    const ScanSpecification& scanSpec, BlockMetadataSpan blocks,
+    const BlockMetadataSearchIndex& searchIndex) {
+  AD_CONTRACT_CHECK(searchIndex.size() == blocks.size());
+  CompressedBlockMetadata key = getSearchKeyForScanSpec(scanSpec);
+  // The same bounds as the `equal_range` in the function above (the graphs of
+  // the `key` are the smallest and largest `Id`, so it makes no difference
+  // that they are ignored by the `searchIndex`).
+  size_t begin = searchIndex.firstBlockNotBefore(key.firstTriple_);
+  size_t end = searchIndex.firstBlockAfter(key.lastTriple_);
+  AD_CORRECTNESS_CHECK(begin <= end);
+  BlockMetadataRanges resultBlocks;
+  if (begin != end) {
+    resultBlocks.emplace_back(blocks.begin() + begin, blocks.begin() + end);
+  }
+  return removeBlocksWithoutFullyBoundTriple(scanSpec, std::move(resultBlocks));
 }
 
 // _____________________________________________________________________________
@@ -1517,6 +2057,25 @@ ad_utility::TaskQueue<false> CompressedRelationWriter::makeBlockWriteQueue() {
   return ad_utility::TaskQueue<false>{queueSize, threadCount};
 }
 
+// _____________________________________________________________________________
+int CompressedRelationWriter::compressionLevelFromRuntimeParameter() {
+  return static_cast<int>(
+      getRuntimeParameter<&RuntimeParameters::permutationCompressionLevel_>());
+}
+
+// _____________________________________________________________________________
+size_t CompressedRelationWriter::maxBlocksizeFactorFromRuntimeParameter() {
+  return getRuntimeParameter<
+      &RuntimeParameters::permutationMaxBlocksizeFactor_>();
+}
+
+// _____________________________________________________________________________
+size_t
+CompressedRelationWriter::tripleBloomFilterBitsPerTripleFromRuntimeParameter() {
+  return getRuntimeParameter<
+      &RuntimeParameters::permutationTripleBloomFilterBitsPerTriple_>();
+}
+
 // _____________________________________________________________________________
 void CompressedRelationWriter::addBlockForLargeRelation(Id col0Id,
                                                         IdTable relation) {
@@ -1703,7 +2262,8 @@ auto CompressedRelationReader::getScanConfig(
   }();
   FilterDuplicatesAndGraphs graphFilter{scanSpec.graphFilter(),
                                         graphColumnIndex, deleteGraphColumn};
-  return {std::move(columnIndices), std::move(graphFilter), locatedTriples};
+  return {std::move(columnIndices), std::move(graphFilter), locatedTriples,
+          std::nullopt};
 }
 
 // _____________________________________________________________________________
@@ -1811,6 +2371,22 @@ CompressedRelationReader::ScanSpecAndBlocks::ScanSpecAndBlocks(
   sizeBlockMetadata_ = getNumberOfBlockMetadataValues(blockMetadata_);
 }
 
+// _____________________________________________________________________________
+CompressedRelationReader::ScanSpecAndBlocks::ScanSpecAndBlocks(
+    ScanSpecification scanSpec, BlockMetadataSpan blocks,
+    const BlockMetadataSearchIndex& searchIndex)
+    : scanSpec_(std::move(scanSpec)) {
+  if constexpr (ad_utility::areExpensiveChecksEnabled) {
+    checkBlockMetadataInvariantOrderAndUniquenessImpl(blocks);
+  }
+  blockMetadata_ = getRelevantBlocks(scanSpec_, blocks, searchIndex);
+  if constexpr (ad_utility::areExpensiveChecksEnabled) {
+    checkBlockMetadataInvariantBlockConsistencyImpl(
+        getBlockMetadataView(), scanSpec_.firstFreeColIndex());
+  }
+  sizeBlockMetadata_ = getNumberOfBlockMetadataValues(blockMetadata_);
+}
+
 // _____________________________________________________________________________
 ql::span<const CompressedBlockMetadata>
 CompressedRelationReader::ScanSpecAndBlocks::getBlockMetadataSpan() const {
@@ -1852,6 +2428,13 @@ void CompressedRelationReader::ScanSpecAndBlocks::removePrefix(
   blockMetadata_.erase(blockMetadata_.begin(), it);
 }
 
+// _____________________________________________________________________________
+std::atomic<std::chrono::microseconds::rep>&
+CompressedRelationReader::totalLazyScanBlockingTime() {
+  static std::atomic<std::chrono::microseconds::rep> totalTime{0};
+  return totalTime;
+}
+
 // _____________________________________________________________________________
 void CompressedRelationReader::LazyScanMetadata::update(
     const DecompressedBlockAndMetadata& blockAndMetadata) {
@@ -1861,6 +2444,10 @@ void CompressedRelationReader::LazyScanMetadata::update(
       static_cast<size_t>(blockAndMetadata.containsUpdates_);
   ++numBlocksRead_;
   numElementsRead_ += blockAndMetadata.block_.numRows();
+  numBytesRead_ += blockAndMetadata.numBytesRead_;
+  numBytesDecompressed_ += blockAndMetadata.numBytesDecompressed_;
+  numBlocksWithOnlyFirstColumnDecompressed_ +=
+      static_cast<size_t>(blockAndMetadata.onlyFirstColumnDecompressed_);
 }
 
 // _____________________________________________________________________________
@@ -1884,4 +2471,8 @@ void CompressedRelationReader::LazyScanMetadata::aggregate(
   numBlocksSkippedBecauseOfGraph_ += newValue.numBlocksSkippedBecauseOfGraph_;
   numBlocksPostprocessed_ += newValue.numBlocksPostprocessed_;
   numBlocksWithUpdate_ += newValue.numBlocksWithUpdate_;
+  numBytesRead_ += newValue.numBytesRead_;
+  numBytesDecompressed_ += newValue.numBytesDecompressed_;
+  numBlocksWithOnlyFirstColumnDecompressed_ +=
+      newValue.numBlocksWithOnlyFirstColumnDecompressed_;
 }
@@ -7,6 +7,8 @@
 
 #include <gtest/gtest_prod.h>
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 
 #include "backports/algorithm.h"
@@ -14,10 +16,13 @@
 #include "backports/type_traits.h"
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
+#include "index/ColumnCodec.h"
+#include "index/DecompressedBlockCache.h"
 #include "index/KeyOrder.h"
 #include "index/ScanSpecification.h"
 #include "parser/data/LimitOffsetClause.h"
 #include "util/CancellationHandle.h"
+#include "util/EytzingerArray.h"
 #include "util/File.h"
 #include "util/MemorySize/MemorySize.h"
 #include "util/Serializer/SerializeArrayOrTuple.h"
@@ -48,6 +53,14 @@ struct DecompressedBlockAndMetadata {
   // True iff triples this block had to be merged with the `LocatedTriples`
   // because it contained updates.
   bool containsUpdates_;
+  // The number of bytes that were read from the file for this block, and the
+  // size of these bytes after the decompression. The columns that were found
+  // in the `DecompressedBlockCache` count for neither of them.
+  size_t numBytesRead_ = 0;
+  size_t numBytesDecompressed_ = 0;
+  // True iff only the first column of the block was decompressed, because it
+  // contains none of the `ScanImplConfig::firstColumnKeys_`.
+  bool onlyFirstColumnDecompressed_ = false;
 };
 
 // After compression the columns have different sizes, so we cannot use an
@@ -61,8 +74,12 @@ struct CompressedBlockMetadataNoBlockIndex {
   struct OffsetAndCompressedSize {
     off_t offsetInFile_;
     size_t compressedSize_;
+    // The encoding of the column, see `ColumnCodec.h`.
+    qlever::columnCodec::ColumnCodec codec_ =
+        qlever::columnCodec::ColumnCodec::Zstd;
     QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(OffsetAndCompressedSize,
-                                                offsetInFile_, compressedSize_)
+                                                offsetInFile_, compressedSize_,
+                                                codec_)
   };
 
   using GraphInfo = std::optional<std::vector<Id>>;
@@ -125,6 +142,113 @@ struct CompressedBlockMetadataNoBlockIndex {
   // blocks.
   bool containsDuplicatesWithDifferentGraphs_;
 
+  // Per-column statistics ("zone maps") of the triples in this block. In
+  // contrast to `firstTriple_` and `lastTriple_`, these are also meaningful
+  // for the columns by which the block is not sorted, and can thus be used to
+  // prefilter blocks on an arbitrary column (see
+  // `PrefilterExpression::evaluateWithColumnStatistics`).
+  struct ColumnStatistics {
+    // The smallest and largest `Id` in the column (inclusive).
+    Id min_;
+    Id max_;
+    // Bit `i` is set iff the column contains an `Id` with datatype
+    // `static_cast<Datatype>(i)`.
+    uint64_t datatypeBitmask_ = 0;
+
+    // Compute the statistics for the given (non-empty) `column`.
+    static ColumnStatistics fromColumn(ql::span<const Id> column);
+
+    // Widen the statistics such that they also cover `id`.
+    void add(Id id);
+
+    // Return true iff the column contains an `Id` with the given `datatype`.
+    bool containsDatatype(Datatype datatype) const {
+      return (datatypeBitmask_ >> static_cast<size_t>(datatype)) & 1u;
+    }
+
+    QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(ColumnStatistics, min_, max_,
+                                                datatypeBitmask_)
+
+    template <typename T>
+    friend std::true_type allowTrivialSerialization(ColumnStatistics, T);
+  };
+  // The statistics for `col0`, `col1` and `col2` (in this order). The value
+  // `std::nullopt` means that no statistics are available, e.g. for the last
+  // block which only consists of `LocatedTriples`.
+  using ColumnStatisticsPerColumn = std::array<ColumnStatistics, 3>;
+  std::optional<ColumnStatisticsPerColumn> columnStatistics_ = std::nullopt;
+
+  // A Bloom filter (with a single hash function) over the graphs of the
+  // triples in this block. In contrast to `graphInfo_`, it is also meaningful
+  // for blocks with many different graphs, so that scans that are restricted
+  // to a few (small) graphs can also skip most of those blocks.
+  struct GraphBloomFilter {
+    static constexpr size_t numBits = 256;
+    // By default, all bits are set, which means that no information is
+    // available.
+    std::array<uint64_t, numBits / 64> bits_{~uint64_t{0}, ~uint64_t{0},
+                                             ~uint64_t{0}, ~uint64_t{0}};
+
+    // Compute the filter for the given column of graph `Id`s.
+    static GraphBloomFilter fromColumn(ql::span<const Id> column);
+
+    // Add the `graph` to the filter.
+    void add(Id graph);
+
+    // Return false if the block definitely contains no triple from the
+    // `graph`.
+    bool mayContain(Id graph) const;
+
+    QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(GraphBloomFilter, bits_)
+
+    template <typename T>
+    friend std::true_type allowTrivialSerialization(GraphBloomFilter, T);
+
+   private:
+    // The bit for the `graph`. This is part of the on-disk format, so it
+    // must not depend on the process (like e.g. `absl::Hash`).
+    static size_t bitIndex(Id graph) {
+      return (graph.getBits() * 0x9E3779B97F4A7C15ULL) >> 56;
+    }
+  };
+  GraphBloomFilter graphBloomFilter_;
+
+  // An (optional) Bloom filter over the triples `(col0, col1, col2)` of this
+  // block (the graph is ignored). It allows to skip blocks for fully bound
+  // scans (e.g. `ASK { <s> <p> <o> }`) without reading and decompressing
+  // them. The number of bits is a power of two that is determined by the
+  // number of triples in the block and the runtime parameter
+  // `permutation-triple-bloom-filter-bits-per-triple`.
+  struct TripleBloomFilter {
+    static constexpr size_t numHashFunctions = 3;
+    std::vector<uint64_t> bits_;
+
+    // Compute the filter for the first three columns of the `block`, with
+    // (roughly) `bitsPerTriple` bits per row.
+    static TripleBloomFilter fromBlock(const IdTable& block,
+                                      size_t bitsPerTriple);
+
+    // Add the triple to the filter.
+    void add(Id col0, Id col1, Id col2);
+
+    // Return false if the block definitely doesn't contain the triple.
+    bool mayContain(Id col0, Id col1, Id col2) const;
+
+    QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(TripleBloomFilter, bits_)
+
+    AD_SERIALIZE_FRIEND_FUNCTION(TripleBloomFilter) { serializer | arg.bits_; }
+
+   private:
+    // Call `f(wordIndex, bitInWord)` for each of the `numHashFunctions` bits
+    // of the triple (double hashing). The hash is part of the on-disk format,
+    // so it must not depend on the process (like e.g. `absl::Hash`).
+    template <typename F>
+    void forEachBit(Id col0, Id col1, Id col2, const F& f) const;
+  };
+  // `std::nullopt` means that the block has no Bloom filter, e.g. because it
+  // was disabled when the index was built.
+  std::optional<TripleBloomFilter> tripleBloomFilter_ = std::nullopt;
+
   // Check for constant values in `firstTriple_` and `lastTriple` over all
   // columns `< columnIndex`.
   // Returns `true` if the respective column values of `firstTriple_` and
@@ -144,7 +268,8 @@ struct CompressedBlockMetadataNoBlockIndex {
   QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(
       CompressedBlockMetadataNoBlockIndex, offsetsAndCompressedSize_, numRows_,
       firstTriple_, lastTriple_, graphInfo_,
-      containsDuplicatesWithDifferentGraphs_)
+      containsDuplicatesWithDifferentGraphs_, columnStatistics_,
+      graphBloomFilter_, tripleBloomFilter_)
 
   // Format CompressedBlockMetadata contents for debugging.
   friend std::ostream& operator<<(
@@ -160,6 +285,12 @@ struct CompressedBlockMetadataNoBlockIndex {
     }
     str << "[possibly] contains duplicates: "
         << blockMetadata.containsDuplicatesWithDifferentGraphs_ << '\n';
+    if (blockMetadata.columnStatistics_.has_value()) {
+      for (const auto& stats : blockMetadata.columnStatistics_.value()) {
+        str << "Column statistics: [" << stats.min_ << ", " << stats.max_
+            << "], datatypes: " << stats.datatypeBitmask_ << '\n';
+      }
+    }
     return str;
   }
 };
@@ -199,10 +330,26 @@ struct CompressedBlockMetadata : CompressedBlockMetadataNoBlockIndex {
   }
 };
 
-// Serialization of the `OffsetAndcompressedSize` subclass.
+// Serialization of the `OffsetAndcompressedSize` subclass. The codec is
+// stored in the most significant byte of the compressed size, s.t. indices
+// that were built before the codecs were introduced (and which only use
+// `Zstd = 0`) can still be read.
 AD_SERIALIZE_FUNCTION(CompressedBlockMetadata::OffsetAndCompressedSize) {
+  constexpr size_t codecShift = 56;
   serializer | arg.offsetInFile_;
-  serializer | arg.compressedSize_;
+  if constexpr (ad_utility::serialization::WriteSerializer<S>) {
+    AD_CORRECTNESS_CHECK(arg.compressedSize_ < (size_t{1} << codecShift));
+    size_t sizeAndCodec = arg.compressedSize_ |
+                          (static_cast<size_t>(arg.codec_) << codecShift);
+    serializer | sizeAndCodec;
+  } else {
+    static_assert(ad_utility::serialization::ReadSerializer<S>);
+    size_t sizeAndCodec;
+    serializer | sizeAndCodec;
+    arg.compressedSize_ = sizeAndCodec & ((size_t{1} << codecShift) - 1);
+    arg.codec_ = static_cast<qlever::columnCodec::ColumnCodec>(sizeAndCodec >>
+                                                               codecShift);
+  }
 }
 
 // Serialization of the block metadata.
@@ -222,6 +369,9 @@ AD_SERIALIZE_FUNCTION(CompressedBlockMetadata) {
   serializer | arg.lastTriple_;
   serializer | arg.graphInfo_;
   serializer | arg.containsDuplicatesWithDifferentGraphs_;
+  serializer | arg.columnStatistics_;
+  serializer | arg.graphBloomFilter_;
+  serializer | arg.tripleBloomFilter_;
   serializer | arg.blockIndex_;
 }
 
@@ -235,6 +385,42 @@ using BlockMetadataRange = ql::ranges::subrange<BlockMetadataIt>;
 // Vector containing `BlockMetadataRange`s.
 using BlockMetadataRanges = std::vector<BlockMetadataRange>;
 
+// A compact search index over the first and last triples of a sorted sequence
+// of `CompressedBlockMetadata`. The `CompressedBlockMetadata` are large (and
+// contain pointers to heap memory), so a binary search directly on them causes
+// a cache miss for almost every comparison. This index only stores the triples
+// (without the graph) in the cache-friendly Eytzinger layout (see
+// `EytzingerArray`). It has to be rebuilt when the blocks change.
+class BlockMetadataSearchIndex {
+ public:
+  using PermutedTriple = CompressedBlockMetadata::PermutedTriple;
+
+ private:
+  struct Key {
+    Id col0Id_;
+    Id col1Id_;
+    Id col2Id_;
+    auto tie() const { return std::tie(col0Id_, col1Id_, col2Id_); }
+  };
+  ad_utility::EytzingerArray<Key> firstTriples_;
+  ad_utility::EytzingerArray<Key> lastTriples_;
+
+ public:
+  BlockMetadataSearchIndex() = default;
+  explicit BlockMetadataSearchIndex(BlockMetadataSpan blocks);
+
+  // The number of indexed blocks.
+  size_t size() const { return lastTriples_.size(); }
+
+  // Return the index of the first block, whose `lastTriple_` is not less than
+  // the `triple` (ignoring the graphs), or `size()` if there is no such block.
+  size_t firstBlockNotBefore(const PermutedTriple& triple) const;
+
+  // Return the index of the first block, whose `firstTriple_` is greater than
+  // the `triple` (ignoring the graphs), or `size()` if there is no such block.
+  size_t firstBlockAfter(const PermutedTriple& triple) const;
+};
+
 // The metadata of a whole compressed "relation", where relation refers to a
 // maximal sequence of triples with equal first component (e.g., P for the PSO
 // permutation).
@@ -305,6 +491,33 @@ class CompressedRelationWriter {
   Id currentCol0Id_ = Id::makeUndefined();
   size_t currentRelationPreviousSize_ = 0;
 
+  // The zstd compression level of the columns, determined by the runtime
+  // parameter "permutation-compression-level".
+  int compressionLevel_ = compressionLevelFromRuntimeParameter();
+
+  // The maximal factor by which the blocks of large relations are larger than
+  // the `blocksize()`, determined by the runtime parameter
+  // "permutation-max-blocksize-factor" (see `blocksizeForLargeRelation`).
+  size_t maxBlocksizeFactor_ = maxBlocksizeFactorFromRuntimeParameter();
+
+  // The number of bits per triple of the `TripleBloomFilter` of each block,
+  // determined by the runtime parameter
+  // "permutation-triple-bloom-filter-bits-per-triple". A value of 0 means that
+  // no filters are written.
+  size_t tripleBloomFilterBitsPerTriple_ =
+      tripleBloomFilterBitsPerTripleFromRuntimeParameter();
+
+  // The ZSTD dictionaries of the columns (see `ColumnCodec.h`). They are
+  // trained on the columns of the first small blocks, and then used for all
+  // subsequent small blocks.
+  struct DictionaryTraining {
+    std::vector<std::vector<std::vector<char>>> samplesPerColumn_;
+    size_t numSampleBlocks_ = 0;
+    std::shared_ptr<const qlever::columnCodec::ZstdDictionaries>
+        dictionaries_;
+  };
+  ad_utility::Synchronized<DictionaryTraining> dictionaryTraining_;
+
   ad_utility::TaskQueue<false> blockWriteQueue_ = makeBlockWriteQueue();
   ad_utility::timer::ThreadSafeTimer blockWriteQueueTimer_;
 
@@ -451,6 +664,28 @@ class CompressedRelationWriter {
         size_t{uncompressedBlocksizePerColumn_.getBytes() / sizeof(Id)});
   }
 
+  // The first blocks of a large relation with this many rows in total have the
+  // regular `blocksize()`, only the subsequent blocks are larger.
+  static constexpr size_t numRegularBlocksPerLargeRelation = 8;
+
+  // Return the blocksize (in number of triples) for the next block of a large
+  // relation, of which `numRowsSoFar` rows have already been written (or which
+  // has `numRowsSoFar` rows in total, if this is known in advance). The
+  // blocksize is doubled for each doubling of the size of the relation beyond
+  // `numRegularBlocksPerLargeRelation * blocksize()` rows, up to
+  // `maxBlocksizeFactor_ * blocksize()`. The sizes of the blocks are recorded
+  // in their `CompressedBlockMetadata`, so the reader doesn't need to know
+  // about this policy.
+  size_t blocksizeForLargeRelation(size_t numRowsSoFar) const {
+    size_t factor = 1;
+    size_t threshold = numRegularBlocksPerLargeRelation * blocksize();
+    while (factor < maxBlocksizeFactor_ && numRowsSoFar >= 2 * threshold) {
+      factor *= 2;
+      threshold *= 2;
+    }
+    return std::min(factor, maxBlocksizeFactor_) * blocksize();
+  }
+
  private:
   /// Finish writing all relations which have previously been added, but might
   /// still be in some internal buffer.
@@ -460,18 +695,33 @@ class CompressedRelationWriter {
     auto timer = blockWriteQueueTimer_.startMeasurement();
     blockWriteQueue_.finish();
     timer.stop();
-    outfile_.wlock()->close();
+    auto file = outfile_.wlock();
+    writeDictionaries(file->name());
+    file->close();
   }
 
+  // Write the dictionaries to the dictionaries file of the permutation with
+  // the `permutationFilename`, or delete an outdated dictionaries file if no
+  // dictionaries were trained.
+  void writeDictionaries(const std::string& permutationFilename);
+
+  // If the `block` is small enough, add its columns to the samples of the
+  // `dictionaryTraining_` and train the dictionaries as soon as there are
+  // enough samples. Return the dictionaries with which the `block` is to be
+  // compressed (`nullptr` if there are none yet, or the `block` is too large).
+  std::shared_ptr<const qlever::columnCodec::ZstdDictionaries>
+  addSampleAndGetDictionaries(const IdTable& block);
+
   // Compress the contents of `smallRelationsBuffer_` into a single
   // block and write it to outfile_. Update `currentBlockData_` with the meta
   // data of the written block. Then clear `smallRelationsBuffer_`.
   void writeBufferedRelationsToSingleBlock();
 
-  // Compress the `column` and write it to the `outfile_`. Return the offset and
-  // size of the compressed column in the `outfile_`.
+  // Compress the `column` (using the `dictionary` if specified) and write it
+  // to the `outfile_`. Return the offset and size of the compressed column in
+  // the `outfile_`.
   CompressedBlockMetadata::OffsetAndCompressedSize compressAndWriteColumn(
-      ql::span<const Id> column);
+      ql::span<const Id> column, const ZstdDictionary* dictionary);
 
   // Return the number of columns that is stored inside the blocks.
   size_t numColumns() const { return numColumns_; }
@@ -528,8 +778,20 @@ class CompressedRelationWriter {
   // of threads is determined by the runtime parameter
   // "permutation-writer-num-threads".
   static ad_utility::TaskQueue<false> makeBlockWriteQueue();
+
+  // Read the runtime parameter "permutation-compression-level".
+  static int compressionLevelFromRuntimeParameter();
+
+  // Read the runtime parameter "permutation-max-blocksize-factor".
+  static size_t maxBlocksizeFactorFromRuntimeParameter();
+
+  // Read the runtime parameter
+  // "permutation-triple-bloom-filter-bits-per-triple".
+  static size_t tripleBloomFilterBitsPerTripleFromRuntimeParameter();
   FRIEND_TEST(CompressedRelationWriter,
               isInitializedWithCorrectNumberOfThreads);
+  FRIEND_TEST(CompressedRelationWriter, compressionLevel);
+  FRIEND_TEST(CompressedRelationWriter, blocksizeForLargeRelation);
 };
 
 using namespace std::string_view_literals;
@@ -568,6 +830,12 @@ class CompressedRelationReader {
     // disk, and if this fact can be determined by `blockMetadata` alone.
     bool canBlockBeSkipped(const CompressedBlockMetadata& blockMetadata) const;
 
+    // Return false iff `postprocessBlock` doesn't modify the block specified
+    // by the `blockMetadata`, and if this fact can be determined by the
+    // `blockMetadata` alone. Then the size of the block after postprocessing
+    // is its `numRows_`.
+    bool mayModifyBlock(const CompressedBlockMetadata& blockMetadata) const;
+
     // Delete the `graphColumn_` from `block` if `deleteGraphColumn_` is true.
     void deleteGraphColumnIfNecessary(IdTable& block) const;
 
@@ -596,6 +864,13 @@ class CompressedRelationReader {
     ColumnIndices scanColumns_;
     FilterDuplicatesAndGraphs graphFilter_;
     const LocatedTriplesPerBlock& locatedTriples_;
+    // If set, the caller only needs the rows whose entry in the first of the
+    // `scanColumns_` (which has to be the first free column of the scan) is
+    // one of these sorted keys, for example, because the scan is joined with
+    // them. The remaining rows may or may not be part of the result. For the
+    // complete blocks of a scan, the first column is decompressed first, and
+    // the other columns only if it contains at least one of the keys.
+    std::optional<ql::span<const Id>> firstColumnKeys_ = std::nullopt;
   };
 
   // The specification of scan, together with the blocks on which this scan is
@@ -621,6 +896,11 @@ class CompressedRelationReader {
     ScanSpecAndBlocks(ScanSpecification scanSpec,
                       const BlockMetadataRanges& blockMetadataRanges);
 
+    // Same as above, but for a single span of blocks, for which the relevant
+    // blocks are found using the `searchIndex` of the `blocks`.
+    ScanSpecAndBlocks(ScanSpecification scanSpec, BlockMetadataSpan blocks,
+                      const BlockMetadataSearchIndex& searchIndex);
+
     // Direct view access via `ql::views::join` over all
     // `CompressedBlockMetadata` values contained in `BlockMetadatatRanges
     // blockMetadata_`.
@@ -684,11 +964,18 @@ class CompressedRelationReader {
     // actually yield.
     size_t numElementsRead_ = 0;
     size_t numElementsYielded_ = 0;
+    // See the members of `DecompressedBlockAndMetadata` with the same names.
+    size_t numBytesRead_ = 0;
+    size_t numBytesDecompressed_ = 0;
+    // The number of blocks for which only the first column was decompressed
+    // (see `ScanImplConfig::firstColumnKeys_`).
+    size_t numBlocksWithOnlyFirstColumnDecompressed_ = 0;
     std::chrono::milliseconds blockingTime_ = std::chrono::milliseconds::zero();
 
     // Update this metadata, given the metadata from `blockAndMetadata`.
     // Currently updates: `numBlocksPostprocessed_`, `numBlocksWithUpdate_`,
-    // `numElementsRead_`, and `numBlocksRead_`.
+    // `numElementsRead_`, `numBlocksRead_`, `numBytesRead_`,
+    // `numBytesDecompressed_`, and `numBlocksWithOnlyFirstColumnDecompressed_`.
     void update(const DecompressedBlockAndMetadata& blockAndMetadata);
     // `nullopt` means the block was skipped because of the graph filters, else
     // call the overload directly above.
@@ -709,17 +996,61 @@ class CompressedRelationReader {
   // The file that stores the actual permutations.
   ad_utility::File file_;
 
+  // The ZSTD dictionaries of the columns in the `file_`, `nullptr` if the
+  // permutation has no dictionaries.
+  std::shared_ptr<const qlever::columnCodec::ZstdDictionaries> dictionaries_;
+
   // This setting controls whether filtering on the graph column and
   // deduplication of rows is performed during scanning. Deactivating this is
   // used for materialized views where repeated rows are meaningful.
   bool useGraphPostProcessing_;
 
+  // Identifies the `file_` in the `DecompressedBlockCache`. Readers for the
+  // same file that are created via `makeReaderWithReboundAllocator` share
+  // this ID and therefore also the cached blocks.
+  uint64_t fileIdForCache_;
+
+  // The columns of a single block, as returned by `readBlockFromCacheOrFile`.
+  // For each of the requested columns, either the decompressed column was
+  // found in the `DecompressedBlockCache` (then `cachedColumns_[i]` is set), or
+  // the compressed column was read from disk (then it is stored in
+  // `compressedColumns_[i]`). The buffers of the `compressedColumns_` are
+  // taken from and returned to a small pool per thread, s.t. the many blocks
+  // that are read by the same worker thread don't allocate fresh memory.
+  struct CompressedOrCachedBlock {
+    CompressedBlock compressedColumns_;
+    std::vector<DecompressedBlockCache::ColumnPtr> cachedColumns_;
+
+    CompressedOrCachedBlock() = default;
+    CompressedOrCachedBlock(CompressedOrCachedBlock&&) = default;
+    CompressedOrCachedBlock& operator=(CompressedOrCachedBlock&&) = default;
+    // Return the buffers of the `compressedColumns_` to the pool.
+    ~CompressedOrCachedBlock();
+  };
+
+  CompressedRelationReader(
+      Allocator allocator,
+      std::shared_ptr<const qlever::columnCodec::ZstdDictionaries>
+          dictionaries,
+      ad_utility::File file, bool useGraphPostProcessing,
+      uint64_t fileIdForCache)
+      : allocator_{std::move(allocator)},
+        file_{std::move(file)},
+        dictionaries_{std::move(dictionaries)},
+        useGraphPostProcessing_{useGraphPostProcessing},
+        fileIdForCache_{fileIdForCache} {}
+
  public:
   explicit CompressedRelationReader(Allocator allocator, ad_utility::File file,
                                     bool useGraphPostProcessing = true)
-      : allocator_{std::move(allocator)},
-        file_{std::move(file)},
-        useGraphPostProcessing_{useGraphPostProcessing} {}
+      // Note: The arguments in a braced initializer list are evaluated from
+      // left to right, so the `file` is only moved after its name was used.
+      : CompressedRelationReader{
+            std::move(allocator),
+            qlever::columnCodec::readDictionaries(
+                qlever::columnCodec::getDictionariesFilename(file.name())),
+            std::move(file), useGraphPostProcessing,
+            DecompressedBlockCache::getUniqueFileId()} {}
 
   // Helper function that enables a comparison of a triple with an `Id` in the
   // function `getBlocksForJoin` below.  If the given triple matches `col0Id` of
@@ -730,6 +1061,12 @@ class CompressedRelationReader {
       CompressedBlockMetadata::PermutedTriple triple,
       const ScanSpecAndBlocksAndBounds& metadataAndBlocks);
 
+  // The total time that the consumers of all the lazy scans of this process
+  // have waited for the next block (see `LazyScanMetadata::blockingTime_`),
+  // e.g. for the `/metrics` endpoint of the server.
+  static std::atomic<std::chrono::microseconds::rep>&
+  totalLazyScanBlockingTime();
+
   // Get the blocks (an ordered subset of the blocks that are passed in via the
   // `metadataAndBlocks`) where the `col1Id` can theoretically match one of the
   // elements in the `joinColumn` (The col0Id is fixed and specified by the
@@ -774,6 +1111,8 @@ class CompressedRelationReader {
    * exactly one column.
    * @param cancellationHandle An `CancellationException` will be thrown if the
    * cancellationHandle runs out during the execution of this function.
+   * @param scanMetadata If not null, the metadata of the scan (e.g. the number
+   * of blocks and bytes that were read) is stored here.
    *
    * The arguments `metadata`, `blocks`, and `file` must all be obtained from
    * The same `CompressedRelationWriter` (see below).
@@ -782,18 +1121,22 @@ class CompressedRelationReader {
                ColumnIndicesRef additionalColumns,
                const CancellationHandle& cancellationHandle,
                const LocatedTriplesPerBlock& locatedTriplesPerBlock,
-               const LimitOffsetClause& limitOffset = {}) const;
+               const LimitOffsetClause& limitOffset = {},
+               LazyScanMetadata* scanMetadata = nullptr) const;
 
   // Similar to `scan` (directly above), but the result of the scan is lazily
   // computed and returned as a generator of the single blocks that are scanned.
-  // The blocks are guaranteed to be in order.
+  // The blocks are guaranteed to be in order. If `firstColumnKeys` are
+  // specified, the rows whose first column is not one of these keys might be
+  // omitted from the result (see `ScanImplConfig::firstColumnKeys_`).
   CompressedRelationReader::IdTableGeneratorInputRange lazyScan(
       const ScanSpecification& scanSpec,
       std::vector<CompressedBlockMetadata> relevantBlockMetadata,
       ColumnIndices additionalColumns,
       const CancellationHandle& cancellationHandle,
       const LocatedTriplesPerBlock& locatedTriplesPerBlock,
-      const LimitOffsetClause& limitOffset = {}) const;
+      const LimitOffsetClause& limitOffset = {},
+      std::optional<ql::span<const Id>> firstColumnKeys = std::nullopt) const;
 
   // Retrieve all triples in the given block, ignoring updates. This is used in
   // `DeltaTriples::vacuum` to determine update triples that have no effect and
@@ -855,6 +1198,12 @@ class CompressedRelationReader {
       const ScanSpecification& scanSpec,
       const BlockMetadataRanges& blockMetadata);
 
+  // Same as above, but for a single span of `blocks`, which are searched using
+  // their `searchIndex`.
+  static BlockMetadataRanges getRelevantBlocks(
+      const ScanSpecification& scanSpec, BlockMetadataSpan blocks,
+      const BlockMetadataSearchIndex& searchIndex);
+
   // Get the first and the last triple that the result of a `scan` with the
   // given arguments would lead to, ignoring any graph filters set for
   // `metadataAndBlocks`. So this always returns the first and last triple we
@@ -874,32 +1223,50 @@ class CompressedRelationReader {
   // allocator.
   CompressedRelationReader makeReaderWithReboundAllocator(
       Allocator allocator) const {
-    return CompressedRelationReader{std::move(allocator),
-                                    ad_utility::File{file_.name(), "r"},
-                                    useGraphPostProcessing_};
+    return CompressedRelationReader{
+        std::move(allocator), dictionaries_,
+        ad_utility::File{file_.name(), "r"}, useGraphPostProcessing_,
+        fileIdForCache_};
   }
 
  private:
   // Read the block that is identified by the `blockMetaData` from the `file`.
-  // Only the columns specified by `columnIndices` are read.
-  CompressedBlock readCompressedBlockFromFile(
+  // Only the columns specified by `columnIndices` are read. Columns that are
+  // contained in the `DecompressedBlockCache` are taken from there instead.
+  CompressedOrCachedBlock readBlockFromCacheOrFile(
       const CompressedBlockMetadata& blockMetaData,
       ColumnIndicesRef columnIndices) const;
 
-  // Decompress the `compressedBlock`. The number of rows that the block will
-  // have after decompression must be passed in via the `numRowsToRead`
-  // argument. It is typically obtained from the corresponding
-  // `CompressedBlockMetaData`.
-  DecompressedBlock decompressBlock(const CompressedBlock& compressedBlock,
-                                    size_t numRowsToRead) const;
+  // Advise the operating system that the columns specified by `columnIndices`
+  // of the block identified by `blockMetaData` will be read soon.
+  void prefetchBlock(const CompressedBlockMetadata& blockMetaData,
+                     ColumnIndicesRef columnIndices) const;
+
+  // Decompress the `block` that was read via `readBlockFromCacheOrFile` with
+  // the same `blockMetaData` and `columnIndices`. Decompressed columns are
+  // inserted into the `DecompressedBlockCache`. If `firstColumnKeys` are
+  // specified and the (sorted) first column contains none of them, the other
+  // columns are not decompressed and the returned block is empty.
+  DecompressedBlock decompressBlock(
+      const CompressedOrCachedBlock& block,
+      const CompressedBlockMetadata& blockMetaData,
+      ColumnIndicesRef columnIndices,
+      std::optional<ql::span<const Id>> firstColumnKeys = std::nullopt) const;
 
   // Helper function used by `decompressBlock` and
-  // `decompressBlockToExistingIdTable`. Decompress the `compressedColumn` and
-  // store the result at the `iterator`. For the `numRowsToRead` argument, see
-  // the documentation of `decompressBlock`.
-  template <typename Iterator>
+  // `decompressBlockToExistingIdTable`. Decompress the `compressedColumn`,
+  // which was encoded with the `codec` (and possibly the `dictionary`), and
+  // store the result at the `result`. The number of rows that the column will
+  // have after decompression must be passed in via the `numRowsToRead`
+  // argument. It is typically obtained from the `CompressedBlockMetadata`.
   static void decompressColumn(const std::vector<char>& compressedColumn,
-                               size_t numRowsToRead, Iterator iterator);
+                               qlever::columnCodec::ColumnCodec codec,
+                               const ZstdDictionary* dictionary,
+                               size_t numRowsToRead, Id* result);
+
+  // Return the dictionary of the column with the `columnIndex`, `nullptr` if
+  // there is none.
+  const ZstdDictionary* getDictionary(ColumnIndex columnIndex) const;
 
   // Read and decompress the parts of the block given by `blockMetaData` (which
   // identifies the block) and `scanConfig` (which specifies the part of that
@@ -912,7 +1279,7 @@ class CompressedRelationReader {
   // triples (if any) and applying the graph filters (if any), both specified
   // as part of the `scanConfig`.
   DecompressedBlockAndMetadata decompressAndPostprocessBlock(
-      const CompressedBlock& compressedBlock, size_t numRowsToRead,
+      const CompressedOrCachedBlock& block,
       const CompressedRelationReader::ScanImplConfig& scanConfig,
       const CompressedBlockMetadata& metadata) const;
 
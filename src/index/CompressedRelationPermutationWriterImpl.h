@@ -117,6 +117,12 @@ struct CompressedRelationWriter::PermutationWriter {
   // TODO<joka921> Use call_fixed_size if there is benefit to it.
   IdTableStatic<0> relation_{numColumns_, alloc_};
   size_t numBlocksCurrentRel_ = 0;
+  // The number of rows of the current relation that have already been written
+  // via `addBlockForLargeRelation`, and the blocksize for the next block of the
+  // current relation (see `blocksizeForLargeRelation` in the
+  // `CompressedRelationWriter`).
+  size_t numRowsWrittenCurrentRel_ = 0;
+  size_t blocksizeCurrentRel_ = blocksize_;
 
   using TwinRelationSorter = ad_utility::CompressedExternalIdTableSorter<
       compressedRelationHelpers::ComparatorForConstCol0, 0>;
@@ -188,10 +194,13 @@ struct CompressedRelationWriter::PermutationWriter {
         twinRelationSorter_.push(row);
       }
     }
+    numRowsWrittenCurrentRel_ += relation_.numRows();
     writer1_->addBlockForLargeRelation(col0IdCurrentRelation_.value(),
                                        std::move(relation_).toDynamic());
     relation_.clear();
-    relation_.reserve(blocksize_);
+    blocksizeCurrentRel_ =
+        writer1_->blocksizeForLargeRelation(numRowsWrittenCurrentRel_);
+    relation_.reserve(blocksizeCurrentRel_);
     ++numBlocksCurrentRel_;
   };
 
@@ -208,9 +217,12 @@ struct CompressedRelationWriter::PermutationWriter {
           writer1_->finishLargeRelation(distinctCol1Counter_.getAndReset());
       if constexpr (WritePair) {
         largeTwinRelationTimer_.cont();
+        // The size of the twin relation is known in advance, so all its blocks
+        // have the same size.
         auto md2 = writer2_->addCompleteLargeRelation(
             col0IdCurrentRelation_.value(),
-            twinRelationSorter_.getSortedBlocks(blocksize_));
+            twinRelationSorter_.getSortedBlocks(
+                writer2_->blocksizeForLargeRelation(md1.numRows_)));
         largeTwinRelationTimer_.stop();
         twinRelationSorter_.clear();
         writeMetadata_(md1, md2);
@@ -228,6 +240,8 @@ struct CompressedRelationWriter::PermutationWriter {
     }
     relation_.clear();
     numBlocksCurrentRel_ = 0;
+    numRowsWrittenCurrentRel_ = 0;
+    blocksizeCurrentRel_ = blocksize_;
   };
 
   // ___________________________________________________________________________
@@ -258,12 +272,13 @@ struct CompressedRelationWriter::PermutationWriter {
 
   // Check if we need to create a new block before adding the current
   // triple. We create a new block if:
-  // 1. The relation buffer is at the block size limit, AND
+  // 1. The relation buffer is at the block size limit of the current relation,
+  //    AND
   // 2. The current triple has different first three columns than the last
   //    triple in the buffer (to ensure equal triples stay in same block)
   bool isEndOfBlockForLargeRelation(const auto& curRemainingCols) {
-    AD_CORRECTNESS_CHECK(blocksize_ > 0);
-    if (relation_.size() < blocksize_) {
+    AD_CORRECTNESS_CHECK(blocksizeCurrentRel_ > 0);
+    if (relation_.size() < blocksizeCurrentRel_) {
       return false;
     }
 
@@ -73,6 +73,11 @@ constexpr inline size_t NUM_PARALLEL_ITEM_MAPS = 10;
 // parser is used.
 constexpr inline size_t NUM_PARALLEL_PARSER_THREADS = 8;
 
+// The number of threads and the (approximate) number of lines per batch for
+// the parallel computation of the postings when building the text index.
+constexpr inline size_t NUM_THREADS_TEXT_INDEX_BUILDING = 8;
+constexpr inline size_t BATCH_SIZE_TEXT_INDEX_BUILDING = 100'000;
+
 // Increasing the following two constants increases the RAM usage without much
 // benefit to the performance.
 
@@ -88,6 +93,17 @@ constexpr inline size_t QUEUE_SIZE_AFTER_PARALLEL_PARSING = 10;
 // performance negatively.
 constexpr inline size_t BLOCKSIZE_VOCABULARY_MERGING = 100;
 
+// The merged words of the vocabulary merging are processed in batches of this
+// many words. The order of the words in a batch is checked and the mappings
+// from partial to global IDs are written by `NUM_THREADS_VOCABULARY_MERGING`
+// threads. Batches with fewer than
+// `MIN_BATCH_SIZE_FOR_PARALLEL_VOCABULARY_MERGING` words (typically the last
+// one) are processed by a single thread.
+constexpr inline size_t BATCH_SIZE_VOCABULARY_MERGING_OUTPUT = 100'000;
+constexpr inline size_t NUM_THREADS_VOCABULARY_MERGING = 8;
+constexpr inline size_t MIN_BATCH_SIZE_FOR_PARALLEL_VOCABULARY_MERGING =
+    10'000;
+
 // A buffer size used during the second pass of the Index build.
 // It is not const, so we can set it to a much lower value for unit tests to
 // increase the test coverage.
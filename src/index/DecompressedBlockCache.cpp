@@ -0,0 +1,84 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#include "index/DecompressedBlockCache.h"
+
+#include "global/RuntimeParameters.h"
+
+using ad_utility::MemorySize;
+
+// _____________________________________________________________________________
+DecompressedBlockCache::DecompressedBlockCache(MemorySize maxSize)
+    : cache_{ad_utility::size_t_max, maxSize, maxSize},
+      maxSizeInBytes_{maxSize.getBytes()} {}
+
+// _____________________________________________________________________________
+DecompressedBlockCache& DecompressedBlockCache::get() {
+  static DecompressedBlockCache cache{getRuntimeParameter<
+      &RuntimeParameters::decompressedBlockCacheMaxSize_>()};
+  return cache;
+}
+
+// _____________________________________________________________________________
+uint64_t DecompressedBlockCache::getUniqueFileId() {
+  static std::atomic<uint64_t> nextFileId = 0;
+  return nextFileId++;
+}
+
+// _____________________________________________________________________________
+auto DecompressedBlockCache::lookup(const Key& key) -> ColumnPtr {
+  if (!isEnabled()) {
+    return nullptr;
+  }
+  auto result = (*cache_.wlock())[key];
+  ++(result ? numHits_ : numMisses_);
+  return result;
+}
+
+// _____________________________________________________________________________
+void DecompressedBlockCache::insert(const Key& key, Column column) {
+  if (!isEnabled()) {
+    return;
+  }
+  auto lock = cache_.wlock();
+  if (lock->contains(key)) {
+    return;
+  }
+  // The `FlexibleCache` doesn't report evictions, so we infer them from the
+  // number of entries.
+  size_t numEntriesBefore = lock->numNonPinnedEntries();
+  bool wasInserted = lock->insert(key, std::move(column)) != nullptr;
+  numEvictions_ += numEntriesBefore + static_cast<size_t>(wasInserted) -
+                   lock->numNonPinnedEntries();
+}
+
+// _____________________________________________________________________________
+void DecompressedBlockCache::setMaxSize(MemorySize maxSize) {
+  auto lock = cache_.wlock();
+  size_t numEntriesBefore = lock->numNonPinnedEntries();
+  lock->setMaxSize(maxSize);
+  lock->setMaxSizeSingleEntry(maxSize);
+  numEvictions_ += numEntriesBefore - lock->numNonPinnedEntries();
+  maxSizeInBytes_ = maxSize.getBytes();
+}
+
+// _____________________________________________________________________________
+void DecompressedBlockCache::clear() {
+  cache_.wlock()->clearAll();
+  numHits_ = 0;
+  numMisses_ = 0;
+  numEvictions_ = 0;
+}
+
+// _____________________________________________________________________________
+auto DecompressedBlockCache::getStatistics() const -> Statistics {
+  Statistics result;
+  result.numHits_ = numHits_;
+  result.numMisses_ = numMisses_;
+  result.numEvictions_ = numEvictions_;
+  auto lock = cache_.rlock();
+  result.numEntries_ = lock->numNonPinnedEntries();
+  result.size_ = lock->nonPinnedSize();
+  result.maxSize_ = MemorySize::bytes(maxSizeInBytes_);
+  return result;
+}
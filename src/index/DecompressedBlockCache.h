@@ -0,0 +1,116 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_INDEX_DECOMPRESSEDBLOCKCACHE_H
+#define QLEVER_SRC_INDEX_DECOMPRESSEDBLOCKCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <sys/types.h>
+#include <vector>
+
+#include "backports/three_way_comparison.h"
+#include "global/Id.h"
+#include "util/Cache.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+// A process-wide, size-bounded LRU cache for the decompressed columns of the
+// blocks of the permutations. It sits between the file and the
+// `CompressedRelationReader`, so that concurrent scans of the same (popular)
+// blocks only have to decompress them once.
+//
+// The cache stores the columns exactly as they are stored on disk, that is
+// before the located triples are merged and before the graph filters are
+// applied. The cached values are thus independent of the located triples
+// snapshot of a query and stay valid across updates.
+class DecompressedBlockCache {
+ public:
+  // Identify a single column of a single block. The `fileId_` is unique for
+  // each opened permutation (see `getUniqueFileId`), the `offsetInFile_` is
+  // the offset of the compressed column in that file, as stored in the
+  // `CompressedBlockMetadata`. Using the offset instead of the block index and
+  // the column index is equivalent, but robust against metadata that doesn't
+  // have proper block indices.
+  struct Key {
+    uint64_t fileId_;
+    off_t offsetInFile_;
+
+    QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(Key, fileId_, offsetInFile_)
+
+    template <typename H>
+    friend H AbslHashValue(H h, const Key& key) {
+      return H::combine(std::move(h), key.fileId_, key.offsetInFile_);
+    }
+  };
+
+  using Column = std::vector<Id>;
+  using ColumnPtr = std::shared_ptr<const Column>;
+
+  // The statistics that are reported by the server.
+  struct Statistics {
+    size_t numHits_ = 0;
+    size_t numMisses_ = 0;
+    size_t numEvictions_ = 0;
+    size_t numEntries_ = 0;
+    ad_utility::MemorySize size_;
+    ad_utility::MemorySize maxSize_;
+  };
+
+ private:
+  struct ColumnSizeGetter {
+    ad_utility::MemorySize operator()(const Column& column) const {
+      return ad_utility::MemorySize::bytes(sizeof(Column) +
+                                           column.size() * sizeof(Id));
+    }
+  };
+  using Cache = ad_utility::HeapBasedLRUCache<Key, Column, ColumnSizeGetter>;
+
+  ad_utility::Synchronized<Cache> cache_;
+  // The maximum size of the `cache_`. A cache with a maximum size of zero is
+  // disabled, in this case we don't even acquire the lock of the `cache_`.
+  std::atomic<size_t> maxSizeInBytes_;
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+  std::atomic<size_t> numEvictions_ = 0;
+
+ public:
+  explicit DecompressedBlockCache(ad_utility::MemorySize maxSize);
+
+  // The process-wide instance that is used by all `CompressedRelationReader`s.
+  // Its initial size is the value of the runtime parameter
+  // `decompressed-block-cache-max-size`.
+  static DecompressedBlockCache& get();
+
+  // Return a new ID on each call, to be used as the `fileId_` of the `Key`.
+  // This makes sure that blocks of an index that was rebuilt (with the same
+  // filenames) are never confused with the blocks of the previous index.
+  static uint64_t getUniqueFileId();
+
+  bool isEnabled() const { return maxSizeInBytes_ > 0; }
+
+  // Return the cached column for `key`, or `nullptr` if it is not contained.
+  ColumnPtr lookup(const Key& key);
+
+  // Insert the `column` for `key`. Does nothing if the cache is disabled, the
+  // `key` is already contained (e.g. because it has been decompressed
+  // concurrently by another scan), or the `column` is too large.
+  void insert(const Key& key, Column column);
+
+  // Change the maximum size, least recently used entries are evicted if
+  // necessary. A size of zero disables the cache.
+  void setMaxSize(ad_utility::MemorySize maxSize);
+
+  // Remove all entries from the cache and reset the statistics.
+  void clear();
+
+  Statistics getStatistics() const;
+
+  // The counters of the statistics, which can be read without taking the lock
+  // of the cache.
+  size_t numHits() const { return numHits_; }
+  size_t numMisses() const { return numMisses_; }
+};
+
+#endif  // QLEVER_SRC_INDEX_DECOMPRESSEDBLOCKCACHE_H
@@ -17,12 +17,14 @@
 #include "backports/algorithm.h"
 #include "engine/ExecuteUpdate.h"
 #include "engine/ExportQueryExecutionTrees.h"
+#include "global/RuntimeParameters.h"
 #include "index/ExportIds.h"
 #include "index/Index.h"
 #include "index/IndexImpl.h"
 #include "index/IndexRebuilder.h"
 #include "index/LocatedTriples.h"
 #include "util/ChunkedForLoop.h"
+#include "util/ParallelExecutor.h"
 #include "util/Serializer/TripleSerializer.h"
 
 // ____________________________________________________________________________
@@ -97,6 +99,11 @@ void DeltaTriples::clear() {
             locatedTriples_->getLocatedTriples<false>());
   clearImpl(triplesToHandlesInternal_,
             locatedTriples_->getLocatedTriples<true>());
+  numDeltaTriplesAfterLastVacuum_ = 0;
+  updatesSinceLastWrite_.clear();
+  checkpointIsDue_ = true;
+  updatesForReplication_.clear();
+  clearedSinceLastReplication_ = true;
 }
 
 // ____________________________________________________________________________
@@ -150,9 +157,21 @@ nlohmann::json DeltaTriples::vacuum(
                           toRemoveInInternal.insertionsToRemove_);
   result["internal"] = toRemoveInInternal.stats_;
 
+  numDeltaTriplesAfterLastVacuum_ = numInserted() + numDeleted();
+  // The removed triples are not recorded in the log of updates.
+  checkpointIsDue_ = true;
   return result;
 }
 
+// ____________________________________________________________________________
+bool DeltaTriples::isAutomaticVacuumDue() const {
+  auto threshold = static_cast<int64_t>(
+      getRuntimeParameter<&RuntimeParameters::vacuumAfterNumDeltaTriples_>());
+  return threshold > 0 &&
+         numInserted() + numDeleted() - numDeltaTriplesAfterLastVacuum_ >=
+             threshold;
+}
+
 // ____________________________________________________________________________
 template <bool isInternal>
 DeltaTriples::TriplesToHandles<isInternal>& DeltaTriples::getState() {
@@ -175,22 +194,47 @@ DeltaTriples::locateAndAddTriples(CancellationHandle cancellationHandle,
   auto& lt = locatedTriples_->getLocatedTriples<isInternal>();
   std::array<std::vector<LocatedTriples::iterator>, allPermutations.size()>
       intermediateHandles;
-  for (auto permutation : allPermutations) {
-    tracer.beginTrace(std::string{Permutation::toString(permutation)});
-    tracer.beginTrace("locateTriples");
+  // Locate the triples in a single permutation and add them to the
+  // corresponding `LocatedTriplesPerBlock`. The permutations are independent of
+  // each other.
+  auto locateAndAdd = [this, &cancellationHandle, &triples, insertOrDelete,
+                       &lt, &intermediateHandles](
+                          Permutation::Enum permutation,
+                          ad_utility::timer::TimeTracer& permutationTracer) {
+    permutationTracer.beginTrace(
+        std::string{Permutation::toString(permutation)});
+    permutationTracer.beginTrace("locateTriples");
     auto& basePerm = index_.getPermutation(permutation);
     auto& perm = isInternal ? basePerm.internalPermutation() : basePerm;
     auto locatedTriples = LocatedTriple::locateTriplesInPermutation(
         triples, perm.metaData().blockData(), perm.keyOrder(), insertOrDelete,
-        cancellationHandle);
+        cancellationHandle,
+        lt[static_cast<size_t>(permutation)].getOriginalSearchIndex());
     cancellationHandle->throwIfCancelled();
-    tracer.endTrace("locateTriples");
-    tracer.beginTrace("addToLocatedTriples");
+    permutationTracer.endTrace("locateTriples");
+    permutationTracer.beginTrace("addToLocatedTriples");
     intermediateHandles[static_cast<size_t>(permutation)] =
-        lt[static_cast<size_t>(permutation)].add(locatedTriples, tracer);
+        lt[static_cast<size_t>(permutation)].add(locatedTriples,
+                                                 permutationTracer);
     cancellationHandle->throwIfCancelled();
-    tracer.endTrace("addToLocatedTriples");
-    tracer.endTrace(Permutation::toString(permutation));
+    permutationTracer.endTrace("addToLocatedTriples");
+    permutationTracer.endTrace(Permutation::toString(permutation));
+  };
+  if (triples.size() < minNumTriplesForParallelLocating_) {
+    for (auto permutation : allPermutations) {
+      locateAndAdd(permutation, tracer);
+    }
+  } else {
+    // The time tracer is not thread-safe, so only the total time is traced.
+    tracer.beginTrace("locateAndAddInParallel");
+    std::vector<std::packaged_task<void()>> tasks;
+    for (auto permutation : allPermutations) {
+      tasks.emplace_back([&locateAndAdd, permutation]() {
+        locateAndAdd(permutation, ad_utility::timer::DEFAULT_TIME_TRACER);
+      });
+    }
+    ad_utility::runTasksInParallel(std::move(tasks));
+    tracer.endTrace("locateAndAddInParallel");
   }
   tracer.beginTrace("transformHandles");
   std::vector<typename TriplesToHandles<isInternal>::LocatedTripleHandles>
@@ -429,6 +473,14 @@ void DeltaTriples::modifyTriplesImpl(CancellationHandle cancellationHandle,
     return targetMap.contains(triple);
   });
   tracer.endTrace("removeExistingTriples");
+  if constexpr (!isInternal) {
+    if (filenameForPersisting_.has_value() && !triples.empty()) {
+      updatesSinceLastWrite_.push_back({insertOrDelete, triples});
+    }
+    if (replicationLog_ != nullptr && !triples.empty()) {
+      updatesForReplication_.push_back({insertOrDelete, triples});
+    }
+  }
   tracer.beginTrace("removeInverseTriples");
   ql::ranges::for_each(triples, [this, &inverseMap](const IdTriple<0>& triple) {
     auto handle = inverseMap.find(triple);
@@ -501,14 +553,17 @@ ReturnType DeltaTriplesManager::modify(
                                       updateMetadataAfterRequest,
                                       &tracer](DeltaTriples& deltaTriples) {
     auto updateSnapshot = [this, &deltaTriples] {
-      auto newSnapshot = deltaTriples.getLocatedTriplesSharedStateCopy();
-      currentLocatedTriplesSharedState_.withWriteLock(
-          [&newSnapshot](auto& currentSnapshot) {
-            currentSnapshot = std::move(newSnapshot);
-          });
+      // Release the previous snapshot only after it has been replaced, s.t.
+      // its destruction (if there are no more queries using it) doesn't
+      // delay the publication of the new one.
+      auto previousSnapshot = currentLocatedTriplesSharedState_.exchange(
+          deltaTriples.getLocatedTriplesSharedStateCopy());
     };
     auto writeAndUpdateSnapshot = [&updateSnapshot, &deltaTriples, &tracer,
                                    writeToDiskAfterRequest]() {
+      // The record for the replicas is appended while holding the lock, s.t.
+      // the order of the records is the order of the modifications.
+      deltaTriples.appendToReplicationLog();
       if (writeToDiskAfterRequest) {
         tracer.beginTrace("diskWriteback");
         deltaTriples.writeToDisk();
@@ -561,7 +616,7 @@ void DeltaTriplesManager::clear() { modify<void>(&DeltaTriples::clear); }
 // _____________________________________________________________________________
 LocatedTriplesSharedState
 DeltaTriplesManager::getCurrentLocatedTriplesSharedState() const {
-  return *currentLocatedTriplesSharedState_.rlock();
+  return currentLocatedTriplesSharedState_.load();
 }
 
 // _____________________________________________________________________________
@@ -572,7 +627,7 @@ std::tuple<
 DeltaTriplesManager::getCurrentLocatedTriplesSharedStateWithVocab() const {
   return deltaTriples_.withReadLock([this](const DeltaTriples& deltaTriples) {
     auto [indices, ownedBlocks] = deltaTriples.copyLocalVocab();
-    return std::make_tuple(*currentLocatedTriplesSharedState_.rlock(),
+    return std::make_tuple(currentLocatedTriplesSharedState_.load(),
                            std::move(indices), std::move(ownedBlocks));
   });
 }
@@ -600,10 +655,52 @@ void DeltaTriples::updateAugmentedMetadata() {
 }
 
 // _____________________________________________________________________________
-void DeltaTriples::writeToDisk() const {
+namespace {
+// The total number of local blank node blocks that are owned by the
+// `localVocab`.
+size_t numBlankNodeBlocks(const LocalVocab& localVocab) {
+  size_t result = 0;
+  for (const auto& entry : localVocab.getOwnedLocalBlankNodeBlocks()) {
+    result += entry.blockIndices_.size();
+  }
+  return result;
+}
+
+// The log is never checkpointed before it has reached this size, s.t. small
+// updates on small delta triples don't write a checkpoint each time.
+constexpr size_t minLogSizeForCheckpoint = 16 * 1024 * 1024;
+}  // namespace
+
+// _____________________________________________________________________________
+DeltaTriplesWriteAheadLog DeltaTriples::writeAheadLog() const {
+  AD_CONTRACT_CHECK(filenameForPersisting_.has_value());
+  return DeltaTriplesWriteAheadLog{filenameForPersisting_.value() + ".wal"};
+}
+
+// _____________________________________________________________________________
+bool DeltaTriples::isCheckpointDue() const {
+  return checkpointIsDue_ ||
+         numBlankNodeBlocks(localVocab_) != numBlankNodeBlocksAtCheckpoint_ ||
+         writeAheadLog().sizeInBytes() >=
+             std::max(checkpointSizeInBytes_, minLogSizeForCheckpoint);
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::writeToDisk() {
   if (!filenameForPersisting_.has_value()) {
     return;
   }
+  if (isCheckpointDue()) {
+    writeCheckpoint();
+  } else {
+    writeAheadLog().append(updatesSinceLastWrite_);
+  }
+  updatesSinceLastWrite_.clear();
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::writeCheckpoint() {
+  AD_CONTRACT_CHECK(filenameForPersisting_.has_value());
   // TODO<RobinTF> Currently this only writes non-internal delta triples to
   // disk. The internal triples will be regenerated when importing the rest
   // again. In the future we might to also want to explicitly store the
@@ -623,6 +720,12 @@ void DeltaTriples::writeToDisk() const {
       std::array{toRange(triplesToHandlesNormal_.triplesDeleted_),
                  toRange(triplesToHandlesNormal_.triplesInserted_)});
   std::filesystem::rename(tempPath, filenameForPersisting_.value());
+  // The updates in the log are now contained in the checkpoint.
+  writeAheadLog().clear();
+  checkpointIsDue_ = false;
+  checkpointSizeInBytes_ =
+      std::filesystem::file_size(filenameForPersisting_.value());
+  numBlankNodeBlocksAtCheckpoint_ = numBlankNodeBlocks(localVocab_);
 }
 
 // _____________________________________________________________________________
@@ -631,35 +734,71 @@ void DeltaTriples::readFromDisk() {
     return;
   }
   AD_CONTRACT_CHECK(localVocab_.empty());
-  auto [vocab, idRanges] =
-      ad_utility::deserializeIds(filenameForPersisting_.value(), index_);
-  if (idRanges.empty()) {
-    return;
+  const auto& filename = filenameForPersisting_.value();
+  auto [vocab, idRanges] = ad_utility::deserializeIds(filename, index_);
+  // The checkpoint and the log of updates both refer to the local blank nodes
+  // of the `vocab`, which thus becomes the local vocab of the delta triples.
+  localVocab_ = std::move(vocab);
+  auto cancellationHandle =
+      std::make_shared<CancellationHandle::element_type>();
+  if (!idRanges.empty()) {
+    AD_CORRECTNESS_CHECK(idRanges.size() == 2);
+    auto toTriples = [](const std::vector<Id>& ids) {
+      Triples triples;
+      static_assert(Triples::value_type::PayloadSize == 0);
+      constexpr size_t cols = Triples::value_type::NumCols;
+      AD_CORRECTNESS_CHECK(ids.size() % cols == 0);
+      triples.reserve(ids.size() / cols);
+      for (size_t i = 0; i < ids.size(); i += cols) {
+        triples.emplace_back(
+            std::array{ids[i], ids[i + 1], ids[i + 2], ids[i + 3]});
+      }
+      // `insertTriples` and `deleteTriples` require the triples to be sorted.
+      // `writeToDisk` serializes the triples in the order returned by the
+      // HashMap, which is not necessarily sorted. Sort the triples when reading
+      // them from disk.
+      ql::ranges::sort(triples);
+      return triples;
+    };
+    insertTriples(cancellationHandle, toTriples(idRanges.at(1)));
+    deleteTriples(cancellationHandle, toTriples(idRanges.at(0)));
+    AD_LOG_INFO << "Done, #inserted triples = " << idRanges.at(1).size()
+                << ", #deleted triples = " << idRanges.at(0).size()
+                << std::endl;
+  }
+
+  // Replay the log of updates. Consecutive insertions (or deletions) are
+  // combined, s.t. they are located in bulk (see `locateAndAddTriples`).
+  auto log = writeAheadLog().read(localVocab_, index_);
+  if (!log.empty()) {
+    AD_LOG_INFO << "Replaying " << log.size() << " updates from "
+                << writeAheadLog().path() << " ..." << std::endl;
   }
-  AD_CORRECTNESS_CHECK(idRanges.size() == 2);
-  auto toTriples = [](const std::vector<Id>& ids) {
+  for (auto it = log.begin(); it != log.end();) {
+    bool insertOrDelete = it->insertOrDelete_;
     Triples triples;
-    static_assert(Triples::value_type::PayloadSize == 0);
-    constexpr size_t cols = Triples::value_type::NumCols;
-    AD_CORRECTNESS_CHECK(ids.size() % cols == 0);
-    triples.reserve(ids.size() / cols);
-    for (size_t i = 0; i < ids.size(); i += cols) {
-      triples.emplace_back(
-          std::array{ids[i], ids[i + 1], ids[i + 2], ids[i + 3]});
+    for (; it != log.end() && it->insertOrDelete_ == insertOrDelete; ++it) {
+      ql::ranges::copy(it->triples_, std::back_inserter(triples));
     }
-    // `insertTriples` and `deleteTriples` require the triples to be sorted.
-    // `writeToDisk` serializes the triples in the order returned by the
-    // HashMap, which is not necessarily sorted. Sort the triples when reading
-    // them from disk.
     ql::ranges::sort(triples);
-    return triples;
-  };
-  auto cancellationHandle =
-      std::make_shared<CancellationHandle::element_type>();
-  insertTriples(cancellationHandle, toTriples(idRanges.at(1)));
-  deleteTriples(cancellationHandle, toTriples(idRanges.at(0)));
-  AD_LOG_INFO << "Done, #inserted triples = " << idRanges.at(1).size()
-              << ", #deleted triples = " << idRanges.at(0).size() << std::endl;
+    triples.erase(std::unique(triples.begin(), triples.end()), triples.end());
+    if (insertOrDelete) {
+      insertTriples(cancellationHandle, std::move(triples));
+    } else {
+      deleteTriples(cancellationHandle, std::move(triples));
+    }
+  }
+  if (!log.empty()) {
+    AD_LOG_INFO << "Done, #inserted triples = " << numInserted()
+                << ", #deleted triples = " << numDeleted() << std::endl;
+  }
+
+  // The state that was just read is already on disk.
+  updatesSinceLastWrite_.clear();
+  checkpointIsDue_ = !std::filesystem::exists(filename);
+  checkpointSizeInBytes_ =
+      checkpointIsDue_ ? 0 : std::filesystem::file_size(filename);
+  numBlankNodeBlocksAtCheckpoint_ = numBlankNodeBlocks(localVocab_);
 }
 
 // _____________________________________________________________________________
@@ -667,6 +806,45 @@ void DeltaTriples::setPersists(std::optional<std::string> filename) {
   filenameForPersisting_ = std::move(filename);
 }
 
+// _____________________________________________________________________________
+void DeltaTriples::appendToReplicationLog() {
+  if (replicationLog_ != nullptr) {
+    replicationLog_->append(updatesForReplication_,
+                            clearedSinceLastReplication_);
+  }
+  updatesForReplication_.clear();
+  clearedSinceLastReplication_ = false;
+}
+
+// _____________________________________________________________________________
+ad_utility::HashSet<Id::T> DeltaTriples::localBlankNodes() const {
+  ad_utility::HashSet<Id::T> result;
+  const auto minLocalBlankNode = index_.getBlankNodeManager()->minIndex_;
+  auto collect = [&result, minLocalBlankNode](const auto& map) {
+    for (const auto& triple : map | ql::views::keys) {
+      for (Id id : triple.ids()) {
+        if (id.getDatatype() == Datatype::BlankNodeIndex &&
+            id.getBlankNodeIndex().get() >= minLocalBlankNode) {
+          result.insert(id.getBits());
+        }
+      }
+    }
+  };
+  collect(triplesToHandlesNormal_.triplesInserted_);
+  collect(triplesToHandlesNormal_.triplesDeleted_);
+  return result;
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesManager::enableReplicationLog(ad_utility::MemorySize maxSize) {
+  replicationLog_ = std::make_shared<DeltaTriplesReplicationLog>(maxSize);
+  modify<void>(
+      [this](DeltaTriples& deltaTriples) {
+        deltaTriples.setReplicationLog(replicationLog_);
+      },
+      false, false);
+}
+
 // _____________________________________________________________________________
 void DeltaTriplesManager::setFilenameForPersistentUpdatesAndReadFromDisk(
     std::string filename) {
@@ -720,6 +898,12 @@ void DeltaTriples::addFromSnapshotDiff(
   tracer.endTrace("insertDiffedTriples");
   // Update the index of the located triples to mark that they have changed.
   locatedTriples_->index_++;
+  // The IDs have changed, so the replicas can't continue.
+  if (replicationLog_ != nullptr) {
+    updatesForReplication_.clear();
+    clearedSinceLastReplication_ = false;
+    replicationLog_->reset();
+  }
 }
 
 // _____________________________________________________________________________
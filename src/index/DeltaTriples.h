@@ -12,15 +12,19 @@
 #ifndef QLEVER_SRC_INDEX_DELTATRIPLES_H
 #define QLEVER_SRC_INDEX_DELTATRIPLES_H
 
+#include "backports/atomic_shared_ptr.h"
 #include "backports/three_way_comparison.h"
 #include "engine/UpdateMetadata.h"
 #include "global/IdTriple.h"
+#include "index/DeltaTriplesReplicationLog.h"
+#include "index/DeltaTriplesWriteAheadLog.h"
 #include "index/Index.h"
 #include "index/IndexBuilderTypes.h"
 #include "index/IndexRebuilderTypes.h"
 #include "index/LocalVocab.h"
 #include "index/LocatedTriples.h"
 #include "index/Permutation.h"
+#include "util/HashSet.h"
 #include "util/LruCache.h"
 #include "util/Synchronized.h"
 #include "util/TimeTracer.h"
@@ -115,6 +119,27 @@ class DeltaTriples {
   // See the documentation of `setPersist()` below.
   std::optional<std::string> filenameForPersisting_;
 
+  // The (external) insertions and deletions since the last call to
+  // `writeToDisk`, which are appended to the `writeAheadLog()` by the next
+  // call. Only recorded if `filenameForPersisting_` is set.
+  std::vector<DeltaTriplesWriteAheadLog::Entry> updatesSinceLastWrite_;
+  // If true, the next call to `writeToDisk` writes a complete checkpoint
+  // instead of appending to the log (e.g. after the delta triples have been
+  // vacuumed or cleared, which can't be expressed as entries of the log).
+  bool checkpointIsDue_ = true;
+  // The size of the last checkpoint and the number of local blank node blocks
+  // at that time, see `isCheckpointDue`.
+  size_t checkpointSizeInBytes_ = 0;
+  size_t numBlankNodeBlocksAtCheckpoint_ = 0;
+
+  // The log for the read replicas (`nullptr` if there are none), see
+  // `DeltaTriplesReplicationLog`. The (external) insertions and deletions are
+  // collected in `updatesForReplication_` and appended as a single record at
+  // the end of each `DeltaTriplesManager::modify`.
+  std::shared_ptr<DeltaTriplesReplicationLog> replicationLog_;
+  std::vector<DeltaTriplesWriteAheadLog::Entry> updatesForReplication_;
+  bool clearedSinceLastReplication_ = false;
+
   // Store the id of the `ql:langtag` predicate to avoid repeated disk lookups.
   // This is initialized on first use.
   Id languagePredicate_ = Id::makeUndefined();
@@ -132,6 +157,10 @@ class DeltaTriples {
   ad_utility::util::LRUCache<Id::T, ad_utility::triple_component::Iri>
       predicateCache_{predicateCacheSize_};
 
+  // Below this number of triples, locating the triples in the permutations in
+  // parallel is not worth the overhead of starting the threads.
+  static constexpr size_t minNumTriplesForParallelLocating_ = 10'000;
+
   // Assert that the Permutation Enum values have the expected int values.
   // This is used to store and lookup items that exist for permutation in an
   // array.
@@ -168,6 +197,10 @@ class DeltaTriples {
   TriplesToHandles<false> triplesToHandlesNormal_;
   TriplesToHandles<true> triplesToHandlesInternal_;
 
+  // The number of (external) delta triples right after the last call to
+  // `vacuum` or `clear`, see `isAutomaticVacuumDue`.
+  int64_t numDeltaTriplesAfterLastVacuum_ = 0;
+
  public:
   // Construct for given index.
   explicit DeltaTriples(const Index& index);
@@ -200,6 +233,12 @@ class DeltaTriples {
   nlohmann::json vacuum(
       ad_utility::SharedCancellationHandle cancellationHandle);
 
+  // Return true iff at least `vacuum-after-num-delta-triples` delta triples
+  // have been added since the last call to `vacuum` or `clear`, s.t. the
+  // delta triples should be vacuumed automatically. Always false if the
+  // parameter is 0.
+  bool isAutomaticVacuumDue() const;
+
   // The number of delta triples added and subtracted.
   int64_t numInserted() const {
     return static_cast<int64_t>(
@@ -257,14 +296,41 @@ class DeltaTriples {
           ad_utility::timer::DEFAULT_TIME_TRACER);
 
   // If the `filename` is set, then `writeToDisk()` will write these
-  // `DeltaTriples` to `filename.value()`. If `filename` is `nullopt`, then
+  // `DeltaTriples` to `filename.value()` and the log of the updates to
+  // `filename.value() + ".wal"`. If `filename` is `nullopt`, then
   // `writeToDisk` will be a nullop.
   void setPersists(std::optional<std::string> filename);
 
-  // Write the delta triples to disk to persist them between restarts.
-  void writeToDisk() const;
+  // Set the log to which the changes are appended for the read replicas.
+  void setReplicationLog(std::shared_ptr<DeltaTriplesReplicationLog> log) {
+    replicationLog_ = std::move(log);
+  }
+
+  // Append the changes since the last call as a single record to the
+  // replication log (if there is one).
+  void appendToReplicationLog();
+
+  // Return a new local blank node that is owned by these `DeltaTriples`. Used
+  // by the read replicas to consistently map the local blank nodes of the
+  // primary.
+  Id makeLocalBlankNode() {
+    return Id::makeFromBlankNodeIndex(
+        localVocab_.getBlankNodeIndex(index_.getBlankNodeManager()));
+  }
+
+  // Return the local blank nodes that occur in the (external) delta triples.
+  ad_utility::HashSet<Id::T> localBlankNodes() const;
+
+  // Persist the delta triples to disk s.t. they survive restarts and crashes.
+  // Typically, only the insertions and deletions since the previous call are
+  // appended to the log of updates. When a checkpoint is due (see
+  // `isCheckpointDue`), the complete delta triples are written instead and the
+  // log is cleared, which bounds the size of the log and thus the time for
+  // `readFromDisk`.
+  void writeToDisk();
 
-  // Read the delta triples from disk to restore them after a restart.
+  // Read the delta triples from disk to restore them after a restart. This
+  // reads the last checkpoint and then replays the log of updates.
   void readFromDisk();
 
   // Return a deep copy of the `LocatedTriples` and the corresponding
@@ -326,7 +392,9 @@ class DeltaTriples {
   // to each of the six `LocatedTriplesPerBlock` maps (one per permutation).
   // When `insertOrDelete` is `true`, the triples are inserted, otherwise
   // deleted. Return the iterators of where it was added (so that we can easily
-  // delete it again from these maps later).
+  // delete it again from these maps later). For at least
+  // `minNumTriplesForParallelLocating_` triples, the permutations are handled
+  // concurrently.
   template <bool isInternal>
   std::vector<typename TriplesToHandles<isInternal>::LocatedTripleHandles>
   locateAndAddTriples(CancellationHandle cancellationHandle,
@@ -355,6 +423,21 @@ class DeltaTriples {
   void rewriteLocalVocabEntriesAndBlankNodes(Triples& triples);
   FRIEND_TEST(DeltaTriplesTest, rewriteLocalVocabEntriesAndBlankNodes);
 
+  // The log of the updates, see `writeToDisk`. Must only be called if
+  // `filenameForPersisting_` is set.
+  DeltaTriplesWriteAheadLog writeAheadLog() const;
+
+  // Return true iff the next call to `writeToDisk` has to write a checkpoint.
+  // This is the case if `checkpointIsDue_` is set, if new local blank node
+  // blocks have been allocated since the last checkpoint (the log only stores
+  // the strings of the local vocab entries, but not the blank node blocks), or
+  // if the log has become larger than the last checkpoint (s.t. replaying the
+  // log takes at most about as long as reading the checkpoint).
+  bool isCheckpointDue() const;
+
+  // Write the complete delta triples to disk and clear the log of updates.
+  void writeCheckpoint();
+
   // Erase `LocatedTriple` object from each `LocatedTriplesPerBlock` list. The
   // argument are iterators for each list, as returned by the method
   // `locateTripleInAllPermutations` above.
@@ -397,8 +480,15 @@ class DeltaTriples {
 // race conditions between concurrent updates and queries.
 class DeltaTriplesManager {
   ad_utility::Synchronized<DeltaTriples> deltaTriples_;
-  ad_utility::Synchronized<LocatedTriplesSharedState, std::shared_mutex>
+  // The snapshot for new queries. The snapshots are immutable, so they are
+  // published via an atomic pointer, s.t. acquiring the current snapshot (which
+  // happens at the start of each query) never takes a lock and is never
+  // blocked by a concurrent update. A replaced snapshot is destroyed as soon as
+  // the last query that uses it has finished.
+  ql::atomic_shared_ptr<const LocatedTriplesState>
       currentLocatedTriplesSharedState_;
+  // See `enableReplicationLog`.
+  std::shared_ptr<DeltaTriplesReplicationLog> replicationLog_;
 
  public:
   using CancellationHandle = DeltaTriples::CancellationHandle;
@@ -421,6 +511,15 @@ class DeltaTriplesManager {
 
   void setFilenameForPersistentUpdatesAndReadFromDisk(std::string filename);
 
+  // Enable the replication log with the given maximal size for read replicas
+  // of this server (see `DeltaTriplesReplicationLog`).
+  void enableReplicationLog(ad_utility::MemorySize maxSize);
+
+  // The replication log, `nullptr` if it has not been enabled.
+  std::shared_ptr<const DeltaTriplesReplicationLog> replicationLog() const {
+    return replicationLog_;
+  }
+
   // Reset the updates represented by the underlying `DeltaTriples` and then
   // update the current snapshot.
   void clear();
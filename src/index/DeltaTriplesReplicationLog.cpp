@@ -0,0 +1,103 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/DeltaTriplesReplicationLog.h"
+
+#include "util/Exception.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/SerializeVector.h"
+
+// _____________________________________________________________________________
+void DeltaTriplesReplicationLog::append(
+    ql::span<const DeltaTriplesWriteAheadLog::Entry> entries,
+    bool clearsDeltaTriples) {
+  if (entries.empty() && !clearsDeltaTriples) {
+    return;
+  }
+  // The encoding is done before the lock is acquired.
+  Record record{0, clearsDeltaTriples,
+                DeltaTriplesWriteAheadLog::encodeRecord(entries)};
+  state_.withWriteLock([this, &record](State& state) {
+    record.sequenceNumber_ = ++state.latestSequenceNumber_;
+    state.sizeInBytes_ += record.content_.size();
+    state.records_.push_back(std::move(record));
+    // Always keep the latest record, even if it is larger than the limit.
+    while (state.sizeInBytes_ > maxSizeInBytes_ && state.records_.size() > 1) {
+      state.sizeInBytes_ -= state.records_.front().content_.size();
+      state.firstAvailableSequenceNumber_ =
+          state.records_.front().sequenceNumber_ + 1;
+      state.records_.pop_front();
+    }
+  });
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesReplicationLog::reset() {
+  state_.withWriteLock([](State& state) {
+    state.records_.clear();
+    state.sizeInBytes_ = 0;
+    state.firstAvailableSequenceNumber_ = state.latestSequenceNumber_ + 1;
+  });
+}
+
+// _____________________________________________________________________________
+uint64_t DeltaTriplesReplicationLog::latestSequenceNumber() const {
+  return state_.withWriteLock(
+      [](const State& state) { return state.latestSequenceNumber_; });
+}
+
+// _____________________________________________________________________________
+auto DeltaTriplesReplicationLog::recordsSince(uint64_t sequenceNumber) const
+    -> std::optional<Records> {
+  return state_.withWriteLock(
+      [sequenceNumber](const State& state) -> std::optional<Records> {
+        if (sequenceNumber + 1 < state.firstAvailableSequenceNumber_ ||
+            sequenceNumber > state.latestSequenceNumber_) {
+          return std::nullopt;
+        }
+        Records result{state.latestSequenceNumber_, {}};
+        // The sequence numbers of the records are consecutive.
+        auto begin = state.records_.begin() +
+                     (sequenceNumber + 1 - state.firstAvailableSequenceNumber_);
+        result.records_.assign(begin, state.records_.end());
+        return result;
+      });
+}
+
+// _____________________________________________________________________________
+std::string DeltaTriplesReplicationLog::serialize(const Records& records) {
+  ad_utility::serialization::ByteBufferWriteSerializer serializer;
+  serializer << records.latestSequenceNumber_;
+  serializer << uint64_t{records.records_.size()};
+  for (const auto& record : records.records_) {
+    serializer << record.sequenceNumber_;
+    serializer << record.clearsDeltaTriples_;
+    serializer << record.content_;
+  }
+  const auto& data = serializer.data();
+  return {data.begin(), data.end()};
+}
+
+// _____________________________________________________________________________
+auto DeltaTriplesReplicationLog::deserialize(std::string_view bytes)
+    -> Records {
+  ad_utility::serialization::ByteBufferReadSerializer serializer{
+      std::vector<char>(bytes.begin(), bytes.end())};
+  Records result;
+  uint64_t numRecords;
+  serializer >> result.latestSequenceNumber_;
+  serializer >> numRecords;
+  for (uint64_t i = 0; i < numRecords; ++i) {
+    auto& record = result.records_.emplace_back();
+    serializer >> record.sequenceNumber_;
+    serializer >> record.clearsDeltaTriples_;
+    serializer >> record.content_;
+  }
+  return result;
+}
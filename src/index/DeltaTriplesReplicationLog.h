@@ -0,0 +1,90 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_DELTATRIPLESREPLICATIONLOG_H
+#define QLEVER_SRC_INDEX_DELTATRIPLESREPLICATIONLOG_H
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "backports/span.h"
+#include "index/DeltaTriplesWriteAheadLog.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+// The recent changes of the `DeltaTriples` of a primary server, from which
+// read replicas (that use the same index) fetch and apply the changes instead
+// of executing the same SPARQL updates themselves (see `DeltaTriplesReplica`).
+//
+// Each call to `DeltaTriplesManager::modify` that changes the delta triples
+// appends one record with a consecutive sequence number, which contains the
+// IDs of the inserted and deleted triples and the strings of their local vocab
+// entries (in the format of the records of the `DeltaTriplesWriteAheadLog`).
+// Only the most recent records up to a total size of `maxSizeInBytes` are
+// kept in memory. A replica that is too far behind (or a replica of a primary
+// whose index has been rebuilt, see `reset`) can't catch up and has to be
+// restarted from a fresh copy of the primary.
+class DeltaTriplesReplicationLog {
+ public:
+  struct Record {
+    uint64_t sequenceNumber_ = 0;
+    // If true, all the delta triples have to be removed before the entries of
+    // this record are applied.
+    bool clearsDeltaTriples_ = false;
+    std::vector<char> content_;
+  };
+
+  // The response to a replica, see `recordsSince`.
+  struct Records {
+    uint64_t latestSequenceNumber_ = 0;
+    std::vector<Record> records_;
+  };
+
+ private:
+  struct State {
+    std::deque<Record> records_;
+    size_t sizeInBytes_ = 0;
+    uint64_t latestSequenceNumber_ = 0;
+    // The records with smaller sequence numbers have been dropped.
+    uint64_t firstAvailableSequenceNumber_ = 1;
+  };
+  ad_utility::Synchronized<State> state_;
+  size_t maxSizeInBytes_;
+
+ public:
+  explicit DeltaTriplesReplicationLog(ad_utility::MemorySize maxSize)
+      : maxSizeInBytes_{maxSize.getBytes()} {}
+
+  // Append a record for the `entries`. Nothing is appended if the `entries`
+  // are empty and `clearsDeltaTriples` is false.
+  void append(ql::span<const DeltaTriplesWriteAheadLog::Entry> entries,
+              bool clearsDeltaTriples = false);
+
+  // Drop all the records, s.t. replicas that have not yet fetched all of them
+  // can't continue. This is required when the IDs of the delta triples
+  // change, e.g. after a rebuild of the index.
+  void reset();
+
+  uint64_t latestSequenceNumber() const;
+
+  // Return all the records with a sequence number larger than
+  // `sequenceNumber`. Return `std::nullopt` if some of these records have
+  // already been dropped.
+  std::optional<Records> recordsSince(uint64_t sequenceNumber) const;
+
+  // The binary format in which the `Records` are sent to a replica.
+  static std::string serialize(const Records& records);
+  static Records deserialize(std::string_view bytes);
+};
+
+#endif  // QLEVER_SRC_INDEX_DELTATRIPLESREPLICATIONLOG_H
@@ -0,0 +1,196 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/DeltaTriplesWriteAheadLog.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "util/Exception.h"
+#include "util/File.h"
+#include "util/HashSet.h"
+#include "util/Log.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+
+namespace {
+// Each record is stored as its size, its checksum, and then its content.
+constexpr size_t recordHeaderSize = 2 * sizeof(uint64_t);
+
+// The FNV-1a hash of the `bytes`, which is used to detect records that have
+// not been completely written.
+uint64_t checksum(ql::span<const char> bytes) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : bytes) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Return true iff `id` is the `Id` of a local vocab entry.
+bool isLocalVocabId(Id id) {
+  return id.getDatatype() == Datatype::LocalVocabIndex;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::vector<char> DeltaTriplesWriteAheadLog::encodeRecord(
+    ql::span<const Entry> entries) {
+  ad_utility::serialization::ByteBufferWriteSerializer serializer;
+  // The strings of all the local vocab entries that are used in the record.
+  ad_utility::HashSet<Id::T> localVocabIds;
+  for (const auto& entry : entries) {
+    for (const auto& triple : entry.triples_) {
+      for (Id id : triple.ids()) {
+        if (isLocalVocabId(id)) {
+          localVocabIds.insert(id.getBits());
+        }
+      }
+    }
+  }
+  serializer << uint64_t{localVocabIds.size()};
+  for (Id::T bits : localVocabIds) {
+    serializer << bits;
+    const auto& word = *Id::fromBits(bits).getLocalVocabIndex();
+    serializer << word.toStringRepresentation();
+  }
+  serializer << uint64_t{entries.size()};
+  for (const auto& entry : entries) {
+    serializer << entry.insertOrDelete_;
+    std::vector<Id> ids;
+    ids.reserve(entry.triples_.size() * 4);
+    for (const auto& triple : entry.triples_) {
+      ql::ranges::copy(triple.ids(), std::back_inserter(ids));
+    }
+    serializer << ids;
+  }
+  return std::move(serializer).data();
+}
+
+// _____________________________________________________________________________
+auto DeltaTriplesWriteAheadLog::decodeRecord(std::vector<char> content,
+                                             LocalVocab& localVocab,
+                                             const LocalVocabContext& context)
+    -> std::vector<Entry> {
+  std::vector<Entry> result;
+  ad_utility::serialization::ByteBufferReadSerializer serializer{
+      std::move(content)};
+  uint64_t numWords;
+  serializer >> numWords;
+  absl::flat_hash_map<Id::T, Id> mapping;
+  for (uint64_t i = 0; i < numWords; ++i) {
+    Id::T bits;
+    std::string word;
+    serializer >> bits;
+    serializer >> word;
+    mapping.emplace(bits, Id::makeFromLocalVocabIndex(
+                              localVocab.getIndexAndAddIfNotContained(
+                                  LocalVocabEntry::fromStringRepresentation(
+                                      std::move(word), context))));
+  }
+  uint64_t numEntries;
+  serializer >> numEntries;
+  for (uint64_t i = 0; i < numEntries; ++i) {
+    auto& entry = result.emplace_back();
+    std::vector<Id> ids;
+    serializer >> entry.insertOrDelete_;
+    serializer >> ids;
+    AD_CORRECTNESS_CHECK(ids.size() % 4 == 0);
+    for (Id& id : ids) {
+      if (isLocalVocabId(id)) {
+        id = mapping.at(id.getBits());
+      }
+    }
+    entry.triples_.reserve(ids.size() / 4);
+    for (size_t j = 0; j < ids.size(); j += 4) {
+      entry.triples_.emplace_back(
+          std::array{ids[j], ids[j + 1], ids[j + 2], ids[j + 3]});
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::append(ql::span<const Entry> entries) const {
+  if (entries.empty()) {
+    return;
+  }
+  auto content = encodeRecord(entries);
+  std::array<uint64_t, 2> header{static_cast<uint64_t>(content.size()),
+                                 checksum(content)};
+
+  ad_utility::File file{path_.string(), "a"};
+  file.write(header.data(), recordHeaderSize);
+  file.write(content.data(), content.size());
+  file.sync();
+}
+
+// _____________________________________________________________________________
+auto DeltaTriplesWriteAheadLog::read(LocalVocab& localVocab,
+                                     const LocalVocabContext& context) const
+    -> std::vector<Entry> {
+  std::vector<Entry> result;
+  if (!std::filesystem::exists(path_)) {
+    return result;
+  }
+  std::vector<char> bytes;
+  {
+    std::ifstream stream{path_, std::ios::binary};
+    AD_CORRECTNESS_CHECK(stream.is_open(), "Could not open the log of updates ",
+                         path_);
+    bytes.assign(std::istreambuf_iterator<char>{stream},
+                 std::istreambuf_iterator<char>{});
+  }
+  size_t position = 0;
+  while (position < bytes.size()) {
+    std::array<uint64_t, 2> header{};
+    if (bytes.size() - position < recordHeaderSize) {
+      break;
+    }
+    std::memcpy(header.data(), bytes.data() + position, recordHeaderSize);
+    auto [size, expectedChecksum] = header;
+    const size_t begin = position + recordHeaderSize;
+    if (bytes.size() - begin < size ||
+        checksum(ql::span{bytes.data() + begin, size}) != expectedChecksum) {
+      break;
+    }
+    auto entries = decodeRecord(
+        std::vector<char>(bytes.begin() + begin, bytes.begin() + begin + size),
+        localVocab, context);
+    ql::ranges::move(entries, std::back_inserter(result));
+    position = begin + size;
+  }
+  if (position < bytes.size()) {
+    AD_LOG_WARN << "The last " << bytes.size() - position
+                << " bytes of the log of updates " << path_
+                << " are incomplete (probably because of a crash while writing "
+                   "them) and are ignored"
+                << std::endl;
+    std::filesystem::resize_file(path_, position);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::clear() const {
+  std::filesystem::remove(path_);
+}
+
+// _____________________________________________________________________________
+size_t DeltaTriplesWriteAheadLog::sizeInBytes() const {
+  std::error_code ec;
+  auto size = std::filesystem::file_size(path_, ec);
+  return ec ? 0 : size;
+}
@@ -0,0 +1,77 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_DELTATRIPLESWRITEAHEADLOG_H
+#define QLEVER_SRC_INDEX_DELTATRIPLESWRITEAHEADLOG_H
+
+#include <filesystem>
+#include <vector>
+
+#include "backports/span.h"
+#include "global/IdTriple.h"
+#include "index/LocalVocab.h"
+
+// An append-only log of the insertions and deletions of delta triples. The
+// `DeltaTriples` regularly write their complete state to disk (a
+// "checkpoint"), and in between only append the updates to this log, s.t. the
+// cost of persisting an update doesn't depend on the total number of delta
+// triples. The state after a restart is the checkpoint with all the updates
+// from the log applied in order.
+//
+// Each call to `append` writes a single record, which contains the strings of
+// all the local vocab entries that are used by its triples, and a checksum. The
+// record is synced to disk before `append` returns. A record that has not been
+// completely written (because of a crash during the `append`) is detected and
+// ignored by `read`.
+class DeltaTriplesWriteAheadLog {
+ public:
+  // A single call to `insertTriples` or `deleteTriples`.
+  struct Entry {
+    bool insertOrDelete_;
+    std::vector<IdTriple<0>> triples_;
+  };
+
+ private:
+  std::filesystem::path path_;
+
+ public:
+  explicit DeltaTriplesWriteAheadLog(std::filesystem::path path)
+      : path_{std::move(path)} {}
+
+  const std::filesystem::path& path() const { return path_; }
+
+  // Append the `entries` as a single record and sync the log to disk. Nothing
+  // is written if the `entries` are empty.
+  void append(ql::span<const Entry> entries) const;
+
+  // Read all the complete records from the log in the order in which they were
+  // appended. The local vocab entries of the triples are added to the
+  // `localVocab`. A truncated or corrupt record at the end of the log (and
+  // everything after it) is removed from the file. Return an empty vector if
+  // the log doesn't exist.
+  std::vector<Entry> read(LocalVocab& localVocab,
+                          const LocalVocabContext& context) const;
+
+  // Remove all the records (typically after a checkpoint has been written).
+  void clear() const;
+
+  // The size of the log on disk in bytes (0 if it doesn't exist).
+  size_t sizeInBytes() const;
+
+  // The content of a single record without the size and the checksum, which is
+  // also used for the replication of the updates (see
+  // `DeltaTriplesReplicationLog`). `decodeRecord` is the inverse of
+  // `encodeRecord`, the local vocab entries are added to the `localVocab`.
+  static std::vector<char> encodeRecord(ql::span<const Entry> entries);
+  static std::vector<Entry> decodeRecord(std::vector<char> content,
+                                         LocalVocab& localVocab,
+                                         const LocalVocabContext& context);
+};
+
+#endif  // QLEVER_SRC_INDEX_DELTATRIPLESWRITEAHEADLOG_H
@@ -4,41 +4,244 @@
 
 #include "index/DocsDB.h"
 
+#include <absl/strings/str_cat.h>
+
+#include <array>
+#include <numeric>
+#include <optional>
+#include <utility>
+
 #include "backports/algorithm.h"
-#include "global/Constants.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/ExceptionHandling.h"
+
+// _____________________________________________________________________________
+DocsDB::Writer::Writer(std::string filename, size_t blockSize)
+    : filename_{std::move(filename)},
+      file_{filename_, "w"},
+      offsetsFile_{absl::StrCat(filename_, ".tmp"), "w+"},
+      blockSize_{blockSize} {
+  AD_CONTRACT_CHECK(blockSize_ > 0);
+}
+
+// _____________________________________________________________________________
+void DocsDB::Writer::writeOffset(uint64_t offset) {
+  offsetsFile_.write(&offset, sizeof(offset));
+}
+
+// _____________________________________________________________________________
+void DocsDB::Writer::push(TextRecordIndex recordIndex, std::string_view text) {
+  AD_CONTRACT_CHECK(!finished_);
+  AD_CONTRACT_CHECK(recordIndex.get() >= numRecords_,
+                    "The text records have to be added in ascending order");
+  // Blocks only contain complete texts.
+  if (currentBlock_.size() >= blockSize_) {
+    writeCurrentBlock();
+  }
+  while (numRecords_ <= recordIndex.get()) {
+    writeOffset(currentOffset_);
+    ++numRecords_;
+  }
+  currentBlock_.append(text);
+  currentOffset_ += text.size();
+}
+
+// _____________________________________________________________________________
+void DocsDB::Writer::writeCurrentBlock() {
+  if (currentBlock_.empty()) {
+    return;
+  }
+  auto compressed =
+      ZstdWrapper::compress(currentBlock_.data(), currentBlock_.size());
+  currentCompressedOffset_ += file_.write(compressed.data(), compressed.size());
+  blockOffsets_.push_back(currentOffset_);
+  compressedBlockOffsets_.push_back(currentCompressedOffset_);
+  currentBlock_.clear();
+}
+
+// _____________________________________________________________________________
+void DocsDB::Writer::finish() {
+  if (std::exchange(finished_, true)) {
+    return;
+  }
+  writeCurrentBlock();
+  writeOffset(currentOffset_);
+  auto writeNumbers = [this](ql::span<const uint64_t> numbers) {
+    file_.write(numbers.data(), numbers.size_bytes());
+  };
+  // Pad the compressed blocks, s.t. the offsets are aligned in the memory
+  // mapping.
+  std::string padding((sizeof(uint64_t) - currentCompressedOffset_ %
+                       sizeof(uint64_t)) %
+                          sizeof(uint64_t),
+                      '\0');
+  file_.write(padding.data(), padding.size());
+
+  // Append the offsets of the records from the temporary file in chunks.
+  offsetsFile_.flush();
+  const uint64_t numOffsets = numRecords_ + 1;
+  std::vector<uint64_t> buffer(std::min(numOffsets, uint64_t{1} << 16));
+  for (uint64_t i = 0; i < numOffsets; i += buffer.size()) {
+    auto chunkSize = std::min<uint64_t>(buffer.size(), numOffsets - i);
+    auto chunk = ql::span{buffer}.first(static_cast<size_t>(chunkSize));
+    auto bytesRead =
+        offsetsFile_.read(chunk.data(), chunk.size_bytes(),
+                          static_cast<off_t>(i * sizeof(uint64_t)));
+    AD_CORRECTNESS_CHECK(bytesRead ==
+                         static_cast<ssize_t>(chunk.size_bytes()));
+    writeNumbers(chunk);
+  }
+  offsetsFile_.close();
+  ad_utility::deleteFile(absl::StrCat(filename_, ".tmp"),
+                         /*warnOnFailure=*/false);
+
+  writeNumbers(blockOffsets_);
+  writeNumbers(compressedBlockOffsets_);
+  uint64_t numBlocks = blockOffsets_.size() - 1;
+  std::array<uint64_t, 3> trailer{numRecords_, numBlocks, MAGIC_NUMBER};
+  writeNumbers(trailer);
+  file_.close();
+}
+
+// _____________________________________________________________________________
+DocsDB::Writer::~Writer() {
+  ad_utility::terminateIfThrows([this]() { finish(); },
+                                "Calling `finish` from the destructor of "
+                                "`DocsDB::Writer`");
+}
 
 // _____________________________________________________________________________
 void DocsDB::init(const std::string& fileName) {
-  _dbFile.open(fileName.c_str(), "r");
-  if (_dbFile.empty()) {
-    _size = 0;
-  } else {
-    off_t posLastOfft = _dbFile.getLastOffset(&_startOfOffsets);
-    _size = (posLastOfft - _startOfOffsets) / sizeof(off_t);
+  file_.map(fileName);
+  size_ = 0;
+  recordOffsets_ = {};
+  blockOffsets_ = {};
+  compressedBlockOffsets_ = {};
+  if (file_.size() == 0) {
+    return;
   }
+  constexpr size_t trailerSize = 3;
+  auto throwInvalid = [&fileName]() {
+    AD_THROW(absl::StrCat(
+        "The file \"", fileName,
+        "\" is not a valid text records file. It was probably built by an "
+        "older version of QLever, please rebuild the text index"));
+  };
+  if (file_.size() % sizeof(uint64_t) != 0 ||
+      file_.size() < trailerSize * sizeof(uint64_t)) {
+    throwInvalid();
+  }
+  // The offsets are aligned in the file (see `Writer::finish`), and the
+  // mapping starts at a page boundary.
+  ql::span<const uint64_t> numbers{
+      reinterpret_cast<const uint64_t*>(file_.data()),
+      file_.size() / sizeof(uint64_t)};
+  auto trailer = numbers.last(trailerSize);
+  uint64_t numRecords = trailer[0];
+  uint64_t numBlocks = trailer[1];
+  uint64_t magicNumber = trailer[2];
+  if (magicNumber != MAGIC_NUMBER ||
+      numRecords + 1 + 2 * (numBlocks + 1) + trailerSize > numbers.size()) {
+    throwInvalid();
+  }
+  auto offsets = numbers.first(numbers.size() - trailerSize);
+  compressedBlockOffsets_ = offsets.last(numBlocks + 1);
+  offsets = offsets.first(offsets.size() - (numBlocks + 1));
+  blockOffsets_ = offsets.last(numBlocks + 1);
+  offsets = offsets.first(offsets.size() - (numBlocks + 1));
+  recordOffsets_ = offsets.last(numRecords + 1);
+  AD_CORRECTNESS_CHECK(compressedBlockOffsets_.back() <= file_.size());
+  AD_CORRECTNESS_CHECK(blockOffsets_.back() == recordOffsets_.back());
+  size_ = numRecords;
 }
 
 // _____________________________________________________________________________
-std::string DocsDB::getTextExcerpt(TextRecordIndex cid) const {
+void DocsDB::throwIfEmpty() const {
   // If no DocsDB available, we cannot return a text excerpt for the given ID.
-  if (_size == 0) {
+  if (size_ == 0) {
     AD_THROW(
         "Text records not available, start QLever with -t option and make "
         "sure that"
         " a file .text.docsDB exists");
   }
+}
+
+// _____________________________________________________________________________
+std::pair<uint64_t, uint64_t> DocsDB::getRange(TextRecordIndex cid) const {
+  AD_CONTRACT_CHECK(cid.get() < size_);
+  uint64_t from = recordOffsets_[cid.get()];
+  // For an empty record, use the next nonempty one.
+  auto nextOffsets = recordOffsets_.subspan(cid.get() + 1);
+  auto toIt = ql::ranges::upper_bound(nextOffsets, from);
+  uint64_t to = toIt == nextOffsets.end() ? from : *toIt;
+  return {from, to};
+}
 
-  off_t ft[2];
-  off_t& from = ft[0];
-  off_t& to = ft[1];
-  off_t at = _startOfOffsets + cid.get() * sizeof(off_t);
-  at += _dbFile.read(ft, sizeof(ft), at);
-  while (to == from) {
-    at += _dbFile.read(&to, sizeof(off_t), at);
+// _____________________________________________________________________________
+size_t DocsDB::getBlockIndex(uint64_t offset) const {
+  auto it = ql::ranges::upper_bound(blockOffsets_, offset);
+  AD_CORRECTNESS_CHECK(it != blockOffsets_.begin() &&
+                       it != blockOffsets_.end());
+  return static_cast<size_t>(it - blockOffsets_.begin()) - 1;
+}
+
+// _____________________________________________________________________________
+std::string DocsDB::decompressBlock(size_t blockIndex) const {
+  std::string block(blockOffsets_[blockIndex + 1] - blockOffsets_[blockIndex],
+                    '\0');
+  uint64_t compressedBegin = compressedBlockOffsets_[blockIndex];
+  uint64_t compressedSize =
+      compressedBlockOffsets_[blockIndex + 1] - compressedBegin;
+  auto decompressedSize = ZstdWrapper::decompressToBuffer(
+      file_.data() + compressedBegin, compressedSize, block.data(),
+      block.size());
+  AD_CORRECTNESS_CHECK(decompressedSize == block.size());
+  return block;
+}
+
+// _____________________________________________________________________________
+std::string DocsDB::getTextExcerpt(TextRecordIndex cid) const {
+  throwIfEmpty();
+  auto [from, to] = getRange(cid);
+  if (from == to) {
+    return "";
+  }
+  size_t blockIndex = getBlockIndex(from);
+  AD_CORRECTNESS_CHECK(to <= blockOffsets_[blockIndex + 1]);
+  auto block = decompressBlock(blockIndex);
+  uint64_t blockBegin = blockOffsets_[blockIndex];
+  return block.substr(from - blockBegin, to - from);
+}
+
+// _____________________________________________________________________________
+std::vector<std::string> DocsDB::getTextExcerpts(
+    ql::span<const TextRecordIndex> cids) const {
+  std::vector<std::string> result(cids.size());
+  if (cids.empty()) {
+    return result;
+  }
+  throwIfEmpty();
+  // Retrieve the texts in the order of their offsets, s.t. each block has to
+  // be decompressed only once.
+  std::vector<size_t> permutation(cids.size());
+  std::iota(permutation.begin(), permutation.end(), size_t{0});
+  ql::ranges::sort(permutation, {},
+                   [&cids](size_t i) { return cids[i].get(); });
+  std::optional<size_t> currentBlockIndex;
+  std::string currentBlock;
+  for (size_t i : permutation) {
+    auto [from, to] = getRange(cids[i]);
+    if (from == to) {
+      continue;
+    }
+    size_t blockIndex = getBlockIndex(from);
+    AD_CORRECTNESS_CHECK(to <= blockOffsets_[blockIndex + 1]);
+    if (currentBlockIndex != blockIndex) {
+      currentBlock = decompressBlock(blockIndex);
+      currentBlockIndex = blockIndex;
+    }
+    uint64_t blockBegin = blockOffsets_[blockIndex];
+    result[i] = currentBlock.substr(from - blockBegin, to - from);
   }
-  assert(to > from);
-  size_t nofBytes = static_cast<size_t>(to - from);
-  std::string line(nofBytes, '\0');
-  _dbFile.read(line.data(), nofBytes, from);
-  return line;
+  return result;
 }
@@ -5,19 +5,109 @@
 #ifndef QLEVER_SRC_INDEX_DOCSDB_H
 #define QLEVER_SRC_INDEX_DOCSDB_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "backports/span.h"
 #include "global/IndexTypes.h"
 #include "util/File.h"
+#include "util/ReadOnlyMappedFile.h"
 
+// The texts of the text records (the "docs"). The texts are concatenated and
+// stored in zstd-compressed blocks of (at least) `DEFAULT_BLOCK_SIZE` bytes
+// each, where a block always contains complete texts. The file is memory
+// mapped, so retrieving a text requires no system call and decompresses only
+// a single block. The file has the following layout (all numbers are
+// `uint64_t`):
+//
+// [compressed blocks][padding to 8 bytes]
+// [offset of each text in the uncompressed texts (numRecords + 1)]
+// [uncompressed offset of each block (numBlocks + 1)]
+// [compressed offset of each block (numBlocks + 1)]
+// [numRecords][numBlocks][MAGIC_NUMBER]
 class DocsDB {
  public:
+  // Larger blocks compress better, smaller blocks are faster to decompress for
+  // the retrieval of a single text.
+  static constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 15;
+  static constexpr uint64_t MAGIC_NUMBER = 0x424453434F444C51;  // "QLDOCSDB"
+
+ private:
+  ad_utility::ReadOnlyMappedFile file_;
+  ql::span<const uint64_t> recordOffsets_;
+  ql::span<const uint64_t> blockOffsets_;
+  ql::span<const uint64_t> compressedBlockOffsets_;
+  size_t size_ = 0;
+
+ public:
+  // Write a `DocsDB` text by text. To avoid excessive use of RAM, the offsets
+  // of the texts are streamed to a temporary file, which is appended to the
+  // file by `finish` (or the destructor).
+  class Writer {
+   private:
+    std::string filename_;
+    ad_utility::File file_;
+    ad_utility::File offsetsFile_;
+    size_t blockSize_;
+    uint64_t numRecords_ = 0;
+    uint64_t currentOffset_ = 0;
+    uint64_t currentCompressedOffset_ = 0;
+    // The texts of the current block.
+    std::string currentBlock_;
+    std::vector<uint64_t> blockOffsets_{0};
+    std::vector<uint64_t> compressedBlockOffsets_{0};
+    bool finished_ = false;
+
+   public:
+    explicit Writer(std::string filename,
+                    size_t blockSize = DEFAULT_BLOCK_SIZE);
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    // Add the `text` of the record with the given `recordIndex`. The records
+    // have to be added in ascending order. Missing records are stored as empty
+    // records.
+    void push(TextRecordIndex recordIndex, std::string_view text);
+
+    // Write the last block and the offsets.
+    void finish();
+
+    ~Writer();
+
+   private:
+    void writeOffset(uint64_t offset);
+    void writeCurrentBlock();
+  };
+
+  // Open the `DocsDB` that has been written to the `fileName` by a `Writer`.
   void init(const std::string& fileName);
+
+  // The number of text records.
+  size_t size() const { return size_; }
+
+  // Return the text of the record with index `cid`. For an empty record, the
+  // text of the next nonempty record is returned.
   std::string getTextExcerpt(TextRecordIndex cid) const;
 
-  mutable ad_utility::File _dbFile;
-  off_t _startOfOffsets;
-  size_t _size = 0;
+  // Return the texts of all the `cids` (which may be in any order and contain
+  // duplicates) in the same order. Each block is decompressed at most once, so
+  // this is much cheaper than calling `getTextExcerpt` for each of the `cids`.
+  std::vector<std::string> getTextExcerpts(
+      ql::span<const TextRecordIndex> cids) const;
+
+ private:
+  // Throw if the `DocsDB` is empty.
+  void throwIfEmpty() const;
+  // Return the offsets of the text of the record with index `cid` in the
+  // uncompressed texts.
+  std::pair<uint64_t, uint64_t> getRange(TextRecordIndex cid) const;
+  // Return the index of the block that contains the given (uncompressed)
+  // `offset`.
+  size_t getBlockIndex(uint64_t offset) const;
+  // Decompress the block with the index `blockIndex`.
+  std::string decompressBlock(size_t blockIndex) const;
 };
 
 #endif  // QLEVER_SRC_INDEX_DOCSDB_H
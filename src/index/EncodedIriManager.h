@@ -7,6 +7,8 @@
 
 #include <absl/numeric/bits.h>
 
+#include <charconv>
+
 #include "backports/StartsWithAndEndsWith.h"
 #include "backports/algorithm.h"
 #include "backports/three_way_comparison.h"
@@ -56,6 +58,21 @@ std::optional<std::string_view> matchDigitsPrefix(std::string_view repr);
 // if 4 times the number of digits is larger than `NumBitsTotal - NumBitsTags`,
 // the IRI will not be encoded (but stored as a regular IRI). See the bottom of
 // the file for the default values of `NumBitsTotal` and `NumBitsTags`.
+//
+// Alternatively, a prefix can be followed by a fixed number of lowercase
+// hexadecimal digits (e.g. hashes or the first part of a UUID). These
+// prefixes are specified as `<width>:<prefix>`, e.g. `8:http://example.org/`
+// for IRIs like <http://example.org/deadbeef>. Each hexadecimal digit is stored
+// as its 4-bit value, left-aligned like the decimal digits. All the suffixes of
+// such a prefix have the same width, so the order of the encoded values again
+// corresponds to the lexical order of the IRIs.
+//
+// Optionally, short plain literals (without language tag or datatype, e.g.
+// "yes" or "DE") can also be encoded. This uses the last of the
+// `2 ** NumBitsTags` prefix tags, and the characters (which have to be ASCII)
+// are stored as 7-bit values, left-aligned and filled on the right with
+// zeroes. This again makes the order of the encoded values correspond to the
+// lexical order of the literals.
 struct NoHardcodedPrefixes {
   // The fixed prefixes have to be wrapped into a struct because
   // `std::array<std::string_view>` cannot be passed as a template parameter
@@ -80,10 +97,21 @@ class EncodedIriManagerImpl {
   static_assert(NumBitsTags <= 64);
   static_assert(NumDigits > 0);
 
+  // We use 7 bits per character when encoding short literals.
+  static constexpr size_t CharSize = 7;
+  static constexpr size_t NumLiteralChars = NumBitsEncoding / CharSize;
+
   // The prefixes of the IRIs that will be encoded.
   std::vector<std::string> prefixes_;
+  // For each of the `prefixes_` the number of hexadecimal digits that follow
+  // the prefix, or 0 if the prefix is followed by decimal digits.
+  std::vector<size_t> hexWidths_;
+  // If true, short literals are also encoded (see above).
+  bool inlineShortLiterals_ = false;
 
   static constexpr auto maxNumPrefixes_ = 1ULL << NumBitsTags;
+  // The prefix tag that is used for the short literals.
+  static constexpr uint64_t shortLiteralTag_ = maxNumPrefixes_ - 1;
 
   // By default, `prefixes_` is empty, so no IRI will be encoded.
   // NOTE: When loading an existing index, in particular one from an older
@@ -94,13 +122,19 @@ class EncodedIriManagerImpl {
 
   // Construct from the list of prefixes. The prefixes have to be specified
   // without any brackets, so e.g. "http://example.org/" if IRIs of the form
-  // `<http://example.org/1234>` should be encoded.
+  // `<http://example.org/1234>` should be encoded. The prefixes in
+  // `hexPrefixesWithoutAngleBrackets` are followed by hexadecimal digits and
+  // have the form `<width>:<prefix>` (see above). If `inlineShortLiterals` is
+  // true, short literals are encoded as well.
   // NOTE: When loading an existing index, in particular one from an older
   // QLever version with different hardcoded prefixes, it is crucial to use the
   // deserialization from JSON to initialize the EncodedIriManager. See the
   // note in `from_json`.
   explicit EncodedIriManagerImpl(
-      std::vector<std::string> prefixesWithoutAngleBrackets) {
+      std::vector<std::string> prefixesWithoutAngleBrackets,
+      const std::vector<std::string>& hexPrefixesWithoutAngleBrackets = {},
+      bool inlineShortLiterals = false)
+      : inlineShortLiterals_{inlineShortLiterals} {
     // Add hardcoded prefixes.
     for (const auto& prefix : HardcodedPrefixes) {
       // Adding a hardcoded prefix a second time in the constructor is an error.
@@ -108,32 +142,43 @@ class EncodedIriManagerImpl {
           !ad_utility::contains(prefixesWithoutAngleBrackets, prefix));
       prefixesWithoutAngleBrackets.emplace_back(prefix);
     }
-    if (prefixesWithoutAngleBrackets.empty()) {
+    // The prefixes together with their `hexWidths_`.
+    std::vector<std::pair<std::string, size_t>> prefixesAndHexWidths;
+    for (auto& prefix : prefixesWithoutAngleBrackets) {
+      prefixesAndHexWidths.emplace_back(std::move(prefix), 0);
+    }
+    for (const auto& prefix : hexPrefixesWithoutAngleBrackets) {
+      prefixesAndHexWidths.push_back(parseHexPrefix(prefix));
+    }
+    if (prefixesAndHexWidths.empty()) {
       return;
     }
     // Sort the prefixes lexicographically to make the ordering deterministic
     // (provided that the prefixes do not end with digits).
-    ql::ranges::sort(prefixesWithoutAngleBrackets);
+    ql::ranges::sort(prefixesAndHexWidths);
 
     // Remove duplicates.
     //
     // NOTE: `ql::ranges::unique` does not work because of a discrepancy in the
     // return types between `std::ranges` and `range-v3`.
-    prefixesWithoutAngleBrackets.erase(
-        ::ranges::unique(prefixesWithoutAngleBrackets),
-        prefixesWithoutAngleBrackets.end());
+    prefixesAndHexWidths.erase(::ranges::unique(prefixesAndHexWidths),
+                               prefixesAndHexWidths.end());
 
-    if (prefixesWithoutAngleBrackets.size() > maxNumPrefixes_) {
+    // The tag of the short literals cannot be used for a prefix.
+    const auto maxNumPrefixes =
+        inlineShortLiterals_ ? shortLiteralTag_ : maxNumPrefixes_;
+    if (prefixesAndHexWidths.size() > maxNumPrefixes) {
       throw std::runtime_error(absl::StrCat(
           "Number of prefixes specified with `--encode-as-id` is ",
-          prefixesWithoutAngleBrackets.size(), ", which is too many; ",
-          "the maximum is ", maxNumPrefixes_));
+          prefixesAndHexWidths.size(), ", which is too many; ",
+          "the maximum is ", maxNumPrefixes));
     }
 
     // TODO<C++23> use `std::views::adjacent`.
-    for (size_t i = 0; i < prefixesWithoutAngleBrackets.size() - 1; ++i) {
-      const auto& a = prefixesWithoutAngleBrackets.at(i);
-      const auto& b = prefixesWithoutAngleBrackets.at(i + 1);
+    // NOTE: This also rejects the same prefix with different suffixes.
+    for (size_t i = 0; i < prefixesAndHexWidths.size() - 1; ++i) {
+      const auto& a = prefixesAndHexWidths.at(i).first;
+      const auto& b = prefixesAndHexWidths.at(i + 1).first;
       if (ql::starts_with(b, a)) {
         throw std::runtime_error(absl::StrCat(
             "None of the prefixes specified with `--encode-as-id` "
@@ -141,8 +186,9 @@ class EncodedIriManagerImpl {
             a, "\" and \"", b, "\"."));
       }
     }
-    prefixes_.reserve(prefixesWithoutAngleBrackets.size());
-    for (const auto& prefix : prefixesWithoutAngleBrackets) {
+    prefixes_.reserve(prefixesAndHexWidths.size());
+    hexWidths_.reserve(prefixesAndHexWidths.size());
+    for (const auto& [prefix, hexWidth] : prefixesAndHexWidths) {
       if (ql::starts_with(prefix, '<')) {
         throw std::runtime_error(absl::StrCat(
             "The prefixes specified with `--encode-as-id` must not "
@@ -150,17 +196,55 @@ class EncodedIriManagerImpl {
             prefix, "\""));
       }
       prefixes_.push_back(absl::StrCat("<", prefix));
+      hexWidths_.push_back(hexWidth);
     }
   }
 
+  // Parse a prefix of the form `<width>:<prefix>` into the prefix and the
+  // width. Throw if the width is missing or out of range.
+  static std::pair<std::string, size_t> parseHexPrefix(std::string_view spec) {
+    auto colon = spec.find(':');
+    size_t width = 0;
+    if (colon != std::string_view::npos) {
+      auto [ptr, ec] =
+          std::from_chars(spec.data(), spec.data() + colon, width);
+      if (ec != std::errc{} || ptr != spec.data() + colon) {
+        width = 0;
+      }
+    }
+    if (width == 0 || width > NumDigits) {
+      throw std::runtime_error(absl::StrCat(
+          "The prefixes specified with `--encode-as-id-hex` must have the "
+          "form `<width>:<prefix>`, where `<width>` is the number of "
+          "hexadecimal digits after the prefix (between 1 and ",
+          NumDigits, "); here is a violating prefix: \"", spec, "\""));
+    }
+    return {std::string{spec.substr(colon + 1)}, width};
+  }
+
   // Try to encode the given string as an `Id`. If the encoding fails, return
   // `std::nullopt`. This happens in one of the following cases:
   //
   // 1. The string is not an `<iriref-in-angle-brackets>`
   // 2. The string does not start with any of the `prefixes_`
   // 3. After the matching prefix, there are characters other than `[0-9]`
-  // 4. There are more digits than fit into `NumBitsEncoding` (4 bits / digit)
+  //    (or `[0-9a-f]` for prefixes with hexadecimal digits).
+  // 4. There are more digits than fit into `NumBitsEncoding` (4 bits / digit),
+  //    or the number of hexadecimal digits is not the width of the prefix.
+  //
+  // If `inlineShortLiterals_` is true, then literals are encoded if they
+  // fulfill the requirements of `encodeShortLiteral` below.
   std::optional<Id> encode(std::string_view repr) const {
+    if (ql::starts_with(repr, '"')) {
+      if (!inlineShortLiterals_) {
+        return std::nullopt;
+      }
+      auto payload = encodeShortLiteral(repr);
+      if (!payload.has_value()) {
+        return std::nullopt;
+      }
+      return makeIdFromPrefixIdxAndPayload(shortLiteralTag_, payload.value());
+    }
     // Find the matching prefix.
     auto it = ql::ranges::find_if(prefixes_, [&repr](std::string_view prefix) {
       return ql::starts_with(repr, prefix);
@@ -169,9 +253,18 @@ class EncodedIriManagerImpl {
       return std::nullopt;
     }
 
+    auto prefixIndex = static_cast<size_t>(it - prefixes_.begin());
+    repr.remove_prefix(it->size());
+    if (auto hexWidth = hexWidths_[prefixIndex]; hexWidth > 0) {
+      auto payload = encodeFixedWidthHex(repr, hexWidth);
+      if (!payload.has_value()) {
+        return std::nullopt;
+      }
+      return makeIdFromPrefixIdxAndPayload(prefixIndex, payload.value());
+    }
+
     // Check that after the prefix, the string contains only digits and the
     // trailing '>'.
-    repr.remove_prefix(it->size());
     auto numStringOpt = detail::matchDigitsPrefix(repr);
     if (!numStringOpt.has_value()) {
       return std::nullopt;
@@ -181,8 +274,7 @@ class EncodedIriManagerImpl {
       return std::nullopt;
     }
 
-    // Get the index of the used prefix, and run the actual encoding.
-    auto prefixIndex = static_cast<size_t>(it - prefixes_.begin());
+    // Run the actual encoding.
     return makeIdFromPrefixIdxAndPayload(prefixIndex,
                                          encodeDecimalToNBit(numString));
   }
@@ -200,9 +292,25 @@ class EncodedIriManagerImpl {
     AD_CORRECTNESS_CHECK(id.getDatatype() == Datatype::EncodedVal);
     // Get only the rightmost bits that represent the digits.
     auto [prefixIdx, digitEncoding] = splitIntoPrefixIdxAndPayload(id);
+    if (isShortLiteral(id)) {
+      return decodeShortLiteral(digitEncoding);
+    }
+    if (auto hexWidth = hexWidths_.at(prefixIdx); hexWidth > 0) {
+      std::string result = prefixes_.at(prefixIdx);
+      decodeFixedWidthHex(result, digitEncoding, hexWidth);
+      result.push_back('>');
+      return result;
+    }
     return toStringWithGivenPrefix(digitEncoding, prefixes_.at(prefixIdx));
   }
 
+  // Return true iff the `id` (which must have datatype `EncodedVal`) is an
+  // encoded short literal (and not an encoded IRI).
+  bool isShortLiteral(Id id) const {
+    return inlineShortLiterals_ &&
+           splitIntoPrefixIdxAndPayload(id).first == shortLiteralTag_;
+  }
+
   // The second half of `toString` above: combine the integer encoding of the
   // payload and the prefix string into a result string that represents an IRI.
   // Note: This function expects, that the prefix starts with `<`.
@@ -256,9 +364,14 @@ class EncodedIriManagerImpl {
   // Conversion to and from JSON.
   static constexpr const char* jsonKey_ =
       "prefixes-with-leading-angle-brackets";
+  static constexpr const char* hexWidthsJsonKey_ = "hex-widths";
+  static constexpr const char* inlineShortLiteralsJsonKey_ =
+      "inline-short-literals";
   friend void to_json(nlohmann::json& j,
                       const EncodedIriManagerImpl& encodedIriManager) {
     j[jsonKey_] = encodedIriManager.prefixes_;
+    j[hexWidthsJsonKey_] = encodedIriManager.hexWidths_;
+    j[inlineShortLiteralsJsonKey_] = encodedIriManager.inlineShortLiterals_;
   }
   friend void from_json(const nlohmann::json& j,
                         EncodedIriManagerImpl& encodedIriManager) {
@@ -273,16 +386,114 @@ class EncodedIriManagerImpl {
     // prefixes.
     encodedIriManager.prefixes_ =
         static_cast<std::vector<std::string>>(j[jsonKey_]);
+    // Indices that were built before the hexadecimal prefixes were introduced
+    // only have decimal prefixes.
+    if (j.contains(hexWidthsJsonKey_)) {
+      encodedIriManager.hexWidths_ =
+          static_cast<std::vector<size_t>>(j[hexWidthsJsonKey_]);
+    } else {
+      encodedIriManager.hexWidths_.assign(encodedIriManager.prefixes_.size(),
+                                          0);
+    }
+    AD_CORRECTNESS_CHECK(encodedIriManager.hexWidths_.size() ==
+                         encodedIriManager.prefixes_.size());
+    // The same goes for the short literals.
+    encodedIriManager.inlineShortLiterals_ =
+        j.contains(inlineShortLiteralsJsonKey_) &&
+        static_cast<bool>(j[inlineShortLiteralsJsonKey_]);
   }
 
   // Hash support for use in `TestIndexConfig`.
   template <typename H>
   friend H AbslHashValue(H h, const EncodedIriManagerImpl& manager) {
-    return H::combine(std::move(h), manager.prefixes_);
+    return H::combine(std::move(h), manager.prefixes_, manager.hexWidths_,
+                      manager.inlineShortLiterals_);
   }
 
   // Equality operator for use in `TestIndexConfig`.
-  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(EncodedIriManagerImpl, prefixes_)
+  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(EncodedIriManagerImpl, prefixes_,
+                                              hexWidths_, inlineShortLiterals_)
+
+  // Encode the `repr` of a literal (including the quotes) into a 64-bit
+  // number. Return `std::nullopt` if the literal has a language tag or a
+  // datatype, contains more than `NumLiteralChars` characters, or contains
+  // characters that are not ASCII (or the null character).
+  static std::optional<uint64_t> encodeShortLiteral(std::string_view repr) {
+    if (repr.size() < 2 || repr.front() != '"' || repr.back() != '"') {
+      return std::nullopt;
+    }
+    auto content = repr.substr(1, repr.size() - 2);
+    if (content.size() > NumLiteralChars) {
+      return std::nullopt;
+    }
+    uint64_t result = 0;
+    uint64_t shift = NumBitsEncoding - CharSize;
+    for (const char c : content) {
+      auto value = static_cast<unsigned char>(c);
+      if (value == 0 || value >= 128) {
+        return std::nullopt;
+      }
+      result |= static_cast<uint64_t>(value) << shift;
+      shift -= CharSize;
+    }
+    return result;
+  }
+
+  // The inverse of `encodeShortLiteral`, the result includes the quotes.
+  static std::string decodeShortLiteral(uint64_t encoded) {
+    std::string result;
+    result.reserve(NumLiteralChars + 2);
+    result.push_back('"');
+    size_t shift = NumBitsEncoding - CharSize;
+    for (size_t i = 0; i < NumLiteralChars; ++i) {
+      auto c = static_cast<char>((encoded >> shift) & 0x7F);
+      if (c == 0) {
+        break;
+      }
+      result.push_back(c);
+      shift -= CharSize;
+    }
+    result.push_back('"');
+    return result;
+  }
+
+  // Encode the `repr`, which has to consist of exactly `width` lowercase
+  // hexadecimal digits followed by the trailing '>', into a 64-bit number.
+  // Return `std::nullopt` if `repr` has a different form.
+  static std::optional<uint64_t> encodeFixedWidthHex(std::string_view repr,
+                                                     size_t width) {
+    AD_CORRECTNESS_CHECK(width <= NumDigits);
+    if (repr.size() != width + 1 || repr.back() != '>') {
+      return std::nullopt;
+    }
+    uint64_t result = 0;
+    uint64_t shift = NumBitsEncoding - NibbleSize;
+    for (const char c : repr.substr(0, width)) {
+      uint64_t nibble;
+      if (c >= '0' && c <= '9') {
+        nibble = c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        nibble = c - 'a' + 10;
+      } else {
+        return std::nullopt;
+      }
+      result |= nibble << shift;
+      shift -= NibbleSize;
+    }
+    return result;
+  }
+
+  // The inverse of `encodeFixedWidthHex`. The `width` digits are appended to
+  // the `result` string.
+  static void decodeFixedWidthHex(std::string& result, uint64_t encoded,
+                                  size_t width) {
+    static constexpr std::string_view hexDigits = "0123456789abcdef";
+    size_t shift = NumBitsEncoding - NibbleSize;
+    for (size_t i = 0; i < width; ++i) {
+      result.push_back(hexDigits[(encoded >> shift) & 0xF]);
+      shift -= NibbleSize;
+    }
+  }
 
   // Encode the `numberStr` (which may only consist of digits) into a 64-bit
   // number.
@@ -76,7 +76,8 @@ std::optional<Literal> handleIriOrLiteral(
 // _____________________________________________________________________________
 std::optional<Literal> idToLiteral(const IndexImpl& index, Id id,
                                    const LocalVocab& localVocab,
-                                   bool onlyReturnLiteralsWithXsdString) {
+                                   bool onlyReturnLiteralsWithXsdString,
+                                   VocabDecodeCache* decodeCache) {
   using enum Datatype;
   auto datatype = id.getDatatype();
 
@@ -89,7 +90,7 @@ std::optional<Literal> idToLiteral(const IndexImpl& index, Id id,
     case VocabIndex:
     case LocalVocabIndex:
       return handleIriOrLiteral(
-          getLiteralOrIriFromVocabIndex(index, id, localVocab),
+          getLiteralOrIriFromVocabIndex(index, id, localVocab, decodeCache),
           onlyReturnLiteralsWithXsdString);
     case TextRecordIndex:
       return getLiteralOrNullopt(getLiteralOrIriFromTextRecordIndex(index, id));
@@ -98,6 +99,47 @@ std::optional<Literal> idToLiteral(const IndexImpl& index, Id id,
   }
 }
 
+// _____________________________________________________________________________
+std::vector<std::optional<Literal>> idsToLiterals(
+    const IndexImpl& index, ql::span<const Id> ids,
+    const LocalVocab& localVocab, bool onlyReturnLiteralsWithXsdString,
+    VocabDecodeCache* decodeCache) {
+  std::vector<std::optional<Literal>> result(ids.size());
+  std::vector<VocabIndex> vocabIndices;
+  std::vector<size_t> vocabPositions;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (ids[i].getDatatype() == Datatype::VocabIndex) {
+      vocabIndices.push_back(ids[i].getVocabIndex());
+      vocabPositions.push_back(i);
+    } else {
+      result[i] = idToLiteral(index, ids[i], localVocab,
+                              onlyReturnLiteralsWithXsdString);
+    }
+  }
+  auto words = getVocabWords(index, vocabIndices, decodeCache);
+  for (size_t i = 0; i < words.size(); ++i) {
+    result[vocabPositions[i]] = handleIriOrLiteral(
+        LiteralOrIri::fromStringRepresentation(std::move(words[i])),
+        onlyReturnLiteralsWithXsdString);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::vector<std::string> getVocabWords(const IndexImpl& index,
+                                       ql::span<const VocabIndex> vocabIndices,
+                                       VocabDecodeCache* decodeCache) {
+  if (decodeCache == nullptr) {
+    return index.indicesToStrings(vocabIndices);
+  }
+  std::vector<std::string> result;
+  result.reserve(vocabIndices.size());
+  for (const auto& word : decodeCache->getOrDecode(index, vocabIndices)) {
+    result.push_back(*word);
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 std::optional<Literal> getLiteralOrNullopt(
     std::optional<LiteralOrIri> litOrIri) {
@@ -147,7 +189,8 @@ std::optional<LiteralOrIri> getLiteralOrIriFromTextRecordIndex(
 // _____________________________________________________________________________
 std::optional<LiteralOrIri> idToLiteralOrIri(const IndexImpl& index, Id id,
                                              const LocalVocab& localVocab,
-                                             bool skipEncodedValues) {
+                                             bool skipEncodedValues,
+                                             VocabDecodeCache* decodeCache) {
   using enum Datatype;
   switch (id.getDatatype()) {
     case WordVocabIndex:
@@ -155,8 +198,8 @@ std::optional<LiteralOrIri> idToLiteralOrIri(const IndexImpl& index, Id id,
     case VocabIndex:
     case LocalVocabIndex:
     case EncodedVal:
-      return ql::exportIds::getLiteralOrIriFromVocabIndex(index, id,
-                                                          localVocab);
+      return ql::exportIds::getLiteralOrIriFromVocabIndex(index, id, localVocab,
+                                                          decodeCache);
     case TextRecordIndex:
       return getLiteralOrIriFromTextRecordIndex(index, id);
     default:
@@ -182,11 +225,16 @@ std::optional<std::string> blankNodeIriToString(const Iri& iri) {
 
 // _____________________________________________________________________________
 LiteralOrIri getLiteralOrIriFromVocabIndex(const IndexImpl& index, Id id,
-                                           const LocalVocab& localVocab) {
+                                           const LocalVocab& localVocab,
+                                           VocabDecodeCache* decodeCache) {
   switch (id.getDatatype()) {
     case Datatype::LocalVocabIndex:
       return localVocab.getWord(id.getLocalVocabIndex()).asLiteralOrIri();
     case Datatype::VocabIndex: {
+      if (decodeCache != nullptr) {
+        return LiteralOrIri::fromStringRepresentation(
+            *decodeCache->getOrDecode(index, id.getVocabIndex()));
+      }
       auto getEntity = [&index, id]() {
         return index.indexToString(id.getVocabIndex());
       };
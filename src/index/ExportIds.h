@@ -23,6 +23,7 @@
 #include "index/Index.h"
 #include "index/IndexImpl.h"
 #include "index/LocalVocab.h"
+#include "index/VocabDecodeCache.h"
 #include "parser/LiteralOrIri.h"
 #include "util/ValueIdentity.h"
 
@@ -40,13 +41,25 @@ using Literal = ad_utility::triple_component::Literal;
 // 'onlyReturnLiteralsWithXsdString' is true, all IRIs and literals with
 // non-`xsd:string` datatypes (including encoded IDs) return `std::nullopt`.
 // These semantics are useful for the string expressions in
-// StringExpressions.cpp.
+// StringExpressions.cpp. If a `decodeCache` is given, the words of `Id`s with
+// datatype `VocabIndex` are looked up in it (this also holds for all the
+// following functions with a `decodeCache` argument).
 std::optional<Literal> idToLiteral(
     const IndexImpl& index, Id id, const LocalVocab& localVocab,
-    bool onlyReturnLiteralsWithXsdString = false);
+    bool onlyReturnLiteralsWithXsdString = false,
+    VocabDecodeCache* decodeCache = nullptr);
 
-// Same as the previous function, but only handles the datatypes for which the
-// value is encoded directly in the ID. For other datatypes an exception is
+// Bulk version of `idToLiteral` with the same semantics for each of the `ids`.
+// The words of all the `Id`s with datatype `VocabIndex` are retrieved with a
+// single call to `getVocabWords`, which reads the on-disk vocabulary in a
+// single sorted pass.
+std::vector<std::optional<Literal>> idsToLiterals(
+    const IndexImpl& index, ql::span<const Id> ids,
+    const LocalVocab& localVocab, bool onlyReturnLiteralsWithXsdString = false,
+    VocabDecodeCache* decodeCache = nullptr);
+
+// Same as the `idToLiteral` function, but only handles the datatypes for which
+// the value is encoded directly in the ID. For other datatypes an exception is
 // thrown.
 // If `onlyReturnLiteralsWithXsdString` is `true`, returns `std::nullopt`.
 // If `onlyReturnLiteralsWithXsdString` is `false`, removes datatypes from
@@ -61,9 +74,9 @@ std::optional<Literal> handleIriOrLiteral(LiteralOrIri word,
 
 // The function resolves a given `ValueId` to a `LiteralOrIri` object. Unlike
 // `idToLiteral` no further processing is applied to the string content.
-std::optional<LiteralOrIri> idToLiteralOrIri(const IndexImpl& index, Id id,
-                                             const LocalVocab& localVocab,
-                                             bool skipEncodedValues = false);
+std::optional<LiteralOrIri> idToLiteralOrIri(
+    const IndexImpl& index, Id id, const LocalVocab& localVocab,
+    bool skipEncodedValues = false, VocabDecodeCache* decodeCache = nullptr);
 
 // Helper for the `idToLiteralOrIri` function: Retrieves a string literal from
 // a value encoded in the given ValueId.
@@ -96,8 +109,15 @@ std::optional<std::string> blankNodeIriToString(const Iri& iri);
 // is of type `VocabIndex`, `LocalVocabIndex`, or `EncodedVal`. This function
 // should only be called with suitable `Datatype` Ids, otherwise `AD_FAIL()` is
 // called.
-LiteralOrIri getLiteralOrIriFromVocabIndex(const IndexImpl& index, Id id,
-                                           const LocalVocab& localVocab);
+LiteralOrIri getLiteralOrIriFromVocabIndex(
+    const IndexImpl& index, Id id, const LocalVocab& localVocab,
+    VocabDecodeCache* decodeCache = nullptr);
+
+// Return the words of the vocabulary for the `vocabIndices` (in the same
+// order), they are retrieved with a single bulk lookup.
+std::vector<std::string> getVocabWords(const IndexImpl& index,
+                                       ql::span<const VocabIndex> vocabIndices,
+                                       VocabDecodeCache* decodeCache = nullptr);
 
 // Convert an ID whose value is encoded in the ID bits to (string, XSD-type).
 // Returns std::nullopt for Undefined. Throws for non-encoded-value datatypes.
@@ -108,6 +128,32 @@ idToStringAndTypeForEncodedValue(Id id);
 // IRI via the `EncodedIriManager` in the index.
 LiteralOrIri encodedIdToLiteralOrIri(Id id, const IndexImpl& index);
 
+// Helper for `idToStringAndType` and `idsToStringAndType`: Convert the `word`
+// to a (string, XSD-type) pair, see `idToStringAndType` for the semantics of
+// the template parameters.
+template <bool removeQuotesAndAngleBrackets, bool returnOnlyLiterals,
+          typename EscapeFunction>
+std::optional<std::pair<std::string, const char*>> literalOrIriToStringAndType(
+    const LiteralOrIri& word, EscapeFunction& escapeFunction) {
+  if constexpr (returnOnlyLiterals) {
+    if (!word.isLiteral()) {
+      return std::nullopt;
+    }
+  }
+  if (word.isIri()) {
+    if (auto blankNodeString = blankNodeIriToString(word.getIri())) {
+      return std::pair{std::move(blankNodeString.value()), nullptr};
+    }
+  }
+  if constexpr (removeQuotesAndAngleBrackets) {
+    // TODO<joka921> Can we get rid of the string copying here?
+    return std::pair{
+        escapeFunction(std::string{asStringViewUnsafe(word.getContent())}),
+        nullptr};
+  }
+  return std::pair{escapeFunction(word.toStringRepresentation()), nullptr};
+}
+
 // Convert the `id` to a human-readable string. The `index` is used to resolve
 // `Id`s with datatype `VocabIndex` or `TextRecordIndex`. The `localVocab` is
 // used to resolve `Id`s with datatype `LocalVocabIndex`. The `escapeFunction`
@@ -125,7 +171,8 @@ template <bool removeQuotesAndAngleBrackets = false,
           typename EscapeFunction = ql::identity>
 std::optional<std::pair<std::string, const char*>> idToStringAndType(
     const Index& index, Id id, const LocalVocab& localVocab,
-    EscapeFunction&& escapeFunction = EscapeFunction{}) {
+    EscapeFunction&& escapeFunction = EscapeFunction{},
+    VocabDecodeCache* decodeCache = nullptr) {
   using enum Datatype;
   auto datatype = id.getDatatype();
   if constexpr (returnOnlyLiterals) {
@@ -134,25 +181,10 @@ std::optional<std::pair<std::string, const char*>> idToStringAndType(
     }
   }
 
-  auto handleIriOrLiteral = [&escapeFunction](const LiteralOrIri& word)
-      -> std::optional<std::pair<std::string, const char*>> {
-    if constexpr (returnOnlyLiterals) {
-      if (!word.isLiteral()) {
-        return std::nullopt;
-      }
-    }
-    if (word.isIri()) {
-      if (auto blankNodeString = blankNodeIriToString(word.getIri())) {
-        return std::pair{std::move(blankNodeString.value()), nullptr};
-      }
-    }
-    if constexpr (removeQuotesAndAngleBrackets) {
-      // TODO<joka921> Can we get rid of the string copying here?
-      return std::pair{
-          escapeFunction(std::string{asStringViewUnsafe(word.getContent())}),
-          nullptr};
-    }
-    return std::pair{escapeFunction(word.toStringRepresentation()), nullptr};
+  auto handleIriOrLiteral = [&escapeFunction](const LiteralOrIri& word) {
+    return literalOrIriToStringAndType<removeQuotesAndAngleBrackets,
+                                       returnOnlyLiterals>(word,
+                                                           escapeFunction);
   };
 
   switch (id.getDatatype()) {
@@ -162,8 +194,8 @@ std::optional<std::pair<std::string, const char*>> idToStringAndType(
     }
     case VocabIndex:
     case LocalVocabIndex:
-      return handleIriOrLiteral(
-          getLiteralOrIriFromVocabIndex(index.getImpl(), id, localVocab));
+      return handleIriOrLiteral(getLiteralOrIriFromVocabIndex(
+          index.getImpl(), id, localVocab, decodeCache));
     case EncodedVal:
       return handleIriOrLiteral(encodedIdToLiteralOrIri(id, index.getImpl()));
     case TextRecordIndex:
@@ -175,49 +207,61 @@ std::optional<std::pair<std::string, const char*>> idToStringAndType(
   }
 }
 
-// Batch variant of idToStringAndType.
-// Precondition: `ids` is sorted by `ValueId` (as `ConstructBatchEvaluator`
-// does before calling vocabulary lookups). Under this precondition, all
-// `VocabIndex` IDs form a single contiguous block that is already sorted by
-// vocabulary position, so they can be resolved last and in sequential order
-// for I/O-local access to the on-disk vocabulary. All other IDs are resolved
-// immediately since their values are either encoded in the id bits or stored
-// in the in-memory `LocalVocab`.
+// Batch variant of `idToStringAndType`. The words of all the `Id`s with
+// datatype `VocabIndex` are retrieved with a single call to
+// `getVocabWords`, which sorts and deduplicates the indices, s.t.
+// the on-disk vocabulary is read (and decompressed) in a single pass.
+// Similarly, the excerpts of all the `Id`s with datatype `TextRecordIndex` are
+// retrieved with a single call to `Index::getTextExcerpts`, which decompresses
+// each block of the text records at most once. All other IDs are resolved
+// individually, since their values are either encoded in the id bits or stored
+// in the in-memory `LocalVocab`. The `ids` may be in any order, but callers
+// that sort them (for example by their bits) save the sorting inside the
+// vocabulary.
 template <bool removeQuotesAndAngleBrackets = false,
           bool returnOnlyLiterals = false,
           typename EscapeFunction = ql::identity>
 std::vector<std::optional<std::pair<std::string, const char*>>>
 idsToStringAndType(const Index& index, ql::span<const Id> ids,
                    const LocalVocab& localVocab,
-                   EscapeFunction&& escapeFunction = EscapeFunction{}) {
+                   EscapeFunction&& escapeFunction = EscapeFunction{},
+                   VocabDecodeCache* decodeCache = nullptr) {
   std::vector<std::optional<std::pair<std::string, const char*>>> results(
       ids.size());
 
-  // `ids` is sorted by `ValueId`. Because the datatype tag occupies the 4 most
-  // significant bits of a `ValueId`, all `VocabIndex` IDs form a single
-  // contiguous block and are already sorted by vocabulary position within that
-  // block. We resolve all other datatypes immediately (in-memory lookups) and
-  // record where the `VocabIndex` block begins.
-  size_t vocabBegin = ids.size();
+  std::vector<::VocabIndex> vocabIndices;
+  std::vector<size_t> vocabPositions;
+  std::vector<::TextRecordIndex> textRecordIndices;
+  std::vector<size_t> textRecordPositions;
   for (size_t i = 0; i < ids.size(); ++i) {
-    if (ids[i].getDatatype() != Datatype::VocabIndex) {
+    if (ids[i].getDatatype() == Datatype::VocabIndex) {
+      vocabIndices.push_back(ids[i].getVocabIndex());
+      vocabPositions.push_back(i);
+    } else if (!returnOnlyLiterals &&
+               ids[i].getDatatype() == Datatype::TextRecordIndex) {
+      textRecordIndices.push_back(ids[i].getTextRecordIndex());
+      textRecordPositions.push_back(i);
+    } else {
       results[i] =
           idToStringAndType<removeQuotesAndAngleBrackets, returnOnlyLiterals>(
               index, ids[i], localVocab, escapeFunction);
-    } else if (vocabBegin == ids.size()) {
-      vocabBegin = i;
     }
   }
 
-  // Resolve the contiguous `VocabIndex` block in sorted (vocabulary-position)
-  // order, giving sequential I/O access to the on-disk vocabulary file.
-  for (size_t i = vocabBegin;
-       i < ids.size() && ids[i].getDatatype() == Datatype::VocabIndex; ++i) {
-    results[i] =
-        idToStringAndType<removeQuotesAndAngleBrackets, returnOnlyLiterals>(
-            index, ids[i], localVocab, escapeFunction);
+  auto words = getVocabWords(index.getImpl(), vocabIndices, decodeCache);
+  for (size_t i = 0; i < words.size(); ++i) {
+    results[vocabPositions[i]] =
+        literalOrIriToStringAndType<removeQuotesAndAngleBrackets,
+                                    returnOnlyLiterals>(
+            LiteralOrIri::fromStringRepresentation(std::move(words[i])),
+            escapeFunction);
   }
 
+  auto excerpts = index.getTextExcerpts(textRecordIndices);
+  for (size_t i = 0; i < excerpts.size(); ++i) {
+    results[textRecordPositions[i]] =
+        std::pair{escapeFunction(std::move(excerpts[i])), nullptr};
+  }
   return results;
 }
 
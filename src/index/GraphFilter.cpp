@@ -50,6 +50,12 @@ bool GraphFilter<T>::areAllGraphsAllowed() const {
   return std::holds_alternative<AllTag>(filter_);
 }
 
+//______________________________________________________________________________
+template <typename T>
+const ad_utility::HashSet<T>* GraphFilter<T>::getWhitelist() const {
+  return std::get_if<ad_utility::HashSet<T>>(&filter_);
+}
+
 //______________________________________________________________________________
 template <typename T>
 void GraphFilter<T>::format(
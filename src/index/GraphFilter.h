@@ -83,6 +83,9 @@ class GraphFilter {
   // Return true iff all graphs are always allowed.
   bool areAllGraphsAllowed() const;
 
+  // Return the allowed graphs if this filter is a whitelist, else `nullptr`.
+  const ad_utility::HashSet<T>* getWhitelist() const;
+
   // Make sure this filter is comparable.
   QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(GraphFilter, filter_)
 
@@ -4,9 +4,124 @@
 
 #include "index/IdTableUtils.h"
 
+#include <algorithm>
+#include <array>
+#include <future>
+
 #include "engine/CallFixedSize.h"
+#include "global/ValueIdComparators.h"
 #include "util/ChunkedForLoop.h"
 #include "util/Exception.h"
+#include "util/ParallelExecutor.h"
+
+namespace {
+// Helpers for `IdTableUtils::radixSort`.
+namespace radixSortDetail {
+using Bits = Id::T;
+constexpr size_t numBitsPerDigit = 8;
+constexpr size_t numBuckets = size_t{1} << numBitsPerDigit;
+constexpr size_t numDigits = sizeof(Bits) * 8 / numBitsPerDigit;
+// Below this number of rows, the overhead of spawning threads dominates.
+constexpr size_t minNumRowsPerThread = 50'000;
+
+template <typename T>
+using Vector = std::vector<T, ad_utility::AllocatorWithLimit<T>>;
+
+// A key together with the index of its row in the original table.
+struct KeyAndIndex {
+  Bits key_;
+  size_t index_;
+};
+
+using Histogram = std::array<size_t, numBuckets>;
+
+// Return the `digit`-th digit of the `key`, starting from the least
+// significant one.
+Bits getDigit(Bits key, size_t digit) {
+  return (key >> (digit * numBitsPerDigit)) & (numBuckets - 1);
+}
+
+// Split `[0, size)` into `numChunks` contiguous chunks and call
+// `function(chunkIndex, begin, end)` for each of them in parallel.
+template <typename F>
+void forEachChunkInParallel(size_t size, size_t numChunks, const F& function) {
+  if (numChunks <= 1) {
+    function(size_t{0}, size_t{0}, size);
+    return;
+  }
+  std::vector<std::packaged_task<void()>> tasks;
+  for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+    tasks.emplace_back([&function, chunk, begin = size * chunk / numChunks,
+                        end = size * (chunk + 1) / numChunks]() {
+      function(chunk, begin, end);
+    });
+  }
+  ad_utility::runTasksInParallel(std::move(tasks));
+}
+
+// Stably sort the `data` by the `key_` member. The `buffer` must have the same
+// size as the `data`, its contents are unspecified after the call.
+void radixSortByKey(Vector<KeyAndIndex>& data, Vector<KeyAndIndex>& buffer,
+                    size_t numThreads) {
+  const size_t size = data.size();
+  // Count the occurrences of all digits. A digit that has the same value for
+  // all keys (which is typically the case for the datatype bits and the most
+  // significant bits of the indices) doesn't need to be sorted by.
+  std::vector<std::array<Histogram, numDigits>> threadHistograms(numThreads);
+  forEachChunkInParallel(size, numThreads, [&](size_t chunk, size_t begin,
+                                               size_t end) {
+    auto& histograms = threadHistograms[chunk];
+    for (size_t i = begin; i < end; ++i) {
+      for (size_t digit = 0; digit < numDigits; ++digit) {
+        ++histograms[digit][getDigit(data[i].key_, digit)];
+      }
+    }
+  });
+  auto isTrivialDigit = [&](size_t digit) {
+    auto bucket = getDigit(data.front().key_, digit);
+    size_t count = 0;
+    for (const auto& histograms : threadHistograms) {
+      count += histograms[digit][bucket];
+    }
+    return count == size;
+  };
+
+  std::vector<Histogram> offsets(numThreads);
+  for (size_t digit = 0; digit < numDigits; ++digit) {
+    if (isTrivialDigit(digit)) {
+      continue;
+    }
+    // The per-thread histograms from above can't be reused for the scatter,
+    // because the contents of the chunks change after each pass.
+    forEachChunkInParallel(size, numThreads, [&](size_t chunk, size_t begin,
+                                                 size_t end) {
+      auto& histogram = offsets[chunk];
+      histogram.fill(0);
+      for (size_t i = begin; i < end; ++i) {
+        ++histogram[getDigit(data[i].key_, digit)];
+      }
+    });
+    // Turn the counts into the start offsets for each (bucket, thread) pair.
+    size_t offset = 0;
+    for (size_t bucket = 0; bucket < numBuckets; ++bucket) {
+      for (auto& histogram : offsets) {
+        size_t count = histogram[bucket];
+        histogram[bucket] = offset;
+        offset += count;
+      }
+    }
+    forEachChunkInParallel(size, numThreads, [&](size_t chunk, size_t begin,
+                                                 size_t end) {
+      auto& histogram = offsets[chunk];
+      for (size_t i = begin; i < end; ++i) {
+        buffer[histogram[getDigit(data[i].key_, digit)]++] = data[i];
+      }
+    });
+    std::swap(data, buffer);
+  }
+}
+}  // namespace radixSortDetail
+}  // namespace
 
 // The actual implementation of sorting an `IdTable` according to the
 // `sortCols`.
@@ -14,45 +129,135 @@ void IdTableUtils::sort(IdTable& idTable,
                         const std::vector<ColumnIndex>& sortCols) {
   size_t width = idTable.numColumns();
 
-  // Instantiate specialized comparison lambdas for one and two sort columns
-  // and use a generic comparison for a higher number of sort columns.
-  // TODO<joka921> As soon as we have merged the benchmark, measure whether
-  // this is in fact beneficial and whether it should also be applied for a
-  // higher number of columns, maybe even using `CALL_FIXED_SIZE` for the
-  // number of sort columns.
-  // TODO<joka921> Also experiment with sorting algorithms that take the
-  // column-based structure of the `IdTable` into account.
-  if (sortCols.size() == 1) {
-    ad_utility::callFixedSizeVi(width, [&idTable, col = sortCols[0]](auto I) {
-      IdTableUtils::sort<I>(&idTable, col);
-    });
-  } else if (sortCols.size() == 2) {
-    auto comparison = [c0 = sortCols[0], c1 = sortCols[1]](const auto& row1,
-                                                           const auto& row2) {
-      if (row1[c0] != row2[c0]) {
-        return row1[c0] < row2[c0];
-      } else {
-        return row1[c1] < row2[c1];
-      }
+  auto hasNoLocalVocabEntries = [&idTable](ColumnIndex col) {
+    return valueIdComparators::containsNoLocalVocabIndex(
+        idTable.getColumn(col));
+  };
+  bool compareByBits = ql::ranges::all_of(sortCols, hasNoLocalVocabEntries);
+  if (idTable.numRows() >= minNumRowsForRadixSort && !sortCols.empty() &&
+      sortCols.size() <= 3 && compareByBits) {
+    radixSort(idTable, sortCols);
+    return;
+  }
+
+  // Without `LocalVocabIndex` entries in the `sortCols` (the common case of
+  // columns that only contain `VocabIndex`es or only `Int`s), the `Id`s are
+  // compared by their bits, which is a single comparison without branches.
+  // The comparison lambdas are instantiated separately for both cases.
+  auto sortWithKey = [&idTable, &sortCols, width](auto key) {
+    // Instantiate specialized comparison lambdas for one and two sort columns
+    // and use a generic comparison for a higher number of sort columns.
+    // TODO<joka921> As soon as we have merged the benchmark, measure whether
+    // this is in fact beneficial and whether it should also be applied for a
+    // higher number of columns, maybe even using `CALL_FIXED_SIZE` for the
+    // number of sort columns.
+    // TODO<joka921> Also experiment with sorting algorithms that take the
+    // column-based structure of the `IdTable` into account.
+    // Sorting is one of the hottest operations, so it is instantiated for more
+    // widths than most other operations.
+    static constexpr int maxWidth =
+        MAX_NUM_COLUMNS_STATIC_ID_TABLE_HOT_OPERATORS;
+    auto sortWithComparison = [&idTable, width](const auto& comparison) {
+      ad_utility::callFixedSizeVi<maxWidth>(
+          width, [&idTable, &comparison](auto I) {
+            IdTableUtils::sort<I>(&idTable, comparison);
+          });
     };
-    ad_utility::callFixedSizeVi(idTable.numColumns(),
-                                [&idTable, comparison](auto I) {
-                                  IdTableUtils::sort<I>(&idTable, comparison);
-                                });
-  } else {
-    auto comparison = [&sortCols](const auto& row1, const auto& row2) {
-      for (auto& col : sortCols) {
-        if (row1[col] != row2[col]) {
-          return row1[col] < row2[col];
+    if (sortCols.size() == 1) {
+      sortWithComparison(
+          [key, c0 = sortCols[0]](const auto& row1, const auto& row2) {
+            return key(row1[c0]) < key(row2[c0]);
+          });
+    } else if (sortCols.size() == 2) {
+      sortWithComparison([key, c0 = sortCols[0], c1 = sortCols[1]](
+                             const auto& row1, const auto& row2) {
+        if (key(row1[c0]) != key(row2[c0])) {
+          return key(row1[c0]) < key(row2[c0]);
+        } else {
+          return key(row1[c1]) < key(row2[c1]);
         }
-      }
-      return false;
+      });
+    } else {
+      sortWithComparison([key, &sortCols](const auto& row1, const auto& row2) {
+        for (auto& col : sortCols) {
+          if (key(row1[col]) != key(row2[col])) {
+            return key(row1[col]) < key(row2[col]);
+          }
+        }
+        return false;
+      });
+    }
+  };
+  if (compareByBits) {
+    sortWithKey([](Id id) { return id.getBits(); });
+  } else {
+    sortWithKey([](Id id) { return id; });
+  }
+}
+
+// ___________________________________________________________________________
+void IdTableUtils::radixSort(IdTable& idTable,
+                             const std::vector<ColumnIndex>& sortCols) {
+  radixSort(idTable, sortCols,
+            std::vector<RadixSortKey>(sortCols.size(), nullptr));
+}
+
+// ___________________________________________________________________________
+void IdTableUtils::radixSort(IdTable& idTable,
+                             const std::vector<ColumnIndex>& sortCols,
+                             const std::vector<RadixSortKey>& keyFunctions) {
+  using namespace radixSortDetail;
+  AD_CONTRACT_CHECK(sortCols.size() == keyFunctions.size());
+  const size_t numRows = idTable.numRows();
+  if (numRows <= 1 || sortCols.empty()) {
+    return;
+  }
+  AD_LOG_DEBUG << "Radix sorting " << numRows << " elements ..." << std::endl;
+  const size_t numThreads =
+      std::clamp<size_t>(numRows / minNumRowsPerThread, 1, NUM_SORT_THREADS);
+  auto allocator = idTable.getAllocator();
+  Vector<KeyAndIndex> data(numRows, allocator);
+  Vector<KeyAndIndex> buffer(numRows, allocator);
+
+  // LSD order: Sort by the least significant column first, the stability of
+  // the sort then yields the lexicographic order.
+  bool isFirstColumn = true;
+  for (size_t k = sortCols.size(); k-- > 0;) {
+    decltype(auto) column = idTable.getColumn(sortCols[k]);
+    RadixSortKey keyFunction = keyFunctions[k];
+    auto getKey = [keyFunction](Id id) {
+      return keyFunction == nullptr ? id.getBits() : keyFunction(id);
     };
-    ad_utility::callFixedSizeVi(idTable.numColumns(),
-                                [&idTable, comparison](auto I) {
-                                  IdTableUtils::sort<I>(&idTable, comparison);
-                                });
+    forEachChunkInParallel(
+        numRows, numThreads, [&](size_t, size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            if (isFirstColumn) {
+              data[i] = {getKey(column[i]), i};
+            } else {
+              data[i].key_ = getKey(column[data[i].index_]);
+            }
+          }
+        });
+    isFirstColumn = false;
+    radixSortByKey(data, buffer, numThreads);
   }
+
+  // Apply the permutation to all columns, the columns are distributed among
+  // the threads.
+  const size_t numColumns = idTable.numColumns();
+  forEachChunkInParallel(
+      numColumns, std::min(numThreads, numColumns),
+      [&](size_t, size_t beginCol, size_t endCol) {
+        Vector<Id> permuted(numRows, allocator);
+        for (size_t col = beginCol; col < endCol; ++col) {
+          decltype(auto) column = idTable.getColumn(col);
+          for (size_t i = 0; i < numRows; ++i) {
+            permuted[i] = column[data[i].index_];
+          }
+          ql::ranges::copy(permuted, column.begin());
+        }
+      });
+  AD_LOG_TRACE << "Radix sort done.\n";
 }
 
 // ___________________________________________________________________________
@@ -56,8 +56,38 @@ class IdTableUtils {
     AD_LOG_DEBUG << "Sort done.\n";
   }
 
+  // Sort the `idTable` by the `sortCols` (in the internal order of the `Id`s).
+  // Large tables that are sorted by at most three columns which contain no
+  // `LocalVocabIndex` entries are sorted via `radixSort` below, all other
+  // tables via a comparison-based sort.
   static void sort(IdTable& idTable, const std::vector<ColumnIndex>& sortCols);
 
+  // Tables with fewer rows are always sorted via the comparison-based sort.
+  static constexpr size_t minNumRowsForRadixSort = 100'000;
+
+  // Stable LSD radix sort of the `idTable` by the bits of the `Id`s in the
+  // `sortCols`. First a sorting permutation is computed (8-bit digits, digits
+  // that are the same for all rows, e.g. the datatype bits, are skipped), then
+  // the permutation is applied to all columns. Both steps use up to
+  // `NUM_SORT_THREADS` threads. The order of the bits is the order of the `Id`s
+  // only if there are no `LocalVocabIndex` entries in the `sortCols`, this has
+  // to be ensured by the caller.
+  static void radixSort(IdTable& idTable,
+                        const std::vector<ColumnIndex>& sortCols);
+
+  // A function that maps an `Id` to the key by which it is ordered in the
+  // `radixSort` below. `nullptr` stands for the bits of the `Id`.
+  using RadixSortKey = Id::T (*)(Id);
+
+  // Like `radixSort` above, but the `Id`s of `sortCols[i]` are ordered by the
+  // keys `keyFunctions[i](id)`. This can be used to sort by orders other than
+  // the internal order of the `Id`s (e.g. the order of `ORDER BY`), as long as
+  // this order can be expressed by an order-preserving key of the single
+  // `Id`s.
+  static void radixSort(IdTable& idTable,
+                        const std::vector<ColumnIndex>& sortCols,
+                        const std::vector<RadixSortKey>& keyFunctions);
+
   // Return the number of distinct rows in the `input`. The input must have all
   // duplicates adjacent to each other (e.g. by being sorted), otherwise the
   // behavior is undefined. `checkCancellation()` is invoked regularly and can
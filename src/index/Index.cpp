@@ -51,6 +51,12 @@ RdfsVocabulary::AccessReturnType Index::indexToString(VocabIndex id) const {
   return pimpl_->indexToString(id);
 }
 
+// ____________________________________________________________________________
+std::vector<std::string> Index::indicesToStrings(
+    ql::span<const VocabIndex> ids) const {
+  return pimpl_->indicesToStrings(ids);
+}
+
 // ____________________________________________________________________________
 TextVocabulary::AccessReturnType Index::indexToString(WordVocabIndex id) const {
   return pimpl_->indexToString(id);
@@ -116,6 +122,12 @@ std::string Index::getTextExcerpt(TextRecordIndex cid) const {
   return pimpl_->getTextExcerpt(cid);
 }
 
+// ____________________________________________________________________________
+std::vector<std::string> Index::getTextExcerpts(
+    ql::span<const TextRecordIndex> cids) const {
+  return pimpl_->getTextExcerpts(cids);
+}
+
 // ____________________________________________________________________________
 float Index::getAverageNofEntityContexts() const {
   return pimpl_->getAverageNofEntityContexts();
@@ -143,6 +155,9 @@ bool& Index::addHasWordTriples() { return pimpl_->addHasWordTriples(); }
 // ____________________________________________________________________________
 bool& Index::doNotLoadPermutations() { return pimpl_->doNotLoadPermutations(); }
 
+// ____________________________________________________________________________
+bool& Index::lazyLoadPermutations() { return pimpl_->lazyLoadPermutations(); }
+
 // ____________________________________________________________________________
 void Index::setKeepTempFiles(bool keepTempFiles) {
   return pimpl_->setKeepTempFiles(keepTempFiles);
@@ -202,6 +217,9 @@ const std::string& Index::getOnDiskBase() const {
 // ____________________________________________________________________________
 const std::string& Index::getIndexId() const { return pimpl_->getIndexId(); }
 
+// ____________________________________________________________________________
+uint64_t Index::getInstanceId() const { return pimpl_->getInstanceId(); }
+
 // ____________________________________________________________________________
 const std::string& Index::getGitShortHash() const {
   return pimpl_->getGitShortHash();
@@ -131,6 +131,11 @@ class Index {
   RdfsVocabulary::AccessReturnType indexToString(VocabIndex id) const;
   TextVocabulary::AccessReturnType indexToString(WordVocabIndex id) const;
 
+  // Bulk version of `indexToString` for the `ids` (in any order, duplicates
+  // are allowed), see `Vocabulary::lookupMany`.
+  std::vector<std::string> indicesToStrings(
+      ql::span<const VocabIndex> ids) const;
+
   [[nodiscard]] Vocab::PrefixRanges prefixRanges(std::string_view prefix) const;
 
   [[nodiscard]] const CompactVectorOfStrings<Id>& getPatterns() const;
@@ -173,6 +178,11 @@ class Index {
 
   [[nodiscard]] std::string getTextExcerpt(TextRecordIndex cid) const;
 
+  // Return the text excerpts of all the `cids` (in the same order). This is
+  // much cheaper than calling `getTextExcerpt` for each of them.
+  [[nodiscard]] std::vector<std::string> getTextExcerpts(
+      ql::span<const TextRecordIndex> cids) const;
+
   [[nodiscard]] float getAverageNofEntityContexts() const;
 
   void setKbName(const std::string& name);
@@ -187,6 +197,9 @@ class Index {
 
   bool& doNotLoadPermutations();
 
+  // Load the SPO, SOP, OPS, and OSP permutations only on their first use.
+  bool& lazyLoadPermutations();
+
   void setKeepTempFiles(bool keepTempFiles);
 
   ad_utility::MemorySize& memoryLimitIndexBuilding();
@@ -207,6 +220,7 @@ class Index {
   const std::string& getKbName() const;
   const std::string& getOnDiskBase() const;
   const std::string& getIndexId() const;
+  uint64_t getInstanceId() const;
   const std::string& getGitShortHash() const;
 
   NumNormalAndInternal numTriples() const;
@@ -137,9 +137,18 @@ auto getFileSpecifications = [](const auto& filetype, auto& inputFile,
     if (filename == "-") {
       filename = "/dev/stdin";
     }
-    fileSpecs.emplace_back(filename, getFiletype(type, filename),
+    // Compressed files are decompressed on the fly, the file format is then
+    // deduced from the extension before the compression extension.
+    auto compression = compressionFromFilename(filename);
+    std::string_view filenameWithoutCompression = filename;
+    if (compression != InputCompression::None) {
+      filenameWithoutCompression = filenameWithoutCompression.substr(
+          0, filenameWithoutCompression.rfind('.'));
+    }
+    fileSpecs.emplace_back(filename,
+                           getFiletype(type, filenameWithoutCompression),
                            std::move(defaultGraph), parseInParallel,
-                           parseInParallelSetExplicitly);
+                           parseInParallelSetExplicitly, compression);
   }
   return fileSpecs;
 };
@@ -204,7 +213,8 @@ int main(int argc, char** argv) {
       "The basename of the output files (required).");
   add("kg-input-file,f", po::value(&inputFile),
       "The file with the knowledge graph data to be parsed from. If omitted, "
-      "will read from stdin.");
+      "will read from stdin. Files that end on `.gz` or `.zst` are "
+      "decompressed on the fly.");
   add("file-format,F", po::value(&filetype),
       "The format of the input file with the knowledge graph data. Must be one "
       "of [nt|ttl|nq]. Can be specified once (then all files use that format), "
@@ -217,9 +227,7 @@ int main(int argc, char** argv) {
   add("parallel-parsing,p", po::value(&parseParallel),
       "Enable or disable the parallel parser for all files (if specified once) "
       "or once per input file. Parallel parsing works for all input files "
-      "using the N-Triples or N-Quads format, as well as for well-behaved "
-      "Turtle files, where all the prefix declarations come in one block at "
-      "the beginning and there are no multiline literals");
+      "using the N-Triples, N-Quads, or Turtle format");
   add("kg-index-name,K", po::value(&config.kbIndexName_),
       "The name of the knowledge graph index (default: basename of "
       "`kg-input-file`).");
@@ -277,6 +285,19 @@ int main(int argc, char** argv) {
       "in the ID. NOTE: When using ORDER BY, the order among encoded IRIs and "
       "among non-encoded IRIs is correct, but the order between encoded "
       "and non-encoded IRIs is not");
+  add("encode-as-id-hex",
+      po::value(&config.hexPrefixesForIdEncodedIris_)
+          ->composing()
+          ->multitoken(),
+      "Like `--encode-as-id`, but for IRIs where the prefix is followed by a "
+      "fixed number of lowercase hexadecimal digits. Each prefix has the form "
+      "`<width>:<prefix>`, for example `8:http://example.org/` for IRIs like "
+      "`<http://example.org/deadbeef>`. At most 13 digits are supported");
+  add("inline-short-literals", po::bool_switch(&config.inlineShortLiterals_),
+      "Directly encode plain literals with at most 7 ASCII characters and "
+      "without a language tag or datatype (e.g. \"yes\" or \"DE\") in the ID "
+      "instead of storing them in the vocabulary. The same limitations "
+      "regarding ORDER BY as for `--encode-as-id` apply");
 
   // Options for the index building process.
   add("stxxl-memory,m", po::value(&config.memoryLimit_),
@@ -287,10 +308,38 @@ int main(int argc, char** argv) {
       "large enough to hold a single input triple. Default: 10 MB.");
   add("keep-temporary-files,k", po::bool_switch(&config.keepTemporaryFiles_),
       "Do not delete temporary files from index creation for debugging.");
+  add("write-permutations-concurrently",
+      po::bool_switch(&config.writePermutationsConcurrently_),
+      "Sort and write the OSP/OPS and PSO/POS permutations concurrently. This "
+      "is faster on machines with many cores, but the memory for sorting is "
+      "split between the two permutations. Only used together with "
+      "--no-patterns.");
   add("materialized-views", po::value(&materializedViewsJson),
       "create materialized views after index building. Takes a JSON object "
       "mapping view names to SELECT queries for writing the view, for example: "
       R"({"view1": "SELECT ...", "view2": "SELECT ..."})");
+  add("transitive-closure-predicates",
+      po::value(&config.transitiveClosurePredicates_)
+          ->composing()
+          ->multitoken(),
+      "Space-separated list of predicates (full IRIs in angle brackets) for "
+      "which the transitive closure is precomputed after index building, for "
+      "example for hierarchy predicates like `wdt:P279`. Transitive paths "
+      "with these predicates (e.g. `?x <p>* ?y`) then don't require a graph "
+      "search at query time, as long as the predicate is not affected by "
+      "updates.");
+  add("facet-statistics", po::bool_switch(&config.facetStatistics_),
+      "Precompute the number of subjects per class and predicate and per "
+      "predicate and object after index building. GROUP BY queries for these "
+      "counts (e.g. for faceted browsing) are then answered without a join "
+      "or a GROUP BY at query time, as long as the index is not affected by "
+      "updates.");
+  add("vocabulary-ngram-index",
+      po::bool_switch(&config.vocabularyNgramIndex_),
+      "Build an index of the trigrams of the literals in the vocabulary. "
+      "Filters with CONTAINS or REGEX for a substring of at least three "
+      "characters then only have to check the literals that contain all the "
+      "trigrams of the substring.");
 
   // Process command line arguments.
   po::variables_map optionsMap;
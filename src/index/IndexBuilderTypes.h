@@ -99,26 +99,43 @@ class PartialVocabIndexWithExternalFlag {
   bool isExternal() const { return (encodedId_ >> 63) != 0; }
 };
 
+// A `PartialVocabIndexWithExternalFlag` together with the sort key of the
+// corresponding word (see `TripleComponentComparator::getTotalSortKey`). The
+// sort key is computed only once, when the word is first seen during parsing,
+// so the sorting of the partial vocabulary can compare the sort keys bytewise
+// instead of repeatedly performing the (expensive) Unicode collation of the
+// words. An empty `sortKey_` means that the sort key was not computed.
+struct PartialVocabEntry : PartialVocabIndexWithExternalFlag {
+  std::string_view sortKey_;
+
+  PartialVocabEntry() = default;
+  PartialVocabEntry(uint64_t id, bool isExternal,
+                    std::string_view sortKey = {})
+      : PartialVocabIndexWithExternalFlag{id, isExternal}, sortKey_{sortKey} {}
+  PartialVocabEntry(PartialVocabIndexWithExternalFlag idAndExternal,
+                    std::string_view sortKey = {})
+      : PartialVocabIndexWithExternalFlag{idAndExternal}, sortKey_{sortKey} {}
+};
+
 // During the first phase of the index building, we use hash maps from entries
-// in the partial vocabulary to their `PartialVocabIndexWithExternalFlag` (see
-// above). The hash map only stores `string_view`s as keys, so that we can
+// in the partial vocabulary to their `PartialVocabEntry` (see above). The hash
+// map only stores `string_view`s as keys (and as sort keys), so that we can
 // deallocate all strings from a single batch of triples at once as soon as we
 // have finished processing them.
 
 // Allocator type for the hash map.
 using ItemAlloc = ql::pmr::polymorphic_allocator<
-    std::pair<const std::string_view, PartialVocabIndexWithExternalFlag>>;
+    std::pair<const std::string_view, PartialVocabEntry>>;
 
 // The type of the hash map.
 using ItemMap =
-    ad_utility::HashMap<std::string_view, PartialVocabIndexWithExternalFlag,
+    ad_utility::HashMap<std::string_view, PartialVocabEntry,
                         absl::DefaultHashContainerHash<std::string_view>,
                         absl::DefaultHashContainerEq<std::string_view>,
                         ItemAlloc>;
 
 // A vector that stores the same values as the hash map.
-using ItemVec =
-    std::vector<std::pair<std::string_view, PartialVocabIndexWithExternalFlag>>;
+using ItemVec = std::vector<std::pair<std::string_view, PartialVocabEntry>>;
 
 // A buffer that very efficiently handles a set of strings that is deallocated
 // at once when the buffer goes out of scope.
@@ -216,10 +233,12 @@ struct alignas(256) ItemMapManager {
     if (it == map.end()) {
       uint64_t res = map.size() + minId_;
       // We have to first add the string to the buffer, otherwise we don't have
-      // a persistent `string_view` to add to the `map`.
+      // a persistent `string_view` to add to the `map`. The same holds for
+      // the sort key, which is used when sorting the partial vocabulary.
       auto keyView = buffer.addString(repr);
+      auto sortKeyView = buffer.addString(comparator_->getTotalSortKey(repr));
       map.try_emplace(keyView,
-                      PartialVocabIndexWithExternalFlag{res, key.isExternal_});
+                      PartialVocabEntry{res, key.isExternal_, sortKeyView});
       return Id::makeFromVocabIndex(VocabIndex::make(res));
     } else {
       return Id::makeFromVocabIndex(VocabIndex::make(it->second.id()));
@@ -14,9 +14,12 @@
 
 #include "backports/StartsWithAndEndsWith.h"
 #include "backports/algorithm.h"
+#include "global/RuntimeParameters.h"
 #include "index/FTSAlgorithms.h"
 #include "index/TextIndexReadWrite.h"
 #include "parser/WordsAndDocsFileParser.h"
+#include "util/ThreadBudget.h"
+#include "util/ThreadSafeQueue.h"
 #include "util/TransparentFunctors.h"
 
 // _____________________________________________________________________________
@@ -48,7 +51,7 @@ void IndexImpl::addTextFromOnDiskIndex() {
   if (f.good()) {
     f.close();
     docsDB_.init(std::string(onDiskBase_ + ".text.docsDB"));
-    AD_LOG_INFO << "Registered text records: #records = " << docsDB_._size
+    AD_LOG_INFO << "Registered text records: #records = " << docsDB_.size()
                 << std::endl;
   } else {
     AD_LOG_DEBUG << "No file \"" << docsDbFileName
@@ -67,18 +70,37 @@ IdTable IndexImpl::mergeTextBlockResults(
     const ad_utility::AllocatorWithLimit<Id>& allocator,
     TextScanMode textScanMode) const {
   AD_CONTRACT_CHECK(tbmds.size() > 0);
-  // Collect all blocks as IdTables
-  std::vector<IdTable> partialResults;
-  for (const auto& tbmd : tbmds) {
-    IdTable partialResult{allocator};
-    partialResult =
+  auto readBlock = [reader, &allocator, textScanMode,
+                    this](const TextBlockMetadataAndWordInfo& tbmd) {
+    IdTable partialResult =
         reader(tbmd.tbmd_, allocator, textIndexFile_, textScoringMetric_);
     if (textScanMode == TextScanMode::WordScan && tbmd.hasToBeFiltered()) {
       AD_CORRECTNESS_CHECK(tbmd.optIdRange_.has_value());
       partialResult =
           FTSAlgorithms::filterByRange(tbmd.optIdRange_.value(), partialResult);
     }
-    partialResults.push_back(std::move(partialResult));
+    return partialResult;
+  };
+  // Collect all blocks as IdTables. A prefix can span many blocks, which are
+  // then read and decompressed concurrently (the reads use `pread` and are
+  // therefore safe to be issued concurrently on the same file).
+  std::vector<IdTable> partialResults;
+  partialResults.reserve(tbmds.size());
+  auto threads = ad_utility::globalThreadBudget().reserve(std::min(
+      getRuntimeParameter<&RuntimeParameters::textScanNumThreads_>(),
+      tbmds.size()));
+  auto numThreads = threads.numThreads();
+  if (numThreads <= 1) {
+    for (const auto& tbmd : tbmds) {
+      partialResults.push_back(readBlock(tbmd));
+    }
+  } else {
+    for (auto& partialResult : ad_utility::data_structures::parallelTransform(
+             ql::views::iota(size_t{0}, tbmds.size()),
+             [&readBlock, &tbmds](size_t i) { return readBlock(tbmds[i]); },
+             numThreads, numThreads, true)) {
+      partialResults.push_back(std::move(partialResult));
+    }
   }
   // If only one block was requested return the IdTable
   if (partialResults.size() == 1) {
@@ -153,6 +175,27 @@ IdTable IndexImpl::getWordPostingsForTerm(
   return result;
 }
 
+// _____________________________________________________________________________
+std::vector<std::string> IndexImpl::getTextExcerpts(
+    ql::span<const TextRecordIndex> cids) const {
+  // Records that are not contained in the `docsDB_` have an empty excerpt
+  // (see `getTextExcerpt`).
+  std::vector<TextRecordIndex> containedCids;
+  std::vector<size_t> positions;
+  for (size_t i = 0; i < cids.size(); ++i) {
+    if (cids[i].get() < docsDB_.size()) {
+      containedCids.push_back(cids[i]);
+      positions.push_back(i);
+    }
+  }
+  std::vector<std::string> result(cids.size());
+  auto excerpts = docsDB_.getTextExcerpts(containedCids);
+  for (size_t i = 0; i < excerpts.size(); ++i) {
+    result[positions[i]] = std::move(excerpts[i]);
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 IdTable IndexImpl::getEntityMentionsForWord(
     const std::string& term,
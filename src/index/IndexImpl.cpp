@@ -9,6 +9,7 @@
 
 #include <atomic>
 #include <cstdio>
+#include <filesystem>
 #include <future>
 #include <numeric>
 #include <optional>
@@ -22,6 +23,7 @@
 #include "index/VocabularyMerger.h"
 #include "parser/ParallelParseBuffer.h"
 #include "parser/WordsAndDocsFileParser.h"
+#include "rdfTypes/Literal.h"
 #include "util/BatchedPipeline.h"
 #include "util/CachingMemoryResource.h"
 #include "util/CancellationHandle.h"
@@ -56,6 +58,12 @@ IndexImpl::IndexImpl(ad_utility::AllocatorWithLimit<Id> allocator)
   deltaTriples_.emplace(*this);
 }
 
+// _____________________________________________________________________________
+uint64_t IndexImpl::nextInstanceId() {
+  static std::atomic<uint64_t> nextId = 1;
+  return nextId++;
+}
+
 // _____________________________________________________________________________
 IndexBuilderDataAsFirstPermutationSorter IndexImpl::createIdTriplesAndVocab(
     std::shared_ptr<RdfParserBase> parser) {
@@ -420,6 +428,32 @@ void IndexImpl::createFromFiles(
     createFirstPermutationPair(NumColumnsIndexBuilding,
                                std::move(firstSorterWithUnique));
     configurationJson_["has-all-permutations"] = false;
+  } else if (!usePatterns_ && writePermutationPairsConcurrently_) {
+    createInternalPsoAndPosAndSetMetadata();
+    // Sort the triples for the second and the third pair of permutations
+    // during the same pass over the first sorter, and then write these two
+    // pairs concurrently. The two sorters share the memory of a single sorter,
+    // so the total memory limit still holds.
+    auto secondSorter = makeSorter<SecondPermutation>("second", 2);
+    auto thirdSorter = makeSorter<ThirdPermutation>("third", 2);
+    // NOTE: `createFirstPermutationPair` can't be used here, because for the
+    // case of only two permutations it allows only a single next sorter.
+    static_assert(std::is_same_v<FirstPermutation, SortBySPO>);
+    createSPOAndSOP(NumColumnsIndexBuilding, std::move(firstSorterWithUnique),
+                    secondSorter, thirdSorter);
+    firstSorter.clearUnderlying();
+
+    std::vector<std::packaged_task<void()>> tasks;
+    tasks.emplace_back([this, &secondSorter]() {
+      createSecondPermutationPair(NumColumnsIndexBuilding,
+                                  secondSorter.getSortedBlocks<0>());
+    });
+    tasks.emplace_back([this, &thirdSorter]() {
+      createThirdPermutationPair(NumColumnsIndexBuilding,
+                                 thirdSorter.getSortedBlocks<0>());
+    });
+    ad_utility::runTasksInParallel(std::move(tasks));
+    configurationJson_["has-all-permutations"] = true;
   } else if (!usePatterns_) {
     createInternalPsoAndPosAndSetMetadata();
     // Without patterns, we explicitly have to pass in the next sorters to all
@@ -681,18 +715,19 @@ auto IndexImpl::convertPartialToGlobalIds(
   // static_assert(std::is_const_v<decltype(triplesGenerator)>);
   auto it = triplesGenerator.begin();
   using Buffer = IdTableStatic<NumColumnsIndexBuilding>;
-  struct Buffers {
-    IdTableStatic<NumColumnsIndexBuilding> triples_;
-    IdTableStatic<NumColumnsIndexBuilding> internalTriples_;
-  };
   using Map = ad_utility::HashMap<Id, Id>;
 
   ad_utility::TaskQueue<true> lookupQueue(30, 10,
                                           "looking up local to global IDs");
-  // This queue will be used to push the converted triples to the sorter. It is
-  // important that it has only one thread because it will not be used in a
-  // thread-safe way.
+  // These queues will be used to push the converted triples to the two
+  // sorters. It is important that each of them has only one thread because
+  // the sorters are not thread-safe. With one queue per sorter, the (mostly
+  // much larger) first sorter never has to wait for the pushing to the sorter
+  // of the internal triples, so the lookup of the IDs, and the filling and the
+  // sorting of the blocks of both sorters run concurrently.
   ad_utility::TaskQueue<true> writeQueue(30, 1, "Writing global Ids to file");
+  ad_utility::TaskQueue<true> internalWriteQueue(
+      30, 1, "Writing global Ids of internal triples to file");
 
   // For all triple elements find their mapping from partial to global ids.
   auto transformTriple = [](Buffer::row_reference& curTriple, auto& idMap) {
@@ -712,23 +747,24 @@ auto IndexImpl::convertPartialToGlobalIds(
     }
   };
 
-  // Return a lambda that pushes all the triples to the sorter. Must only be
-  // called single-threaded.
+  // Return a lambda that pushes the `triples` to the `sorter`. The lambdas for
+  // the same sorter must only be called single-threaded. The progress is only
+  // tracked by the lambdas for the first sorter, which therefore also count
+  // the `numInternalTriples` that were split off from the same batch.
   size_t numTriplesConverted = 0;
   ad_utility::ProgressBar progressBar{numTriplesConverted,
                                       "Triples converted: "};
-  auto getWriteTask = [&result, &internalResult, &numTriplesConverted,
-                       &progressBar](Buffers buffers) {
-    return [&result, &internalResult, &numTriplesConverted, &progressBar,
+  auto getWriteTask = [&numTriplesConverted, &progressBar](
+                          auto& sorter, Buffer triples,
+                          std::optional<size_t> numInternalTriples) {
+    return [&sorter, &numTriplesConverted, &progressBar, numInternalTriples,
             triples = std::make_shared<IdTableStatic<0>>(
-                std::move(buffers.triples_).toDynamic()),
-            internalTriples = std::make_shared<IdTableStatic<0>>(
-                std::move(buffers.internalTriples_).toDynamic())] {
-      result.pushBlock(*triples);
-      internalResult.pushBlock(*internalTriples);
-
-      numTriplesConverted += triples->size();
-      numTriplesConverted += internalTriples->size();
+                std::move(triples).toDynamic())] {
+      sorter.pushBlock(*triples);
+      if (!numInternalTriples.has_value()) {
+        return;
+      }
+      numTriplesConverted += triples->size() + numInternalTriples.value();
       if (progressBar.update()) {
         AD_LOG_INFO << progressBar.getProgressString() << std::flush;
       }
@@ -738,10 +774,13 @@ auto IndexImpl::convertPartialToGlobalIds(
   // Return a lambda that for each of the `triples` transforms its partial to
   // global IDs using the `idMap`. The map is passed as a `shared_ptr` because
   // multiple batches need access to the same map.
-  auto getLookupTask = [&isQLeverInternalTriple, &writeQueue, &transformTriple,
+  auto getLookupTask = [&isQLeverInternalTriple, &writeQueue,
+                        &internalWriteQueue, &result, &internalResult,
+                        &transformTriple,
                         &getWriteTask](Buffer triples,
                                        std::shared_ptr<Map> idMap) {
-    return [&isQLeverInternalTriple, &writeQueue,
+    return [&isQLeverInternalTriple, &writeQueue, &internalWriteQueue, &result,
+            &internalResult,
             triples = std::make_shared<Buffer>(std::move(triples)),
             idMap = std::move(idMap), &getWriteTask,
             &transformTriple]() mutable {
@@ -763,9 +802,13 @@ auto IndexImpl::convertPartialToGlobalIds(
                                   triples->end() - triples->begin());
       triples->resize(beginInternal - triples->begin());
 
-      Buffers buffers{std::move(*triples), std::move(internalTriples)};
-
-      writeQueue.push(getWriteTask(std::move(buffers)));
+      size_t numInternalTriples = internalTriples.size();
+      if (numInternalTriples > 0) {
+        internalWriteQueue.push(getWriteTask(
+            internalResult, std::move(internalTriples), std::nullopt));
+      }
+      writeQueue.push(
+          getWriteTask(result, std::move(*triples), numInternalTriples));
     };
   };
 
@@ -824,6 +867,7 @@ auto IndexImpl::convertPartialToGlobalIds(
   }
   lookupQueue.finish();
   writeQueue.finish();
+  internalWriteQueue.finish();
   AD_LOG_INFO << progressBar.getFinalProgressString() << std::flush;
   return {std::move(resultPtr), std::move(internalTriplesPtr)};
 }
@@ -996,30 +1040,50 @@ void IndexImpl::createFromOnDiskIndex(const std::string& onDiskBase,
                                       bool persistUpdatesOnDisk) {
   setOnDiskBase(onDiskBase);
   readConfiguration();
-  vocab_.readFromFile(onDiskBase_ + VOCAB_SUFFIX);
 
-  AD_LOG_DEBUG << "Number of words in internal and external vocabulary: "
-               << vocab_.size() << std::endl;
+  // The vocabulary, the permutations, and the patterns are independent of each
+  // other, so they are loaded concurrently (loading them sequentially takes
+  // several minutes for very large indices). Note: The futures returned by
+  // `std::async` block in their destructor, so all the tasks have finished
+  // when this function exits, even if one of them throws.
+  std::vector<std::future<void>> loadingTasks;
+  auto runAsync = [&loadingTasks](auto task) {
+    loadingTasks.push_back(std::async(std::launch::async, std::move(task)));
+  };
+
+  runAsync([this]() {
+    vocab_.readFromFile(onDiskBase_ + VOCAB_SUFFIX);
+    AD_LOG_DEBUG << "Number of words in internal and external vocabulary: "
+                 << vocab_.size() << std::endl;
+  });
 
   // Load the permutations and register the original metadata for the delta
   // triples.
   // The setting of the metadata doesn't affect the contents of the delta
   // triples, so we don't need to call `writeToDisk`, therefore the second
-  // argument to `modify` is `false`.
+  // argument to `modify` is `false`. The `modify` call is synchronized, so
+  // this is safe while the other permutations are still being loaded.
   auto setMetadata = [this](const Permutation& permutation) {
-    deltaTriplesManager().modify<void>(
+    deltaTriples_.value().modify<void>(
         [&permutation](DeltaTriples& deltaTriples) {
           permutation.setOriginalMetadataForDeltaTriples(deltaTriples);
         },
         false, false);
   };
 
-  auto load = [this, &setMetadata](PermutationPtr permutation,
-                                   bool loadInternalPermutation = false) {
-    permutation->loadFromDisk(onDiskBase_, loadInternalPermutation);
-    setMetadata(*permutation);
+  auto load = [this, &setMetadata, &runAsync](
+                  PermutationPtr permutation,
+                  bool loadInternalPermutation = false) {
+    runAsync([this, setMetadata, permutation = std::move(permutation),
+              loadInternalPermutation]() {
+      permutation->loadFromDisk(onDiskBase_, loadInternalPermutation);
+      setMetadata(*permutation);
+    });
   };
 
+  predicateStatistics_.setFilename(getPredicateStatisticsFilename());
+  vocabularyNgramIndex_.setFilename(getVocabularyNgramIndexFilename());
+
   if (doNotLoadPermutations_) {
     // Set all permutations to nullptr to indicate they are not loaded.
     pso_ = nullptr;
@@ -1037,10 +1101,17 @@ void IndexImpl::createFromOnDiskIndex(const std::string& onDiskBase,
     load(pso_, true);
     load(pos_, true);
     if (loadAllPermutations_) {
-      load(ops_);
-      load(osp_);
-      load(spo_);
-      load(sop_);
+      auto loadPossiblyLazily = [this, &load](PermutationPtr permutation) {
+        if (lazyLoadPermutations_) {
+          permutation->loadFromDiskLazily(onDiskBase_);
+        } else {
+          load(std::move(permutation));
+        }
+      };
+      loadPossiblyLazily(ops_);
+      loadPossiblyLazily(osp_);
+      loadPossiblyLazily(spo_);
+      loadPossiblyLazily(sop_);
     } else {
       AD_LOG_INFO
           << "Only the PSO and POS permutation were loaded, SPARQL queries "
@@ -1052,25 +1123,38 @@ void IndexImpl::createFromOnDiskIndex(const std::string& onDiskBase,
   // We have to load the patterns first to figure out if the patterns were built
   // at all.
   if (usePatterns_) {
-    try {
-      PatternCreator::readPatternsFromFile(
-          getPatternFilename(), avgNumDistinctSubjectsPerPredicate_,
-          avgNumDistinctPredicatesPerSubject_,
-          numDistinctSubjectPredicatePairs_, patterns_);
-    } catch (const std::exception& e) {
-      AD_LOG_WARN
-          << "Could not load the patterns. The internal predicate "
-             "`ql:has-predicate` is therefore not available (and certain "
-             "queries that benefit from that predicate will be slower)."
-             "To suppress this warning, start the server with "
-             "the `--no-patterns` option. The error message was "
-          << e.what() << std::endl;
-      usePatterns_ = false;
-    }
+    runAsync([this]() {
+      try {
+        PatternCreator::readPatternsFromFile(
+            getPatternFilename(), avgNumDistinctSubjectsPerPredicate_,
+            avgNumDistinctPredicatesPerSubject_,
+            numDistinctSubjectPredicatePairs_, patterns_);
+      } catch (const std::exception& e) {
+        AD_LOG_WARN
+            << "Could not load the patterns. The internal predicate "
+               "`ql:has-predicate` is therefore not available (and certain "
+               "queries that benefit from that predicate will be slower)."
+               "To suppress this warning, start the server with "
+               "the `--no-patterns` option. The error message was "
+            << e.what() << std::endl;
+        usePatterns_ = false;
+      }
+    });
   }
+
+  // Wait for all the components and propagate the first exception (if any).
+  for (auto& task : loadingTasks) {
+    task.get();
+  }
+
   if (persistUpdatesOnDisk) {
+    auto updatesFilename = onDiskBase + ".update-triples";
+    // The persisted updates are located in all the permutations.
+    if (std::filesystem::exists(updatesFilename)) {
+      loadLazyPermutations();
+    }
     deltaTriples_.value().setFilenameForPersistentUpdatesAndReadFromDisk(
-        onDiskBase + ".update-triples");
+        updatesFilename);
     graphNameManager_.setFilenameForPersistingAndReadFromDisk(
         onDiskBase + ".allocated-graphs-state");
   }
@@ -1164,6 +1248,29 @@ bool& IndexImpl::addHasWordTriples() { return addHasWordTriples_; }
 // _____________________________________________________________________________
 bool& IndexImpl::doNotLoadPermutations() { return doNotLoadPermutations_; }
 
+// _____________________________________________________________________________
+bool& IndexImpl::lazyLoadPermutations() { return lazyLoadPermutations_; }
+
+// _____________________________________________________________________________
+void IndexImpl::loadLazyPermutations() {
+  if (!lazyLoadPermutations_) {
+    return;
+  }
+  std::call_once(loadLazyPermutationsOnce_, [this]() {
+    for (const auto& permutation : {spo_, sop_, ops_, osp_}) {
+      if (permutation == nullptr || !permutation->isLoaded()) {
+        continue;
+      }
+      // Don't use `deltaTriplesManager()`, which calls this function.
+      deltaTriples_.value().modify<void>(
+          [&permutation](DeltaTriples& deltaTriples) {
+            permutation->setOriginalMetadataForDeltaTriples(deltaTriples);
+          },
+          false, false);
+    }
+  });
+}
+
 // ____________________________________________________________________________
 void IndexImpl::setSettingsFile(const std::string& filename) {
   settingsFileName_ = filename;
@@ -1542,7 +1649,7 @@ std::future<void> IndexImpl::writeNextPartialVocabulary(
       absl::StrCat(onDiskBase_, PARTIAL_VOCAB_WORDS_INFIX, numFiles);
 
   auto lambda = [localIds = std::move(localIds), globalWritePtr,
-                 items = std::move(items), vocab = &vocab_, partialFilename,
+                 items = std::move(items), partialFilename,
                  numFiles]() mutable {
     auto vec = [&]() {
       ad_utility::TimeBlockAndLog l{"vocab maps to vector"};
@@ -1550,11 +1657,15 @@ std::future<void> IndexImpl::writeNextPartialVocabulary(
     }();
     {
       ad_utility::TimeBlockAndLog l{"sorting by unicode order"};
+      // The sort keys have already been computed when parsing the words (see
+      // `ItemMapManager::getId`), so we only have to compare them bytewise.
       sortVocabVector(
           &vec,
-          [&c = vocab->getCaseComparator()](const auto& a, const auto& b) {
-            return c.isLessInTotalWithExternalFlag(
-                a.first, a.second.isExternal(), b.first, b.second.isExternal());
+          [](const auto& a, const auto& b) {
+            using C = TripleComponentComparator;
+            return C::isLessInTotalWithExternalFlagBySortKey(
+                a.second.sortKey_, a.second.isExternal(), b.second.sortKey_,
+                b.second.isExternal());
           },
           true);
     }
@@ -1692,6 +1803,12 @@ RdfsVocabulary::AccessReturnType IndexImpl::indexToString(VocabIndex id) const {
   return vocab_[id];
 }
 
+// ___________________________________________________________________________
+std::vector<std::string> IndexImpl::indicesToStrings(
+    ql::span<const VocabIndex> ids) const {
+  return vocab_.lookupMany(ids);
+}
+
 // ___________________________________________________________________________
 TextVocabulary::AccessReturnType IndexImpl::indexToString(
     WordVocabIndex id) const {
@@ -1753,6 +1870,42 @@ std::string IndexImpl::getPatternFilename() const {
   return onDiskBase_ + ".index.patterns";
 }
 
+// _____________________________________________________________________________
+std::string IndexImpl::getPredicateStatisticsFilename() const {
+  return onDiskBase_ + ".index.predicate-statistics";
+}
+
+// _____________________________________________________________________________
+std::string IndexImpl::getVocabularyNgramIndexFilename() const {
+  return absl::StrCat(onDiskBase_, VOCAB_SUFFIX, ".ngrams");
+}
+
+// _____________________________________________________________________________
+void IndexImpl::buildVocabularyNgramIndex() {
+  AD_LOG_INFO << "Building the n-gram index of the literals in the vocabulary "
+                 "..."
+              << std::endl;
+  // The vocabulary is not kept in memory during the index building.
+  if (vocab_.size() == 0) {
+    vocab_.readFromFile(onDiskBase_ + VOCAB_SUFFIX);
+  }
+  // All the literals start with a quote, so they form a single range.
+  auto [begin, end] = vocab_.prefixRanges("\"").ranges()[0];
+  auto forEachLiteral =
+      [this, begin = begin.get(),
+       end = end.get()](const VocabularyNgramIndex::LiteralCallback& callback) {
+        for (uint64_t index = begin; index < end; ++index) {
+          auto word = vocab_[VocabIndex::make(index)];
+          auto literal = ad_utility::triple_component::LiteralView::
+              fromStringRepresentation(word);
+          callback(index, asStringViewUnsafe(literal.getContent()),
+                   literal.hasDatatype());
+        }
+      };
+  VocabularyNgramIndex::build(forEachLiteral,
+                              getVocabularyNgramIndexFilename());
+}
+
 // _____________________________________________________________________________
 CPP_template_def(typename... NextSorter)(requires(
     sizeof...(NextSorter) <=
@@ -1781,10 +1934,16 @@ CPP_template_def(typename... NextSorter)(requires(
         }
         nextAvailableIndex = std::max(nextAvailableIndex, payload + 1);
       };
-  size_t numPredicates =
-      createPermutationPair(numColumns, AD_FWD(sortedTriples), *pso_, *pos_,
-                            nextSorter.makePushCallback()..., countTriples,
-                            determineNextAvailableInternalGraph);
+  // The triples are sorted by the predicate, as required by the builder.
+  PredicateStatistics::Builder predicateStatistics;
+  auto addToPredicateStatistics = [&predicateStatistics](const auto& triple) {
+    predicateStatistics.add(triple[0], triple[1], triple[2]);
+  };
+  size_t numPredicates = createPermutationPair(
+      numColumns, AD_FWD(sortedTriples), *pso_, *pos_,
+      nextSorter.makePushCallback()..., countTriples,
+      determineNextAvailableInternalGraph, addToPredicateStatistics);
+  std::lock_guard lock{configurationMutex_};
   configurationJson_["num-predicates"] =
       NumNormalAndInternal::fromNormal(numPredicates);
   configurationJson_["num-triples"] =
@@ -1793,6 +1952,7 @@ CPP_template_def(typename... NextSorter)(requires(
                                        nextAvailableIndex);
   configurationJson_["graphNameManager"] = graphNameManager_;
   if (doWriteConfiguration) {
+    predicateStatistics.writeToFile(getPredicateStatisticsFilename());
     writeConfiguration();
   }
 }
@@ -1808,7 +1968,7 @@ CPP_template_def(typename... NextSorter)(
 }
 
 // _____________________________________________________________________________
-CPP_template_def(typename... NextSorter)(requires(sizeof...(NextSorter) <= 1))
+CPP_template_def(typename... NextSorter)(requires(sizeof...(NextSorter) <= 2))
     std::optional<PatternCreator::TripleSorter> IndexImpl::createSPOAndSOP(
         size_t numColumns, BlocksOfTriples sortedTriples,
         NextSorter&&... nextSorter) {
@@ -1838,7 +1998,7 @@ CPP_template_def(typename... NextSorter)(requires(sizeof...(NextSorter) <= 1))
     writeConfiguration();
     result = std::move(patternCreator).getTripleSorter();
   } else {
-    AD_CORRECTNESS_CHECK(sizeof...(nextSorter) == 1);
+    AD_CORRECTNESS_CHECK(sizeof...(nextSorter) >= 1);
     size_t numSubjects =
         createPermutationPair(numColumns, AD_FWD(sortedTriples), *spo_, *sop_,
                               nextSorter.makePushCallback()...);
@@ -1860,6 +2020,7 @@ CPP_template_def(typename... NextSorter)(
   size_t numObjects =
       createPermutationPair(numColumns, AD_FWD(sortedTriples), *osp_, *ops_,
                             nextSorter.makePushCallback()...);
+  std::lock_guard lock{configurationMutex_};
   configurationJson_["num-objects"] =
       NumNormalAndInternal::fromNormal(numObjects);
   configurationJson_["has-all-permutations"] = true;
@@ -1868,7 +2029,9 @@ CPP_template_def(typename... NextSorter)(
 
 // _____________________________________________________________________________
 template <typename Comparator, size_t I, bool returnPtr>
-auto IndexImpl::makeSorterImpl(std::string_view permutationName) const {
+auto IndexImpl::makeSorterImpl(std::string_view permutationName,
+                               size_t numSortersSharingMemory) const {
+  AD_CONTRACT_CHECK(numSortersSharingMemory > 0);
   using Sorter = ExternalSorter<Comparator, I>;
   auto apply = [](auto&&... args) {
     if constexpr (returnPtr) {
@@ -1878,15 +2041,17 @@ auto IndexImpl::makeSorterImpl(std::string_view permutationName) const {
     }
   };
   return apply(absl::StrCat(onDiskBase_, ".", permutationName, "-sorter.dat"),
-               memoryLimitIndexBuilding() / NUM_EXTERNAL_SORTERS_AT_SAME_TIME,
+               memoryLimitIndexBuilding() / NUM_EXTERNAL_SORTERS_AT_SAME_TIME /
+                   numSortersSharingMemory,
                allocator_);
 }
 
 // _____________________________________________________________________________
 template <typename Comparator, size_t I>
 ExternalSorter<Comparator, I> IndexImpl::makeSorter(
-    std::string_view permutationName) const {
-  return makeSorterImpl<Comparator, I, false>(permutationName);
+    std::string_view permutationName, size_t numSortersSharingMemory) const {
+  return makeSorterImpl<Comparator, I, false>(permutationName,
+                                              numSortersSharingMemory);
 }
 // _____________________________________________________________________________
 template <typename Comparator, size_t I>
@@ -1903,9 +2068,12 @@ ad_utility::BlankNodeManager* IndexImpl::getBlankNodeManager() const {
 
 // _____________________________________________________________________________
 void IndexImpl::setPrefixesForEncodedValues(
-    std::vector<std::string> prefixesWithoutAngleBrackets) {
-  encodedIriManager_ =
-      EncodedIriManager{std::move(prefixesWithoutAngleBrackets)};
+    std::vector<std::string> prefixesWithoutAngleBrackets,
+    const std::vector<std::string>& hexPrefixesWithoutAngleBrackets,
+    bool inlineShortLiterals) {
+  encodedIriManager_ = EncodedIriManager{std::move(prefixesWithoutAngleBrackets),
+                                         hexPrefixesWithoutAngleBrackets,
+                                         inlineShortLiterals};
 }
 // _____________________________________________________________________________
 void IndexImpl::writePatternsToFile() const {
@@ -10,6 +10,7 @@
 #include <gtest/gtest_prod.h>
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -31,9 +32,11 @@
 #include "index/IndexMetaData.h"
 #include "index/PatternCreator.h"
 #include "index/Permutation.h"
+#include "index/PredicateStatistics.h"
 #include "index/TextMetaData.h"
 #include "index/TextScoring.h"
 #include "index/Vocabulary.h"
+#include "index/VocabularyNgramIndex.h"
 #include "index/VocabularyMerger.h"
 #include "parser/RdfParser.h"
 #include "parser/TripleComponent.h"
@@ -112,6 +115,13 @@ class IndexImpl {
       TurtleParserIntegerOverflowBehavior::Error;
   bool turtleParserSkipIllegalLiterals_ = false;
   bool keepTempFiles_ = false;
+  // If set, the OSP/OPS and the PSO/POS permutations are sorted during the
+  // same pass over the SPO-sorted triples, and then written concurrently (see
+  // `createFromFiles`). Only used if no patterns are built.
+  bool writePermutationPairsConcurrently_ = false;
+  // Protects the `configurationJson_` while two pairs of permutations are
+  // written concurrently.
+  std::mutex configurationMutex_;
   ad_utility::MemorySize memoryLimitIndexBuilding_ =
       DEFAULT_MEMORY_LIMIT_INDEX_BUILDING;
   ad_utility::MemorySize parserBufferSize_ = DEFAULT_PARSER_BUFFER_SIZE;
@@ -149,6 +159,10 @@ class IndexImpl {
   NumNormalAndInternal numTriples_;
   std::string indexId_;
   std::string gitShortHash_ = "git short hash not set";
+  // A number that is different for each `IndexImpl` in this process, see
+  // `getInstanceId`.
+  static uint64_t nextInstanceId();
+  const uint64_t instanceId_ = nextInstanceId();
 
   // Keeps track of the number of nonLiteral contexts in the index this is used
   // in the test retrieval of the texts. This only works reliably if the
@@ -162,6 +176,10 @@ class IndexImpl {
    * @brief Maps pattern ids to sets of predicate ids.
    */
   CompactVectorOfStrings<Id> patterns_;
+
+  // The per-predicate statistics for the query planner, read lazily.
+  PredicateStatistics predicateStatistics_;
+  VocabularyNgramIndex vocabularyNgramIndex_;
   ad_utility::AllocatorWithLimit<Id> allocator_;
 
   // TODO: make those private and allow only const access
@@ -192,6 +210,13 @@ class IndexImpl {
   // the permutations need to be executed.
   bool doNotLoadPermutations_ = false;
 
+  // If true, the SPO, SOP, OPS, and OSP permutations are only loaded from disk
+  // on their first use (the PSO and POS permutations are required by almost
+  // all queries, so they are always loaded). Before the first update, all the
+  // permutations are loaded, because updates are located in all of them.
+  bool lazyLoadPermutations_ = false;
+  std::once_flag loadLazyPermutationsOnce_;
+
   // The vocabulary type that is used (only relevant during index building).
   ad_utility::VocabularyType vocabularyTypeForIndexBuilding_{
       ad_utility::VocabularyType::Enum::OnDiskCompressed};
@@ -256,7 +281,13 @@ class IndexImpl {
 
   ad_utility::BlankNodeManager* getBlankNodeManager() const;
 
-  DeltaTriplesManager& deltaTriplesManager() { return deltaTriples_.value(); }
+  // Note: All modifications of the delta triples go through the non-const
+  // overload, so it loads the lazily loaded permutations (see
+  // `lazyLoadPermutations_`) before the first modification.
+  DeltaTriplesManager& deltaTriplesManager() {
+    loadLazyPermutations();
+    return deltaTriples_.value();
+  }
   const DeltaTriplesManager& deltaTriplesManager() const {
     return deltaTriples_.value();
   }
@@ -269,7 +300,14 @@ class IndexImpl {
   // Set the prefixes of the IRIs that will be encoded directly into
   // the `Id`; see `EncodedIriManager` for details.
   void setPrefixesForEncodedValues(
-      std::vector<std::string> prefixesWithoutAngleBrackets);
+      std::vector<std::string> prefixesWithoutAngleBrackets,
+      const std::vector<std::string>& hexPrefixesWithoutAngleBrackets = {},
+      bool inlineShortLiterals = false);
+
+  // See `writePermutationPairsConcurrently_` for details.
+  void setWritePermutationPairsConcurrently(bool concurrently) {
+    writePermutationPairsConcurrently_ = concurrently;
+  }
 
   // Set the vocabulary type; see `ad_utility::VocabularyType` for details.
   void setVocabularyTypeForIndexBuilding(ad_utility::VocabularyType type) {
@@ -292,6 +330,10 @@ class IndexImpl {
   // ___________________________________________________________________________
   RdfsVocabulary::AccessReturnType indexToString(VocabIndex id) const;
 
+  // ___________________________________________________________________________
+  std::vector<std::string> indicesToStrings(
+      ql::span<const VocabIndex> ids) const;
+
   // ___________________________________________________________________________
   TextVocabulary::AccessReturnType indexToString(WordVocabIndex id) const;
 
@@ -321,6 +363,21 @@ class IndexImpl {
    */
   size_t getNumDistinctSubjectPredicatePairs() const;
 
+  // The per-predicate statistics (see `PredicateStatistics`).
+  const PredicateStatistics& predicateStatistics() const {
+    return predicateStatistics_;
+  }
+
+  // The (optional) n-gram index of the literals in the vocabulary (see
+  // `VocabularyNgramIndex`).
+  const VocabularyNgramIndex& vocabularyNgramIndex() const {
+    return vocabularyNgramIndex_;
+  }
+
+  // Build the `VocabularyNgramIndex` for the vocabulary of the index with the
+  // current `onDiskBase_`. Has to be called after the index was created.
+  void buildVocabularyNgramIndex();
+
   // This struct is used to retrieve text blocks.
   struct TextBlockMetadataAndWordInfo {
     TextBlockMetadataAndWordInfo(
@@ -401,12 +458,16 @@ class IndexImpl {
       const std::vector<std::string>& terms) const;
 
   std::string getTextExcerpt(TextRecordIndex cid) const {
-    if (cid.get() >= docsDB_._size) {
+    if (cid.get() >= docsDB_.size()) {
       return "";
     }
     return docsDB_.getTextExcerpt(cid);
   }
 
+  // Batch variant of `getTextExcerpt`, see `DocsDB::getTextExcerpts`.
+  std::vector<std::string> getTextExcerpts(
+      ql::span<const TextRecordIndex> cids) const;
+
   float getAverageNofEntityContexts() const {
     return textMeta_.getAverageNofEntityContexts();
   };
@@ -425,6 +486,8 @@ class IndexImpl {
 
   bool& doNotLoadPermutations();
 
+  bool& lazyLoadPermutations();
+
   void setKeepTempFiles(bool keepTempFiles);
 
   ad_utility::MemorySize& memoryLimitIndexBuilding() {
@@ -459,6 +522,10 @@ class IndexImpl {
   const std::string& getKbName() const { return PSO().getKbName(); }
   const std::string& getOnDiskBase() const { return onDiskBase_; }
   const std::string& getIndexId() const { return indexId_; }
+  // Unlike the `indexId_`, this is different for two `IndexImpl`s that were
+  // loaded from the same files. It distinguishes the results of different
+  // indices in a `QueryResultCache` that is shared between them.
+  uint64_t getInstanceId() const { return instanceId_; }
   const std::string& getGitShortHash() const { return gitShortHash_; }
 
   size_t getNofTextRecords() const { return textMeta_.getNofTextRecords(); }
@@ -721,6 +788,11 @@ class IndexImpl {
 
   // Dereference the `permutationPtr` and throw an exception if it is `nullptr`.
   // The `permutationName` is used to enrich the error message.
+  // Load all the permutations that are loaded lazily (see
+  // `lazyLoadPermutations_`) and register their metadata for the delta
+  // triples. Only has an effect on the first call.
+  void loadLazyPermutations();
+
   static const Permutation& getPermutationImpl(
       const PermutationPtr& permutationPtr, std::string_view permutationName);
 
@@ -739,6 +811,12 @@ class IndexImpl {
   // Return the filename where the patterns are stored.
   std::string getPatternFilename() const;
 
+  // Return the filename where the `PredicateStatistics` are stored.
+  std::string getPredicateStatisticsFilename() const;
+
+  // Return the filename where the `VocabularyNgramIndex` is stored.
+  std::string getVocabularyNgramIndexFilename() const;
+
  public:
   // Count the number of "QLever-internal" triples (predicate ql:langtag or
   // predicate starts with @) and all other triples (that were actually part of
@@ -757,8 +835,9 @@ class IndexImpl {
 
   // Create the SPO and SOP permutations. Additionally, count the number of
   // distinct actual (not internal) subjects in the input and write it to the
-  // metadata. Also builds the patterns if specified.
-  CPP_template(typename... NextSorter)(requires(sizeof...(NextSorter) <= 1))
+  // metadata. Also builds the patterns if specified. Without patterns, the
+  // triples can be pushed to up to two `nextSorter`s.
+  CPP_template(typename... NextSorter)(requires(sizeof...(NextSorter) <= 2))
       std::optional<PatternCreator::TripleSorter> createSPOAndSOP(
           size_t numColumns, BlocksOfTriples sortedTriples,
           NextSorter&&... nextSorter);
@@ -797,17 +876,21 @@ class IndexImpl {
 
   // Set up one of the permutation sorters with the appropriate memory limit.
   // The `permutationName` is used to determine the filename and must be unique
-  // for each call during one index build.
+  // for each call during one index build. If `numSortersSharingMemory` is
+  // larger than one, the memory of a single sorter is shared between that many
+  // sorters that are filled at the same time.
   template <typename Comparator, size_t N = NumColumnsIndexBuilding>
   ExternalSorter<Comparator, N> makeSorter(
-      std::string_view permutationName) const;
+      std::string_view permutationName,
+      size_t numSortersSharingMemory = 1) const;
   // Same as the same function, but return a `unique_ptr`.
   template <typename Comparator, size_t N = NumColumnsIndexBuilding>
   std::unique_ptr<ExternalSorter<Comparator, N>> makeSorterPtr(
       std::string_view permutationName) const;
   // The common implementation of the above two functions.
   template <typename Comparator, size_t N, bool returnPtr>
-  auto makeSorterImpl(std::string_view permutationName) const;
+  auto makeSorterImpl(std::string_view permutationName,
+                      size_t numSortersSharingMemory = 1) const;
 
   // Aliases for the three functions above that should be consistently used.
   // They assert that the order of the permutations as communicated by the
@@ -141,9 +141,15 @@ class IndexMetaData {
   // pointer to the end of that file.
   void appendToFile(ad_utility::File* file) const;
 
-  // Read from file with the given name.
+  // Read from file with the given name. The file is memory-mapped, s.t. the
+  // (possibly very large) metadata is deserialized directly from the page
+  // cache without first copying it into a separate buffer.
   void readFromFile(const std::string& filename);
 
+  // Read from the complete `contents` of a file that has valid meta data at
+  // the end (e.g. a memory-mapped file).
+  void readFromFileContents(std::string_view contents);
+
   // Read from file, assuming that it is already open and has valid meta data at
   // the end. The call will change the position in the file.
   void readFromFile(ad_utility::File* file);
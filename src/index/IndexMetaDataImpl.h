@@ -6,8 +6,12 @@
 #ifndef QLEVER_SRC_INDEX_INDEXMETADATAIMPL_H
 #define QLEVER_SRC_INDEX_INDEXMETADATAIMPL_H
 
+#include <cstring>
+#include <string_view>
+
 #include "index/IndexMetaData.h"
 #include "util/File.h"
+#include "util/ReadOnlyMappedFile.h"
 #include "util/ReadableNumberFacet.h"
 #include "util/Serializer/ByteBufferSerializer.h"
 #include "util/Serializer/FileSerializer.h"
@@ -68,10 +72,24 @@ void IndexMetaData<MapType>::appendToFile(ad_utility::File* file) const {
 // _________________________________________________________________________
 template <class MapType>
 void IndexMetaData<MapType>::readFromFile(const std::string& filename) {
-  ad_utility::File file;
-  file.open(filename.c_str(), "r");
-  readFromFile(&file);
-  file.close();
+  ad_utility::ReadOnlyMappedFile file{filename};
+  readFromFileContents(file.view());
+}
+
+// _________________________________________________________________________
+template <class MapType>
+void IndexMetaData<MapType>::readFromFileContents(std::string_view contents) {
+  // The file ends with the offset at which the meta data starts.
+  off_t metaFrom;
+  AD_CORRECTNESS_CHECK(contents.size() >= sizeof(metaFrom));
+  const size_t metaTo = contents.size() - sizeof(metaFrom);
+  std::memcpy(&metaFrom, contents.data() + metaTo, sizeof(metaFrom));
+  AD_CORRECTNESS_CHECK(metaFrom >= 0 &&
+                       static_cast<size_t>(metaFrom) <= metaTo);
+
+  ad_utility::serialization::ByteBufferViewReadSerializer serializer{
+      contents.substr(metaFrom, metaTo - metaFrom)};
+  serializer >> (*this);
 }
 
 // _________________________________________________________________________
@@ -10,6 +10,7 @@
 #ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
 #include "index/IndexRebuilder.h"
 
+#include <algorithm>
 #include <array>
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/co_spawn.hpp>
@@ -19,6 +20,7 @@
 #include <boost/asio/use_awaitable.hpp>
 #include <cstdint>
 #include <fstream>
+#include <numeric>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -146,6 +148,51 @@ AD_ALWAYS_INLINE Id remapVocabId(Id original,
       VocabIndex::make(original.getVocabIndex().get() + offset));
 }
 
+// _____________________________________________________________________________
+VocabIdRemapper::VocabIdRemapper(const InsertionPositions& insertionPositions)
+    : insertionPositions_{insertionPositions} {
+  AD_CORRECTNESS_CHECK(ql::ranges::is_sorted(insertionPositions));
+  if (insertionPositions.empty()) {
+    return;
+  }
+  // Choose the bucket size s.t. there are at most as many buckets as
+  // insertion positions.
+  uint64_t numIndices = insertionPositions.back().get() + 1;
+  while ((numIndices >> bucketShift_) > insertionPositions.size()) {
+    ++bucketShift_;
+  }
+  size_t numBuckets = ((numIndices - 1) >> bucketShift_) + 1;
+  bucketOffsets_.resize(numBuckets + 1, 0);
+  for (VocabIndex position : insertionPositions) {
+    ++bucketOffsets_[(position.get() >> bucketShift_) + 1];
+  }
+  std::partial_sum(bucketOffsets_.begin(), bucketOffsets_.end(),
+                   bucketOffsets_.begin());
+}
+
+// _____________________________________________________________________________
+AD_ALWAYS_INLINE Id VocabIdRemapper::operator()(Id original) const {
+  AD_EXPENSIVE_CHECK(
+      original.getDatatype() == Datatype::VocabIndex,
+      "Only ids resembling a vocab index can be remapped with this function.");
+  uint64_t index = original.getVocabIndex().get();
+  size_t bucket = index >> bucketShift_;
+  size_t offset;
+  if (bucket + 1 >= bucketOffsets_.size()) {
+    // The `index` is larger than all the insertion positions.
+    offset = insertionPositions_.size();
+  } else {
+    // Only the insertion positions in the same bucket have to be compared.
+    auto begin = insertionPositions_.begin() + bucketOffsets_[bucket];
+    auto end = insertionPositions_.begin() + bucketOffsets_[bucket + 1];
+    offset = bucketOffsets_[bucket] +
+             static_cast<size_t>(
+                 std::upper_bound(begin, end, original.getVocabIndex()) -
+                 begin);
+  }
+  return Id::makeFromVocabIndex(VocabIndex::make(index + offset));
+}
+
 // _____________________________________________________________________________
 std::optional<Id> tryRemapBlankNodeId(Id original,
                                       const BlankNodeBlocks& blankNodeBlocks,
@@ -200,8 +247,9 @@ ad_utility::InputRangeTypeErased<IdTableStatic<0>> readIndexAndRemap(
       scanSpecAndBlocks, additionalColumns, cancellationHandle,
       *locatedTriplesSharedState);
 
-  auto remapId = [&insertionPositions, &localVocabMapping, &blankNodeBlocks,
-                  minBlankNodeIndex, lastId = Id::makeUndefined(),
+  auto remapId = [remapVocab = VocabIdRemapper{insertionPositions},
+                  &localVocabMapping, &blankNodeBlocks, minBlankNodeIndex,
+                  lastId = Id::makeUndefined(),
                   mappedId = Id::makeUndefined()](Id& id) mutable {
     if (lastId.getBits() == id.getBits()) {
       id = mappedId;
@@ -211,7 +259,7 @@ ad_utility::InputRangeTypeErased<IdTableStatic<0>> readIndexAndRemap(
     using enum Datatype;
     auto datatype = id.getDatatype();
     if (datatype == VocabIndex) [[likely]] {
-      id = remapVocabId(id, insertionPositions);
+      id = remapVocab(id);
     } else if (datatype == LocalVocabIndex) {
       id = localVocabMapping.at(id.getBits());
     } else if (datatype == BlankNodeIndex) {
@@ -405,8 +453,8 @@ indexRebuilder::IndexRebuildMapping materializeToIndex(
     net::post(threadPool, exceptionCollector.wrap([&newIndex, &index,
                                                    &insertionPositions]() {
       newIndex.getPatterns() = index.getPatterns().cloneAndRemap(
-          [&insertionPositions](const Id& oldId) {
-            return remapVocabId(oldId, insertionPositions);
+          [remapVocab = VocabIdRemapper{insertionPositions}](const Id& oldId) {
+            return remapVocab(oldId);
           });
       newIndex.writePatternsToFile();
     }));
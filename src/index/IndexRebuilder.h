@@ -14,6 +14,7 @@
 #include <string>
 #include <vector>
 
+#include "backports/span.h"
 #include "global/IndexTypes.h"
 #include "index/DeltaTriples.h"
 #include "index/IndexImpl.h"
@@ -29,6 +30,29 @@ namespace indexRebuilder {
 // rebuild.
 Id remapVocabId(Id original, const InsertionPositions& insertionPositions);
 
+// A precomputed lookup structure that computes the same mapping as
+// `remapVocabId`, but in (amortized) constant time per `Id` instead of a
+// binary search over all the `insertionPositions`. The range of the old vocab
+// indices is divided into buckets of equal size (a power of two), each of
+// which contains about one insertion position on average, and for each bucket
+// the number of insertion positions before it is stored. Only the (few)
+// insertion positions inside the bucket of an `Id` then have to be inspected.
+class VocabIdRemapper {
+  // ql::span instead of a reference, s.t. the class is cheap to copy.
+  ql::span<const VocabIndex> insertionPositions_;
+  size_t bucketShift_ = 0;
+  // `bucketOffsets_[i]` is the number of insertion positions that are smaller
+  // than `i << bucketShift_`. The last entry is the total number.
+  std::vector<size_t> bucketOffsets_;
+
+ public:
+  // The `insertionPositions` must be sorted and must outlive the remapper.
+  explicit VocabIdRemapper(const InsertionPositions& insertionPositions);
+
+  // Return `remapVocabId(original, insertionPositions)`.
+  Id operator()(Id original) const;
+};
+
 // Remaps a blank node `Id` to another blank node `Id` to reduce the gaps in the
 // id space left by random allocation of blank node ids. Return an empty
 // optional if the blank node cannot be remapped given the provided mapping.
@@ -49,14 +49,16 @@ struct InputFileSpecification {
   std::optional<std::string> defaultGraph_;
 
   // If set to `true`, then the parallel RDF parser will be used for this file.
-  // This always works for N-Triples and N-Quads files, and for well-behaved
-  // Turtle files with all prefixes at the beginning and no multiline literals.
   bool parseInParallel_ = false;
 
   // Remember if the value for parallel parsing was set explicitly (via the
   // command line).
   bool parseInParallelSetExplicitly_ = false;
 
+  // The compression of the input. If it is not `None`, then the bytes of the
+  // `source_` are decompressed in a separate thread while parsing.
+  InputCompression compression_ = InputCompression::None;
+
   // Return the filename/description for the `source_`.
   const std::string& filename() const {
     return std::visit(
@@ -72,15 +74,23 @@ struct InputFileSpecification {
 
   // Create and return a `ParallelBuffer` for this spec. For filename-based
   // specs, a `ParallelFileBuffer` with the given `blocksize` is returned. For
-  // factory-based specs, the factory is called.
+  // factory-based specs, the factory is called. If the input is compressed,
+  // the buffer is wrapped in a `ParallelDecompressingBuffer`.
   std::unique_ptr<ParallelBuffer> getParallelBuffer(size_t blocksize) const {
-    if (std::holds_alternative<std::string>(source_)) {
-      return std::make_unique<ParallelFileBuffer>(
-          blocksize, std::get<std::string>(source_));
+    auto buffer = [this, blocksize]() -> std::unique_ptr<ParallelBuffer> {
+      if (std::holds_alternative<std::string>(source_)) {
+        return std::make_unique<ParallelFileBuffer>(
+            blocksize, std::get<std::string>(source_));
+      }
+      auto& [factory, description] =
+          std::get<BufferFactoryAndDescription>(source_);
+      return factory(blocksize, description);
+    }();
+    if (compression_ == InputCompression::None) {
+      return buffer;
     }
-    auto& [factory, description] =
-        std::get<BufferFactoryAndDescription>(source_);
-    return factory(blocksize, description);
+    return std::make_unique<ParallelDecompressingBuffer>(std::move(buffer),
+                                                         compression_);
   }
 };
 }  // namespace qlever
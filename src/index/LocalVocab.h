@@ -7,7 +7,6 @@
 #define QLEVER_SRC_ENGINE_LOCALVOCAB_H
 
 #include <absl/container/flat_hash_set.h>
-#include <absl/container/node_hash_set.h>
 
 #include <cstdlib>
 #include <memory>
@@ -17,6 +16,7 @@
 #include "backports/algorithm.h"
 #include "backports/span.h"
 #include "index/LocalVocabEntry.h"
+#include "index/LocalVocabWordSet.h"
 #include "util/BlankNodeManager.h"
 #include "util/Exception.h"
 
@@ -37,10 +37,11 @@ class LocalVocab {
  private:
   // The primary set of `LocalVocabEntry`s, which can grow dynamically.
   //
-  // NOTE: This is a `absl::node_hash_set` because we hand out pointers to
-  // the `LocalVocabEntry`s and it is hence essential that their addresses
-  // remain stable over their lifetime in the hash set.
-  using Set = absl::node_hash_set<LocalVocabEntry>;
+  // NOTE: We hand out pointers to the `LocalVocabEntry`s, so it is essential
+  // that their addresses remain stable over their lifetime in the set. The
+  // `LocalVocabWordSet` guarantees this and allocates the entries in blocks
+  // (instead of one allocation per entry).
+  using Set = LocalVocabWordSet;
   std::shared_ptr<Set> primaryWordSet_ = std::make_shared<Set>();
 
   using LocalBlankNodeManager =
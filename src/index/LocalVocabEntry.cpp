@@ -4,8 +4,12 @@
 
 #include "index/LocalVocabEntry.h"
 
+#include <thread>
+
 #include "global/VocabIndex.h"
 #include "index/IndexImpl.h"
+#include "util/HashSet.h"
+#include "util/ParallelExecutor.h"
 
 // ___________________________________________________________________________
 ql::strong_ordering LocalVocabEntry::compareThreeWay(
@@ -22,6 +26,18 @@ ql::strong_ordering LocalVocabEntry::compareThreeWay(
   }
 }
 
+// ___________________________________________________________________________
+auto LocalVocabEntry::encodedShortLiteral() const -> std::optional<IdProxy> {
+  if (!isLiteral()) {
+    return std::nullopt;
+  }
+  auto opt = context_->encodedIriManager().encode(toStringRepresentation());
+  if (!opt.has_value()) {
+    return std::nullopt;
+  }
+  return IdProxy::make(opt.value().getBits());
+}
+
 // ___________________________________________________________________________
 auto LocalVocabEntry::positionInVocabExpensiveCase() const -> PositionInVocab {
   // Lookup the lower and upper bound from the vocabulary of the index,
@@ -55,6 +71,44 @@ auto LocalVocabEntry::positionInVocabExpensiveCase() const -> PositionInVocab {
   return positionInVocab;
 }
 
+// _____________________________________________________________________________
+void LocalVocabEntry::computePositionsInVocab(
+    ql::span<const LocalVocabEntry* const> entries) {
+  ad_utility::HashSet<const LocalVocabEntry*> unknownSet;
+  for (const LocalVocabEntry* entry : entries) {
+    if (!entry->positionInVocabKnown_.load(std::memory_order_acquire)) {
+      unknownSet.insert(entry);
+    }
+  }
+  std::vector<const LocalVocabEntry*> unknown(unknownSet.begin(),
+                                              unknownSet.end());
+  auto computePositions = [](ql::span<const LocalVocabEntry* const> batch) {
+    for (const LocalVocabEntry* entry : batch) {
+      entry->positionInVocabExpensiveCase();
+    }
+  };
+  // The lookup of a single position is a binary search in the vocabulary, so
+  // it only pays off to start threads for a sufficient number of lookups.
+  static constexpr size_t minNumLookupsPerThread = 1000;
+  const size_t numThreads =
+      std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()),
+                       unknown.size() / minNumLookupsPerThread);
+  if (numThreads <= 1) {
+    computePositions(unknown);
+    return;
+  }
+  const size_t batchSize = (unknown.size() + numThreads - 1) / numThreads;
+  std::vector<std::packaged_task<void()>> tasks;
+  for (size_t begin = 0; begin < unknown.size(); begin += batchSize) {
+    ql::span<const LocalVocabEntry* const> batch{
+        unknown.data() + begin, std::min(batchSize, unknown.size() - begin)};
+    tasks.emplace_back([&computePositions, batch]() {
+      computePositions(batch);
+    });
+  }
+  ad_utility::runTasksInParallel(std::move(tasks));
+}
+
 // _____________________________________________________________________________
 LocalVocabEntry LocalVocabEntry::fromStringRepresentation(
     std::string s, const LocalVocabContext& ctx) {
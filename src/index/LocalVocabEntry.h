@@ -11,6 +11,7 @@
 
 #include "backports/algorithm.h"
 #include "backports/keywords.h"
+#include "backports/span.h"
 #include "backports/three_way_comparison.h"
 #include "global/TypedIndex.h"
 #include "global/VocabIndex.h"
@@ -128,6 +129,20 @@ class alignas(16) LocalVocabEntry
     return positionInVocabExpensiveCase();
   }
 
+  // If this entry is a literal that can be encoded directly into an `Id`
+  // (see the short literals in `EncodedIriManager`), return the bits of that
+  // `Id`, else return `std::nullopt`.
+  std::optional<IdProxy> encodedShortLiteral() const;
+
+  // Compute and cache the positions in the vocabulary of all the `entries`
+  // for which they are not yet known. This has the same effect as calling
+  // `positionInVocab()` for each entry, but large batches are looked up in
+  // parallel. This should be called before sorting or comparing many `Id`s
+  // with new local vocab entries (which otherwise triggers the lookups one by
+  // one).
+  static void computePositionsInVocab(
+      ql::span<const LocalVocabEntry* const> entries);
+
   // It suffices to hash the base class `LiteralOrIri` as the position in the
   // vocab is redundant for those purposes.
   template <typename H, typename V>
@@ -0,0 +1,177 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_LOCALVOCABWORDSET_H
+#define QLEVER_SRC_INDEX_LOCALVOCABWORDSET_H
+
+#include <absl/container/flat_hash_set.h>
+#include <absl/hash/hash.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "index/LocalVocabEntry.h"
+#include "util/Forward.h"
+
+// A set of `LocalVocabEntry`s with stable addresses (the addresses are used
+// as the `LocalVocabIndex` of the entries), which is the building block of
+// the `LocalVocab`.
+//
+// The entries are stored in an arena of blocks, each of which is filled up
+// before the next (larger) one is allocated, so (unlike with a
+// `absl::node_hash_set`) inserting a new entry doesn't require an allocation
+// of its own. The lookup is done via a flat (open addressing) hash set of
+// pointers into the arena. Iterating over the set yields the entries in the
+// order in which they have been inserted.
+class LocalVocabWordSet {
+ private:
+  // The size of the first block, and the maximal size of a block. In between,
+  // each new block is as large as all the previous blocks together.
+  static constexpr size_t minBlockSize_ = 16;
+  static constexpr size_t maxBlockSize_ = 1 << 16;
+
+  // The blocks of the arena. The capacity of each block is reserved when it
+  // is created and never exceeded, s.t. the entries never move. None of the
+  // blocks is empty.
+  std::vector<std::vector<LocalVocabEntry>> blocks_;
+
+  // The elements of the hash table are pointers into the arena together with
+  // the precomputed hash of the entry. This way the (potentially long) strings
+  // are hashed only once per insertion or lookup and never again when the
+  // table grows, and most of the comparisons of unequal entries are resolved
+  // by comparing the hashes.
+  struct Element {
+    const LocalVocabEntry* entry_;
+    size_t hash_;
+  };
+  // A word that is looked up, together with its hash.
+  struct Key {
+    const LocalVocabEntry& entry_;
+    size_t hash_;
+  };
+  static size_t hashOf(const LocalVocabEntry& entry) {
+    return absl::Hash<LocalVocabEntry>{}(entry);
+  }
+  static const LocalVocabEntry& get(const Element& element) {
+    return *element.entry_;
+  }
+  static const LocalVocabEntry& get(const Key& key) { return key.entry_; }
+
+  // Transparent hash and equality functors that use the precomputed hashes.
+  struct Hash {
+    using is_transparent = void;
+    template <typename T>
+    size_t operator()(const T& elementOrKey) const {
+      return elementOrKey.hash_;
+    }
+  };
+  struct Equal {
+    using is_transparent = void;
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+      return a.hash_ == b.hash_ && get(a) == get(b);
+    }
+  };
+  absl::flat_hash_set<Element, Hash, Equal> index_;
+
+ public:
+  LocalVocabWordSet() = default;
+
+  // The entries are referenced by their address, so the set can't be copied.
+  // Moving is fine, because it doesn't change the addresses of the entries.
+  LocalVocabWordSet(const LocalVocabWordSet&) = delete;
+  LocalVocabWordSet& operator=(const LocalVocabWordSet&) = delete;
+  LocalVocabWordSet(LocalVocabWordSet&&) = default;
+  LocalVocabWordSet& operator=(LocalVocabWordSet&&) = default;
+
+  // Insert the `word` if it is not yet contained. Return a pointer to the
+  // (new or already existing) entry and a bool that is true iff the `word`
+  // was newly inserted (same as `std::unordered_set::insert`).
+  template <typename WordT>
+  std::pair<const LocalVocabEntry*, bool> insert(WordT&& word) {
+    const size_t hash = hashOf(word);
+    if (auto it = index_.find(Key{word, hash}); it != index_.end()) {
+      return {it->entry_, false};
+    }
+    if (blocks_.empty() || blocks_.back().size() == blocks_.back().capacity()) {
+      blocks_.emplace_back().reserve(
+          std::clamp(size(), minBlockSize_, maxBlockSize_));
+    }
+    auto& block = blocks_.back();
+    const LocalVocabEntry* entry = &block.emplace_back(AD_FWD(word));
+    index_.insert(Element{entry, hash});
+    return {entry, true};
+  }
+
+  // Return a pointer to the entry that is equal to the `word`, or `nullptr`
+  // if there is no such entry.
+  const LocalVocabEntry* find(const LocalVocabEntry& word) const {
+    auto it = index_.find(Key{word, hashOf(word)});
+    return it == index_.end() ? nullptr : it->entry_;
+  }
+
+  size_t size() const { return index_.size(); }
+  bool empty() const { return index_.empty(); }
+
+  // Forward iterator over all the entries in the order of their insertion.
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = LocalVocabEntry;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const LocalVocabEntry*;
+    using reference = const LocalVocabEntry&;
+
+   private:
+    const std::vector<std::vector<LocalVocabEntry>>* blocks_ = nullptr;
+    size_t blockIndex_ = 0;
+    size_t indexInBlock_ = 0;
+
+   public:
+    Iterator() = default;
+    Iterator(const std::vector<std::vector<LocalVocabEntry>>* blocks,
+             size_t blockIndex)
+        : blocks_{blocks}, blockIndex_{blockIndex} {}
+
+    reference operator*() const {
+      return (*blocks_)[blockIndex_][indexInBlock_];
+    }
+    pointer operator->() const { return &**this; }
+
+    Iterator& operator++() {
+      ++indexInBlock_;
+      if (indexInBlock_ == (*blocks_)[blockIndex_].size()) {
+        ++blockIndex_;
+        indexInBlock_ = 0;
+      }
+      return *this;
+    }
+    Iterator operator++(int) {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    friend bool operator==(const Iterator& a, const Iterator& b) {
+      return a.blockIndex_ == b.blockIndex_ &&
+             a.indexInBlock_ == b.indexInBlock_;
+    }
+    friend bool operator!=(const Iterator& a, const Iterator& b) {
+      return !(a == b);
+    }
+  };
+
+  Iterator begin() const { return {&blocks_, 0}; }
+  Iterator end() const { return {&blocks_, blocks_.size()}; }
+};
+
+#endif  // QLEVER_SRC_INDEX_LOCALVOCABWORDSET_H
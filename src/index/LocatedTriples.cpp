@@ -25,29 +25,65 @@ std::vector<LocatedTriple> LocatedTriple::locateTriplesInPermutation(
     ql::span<const IdTriple<0>> triples,
     ql::span<const CompressedBlockMetadata> blockMetadata,
     const qlever::KeyOrder& keyOrder, bool insertOrDelete,
-    ad_utility::SharedCancellationHandle cancellationHandle) {
+    ad_utility::SharedCancellationHandle cancellationHandle,
+    const BlockMetadataSearchIndex* searchIndex) {
   std::vector<LocatedTriple> out;
   out.reserve(triples.size());
+  const size_t numBlocks = blockMetadata.size();
+  AD_CONTRACT_CHECK(searchIndex == nullptr || searchIndex->size() == numBlocks);
+  // The block of the previous triple. If the triples are sorted according to
+  // the `keyOrder`, the search for the block of a triple starts at the block of
+  // the previous one, which makes this a merge-style pass over the blocks.
+  size_t previousBlockIndex = 0;
+  using PermutedTriple = CompressedBlockMetadata::PermutedTriple;
+  std::optional<PermutedTriple> previousTriple;
   ad_utility::chunkedForLoop<10'000>(
       0, triples.size(),
-      [&triples, &out, &blockMetadata, &keyOrder, &insertOrDelete](size_t i) {
+      [&triples, &out, &blockMetadata, &keyOrder, &insertOrDelete, numBlocks,
+       &previousBlockIndex, &previousTriple, searchIndex](size_t i) {
         auto triple = triples[i].permute(keyOrder);
+        auto permutedTriple = triple.toPermutedTriple();
         // A triple belongs to the first block that contains at least one triple
         // that larger than or equal to the triple. See `LocatedTriples.h` for a
         // discussion of the corner cases.
-        size_t blockIndex =
-            ql::ranges::lower_bound(
-                blockMetadata, triple.toPermutedTriple(),
-                [](const auto& a, const auto& b) {
-                  // All identical triples with different graphs are currently
-                  // stored in the same block, so we don't need to check the
-                  // graph. In particular, if this triple is equal (without
-                  // graphs) to the first or last triple of a block, then this
-                  // call to `lower_bound` will correctly identify this block.
-                  return a.tieWithoutGraph() < b.tieWithoutGraph();
-                },
-                &CompressedBlockMetadata::lastTriple_) -
-            blockMetadata.begin();
+        //
+        // All identical triples with different graphs are currently stored in
+        // the same block, so we don't need to check the graph. In particular,
+        // if this triple is equal (without graphs) to the first or last triple
+        // of a block, then the search below will correctly identify this
+        // block.
+        auto isBeforeTriple = [&permutedTriple](const PermutedTriple& last) {
+          return last.tieWithoutGraph() < permutedTriple.tieWithoutGraph();
+        };
+        bool isNotBeforePrevious = previousTriple.has_value() &&
+                                   !(permutedTriple.tieWithoutGraph() <
+                                     previousTriple.value().tieWithoutGraph());
+        size_t blockIndex;
+        if (!isNotBeforePrevious && searchIndex != nullptr) {
+          blockIndex = searchIndex->firstBlockNotBefore(permutedTriple);
+        } else {
+          // Exponential search for a range `[begin, end]` that contains the
+          // block, followed by a binary search within that range.
+          size_t begin = isNotBeforePrevious ? previousBlockIndex : 0;
+          size_t end = begin;
+          for (size_t step = 1; end < numBlocks &&
+                                isBeforeTriple(blockMetadata[end].lastTriple_);
+               step *= 2) {
+            begin = end + 1;
+            end = std::min(numBlocks, end + step);
+          }
+          blockIndex =
+              ql::ranges::lower_bound(
+                  blockMetadata.begin() + begin, blockMetadata.begin() + end,
+                  permutedTriple,
+                  [](const auto& a, const auto& b) {
+                    return a.tieWithoutGraph() < b.tieWithoutGraph();
+                  },
+                  &CompressedBlockMetadata::lastTriple_) -
+              blockMetadata.begin();
+        }
+        previousBlockIndex = blockIndex;
+        previousTriple = permutedTriple;
         out.push_back({blockIndex, triple, insertOrDelete});
       },
       [&cancellationHandle]() { cancellationHandle->throwIfCancelled(); });
@@ -395,6 +431,8 @@ void LocatedTriplesPerBlock::erase(size_t blockIndex,
 // ____________________________________________________________________________
 void LocatedTriplesPerBlock::setOriginalMetadata(
     std::shared_ptr<const std::vector<CompressedBlockMetadata>> metadata) {
+  originalSearchIndex_ =
+      std::make_shared<const BlockMetadataSearchIndex>(*metadata);
   originalMetadata_ = std::move(metadata);
 }
 
@@ -406,6 +444,11 @@ void LocatedTriplesPerBlock::setOriginalMetadata(
 void updateGraphMetadata(CompressedBlockMetadata& blockMetadata,
                          const LocatedTriples& locatedTriples) {
   auto& graphs = blockMetadata.graphInfo_;
+  for (const LocatedTriple& lt :
+       locatedTriples | ql::views::filter(&LocatedTriple::insertOrDelete_)) {
+    blockMetadata.graphBloomFilter_.add(
+        lt.triple_.ids().at(ADDITIONAL_COLUMN_GRAPH_ID));
+  }
   // We only insert graphs, never delete them, so if `graphs` is already
   // `nullopt`, then it will stay `nullopt`.
   if (graphs.has_value()) {
@@ -427,6 +470,40 @@ void updateGraphMetadata(CompressedBlockMetadata& blockMetadata,
   }
 }
 
+// Widen the column statistics of the `blockMetadata` such that they also
+// cover all the triples that are inserted into that block. Deleted triples can
+// be ignored, because the statistics only have to be conservative.
+static void updateColumnStatistics(CompressedBlockMetadata& blockMetadata,
+                                   const LocatedTriples& locatedTriples) {
+  auto& statistics = blockMetadata.columnStatistics_;
+  if (!statistics.has_value()) {
+    return;
+  }
+  for (const LocatedTriple& lt :
+       locatedTriples | ql::views::filter(&LocatedTriple::insertOrDelete_)) {
+    const auto& ids = lt.triple_.ids();
+    for (size_t i = 0; i < statistics->size(); ++i) {
+      statistics.value()[i].add(ids.at(i));
+    }
+  }
+}
+
+// Add all the triples that are inserted into the block to the triple Bloom
+// filter of the `blockMetadata` (if it has one). Deleted triples stay in the
+// filter, which is fine, because a Bloom filter may have false positives.
+static void updateTripleBloomFilter(CompressedBlockMetadata& blockMetadata,
+                                    const LocatedTriples& locatedTriples) {
+  auto& filter = blockMetadata.tripleBloomFilter_;
+  if (!filter.has_value()) {
+    return;
+  }
+  for (const LocatedTriple& lt :
+       locatedTriples | ql::views::filter(&LocatedTriple::insertOrDelete_)) {
+    const auto& ids = lt.triple_.ids();
+    filter->add(ids.at(0), ids.at(1), ids.at(2));
+  }
+}
+
 // ____________________________________________________________________________
 void LocatedTriplesPerBlock::updateAugmentedMetadata() {
   // TODO<C++23> use view::enumerate
@@ -448,6 +525,8 @@ void LocatedTriplesPerBlock::updateAugmentedMetadata() {
           std::max(blockMetadata.lastTriple_,
                    blockUpdates->rbegin()->triple_.toPermutedTriple());
       updateGraphMetadata(blockMetadata, *blockUpdates);
+      updateColumnStatistics(blockMetadata, *blockUpdates);
+      updateTripleBloomFilter(blockMetadata, *blockUpdates);
     }
     blockIndex++;
   }
@@ -470,6 +549,8 @@ void LocatedTriplesPerBlock::updateAugmentedMetadata() {
         CompressedBlockMetadata::checkInvariantsForSortedBlocks(
             *augmentedMetadata_));
   }
+  augmentedSearchIndex_ =
+      std::make_shared<const BlockMetadataSearchIndex>(*augmentedMetadata_);
 }
 
 // ____________________________________________________________________________
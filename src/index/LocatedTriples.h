@@ -84,12 +84,15 @@ struct LocatedTriple {
   // If `true`, the triple is inserted, otherwise it is deleted.
   bool insertOrDelete_;
 
-  // Locate the given triples in the given permutation.
+  // Locate the given triples in the given permutation. If the `searchIndex`
+  // (of the `blockMetadata`) is given, it is used to find the blocks of the
+  // triples that are not larger than their predecessor in the `triples`.
   static std::vector<LocatedTriple> locateTriplesInPermutation(
       ql::span<const IdTriple<0>> triples,
       ql::span<const CompressedBlockMetadata> blockMetadata,
       const qlever::KeyOrder& keyOrder, bool insertOrDelete,
-      ad_utility::SharedCancellationHandle cancellationHandle);
+      ad_utility::SharedCancellationHandle cancellationHandle,
+      const BlockMetadataSearchIndex* searchIndex = nullptr);
 
   QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(LocatedTriple, blockIndex_,
                                               triple_, insertOrDelete_)
@@ -142,6 +145,11 @@ class LocatedTriplesPerBlock {
   std::optional<std::vector<CompressedBlockMetadata>> augmentedMetadata_;
   std::optional<std::shared_ptr<const std::vector<CompressedBlockMetadata>>>
       originalMetadata_;
+  // Search indices for the original and the augmented metadata (see
+  // `BlockMetadataSearchIndex`). They are shared, s.t. copies of this class
+  // (e.g. for a snapshot) are cheap.
+  std::shared_ptr<const BlockMetadataSearchIndex> originalSearchIndex_;
+  std::shared_ptr<const BlockMetadataSearchIndex> augmentedSearchIndex_;
 
  public:
   void updateAugmentedMetadata();
@@ -233,6 +241,9 @@ class LocatedTriplesPerBlock {
             std::move(metadata)));
   }
 
+  // Return true iff `setOriginalMetadata` has been called.
+  bool hasOriginalMetadata() const { return originalMetadata_.has_value(); }
+
   // Returns the block metadata where the block borders have been updated to
   // account for the update triples. All triples (both insert and delete) will
   // enlarge the block borders.
@@ -244,11 +255,25 @@ class LocatedTriplesPerBlock {
     return *originalMetadata_.value();
   };
 
+  // Return the search index for the `getAugmentedMetadata()`, or `nullptr` if
+  // there is none.
+  const BlockMetadataSearchIndex* getAugmentedSearchIndex() const {
+    return augmentedMetadata_.has_value() ? augmentedSearchIndex_.get()
+                                          : originalSearchIndex_.get();
+  }
+
+  // Return the search index for the original metadata, or `nullptr` if the
+  // original metadata has not been set.
+  const BlockMetadataSearchIndex* getOriginalSearchIndex() const {
+    return originalSearchIndex_.get();
+  }
+
   // Remove all located triples.
   void clear() {
     map_.clear();
     numTriples_ = 0;
     augmentedMetadata_.reset();
+    augmentedSearchIndex_.reset();
   }
 
   // Identify, for all blocks in `perm` whose number of located triples is at
@@ -28,10 +28,27 @@ Permutation::Permutation(Enum permutation, Allocator allocator,
       allocator_{std::move(allocator)},
       permutation_{permutation} {}
 
+// Return true iff the blocks of a permutation are given by the augmented
+// metadata of its `locatedTriples`. For a lazily loaded permutation, the
+// original metadata is only set for the delta triples before the first update,
+// see `loadFromDiskLazily`.
+static bool usesAugmentedMetadata(
+    const LocatedTriplesPerBlock& locatedTriples) {
+  return locatedTriples.hasOriginalMetadata() ||
+         locatedTriples.numTriples() > 0;
+}
+
 // _____________________________________________________________________
 CompressedRelationReader::ScanSpecAndBlocks Permutation::getScanSpecAndBlocks(
     const ScanSpecification& scanSpec,
     const LocatedTriplesState& locatedTriplesState) const {
+  const auto& locatedTriples =
+      getLocatedTriplesForPermutation(locatedTriplesState);
+  if (usesAugmentedMetadata(locatedTriples)) {
+    if (const auto* searchIndex = locatedTriples.getAugmentedSearchIndex()) {
+      return {scanSpec, locatedTriples.getAugmentedMetadata(), *searchIndex};
+    }
+  }
   return {scanSpec, BlockMetadataRanges(getAugmentedMetadataForPermutation(
                         locatedTriplesState))};
 }
@@ -67,7 +84,7 @@ void Permutation::loadFromDisk(
              "message was: " +
              e.what());
   }
-  meta_.readFromFile(&file);
+  meta_.readFromFile(filename);
   // Materialized views never use graph post-processing, while normal and
   // internal permutations always use it.
   bool useGraphPostProcessing = permutationType != Type::MATERIALIZED_VIEW;
@@ -77,6 +94,18 @@ void Permutation::loadFromDisk(
   isLoaded_ = true;
 }
 
+// _____________________________________________________________________________
+void Permutation::loadFromDiskLazily(const std::string& onDiskBase,
+                                     bool loadInternalPermutation) {
+  AD_CONTRACT_CHECK(!isLoaded());
+  lazyLoad_ = std::make_unique<LazyLoad>();
+  lazyLoad_->load_ = [this, onDiskBase, loadInternalPermutation]() {
+    loadFromDisk(onDiskBase, loadInternalPermutation);
+  };
+  AD_LOG_INFO << "The " << readableName_
+              << " permutation will be loaded on its first use" << std::endl;
+}
+
 // _____________________________________________________________________________
 void Permutation::setOriginalMetadataForDeltaTriples(
     DeltaTriples& deltaTriples) const {
@@ -92,14 +121,17 @@ IdTable Permutation::scan(const ScanSpecAndBlocks& scanSpecAndBlocks,
                           ColumnIndicesRef additionalColumns,
                           const CancellationHandle& cancellationHandle,
                           const LocatedTriplesState& locatedTriplesState,
-                          const LimitOffsetClause& limitOffset) const {
+                          const LimitOffsetClause& limitOffset,
+                          CompressedRelationReader::LazyScanMetadata*
+                              scanMetadata) const {
+  ensureLoaded();
   if (!isLoaded_) {
     throw std::runtime_error("This query requires the permutation " +
                              readableName_ + ", which was not loaded");
   }
   return reader().scan(scanSpecAndBlocks, additionalColumns, cancellationHandle,
                        getLocatedTriplesForPermutation(locatedTriplesState),
-                       limitOffset);
+                       limitOffset, scanMetadata);
 }
 
 // _____________________________________________________________________
@@ -187,8 +219,8 @@ std::string_view Permutation::toString(Permutation::Enum permutation) {
 // _____________________________________________________________________
 std::optional<CompressedRelationMetadata> Permutation::getMetadata(
     Id col0Id, const LocatedTriplesState& locatedTriplesState) const {
-  if (meta_.col0IdExists(col0Id)) {
-    return meta_.getMetaData(col0Id);
+  if (metaData().col0IdExists(col0Id)) {
+    return metaData().getMetaData(col0Id);
   }
   return reader().getMetadataForSmallRelation(
       getScanSpecAndBlocks(
@@ -217,10 +249,11 @@ CompressedRelationReader::IdTableGeneratorInputRange Permutation::lazyScan(
     ColumnIndicesRef additionalColumns,
     const CancellationHandle& cancellationHandle,
     const LocatedTriplesState& locatedTriplesState,
-    const LimitOffsetClause& limitOffset) const {
+    const LimitOffsetClause& limitOffset,
+    std::optional<ql::span<const Id>> firstColumnKeys) const {
   return lazyScanImpl(reader(), scanSpecAndBlocks, std::move(optBlocks),
                       additionalColumns, cancellationHandle,
-                      locatedTriplesState, limitOffset);
+                      locatedTriplesState, limitOffset, firstColumnKeys);
 }
 
 // _____________________________________________________________________________
@@ -231,7 +264,8 @@ CompressedRelationReader::IdTableGeneratorInputRange Permutation::lazyScanImpl(
     ColumnIndicesRef additionalColumns,
     const CancellationHandle& cancellationHandle,
     const LocatedTriplesState& locatedTriplesState,
-    const LimitOffsetClause& limitOffset) const {
+    const LimitOffsetClause& limitOffset,
+    std::optional<ql::span<const Id>> firstColumnKeys) const {
   ColumnIndices columns{additionalColumns.begin(), additionalColumns.end()};
   if (!optBlocks.has_value()) {
     optBlocks = CompressedRelationReader::convertBlockMetadataRangesToVector(
@@ -240,7 +274,8 @@ CompressedRelationReader::IdTableGeneratorInputRange Permutation::lazyScanImpl(
   return reader.lazyScan(
       scanSpecAndBlocks.scanSpec_, std::move(optBlocks.value()),
       std::move(columns), cancellationHandle,
-      getLocatedTriplesForPermutation(locatedTriplesState), limitOffset);
+      getLocatedTriplesForPermutation(locatedTriplesState), limitOffset,
+      firstColumnKeys);
 }
 
 // _____________________________________________________________________________
@@ -271,13 +306,17 @@ const LocatedTriplesPerBlock& Permutation::getLocatedTriplesForPermutation(
 // ______________________________________________________________________
 BlockMetadataRanges Permutation::getAugmentedMetadataForPermutation(
     const LocatedTriplesState& locatedTriplesState) const {
-  BlockMetadataSpan blocks(getLocatedTriplesForPermutation(locatedTriplesState)
-                               .getAugmentedMetadata());
+  const auto& locatedTriples =
+      getLocatedTriplesForPermutation(locatedTriplesState);
+  BlockMetadataSpan blocks(usesAugmentedMetadata(locatedTriples)
+                               ? locatedTriples.getAugmentedMetadata()
+                               : metaData().blockData());
   return {{blocks.begin(), blocks.end()}};
 }
 
 // ______________________________________________________________________
 const Permutation& Permutation::internalPermutation() const {
+  ensureLoaded();
   AD_CONTRACT_CHECK(internalPermutation_ != nullptr);
   return *internalPermutation_;
 }
@@ -12,7 +12,9 @@
 #define QLEVER_SRC_INDEX_PERMUTATION_H
 
 #include <array>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "engine/VariableToColumnMap.h"
@@ -93,6 +95,14 @@ class Permutation {
       Type permutationType = Type::NORMAL,
       ad_utility::HashSet<ColumnIndex> possiblyUndefinedColumns = {});
 
+  // Register the permutation to be loaded from disk (via `loadFromDisk` with
+  // the given arguments) on its first use, which is thread-safe. The original
+  // metadata for the delta triples has to be set (via
+  // `setOriginalMetadataForDeltaTriples`) before the first update. Until then,
+  // scans use the metadata of this permutation.
+  void loadFromDiskLazily(const std::string& onDiskBase,
+                          bool loadInternalPermutation = false);
+
   // Set the original metadata for the delta triples. This also sets the
   // metadata for internal permutation if present.
   void setOriginalMetadataForDeltaTriples(DeltaTriples& deltaTriples) const;
@@ -105,7 +115,9 @@ class Permutation {
                ColumnIndicesRef additionalColumns,
                const CancellationHandle& cancellationHandle,
                const LocatedTriplesState& locatedTriplesState,
-               const LimitOffsetClause& limitOffset = {}) const;
+               const LimitOffsetClause& limitOffset = {},
+               CompressedRelationReader::LazyScanMetadata* scanMetadata =
+                   nullptr) const;
 
   // For a given relation, determine the `col1Id`s and their counts. This is
   // used for `computeGroupByObjectWithCount`. The `col0Id` must have metadata
@@ -138,6 +150,9 @@ class Permutation {
   //   in `ScanSpecAndBlocks`. The `BlockMetadatRanges` of the
   //   `ScanSpecAndBlocks` are ignored for scanning if `optBlocks` contains the
   //   join-specific prefiltered block metadata.
+  // - If `firstColumnKeys` are specified, only the rows with one of these
+  //   (sorted) keys in the first column are needed by the caller (see
+  //   `CompressedRelationReader::ScanImplConfig::firstColumnKeys_`).
   //
   // TODO<joka921> We should only communicate this interface via the
   // `ScanSpecAndBlocksAndBounds` class and make this a strong class that always
@@ -148,7 +163,8 @@ class Permutation {
       ColumnIndicesRef additionalColumns,
       const CancellationHandle& cancellationHandle,
       const LocatedTriplesState& locatedTriplesState,
-      const LimitOffsetClause& limitOffset = {}) const;
+      const LimitOffsetClause& limitOffset = {},
+      std::optional<ql::span<const Id>> firstColumnKeys = std::nullopt) const;
 
   // A lazy scan together with the independent `CompressedRelationReader` it
   // reads from. The `reader_` owns the file handle and allocator that `blocks_`
@@ -200,10 +216,13 @@ class Permutation {
       const LocatedTriplesState& locatedTriplesState) const;
 
   // _______________________________________________________
-  void setKbName(const std::string& name) { meta_.setName(name); }
+  void setKbName(const std::string& name) {
+    ensureLoaded();
+    meta_.setName(name);
+  }
 
   // _______________________________________________________
-  const std::string& getKbName() const { return meta_.getName(); }
+  const std::string& getKbName() const { return metaData().getName(); }
 
   // _______________________________________________________
   const std::string& readableName() const { return readableName_; }
@@ -218,10 +237,15 @@ class Permutation {
   const KeyOrder& keyOrder() const { return keyOrder_; };
 
   // _______________________________________________________
-  const bool& isLoaded() const { return isLoaded_; }
+  // Return true if the permutation has been loaded or is loaded on its first
+  // use (see `loadFromDiskLazily`).
+  bool isLoaded() const { return isLoaded_ || lazyLoad_ != nullptr; }
 
   // _______________________________________________________
-  const MetaData& metaData() const { return meta_; }
+  const MetaData& metaData() const {
+    ensureLoaded();
+    return meta_;
+  }
 
   // _______________________________________________________
   Type permutationType() const { return permutationType_; }
@@ -242,7 +266,10 @@ class Permutation {
   BlockMetadataRanges getAugmentedMetadataForPermutation(
       const LocatedTriplesState& locatedTriplesState) const;
 
-  const CompressedRelationReader& reader() const { return reader_.value(); }
+  const CompressedRelationReader& reader() const {
+    ensureLoaded();
+    return reader_.value();
+  }
 
   Enum permutation() const { return permutation_; }
 
@@ -264,6 +291,14 @@ class Permutation {
       ColumnIndex col) const;
 
  private:
+  // If the permutation is loaded lazily, load it unless this has already
+  // happened.
+  void ensureLoaded() const {
+    if (lazyLoad_ != nullptr) {
+      std::call_once(lazyLoad_->onceFlag_, lazyLoad_->load_);
+    }
+  }
+
   // Common implementation of the two `lazyScan` overloads above. Performs the
   // scan through the given `reader`, which may either be this permutation's
   // shared reader or an independently created one.
@@ -274,7 +309,8 @@ class Permutation {
       ColumnIndicesRef additionalColumns,
       const CancellationHandle& cancellationHandle,
       const LocatedTriplesState& locatedTriplesState,
-      const LimitOffsetClause& limitOffset) const;
+      const LimitOffsetClause& limitOffset,
+      std::optional<ql::span<const Id>> firstColumnKeys = std::nullopt) const;
 
   // The base filename of the permutation without the suffix below
   std::string onDiskBase_;
@@ -295,6 +331,14 @@ class Permutation {
 
   bool isLoaded_ = false;
 
+  // Only set if the permutation is loaded on its first use. The `once_flag`
+  // is stored on the heap, because it can neither be moved nor copied.
+  struct LazyLoad {
+    std::once_flag onceFlag_;
+    std::function<void()> load_;
+  };
+  std::unique_ptr<LazyLoad> lazyLoad_;
+
   Enum permutation_;
   std::unique_ptr<Permutation> internalPermutation_ = nullptr;
 
@@ -0,0 +1,62 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#include "index/PredicateStatistics.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#include "util/Exception.h"
+#include "util/Log.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializePair.h"
+#include "util/Serializer/SerializeVector.h"
+
+// _____________________________________________________________________________
+void PredicateStatistics::Builder::add(Id subject, Id predicate, Id object) {
+  if (sketches_.empty() || sketches_.back().first != predicate) {
+    // The triples have to be sorted by the predicate.
+    AD_CORRECTNESS_CHECK(sketches_.empty() ||
+                         sketches_.back().first < predicate);
+    sketches_.emplace_back(predicate, Sketches{});
+  }
+  auto& sketches = sketches_.back().second;
+  sketches.subjects_.add(subject.getBits());
+  sketches.objects_.add(object.getBits());
+}
+
+// _____________________________________________________________________________
+void PredicateStatistics::Builder::writeToFile(
+    const std::string& filename) const {
+  ad_utility::serialization::FileWriteSerializer writer{filename};
+  writer << sketches_;
+}
+
+// _____________________________________________________________________________
+void PredicateStatistics::readFromFile() const {
+  if (!filename_.has_value()) {
+    return;
+  }
+  if (!std::filesystem::exists(filename_.value())) {
+    AD_LOG_INFO << "No predicate statistics found (file " << filename_.value()
+                << "), the query planner uses the average multiplicities only"
+                << std::endl;
+    return;
+  }
+  ad_utility::serialization::FileReadSerializer reader{filename_.value()};
+  reader >> sketches_;
+  AD_LOG_DEBUG << "Read the predicate statistics for " << sketches_.size()
+               << " predicates" << std::endl;
+}
+
+// _____________________________________________________________________________
+auto PredicateStatistics::getSketches(Id predicate) const -> const Sketches* {
+  std::call_once(isLoaded_, [this]() { readFromFile(); });
+  auto it = std::lower_bound(
+      sketches_.begin(), sketches_.end(), predicate,
+      [](const auto& entry, Id id) { return entry.first < id; });
+  if (it == sketches_.end() || it->first != predicate) {
+    return nullptr;
+  }
+  return &it->second;
+}
@@ -0,0 +1,72 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_INDEX_PREDICATESTATISTICS_H
+#define QLEVER_SRC_INDEX_PREDICATESTATISTICS_H
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "global/Id.h"
+#include "util/HyperLogLog.h"
+#include "util/Serializer/Serializer.h"
+
+// Per-predicate statistics that are computed when building the index and
+// stored in a separate file next to the permutations. Currently these are
+// HyperLogLog sketches of the distinct subjects and objects of each predicate,
+// which allow the query planner to estimate how many distinct values two
+// scans with different predicates have in common (which the average
+// multiplicities of the permutations can't tell).
+//
+// The file is only read on the first call to `getSketches`, so that the
+// startup of the server isn't slowed down for indices with many predicates.
+class PredicateStatistics {
+ public:
+  struct Sketches {
+    ad_utility::HyperLogLog subjects_;
+    ad_utility::HyperLogLog objects_;
+
+    AD_SERIALIZE_FRIEND_FUNCTION(Sketches) {
+      serializer | arg.subjects_;
+      serializer | arg.objects_;
+    }
+  };
+
+  // The sketches for each predicate, sorted by the predicate.
+  using SketchesPerPredicate = std::vector<std::pair<Id, Sketches>>;
+
+  // Compute the statistics from triples that are sorted by the predicate
+  // (e.g. in the PSO or POS order).
+  class Builder {
+    SketchesPerPredicate sketches_;
+
+   public:
+    void add(Id subject, Id predicate, Id object);
+    void writeToFile(const std::string& filename) const;
+  };
+
+ private:
+  std::optional<std::string> filename_;
+  // Lazily initialized on the first call to `getSketches`.
+  mutable std::once_flag isLoaded_;
+  mutable SketchesPerPredicate sketches_;
+
+ public:
+  // Set the file from which the statistics are (lazily) read. If this is
+  // never called, or the file doesn't exist (e.g. for indices that were built
+  // before the statistics were introduced), `getSketches` always returns
+  // `nullptr`.
+  void setFilename(std::string filename) { filename_ = std::move(filename); }
+
+  // Return the sketches for the `predicate`, or `nullptr` if there are no
+  // statistics for it. Thread-safe.
+  const Sketches* getSketches(Id predicate) const;
+
+ private:
+  void readFromFile() const;
+};
+
+#endif  // QLEVER_SRC_INDEX_PREDICATESTATISTICS_H
@@ -638,6 +638,42 @@ class TripleComponentComparator {
     return aIsExternal && !bIsExternal;
   }
 
+  // Return a sort key for `a`, s.t. the bytewise comparison of the sort keys
+  // of two strings yields the same result as `compare` on the `TOTAL` level.
+  // Computing the sort keys once and comparing them is much cheaper than
+  // repeatedly calling `compare`, e.g. when sorting many strings. The sort key
+  // consists of the first character (which determines the datatype), the ICU
+  // sort key of the inner value (which never contains a zero byte), a zero
+  // byte as a separator, and the complete input as the final tie break.
+  [[nodiscard]] std::string getTotalSortKey(std::string_view a) const {
+    auto split = extractComparable<SplitValNonOwning>(a, Level::TOTAL);
+    auto innerSortKey =
+        _locManager.getSortKey(split.transformedVal_, Level::TOTAL);
+    const auto& bytes = innerSortKey.get();
+    std::string result;
+    result.reserve(bytes.size() + a.size() + 2);
+    result.push_back(split.firstOriginalChar_);
+    result.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    result.push_back('\0');
+    result.append(a);
+    return result;
+  }
+
+  // The equivalent of `isLessInTotalWithExternalFlag` for the sort keys that
+  // were obtained via `getTotalSortKey`.
+  static bool isLessInTotalWithExternalFlagBySortKey(std::string_view aSortKey,
+                                                     bool aIsExternal,
+                                                     std::string_view bSortKey,
+                                                     bool bIsExternal) {
+    // Note: `std::string_view::compare` compares the bytes as unsigned
+    // values, just like ICU's sort keys are compared.
+    int cmp = aSortKey.compare(bSortKey);
+    if (cmp != 0) {
+      return cmp < 0;
+    }
+    return aIsExternal && !bIsExternal;
+  }
+
   /**
    * @brief Split a literal or iri into its components and convert the inner
    * value according to the held locale
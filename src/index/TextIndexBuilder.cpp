@@ -6,13 +6,12 @@
 
 #include "index/TextIndexBuilder.h"
 
-#include <absl/cleanup/cleanup.h>
-
 #include <charconv>
-#include <filesystem>
 
+#include "index/ConstantsIndexBuilding.h"
 #include "index/Postings.h"
 #include "index/TextIndexReadWrite.h"
+#include "util/ThreadSafeQueue.h"
 
 // _____________________________________________________________________________
 void TextIndexBuilder::buildTextIndexFile(
@@ -92,35 +91,42 @@ size_t TextIndexBuilder::processWordsForVocabulary(
 void TextIndexBuilder::processWordsForInvertedLists(
     const std::string& contextFile, bool addWordsFromLiterals, TextVec& vec) {
   AD_LOG_TRACE << "BEGIN IndexImpl::passContextFileIntoVector" << std::endl;
-  ad_utility::HashMap<WordIndex, Score> wordsInContext;
-  ad_utility::HashMap<Id, Score> entitiesInContext;
-  auto currentContext = TextRecordIndex::make(0);
   // The nofContexts can be misleading since it also counts empty contexts
   size_t nofContexts = 0;
   size_t nofWordPostings = 0;
   size_t nofEntityPostings = 0;
   size_t entityNotFoundErrorMsgCount = 0;
   size_t nofLiterals = 0;
+  bool isFirstBatch = true;
 
-  for (const auto& line :
-       wordsInTextRecords(contextFile, addWordsFromLiterals)) {
-    if (line.contextId_ != currentContext) {
-      ++nofContexts;
-      addContextToVector(vec, currentContext, wordsInContext,
-                         entitiesInContext);
-      currentContext = line.contextId_;
-      wordsInContext.clear();
-      entitiesInContext.clear();
+  // The batches are processed in parallel (the lookups of the words and
+  // entities in the vocabularies and the computation of the scores are the
+  // expensive part), and added to the `vec` in their original order.
+  auto processBatch = [this](const std::vector<WordsFileLine>& batch) {
+    return processBatchOfTextRecords(batch);
+  };
+  for (auto& postings : ad_utility::data_structures::parallelTransform(
+           batchesOfTextRecords(contextFile, addWordsFromLiterals),
+           processBatch, NUM_THREADS_TEXT_INDEX_BUILDING,
+           NUM_THREADS_TEXT_INDEX_BUILDING, true)) {
+    for (const auto& entry : postings.entries_) {
+      vec.push(entry);
     }
-    if (line.isEntity_) {
-      ++nofEntityPostings;
-      processEntityCaseDuringInvertedListProcessing(
-          line, entitiesInContext, nofLiterals, entityNotFoundErrorMsgCount);
-    } else {
-      ++nofWordPostings;
-      processWordCaseDuringInvertedListProcessing(line, wordsInContext,
-                                                  scoreData_);
+    nofContexts += postings.numContextChanges_;
+    // The context of the lines before the first line is `0`, so a first line
+    // with context `0` is no change of the context.
+    if (isFirstBatch && postings.firstContext_ == TextRecordIndex::make(0)) {
+      --nofContexts;
     }
+    isFirstBatch = false;
+    nofWordPostings += postings.nofWordPostings_;
+    nofEntityPostings += postings.nofEntityPostings_;
+    nofLiterals += postings.nofLiterals_;
+    for (const auto& entity : postings.entitiesNotFound_) {
+      logEntityNotFound(entity, entityNotFoundErrorMsgCount);
+    }
+    entityNotFoundErrorMsgCount +=
+        postings.nofEntitiesNotFound_ - postings.entitiesNotFound_.size();
   }
   if (entityNotFoundErrorMsgCount > 0) {
     AD_LOG_WARN
@@ -130,7 +136,6 @@ void TextIndexBuilder::processWordsForInvertedLists(
   AD_LOG_DEBUG << "Number of total entity mentions: " << nofEntityPostings
                << std::endl;
   ++nofContexts;
-  addContextToVector(vec, currentContext, wordsInContext, entitiesInContext);
   textMeta_.setNofTextRecords(nofContexts);
   textMeta_.setNofWordPostings(nofWordPostings);
   textMeta_.setNofEntityPostings(nofEntityPostings);
@@ -142,6 +147,62 @@ void TextIndexBuilder::processWordsForInvertedLists(
   AD_LOG_TRACE << "END IndexImpl::passContextFileIntoVector" << std::endl;
 }
 
+// _____________________________________________________________________________
+cppcoro::generator<std::vector<WordsFileLine>>
+TextIndexBuilder::batchesOfTextRecords(std::string contextFile,
+                                       bool addWordsFromLiterals) const {
+  std::vector<WordsFileLine> batch;
+  for (auto& line :
+       wordsInTextRecords(std::move(contextFile), addWordsFromLiterals)) {
+    if (batch.size() >= BATCH_SIZE_TEXT_INDEX_BUILDING &&
+        line.contextId_ != batch.back().contextId_) {
+      co_yield batch;
+      batch.clear();
+    }
+    batch.push_back(std::move(line));
+  }
+  if (!batch.empty()) {
+    co_yield batch;
+  }
+}
+
+// _____________________________________________________________________________
+TextIndexBuilder::PostingsOfTextRecords
+TextIndexBuilder::processBatchOfTextRecords(
+    const std::vector<WordsFileLine>& batch) const {
+  PostingsOfTextRecords postings;
+  if (batch.empty()) {
+    return postings;
+  }
+  ad_utility::HashMap<WordIndex, Score> wordsInContext;
+  ad_utility::HashMap<Id, Score> entitiesInContext;
+  auto currentContext = batch.front().contextId_;
+  postings.firstContext_ = currentContext;
+  postings.numContextChanges_ = 1;
+  for (const auto& line : batch) {
+    if (line.contextId_ != currentContext) {
+      ++postings.numContextChanges_;
+      addContextToVector(postings.entries_, currentContext, wordsInContext,
+                         entitiesInContext);
+      currentContext = line.contextId_;
+      wordsInContext.clear();
+      entitiesInContext.clear();
+    }
+    if (line.isEntity_) {
+      ++postings.nofEntityPostings_;
+      processEntityCaseDuringInvertedListProcessing(line, entitiesInContext,
+                                                    postings);
+    } else {
+      ++postings.nofWordPostings_;
+      processWordCaseDuringInvertedListProcessing(line, wordsInContext,
+                                                  scoreData_);
+    }
+  }
+  addContextToVector(postings.entries_, currentContext, wordsInContext,
+                     entitiesInContext);
+  return postings;
+}
+
 // _____________________________________________________________________________
 cppcoro::generator<WordsFileLine> TextIndexBuilder::wordsInTextRecords(
     std::string contextFile, bool addWordsFromLiterals) const {
@@ -163,17 +224,19 @@ cppcoro::generator<WordsFileLine> TextIndexBuilder::wordsInTextRecords(
   // ROUND 2: Optionally, consider each literal from the internal vocabulary as
   // a text record.
   if (addWordsFromLiterals) {
-    for (VocabIndex index = VocabIndex::make(0); index.get() < vocab_.size();
+    // All the literals start with a quote, so they form a single range of the
+    // vocabulary, and the IRIs don't have to be decoded.
+    auto [begin, end] = vocab_.prefixRanges("\"").ranges()[0];
+    for (VocabIndex index = begin; index.get() < end.get();
          index = index.incremented()) {
       auto text = vocab_[index];
-      if (!isLiteral(text)) {
-        continue;
-      }
+      AD_CORRECTNESS_CHECK(isLiteral(text));
 
       // We need the explicit cast to `std::string` because the return type of
       // `indexToString` might be `string_view` if the vocabulary is stored
       // uncompressed in memory.
-      WordsFileLine entityLine{std::string{text}, true, contextId, 1, true};
+      WordsFileLine entityLine{std::string{text}, true, contextId, 1, true,
+                               index};
       co_yield entityLine;
       std::string_view textView = text;
       textView = textView.substr(0, textView.rfind('"'));
@@ -190,20 +253,29 @@ cppcoro::generator<WordsFileLine> TextIndexBuilder::wordsInTextRecords(
 // _____________________________________________________________________________
 void TextIndexBuilder::processEntityCaseDuringInvertedListProcessing(
     const WordsFileLine& line,
-    ad_utility::HashMap<Id, Score>& entitiesInContext, size_t& nofLiterals,
-    size_t& entityNotFoundErrorMsgCount) const {
+    ad_utility::HashMap<Id, Score>& entitiesInContext,
+    PostingsOfTextRecords& postings) const {
   VocabIndex eid;
   // TODO<joka921> Currently only IRIs and strings from the vocabulary can
   // be tagged entities in the text index (no doubles, ints, etc).
-  if (getVocab().getId(line.word_, &eid)) {
+  // The literals taken from the vocabulary already know their index.
+  if (line.vocabIndex_.has_value()) {
+    eid = line.vocabIndex_.value();
+  }
+  if (line.vocabIndex_.has_value() || getVocab().getId(line.word_, &eid)) {
     // Note that `entitiesInContext` is a HashMap, so the `Id`s don't have
     // to be contiguous.
     entitiesInContext[Id::makeFromVocabIndex(eid)] += line.score_;
     if (line.isLiteralEntity_) {
-      ++nofLiterals;
+      ++postings.nofLiterals_;
     }
   } else {
-    logEntityNotFound(line.word_, entityNotFoundErrorMsgCount);
+    // The warnings are logged by the caller (in the order of the input), see
+    // `logEntityNotFound`, which logs at most 20 of them.
+    if (postings.entitiesNotFound_.size() < 20) {
+      postings.entitiesNotFound_.push_back(line.word_);
+    }
+    ++postings.nofEntitiesNotFound_;
   }
 }
 
@@ -211,7 +283,7 @@ void TextIndexBuilder::processEntityCaseDuringInvertedListProcessing(
 void TextIndexBuilder::processWordCaseDuringInvertedListProcessing(
     const WordsFileLine& line,
     ad_utility::HashMap<WordIndex, Score>& wordsInContext,
-    ScoreData& scoreData) const {
+    const ScoreData& scoreData) const {
   // TODO<joka921> Let the `textVocab_` return a `WordIndex` directly.
   WordVocabIndex vid;
   bool ret = textVocab_.getId(line.word_, &vid);
@@ -244,7 +316,7 @@ void TextIndexBuilder::logEntityNotFound(const std::string& word,
 
 // _____________________________________________________________________________
 void TextIndexBuilder::addContextToVector(
-    TextVec& vec, TextRecordIndex context,
+    std::vector<std::array<Id, 5>>& entries, TextRecordIndex context,
     const ad_utility::HashMap<WordIndex, Score>& words,
     const ad_utility::HashMap<Id, Score>& entities) const {
   // Determine blocks for each word and each entity.
@@ -253,10 +325,11 @@ void TextIndexBuilder::addContextToVector(
   ql::ranges::for_each(words, [&](const auto& word) {
     TextBlockIndex blockId = getWordBlockId(word.first);
     touchedBlocks.insert(blockId);
-    vec.push(std::array{Id::makeFromInt(blockId), Id::makeFromBool(false),
-                        Id::makeFromInt(context.get()),
-                        Id::makeFromInt(word.first),
-                        Id::makeFromDouble(word.second)});
+    entries.push_back(std::array{Id::makeFromInt(blockId),
+                                 Id::makeFromBool(false),
+                                 Id::makeFromInt(context.get()),
+                                 Id::makeFromInt(word.first),
+                                 Id::makeFromDouble(word.second)});
   });
 
   // All entities have to be written in the entity list part for each block.
@@ -267,10 +340,11 @@ void TextIndexBuilder::addContextToVector(
   for (TextBlockIndex blockId : touchedBlocks) {
     for (auto it = entities.begin(); it != entities.end(); ++it) {
       AD_CONTRACT_CHECK(it->first.getDatatype() == Datatype::VocabIndex);
-      vec.push(std::array{Id::makeFromInt(blockId), Id::makeFromBool(true),
-                          Id::makeFromInt(context.get()),
-                          Id::makeFromInt(it->first.getVocabIndex().get()),
-                          Id::makeFromDouble(it->second)});
+      entries.push_back(
+          std::array{Id::makeFromInt(blockId), Id::makeFromBool(true),
+                     Id::makeFromInt(context.get()),
+                     Id::makeFromInt(it->first.getVocabIndex().get()),
+                     Id::makeFromDouble(it->second)});
     }
   }
 }
@@ -500,21 +574,7 @@ void TextIndexBuilder::calculateBlockBoundaries() {
 void TextIndexBuilder::buildDocsDB(const std::string& docsFileName) const {
   AD_LOG_INFO << "Building DocsDB...\n";
   std::ifstream docsFile = ad_utility::makeIfstream(docsFileName);
-  std::ofstream ofs = ad_utility::makeOfstream(onDiskBase_ + ".text.docsDB");
-  // To avoid excessive use of RAM, we stream the offsets into a temporary file
-  // and append them to the end of the docsDB file once all text records have
-  // been written.
-  std::filesystem::path offsetsFilename = onDiskBase_ + ".text.docsDB.tmp";
-  absl::Cleanup deleteOffsetsFile{[&offsetsFilename]() {
-    ad_utility::deleteFile(offsetsFilename, /*warnOnFailure=*/false);
-  }};
-  std::ofstream offsets =
-      ad_utility::makeOfstream(offsetsFilename, std::ios::binary);
-  auto writeOffset = [&offsets](off_t offset) {
-    offsets.write(reinterpret_cast<const char*>(&offset), sizeof(off_t));
-  };
-  off_t currentOffset = 0;
-  uint64_t currentContextId = 0;
+  DocsDB::Writer writer{onDiskBase_ + ".text.docsDB"};
   std::string line;
   line.reserve(BUFFER_SIZE_DOCSFILE_LINE);
   while (std::getline(docsFile, line)) {
@@ -525,23 +585,9 @@ void TextIndexBuilder::buildDocsDB(const std::string& docsFileName) const {
     std::from_chars(lineView.data(), lineView.data() + tab, contextId);
     // Set lineView to the docText
     lineView = lineView.substr(tab + 1);
-    ofs << lineView;
-    while (currentContextId < contextId) {
-      writeOffset(currentOffset);
-      currentContextId++;
-    }
-    writeOffset(currentOffset);
-    currentContextId++;
-    currentOffset += static_cast<off_t>(lineView.size());
+    writer.push(TextRecordIndex::make(contextId), lineView);
   }
-  writeOffset(currentOffset);
-  // Append the offsets stored in the temporary file to the docsDB file. We
-  // always wrote at least one offset above, so the temporary file is never
-  // empty (which would otherwise set the failbit on `rdbuf` insertion).
-  offsets.close();
-  std::ifstream offsetsIn =
-      ad_utility::makeIfstream(offsetsFilename, std::ios::binary);
-  ofs << offsetsIn.rdbuf();
+  writer.finish();
   AD_LOG_INFO << "DocsDB done.\n";
 }
 
@@ -37,6 +37,9 @@ class TextIndexBuilder : public IndexImpl {
   size_t processWordsForVocabulary(const std::string& contextFile,
                                    bool addWordsFromLiterals);
 
+  // Build the postings of all the text records and add them to the `vec`. The
+  // text records are processed in batches in parallel, see
+  // `processBatchOfTextRecords`.
   void processWordsForInvertedLists(const std::string& contextFile,
                                     bool addWordsFromLiterals, TextVec& vec);
 
@@ -49,20 +52,51 @@ class TextIndexBuilder : public IndexImpl {
   cppcoro::generator<WordsFileLine> wordsInTextRecords(
       std::string contextFile, bool addWordsFromLiterals) const;
 
+  // The lines of `wordsInTextRecords` in batches of (approximately)
+  // `BATCH_SIZE_TEXT_INDEX_BUILDING` lines. A batch only ends where the
+  // context changes, s.t. the lines of a text record are never split between
+  // two batches.
+  cppcoro::generator<std::vector<WordsFileLine>> batchesOfTextRecords(
+      std::string contextFile, bool addWordsFromLiterals) const;
+
+  // The entries of the `TextVec` for a batch of text records, together with
+  // the statistics of the batch.
+  struct PostingsOfTextRecords {
+    std::vector<std::array<Id, 5>> entries_;
+    // The context of the first line of the batch.
+    TextRecordIndex firstContext_ = TextRecordIndex::make(0);
+    // The number of times that the context changes within the batch (counting
+    // the first line of the batch as a change).
+    size_t numContextChanges_ = 0;
+    size_t nofWordPostings_ = 0;
+    size_t nofEntityPostings_ = 0;
+    size_t nofLiterals_ = 0;
+    // The number of entity mentions that were not found in the vocabulary,
+    // and the first few of them (for logging).
+    size_t nofEntitiesNotFound_ = 0;
+    std::vector<std::string> entitiesNotFound_;
+  };
+
+  // Compute the postings of a single batch, see `batchesOfTextRecords`. This
+  // function is thread-safe.
+  PostingsOfTextRecords processBatchOfTextRecords(
+      const std::vector<WordsFileLine>& batch) const;
+
   void processEntityCaseDuringInvertedListProcessing(
       const WordsFileLine& line,
-      ad_utility::HashMap<Id, Score>& entitiesInContxt, size_t& nofLiterals,
-      size_t& entityNotFoundErrorMsgCount) const;
+      ad_utility::HashMap<Id, Score>& entitiesInContext,
+      PostingsOfTextRecords& postings) const;
 
   void processWordCaseDuringInvertedListProcessing(
       const WordsFileLine& line,
       ad_utility::HashMap<WordIndex, Score>& wordsInContext,
-      ScoreData& scoreData) const;
+      const ScoreData& scoreData) const;
 
   static void logEntityNotFound(const std::string& word,
                                 size_t& entityNotFoundErrorMsgCount);
 
-  void addContextToVector(TextVec& vec, TextRecordIndex context,
+  void addContextToVector(std::vector<std::array<Id, 5>>& entries,
+                          TextRecordIndex context,
                           const ad_utility::HashMap<WordIndex, Score>& words,
                           const ad_utility::HashMap<Id, Score>& entities) const;
 
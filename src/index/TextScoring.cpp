@@ -65,12 +65,12 @@ void ScoreData::calculateScoreData(const std::string& docsFileName,
         << wordsNotFoundFromDocuments << std::endl;
   }
   size_t wordsNotFoundFromLiterals = 0;
-  for (VocabIndex index = VocabIndex::make(0); index.get() < vocab.size();
+  // All the literals start with a quote, so they form a single range of the
+  // vocabulary, and the IRIs don't have to be decoded.
+  auto [begin, end] = vocab.prefixRanges("\"").ranges()[0];
+  for (VocabIndex index = begin; index.get() < end.get();
        index = index.incremented()) {
     auto text = vocab[index];
-    if (!vocab.isLiteral(index)) {
-      continue;
-    }
     // Reset parameters for loop
     docId = docId.incremented();
     std::string_view textView = text;
@@ -110,7 +110,8 @@ void ScoreData::addDocumentOrLiteralToScoreDataInvertedIndex(
 }
 
 // ____________________________________________________________________________
-float ScoreData::getScore(WordIndex wordIndex, TextRecordIndex contextId) {
+float ScoreData::getScore(WordIndex wordIndex,
+                          TextRecordIndex contextId) const {
   AD_CORRECTNESS_CHECK(!(scoringMetric_ == TextScoringMetric::EXPLICIT),
                        "This method shouldn't be called for explicit scores.");
   // Retrieve inner map
@@ -120,8 +121,7 @@ float ScoreData::getScore(WordIndex wordIndex, TextRecordIndex contextId) {
                  << wordIndex << std::endl;
     return 0;
   }
-  calculateAVDL();
-  InnerMap& innerMap = it->second;
+  const InnerMap& innerMap = it->second;
   size_t df = innerMap.size();
   float idf = std::log2f(static_cast<float>(nofDocuments_) / df);
 
@@ -169,7 +169,7 @@ float ScoreData::getScore(WordIndex wordIndex, TextRecordIndex contextId) {
       " This hints on faulty input data for wordsfile.tsv and or docsfile.tsv");
   size_t dl = ret2->second;
   float alpha =
-      (1 - b_ + b_ * (static_cast<float>(dl) / averageDocumentLength_));
+      (1 - b_ + b_ * (static_cast<float>(dl) / averageDocumentLength()));
   float tfStar = (static_cast<float>(tf) * (k_ + 1)) /
                  (k_ * alpha + static_cast<float>(tf));
   return tfStar * idf;
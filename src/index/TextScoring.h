@@ -31,8 +31,8 @@ class ScoreData {
 
   TextScoringMetric getScoringMetric() const { return scoringMetric_; }
 
-  // Retrieves score from filled InvertedIndex
-  float getScore(WordIndex wordIndex, TextRecordIndex contextId);
+  // Retrieves score from filled InvertedIndex. This function is thread-safe.
+  float getScore(WordIndex wordIndex, TextRecordIndex contextId) const;
 
   // Parses docsFile and if true literals to fill the InvertedIndex and the
   // extra values needed to calculate scores
@@ -65,7 +65,6 @@ class ScoreData {
   // Values needed to calculate tf-idf and bm25
   size_t nofDocuments_ = 0;
   size_t totalDocumentLength_ = 0;
-  float averageDocumentLength_;
 
   // Used to fill the InvertedIndex given a document (or literal), the docId
   // and the current TextVocab
@@ -73,11 +72,10 @@ class ScoreData {
       std::string_view text, DocumentIndex docId,
       const Index::TextVocab& textVocab, size_t& wordNotFoundErrorMsgCount);
 
-  void calculateAVDL() {
-    averageDocumentLength_ = nofDocuments_
-                                 ? (static_cast<float>(totalDocumentLength_) /
-                                    static_cast<float>(nofDocuments_))
-                                 : 0;
+  float averageDocumentLength() const {
+    return nofDocuments_ ? (static_cast<float>(totalDocumentLength_) /
+                            static_cast<float>(nofDocuments_))
+                         : 0;
   }
 };
 
@@ -0,0 +1,104 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#include "index/VocabDecodeCache.h"
+
+#include <numeric>
+
+#include "global/RuntimeParameters.h"
+#include "index/IndexImpl.h"
+
+using ad_utility::MemorySize;
+
+// _____________________________________________________________________________
+VocabDecodeCache::VocabDecodeCache(MemorySize maxSize)
+    : cache_{ad_utility::size_t_max, maxSize, maxSize},
+      isEnabled_{maxSize.getBytes() > 0} {}
+
+// _____________________________________________________________________________
+std::unique_ptr<VocabDecodeCache> VocabDecodeCache::makeFromRuntimeParameter() {
+  return std::make_unique<VocabDecodeCache>(
+      getRuntimeParameter<&RuntimeParameters::vocabDecodeCacheMaxSize_>());
+}
+
+// _____________________________________________________________________________
+auto VocabDecodeCache::getOrDecode(const IndexImpl& index,
+                                   VocabIndex vocabIndex) -> WordPtr {
+  auto decode = [&index, vocabIndex]() {
+    return std::string(index.indexToString(vocabIndex));
+  };
+  if (!isEnabled()) {
+    return std::make_shared<const std::string>(decode());
+  }
+  if (auto word = (*cache_.wlock())[vocabIndex.get()]) {
+    ++numHits_;
+    return word;
+  }
+  ++numMisses_;
+  // The word is decoded without holding the lock. If it has been inserted
+  // concurrently by another thread, the cached word is returned. If the word
+  // is too large to be cached, it is returned without being inserted.
+  auto word = std::make_shared<std::string>(decode());
+  auto lock = cache_.wlock();
+  if (auto cached = (*lock)[vocabIndex.get()]) {
+    return cached;
+  }
+  lock->insert(vocabIndex.get(), word);
+  return word;
+}
+
+// _____________________________________________________________________________
+auto VocabDecodeCache::getOrDecode(const IndexImpl& index,
+                                   ql::span<const VocabIndex> vocabIndices)
+    -> std::vector<WordPtr> {
+  std::vector<WordPtr> result(vocabIndices.size());
+  std::vector<VocabIndex> missingIndices;
+  std::vector<size_t> missingPositions;
+  if (isEnabled()) {
+    auto lock = cache_.wlock();
+    for (size_t i = 0; i < vocabIndices.size(); ++i) {
+      result[i] = (*lock)[vocabIndices[i].get()];
+      if (result[i] == nullptr) {
+        missingIndices.push_back(vocabIndices[i]);
+        missingPositions.push_back(i);
+      }
+    }
+  } else {
+    missingIndices.assign(vocabIndices.begin(), vocabIndices.end());
+    missingPositions.resize(vocabIndices.size());
+    std::iota(missingPositions.begin(), missingPositions.end(), 0);
+  }
+  numHits_ += vocabIndices.size() - missingIndices.size();
+  numMisses_ += isEnabled() ? missingIndices.size() : 0;
+
+  // Decode the missing words without holding the lock.
+  auto words = index.indicesToStrings(missingIndices);
+  std::vector<std::shared_ptr<std::string>> decodedWords;
+  decodedWords.reserve(words.size());
+  for (size_t i = 0; i < words.size(); ++i) {
+    decodedWords.push_back(std::make_shared<std::string>(std::move(words[i])));
+    result[missingPositions[i]] = decodedWords.back();
+  }
+  if (isEnabled()) {
+    auto lock = cache_.wlock();
+    for (size_t i = 0; i < missingIndices.size(); ++i) {
+      // The same index may be missing multiple times, or the word may have
+      // been inserted concurrently by another thread.
+      if (!lock->contains(missingIndices[i].get())) {
+        lock->insert(missingIndices[i].get(), decodedWords[i]);
+      }
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+auto VocabDecodeCache::getStatistics() const -> Statistics {
+  Statistics result;
+  result.numHits_ = numHits_;
+  result.numMisses_ = numMisses_;
+  auto lock = cache_.rlock();
+  result.numEntries_ = lock->numNonPinnedEntries();
+  result.size_ = lock->nonPinnedSize();
+  return result;
+}
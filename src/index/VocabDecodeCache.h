@@ -0,0 +1,76 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_INDEX_VOCABDECODECACHE_H
+#define QLEVER_SRC_INDEX_VOCABDECODECACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "backports/span.h"
+#include "global/VocabIndex.h"
+#include "util/Cache.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+class IndexImpl;
+
+// A size-bounded LRU cache of decoded vocabulary words. There is one cache
+// per query (see `QueryExecutionContext::vocabDecodeCache`), which is shared
+// by the expression evaluation and the export. That way, words that are used
+// many times by a query (for example, the same language-tagged labels in
+// repeated `LANG()`, `STR()`, or `STRLEN()` calls) are only read from disk
+// and decompressed once. The cache is thread-safe.
+class VocabDecodeCache {
+ public:
+  using WordPtr = std::shared_ptr<const std::string>;
+
+  // The statistics that are reported in the runtime information of a query.
+  struct Statistics {
+    size_t numHits_ = 0;
+    size_t numMisses_ = 0;
+    size_t numEntries_ = 0;
+    ad_utility::MemorySize size_;
+  };
+
+ private:
+  struct WordSizeGetter {
+    ad_utility::MemorySize operator()(const std::string& word) const {
+      return ad_utility::MemorySize::bytes(sizeof(std::string) + word.size());
+    }
+  };
+  using Cache =
+      ad_utility::HeapBasedLRUCache<uint64_t, std::string, WordSizeGetter>;
+
+  ad_utility::Synchronized<Cache> cache_;
+  // A cache with a maximum size of zero is disabled, in this case we don't
+  // even acquire the lock of the `cache_`.
+  bool isEnabled_;
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+
+ public:
+  explicit VocabDecodeCache(ad_utility::MemorySize maxSize);
+
+  // Create a cache with the maximal size that is given by the runtime
+  // parameter `vocab-decode-cache-max-size`.
+  static std::unique_ptr<VocabDecodeCache> makeFromRuntimeParameter();
+
+  bool isEnabled() const { return isEnabled_; }
+
+  // Return the word with the given `vocabIndex` from the vocabulary of the
+  // `index`. The word is decoded and inserted if it is not yet contained.
+  WordPtr getOrDecode(const IndexImpl& index, VocabIndex vocabIndex);
+
+  // Bulk version of the above function, the words that are not yet contained
+  // are decoded with a single call to `IndexImpl::indicesToStrings`.
+  std::vector<WordPtr> getOrDecode(const IndexImpl& index,
+                                   ql::span<const VocabIndex> vocabIndices);
+
+  Statistics getStatistics() const;
+};
+
+#endif  // QLEVER_SRC_INDEX_VOCABDECODECACHE_H
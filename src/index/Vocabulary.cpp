@@ -8,12 +8,14 @@
 #include "index/Vocabulary.h"
 
 #include <iostream>
+#include <iterator>
 
 #include "backports/StartsWithAndEndsWith.h"
 #include "index/ConstantsIndexBuilding.h"
 #include "index/vocabulary/PolymorphicVocabulary.h"
 #include "index/vocabulary/SplitVocabulary.h"
 #include "rdfTypes/GeometryInfo.h"
+#include "util/Algorithm.h"
 #include "util/Exception.h"
 #include "util/TypeTraits.h"
 
@@ -253,6 +255,28 @@ bool Vocabulary<S, C, I>::isGeoInfoAvailable() const {
   }
 };
 
+// _____________________________________________________________________________
+template <typename S, typename C, typename I>
+auto Vocabulary<S, C, I>::getIndexRangesForLanguageTag(
+    std::string_view languageTag) const
+    -> std::optional<std::vector<std::pair<IndexType, IndexType>>> {
+  if constexpr (std::is_same_v<S, PolymorphicVocabulary>) {
+    auto ranges =
+        vocabulary_.getUnderlyingVocabulary().getIndexRangesForLanguageTag(
+            languageTag);
+    if (!ranges.has_value()) {
+      return std::nullopt;
+    }
+    return ad_utility::transform(ranges.value(), [](const auto& range) {
+      return std::pair{IndexType::make(range.first),
+                       IndexType::make(range.second)};
+    });
+  } else {
+    (void)languageTag;
+    return std::nullopt;
+  }
+}
+
 // _____________________________________________________________________________
 template <typename S, typename ComparatorType, typename I>
 void Vocabulary<S, ComparatorType, I>::setLocale(const std::string& language,
@@ -298,6 +322,18 @@ auto Vocabulary<UnderlyingVocabulary, C, I>::operator[](IndexType idx) const
   return vocabulary_[idx.get()];
 }
 
+// _____________________________________________________________________________
+template <typename U, typename C, typename I>
+std::vector<std::string> Vocabulary<U, C, I>::lookupMany(
+    ql::span<const IndexType> indices) const {
+  std::vector<uint64_t> rawIndices;
+  rawIndices.reserve(indices.size());
+  ql::ranges::transform(indices, std::back_inserter(rawIndices),
+                        [](IndexType idx) { return idx.get(); });
+  return ad_utility::vocabulary::lookupMany(
+      vocabulary_, ql::span<const uint64_t>{rawIndices});
+}
+
 // Explicit template instantiations
 template class Vocabulary<detail::UnderlyingVocabRdfsVocabulary,
                           TripleComponentComparator, VocabIndex>;
@@ -119,6 +119,13 @@ class Vocabulary {
   // in the vocabulary.
   AccessReturnType operator[](IndexType idx) const;
 
+  // Get the words for all the `indices` (in the same order). The indices may
+  // be unsorted and contain duplicates, they are sorted and deduplicated
+  // internally, s.t. the underlying vocabulary can read (and decompress) the
+  // words in a single pass, which is much faster than calling `operator[]`
+  // for each index if the vocabulary is stored on disk.
+  std::vector<std::string> lookupMany(ql::span<const IndexType> indices) const;
+
   //! Get the number of words in the vocabulary.
   [[nodiscard]] size_t size() const { return vocabulary_.size(); }
 
@@ -144,6 +151,14 @@ class Vocabulary {
   // available.
   bool isGeoInfoAvailable() const;
 
+  // If the literals with a language tag are stored in their own partitions of
+  // the vocabulary (see `SplitLanguageVocabulary`), return the half-open
+  // ranges of the indices of the partitions that contain all the literals with
+  // the `languageTag` (`*` for all the literals with a language tag). Return
+  // `std::nullopt` if there is no such partitioning.
+  std::optional<std::vector<std::pair<IndexType, IndexType>>>
+  getIndexRangesForLanguageTag(std::string_view languageTag) const;
+
   // Get the index range for the given prefix or `std::nullopt` if no word with
   // the given prefix exists in the vocabulary.
   //
@@ -6,6 +6,7 @@
 #define QLEVER_SRC_INDEX_VOCABULARYMERGERIMPL_H
 
 #include <future>
+#include <iterator>
 #include <string>
 #include <utility>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "util/HashMap.h"
 #include "util/InputRangeUtils.h"
 #include "util/Log.h"
+#include "util/ParallelExecutor.h"
 #include "util/ParallelMultiwayMerge.h"
 #include "util/ProgressBar.h"
 #include "util/Serializer/ByteBufferSerializer.h"
@@ -91,9 +93,18 @@ auto VocabularyMerger::mergeVocabulary(const std::string& basename,
           0.8 * memoryToUse, std::move(generators), lessThanForQueue);
   ad_utility::ProgressBar progressBar{metaData_.numWordsTotal(),
                                       "Words merged: "};
+  // The merge yields small blocks, which are collected into larger batches,
+  // s.t. they can be processed by multiple threads.
+  std::vector<QueueWord> batch;
+  batch.reserve(BATCH_SIZE_VOCABULARY_MERGING_OUTPUT);
   for (std::vector<QueueWord>& currentWords : mergedWords) {
-    writeQueueWordsToIdMap(currentWords, wordCallback, lessThan, progressBar);
+    ql::ranges::move(currentWords, std::back_inserter(batch));
+    if (batch.size() >= BATCH_SIZE_VOCABULARY_MERGING_OUTPUT) {
+      writeQueueWordsToIdMap(batch, wordCallback, lessThan, progressBar);
+      batch.clear();
+    }
   }
+  writeQueueWordsToIdMap(batch, wordCallback, lessThan, progressBar);
 
   AD_LOG_INFO << progressBar.getFinalProgressString() << std::flush;
 
@@ -113,11 +124,54 @@ CPP_template_def(typename C, typename L)(
                            ad_utility::ProgressBar& progressBar) {
   AD_LOG_TIMING << "Start writing a batch of merged words\n";
 
+  // Run `function(threadIndex)` for all the `threadIndex`es in
+  // `[0, numThreads)` concurrently.
+  const size_t numThreads =
+      buffer.size() < MIN_BATCH_SIZE_FOR_PARALLEL_VOCABULARY_MERGING
+          ? 1
+          : NUM_THREADS_VOCABULARY_MERGING;
+  auto runInParallel = [numThreads](const auto& function) {
+    if (numThreads == 1) {
+      function(0);
+      return;
+    }
+    std::vector<std::packaged_task<void()>> tasks;
+    for (size_t threadIndex : ad_utility::integerRange(numThreads)) {
+      tasks.emplace_back([&function, threadIndex]() { function(threadIndex); });
+    }
+    ad_utility::runTasksInParallel(std::move(tasks));
+  };
+
+  // Check the order of the words in the `buffer`. The (expensive) comparisons
+  // of neighboring words are split between the threads. The first word is
+  // compared to the last word of the previous batch below.
+  auto checkOrder = [&buffer, &lessThan, numThreads](size_t threadIndex) {
+    const size_t chunkSize = buffer.size() / numThreads + 1;
+    const size_t begin = std::max(size_t{1}, threadIndex * chunkSize);
+    const size_t end = std::min(buffer.size(), (threadIndex + 1) * chunkSize);
+    for (size_t i = begin; i < end; ++i) {
+      const auto& previous = buffer[i - 1];
+      const auto& current = buffer[i];
+      if (previous.iriOrLiteral() != current.iriOrLiteral()) {
+        AD_CORRECTNESS_CHECK(lessThan(previous.entry_, current.entry_),
+                             "Total vocabulary order violated for ",
+                             previous.iriOrLiteral(), " and ",
+                             current.iriOrLiteral());
+      }
+    }
+  };
+  runInParallel(checkOrder);
+
+  // The global IDs of the words in the `buffer`. These have to be assigned in
+  // order by a single thread, because the `wordCallback` has to be called in
+  // order.
+  std::vector<Id> targetIds(buffer.size(), Id::makeUndefined());
   // Iterate (avoid duplicates).
-  for (auto& top : buffer) {
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    auto& top = buffer[i];
     if (!lastTripleComponent_.has_value() ||
         top.iriOrLiteral() != lastTripleComponent_.value().iriOrLiteral()) {
-      if (lastTripleComponent_.has_value()) {
+      if (lastTripleComponent_.has_value() && i == 0) {
         AD_CORRECTNESS_CHECK(lessThan(lastTripleComponent_.value(), top.entry_),
                              "Total vocabulary order violated for ",
                              lastTripleComponent_->iriOrLiteral(), " and ",
@@ -150,14 +204,27 @@ CPP_template_def(typename C, typename L)(
       external = external || top.isExternal();
     }
     const auto& word = lastTripleComponent_.value();
-    Id targetId =
+    targetIds[i] =
         word.isBlankNode()
             ? Id::makeFromBlankNodeIndex(BlankNodeIndex::make(word.index_))
             : Id::makeFromVocabIndex(VocabIndex::make(word.index_));
-    // Write pair of local and global ID to buffer.
-    idMaps_[top.partialFileId_].push_back(
-        {Id::makeFromVocabIndex(VocabIndex::make(top.id())), targetId});
   }
+
+  // Write the pairs of local and global IDs to the `idMaps_`. Each thread
+  // writes to a disjoint subset of the `idMaps_`, and the pairs for a single
+  // `idMap` are written in order.
+  auto writeIdMaps = [this, &buffer, &targetIds,
+                      numThreads](size_t threadIndex) {
+    for (size_t i = 0; i < buffer.size(); ++i) {
+      const auto& top = buffer[i];
+      if (top.partialFileId_ % numThreads != threadIndex) {
+        continue;
+      }
+      idMaps_[top.partialFileId_].push_back(
+          {Id::makeFromVocabIndex(VocabIndex::make(top.id())), targetIds[i]});
+    }
+  };
+  runInParallel(writeIdMaps);
 }
 
 // ____________________________________________________________________________________________________________
@@ -175,8 +242,8 @@ inline HashMap<uint64_t, uint64_t> createInternalMapping(ItemVec& els) {
     }
     auto inserted = res.try_emplace(id, nextWordId).second;
     AD_CORRECTNESS_CHECK(inserted);
-    idAndExternal = PartialVocabIndexWithExternalFlag{
-        nextWordId, idAndExternal.isExternal()};
+    idAndExternal = PartialVocabEntry{nextWordId, idAndExternal.isExternal(),
+                                      idAndExternal.sortKey_};
   }
   return res;
 }
@@ -0,0 +1,193 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/VocabularyNgramIndex.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#include "util/Exception.h"
+#include "util/Log.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeVector.h"
+
+// _____________________________________________________________________________
+auto VocabularyNgramIndex::getDistinctNgrams(std::string_view text)
+    -> std::vector<Ngram> {
+  std::vector<Ngram> ngrams;
+  if (text.size() < NGRAM_SIZE) {
+    return ngrams;
+  }
+  ngrams.reserve(text.size() - NGRAM_SIZE + 1);
+  for (size_t i = 0; i + NGRAM_SIZE <= text.size(); ++i) {
+    auto byte = [&text, i](size_t j) {
+      return static_cast<Ngram>(static_cast<unsigned char>(text[i + j]));
+    };
+    ngrams.push_back(byte(0) << 16 | byte(1) << 8 | byte(2));
+  }
+  std::sort(ngrams.begin(), ngrams.end());
+  ngrams.erase(std::unique(ngrams.begin(), ngrams.end()), ngrams.end());
+  return ngrams;
+}
+
+// _____________________________________________________________________________
+void VocabularyNgramIndex::build(const ForEachLiteral& forEachLiteral,
+                                 const std::string& filename) {
+  // The first pass counts the sizes of the posting lists.
+  ad_utility::HashMap<Ngram, uint64_t> sizes;
+  size_t numLiterals = 0;
+  forEachLiteral([&sizes, &numLiterals](uint64_t, std::string_view content,
+                                        bool hasDatatype) {
+    for (auto ngram : getDistinctNgrams(content)) {
+      ++sizes[ngram];
+    }
+    if (hasDatatype) {
+      ++sizes[LITERALS_WITH_DATATYPE];
+    }
+    ++numLiterals;
+  });
+
+  std::vector<Ngram> ngrams;
+  ngrams.reserve(sizes.size());
+  for (const auto& [ngram, size] : sizes) {
+    ngrams.push_back(ngram);
+  }
+  std::sort(ngrams.begin(), ngrams.end());
+  // From now on, `positions` contains the position in the `postings` where
+  // the next index is written for each ngram.
+  auto& positions = sizes;
+  std::vector<uint64_t> offsets;
+  offsets.reserve(ngrams.size() + 1);
+  offsets.push_back(0);
+  for (auto ngram : ngrams) {
+    auto size = sizes.at(ngram);
+    positions.at(ngram) = offsets.back();
+    offsets.push_back(offsets.back() + size);
+  }
+
+  // The second pass writes the posting lists. The literals are enumerated in
+  // ascending order, so the posting lists are sorted.
+  {
+    ad_utility::MmapVector<uint64_t> postings{offsets.back(),
+                                              filename + ".postings"};
+    forEachLiteral([&positions, &postings](uint64_t index,
+                                           std::string_view content,
+                                           bool hasDatatype) {
+      for (auto ngram : getDistinctNgrams(content)) {
+        postings[positions.at(ngram)++] = index;
+      }
+      if (hasDatatype) {
+        postings[positions.at(LITERALS_WITH_DATATYPE)++] = index;
+      }
+    });
+  }
+  // Both passes have to enumerate the same literals.
+  for (size_t i = 0; i < ngrams.size(); ++i) {
+    AD_CORRECTNESS_CHECK(positions.at(ngrams[i]) == offsets[i + 1]);
+  }
+
+  ad_utility::serialization::FileWriteSerializer writer{filename};
+  writer << ngrams;
+  writer << offsets;
+  AD_LOG_INFO << "Number of literals in the n-gram index: " << numLiterals
+              << ", number of distinct n-grams: " << ngrams.size()
+              << std::endl;
+}
+
+// _____________________________________________________________________________
+void VocabularyNgramIndex::readFromFile() const {
+  if (!filename_.has_value()) {
+    return;
+  }
+  if (!std::filesystem::exists(filename_.value())) {
+    AD_LOG_DEBUG << "No n-gram index of the vocabulary found (file "
+                 << filename_.value()
+                 << "), substring filters have to check all the literals"
+                 << std::endl;
+    return;
+  }
+  ad_utility::serialization::FileReadSerializer reader{filename_.value()};
+  reader >> ngrams_;
+  reader >> offsets_;
+  postings_.open(filename_.value() + ".postings");
+  AD_CORRECTNESS_CHECK(offsets_.size() == ngrams_.size() + 1);
+  AD_CORRECTNESS_CHECK(offsets_.back() == postings_.size());
+  isAvailable_ = true;
+  AD_LOG_DEBUG << "Read the n-gram index of the vocabulary with "
+               << ngrams_.size() << " distinct n-grams" << std::endl;
+}
+
+// _____________________________________________________________________________
+ql::span<const uint64_t> VocabularyNgramIndex::getPostingList(
+    Ngram ngram) const {
+  auto it = std::lower_bound(ngrams_.begin(), ngrams_.end(), ngram);
+  if (it == ngrams_.end() || *it != ngram) {
+    return {};
+  }
+  auto i = static_cast<size_t>(it - ngrams_.begin());
+  return {postings_.data() + offsets_[i], offsets_[i + 1] - offsets_[i]};
+}
+
+// _____________________________________________________________________________
+auto VocabularyNgramIndex::getCandidates(std::string_view substring) const
+    -> std::shared_ptr<const VocabIndices> {
+  std::call_once(isLoaded_, [this]() { readFromFile(); });
+  if (!isAvailable_ || substring.size() < NGRAM_SIZE) {
+    return nullptr;
+  }
+  std::string key{substring};
+  {
+    std::lock_guard lock{cacheMutex_};
+    if (auto it = cachedCandidates_.find(key); it != cachedCandidates_.end()) {
+      return it->second;
+    }
+  }
+
+  // Intersect the posting lists, starting with the shortest one. The
+  // candidates are only a few in the typical case, so they are looked up in
+  // the longer lists via binary search.
+  std::vector<ql::span<const uint64_t>> postingLists;
+  for (auto ngram : getDistinctNgrams(substring)) {
+    postingLists.push_back(getPostingList(ngram));
+  }
+  std::sort(postingLists.begin(), postingLists.end(),
+            [](const auto& a, const auto& b) { return a.size() < b.size(); });
+  auto candidates = std::make_shared<VocabIndices>(postingLists[0].begin(),
+                                                   postingLists[0].end());
+  for (size_t i = 1; i < postingLists.size() && !candidates->empty(); ++i) {
+    const auto& list = postingLists[i];
+    auto it = list.begin();
+    size_t numKept = 0;
+    for (auto candidate : *candidates) {
+      it = std::lower_bound(it, list.end(), candidate);
+      if (it == list.end()) {
+        break;
+      }
+      if (*it == candidate) {
+        (*candidates)[numKept++] = candidate;
+      }
+    }
+    candidates->resize(numKept);
+  }
+
+  std::lock_guard lock{cacheMutex_};
+  if (cachedCandidates_.size() >= MAX_NUM_CACHED_CANDIDATES) {
+    cachedCandidates_.clear();
+  }
+  cachedCandidates_.emplace(std::move(key), candidates);
+  return candidates;
+}
+
+// _____________________________________________________________________________
+bool VocabularyNgramIndex::hasDatatype(uint64_t vocabIndex) const {
+  AD_CONTRACT_CHECK(isAvailable_);
+  auto literalsWithDatatype = getPostingList(LITERALS_WITH_DATATYPE);
+  return std::binary_search(literalsWithDatatype.begin(),
+                            literalsWithDatatype.end(), vocabIndex);
+}
@@ -0,0 +1,108 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_VOCABULARYNGRAMINDEX_H
+#define QLEVER_SRC_INDEX_VOCABULARYNGRAMINDEX_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "backports/span.h"
+#include "util/HashMap.h"
+#include "util/MmapVector.h"
+
+// An optional index of the trigrams (three consecutive bytes) of the contents
+// of the literals in the vocabulary. For each trigram it stores the sorted
+// indices of the literals that contain it. A literal can only contain a
+// substring of length at least three if it contains all the trigrams of the
+// substring, so the index yields a (typically small) set of candidates for
+// substring filters like `CONTAINS` and `REGEX`. The candidates still have
+// to be verified, but all the other literals don't have to be decoded.
+//
+// The index consists of two files, the sorted trigrams with the offsets of
+// their posting lists (which is read into memory on the first access), and
+// the posting lists themselves (which are memory-mapped).
+class VocabularyNgramIndex {
+ public:
+  using Ngram = uint32_t;
+  using VocabIndices = std::vector<uint64_t>;
+  static constexpr size_t NGRAM_SIZE = 3;
+  // The results of at most this many substrings are cached, s.t. the blocks
+  // of a lazy evaluation don't intersect the posting lists again.
+  static constexpr size_t MAX_NUM_CACHED_CANDIDATES = 64;
+
+  // Called with the vocabulary index, the content, and whether the literal
+  // has a datatype, for each literal in ascending order of the indices.
+  using LiteralCallback =
+      std::function<void(uint64_t, std::string_view, bool)>;
+  using ForEachLiteral = std::function<void(const LiteralCallback&)>;
+
+ private:
+  // The posting list of this key contains the literals with a datatype,
+  // which are needed to determine the value of a string function for a
+  // literal that is not a candidate. Trigrams only use the lower 24 bits.
+  static constexpr Ngram LITERALS_WITH_DATATYPE = ~Ngram{0};
+
+  std::optional<std::string> filename_;
+  // Lazily initialized on the first call to `getCandidates`.
+  mutable std::once_flag isLoaded_;
+  mutable bool isAvailable_ = false;
+  mutable std::vector<Ngram> ngrams_;
+  // The posting list of `ngrams_[i]` is `postings_[offsets_[i],
+  // offsets_[i + 1])`.
+  mutable std::vector<uint64_t> offsets_;
+  mutable ad_utility::MmapVectorView<uint64_t> postings_;
+
+  mutable std::mutex cacheMutex_;
+  mutable ad_utility::HashMap<std::string, std::shared_ptr<const VocabIndices>>
+      cachedCandidates_;
+
+ public:
+  // Build the index for the literals that are enumerated by `forEachLiteral`
+  // and write it to the `filename` (the posting lists to the `filename` with
+  // the suffix `.postings`). The literals are enumerated twice, first to count
+  // the sizes of the posting lists, and then to write them, s.t. the posting
+  // lists never have to be held in memory.
+  static void build(const ForEachLiteral& forEachLiteral,
+                    const std::string& filename);
+
+  // Set the file from which the index is (lazily) read. If this is never
+  // called, or the file doesn't exist (the index is optional),
+  // `getCandidates` always returns `nullptr`.
+  void setFilename(std::string filename) { filename_ = std::move(filename); }
+
+  // Return the sorted indices of all the literals in the vocabulary that
+  // possibly contain the `substring`. Return `nullptr` if the index is not
+  // available or the `substring` is shorter than `NGRAM_SIZE`, s.t. no
+  // literal can be ruled out. Thread-safe.
+  std::shared_ptr<const VocabIndices> getCandidates(
+      std::string_view substring) const;
+
+  // Return true iff the literal with the `vocabIndex` has a datatype. May only
+  // be called if `getCandidates` has returned a non-null result.
+  bool hasDatatype(uint64_t vocabIndex) const;
+
+  // Return the distinct trigrams of the `text` in ascending order.
+  static std::vector<Ngram> getDistinctNgrams(std::string_view text);
+
+ private:
+  void readFromFile() const;
+
+  // Return the posting list of the `ngram`, which is empty if no literal
+  // contains it.
+  ql::span<const uint64_t> getPostingList(Ngram ngram) const;
+};
+
+#endif  // QLEVER_SRC_INDEX_VOCABULARYNGRAMINDEX_H
@@ -58,6 +58,21 @@ CPP_template(typename UnderlyingVocabulary,
         toStringView(underlyingVocabulary_[idx]), getDecoderIdx(idx));
   }
 
+  // Get the uncompressed words at the `sortedIndices` (which must be sorted).
+  // The compressed words are retrieved from the underlying vocabulary in one
+  // bulk access, and as the indices are sorted, all the words that use the
+  // same decoder are decompressed consecutively.
+  std::vector<std::string> lookupSorted(
+      ql::span<const uint64_t> sortedIndices) const {
+    auto words = ad_utility::vocabulary::lookupSorted(underlyingVocabulary_,
+                                                      sortedIndices);
+    for (size_t i = 0; i < words.size(); ++i) {
+      words[i] = compressionWrapper_.decompress(
+          words[i], getDecoderIdx(sortedIndices[i]));
+    }
+    return words;
+  }
+
   [[nodiscard]] uint64_t size() const { return underlyingVocabulary_.size(); }
 
   // From a `comparator` that can compare two strings, make a new comparator,
@@ -0,0 +1,92 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_VOCABULARY_EXACTWORDINDEX_H
+#define QLEVER_SRC_INDEX_VOCABULARY_EXACTWORDINDEX_H
+
+#include <absl/hash/hash.h>
+#include <absl/numeric/bits.h>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "util/Exception.h"
+
+// A hash index from the words of an in-memory vocabulary to their positions,
+// s.t. looking up the position of a word that is contained in the vocabulary
+// (e.g. an IRI from a query or from an update) requires O(1) string
+// comparisons instead of O(log n) comparisons with the (expensive) ICU-aware
+// comparator. Looking up a word that is not contained has to fall back to a
+// binary search, because then the position where the word would be inserted is
+// required. The index doesn't store the words themselves, but only their
+// positions in an open-addressing hash table, so it requires about 16 bytes per
+// word. The words are passed to all the member functions and must not change
+// between `build` and `find`.
+class ExactWordIndex {
+ private:
+  // The position of the word plus one, `0` marks an empty slot.
+  std::vector<uint64_t> slots_;
+
+  static size_t hash(std::string_view word) {
+    return absl::Hash<std::string_view>{}(word);
+  }
+
+ public:
+  // Build the index for the `words` (a random-access range of strings). If a
+  // word occurs multiple times, the index contains its first position.
+  template <typename Words>
+  void build(const Words& words) {
+    clear();
+    const size_t numWords = words.size();
+    if (numWords == 0) {
+      return;
+    }
+    // A load factor of at most 1/2 keeps the probe sequences short.
+    slots_.resize(absl::bit_ceil(2 * numWords));
+    const size_t mask = slots_.size() - 1;
+    for (size_t position = 0; position < numWords; ++position) {
+      std::string_view word = words[position];
+      size_t slot = hash(word) & mask;
+      while (slots_[slot] != 0 &&
+             std::string_view{words[slots_[slot] - 1]} != word) {
+        slot = (slot + 1) & mask;
+      }
+      if (slots_[slot] == 0) {
+        slots_[slot] = position + 1;
+      }
+    }
+  }
+
+  // Return the position of the `word` in the `words` for which the index was
+  // built, or `std::nullopt` if the `word` is not contained.
+  template <typename Words>
+  std::optional<uint64_t> find(const Words& words,
+                               std::string_view word) const {
+    if (slots_.empty()) {
+      return std::nullopt;
+    }
+    const size_t mask = slots_.size() - 1;
+    for (size_t slot = hash(word) & mask; slots_[slot] != 0;
+         slot = (slot + 1) & mask) {
+      auto position = slots_[slot] - 1;
+      AD_EXPENSIVE_CHECK(position < words.size());
+      if (std::string_view{words[position]} == word) {
+        return position;
+      }
+    }
+    return std::nullopt;
+  }
+
+  // Remove all the entries.
+  void clear() { slots_.clear(); }
+};
+
+#endif  // QLEVER_SRC_INDEX_VOCABULARY_EXACTWORDINDEX_H
@@ -4,6 +4,7 @@
 
 #include "index/vocabulary/GeoVocabulary.h"
 
+#include <cstring>
 #include <stdexcept>
 
 #include "index/vocabulary/CompressedVocabulary.h"
@@ -20,27 +21,41 @@ template <typename V>
 void GeoVocabulary<V>::open(const std::string& filename) {
   literals_.open(filename);
 
-  geoInfoFile_.open(getGeoInfoFilename(filename).c_str(), "r");
+  const auto geoInfoFilename = getGeoInfoFilename(filename);
+  geoInfoFile_.map(geoInfoFilename);
 
   // Read header of `geoInfoFile_` to determine version
   std::decay_t<decltype(ad_utility::GEOMETRY_INFO_VERSION)> versionOfFile = 0;
-  geoInfoFile_.read(&versionOfFile, geoInfoHeader, 0);
+  if (geoInfoFile_.size() >= geoInfoHeader) {
+    std::memcpy(&versionOfFile, geoInfoFile_.data(), geoInfoHeader);
+  }
 
   // Check version of geo info file
   if (versionOfFile != ad_utility::GEOMETRY_INFO_VERSION) {
     throw std::runtime_error(absl::StrCat(
-        "The geometry info version of ", getGeoInfoFilename(filename), " is ",
+        "The geometry info version of ", geoInfoFilename, " is ",
         versionOfFile, ", which is incompatible with version ",
         ad_utility::GEOMETRY_INFO_VERSION,
         " as required by this version of QLever. Please rebuild your index."));
   }
+
+  // There has to be exactly one record per literal, otherwise the file is
+  // truncated or belongs to a different vocabulary.
+  const size_t expectedSize = geoInfoHeader + size() * geoInfoOffset;
+  if (geoInfoFile_.size() != expectedSize) {
+    throw std::runtime_error(absl::StrCat(
+        "The geometry info file ", geoInfoFilename, " has a size of ",
+        geoInfoFile_.size(), " bytes, but ", expectedSize,
+        " bytes are expected for ", size(),
+        " literals. Please rebuild your index."));
+  }
 };
 
 // ____________________________________________________________________________
 template <typename V>
 void GeoVocabulary<V>::close() {
   literals_.close();
-  geoInfoFile_.close();
+  geoInfoFile_.unmap();
 }
 
 // ____________________________________________________________________________
@@ -114,12 +129,12 @@ GeoVocabulary<V>::WordWriter::~WordWriter() {
 template <typename V>
 std::optional<GeometryInfo> GeoVocabulary<V>::getGeoInfo(uint64_t index) const {
   AD_CONTRACT_CHECK(index < size());
-  // Allocate the required number of bytes
-  std::array<uint8_t, geoInfoOffset> buffer;
-  void* ptr = &buffer;
-
-  // Read into the buffer
-  geoInfoFile_.read(ptr, geoInfoOffset, geoInfoHeader + index * geoInfoOffset);
+  // Copy the record from the memory-mapped file (the records are not
+  // necessarily aligned).
+  GeometryInfoBuffer buffer;
+  std::memcpy(buffer.data(),
+              geoInfoFile_.data() + geoInfoHeader + index * geoInfoOffset,
+              geoInfoOffset);
 
   // If all bytes are zero, this record on disk represents an invalid geometry.
   // The `GeometryInfo` class makes the guarantee that it can not have an
@@ -13,6 +13,7 @@
 #include "rdfTypes/GeometryInfo.h"
 #include "util/ExceptionHandling.h"
 #include "util/File.h"
+#include "util/ReadOnlyMappedFile.h"
 #include "util/Serializer/Serializer.h"
 
 // A `GeoVocabulary` holds Well-Known Text (WKT) literals. In contrast to the
@@ -30,10 +31,11 @@ class GeoVocabulary {
   UnderlyingVocabulary literals_;
 
   // The file in which the additional information on the geometries (like
-  // bounding box) is stored.
-  ad_utility::File geoInfoFile_;
-
-  // TODO<ullingerc> Possibly add in-memory cache of bounding boxes here
+  // bounding box) is stored. It is written when the index is built and
+  // memory-mapped when the vocabulary is opened, s.t. the spatial joins and the
+  // `geof:` functions can access the information without a system call per
+  // geometry and without the cost of loading it into memory at startup.
+  ad_utility::ReadOnlyMappedFile geoInfoFile_;
 
   // Filename suffix for geometry information file
   static constexpr std::string_view geoInfoSuffix = ".geoinfo";
@@ -33,6 +33,16 @@ std::string PolymorphicVocabulary::operator[](uint64_t i) const {
   return std::visit([i](auto& vocab) { return std::string{vocab[i]}; }, vocab_);
 }
 
+// _____________________________________________________________________________
+std::vector<std::string> PolymorphicVocabulary::lookupSorted(
+    ql::span<const uint64_t> sortedIndices) const {
+  return std::visit(
+      [sortedIndices](auto& vocab) {
+        return ad_utility::vocabulary::lookupSorted(vocab, sortedIndices);
+      },
+      vocab_);
+}
+
 // _____________________________________________________________________________
 auto PolymorphicVocabulary::makeDiskWriterPtr(const std::string& filename) const
     -> std::unique_ptr<WordWriterBase> {
@@ -68,6 +78,8 @@ void PolymorphicVocabulary::resetToType(VocabularyType type) {
     AD_CASE(InMemoryCompressed);
     AD_CASE(OnDiskCompressed);
     AD_CASE(OnDiskCompressedGeoSplit);
+    AD_CASE(OnDiskFrontCoded);
+    AD_CASE(OnDiskCompressedLanguageSplit);
     default:
       AD_FAIL();
   }
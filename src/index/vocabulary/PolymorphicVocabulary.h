@@ -15,6 +15,7 @@
 #include "index/vocabulary/CompressedVocabulary.h"
 #include "index/vocabulary/SplitVocabulary.h"
 #include "index/vocabulary/VocabularyConstraints.h"
+#include "index/vocabulary/VocabularyFrontCoded.h"
 #include "index/vocabulary/VocabularyInMemory.h"
 #include "index/vocabulary/VocabularyInternalExternal.h"
 #include "index/vocabulary/VocabularyType.h"
@@ -43,9 +44,13 @@ class PolymorphicVocabulary {
   using InMemoryCompressed = CompressedVocabulary<InMemoryUncompressed>;
   using OnDiskCompressed = CompressedVocabulary<OnDiskUncompressed>;
   using OnDiskCompressedGeoSplit = SplitGeoVocabulary<OnDiskCompressed>;
+  using OnDiskFrontCoded = VocabularyFrontCoded;
+  using OnDiskCompressedLanguageSplit =
+      SplitLanguageVocabulary<OnDiskCompressed>;
   using Variant =
       std::variant<InMemoryUncompressed, OnDiskUncompressed, OnDiskCompressed,
-                   InMemoryCompressed, OnDiskCompressedGeoSplit>;
+                   InMemoryCompressed, OnDiskCompressedGeoSplit,
+                   OnDiskFrontCoded, OnDiskCompressedLanguageSplit>;
 
   // In this variant we store the actual vocabulary.
   Variant vocab_;
@@ -73,6 +78,11 @@ class PolymorphicVocabulary {
   // Return the `i`-th word, throw if `i` is out of bounds.
   std::string operator[](uint64_t i) const;
 
+  // Return the words at the `sortedIndices` (which must be sorted), see
+  // `ad_utility::vocabulary::lookupSorted`.
+  std::vector<std::string> lookupSorted(
+      ql::span<const uint64_t> sortedIndices) const;
+
   // Return a reference to currently underlying vocabulary, as a variant of the
   // possible types.
   Variant& getUnderlyingVocabulary() { return vocab_; }
@@ -159,6 +169,25 @@ class PolymorphicVocabulary {
         vocab_);
   }
 
+  // If the literals with a language tag are stored in their own underlying
+  // vocabularies, return the index ranges of the ones that contain the
+  // literals with the `languageTag`, see
+  // `SplitVocabulary::getIndexRangesForLanguageTag`.
+  std::optional<std::vector<std::pair<uint64_t, uint64_t>>>
+  getIndexRangesForLanguageTag(std::string_view languageTag) const {
+    return std::visit(
+        [&languageTag](const auto& vocab)
+            -> std::optional<std::vector<std::pair<uint64_t, uint64_t>>> {
+          using T = std::decay_t<decltype(vocab)>;
+          if constexpr (ad_utility::isInstantiation<T, SplitVocabulary>) {
+            return vocab.getIndexRangesForLanguageTag(languageTag);
+          } else {
+            return std::nullopt;
+          }
+        },
+        vocab_);
+  }
+
   // Create a `WordWriter` that will create a vocabulary with the given `type`
   // at the given `filename`.
   static std::unique_ptr<WordWriterBase> makeDiskWriterPtr(
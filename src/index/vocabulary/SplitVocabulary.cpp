@@ -14,3 +14,18 @@ template class SplitVocabulary<
 template class SplitVocabulary<GeoSplitFunc, GeoFilenameFunc,
                                VocabularyInMemory,
                                GeoVocabulary<VocabularyInMemory>>;
+template class SplitVocabulary<
+    LanguageSplitFunc, LanguageFilenameFunc,
+    CompressedVocabulary<VocabularyInternalExternal>,
+    CompressedVocabulary<VocabularyInternalExternal>,
+    CompressedVocabulary<VocabularyInternalExternal>,
+    CompressedVocabulary<VocabularyInternalExternal>,
+    CompressedVocabulary<VocabularyInternalExternal>,
+    CompressedVocabulary<VocabularyInternalExternal>,
+    CompressedVocabulary<VocabularyInternalExternal>,
+    CompressedVocabulary<VocabularyInternalExternal>>;
+template class SplitVocabulary<
+    LanguageSplitFunc, LanguageFilenameFunc, VocabularyInMemory,
+    VocabularyInMemory, VocabularyInMemory, VocabularyInMemory,
+    VocabularyInMemory, VocabularyInMemory, VocabularyInMemory,
+    VocabularyInMemory>;
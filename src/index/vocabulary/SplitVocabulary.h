@@ -5,10 +5,15 @@
 #ifndef QLEVER_SRC_INDEX_VOCABULARY_SPLITVOCABULARY_H
 #define QLEVER_SRC_INDEX_VOCABULARY_SPLITVOCABULARY_H
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <string_view>
 #include <variant>
+#include <vector>
 
 #include "backports/StartsWithAndEndsWith.h"
 #include "backports/functional.h"
@@ -42,6 +47,12 @@ CPP_concept SplitFilenameFunctionT =
 // Forward declaration of `PolymorphicVocabulary` for static assertion.
 class PolymorphicVocabulary;
 
+// Forward declaration of the split function of the `SplitLanguageVocabulary`
+// (see below).
+namespace detail::splitVocabulary {
+struct LanguageSplitFunc;
+}
+
 // A SplitVocabulary is a vocabulary layer that divides words into different
 // underlying vocabularies. It is templated on the UnderlyingVocabularies as
 // well as a SplitFunction that decides which underlying vocabulary is used for
@@ -166,6 +177,37 @@ class SplitVocabulary {
         underlying_[marker]);
   }
 
+  // Return the words at the `sortedIndices` (which must be sorted and contain
+  // the marker bits). As the marker is stored in the most significant bits,
+  // the indices for the same underlying vocabulary are contiguous, and each
+  // underlying vocabulary is accessed with a single bulk lookup.
+  std::vector<std::string> lookupSorted(
+      ql::span<const uint64_t> sortedIndices) const {
+    std::vector<std::string> result;
+    result.reserve(sortedIndices.size());
+    std::vector<uint64_t> unmarkedIndices;
+    auto begin = sortedIndices.begin();
+    while (begin != sortedIndices.end()) {
+      auto marker = getMarker(*begin);
+      auto end = std::find_if(begin, sortedIndices.end(), [marker](auto idx) {
+        return getMarker(idx) != marker;
+      });
+      unmarkedIndices.clear();
+      std::transform(begin, end, std::back_inserter(unmarkedIndices),
+                     [](auto idx) { return getVocabIndex(idx); });
+      auto words = std::visit(
+          [&unmarkedIndices](auto& vocab) {
+            AD_CORRECTNESS_CHECK(unmarkedIndices.back() < vocab.size());
+            return ad_utility::vocabulary::lookupSorted(
+                vocab, ql::span<const uint64_t>{unmarkedIndices});
+          },
+          underlying_[marker]);
+      std::move(words.begin(), words.end(), std::back_inserter(result));
+      begin = end;
+    }
+    return result;
+  }
+
   // The size of a SplitVocabulary is the sum of the sizes of the underlying
   // vocabularies.
   [[nodiscard]] uint64_t size() const {
@@ -231,6 +273,24 @@ class SplitVocabulary {
     return pos.value();
   }
 
+  // Return the half-open range of the indices (with the marker bits) of the
+  // words in the underlying vocabulary with the given `marker`.
+  std::pair<uint64_t, uint64_t> getIndexRangeOfUnderlyingVocabulary(
+      uint8_t marker) const {
+    AD_CORRECTNESS_CHECK(marker < numberOfVocabs);
+    auto size = std::visit([](auto& v) -> uint64_t { return v.size(); },
+                           underlying_[marker]);
+    return {addMarker(0, marker), addMarker(size, marker)};
+  }
+
+  // If the literals with a language tag are stored in their own underlying
+  // vocabularies (see `SplitLanguageVocabulary`), return the index ranges
+  // (see above) of the underlying vocabularies that contain all the literals
+  // with the `languageTag` (`*` for all the literals with a language tag).
+  // Return `std::nullopt` for all other split functions.
+  std::optional<std::vector<std::pair<uint64_t, uint64_t>>>
+  getIndexRangesForLanguageTag(std::string_view languageTag) const;
+
   // Shortcut to retrieve the first underlying vocabulary
   AnyUnderlyingVocab& getUnderlyingMainVocabulary() { return underlying_[0]; }
   const AnyUnderlyingVocab& getUnderlyingMainVocabulary() const {
@@ -319,6 +379,64 @@ struct GeoFilenameFunc {
   }
 };
 
+// The language tags of the literals that the `SplitLanguageVocabulary` stores
+// in their own vocabulary. The literals with the language tag
+// `LANGUAGE_SPLIT_TAGS[i]` go to vocabulary `i + 1`, the literals with any
+// other language tag to the last vocabulary.
+constexpr inline std::array<std::string_view, 6> LANGUAGE_SPLIT_TAGS{
+    "en", "de", "fr", "es", "it", "ru"};
+
+// Split function for literals with a language tag: Literals with one of the
+// `LANGUAGE_SPLIT_TAGS` go to their own vocabulary, the literals with any other
+// language tag to the last vocabulary, and all other words to vocabulary 0.
+struct LanguageSplitFunc {
+  static constexpr uint8_t otherLanguagesMarker =
+      static_cast<uint8_t>(LANGUAGE_SPLIT_TAGS.size() + 1);
+
+  // Return the marker of the vocabulary for the literals with the
+  // `languageTag`, which must not be empty.
+  static constexpr uint8_t getMarkerForLanguageTag(
+      std::string_view languageTag) {
+    for (size_t i = 0; i < LANGUAGE_SPLIT_TAGS.size(); ++i) {
+      if (languageTag == LANGUAGE_SPLIT_TAGS[i]) {
+        return static_cast<uint8_t>(i + 1);
+      }
+    }
+    return otherLanguagesMarker;
+  }
+
+  uint8_t operator()(std::string_view word) const {
+    // The language tag follows the last `"@` and can't contain a quote.
+    auto pos = word.rfind("\"@");
+    if (!ql::starts_with(word, "\"") || pos == 0 ||
+        pos == std::string_view::npos) {
+      return 0;
+    }
+    auto languageTag = word.substr(pos + 2);
+    if (languageTag.empty() ||
+        languageTag.find('"') != std::string_view::npos) {
+      return 0;
+    }
+    return getMarkerForLanguageTag(languageTag);
+  }
+};
+
+// Split filename function for literals with a language tag: The vocabulary 0
+// is saved under the base filename and the other vocabularies with the suffix
+// ".lang-<tag>" or ".lang-other".
+struct LanguageFilenameFunc {
+  std::array<std::string, LANGUAGE_SPLIT_TAGS.size() + 2> operator()(
+      std::string_view base) const {
+    std::array<std::string, LANGUAGE_SPLIT_TAGS.size() + 2> filenames;
+    filenames.front() = std::string(base);
+    for (size_t i = 0; i < LANGUAGE_SPLIT_TAGS.size(); ++i) {
+      filenames[i + 1] = absl::StrCat(base, ".lang-", LANGUAGE_SPLIT_TAGS[i]);
+    }
+    filenames.back() = absl::StrCat(base, ".lang-other");
+    return filenames;
+  }
+};
+
 }  // namespace detail::splitVocabulary
 
 // A SplitGeoVocabulary splits only Well-Known Text literals to their own
@@ -329,4 +447,21 @@ using SplitGeoVocabulary =
                     detail::splitVocabulary::GeoFilenameFunc,
                     UnderlyingVocabulary, GeoVocabulary<UnderlyingVocabulary>>;
 
+// A SplitLanguageVocabulary stores the literals with a language tag in their
+// own vocabularies (see `LanguageSplitFunc`), such that the literals with one
+// of the `LANGUAGE_SPLIT_TAGS` form a contiguous range of `Id`s, which can be
+// used for the prefiltering of `LANG(?x) = "en"`. Like for the
+// `SplitGeoVocabulary`, the `Id`s of these literals are larger than those of
+// all the words in vocabulary 0 (including the IRIs), and are not found by
+// `lower_bound`, `upper_bound` and `prefix_range`, which only search
+// vocabulary 0.
+template <class UnderlyingVocabulary>
+using SplitLanguageVocabulary =
+    SplitVocabulary<detail::splitVocabulary::LanguageSplitFunc,
+                    detail::splitVocabulary::LanguageFilenameFunc,
+                    UnderlyingVocabulary, UnderlyingVocabulary,
+                    UnderlyingVocabulary, UnderlyingVocabulary,
+                    UnderlyingVocabulary, UnderlyingVocabulary,
+                    UnderlyingVocabulary, UnderlyingVocabulary>;
+
 #endif  // QLEVER_SRC_INDEX_VOCABULARY_SPLITVOCABULARY_H
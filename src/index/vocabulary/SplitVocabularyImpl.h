@@ -163,4 +163,34 @@ bool SplitVocabulary<SF, SFN, S...>::isGeoInfoAvailable() {
   }
 }
 
+// _____________________________________________________________________________
+template <typename SF, typename SFN, typename... S>
+QL_CONCEPT_OR_NOTHING(
+    requires SplitFunctionT<SF>&& SplitFilenameFunctionT<SFN, sizeof...(S)>)
+std::optional<std::vector<std::pair<uint64_t, uint64_t>>>
+SplitVocabulary<SF, SFN, S...>::getIndexRangesForLanguageTag(
+    std::string_view languageTag) const {
+  using detail::splitVocabulary::LanguageSplitFunc;
+  if constexpr (!std::is_same_v<SF, LanguageSplitFunc>) {
+    (void)languageTag;
+    return std::nullopt;
+  } else {
+    // The literals without a language tag are stored in vocabulary 0
+    // together with all the other words.
+    if (languageTag.empty()) {
+      return std::nullopt;
+    }
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;
+    if (languageTag == "*") {
+      for (uint8_t marker = 1; marker < numberOfVocabs; ++marker) {
+        ranges.push_back(getIndexRangeOfUnderlyingVocabulary(marker));
+      }
+    } else {
+      ranges.push_back(getIndexRangeOfUnderlyingVocabulary(
+          LanguageSplitFunc::getMarkerForLanguageTag(languageTag)));
+    }
+    return ranges;
+  }
+}
+
 #endif  // QLEVER_SRC_INDEX_VOCABULARY_SPLITVOCABULARYIMPL_H
@@ -31,6 +31,14 @@ class UnicodeVocabulary {
 
   auto operator[](uint64_t id) const { return _underlyingVocabulary[id]; }
 
+  // Return the words at the `sortedIndices` (which must be sorted), see
+  // `ad_utility::vocabulary::lookupSorted`.
+  std::vector<std::string> lookupSorted(
+      ql::span<const uint64_t> sortedIndices) const {
+    return ad_utility::vocabulary::lookupSorted(_underlyingVocabulary,
+                                                sortedIndices);
+  }
+
   [[nodiscard]] uint64_t size() const { return _underlyingVocabulary.size(); }
 
   /// Return a `WordAndIndex` that points to the first entry that is equal or
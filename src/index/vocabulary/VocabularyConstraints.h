@@ -7,6 +7,7 @@
 
 #include "index/vocabulary/CompressedVocabulary.h"
 #include "index/vocabulary/SplitVocabulary.h"
+#include "index/vocabulary/VocabularyFrontCoded.h"
 #include "index/vocabulary/VocabularyInMemory.h"
 #include "index/vocabulary/VocabularyInternalExternal.h"
 #include "util/TypeTraits.h"
@@ -19,12 +20,14 @@
 // Forward declaration for concepts below.
 class PolymorphicVocabulary;
 
-// Only the `SplitVocabulary` currently needs a special handling for
-// `getPositionOfWord` (this includes the `PolymorphicVocabulary` which may
-// dynamically hold a `SplitVocabulary`)
+// The `SplitVocabulary` needs a special handling for `getPositionOfWord` (this
+// includes the `PolymorphicVocabulary` which may dynamically hold a
+// `SplitVocabulary`). The uncompressed vocabularies implement
+// `getPositionOfWord` using a hash index for the words that are stored in RAM.
 template <typename T>
 CPP_concept HasSpecialGetPositionOfWord =
-    std::is_same_v<T, PolymorphicVocabulary> ||
+    ad_utility::SameAsAny<T, PolymorphicVocabulary, VocabularyInMemory,
+                          VocabularyInternalExternal> ||
     ad_utility::isInstantiation<T, SplitVocabulary>;
 
 // As a safeguard for the future: Concept that a vocabulary does NOT require a
@@ -34,9 +37,9 @@ CPP_concept HasSpecialGetPositionOfWord =
 // general.
 template <typename T>
 CPP_concept HasDefaultGetPositionOfWord =
-    ad_utility::SameAsAny<T, VocabularyInMemory, VocabularyInternalExternal,
-                          CompressedVocabulary<VocabularyInMemory>,
-                          CompressedVocabulary<VocabularyInternalExternal>>;
+    ad_utility::SameAsAny<T, CompressedVocabulary<VocabularyInMemory>,
+                          CompressedVocabulary<VocabularyInternalExternal>,
+                          VocabularyFrontCoded>;
 
 // This concept states that the given vocabulary implementation `T` might
 // provide precomputed `GeometryInfo` via a `getGeoInfo` method (for example,
@@ -54,13 +57,12 @@ CPP_concept MaybeProvidesGeometryInfo =
 // implementation will never provide precomputed `GeometryInfo` via a
 // `getGeoInfo` method. A vocabulary class should only be added if it can be
 // GUARANTEED that this will be the case.
-// Note: Currently, this concept is identical with `HasDefaultGetPositionOfWord`
-// by coincidence. However, both concepts are semantically different.
 template <typename T>
 CPP_concept NeverProvidesGeometryInfo =
     ad_utility::SameAsAny<T, VocabularyInMemory, VocabularyInternalExternal,
                           CompressedVocabulary<VocabularyInMemory>,
-                          CompressedVocabulary<VocabularyInternalExternal>>;
+                          CompressedVocabulary<VocabularyInternalExternal>,
+                          VocabularyFrontCoded>;
 
 // A variadic version of `NeverProvidesGeometryInfo` that guarantees the
 // semantics of the named concept for all of its template parameters `Ts...`.
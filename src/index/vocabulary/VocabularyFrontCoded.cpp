@@ -0,0 +1,202 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/vocabulary/VocabularyFrontCoded.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <optional>
+
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeVector.h"
+
+namespace {
+// The lengths are stored as variable-length integers with 7 bits per byte
+// (the highest bit of each byte is set iff more bytes follow), s.t. the
+// typical short lengths require a single byte.
+void appendLength(std::string& target, uint64_t length) {
+  while (length >= 0x80) {
+    target.push_back(static_cast<char>((length & 0x7F) | 0x80));
+    length >>= 7;
+  }
+  target.push_back(static_cast<char>(length));
+}
+
+uint64_t readLength(const char*& current, const char* end) {
+  uint64_t length = 0;
+  for (size_t shift = 0;; shift += 7) {
+    AD_CORRECTNESS_CHECK(current < end && shift < 64);
+    auto byte = static_cast<unsigned char>(*current++);
+    length |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return length;
+    }
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+bool VocabularyFrontCoded::BlockDecoder::next() {
+  if (numRemaining_ == 0) {
+    return false;
+  }
+  --numRemaining_;
+  ++offsetInBlock_;
+  auto sharedPrefix = readLength(current_, end_);
+  auto suffixSize = readLength(current_, end_);
+  AD_CORRECTNESS_CHECK(sharedPrefix <= word_.size() &&
+                       suffixSize <= static_cast<uint64_t>(end_ - current_));
+  word_.resize(sharedPrefix);
+  word_.append(current_, suffixSize);
+  current_ += suffixSize;
+  return true;
+}
+
+// _____________________________________________________________________________
+auto VocabularyFrontCoded::getDecoder(uint64_t blockIndex) const
+    -> BlockDecoder {
+  AD_CORRECTNESS_CHECK(blockIndex < numBlocks());
+  const char* data = payload_.data();
+  uint64_t firstWord = blockIndex * wordsPerBlock_;
+  return {data + blockOffsets_[blockIndex],
+          data + blockOffsets_[blockIndex + 1],
+          std::min(wordsPerBlock_, size_ - firstWord)};
+}
+
+// _____________________________________________________________________________
+std::string VocabularyFrontCoded::operator[](uint64_t idx) const {
+  AD_CONTRACT_CHECK(idx < size());
+  auto decoder = getDecoder(idx / wordsPerBlock_);
+  // Only decode the block up to the requested word.
+  for (uint64_t i = 0; i <= idx % wordsPerBlock_; ++i) {
+    decoder.next();
+  }
+  return std::string{decoder.word()};
+}
+
+// _____________________________________________________________________________
+std::vector<std::string> VocabularyFrontCoded::lookupSorted(
+    ql::span<const uint64_t> sortedIndices) const {
+  std::vector<std::string> result;
+  result.reserve(sortedIndices.size());
+  std::optional<BlockDecoder> decoder;
+  uint64_t currentBlock = 0;
+  for (uint64_t idx : sortedIndices) {
+    AD_CONTRACT_CHECK(idx < size());
+    uint64_t block = idx / wordsPerBlock_;
+    uint64_t offsetInBlock = idx % wordsPerBlock_;
+    // Start a new decoder if the word is in a different block or if it has
+    // already been decoded (for duplicate indices).
+    if (!decoder.has_value() || block != currentBlock ||
+        decoder->offsetInBlock() > offsetInBlock) {
+      decoder.emplace(getDecoder(block));
+      currentBlock = block;
+      decoder->next();
+    }
+    while (decoder->offsetInBlock() < offsetInBlock) {
+      decoder->next();
+    }
+    result.emplace_back(decoder->word());
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void VocabularyFrontCoded::open(const std::string& filename) {
+  close();
+  payload_.map(filename);
+  {
+    ad_utility::serialization::FileReadSerializer blocksFile(
+        absl::StrCat(filename, blocksSuffix_));
+    blocksFile >> size_;
+    blocksFile >> wordsPerBlock_;
+    blocksFile >> blockOffsets_;
+    blocksFile >> blockHeads_;
+  }
+  AD_CORRECTNESS_CHECK(wordsPerBlock_ > 0);
+  AD_CORRECTNESS_CHECK(numBlocks() ==
+                       (size_ + wordsPerBlock_ - 1) / wordsPerBlock_);
+  AD_CORRECTNESS_CHECK(blockOffsets_.size() == numBlocks() + 1);
+  AD_CORRECTNESS_CHECK(blockOffsets_.back() <= payload_.size());
+}
+
+// _____________________________________________________________________________
+void VocabularyFrontCoded::close() {
+  payload_.unmap();
+  blockHeads_.clear();
+  blockOffsets_.clear();
+  size_ = 0;
+}
+
+// _____________________________________________________________________________
+VocabularyFrontCoded::WordWriter::WordWriter(const std::string& filename,
+                                             uint64_t wordsPerBlock)
+    : file_{filename, "w"},
+      blocksFilename_{absl::StrCat(filename, blocksSuffix_)},
+      wordsPerBlock_{wordsPerBlock} {
+  AD_CONTRACT_CHECK(wordsPerBlock_ > 0);
+}
+
+// _____________________________________________________________________________
+uint64_t VocabularyFrontCoded::WordWriter::operator()(
+    std::string_view word, [[maybe_unused]] bool isExternalDummy) {
+  if (numWords_ % wordsPerBlock_ == 0) {
+    writeCurrentBlock();
+    blockOffsets_.push_back(currentOffset_);
+    blockHeads_.emplace_back(word);
+    previousWord_.clear();
+  }
+  auto mismatch = std::mismatch(previousWord_.begin(), previousWord_.end(),
+                                word.begin(), word.end());
+  auto sharedPrefix =
+      static_cast<uint64_t>(mismatch.first - previousWord_.begin());
+  appendLength(currentBlock_, sharedPrefix);
+  appendLength(currentBlock_, word.size() - sharedPrefix);
+  currentBlock_.append(word.substr(sharedPrefix));
+  previousWord_ = word;
+  return numWords_++;
+}
+
+// _____________________________________________________________________________
+void VocabularyFrontCoded::WordWriter::writeCurrentBlock() {
+  if (currentBlock_.empty()) {
+    return;
+  }
+  // Pad the block, s.t. the next block is aligned.
+  currentBlock_.resize(
+      (currentBlock_.size() + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT *
+          BLOCK_ALIGNMENT,
+      '\0');
+  currentOffset_ += file_.write(currentBlock_.data(), currentBlock_.size());
+  currentBlock_.clear();
+}
+
+// _____________________________________________________________________________
+void VocabularyFrontCoded::WordWriter::finishImpl() {
+  writeCurrentBlock();
+  blockOffsets_.push_back(currentOffset_);
+  file_.close();
+  CompactVectorOfStrings<char> heads;
+  heads.build(blockHeads_);
+  ad_utility::serialization::FileWriteSerializer blocksFile{blocksFilename_};
+  blocksFile << numWords_;
+  blocksFile << wordsPerBlock_;
+  blocksFile << blockOffsets_;
+  blocksFile << heads;
+}
+
+// _____________________________________________________________________________
+VocabularyFrontCoded::WordWriter::~WordWriter() {
+  if (!finishWasCalled()) {
+    ad_utility::terminateIfThrows([this]() { this->finish(); },
+                                  "Calling `finish` from the destructor of "
+                                  "`VocabularyFrontCoded::WordWriter`");
+  }
+}
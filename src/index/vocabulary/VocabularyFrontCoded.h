@@ -0,0 +1,201 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_VOCABULARY_VOCABULARYFRONTCODED_H
+#define QLEVER_SRC_INDEX_VOCABULARY_VOCABULARYFRONTCODED_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "backports/algorithm.h"
+#include "backports/span.h"
+#include "global/Pattern.h"
+#include "index/vocabulary/VocabularyTypes.h"
+#include "util/File.h"
+#include "util/ReadOnlyMappedFile.h"
+#include "util/Serializer/Serializer.h"
+
+// A vocabulary in which the (sorted) words are front coded in blocks of
+// (typically) `DEFAULT_WORDS_PER_BLOCK` words: Each word is stored as the
+// length of the prefix that it shares with the previous word of the block,
+// followed by the remaining suffix. Only the first word of each block (the
+// "head") is kept in RAM (uncompressed), the front-coded words are memory
+// mapped. A binary search only compares with the heads of the blocks and then
+// decodes a single block, and accessing a word only decodes the block up to
+// that word. Each block starts at a multiple of `BLOCK_ALIGNMENT` bytes, so
+// decoding a small block touches as few cache lines (and pages) as possible.
+class VocabularyFrontCoded {
+ public:
+  // The words per block are a tradeoff between the size of the heads in RAM
+  // (and the compression ratio), and the number of words that have to be
+  // decoded for an access.
+  static constexpr size_t DEFAULT_WORDS_PER_BLOCK = 16;
+  static constexpr size_t BLOCK_ALIGNMENT = 64;
+
+ private:
+  // The front-coded words of all the blocks.
+  ad_utility::ReadOnlyMappedFile payload_;
+  // The first word of each block.
+  CompactVectorOfStrings<char> blockHeads_;
+  // The offset of each block in the `payload_`, followed by the end offset of
+  // the last block.
+  std::vector<uint64_t> blockOffsets_;
+  uint64_t wordsPerBlock_ = DEFAULT_WORDS_PER_BLOCK;
+  uint64_t size_ = 0;
+
+  // This suffix is appended to the filename of the payload to get the name of
+  // the file in which the heads and offsets of the blocks are stored.
+  static constexpr std::string_view blocksSuffix_ = ".blocks";
+
+  // Decode the words of a single block one after the other.
+  class BlockDecoder {
+   private:
+    const char* current_;
+    const char* end_;
+    uint64_t numRemaining_;
+    uint64_t offsetInBlock_ = 0;
+    std::string word_;
+
+   public:
+    BlockDecoder(const char* begin, const char* end, uint64_t numWords)
+        : current_{begin}, end_{end}, numRemaining_{numWords} {}
+    // Decode the next word; return false if the block has no more words.
+    bool next();
+    // The last decoded word and its offset in its block.
+    std::string_view word() const { return word_; }
+    uint64_t offsetInBlock() const { return offsetInBlock_ - 1; }
+  };
+
+ public:
+  // A helper class to build the vocabulary word by word. The words have to be
+  // added in sorted order, otherwise the binary searches will fail.
+  class WordWriter : public WordWriterBase {
+   private:
+    ad_utility::File file_;
+    std::string blocksFilename_;
+    uint64_t wordsPerBlock_;
+    uint64_t numWords_ = 0;
+    uint64_t currentOffset_ = 0;
+    std::string previousWord_;
+    // The front-coded words of the current block.
+    std::string currentBlock_;
+    std::vector<std::string> blockHeads_;
+    std::vector<uint64_t> blockOffsets_;
+
+   public:
+    explicit WordWriter(const std::string& filename,
+                        uint64_t wordsPerBlock = DEFAULT_WORDS_PER_BLOCK);
+    // Add the next word to the vocabulary and return its index.
+    uint64_t operator()(std::string_view word, bool isExternalDummy) override;
+
+    ~WordWriter() override;
+
+   private:
+    // Write the `currentBlock_` (padded to the `BLOCK_ALIGNMENT`).
+    void writeCurrentBlock();
+    void finishImpl() override;
+  };
+
+  // Return a `unique_ptr<WordWriter>` that writes a vocabulary to the given
+  // `filename`, which afterward has to be opened via `open(filename)`.
+  static auto makeDiskWriterPtr(const std::string& filename) {
+    return std::make_unique<WordWriter>(filename);
+  }
+
+  VocabularyFrontCoded() = default;
+  VocabularyFrontCoded(VocabularyFrontCoded&&) noexcept = default;
+  VocabularyFrontCoded& operator=(VocabularyFrontCoded&&) noexcept = default;
+
+  // Open the vocabulary that has been written to the `filename` by a
+  // `WordWriter`.
+  void open(const std::string& filename);
+
+  // Clear the vocabulary.
+  void close();
+
+  // Return the total number of words.
+  size_t size() const { return size_; }
+
+  // Return the word with the index `idx`, throw if `idx >= size()`.
+  std::string operator[](uint64_t idx) const;
+
+  // Return the words at the `sortedIndices` (which must be sorted). Each block
+  // is decoded at most once.
+  std::vector<std::string> lookupSorted(
+      ql::span<const uint64_t> sortedIndices) const;
+
+  // Return a `WordAndIndex` that points to the first entry that is equal or
+  // greater than `word` wrt. to the `comparator`. Only works correctly if the
+  // words are sorted according to the `comparator`.
+  template <typename InternalStringType, typename Comparator>
+  WordAndIndex lower_bound(const InternalStringType& word,
+                           Comparator comparator) const {
+    // All the blocks before `nextBlock` have a head that is less than the
+    // `word`.
+    auto nextBlock = static_cast<uint64_t>(
+        ql::ranges::lower_bound(blockHeads_, word, comparator) -
+        blockHeads_.begin());
+    return boundImpl(nextBlock, [&](std::string_view element) {
+      return !comparator(element, word);
+    });
+  }
+
+  // Return a `WordAndIndex` that points to the first entry that is greater
+  // than `word`, the interface is the same as for `lower_bound`.
+  template <typename InternalStringType, typename Comparator>
+  WordAndIndex upper_bound(const InternalStringType& word,
+                           Comparator comparator) const {
+    auto nextBlock = static_cast<uint64_t>(
+        ql::ranges::upper_bound(blockHeads_, word, comparator) -
+        blockHeads_.begin());
+    return boundImpl(nextBlock, [&](std::string_view element) {
+      return comparator(word, element);
+    });
+  }
+
+  // Generic serialization support.
+  AD_SERIALIZE_FRIEND_FUNCTION(VocabularyFrontCoded) {
+    (void)serializer;
+    (void)arg;
+    throw std::runtime_error(
+        "Generic serialization is not implemented for VocabularyFrontCoded.");
+  }
+
+ private:
+  uint64_t numBlocks() const { return blockHeads_.size(); }
+
+  // Return a `BlockDecoder` for the block with the `blockIndex`.
+  BlockDecoder getDecoder(uint64_t blockIndex) const;
+
+  // Return the first word that satisfies the `isResult` predicate, provided
+  // that the heads of all the blocks before `nextBlock` don't satisfy it, but
+  // the head of `nextBlock` does (if it exists).
+  template <typename Predicate>
+  WordAndIndex boundImpl(uint64_t nextBlock, const Predicate& isResult) const {
+    if (nextBlock > 0) {
+      // The result might be one of the remaining words of the previous block.
+      uint64_t block = nextBlock - 1;
+      auto decoder = getDecoder(block);
+      decoder.next();
+      while (decoder.next()) {
+        if (isResult(decoder.word())) {
+          return {decoder.word(),
+                  block * wordsPerBlock_ + decoder.offsetInBlock()};
+        }
+      }
+    }
+    if (nextBlock == numBlocks()) {
+      return WordAndIndex::end();
+    }
+    return {blockHeads_[nextBlock], nextBlock * wordsPerBlock_};
+  }
+};
+
+#endif  // QLEVER_SRC_INDEX_VOCABULARY_VOCABULARYFRONTCODED_H
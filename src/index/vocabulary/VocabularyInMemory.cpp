@@ -13,6 +13,7 @@ void VocabularyInMemory::open(const string& fileName) {
   _words.clear();
   ad_utility::serialization::FileReadSerializer file(fileName);
   file >> _words;
+  exactWordIndex_.build(_words);
   AD_LOG_INFO << "Done, number of words: " << size() << std::endl;
 }
 
@@ -10,6 +10,7 @@
 
 #include "global/Pattern.h"
 #include "index/StringSortComparator.h"
+#include "index/vocabulary/ExactWordIndex.h"
 #include "index/vocabulary/VocabularyBinarySearchMixin.h"
 #include "index/vocabulary/VocabularyTypes.h"
 #include "util/Exception.h"
@@ -29,13 +30,17 @@ class VocabularyInMemory
  private:
   // The actual storage.
   Words _words;
+  // Hash index for the exact lookup of words, see `getPositionOfWord`.
+  ExactWordIndex exactWordIndex_;
 
  public:
   /// Construct an empty vocabulary
   VocabularyInMemory() = default;
 
   /// Construct the vocabulary from `Words`
-  explicit VocabularyInMemory(Words words) : _words{std::move(words)} {}
+  explicit VocabularyInMemory(Words words) : _words{std::move(words)} {
+    exactWordIndex_.build(_words);
+  }
 
   // Vocabularies are movable
   VocabularyInMemory& operator=(VocabularyInMemory&&) noexcept = default;
@@ -54,6 +59,23 @@ class VocabularyInMemory
   /// Return the `i-th` word. The behavior is undefined if `i >= size()`
   auto operator[](uint64_t i) const { return _words[i]; }
 
+  // Return the range `[lower, upper)` of the positions of the `word`, which is
+  // empty (and starts at the position where the `word` would be inserted) if
+  // the `word` is not contained. The `comparator` must be the comparator by
+  // which the words are sorted. The words that are contained are found in O(1)
+  // via the `exactWordIndex_`, only for the other words a binary search is
+  // required.
+  template <typename T, typename Comparator>
+  std::pair<uint64_t, uint64_t> getPositionOfWord(const T& word,
+                                                  Comparator comparator) const {
+    if (auto position = exactWordIndex_.find(_words, word)) {
+      return {position.value(), position.value() + 1};
+    }
+    return lower_bound(word, comparator)
+        .positionOfWord(word)
+        .value_or(std::pair<uint64_t, uint64_t>{size(), size()});
+  }
+
   // Conversion function that is used by the Mixin base class.
   template <typename It>
   WordAndIndex iteratorToWordAndIndex(It it) const {
@@ -98,14 +120,22 @@ class VocabularyInMemory
   }
 
   /// Clear the vocabulary.
-  void close() { _words.clear(); }
+  void close() {
+    _words.clear();
+    exactWordIndex_.clear();
+  }
 
   // Const access to the underlying words.
   auto begin() const { return _words.begin(); }
   auto end() const { return _words.end(); }
 
   // Generic serialization support.
-  AD_SERIALIZE_FRIEND_FUNCTION(VocabularyInMemory) { serializer | arg._words; }
+  AD_SERIALIZE_FRIEND_FUNCTION(VocabularyInMemory) {
+    serializer | arg._words;
+    if constexpr (ad_utility::serialization::ReadSerializer<S>) {
+      arg.exactWordIndex_.build(arg._words);
+    }
+  }
 };
 
 #endif  // QLEVER_SRC_INDEX_VOCABULARY_VOCABULARYINMEMORY_H
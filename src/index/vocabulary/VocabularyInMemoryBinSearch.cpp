@@ -19,6 +19,7 @@ void VocabularyInMemoryBinSearch::open(const string& fileName) {
     ad_utility::serialization::FileReadSerializer idFile(fileName + ".ids");
     idFile >> indices_;
   }
+  exactWordIndex_.build(words_);
 }
 
 // _____________________________________________________________________________
@@ -31,6 +32,16 @@ std::optional<std::string_view> VocabularyInMemoryBinSearch::operator[](
   return std::nullopt;
 }
 
+// _____________________________________________________________________________
+std::optional<uint64_t> VocabularyInMemoryBinSearch::getIndexOfExactWord(
+    std::string_view word) const {
+  auto position = exactWordIndex_.find(words_, word);
+  if (!position.has_value()) {
+    return std::nullopt;
+  }
+  return indices_[position.value()];
+}
+
 // _____________________________________________________________________________
 WordAndIndex VocabularyInMemoryBinSearch::iteratorToWordAndIndex(
     ql::ranges::iterator_t<Words> it) const {
@@ -49,6 +60,7 @@ WordAndIndex VocabularyInMemoryBinSearch::iteratorToWordAndIndex(
 void VocabularyInMemoryBinSearch::close() {
   words_.clear();
   indices_.clear();
+  exactWordIndex_.clear();
 }
 
 // _____________________________________________________________________________
@@ -9,6 +9,7 @@
 #include <string_view>
 
 #include "global/Pattern.h"
+#include "index/vocabulary/ExactWordIndex.h"
 #include "index/vocabulary/VocabularyBinarySearchMixin.h"
 #include "index/vocabulary/VocabularyTypes.h"
 #include "util/Algorithm.h"
@@ -33,6 +34,8 @@ class VocabularyInMemoryBinSearch
   // The actual storage.
   Words words_;
   Indices indices_;
+  // Hash index for the exact lookup of words, see `getIndexOfExactWord`.
+  ExactWordIndex exactWordIndex_;
 
  public:
   // Construct an empty vocabulary
@@ -60,6 +63,11 @@ class VocabularyInMemoryBinSearch
   // vocabulary, return `std::nullopt`.
   std::optional<std::string_view> operator[](uint64_t index) const;
 
+  // Return the index of the `word` if it is contained in this vocabulary, else
+  // `std::nullopt`. In contrast to `lower_bound`, this requires no binary
+  // search.
+  std::optional<uint64_t> getIndexOfExactWord(std::string_view word) const;
+
   // Convert an iterator to a `WordAndIndex`. Required for the mixin.
   WordAndIndex iteratorToWordAndIndex(ql::ranges::iterator_t<Words> it) const;
 
@@ -13,6 +13,28 @@ std::string VocabularyInternalExternal::operator[](uint64_t i) const {
   return externalVocab_[i];
 }
 
+// _____________________________________________________________________________
+std::vector<std::string> VocabularyInternalExternal::lookupSorted(
+    ql::span<const uint64_t> sortedIndices) const {
+  std::vector<std::string> result(sortedIndices.size());
+  std::vector<uint64_t> externalIndices;
+  std::vector<size_t> externalPositions;
+  for (size_t i = 0; i < sortedIndices.size(); ++i) {
+    auto fromInternal = internalVocab_[sortedIndices[i]];
+    if (fromInternal.has_value()) {
+      result[i] = std::string{fromInternal.value()};
+    } else {
+      externalIndices.push_back(sortedIndices[i]);
+      externalPositions.push_back(i);
+    }
+  }
+  auto fromExternal = externalVocab_.lookupSorted(externalIndices);
+  for (size_t i = 0; i < externalPositions.size(); ++i) {
+    result[externalPositions[i]] = std::move(fromExternal[i]);
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 VocabularyInternalExternal::WordWriter::WordWriter(const std::string& filename,
                                                    size_t milestoneDistance)
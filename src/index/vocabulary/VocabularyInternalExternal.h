@@ -49,6 +49,12 @@ class VocabularyInternalExternal {
   /// Return the `i-th` word. The behavior is undefined if `i >= size()`
   std::string operator[](uint64_t i) const;
 
+  // Return the words at the `sortedIndices` (which must be sorted). The words
+  // that are not stored in the internal vocabulary are read from the external
+  // vocabulary in a single bulk access.
+  std::vector<std::string> lookupSorted(
+      ql::span<const uint64_t> sortedIndices) const;
+
   /// Return a `WordAndIndex` that points to the first entry that is equal or
   /// greater than `word` wrt. to the `comparator`. Only works correctly if the
   /// `words_` are sorted according to the comparator (exactly like in
@@ -93,6 +99,22 @@ class VocabularyInternalExternal {
     });
   }
 
+  // Return the range `[lower, upper)` of the positions of the `word`, which is
+  // empty (and starts at the position where the `word` would be inserted) if
+  // the `word` is not contained. The `comparator` must be the comparator by
+  // which the words are sorted. The words that are cached in RAM are found
+  // without a binary search.
+  template <typename T, typename Comparator>
+  std::pair<uint64_t, uint64_t> getPositionOfWord(const T& word,
+                                                  Comparator comparator) const {
+    if (auto index = internalVocab_.getIndexOfExactWord(word)) {
+      return {index.value(), index.value() + 1};
+    }
+    return lower_bound(word, comparator)
+        .positionOfWord(word)
+        .value_or(std::pair<uint64_t, uint64_t>{size(), size()});
+  }
+
   /// A helper type that can be used to directly write a vocabulary to disk
   /// word-by-word, without having to materialize it in RAM first.
   struct WordWriter : public WordWriterBase {
@@ -34,6 +34,54 @@ std::string VocabularyOnDisk::operator[](uint64_t idx) const {
   return result;
 }
 
+// _____________________________________________________________________________
+std::vector<std::string> VocabularyOnDisk::lookupSorted(
+    ql::span<const uint64_t> sortedIndices) const {
+  std::vector<std::string> result;
+  result.reserve(sortedIndices.size());
+  std::vector<Offset> offsets;
+  std::string buffer;
+  auto runBegin = sortedIndices.begin();
+  while (runBegin != sortedIndices.end()) {
+    auto runEnd = runBegin + 1;
+    while (runEnd != sortedIndices.end() &&
+           *runEnd - *(runEnd - 1) <= MAX_GAP_IN_RUN) {
+      ++runEnd;
+    }
+    uint64_t first = *runBegin;
+    uint64_t last = *(runEnd - 1);
+    AD_CONTRACT_CHECK(last < size());
+    // Read the offsets of all the words of the run, including the offset
+    // that marks the end of the last word.
+    offsets.resize(last - first + 2);
+    offsetsFile_.read(offsets.data(), offsets.size() * sizeof(Offset),
+                      static_cast<off_t>(first * sizeof(Offset)));
+    auto offsetOf = [&](uint64_t idx) { return offsets[idx - first]; };
+
+    // Read the words of the run in chunks of at most `MAX_BYTES_PER_READ`
+    // bytes.
+    auto chunkBegin = runBegin;
+    while (chunkBegin != runEnd) {
+      Offset chunkStart = offsetOf(*chunkBegin);
+      auto chunkEnd = chunkBegin + 1;
+      while (chunkEnd != runEnd &&
+             offsetOf(*chunkEnd + 1) - chunkStart <= MAX_BYTES_PER_READ) {
+        ++chunkEnd;
+      }
+      buffer.resize(offsetOf(*(chunkEnd - 1) + 1) - chunkStart);
+      file_.read(buffer.data(), buffer.size(),
+                 static_cast<off_t>(chunkStart));
+      for (auto it = chunkBegin; it != chunkEnd; ++it) {
+        result.emplace_back(buffer, offsetOf(*it) - chunkStart,
+                            offsetOf(*it + 1) - offsetOf(*it));
+      }
+      chunkBegin = chunkEnd;
+    }
+    runBegin = runEnd;
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 VocabularyOnDisk::WordWriter::WordWriter(const std::string& outFilename)
     : file_{outFilename, "w"},
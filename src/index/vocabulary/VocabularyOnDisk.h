@@ -73,6 +73,20 @@ class VocabularyOnDisk : public VocabularyBinarySearchMixin<VocabularyOnDisk> {
   // size`.
   std::string operator[](uint64_t idx) const;
 
+  // Return the words at the `sortedIndices` (which must be sorted). Indices
+  // that are close to each other are read together, s.t. the offsets and the
+  // words of such a run are read with one `pread` each instead of two
+  // `pread`s per word.
+  std::vector<std::string> lookupSorted(
+      ql::span<const uint64_t> sortedIndices) const;
+
+  // Two consecutive requested indices belong to the same run if there are at
+  // most this many words between them.
+  static constexpr uint64_t MAX_GAP_IN_RUN = 64;
+  // The words of a run are read in chunks of at most this many bytes (a
+  // single word that is larger is read on its own).
+  static constexpr uint64_t MAX_BYTES_PER_READ = 1 << 16;
+
   // Get the number of words in the vocabulary.
   size_t size() const { return size_; }
 
@@ -10,7 +10,11 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "backports/algorithm.h"
+#include "backports/concepts.h"
+#include "backports/span.h"
 #include "util/Exception.h"
 #include "util/ExceptionHandling.h"
 
@@ -135,4 +139,64 @@ class WordWriterBase {
   virtual void finishImpl() = 0;
 };
 
+namespace ad_utility::vocabulary {
+namespace detail {
+template <typename Vocabulary>
+CPP_requires(HasLookupSorted_,
+             requires(const Vocabulary& vocabulary,
+                      ql::span<const uint64_t> indices)(
+                 vocabulary.lookupSorted(indices)));
+
+template <typename Vocabulary>
+CPP_concept HasLookupSorted = CPP_requires_ref(HasLookupSorted_, Vocabulary);
+}  // namespace detail
+
+// Return the words of the vocabulary for all the `sortedIndices`, which must
+// be sorted in ascending order. Vocabularies for which such a bulk access is
+// cheaper than the individual accesses (for example, because the words are
+// stored on disk or compressed in blocks) provide a member function
+// `lookupSorted` with this semantics, for all other vocabularies `operator[]`
+// is called for each index.
+template <typename Vocabulary>
+std::vector<std::string> lookupSorted(const Vocabulary& vocabulary,
+                                      ql::span<const uint64_t> sortedIndices) {
+  AD_EXPENSIVE_CHECK(ql::ranges::is_sorted(sortedIndices));
+  if constexpr (detail::HasLookupSorted<Vocabulary>) {
+    return vocabulary.lookupSorted(sortedIndices);
+  } else {
+    std::vector<std::string> result;
+    result.reserve(sortedIndices.size());
+    for (uint64_t index : sortedIndices) {
+      result.emplace_back(vocabulary[index]);
+    }
+    return result;
+  }
+}
+
+// Like `lookupSorted`, but the `indices` may be in any order and contain
+// duplicates. They are sorted and deduplicated internally, and the words are
+// returned in the order of the `indices`.
+template <typename Vocabulary>
+std::vector<std::string> lookupMany(const Vocabulary& vocabulary,
+                                    ql::span<const uint64_t> indices) {
+  if (ql::ranges::is_sorted(indices) &&
+      ql::ranges::adjacent_find(indices) == indices.end()) {
+    return lookupSorted(vocabulary, indices);
+  }
+  std::vector<uint64_t> sortedIndices(indices.begin(), indices.end());
+  ql::ranges::sort(sortedIndices);
+  sortedIndices.erase(std::unique(sortedIndices.begin(), sortedIndices.end()),
+                      sortedIndices.end());
+  auto words =
+      lookupSorted(vocabulary, ql::span<const uint64_t>{sortedIndices});
+  std::vector<std::string> result;
+  result.reserve(indices.size());
+  for (uint64_t index : indices) {
+    auto it = ql::ranges::lower_bound(sortedIndices, index);
+    result.push_back(words[it - sortedIndices.begin()]);
+  }
+  return result;
+}
+}  // namespace ad_utility::vocabulary
+
 #endif  // QLEVER_SRC_INDEX_VOCABULARY_VOCABULARYTYPES_H
@@ -0,0 +1,128 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "libqlever/IdTableResult.h"
+
+#include <stdexcept>
+
+#include "engine/ExportQueryExecutionTrees.h"
+#include "engine/QueryExecutionContext.h"
+#include "engine/QueryExecutionTree.h"
+#include "index/ExportIds.h"
+#include "parser/ParsedQuery.h"
+#include "util/Algorithm.h"
+#include "util/InputRangeUtils.h"
+
+namespace qlever {
+
+// _____________________________________________________________________________
+IdTableResult::IdTableResult(
+    QueryPlan plan, ad_utility::SharedCancellationHandle cancellationHandle)
+    : plan_{std::move(plan)},
+      cancellationHandle_{std::move(cancellationHandle)} {
+  const auto& [qet, qec, parsedQuery] = plan_;
+  if (!parsedQuery.hasSelectClause()) {
+    throw std::invalid_argument(
+        "Only the results of SELECT queries can be returned as `IdTable`s");
+  }
+  limitOffset_ = parsedQuery._limitOffset;
+  ExportQueryExecutionTrees::compensateForLimitOffsetClause(limitOffset_,
+                                                            *qet);
+  const auto& selectedVariables =
+      parsedQuery.selectClause().getSelectedVariables();
+  auto columnIndices = qet->selectedVariablesToColumnIndices(
+      parsedQuery.selectClause(), true);
+  for (size_t i = 0; i < selectedVariables.size(); ++i) {
+    if (columnIndices[i].has_value()) {
+      variables_.push_back(selectedVariables[i]);
+      columns_.push_back(columnIndices[i].value().columnIndex_);
+    }
+  }
+  // This triggers the (possibly lazy) computation of the result.
+  result_ = qet->getResult(true);
+}
+
+// _____________________________________________________________________________
+ad_utility::InputRangeTypeErased<IdTableResult::Block> IdTableResult::blocks() {
+  // The number of rows is written by `getRowIndices`, but not needed.
+  auto totalNumRows = std::make_shared<uint64_t>(0);
+  auto rowIndices = ExportQueryExecutionTrees::getRowIndices(
+      limitOffset_, *result_, *totalNumRows);
+  // The transformation owns the `totalNumRows` and is destroyed after the
+  // `rowIndices` (see `CachingTransformInputRange`).
+  return ad_utility::InputRangeTypeErased{
+      ad_utility::CachingTransformInputRange(
+          std::move(rowIndices),
+          [this, totalNumRows](const TableWithRange& tableWithRange) {
+            cancellationHandle_->throwIfCancelled();
+            const auto& [tableWithVocab, range] = tableWithRange;
+            auto rows = tableWithVocab.idTable().asRowRangeView(
+                *range.begin(), *range.begin() + range.size());
+            return Block{rows.asColumnSubsetView(columns_),
+                         tableWithVocab.localVocab_};
+          })};
+}
+
+// _____________________________________________________________________________
+std::vector<std::optional<int64_t>> IdTableResult::decodeInts(
+    const Block& block, size_t column) const {
+  return ad_utility::transform(
+      block.idTable_.getColumn(column), [](Id id) -> std::optional<int64_t> {
+        if (id.getDatatype() == Datatype::Int) {
+          return id.getInt();
+        }
+        return std::nullopt;
+      });
+}
+
+// _____________________________________________________________________________
+std::vector<std::optional<double>> IdTableResult::decodeDoubles(
+    const Block& block, size_t column) const {
+  return ad_utility::transform(
+      block.idTable_.getColumn(column), [](Id id) -> std::optional<double> {
+        if (id.getDatatype() == Datatype::Double) {
+          return id.getDouble();
+        } else if (id.getDatatype() == Datatype::Int) {
+          return static_cast<double>(id.getInt());
+        }
+        return std::nullopt;
+      });
+}
+
+// _____________________________________________________________________________
+std::vector<std::optional<DateYearOrDuration>> IdTableResult::decodeDates(
+    const Block& block, size_t column) const {
+  return ad_utility::transform(
+      block.idTable_.getColumn(column),
+      [](Id id) -> std::optional<DateYearOrDuration> {
+        if (id.getDatatype() == Datatype::Date) {
+          return id.getDate();
+        }
+        return std::nullopt;
+      });
+}
+
+// _____________________________________________________________________________
+std::vector<std::optional<std::string>> IdTableResult::decodeStrings(
+    const Block& block, size_t column) const {
+  const auto& qec = std::get<1>(plan_);
+  auto stringsAndTypes = ql::exportIds::idsToStringAndType(
+      qec->getIndex(), block.idTable_.getColumn(column), block.localVocab(),
+      ql::identity{}, &qec->vocabDecodeCache());
+  return ad_utility::transform(
+      std::move(stringsAndTypes),
+      [](auto&& stringAndType) -> std::optional<std::string> {
+        if (!stringAndType.has_value()) {
+          return std::nullopt;
+        }
+        return std::move(stringAndType.value().first);
+      });
+}
+
+}  // namespace qlever
@@ -0,0 +1,99 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_LIBQLEVER_IDTABLERESULT_H
+#define QLEVER_SRC_LIBQLEVER_IDTABLERESULT_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "engine/Result.h"
+#include "engine/idTable/IdTable.h"
+#include "global/Id.h"
+#include "index/LocalVocab.h"
+#include "libqlever/QleverTypes.h"
+#include "parser/data/LimitOffsetClause.h"
+#include "parser/data/Variable.h"
+#include "util/CancellationHandle.h"
+#include "util/DateYearDuration.h"
+#include "util/Iterators.h"
+
+namespace qlever {
+
+// The result of a SELECT query as blocks of `IdTable` views, see
+// `Qlever::queryIdTables`. In contrast to `Qlever::query`, the result is not
+// serialized, so an embedding application can directly work with the IDs, and
+// convert only those that it needs to values with the batched `decode...`
+// functions below.
+class IdTableResult {
+ public:
+  // A block of rows of the result. The block is only valid until the next
+  // block is requested from the range returned by `blocks()`.
+  struct Block {
+    // The columns of the `variables()` (in this order) for the rows of this
+    // block. The `IdTable` is not copied.
+    IdTableView<0> idTable_;
+    // The `LocalVocab` of the `Id`s with datatype `LocalVocabIndex`.
+    std::reference_wrapper<const LocalVocab> localVocab_;
+
+    const LocalVocab& localVocab() const { return localVocab_.get(); }
+  };
+
+ private:
+  QueryPlan plan_;
+  std::shared_ptr<const Result> result_;
+  std::vector<Variable> variables_;
+  std::vector<ColumnIndex> columns_;
+  LimitOffsetClause limitOffset_;
+  ad_utility::SharedCancellationHandle cancellationHandle_;
+
+ public:
+  // Compute the result of the `plan` of a SELECT query (if the result is not
+  // cached, the result is computed lazily while iterating over the `blocks`).
+  // Throws `std::invalid_argument` if the query is not a SELECT query.
+  IdTableResult(QueryPlan plan,
+                ad_utility::SharedCancellationHandle cancellationHandle);
+
+  // The selected variables, which are the columns of each `Block`. Selected
+  // variables that are never bound in the query body are omitted.
+  const std::vector<Variable>& variables() const { return variables_; }
+
+  // The blocks of the result, with the LIMIT and OFFSET of the query already
+  // applied. Can only be iterated over once. The `IdTableResult` must outlive
+  // the iteration.
+  ad_utility::InputRangeTypeErased<Block> blocks();
+
+  // Decode the `column` of the `block` to typed values. The `i`-th element of
+  // the result is `std::nullopt` if the `i`-th ID of that column doesn't have
+  // the corresponding type (for example, an IRI or UNDEF).
+  //
+  // `xsd:integer` values.
+  std::vector<std::optional<int64_t>> decodeInts(const Block& block,
+                                                 size_t column) const;
+  // `xsd:double` values (integers are converted to doubles).
+  std::vector<std::optional<double>> decodeDoubles(const Block& block,
+                                                   size_t column) const;
+  // `xsd:date`, `xsd:dateTime`, `xsd:gYear`, ... and `xsd:dayTimeDuration`
+  // values.
+  std::vector<std::optional<DateYearOrDuration>> decodeDates(
+      const Block& block, size_t column) const;
+  // All values as strings, in the format of the TSV export (but without the
+  // escaping). The strings of the vocabulary are retrieved with a single
+  // batched lookup for the whole column.
+  std::vector<std::optional<std::string>> decodeStrings(const Block& block,
+                                                        size_t column) const;
+};
+
+}  // namespace qlever
+
+#endif  // QLEVER_SRC_LIBQLEVER_IDTABLERESULT_H
@@ -6,58 +6,117 @@
 
 #include "libqlever/Qlever.h"
 
+#include <absl/cleanup/cleanup.h>
+#include <absl/strings/str_cat.h>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <filesystem>
+#include <future>
 #include <memory>
 #include <stdexcept>
 
 #include "engine/ExportQueryExecutionTrees.h"
+#include "engine/ExternalValues.h"
 #include "engine/MaterializedViews.h"
 #include "engine/QueryExecutionContext.h"
+#include "global/RuntimeParameters.h"
+#include "index/DecompressedBlockCache.h"
 #include "index/IndexImpl.h"
 #include "index/TextIndexBuilder.h"
 #include "libqlever/QleverTypes.h"
 #include "parser/SparqlParser.h"
+#include "util/Algorithm.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeString.h"
 #include "util/http/UrlParser.h"
 
 namespace qlever {
 
+// _____________________________________________________________________________
+auto Qlever::makeSharedResources(ad_utility::MemorySize memoryLimit)
+    -> SharedResources {
+  auto cache = std::make_shared<QueryResultCache>(
+      ad_utility::NumShards{NUM_QUERY_RESULT_CACHE_SHARDS});
+  // The cached results contain copies of the allocator, so the allocator must
+  // not keep the cache alive.
+  ad_utility::AllocatorWithLimit<Id> allocator{
+      ad_utility::makeAllocationMemoryLeftThreadsafeObject(memoryLimit),
+      [weakCache = std::weak_ptr{cache}](
+          ad_utility::MemorySize numMemoryToAllocate) {
+        if (auto lockedCache = weakCache.lock()) {
+          lockedCache->makeRoomAsMuchAsPossible(MAKE_ROOM_SLACK_FACTOR *
+                                                numMemoryToAllocate);
+        }
+      }};
+  return {std::move(cache), std::move(allocator)};
+}
+
 // _____________________________________________________________________________
 Qlever::Qlever(const EngineConfig& config)
-    : allocator_{ad_utility::AllocatorWithLimit<Id>{
-          ad_utility::makeAllocationMemoryLeftThreadsafeObject(
-              config.memoryLimit_.value_or(DEFAULT_MEM_FOR_QUERIES)),
-          [this](ad_utility::MemorySize numMemoryToAllocate) {
-            cache_.makeRoomAsMuchAsPossible(MAKE_ROOM_SLACK_FACTOR *
-                                            numMemoryToAllocate);
-          }}},
+    : Qlever{config,
+             makeSharedResources(
+                 config.memoryLimit_.value_or(DEFAULT_MEM_FOR_QUERIES))} {}
+
+// _____________________________________________________________________________
+Qlever::Qlever(const EngineConfig& config, SharedResources resources)
+    : cache_{std::move(resources.cache_)},
+      allocator_{std::move(resources.allocator_)},
       index_{std::make_shared<Index>(allocator_)},
       enablePatternTrick_{!config.noPatterns_},
-      disableCaching_{config.disableCaching_} {
+      disableCaching_{config.disableCaching_},
+      numThreadsForAsyncQueries_{config.numThreadsForAsyncQueries_} {
   // Set runtime parameters relevant for caching and propagate them to the
   // cache.
   globalRuntimeParameters.wlock()->cacheMaxNumEntries_.setOnUpdateAction(
-      [this](size_t newValue) { cache_.setMaxNumEntries(newValue); });
+      [this](size_t newValue) { cache_->setMaxNumEntries(newValue); });
   globalRuntimeParameters.wlock()->cacheMaxSize_.setOnUpdateAction(
-      [this](ad_utility::MemorySize newValue) { cache_.setMaxSize(newValue); });
+      [this](ad_utility::MemorySize newValue) {
+        cache_->setMaxSize(newValue);
+      });
   globalRuntimeParameters.wlock()->cacheMaxSizeSingleEntry_.setOnUpdateAction(
       [this](ad_utility::MemorySize newValue) {
-        cache_.setMaxSizeSingleEntry(newValue);
+        cache_->setMaxSizeSingleEntry(newValue);
       });
+  globalRuntimeParameters.wlock()
+      ->decompressedBlockCacheMaxSize_.setOnUpdateAction(
+          [](ad_utility::MemorySize newValue) {
+            DecompressedBlockCache::get().setMaxSize(newValue);
+          });
 
   // Load the index from disk.
   index_->usePatterns() = enablePatternTrick_;
   index_->loadAllPermutations() = !config.onlyPsoAndPos_;
   index_->doNotLoadPermutations() = config.doNotLoadPermutations_;
+  index_->lazyLoadPermutations() = config.lazyLoadPermutations_;
   index_->createFromOnDiskIndex(config.baseName_, config.persistUpdates_);
+
+  // Estimate the cost of sorting operations (needed for query planning). This
+  // is CPU-bound and runs concurrently with the loading of the text index,
+  // which doesn't use the `allocator_`.
+  auto sortEstimates = std::async(std::launch::async, [this]() {
+    sortPerformanceEstimator_.computeEstimatesExpensively(
+        allocator_, index_->numTriples().normalAndInternal_() *
+                        PERCENTAGE_OF_TRIPLES_FOR_SORT_ESTIMATE / 100);
+  });
   if (config.loadTextIndex_) {
     index_->addTextFromOnDiskIndex();
   }
 
   materializedViewsManager_->setOnDiskBase(config.baseName_);
 
-  // Estimate the cost of sorting operations (needed for query planning).
-  sortPerformanceEstimator_.computeEstimatesExpensively(
-      allocator_, index_->numTriples().normalAndInternal_() *
-                      PERCENTAGE_OF_TRIPLES_FOR_SORT_ESTIMATE / 100);
+  if (!config.resultCacheDirectory_.empty()) {
+    resultDiskCache_ = std::make_shared<const QueryResultDiskCache>(
+        config.resultCacheDirectory_, index_->getIndexId());
+  }
+  sortEstimates.get();
+
+  // Restore the named results from a previous run. This has to happen before
+  // any query is executed (see `NamedResultCache::readFromSerializer`).
+  if (config.persistNamedResults_) {
+    namedResultCacheFile_ = absl::StrCat(config.baseName_, ".named-results");
+    readPersistedNamedResultCache();
+  }
 
   // Preload materialized views as requested by the user.
   for (const auto& viewName : config.preloadMaterializedViews_) {
@@ -99,7 +158,11 @@ void Qlever::buildIndex(IndexBuilderConfig config) {
   index.loadAllPermutations() = !config.onlyPsoAndPos_;
   index.addHasWordTriples() = config.addHasWordTriples_;
   index.getImpl().setVocabularyTypeForIndexBuilding(config.vocabType_);
-  index.getImpl().setPrefixesForEncodedValues(config.prefixesForIdEncodedIris_);
+  index.getImpl().setPrefixesForEncodedValues(
+      config.prefixesForIdEncodedIris_, config.hexPrefixesForIdEncodedIris_,
+      config.inlineShortLiterals_);
+  index.getImpl().setWritePermutationPairsConcurrently(
+      config.writePermutationsConcurrently_);
 
   // Build text index if requested (various options).
   if (!config.onlyAddTextIndex_) {
@@ -127,8 +190,15 @@ void Qlever::buildIndex(IndexBuilderConfig config) {
 #endif
   }
 
-  // Build materialized views if requested.
-  if (!config.writeMaterializedViews_.empty()) {
+  if (config.vocabularyNgramIndex_) {
+    index.getImpl().buildVocabularyNgramIndex();
+  }
+
+  // Build materialized views and precompute transitive closures and facet
+  // statistics (which are also stored as materialized views) if requested.
+  if (!config.writeMaterializedViews_.empty() ||
+      !config.transitiveClosurePredicates_.empty() ||
+      config.facetStatistics_) {
     std::cout << std::endl;
     AD_LOG_INFO << "Loading the new index to execute materialized view write "
                    "queries ..."
@@ -137,6 +207,27 @@ void Qlever::buildIndex(IndexBuilderConfig config) {
     for (auto& [viewName, query] : config.writeMaterializedViews_) {
       engine.writeMaterializedView(viewName, query);
     }
+    for (const auto& predicate : config.transitiveClosurePredicates_) {
+      AD_LOG_INFO << "Precomputing the transitive closure of " << predicate
+                  << " ..." << std::endl;
+      for (bool forward : {true, false}) {
+        engine.writeMaterializedView(
+            MaterializedViewsManager::getTransitiveClosureViewName(predicate,
+                                                                   forward),
+            MaterializedViewsManager::getTransitiveClosureViewQuery(predicate,
+                                                                    forward));
+      }
+    }
+    if (config.facetStatistics_) {
+      using materializedViewsQueryAnalysis::FacetStatistics;
+      AD_LOG_INFO << "Precomputing the facet statistics ..." << std::endl;
+      for (auto statistics : {FacetStatistics::ClassPredicate,
+                              FacetStatistics::PredicateObject}) {
+        engine.writeMaterializedView(
+            MaterializedViewsManager::getFacetStatisticsViewName(statistics),
+            MaterializedViewsManager::getFacetStatisticsViewQuery(statistics));
+      }
+    }
     AD_LOG_INFO << "All materialized views written successfully" << std::endl;
   }
 }
@@ -149,13 +240,15 @@ std::string Qlever::query(std::string queryString,
 
 // ___________________________________________________________________________
 std::string Qlever::query(const QueryPlan& queryPlan,
-                          ad_utility::MediaType mediaType) const {
+                          ad_utility::MediaType mediaType,
+                          ad_utility::SharedCancellationHandle handle) const {
   const auto& [qet, qec, parsedQuery] = queryPlan;
   ad_utility::Timer timer{ad_utility::Timer::Started};
 
-  // TODO<joka921> For cancellation we have to call
-  // `recursivelySetCancellationHandle` (see `Server::parseAndPlan`).
-  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  // All the operations of the plan check the same handle (see
+  // `Server::planQuery`).
+  qet->getRootOperation()->recursivelySetCancellationHandle(handle);
+  handle->throwIfCancelled();
   std::string result;
 #ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
   auto responseGenerator = ExportQueryExecutionTrees::computeResult(
@@ -174,6 +267,95 @@ std::string Qlever::query(const QueryPlan& queryPlan,
   return result;
 }
 
+// _____________________________________________________________________________
+std::future<std::string> Qlever::queryAsync(std::string queryString,
+                                            AsyncQueryOptions options) const {
+  return queryAsyncImpl(
+      [this, queryString = std::move(queryString)](
+          ad_utility::SharedCancellationHandle handle) {
+        return parseAndPlanQuery(queryString, std::move(handle));
+      },
+      std::move(options));
+}
+
+// _____________________________________________________________________________
+std::future<std::string> Qlever::queryAsync(QueryPlan queryPlan,
+                                            AsyncQueryOptions options) const {
+  return queryAsyncImpl(
+      [queryPlan = std::move(queryPlan)](
+          const ad_utility::SharedCancellationHandle&) mutable {
+        return std::move(queryPlan);
+      },
+      std::move(options));
+}
+
+// _____________________________________________________________________________
+std::future<std::string> Qlever::queryAsyncImpl(
+    std::function<QueryPlan(ad_utility::SharedCancellationHandle)> makePlan,
+    AsyncQueryOptions options) const {
+  std::call_once(asyncExecutorOnceFlag_, [this]() {
+    asyncExecutor_ =
+        std::make_unique<AsyncExecutor>(numThreadsForAsyncQueries_);
+  });
+  auto handle = options.cancellationHandle_ != nullptr
+                    ? std::move(options.cancellationHandle_)
+                    : std::make_shared<ad_utility::CancellationHandle<>>();
+  auto promise = std::make_shared<std::promise<std::string>>();
+  auto future = promise->get_future();
+
+  // The timer for the timeout is cancelled when the query has finished (the
+  // same as in `Server::cancelAfterDeadline`).
+  std::optional<std::chrono::steady_clock::time_point> deadline;
+  std::shared_ptr<boost::asio::steady_timer> timer;
+  if (options.timeout_.has_value()) {
+    deadline = std::chrono::steady_clock::now() + options.timeout_.value();
+    timer = std::make_shared<boost::asio::steady_timer>(
+        asyncExecutor_->timerThread_, deadline.value());
+    timer->async_wait(
+        [weakHandle = std::weak_ptr{handle}](const boost::system::error_code&) {
+          if (auto pointer = weakHandle.lock()) {
+            pointer->cancel(ad_utility::CancellationState::TIMEOUT);
+          }
+        });
+  }
+
+  boost::asio::post(
+      asyncExecutor_->queryThreads_,
+      [this, promise, handle, deadline, timer, makePlan = std::move(makePlan),
+       mediaType = options.mediaType_]() {
+        absl::Cleanup cancelTimer{[&timer]() {
+          if (timer != nullptr) {
+            timer->cancel();
+          }
+        }};
+        try {
+          handle->throwIfCancelled();
+          auto plan = makePlan(handle);
+          if (deadline.has_value()) {
+            const auto& qet = std::get<0>(plan);
+            qet->getRootOperation()->recursivelySetTimeConstraint(
+                deadline.value());
+          }
+          promise->set_value(query(plan, mediaType, handle));
+        } catch (...) {
+          promise->set_exception(std::current_exception());
+        }
+      });
+  return future;
+}
+
+// _____________________________________________________________________________
+IdTableResult Qlever::queryIdTables(
+    QueryPlan queryPlan,
+    ad_utility::SharedCancellationHandle cancellationHandle) const {
+  return IdTableResult{std::move(queryPlan), std::move(cancellationHandle)};
+}
+
+// _____________________________________________________________________________
+IdTableResult Qlever::queryIdTables(std::string query) const {
+  return queryIdTables(parseAndPlanQuery(std::move(query)));
+}
+
 // _____________________________________________________________________________
 void Qlever::queryAndPinResultWithName(
     QueryExecutionContext::PinResultWithName options, std::string query) {
@@ -181,6 +363,7 @@ void Qlever::queryAndPinResultWithName(
   auto& [qet, qec, parsedQuery] = queryPlan;
   qec->pinResultWithName() = std::move(options);
   [[maybe_unused]] auto result = this->query(queryPlan);
+  persistNamedResultCacheIfChanged();
 }
 
 // _____________________________________________________________________________
@@ -191,24 +374,113 @@ void Qlever::queryAndPinResultWithName(std::string name, std::string query) {
 }
 
 // _____________________________________________________________________________
-void Qlever::clearNamedResultCache() { namedResultCache_.clear(); }
+void Qlever::clearNamedResultCache() {
+  namedResultCache_.clear();
+  persistNamedResultCacheIfChanged();
+}
 
 // _____________________________________________________________________________
 void Qlever::eraseResultWithName(std::string name) {
   namedResultCache_.erase(name);
+  persistNamedResultCacheIfChanged();
+}
+
+// _____________________________________________________________________________
+void Qlever::persistNamedResultCacheIfChanged() {
+  if (namedResultCacheFile_.empty()) {
+    return;
+  }
+  // The lock also prevents concurrent writes of the file.
+  auto persistedVersion = persistedNamedResultCacheVersion_.wlock();
+  size_t version = namedResultCache_.version();
+  if (version == *persistedVersion) {
+    return;
+  }
+  // Write to a temporary file first, s.t. a crash during the writing doesn't
+  // destroy the previous snapshot.
+  auto tmpFile = absl::StrCat(namedResultCacheFile_, ".tmp");
+  try {
+    {
+      ad_utility::serialization::FileWriteSerializer serializer{tmpFile};
+      serializer << index_->getIndexId();
+      writeNamedResultCacheToSerializer(serializer);
+    }
+    std::filesystem::rename(tmpFile, namedResultCacheFile_);
+    *persistedVersion = version;
+    AD_LOG_INFO << "Persisted " << namedResultCache_.numEntries()
+                << " named result(s) to \"" << namedResultCacheFile_ << "\""
+                << std::endl;
+  } catch (const std::exception& e) {
+    AD_LOG_ERROR << "Persisting the named results to \""
+                 << namedResultCacheFile_ << "\" failed: " << e.what()
+                 << std::endl;
+    std::error_code ec;
+    std::filesystem::remove(tmpFile, ec);
+  }
+}
+
+// _____________________________________________________________________________
+void Qlever::readPersistedNamedResultCache() {
+  if (!std::filesystem::exists(namedResultCacheFile_)) {
+    return;
+  }
+  try {
+    ad_utility::serialization::FileReadSerializer serializer{
+        namedResultCacheFile_};
+    std::string indexId;
+    serializer >> indexId;
+    if (indexId != index_->getIndexId()) {
+      AD_LOG_WARN << "The named results in \"" << namedResultCacheFile_
+                  << "\" were written for a different index and are ignored"
+                  << std::endl;
+      return;
+    }
+    readNamedResultCacheFromDisk(serializer);
+    AD_LOG_INFO << "Restored " << namedResultCache_.numEntries()
+                << " named result(s) from \"" << namedResultCacheFile_ << "\""
+                << std::endl;
+  } catch (const std::exception& e) {
+    AD_LOG_ERROR << "Reading the named results from \""
+                 << namedResultCacheFile_ << "\" failed: " << e.what()
+                 << std::endl;
+    namedResultCache_.clear();
+  }
+  // The restored contents don't have to be written again.
+  *persistedNamedResultCacheVersion_.wlock() = namedResultCache_.version();
 }
 
 // ___________________________________________________________________________
-Qlever::QueryPlan Qlever::parseAndPlanQuery(std::string query) const {
+ad_utility::AllocatorWithLimit<Id> Qlever::makeQueryAllocator() const {
+  auto budget = getRuntimeParameter<&RuntimeParameters::queryMaxMemory_>();
+  if (budget.getBytes() == 0) {
+    return allocator_;
+  }
+  return ad_utility::AllocatorWithLimit<Id>{
+      ad_utility::makeChildAllocationMemoryLeftThreadsafeObject(
+          allocator_.getMemoryLeft(), budget),
+      allocator_.clearOnAllocation()};
+}
+
+// ___________________________________________________________________________
+std::shared_ptr<QueryExecutionContext> Qlever::makeQueryExecutionContext(
+    QueryExecutionContext::DisableCaching disableCaching) const {
   auto qecPtr = std::make_shared<QueryExecutionContext>(
-      index_, &cache_, allocator_, sortPerformanceEstimator_,
+      index_, cache_.get(), makeQueryAllocator(), sortPerformanceEstimator_,
       &namedResultCache_, materializedViewsManager_, [](std::string) {}, false,
-      false, disableCaching_);
+      false, disableCaching);
+  qecPtr->setResultDiskCache(resultDiskCache_);
+  qecPtr->setSharedLazyResults(sharedLazyResults_);
+  return qecPtr;
+}
+
+// ___________________________________________________________________________
+Qlever::QueryPlan Qlever::parseAndPlanQuery(
+    std::string query, ad_utility::SharedCancellationHandle handle) const {
+  auto qecPtr = makeQueryExecutionContext(disableCaching_);
   // TODO<joka921> support Dataset clauses.
   auto parsedQuery = SparqlParser::parseQuery(
       &index_->getImpl().encodedIriManager(), std::move(query), {});
-  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
-  QueryPlanner qp{qecPtr.get(), handle};
+  QueryPlanner qp{qecPtr.get(), std::move(handle)};
   qp.setEnablePatternTrick(enablePatternTrick_);
   auto qet = qp.createExecutionTree(parsedQuery);
   qet.isRoot() = true;
@@ -217,6 +489,73 @@ Qlever::QueryPlan Qlever::parseAndPlanQuery(std::string query) const {
   return {qetPtr, std::move(qecPtr), std::move(parsedQuery)};
 }
 
+// ___________________________________________________________________________
+PreparedQuery Qlever::prepare(std::string query,
+                              std::vector<Variable> parameters) const {
+  if (parameters.empty()) {
+    throw std::invalid_argument(
+        "A prepared query needs at least one parameter");
+  }
+  auto qecPtr = makeQueryExecutionContext(disableCaching_);
+  auto parsedQuery = SparqlParser::parseQuery(
+      &index_->getImpl().encodedIriManager(), std::move(query), {});
+  for (const auto& parameter : parameters) {
+    if (!ad_utility::contains(parsedQuery.getVisibleVariables(), parameter)) {
+      throw std::invalid_argument(
+          absl::StrCat("The parameter ", parameter.name(),
+                       " of a prepared query is not visible in its body"));
+    }
+  }
+  // The parameters are the variables of an `ExternalValues` operation, the
+  // values of which are set by `bind`.
+  parsedQuery::ExternalValuesQuery externalValues;
+  externalValues.name_ = std::string{PreparedQuery::parametersName};
+  externalValues.variables_ = parameters;
+  auto& children = parsedQuery.children();
+  children.insert(children.begin(), std::move(externalValues));
+
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  QueryPlanner qp{qecPtr.get(), handle};
+  qp.setEnablePatternTrick(enablePatternTrick_);
+  auto qet = std::make_shared<QueryExecutionTree>(
+      qp.createExecutionTree(parsedQuery));
+  return {{std::move(qet), std::move(qecPtr), std::move(parsedQuery)},
+          std::move(parameters)};
+}
+
+// ___________________________________________________________________________
+Qlever::QueryPlan Qlever::bind(
+    const PreparedQuery& preparedQuery,
+    std::vector<std::vector<TripleComponent>> values) const {
+  const auto& parameters = preparedQuery.parameters();
+  for (const auto& row : values) {
+    if (row.size() != parameters.size()) {
+      throw std::invalid_argument(absl::StrCat(
+          "Each row of values for a prepared query must contain ",
+          parameters.size(), " values, but a row contains ", row.size()));
+    }
+  }
+  const auto& [preparedTree, preparedQec, parsedQuery] = preparedQuery.plan();
+  auto qecPtr = makeQueryExecutionContext(disableCaching_);
+  auto qet = preparedTree->clone();
+  qet->recursivelySetExecutionContext(qecPtr.get());
+  qet->isRoot() = true;
+
+  std::vector<ExternalValues*> externalValues;
+  qet->getRootOperation()->getExternalValues(externalValues);
+  auto it = ql::ranges::find(externalValues, PreparedQuery::parametersName,
+                             &ExternalValues::getName);
+  AD_CORRECTNESS_CHECK(it != externalValues.end());
+  parsedQuery::SparqlValues sparqlValues;
+  sparqlValues._variables = parameters;
+  sparqlValues._values = std::move(values);
+  (*it)->updateValues(std::move(sparqlValues));
+  // The cache keys of the ancestors of the `ExternalValues` contain the
+  // values.
+  qet->updateCacheKeysRecursively();
+  return {std::move(qet), std::move(qecPtr), parsedQuery};
+}
+
 // ___________________________________________________________________________
 void IndexBuilderConfig::validate() const {
   if (kScoringParam_ < 0) {
@@ -235,6 +574,15 @@ void IndexBuilderConfig::validate() const {
         "text index. If none are given the option to add words from literals "
         "has to be true. For details see --help."));
   }
+  for (const auto& predicate : transitiveClosurePredicates_) {
+    if (predicate.size() <= 2 || predicate.front() != '<' ||
+        predicate.back() != '>') {
+      throw std::invalid_argument(absl::StrCat(
+          "The predicates for which the transitive closure is precomputed "
+          "must be full IRIs in angle brackets, but got: ",
+          predicate));
+    }
+  }
 }
 
 // ___________________________________________________________________________
@@ -257,9 +605,13 @@ void Qlever::loadMaterializedView(std::string name) const {
 std::shared_ptr<QueryExecutionContext> Qlever::createQueryExecutionContext(
     std::function<void(std::string)> updateCallback, bool pinSubtrees,
     bool pinResult) {
-  return std::make_shared<QueryExecutionContext>(
-      sharedIndex(), &cache_, allocator_, sortPerformanceEstimator_,
+  auto qec = std::make_shared<QueryExecutionContext>(
+      sharedIndex(), cache_.get(), makeQueryAllocator(),
+      sortPerformanceEstimator_,
       &namedResultCache_, materializedViewsManager_, updateCallback,
       pinSubtrees, pinResult);
+  qec->setResultDiskCache(resultDiskCache_);
+  qec->setSharedLazyResults(sharedLazyResults_);
+  return qec;
 }
 }  // namespace qlever
@@ -7,9 +7,14 @@
 #ifndef QLEVER_SRC_LIBQLEVER_QLEVER_H
 #define QLEVER_SRC_LIBQLEVER_QLEVER_H
 
+#include <boost/asio/static_thread_pool.hpp>
+#include <chrono>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -18,12 +23,18 @@
 #include "engine/NamedResultCacheSerializer.h"
 #include "engine/QueryExecutionContext.h"
 #include "engine/QueryPlanner.h"
+#include "engine/QueryResultDiskCache.h"
+#include "engine/SharedLazyResults.h"
+#include "global/Constants.h"
 #include "global/RuntimeParameters.h"
 #include "index/Index.h"
 #include "index/InputFileSpecification.h"
+#include "libqlever/IdTableResult.h"
 #include "libqlever/QleverTypes.h"
 #include "util/AllocatorWithLimit.h"
+#include "util/CancellationHandle.h"
 #include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
 #include "util/http/MediaTypes.h"
 
 namespace qlever {
@@ -105,6 +116,12 @@ struct IndexBuilderConfig : CommonConfig {
   // building the index are not deleted. This can be useful for debugging.
   bool keepTemporaryFiles_ = false;
 
+  // If set to true and no patterns are built, the OSP/OPS and the PSO/POS
+  // permutations are sorted during the same pass over the input and then
+  // written concurrently. This makes better use of many cores, but the memory
+  // of the sorters (see `memoryLimit_`) is split between both sorters.
+  bool writePermutationsConcurrently_ = false;
+
   // A list of IRI prefixes (without angle brackets). IRIs that start with one
   // of these prefixes, followed by a sequence of a bounded number of digits
   // are encoded directly in the internal ID. This reduces the size of the
@@ -115,6 +132,14 @@ struct IndexBuilderConfig : CommonConfig {
   // https://github.com/ad-freiburg/qlever/pull/2299 for the details and
   // limitations regarding the correctness of FILTER and ORDER BY.
   std::vector<std::string> prefixesForIdEncodedIris_;
+  // Like `prefixesForIdEncodedIris_`, but for IRIs of which the prefix is
+  // followed by a fixed number of lowercase hexadecimal digits. The prefixes
+  // have the form `<width>:<prefix>`, e.g. `8:http://example.org/`.
+  std::vector<std::string> hexPrefixesForIdEncodedIris_;
+  // If true, plain literals with at most 7 ASCII characters and without a
+  // language tag or datatype (e.g. "yes" or "DE") are also encoded directly in
+  // the internal ID. The same limitations as for the encoded IRIs apply.
+  bool inlineShortLiterals_ = false;
 
   // The remaining members of this class, are only relevant if a full-text
   // index is built in addition to the RDF index. By default, no fulltext index
@@ -147,6 +172,25 @@ struct IndexBuilderConfig : CommonConfig {
       std::vector<std::pair<std::string, std::string>>;
   WriteMaterializedViews writeMaterializedViews_;
 
+  // Predicates (full IRIs in angle brackets) for which the transitive closure
+  // is precomputed after the normal index build is complete. Transitive paths
+  // like `?x <p>* ?y` can then be evaluated without a graph search. See
+  // `MaterializedViewsManager::getTransitiveClosureView` for details.
+  std::vector<std::string> transitiveClosurePredicates_;
+
+  // If true, the facet statistics for faceted browsing (the number of
+  // subjects per class and predicate, and per predicate and object) are
+  // precomputed after the normal index build is complete. Matching `GROUP BY`
+  // queries are then answered by a scan. See
+  // `materializedViewsQueryAnalysis::FacetStatistics` for details.
+  bool facetStatistics_ = false;
+
+  // If true, an index of the trigrams of the literals in the vocabulary is
+  // built after the normal index build is complete. Substring filters like
+  // `CONTAINS` and `REGEX` then only have to check the literals that contain
+  // all the trigrams of the substring. See `VocabularyNgramIndex` for details.
+  bool vocabularyNgramIndex_ = false;
+
   // Assert that the given configuration is valid.
   void validate() const;
 
@@ -174,6 +218,17 @@ struct EngineConfig : CommonConfig {
   // simply delete this file.
   bool persistUpdates_ = true;
 
+  // If non-empty, the results of expensive operations are additionally stored
+  // in files in this directory, see `QueryResultDiskCache.h`.
+  std::string resultCacheDirectory_;
+
+  // If set to true, the results that are pinned with a name (see
+  // `NamedResultCache`), including their geometry indexes, are written to the
+  // file `basename.named-results` whenever they change, and read from this
+  // file when the engine is started again. The file is ignored if it was
+  // written for a different index (see `Index::getIndexId`).
+  bool persistNamedResults_ = false;
+
   // If set to true, no permutations will be loaded from disk. This is useful
   // when only queries that don't require accessing the permutations need to be
   // executed (e.g., queries that only compute constant expressions, or query
@@ -181,6 +236,11 @@ struct EngineConfig : CommonConfig {
   // separately).
   bool doNotLoadPermutations_ = false;
 
+  // If set to true, the SPO, SOP, OPS, and OSP permutations are only loaded
+  // from disk when they are first used (by a query, or before the first
+  // update).
+  bool lazyLoadPermutations_ = false;
+
   // A list of IRI prefixes that are allowed as `SERVICE` endpoints. If empty
   // (the default), all IRIs are allowed. If non-empty, `SERVICE` requests to
   // IRIs that do not start with any of the given prefixes are rejected.
@@ -194,31 +254,142 @@ struct EngineConfig : CommonConfig {
   // Names of materialized views to load from disk during initialization.
   // If a view doesn't exist, a warning is logged and startup continues.
   std::vector<std::string> preloadMaterializedViews_ = {};
+
+  // The number of threads on which the queries of `Qlever::queryAsync` are
+  // executed concurrently. The threads are only started by the first call to
+  // `queryAsync`.
+  size_t numThreadsForAsyncQueries_ = 4;
+};
+
+// The options for the asynchronous execution of a query, see
+// `Qlever::queryAsync`.
+struct AsyncQueryOptions {
+  ad_utility::MediaType mediaType_ = ad_utility::MediaType::sparqlJson;
+  // If set, the query is cancelled (with `CancellationState::TIMEOUT`) if it
+  // has not finished within this time after the call to `queryAsync`. The
+  // time also includes the waiting for a free thread.
+  std::optional<std::chrono::milliseconds> timeout_;
+  // With this handle, the embedding application can cancel the query at any
+  // time via `cancel(ad_utility::CancellationState::MANUAL)`. If `nullptr`, a
+  // new handle is used.
+  ad_utility::SharedCancellationHandle cancellationHandle_;
+};
+
+// A query that is parsed and planned once (via `Qlever::prepare`) and can then
+// be executed many times with different values for some of its variables (the
+// parameters), see `Qlever::bind`.
+class PreparedQuery {
+ public:
+  // The name of the `ExternalValues` operation that contains the values of
+  // the parameters.
+  static constexpr std::string_view parametersName =
+      "prepared-query-parameters";
+
+ private:
+  friend class Qlever;
+  // The query plan, the execution tree of which is only cloned, but never
+  // executed.
+  QueryPlan plan_;
+  std::vector<Variable> parameters_;
+
+  PreparedQuery(QueryPlan plan, std::vector<Variable> parameters)
+      : plan_{std::move(plan)}, parameters_{std::move(parameters)} {}
+
+ public:
+  const std::vector<Variable>& parameters() const { return parameters_; }
+  const QueryPlan& plan() const { return plan_; }
 };
 
 // Class to use QLever as an embedded database, without the HTTP server. See
 // `src/engine/LibQleverExample.cpp` for an example use.
 class Qlever {
  private:
-  // The cache is threadsafe, so making it `mutable` is reasonably safe.
-  mutable QueryResultCache cache_;
+  // The cache and the allocator are possibly shared with other `Qlever`
+  // instances (see `SharedResources`). The cache is threadsafe.
+  std::shared_ptr<QueryResultCache> cache_;
   ad_utility::AllocatorWithLimit<Id> allocator_;
   SortPerformanceEstimator sortPerformanceEstimator_;
   std::shared_ptr<Index> index_;
   mutable NamedResultCache namedResultCache_;
+  // The file to which the `namedResultCache_` is persisted, or the empty
+  // string if the named results are not persisted (see
+  // `persistNamedResults_`).
+  std::string namedResultCacheFile_;
+  // The `version()` of the `namedResultCache_` that was last persisted.
+  ad_utility::Synchronized<size_t> persistedNamedResultCacheVersion_{0};
+  // The optional on-disk tier of the `cache_` (`nullptr` if there is none).
+  std::shared_ptr<const QueryResultDiskCache> resultDiskCache_;
+  // The lazy results that are shared between concurrent queries.
+  std::shared_ptr<SharedLazyResults> sharedLazyResults_ =
+      std::make_shared<SharedLazyResults>();
   std::shared_ptr<MaterializedViewsManager> materializedViewsManager_ =
       std::make_shared<MaterializedViewsManager>();
   bool enablePatternTrick_;
   QueryExecutionContext::DisableCaching disableCaching_;
 
+  // The threads for `queryAsync`, and a separate thread for the timers of the
+  // timeouts. They are created by the first call to `queryAsync` and declared
+  // last, s.t. the running queries are finished before the other members are
+  // destroyed. Queries that are still waiting for a thread at that time are
+  // dropped (their futures report a `std::future_error`).
+  struct AsyncExecutor {
+    boost::asio::static_thread_pool queryThreads_;
+    boost::asio::static_thread_pool timerThread_{1};
+    explicit AsyncExecutor(size_t numThreads) : queryThreads_{numThreads} {}
+  };
+  size_t numThreadsForAsyncQueries_;
+  mutable std::once_flag asyncExecutorOnceFlag_;
+  mutable std::unique_ptr<AsyncExecutor> asyncExecutor_;
+
+  // Return the allocator for a single query. If the runtime parameter
+  // `query-max-memory` is set, the allocator has its own limit within the
+  // limit of the `allocator_`, s.t. a single query can't use up all the memory
+  // and the peak memory usage of its operations only contains the memory of
+  // this query.
+  ad_utility::AllocatorWithLimit<Id> makeQueryAllocator() const;
+
+  // Create the context for the execution of a single query with the given
+  // setting for the caching.
+  std::shared_ptr<QueryExecutionContext> makeQueryExecutionContext(
+      QueryExecutionContext::DisableCaching disableCaching) const;
+
+  // Read the named results from the `namedResultCacheFile_` if it exists and
+  // was written for the current index.
+  void readPersistedNamedResultCache();
+
+  // The implementation of both overloads of `queryAsync`. The query plan is
+  // created by `makePlan` (on the thread of the query).
+  std::future<std::string> queryAsyncImpl(
+      std::function<QueryPlan(ad_utility::SharedCancellationHandle)> makePlan,
+      AsyncQueryOptions options) const;
+
  public:
   // Build an index, using an `IndexBuilderConfig` as explained above.
   static void buildIndex(IndexBuilderConfig config);
 
+  // The resources that several `Qlever` instances in the same process (e.g.
+  // for different datasets) can share, s.t. the memory and the space in the
+  // cache go to whichever instance currently needs them. The results of the
+  // different indices are kept apart in the shared cache (see `QueryCacheKey`).
+  struct SharedResources {
+    std::shared_ptr<QueryResultCache> cache_;
+    ad_utility::AllocatorWithLimit<Id> allocator_;
+  };
+
+  // Create the resources with the given `memoryLimit` for the queries of all
+  // the instances. When an allocation would exceed the limit, entries are
+  // removed from the cache as far as possible.
+  static SharedResources makeSharedResources(
+      ad_utility::MemorySize memoryLimit);
+
   // Create a QLever instance for querying using an `EngineConfig` as
   // explained above.
   explicit Qlever(const EngineConfig& config);
 
+  // Create a QLever instance that uses the given `resources`, which may also be
+  // used by other instances. The `memoryLimit_` of the `config` is ignored.
+  Qlever(const EngineConfig& config, SharedResources resources);
+
   // Parse and plan the given `query`.
   //
   // NOTE: This is useful as a separate function for the following reasons.
@@ -231,8 +402,36 @@ class Qlever {
   //
   // 3. It enables an inspection or even modification of the query plan before
   // executing it (this requires some expertise).
+  //
+  // The `cancellationHandle` is checked during the query planning.
   using QueryPlan = qlever::QueryPlan;
-  QueryPlan parseAndPlanQuery(std::string query) const;
+  QueryPlan parseAndPlanQuery(
+      std::string query,
+      ad_utility::SharedCancellationHandle cancellationHandle =
+          std::make_shared<ad_utility::CancellationHandle<>>()) const;
+
+  // Parse and plan the given `query`, in which the given `parameters` are
+  // placeholders for values that are only specified when the query is
+  // executed (via `bind`). Each parameter must be a variable that is visible
+  // in the body of the query. The parameters are joined with the rest of the
+  // query like a VALUES clause, and the query is planned under the assumption
+  // that only few values are bound to them.
+  //
+  // NOTE: The executions of a prepared query use the cache for query results
+  // (unless caching is disabled for this engine): The subtrees that don't
+  // depend on the parameters are only computed once, and the others are
+  // recomputed for new values of the parameters (see `ExternalValues`).
+  PreparedQuery prepare(std::string query,
+                        std::vector<Variable> parameters) const;
+
+  // Return a plan for the `preparedQuery` with the given `values` for its
+  // parameters, without parsing or planning the query again. Each element of
+  // the `values` is a row with one value for each of the parameters (in the
+  // order of `PreparedQuery::parameters`), as in a VALUES clause. The returned
+  // plan can be executed via `query` and is independent of other plans for
+  // the same `preparedQuery`, so these can be executed concurrently.
+  QueryPlan bind(const PreparedQuery& preparedQuery,
+                 std::vector<std::vector<TripleComponent>> values) const;
 
   // Run the given parsed and planned query. The result is returned as a
   // string; see `src/util/http/MediaTypes.h` for the supported formats.
@@ -240,20 +439,50 @@ class Qlever {
   // NOTE: With `ad_utility::MediaType::qleverJson`, the result also contains
   // detailed information on the query execution, including timings of the
   // various parts of the query plan.
-  std::string query(const QueryPlan& queryPlan,
-                    ad_utility::MediaType mediaType =
-                        ad_utility::MediaType::sparqlJson) const;
+  //
+  // The query is aborted with an `ad_utility::CancellationException` when the
+  // `cancellationHandle` is cancelled (e.g. from another thread).
+  std::string query(
+      const QueryPlan& queryPlan,
+      ad_utility::MediaType mediaType = ad_utility::MediaType::sparqlJson,
+      ad_utility::SharedCancellationHandle cancellationHandle =
+          std::make_shared<ad_utility::CancellationHandle<>>()) const;
 
   // Plan, parse, and execute a query using a single function call. This is
   // equivalent to calling `parseAndPlanQuery` followed by `query`.
   //
-  // TODO: Also support timeouts, manual cancellation, updates, live timings
-  // while the query is running, etc, These are all supported by QLever, but
-  // not by this class yet.
+  // TODO: Also support updates, live timings while the query is running, etc.
+  // These are all supported by QLever, but not by this class yet.
   std::string query(std::string query,
                     ad_utility::MediaType mediaType =
                         ad_utility::MediaType::sparqlJson) const;
 
+  // Parse, plan, and execute the `query` on one of the threads of this
+  // instance (see `numThreadsForAsyncQueries_`) and return a future for the
+  // result (which rethrows the exception if the query failed). Many queries
+  // can be executed concurrently this way, like the queries of the HTTP
+  // server. See `AsyncQueryOptions` for timeouts and manual cancellation.
+  std::future<std::string> queryAsync(std::string query,
+                                      AsyncQueryOptions options = {}) const;
+
+  // Same as above, but for a query that has already been parsed and planned.
+  // The `queryPlan` must not be executed concurrently by another call.
+  std::future<std::string> queryAsync(QueryPlan queryPlan,
+                                      AsyncQueryOptions options = {}) const;
+
+  // Run the given parsed and planned SELECT query, and return the result as
+  // blocks of `IdTable`s without serializing it, see `IdTableResult`. The
+  // `cancellationHandle` is checked before each block.
+  IdTableResult queryIdTables(
+      QueryPlan queryPlan,
+      ad_utility::SharedCancellationHandle cancellationHandle =
+          std::make_shared<ad_utility::CancellationHandle<>>()) const;
+
+  // Plan, parse, and execute a SELECT query and return the result as
+  // `IdTable`s. This is equivalent to calling `parseAndPlanQuery` followed by
+  // `queryIdTables`.
+  IdTableResult queryIdTables(std::string query) const;
+
   // Plan, parse, and execute the given `query` and pin the result to the cache
   // with the given options (name and possibly request for building a geometry
   // index). This result can then be reused in a query as follows: `SERVICE
@@ -269,6 +498,15 @@ class Qlever {
   // Completely clear the `NamedResultCache`.
   void clearNamedResultCache();
 
+  // If the named results are persisted (see `persistNamedResults_`) and the
+  // `NamedResultCache` has changed since it was last persisted, write its
+  // contents to disk. This is called by the functions of this class that
+  // change the named results, but has to be called explicitly when they are
+  // changed otherwise (e.g. by a query with `pinResultWithName()` that is not
+  // executed via `queryAndPinResultWithName`). Errors are only logged,
+  // because the named results are still available in memory.
+  void persistNamedResultCacheIfChanged();
+
   // Write a new materialized view with `name` to disk and store the result of
   // `query`.
   void writeMaterializedView(std::string name, std::string query) const;
@@ -304,8 +542,8 @@ class Qlever {
   Index& index() { return *index_; }
   const Index& index() const { return *index_; }
 
-  QueryResultCache& cache() { return cache_; }
-  const QueryResultCache& cache() const { return cache_; }
+  QueryResultCache& cache() { return *cache_; }
+  const QueryResultCache& cache() const { return *cache_; }
 
   ad_utility::AllocatorWithLimit<Id>& allocator() { return allocator_; }
   const ad_utility::AllocatorWithLimit<Id>& allocator() const {
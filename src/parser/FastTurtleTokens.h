@@ -0,0 +1,158 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_PARSER_FASTTURTLETOKENS_H
+#define QLEVER_SRC_PARSER_FASTTURTLETOKENS_H
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#include "backports/StartsWithAndEndsWith.h"
+#include "parser/TurtleTokenId.h"
+
+// Hand-written matchers for the tokens that make up (almost) all of the
+// N-Triples and N-Quads input, namely IRI references, blank node labels,
+// language tags, `^^` and `.`. The regexes of the `Tokenizer` and the
+// `TokenizerCtre` are matched one token at a time, which dominates the time
+// of parsing such input. The matchers here only classify the bytes of the
+// input with a lookup table. They handle the common (ASCII-only and
+// escape-free) cases and report when an input has to be matched by the
+// regular tokenizer instead, which thus remains the validating fallback.
+namespace fastTurtleTokens {
+
+namespace detail {
+// A lookup table with one entry per byte value.
+using ByteTable = std::array<bool, 256>;
+
+constexpr ByteTable makeTable(std::string_view chars) {
+  ByteTable result{};
+  for (char c : chars) {
+    result[static_cast<unsigned char>(c)] = true;
+  }
+  return result;
+}
+
+constexpr ByteTable unionOf(ByteTable a, const ByteTable& b) {
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = a[i] || b[i];
+  }
+  return a;
+}
+
+constexpr ByteTable letters =
+    makeTable("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ");
+constexpr ByteTable digits = makeTable("0123456789");
+constexpr ByteTable lettersAndDigits = unionOf(letters, digits);
+
+// The first character of a blank node label (`PN_CHARS_U` or a digit).
+constexpr ByteTable blankNodeLabelBegin =
+    unionOf(lettersAndDigits, makeTable("_"));
+// The other characters of a blank node label (`PN_CHARS` or `.`).
+constexpr ByteTable blankNodeLabelRest =
+    unionOf(blankNodeLabelBegin, makeTable("-."));
+
+// The ASCII characters that may appear in an IRI reference without being
+// escaped: everything except for `\x00`-`\x20` and `<>"{}|^`\`.
+constexpr ByteTable irirefChars = []() {
+  ByteTable result{};
+  for (size_t c = 0x21; c < 0x80; ++c) {
+    result[c] = true;
+  }
+  for (char c : std::string_view{"<>\"{}|^`\\"}) {
+    result[static_cast<unsigned char>(c)] = false;
+  }
+  return result;
+}();
+
+// Return the number of bytes at the beginning of `input` (starting at
+// position `begin`) that are contained in the `table`.
+inline size_t spanOf(std::string_view input, size_t begin,
+                     const ByteTable& table) {
+  size_t i = begin;
+  while (i < input.size() && table[static_cast<unsigned char>(input[i])]) {
+    ++i;
+  }
+  return i - begin;
+}
+
+inline bool isNonAscii(std::string_view input, size_t position) {
+  return position < input.size() &&
+         static_cast<unsigned char>(input[position]) >= 0x80;
+}
+}  // namespace detail
+
+// Match the token with the given `id` at the beginning of the `input`. Return
+// the length of the match, which is `0` if the input definitely doesn't start
+// with the token. Return `std::nullopt` if the result can't be determined by
+// the fast path (e.g. because of escape sequences or non-ASCII characters) or
+// if there is no fast path for the token. In that case the input has to be
+// matched by the regular tokenizer. The lengths are always the same as the
+// ones of the regexes of the `Tokenizer`.
+template <TurtleTokenId id>
+std::optional<size_t> match(std::string_view input) {
+  using namespace detail;
+  if constexpr (id == TurtleTokenId::Dot) {
+    return ql::starts_with(input, '.') ? 1 : 0;
+  } else if constexpr (id == TurtleTokenId::DoubleCircumflex) {
+    return ql::starts_with(input, "^^") ? 2 : 0;
+  } else if constexpr (id == TurtleTokenId::Iriref) {
+    if (!ql::starts_with(input, '<')) {
+      return 0;
+    }
+    size_t end = 1 + spanOf(input, 1, irirefChars);
+    if (end < input.size() && input[end] == '>') {
+      return end + 1;
+    }
+    // An escape sequence, a non-ASCII character, or an invalid IRI.
+    return std::nullopt;
+  } else if constexpr (id == TurtleTokenId::BlankNodeLabel) {
+    if (!ql::starts_with(input, "_:")) {
+      return 0;
+    }
+    if (input.size() < 3 ||
+        !blankNodeLabelBegin[static_cast<unsigned char>(input[2])]) {
+      return std::nullopt;
+    }
+    size_t end = 3 + spanOf(input, 3, blankNodeLabelRest);
+    // The label might be continued by a non-ASCII character.
+    if (isNonAscii(input, end)) {
+      return std::nullopt;
+    }
+    // A blank node label must not end with a `.`.
+    while (input[end - 1] == '.') {
+      --end;
+    }
+    return end;
+  } else if constexpr (id == TurtleTokenId::Langtag) {
+    if (!ql::starts_with(input, '@')) {
+      return 0;
+    }
+    size_t end = 1 + spanOf(input, 1, letters);
+    if (end == 1) {
+      return 0;
+    }
+    // Subtags of the form `-[a-zA-Z0-9]+`.
+    while (end < input.size() && input[end] == '-') {
+      size_t subtagSize = spanOf(input, end + 1, lettersAndDigits);
+      if (subtagSize == 0) {
+        break;
+      }
+      end += 1 + subtagSize;
+    }
+    return end;
+  } else {
+    return std::nullopt;
+  }
+}
+
+}  // namespace fastTurtleTokens
+
+#endif  // QLEVER_SRC_PARSER_FASTTURTLETOKENS_H
@@ -0,0 +1,155 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "parser/GraphAnalyticsQuery.h"
+
+#include <string_view>
+
+#include "parser/MagicServiceIriConstants.h"
+#include "parser/SparqlTriple.h"
+
+namespace parsedQuery {
+
+namespace {
+// Return the value of the parameter with the given `name`, which has to be a
+// non-negative integer.
+size_t getNonNegativeInt(std::string_view name, const TripleComponent& object) {
+  if (!object.isInt() || object.getInt() < 0) {
+    throw GraphAnalyticsException(absl::StrCat(
+        "The parameter <", name, "> expects a non-negative integer"));
+  }
+  return static_cast<size_t>(object.getInt());
+}
+}  // namespace
+
+// ____________________________________________________________________________
+void GraphAnalyticsQuery::addParameter(const SparqlTriple& triple) {
+  auto simpleTriple = triple.getSimple();
+  TripleComponent predicate = simpleTriple.p_;
+  TripleComponent object = simpleTriple.o_;
+
+  auto predString = extractParameterName(predicate, GRAPH_ANALYTICS_IRI);
+
+  if (predString == "algorithm") {
+    if (!object.isIri()) {
+      throw GraphAnalyticsException("The <algorithm> value has to be an IRI");
+    }
+    auto objString = extractParameterName(object, GRAPH_ANALYTICS_IRI);
+    if (objString == "pageRank") {
+      algorithm_ = GraphAnalyticsAlgorithm::PAGE_RANK;
+    } else if (objString == "connectedComponents") {
+      algorithm_ = GraphAnalyticsAlgorithm::CONNECTED_COMPONENTS;
+    } else if (objString == "kHopNeighborhood") {
+      algorithm_ = GraphAnalyticsAlgorithm::K_HOP_NEIGHBORHOOD;
+    } else {
+      throw GraphAnalyticsException(absl::StrCat(
+          "Unsupported algorithm in graph analytics: ", objString,
+          ". Supported algorithms: <pageRank>, <connectedComponents>, "
+          "<kHopNeighborhood>."));
+    }
+  } else if (predString == "source") {
+    setVariable("source", object, source_);
+  } else if (predString == "target") {
+    setVariable("target", object, target_);
+  } else if (predString == "node") {
+    setVariable("node", object, node_);
+  } else if (predString == "value") {
+    setVariable("value", object, value_);
+  } else if (predString == "numIterations") {
+    numIterations_ = getNonNegativeInt("numIterations", object);
+  } else if (predString == "dampingFactor") {
+    std::optional<double> value;
+    if (object.isDouble()) {
+      value = object.getDouble();
+    } else if (object.isInt()) {
+      value = static_cast<double>(object.getInt());
+    }
+    if (!value.has_value() || value.value() < 0 || value.value() > 1) {
+      throw GraphAnalyticsException(
+          "The parameter <dampingFactor> expects a number between 0 and 1");
+    }
+    dampingFactor_ = value;
+  } else if (predString == "start") {
+    if (object.isVariable()) {
+      throw GraphAnalyticsException(
+          "The parameter <start> expects an IRI or a literal, not a variable");
+    }
+    startNodes_.push_back(std::move(object));
+  } else if (predString == "maxNumHops") {
+    maxNumHops_ = getNonNegativeInt("maxNumHops", object);
+  } else {
+    throw GraphAnalyticsException(absl::StrCat(
+        "Unsupported argument <", predString,
+        "> in graph analytics. Supported arguments: <algorithm>, <source>, "
+        "<target>, <node>, <value>, <numIterations>, <dampingFactor>, "
+        "<start>, <maxNumHops>."));
+  }
+}
+
+// ____________________________________________________________________________
+void GraphAnalyticsQuery::validate() const {
+  auto throwIfMissing = [](const auto& parameter, std::string_view name) {
+    if (!parameter.has_value()) {
+      throw GraphAnalyticsException(absl::StrCat(
+          "Missing parameter <", name, "> in graph analytics."));
+    }
+  };
+  throwIfMissing(algorithm_, "algorithm");
+  throwIfMissing(source_, "source");
+  throwIfMissing(target_, "target");
+  throwIfMissing(node_, "node");
+  throwIfMissing(value_, "value");
+  if (!childGraphPattern_.has_value()) {
+    throw GraphAnalyticsException(
+        "The graph analytics service requires a group graph pattern that "
+        "contains the edges of the graph.");
+  }
+
+  using Algorithm = GraphAnalyticsAlgorithm;
+  auto algorithm = algorithm_.value();
+  if (algorithm != Algorithm::PAGE_RANK &&
+      (numIterations_.has_value() || dampingFactor_.has_value())) {
+    throw GraphAnalyticsException(
+        "The parameters <numIterations> and <dampingFactor> are only "
+        "supported by the algorithm <pageRank>.");
+  }
+  if (algorithm != Algorithm::K_HOP_NEIGHBORHOOD &&
+      (!startNodes_.empty() || maxNumHops_.has_value())) {
+    throw GraphAnalyticsException(
+        "The parameters <start> and <maxNumHops> are only supported by the "
+        "algorithm <kHopNeighborhood>.");
+  }
+  if (algorithm == Algorithm::K_HOP_NEIGHBORHOOD && startNodes_.empty()) {
+    throw GraphAnalyticsException(
+        "The algorithm <kHopNeighborhood> requires at least one <start> "
+        "node.");
+  }
+}
+
+// ____________________________________________________________________________
+GraphAnalyticsConfiguration GraphAnalyticsQuery::toGraphAnalyticsConfiguration(
+    const IndexImpl& index) const {
+  validate();
+  GraphAnalyticsConfiguration config{algorithm_.value(), source_.value(),
+                                     target_.value(), node_.value(),
+                                     value_.value()};
+  config.numIterations_ = numIterations_.value_or(config.numIterations_);
+  config.dampingFactor_ = dampingFactor_.value_or(config.dampingFactor_);
+  config.maxNumHops_ = maxNumHops_.value_or(config.maxNumHops_);
+  for (const auto& startNode : startNodes_) {
+    LocalVocab localVocab;
+    auto id = TripleComponent{startNode}.toValueId(index, localVocab);
+    if (id.getDatatype() != Datatype::LocalVocabIndex) {
+      config.startNodes_.push_back(id);
+    }
+  }
+  return config;
+}
+
+}  // namespace parsedQuery
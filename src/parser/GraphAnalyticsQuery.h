@@ -0,0 +1,75 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_PARSER_GRAPHANALYTICSQUERY_H
+#define QLEVER_SRC_PARSER_GRAPHANALYTICSQUERY_H
+
+#include "engine/GraphAnalytics.h"
+#include "index/Index.h"
+#include "parser/MagicServiceQuery.h"
+
+class SparqlTriple;
+
+namespace parsedQuery {
+
+class GraphAnalyticsException : public std::runtime_error {
+  // Constructors have to be explicitly inherited
+  using std::runtime_error::runtime_error;
+};
+
+// The `GraphAnalyticsQuery` holds the parameters of the graph analytics
+// service, which runs an algorithm on the graph that is formed by the edges
+// from `source` to `target` of the child graph pattern. For example:
+//
+// SELECT ?node ?rank {
+//   SERVICE <https://qlever.cs.uni-freiburg.de/graphAnalytics/> {
+//     _:config <algorithm> <pageRank> ;
+//              <source> ?s ; <target> ?t ;
+//              <node> ?node ; <value> ?rank .
+//     { ?s <follows> ?t }
+//   }
+// }
+//
+// The supported algorithms are `<pageRank>` (with the optional parameters
+// `<numIterations>` and `<dampingFactor>`), `<connectedComponents>` (the value
+// is the smallest node of the weakly connected component), and
+// `<kHopNeighborhood>` (with one or more `<start>` nodes and the optional
+// `<maxNumHops>`, the value is the number of hops).
+struct GraphAnalyticsQuery : MagicServiceQuery {
+  std::optional<GraphAnalyticsAlgorithm> algorithm_;
+  std::optional<Variable> source_;
+  std::optional<Variable> target_;
+  std::optional<Variable> node_;
+  std::optional<Variable> value_;
+  std::optional<size_t> numIterations_;
+  std::optional<double> dampingFactor_;
+  std::vector<TripleComponent> startNodes_;
+  std::optional<size_t> maxNumHops_;
+
+  // See MagicServiceQuery
+  void addParameter(const SparqlTriple& triple) override;
+
+  // Check that all the required parameters are set, and that the parameters
+  // fit the algorithm.
+  void validate() const override;
+
+  // Convert this query into a `GraphAnalyticsConfiguration`. The start nodes
+  // that are not contained in the vocabulary of the `index` are ignored,
+  // because they can't be nodes of the graph.
+  GraphAnalyticsConfiguration toGraphAnalyticsConfiguration(
+      const IndexImpl& index) const;
+
+  constexpr std::string_view name() const override {
+    return "graph analytics";
+  };
+};
+
+}  // namespace parsedQuery
+
+#endif  // QLEVER_SRC_PARSER_GRAPHANALYTICSQUERY_H
@@ -44,7 +44,8 @@ struct BasicGraphPatternsInvariantTo {
             pq::BasicGraphPattern, pq::Service, pq::PathQuery, pq::SpatialQuery,
             pq::TextSearchQuery, pq::Minus, pq::GroupGraphPattern, pq::Describe,
             pq::Load, pq::NamedCachedResult, pq::MaterializedViewQuery,
-            pq::ExternalValuesQuery>);
+            pq::ExternalValuesQuery, pq::GraphAnalyticsQuery,
+            pq::WindowFunctionsQuery>);
     return false;
   }
 };
@@ -16,6 +16,7 @@
 #include "engine/sparqlExpressions/SparqlExpressionPimpl.h"
 #include "parser/DatasetClauses.h"
 #include "parser/ExternalValuesQuery.h"
+#include "parser/GraphAnalyticsQuery.h"
 #include "parser/GraphPattern.h"
 #include "parser/MaterializedViewQuery.h"
 #include "parser/NamedCachedResult.h"
@@ -23,6 +24,7 @@
 #include "parser/SpatialQuery.h"
 #include "parser/TextSearchQuery.h"
 #include "parser/TripleComponent.h"
+#include "parser/WindowFunctionsQuery.h"
 #include "rdfTypes/Variable.h"
 #include "util/TransparentFunctors.h"
 #include "util/VisitMixin.h"
@@ -234,7 +236,8 @@ using GraphPatternOperationVariant =
     std::variant<Optional, Union, Subquery, TransPath, Bind, BasicGraphPattern,
                  Values, Service, PathQuery, SpatialQuery, TextSearchQuery,
                  Minus, GroupGraphPattern, Describe, Load, NamedCachedResult,
-                 MaterializedViewQuery, ExternalValuesQuery>;
+                 MaterializedViewQuery, ExternalValuesQuery,
+                 GraphAnalyticsQuery, WindowFunctionsQuery>;
 struct GraphPatternOperation
     : public GraphPatternOperationVariant,
       public VisitMixin<GraphPatternOperation, GraphPatternOperationVariant> {
@@ -24,6 +24,12 @@ constexpr inline std::string_view SPATIAL_SEARCH_IRI =
 constexpr inline std::string_view TEXT_SEARCH_IRI =
     "<https://qlever.cs.uni-freiburg.de/textSearch/>";
 
+constexpr inline std::string_view GRAPH_ANALYTICS_IRI =
+    "<https://qlever.cs.uni-freiburg.de/graphAnalytics/>";
+
+constexpr inline std::string_view WINDOW_FUNCTIONS_IRI =
+    "<https://qlever.cs.uni-freiburg.de/windowFunctions/>";
+
 constexpr inline std::string_view EXTERNAL_VALUES_IRI =
     "<https://qlever.cs.uni-freiburg.de/external-values/>";
 
@@ -9,6 +9,13 @@
 
 #include "parser/ParallelBuffer.h"
 
+#include <zstd.h>
+
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "backports/StartsWithAndEndsWith.h"
 #include "util/StringUtils.h"
 
 // _________________________________________________________________________
@@ -47,6 +54,26 @@ std::optional<ParallelBuffer::BufferType> ParallelFileBuffer::getNextBlock() {
   return ret;
 }
 
+// _____________________________________________________________________________
+std::optional<ParallelBuffer::BufferType>
+ParallelBufferFromByteSpans::getNextBlock() {
+  if (!iterator_.has_value()) {
+    iterator_ = byteSpans_.begin();
+  }
+  auto& it = iterator_.value();
+  BufferType block;
+  while (it != byteSpans_.end() && block.size() < blocksize_) {
+    auto bytes = *it;
+    const auto* chars = reinterpret_cast<const char*>(bytes.data());
+    block.insert(block.end(), chars, chars + bytes.size());
+    ++it;
+  }
+  if (block.empty()) {
+    return std::nullopt;
+  }
+  return block;
+}
+
 // ____________________________________________________________________________
 std::optional<size_t> ParallelBufferWithEndRegex::findRegexNearEnd(
     const BufferType& vec, const re2::RE2& regex) {
@@ -137,3 +164,162 @@ ParallelBufferWithEndRegex::getNextBlock() {
                     rawInput->end());
   return result;
 }
+
+// _____________________________________________________________________________
+std::optional<ParallelBuffer::BufferType>
+ParallelBufferWithTurtleStatementEnds::getNextBlock() {
+  directivesInLastBlock_.clear();
+  while (!exhausted_) {
+    auto rawInput = rawBuffer_->getNextBlock();
+    if (!rawInput) {
+      exhausted_ = true;
+      break;
+    }
+    remainder_.insert(remainder_.end(), rawInput->begin(), rawInput->end());
+    scanner_.scan(std::string_view{remainder_.data(), remainder_.size()},
+                  false);
+    auto endOfLastStatement = scanner_.endOfLastStatement();
+    if (endOfLastStatement == 0) {
+      // There is no complete statement yet, so we need more input.
+      continue;
+    }
+    BufferType result = std::move(remainder_);
+    remainder_.clear();
+    remainder_.insert(remainder_.end(), result.begin() + endOfLastStatement,
+                      result.end());
+    result.resize(endOfLastStatement);
+    directivesInLastBlock_ = scanner_.consumeCompleteStatements();
+    return result;
+  }
+
+  // The input is exhausted, so the remainder is the last block. It doesn't
+  // have to be scanned, because there are no following blocks for which the
+  // directives would be relevant.
+  if (remainder_.empty()) {
+    return std::nullopt;
+  }
+  auto result = std::move(remainder_);
+  // The C++ standard does not require that remainder_ is empty after the
+  // move, but we need it to be empty to make the logic above work.
+  remainder_.clear();
+  return result;
+}
+
+// _____________________________________________________________________________
+InputCompression compressionFromFilename(std::string_view filename) {
+  if (ql::ends_with(filename, ".gz")) {
+    return InputCompression::Gzip;
+  } else if (ql::ends_with(filename, ".zst")) {
+    return InputCompression::Zstd;
+  }
+  return InputCompression::None;
+}
+
+// _____________________________________________________________________________
+ParallelDecompressingBuffer::ParallelDecompressingBuffer(
+    std::unique_ptr<ParallelBuffer> rawBuffer, InputCompression compression)
+    : ParallelBuffer{rawBuffer->getBlocksize()},
+      rawBuffer_{std::move(rawBuffer)} {
+  AD_CONTRACT_CHECK(compression != InputCompression::None);
+  decompressionThread_ = ad_utility::JThread{[this, compression]() {
+    try {
+      if (compression == InputCompression::Gzip) {
+        decompressGzip();
+      } else {
+        decompressZstd();
+      }
+      decompressedBlocks_.finish();
+    } catch (...) {
+      decompressedBlocks_.pushException(std::current_exception());
+    }
+  }};
+}
+
+// _____________________________________________________________________________
+ParallelDecompressingBuffer::~ParallelDecompressingBuffer() {
+  // Make the decompression thread stop at its next `push`, s.t. it can be
+  // joined.
+  decompressedBlocks_.finish();
+}
+
+// _____________________________________________________________________________
+std::optional<ParallelBuffer::BufferType>
+ParallelDecompressingBuffer::getNextBlock() {
+  return decompressedBlocks_.pop();
+}
+
+// _____________________________________________________________________________
+void ParallelDecompressingBuffer::decompressGzip() {
+  namespace io = boost::iostreams;
+  // The raw blocks are decompressed in slices of this size, s.t. the size of
+  // the decompressed blocks stays close to the `blocksize_`, independent of
+  // the compression ratio.
+  static constexpr size_t sliceSize = 1 << 16;
+  BufferType block;
+  io::filtering_ostream stream;
+  stream.push(io::gzip_decompressor());
+  stream.push(io::back_inserter(block), 0);
+  // Only set after the chain is complete, because an incomplete chain is in a
+  // failed state.
+  stream.exceptions(std::ios::badbit | std::ios::failbit);
+  while (auto raw = rawBuffer_->getNextBlock()) {
+    for (size_t i = 0; i < raw->size(); i += sliceSize) {
+      stream.write(raw->data() + i,
+                   static_cast<std::streamsize>(
+                       std::min(sliceSize, raw->size() - i)));
+      if (block.size() >= blocksize_) {
+        if (!decompressedBlocks_.push(std::move(block))) {
+          return;
+        }
+        block.clear();
+      }
+    }
+  }
+  // Flush the remaining bytes into the `block`.
+  stream.reset();
+  if (!block.empty()) {
+    decompressedBlocks_.push(std::move(block));
+  }
+}
+
+// _____________________________________________________________________________
+void ParallelDecompressingBuffer::decompressZstd() {
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{
+      ZSTD_createDCtx(), &ZSTD_freeDCtx};
+  AD_CORRECTNESS_CHECK(context != nullptr);
+  BufferType block(blocksize_);
+  size_t numBytesInBlock = 0;
+  // The result of the last call to `ZSTD_decompressStream`, which is `0` iff
+  // a frame has been completely decoded and flushed.
+  size_t lastResult = 0;
+  while (auto raw = rawBuffer_->getNextBlock()) {
+    ZSTD_inBuffer input{raw->data(), raw->size(), 0};
+    bool outputWasFull = false;
+    while (input.pos < input.size || outputWasFull) {
+      ZSTD_outBuffer output{block.data(), block.size(), numBytesInBlock};
+      lastResult = ZSTD_decompressStream(context.get(), &output, &input);
+      if (ZSTD_isError(lastResult)) {
+        throw std::runtime_error{absl::StrCat(
+            "Error during the zstd decompression of the input: ",
+            ZSTD_getErrorName(lastResult))};
+      }
+      numBytesInBlock = output.pos;
+      outputWasFull = output.pos == output.size;
+      if (outputWasFull) {
+        if (!decompressedBlocks_.push(std::move(block))) {
+          return;
+        }
+        block = BufferType(blocksize_);
+        numBytesInBlock = 0;
+      }
+    }
+  }
+  if (lastResult != 0) {
+    throw std::runtime_error{
+        "The zstd-compressed input ended in the middle of a frame"};
+  }
+  if (numBytesInBlock > 0) {
+    block.resize(numBytesInBlock);
+    decompressedBlocks_.push(std::move(block));
+  }
+}
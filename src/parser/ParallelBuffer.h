@@ -13,12 +13,19 @@
 #include <re2/re2.h>
 
 #include <future>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "backports/span.h"
+#include "parser/TurtleStatementScanner.h"
 #include "util/File.h"
+#include "util/Generator.h"
+#include "util/ThreadSafeQueue.h"
 #include "util/UninitializedAllocator.h"
+#include "util/jthread.h"
 
 /**
  * @brief Abstract base class for certain input buffers.
@@ -78,6 +85,28 @@ class ParallelFileBuffer : public ParallelBuffer {
   std::future<size_t> fut_;
 };
 
+// A parallel buffer that reads the bytes from a generator of byte spans (e.g.
+// the body of an HTTP response) and concatenates them to blocks of at least
+// `blocksize` bytes (except for the last block). The generator is advanced by
+// the thread that calls `getNextBlock`, so when this buffer is used by a
+// parallel parser, the input is consumed while the previous blocks are being
+// parsed.
+class ParallelBufferFromByteSpans : public ParallelBuffer {
+ public:
+  using ByteSpans = cppcoro::generator<ql::span<std::byte>>;
+
+  ParallelBufferFromByteSpans(size_t blocksize, ByteSpans byteSpans)
+      : ParallelBuffer{blocksize}, byteSpans_{std::move(byteSpans)} {}
+
+  // Get the next block, or `std::nullopt` if the generator is exhausted.
+  std::optional<BufferType> getNextBlock() override;
+
+ private:
+  ByteSpans byteSpans_;
+  // Initialized by the first call to `getNextBlock`.
+  std::optional<ByteSpans::iterator> iterator_;
+};
+
 // A parallel buffer that reads input in blocks, where each block, except
 // possibly the last, ends with `endRegex`. It wraps any `ParallelBuffer` as
 // the underlying byte source.
@@ -112,4 +141,83 @@ class ParallelBufferWithEndRegex : public ParallelBuffer {
   bool exhausted_ = false;
 };
 
+// A parallel buffer that reads Turtle input in blocks, where each block ends
+// with the end of a statement. Unlike `ParallelBufferWithEndRegex`, the ends
+// of the statements are found by the `TurtleStatementScanner`, so the blocks
+// are also correctly split if the input contains multiline string literals or
+// `.` followed by a newline inside of a string literal. If a block of the
+// underlying buffer contains no end of a statement (e.g. because of a very
+// long multiline literal), it is concatenated with the following block(s).
+class ParallelBufferWithTurtleStatementEnds : public ParallelBuffer {
+ public:
+  using Range = TurtleStatementScanner::Range;
+
+  explicit ParallelBufferWithTurtleStatementEnds(
+      std::unique_ptr<ParallelBuffer> rawBuffer)
+      : ParallelBuffer{rawBuffer->getBlocksize()},
+        rawBuffer_{std::move(rawBuffer)} {}
+
+  // Get the next block of complete statements, or `std::nullopt` if the
+  // input is exhausted.
+  std::optional<BufferType> getNextBlock() override;
+
+  // The positions of the `@prefix`, `@base`, `PREFIX`, and `BASE` directives
+  // in the block that was returned by the last call to `getNextBlock`.
+  const std::vector<Range>& directivesInLastBlock() const {
+    return directivesInLastBlock_;
+  }
+
+ private:
+  std::unique_ptr<ParallelBuffer> rawBuffer_;
+  // The input that has been read, but not yet returned. It always starts at
+  // the beginning of a statement.
+  BufferType remainder_;
+  TurtleStatementScanner scanner_;
+  std::vector<Range> directivesInLastBlock_;
+  bool exhausted_ = false;
+};
+
+// The compression format of an input file or stream.
+enum class InputCompression { None, Gzip, Zstd };
+
+// Deduce the compression from the extension of the `filename` (`.gz` or
+// `.zst`). Files with other extensions are assumed to be uncompressed.
+InputCompression compressionFromFilename(std::string_view filename);
+
+// A parallel buffer that decompresses the bytes of another `ParallelBuffer`.
+// The decompression runs in a dedicated thread, which (together with the
+// asynchronous reading of the underlying buffer) overlaps the reading and
+// decompression of the input with its consumption by the parser. Up to
+// `numBufferedBlocks` decompressed blocks are kept ahead of the consumer.
+// Concatenated gzip members and zstd frames are all decompressed.
+class ParallelDecompressingBuffer : public ParallelBuffer {
+ public:
+  static constexpr size_t numBufferedBlocks = 4;
+
+  // Decompress the bytes of the `rawBuffer`, which must not be
+  // `InputCompression::None`. The blocksize is derived from `rawBuffer`.
+  ParallelDecompressingBuffer(std::unique_ptr<ParallelBuffer> rawBuffer,
+                              InputCompression compression);
+
+  // Stop the decompression thread.
+  ~ParallelDecompressingBuffer() override;
+
+  // Get the next block of decompressed bytes, or `std::nullopt` if the input
+  // is exhausted. Errors during the decompression are rethrown here.
+  std::optional<BufferType> getNextBlock() override;
+
+ private:
+  // The implementations of the decompression, which are run in the
+  // `decompressionThread_`.
+  void decompressGzip();
+  void decompressZstd();
+
+  std::unique_ptr<ParallelBuffer> rawBuffer_;
+  ad_utility::data_structures::ThreadSafeQueue<BufferType> decompressedBlocks_{
+      numBufferedBlocks};
+  // Must be declared last, s.t. all the other members are initialized before
+  // the thread starts and are destroyed after the thread has been joined.
+  ad_utility::JThread decompressionThread_;
+};
+
 #endif  // QLEVER_SRC_PARSER_PARALLELBUFFER_H
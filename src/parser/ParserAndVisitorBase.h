@@ -5,6 +5,7 @@
 #ifndef QLEVER_SRC_PARSER_PARSERANDVISITORBASE_H
 #define QLEVER_SRC_PARSER_PARSERANDVISITORBASE_H
 
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -42,20 +43,27 @@ struct ParserAndVisitorBase {
  public:
   SparqlAutomaticParser parser_{&tokens_};
   Visitor visitor_;
+  // If true, the input is first parsed using ANTLR's `SLL` prediction mode,
+  // which is much faster and allocates much less than the full `LL` prediction,
+  // but might fail for some valid inputs. Only if that fails, the input is
+  // parsed again with the `LL` prediction. If the `SLL` parsing succeeds
+  // without errors, its parse tree is a correct parse of the input. Can be
+  // disabled for testing and benchmarking.
+  bool trySllPredictionFirst_ = true;
+
   explicit ParserAndVisitorBase(std::string input, Visitor visitor = {})
       : input_{std::move(input)}, visitor_{std::move(visitor)} {
     // The default in ANTLR is to log all errors to the console and to continue
     // the parsing. We need to turn parse errors into exceptions instead to
     // propagate them to the user.
-    parser_.removeErrorListeners();
-    parser_.addErrorListener(&errorListener_);
+    useLlPrediction();
     lexer_.removeErrorListeners();
     lexer_.addErrorListener(&errorListener_);
   }
 
   template <typename ContextType>
   auto parseTypesafe(ContextType* (SparqlAutomaticParser::*F)(void)) {
-    auto resultOfParse = visitor_.visit(std::invoke(F, parser_));
+    auto resultOfParse = visitor_.visit(parseTwoStage(F));
 
     // The `startIndex()` denotes the index of a Unicode codepoint, but `input_`
     // is UTF-8 encoded.
@@ -64,6 +72,44 @@ struct ParserAndVisitorBase {
     return ResultOfParseAndRemainingText{std::move(resultOfParse),
                                          std::string{remainingString}};
   }
+
+ private:
+  // Parse the input using the rule `F`, first with the `SLL` prediction (if
+  // enabled, see `trySllPredictionFirst_` above), and if that fails, with the
+  // full `LL` prediction. Only the errors of the `LL` parsing are reported, so
+  // the error messages for invalid inputs don't change.
+  template <typename ContextType>
+  ContextType* parseTwoStage(ContextType* (SparqlAutomaticParser::*F)(void)) {
+    if (!trySllPredictionFirst_) {
+      return std::invoke(F, parser_);
+    }
+    // In the `SLL` stage, a syntax error immediately aborts the parsing
+    // (without being reported) via a `ParseCancellationException`.
+    parser_.getInterpreter<antlr4::atn::ParserATNSimulator>()
+        ->setPredictionMode(antlr4::atn::PredictionMode::SLL);
+    parser_.setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+    parser_.removeErrorListeners();
+    try {
+      auto* result = std::invoke(F, parser_);
+      useLlPrediction();
+      return result;
+    } catch (const antlr4::ParseCancellationException&) {
+      // Rewind the already lexed tokens and parse them again.
+      parser_.reset();
+      useLlPrediction();
+    }
+    return std::invoke(F, parser_);
+  }
+
+  // Set up the `parser_` for the parsing with the full `LL` prediction, which
+  // reports all errors to the `errorListener_`.
+  void useLlPrediction() {
+    parser_.getInterpreter<antlr4::atn::ParserATNSimulator>()
+        ->setPredictionMode(antlr4::atn::PredictionMode::LL);
+    parser_.setErrorHandler(std::make_shared<antlr4::DefaultErrorStrategy>());
+    parser_.removeErrorListeners();
+    parser_.addErrorListener(&errorListener_);
+  }
 };
 }  // namespace sparqlParserHelpers
 #endif  // QLEVER_SRC_PARSER_PARSERANDVISITORBASE_H
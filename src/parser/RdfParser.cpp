@@ -769,6 +769,15 @@ bool TurtleParser<T>::parseTerminal() {
   if constexpr (SkipWhitespaceBefore) {
     tok_.skipWhitespaceAndComments();
   }
+  // For the most frequent tokens, try the fast path first.
+  if (auto length = fastTurtleTokens::match<terminal>(tok_.view())) {
+    if (length.value() == 0) {
+      return false;
+    }
+    lastParseResult_ = std::string{tok_.view().substr(0, length.value())};
+    tok_.remove_prefix(length.value());
+    return true;
+  }
   auto [success, word] = tok_.template getNextToken<terminal>();
   if (success) {
     lastParseResult_ = word;
@@ -1125,11 +1134,18 @@ void RdfParallelParser<T>::finishTripleCollectorIfLastBatch() {
 // __________________________________________________________________________________
 template <typename T>
 template <typename Batch>
-void RdfParallelParser<T>::parseBatch(size_t parsePosition, Batch batch) {
+void RdfParallelParser<T>::parseBatch(size_t parsePosition, Batch batch,
+                                      std::shared_ptr<const Header> header) {
   try {
     RdfStringParser<T> parser{&this->encodedIriManager(), defaultGraphIri_};
-    this->copyHeaderFrom(*this, parser);
-    parser.useSimplifiedGrammar();
+    if constexpr (isTurtle) {
+      // The batch consists of complete statements, so it may also contain
+      // directives and multiline literals.
+      this->copyHeaderFrom(*header, parser);
+    } else {
+      this->copyHeaderFrom(*this, parser);
+      parser.useSimplifiedGrammar();
+    }
     parser.setPositionOffset(parsePosition);
     // Ensure that all sub-parsers use the same file-level blank node prefix
     // so that user-specified blank node labels (_:foo) have the same ID
@@ -1164,8 +1180,34 @@ void RdfParallelParser<T>::feedBatchesToParser(
         parallelParser_.finish();
       });
   decltype(remainingBatchFromInitialization) inputBatch;
+  // For Turtle input, the prefixes and the base IRI that are active at the
+  // beginning of the next batch. After each batch, they are updated by
+  // parsing the directives of the batch (which have been found by the
+  // `fileBuffer_`) with the `directiveParser`.
+  auto header = std::make_shared<Header>();
+  this->copyHeaderFrom(*this, *header);
+  RdfStringParser<T> directiveParser{&this->encodedIriManager()};
+  this->copyHeaderFrom(*this, directiveParser);
+  auto updateHeader = [&](std::string_view batch) {
+    if constexpr (isTurtle) {
+      const auto& directives = fileBuffer_->directivesInLastBlock();
+      if (directives.empty()) {
+        return;
+      }
+      for (auto [begin, end] : directives) {
+        directiveParser.setInputStream(batch.substr(begin, end - begin));
+        directiveParser.parseDirectiveManually();
+      }
+      header = std::make_shared<Header>();
+      this->copyHeaderFrom(directiveParser, *header);
+    } else {
+      (void)batch;
+    }
+  };
   try {
     while (true) {
+      // The directives of a batch only affect the following batches.
+      std::shared_ptr<const Header> headerOfThisBatch = header;
       if (first) {
         inputBatch = std::move(remainingBatchFromInitialization);
         first = false;
@@ -1175,11 +1217,15 @@ void RdfParallelParser<T>::feedBatchesToParser(
           return;
         }
         inputBatch = std::move(nextOptional.value());
+        updateHeader(std::string_view{inputBatch.data(), inputBatch.size()});
       }
       auto batchSize = inputBatch.size();
       auto parseThisBatch = [this, parsePosition,
-                             batch = std::move(inputBatch)]() mutable {
-        parseBatch(parsePosition, std::move(batch));
+                             batch = std::move(inputBatch),
+                             headerOfThisBatch =
+                                 std::move(headerOfThisBatch)]() mutable {
+        parseBatch(parsePosition, std::move(batch),
+                   std::move(headerOfThisBatch));
       };
       parsePosition += batchSize;
       numBatchesTotal_.fetch_add(1);
@@ -1201,35 +1247,45 @@ void RdfParallelParser<T>::feedBatchesToParser(
 template <typename T>
 void RdfParallelParser<T>::initialize(
     std::unique_ptr<ParallelBuffer> rawBuffer) {
-  fileBuffer_ = std::make_unique<ParallelBufferWithEndRegex>(
-      std::move(rawBuffer), "\\.[\\t ]*([\\r\\n]+)");
-  ParallelBuffer::BufferType remainingBatchFromInitialization;
-  RdfStringParser<T> declarationParser{&this->encodedIriManager()};
-  std::string_view remainder;
-  while (remainder.empty()) {
-    if (auto batch = fileBuffer_->getNextBlock()) {
-      declarationParser.setInputStream(std::move(batch.value()));
-      while (declarationParser.parseDirectiveManually()) {
+  if constexpr (isTurtle) {
+    // The directives are handled while feeding the batches to the parser
+    // threads, so there is no separate initialization phase.
+    fileBuffer_ = std::make_unique<ParallelBufferWithTurtleStatementEnds>(
+        std::move(rawBuffer));
+    parseFuture_ = std::async(std::launch::async, [this]() {
+      feedBatchesToParser(ParallelBuffer::BufferType{});
+    });
+  } else {
+    fileBuffer_ = std::make_unique<ParallelBufferWithEndRegex>(
+        std::move(rawBuffer), "\\.[\\t ]*([\\r\\n]+)");
+    ParallelBuffer::BufferType remainingBatchFromInitialization;
+    RdfStringParser<T> declarationParser{&this->encodedIriManager()};
+    std::string_view remainder;
+    while (remainder.empty()) {
+      if (auto batch = fileBuffer_->getNextBlock()) {
+        declarationParser.setInputStream(std::move(batch.value()));
+        while (declarationParser.parseDirectiveManually()) {
+        }
+        remainder = declarationParser.getUnparsedRemainder();
+      } else {
+        AD_LOG_WARN
+            << "Empty input to the TURTLE parser, is this what you intended?"
+            << std::endl;
+        break;
       }
-      remainder = declarationParser.getUnparsedRemainder();
-    } else {
-      AD_LOG_WARN
-          << "Empty input to the TURTLE parser, is this what you intended?"
-          << std::endl;
-      break;
     }
-  }
-  this->copyHeaderFrom(std::move(declarationParser), *this);
-  remainingBatchFromInitialization.reserve(remainder.size());
-  ql::ranges::copy(remainder,
-                   std::back_inserter(remainingBatchFromInitialization));
+    this->copyHeaderFrom(std::move(declarationParser), *this);
+    remainingBatchFromInitialization.reserve(remainder.size());
+    ql::ranges::copy(remainder,
+                     std::back_inserter(remainingBatchFromInitialization));
 
-  auto feedBatches = [this, firstBatch = std::move(
-                                remainingBatchFromInitialization)]() mutable {
-    feedBatchesToParser(std::move(firstBatch));
-  };
+    auto feedBatches = [this, firstBatch = std::move(
+                                  remainingBatchFromInitialization)]() mutable {
+      feedBatchesToParser(std::move(firstBatch));
+    };
 
-  parseFuture_ = std::async(std::launch::async, feedBatches);
+    parseFuture_ = std::async(std::launch::async, feedBatches);
+  }
 }
 
 // _____________________________________________________________________________
@@ -24,6 +24,7 @@
 #include "index/ConstantsIndexBuilding.h"
 #include "index/EncodedIriManager.h"
 #include "index/InputFileSpecification.h"
+#include "parser/FastTurtleTokens.h"
 #include "parser/ParallelBuffer.h"
 #include "parser/TripleComponent.h"
 #include "parser/TurtleTokenId.h"
@@ -35,6 +36,7 @@
 #include "util/ParsedUri.h"
 #include "util/TaskQueue.h"
 #include "util/ThreadSafeQueue.h"
+#include "util/TypeTraits.h"
 
 enum class TurtleParserIntegerOverflowBehavior {
   Error,
@@ -332,6 +334,10 @@ class TurtleParser : public RdfParserBase {
   template <TurtleTokenId reg>
   bool skip() {
     tok_.skipWhitespaceAndComments();
+    if (auto length = fastTurtleTokens::match<reg>(tok_.view())) {
+      tok_.remove_prefix(length.value());
+      return length.value() > 0;
+    }
     return tok_.template skip<reg>();
   }
 
@@ -611,9 +617,28 @@ class RdfStreamParser : public Parser {
  * This class is a TurtleParser that always assumes that
  * its input file is an uncompressed .ttl file that will be read in
  * chunks. Input file can also be a stream like stdin.
+ *
+ * For Turtle input, the chunks are split at the ends of statements that are
+ * found by the `TurtleStatementScanner`, and each chunk is parsed with the
+ * prefixes and the base IRI that are active at its beginning. Directives and
+ * multiline literals can therefore appear anywhere in the input. For N-Quads,
+ * the chunks are split at `.` followed by a newline.
  */
 template <typename Parser>
 class RdfParallelParser : public Parser {
+  static constexpr bool isTurtle =
+      !ad_utility::isInstantiation<Parser, NQuadParser>;
+  using FileBuffer =
+      std::conditional_t<isTurtle, ParallelBufferWithTurtleStatementEnds,
+                         ParallelBufferWithEndRegex>;
+
+  // The prefixes and the base IRI that are active at the beginning of a
+  // chunk.
+  struct Header {
+    ad_utility::HashMap<std::string, TripleComponent::Iri> prefixMap_;
+    std::optional<qlever::util::ParsedUri> baseIri_;
+  };
+
  public:
   using Triple = std::array<std::string, 3>;
   // Default construction needed for tests
@@ -662,8 +687,11 @@ class RdfParallelParser : public Parser {
   // interacts with the functions next to it.
   void finishTripleCollectorIfLastBatch();
   // Parse the single `batch` and push the result to the `triplesCollector_`.
+  // For Turtle input, the `header` is used for the prefixes and the base IRI,
+  // otherwise the ones of this parser.
   template <typename Batch>
-  void parseBatch(size_t parsePosition, Batch batch);
+  void parseBatch(size_t parsePosition, Batch batch,
+                  std::shared_ptr<const Header> header);
 
   // Read all the batches from the file and feed them to the parallel parser
   // threads. The argument is the first batch which might have been leftover
@@ -681,7 +709,7 @@ class RdfParallelParser : public Parser {
   using Parser::triples_;
 
   // Initialized in the call to `initialize`.
-  std::unique_ptr<ParallelBufferWithEndRegex> fileBuffer_;
+  std::unique_ptr<FileBuffer> fileBuffer_;
 
   // Collect error messages in case of multiple failures. The `size_t` is the
   // start position of the corresponding batch, used to order the errors in case
@@ -4,7 +4,18 @@
 
 #include "parser/SparqlParser.h"
 
+#include <absl/strings/ascii.h>
+#include <absl/strings/match.h>
+#include <absl/strings/str_cat.h>
+#include <re2/re2.h>
+
+#include "backports/algorithm.h"
+#include "parser/ParallelBuffer.h"
+#include "parser/Quads.h"
+#include "parser/RdfParser.h"
 #include "parser/SparqlParserHelpers.h"
+#include "parser/Tokenizer.h"
+#include "util/Algorithm.h"
 
 using AntlrParser = SparqlAutomaticParser;
 
@@ -58,6 +69,128 @@ ParsedQuery SparqlParser::parseQuery(
 std::vector<ParsedQuery> SparqlParser::parseUpdate(
     BnodeMgr bnodeMgr, const EncodedIriManager* encodedIriManager,
     std::string update, const std::vector<DatasetClause>& datasets) {
+  if (update.size() >= MIN_SIZE_FOR_TURTLE_PARSING_OF_DATA_UPDATES()) {
+    auto dataUpdate = parseDataUpdateWithTurtleParser(
+        bnodeMgr, encodedIriManager, update, datasets);
+    if (dataUpdate.has_value()) {
+      std::vector<ParsedQuery> result;
+      result.push_back(std::move(dataUpdate).value());
+      return result;
+    }
+  }
   return parseOperation(bnodeMgr, encodedIriManager, &AntlrParser::update,
                         std::move(update), datasets);
 }
+
+// _____________________________________________________________________________
+std::optional<ParsedQuery> SparqlParser::parseDataUpdateWithTurtleParser(
+    BnodeMgr bnodeMgr, const EncodedIriManager* encodedIriManager,
+    std::string_view update, const std::vector<DatasetClause>& datasets) {
+  // The SPARQL parser replaces all unicode escape sequences before the
+  // tokenization, even inside of literals, where the Turtle parser treats them
+  // differently. Leave such (rare) updates to the SPARQL parser.
+  if (update.find("\\u") != std::string_view::npos ||
+      update.find("\\U") != std::string_view::npos) {
+    return std::nullopt;
+  }
+
+  // Split the update into the prologue, the operation, and the body of the
+  // operation, which has to be the rest of the update up to the final `}`.
+  static const re2::RE2 operationRegex{
+      R"(^((?s:.*?))(?i:(INSERT|DELETE))\s+(?i:DATA)\s*\{)"};
+  re2::StringPiece prologue;
+  re2::StringPiece operation;
+  if (!RE2::PartialMatch(re2::StringPiece{update.data(), update.size()},
+                         operationRegex, &prologue, &operation)) {
+    return std::nullopt;
+  }
+  bool isInsert = absl::EqualsIgnoreCase(operation, "INSERT");
+  auto bodyBegin = update.find('{', prologue.size() + operation.size());
+  AD_CORRECTNESS_CHECK(bodyBegin != std::string_view::npos);
+  std::string_view body = absl::StripTrailingAsciiWhitespace(
+      update.substr(bodyBegin + 1));
+  if (!body.ends_with('}')) {
+    return std::nullopt;
+  }
+  body.remove_suffix(1);
+
+  using TurtleStringParser = RdfStringParser<TurtleParser<Tokenizer>>;
+  std::vector<TurtleTriple> triples;
+  try {
+    // The prologue must only consist of directives, as everything else would
+    // be parsed as triples by the Turtle parser.
+    TurtleStringParser prologueParser{encodedIriManager};
+    prologueParser.setInputStream(
+        std::string_view{prologue.data(), prologue.size()});
+    while (prologueParser.parseDirectiveManually()) {
+    }
+    if (!absl::StripAsciiWhitespace(prologueParser.getUnparsedRemainder())
+             .empty()) {
+      return std::nullopt;
+    }
+
+    // In SPARQL, the final `.` of the body is optional.
+    auto trimmedBody = absl::StripTrailingAsciiWhitespace(body);
+    bool addDot = !trimmedBody.empty() && !trimmedBody.ends_with('.');
+    std::string turtle =
+        absl::StrCat(std::string_view{prologue.data(), prologue.size()}, "\n",
+                     body, addDot ? " ." : "");
+    auto byteSpans = [](std::string input, size_t blocksize)
+        -> ParallelBufferFromByteSpans::ByteSpans {
+      for (size_t i = 0; i < input.size(); i += blocksize) {
+        co_yield ql::span<std::byte>{
+            reinterpret_cast<std::byte*>(input.data()) + i,
+            std::min(blocksize, input.size() - i)};
+      }
+    };
+    size_t blocksize = BLOCKSIZE_TURTLE_PARSING_OF_DATA_UPDATES.getBytes();
+    RdfParallelParser<TurtleParser<Tokenizer>> parser{
+        std::make_unique<ParallelBufferFromByteSpans>(
+            blocksize, byteSpans(std::move(turtle), blocksize)),
+        encodedIriManager};
+    while (auto batch = parser.getBatch()) {
+      ad_utility::appendVector(triples, std::move(batch).value());
+    }
+  } catch (const std::exception&) {
+    // The SPARQL parser reports the error (or the input is valid SPARQL, but
+    // not valid Turtle).
+    return std::nullopt;
+  }
+
+  // Blank nodes are not allowed in `DELETE DATA`, let the SPARQL parser
+  // report the error.
+  auto hasBlankNode = [](const TurtleTriple& triple) {
+    return triple.subject_.isString() || triple.object_.isString();
+  };
+  if (!isInsert && ql::ranges::any_of(triples, hasBlankNode)) {
+    return std::nullopt;
+  }
+
+  // Convert the triples to the format of the updates.
+  Quads::BlankNodeAdder blankNodeAdder{{}, {}, bnodeMgr};
+  auto transformTc = [&blankNodeAdder](TripleComponent&& tc) {
+    if (tc.isString()) {
+      return TripleComponent{blankNodeAdder.getBlankNodeIndex(tc.getString())};
+    }
+    return std::move(tc);
+  };
+  auto quads = ad_utility::transform(
+      std::move(triples), [&transformTc](TurtleTriple&& triple) {
+        return SparqlTripleSimpleWithGraph{
+            transformTc(std::move(triple.subject_)),
+            transformTc(std::move(triple.predicate_)),
+            transformTc(std::move(triple.object_)), std::monostate{}};
+      });
+  updateClause::GraphUpdate::Triples updateTriples{
+      std::move(quads), blankNodeAdder.localVocab_.clone()};
+
+  ParsedQuery result;
+  result._clause = parsedQuery::UpdateClause{
+      isInsert ? updateClause::GraphUpdate{std::move(updateTriples), {}}
+               : updateClause::GraphUpdate{{}, std::move(updateTriples)}};
+  if (!datasets.empty()) {
+    result.datasetClauses_ = parsedQuery::DatasetClauses::fromClauses(datasets);
+  }
+  result._originalString = std::string{absl::StripAsciiWhitespace(update)};
+  return result;
+}
@@ -5,10 +5,29 @@
 #ifndef QLEVER_SRC_PARSER_SPARQLPARSER_H
 #define QLEVER_SRC_PARSER_SPARQLPARSER_H
 
+#include <atomic>
+#include <optional>
 #include <string>
+#include <string_view>
 
 #include "parser/ParsedQuery.h"
 #include "util/BlankNodeManager.h"
+#include "util/MemorySize/MemorySize.h"
+
+// Updates with at least this many bytes that consist of a single `INSERT DATA`
+// or `DELETE DATA` operation (with an optional prologue) are parsed by the
+// parallel Turtle parser instead of the ANTLR-based SPARQL parser (see
+// `SparqlParser::parseDataUpdateWithTurtleParser` below). It is not const, so
+// we can set it to a much lower value for unit tests.
+inline std::atomic<size_t>& MIN_SIZE_FOR_TURTLE_PARSING_OF_DATA_UPDATES() {
+  static std::atomic<size_t> value = 1'000'000;
+  return value;
+}
+
+// The size of the blocks in which the Turtle parser parses the body of a large
+// `INSERT DATA` or `DELETE DATA` operation in parallel.
+constexpr inline ad_utility::MemorySize BLOCKSIZE_TURTLE_PARSING_OF_DATA_UPDATES =
+    ad_utility::MemorySize::megabytes(1);
 
 // The SPARQL parser used by QLever. The actual parsing is delegated to a parser
 // that is based on ANTLR4, which recognises the complete SPARQL 1.1 QL grammar.
@@ -27,6 +46,18 @@ class SparqlParser {
       ad_utility::BlankNodeManager* bnodeManager,
       const EncodedIriManager* encodedIriManager, std::string update,
       const std::vector<DatasetClause>& datasets = {});
+
+  // If the `update` consists of a prologue (`PREFIX` and `BASE` declarations)
+  // followed by a single `INSERT DATA { ... }` or `DELETE DATA { ... }` with
+  // only triples (no `GRAPH` blocks), parse the triples with the parallel
+  // Turtle parser and return the resulting update, which is the same as the
+  // one of `parseUpdate`. Return `std::nullopt` if the `update` doesn't have
+  // this form or can't be parsed by the Turtle parser, in which case
+  // `parseUpdate` has to be used (which then also reports the errors).
+  static std::optional<ParsedQuery> parseDataUpdateWithTurtleParser(
+      ad_utility::BlankNodeManager* bnodeManager,
+      const EncodedIriManager* encodedIriManager, std::string_view update,
+      const std::vector<DatasetClause>& datasets = {});
 };
 
 #endif  // QLEVER_SRC_PARSER_SPARQLPARSER_H
@@ -56,10 +56,11 @@ std::optional<Id> TripleComponent::toValueIdIfNotString(
     const EncodedIriManager* evManager) const {
   auto visitor = [evManager](const auto& value) -> std::optional<Id> {
     using T = std::decay_t<decltype(value)>;
-    if constexpr (std::is_same_v<T, Iri>) {
+    if constexpr (ad_utility::SameAsAny<T, Iri, Literal>) {
+      // Only some IRIs and short literals can be encoded, depending on the
+      // configuration of the `EncodedIriManager`.
       return evManager->encode(value.toStringRepresentation());
-
-    } else if constexpr (ad_utility::SameAsAny<T, std::string, Literal>) {
+    } else if constexpr (std::is_same_v<T, std::string>) {
       return std::nullopt;
     } else if constexpr (std::is_same_v<T, int64_t>) {
       return Id::makeFromInt(value);
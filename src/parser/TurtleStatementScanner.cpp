@@ -0,0 +1,280 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "parser/TurtleStatementScanner.h"
+
+#include <algorithm>
+#include <array>
+
+#include "util/Exception.h"
+
+namespace {
+// The bytes that have to be inspected outside of IRIs, string literals, and
+// comments. All other bytes can be skipped without looking at them in
+// detail.
+constexpr std::array<bool, 256> interestingBytes = []() {
+  std::array<bool, 256> result{};
+  for (char c : std::string_view{"#\"'<\\.@pPbB"}) {
+    result[static_cast<unsigned char>(c)] = true;
+  }
+  return result;
+}();
+
+// Return true iff `c` can continue a prefixed name or a number, s.t. a `.`
+// followed by `c` is not the end of a statement. A negative `c` means that
+// the end of the input was reached.
+bool continuesName(int c) {
+  return c >= 0x80 || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_' || c == '-' || c == '.' ||
+         c == ':' || c == '%' || c == '\\';
+}
+
+bool isWhitespace(int c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Return true iff `input` at `position` starts with `keyword`, ignoring the
+// ASCII case. `keyword` has to be given in lowercase.
+bool startsWithIgnoringCase(std::string_view input, size_t position,
+                            std::string_view keyword) {
+  if (input.size() - position < keyword.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < keyword.size(); ++i) {
+    char c = input[position + i];
+    if (c >= 'A' && c <= 'Z') {
+      c = static_cast<char>(c - 'A' + 'a');
+    }
+    if (c != keyword[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void TurtleStatementScanner::scan(std::string_view input, bool isEndOfInput) {
+  AD_CONTRACT_CHECK(position_ <= input.size());
+  while (position_ < input.size() && scanStep(input, isEndOfInput)) {
+  }
+}
+
+// _____________________________________________________________________________
+auto TurtleStatementScanner::consumeCompleteStatements() -> std::vector<Range> {
+  size_t end = endOfLastStatement_;
+  AD_CORRECTNESS_CHECK(position_ >= end);
+  position_ -= end;
+  if (directiveBegin_.has_value()) {
+    AD_CORRECTNESS_CHECK(directiveBegin_.value() >= end);
+    directiveBegin_.value() -= end;
+  }
+  endOfLastStatement_ = 0;
+  return std::exchange(directives_, {});
+}
+
+// _____________________________________________________________________________
+void TurtleStatementScanner::endStatement(size_t position) {
+  endOfLastStatement_ = position;
+  if (directiveBegin_.has_value()) {
+    directives_.emplace_back(directiveBegin_.value(), position);
+    directiveBegin_.reset();
+  }
+}
+
+// _____________________________________________________________________________
+bool TurtleStatementScanner::scanStep(std::string_view input,
+                                      bool isEndOfInput) {
+  const size_t size = input.size();
+  // Return the byte at position `i`, or -1 if `i` is past the end.
+  auto at = [&input, size](size_t i) -> int {
+    return i < size ? static_cast<unsigned char>(input[i]) : -1;
+  };
+  // Return true iff the `n` bytes starting at `position_` can be inspected.
+  // At the end of the input, the missing bytes are reported as -1 by `at`.
+  auto available = [this, size, isEndOfInput](size_t n) {
+    return isEndOfInput || position_ + n <= size;
+  };
+  // Find the first of the `chars` starting at `position_`. If there is none,
+  // skip the rest of the input and return `std::nullopt`.
+  auto findFirstOf = [this, &input,
+                      size](std::string_view chars) -> std::optional<char> {
+    auto next = input.find_first_of(chars, position_);
+    if (next == std::string_view::npos) {
+      position_ = size;
+      return std::nullopt;
+    }
+    position_ = next;
+    return input[next];
+  };
+
+  switch (state_) {
+    case State::Default: {
+      while (position_ < size &&
+             !interestingBytes[static_cast<unsigned char>(input[position_])]) {
+        ++position_;
+      }
+      if (position_ == size) {
+        return false;
+      }
+      char c = input[position_];
+      switch (c) {
+        case '#':
+          state_ = State::Comment;
+          ++position_;
+          return true;
+        case '"':
+        case '\'':
+          if (!available(3)) {
+            return false;
+          }
+          quote_ = c;
+          if (at(position_ + 1) == c && at(position_ + 2) == c) {
+            state_ = State::LongString;
+            position_ += 3;
+          } else {
+            state_ = State::String;
+            ++position_;
+          }
+          return true;
+        case '<':
+          if (!available(2)) {
+            return false;
+          }
+          // `<<` is the beginning of a quoted triple, not of an IRI.
+          if (at(position_ + 1) == '<') {
+            position_ += 2;
+          } else {
+            state_ = State::Iri;
+            ++position_;
+          }
+          return true;
+        case '\\':
+          // An escaped character in a prefixed name.
+          if (!available(2)) {
+            return false;
+          }
+          position_ = std::min(position_ + 2, size);
+          return true;
+        case '.':
+          if (!available(2)) {
+            return false;
+          }
+          ++position_;
+          if (!continuesName(at(position_))) {
+            endStatement(position_);
+          }
+          return true;
+        default:
+          return checkForDirective(input, isEndOfInput);
+      }
+    }
+    case State::Iri:
+      if (!findFirstOf(">")) {
+        return false;
+      }
+      ++position_;
+      state_ = State::Default;
+      // A SPARQL-style directive ends with its IRI.
+      if (directiveBegin_.has_value() && directiveIsSparqlStyle_) {
+        endStatement(position_);
+      }
+      return true;
+    case State::Comment:
+      if (!findFirstOf("\r\n")) {
+        return false;
+      }
+      ++position_;
+      state_ = State::Default;
+      return true;
+    case State::String:
+    case State::LongString: {
+      const char escapeOrQuote[] = {'\\', quote_};
+      auto c = findFirstOf(std::string_view{escapeOrQuote, 2});
+      if (!c) {
+        return false;
+      }
+      if (c.value() == '\\') {
+        if (!available(2)) {
+          return false;
+        }
+        position_ = std::min(position_ + 2, size);
+        return true;
+      }
+      if (state_ == State::String) {
+        ++position_;
+        state_ = State::Default;
+        return true;
+      }
+      if (!available(3)) {
+        return false;
+      }
+      if (at(position_ + 1) == quote_ && at(position_ + 2) == quote_) {
+        position_ += 3;
+        state_ = State::Default;
+      } else {
+        ++position_;
+      }
+      return true;
+    }
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+bool TurtleStatementScanner::checkForDirective(std::string_view input,
+                                               bool isEndOfInput) {
+  // The longest keyword is `@prefix`, and we also have to inspect the byte
+  // that follows it.
+  static constexpr size_t maxLookahead = 8;
+  if (!isEndOfInput && input.size() - position_ < maxLookahead) {
+    return false;
+  }
+  auto at = [&input](size_t i) -> int {
+    return i < input.size() ? static_cast<unsigned char>(input[i]) : -1;
+  };
+  char c = input[position_];
+  int previous = position_ == 0 ? ' ' : at(position_ - 1);
+  auto enterDirective = [this](size_t keywordSize, bool isSparqlStyle) {
+    directiveBegin_ = position_;
+    directiveIsSparqlStyle_ = isSparqlStyle;
+    position_ += keywordSize;
+    return true;
+  };
+
+  if (c == '@') {
+    // An `@` directly after a string literal starts a language tag.
+    if (previous != '"' && previous != '\'') {
+      for (std::string_view keyword : {"@prefix", "@base"}) {
+        if (input.substr(position_, keyword.size()) == keyword) {
+          int next = at(position_ + keyword.size());
+          bool continuesLanguageTag =
+              next >= 0 && next < 0x80 && next != ':' && continuesName(next);
+          if (!continuesLanguageTag) {
+            return enterDirective(keyword.size(), false);
+          }
+        }
+      }
+    }
+  } else if (isWhitespace(previous)) {
+    // The SPARQL-style keywords are case-insensitive. They are not valid
+    // Turtle terms on their own, so a whitespace-delimited occurrence outside
+    // of IRIs, literals, and comments is always a directive.
+    for (std::string_view keyword : {"prefix", "base"}) {
+      if (startsWithIgnoringCase(input, position_, keyword)) {
+        int next = at(position_ + keyword.size());
+        if (isWhitespace(next) || (keyword == "base" && next == '<')) {
+          return enterDirective(keyword.size(), true);
+        }
+      }
+    }
+  }
+  ++position_;
+  return true;
+}
@@ -0,0 +1,93 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_PARSER_TURTLESTATEMENTSCANNER_H
+#define QLEVER_SRC_PARSER_TURTLESTATEMENTSCANNER_H
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// A fast scanner that finds the ends of the statements in a Turtle input
+// without actually parsing it, s.t. the input can be split into chunks that
+// can be parsed independently (and in parallel). Unlike a simple search for
+// `.` followed by a newline, the scanner keeps track of whether it is inside
+// of an IRI, a (possibly multiline) string literal, or a comment, so the
+// chunks are never split inside of a statement. Additionally, the scanner
+// reports the positions of all the `@prefix`, `@base`, `PREFIX`, and `BASE`
+// directives, s.t. the parser of a chunk can be given the prefixes and the
+// base IRI that are active at the beginning of the chunk.
+//
+// The input can be scanned incrementally: `scan` can be called repeatedly
+// with the same input that has been extended at the end, and the scanning
+// continues where the previous call stopped.
+class TurtleStatementScanner {
+ public:
+  // A half-open range `[begin, end)` of positions in the input.
+  using Range = std::pair<size_t, size_t>;
+
+ private:
+  enum class State {
+    Default,
+    Iri,
+    String,
+    LongString,
+    Comment,
+  };
+  // The next position in the input that has not yet been scanned.
+  size_t position_ = 0;
+  State state_ = State::Default;
+  // The quote character of the current string (`"` or `'`).
+  char quote_ = '"';
+  // The position right after the end of the last complete statement or
+  // directive, or `0` if none has been found so far.
+  size_t endOfLastStatement_ = 0;
+  // If we are currently inside a directive, its start position and whether it
+  // is a SPARQL-style directive (which is not terminated by a `.`, but by the
+  // end of its IRI).
+  std::optional<size_t> directiveBegin_;
+  bool directiveIsSparqlStyle_ = false;
+  // All the directives that have been completely scanned.
+  std::vector<Range> directives_;
+
+ public:
+  // Continue scanning the `input` (the part that was scanned by previous calls
+  // must not have been changed). If `isEndOfInput` is false, then the scanner
+  // does not look at the last few bytes if their meaning might depend on the
+  // bytes that follow (e.g. `""` might be the beginning of `"""`).
+  void scan(std::string_view input, bool isEndOfInput);
+
+  // The position right after the end of the last complete statement that has
+  // been found so far, or `0` if none has been found. The input can be safely
+  // split at this position.
+  size_t endOfLastStatement() const { return endOfLastStatement_; }
+
+  // Remove the part of the input until `endOfLastStatement()` from the
+  // scanner. The positions of the following calls are relative to the rest of
+  // the input. Return all the directives in the removed part.
+  std::vector<Range> consumeCompleteStatements();
+
+ private:
+  // The implementation of `scan`, which handles a single construct (e.g. an
+  // IRI or a string literal) or a sequence of uninteresting bytes. Return
+  // false if more input is needed to proceed.
+  bool scanStep(std::string_view input, bool isEndOfInput);
+
+  // Check whether the input at the `position_` starts a directive and if so,
+  // enter the directive state. Return false if more input is needed to
+  // decide.
+  bool checkForDirective(std::string_view input, bool isEndOfInput);
+
+  // Register the end of a statement or directive at `position`.
+  void endStatement(size_t position);
+};
+
+#endif  // QLEVER_SRC_PARSER_TURTLESTATEMENTSCANNER_H
@@ -175,4 +175,24 @@ void VariableCounter::operator()(const ExternalValuesQuery& op) {
   (*this)(op.variables_);
 }
 
+// _____________________________________________________________________________
+void VariableCounter::operator()(const GraphAnalyticsQuery& op) {
+  (*this)(op.source_);
+  (*this)(op.target_);
+  (*this)(op.node_);
+  (*this)(op.value_);
+  (*this)(op.childGraphPattern_);
+}
+
+// _____________________________________________________________________________
+void VariableCounter::operator()(const WindowFunctionsQuery& op) {
+  (*this)(op.partitionBy_);
+  (*this)(op.orderBy_);
+  (*this)(op.value_);
+  for (const auto& [function, variable] : op.functions_) {
+    (*this)(variable);
+  }
+  (*this)(op.childGraphPattern_);
+}
+
 }  // namespace parsedQuery
@@ -87,6 +87,8 @@ struct VariableCounter {
   void operator()(const NamedCachedResult& op);
   void operator()(const MaterializedViewQuery& op);
   void operator()(const ExternalValuesQuery& op);
+  void operator()(const GraphAnalyticsQuery& op);
+  void operator()(const WindowFunctionsQuery& op);
 };
 
 }  // namespace parsedQuery
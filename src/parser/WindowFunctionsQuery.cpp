@@ -0,0 +1,87 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "parser/WindowFunctionsQuery.h"
+
+#include <string_view>
+
+#include "parser/MagicServiceIriConstants.h"
+#include "parser/SparqlTriple.h"
+
+namespace parsedQuery {
+
+// ____________________________________________________________________________
+void WindowFunctionsQuery::addParameter(const SparqlTriple& triple) {
+  auto simpleTriple = triple.getSimple();
+  TripleComponent predicate = simpleTriple.p_;
+  TripleComponent object = simpleTriple.o_;
+
+  auto predString = extractParameterName(predicate, WINDOW_FUNCTIONS_IRI);
+
+  auto addFunction = [this, &object, &predString](WindowFunction function) {
+    functions_.emplace_back(function, getVariable(predString, object));
+  };
+  if (predString == "partitionBy") {
+    partitionBy_.push_back(getVariable(predString, object));
+  } else if (predString == "orderBy") {
+    orderBy_.push_back(getVariable(predString, object));
+  } else if (predString == "value") {
+    setVariable("value", object, value_);
+  } else if (predString == "offset") {
+    if (!object.isInt() || object.getInt() <= 0) {
+      throw WindowFunctionsException(
+          "The parameter <offset> expects a positive integer");
+    }
+    offset_ = static_cast<size_t>(object.getInt());
+  } else if (predString == "rowNumber") {
+    addFunction(WindowFunction::ROW_NUMBER);
+  } else if (predString == "rank") {
+    addFunction(WindowFunction::RANK);
+  } else if (predString == "runningSum") {
+    addFunction(WindowFunction::RUNNING_SUM);
+  } else if (predString == "runningCount") {
+    addFunction(WindowFunction::RUNNING_COUNT);
+  } else if (predString == "lag") {
+    addFunction(WindowFunction::LAG);
+  } else if (predString == "lead") {
+    addFunction(WindowFunction::LEAD);
+  } else {
+    throw WindowFunctionsException(absl::StrCat(
+        "Unsupported argument <", predString,
+        "> in window functions. Supported arguments: <partitionBy>, "
+        "<orderBy>, <value>, <offset>, <rowNumber>, <rank>, <runningSum>, "
+        "<runningCount>, <lag>, <lead>."));
+  }
+}
+
+// ____________________________________________________________________________
+void WindowFunctionsQuery::validate() const {
+  if (!childGraphPattern_.has_value()) {
+    throw WindowFunctionsException(
+        "The window functions service requires a group graph pattern that "
+        "contains the rows.");
+  }
+  if (functions_.empty()) {
+    throw WindowFunctionsException(
+        "The window functions service requires at least one of the functions "
+        "<rowNumber>, <rank>, <runningSum>, <runningCount>, <lag>, <lead>.");
+  }
+}
+
+// ____________________________________________________________________________
+WindowFunctionsConfiguration
+WindowFunctionsQuery::toWindowFunctionsConfiguration() const {
+  validate();
+  WindowFunctionsConfiguration config{partitionBy_, orderBy_, value_};
+  config.offset_ = offset_.value_or(config.offset_);
+  config.functions_ = functions_;
+  return config;
+}
+
+}  // namespace parsedQuery
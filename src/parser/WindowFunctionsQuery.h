@@ -0,0 +1,67 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_PARSER_WINDOWFUNCTIONSQUERY_H
+#define QLEVER_SRC_PARSER_WINDOWFUNCTIONSQUERY_H
+
+#include "engine/WindowFunctions.h"
+#include "parser/MagicServiceQuery.h"
+
+class SparqlTriple;
+
+namespace parsedQuery {
+
+class WindowFunctionsException : public std::runtime_error {
+  // Constructors have to be explicitly inherited
+  using std::runtime_error::runtime_error;
+};
+
+// The `WindowFunctionsQuery` holds the parameters of the window functions
+// service, which computes ranks, running aggregates and the values of
+// neighboring rows within the partitions of the child graph pattern. For
+// example:
+//
+// SELECT ?country ?date ?rank ?total ?previous {
+//   SERVICE <https://qlever.cs.uni-freiburg.de/windowFunctions/> {
+//     _:config <partitionBy> ?country ; <orderBy> ?date ;
+//              <value> ?amount ;
+//              <rank> ?rank ; <runningSum> ?total ; <lag> ?previous .
+//     { ?sale <country> ?country ; <date> ?date ; <amount> ?amount }
+//   }
+// }
+//
+// `<partitionBy>` and `<orderBy>` can be given several times, the order of
+// the `<orderBy>` variables is the order in which they are given. The
+// functions are `<rowNumber>`, `<rank>`, `<runningSum>`, `<runningCount>`,
+// `<lag>`, and `<lead>` (see `WindowFunctions`), the latter two with the
+// optional `<offset>` (the default is 1).
+struct WindowFunctionsQuery : MagicServiceQuery {
+  std::vector<Variable> partitionBy_;
+  std::vector<Variable> orderBy_;
+  std::optional<Variable> value_;
+  std::optional<size_t> offset_;
+  std::vector<std::pair<WindowFunction, Variable>> functions_;
+
+  // See MagicServiceQuery
+  void addParameter(const SparqlTriple& triple) override;
+
+  // Check that there is a child graph pattern and at least one function.
+  void validate() const override;
+
+  // Convert this query into a `WindowFunctionsConfiguration`.
+  WindowFunctionsConfiguration toWindowFunctionsConfiguration() const;
+
+  constexpr std::string_view name() const override {
+    return "window functions";
+  };
+};
+
+}  // namespace parsedQuery
+
+#endif  // QLEVER_SRC_PARSER_WINDOWFUNCTIONSQUERY_H
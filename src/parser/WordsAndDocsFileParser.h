@@ -11,6 +11,7 @@
 #include <unicode/uchar.h>
 
 #include <fstream>
+#include <optional>
 #include <string>
 
 #include "global/Id.h"
@@ -60,6 +61,10 @@
  *                          being true. The need to count this comes only from
  *                          a trick used in testing right now.  To be specific
  *                          the method getTextRecordFromResultTable
+ * - std::optional<VocabIndex> vocabIndex_: This does not stem from the
+ *                          wordsfile either. For the literal entities it is
+ *                          the index of the literal in the vocabulary, s.t.
+ *                          it doesn't have to be looked up again.
  */
 struct WordsFileLine {
   std::string word_;
@@ -67,6 +72,7 @@ struct WordsFileLine {
   TextRecordIndex contextId_;
   Score score_;
   bool isLiteralEntity_ = false;
+  std::optional<VocabIndex> vocabIndex_ = std::nullopt;
 };
 
 /**
@@ -20,6 +20,7 @@
 
 #include "backports/StartsWithAndEndsWith.h"
 #include "engine/SpatialJoinConfig.h"
+#include "engine/sparqlExpressions/ApproxCountDistinctExpression.h"
 #include "engine/sparqlExpressions/BlankNodeExpression.h"
 #include "engine/sparqlExpressions/CountStarExpression.h"
 #include "engine/sparqlExpressions/ExistsExpression.h"
@@ -37,6 +38,7 @@
 #include "generated/SparqlAutomaticParser.h"
 #include "global/Constants.h"
 #include "global/RuntimeParameters.h"
+#include "parser/GraphAnalyticsQuery.h"
 #include "parser/GraphPatternOperation.h"
 #include "parser/MagicServiceIriConstants.h"
 #include "parser/MagicServiceQuery.h"
@@ -49,6 +51,7 @@
 #include "parser/SpatialQuery.h"
 #include "parser/TextSearchQuery.h"
 #include "parser/TokenizerCtre.h"
+#include "parser/WindowFunctionsQuery.h"
 #include "rdfTypes/GeometryInfo.h"
 #include "rdfTypes/Variable.h"
 #include "util/Algorithm.h"
@@ -305,6 +308,9 @@ ExpressionPtr Visitor::processIriFunctionCall(
       return createUnary(unaryInternalFuncs.at(functionName));
     } else if (functionName == "prefix-match") {
       return createBinary(&makePrefixMatchExpression);
+    } else if (functionName == "approxCountDistinct") {
+      // An aggregate, see `ApproxCountDistinctExpression`.
+      return createUnary(&makeApproxCountDistinctExpression);
     }
   }
 
@@ -1284,6 +1290,10 @@ GraphPatternOperation Visitor::visit(Parser::ServiceGraphPatternContext* ctx) {
     return visitMagicServiceQuery<parsedQuery::SpatialQuery>(ctx);
   } else if (serviceIri.toStringRepresentation() == TEXT_SEARCH_IRI) {
     return visitMagicServiceQuery<parsedQuery::TextSearchQuery>(ctx);
+  } else if (serviceIri.toStringRepresentation() == GRAPH_ANALYTICS_IRI) {
+    return visitMagicServiceQuery<parsedQuery::GraphAnalyticsQuery>(ctx);
+  } else if (serviceIri.toStringRepresentation() == WINDOW_FUNCTIONS_IRI) {
+    return visitMagicServiceQuery<parsedQuery::WindowFunctionsQuery>(ctx);
   } else if (serviceIri.toStringRepresentation() == EXTERNAL_VALUES_IRI ||
              ql::starts_with(serviceIri.toStringRepresentation(),
                              EXTERNAL_VALUES_IRI_PREFIX)) {
@@ -267,6 +267,32 @@ CPP_template(typename ForwardIterator, typename Tp,
   return first;
 }
 
+// Return the first iterator `it` in `[begin, end)` for which `pred(*it)` is
+// false, where `pred` has to be true for a (possibly empty) prefix of the range
+// and false for the rest. In contrast to `std::partition_point`, the search is
+// exponential starting from `begin`, so the number of calls to `pred` is
+// logarithmic in the distance between `begin` and the result instead of the
+// size of the range. This is faster if the result is typically close to
+// `begin`, e.g. when repeatedly skipping forward in a sorted range.
+CPP_template(typename RandomAccessIterator, typename Pred)(
+    requires ql::concepts::random_access_iterator<
+        RandomAccessIterator>) constexpr RandomAccessIterator
+    gallopingPartitionPoint(RandomAccessIterator begin,
+                            RandomAccessIterator end, const Pred& pred) {
+  using DistanceType =
+      typename std::iterator_traits<RandomAccessIterator>::difference_type;
+  DistanceType step = 1;
+  while (end - begin > step) {
+    auto probe = begin + step;
+    if (!pred(*probe)) {
+      return std::partition_point(begin, probe, pred);
+    }
+    begin = probe;
+    step *= 2;
+  }
+  return std::partition_point(begin, end, pred);
+}
+
 }  // namespace ad_utility
 
 #endif  // QLEVER_ALGORITHM_H
@@ -0,0 +1,127 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_ALLOCATIONPOOL_H
+#define QLEVER_SRC_UTIL_ALLOCATIONPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+
+namespace ad_utility {
+
+// A size-bounded, threadsafe pool of freed memory blocks, s.t. a later
+// allocation of exactly the same size can reuse a block instead of
+// allocating (and page faulting) fresh memory. This is useful for lazy
+// pipelines, which allocate and free an `IdTable` with the same size for each
+// of their blocks. In contrast to the `CachingMemoryResource`, the size of the
+// pool is bounded and the pool is shared by all the allocators of the process.
+class AllocationPool {
+ public:
+  // The function that is used to actually free a block (given the pointer and
+  // the size in bytes).
+  using Deallocate = void (*)(void*, size_t);
+
+ private:
+  Deallocate deallocate_;
+  std::mutex mutex_;
+  ad_utility::HashMap<size_t, std::vector<void*>> blocks_;
+  size_t sizeInBytes_ = 0;
+  // A pool with a maximum size of zero is disabled, in this case we don't even
+  // acquire the `mutex_`.
+  std::atomic<size_t> maxSizeInBytes_;
+
+ public:
+  AllocationPool(Deallocate deallocate, MemorySize maxSize)
+      : deallocate_{deallocate}, maxSizeInBytes_{maxSize.getBytes()} {}
+
+  // Free all the blocks in the pool.
+  ~AllocationPool() { setMaxSize(MemorySize::bytes(0)); }
+
+  AllocationPool(const AllocationPool&) = delete;
+  AllocationPool& operator=(const AllocationPool&) = delete;
+
+  // Return a block of exactly `numBytes` bytes from the pool, or `nullptr` if
+  // there is no such block.
+  void* get(size_t numBytes) {
+    if (maxSizeInBytes_.load(std::memory_order_relaxed) == 0) {
+      return nullptr;
+    }
+    std::lock_guard lock{mutex_};
+    auto it = blocks_.find(numBytes);
+    if (it == blocks_.end() || it->second.empty()) {
+      return nullptr;
+    }
+    void* block = it->second.back();
+    it->second.pop_back();
+    sizeInBytes_ -= numBytes;
+    return block;
+  }
+
+  // Add the block at `ptr` with `numBytes` bytes to the pool. If there is not
+  // enough space, blocks of other sizes are freed first. Return false (and
+  // don't take ownership of the block) if the block still doesn't fit.
+  bool put(void* ptr, size_t numBytes) {
+    const size_t maxSize = maxSizeInBytes_.load(std::memory_order_relaxed);
+    if (numBytes > maxSize) {
+      return false;
+    }
+    std::lock_guard lock{mutex_};
+    for (auto& [size, blocks] : blocks_) {
+      if (sizeInBytes_ + numBytes <= maxSize) {
+        break;
+      }
+      if (size == numBytes) {
+        continue;
+      }
+      while (!blocks.empty() && sizeInBytes_ + numBytes > maxSize) {
+        deallocate_(blocks.back(), size);
+        blocks.pop_back();
+        sizeInBytes_ -= size;
+      }
+    }
+    if (sizeInBytes_ + numBytes > maxSize) {
+      return false;
+    }
+    blocks_[numBytes].push_back(ptr);
+    sizeInBytes_ += numBytes;
+    return true;
+  }
+
+  // Set the maximum size. If the pool is currently larger, all of its blocks
+  // are freed.
+  void setMaxSize(MemorySize maxSize) {
+    std::lock_guard lock{mutex_};
+    maxSizeInBytes_ = maxSize.getBytes();
+    if (sizeInBytes_ <= maxSizeInBytes_) {
+      return;
+    }
+    for (auto& [size, blocks] : blocks_) {
+      for (void* block : blocks) {
+        deallocate_(block, size);
+      }
+    }
+    blocks_.clear();
+    sizeInBytes_ = 0;
+  }
+
+  // The total size of the blocks that are currently in the pool.
+  MemorySize size() {
+    std::lock_guard lock{mutex_};
+    return MemorySize::bytes(sizeInBytes_);
+  }
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_ALLOCATIONPOOL_H
@@ -8,9 +8,18 @@
 
 #include <absl/strings/str_cat.h>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <new>
+#include <utility>
 
 #include "backports/functional.h"
+#include "util/AllocationPool.h"
 #include "util/MemorySize/MemorySize.h"
 #include "util/Synchronized.h"
 
@@ -38,18 +47,40 @@ class AllocationExceedsLimitException : public std::exception {
 // not enough memory is left, an AllocationExceedsLimitException is thrown. Note
 // that need a separate class for this because there can be many Allocation
 // objects at the same time (hence the wrapper class and the synchronization
-// below).
+// below). A limit can have a `parent` limit (e.g. the limit of a single query
+// below the limit of the whole server), then all the allocations and
+// deallocations also count towards the parent.
 class AllocationMemoryLeft {
+ public:
+  using Parent =
+      std::shared_ptr<ad_utility::Synchronized<AllocationMemoryLeft, SpinLock>>;
+
+ private:
   // Remaining free memory.
   MemorySize free_;
+  // The minimum of `free_` since the last call to `exchangeMinimumMemoryLeft`,
+  // see `PeakMemoryUsageMeasurement` below.
+  MemorySize minFree_;
+  // The enclosing limit, or `nullptr`. Note: The parent is always locked while
+  // the child is locked, never the other way around, so there are no
+  // deadlocks.
+  Parent parent_;
 
  public:
-  AllocationMemoryLeft(MemorySize n) : free_(n) {}
+  AllocationMemoryLeft(MemorySize n, Parent parent = nullptr)
+      : free_(n), minFree_(n), parent_{std::move(parent)} {}
 
   // Called before memory is allocated.
   bool decrease_if_enough_left_or_return_false(MemorySize n) noexcept {
     if (n <= free_) {
+      if (parent_ &&
+          !parent_->wlock()->decrease_if_enough_left_or_return_false(n)) {
+        return false;
+      }
       free_ -= n;
+      if (free_ < minFree_) {
+        minFree_ = free_;
+      }
       return true;
     } else {
       return false;
@@ -59,13 +90,35 @@ class AllocationMemoryLeft {
   // Called before memory is allocated.
   void decrease_if_enough_left_or_throw(MemorySize n) {
     if (!decrease_if_enough_left_or_return_false(n)) {
-      throw AllocationExceedsLimitException{n, free_};
+      throw AllocationExceedsLimitException{n, amountMemoryLeftWithParents()};
     }
   }
 
   // Called after memory is deallocated.
-  void increase(MemorySize n) { free_ += n; }
+  void increase(MemorySize n) {
+    free_ += n;
+    if (parent_) {
+      parent_->wlock()->increase(n);
+    }
+  }
+
+  // Return the memory that is left on this level, regardless of the parents.
   [[nodiscard]] MemorySize amountMemoryLeft() const { return free_; }
+
+  // Return the memory that can actually be allocated, which is the minimum of
+  // the memory left on this level and on all the parent levels.
+  [[nodiscard]] MemorySize amountMemoryLeftWithParents() const {
+    if (!parent_) {
+      return free_;
+    }
+    return std::min(free_, parent_->wlock()->amountMemoryLeftWithParents());
+  }
+
+  // Return the minimum of the memory left since the last call to this
+  // function, and replace it by `minimum`.
+  MemorySize exchangeMinimumMemoryLeft(MemorySize minimum) {
+    return std::exchange(minFree_, minimum);
+  }
 };
 
 // Threadsafe Wrapper around `AllocationMemoryLeft`.
@@ -98,6 +151,57 @@ makeAllocationMemoryLeftThreadsafeObject(MemorySize n) {
       ad_utility::Synchronized<detail::AllocationMemoryLeft, SpinLock>>(n)};
 }
 
+// Set up a shared allocation state with the limit `n` that is nested in the
+// `parent` limit: An allocation only succeeds if there is enough memory left
+// in both limits, and it counts towards both of them. This can be used to
+// assign a budget to a single query that is also part of the limit of the
+// whole server.
+inline detail::AllocationMemoryLeftThreadsafe
+makeChildAllocationMemoryLeftThreadsafeObject(
+    const detail::AllocationMemoryLeftThreadsafe& parent, MemorySize n) {
+  return detail::AllocationMemoryLeftThreadsafe{std::make_shared<
+      ad_utility::Synchronized<detail::AllocationMemoryLeft, SpinLock>>(
+      n, parent.ptr())};
+}
+
+// Measure the peak memory usage of the allocations from a shared memory limit
+// between the construction of this object and the call to `stop`, relative to
+// the memory that was already allocated at the construction. Measurements may
+// be nested, then the peak of the outer measurement also includes the peak of
+// the inner one. Note: All the allocations from the limit count, so if the
+// limit is shared by several concurrent computations (e.g. by all the queries
+// of the server), the peak also includes the allocations of the others. Use a
+// separate child limit per computation (see
+// `makeChildAllocationMemoryLeftThreadsafeObject`) to avoid this.
+class PeakMemoryUsageMeasurement {
+  detail::AllocationMemoryLeftThreadsafe memoryLeft_;
+  MemorySize freeAtStart_;
+  // The minimum of the memory left before this measurement was started, which
+  // is restored in `stop` for the enclosing measurements.
+  MemorySize previousMinimum_;
+
+ public:
+  explicit PeakMemoryUsageMeasurement(
+      detail::AllocationMemoryLeftThreadsafe memoryLeft)
+      : memoryLeft_{std::move(memoryLeft)} {
+    auto lock = memoryLeft_.ptr()->wlock();
+    freeAtStart_ = lock->amountMemoryLeft();
+    previousMinimum_ = lock->exchangeMinimumMemoryLeft(freeAtStart_);
+  }
+
+  // Stop the measurement and return the peak memory usage. Must be called at
+  // most once.
+  MemorySize stop() {
+    auto lock = memoryLeft_.ptr()->wlock();
+    auto minimum = lock->exchangeMinimumMemoryLeft(previousMinimum_);
+    if (minimum < previousMinimum_) {
+      lock->exchangeMinimumMemoryLeft(minimum);
+    }
+    return minimum < freeAtStart_ ? freeAtStart_ - minimum
+                                  : MemorySize::bytes(0);
+  }
+};
+
 /*
 A lambda for use with `AllocatorWithLimit`.
 
@@ -108,6 +212,72 @@ The lambda is given at construction.
 */
 using ClearOnAllocation = std::function<void(MemorySize)>;
 
+namespace detail {
+// Allocations of at least this many bytes are aligned to the size of a
+// (transparent) huge page on x86-64, s.t. they can be backed by huge pages.
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// If true, the operating system is advised to back the large allocations with
+// transparent huge pages, which reduces the number of TLB misses when large
+// `IdTable`s are joined or sorted. Set via the runtime parameter
+// `use-transparent-huge-pages`.
+inline std::atomic<bool> useTransparentHugePages = false;
+
+// Allocations of at least this many bytes are served from (and returned to)
+// the process-wide `AllocationPool`. Smaller allocations are cheap anyway.
+constexpr size_t MIN_POOLED_ALLOCATION_SIZE = 64 * 1024;
+// The alignment of all the allocations that are pooled and smaller than
+// `HUGE_PAGE_SIZE`. It is large enough for all the types that we use.
+constexpr size_t POOLED_ALLOCATION_ALIGNMENT = 64;
+
+// The alignment that is used by `allocateBytes`.
+constexpr size_t alignmentForAllocation(size_t numBytes) {
+  return numBytes >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE
+                                    : POOLED_ALLOCATION_ALIGNMENT;
+}
+
+// Allocate `numBytes >= MIN_POOLED_ALLOCATION_SIZE` bytes, aligned according
+// to `alignmentForAllocation`. The memory has to be freed by `deallocateBytes`.
+inline void* allocateBytes(size_t numBytes) {
+  void* ptr = ::operator new(
+      numBytes, std::align_val_t{alignmentForAllocation(numBytes)});
+#ifdef MADV_HUGEPAGE
+  if (numBytes >= HUGE_PAGE_SIZE &&
+      useTransparentHugePages.load(std::memory_order_relaxed)) {
+    // The advice is only a hint, so errors (e.g. if transparent huge pages are
+    // disabled for the system) are ignored. The pages of physical memory are
+    // only assigned when they are first touched, so they are on the NUMA node
+    // of the thread that fills the allocation.
+    ::madvise(ptr, numBytes / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE, MADV_HUGEPAGE);
+  }
+#endif
+  return ptr;
+}
+
+// Free memory that has been allocated by `allocateBytes(numBytes)`.
+inline void deallocateBytes(void* ptr, size_t numBytes) {
+  ::operator delete(ptr, std::align_val_t{alignmentForAllocation(numBytes)});
+}
+
+// The pool of freed blocks that is shared by all the `AllocatorWithLimit`s.
+// Its maximum size is set via the runtime parameter
+// `allocation-pool-max-size`.
+// Note: The pool is deliberately never destroyed, because blocks might still
+// be deallocated during the destruction of other static objects.
+inline AllocationPool& allocationPool() {
+  static auto* pool =
+      new AllocationPool{&deallocateBytes, MemorySize::bytes(0)};
+  return *pool;
+}
+}  // namespace detail
+
+// Enable or disable the use of transparent huge pages for large allocations,
+// see `detail::useTransparentHugePages`.
+inline void setUseTransparentHugePages(bool useHugePages) {
+  detail::useTransparentHugePages.store(useHugePages,
+                                        std::memory_order_relaxed);
+}
+
 /// A Noop lambda that will be used as a template default parameter
 /// in the `AllocatorWithLimit` class.
 inline ClearOnAllocation noClearOnAllocation = [](MemorySize) {};
@@ -229,29 +399,54 @@ class AllocatorWithLimit {
       memoryLeft_.ptr()->wlock()->decrease_if_enough_left_or_throw(bytesNeeded);
     }
     // the actual allocation
+    if (isPooled(n)) {
+      void* ptr = detail::allocationPool().get(bytesNeeded.getBytes());
+      if (ptr == nullptr) {
+        ptr = detail::allocateBytes(bytesNeeded.getBytes());
+      }
+      return static_cast<T*>(ptr);
+    }
     return allocator_.allocate(n);
   }
 
   // An allocator must have a function "deallocate" with exactly this signature.
   void deallocate(T* p, std::size_t n) {
-    // free the memory
-    allocator_.deallocate(p, n);
+    // free the memory (or keep it in the pool for a later allocation)
+    if (isPooled(n)) {
+      const size_t numBytes = n * sizeof(T);
+      if (!detail::allocationPool().put(p, numBytes)) {
+        detail::deallocateBytes(p, numBytes);
+      }
+    } else {
+      allocator_.deallocate(p, n);
+    }
     // Update the amount of memory left.
     memoryLeft_.ptr()->wlock()->increase(MemorySize::bytes(n * sizeof(T)));
   }
 
   /// Return the number of bytes, that this allocator and all of its copies
-  /// currently have available
+  /// currently have available (including the limits of the parents, see
+  /// `makeChildAllocationMemoryLeftThreadsafeObject`).
   [[nodiscard]] MemorySize amountMemoryLeft() const {
     // casting is ok, because the actual numFreeBytes call
     // is const, and everything else is locking
     return const_cast<AllocatorWithLimit*>(this)
         ->memoryLeft_.ptr()
         ->wlock()
-        ->amountMemoryLeft();
+        ->amountMemoryLeftWithParents();
   }
 
   const auto& getMemoryLeft() const { return memoryLeft_; }
+
+ private:
+  // Return true iff an allocation of `n` elements is served via the
+  // `detail::allocationPool()`.
+  static bool isPooled(std::size_t n) {
+    return alignof(T) <= detail::POOLED_ALLOCATION_ALIGNMENT &&
+           n * sizeof(T) >= detail::MIN_POOLED_ALLOCATION_SIZE;
+  }
+
+ public:
   const auto& clearOnAllocation() const { return clearOnAllocation_; }
 
   // The STL needs two allocators to be equal if and only they refer to the same
@@ -0,0 +1,73 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_BITPACKING_H
+#define QLEVER_SRC_UTIL_BITPACKING_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "util/BitUtils.h"
+
+namespace ad_utility {
+
+// Return the number of 64-bit words that `bitPack` needs for `numValues`
+// values with `numBits` bits each.
+constexpr inline size_t numBitPackedWords(size_t numValues, uint8_t numBits) {
+  return (numValues * numBits + 63) / 64;
+}
+
+// Bit-pack the `numValues` values that are returned by `getValue(i)`, each of
+// which must fit into `numBits` bits.
+template <typename F>
+std::vector<uint64_t> bitPack(size_t numValues, uint8_t numBits,
+                              const F& getValue) {
+  std::vector<uint64_t> packed(numBitPackedWords(numValues, numBits), 0);
+  if (numBits == 0) {
+    return packed;
+  }
+  for (size_t i = 0; i < numValues; ++i) {
+    uint64_t value = getValue(i);
+    size_t position = i * numBits;
+    size_t word = position / 64;
+    size_t offset = position % 64;
+    packed[word] |= value << offset;
+    if (offset + numBits > 64) {
+      packed[word + 1] |= value >> (64 - offset);
+    }
+  }
+  return packed;
+}
+
+// Return the `i`-th value that was packed by `bitPack` with `numBits` bits.
+// The `packed` words are given as raw bytes, s.t. they don't have to be
+// aligned (e.g. when they are part of a larger buffer that was read from
+// disk).
+inline uint64_t bitUnpack(const char* packed, uint8_t numBits, size_t i) {
+  if (numBits == 0) {
+    return 0;
+  }
+  auto word = [packed](size_t index) {
+    uint64_t result;
+    std::memcpy(&result, packed + index * sizeof(uint64_t), sizeof(uint64_t));
+    return result;
+  };
+  size_t position = i * numBits;
+  size_t offset = position % 64;
+  uint64_t value = word(position / 64) >> offset;
+  if (offset + numBits > 64) {
+    value |= word(position / 64 + 1) << (64 - offset);
+  }
+  return value & bitMaskForLowerBits(numBits);
+}
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_BITPACKING_H
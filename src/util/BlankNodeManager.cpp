@@ -11,55 +11,90 @@
 
 #include <absl/cleanup/cleanup.h>
 
+#include <algorithm>
+#include <functional>
+#include <thread>
+
 #include "util/Exception.h"
 
 namespace ad_utility {
 
 // _____________________________________________________________________________
-BlankNodeManager::BlankNodeManager(uint64_t minIndex)
-    : minIndex_(minIndex),
-      state_{SlowRandomIntGenerator<uint64_t>(0, totalAvailableBlocks_ - 1)} {}
+BlankNodeManager::BlankNodeManager(uint64_t minIndex) : minIndex_(minIndex) {
+  // Every shard needs at least one block.
+  size_t numShards = static_cast<size_t>(std::clamp<uint64_t>(
+      totalAvailableBlocks_, uint64_t{1}, uint64_t{maxNumShards_}));
+  shards_.reserve(numShards);
+  for (size_t i = 0; i < numShards; ++i) {
+    shards_.emplace_back(SlowRandomIntGenerator<uint64_t>(
+        0, (totalAvailableBlocks_ - 1 - i) / numShards));
+  }
+}
+
+// _____________________________________________________________________________
+size_t BlankNodeManager::getShardIndexForCurrentThread() const {
+  static thread_local const size_t threadHash =
+      std::hash<std::thread::id>{}(std::this_thread::get_id());
+  return threadHash % shards_.size();
+}
 
 // _____________________________________________________________________________
 BlankNodeManager::Block BlankNodeManager::allocateBlock() {
+  auto blocks = allocateBlocks(1);
+  return std::move(blocks.front());
+}
+
+// _____________________________________________________________________________
+auto BlankNodeManager::allocateBlocks(size_t numBlocks) -> std::vector<Block> {
+  randomBlockWasRequested_ = true;
   // The Random-Generation Algorithm's performance is reduced once the number of
-  // used blocks exceeds a limit.
-  auto stateLock = state_.wlock();
-  stateLock->randomBlockWasRequested_ = true;
-  auto numBlocks = stateLock->usedBlocksSet_.size();
-  AD_CORRECTNESS_CHECK(
-      numBlocks < totalAvailableBlocks_ / 256,
-      absl::StrCat("Critical high number of blank node blocks in use: ",
-                   numBlocks, " blocks"));
-
-  auto& usedBlocksSet = stateLock->usedBlocksSet_;
-  while (true) {
-    auto blockIdx = stateLock->randBlockIndex_();
-    auto [_, inserted] = usedBlocksSet.insert(blockIdx);
+  // used blocks exceeds a limit. The blocks are counted before they are
+  // inserted, s.t. concurrent allocations can't exceed the limit together.
+  auto numBlocksBefore = numBlocksUsed_.fetch_add(numBlocks);
+  if (numBlocksBefore + numBlocks > totalAvailableBlocks_ / 256) {
+    numBlocksUsed_ -= numBlocks;
+    AD_THROW(absl::StrCat("Critical high number of blank node blocks in use: ",
+                          numBlocksBefore, " blocks"));
+  }
+
+  std::vector<Block> result;
+  result.reserve(numBlocks);
+  size_t shardIdx = getShardIndexForCurrentThread();
+  auto shard = shards_[shardIdx].wlock();
+  while (result.size() < numBlocks) {
+    auto blockIdx = shard->randBlockIndex_() * shards_.size() + shardIdx;
+    auto [_, inserted] = shard->usedBlocksSet_.insert(blockIdx);
     if (inserted) {
-      return Block(blockIdx, minIndex_ + blockIdx * blockSize_);
+      result.push_back(Block(blockIdx, minIndex_ + blockIdx * blockSize_));
     }
   }
+  return result;
 }
 
 // ______________________________________________________________________________
-[[nodiscard]] auto BlankNodeManager::allocateExplicitBlock(
-    uint64_t blockIdx, boost::optional<WriteLock&> lockOpt) -> Block {
-  auto localLock =
-      lockOpt.has_value() ? std::nullopt : std::optional{state_.wlock()};
-  auto& lock = lockOpt.has_value() ? lockOpt.value() : localLock.value();
-  auto& usedBlocksSet = lock->usedBlocksSet_;
-  AD_CONTRACT_CHECK(!lock->randomBlockWasRequested_,
+[[nodiscard]] auto BlankNodeManager::allocateExplicitBlock(uint64_t blockIdx)
+    -> Block {
+  AD_CONTRACT_CHECK(!randomBlockWasRequested_,
                     "The explicit allocation of blank node blocks (e.g. from "
                     "serialized updates or cached results) has to happen "
                     "before any additional random blank nodes are requested");
-  auto [_, inserted] = usedBlocksSet.insert(blockIdx);
+  auto [_, inserted] =
+      getShard(blockIdx).wlock()->usedBlocksSet_.insert(blockIdx);
   AD_CONTRACT_CHECK(inserted,
                     "Trying to explicitly allocate a block of blank nodes that "
                     "has previously already been allocated.");
+  ++numBlocksUsed_;
   return Block(blockIdx, minIndex_ + blockIdx * blockSize_);
 }
 
+// _____________________________________________________________________________
+void BlankNodeManager::freeBlock(uint64_t blockIdx) {
+  size_t elementsRemoved =
+      getShard(blockIdx).wlock()->usedBlocksSet_.erase(blockIdx);
+  AD_CONTRACT_CHECK(elementsRemoved == 1);
+  --numBlocksUsed_;
+}
+
 // _____________________________________________________________________________
 BlankNodeManager::Block::Block(uint64_t blockIndex, uint64_t startIndex)
     : blockIdx_(blockIndex), startIdx_(startIndex), nextIdx_(startIndex) {}
@@ -73,7 +108,20 @@ BlankNodeManager::LocalBlankNodeManager::LocalBlankNodeManager(
 uint64_t BlankNodeManager::LocalBlankNodeManager::getId() {
   auto& blocks = blocks_->blocks_;
   if (blocks.empty() || blocks.back().nextIdx_ == idxAfterCurrentBlock_) {
-    blocks.emplace_back(blankNodeManager_->allocateBlock());
+    auto& reservedBlocks = blocks_->reservedBlocks_;
+    if (reservedBlocks.empty()) {
+      // Most local vocabs only need a single block. Once a local vocab has
+      // used several blocks (e.g. for a large update), the number of blocks
+      // that are reserved at once doubles, s.t. the number of calls to the
+      // `BlankNodeManager` only grows logarithmically.
+      size_t numBlocks =
+          blocks.size() < 8
+              ? 1
+              : std::min(blocks.size(), maxNumBlocksPerReservation_);
+      reservedBlocks = blankNodeManager_->allocateBlocks(numBlocks);
+    }
+    blocks.push_back(reservedBlocks.back());
+    reservedBlocks.pop_back();
     idxAfterCurrentBlock_ = blocks.back().nextIdx_ + blockSize_;
   }
   return blocks.back().nextIdx_++;
@@ -158,7 +206,7 @@ auto BlankNodeManager::createBlockSet() -> std::shared_ptr<Blocks> {
 void BlankNodeManager::freeBlockSet(const Blocks& blocks) {
   // We keep the lock the whole time because we have to perform a consistent,
   // transactional operation on the `state_`, which itself is not threadsafe.
-  state_.withWriteLock([&blocks](auto& state) {
+  state_.withWriteLock([this, &blocks](auto& state) {
     // First unregister the UUID.
     auto it = state.managedBlockSets_.find(blocks.uuid_);
     if (it == state.managedBlockSets_.end()) {
@@ -177,10 +225,11 @@ void BlankNodeManager::freeBlockSet(const Blocks& blocks) {
     if (it->second.expired()) {
       state.managedBlockSets_.erase(it);
     }
-    auto& usedBlockSet = state.usedBlocksSet_;
     for (const auto& block : blocks.blocks_) {
-      size_t elementsRemoved = usedBlockSet.erase(block.blockIdx_);
-      AD_CONTRACT_CHECK(elementsRemoved == 1);
+      freeBlock(block.blockIdx_);
+    }
+    for (const auto& block : blocks.reservedBlocks_) {
+      freeBlock(block.blockIdx_);
     }
   });
 }
@@ -214,7 +263,7 @@ BlankNodeManager::registerAndAllocateBlockSet(
     it->second = blocks;
     // If the block is new, we need to allocate all the specified block indices.
     for (const auto& idx : entry.blockIndices_) {
-      blocks->blocks_.push_back(allocateExplicitBlock(idx, lock));
+      blocks->blocks_.push_back(allocateExplicitBlock(idx));
     }
     return blocks;
   } else {
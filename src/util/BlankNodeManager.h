@@ -13,6 +13,7 @@
 
 #include <gtest/gtest_prod.h>
 
+#include <atomic>
 #include <boost/functional/hash.hpp>
 #include <boost/optional.hpp>
 #include <boost/uuid/uuid.hpp>
@@ -37,6 +38,9 @@ namespace ad_utility {
  * A `LocalVocab` can register new blank nodes (e.g. resulting from a `Service`
  * operation) by obtaining a `Block` of currently unused indices using it's own
  * `LocalBlankNodeManager` from the `BlankNodeManager`.
+ * The used blocks are distributed over several independently locked shards,
+ * and each thread allocates its random blocks from "its" shard, s.t.
+ * concurrent queries, updates, and parsers don't contend for a single lock.
  */
 class BlankNodeManager {
  public:
@@ -53,25 +57,50 @@ class BlankNodeManager {
   const uint64_t totalAvailableBlocks_ =
       (ValueId::maxIndex - minIndex_ + 1) / blockSize_;
 
+  // The maximal number of shards of the used blocks (see `Shard` below).
+  static constexpr size_t maxNumShards_ = 16;
+
+  // The maximal number of blocks that a `LocalBlankNodeManager` reserves at
+  // once (see `LocalBlankNodeManager::getId`).
+  static constexpr size_t maxNumBlocksPerReservation_ = 64;
+
  private:
   // Forward declaration because of cyclic dependency.
   struct Blocks;
 
-  // All the data members of this `BlankNodeManager`, wrapped into a struct,
-  // s.t. we can synchronize the access and make the `BlankNodeManager`
-  // threadsafe.
-  struct State {
-    // Random generator for block indices.
+  // The used blocks with `blockIdx % shards_.size() == i` are managed by the
+  // shard with index `i`, which has its own lock.
+  struct Shard {
+    // Random generator for the block indices of this shard (the generated
+    // number `r` stands for the block index `r * shards_.size() + i`).
     SlowRandomIntGenerator<uint64_t> randBlockIndex_;
 
+    // Hash set the stores the indices of all the blank node blocks of this
+    // shard that are currently reserved by any of the `LocalBlankNodeManager`
+    // that are currently alive.
+    HashSet<uint64_t> usedBlocksSet_;
+
+    explicit Shard(SlowRandomIntGenerator<uint64_t> randBlockIndex)
+        : randBlockIndex_{std::move(randBlockIndex)} {}
+  };
+  std::vector<Synchronized<Shard>> shards_;
+
+  // The total number of used blocks in all the shards.
+  std::atomic<size_t> numBlocksUsed_ = 0;
+
+  // Keep track of whether the method for retrieving a random block has been
+  // called at least once. after this point, the allocation of blocks by
+  // explicit indices is forbidden.
+  std::atomic<bool> randomBlockWasRequested_ = false;
+
+  // The data members of this `BlankNodeManager` that manage the sets of
+  // blocks, wrapped into a struct, s.t. we can synchronize the access and make
+  // the `BlankNodeManager` threadsafe. When both are required, the lock for
+  // the `state_` has to be acquired before the lock of a shard.
+  struct State {
     // A random generator for UUIDs.
     boost::uuids::random_generator uuidGenerator_;
 
-    // Hash set the stores the indices of all the blank node blocks that are
-    // currently reserved by any of the `LocalBlankNodeManager` that are
-    // currently alive.
-    HashSet<uint64_t> usedBlocksSet_;
-
     // Each set of blocks that is currently managed by a `LocalBlankNodeManager`
     // is assigned a UUID. This map keeps track of the currently active sets,
     // but does not participate in their (shared) ownership, hence the
@@ -79,22 +108,11 @@ class BlankNodeManager {
     ad_utility::HashMap<boost::uuids::uuid, std::weak_ptr<Blocks>,
                         boost::hash<boost::uuids::uuid>>
         managedBlockSets_;
-
-    // Keep track of whether the method for retrieving a random block has been
-    // called at least once. after this point, the allocation of blocks by
-    // explicit indices is forbidden.
-    ad_utility::ResetWhenMoved<bool, false> randomBlockWasRequested_ = false;
-
-    // Constructor, all members except for the block index generator can be
-    // default-constructed.
-    explicit State(SlowRandomIntGenerator<uint64_t> randBlockIndex)
-        : randBlockIndex_{std::move(randBlockIndex)} {}
   };
 
   // The actual state variable, wrapped in a `Synchronized` to enforce
   // threadsafe access.
   Synchronized<State> state_;
-  using WriteLock = decltype(state_.wlock());
 
   // A block of blank node indices.
   class Block {
@@ -122,6 +140,10 @@ class BlankNodeManager {
     BlankNodeManager* manager_;
     boost::uuids::uuid uuid_;
     std::vector<Block> blocks_;
+    // Blocks that have been reserved ahead of time, but from which no index
+    // has been handed out yet. They are freed together with the `blocks_`,
+    // but are not serialized.
+    std::vector<Block> reservedBlocks_;
     ad_utility::ThrowInDestructorIfSafe throwIfSafe_;
 
     explicit Blocks(BlankNodeManager* manager, boost::uuids::uuid uuid)
@@ -241,17 +263,17 @@ class BlankNodeManager {
   // Allocate and retrieve a block of new blank node indexes.
   [[nodiscard]] Block allocateBlock();
 
+  // Allocate and retrieve `numBlocks` blocks of new blank node indexes. The
+  // blocks are taken from the shard of the calling thread, s.t. only a single
+  // lock has to be acquired.
+  [[nodiscard]] std::vector<Block> allocateBlocks(size_t numBlocks);
+
   // Allocate and return the block with the given `blockIdx`. This function can
   // only be safely called when no calls to `allocateBlock()` have been
   // performed. It can for example be used to restore blocks from previously
   // serialized cache results or updates when the engine is started, but before
-  // any queries are performed. Can be used while alreading holding a lock to
-  // the synchronized `state`, in which case the lock has to be passed as the
-  // second argument. Can also be used without holding the lock, then the second
-  // argument has to be `boost::none` and the function obtains its own lock
-  // (this is used for more fine-grained unit tests).
-  [[nodiscard]] Block allocateExplicitBlock(
-      uint64_t blockIdx, boost::optional<WriteLock&> lock = boost::none);
+  // any queries are performed.
+  [[nodiscard]] Block allocateExplicitBlock(uint64_t blockIdx);
 
   // If the `uuid` of the `entry` is not yet registered with this
   // `BlankNodeManager`, register and return a new `Blocks` struct with the
@@ -265,7 +287,25 @@ class BlankNodeManager {
       const LocalBlankNodeManager::OwnedBlocksEntry& entry);
 
   // Get the number of currently used blocks
-  size_t numBlocksUsed() const { return state_.rlock()->usedBlocksSet_.size(); }
+  size_t numBlocksUsed() const { return numBlocksUsed_.load(); }
+
+ private:
+  // Return the shard that manages the block with the given `blockIdx`.
+  Synchronized<Shard>& getShard(uint64_t blockIdx) {
+    return shards_[blockIdx % shards_.size()];
+  }
+  const Synchronized<Shard>& getShard(uint64_t blockIdx) const {
+    return shards_[blockIdx % shards_.size()];
+  }
+
+  // Return the index of the shard from which the calling thread allocates its
+  // random blocks.
+  size_t getShardIndexForCurrentThread() const;
+
+  // Free the block with the given `blockIdx`, which must currently be used.
+  void freeBlock(uint64_t blockIdx);
+
+ public:
 
   FRIEND_TEST(BlankNodeManager, blockAllocationAndFree);
   FRIEND_TEST(BlankNodeManager, moveLocalBlankNodeManager);
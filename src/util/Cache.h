@@ -7,6 +7,7 @@
 #ifndef QLEVER_SRC_UTIL_CACHE_H
 #define QLEVER_SRC_UTIL_CACHE_H
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
 #include <memory>
@@ -25,6 +26,15 @@ using namespace ad_utility::memory_literals;
 
 static constexpr auto size_t_max = std::numeric_limits<size_t>::max();
 
+namespace detail {
+// Detect whether the `ScoreCalculator` of a `FlexibleCache` wants to be
+// notified of the score of each entry that is evicted from the cache (see the
+// `GDSFCache` below for an example).
+template <typename T, typename Score>
+CPP_requires(HasOnEviction,
+             requires(T& t, const Score& score)(t.onEviction(score)));
+}  // namespace detail
+
 /*
  @brief Associative array for almost arbitrary keys and values that acts as a
  cache with fixed memory capacity.
@@ -48,7 +58,8 @@ static constexpr auto size_t_max = std::numeric_limits<size_t>::max();
  @tparam AccessUpdater function (Score, Value) -> Score. Each time a value is
  accessed, its previous score and the value are used to calculate a new score.
  @tparam ScoreCalculator function Value -> Score to determine the Score of a a
- newly inserted entry
+ newly inserted entry. If it has a member function `onEviction(Score)`, then
+ this function is called with the score of each entry that is evicted.
  @tparam ValueSizeGetter function Value -> MemorySize to determine the actual
  size of a value for statistics
  */
@@ -323,6 +334,16 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
         });
   }
 
+  /// Return the total size of the pinned and the non-pinned entries in O(1),
+  /// as it was when they were inserted (in contrast to `pinnedSize()` and
+  /// `nonPinnedSize()` this doesn't reflect later changes of the sizes).
+  [[nodiscard]] MemorySize pinnedSizeAtInsertion() const {
+    return _totalSizePinned;
+  }
+  [[nodiscard]] MemorySize nonPinnedSizeAtInsertion() const {
+    return _totalSizeNonPinned;
+  }
+
   /// Return the number of non-pinned cache entries
   [[nodiscard]] size_t numNonPinnedEntries() const { return _accessMap.size(); }
 
@@ -377,6 +398,16 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
     return true;
   }
 
+  // Delete the non-pinned entry with the smallest score. Return false if there
+  // is no non-pinned entry.
+  bool removeEntryWithSmallestScore() {
+    if (_entries.empty()) {
+      return false;
+    }
+    removeOneEntry();
+    return true;
+  }
+
   // Get all the keys of entries that are currently stored (but not pinned) in
   // the cache.
   // NOTE: This function returns a lazy view, so the behavior is undefined if
@@ -389,6 +420,10 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   void removeOneEntry() {
     AD_CONTRACT_CHECK(!_entries.empty());
     auto handle = _entries.pop();
+    if constexpr (CPP_requires_ref(detail::HasOnEviction, ScoreCalculator,
+                                   Score)) {
+      _scoreCalculator.onEviction(handle.score());
+    }
     _totalSizeNonPinned =
         _totalSizeNonPinned - _valueSizeGetter(*handle.value().value());
     _accessMap.erase(handle.value().key());
@@ -483,6 +518,101 @@ CPP_template(typename Key, typename Value, typename ValueSizeGetterT)(
              detail::timeAsScore{}, ValueSizeGetterT{}) {}
 };
 
+namespace detail {
+// Helper types for the `GDSFCache` below. The score of an entry is its
+// priority, and the number of accesses, which is needed to recompute the
+// priority when the entry is accessed again.
+struct GdsfScore {
+  double priority_;
+  size_t frequency_;
+};
+
+struct GdsfScoreComparator {
+  bool operator()(const GdsfScore& a, const GdsfScore& b) const {
+    return a.priority_ < b.priority_;
+  }
+};
+
+// The priority of an entry is `L + frequency * cost / size`, where `L` (the
+// "inflation") is the priority of the entry that was evicted last. The
+// inflation is shared between the `GdsfScoreCalculator` (which is notified of
+// the evictions) and the `GdsfAccessUpdater`.
+template <typename ValueSizeGetterT, typename CostGetterT>
+struct GdsfPriority {
+  std::shared_ptr<double> inflation_ = std::make_shared<double>(0.0);
+  ValueSizeGetterT valueSizeGetter_{};
+  CostGetterT costGetter_{};
+
+  template <typename Value>
+  GdsfScore operator()(const Value& value, size_t frequency) const {
+    // The `+ 1` avoids a division by zero for empty values.
+    auto size = static_cast<double>(valueSizeGetter_(value).getBytes() + 1);
+    auto cost = static_cast<double>(costGetter_(value));
+    return {*inflation_ + static_cast<double>(frequency) * cost / size,
+            frequency};
+  }
+};
+
+template <typename ValueSizeGetterT, typename CostGetterT>
+struct GdsfScoreCalculator {
+  GdsfPriority<ValueSizeGetterT, CostGetterT> priority_;
+  template <typename Value>
+  GdsfScore operator()(const Value& value) const {
+    return priority_(value, 1);
+  }
+  void onEviction(const GdsfScore& score) {
+    *priority_.inflation_ = std::max(*priority_.inflation_, score.priority_);
+  }
+};
+
+template <typename ValueSizeGetterT, typename CostGetterT>
+struct GdsfAccessUpdater {
+  GdsfPriority<ValueSizeGetterT, CostGetterT> priority_;
+  // The `entry` is the entry of the `FlexibleCache`, which holds a pointer to
+  // the value.
+  template <typename Entry>
+  GdsfScore operator()(const GdsfScore& score, const Entry& entry) const {
+    return priority_(*entry.value(), score.frequency_ + 1);
+  }
+};
+}  // namespace detail
+
+// A cache with the GreedyDual-Size-Frequency (GDSF) eviction policy: The entry
+// with the lowest `frequency * cost / size` is evicted first, where
+// `frequency` is the number of accesses and `cost` is given by the
+// `CostGetterT` (e.g. the time it took to compute the value). To let entries
+// that are no longer accessed age, the priority of the last evicted entry is
+// added to the priority of each entry when it is inserted or accessed. That
+// way, a large value that is cheap to compute is evicted before a small value
+// that was expensive to compute, even if the latter was accessed less recently.
+CPP_template(typename Key, typename Value, typename ValueSizeGetterT,
+             typename CostGetterT)(
+    requires ValueSizeGetter<ValueSizeGetterT, Value>) class GDSFCache
+    : public HeapBasedCache<
+          Key, Value, detail::GdsfScore, detail::GdsfScoreComparator,
+          detail::GdsfAccessUpdater<ValueSizeGetterT, CostGetterT>,
+          detail::GdsfScoreCalculator<ValueSizeGetterT, CostGetterT>,
+          ValueSizeGetterT> {
+  using Priority = detail::GdsfPriority<ValueSizeGetterT, CostGetterT>;
+  using Base =
+      HeapBasedCache<Key, Value, detail::GdsfScore, detail::GdsfScoreComparator,
+                     detail::GdsfAccessUpdater<ValueSizeGetterT, CostGetterT>,
+                     detail::GdsfScoreCalculator<ValueSizeGetterT, CostGetterT>,
+                     ValueSizeGetterT>;
+
+  explicit GDSFCache(size_t capacityNumEls, MemorySize capacitySize,
+                     MemorySize maxSizeSingleEl, Priority priority)
+      : Base(capacityNumEls, capacitySize, maxSizeSingleEl,
+             detail::GdsfScoreComparator{}, {priority}, {priority},
+             ValueSizeGetterT{}) {}
+
+ public:
+  explicit GDSFCache(size_t capacityNumEls = size_t_max,
+                     MemorySize capacitySize = MemorySize::max(),
+                     MemorySize maxSizeSingleEl = MemorySize::max())
+      : GDSFCache(capacityNumEls, capacitySize, maxSizeSingleEl, Priority{}) {}
+};
+
 /// typedef for the simple name LRUCache that is fixed to one of the possible
 /// implementations at compile time
 #ifdef _QLEVER_USE_TREE_BASED_CACHE
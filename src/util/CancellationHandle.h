@@ -8,7 +8,9 @@
 #include <absl/strings/str_cat.h>
 #include <gtest/gtest_prod.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <exception>
 #include <mutex>
@@ -20,6 +22,7 @@
 #include "util/Log.h"
 #include "util/ParseableDuration.h"
 #include "util/SourceLocation.h"
+#include "util/TransparentFunctors.h"
 #include "util/TypeTraits.h"
 #include "util/jthread.h"
 
@@ -307,6 +310,63 @@ class CancellationHandle {
 };
 
 using SharedCancellationHandle = std::shared_ptr<CancellationHandle<>>;
+
+/// Wrapper around a callable `check` (typically a call to
+/// `CancellationHandle::throwIfCancelled`) that is called in every iteration
+/// of a tight loop. A call to the wrapper only decrements a counter and
+/// invokes the `check` only on every `interval()`-th call. The interval is
+/// calibrated at runtime: It is doubled (up to `maxInterval`) as long as the
+/// time between two invocations of the `check` is shorter than
+/// `targetTimeBetweenChecks`, and halved otherwise. This keeps the overhead of
+/// the checks low without making the detection of a cancellation or timeout
+/// noticeably slower. If `Check` is `Noop`, the wrapper does nothing.
+template <typename Check>
+class AmortizedCancellationCheck {
+ public:
+  static constexpr std::chrono::steady_clock::duration
+      targetTimeBetweenChecks = DESIRED_CANCELLATION_CHECK_INTERVAL / 50;
+  static constexpr size_t maxInterval = 1 << 16;
+
+ private:
+  static constexpr bool isNoop = isSimilar<Check, Noop>;
+  Check check_;
+  size_t interval_ = 1;
+  size_t countdown_ = 1;
+  std::chrono::steady_clock::time_point lastCheck_{};
+
+  // Invoke the `check` and adapt the `interval_` to the time since the last
+  // invocation.
+  void checkAndCalibrate() {
+    check_();
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastCheck_ < targetTimeBetweenChecks) {
+      interval_ = std::min(2 * interval_, maxInterval);
+    } else if (interval_ > 1) {
+      interval_ /= 2;
+    }
+    lastCheck_ = now;
+    countdown_ = interval_;
+  }
+
+ public:
+  explicit AmortizedCancellationCheck(Check check) : check_{std::move(check)} {
+    if constexpr (!isNoop) {
+      lastCheck_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  AD_ALWAYS_INLINE void operator()() {
+    if constexpr (!isNoop) {
+      if (--countdown_ > 0) [[likely]] {
+        return;
+      }
+      checkAndCalibrate();
+    }
+  }
+
+  // The current number of calls per invocation of the `check`.
+  size_t interval() const { return interval_; }
+};
 }  // namespace ad_utility
 
 #endif  // QLEVER_CANCELLATIONHANDLE_H
@@ -0,0 +1,107 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_COMPRESSIONUSINGZSTD_ZSTDDICTIONARY_H
+#define QLEVER_SRC_UTIL_COMPRESSIONUSINGZSTD_ZSTDDICTIONARY_H
+
+#include <zdict.h>
+#include <zstd.h>
+
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/Exception.h"
+
+// A ZSTD dictionary, which improves the compression of many small inputs that
+// are similar to each other. The digested dictionaries (`ZSTD_CDict` and
+// `ZSTD_DDict`) are created once, and the thread-local compression and
+// decompression contexts of the `ZstdWrapper` are reused, s.t. compressing and
+// decompressing small inputs is cheap.
+class ZstdDictionary {
+ private:
+  struct CDictDeleter {
+    void operator()(ZSTD_CDict* d) const { ZSTD_freeCDict(d); }
+  };
+  struct DDictDeleter {
+    void operator()(ZSTD_DDict* d) const { ZSTD_freeDDict(d); }
+  };
+
+  std::vector<char> bytes_;
+  std::unique_ptr<ZSTD_CDict, CDictDeleter> cDict_;
+  std::unique_ptr<ZSTD_DDict, DDictDeleter> dDict_;
+
+ public:
+  // Create from the raw `bytes` of a dictionary (as they are returned by
+  // `bytes()`). The `compressionLevel` is used by `compress`.
+  explicit ZstdDictionary(std::vector<char> bytes, int compressionLevel = 3)
+      : bytes_{std::move(bytes)},
+        cDict_{ZSTD_createCDict(bytes_.data(), bytes_.size(),
+                                compressionLevel)},
+        dDict_{ZSTD_createDDict(bytes_.data(), bytes_.size())} {
+    AD_CORRECTNESS_CHECK(cDict_ != nullptr && dDict_ != nullptr);
+  }
+
+  // Train a dictionary with at most `maxNumBytes` bytes on the `samples`.
+  // Return `std::nullopt` if ZSTD can't train a dictionary, for example
+  // because there are too few samples.
+  static std::optional<ZstdDictionary> train(
+      const std::vector<std::vector<char>>& samples, size_t maxNumBytes,
+      int compressionLevel = 3) {
+    std::vector<char> concatenation;
+    std::vector<size_t> sampleSizes;
+    for (const auto& sample : samples) {
+      concatenation.insert(concatenation.end(), sample.begin(), sample.end());
+      sampleSizes.push_back(sample.size());
+    }
+    std::vector<char> bytes(maxNumBytes);
+    auto numBytes = ZDICT_trainFromBuffer(
+        bytes.data(), bytes.size(), concatenation.data(), sampleSizes.data(),
+        static_cast<unsigned>(sampleSizes.size()));
+    if (ZDICT_isError(numBytes)) {
+      return std::nullopt;
+    }
+    bytes.resize(numBytes);
+    return ZstdDictionary{std::move(bytes), compressionLevel};
+  }
+
+  // The raw bytes of the dictionary, e.g. for writing it to disk.
+  const std::vector<char>& bytes() const { return bytes_; }
+
+  // Compress the given byte array with the dictionary and return the result.
+  std::vector<char> compress(const void* src, size_t numBytes) const {
+    std::vector<char> result(ZSTD_compressBound(numBytes));
+    auto compressedSize = ZSTD_compress_usingCDict(
+        ZstdWrapper::compressionContext(), result.data(), result.size(), src,
+        numBytes, cDict_.get());
+    AD_CORRECTNESS_CHECK(!ZSTD_isError(compressedSize));
+    result.resize(compressedSize);
+    return result;
+  }
+
+  // Decompress the given byte array (which must have been compressed with the
+  // same dictionary) to the given buffer of the given size, returning the
+  // number of bytes of the decompressed data.
+  size_t decompressToBuffer(const char* src, size_t numBytes, void* buffer,
+                            size_t bufferCapacity) const {
+    auto decompressedSize = ZSTD_decompress_usingDDict(
+        ZstdWrapper::decompressionContext(), buffer, bufferCapacity, src,
+        numBytes, dDict_.get());
+    if (ZSTD_isError(decompressedSize)) {
+      throw std::runtime_error(std::string("error during decompression : ") +
+                               ZSTD_getErrorName(decompressedSize));
+    }
+    return decompressedSize;
+  }
+};
+
+#endif  // QLEVER_SRC_UTIL_COMPRESSIONUSINGZSTD_ZSTDDICTIONARY_H
@@ -7,18 +7,40 @@
 
 #include <zstd.h>
 
+#include <memory>
 #include <vector>
 
 #include "util/Exception.h"
 
 class ZstdWrapper {
  public:
+  // The compression and decompression contexts of the current thread. Reusing
+  // them avoids the setup of a new context for each call, which is expensive
+  // compared to the actual work for small inputs.
+  static ZSTD_CCtx* compressionContext() {
+    struct Deleter {
+      void operator()(ZSTD_CCtx* c) const { ZSTD_freeCCtx(c); }
+    };
+    thread_local std::unique_ptr<ZSTD_CCtx, Deleter> context{
+        ZSTD_createCCtx()};
+    return context.get();
+  }
+  static ZSTD_DCtx* decompressionContext() {
+    struct Deleter {
+      void operator()(ZSTD_DCtx* c) const { ZSTD_freeDCtx(c); }
+    };
+    thread_local std::unique_ptr<ZSTD_DCtx, Deleter> context{
+        ZSTD_createDCtx()};
+    return context.get();
+  }
+
   // Compress the given byte array and return the result;
   static std::vector<char> compress(const void* src, size_t numBytes,
                                     int compressionLevel = 3) {
     std::vector<char> result(ZSTD_compressBound(numBytes));
-    auto compressedSize = ZSTD_compress(result.data(), result.size(), src,
-                                        numBytes, compressionLevel);
+    auto compressedSize =
+        ZSTD_compressCCtx(compressionContext(), result.data(), result.size(),
+                          src, numBytes, compressionLevel);
     result.resize(compressedSize);
     return result;
   }
@@ -32,7 +54,8 @@ class ZstdWrapper {
     knownOriginalSize *= sizeof(T);
     std::vector<T> result(knownOriginalSize / sizeof(T));
     auto compressedSize =
-        ZSTD_decompress(result.data(), knownOriginalSize, src, numBytes);
+        ZSTD_decompressDCtx(decompressionContext(), result.data(),
+                            knownOriginalSize, src, numBytes);
     AD_CONTRACT_CHECK(compressedSize == knownOriginalSize);
     return result;
   }
@@ -43,8 +66,8 @@ class ZstdWrapper {
       requires(std::is_trivially_copyable_v<T>)) static size_t
       decompressToBuffer(const char* src, size_t numBytes, T* buffer,
                          size_t bufferCapacity) {
-    auto decompressedSize =
-        ZSTD_decompress(buffer, bufferCapacity, src, numBytes);
+    auto decompressedSize = ZSTD_decompressDCtx(
+        decompressionContext(), buffer, bufferCapacity, src, numBytes);
     if (ZSTD_isError(decompressedSize)) {
       throw std::runtime_error(std::string("error during decompression : ") +
                                ZSTD_getErrorName(decompressedSize));
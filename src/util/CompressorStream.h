@@ -11,17 +11,159 @@
 #ifndef EOF
 #define EOF std::char_traits<char>::eof()
 #endif
+#include <absl/cleanup/cleanup.h>
+#include <zlib.h>
+
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
+#include <limits>
+#include <memory>
 #include <string>
 
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/Exception.h"
 #include "util/Generator.h"
+#include "util/StringBufferPool.h"
+#include "util/ThreadSafeQueue.h"
 #include "util/http/ContentEncodingHelper.h"
 
 namespace ad_utility::streams {
 namespace io = boost::iostreams;
 using ad_utility::content_encoding::CompressionMethod;
 
+namespace detail {
+// The compression level of zstd, which is the default level of the `zstd`
+// command-line tool.
+constexpr int zstdCompressionLevel = 3;
+
+// Compress the `range` with zstd into a single frame.
+template <typename Range>
+cppcoro::generator<std::string> compressStreamWithZstd(Range range) {
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{
+      ZSTD_createCCtx(), &ZSTD_freeCCtx};
+  ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel,
+                         zstdCompressionLevel);
+  std::string output;
+  // Compress the `input` and append the result to the `output`. For
+  // `ZSTD_e_continue`, the compressed data might be buffered internally.
+  auto compress = [&context, &output](std::string_view input,
+                                      ZSTD_EndDirective mode) {
+    ZSTD_inBuffer in{input.data(), input.size(), 0};
+    bool done = false;
+    while (!done) {
+      size_t oldSize = output.size();
+      output.resize(oldSize + ZSTD_CStreamOutSize());
+      ZSTD_outBuffer out{output.data() + oldSize, output.size() - oldSize, 0};
+      size_t remaining = ZSTD_compressStream2(context.get(), &out, &in, mode);
+      AD_CORRECTNESS_CHECK(!ZSTD_isError(remaining),
+                           ZSTD_getErrorName(remaining));
+      output.resize(oldSize + out.pos);
+      done = mode == ZSTD_e_continue ? in.pos == in.size : remaining == 0;
+    }
+  };
+  for (const auto& value : range) {
+    compress(value, ZSTD_e_continue);
+    if (!output.empty()) {
+      co_yield output;
+      output.clear();
+    }
+  }
+  compress({}, ZSTD_e_end);
+  co_yield output;
+}
+
+// The size of the window of the deflate algorithm, which is the maximal
+// distance of a back reference.
+constexpr size_t deflateWindowSize = 32 * 1024;
+
+// A chunk of the input of `compressStreamInParallel`, together with the end
+// of the input that precedes it (at most the `deflateWindowSize`).
+struct ChunkWithDictionary {
+  std::string dictionary_;
+  std::string chunk_;
+};
+
+// A compressed chunk, together with the size and the checksum (CRC-32 for
+// gzip, Adler-32 for deflate) of the uncompressed chunk.
+struct CompressedChunk {
+  std::string compressed_;
+  size_t uncompressedSize_ = 0;
+  uLong checksum_ = 0;
+};
+
+// Compress the `input` with the deflate algorithm into raw deflate blocks
+// (without a header and a trailer), using the `dictionary` for back
+// references. For `Z_SYNC_FLUSH`, the last block is not final and ends at a
+// byte boundary, s.t. such blocks can be concatenated.
+inline std::string deflateRaw(std::string_view dictionary,
+                              std::string_view input, int flush) {
+  AD_CORRECTNESS_CHECK(input.size() <= std::numeric_limits<uInt>::max());
+  z_stream stream{};
+  AD_CORRECTNESS_CHECK(deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -15, 8,
+                                    Z_DEFAULT_STRATEGY) == Z_OK);
+  absl::Cleanup cleanup{[&stream]() { deflateEnd(&stream); }};
+  auto toBytes = [](const char* data) {
+    return reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  };
+  if (!dictionary.empty()) {
+    AD_CORRECTNESS_CHECK(
+        deflateSetDictionary(&stream, toBytes(dictionary.data()),
+                             static_cast<uInt>(dictionary.size())) == Z_OK);
+  }
+  stream.next_in = toBytes(input.data());
+  stream.avail_in = static_cast<uInt>(input.size());
+  std::string result(deflateBound(&stream, input.size()) + 16, '\0');
+  size_t numWritten = 0;
+  while (true) {
+    stream.next_out = toBytes(result.data() + numWritten);
+    stream.avail_out = static_cast<uInt>(result.size() - numWritten);
+    int status = deflate(&stream, flush);
+    AD_CORRECTNESS_CHECK(status == Z_OK || status == Z_STREAM_END ||
+                         status == Z_BUF_ERROR);
+    numWritten = result.size() - stream.avail_out;
+    // If there was space left in the output, all the input has been consumed
+    // and flushed.
+    if (stream.avail_out > 0) {
+      break;
+    }
+    result.resize(2 * result.size());
+  }
+  result.resize(numWritten);
+  return result;
+}
+
+// Append the `value` in little-endian (`bigEndian == false`) or big-endian
+// byte order to the `target`.
+inline void appendUint32(std::string& target, uint32_t value, bool bigEndian) {
+  for (size_t i = 0; i < 4; ++i) {
+    size_t shift = bigEndian ? 8 * (3 - i) : 8 * i;
+    target.push_back(static_cast<char>((value >> shift) & 0xFF));
+  }
+}
+
+// Yield the `chunks` of the `range` together with the end of the previous
+// chunks (which is only needed for gzip and deflate). Empty chunks are
+// skipped.
+template <typename Range>
+cppcoro::generator<ChunkWithDictionary> chunksWithDictionary(
+    Range range, bool withDictionary) {
+  std::string window;
+  for (auto&& value : range) {
+    ChunkWithDictionary next{window, std::string(std::move(value))};
+    if (next.chunk_.empty()) {
+      continue;
+    }
+    if (withDictionary) {
+      window.append(next.chunk_);
+      if (window.size() > deflateWindowSize) {
+        window.erase(0, window.size() - deflateWindowSize);
+      }
+    }
+    co_yield next;
+  }
+}
+}  // namespace detail
+
 /**
  * Takes a range of strings. Behavior: The concatenation of all yielded strings
  * is the compression, specified by the `compressionMethod` applied to the
@@ -30,12 +172,18 @@ using ad_utility::content_encoding::CompressionMethod;
 template <typename Range>
 cppcoro::generator<std::string> compressStream(
     Range range, CompressionMethod compressionMethod) {
+  if (compressionMethod == CompressionMethod::ZSTD) {
+    for (auto& value : detail::compressStreamWithZstd(std::move(range))) {
+      co_yield value;
+    }
+    co_return;
+  }
   // NOTE: `stringBuffer` must be declared before `filteringStream` so that it
   // is destroyed after it. The `filteringStream` holds a reference to
   // `stringBuffer` via `io::back_inserter`. If the coroutine is destroyed
   // mid-iteration, the destructor of `filteringStream` flushes pending data
   // into `stringBuffer`, which must still be alive at that point.
-  std::string stringBuffer;
+  std::string stringBuffer = httpResponseBufferPool().get();
   io::filtering_ostream filteringStream;
 
   // setup compression method
@@ -50,6 +198,11 @@ cppcoro::generator<std::string> compressStream(
     filteringStream << value;
     if (!stringBuffer.empty()) {
       co_yield stringBuffer;
+      // The consumer might have moved the buffer out, in this case a buffer
+      // from the pool is used for the next chunk.
+      if (stringBuffer.capacity() == 0) {
+        stringBuffer = httpResponseBufferPool().get();
+      }
       stringBuffer.clear();
     }
   }
@@ -59,6 +212,85 @@ cppcoro::generator<std::string> compressStream(
     co_yield stringBuffer;
   }
 }
+
+// Same as `compressStream`, but the strings of the `range` are compressed
+// independently of each other in `numThreads` concurrent threads, and the
+// compressed strings are yielded in the order of the `range`. The result is
+// still a single valid stream for the `compressionMethod`:
+//
+// * For zstd, each string is compressed into a separate frame (a zstd stream
+//   may consist of several frames).
+// * For gzip and deflate, each string is compressed into raw deflate blocks
+//   that are flushed to a byte boundary (like `pigz` does). The end of the
+//   previous string is used as the dictionary, s.t. the compression ratio is
+//   the same as for a sequential compression. The checksums of the strings
+//   are combined for the trailer.
+//
+// This only pays off if the strings are large (like the chunks of the
+// `stream_generator`).
+template <typename Range>
+cppcoro::generator<std::string> compressStreamInParallel(
+    Range range, CompressionMethod compressionMethod, size_t numThreads) {
+  AD_CONTRACT_CHECK(compressionMethod != CompressionMethod::NONE);
+  bool isZstd = compressionMethod == CompressionMethod::ZSTD;
+  bool isGzip = compressionMethod == CompressionMethod::GZIP;
+  auto compressChunk = [isZstd, isGzip](detail::ChunkWithDictionary& chunk) {
+    detail::CompressedChunk result;
+    const auto& input = chunk.chunk_;
+    result.uncompressedSize_ = input.size();
+    if (isZstd) {
+      auto compressed = ZstdWrapper::compress(input.data(), input.size(),
+                                              detail::zstdCompressionLevel);
+      result.compressed_.assign(compressed.data(), compressed.size());
+      return result;
+    }
+    auto data = reinterpret_cast<const Bytef*>(input.data());
+    auto size = static_cast<uInt>(input.size());
+    result.checksum_ =
+        isGzip ? crc32(0L, data, size) : adler32(1L, data, size);
+    result.compressed_ =
+        detail::deflateRaw(chunk.dictionary_, input, Z_SYNC_FLUSH);
+    return result;
+  };
+  auto compressedChunks = ad_utility::data_structures::parallelTransform(
+      detail::chunksWithDictionary(std::move(range), !isZstd),
+      std::move(compressChunk), numThreads, 2 * numThreads, true);
+
+  if (isZstd) {
+    bool isEmpty = true;
+    for (auto& chunk : compressedChunks) {
+      isEmpty = false;
+      co_yield chunk.compressed_;
+    }
+    // A stream without frames is not valid, so we yield an empty frame.
+    if (isEmpty) {
+      auto frame = ZstdWrapper::compress(nullptr, 0);
+      co_yield std::string(frame.data(), frame.size());
+    }
+    co_return;
+  }
+
+  // The headers of gzip (no file name, no modification time, fastest
+  // compression, unknown OS) and of zlib (fastest compression, no dictionary).
+  co_yield isGzip ? std::string{"\x1f\x8b\x08\x00\x00\x00\x00\x00\x04\xff", 10}
+                  : std::string{"\x78\x01"};
+  uLong checksum = isGzip ? crc32(0L, Z_NULL, 0) : adler32(0L, Z_NULL, 0);
+  size_t totalSize = 0;
+  for (auto& chunk : compressedChunks) {
+    auto size = static_cast<z_off_t>(chunk.uncompressedSize_);
+    checksum = isGzip ? crc32_combine(checksum, chunk.checksum_, size)
+                      : adler32_combine(checksum, chunk.checksum_, size);
+    totalSize += chunk.uncompressedSize_;
+    co_yield chunk.compressed_;
+  }
+  // The final (empty) block and the trailer.
+  std::string trailer = detail::deflateRaw({}, {}, Z_FINISH);
+  detail::appendUint32(trailer, static_cast<uint32_t>(checksum), !isGzip);
+  if (isGzip) {
+    detail::appendUint32(trailer, static_cast<uint32_t>(totalSize), false);
+  }
+  co_yield trailer;
+}
 }  // namespace ad_utility::streams
 
 #endif  // QLEVER_SRC_UTIL_COMPRESSORSTREAM_H
@@ -4,12 +4,21 @@
 
 #ifndef QLEVER_CONCURRENTCACHE_H
 #define QLEVER_CONCURRENTCACHE_H
+#include <absl/hash/hash.h>
+
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
+#include "backports/algorithm.h"
 #include "backports/keywords.h"
+#include "util/CopyableSynchronization.h"
 #include "util/Forward.h"
 #include "util/HashMap.h"
 #include "util/Log.h"
@@ -143,6 +152,11 @@ class ResultInProgress {
 };
 }  // namespace ConcurrentCacheDetail
 
+// The number of shards of a `ConcurrentCache` (see below).
+struct NumShards {
+  size_t numShards_ = 1;
+};
+
 /**
  * @brief Makes sure that an expensive, deterministic computation result is
  * reused, if it is already cached or currently being computed by another
@@ -156,12 +170,32 @@ class ConcurrentCache {
   using Value = typename Cache::value_type;
   using Key = typename Cache::key_type;
 
-  ConcurrentCache() = default;
+  ConcurrentCache() : ConcurrentCache(NumShards{}) {}
   /// Constructor: all arguments are forwarded to the underlying cache type.
   CPP_template(typename CacheArg, typename... CacheArgs)(requires(
-      !ql::concepts::same_as<ConcurrentCache, ql::remove_cvref_t<CacheArg>>))
-      ConcurrentCache(CacheArg&& cacheArg, CacheArgs&&... cacheArgs)
-      : _cacheAndInProgressMap{AD_FWD(cacheArg), AD_FWD(cacheArgs)...} {}
+      !ql::concepts::same_as<ConcurrentCache, ql::remove_cvref_t<CacheArg>> &&
+      !ql::concepts::same_as<NumShards, ql::remove_cvref_t<CacheArg>>))
+      ConcurrentCache(CacheArg&& cacheArg, CacheArgs&&... cacheArgs) {
+    shards_.push_back(
+        std::make_unique<Shard>(AD_FWD(cacheArg), AD_FWD(cacheArgs)...));
+  }
+
+  /// Constructor for a cache that consists of `numShards` independent caches
+  /// with separate locks, s.t. concurrent accesses to different keys rarely
+  /// have to wait for each other. Each shard is constructed from the
+  /// `cacheArgs`. The keys are distributed to the shards by their hash. The
+  /// limits of the number of entries and the total size (which have to be set
+  /// via `setMaxNumEntries` and `setMaxSize`) apply to the whole cache: When
+  /// they are exceeded, the entries with the smallest score are evicted from
+  /// the shard with the most non-pinned entries (or bytes), which approximates
+  /// a global eviction order.
+  template <typename... CacheArgs>
+  explicit ConcurrentCache(NumShards numShards, const CacheArgs&... cacheArgs) {
+    AD_CONTRACT_CHECK(numShards.numShards_ > 0);
+    for (size_t i = 0; i < numShards.numShards_; ++i) {
+      shards_.push_back(std::make_unique<Shard>(cacheArgs...));
+    }
+  }
 
   struct ResultAndCacheStatus {
     std::shared_ptr<const Value> _resultPointer;
@@ -221,7 +255,8 @@ class ConcurrentCache {
           bool onlyReadFromCache,
           [[maybe_unused]] const SuitabilityFuncT& suitedForCache) {
     {
-      auto resultPtr = _cacheAndInProgressMap.wlock()->_cache[key];
+      auto resultPtr =
+          shardFor(key).cacheAndInProgressMap_.wlock()->_cache[key];
       if (resultPtr != nullptr) {
         return {std::move(resultPtr), CacheStatus::cachedNotPinned};
       }
@@ -238,67 +273,128 @@ class ConcurrentCache {
   // pinned in case it is not pinned yet.
   void tryInsertIfNotPresent(bool pinned, const Key& key,
                              std::shared_ptr<Value> value) {
-    auto lockPtr = _cacheAndInProgressMap.wlock();
-    auto& cache = lockPtr->_cache;
-    if (pinned) {
-      if (!cache.containsAndMakePinnedIfExists(key)) {
-        cache.insertPinned(key, std::move(value));
+    auto& shard = shardFor(key);
+    {
+      auto lockPtr = shard.cacheAndInProgressMap_.wlock();
+      auto& cache = lockPtr->_cache;
+      if (pinned) {
+        if (!cache.containsAndMakePinnedIfExists(key)) {
+          cache.insertPinned(key, std::move(value));
+        }
+      } else if (!cache.contains(key)) {
+        cache.insert(key, std::move(value));
       }
-    } else if (!cache.contains(key)) {
-      cache.insert(key, std::move(value));
+      shard.updateStatistics(cache);
     }
+    enforceGlobalLimits();
   }
 
   /// Clear the cache (but not the pinned entries)
   void clearUnpinnedOnly() {
-    _cacheAndInProgressMap.wlock()->_cache.clearUnpinnedOnly();
+    forEachShard([](Cache& cache) { cache.clearUnpinnedOnly(); });
   }
 
   /// Clear the cache, including the pinned entries.
-  void clearAll() { _cacheAndInProgressMap.wlock()->_cache.clearAll(); }
+  void clearAll() {
+    forEachShard([](Cache& cache) { cache.clearAll(); });
+  }
 
   /// Delete elements from the unpinned part of the cache of total size
   /// at least `size`;
   bool makeRoomAsMuchAsPossible(MemorySize size) {
-    return _cacheAndInProgressMap.wlock()->_cache.makeRoomAsMuchAsPossible(
-        size);
+    if (shards_.size() == 1) {
+      auto& shard = *shards_.front();
+      auto lockPtr = shard.cacheAndInProgressMap_.wlock();
+      bool result = lockPtr->_cache.makeRoomAsMuchAsPossible(size);
+      shard.updateStatistics(lockPtr->_cache);
+      return result;
+    }
+    // Free the space from the shards with the most non-pinned bytes first.
+    std::vector<Shard*> shards;
+    size_t numBytesNonPinned = 0;
+    for (auto& shard : shards_) {
+      shards.push_back(shard.get());
+      numBytesNonPinned += shard->numBytesNonPinned_.load();
+    }
+    if (size.getBytes() > numBytesNonPinned) {
+      clearUnpinnedOnly();
+      return false;
+    }
+    ql::ranges::sort(shards, std::greater<>{}, [](const Shard* shard) {
+      return shard->numBytesNonPinned_.load();
+    });
+    size_t numBytesToFree = size.getBytes();
+    for (Shard* shard : shards) {
+      if (numBytesToFree == 0) {
+        break;
+      }
+      auto lockPtr = shard->cacheAndInProgressMap_.wlock();
+      auto& cache = lockPtr->_cache;
+      auto sizeBefore = cache.nonPinnedSizeAtInsertion().getBytes();
+      cache.makeRoomAsMuchAsPossible(MemorySize::bytes(
+          std::min(numBytesToFree, sizeBefore)));
+      auto numFreed = sizeBefore - cache.nonPinnedSizeAtInsertion().getBytes();
+      numBytesToFree -= std::min(numBytesToFree, numFreed);
+      shard->updateStatistics(cache);
+    }
+    return numBytesToFree == 0;
   }
 
   /// The number of non-pinned entries in the cache
   auto numNonPinnedEntries() const {
-    return _cacheAndInProgressMap.wlock()->_cache.numNonPinnedEntries();
+    return sumOverShards(
+        [](const Cache& cache) { return cache.numNonPinnedEntries(); });
   }
 
   /// The number of pinned entries in the underlying cache
   auto numPinnedEntries() const {
-    return _cacheAndInProgressMap.wlock()->_cache.numPinnedEntries();
+    return sumOverShards(
+        [](const Cache& cache) { return cache.numPinnedEntries(); });
   }
 
   /// Total size of the non-pinned entries in the cache (the unit depends on
   /// the cache's configuration)
   auto nonPinnedSize() const {
-    return _cacheAndInProgressMap.wlock()->_cache.nonPinnedSize();
+    return sumOverShards(
+        [](const Cache& cache) { return cache.nonPinnedSize(); });
   }
 
   /// Total size of the non-pinned entries in the cache (the unit depends on
   /// the cache's configuration)
   auto pinnedSize() const {
-    return _cacheAndInProgressMap.wlock()->_cache.pinnedSize();
+    return sumOverShards([](const Cache& cache) { return cache.pinnedSize(); });
+  }
+
+  /// The number of calls to `computeOnce` and `computeOncePinned` the result
+  /// of which was read from the cache, or had to be computed (see
+  /// `CacheStatus`). Calls with `onlyReadFromCache` that don't find the
+  /// result count for neither of them. These counters can be read without
+  /// taking the lock of the cache.
+  struct Statistics {
+    size_t numHits_ = 0;
+    size_t numMisses_ = 0;
+  };
+  Statistics getStatistics() const {
+    return {numHits_.load(std::memory_order_relaxed),
+            numMisses_.load(std::memory_order_relaxed)};
   }
 
-  /// only for testing: get access to the implementation
-  auto& getStorage() { return _cacheAndInProgressMap; }
+  /// only for testing: get access to the implementation (of the first shard)
+  auto& getStorage() { return shards_.front()->cacheAndInProgressMap_; }
+
+  /// The number of shards, see the constructor above.
+  size_t numShards() const { return shards_.size(); }
 
   // is key in cache (not in progress), used for testing
   bool cacheContains(const Key& k) const {
-    return _cacheAndInProgressMap.wlock()->_cache.contains(k);
+    return shardFor(k).cacheAndInProgressMap_.wlock()->_cache.contains(k);
   }
 
   // If the `key` is contained in the cache, return the corresponding value and
   // cache status (which will always be `pinned` or `not-pinned` in this case_).
   // If the `key` is not in the cache, return `std::nullopt`.
   std::optional<ResultAndCacheStatus> getIfContained(const Key& key) {
-    auto lockPtr = _cacheAndInProgressMap.wlock();
+    auto lockPtr = shardFor(key).cacheAndInProgressMap_.wlock();
     auto& cache = lockPtr->_cache;
     const auto cacheStatus = getCacheStatus(cache, key);
     if (cacheStatus == CacheStatus::computed) {
@@ -308,19 +404,31 @@ class ConcurrentCache {
     return ResultAndCacheStatus{cache[key], cacheStatus};
   }
 
-  // These functions set the different capacity/size settings of the cache
+  // These functions set the different capacity/size settings of the cache. For
+  // a sharded cache, each shard gets the full capacity (s.t. a single large
+  // entry still fits) and the capacities of the whole cache are enforced by
+  // `enforceGlobalLimits`.
   void setMaxSize(MemorySize maxSize) {
-    _cacheAndInProgressMap.wlock()->_cache.setMaxSize(maxSize);
+    maxNumBytes_ = maxSize.getBytes();
+    forEachShard([maxSize](Cache& cache) { cache.setMaxSize(maxSize); });
+    enforceGlobalLimits();
   }
   void setMaxNumEntries(size_t maxNumEntries) {
-    _cacheAndInProgressMap.wlock()->_cache.setMaxNumEntries(maxNumEntries);
+    maxNumEntries_ = maxNumEntries;
+    forEachShard([maxNumEntries](Cache& cache) {
+      cache.setMaxNumEntries(maxNumEntries);
+    });
+    enforceGlobalLimits();
   }
   void setMaxSizeSingleEntry(MemorySize maxSize) {
-    _cacheAndInProgressMap.wlock()->_cache.setMaxSizeSingleEntry(maxSize);
+    forEachShard(
+        [maxSize](Cache& cache) { cache.setMaxSizeSingleEntry(maxSize); });
   }
 
   MemorySize getMaxSizeSingleEntry() const {
-    return _cacheAndInProgressMap.wlock()->_cache.getMaxSizeSingleEntry();
+    return shards_.front()
+        ->cacheAndInProgressMap_.wlock()
+        ->_cache.getMaxSizeSingleEntry();
   }
 
  private:
@@ -347,22 +455,118 @@ class ConcurrentCache {
   // make the whole class thread-safe by making all the data members thread-safe
   using SyncCache = ad_utility::Synchronized<CacheAndInProgressMap, std::mutex>;
 
+  // A part of the cache with its own lock. The statistics are stored in
+  // atomics, s.t. the limits of the whole cache can be checked without taking
+  // the locks of all the shards.
+  struct Shard {
+    SyncCache cacheAndInProgressMap_;
+    std::atomic<size_t> numEntries_ = 0;
+    std::atomic<size_t> numBytes_ = 0;
+    std::atomic<size_t> numEntriesNonPinned_ = 0;
+    std::atomic<size_t> numBytesNonPinned_ = 0;
+
+    template <typename... Args>
+    explicit Shard(Args&&... args) : cacheAndInProgressMap_{AD_FWD(args)...} {}
+
+    // Update the statistics from the `cache` of this shard, the lock of which
+    // must be held by the caller.
+    void updateStatistics(const Cache& cache) {
+      auto nonPinned = cache.nonPinnedSizeAtInsertion().getBytes();
+      auto numNonPinned = cache.numNonPinnedEntries();
+      numEntriesNonPinned_ = numNonPinned;
+      numBytesNonPinned_ = nonPinned;
+      numEntries_ = numNonPinned + cache.numPinnedEntries();
+      numBytes_ = nonPinned + cache.pinnedSizeAtInsertion().getBytes();
+    }
+  };
+
+  // Return the shard that is responsible for the `key`.
+  Shard& shardFor(const Key& key) const {
+    if (shards_.size() == 1) {
+      return *shards_.front();
+    }
+    return *shards_[absl::Hash<Key>{}(key) % shards_.size()];
+  }
+
+  // Call `function(cache)` for the cache of each shard while holding its lock.
+  template <typename F>
+  void forEachShard(const F& function) {
+    for (auto& shard : shards_) {
+      auto lockPtr = shard->cacheAndInProgressMap_.wlock();
+      function(lockPtr->_cache);
+      shard->updateStatistics(lockPtr->_cache);
+    }
+  }
+
+  // Return the sum of `function(cache)` over the caches of all shards.
+  template <typename F>
+  auto sumOverShards(const F& function) const {
+    auto resultOf = [&function](const std::unique_ptr<Shard>& shard) {
+      return function(shard->cacheAndInProgressMap_.wlock()->_cache);
+    };
+    auto result = resultOf(shards_.front());
+    for (size_t i = 1; i < shards_.size(); ++i) {
+      result = result + resultOf(shards_[i]);
+    }
+    return result;
+  }
+
+  // If the whole cache has more entries or bytes than allowed, evict
+  // non-pinned entries from the shards with the most non-pinned entries or
+  // bytes respectively. Must be called without holding any of the locks. A
+  // single shard already enforces the limits itself.
+  void enforceGlobalLimits() {
+    if (shards_.size() == 1) {
+      return;
+    }
+    while (true) {
+      size_t numEntries = 0;
+      size_t numBytes = 0;
+      for (const auto& shard : shards_) {
+        numEntries += shard->numEntries_.load();
+        numBytes += shard->numBytes_.load();
+      }
+      bool tooManyEntries = numEntries > maxNumEntries_.load();
+      bool tooManyBytes = numBytes > maxNumBytes_.load();
+      if (!tooManyEntries && !tooManyBytes) {
+        return;
+      }
+      auto& shard = *ql::ranges::max(
+          shards_, std::less<>{}, [tooManyEntries](const auto& shard) {
+            return tooManyEntries ? shard->numEntriesNonPinned_.load()
+                                  : shard->numBytesNonPinned_.load();
+          });
+      auto lockPtr = shard.cacheAndInProgressMap_.wlock();
+      auto& cache = lockPtr->_cache;
+      bool removedEntry = cache.removeEntryWithSmallestScore();
+      shard.updateStatistics(cache);
+      if (!removedEntry) {
+        // Only pinned entries are left, which can exceed the limits.
+        return;
+      }
+    }
+  }
+
   // delete the operation with the key from the hash map of the operations that
   // are in progress, and add it to the cache using the computationResult
   // Will crash if the key cannot be found in the hash map
   void moveFromInProgressToCache(Key key,
                                  std::shared_ptr<Value> computationResult) {
-    // Obtain a lock for the whole operation, making it atomic.
-    auto lockPtr = _cacheAndInProgressMap.wlock();
-    AD_CONTRACT_CHECK(lockPtr->_inProgress.contains(key));
-    bool pinned = lockPtr->_inProgress[key].first;
-    if (pinned) {
-      lockPtr->_cache.insertPinned(std::move(key),
-                                   std::move(computationResult));
-    } else {
-      lockPtr->_cache.insert(std::move(key), std::move(computationResult));
+    auto& shard = shardFor(key);
+    {
+      // Obtain a lock for the whole operation, making it atomic.
+      auto lockPtr = shard.cacheAndInProgressMap_.wlock();
+      AD_CONTRACT_CHECK(lockPtr->_inProgress.contains(key));
+      bool pinned = lockPtr->_inProgress[key].first;
+      if (pinned) {
+        lockPtr->_cache.insertPinned(key, std::move(computationResult));
+      } else {
+        lockPtr->_cache.insert(key, std::move(computationResult));
+      }
+      lockPtr->_inProgress.erase(key);
+      shard.updateStatistics(lockPtr->_cache);
     }
-    lockPtr->_inProgress.erase(key);
+    enforceGlobalLimits();
   }
 
  private:
@@ -379,18 +583,21 @@ class ConcurrentCache {
     using std::shared_ptr;
     bool mustCompute;
     shared_ptr<ResultInProgress> resultInProgress;
+    auto& shard = shardFor(key);
     // first determine whether we have to compute the result,
     // this is done atomically by locking the storage for the whole time
     {
-      auto lockPtr = _cacheAndInProgressMap.wlock();
+      auto lockPtr = shard.cacheAndInProgressMap_.wlock();
       auto& cache = lockPtr->_cache;
       const auto cacheStatus = getCacheStatus(cache, key);
       if (pinned) {
         cache.containsAndMakePinnedIfExists(key);
+        shard.updateStatistics(cache);
       }
       bool contained = cacheStatus != CacheStatus::computed;
       if (contained) {
         // the result is in the cache, simply return it.
+        numHits_.fetch_add(1, std::memory_order_relaxed);
         return {cache[key], cacheStatus};
       } else if (onlyReadFromCache) {
         return {nullptr, CacheStatus::notInCacheAndNotComputed};
@@ -413,6 +620,7 @@ class ConcurrentCache {
         lockPtr->_inProgress[key] = std::pair(pinned, resultInProgress);
       }
     }  // release the lock, it is not required while we are computing
+    numMisses_.fetch_add(1, std::memory_order_relaxed);
     if (mustCompute) {
       AD_LOG_TRACE << "Not in the cache, need to compute result" << std::endl;
       try {
@@ -424,14 +632,14 @@ class ConcurrentCache {
           resultInProgress->finish(result);
         } else {
           AD_CONTRACT_CHECK(!pinned);
-          _cacheAndInProgressMap.wlock()->_inProgress.erase(key);
+          shard.cacheAndInProgressMap_.wlock()->_inProgress.erase(key);
           resultInProgress->finish(nullptr);
         }
         // result was not cached
         return {std::move(result), CacheStatus::computed};
       } catch (...) {
         // Other threads may try this computation again in the future
-        _cacheAndInProgressMap.wlock()->_inProgress.erase(key);
+        shard.cacheAndInProgressMap_.wlock()->_inProgress.erase(key);
         // Result computation has failed, signal the other threads,
         resultInProgress->abort();
         throw;
@@ -456,7 +664,13 @@ class ConcurrentCache {
   }
 
   // Data members
-  SyncCache _cacheAndInProgressMap;  // the data storage
+  // The shards of the cache, see the constructor. There is always at least one.
+  std::vector<std::unique_ptr<Shard>> shards_;
+  // The limits of the whole cache, see `enforceGlobalLimits`.
+  CopyableAtomic<size_t> maxNumEntries_{std::numeric_limits<size_t>::max()};
+  CopyableAtomic<size_t> maxNumBytes_{std::numeric_limits<size_t>::max()};
+  CopyableAtomic<size_t> numHits_{0};
+  CopyableAtomic<size_t> numMisses_{0};
 };
 }  // namespace ad_utility
 
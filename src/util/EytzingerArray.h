@@ -0,0 +1,99 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_EYTZINGERARRAY_H
+#define QLEVER_SRC_UTIL_EYTZINGERARRAY_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "backports/algorithm.h"
+#include "backports/span.h"
+#include "util/Exception.h"
+
+namespace ad_utility {
+
+// A static, sorted sequence of elements that is stored in the Eytzinger layout
+// (the layout of a binary heap: the children of the element at position `k`
+// are at positions `2k` and `2k + 1`). A binary search on this layout accesses
+// the memory in a very regular pattern, so that the first levels of the
+// implicit search tree stay in the cache and the next levels can be
+// prefetched. This makes `partitionPoint` much faster than
+// `std::partition_point` on a large sorted vector. The elements should be
+// small, e.g. only the keys of larger objects.
+template <typename T>
+class EytzingerArray {
+ private:
+  // The elements in Eytzinger order. Position 0 is unused.
+  std::vector<T> elements_;
+  // For each position in `elements_`, the index of the element in the sorted
+  // order.
+  std::vector<uint32_t> sortedIndices_;
+
+ public:
+  EytzingerArray() = default;
+
+  // Construct from elements that are sorted wrt the searches which will be
+  // performed later on.
+  explicit EytzingerArray(ql::span<const T> sortedElements) {
+    size_t numElements = sortedElements.size();
+    AD_CONTRACT_CHECK(numElements < std::numeric_limits<uint32_t>::max());
+    elements_.resize(numElements + 1);
+    sortedIndices_.resize(numElements + 1);
+    size_t nextSortedIndex = 0;
+    fill(sortedElements, nextSortedIndex, 1);
+    AD_CORRECTNESS_CHECK(nextSortedIndex == numElements);
+  }
+
+  // The number of elements.
+  size_t size() const { return elements_.empty() ? 0 : elements_.size() - 1; }
+
+  // Return the index (in the sorted order) of the first element for which
+  // `pred` is false, where `pred` has to be true for a (possibly empty) prefix
+  // of the sorted elements and false for the rest (like
+  // `std::partition_point`). Return `size()` if `pred` is true for all
+  // elements.
+  template <typename Pred>
+  size_t partitionPoint(const Pred& pred) const {
+    const size_t numElements = size();
+    size_t k = 1;
+    while (k <= numElements) {
+      // Prefetch the descendants four levels down, which are contiguous.
+      __builtin_prefetch(elements_.data() + std::min(16 * k, numElements));
+      k = 2 * k + static_cast<size_t>(pred(elements_[k]));
+    }
+    // `k` is the position "below" a leaf. The result is the last ancestor of
+    // that position where we went to the left, so we have to remove the
+    // trailing right turns (ones) and the last left turn (zero).
+    k >>= std::countr_one(k) + 1;
+    return k == 0 ? numElements : sortedIndices_[k];
+  }
+
+ private:
+  // Fill the subtree rooted at position `k` with the next elements (in-order
+  // traversal).
+  void fill(ql::span<const T> sortedElements, size_t& nextSortedIndex,
+            size_t k) {
+    if (k >= elements_.size()) {
+      return;
+    }
+    fill(sortedElements, nextSortedIndex, 2 * k);
+    elements_[k] = sortedElements[nextSortedIndex];
+    sortedIndices_[k] = static_cast<uint32_t>(nextSortedIndex);
+    ++nextSortedIndex;
+    fill(sortedElements, nextSortedIndex, 2 * k + 1);
+  }
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_EYTZINGERARRAY_H
@@ -6,6 +6,7 @@
 #define QLEVER_SRC_UTIL_FILE_H
 
 #include <absl/strings/str_cat.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -131,6 +132,17 @@ class File {
 
   void flush() { fflush(file_); }
 
+  // Flush the buffer and make the operating system write the contents of the
+  // file to the disk.
+  void sync() {
+    flush();
+    if (fsync(fileno(file_)) != 0) {
+      throw std::runtime_error{absl::StrCat("Could not sync file \"", name_,
+                                            "\" to disk (", strerror(errno),
+                                            ")")};
+    }
+  }
+
   //! Seeks a position in the file.
   //! Sets the file position indicator for the stream.
   //! The new position is obtained by adding seekOffset
@@ -164,6 +176,21 @@ class File {
     return bytesRead;
   }
 
+  // Advise the operating system that the `nofBytes` bytes starting at the
+  // given `offset` will be read soon (see `posix_fadvise`), s.t. they can
+  // already be loaded into the page cache. This is only a hint, so errors are
+  // ignored.
+  void adviseWillNeed(off_t offset, size_t nofBytes) const {
+    assert(file_);
+#ifdef POSIX_FADV_WILLNEED
+    posix_fadvise(fileno(file_), offset, static_cast<off_t>(nofBytes),
+                  POSIX_FADV_WILLNEED);
+#else
+    (void)offset;
+    (void)nofBytes;
+#endif
+  }
+
   //! Returns the number of bytes from the beginning
   //! is 0 on opening. Later equal the number of bytes written.
   //! -1 is returned when an error occurs
@@ -0,0 +1,127 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_UTIL_HYPERLOGLOG_H
+#define QLEVER_SRC_UTIL_HYPERLOGLOG_H
+
+#include <absl/numeric/bits.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "backports/three_way_comparison.h"
+#include "util/Serializer/SerializeArrayOrTuple.h"
+#include "util/Serializer/Serializer.h"
+
+namespace ad_utility {
+
+// A HyperLogLog sketch (Flajolet et al., 2007) that estimates the number of
+// distinct values that have been added to it, using a constant amount of
+// memory (`numRegisters` bytes). The relative standard error of the estimate
+// is about `1.04 / sqrt(numRegisters)` (see `relativeStandardError`). Two
+// sketches can be merged, the result is the sketch of the union of the two
+// sets of values.
+template <size_t NUM_REGISTER_BITS>
+class BasicHyperLogLog {
+ public:
+  static constexpr size_t numRegisterBits = NUM_REGISTER_BITS;
+  static constexpr size_t numRegisters = size_t{1} << numRegisterBits;
+  static_assert(numRegisterBits >= 4 && numRegisterBits <= 16);
+
+  // The relative standard error of `estimate()`.
+  static double relativeStandardError() {
+    return 1.04 / std::sqrt(static_cast<double>(numRegisters));
+  }
+
+ private:
+  // `registers_[i]` is the maximal rank (the number of leading zeros + 1 of
+  // the remaining bits of the hash) of all the hashes with index `i`.
+  std::array<uint8_t, numRegisters> registers_{};
+
+ public:
+  // Add the `value`. It is hashed internally, so the values don't have to be
+  // uniformly distributed.
+  void add(uint64_t value) { addHash(mix(value)); }
+
+  // Add a value that is given by its (uniformly distributed) 64-bit `hash`.
+  void addHash(uint64_t hash) {
+    size_t index = hash >> (64 - numRegisterBits);
+    uint64_t remainingBits = hash << numRegisterBits;
+    auto rank = static_cast<uint8_t>(
+        remainingBits == 0 ? 64 - numRegisterBits + 1
+                           : absl::countl_zero(remainingBits) + 1);
+    registers_[index] = std::max(registers_[index], rank);
+  }
+
+  // Merge the `other` sketch into this one.
+  void merge(const BasicHyperLogLog& other) {
+    for (size_t i = 0; i < numRegisters; ++i) {
+      registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+  }
+
+  // Return the estimated number of distinct values that have been added.
+  double estimate() const {
+    static constexpr double m = numRegisters;
+    static constexpr double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double sum = 0;
+    size_t numZeroRegisters = 0;
+    for (uint8_t rank : registers_) {
+      sum += std::ldexp(1.0, -static_cast<int>(rank));
+      numZeroRegisters += rank == 0;
+    }
+    double result = alpha * m * m / sum;
+    // For small cardinalities the raw estimate is biased, use linear counting
+    // instead (as proposed in the original paper).
+    if (result <= 2.5 * m && numZeroRegisters > 0) {
+      result = m * std::log(m / static_cast<double>(numZeroRegisters));
+    }
+    return result;
+  }
+
+  // Return the estimated number of distinct values in the union of the values
+  // of `a` and `b`.
+  static double estimateUnion(const BasicHyperLogLog& a,
+                              const BasicHyperLogLog& b) {
+    BasicHyperLogLog result = a;
+    result.merge(b);
+    return result.estimate();
+  }
+
+  // Return the estimated number of distinct values that have been added to
+  // both `a` and `b` (via the inclusion-exclusion principle). Note that the
+  // absolute error of this estimate is in the order of the error of the
+  // estimates for `a` and `b`, so it is imprecise for small intersections.
+  static double estimateIntersection(const BasicHyperLogLog& a,
+                                     const BasicHyperLogLog& b) {
+    double estimateA = a.estimate();
+    double estimateB = b.estimate();
+    double intersection = estimateA + estimateB - estimateUnion(a, b);
+    return std::clamp(intersection, 0.0, std::min(estimateA, estimateB));
+  }
+
+  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(BasicHyperLogLog, registers_)
+
+  AD_SERIALIZE_FRIEND_FUNCTION(BasicHyperLogLog) {
+    serializer | arg.registers_;
+  }
+
+ private:
+  // The finalizer of the `splitmix64` generator, which is a cheap, but good
+  // mixing function for 64-bit values.
+  static constexpr uint64_t mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+};
+
+// The sketch that is used for the statistics of the index, with 512 registers
+// (a relative standard error of about 4.6%).
+using HyperLogLog = BasicHyperLogLog<9>;
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_HYPERLOGLOG_H
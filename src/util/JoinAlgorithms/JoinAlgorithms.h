@@ -17,6 +17,7 @@
 #include "backports/span.h"
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
+#include "util/CancellationHandle.h"
 #include "util/InputRangeUtils.h"
 #include "util/JoinAlgorithms/FindUndefRanges.h"
 #include "util/JoinAlgorithms/JoinColumnMapping.h"
@@ -129,6 +130,10 @@ CPP_template(typename Range1, typename Range2, typename LessThan,
         const FindSmallerUndefRangesRight& findSmallerUndefRangesRight,
         ElFromFirstNotFoundAction elFromFirstNotFoundAction = {},
         CheckCancellation checkCancellation = {}, CoverUndefRanges = {}) {
+  // The cancellation is checked for every element, so only every few of these
+  // checks are actually forwarded to `checkCancellation`.
+  ad_utility::AmortizedCancellationCheck checkCancellationAmortized{
+      std::move(checkCancellation)};
   // If this is not an OPTIONAL join or a MINUS we can apply several
   // optimizations, so we store this information.
   static constexpr bool hasNotFoundAction =
@@ -172,7 +177,7 @@ CPP_template(typename Range1, typename Range2, typename LessThan,
   // `left.end()`, but passing in smaller ranges is more efficient.
   auto mergeWithUndefLeft = [&](auto itFromRight, auto leftBegin,
                                 auto leftEnd) {
-    checkCancellation();
+    checkCancellationAmortized();
     if constexpr (!isSimilar<FindSmallerUndefRangesLeft, Noop>) {
       // We need to bind the const& to a variable, else it will be
       // dangling inside the `findSmallerUndefRangesLeft` generator.
@@ -216,7 +221,7 @@ CPP_template(typename Range1, typename Range2, typename LessThan,
   // element in `right` that is only discovered later.
   auto mergeWithUndefRight = [&](auto itFromLeft, auto beginRight,
                                  auto endRight, bool hasNoMatch) {
-    checkCancellation();
+    checkCancellationAmortized();
     if constexpr (!isSimilar<FindSmallerUndefRangesRight, Noop>) {
       bool compatibleWasFound = false;
       // We need to bind the const& to a variable, else it will be
@@ -265,7 +270,7 @@ CPP_template(typename Range1, typename Range2, typename LessThan,
           return;
         }
       }
-      checkCancellation();
+      checkCancellationAmortized();
 
       // Find the following ranges in `left` and `right` where the elements are
       // equal.
@@ -279,7 +284,7 @@ CPP_template(typename Range1, typename Range2, typename LessThan,
           it1, end1, [&](const auto& row) { return eq(row, *it2); });
       auto endSame2 = std::find_if_not(
           it2, end2, [&](const auto& row) { return eq(*it1, row); });
-      checkCancellation();
+      checkCancellationAmortized();
 
       for (auto it = it1; it != endSame1; ++it) {
         mergeWithUndefRight(it, std::begin(right), it2, false);
@@ -301,7 +306,7 @@ CPP_template(typename Range1, typename Range2, typename LessThan,
         }
       } else {
         for (; it1 != endSame1; ++it1) {
-          checkCancellation();
+          checkCancellationAmortized();
           cover(it1);
           for (auto innerIt2 = it2; innerIt2 != endSame2; ++innerIt2) {
             compatibleRowAction(it1, innerIt2);
@@ -312,7 +317,7 @@ CPP_template(typename Range1, typename Range2, typename LessThan,
       it2 = endSame2;
     }
   }();
-  checkCancellation();
+  checkCancellationAmortized();
 
   // Deal with the remaining elements that have no exact match in the other
   // input.
@@ -331,7 +336,7 @@ CPP_template(typename Range1, typename Range2, typename LessThan,
   if constexpr (hasNotFoundAction) {
     for (size_t i = 0; i < coveredFromLeft.size(); ++i) {
       if (!coveredFromLeft[i]) {
-        checkCancellation();
+        checkCancellationAmortized();
         elFromFirstNotFoundAction(std::begin(left) + i);
         ++numOutOfOrderAtEnd;
       }
@@ -386,6 +391,10 @@ CPP_template(typename RangeSmaller, typename RangeLarger, typename LessThan,
                                                      {},
                                              CheckCancellation
                                                  checkCancellation = {}) {
+  // The cancellation is checked for every element of `smaller`, so only every
+  // few of these checks are actually forwarded to `checkCancellation`.
+  ad_utility::AmortizedCancellationCheck checkCancellationAmortized{
+      std::move(checkCancellation)};
   auto itSmall = std::begin(smaller);
   auto endSmall = std::end(smaller);
   auto itLarge = std::begin(larger);
@@ -401,9 +410,9 @@ CPP_template(typename RangeSmaller, typename RangeLarger, typename LessThan,
   // case the second iterator will be `endLarge`. This is defined in a way, s.t.
   // a subsequent `std::lower_bound(lower, upper)` will either find the element
   // or will return `upper` and `upper == endLarge`.
-  auto exponentialSearch = [&checkCancellation, &lessThan, &endLarge](
+  auto exponentialSearch = [&checkCancellationAmortized, &lessThan, &endLarge](
                                auto itL, auto itS) {
-    checkCancellation();
+    checkCancellationAmortized();
     size_t step = 1;
     auto lower = itL;
     while (lessThan(*itL, *itS)) {
@@ -420,7 +429,7 @@ CPP_template(typename RangeSmaller, typename RangeLarger, typename LessThan,
     return std::pair{lower, itL + 1};
   };
   while (itSmall < endSmall && itLarge < endLarge) {
-    checkCancellation();
+    checkCancellationAmortized();
     const auto& elLarge = *itLarge;
     // Linear search in the smaller input.
     while (lessThan(*itSmall, elLarge)) {
@@ -444,7 +453,7 @@ CPP_template(typename RangeSmaller, typename RangeLarger, typename LessThan,
     if (itLarge == endLarge) {
       break;
     }
-    checkCancellation();
+    checkCancellationAmortized();
 
     // Find the ranges where both inputs are equal and add them to the result.
     auto endSameSmall = std::find_if_not(
@@ -453,7 +462,7 @@ CPP_template(typename RangeSmaller, typename RangeLarger, typename LessThan,
         itLarge, endLarge, [&](const auto& row) { return eq(row, *itSmall); });
 
     for (; itSmall != endSameSmall; ++itSmall) {
-      checkCancellation();
+      checkCancellationAmortized();
       for (auto innerItLarge = itLarge; innerItLarge != endSameLarge;
            ++innerItLarge) {
         action(itSmall, innerItLarge);
@@ -0,0 +1,117 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#include "util/JoinAlgorithms/SimdZipperJoin.h"
+
+#include <limits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define QLEVER_SIMD_ZIPPER_JOIN_AVX2
+#include <immintrin.h>
+#endif
+
+namespace ad_utility::simdZipperJoin {
+
+static_assert(sizeof(Id) == sizeof(Id::T));
+
+namespace {
+
+// The number of elements that are compared linearly before we switch to the
+// exponential search. Chosen such that the linear scan covers a few cache
+// lines, which is the typical distance when two inputs of similar size are
+// joined.
+constexpr size_t linearScanLimit = 32;
+
+// Scalar version of the linear scan.
+size_t linearScanScalar(const Id* values, size_t begin, size_t end,
+                        Id::T needle) {
+  while (begin < end && values[begin].getBits() < needle) {
+    ++begin;
+  }
+  return begin;
+}
+
+#ifdef QLEVER_SIMD_ZIPPER_JOIN_AVX2
+// AVX2 version of the linear scan, which compares four elements at once. AVX2
+// only has a signed 64-bit comparison, so we flip the sign bit of both sides to
+// get the unsigned order of the bits. The target attribute allows us to use
+// this function without compiling the whole binary with `-mavx2`, it must only
+// be called if `__builtin_cpu_supports("avx2")` holds.
+__attribute__((target("avx2"))) size_t linearScanAvx2(const Id* values,
+                                                      size_t begin, size_t end,
+                                                      Id::T needle) {
+  const __m256i signBit =
+      _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+  const __m256i needleVec = _mm256_xor_si256(
+      _mm256_set1_epi64x(static_cast<int64_t>(needle)), signBit);
+  for (; begin + 4 <= end; begin += 4) {
+    __m256i block = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + begin)),
+        signBit);
+    // Bit `k` of `isLess` is set iff `values[begin + k] < needle`. As the
+    // values are sorted, the set bits form a prefix.
+    auto isLess = static_cast<unsigned>(_mm256_movemask_pd(
+        _mm256_castsi256_pd(_mm256_cmpgt_epi64(needleVec, block))));
+    if (isLess != 0b1111) {
+      return begin + __builtin_ctz(~isLess);
+    }
+  }
+  return linearScanScalar(values, begin, end, needle);
+}
+#endif
+
+// Dispatch to the fastest linear scan that is supported by the CPU.
+size_t linearScan(const Id* values, size_t begin, size_t end, Id::T needle) {
+#ifdef QLEVER_SIMD_ZIPPER_JOIN_AVX2
+  static const bool hasAvx2 = isVectorizedKernelAvailable();
+  if (hasAvx2) {
+    return linearScanAvx2(values, begin, end, needle);
+  }
+#endif
+  return linearScanScalar(values, begin, end, needle);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+bool isVectorizedKernelAvailable() {
+#ifdef QLEVER_SIMD_ZIPPER_JOIN_AVX2
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+// _____________________________________________________________________________
+size_t findFirstNotLess(const Id* values, size_t begin, size_t end,
+                        Id::T needle) {
+  size_t endOfScan = std::min(end, begin + linearScanLimit);
+  size_t result = linearScan(values, begin, endOfScan, needle);
+  if (result < endOfScan || endOfScan == end) {
+    return result;
+  }
+  // The element is further away, find it via an exponential search followed
+  // by a binary search.
+  size_t lower = endOfScan;
+  size_t step = linearScanLimit;
+  size_t upper = std::min(end, lower + step);
+  while (upper < end && values[upper - 1].getBits() < needle) {
+    lower = upper;
+    step *= 2;
+    upper = std::min(end, lower + step);
+  }
+  auto isLess = [](Id id, Id::T bits) { return id.getBits() < bits; };
+  return std::lower_bound(values + lower, values + upper, needle, isLess) -
+         values;
+}
+
+// _____________________________________________________________________________
+bool isApplicable(ql::span<const Id> column) {
+  if (!column.empty() && column.front().isUndefined()) {
+    return false;
+  }
+  return std::none_of(column.begin(), column.end(), [](Id id) {
+    return id.getDatatype() == Datatype::LocalVocabIndex;
+  });
+}
+
+}  // namespace ad_utility::simdZipperJoin
@@ -0,0 +1,83 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_UTIL_JOINALGORITHMS_SIMDZIPPERJOIN_H
+#define QLEVER_SRC_UTIL_JOINALGORITHMS_SIMDZIPPERJOIN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "backports/span.h"
+#include "global/Id.h"
+
+// A specialized zipper join for the most common case of a join on a single
+// column that contains neither UNDEF values nor `LocalVocabIndex` entries. In
+// this case, the order of the `Id`s is exactly the order of their underlying
+// bits, which allows us to skip over non-matching elements in blocks using
+// vectorized comparisons (AVX2, selected at runtime) with a scalar fallback.
+namespace ad_utility::simdZipperJoin {
+
+// Return the index of the first element in `values[begin, end)` the bits of
+// which are not less than `needle`, or `end` if there is no such element. The
+// bits of `values[begin, end)` must be sorted. Short distances are found by a
+// (vectorized) linear scan, longer distances by an exponential search.
+size_t findFirstNotLess(const Id* values, size_t begin, size_t end,
+                        Id::T needle);
+
+// Return true iff the AVX2 kernel is used by `findFirstNotLess` on this
+// machine. Only used for logging and testing.
+bool isVectorizedKernelAvailable();
+
+// Return true iff the sorted `column` can be joined via `zipperJoin` below,
+// i.e. if it contains no UNDEF values and no `LocalVocabIndex` entries. The
+// first check is O(1) because UNDEF values are sorted to the front.
+bool isApplicable(ql::span<const Id> column);
+
+// Join the sorted columns `left` and `right` (both have to fulfill
+// `isApplicable`). For each pair of matching elements, `action(itLeft,
+// itRight)` is called with iterators into `left` and `right`. The calls happen
+// in the same order as in `zipperJoinWithUndef`, so the result is sorted.
+// `checkCancellation` is called regularly.
+template <typename Action, typename CheckCancellation>
+void zipperJoin(ql::span<const Id> left, ql::span<const Id> right,
+                const Action& action,
+                const CheckCancellation& checkCancellation) {
+  const size_t sizeLeft = left.size();
+  const size_t sizeRight = right.size();
+  size_t i = 0;
+  size_t j = 0;
+  while (i < sizeLeft && j < sizeRight) {
+    checkCancellation();
+    auto bitsLeft = left[i].getBits();
+    auto bitsRight = right[j].getBits();
+    if (bitsLeft < bitsRight) {
+      i = findFirstNotLess(left.data(), i + 1, sizeLeft, bitsRight);
+      continue;
+    }
+    if (bitsRight < bitsLeft) {
+      j = findFirstNotLess(right.data(), j + 1, sizeRight, bitsLeft);
+      continue;
+    }
+    // The ranges of equal elements are typically short, so we find their end
+    // by a simple linear scan.
+    auto isDifferent = [bitsLeft](Id id) { return id.getBits() != bitsLeft; };
+    size_t endLeft =
+        std::find_if(left.begin() + i + 1, left.end(), isDifferent) -
+        left.begin();
+    size_t endRight =
+        std::find_if(right.begin() + j + 1, right.end(), isDifferent) -
+        right.begin();
+    for (size_t k = i; k < endLeft; ++k) {
+      for (size_t l = j; l < endRight; ++l) {
+        action(left.begin() + k, right.begin() + l);
+      }
+    }
+    i = endLeft;
+    j = endRight;
+  }
+}
+
+}  // namespace ad_utility::simdZipperJoin
+
+#endif  // QLEVER_SRC_UTIL_JOINALGORITHMS_SIMDZIPPERJOIN_H
@@ -0,0 +1,144 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_LOSERTREE_H
+#define QLEVER_SRC_UTIL_LOSERTREE_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "backports/algorithm.h"
+#include "util/Exception.h"
+
+namespace ad_utility {
+
+// A tournament tree ("loser tree") for the k-way merge of sorted inputs, each
+// of which is given as a pair of an iterator and a sentinel. The smallest
+// current element of all the inputs can be accessed via `top()`, and `pop()`
+// advances the corresponding input.
+//
+// In contrast to a binary heap, each `pop()` only replays the matches on the
+// path from the leaf of the advanced input to the root. These are exactly
+// `log2(k)` comparisons with the current loser of each match (a heap needs
+// about twice as many), and the nodes on that path are stored contiguously in
+// a small array of indices, which makes the loser tree cache-friendly also for
+// large `k`.
+//
+// The `Comparator` has to be a strict weak ordering on the elements of the
+// inputs. Among equal elements, the one from the input with the smaller index
+// is returned first, so the merge is stable.
+template <typename Iterator, typename Sentinel, typename Comparator>
+class LoserTree {
+ public:
+  using Input = std::pair<Iterator, Sentinel>;
+
+ private:
+  std::vector<Input> inputs_;
+  // `tree_[0]` is the index of the input with the overall smallest element
+  // (the winner). For `1 <= i < k`, `tree_[i]` is the index of the input that
+  // lost the match at the internal node `i`. The children of node `i` are the
+  // nodes `2i` and `2i + 1`, and the leaf for input `j` is the node `k + j`.
+  std::vector<size_t> tree_;
+  Comparator comparator_;
+
+ public:
+  LoserTree(std::vector<Input> inputs, Comparator comparator)
+      : inputs_{std::move(inputs)},
+        tree_(std::max(inputs_.size(), size_t{1})),
+        comparator_{std::move(comparator)} {
+    if (!inputs_.empty()) {
+      tree_[0] = initialize(1);
+    }
+  }
+
+  // Return true iff all the inputs are exhausted.
+  bool empty() const { return inputs_.empty() || isExhausted(tree_[0]); }
+
+  // Return the smallest current element. May only be called if `!empty()`.
+  decltype(auto) top() {
+    AD_EXPENSIVE_CHECK(!empty());
+    return *inputs_[tree_[0]].first;
+  }
+
+  // The index of the input from which `top()` stems.
+  size_t topIndex() const { return tree_[0]; }
+
+  // Advance the input of the smallest element and restore the invariants of
+  // the tree. May only be called if `!empty()`.
+  void pop() {
+    AD_EXPENSIVE_CHECK(!empty());
+    size_t winner = tree_[0];
+    ++inputs_[winner].first;
+    for (size_t node = (winner + numInputs()) / 2; node > 0; node /= 2) {
+      // Use conditional moves instead of a (badly predictable) branch.
+      size_t loser = tree_[node];
+      bool swap = beats(loser, winner);
+      tree_[node] = swap ? winner : loser;
+      winner = swap ? loser : winner;
+    }
+    tree_[0] = winner;
+  }
+
+ private:
+  size_t numInputs() const { return inputs_.size(); }
+
+  bool isExhausted(size_t input) const {
+    return inputs_[input].first == inputs_[input].second;
+  }
+
+  // Return true iff the current element of input `a` has to be returned before
+  // the current element of input `b`. Exhausted inputs lose against all
+  // others.
+  bool beats(size_t a, size_t b) {
+    if (isExhausted(a)) {
+      return false;
+    }
+    if (isExhausted(b)) {
+      return true;
+    }
+    decltype(auto) elA = *inputs_[a].first;
+    decltype(auto) elB = *inputs_[b].first;
+    return comparator_(elA, elB) || (!comparator_(elB, elA) && a < b);
+  }
+
+  // Play all the matches in the subtree of the `node`, store the losers, and
+  // return the index of the winner.
+  size_t initialize(size_t node) {
+    if (node >= numInputs()) {
+      return node - numInputs();
+    }
+    size_t left = initialize(2 * node);
+    size_t right = initialize(2 * node + 1);
+    bool leftWins = beats(left, right);
+    tree_[node] = leftWins ? right : left;
+    return leftWins ? left : right;
+  }
+};
+
+// Create a `LoserTree` for the given `inputs` which have to be a random access
+// range of ranges. The `inputs` have to outlive the returned tree.
+template <typename Inputs, typename Comparator>
+auto makeLoserTree(Inputs& inputs, Comparator comparator) {
+  using Range = ql::ranges::range_value_t<Inputs>;
+  using Iterator = ql::ranges::iterator_t<Range>;
+  using Sentinel = ql::ranges::sentinel_t<Range>;
+  using Tree = LoserTree<Iterator, Sentinel, Comparator>;
+  std::vector<typename Tree::Input> iteratorPairs;
+  iteratorPairs.reserve(ql::ranges::size(inputs));
+  for (auto& input : inputs) {
+    iteratorPairs.emplace_back(ql::ranges::begin(input),
+                               ql::ranges::end(input));
+  }
+  return Tree{std::move(iteratorPairs), std::move(comparator)};
+}
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_LOSERTREE_H
@@ -10,6 +10,7 @@
 
 #include "util/AsyncStream.h"
 #include "util/Generator.h"
+#include "util/LoserTree.h"
 #include "util/TypeTraits.h"
 #include "util/ValueSizeGetters.h"
 #include "util/Views.h"
@@ -162,6 +163,66 @@ CPP_template(typename T, bool moveElements, typename SizeGetter,
   void next() { getNextBlock(); }
 };
 
+// Merge the elements from the presorted `ranges` according to the `comparator`
+// using a `LoserTree`. Otherwise the same as `LazyBinaryMerge` above.
+CPP_template(typename T, bool moveElements, typename SizeGetter, typename Range,
+             typename ComparisonFuncT)(
+    requires ValueSizeGetter<SizeGetter, T> CPP_and RangeWithValue<Range, T>
+        CPP_and ad_utility::InvocableWithExactReturnType<
+            ComparisonFuncT, bool, const T&,
+            const T&>) class LazyLoserTreeMerge
+    : public ad_utility::InputRangeMixin<LazyLoserTreeMerge<
+          T, moveElements, SizeGetter, Range, ComparisonFuncT>> {
+ private:
+  MemorySize maxMem_;
+  size_t maxBlockSize_;
+  std::vector<Range> ranges_;
+  ComparisonFuncT comparison_;
+  bool finished_{false};
+  std::vector<T> buffer_{};
+  using Tree = decltype(makeLoserTree(std::declval<std::vector<Range>&>(),
+                                      std::declval<ComparisonFuncT>()));
+  std::optional<Tree> tree_;
+
+ public:
+  using value_type = std::vector<T>;
+  LazyLoserTreeMerge(MemorySize maxMem, size_t maxBlockSize,
+                     std::vector<Range> ranges, ComparisonFuncT comparison)
+      : maxMem_{maxMem},
+        maxBlockSize_{maxBlockSize},
+        ranges_{std::move(ranges)},
+        comparison_{comparison} {}
+
+  void getNextBlock() {
+    MemorySize sizeOfCurrentBlock = 0_B;
+    buffer_.clear();
+    buffer_.reserve(maxBlockSize_);
+    auto& tree = tree_.value();
+    while (!tree.empty() && buffer_.size() < maxBlockSize_ &&
+           sizeOfCurrentBlock < maxMem_) {
+      pushSingleElement<moveElements, T, SizeGetter>(
+          buffer_, sizeOfCurrentBlock, tree.top());
+      tree.pop();
+    }
+    finished_ = buffer_.empty();
+  }
+
+  void start() {
+    tree_.emplace(makeLoserTree(ranges_, comparison_));
+    getNextBlock();
+  }
+  bool isFinished() { return finished_; }
+  auto& get() { return buffer_; }
+  const auto& get() const { return buffer_; }
+
+  void next() { getNextBlock(); }
+};
+
+// Up to this many ranges are merged by a single `LazyLoserTreeMerge` in the
+// recursion of `parallelMultiwayMerge`. More ranges are split into two halves
+// which are merged in parallel.
+static constexpr size_t maxNumRangesPerLoserTree = 16;
+
 // Return the elements of the `range` in blocks of the given `blocksize`.
 // TODO<joka921> This gets much simpler with the buffering generator.
 CPP_template(typename T, bool moveElements, typename SizeGetter,
@@ -243,6 +304,16 @@ CPP_template(typename T, bool moveElements, typename SizeGetter, typename R,
                         ql::ranges::range_value_t<R>, ComparisonFuncT>(
             maxMemPerNode, blocksize, moveIf(rangeOfRanges[0]),
             moveIf(rangeOfRanges[1]), comparison)};
+  } else if (ql::ranges::size(rangeOfRanges) <= maxNumRangesPerLoserTree) {
+    using Range = ql::ranges::range_value_t<R>;
+    std::vector<Range> ranges;
+    ranges.reserve(ql::ranges::size(rangeOfRanges));
+    for (auto& range : rangeOfRanges) {
+      ranges.push_back(moveIf(range));
+    }
+    return ResultT{
+        LazyLoserTreeMerge<T, moveElements, SizeGetter, Range, ComparisonFuncT>(
+            maxMemPerNode, blocksize, std::move(ranges), comparison)};
   } else {
     size_t size = ql::ranges::size(rangeOfRanges);
     size_t split = size / 2;
@@ -0,0 +1,110 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Christoph Ullinger <ullingec@informatik.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_READONLYMAPPEDFILE_H
+#define QLEVER_SRC_UTIL_READONLYMAPPEDFILE_H
+
+#include <absl/strings/str_cat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "util/ResetWhenMoved.h"
+
+namespace ad_utility {
+
+// A read-only memory mapping of a complete file. In contrast to reading from
+// an `ad_utility::File`, accessing the contents requires no system call, and
+// opening the file has no startup cost, because the operating system loads
+// the pages of the file lazily (and keeps them in its page cache). The file
+// must not be modified while it is mapped. The mapping is removed by `unmap`
+// or the destructor.
+class ReadOnlyMappedFile {
+ private:
+  ResetWhenMoved<const char*, nullptr> data_;
+  ResetWhenMoved<size_t, 0> size_;
+
+ public:
+  ReadOnlyMappedFile() = default;
+
+  // Map the file with the given `filename`, see `map`.
+  explicit ReadOnlyMappedFile(const std::string& filename) { map(filename); }
+
+  ReadOnlyMappedFile(ReadOnlyMappedFile&&) noexcept = default;
+  ReadOnlyMappedFile& operator=(ReadOnlyMappedFile&& other) noexcept {
+    unmap();
+    data_ = std::move(other.data_);
+    size_ = std::move(other.size_);
+    return *this;
+  }
+  ReadOnlyMappedFile(const ReadOnlyMappedFile&) = delete;
+  ReadOnlyMappedFile& operator=(const ReadOnlyMappedFile&) = delete;
+
+  ~ReadOnlyMappedFile() { unmap(); }
+
+  // Map the file with the given `filename` (after removing a previous
+  // mapping). Throw if the file can't be opened or mapped.
+  void map(const std::string& filename) {
+    unmap();
+    auto throwError = [&filename](std::string_view what) {
+      throw std::runtime_error(absl::StrCat("Could not ", what, " the file \"",
+                                            filename,
+                                            "\": ", std::strerror(errno)));
+    };
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throwError("open");
+    }
+    struct stat fileStatus;
+    if (::fstat(fd, &fileStatus) != 0) {
+      ::close(fd);
+      throwError("determine the size of");
+    }
+    size_t size = static_cast<size_t>(fileStatus.st_size);
+    // A mapping of size zero is not allowed, empty files are represented by
+    // `data() == nullptr`.
+    if (size == 0) {
+      ::close(fd);
+      return;
+    }
+    void* ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping stays valid after the file descriptor has been closed.
+    ::close(fd);
+    if (ptr == MAP_FAILED) {
+      throwError("memory-map");
+    }
+    data_ = static_cast<const char*>(ptr);
+    size_ = size;
+  }
+
+  // Remove the mapping. Afterward, the file is empty.
+  void unmap() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<char*>(static_cast<const char*>(data_)), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  // The contents of the file.
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+  std::string_view view() const { return {data(), size()}; }
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_READONLYMAPPEDFILE_H
@@ -5,6 +5,7 @@
 #ifndef QLEVER_BYTEBUFFERSERIALIZER_H
 #define QLEVER_BYTEBUFFERSERIALIZER_H
 
+#include <string_view>
 #include <vector>
 
 #include "backports/algorithm.h"
@@ -69,6 +70,29 @@ class ByteBufferReadSerializer {
   Storage::const_iterator _iterator{_data.begin()};
 };
 
+/**
+ * Serializer that reads from a buffer of bytes that it doesn't own (e.g. a
+ * memory-mapped file). The buffer must outlive the serializer.
+ */
+class ByteBufferViewReadSerializer {
+ public:
+  using SerializerType = ReadSerializerTag;
+
+  explicit ByteBufferViewReadSerializer(std::string_view data)
+      : _data{data} {};
+  void serializeBytes(char* bytePointer, size_t numBytes) {
+    AD_CONTRACT_CHECK(numBytes <= _data.size());
+    std::copy(_data.begin(), _data.begin() + numBytes, bytePointer);
+    _data.remove_prefix(numBytes);
+  }
+
+  // The bytes that have not been read yet.
+  std::string_view remainingData() const noexcept { return _data; }
+
+ private:
+  std::string_view _data;
+};
+
 }  // namespace ad_utility::serialization
 
 #endif  // QLEVER_BYTEBUFFERSERIALIZER_H
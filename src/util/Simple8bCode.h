@@ -8,17 +8,20 @@
 #include <assert.h>
 #include <stdint.h>
 
+#include <array>
+#include <utility>
+
 #include "backports/algorithm.h"
 
 namespace ad_utility {
 
 //! Selector mask,
 //! see: Anh & Moffat: "Index compression using 64-bit words."
-static const uint64_t SIMPLE8B_SELECTOR_MASK = 0x000000000000000F;
+static constexpr uint64_t SIMPLE8B_SELECTOR_MASK = 0x000000000000000F;
 
 //! Selectors,
 //! see: Anh & Moffat: "Index compression using 64-bit words."
-static const struct {
+static constexpr struct {
   unsigned char _itemWidth;
   unsigned char _groupSize;
   unsigned char _wastedBits;
@@ -148,27 +151,40 @@ class Simple8bCode {
   static void decode(uint64_t* const encoded, size_t nofElements,
                      Numeric* decoded,
                      MakeFromUint64t makeFromUint64 = MakeFromUint64t{}) {
-    // Handle trivial empty case
-    if (!nofElements) {
-      return;
-    }
-    uint64_t word;
-    // Loop over full 64bit codewords and
+    // One decoding function per selector, see `decodeWord` below.
+    static constexpr auto decodeWordFunctions =
+        makeDecodeWordFunctions<Numeric, MakeFromUint64t>(
+            std::make_index_sequence<16>{});
     size_t nofElementsDone(0), nofCodeWordsDone(0);
-    size_t selector(encoded[nofCodeWordsDone] & SIMPLE8B_SELECTOR_MASK);
     while (nofElementsDone < nofElements) {
-      word = encoded[nofCodeWordsDone] >> 4;
-      for (size_t i(0); i < SIMPLE8B_SELECTORS[selector]._groupSize; ++i) {
-        decoded[nofElementsDone++] =
-            makeFromUint64(word & SIMPLE8B_SELECTORS[selector]._mask);
-        word >>= SIMPLE8B_SELECTORS[selector]._itemWidth;
-      }
-      ++nofCodeWordsDone;
-      if (nofElementsDone < nofElements) {
-        selector = encoded[nofCodeWordsDone] & SIMPLE8B_SELECTOR_MASK;
-      }
+      uint64_t word = encoded[nofCodeWordsDone++];
+      size_t selector = word & SIMPLE8B_SELECTOR_MASK;
+      decodeWordFunctions[selector](word >> 4, decoded + nofElementsDone,
+                                    makeFromUint64);
+      nofElementsDone += SIMPLE8B_SELECTORS[selector]._groupSize;
     }
   }
+
+ private:
+  // Decode the items of a single codeword (without the selector bits) with
+  // the given `Selector`. As the width and the number of the items are known
+  // at compile time and the items are extracted independently of each other,
+  // the compiler can unroll and vectorize the loop.
+  template <size_t Selector, typename Numeric, typename MakeFromUint64t>
+  static void decodeWord(uint64_t word, Numeric* decoded,
+                         const MakeFromUint64t& makeFromUint64) {
+    constexpr auto selector = SIMPLE8B_SELECTORS[Selector];
+    for (size_t i = 0; i < selector._groupSize; ++i) {
+      decoded[i] = makeFromUint64((word >> (i * selector._itemWidth)) &
+                                  selector._mask);
+    }
+  }
+
+  template <typename Numeric, typename MakeFromUint64t, size_t... Selectors>
+  static constexpr auto makeDecodeWordFunctions(
+      std::index_sequence<Selectors...>) {
+    return std::array{&decodeWord<Selectors, Numeric, MakeFromUint64t>...};
+  }
 };
 }  // namespace ad_utility
 
@@ -0,0 +1,175 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "util/SpanTracer.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <atomic>
+#include <random>
+
+#include "backports/algorithm.h"
+#include "util/Exception.h"
+
+namespace ad_utility::timer {
+
+namespace {
+// The tracer that is active on the current thread.
+thread_local SpanTracer* activeTracer = nullptr;
+
+// The buffer of the tracer with the given ID that was last used on the current
+// thread. This avoids the lock of the `buffers_` for all but the first span of
+// a thread. The IDs are never reused, so a buffer of a destroyed tracer is
+// never accessed.
+struct CachedBuffer {
+  uint64_t tracerId_ = 0;
+  void* buffer_ = nullptr;
+};
+thread_local CachedBuffer cachedBuffer;
+
+std::atomic<uint64_t> nextTracerId{1};
+
+int64_t toMicroseconds(std::chrono::steady_clock::time_point timePoint) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             timePoint.time_since_epoch())
+      .count();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+SpanTracer::SpanTracer(size_t maxNumSpansPerThread)
+    : id_{nextTracerId.fetch_add(1)},
+      maxNumSpansPerThread_{maxNumSpansPerThread} {
+  AD_CONTRACT_CHECK(maxNumSpansPerThread > 0);
+}
+
+// _____________________________________________________________________________
+auto SpanTracer::bufferOfCurrentThread() -> ThreadBuffer& {
+  if (cachedBuffer.tracerId_ == id_) {
+    return *static_cast<ThreadBuffer*>(cachedBuffer.buffer_);
+  }
+  auto threadIndex = currentThreadIndex();
+  auto buffers = buffers_.wlock();
+  auto it = ql::ranges::find(*buffers, threadIndex, [](const auto& buffer) {
+    return buffer->threadIndex_;
+  });
+  if (it == buffers->end()) {
+    buffers->push_back(std::make_unique<ThreadBuffer>());
+    buffers->back()->threadIndex_ = threadIndex;
+    it = buffers->end() - 1;
+  }
+  cachedBuffer = {id_, it->get()};
+  return **it;
+}
+
+// _____________________________________________________________________________
+void SpanTracer::record(std::string_view category, std::string name,
+                        std::chrono::steady_clock::time_point begin,
+                        std::chrono::steady_clock::time_point end) {
+  Span span{category, std::move(name), toMicroseconds(begin),
+            toMicroseconds(end) - toMicroseconds(begin)};
+  auto& buffer = bufferOfCurrentThread();
+  std::lock_guard lock{buffer.mutex_};
+  if (buffer.ringBuffer_.size() < maxNumSpansPerThread_) {
+    buffer.ringBuffer_.push_back(std::move(span));
+  } else {
+    buffer.ringBuffer_[buffer.numRecorded_ % maxNumSpansPerThread_] =
+        std::move(span);
+  }
+  ++buffer.numRecorded_;
+}
+
+// _____________________________________________________________________________
+auto SpanTracer::collectSpans() const -> std::vector<ThreadSpans> {
+  std::vector<ThreadSpans> result;
+  auto buffers = buffers_.rlock();
+  for (const auto& buffer : *buffers) {
+    std::lock_guard lock{buffer->mutex_};
+    const auto& ring = buffer->ringBuffer_;
+    ThreadSpans& spans = result.emplace_back(ThreadSpans{
+        buffer->threadIndex_, {}, buffer->numRecorded_ - ring.size()});
+    // The oldest span is at the position that is overwritten next.
+    size_t oldest = ring.size() < maxNumSpansPerThread_
+                        ? 0
+                        : buffer->numRecorded_ % maxNumSpansPerThread_;
+    spans.spans_.reserve(ring.size());
+    for (size_t i = 0; i < ring.size(); ++i) {
+      spans.spans_.push_back(ring[(oldest + i) % ring.size()]);
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void SpanTracer::appendChromeTraceEvents(nlohmann::json& traceEvents,
+                                         size_t processId,
+                                         std::string_view processName) const {
+  traceEvents.push_back({{"ph", "M"},
+                         {"name", "process_name"},
+                         {"pid", processId},
+                         {"args", {{"name", std::string{processName}}}}});
+  for (const auto& thread : collectSpans()) {
+    auto name = absl::StrCat("thread ", thread.threadIndex_);
+    if (thread.numDropped_ > 0) {
+      absl::StrAppend(&name, " (", thread.numDropped_, " spans dropped)");
+    }
+    traceEvents.push_back({{"ph", "M"},
+                           {"name", "thread_name"},
+                           {"pid", processId},
+                           {"tid", thread.threadIndex_},
+                           {"args", {{"name", std::move(name)}}}});
+    for (const auto& span : thread.spans_) {
+      traceEvents.push_back({{"ph", "X"},
+                             {"name", span.name_},
+                             {"cat", std::string{span.category_}},
+                             {"ts", span.beginMicroseconds_},
+                             {"dur", span.durationMicroseconds_},
+                             {"pid", processId},
+                             {"tid", thread.threadIndex_}});
+    }
+  }
+}
+
+// _____________________________________________________________________________
+nlohmann::json SpanTracer::toChromeTrace(std::string_view processName) const {
+  auto traceEvents = nlohmann::json::array();
+  appendChromeTraceEvents(traceEvents, 1, processName);
+  return {{"traceEvents", std::move(traceEvents)}, {"displayTimeUnit", "ms"}};
+}
+
+// _____________________________________________________________________________
+SpanTracer* SpanTracer::active() { return activeTracer; }
+
+// _____________________________________________________________________________
+bool SpanTracer::sample(double probability) {
+  if (probability <= 0.0) {
+    return false;
+  }
+  thread_local std::minstd_rand randomEngine{std::random_device{}()};
+  return std::uniform_real_distribution<double>{0.0, 1.0}(randomEngine) <
+         probability;
+}
+
+// _____________________________________________________________________________
+size_t SpanTracer::currentThreadIndex() {
+  static std::atomic<size_t> nextThreadIndex{0};
+  thread_local size_t threadIndex = nextThreadIndex.fetch_add(1);
+  return threadIndex;
+}
+
+// _____________________________________________________________________________
+SpanTracer::Activation::Activation(SpanTracer* tracer)
+    : previous_{activeTracer} {
+  activeTracer = tracer;
+}
+
+// _____________________________________________________________________________
+SpanTracer::Activation::~Activation() { activeTracer = previous_; }
+
+}  // namespace ad_utility::timer
@@ -0,0 +1,160 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_SPANTRACER_H
+#define QLEVER_SRC_UTIL_SPANTRACER_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/Synchronized.h"
+#include "util/json.h"
+
+namespace ad_utility::timer {
+
+// A tracer for the spans (named intervals of time) of a single query on all
+// the threads that work on the query. In contrast to the `TimeTracer`, which
+// builds a tree of the traces of a single thread, the spans are recorded in a
+// ring buffer per thread (the oldest spans are overwritten when it is full),
+// and exported in the trace event format of Chrome (which is also understood
+// by Perfetto), where concurrent spans on different threads, e.g. of the
+// workers of a lazy index scan, are shown next to each other.
+//
+// A tracer is activated for the current thread using an `Activation`, and the
+// `TraceSpan`s that are created on this thread are then recorded by the
+// active tracer. If no tracer is active (the common case), a `TraceSpan` only
+// costs a single read of a thread-local variable.
+class SpanTracer {
+ public:
+  struct Span {
+    // The category, e.g. "operation" or "scan". Must be a string literal.
+    std::string_view category_;
+    std::string name_;
+    // In microseconds since the epoch of the `steady_clock`, s.t. the spans
+    // of different tracers can be shown on the same timeline.
+    int64_t beginMicroseconds_;
+    int64_t durationMicroseconds_;
+  };
+
+  // The spans that were recorded on a single thread, in the order of their
+  // end.
+  struct ThreadSpans {
+    // A process-wide index of the thread, see `currentThreadIndex`.
+    size_t threadIndex_;
+    std::vector<Span> spans_;
+    // The number of spans that were overwritten in the ring buffer.
+    size_t numDropped_;
+  };
+
+ private:
+  struct ThreadBuffer {
+    size_t threadIndex_;
+    // Only contended when the spans are collected.
+    std::mutex mutex_;
+    std::vector<Span> ringBuffer_;
+    // The total number of spans that were recorded on this thread.
+    size_t numRecorded_ = 0;
+  };
+
+  const uint64_t id_;
+  const size_t maxNumSpansPerThread_;
+  Synchronized<std::vector<std::unique_ptr<ThreadBuffer>>> buffers_;
+
+  // Get the buffer of the current thread, create it if necessary.
+  ThreadBuffer& bufferOfCurrentThread();
+
+ public:
+  explicit SpanTracer(size_t maxNumSpansPerThread = 10'000);
+
+  SpanTracer(const SpanTracer&) = delete;
+  SpanTracer& operator=(const SpanTracer&) = delete;
+
+  // Record a span on the current thread.
+  void record(std::string_view category, std::string name,
+              std::chrono::steady_clock::time_point begin,
+              std::chrono::steady_clock::time_point end);
+
+  // Get the spans of all the threads. Must only be called when no more spans
+  // are recorded concurrently, otherwise the result is incomplete.
+  std::vector<ThreadSpans> collectSpans() const;
+
+  // Append the spans to the `traceEvents` (a JSON array) in the trace event
+  // format of Chrome, as the spans of the process `processId` with the given
+  // `processName` (a trace of several queries shows each query as a separate
+  // process).
+  void appendChromeTraceEvents(nlohmann::json& traceEvents, size_t processId,
+                               std::string_view processName) const;
+
+  // Return a complete trace in the trace event format of Chrome that only
+  // contains the spans of this tracer.
+  nlohmann::json toChromeTrace(std::string_view processName) const;
+
+  // The tracer that is active on the current thread, `nullptr` if there is
+  // none.
+  static SpanTracer* active();
+
+  // Return true with the given `probability`, to decide whether a query is
+  // traced.
+  static bool sample(double probability);
+
+  // A small process-wide index of the current thread (starting at zero in the
+  // order in which the threads first record a span), which is used as the
+  // thread ID in the exported traces.
+  static size_t currentThreadIndex();
+
+  // Make the `tracer` (which may be `nullptr`) the active tracer of the
+  // current thread until the end of the scope, then restore the previously
+  // active tracer. Must not be held across the suspension points of a
+  // coroutine, because the coroutine might be resumed on another thread.
+  class Activation {
+    SpanTracer* previous_;
+
+   public:
+    explicit Activation(SpanTracer* tracer);
+    ~Activation();
+    Activation(const Activation&) = delete;
+    Activation& operator=(const Activation&) = delete;
+  };
+};
+
+// Record the lifetime of this object as a span of the tracer that is active on
+// the current thread when it is constructed (if any). If the `name` is
+// expensive to compute, check `SpanTracer::active()` first.
+class TraceSpan {
+  SpanTracer* tracer_;
+  std::string_view category_;
+  std::string name_;
+  std::chrono::steady_clock::time_point begin_;
+
+ public:
+  explicit TraceSpan(std::string_view category, std::string_view name = {})
+      : tracer_{SpanTracer::active()}, category_{category} {
+    if (tracer_ != nullptr) {
+      name_ = name.empty() ? std::string{category} : std::string{name};
+      begin_ = std::chrono::steady_clock::now();
+    }
+  }
+  ~TraceSpan() {
+    if (tracer_ != nullptr) {
+      tracer_->record(category_, std::move(name_), begin_,
+                      std::chrono::steady_clock::now());
+    }
+  }
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+};
+
+}  // namespace ad_utility::timer
+
+#endif  // QLEVER_SRC_UTIL_SPANTRACER_H
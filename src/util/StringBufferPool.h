@@ -0,0 +1,81 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_STRINGBUFFERPOOL_H
+#define QLEVER_SRC_UTIL_STRINGBUFFERPOOL_H
+
+#include <string>
+#include <vector>
+
+#include "util/Synchronized.h"
+
+namespace ad_utility::streams {
+
+// A threadsafe pool of `std::string`s that are used as buffers, s.t. a
+// pipeline that passes one string per chunk from a producer to a consumer
+// (like the streaming of a large HTTP response) doesn't allocate (and page
+// fault) a fresh buffer for each chunk. The consumer returns the strings that
+// it is done with via `put`, and the producer gets them via `get`.
+class StringBufferPool {
+  // The initial capacity of newly created buffers.
+  size_t bufferCapacity_;
+  // The maximal number of buffers that are kept in the pool.
+  size_t maxNumBuffers_;
+  Synchronized<std::vector<std::string>> buffers_;
+
+ public:
+  StringBufferPool(size_t bufferCapacity, size_t maxNumBuffers)
+      : bufferCapacity_{bufferCapacity}, maxNumBuffers_{maxNumBuffers} {}
+
+  // Return an empty string, the capacity of which is at least the
+  // `bufferCapacity_`.
+  std::string get() {
+    std::string result;
+    {
+      auto buffers = buffers_.wlock();
+      if (!buffers->empty()) {
+        result = std::move(buffers->back());
+        buffers->pop_back();
+      }
+    }
+    result.clear();
+    result.reserve(bufferCapacity_);
+    return result;
+  }
+
+  // Return the `buffer` to the pool. Buffers that are too small or too large
+  // (s.t. a single large chunk doesn't pin its memory) and buffers that
+  // exceed the `maxNumBuffers_` are freed.
+  void put(std::string buffer) {
+    if (buffer.capacity() < bufferCapacity_ ||
+        buffer.capacity() > 2 * bufferCapacity_) {
+      return;
+    }
+    auto buffers = buffers_.wlock();
+    if (buffers->size() < maxNumBuffers_) {
+      buffers->push_back(std::move(buffer));
+    }
+  }
+
+  // The number of buffers that are currently in the pool.
+  size_t numBuffers() const { return buffers_.rlock()->size(); }
+};
+
+// The pool for the chunks of the streamed HTTP responses, with buffers of
+// the size of the chunks of the `stream_generator` (1 MiB).
+// Note: The pool is deliberately never destroyed, because buffers might
+// still be returned during the destruction of other static objects.
+inline StringBufferPool& httpResponseBufferPool() {
+  static auto* pool = new StringBufferPool{1u << 20, 32};
+  return *pool;
+}
+
+}  // namespace ad_utility::streams
+
+#endif  // QLEVER_SRC_UTIL_STRINGBUFFERPOOL_H
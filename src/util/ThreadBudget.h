@@ -0,0 +1,113 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_THREADBUDGET_H
+#define QLEVER_SRC_UTIL_THREADBUDGET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "util/Exception.h"
+
+namespace ad_utility {
+
+// A threadsafe budget of CPU threads that is shared by all the operations that
+// want to compute something in parallel. Each operation requests the number
+// of threads it would like to use and only gets as many as are still free
+// (but always at least one, namely the calling thread). On an idle server, a
+// single query thus gets all the threads, and under load, the queries
+// gracefully degrade to fewer threads instead of oversubscribing the cores.
+class ThreadBudget {
+  std::mutex mutex_;
+  size_t capacity_;
+  size_t numReserved_ = 0;
+
+ public:
+  // A number of threads that has been reserved from the budget. The threads
+  // are returned to the budget on destruction.
+  class Reservation {
+    ThreadBudget* budget_;
+    size_t numThreads_;
+
+    friend class ThreadBudget;
+    Reservation(ThreadBudget* budget, size_t numThreads)
+        : budget_{budget}, numThreads_{numThreads} {}
+
+   public:
+    Reservation(Reservation&& other) noexcept
+        : budget_{std::exchange(other.budget_, nullptr)},
+          numThreads_{other.numThreads_} {}
+    Reservation& operator=(Reservation&&) = delete;
+    Reservation(const Reservation&) = delete;
+    Reservation& operator=(const Reservation&) = delete;
+    ~Reservation() {
+      if (budget_ != nullptr) {
+        budget_->release(numThreads_);
+      }
+    }
+
+    // The number of threads that may be used, at least one.
+    size_t numThreads() const { return numThreads_; }
+  };
+
+  // A `capacity` of zero means the number of hardware threads.
+  explicit ThreadBudget(size_t capacity) { setCapacity(capacity); }
+
+  ThreadBudget(const ThreadBudget&) = delete;
+  ThreadBudget& operator=(const ThreadBudget&) = delete;
+
+  // Change the capacity (zero means the number of hardware threads). Existing
+  // reservations are not affected.
+  void setCapacity(size_t capacity) {
+    std::lock_guard lock{mutex_};
+    size_t numHardwareThreads = std::thread::hardware_concurrency();
+    capacity_ =
+        capacity != 0 ? capacity : std::max(size_t{1}, numHardwareThreads);
+  }
+
+  // Reserve up to `numRequested` threads. The returned reservation has at
+  // least one thread, even if the budget is exhausted.
+  Reservation reserve(size_t numRequested) {
+    std::lock_guard lock{mutex_};
+    size_t numFree = capacity_ > numReserved_ ? capacity_ - numReserved_ : 0;
+    size_t numThreads = std::max(size_t{1}, std::min(numRequested, numFree));
+    numReserved_ += numThreads;
+    return Reservation{this, numThreads};
+  }
+
+  // The number of currently reserved threads.
+  size_t numReserved() {
+    std::lock_guard lock{mutex_};
+    return numReserved_;
+  }
+
+ private:
+  void release(size_t numThreads) {
+    std::lock_guard lock{mutex_};
+    AD_CORRECTNESS_CHECK(numReserved_ >= numThreads);
+    numReserved_ -= numThreads;
+  }
+};
+
+// The budget that is shared by all the queries of the process. Its capacity is
+// set via the runtime parameter `thread-budget`.
+// Note: Like the `allocationPool()`, the budget is deliberately never
+// destroyed, because reservations might still be released during the
+// destruction of other static objects.
+inline ThreadBudget& globalThreadBudget() {
+  static auto* budget = new ThreadBudget{0};
+  return *budget;
+}
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_THREADBUDGET_H
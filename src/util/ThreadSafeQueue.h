@@ -9,9 +9,12 @@
 #include <absl/cleanup/cleanup.h>
 
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <type_traits>
+#include <utility>
 
 #include "util/Exception.h"
 #include "util/ExceptionHandling.h"
@@ -312,6 +315,70 @@ ad_utility::InputRangeTypeErased<typename Queue::value_type> queueManager(
       queueSize, numThreads, std::move(producer))};
 }
 
+// Apply the `function` to all the elements of the `input` range in
+// `numThreads` concurrent worker threads ("morsel-driven"), and return the
+// results as an input range. Each worker repeatedly pulls the next element of
+// the `input` (only one worker at a time, so the `input` itself doesn't have to
+// be thread-safe) and calls the `function` on an lvalue reference to it. The
+// `function` is copied to each worker, has to be callable as `const`, and has
+// to be safe to be called concurrently. If `keepOrder` is true, the results
+// are yielded in the order of their elements in the `input`, otherwise in the
+// order in which they are computed. At most `queueSize` results are
+// buffered. Exceptions that are thrown by the `input` or the `function` are
+// propagated to the consumer.
+template <typename Input, typename Function>
+auto parallelTransform(Input input, Function function, size_t numThreads,
+                       size_t queueSize, bool keepOrder) {
+  using T = ql::ranges::range_value_t<Input>;
+  using U = std::decay_t<std::invoke_result_t<const Function&, T&>>;
+  // The `input` that is shared by all the workers, together with the index of
+  // its next element.
+  struct SharedInput {
+    std::mutex mutex_;
+    ad_utility::InputRangeTypeErased<T> input_;
+    size_t nextIndex_ = 0;
+    bool isExhausted_ = false;
+  };
+  auto sharedInput = std::make_shared<SharedInput>();
+  sharedInput->input_ = ad_utility::InputRangeTypeErased<T>{std::move(input)};
+  using IndexAndElement = std::pair<size_t, T>;
+  auto getNext = [sharedInput = std::move(
+                      sharedInput)]() -> std::optional<IndexAndElement> {
+    std::lock_guard lock{sharedInput->mutex_};
+    if (sharedInput->isExhausted_) {
+      return std::nullopt;
+    }
+    auto element = sharedInput->input_.get();
+    if (!element.has_value()) {
+      sharedInput->isExhausted_ = true;
+      return std::nullopt;
+    }
+    return IndexAndElement{sharedInput->nextIndex_++,
+                           std::move(element.value())};
+  };
+
+  if (keepOrder) {
+    return queueManager<OrderedThreadSafeQueue<U>>(
+        queueSize, numThreads,
+        [getNext, function]() -> std::optional<std::pair<size_t, U>> {
+          auto next = getNext();
+          if (!next.has_value()) {
+            return std::nullopt;
+          }
+          return std::pair<size_t, U>{next->first, function(next->second)};
+        });
+  }
+  return queueManager<ThreadSafeQueue<U>>(
+      queueSize, numThreads,
+      [getNext, function]() -> std::optional<U> {
+        auto next = getNext();
+        if (!next.has_value()) {
+          return std::nullopt;
+        }
+        return function(next->second);
+      });
+}
+
 }  // namespace ad_utility::data_structures
 
 #endif  // QLEVER_SRC_UTIL_THREADSAFEQUEUE_H
@@ -7,6 +7,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <ctime>
 
 #include "backports/keywords.h"
 #include "util/Log.h"
@@ -183,6 +184,17 @@ class ThreadSafeTimer {
   }
 };
 
+// Return the CPU time that has been consumed by the calling thread so far. The
+// difference of two calls on the same thread is the CPU time of the work in
+// between, which (unlike the wall time measured by the `Timer`) doesn't include
+// the time that the thread was blocked, e.g. waiting for I/O or for a lock.
+inline Timer::Duration currentThreadCpuTime() {
+  timespec time{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+  return Timer::toDuration(chr::seconds{time.tv_sec} +
+                           chr::nanoseconds{time.tv_nsec});
+}
+
 namespace detail {
 // A helper struct that measures the time from its creation until its
 // destruction and logs the time together with a specified message
@@ -223,6 +235,7 @@ using detail::TimeBlockAndLog;
 #endif
 
 }  // namespace timer
+using timer::currentThreadCpuTime;
 using timer::TimeBlockAndLog;
 using timer::Timer;
 }  // namespace ad_utility
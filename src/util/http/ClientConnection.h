@@ -0,0 +1,74 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_HTTP_CLIENTCONNECTION_H
+#define QLEVER_SRC_UTIL_HTTP_CLIENTCONNECTION_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "util/Synchronized.h"
+
+namespace ad_utility::httpUtils {
+
+// The state of the connection over which a request was received by the
+// `HttpServer`. If the HTTP handler accepts it as a third argument, the server
+// passes a `ClientConnection` for each request and closes it as soon as the
+// client has closed the connection while the request is being handled. This
+// can be used to cancel the processing of requests the response of which
+// nobody is waiting for anymore (for example, because a browser aborts
+// outdated autocompletion queries by closing their connection).
+class ClientConnection {
+  struct State {
+    bool isClosed_ = false;
+    std::vector<std::function<void()>> onClose_;
+  };
+  Synchronized<State, std::mutex> state_;
+
+ public:
+  // Register a `callback` which is invoked (once) when the connection is
+  // closed. If the connection has already been closed, the `callback` is
+  // invoked immediately.
+  void onClose(std::function<void()> callback) {
+    {
+      auto state = state_.wlock();
+      if (!state->isClosed_) {
+        state->onClose_.push_back(std::move(callback));
+        return;
+      }
+    }
+    callback();
+  }
+
+  // Mark the connection as closed and invoke all the registered callbacks.
+  // Further calls have no effect.
+  void close() {
+    std::vector<std::function<void()>> callbacks;
+    {
+      auto state = state_.wlock();
+      if (state->isClosed_) {
+        return;
+      }
+      state->isClosed_ = true;
+      callbacks = std::move(state->onClose_);
+    }
+    for (auto& callback : callbacks) {
+      callback();
+    }
+  }
+
+  // Return true iff the connection has been closed by the client.
+  bool isClosed() const { return state_.wlock()->isClosed_; }
+};
+
+}  // namespace ad_utility::httpUtils
+
+#endif  // QLEVER_SRC_UTIL_HTTP_CLIENTCONNECTION_H
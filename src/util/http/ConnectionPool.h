@@ -0,0 +1,114 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_HTTP_CONNECTIONPOOL_H
+#define QLEVER_SRC_UTIL_HTTP_CONNECTIONPOOL_H
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/Synchronized.h"
+
+namespace ad_utility::httpUtils {
+
+// A pool of idle connections (e.g. `HttpClient`s with HTTP keep-alive), s.t.
+// subsequent requests to the same server don't have to open a new connection
+// (which for HTTPS includes an expensive TLS handshake). The connections are
+// identified by a `key` (typically the host and the port). At most
+// `maxNumIdleConnections` connections are kept, and connections that have been
+// idle for longer than the `idleTimeout` are closed (servers typically close
+// idle connections after some time anyway).
+template <typename Connection>
+class ConnectionPool {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+ private:
+  struct IdleConnection {
+    std::string key_;
+    std::unique_ptr<Connection> connection_;
+    Clock::time_point idleSince_;
+  };
+  struct State {
+    // The connections that have been released least recently are at the
+    // front.
+    std::deque<IdleConnection> idleConnections_;
+    size_t maxNumIdleConnections_;
+    Clock::duration idleTimeout_;
+  };
+  ad_utility::Synchronized<State> state_;
+
+ public:
+  ConnectionPool(size_t maxNumIdleConnections, Clock::duration idleTimeout)
+      : state_{State{{}, maxNumIdleConnections, idleTimeout}} {}
+
+  // Return an idle connection for the `key` and remove it from the pool, or
+  // `nullptr` if there is none. The connection that was released most
+  // recently is returned, because it is the least likely to have been closed
+  // by the server.
+  std::unique_ptr<Connection> acquire(std::string_view key) {
+    // The connections are closed after the lock has been released.
+    std::vector<std::unique_ptr<Connection>> expired;
+    auto lock = state_.wlock();
+    auto& idle = lock->idleConnections_;
+    auto oldestValid = Clock::now() - lock->idleTimeout_;
+    while (!idle.empty() && idle.front().idleSince_ < oldestValid) {
+      expired.push_back(std::move(idle.front().connection_));
+      idle.pop_front();
+    }
+    for (auto it = idle.rbegin(); it != idle.rend(); ++it) {
+      if (it->key_ == key) {
+        auto connection = std::move(it->connection_);
+        idle.erase(std::next(it).base());
+        return connection;
+      }
+    }
+    return nullptr;
+  }
+
+  // Add the idle `connection` for the `key` to the pool. If the pool is full,
+  // the connection that has been idle for the longest time is closed.
+  void release(std::string key, std::unique_ptr<Connection> connection) {
+    std::vector<std::unique_ptr<Connection>> evicted;
+    auto lock = state_.wlock();
+    auto& idle = lock->idleConnections_;
+    idle.push_back(
+        IdleConnection{std::move(key), std::move(connection), Clock::now()});
+    while (idle.size() > lock->maxNumIdleConnections_) {
+      evicted.push_back(std::move(idle.front().connection_));
+      idle.pop_front();
+    }
+  }
+
+  // Change the limits, which are applied to the connections that are
+  // released afterward.
+  void setLimits(size_t maxNumIdleConnections, Clock::duration idleTimeout) {
+    auto lock = state_.wlock();
+    lock->maxNumIdleConnections_ = maxNumIdleConnections;
+    lock->idleTimeout_ = idleTimeout;
+  }
+
+  // Close all the idle connections.
+  void clear() {
+    std::deque<IdleConnection> idle;
+    std::swap(idle, state_.wlock()->idleConnections_);
+  }
+
+  // The number of idle connections in the pool.
+  size_t numIdleConnections() const {
+    return state_.rlock()->idleConnections_.size();
+  }
+};
+}  // namespace ad_utility::httpUtils
+
+#endif  // QLEVER_SRC_UTIL_HTTP_CONNECTIONPOOL_H
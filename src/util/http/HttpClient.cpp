@@ -7,6 +7,7 @@
 #ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
 #include "util/http/HttpClient.h"
 
+#include <absl/cleanup/cleanup.h>
 #include <absl/strings/str_cat.h>
 
 #include <boost/url/url.hpp>
@@ -14,6 +15,7 @@
 
 #include "global/Constants.h"
 #include "util/AsioHelpers.h"
+#include "util/AsyncStream.h"
 #include "util/TypeIdentity.h"
 #include "util/http/HttpUtils.h"
 #include "util/http/beast.h"
@@ -32,7 +34,8 @@ using ad_utility::httpUtils::Url;
 // ____________________________________________________________________________
 template <typename StreamType>
 HttpClientImpl<StreamType>::HttpClientImpl(std::string_view host,
-                                           std::string_view port) {
+                                           std::string_view port)
+    : poolKey_{poolKey(host, port)} {
   // IMPORTANT implementation note: Although we need only `stream_` later, it
   // is important that we also keep `io_context_` and `ssl_context_` alive.
   // Otherwise, we get a nasty and non-deterministic segmentation fault when
@@ -106,6 +109,7 @@ HttpOrHttpsResponse HttpClientImpl<StreamType>::sendRequest(
   request.set(http::field::accept, acceptHeader);
   request.set(http::field::content_type, contentTypeHeader);
   request.set(http::field::content_length, std::to_string(requestBody.size()));
+  request.keep_alive(true);
   request.body() = requestBody;
 
   auto wait = [&client, &handle](
@@ -134,33 +138,66 @@ HttpOrHttpsResponse HttpClientImpl<StreamType>::sendRequest(
       responseParser->get()[http::field::content_type];
   const std::string location = responseParser->get()[http::field::location];
 
-  auto getBody = [](std::unique_ptr<HttpClientImpl<StreamType>> client,
-                    std::unique_ptr<http::response_parser<http::buffer_body>>
-                        responseParser,
-                    beast::flat_buffer buffer,
-                    ad_utility::SharedCancellationHandle handle)
-      -> cppcoro::generator<ql::span<std::byte>> {
+  // Read the body in chunks (on the thread that iterates over the generator).
+  auto readChunks =
+      [](std::unique_ptr<HttpClientImpl<StreamType>> client,
+         std::unique_ptr<http::response_parser<http::buffer_body>>
+             responseParser,
+         beast::flat_buffer buffer, ad_utility::SharedCancellationHandle handle,
+         ad_utility::SharedCancellationHandle readAheadHandle)
+      -> cppcoro::generator<std::vector<std::byte>> {
     while (!responseParser->is_done()) {
-      std::array<std::byte, 4096> staticBuffer;
-      responseParser->get().body().data = staticBuffer.data();
-      responseParser->get().body().size = staticBuffer.size();
+      std::vector<std::byte> chunk(HTTP_CLIENT_BODY_CHUNK_SIZE);
+      responseParser->get().body().data = chunk.data();
+      responseParser->get().body().size = chunk.size();
       ad_utility::runAndWaitForAwaitable(
           ad_utility::interruptible(
-              http::async_read_some(*(client->stream_), buffer, *responseParser,
-                                    net::use_awaitable),
-              handle, AD_CURRENT_SOURCE_LOC()),
+              ad_utility::interruptible(
+                  http::async_read_some(*(client->stream_), buffer,
+                                        *responseParser, net::use_awaitable),
+                  handle, AD_CURRENT_SOURCE_LOC()),
+              readAheadHandle, AD_CURRENT_SOURCE_LOC()),
           client->ioContext_);
-      size_t remainingBytes = responseParser->get().body().size;
-      co_yield ql::span{staticBuffer}.first(staticBuffer.size() -
-                                            remainingBytes);
+      chunk.resize(chunk.size() - responseParser->get().body().size);
+      if (!chunk.empty()) {
+        co_yield chunk;
+      }
+    }
+    // The response has been read completely, so the connection can be used
+    // for another request.
+    if (responseParser->get().keep_alive()) {
+      std::string key = client->poolKey_;
+      connectionPool().release(std::move(key), std::move(client));
+    }
+  };
+
+  // The chunks are read ahead on a separate thread, s.t. the network transfer
+  // of a large body overlaps with its processing (e.g. the parsing of the
+  // result of a `SERVICE`) by the consumer. If the consumer stops early, the
+  // `readAheadHandle` aborts a read that is waiting for the server, s.t. the
+  // destruction of the body doesn't block until the next chunk arrives.
+  auto getBody = [](cppcoro::generator<std::vector<std::byte>> chunks,
+                    ad_utility::SharedCancellationHandle readAheadHandle)
+      -> cppcoro::generator<ql::span<std::byte>> {
+    auto chunksReadAhead = ad_utility::streams::runStreamAsync(
+        std::move(chunks), HTTP_CLIENT_NUM_BODY_CHUNKS_TO_READ_AHEAD);
+    absl::Cleanup abortReadAhead{[&readAheadHandle]() {
+      readAheadHandle->cancel(ad_utility::CancellationState::MANUAL);
+    }};
+    for (auto& chunk : chunksReadAhead) {
+      co_yield ql::span{chunk};
     }
   };
 
+  auto readAheadHandle = std::make_shared<ad_utility::CancellationHandle<>>();
   return {.status_ = status,
           .contentType_ = contentType,
           .location_ = location,
-          .body_ = getBody(std::move(client), std::move(responseParser),
-                           std::move(buffer), std::move(handle))};
+          .body_ = getBody(readChunks(std::move(client),
+                                      std::move(responseParser),
+                                      std::move(buffer), std::move(handle),
+                                      readAheadHandle),
+                           readAheadHandle)};
 }
 
 // ____________________________________________________________________________
@@ -195,6 +232,22 @@ HttpClientImpl<StreamType>::sendWebSocketHandshake(const http::verb& method,
   return response;
 }
 
+// ____________________________________________________________________________
+template <typename StreamType>
+ad_utility::httpUtils::ConnectionPool<HttpClientImpl<StreamType>>&
+HttpClientImpl<StreamType>::connectionPool() {
+  static ad_utility::httpUtils::ConnectionPool<HttpClientImpl> pool{
+      HTTP_CLIENT_MAX_NUM_IDLE_CONNECTIONS, HTTP_CLIENT_IDLE_TIMEOUT};
+  return pool;
+}
+
+// ____________________________________________________________________________
+template <typename StreamType>
+std::string HttpClientImpl<StreamType>::poolKey(std::string_view host,
+                                                std::string_view port) {
+  return absl::StrCat(host, ":", port);
+}
+
 // Explicit instantiations for HTTP and HTTPS, see the bottom of
 // `HttpClient.h`.
 template class HttpClientImpl<beast::tcp_stream>;
@@ -209,11 +262,23 @@ HttpOrHttpsResponse sendHttpOrHttpsRequest(
   auto sendRequest = [&](const Url& currentUrl,
                          auto ti) -> HttpOrHttpsResponse {
     using Client = typename decltype(ti)::type;
-    auto client =
-        std::make_unique<Client>(currentUrl.host(), currentUrl.port());
-    return Client::sendRequest(std::move(client), method, currentUrl.host(),
-                               currentUrl.target(), handle, requestData,
-                               contentTypeHeader, acceptHeader);
+    auto send = [&](std::unique_ptr<Client> client) {
+      return Client::sendRequest(std::move(client), method, currentUrl.host(),
+                                 currentUrl.target(), handle, requestData,
+                                 contentTypeHeader, acceptHeader);
+    };
+    auto pooledClient = Client::connectionPool().acquire(
+        Client::poolKey(currentUrl.host(), currentUrl.port()));
+    if (pooledClient != nullptr) {
+      // The server might have closed the idle connection in the meantime, in
+      // which case we retry with a new connection. Other errors (e.g. the
+      // cancellation) are propagated.
+      try {
+        return send(std::move(pooledClient));
+      } catch (const boost::system::system_error&) {
+      }
+    }
+    return send(std::make_unique<Client>(currentUrl.host(), currentUrl.port()));
   };
 
   using namespace ad_utility::use_type_identity;
@@ -22,6 +22,7 @@
 #include "backports/span.h"
 #include "util/CancellationHandle.h"
 #include "util/Generator.h"
+#include "util/http/ConnectionPool.h"
 #include "util/http/HttpUtils.h"
 #include "util/http/beast.h"
 
@@ -68,9 +69,10 @@ class HttpClientImpl {
   // Send a request (the first argument must be either `http::verb::get` or
   // `http::verb::post`) and return the status and content-type as
   // well as the body of the response (possibly very large) as an
-  // `cppcoro::generator<ql::span<std::byte>>`. The connection can be used
-  // for only one request, as the client is moved to the content yielding
-  // coroutine.
+  // `cppcoro::generator<ql::span<std::byte>>`. The client is moved to the
+  // content yielding coroutine. When the complete body has been read and the
+  // server keeps the connection alive, the client is added to the
+  // `connectionPool()`, from which it can be reused for later requests.
   static HttpOrHttpsResponse sendRequest(
       std::unique_ptr<HttpClientImpl> client,
       const boost::beast::http::verb& method, std::string_view host,
@@ -84,7 +86,17 @@ class HttpClientImpl {
   sendWebSocketHandshake(const boost::beast::http::verb& method,
                          std::string_view host, std::string_view target);
 
+  // The process-wide pool of idle connections of this type (HTTP or HTTPS).
+  static ad_utility::httpUtils::ConnectionPool<HttpClientImpl>&
+  connectionPool();
+
+  // The key of the connections to the given host and port in the
+  // `connectionPool()`.
+  static std::string poolKey(std::string_view host, std::string_view port);
+
  private:
+  std::string poolKey_;
+
   // The connection stream and associated objects. See the implementation of
   // `openStream` for why we need all of them, and not just `stream_`.
   boost::asio::io_context ioContext_;
@@ -114,7 +126,8 @@ using SendRequestType = std::function<HttpOrHttpsResponse(
 
 // Global convenience function for sending a request (default: GET) to the given
 // URL and obtaining the result as a `cppcoro::generator<ql::span<std::byte>>`.
-// The protocol (HTTP or HTTPS) is chosen automatically based on the URL. The
+// The protocol (HTTP or HTTPS) is chosen automatically based on the URL. An
+// idle connection from the `connectionPool()` is used if possible. The
 // `requestBody` is the payload sent for POST requests (default: empty). If
 // `maxRedirects` is greater than 0, the function will automatically follow
 // redirects (301, 302, 307, 308) up to the specified limit.
@@ -6,11 +6,15 @@
 #ifndef QLEVER_HTTPSERVER_H
 #define QLEVER_HTTPSERVER_H
 
+#include <absl/cleanup/cleanup.h>
+
 #include <cstdlib>
 #include <future>
+#include <memory>
 
 #include "util/Exception.h"
 #include "util/Log.h"
+#include "util/http/ClientConnection.h"
 #include "util/http/HttpUtils.h"
 #include "util/http/beast.h"
 #include "util/http/websocket/WebSocketSession.h"
@@ -42,6 +46,10 @@ ad_utility::MemorySize getRequestBodyLimit();
  * http::message is templated on the body type). For this reason, this approach
  * is more flexible, than having httpHandler_ simply return the response.
  *
+ * The HttpHandler may optionally take a third parameter, a
+ * `std::shared_ptr<ClientConnection>`, which is closed when the client closes
+ * the connection while the request is handled (see `ClientConnection.h`).
+ *
  * A very basic HttpHandler, which simply serves files from a directory, can be
  * obtained via `ad_utility::httpUtils::makeFileServer()`.
  *
@@ -56,6 +64,7 @@ CPP_template(typename HttpHandler, typename WebSocketHandler)(
         const http::request<http::string_body>&,
         tcp::socket>) class HttpServer {
  private:
+  using ClientConnection = ad_utility::httpUtils::ClientConnection;
   HttpHandler httpHandler_;
   int numServerThreads_;
   net::io_context ioContext_;
@@ -210,6 +219,28 @@ CPP_template(typename HttpHandler, typename WebSocketHandler)(
     }
   }
 
+  // Close the `connection` if the client closes the `socket`, until the
+  // waiting is cancelled. Note: If the client sends another (pipelined)
+  // request before the current one has been handled, a close of the
+  // connection can no longer be detected (without reading that request), so
+  // the watching stops in this case.
+  static boost::asio::awaitable<void> watchForClose(
+      tcp::socket& socket, std::shared_ptr<ClientConnection> connection) {
+    beast::error_code ec;
+    co_await socket.async_wait(tcp::socket::wait_read,
+                               net::redirect_error(net::use_awaitable, ec));
+    if (ec) {
+      // The waiting was cancelled, the `socket` must not be used anymore.
+      co_return;
+    }
+    char byte;
+    size_t numBytes = socket.receive(net::buffer(&byte, 1),
+                                     tcp::socket::message_peek, ec);
+    if (ec || numBytes == 0) {
+      connection->close();
+    }
+  }
+
   // This coroutine handles a single http session which is represented by a
   // socket.
   boost::asio::awaitable<void> session(tcp::socket socket) {
@@ -285,7 +316,25 @@ CPP_template(typename HttpHandler, typename WebSocketHandler)(
 
           // Handle the http request. Note that `httpHandler_` is also
           // responsible for sending the message via the `sendMessage` lambda.
-          co_await httpHandler_(std::move(req), sendMessage);
+          if constexpr (std::is_invocable_v<
+                            HttpHandler&, http::request<http::string_body>,
+                            decltype(sendMessage)&,
+                            std::shared_ptr<ClientConnection>>) {
+            auto connection = std::make_shared<ClientConnection>();
+            net::co_spawn(co_await net::this_coro::executor,
+                          watchForClose(stream.socket(), connection),
+                          net::detached);
+            // Stop the watching when the request has been handled (also if
+            // the handler throws).
+            absl::Cleanup stopWatching{[&stream]() {
+              [[maybe_unused]] beast::error_code ec;
+              stream.socket().cancel(ec);
+            }};
+            co_await httpHandler_(std::move(req), sendMessage,
+                                  std::move(connection));
+          } else {
+            co_await httpHandler_(std::move(req), sendMessage);
+          }
         }
 
         // The closing of the stream is done in the exception handler.
@@ -7,11 +7,20 @@
 
 #include <ctre-unicode.hpp>
 
+#include "global/RuntimeParameters.h"
+
 // TODO: Which other implementations that are currently still in `HttpUtils.h`
 // should we move here, to `HttpUtils.cpp`?
 
 namespace ad_utility::httpUtils {
 
+// ____________________________________________________________________________
+size_t getResponseCompressionNumThreads() {
+  size_t numThreads =
+      getRuntimeParameter<&RuntimeParameters::responseCompressionNumThreads_>();
+  return std::max(size_t{1}, numThreads);
+}
+
 // The regex for parsing the components of a URL. We need it also as a string
 // (for error messaging) and CTRE has no function for printing a regex as
 // a string, hence the two variables.
@@ -93,6 +93,12 @@ static constexpr bool isHttpRequest<http::request<Body, Fields>> = true;
 template <typename T>
 CPP_concept HttpRequest = detail::isHttpRequest<T>;
 
+// The number of threads for the compression of a response, see the runtime
+// parameter `response-compression-num-threads`. Including the
+// `RuntimeParameters` header is expensive, so this is defined in the
+// implementation file.
+size_t getResponseCompressionNumThreads();
+
 // The response type used for almost all cases. Only when there is an error
 // parsing the request, then another response type is used.
 using ResponseT = http::response<streamable_body>;
@@ -111,16 +117,21 @@ CPP_template(typename RequestType)(
   CompressionMethod method =
       ad_utility::content_encoding::getCompressionMethodForRequest(request);
 
-  auto asyncGenerator = streams::runStreamAsync(std::move(generator), 100);
-  auto coroAsyncGenerator = [](auto range) -> cppcoro::generator<std::string> {
+  auto toGenerator = [](auto range) -> cppcoro::generator<std::string> {
     for (auto& value : range) {
       co_yield value;
     }
-  }(std::move(asyncGenerator));
+  };
+  auto coroAsyncGenerator =
+      toGenerator(streams::runStreamAsync(std::move(generator), 100));
 
   if (method != CompressionMethod::NONE) {
-    response.body() =
-        streams::compressStream(std::move(coroAsyncGenerator), method);
+    // Compress the chunks in separate threads, s.t. the compression neither
+    // blocks the thread that writes the response nor the one that computes
+    // the chunks.
+    response.body() = streams::compressStreamInParallel(
+        std::move(coroAsyncGenerator), method,
+        getResponseCompressionNumThreads());
     ad_utility::content_encoding::setContentEncodingHeaderForCompressionMethod(
         method, response);
   } else {
@@ -21,8 +21,8 @@ using enum MediaType;
 // specified in the request. It's "application/sparql-results+json", as
 // required by the SPARQL standard.
 constexpr std::array SUPPORTED_MEDIA_TYPES{
-    sparqlJson, sparqlXml,   qleverJson,        tsv, csv, turtle,
-    ntriples,   octetStream, binaryQleverExport};
+    sparqlJson, sparqlXml,   qleverJson,         tsv,        csv, turtle,
+    ntriples,   octetStream, binaryQleverExport, arrowStream};
 
 // _____________________________________________________________
 const ad_utility::HashMap<MediaType, MediaTypeImpl>& getAllMediaTypes() {
@@ -47,6 +47,7 @@ const ad_utility::HashMap<MediaType, MediaTypeImpl>& getAllMediaTypes() {
     add(ntriples, "application", "n-triples", {".nt"});
     add(octetStream, "application", "octet-stream", {});
     add(binaryQleverExport, "application", "qlever-export+octet-stream", {});
+    add(arrowStream, "application", "vnd.apache.arrow.stream", {".arrows"});
     return t;
   }();
   return types;
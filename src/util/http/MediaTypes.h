@@ -31,7 +31,8 @@ enum class MediaType {
   turtle,
   ntriples,
   octetStream,
-  binaryQleverExport
+  binaryQleverExport,
+  arrowStream
 };
 
 struct MediaTypeWithQuality {
@@ -10,6 +10,7 @@
 
 #include "util/Generator.h"
 #include "util/Log.h"
+#include "util/StringBufferPool.h"
 #include "util/http/beast.h"
 
 namespace ad_utility::httpUtils::httpStreams {
@@ -75,6 +76,9 @@ class streamable_body::writer {
          value_type& generator)
       : _generator{generator} {}
 
+  // Return the buffer of the last chunk to the pool.
+  ~writer() { recycleStorage(); }
+
   /**
    * This is called before the body is serialized and
    * gives the writer a chance to do something that might
@@ -114,6 +118,9 @@ class streamable_body::writer {
       } else {
         _iterator++;
       }
+      // The previous buffer has been consumed by the serializer, so it can be
+      // reused by the producer of the chunks.
+      recycleStorage();
       if (_iterator == _generator.end()) {
         return boost::none;
       }
@@ -128,6 +135,13 @@ class streamable_body::writer {
       return boost::none;
     }
   }
+
+ private:
+  // Move the `_storage` to the `httpResponseBufferPool`.
+  void recycleStorage() {
+    streams::httpResponseBufferPool().put(std::move(_storage));
+    _storage = {};
+  }
 };
 
 static_assert(boost::beast::http::is_body<streamable_body>::value,
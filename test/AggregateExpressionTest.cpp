@@ -14,6 +14,7 @@
 #include "backports/type_traits.h"
 #include "engine/ValuesForTesting.h"
 #include "engine/sparqlExpressions/AggregateExpression.h"
+#include "engine/sparqlExpressions/ApproxCountDistinctExpression.h"
 #include "engine/sparqlExpressions/CountStarExpression.h"
 #include "engine/sparqlExpressions/SampleExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionTypes.h"
@@ -94,6 +95,63 @@ TEST(AggregateExpression, count) {
   testCountString({lit("alpha"), lit("äpfel"), lit(""), lit("unfug")}, I(4));
 }
 
+// Test `ApproxCountDistinctExpression`.
+TEST(AggregateExpression, approxCountDistinct) {
+  // Small inputs are counted exactly, UNDEF values are ignored.
+  auto testApproxId = testAggregate<ApproxCountDistinctExpression, Id>;
+  testApproxId({D(2), D(2), I(2), V(17), U}, I(3));
+  testApproxId({}, I(0));
+  auto testApproxString =
+      testAggregate<ApproxCountDistinctExpression, IdOrLiteralOrIri, Id>;
+  testApproxString({lit("alpha"), lit("beta"), lit("alpha")}, I(2));
+
+  // A large input with 50'000 distinct values. The relative standard error is
+  // below 1%, we allow for five times that.
+  EXPECT_LT(ApproxCountDistinctExpression::relativeStandardError(), 0.01);
+  TestContext t;
+  VectorWithMemoryLimit<Id> input(makeAllocator());
+  for (int64_t i = 0; i < 100'000; ++i) {
+    input.push_back(I(i % 50'000));
+  }
+  t.context._endIndex = input.size();
+  ApproxCountDistinctExpression expression{
+      false, std::make_unique<SingleUseExpression>(std::move(input))};
+  auto result = std::get<Id>(expression.evaluate(&t.context));
+  EXPECT_NEAR(result.getInt(), 50'000, 2'500);
+  EXPECT_EQ(expression.isAggregate(),
+            SparqlExpression::AggregateStatus::NonDistinctAggregate);
+}
+
+// Test the merging of `DistinctCountSketch`es, which is used by the hash map
+// optimization of GROUP BY.
+TEST(AggregateExpression, distinctCountSketchMerge) {
+  using sparqlExpression::detail::DistinctCountSketch;
+  auto makeSketch = [](int64_t begin, int64_t end) {
+    DistinctCountSketch sketch;
+    for (int64_t i = begin; i < end; ++i) {
+      sketch.add(I(i));
+    }
+    return sketch;
+  };
+  // Two small sketches stay exact.
+  auto a = makeSketch(0, 100);
+  a.mergeWith(makeSketch(50, 150));
+  EXPECT_TRUE(a.isExact());
+  EXPECT_EQ(a.estimate(), 150);
+
+  // A small and a large sketch, in both orders.
+  auto large = makeSketch(0, 20'000);
+  EXPECT_FALSE(large.isExact());
+  auto small = makeSketch(19'900, 20'100);
+  auto smallThenLarge = small;
+  smallThenLarge.mergeWith(large);
+  auto largeThenSmall = large;
+  largeThenSmall.mergeWith(small);
+  EXPECT_FALSE(smallThenLarge.isExact());
+  EXPECT_EQ(smallThenLarge.estimate(), largeThenSmall.estimate());
+  EXPECT_NEAR(smallThenLarge.estimate(), 20'100, 1'000);
+}
+
 // Test the behavior of COUNT for variables.
 TEST(AggregateExpression, countForVariables) {
   auto testCount = testAggregateWithVariable<CountExpression, Id>;
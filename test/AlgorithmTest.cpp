@@ -244,3 +244,23 @@ TEST(AlgorithmTest, lowerUpperBoundIterator) {
               ql::ranges::upper_bound(input, value));
   }
 }
+
+// _____________________________________________________________________________
+TEST(AlgorithmTest, gallopingPartitionPoint) {
+  std::vector<size_t> input(1000);
+  std::iota(input.begin(), input.end(), 0);
+  for (size_t threshold : {0, 1, 2, 3, 17, 64, 999, 1000, 2000}) {
+    auto pred = [threshold](size_t value) { return value < threshold; };
+    EXPECT_EQ(ad_utility::gallopingPartitionPoint(input.begin(), input.end(),
+                                                  pred),
+              ql::ranges::partition_point(input, pred));
+    // Start in the middle of the range.
+    auto begin = input.begin() + std::min<size_t>(threshold / 2, 1000);
+    EXPECT_EQ(ad_utility::gallopingPartitionPoint(begin, input.end(), pred),
+              std::partition_point(begin, input.end(), pred));
+  }
+  std::vector<size_t> empty;
+  EXPECT_EQ(ad_utility::gallopingPartitionPoint(
+                empty.begin(), empty.end(), [](size_t) { return true; }),
+            empty.end());
+}
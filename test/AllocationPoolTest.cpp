@@ -0,0 +1,107 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gtest/gtest.h>
+
+#include "util/AllocationPool.h"
+#include "util/AllocatorWithLimit.h"
+
+using ad_utility::AllocationPool;
+using ad_utility::MemorySize;
+using namespace ad_utility::memory_literals;
+
+namespace {
+// The blocks in these tests are not real allocations, so the deallocation only
+// counts the freed bytes.
+size_t numDeallocatedBytes = 0;
+void countDeallocation(void*, size_t numBytes) {
+  numDeallocatedBytes += numBytes;
+}
+
+// Return a (fake) pointer for the tests.
+void* fakePointer(uintptr_t i) { return reinterpret_cast<void*>(i * 64); }
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(AllocationPool, getAndPut) {
+  numDeallocatedBytes = 0;
+  {
+    AllocationPool pool{&countDeallocation, 100_B};
+    EXPECT_EQ(pool.get(10), nullptr);
+    EXPECT_TRUE(pool.put(fakePointer(1), 10));
+    EXPECT_TRUE(pool.put(fakePointer(2), 10));
+    EXPECT_TRUE(pool.put(fakePointer(3), 20));
+    EXPECT_EQ(pool.size(), 40_B);
+
+    // Only blocks with exactly the same size are reused.
+    EXPECT_EQ(pool.get(15), nullptr);
+    EXPECT_EQ(pool.get(10), fakePointer(2));
+    EXPECT_EQ(pool.get(10), fakePointer(1));
+    EXPECT_EQ(pool.get(10), nullptr);
+    EXPECT_EQ(pool.size(), 20_B);
+    EXPECT_EQ(numDeallocatedBytes, 0u);
+
+    // Blocks that are larger than the pool are never added.
+    EXPECT_FALSE(pool.put(fakePointer(4), 101));
+  }
+  // The destructor frees the remaining block.
+  EXPECT_EQ(numDeallocatedBytes, 20u);
+}
+
+// _____________________________________________________________________________
+TEST(AllocationPool, eviction) {
+  numDeallocatedBytes = 0;
+  AllocationPool pool{&countDeallocation, 100_B};
+  EXPECT_TRUE(pool.put(fakePointer(1), 40));
+  EXPECT_TRUE(pool.put(fakePointer(2), 40));
+  // To make room for a block of a different size, the other blocks are freed.
+  EXPECT_TRUE(pool.put(fakePointer(3), 30));
+  EXPECT_EQ(numDeallocatedBytes, 40u);
+  EXPECT_EQ(pool.size(), 70_B);
+  EXPECT_EQ(pool.get(40), fakePointer(1));
+  EXPECT_TRUE(pool.put(fakePointer(4), 30));
+  EXPECT_TRUE(pool.put(fakePointer(5), 30));
+  EXPECT_EQ(pool.size(), 90_B);
+  // Blocks of the same size are not evicted, so this block doesn't fit.
+  EXPECT_FALSE(pool.put(fakePointer(6), 30));
+  EXPECT_EQ(numDeallocatedBytes, 40u);
+  EXPECT_EQ(pool.size(), 90_B);
+
+  // Shrinking the pool frees all the blocks, a size of zero disables it.
+  pool.setMaxSize(50_B);
+  EXPECT_EQ(numDeallocatedBytes, 130u);
+  EXPECT_EQ(pool.size(), 0_B);
+  pool.setMaxSize(0_B);
+  EXPECT_FALSE(pool.put(fakePointer(7), 1));
+  EXPECT_EQ(pool.get(1), nullptr);
+}
+
+// _____________________________________________________________________________
+TEST(AllocationPool, reuseByAllocatorWithLimit) {
+  auto& pool = ad_utility::detail::allocationPool();
+  pool.setMaxSize(0_B);
+  pool.setMaxSize(16_MB);
+  auto allocator = ad_utility::makeAllocatorWithLimit<uint64_t>(10_MB);
+  // Large allocations are returned to the pool and reused.
+  size_t n = 2 * ad_utility::detail::MIN_POOLED_ALLOCATION_SIZE;
+  auto* ptr = allocator.allocate(n);
+  allocator.deallocate(ptr, n);
+  EXPECT_EQ(pool.size(), MemorySize::bytes(n * sizeof(uint64_t)));
+  EXPECT_EQ(allocator.amountMemoryLeft(), 10_MB);
+  EXPECT_EQ(allocator.allocate(n), ptr);
+  EXPECT_EQ(pool.size(), 0_B);
+  allocator.deallocate(ptr, n);
+
+  // Small allocations are not pooled.
+  auto* small = allocator.allocate(10);
+  allocator.deallocate(small, 10);
+  EXPECT_EQ(pool.size(), MemorySize::bytes(n * sizeof(uint64_t)));
+  pool.setMaxSize(0_B);
+  EXPECT_EQ(pool.size(), 0_B);
+}
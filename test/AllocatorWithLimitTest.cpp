@@ -105,3 +105,95 @@ TEST(AllocatorWithLimit, unlikelyExceptionsDuringCopyingAndMoving) {
   ASSERT_DEATH_IF_SUPPORTED(
       moveAssign(), "The move assignment operator of `AllocatorWithLimit`");
 }
+
+TEST(AllocatorWithLimit, largeAllocationsAreAlignedToHugePages) {
+  using ad_utility::detail::HUGE_PAGE_SIZE;
+  for (bool useHugePages : {false, true}) {
+    ad_utility::setUseTransparentHugePages(useHugePages);
+    AllocatorWithLimit<int> all{
+        ad_utility::makeAllocationMemoryLeftThreadsafeObject(10_MB)};
+    // A large allocation is aligned and counts towards the limit.
+    size_t numInts = 3 * HUGE_PAGE_SIZE / sizeof(int) + 17;
+    auto ptr = all.allocate(numInts);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % HUGE_PAGE_SIZE, 0u);
+    EXPECT_EQ(all.amountMemoryLeft(),
+              10_MB - ad_utility::MemorySize::bytes(numInts * sizeof(int)));
+    std::fill(ptr, ptr + numInts, 42);
+    EXPECT_EQ(ptr[numInts - 1], 42);
+    all.deallocate(ptr, numInts);
+    EXPECT_EQ(all.amountMemoryLeft(), 10_MB);
+
+    // Small allocations use the default allocator.
+    V v{all};
+    v.push_back(5);
+    EXPECT_EQ(v[0], 5);
+  }
+  ad_utility::setUseTransparentHugePages(false);
+}
+
+TEST(AllocatorWithLimit, peakMemoryUsageMeasurement) {
+  auto memoryLeft = ad_utility::makeAllocationMemoryLeftThreadsafeObject(1_MB);
+  AllocatorWithLimit<char> all{memoryLeft};
+  auto before = all.allocate(100);
+  ad_utility::PeakMemoryUsageMeasurement outer{memoryLeft};
+  auto first = all.allocate(300);
+  all.deallocate(first, 300);
+  {
+    // The inner measurement only sees its own peak.
+    ad_utility::PeakMemoryUsageMeasurement inner{memoryLeft};
+    auto second = all.allocate(200);
+    all.deallocate(second, 200);
+    EXPECT_EQ(inner.stop(), ad_utility::MemorySize::bytes(200));
+  }
+  // The peak of the outer measurement includes the inner measurement, but not
+  // the memory that was allocated before its start.
+  auto third = all.allocate(50);
+  EXPECT_EQ(outer.stop(), ad_utility::MemorySize::bytes(300));
+  all.deallocate(third, 50);
+  all.deallocate(before, 100);
+
+  // Without allocations, the peak is zero.
+  ad_utility::PeakMemoryUsageMeasurement empty{memoryLeft};
+  EXPECT_EQ(empty.stop(), ad_utility::MemorySize::bytes(0));
+}
+
+TEST(AllocatorWithLimit, childLimit) {
+  using ad_utility::MemorySize;
+  auto parent = ad_utility::makeAllocationMemoryLeftThreadsafeObject(1_kB);
+  auto child = ad_utility::makeChildAllocationMemoryLeftThreadsafeObject(
+      parent, MemorySize::bytes(600));
+  AllocatorWithLimit<char> parentAll{parent};
+  AllocatorWithLimit<char> childAll{child};
+  EXPECT_NE(parentAll, childAll);
+
+  // Allocations of the child count towards both limits.
+  auto first = childAll.allocate(500);
+  EXPECT_EQ(childAll.amountMemoryLeft(), MemorySize::bytes(100));
+  EXPECT_EQ(parentAll.amountMemoryLeft(), MemorySize::bytes(500));
+
+  // The limit of the child is exceeded.
+  using ad_utility::detail::AllocationExceedsLimitException;
+  EXPECT_THROW(childAll.allocate(200), AllocationExceedsLimitException);
+  EXPECT_EQ(parentAll.amountMemoryLeft(), MemorySize::bytes(500));
+
+  // The limit of the parent is exceeded, then the child limit is unchanged.
+  auto second = parentAll.allocate(450);
+  EXPECT_EQ(childAll.amountMemoryLeft(), MemorySize::bytes(50));
+  EXPECT_THROW(childAll.allocate(80), AllocationExceedsLimitException);
+  EXPECT_EQ(child.ptr()->wlock()->amountMemoryLeft(), MemorySize::bytes(100));
+  parentAll.deallocate(second, 450);
+
+  // Deallocations of the child are returned to both limits.
+  childAll.deallocate(first, 500);
+  EXPECT_EQ(childAll.amountMemoryLeft(), MemorySize::bytes(600));
+  EXPECT_EQ(parentAll.amountMemoryLeft(), 1_kB);
+
+  // The peak of a measurement on the child only contains the allocations of
+  // the child.
+  ad_utility::PeakMemoryUsageMeasurement measurement{child};
+  auto third = parentAll.allocate(300);
+  auto fourth = childAll.allocate(100);
+  childAll.deallocate(fourth, 100);
+  parentAll.deallocate(third, 300);
+  EXPECT_EQ(measurement.stop(), MemorySize::bytes(100));
+}
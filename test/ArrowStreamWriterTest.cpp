@@ -0,0 +1,224 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+
+#include <cstring>
+
+#include "engine/ArrowStreamWriter.h"
+
+using namespace qlever::arrowExport;
+using ::testing::ElementsAre;
+using ::testing::Optional;
+
+namespace {
+
+template <typename T>
+T read(std::string_view bytes, size_t position) {
+  EXPECT_LE(position + sizeof(T), bytes.size());
+  EXPECT_EQ(position % sizeof(T), 0u);
+  T result;
+  std::memcpy(&result, bytes.data() + position, sizeof(T));
+  return result;
+}
+
+// A minimal reader for the FlatBuffer tables that are written by the
+// `ArrowStreamWriter`, to check the written metadata.
+struct Table {
+  std::string_view buffer_;
+  size_t position_;
+
+  // Return the table at the root of the `buffer`.
+  static Table root(std::string_view buffer) {
+    return {buffer, read<uint32_t>(buffer, 0)};
+  }
+
+  // Return the position of the field in `slot`, or zero if it is absent.
+  size_t fieldPosition(size_t slot) const {
+    auto vtable = position_ - read<int32_t>(buffer_, position_);
+    auto vtableSize = read<uint16_t>(buffer_, vtable);
+    if (4 + 2 * slot >= vtableSize) {
+      return 0;
+    }
+    auto offset = read<uint16_t>(buffer_, vtable + 4 + 2 * slot);
+    return offset == 0 ? 0 : position_ + offset;
+  }
+  template <typename T>
+  T scalar(size_t slot) const {
+    auto position = fieldPosition(slot);
+    return position == 0 ? T{0} : read<T>(buffer_, position);
+  }
+  size_t target(size_t slot) const {
+    auto position = fieldPosition(slot);
+    EXPECT_NE(position, 0u);
+    return position + read<uint32_t>(buffer_, position);
+  }
+  Table table(size_t slot) const { return {buffer_, target(slot)}; }
+  size_t vectorSize(size_t slot) const {
+    return read<uint32_t>(buffer_, target(slot));
+  }
+  Table tableInVector(size_t slot, size_t i) const {
+    size_t position = target(slot) + 4 + 4 * i;
+    return {buffer_, position + read<uint32_t>(buffer_, position)};
+  }
+  std::string_view string(size_t slot) const {
+    return buffer_.substr(target(slot) + 4, vectorSize(slot));
+  }
+  std::pair<int64_t, int64_t> pairInVector(size_t slot, size_t i) const {
+    size_t position = target(slot) + 4 + 16 * i;
+    return {read<int64_t>(buffer_, position),
+            read<int64_t>(buffer_, position + 8)};
+  }
+};
+
+// An encapsulated message of an Arrow stream.
+struct Message {
+  std::string metadata_;
+  std::string body_;
+  Table message() const { return Table::root(metadata_); }
+};
+
+// Split the `stream` into its messages and check that it ends with the
+// end-of-stream marker.
+std::vector<Message> splitMessages(std::string_view stream) {
+  std::vector<Message> result;
+  size_t position = 0;
+  while (true) {
+    EXPECT_EQ(read<uint32_t>(stream, position), 0xFFFFFFFF);
+    auto metadataSize = read<int32_t>(stream, position + 4);
+    position += 8;
+    if (metadataSize == 0) {
+      EXPECT_EQ(position, stream.size());
+      return result;
+    }
+    EXPECT_EQ(metadataSize % 8, 0);
+    Message message;
+    message.metadata_ = stream.substr(position, metadataSize);
+    position += metadataSize;
+    auto bodyLength = message.message().scalar<int64_t>(3);
+    EXPECT_EQ(bodyLength % 8, 0);
+    message.body_ = stream.substr(position, bodyLength);
+    position += bodyLength;
+    result.push_back(std::move(message));
+  }
+}
+
+// Decode the `Utf8` column with the given index from a record batch message.
+std::vector<std::optional<std::string>> decodeColumn(const Message& message,
+                                                     size_t column) {
+  auto recordBatch = message.message().table(2);
+  auto numRows = recordBatch.scalar<int64_t>(0);
+  auto [length, nullCount] = recordBatch.pairInVector(1, column);
+  EXPECT_EQ(length, numRows);
+  auto [validityOffset, validityLength] =
+      recordBatch.pairInVector(2, 3 * column);
+  auto offsetsOffset = recordBatch.pairInVector(2, 3 * column + 1).first;
+  auto dataOffset = recordBatch.pairInVector(2, 3 * column + 2).first;
+  EXPECT_EQ(validityLength == 0, nullCount == 0);
+  std::string_view body = message.body_;
+  std::vector<std::optional<std::string>> result;
+  int64_t numNulls = 0;
+  for (int64_t i = 0; i < numRows; ++i) {
+    bool isValid =
+        validityLength == 0 ||
+        (static_cast<uint8_t>(body[validityOffset + i / 8]) >> (i % 8)) & 1;
+    auto begin = read<int32_t>(body, offsetsOffset + 4 * i);
+    auto end = read<int32_t>(body, offsetsOffset + 4 * (i + 1));
+    if (isValid) {
+      result.emplace_back(body.substr(dataOffset + begin, end - begin));
+    } else {
+      EXPECT_EQ(begin, end);
+      result.emplace_back(std::nullopt);
+      ++numNulls;
+    }
+  }
+  EXPECT_EQ(numNulls, nullCount);
+  return result;
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ArrowStreamWriter, schema) {
+  auto messages = splitMessages(makeSchemaMessage({"x", "name"}) +
+                                makeEndOfStreamMarker());
+  ASSERT_EQ(messages.size(), 1u);
+  auto message = messages[0].message();
+  // Version V5, the header is a schema.
+  EXPECT_EQ(message.scalar<int16_t>(0), 4);
+  EXPECT_EQ(message.scalar<uint8_t>(1), 1);
+  EXPECT_TRUE(messages[0].body_.empty());
+  auto schema = message.table(2);
+  ASSERT_EQ(schema.vectorSize(1), 2u);
+  std::vector<std::string_view> names;
+  for (size_t i = 0; i < 2; ++i) {
+    auto field = schema.tableInVector(1, i);
+    names.push_back(field.string(0));
+    // Nullable, the type is `Utf8`, and there are no children.
+    EXPECT_EQ(field.scalar<uint8_t>(1), 1);
+    EXPECT_EQ(field.scalar<uint8_t>(2), 5);
+    EXPECT_EQ(field.vectorSize(5), 0u);
+  }
+  EXPECT_THAT(names, ElementsAre("x", "name"));
+}
+
+// _____________________________________________________________________________
+TEST(ArrowStreamWriter, recordBatches) {
+  RecordBatchBuilder builder{2};
+  builder.addValue("<a>");
+  builder.addValue(std::nullopt);
+  builder.finishRow();
+  builder.addValue("42");
+  builder.addValue("\"hello\"@en");
+  builder.finishRow();
+  // Enough rows for a validity bitmap with more than one byte.
+  for (size_t i = 0; i < 9; ++i) {
+    builder.addValue("");
+    builder.addValue(std::to_string(i));
+    builder.finishRow();
+  }
+  EXPECT_EQ(builder.numRows(), 11u);
+  auto stream = makeSchemaMessage({"a", "b"}) + builder.finish() +
+                RecordBatchBuilder{2}.finish() + makeEndOfStreamMarker();
+
+  auto messages = splitMessages(stream);
+  ASSERT_EQ(messages.size(), 3u);
+  auto recordBatch = messages[1].message();
+  EXPECT_EQ(recordBatch.scalar<uint8_t>(1), 3);
+  EXPECT_EQ(recordBatch.table(2).scalar<int64_t>(0), 11);
+
+  std::vector<std::optional<std::string>> expectedA{"<a>", "42"};
+  expectedA.resize(11, "");
+  EXPECT_EQ(decodeColumn(messages[1], 0), expectedA);
+  auto columnB = decodeColumn(messages[1], 1);
+  ASSERT_EQ(columnB.size(), 11u);
+  EXPECT_EQ(columnB[0], std::nullopt);
+  EXPECT_THAT(columnB[1], Optional(std::string{"\"hello\"@en"}));
+  EXPECT_THAT(columnB[10], Optional(std::string{"8"}));
+
+  // An empty record batch.
+  EXPECT_EQ(messages[2].message().table(2).scalar<int64_t>(0), 0);
+  EXPECT_TRUE(decodeColumn(messages[2], 0).empty());
+}
+
+// _____________________________________________________________________________
+TEST(ArrowStreamWriter, incompleteRows) {
+  RecordBatchBuilder builder{2};
+  builder.addValue("a");
+  EXPECT_ANY_THROW(builder.finishRow());
+  EXPECT_ANY_THROW(builder.finish());
+  builder.addValue("b");
+  EXPECT_ANY_THROW(builder.addValue("c"));
+  builder.finishRow();
+  EXPECT_EQ(builder.numRows(), 1u);
+  EXPECT_NO_THROW(builder.finish());
+
+  // Without columns, only the number of rows is stored.
+  RecordBatchBuilder noColumns{0};
+  EXPECT_ANY_THROW(noColumns.addValue("a"));
+  noColumns.finishRow();
+  noColumns.finishRow();
+  auto messages = splitMessages(noColumns.finish() + makeEndOfStreamMarker());
+  ASSERT_EQ(messages.size(), 1u);
+  EXPECT_EQ(messages[0].message().table(2).scalar<int64_t>(0), 2);
+}
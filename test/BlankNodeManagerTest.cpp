@@ -10,6 +10,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include "gmock/gmock.h"
 #include "util/BlankNodeManager.h"
 #include "util/GTestHelpers.h"
@@ -119,12 +121,17 @@ class BlankNodeManagerTestFixture : public ::testing::Test {
 
   // Helper to get the number of used blocks.
   static size_t getUsedBlockCount(const BlankNodeManager& bnm) {
-    return bnm.state_.rlock()->usedBlocksSet_.size();
+    size_t numBlocks = 0;
+    for (const auto& shard : bnm.shards_) {
+      numBlocks += shard.rlock()->usedBlocksSet_.size();
+    }
+    EXPECT_EQ(numBlocks, bnm.numBlocksUsed());
+    return numBlocks;
   }
 
   // Helper to check if a specific block index is used.
   static bool isBlockUsed(const BlankNodeManager& bnm, uint64_t blockIdx) {
-    return bnm.state_.rlock()->usedBlocksSet_.contains(blockIdx);
+    return bnm.getShard(blockIdx).rlock()->usedBlocksSet_.contains(blockIdx);
   }
 
   // Helper to get the number of managed UUIDs.
@@ -159,25 +166,26 @@ class BlankNodeManagerTestFixture : public ::testing::Test {
 // _____________________________________________________________________________
 TEST(BlankNodeManager, blockAllocationAndFree) {
   BlankNodeManager bnm(0);
-  EXPECT_TRUE(bnm.state_.rlock()->usedBlocksSet_.empty());
+  EXPECT_EQ(bnm.numBlocksUsed(), 0);
 
   {
     // LocalBlankNodeManager allocates a new block.
     BlankNodeManager::LocalBlankNodeManager lbnm(&bnm);
     [[maybe_unused]] uint64_t id = lbnm.getId();
-    EXPECT_EQ(bnm.state_.rlock()->usedBlocksSet_.size(), 1);
+    EXPECT_EQ(bnm.numBlocksUsed(), 1);
   }
 
   // Once the LocalBlankNodeManager is destroyed, all Blocks allocated through.
   // it are freed/removed from the BlankNodeManager's set.
-  EXPECT_TRUE(bnm.state_.rlock()->usedBlocksSet_.empty());
+  EXPECT_EQ(bnm.numBlocksUsed(), 0);
 
   // Mock randomIntGenerator to let the block index generation collide.
-  bnm.state_.wlock()->randBlockIndex_ = SlowRandomIntGenerator<uint64_t>(0, 1);
+  bnm.shards_[bnm.getShardIndexForCurrentThread()].wlock()->randBlockIndex_ =
+      SlowRandomIntGenerator<uint64_t>(0, 1);
   [[maybe_unused]] auto _ = bnm.allocateBlock();
   for (int i = 0; i < 30; ++i) {
     auto block = bnm.allocateBlock();
-    bnm.state_.wlock()->usedBlocksSet_.erase(block.blockIdx_);
+    bnm.freeBlock(block.blockIdx_);
   }
 }
 
@@ -237,7 +245,7 @@ TEST(BlankNodeManager, moveLocalBlankNodeManager) {
     BlankNodeManager::LocalBlankNodeManager l3(&bnm);
     l3 = std::move(l2);
   });
-  EXPECT_TRUE(bnm.state_.rlock()->usedBlocksSet_.empty());
+  EXPECT_EQ(bnm.numBlocksUsed(), 0);
 }
 
 // _____________________________________________________________________________
@@ -577,4 +585,60 @@ TEST_F(BlankNodeManagerTestFixture, serializationPreservesBlockIndices) {
   EXPECT_TRUE(isBlockUsed(*bnm, 100));
 }
 
+// _____________________________________________________________________________
+TEST_F(BlankNodeManagerTestFixture, reservationGrowsWithUsage) {
+  auto bnm = createManager();
+  {
+    auto lbnm = createLocalManager(bnm.get());
+    auto ids = allocateIdsAcrossBlocks(*lbnm, 20);
+    verifyIdsContained(*lbnm, ids);
+    // The first 8 blocks are allocated one at a time, then 8 and 16 blocks
+    // are reserved at once.
+    EXPECT_EQ(getPrimaryBlocks(*lbnm).size(), 20);
+    EXPECT_EQ(getUsedBlockCount(*bnm), 32);
+    // Only the blocks that were actually used are serialized.
+    auto entries = serialize(*lbnm);
+    ASSERT_EQ(entries.size(), 1);
+    EXPECT_EQ(entries[0].blockIndices_.size(), 20);
+  }
+  // The reserved blocks are also freed.
+  EXPECT_EQ(getUsedBlockCount(*bnm), 0);
+}
+
+// _____________________________________________________________________________
+TEST_F(BlankNodeManagerTestFixture, concurrentAllocation) {
+  auto bnm = createManager();
+  constexpr size_t numThreads = 8;
+  constexpr size_t numIdsPerThread = 5 * BlankNodeManager::blockSize_;
+  std::vector<std::vector<uint64_t>> ids(numThreads);
+  {
+    std::vector<std::shared_ptr<BlankNodeManager::LocalBlankNodeManager>>
+        managers;
+    for (size_t i = 0; i < numThreads; ++i) {
+      managers.push_back(createLocalManager(bnm.get()));
+    }
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; ++i) {
+      threads.emplace_back([&ids, &managers, i]() {
+        ids[i] = allocateIds(*managers[i], numIdsPerThread);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    EXPECT_EQ(getUsedBlockCount(*bnm), numThreads * 5);
+    for (size_t i = 0; i < numThreads; ++i) {
+      verifyIdsContained(*managers[i], ids[i]);
+    }
+  }
+  EXPECT_EQ(getUsedBlockCount(*bnm), 0);
+
+  // No index was handed out twice.
+  ad_utility::HashSet<uint64_t> allIds;
+  for (const auto& threadIds : ids) {
+    allIds.insert(threadIds.begin(), threadIds.end());
+  }
+  EXPECT_EQ(allIds.size(), numThreads * numIdsPerThread);
+}
+
 }  // namespace ad_utility
@@ -2,6 +2,7 @@
 // Chair of Algorithms and Data Structures.
 // Author: Björn Buchhold (buchhold@informatik.uni-freiburg.de)
 
+#include <absl/strings/str_cat.h>
 #include <gtest/gtest.h>
 
 #include <string>
@@ -139,4 +140,81 @@ TEST(LRUCacheTest, testDecreasingCapacity) {
   ASSERT_FALSE(cache["3"]);
   ASSERT_FALSE(cache["4"]);
 }
+
+// _____________________________________________________________________________
+namespace {
+// A value for the `GDSFCache` with an explicit size and cost.
+struct SizeAndCost {
+  size_t size_;
+  double cost_;
+};
+struct SizeAndCostSizeGetter {
+  MemorySize operator()(const SizeAndCost& value) const {
+    return MemorySize::bytes(value.size_);
+  }
+};
+struct SizeAndCostCostGetter {
+  double operator()(const SizeAndCost& value) const { return value.cost_; }
+};
+using TestGDSFCache = GDSFCache<string, SizeAndCost, SizeAndCostSizeGetter,
+                                SizeAndCostCostGetter>;
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(GDSFCacheTest, expensiveEntriesAreKept) {
+  TestGDSFCache cache(3);
+  cache.insert("expensive", {10, 1000.0});
+  cache.insert("cheap1", {1000, 1.0});
+  cache.insert("cheap2", {1000, 1.0});
+  // Evicts one of the cheap entries, which have the lowest cost per byte. An
+  // LRU cache would evict `expensive`.
+  cache.insert("cheap3", {1000, 1.0});
+  EXPECT_TRUE(cache.contains("expensive"));
+  EXPECT_EQ(cache.numNonPinnedEntries(), 3);
+  cache.insert("cheap4", {1000, 1.0});
+  cache.insert("cheap5", {1000, 1.0});
+  EXPECT_TRUE(cache.contains("expensive"));
+  EXPECT_TRUE(cache.contains("cheap5"));
+  EXPECT_EQ(cache.numNonPinnedEntries(), 3);
+
+  // Large entries that are cheap to compute are also evicted first when the
+  // limit on the total size is reached.
+  TestGDSFCache sizeLimited(100, 2500_B);
+  sizeLimited.insert("cheap", {1000, 1.0});
+  sizeLimited.insert("expensive", {1000, 100.0});
+  sizeLimited.insert("new", {1000, 1.0});
+  EXPECT_FALSE(sizeLimited.contains("cheap"));
+  EXPECT_TRUE(sizeLimited.contains("expensive"));
+  EXPECT_TRUE(sizeLimited.contains("new"));
+}
+
+// _____________________________________________________________________________
+TEST(GDSFCacheTest, frequentlyAccessedEntriesAreKept) {
+  TestGDSFCache cache(2);
+  cache.insert("frequent", {100, 10.0});
+  ASSERT_TRUE(cache["frequent"]);
+  ASSERT_TRUE(cache["frequent"]);
+  cache.insert("rare", {100, 10.0});
+  // `frequent` is the least recently used entry, but has been accessed more
+  // often than `rare`.
+  cache.insert("new", {100, 10.0});
+  EXPECT_TRUE(cache.contains("frequent"));
+  EXPECT_FALSE(cache.contains("rare"));
+  EXPECT_TRUE(cache.contains("new"));
+}
+
+// _____________________________________________________________________________
+TEST(GDSFCacheTest, unusedEntriesAge) {
+  // Each eviction raises the priority of the entries that are inserted or
+  // accessed afterward, so an expensive entry that is never accessed again is
+  // eventually evicted.
+  TestGDSFCache cache(2);
+  cache.insert("expensive", {10, 100.0});
+  cache.insert("cheap0", {10, 1.0});
+  for (size_t i = 1; i < 200; ++i) {
+    cache.insert(absl::StrCat("cheap", i), {10, 1.0});
+  }
+  EXPECT_FALSE(cache.contains("expensive"));
+  EXPECT_TRUE(cache.contains("cheap199"));
+}
 }  // namespace ad_utility
@@ -115,6 +115,11 @@ TEST(CallFixedSize, CallFixedSize1) {
   };
   testWithGivenUpperBound(
       std::integral_constant<int, DEFAULT_MAX_NUM_COLUMNS_STATIC_ID_TABLE>{});
+  static_assert(MAX_NUM_COLUMNS_STATIC_ID_TABLE_HOT_OPERATORS >=
+                DEFAULT_MAX_NUM_COLUMNS_STATIC_ID_TABLE);
+  testWithGivenUpperBound(
+      std::integral_constant<int,
+                             MAX_NUM_COLUMNS_STATIC_ID_TABLE_HOT_OPERATORS>{});
   // Custom upper bounds cannot be tested with the macros, as the macros don't
   // allow redefining the upper bound.
   testWithGivenUpperBound(std::integral_constant<int, 12>{});
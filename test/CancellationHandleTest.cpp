@@ -493,6 +493,52 @@ static_assert(isMemberFunction(&CancellationHandle<DISABLED>::isCancelled));
 // Ideally we'd add a static assertion for throwIfCancelled here too, but
 // because the function is overloaded, we can't get a function pointer for it.
 
+// _____________________________________________________________________________
+TEST(AmortizedCancellationCheck, checksAreAmortizedAndCalibrated) {
+  size_t numChecks = 0;
+  AmortizedCancellationCheck check{[&numChecks]() { ++numChecks; }};
+  // The first call is always forwarded.
+  check();
+  EXPECT_EQ(numChecks, 1);
+  // Fast calls increase the interval, so only few of them are forwarded.
+  for (size_t i = 0; i < 100'000; ++i) {
+    check();
+  }
+  EXPECT_GT(numChecks, 1);
+  EXPECT_LT(numChecks, 1'000);
+  EXPECT_GT(check.interval(), 1);
+  EXPECT_LE(check.interval(), check.maxInterval);
+
+  // Slow calls decrease the interval again.
+  AmortizedCancellationCheck slowCheck{[&numChecks]() { ++numChecks; }};
+  slowCheck();
+  EXPECT_EQ(slowCheck.interval(), 2);
+  slowCheck();
+  std::this_thread::sleep_for(2 * slowCheck.targetTimeBetweenChecks);
+  slowCheck();
+  EXPECT_EQ(slowCheck.interval(), 1);
+
+  // A cancellation is still detected.
+  CancellationHandle<NO_WATCH_DOG> handle;
+  AmortizedCancellationCheck checkHandle{
+      [&handle]() { handle.throwIfCancelled(); }};
+  for (size_t i = 0; i < 1'000; ++i) {
+    checkHandle();
+  }
+  handle.cancel(MANUAL);
+  auto callUntilThrown = [&checkHandle]() {
+    for (size_t i = 0; i <= checkHandle.maxInterval; ++i) {
+      checkHandle();
+    }
+  };
+  EXPECT_THROW(callUntilThrown(), CancellationException);
+
+  // A `Noop` is never called.
+  AmortizedCancellationCheck noop{Noop{}};
+  noop();
+  EXPECT_EQ(noop.interval(), 1);
+}
+
 // Constexpr test cases
 static_assert(trimFileName("") == "");
 static_assert(trimFileName("/") == "");
@@ -0,0 +1,36 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gtest/gtest.h>
+
+#include "util/http/ClientConnection.h"
+
+using ad_utility::httpUtils::ClientConnection;
+
+// _____________________________________________________________________________
+TEST(ClientConnection, callbacksAreInvokedOnceOnClose) {
+  ClientConnection connection;
+  EXPECT_FALSE(connection.isClosed());
+  size_t numCalls = 0;
+  connection.onClose([&numCalls]() { ++numCalls; });
+  connection.onClose([&numCalls]() { ++numCalls; });
+  EXPECT_EQ(numCalls, 0);
+
+  connection.close();
+  EXPECT_TRUE(connection.isClosed());
+  EXPECT_EQ(numCalls, 2);
+
+  // Closing again has no effect.
+  connection.close();
+  EXPECT_EQ(numCalls, 2);
+
+  // A callback that is registered after the close is invoked immediately.
+  connection.onClose([&numCalls]() { ++numCalls; });
+  EXPECT_EQ(numCalls, 3);
+}
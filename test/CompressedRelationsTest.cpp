@@ -9,6 +9,7 @@
 #include "./util/GTestHelpers.h"
 #include "./util/IdTableHelpers.h"
 #include "index/CompressedRelation.h"
+#include "index/DecompressedBlockCache.h"
 #include "index/IndexImpl.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
@@ -267,6 +268,23 @@ auto writeAndOpenRelations(const std::vector<RelationInput>& inputs,
   return std::tuple{std::move(blocks), std::move(metaData), reader()};
 }
 
+// Check that `getRelevantBlocks` for the `scanSpec` gives the same result with
+// and without a `BlockMetadataSearchIndex` for the `blocks`.
+void checkRelevantBlocksWithSearchIndex(
+    const ScanSpecification& scanSpec,
+    const std::vector<CompressedBlockMetadata>& blocks,
+    source_location l = AD_CURRENT_SOURCE_LOC()) {
+  auto trace = generateLocationTrace(l);
+  using Reader = CompressedRelationReader;
+  BlockMetadataSearchIndex searchIndex{blocks};
+  EXPECT_EQ(searchIndex.size(), blocks.size());
+  auto ranges = getBlockMetadataRangesfromVec(blocks);
+  EXPECT_EQ(Reader::convertBlockMetadataRangesToVector(
+                Reader::getRelevantBlocks(scanSpec, blocks, searchIndex)),
+            Reader::convertBlockMetadataRangesToVector(
+                Reader::getRelevantBlocks(scanSpec, ranges)));
+}
+
 // Run a set of tests on a permutation that is defined by the `inputs`. The
 // `inputs` must be ordered wrt the `col0_`.  `blocksize` is the size of the
 // blocks in which the permutation will be compressed and stored on disk.
@@ -294,6 +312,9 @@ void testCompressedRelations(const auto& inputsOriginalBeforeCopy,
   locatedTriples.updateAugmentedMetadata();
   auto blocks =
       getBlockMetadataRangesfromVec(locatedTriples.getAugmentedMetadata());
+  ASSERT_NE(locatedTriples.getAugmentedSearchIndex(), nullptr);
+  EXPECT_EQ(locatedTriples.getAugmentedSearchIndex()->size(),
+            locatedTriples.getAugmentedMetadata().size());
 
   auto& reader = *readerPtr;
 
@@ -345,6 +366,8 @@ void testCompressedRelations(const auto& inputsOriginalBeforeCopy,
 
     // Scan for all distinct `col0` and check that we get the expected result.
     ScanSpecification scanSpec{V(inputs[i].col0_), std::nullopt, std::nullopt};
+    checkRelevantBlocksWithSearchIndex(scanSpec,
+                                       locatedTriples.getAugmentedMetadata());
     IdTable table =
         reader.scan(ScanSpecAndBlocks{scanSpec, blocks}, additionalColumns,
                     cancellationHandle, locatedTriples);
@@ -383,6 +406,11 @@ void testCompressedRelations(const auto& inputsOriginalBeforeCopy,
     auto scanAndCheck = [&]() {
       ScanSpecification scanSpec{V(inputs[i].col0_), V(lastCol1Id),
                                  std::nullopt};
+      checkRelevantBlocksWithSearchIndex(
+          scanSpec, locatedTriples.getAugmentedMetadata());
+      checkRelevantBlocksWithSearchIndex(
+          ScanSpecification{V(inputs[i].col0_), V(lastCol1Id), V(col3[0][0])},
+          locatedTriples.getAugmentedMetadata());
       auto size = reader.getResultSizeOfScan(
           ScanSpecAndBlocks{scanSpec, blocks}, locatedTriples);
       IdTable tableWidthOne = reader.scan(ScanSpecAndBlocks{scanSpec, blocks},
@@ -439,6 +467,135 @@ TEST(CompressedRelationWriter, SmallRelations) {
   testWithDifferentBlockSizes(inputs);
 }
 
+// Test that the scans yield the same results with and without the
+// `DecompressedBlockCache`, and that repeated scans of the same blocks are
+// served from the cache.
+TEST(CompressedRelationReader, decompressedBlockCache) {
+  std::vector<RelationInput> inputs;
+  for (int i = 1; i < 200; ++i) {
+    inputs.push_back(
+        RelationInput{i, {{i - 1, i + 1}, {i - 1, i + 2}, {i, i - 1}}});
+  }
+  auto& cache = DecompressedBlockCache::get();
+  auto maxSizeBefore = cache.getStatistics().maxSize_;
+  auto cleanup = absl::Cleanup{[&cache, maxSizeBefore]() {
+    cache.setMaxSize(maxSizeBefore);
+  }};
+
+  cache.clear();
+  cache.setMaxSize(ad_utility::MemorySize::megabytes(10));
+  testCompressedRelations(inputs, 237_B);
+  auto stats = cache.getStatistics();
+  EXPECT_GT(stats.numHits_, 0u);
+  EXPECT_GT(stats.numMisses_, 0u);
+  EXPECT_GT(stats.numEntries_, 0u);
+  EXPECT_EQ(stats.numEvictions_, 0u);
+
+  // A tiny cache has to evict entries, but the results stay correct.
+  cache.clear();
+  cache.setMaxSize(ad_utility::MemorySize::bytes(200));
+  testCompressedRelations(inputs, 237_B);
+  EXPECT_GT(cache.getStatistics().numEvictions_, 0u);
+
+  // A disabled cache is never consulted.
+  cache.clear();
+  cache.setMaxSize(0_B);
+  testCompressedRelations(inputs, 237_B);
+  stats = cache.getStatistics();
+  EXPECT_EQ(stats.numHits_, 0u);
+  EXPECT_EQ(stats.numMisses_, 0u);
+  EXPECT_EQ(stats.numEntries_, 0u);
+}
+
+// Test that the lazy scans yield the correct results if the worker threads read
+// their blocks concurrently.
+TEST(CompressedRelationReader, lazyScanWithConcurrentReads) {
+  auto concurrentReads = setRuntimeParameterForTest<
+      &RuntimeParameters::lazyIndexScanConcurrentReads_>(true);
+  // Disable the cache, s.t. all the blocks are actually read from disk.
+  auto& cache = DecompressedBlockCache::get();
+  auto maxSizeBefore = cache.getStatistics().maxSize_;
+  auto cleanup = absl::Cleanup{[&cache, maxSizeBefore]() {
+    cache.setMaxSize(maxSizeBefore);
+  }};
+  cache.setMaxSize(0_B);
+  std::vector<RelationInput> inputs;
+  for (int i = 1; i < 200; ++i) {
+    inputs.push_back(
+        RelationInput{i, {{i - 1, i + 1}, {i - 1, i + 2}, {i, i - 1}}});
+  }
+  testWithDifferentBlockSizes(inputs);
+}
+
+// Test that the lazy scans yield the correct results with and without the
+// prefetching of blocks.
+TEST(CompressedRelationReader, lazyScanWithPrefetching) {
+  std::vector<RelationInput> inputs;
+  for (int i = 1; i < 200; ++i) {
+    inputs.push_back(
+        RelationInput{i, {{i - 1, i + 1}, {i - 1, i + 2}, {i, i - 1}}});
+  }
+  for (size_t maxNumPrefetchedBlocks : {0, 1, 1000}) {
+    auto prefetching = setRuntimeParameterForTest<
+        &RuntimeParameters::lazyIndexScanMaxNumPrefetchedBlocks_>(
+        maxNumPrefetchedBlocks);
+    testCompressedRelations(inputs, 237_B);
+  }
+}
+
+// Test that with `firstColumnKeys`, the blocks that contain none of the keys
+// in their first column are skipped after decompressing this column, and that
+// all the rows with one of the keys are still yielded.
+TEST(CompressedRelationReader, lazyScanWithFirstColumnKeys) {
+  std::vector<RelationInput> inputs;
+  std::vector<RowInput> rows;
+  for (int i = 0; i < 100; ++i) {
+    rows.push_back({i, i + 1, 0});
+  }
+  inputs.push_back(RelationInput{42, std::move(rows)});
+  auto [blocks, metadata, reader] =
+      writeAndOpenRelations(inputs, "lazyScanWithFirstColumnKeys", 32_B);
+  ASSERT_GT(blocks.size(), 3u);
+  ScanSpecification spec{V(42), std::nullopt, std::nullopt};
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  auto scanWithKeys = [&](std::optional<ql::span<const Id>> keys) {
+    auto relevantBlocks =
+        CompressedRelationReader::convertBlockMetadataRangesToVector(
+            CompressedRelationReader::getRelevantBlocks(
+                spec, getBlockMetadataRangesfromVec(blocks)));
+    auto range = reader->lazyScan(spec, std::move(relevantBlocks), {}, handle,
+                                  emptyLocatedTriples, {}, keys);
+    IdTable result{2, ad_utility::makeUnlimitedAllocator<Id>()};
+    for (const auto& block : range) {
+      result.insertAtEnd(block);
+    }
+    return std::pair{std::move(result),
+                     range.details().numBlocksWithOnlyFirstColumnDecompressed_};
+  };
+
+  // Without keys, all the blocks are completely decompressed.
+  auto [fullResult, numSkippedWithoutKeys] = scanWithKeys(std::nullopt);
+  EXPECT_EQ(fullResult.numRows(), 100u);
+  EXPECT_EQ(numSkippedWithoutKeys, 0u);
+
+  std::vector<Id> keys{V(17), V(50), V(51), V(1000)};
+  auto [result, numSkipped] = scanWithKeys(keys);
+  EXPECT_GT(numSkipped, 0u);
+  EXPECT_LT(result.numRows(), fullResult.numRows());
+  // All the rows with a join partner are contained in the result.
+  std::vector<std::vector<Id>> rowsWithKeys;
+  for (const auto& row : result) {
+    if (ql::ranges::binary_search(keys, row[0])) {
+      rowsWithKeys.push_back({row[0], row[1]});
+    }
+  }
+  EXPECT_THAT(rowsWithKeys,
+              ::testing::ElementsAre(
+                  ::testing::ElementsAre(V(17), V(18)),
+                  ::testing::ElementsAre(V(50), V(51)),
+                  ::testing::ElementsAre(V(51), V(52))));
+}
+
 // Internal matchers for the following two tests.
 namespace {
 // A matcher for a `PermutedTriple`. The `int`s are converted to VocabIds.
@@ -759,6 +916,52 @@ TEST(CompressedRelationReader, getBlocksForJoinWithColumn) {
   test({V(1)}, {}, 0);
 }
 
+// _____________________________________________________________________________
+TEST(CompressedRelationReader, getBlocksForJoinWithFewKeysAndManyBlocks) {
+  using SpecBlocksBounds = CompressedRelationReader::ScanSpecAndBlocksAndBounds;
+  // Block `i` contains the col1Ids `2 * i` and `2 * i + 1` of the relation 42.
+  constexpr size_t numBlocks = 1000;
+  std::vector<CompressedBlockMetadata> blocks;
+  for (size_t i = 0; i < numBlocks; ++i) {
+    blocks.push_back(CompressedBlockMetadata{{{},
+                                              0,
+                                              {V(42), V(2 * i), V(0), g},
+                                              {V(42), V(2 * i + 1), V(0), g},
+                                              {},
+                                              false},
+                                             i});
+  }
+  auto scanSpec = ScanSpecification{V(42), std::nullopt, std::nullopt};
+  SpecBlocksBounds metadataAndBlocks{
+      {scanSpec, getBlockMetadataRangesfromVec(blocks)},
+      {{V(42), V(0), V(0), g}, {V(42), V(2 * numBlocks - 1), V(0), g}}};
+
+  auto test = [&](const std::vector<size_t>& keys,
+                  const std::vector<size_t>& expectedBlockIndices,
+                  size_t numHandledBlocksExpected,
+                  source_location l = AD_CURRENT_SOURCE_LOC()) {
+    auto t = generateLocationTrace(l);
+    std::vector<Id> joinColumn;
+    for (auto key : keys) {
+      joinColumn.push_back(V(key));
+    }
+    std::vector<CompressedBlockMetadata> expectedBlocks;
+    for (auto i : expectedBlockIndices) {
+      expectedBlocks.push_back(blocks.at(i));
+    }
+    auto [result, numHandledBlocks] =
+        CompressedRelationReader::getBlocksForJoin(joinColumn,
+                                                   metadataAndBlocks);
+    EXPECT_THAT(result, ::testing::ElementsAreArray(expectedBlocks));
+    EXPECT_EQ(numHandledBlocks, numHandledBlocksExpected);
+  };
+  test({0}, {0}, 1);
+  test({7, 8, 9}, {3, 4}, 5);
+  test({3, 501, 1998}, {1, 250, 999}, 1000);
+  test({1999, 5000}, {999}, 1000);
+  test({4000}, {}, 1000);
+}
+
 TEST(CompressedRelationReader, getBlocksForJoin) {
   using SpecBlocksBounds = CompressedRelationReader::ScanSpecAndBlocksAndBounds;
   CompressedBlockMetadata block1{
@@ -955,6 +1158,24 @@ TEST(CompressedRelationReader, makeCanBeSkippedForBlock) {
   // only want graph `3`, so the block can't be skipped.
   metadata.graphInfo_.reset();
   EXPECT_FALSE(filter.canBlockBeSkipped(metadata));
+
+  // The Bloom filter says that the block doesn't contain graph `3`, so it can
+  // be skipped again.
+  using BloomFilter = CompressedBlockMetadata::GraphBloomFilter;
+  std::array containedGraphs{V(1), V(4)};
+  metadata.graphBloomFilter_ = BloomFilter::fromColumn(containedGraphs);
+  EXPECT_TRUE(metadata.graphBloomFilter_.mayContain(V(1)));
+  EXPECT_FALSE(metadata.graphBloomFilter_.mayContain(V(3)));
+  EXPECT_TRUE(filter.canBlockBeSkipped(metadata));
+
+  // After adding graph `3` (e.g. by an update) it can't be skipped anymore.
+  metadata.graphBloomFilter_.add(V(3));
+  EXPECT_FALSE(filter.canBlockBeSkipped(metadata));
+
+  // The Bloom filter can only be used for a whitelist.
+  metadata.graphBloomFilter_ = BloomFilter::fromColumn(containedGraphs);
+  graphFilter = GF::Blacklist(V(1));
+  EXPECT_FALSE(filter.canBlockBeSkipped(metadata));
 }
 
 TEST(CompressedRelationReader, getResultSizeImpl) {
@@ -1369,6 +1590,70 @@ TEST(CompressedRelationWriter, isInitializedWithCorrectNumberOfThreads) {
   }
 }
 
+// _____________________________________________________________________________
+TEST(CompressedRelationWriter, compressionLevel) {
+  std::vector<RelationInput> inputs;
+  for (int i = 1; i < 6; ++i) {
+    std::vector<RowInput> col1And2;
+    for (int j = 0; j < 200; ++j) {
+      col1And2.push_back({i * j, j % 7});
+    }
+    inputs.push_back(RelationInput{i * 17, std::move(col1And2)});
+  }
+  for (size_t level : {1, 19}) {
+    auto reset = setRuntimeParameterForTest<
+        &RuntimeParameters::permutationCompressionLevel_>(level);
+    auto [filename, cleanup] = testFilenameWithCleanup();
+    CompressedRelationWriter writer{1, ad_utility::File{filename, "w+"}, 16_B};
+    EXPECT_EQ(writer.compressionLevel_, static_cast<int>(level));
+    testWithDifferentBlockSizes(inputs);
+  }
+  EXPECT_ANY_THROW(
+      setRuntimeParameter<&RuntimeParameters::permutationCompressionLevel_>(
+          0));
+  EXPECT_ANY_THROW(
+      setRuntimeParameter<&RuntimeParameters::permutationCompressionLevel_>(
+          23));
+}
+
+// _____________________________________________________________________________
+TEST(CompressedRelationWriter, blocksizeForLargeRelation) {
+  auto [filename, cleanup] = testFilenameWithCleanup();
+  {
+    // By default, all blocks have the regular size.
+    CompressedRelationWriter writer{1, ad_utility::File{filename, "w+"}, 80_B};
+    EXPECT_EQ(writer.blocksize(), 10);
+    EXPECT_EQ(writer.maxBlocksizeFactor_, 1);
+    EXPECT_EQ(writer.blocksizeForLargeRelation(0), 10);
+    EXPECT_EQ(writer.blocksizeForLargeRelation(1'000'000), 10);
+  }
+  auto reset = setRuntimeParameterForTest<
+      &RuntimeParameters::permutationMaxBlocksizeFactor_>(4);
+  {
+    CompressedRelationWriter writer{1, ad_utility::File{filename, "w+"}, 80_B};
+    EXPECT_EQ(writer.maxBlocksizeFactor_, 4);
+    EXPECT_EQ(writer.blocksizeForLargeRelation(0), 10);
+    EXPECT_EQ(writer.blocksizeForLargeRelation(159), 10);
+    EXPECT_EQ(writer.blocksizeForLargeRelation(160), 20);
+    EXPECT_EQ(writer.blocksizeForLargeRelation(319), 20);
+    EXPECT_EQ(writer.blocksizeForLargeRelation(320), 40);
+    EXPECT_EQ(writer.blocksizeForLargeRelation(1'000'000), 40);
+  }
+  // The growing blocks of large relations and their twins are read correctly.
+  std::vector<RelationInput> inputs;
+  for (int i = 1; i < 4; ++i) {
+    std::vector<RowInput> col1And2;
+    for (int j = 0; j < 500 * i; ++j) {
+      col1And2.push_back({j / 3, j % 5});
+    }
+    inputs.push_back(RelationInput{i * 17, std::move(col1And2)});
+  }
+  testWithDifferentBlockSizes(inputs);
+  EXPECT_ANY_THROW(
+      setRuntimeParameter<&RuntimeParameters::permutationMaxBlocksizeFactor_>(
+          0));
+}
+
 // _____________________________________________________________________________
 TEST(ScanSpecAndBlocks, removePrefix) {
   using ScanSpecAndBlocks = CompressedRelationReader::ScanSpecAndBlocks;
@@ -1442,3 +1727,105 @@ TEST(CompressedBlockMetadata, invariantChecks) {
   blocks.front().lastTriple_ = {V(1), V(2), V(3), V(16)};
   EXPECT_TRUE(CompressedBlockMetadata::checkInvariantsForSortedBlocks(blocks));
 }
+
+// _____________________________________________________________________________
+TEST(CompressedBlockMetadata, tripleBloomFilter) {
+  using Filter = CompressedBlockMetadata::TripleBloomFilter;
+  VectorTable rows;
+  for (int64_t i = 0; i < 100; ++i) {
+    rows.push_back({i, 2 * i, 3 * i});
+  }
+  auto block = makeIdTableFromVector(rows);
+  auto filter = Filter::fromBlock(block, 16);
+  // 100 rows times 16 bits, rounded up to a power of two.
+  EXPECT_EQ(filter.bits_.size(), 32u);
+  for (int64_t i = 0; i < 100; ++i) {
+    EXPECT_TRUE(filter.mayContain(V(i), V(2 * i), V(3 * i)));
+  }
+  size_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 1000; ++i) {
+    numFalsePositives += filter.mayContain(V(i), V(2 * i), V(3 * i + 1));
+  }
+  EXPECT_LT(numFalsePositives, 50u);
+
+  // Even for an empty block, the filter has at least one word. Triples can be
+  // added later on (e.g. by an update).
+  auto emptyFilter =
+      Filter::fromBlock(IdTable{3, ad_utility::testing::makeAllocator()}, 16);
+  EXPECT_EQ(emptyFilter.bits_.size(), 1u);
+  EXPECT_FALSE(emptyFilter.mayContain(V(1), V(1), V(1)));
+  emptyFilter.add(V(1), V(1), V(1));
+  EXPECT_TRUE(emptyFilter.mayContain(V(1), V(1), V(1)));
+}
+
+// _____________________________________________________________________________
+TEST(CompressedRelationWriter, tripleBloomFilterSkipsBlocks) {
+  std::vector<RelationInput> inputs;
+  for (int i = 1; i < 4; ++i) {
+    std::vector<RowInput> col1And2;
+    for (int j = 0; j < 200; ++j) {
+      col1And2.push_back({j, j % 7});
+    }
+    inputs.push_back(RelationInput{i * 17, std::move(col1And2)});
+  }
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  // Return the total number of relevant blocks for all the fully bound scans
+  // for `<34> <j> <j % 7 + offset>`, and check that each of the scans has
+  // `expectedSize` many results.
+  auto numBlocksForFullyBoundScans = [&](const auto& blocks,
+                                         const auto& reader,
+                                         const LocatedTriplesPerBlock& located,
+                                         int offset, size_t expectedSize) {
+    size_t numBlocks = 0;
+    for (int j = 0; j < 200; ++j) {
+      ScanSpecification scanSpec{V(34), V(j), V(j % 7 + offset)};
+      numBlocks += CompressedRelationReader::getNumberOfBlockMetadataValues(
+          CompressedRelationReader::getRelevantBlocks(scanSpec, blocks));
+      using ScanSpecAndBlocks = CompressedRelationReader::ScanSpecAndBlocks;
+      auto result = reader.scan(ScanSpecAndBlocks{scanSpec, blocks},
+                                Permutation::ColumnIndicesRef{}, handle,
+                                located);
+      EXPECT_EQ(result.numRows(), expectedSize);
+    }
+    return numBlocks;
+  };
+
+  std::array<size_t, 2> numBlocksForAbsentTriples{};
+  for (size_t bitsPerTriple : {0, 16}) {
+    auto reset = setRuntimeParameterForTest<
+        &RuntimeParameters::permutationTripleBloomFilterBitsPerTriple_>(
+        bitsPerTriple);
+    auto [filename, cleanup] = testFilenameWithCleanup();
+    auto [blocksVec, metaData, reader] =
+        writeAndOpenRelations(inputs, filename, 64_B);
+    ASSERT_GT(blocksVec.size(), 10u);
+    for (const auto& block : blocksVec) {
+      EXPECT_EQ(block.tripleBloomFilter_.has_value(), bitsPerTriple > 0);
+    }
+    auto blocks = getBlockMetadataRangesfromVec(blocksVec);
+    numBlocksForFullyBoundScans(blocks, *reader, emptyLocatedTriples, 0, 1);
+    numBlocksForAbsentTriples.at(bitsPerTriple > 0) =
+        numBlocksForFullyBoundScans(blocks, *reader, emptyLocatedTriples, 1, 0);
+
+    // Triples that are inserted via `LocatedTriples` are added to the filter
+    // of the augmented metadata, so their blocks are not skipped.
+    std::vector<IdTriple<>> inserted;
+    for (int j = 0; j < 200; ++j) {
+      inserted.push_back(IdTriple<>{{V(34), V(j), V(j % 7 + 1), V(103496581)}});
+    }
+    LocatedTriplesPerBlock locatedTriples;
+    locatedTriples.add(LocatedTriple::locateTriplesInPermutation(
+        inserted, blocksVec, {0, 1, 2, 3}, true, handle));
+    locatedTriples.setOriginalMetadata(blocksVec);
+    locatedTriples.updateAugmentedMetadata();
+    auto augmentedBlocks =
+        getBlockMetadataRangesfromVec(locatedTriples.getAugmentedMetadata());
+    EXPECT_GE(numBlocksForFullyBoundScans(augmentedBlocks, *reader,
+                                          locatedTriples, 1, 1),
+              200u);
+  }
+  // Without the filter, (nearly) each of the absent triples falls into the
+  // range of a block, with the filter, hardly any of them does.
+  EXPECT_GT(numBlocksForAbsentTriples[0], 150u);
+  EXPECT_LT(numBlocksForAbsentTriples[1] * 10, numBlocksForAbsentTriples[0]);
+}
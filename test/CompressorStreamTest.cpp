@@ -12,6 +12,7 @@ namespace io = boost::iostreams;
 namespace http = boost::beast::http;
 using ad_utility::content_encoding::CompressionMethod;
 using ad_utility::streams::compressStream;
+using ad_utility::streams::compressStreamInParallel;
 
 namespace {
 cppcoro::generator<std::string> generateNChars(size_t n) {
@@ -19,6 +20,37 @@ cppcoro::generator<std::string> generateNChars(size_t n) {
     co_yield "A";
   }
 }
+
+// Yield `numChunks` chunks of `chunkSize` characters each, the content of
+// which is repetitive, but not constant.
+cppcoro::generator<std::string> generateChunks(size_t numChunks,
+                                               size_t chunkSize) {
+  for (size_t i = 0; i < numChunks; i++) {
+    std::string chunk;
+    for (size_t j = 0; chunk.size() < chunkSize; j++) {
+      chunk.append(std::to_string((i * chunkSize + j) % 997));
+      chunk.push_back(' ');
+    }
+    chunk.resize(chunkSize);
+    co_yield chunk;
+  }
+}
+
+// Decompress all the frames of a zstd stream.
+std::string decompressZstd(std::string_view compressedData) {
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{
+      ZSTD_createDCtx(), &ZSTD_freeDCtx};
+  std::string result;
+  ZSTD_inBuffer in{compressedData.data(), compressedData.size(), 0};
+  std::string buffer(ZSTD_DStreamOutSize(), '\0');
+  while (in.pos < in.size) {
+    ZSTD_outBuffer out{buffer.data(), buffer.size(), 0};
+    size_t status = ZSTD_decompressStream(context.get(), &out, &in);
+    AD_CORRECTNESS_CHECK(!ZSTD_isError(status));
+    result.append(buffer.data(), out.pos);
+  }
+  return result;
+}
 }  // namespace
 
 class CompressorStreamTestFixture
@@ -26,6 +58,9 @@ class CompressorStreamTestFixture
  public:
   [[nodiscard]] static std::string decompressData(
       std::string_view compressedData) {
+    if (GetParam() == CompressionMethod::ZSTD) {
+      return decompressZstd(compressedData);
+    }
     std::string result;
     io::filtering_ostream filterStream;
     if (GetParam() == CompressionMethod::GZIP) {
@@ -40,6 +75,8 @@ class CompressorStreamTestFixture
 
     filterStream.write(compressedData.data(),
                        static_cast<std::streamsize>(compressedData.size()));
+    // Flush the remaining decompressed data into the `result`.
+    filterStream.reset();
     return result;
   }
 };
@@ -75,9 +112,46 @@ TEST_P(CompressorStreamTestFixture, IncompleteIteration) {
   }
 }
 
+// The concatenation of all the strings of the `generator`.
+std::string concatenate(cppcoro::generator<std::string> generator) {
+  std::string result;
+  for (const auto& value : generator) {
+    result.append(value);
+  }
+  return result;
+}
+
+TEST_P(CompressorStreamTestFixture, ParallelCompression) {
+  for (size_t numThreads : {1, 3}) {
+    for (auto [numChunks, chunkSize] :
+         {std::pair<size_t, size_t>{0, 0}, {1, 10}, {7, 100'000}}) {
+      auto compressed = concatenate(compressStreamInParallel(
+          generateChunks(numChunks, chunkSize), GetParam(), numThreads));
+      auto expected = concatenate(generateChunks(numChunks, chunkSize));
+      EXPECT_EQ(decompressData(compressed), expected);
+      // The compression is still effective for independently compressed
+      // chunks.
+      if (numChunks > 1) {
+        EXPECT_LT(compressed.size(), expected.size() / 2);
+      }
+    }
+  }
+
+  // Empty chunks are skipped.
+  auto withEmptyChunks = []() -> cppcoro::generator<std::string> {
+    co_yield "";
+    co_yield "abc";
+    co_yield "";
+  };
+  EXPECT_EQ(decompressData(concatenate(
+                compressStreamInParallel(withEmptyChunks(), GetParam(), 2))),
+            "abc");
+}
+
 using ad_utility::content_encoding::CompressionMethod;
 
 INSTANTIATE_TEST_SUITE_P(CompressionMethodParameters,
                          CompressorStreamTestFixture,
                          ::testing::Values(CompressionMethod::DEFLATE,
-                                           CompressionMethod::GZIP));
+                                           CompressionMethod::GZIP,
+                                           CompressionMethod::ZSTD));
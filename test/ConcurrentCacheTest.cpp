@@ -115,6 +115,19 @@ TEST(ConcurrentCache, sequentialComputation) {
   ASSERT_TRUE(a.getStorage().wlock()->_inProgress.empty());
 }
 
+TEST(ConcurrentCache, statistics) {
+  SimpleConcurrentLruCache a{3ul};
+  EXPECT_EQ(a.getStatistics().numHits_, 0);
+  EXPECT_EQ(a.getStatistics().numMisses_, 0);
+  a.computeOnce(3, waiting_function("3"s, 0), false, returnTrue);
+  a.computeOnce(3, waiting_function("3"s, 0), false, returnTrue);
+  a.computeOncePinned(3, waiting_function("3"s, 0), false, returnTrue);
+  // A read-only lookup that doesn't find the result doesn't count.
+  a.computeOnce(4, waiting_function("4"s, 0), true, returnTrue);
+  EXPECT_EQ(a.getStatistics().numHits_, 2);
+  EXPECT_EQ(a.getStatistics().numMisses_, 1);
+}
+
 TEST(ConcurrentCache, sequentialPinnedComputation) {
   SimpleConcurrentLruCache a{3ul};
   ad_utility::Timer t{ad_utility::Timer::Started};
@@ -571,3 +584,65 @@ TEST(ConcurrentCache, computeButDontStore) {
       42, []() { return "blubb"; }, true, alwaysSuitable);
   EXPECT_EQ(res._resultPointer, nullptr);
 }
+
+// _____________________________________________________________________________
+TEST(ConcurrentCache, shardedCache) {
+  SimpleConcurrentLruCache cache{ad_utility::NumShards{4}};
+  EXPECT_EQ(cache.numShards(), 4);
+  cache.setMaxNumEntries(5);
+
+  // The limit of the number of entries applies to all the shards together.
+  for (int i = 0; i < 20; ++i) {
+    auto res = cache.computeOnce(
+        i, [i]() { return std::to_string(i); }, false, returnTrue);
+    EXPECT_EQ(*res._resultPointer, std::to_string(i));
+    EXPECT_EQ(res._cacheStatus, ad_utility::CacheStatus::computed);
+  }
+  EXPECT_EQ(cache.numNonPinnedEntries(), 5);
+  EXPECT_EQ(cache.numPinnedEntries(), 0);
+
+  // Entries that are still contained are read from the cache.
+  size_t numContained = 0;
+  for (int i = 0; i < 20; ++i) {
+    if (!cache.cacheContains(i)) {
+      continue;
+    }
+    ++numContained;
+    auto res = cache.computeOnce(
+        i, []() -> std::string { throw std::runtime_error("unexpected"); },
+        false, returnTrue);
+    EXPECT_EQ(*res._resultPointer, std::to_string(i));
+    EXPECT_EQ(res._cacheStatus, ad_utility::CacheStatus::cachedNotPinned);
+  }
+  EXPECT_EQ(numContained, 5);
+
+  // Pinned entries are never evicted, even if they exceed the limits.
+  for (int i = 100; i < 108; ++i) {
+    cache.computeOncePinned(
+        i, [i]() { return std::to_string(i); }, false, returnTrue);
+  }
+  EXPECT_EQ(cache.numPinnedEntries(), 8);
+  EXPECT_EQ(cache.numNonPinnedEntries(), 0);
+  for (int i = 100; i < 108; ++i) {
+    EXPECT_TRUE(cache.cacheContains(i));
+  }
+
+  // The limit of the total size.
+  cache.clearAll();
+  cache.setMaxNumEntries(1000);
+  cache.setMaxSize(ad_utility::MemorySize::bytes(30));
+  for (int i = 0; i < 20; ++i) {
+    cache.computeOnce(
+        i, []() { return std::string(10, 'a'); }, false, returnTrue);
+  }
+  EXPECT_EQ(cache.numNonPinnedEntries(), 3);
+  EXPECT_EQ(cache.nonPinnedSize(), ad_utility::MemorySize::bytes(30));
+
+  // Making room frees entries from all the shards.
+  EXPECT_TRUE(
+      cache.makeRoomAsMuchAsPossible(ad_utility::MemorySize::bytes(20)));
+  EXPECT_LE(cache.nonPinnedSize(), ad_utility::MemorySize::bytes(10));
+  EXPECT_FALSE(
+      cache.makeRoomAsMuchAsPossible(ad_utility::MemorySize::bytes(50)));
+  EXPECT_EQ(cache.numNonPinnedEntries(), 0);
+}
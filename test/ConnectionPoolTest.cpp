@@ -0,0 +1,61 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "util/http/ConnectionPool.h"
+
+using ad_utility::httpUtils::ConnectionPool;
+using namespace std::chrono_literals;
+
+// _____________________________________________________________________________
+TEST(ConnectionPool, acquireAndRelease) {
+  ConnectionPool<int> pool{3, 1h};
+  EXPECT_EQ(pool.acquire("a:80"), nullptr);
+  pool.release("a:80", std::make_unique<int>(1));
+  pool.release("b:80", std::make_unique<int>(2));
+  pool.release("a:80", std::make_unique<int>(3));
+  EXPECT_EQ(pool.numIdleConnections(), 3);
+
+  // The most recently released connection for the key is returned first.
+  auto connection = pool.acquire("a:80");
+  ASSERT_NE(connection, nullptr);
+  EXPECT_EQ(*connection, 3);
+  connection = pool.acquire("a:80");
+  ASSERT_NE(connection, nullptr);
+  EXPECT_EQ(*connection, 1);
+  EXPECT_EQ(pool.acquire("a:80"), nullptr);
+  EXPECT_EQ(pool.numIdleConnections(), 1);
+
+  pool.clear();
+  EXPECT_EQ(pool.numIdleConnections(), 0);
+  EXPECT_EQ(pool.acquire("b:80"), nullptr);
+}
+
+// _____________________________________________________________________________
+TEST(ConnectionPool, limits) {
+  // If the pool is full, the oldest connection is evicted.
+  ConnectionPool<int> pool{2, 1h};
+  pool.release("a", std::make_unique<int>(1));
+  pool.release("b", std::make_unique<int>(2));
+  pool.release("c", std::make_unique<int>(3));
+  EXPECT_EQ(pool.numIdleConnections(), 2);
+  EXPECT_EQ(pool.acquire("a"), nullptr);
+  EXPECT_NE(pool.acquire("b"), nullptr);
+
+  // The connections that have been idle for too long are closed.
+  pool.setLimits(2, 1ms);
+  std::this_thread::sleep_for(5ms);
+  EXPECT_EQ(pool.acquire("c"), nullptr);
+  EXPECT_EQ(pool.numIdleConnections(), 0);
+
+  // With a maximum of zero idle connections, nothing is pooled.
+  pool.setLimits(0, 1h);
+  pool.release("a", std::make_unique<int>(1));
+  EXPECT_EQ(pool.numIdleConnections(), 0);
+}
@@ -9,6 +9,7 @@
 #include <gmock/gmock.h>
 
 #include "./util/IdTableHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
 #include "./util/TripleComponentTestHelpers.h"
 #include "engine/ConstructTripleGenerator.h"
 #include "engine/ConstructTripleInstantiator.h"
@@ -500,4 +501,56 @@ TEST_F(ConstructTripleGeneratorTest,
   }
 }
 
+// With multiple threads, the batches are formatted concurrently. The
+// concatenated output (including the blank node labels, which depend on the
+// row offsets) has to be the same as for a single thread, and cancellation
+// has to be propagated from the worker threads.
+TEST_F(ConstructTripleGeneratorTest, generateFormattedTriplesInParallel) {
+  constexpr size_t N = 5 * ConstructTripleGenerator::BATCH_SIZE + 7;
+  std::vector<std::vector<IntOrId>> rows;
+  for (size_t i = 0; i < N; ++i) {
+    // Rows with an undefined value don't yield a triple.
+    rows.push_back({i % 3 == 0 ? idS_ : (i % 3 == 1 ? idO_ : U)});
+  }
+  auto result1 = makeResult(makeIdTableFromVector(rows));
+  auto result2 = makeResult(makeIdTableFromVector(rows));
+  Triples templateTriples{
+      {Variable{"?sub"}, iriV("<p>"), BlankNode{false, "b"}},
+      {BlankNode{false, "b"}, iriV("<q>"), iriV("<o>")}};
+  VariableToColumnMap varMap;
+  varMap[Variable{"?sub"}] = makeAlwaysDefinedColumn(0);
+
+  auto makeTables = [&]() {
+    return ad_utility::InputRangeTypeErased{std::vector<TableWithRange>{
+        makeTableWithRange(*result1, 0, N),
+        makeTableWithRange(*result2, 3, N - 5),
+        makeTableWithRange(*result2, 0, 0)}};
+  };
+  auto formatWithThreads = [&](size_t numThreads,
+                               ad_utility::SharedCancellationHandle handle) {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::constructExportNumThreads_>(numThreads);
+    auto range = ConstructTripleGenerator::generateFormattedTriples(
+        templateTriples, varMap, index_, std::move(handle), makeTables(), 42,
+        ad_utility::MediaType::turtle);
+    std::string output;
+    while (auto chunk = range.get()) {
+      EXPECT_FALSE(chunk->empty());
+      output.append(chunk.value());
+    }
+    return output;
+  };
+
+  auto expected = formatWithThreads(1, makeHandle());
+  EXPECT_THAT(expected, ::testing::StartsWith("<s> <p> _:u42_b .\n"
+                                              "_:u42_b <q> <o> .\n"));
+  for (size_t numThreads : {2, 4, 16}) {
+    EXPECT_EQ(formatWithThreads(numThreads, makeHandle()), expected);
+  }
+
+  auto handle = makeHandle();
+  handle->cancel(ad_utility::CancellationState::MANUAL);
+  EXPECT_ANY_THROW(formatWithThreads(4, handle));
+}
+
 }  // namespace qlever::constructExport
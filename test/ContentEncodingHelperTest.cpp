@@ -49,7 +49,8 @@ auto getValuePairsForHeaderTest() {
       // empty string_view means no such header is present
       std::pair{CompressionMethod::NONE, std::string_view{}},
       std::pair{CompressionMethod::DEFLATE, "deflate"},
-      std::pair{CompressionMethod::GZIP, "gzip"});
+      std::pair{CompressionMethod::GZIP, "gzip"},
+      std::pair{CompressionMethod::ZSTD, "zstd"});
 }
 
 INSTANTIATE_TEST_SUITE_P(CompressionMethodParameters,
@@ -95,3 +96,12 @@ TEST(ContentEncodingHelper, DeflateHeaderIsPreferredOverGzipOnMultipleHeaders) {
 
   ASSERT_EQ(result, CompressionMethod::DEFLATE);
 }
+
+TEST(ContentEncodingHelper, ZstdHeaderIsPreferred) {
+  http::request<http::string_body> request;
+  request.insert(http::field::accept_encoding, "gzip, deflate");
+  request.insert(http::field::accept_encoding, "zstd");
+  auto result = getCompressionMethodForRequest(request);
+
+  ASSERT_EQ(result, CompressionMethod::ZSTD);
+}
@@ -935,6 +935,219 @@ TEST_F(DeltaTriplesTest, storeAndRestoreData) {
   }
 }
 
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, writeAheadLog) {
+  auto tmpFile = std::filesystem::temp_directory_path() / "testWriteAheadLog";
+  std::filesystem::remove(tmpFile);
+  absl::Cleanup cleanup{[&tmpFile]() { std::filesystem::remove(tmpFile); }};
+  const auto& index = testQec->getIndex().getImpl();
+  LocalVocab localVocab;
+  auto triples = [&](const std::vector<std::string>& turtles) {
+    return makeIdTriples(index, localVocab, turtles);
+  };
+  using Entry = DeltaTriplesWriteAheadLog::Entry;
+  DeltaTriplesWriteAheadLog log{tmpFile};
+  EXPECT_EQ(log.sizeInBytes(), 0);
+  const auto& context = testQec->getLocalVocabContext();
+  LocalVocab readVocab;
+  EXPECT_TRUE(log.read(readVocab, context).empty());
+
+  log.append(std::vector<Entry>{{true, triples({"<a> <b> <new>"})},
+                                {false, triples({"<a> <b> <c>"})}});
+  log.append(std::vector<Entry>{{true, triples({"<x> <y> <new>"})}});
+  // Nothing is written for an empty list of entries.
+  auto size = log.sizeInBytes();
+  log.append({});
+  EXPECT_EQ(log.sizeInBytes(), size);
+
+  // Reading the log maps the local vocab entries to the `readVocab`.
+  auto toStrings = [this](const Entry& entry) {
+    std::vector<std::string> result;
+    for (const auto& triple : entry.triples_) {
+      for (Id id : ql::span{triple.ids()}.first(3)) {
+        result.push_back(
+            ql::exportIds::idToStringAndType(testQec->getIndex(), id,
+                                             LocalVocab{})
+                .value()
+                .first);
+      }
+    }
+    return result;
+  };
+  auto checkLog = [&]() {
+    using ::testing::ElementsAre;
+    auto entries = log.read(readVocab, context);
+    ASSERT_EQ(entries.size(), 3);
+    EXPECT_TRUE(entries[0].insertOrDelete_);
+    EXPECT_FALSE(entries[1].insertOrDelete_);
+    EXPECT_TRUE(entries[2].insertOrDelete_);
+    EXPECT_THAT(toStrings(entries[0]), ElementsAre("<a>", "<b>", "<new>"));
+    EXPECT_THAT(toStrings(entries[1]), ElementsAre("<a>", "<b>", "<c>"));
+    EXPECT_THAT(toStrings(entries[2]), ElementsAre("<x>", "<y>", "<new>"));
+  };
+  checkLog();
+
+  // Simulate a crash while appending a record. The incomplete record is
+  // ignored and removed from the log.
+  {
+    std::ofstream stream{tmpFile, std::ios::binary | std::ios::app};
+    stream << "incomplete record";
+  }
+  checkLog();
+  EXPECT_EQ(log.sizeInBytes(), size);
+
+  log.clear();
+  EXPECT_EQ(log.sizeInBytes(), 0);
+  EXPECT_TRUE(log.read(readVocab, context).empty());
+}
+
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, replicationLog) {
+  const auto& index = testQec->getIndex().getImpl();
+  LocalVocab localVocab;
+  auto triples = [&](const std::vector<std::string>& turtles) {
+    return makeIdTriples(index, localVocab, turtles);
+  };
+  using Entry = DeltaTriplesWriteAheadLog::Entry;
+  using Log = DeltaTriplesReplicationLog;
+  auto sequenceNumbers = [](const std::optional<Log::Records>& records) {
+    std::vector<uint64_t> result;
+    for (const auto& record : records.value().records_) {
+      result.push_back(record.sequenceNumber_);
+    }
+    return result;
+  };
+  using ::testing::ElementsAre;
+
+  Log log{ad_utility::MemorySize::megabytes(1)};
+  EXPECT_EQ(log.latestSequenceNumber(), 0);
+  EXPECT_THAT(sequenceNumbers(log.recordsSince(0)), ElementsAre());
+  log.append(std::vector<Entry>{{true, triples({"<a> <b> <new>"})}});
+  log.append(std::vector<Entry>{{false, triples({"<a> <b> <c>"})}});
+  // Nothing is appended for an empty list of entries, unless it clears the
+  // delta triples.
+  log.append({});
+  EXPECT_EQ(log.latestSequenceNumber(), 2);
+  log.append({}, true);
+  EXPECT_EQ(log.latestSequenceNumber(), 3);
+  EXPECT_THAT(sequenceNumbers(log.recordsSince(0)), ElementsAre(1, 2, 3));
+  EXPECT_THAT(sequenceNumbers(log.recordsSince(2)), ElementsAre(3));
+  EXPECT_THAT(sequenceNumbers(log.recordsSince(3)), ElementsAre());
+  EXPECT_FALSE(log.recordsSince(4).has_value());
+
+  // The serialized records can be deserialized and decoded.
+  auto records = Log::deserialize(Log::serialize(log.recordsSince(1).value()));
+  EXPECT_EQ(records.latestSequenceNumber_, 3);
+  ASSERT_EQ(records.records_.size(), 2);
+  EXPECT_FALSE(records.records_[0].clearsDeltaTriples_);
+  EXPECT_TRUE(records.records_[1].clearsDeltaTriples_);
+  LocalVocab readVocab;
+  auto entries = DeltaTriplesWriteAheadLog::decodeRecord(
+      records.records_[0].content_, readVocab,
+      testQec->getLocalVocabContext());
+  ASSERT_EQ(entries.size(), 1);
+  EXPECT_FALSE(entries[0].insertOrDelete_);
+  EXPECT_EQ(entries[0].triples_, triples({"<a> <b> <c>"}));
+
+  // After a reset, the replicas can't continue, but new records still get
+  // consecutive sequence numbers.
+  log.reset();
+  EXPECT_FALSE(log.recordsSince(2).has_value());
+  EXPECT_THAT(sequenceNumbers(log.recordsSince(3)), ElementsAre());
+  log.append(std::vector<Entry>{{true, triples({"<x> <y> <z>"})}});
+  EXPECT_THAT(sequenceNumbers(log.recordsSince(3)), ElementsAre(4));
+
+  // The oldest records are dropped when the maximal size is exceeded, but the
+  // latest record is always kept.
+  Log smallLog{ad_utility::MemorySize::bytes(1)};
+  smallLog.append(std::vector<Entry>{{true, triples({"<a> <b> <new>"})}});
+  smallLog.append(std::vector<Entry>{{true, triples({"<x> <y> <z>"})}});
+  EXPECT_FALSE(smallLog.recordsSince(0).has_value());
+  EXPECT_THAT(sequenceNumbers(smallLog.recordsSince(1)), ElementsAre(2));
+
+  // Each modification of the `DeltaTriplesManager` appends a single record,
+  // which only contains the updates of the external permutations.
+  DeltaTriplesManager manager{testQec->getIndex()};
+  EXPECT_EQ(manager.replicationLog(), nullptr);
+  manager.enableReplicationLog(ad_utility::MemorySize::megabytes(1));
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  manager.modify<void>([&](DeltaTriples& deltaTriples) {
+    deltaTriples.insertTriples(cancellationHandle,
+                               triples({"<a> <b> <new>", "<a> <b> <new2>"}));
+    deltaTriples.deleteTriples(cancellationHandle, triples({"<a> <b> <c>"}));
+  });
+  manager.modify<void>([](DeltaTriples&) {});
+  manager.clear();
+  auto managerRecords = manager.replicationLog()->recordsSince(0).value();
+  ASSERT_EQ(managerRecords.records_.size(), 2);
+  EXPECT_FALSE(managerRecords.records_[0].clearsDeltaTriples_);
+  EXPECT_TRUE(managerRecords.records_[1].clearsDeltaTriples_);
+  auto managerEntries = DeltaTriplesWriteAheadLog::decodeRecord(
+      managerRecords.records_[0].content_, readVocab,
+      testQec->getLocalVocabContext());
+  ASSERT_EQ(managerEntries.size(), 2);
+  EXPECT_TRUE(managerEntries[0].insertOrDelete_);
+  EXPECT_EQ(managerEntries[0].triples_.size(), 2);
+  EXPECT_FALSE(managerEntries[1].insertOrDelete_);
+}
+
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, restoreFromCheckpointAndLog) {
+  auto tmpFile =
+      std::filesystem::temp_directory_path() / "testDeltaTriplesWithLog";
+  std::filesystem::path logFile = tmpFile.string() + ".wal";
+  std::filesystem::remove(tmpFile);
+  std::filesystem::remove(logFile);
+  absl::Cleanup cleanup{[&tmpFile, &logFile]() {
+    std::filesystem::remove(tmpFile);
+    std::filesystem::remove(logFile);
+  }};
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  const auto& index = testQec->getIndex().getImpl();
+  auto restore = [this, &tmpFile]() {
+    auto deltaTriples = std::make_unique<DeltaTriples>(testQec->getIndex());
+    deltaTriples->setPersists(tmpFile);
+    deltaTriples->readFromDisk();
+    return deltaTriples;
+  };
+  {
+    auto deltaTriples = restore();
+    auto& localVocab = deltaTriples->localVocab();
+    deltaTriples->insertTriples(
+        cancellationHandle, makeIdTriples(index, localVocab, {"<a> <b> <c>"}));
+    // The first write is a checkpoint.
+    deltaTriples->writeToDisk();
+    EXPECT_TRUE(std::filesystem::exists(tmpFile));
+    EXPECT_FALSE(std::filesystem::exists(logFile));
+
+    // The following writes only append to the log.
+    deltaTriples->insertTriples(
+        cancellationHandle, makeIdTriples(index, localVocab, {"<a> <b> <d>"}));
+    deltaTriples->deleteTriples(
+        cancellationHandle, makeIdTriples(index, localVocab, {"<a> <b> <c>"}));
+    deltaTriples->writeToDisk();
+    EXPECT_TRUE(std::filesystem::exists(logFile));
+    deltaTriples->deleteTriples(
+        cancellationHandle, makeIdTriples(index, localVocab, {"<x> <y> <z>"}));
+    deltaTriples->writeToDisk();
+    EXPECT_THAT(*deltaTriples, NumTriples(1, 2, 3));
+  }
+  {
+    // The state is restored from the checkpoint and the log (without a
+    // proper shutdown).
+    auto deltaTriples = restore();
+    EXPECT_THAT(*deltaTriples, NumTriples(1, 2, 3));
+    // Clearing the delta triples can't be expressed in the log, so the next
+    // write is a checkpoint.
+    deltaTriples->clear();
+    deltaTriples->writeToDisk();
+    EXPECT_FALSE(std::filesystem::exists(logFile));
+  }
+  EXPECT_THAT(*restore(), NumTriples(0, 0, 0));
+}
+
 // _____________________________________________________________________________
 TEST_F(DeltaTriplesTest, copyLocalVocab) {
   using namespace ::testing;
@@ -1069,6 +1282,69 @@ TEST_F(DeltaTriplesTest, vacuum) {
   EXPECT_EQ(result["internal"]["totalKept"], 0);
 }
 
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, locateManyTriplesInParallel) {
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  DeltaTriples deltaTriples(testQec->getIndex());
+  auto& index = testQec->getIndex().getImpl();
+  LocalVocab localVocab;
+
+  // Enough triples s.t. the permutations are handled in parallel.
+  std::vector<std::string> turtles;
+  for (size_t i = 0; i < 10'000; ++i) {
+    turtles.push_back(absl::StrCat("<s", i % 100, "> <p", i % 7, "> <o", i,
+                                   ">"));
+  }
+  auto triples = makeIdTriples(index, localVocab, turtles);
+  ql::ranges::sort(triples);
+  deltaTriples.insertTriples(cancellationHandle, triples);
+  EXPECT_THAT(deltaTriples, NumTriples(10'000, 0, 10'000));
+
+  // Deleting the triples again uses the handles of all the permutations.
+  deltaTriples.deleteTriples(cancellationHandle, triples);
+  EXPECT_THAT(deltaTriples, NumTriples(0, 10'000, 10'000));
+}
+
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, isAutomaticVacuumDue) {
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  DeltaTriples deltaTriples(testQec->getIndex());
+  auto& index = testQec->getIndex().getImpl();
+  LocalVocab localVocab;
+  auto insert = [&](const std::vector<std::string>& triples) {
+    deltaTriples.insertTriples(cancellationHandle,
+                               makeIdTriples(index, localVocab, triples));
+  };
+
+  // The automatic vacuuming is disabled by default.
+  insert({"<a> <upp> <A>", "<a> <upp> <newval>"});
+  EXPECT_FALSE(deltaTriples.isAutomaticVacuumDue());
+
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::vacuumAfterNumDeltaTriples_>(3ul);
+  EXPECT_FALSE(deltaTriples.isAutomaticVacuumDue());
+  insert({"<X> <Y> <Z>"});
+  EXPECT_TRUE(deltaTriples.isAutomaticVacuumDue());
+
+  // Only the triples that are added after the vacuuming count. `<a> <upp> <A>`
+  // is contained in the index and thus removed by the vacuuming.
+  auto cleanup2 =
+      setRuntimeParameterForTest<&RuntimeParameters::vacuumMinimumBlockSize_>(
+          0ul);
+  deltaTriples.vacuum(cancellationHandle);
+  EXPECT_THAT(deltaTriples, NumTriples(2, 0, 2));
+  EXPECT_FALSE(deltaTriples.isAutomaticVacuumDue());
+  insert({"<X> <Y> <Z2>", "<X> <Y> <Z3>"});
+  EXPECT_FALSE(deltaTriples.isAutomaticVacuumDue());
+  insert({"<X> <Y> <Z4>"});
+  EXPECT_TRUE(deltaTriples.isAutomaticVacuumDue());
+
+  deltaTriples.clear();
+  EXPECT_FALSE(deltaTriples.isAutomaticVacuumDue());
+}
+
 // _____________________________________________________________________________
 TEST_F(DeltaTriplesTest, remapId) {
   auto I = &Id::makeFromInt;
@@ -40,15 +40,16 @@ TEST(EnumWithStrings, VocabularyTypeEnum) {
   EXPECT_THAT(all, ::testing::ElementsAre(
                        V::InMemoryUncompressed, V::OnDiskUncompressed,
                        V::InMemoryCompressed, V::OnDiskCompressed,
-                       V::OnDiskCompressedGeoSplit));
+                       V::OnDiskCompressedGeoSplit, V::OnDiskFrontCoded,
+                       V::OnDiskCompressedLanguageSplit));
 
   ad_utility::HashMap<V, size_t> h;
   for (size_t i = 0; i < 50000; ++i) {
     h[V::random()]++;
   }
   for (auto v : all) {
-    EXPECT_GT(h[v], 7000);
-    EXPECT_LT(h[v], 13000);
+    EXPECT_GT(h[v], 5500);
+    EXPECT_LT(h[v], 9000);
   }
 
   EXPECT_THROW(V::fromString("not-a-valid-type"), std::runtime_error);
@@ -270,18 +270,133 @@ TEST(ExportIds, idsToStringAndTypeBatchMatchesIndividualLookups) {
       Id::makeUndefined(),
   };
 
-  // `idsToStringAndType` requires the input to be sorted by `ValueId`.
+  auto checkBatch = [&index, &localVocab](const std::vector<Id>& ids) {
+    auto batchResults = ql::exportIds::idsToStringAndType(
+        index, ql::span<const Id>{ids}, localVocab);
+
+    ASSERT_EQ(batchResults.size(), ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+      EXPECT_EQ(batchResults[i],
+                ql::exportIds::idToStringAndType(index, ids[i], localVocab))
+          << "Mismatch at index " << i;
+    }
+  };
+  // Unsorted input with duplicates (the vocabulary words are sorted and
+  // deduplicated internally), and input that is sorted by `ValueId` (as in the
+  // `ConstructBatchEvaluator`).
+  auto withDuplicates = ids;
+  withDuplicates.push_back(getId("<p>"));
+  withDuplicates.push_back(getId("<s>"));
+  checkBatch(withDuplicates);
   ql::ranges::sort(ids);
+  checkBatch(ids);
+}
+
+// _____________________________________________________________________________
+// Verify that `idsToLiterals` produces identical results to calling
+// `idToLiteral` for each ID individually.
+TEST(ExportIds, idsToLiteralsMatchesIndividualLookups) {
+  std::string kg =
+      "<s> <p> \"something\" . <s> <p> 1 . <s> <p> "
+      "\"some\"^^<http://www.w3.org/2001/XMLSchema#string> . <s> <p> "
+      "\"dadudeldu\"^^<http://www.dadudeldu.com/NoSuchDatatype> .";
+  auto qec = ad_utility::testing::getQec(kg);
+  const auto& index = qec->getIndex().getImpl();
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  LocalVocab localVocab{};
+  std::vector<Id> ids{
+      getId("\"something\""),
+      getId("<s>"),
+      Id::makeFromInt(1),
+      getId("\"dadudeldu\"^^<http://www.dadudeldu.com/NoSuchDatatype>"),
+      getId("\"some\"^^<http://www.w3.org/2001/XMLSchema#string>"),
+      Id::makeUndefined(),
+      getId("\"something\""),
+      getId("<p>")};
+  for (bool onlyLiteralsWithXsdString : {false, true}) {
+    auto batchResults = ql::exportIds::idsToLiterals(
+        index, ids, localVocab, onlyLiteralsWithXsdString);
+    ASSERT_EQ(batchResults.size(), ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+      EXPECT_EQ(batchResults[i],
+                ql::exportIds::idToLiteral(index, ids[i], localVocab,
+                                           onlyLiteralsWithXsdString))
+          << "Mismatch at index " << i;
+    }
+  }
+  EXPECT_TRUE(ql::exportIds::idsToLiterals(index, {}, localVocab).empty());
+}
 
-  auto batchResults = ql::exportIds::idsToStringAndType(
-      index, ql::span<const Id>{ids}, localVocab);
+// _____________________________________________________________________________
+TEST(ExportIds, vocabDecodeCache) {
+  auto qec = ad_utility::testing::getQec(
+      "<s> <p> \"something\"@en . <s> <p> <o> . <s> <q> 42 .");
+  const auto& index = qec->getIndex().getImpl();
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  LocalVocab localVocab{};
+  std::vector<Id> ids{getId("\"something\"@en"), getId("<o>"),
+                      Id::makeFromInt(42), getId("<s>"),
+                      getId("\"something\"@en")};
+  std::vector<VocabIndex> vocabIndices;
+  for (Id id : ids) {
+    if (id.getDatatype() == Datatype::VocabIndex) {
+      vocabIndices.push_back(id.getVocabIndex());
+    }
+  }
 
-  ASSERT_EQ(batchResults.size(), ids.size());
-  for (size_t i = 0; i < ids.size(); ++i) {
-    EXPECT_EQ(batchResults[i],
-              ql::exportIds::idToStringAndType(index, ids[i], localVocab))
-        << "Mismatch at index " << i;
+  VocabDecodeCache cache{ad_utility::MemorySize::megabytes(1)};
+  EXPECT_TRUE(cache.isEnabled());
+  // The duplicate of the literal is decoded twice, because both occurrences
+  // are looked up before any of the words is inserted.
+  auto words = cache.getOrDecode(index, vocabIndices);
+  ASSERT_EQ(words.size(), vocabIndices.size());
+  for (size_t i = 0; i < words.size(); ++i) {
+    EXPECT_EQ(*words[i], index.indexToString(vocabIndices[i]));
+  }
+  auto statistics = cache.getStatistics();
+  EXPECT_EQ(statistics.numHits_, 0u);
+  EXPECT_EQ(statistics.numMisses_, 4u);
+  EXPECT_EQ(statistics.numEntries_, 3u);
+
+  // All the following lookups are hits.
+  EXPECT_EQ(*cache.getOrDecode(index, vocabIndices[1]),
+            index.indexToString(vocabIndices[1]));
+  EXPECT_EQ(cache.getOrDecode(index, vocabIndices[0]), words[0]);
+  for (bool onlyLiteralsWithXsdString : {false, true}) {
+    auto results = ql::exportIds::idsToLiterals(
+        index, ids, localVocab, onlyLiteralsWithXsdString, &cache);
+    ASSERT_EQ(results.size(), ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+      EXPECT_EQ(results[i],
+                ql::exportIds::idToLiteral(index, ids[i], localVocab,
+                                           onlyLiteralsWithXsdString, &cache));
+      EXPECT_EQ(results[i],
+                ql::exportIds::idToLiteral(index, ids[i], localVocab,
+                                           onlyLiteralsWithXsdString));
+    }
+  }
+  statistics = cache.getStatistics();
+  EXPECT_EQ(statistics.numMisses_, 4u);
+  EXPECT_EQ(statistics.numHits_, 2u + 2 * (4u + 4u));
+
+  // A cache with a maximal size of zero still returns the correct words, but
+  // neither stores them nor counts any hits or misses.
+  VocabDecodeCache disabledCache{ad_utility::MemorySize::bytes(0)};
+  EXPECT_FALSE(disabledCache.isEnabled());
+  auto uncachedWords = disabledCache.getOrDecode(index, vocabIndices);
+  ASSERT_EQ(uncachedWords.size(), vocabIndices.size());
+  for (size_t i = 0; i < words.size(); ++i) {
+    EXPECT_EQ(*uncachedWords[i], *words[i]);
   }
+  EXPECT_EQ(*disabledCache.getOrDecode(index, vocabIndices[2]), *words[2]);
+  statistics = disabledCache.getStatistics();
+  EXPECT_EQ(statistics.numHits_, 0u);
+  EXPECT_EQ(statistics.numMisses_, 0u);
+  EXPECT_EQ(statistics.numEntries_, 0u);
+
+  // Each `QueryExecutionContext` has its own cache.
+  EXPECT_NE(&qec->vocabDecodeCache(),
+            &ad_utility::testing::getQec("<a> <b> <c>")->vocabDecodeCache());
 }
 
 // _____________________________________________________________________________
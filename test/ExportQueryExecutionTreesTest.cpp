@@ -1607,8 +1607,8 @@ TEST_P(StreamableMediaTypesFixture, CancellationCancelsStream) {
 
 INSTANTIATE_TEST_SUITE_P(StreamableMediaTypes, StreamableMediaTypesFixture,
                          ::testing::Values(turtle, sparqlXml, tsv, csv,
-                                           octetStream, sparqlJson,
-                                           qleverJson));
+                                           octetStream, sparqlJson, qleverJson,
+                                           arrowStream));
 
 // TODO<joka921> Unit tests for the more complex CONSTRUCT export (combination
 // between constants and stuff from the knowledge graph).
@@ -2036,3 +2036,69 @@ TEST(ExportQueryExecutionTrees, SparqlJsonWithMetaField) {
     ASSERT_FALSE(result.contains("meta"));
   }
 }
+
+// _____________________________________________________________________________
+// The rows of a SELECT result are converted in chunks, which are formatted in
+// parallel if `select-export-num-threads` is larger than one. The result must
+// not depend on the number of threads, in particular the chunks have to be
+// exported in the order of the rows.
+TEST(ExportQueryExecutionTrees, ParallelChunkedSelectExport) {
+  // More rows than fit into a single chunk; the subject and the literal
+  // occur in many rows of each chunk.
+  constexpr size_t numTriples = 3000;
+  std::string kg;
+  for (size_t i = 0; i < numTriples; ++i) {
+    absl::StrAppend(&kg, "<s> <p> <o", i, "> . <o", i, "> <q> \"x\" . ");
+  }
+  std::string query =
+      "SELECT ?o ?s ?x WHERE { ?s <p> ?o . OPTIONAL { ?o <q> ?x } }";
+
+  auto exportWithThreads = [&](size_t numThreads,
+                               ad_utility::MediaType mediaType) {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::selectExportNumThreads_>(numThreads);
+    return runQueryStreamableResult(kg, query, mediaType);
+  };
+
+  for (auto mediaType : {tsv, csv, sparqlJson, sparqlXml}) {
+    auto expected = exportWithThreads(1, mediaType);
+    for (size_t numThreads : {2, 8}) {
+      EXPECT_EQ(exportWithThreads(numThreads, mediaType), expected);
+    }
+  }
+
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::selectExportNumThreads_>(
+          4);
+  auto tsvResult = runQueryStreamableResult(kg, query, tsv);
+  EXPECT_EQ(ql::ranges::count(tsvResult, '\n'), numTriples + 1);
+  EXPECT_THAT(tsvResult, HasSubstr("\n<o0>\t<s>\t\"x\"\n"));
+  auto jsonResult = runJSONQuery(kg, query, sparqlJson);
+  const auto& bindings = jsonResult["results"]["bindings"];
+  ASSERT_EQ(bindings.size(), numTriples);
+  for (const auto& binding : bindings) {
+    EXPECT_EQ(binding["s"]["value"], "s");
+    EXPECT_EQ(binding["x"]["value"], "x");
+  }
+}
+
+// _____________________________________________________________________________
+// The Arrow export consists of the schema, one record batch per chunk of rows,
+// and the end-of-stream marker. The encoding itself is tested in
+// `ArrowStreamWriterTest.cpp`.
+TEST(ExportQueryExecutionTrees, ArrowExport) {
+  std::string kg = "<s> <p> 42 . <s> <p> \"abc\"@en . <s> <q> <o>";
+  std::string query = "SELECT ?o ?unbound WHERE { <s> <p> ?o }";
+  auto result = runQueryStreamableResult(kg, query, arrowStream);
+  std::string continuationMarker(4, '\xFF');
+  EXPECT_THAT(result, ::testing::StartsWith(continuationMarker));
+  EXPECT_THAT(result, EndsWith(continuationMarker + std::string(4, '\0')));
+  EXPECT_THAT(result, HasSubstr("unbound"));
+  EXPECT_THAT(result, HasSubstr("42"));
+  EXPECT_THAT(result, HasSubstr("\"abc\"@en"));
+  EXPECT_THAT(result, ::testing::Not(HasSubstr("<o>")));
+
+  // The Arrow export is not supported for CONSTRUCT queries.
+  EXPECT_ANY_THROW(runQueryStreamableResult(
+      kg, "CONSTRUCT { <s> <p> ?o } WHERE { <s> <p> ?o }", arrowStream));
+}
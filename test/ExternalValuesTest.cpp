@@ -17,6 +17,7 @@
 #include "engine/ExternalValues.h"
 #include "engine/Operation.h"
 #include "engine/Result.h"
+#include "engine/Sort.h"
 #include "engine/idTable/IdTable.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
@@ -44,11 +45,12 @@ TEST(ExternalValues, basicMethods) {
   // values).
   EXPECT_FALSE(externalValuesOp.knownEmptyResult());
 
-  // Check that the operation is uncachable.
+  // Check that the result of the operation is never stored in the cache, but
+  // that it has a cache key that contains the values.
   EXPECT_FALSE(externalValuesOp.canResultBeCached());
-  AD_EXPECT_THROW_WITH_MESSAGE(
-      externalValuesOp.getCacheKey(),
-      ::testing::HasSubstr("Caching must be disabled"));
+  EXPECT_THAT(externalValuesOp.getCacheKey(),
+              ::testing::AllOf(::testing::StartsWith("EXTERNAL VALUES"),
+                               ::testing::HasSubstr("42")));
 
   // Check other basic methods inherited from `Values`.
   EXPECT_EQ(externalValuesOp.getSizeEstimate(), 3u);
@@ -122,16 +124,10 @@ TEST(ExternalValues, updateValues) {
 
     // Check that the size changed.
     EXPECT_EQ(externalValuesOp.getSizeEstimate(), 3u);
-    if (cachingDisabled) {
-      auto res = externalValuesOp.computeResultOnlyForTesting();
-      EXPECT_THAT(res.idTable(),
-                  matchesIdTableFromVector({{10, 20}, {30, 40}, {50, 60}},
-                                           &Id::makeFromInt));
-    } else {
-      AD_EXPECT_THROW_WITH_MESSAGE(
-          externalValuesOp.computeResultOnlyForTesting(),
-          ::testing::HasSubstr("caching is disabled"));
-    }
+    auto res = externalValuesOp.computeResultOnlyForTesting();
+    EXPECT_THAT(res.idTable(),
+                matchesIdTableFromVector({{10, 20}, {30, 40}, {50, 60}},
+                                         &Id::makeFromInt));
   };
   runTest(false);
   runTest(true);
@@ -206,3 +202,36 @@ TEST(ExternalValues, getExternalValues) {
   EXPECT_EQ(collected[0], &externalValuesOp);
   EXPECT_EQ(collected[0]->getName(), "collect-test");
 }
+
+// Test that the cache keys of a tree with `ExternalValues` follow the values,
+// s.t. results that were computed for other values are not reused.
+TEST(ExternalValues, cacheKeysFollowTheValues) {
+  auto qec = ad_utility::testing::getQec();
+  qec->clearCacheUnpinnedOnly();
+  auto valuesTree = ad_utility::makeExecutionTree<ExternalValues>(
+      qec, parsedQuery::SparqlValues{{Variable{"?x"}}, {{TC{3}}, {TC{1}}}},
+      "cache-test");
+  auto sortTree = ad_utility::makeExecutionTree<Sort>(
+      qec, valuesTree, std::vector<ColumnIndex>{0});
+  auto cacheKey = sortTree->getCacheKey();
+  EXPECT_THAT(sortTree->getResult()->idTable(),
+              matchesIdTableFromVector({{1}, {3}}, &Id::makeFromInt));
+
+  std::vector<ExternalValues*> externalValues;
+  sortTree->getRootOperation()->getExternalValues(externalValues);
+  ASSERT_EQ(externalValues.size(), 1u);
+  externalValues[0]->updateValues({{Variable{"?x"}}, {{TC{2}}}});
+  sortTree->updateCacheKeysRecursively();
+  EXPECT_NE(sortTree->getCacheKey(), cacheKey);
+  EXPECT_THAT(sortTree->getResult()->idTable(),
+              matchesIdTableFromVector({{2}}, &Id::makeFromInt));
+
+  // For the original values, the cached result of the sort is reused.
+  externalValues[0]->updateValues({{Variable{"?x"}}, {{TC{3}}, {TC{1}}}});
+  sortTree->updateCacheKeysRecursively();
+  EXPECT_EQ(sortTree->getCacheKey(), cacheKey);
+  EXPECT_THAT(sortTree->getResult()->idTable(),
+              matchesIdTableFromVector({{1}, {3}}, &Id::makeFromInt));
+  EXPECT_EQ(sortTree->getRootOperation()->runtimeInfo().cacheStatus_,
+            ad_utility::CacheStatus::cachedNotPinned);
+}
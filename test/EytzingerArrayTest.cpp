@@ -0,0 +1,47 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "util/EytzingerArray.h"
+
+using ad_utility::EytzingerArray;
+
+// _____________________________________________________________________________
+TEST(EytzingerArray, partitionPoint) {
+  // Test all sizes up to a few complete trees, s.t. both complete and
+  // incomplete trees are covered.
+  for (int numElements = 0; numElements < 70; ++numElements) {
+    // Sorted elements with duplicates.
+    std::vector<int> sorted;
+    for (int i = 0; i < numElements; ++i) {
+      sorted.push_back(i / 3);
+    }
+    EytzingerArray<int> array{sorted};
+    EXPECT_EQ(array.size(), sorted.size());
+    for (int bound = -1; bound <= numElements / 3 + 1; ++bound) {
+      auto pred = [bound](int x) { return x < bound; };
+      size_t expected =
+          std::partition_point(sorted.begin(), sorted.end(), pred) -
+          sorted.begin();
+      EXPECT_EQ(array.partitionPoint(pred), expected)
+          << "numElements: " << numElements << ", bound: " << bound;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(EytzingerArray, defaultConstructed) {
+  EytzingerArray<int> array;
+  EXPECT_EQ(array.size(), 0u);
+  EXPECT_EQ(array.partitionPoint([](int) { return true; }), 0u);
+}
@@ -52,6 +52,24 @@ TEST(File, move) {
   ASSERT_EQ(0u, fileRead3.read(s.data(), 9));
   ad_utility::deleteFile(filename);
 }
+
+// `adviseWillNeed` is only a hint, it must not change the file or the results
+// of subsequent reads, even for ranges beyond the end of the file.
+TEST(File, adviseWillNeed) {
+  std::string filename = "testFileAdviseWillNeed.tmp";
+  File fileWrite(filename, "w");
+  fileWrite.write("abcdef", 6);
+  fileWrite.close();
+
+  File fileRead(filename, "r");
+  fileRead.adviseWillNeed(2, 3);
+  fileRead.adviseWillNeed(0, 1000);
+  std::string s;
+  s.resize(3);
+  ASSERT_EQ(fileRead.read(s.data(), 3, 2), 3);
+  ASSERT_EQ(s, "cde");
+  ad_utility::deleteFile(filename);
+}
 }  // namespace ad_utility
 
 TEST(File, makeFilestream) {
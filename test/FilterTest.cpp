@@ -5,16 +5,19 @@
 #include <gmock/gmock.h>
 
 #include "./PrefilterExpressionTestHelpers.h"
+#include "engine/Bind.h"
 #include "engine/Filter.h"
 #include "engine/IndexScan.h"
 #include "engine/ValuesForTesting.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
+#include "util/GTestHelpers.h"
 #include "util/IdTableHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
 #include "util/RuntimeParametersTestHelpers.h"
+#include "util/TripleComponentTestHelpers.h"
 
 using ::testing::ElementsAre;
 using ::testing::Eq;
@@ -63,6 +66,21 @@ void checkSetPrefilterExpressionVariablePair(
   }
 }
 
+// Return the result of a `Filter` with the `expression` on the `table`, the
+// columns of which are bound to `?x`, `?y`, and `?z`.
+IdTable computeFilter(QueryExecutionContext* qec, const IdTable& table,
+                      sparqlExpression::SparqlExpression::Ptr expression) {
+  qec->getQueryTreeCache().clearAll();
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, table.clone(),
+      std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"},
+                                           Variable{"?z"}});
+  Filter filter{qec, std::move(subtree), {std::move(expression), "filter"}};
+  return filter.getResult(false, ComputationMode::FULLY_MATERIALIZED)
+      ->idTable()
+      .clone();
+}
+
 }  // namespace
 
 // _____________________________________________________________________________
@@ -266,3 +284,316 @@ TEST(Filter, clone) {
   EXPECT_THAT(filter, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), filter.getDescriptor());
 }
+
+// _____________________________________________________________________________
+TEST(Filter, filterKernels) {
+  using namespace makeSparqlExpression;
+  using sparqlExpression::FilterKernel;
+  std::string kg =
+      "<a> <p> \"x\"@en . <b> <p> \"y\"@de . <c> <p> \"z\" . <c> <p> <e> .";
+  QueryExecutionContext* qec = ad_utility::testing::getQec(kg);
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  auto I = ad_utility::testing::IntId;
+  auto D = ad_utility::testing::DoubleId;
+  Id U = Id::makeUndefined();
+  Id a = getId("<a>");
+  Id e = getId("<e>");
+  Id en = getId("\"x\"@en");
+  Id de = getId("\"y\"@de");
+  Id z = getId("\"z\"");
+  auto table = makeIdTableFromVector({{I(1), I(2), a},
+                                      {I(3), D(3.0), en},
+                                      {D(2.5), I(1), de},
+                                      {U, I(4), z},
+                                      {I(5), U, U},
+                                      {a, a, e},
+                                      {z, I(3), I(7)}});
+  Variable x{"?x"};
+  Variable y{"?y"};
+  Variable zVar{"?z"};
+  auto lang = [](const Variable& var) {
+    return makeLangExpression(std::make_unique<VariableExpression>(var));
+  };
+  auto bound = [](const Variable& var) {
+    return makeBoundExpression(std::make_unique<VariableExpression>(var));
+  };
+  auto literal = [](std::string_view s,
+                    std::string_view langtag = "") -> SparqlExpression::Ptr {
+    return std::make_unique<StringLiteralExpression>(
+        ad_utility::testing::tripleComponentLiteral(s, langtag));
+  };
+
+  // Check that the `expression` is evaluated by a `FilterKernel` iff
+  // `isSupported` is true, and that the result is the same as the one of the
+  // generic evaluation.
+  auto check = [&](auto makeExpression, bool isSupported,
+                   ad_utility::source_location l =
+                       ad_utility::source_location::current()) {
+    auto t = generateLocationTrace(l);
+    EXPECT_EQ(FilterKernel::fromExpression(*makeExpression()).has_value(),
+              isSupported);
+    IdTable withKernels = computeFilter(qec, table, makeExpression());
+    IdTable withoutKernels = [&]() {
+      auto cleanup = setRuntimeParameterForTest<
+          &RuntimeParameters::enableFilterKernels_>(false);
+      return computeFilter(qec, table, makeExpression());
+    }();
+    EXPECT_EQ(withKernels, withoutKernels);
+    return withKernels;
+  };
+
+  EXPECT_EQ(check([&]() { return ltSprql(x, I(3)); }, true),
+            makeIdTableFromVector({{I(1), I(2), a}, {D(2.5), I(1), de}}));
+  check([&]() { return geSprql(D(2.5), x); }, true);
+  check([&]() { return neqSprql(x, I(5)); }, true);
+  check([&]() { return eqSprql(x, y); }, true);
+  check([&]() { return gtSprql(y, x); }, true);
+  check([&]() { return eqSprql(x, literal("\"z\"")); }, true);
+  check([&]() { return ltSprql(literal("\"notInVocab\""), zVar); }, true);
+  EXPECT_EQ(check([&]() { return bound(y); }, true).numRows(), 6u);
+  EXPECT_EQ(check([&]() { return isIriSprql(zVar); }, true),
+            makeIdTableFromVector({{I(1), I(2), a}, {a, a, e}}));
+  EXPECT_EQ(check([&]() { return eqSprql(lang(zVar), literal("\"en\"")); },
+                  true),
+            makeIdTableFromVector({{I(3), D(3.0), en}}));
+  check([&]() { return eqSprql(literal("\"\""), lang(zVar)); }, true);
+  EXPECT_EQ(
+      check(
+          [&]() {
+            return andSprqlExpr(andSprqlExpr(gtSprql(x, D(0.5)), bound(y)),
+                                isIriSprql(zVar));
+          },
+          true),
+      makeIdTableFromVector({{I(1), I(2), a}}));
+  check([&]() { return andSprqlExpr(bound(x), bound(Variable{"?unbound"})); },
+        true);
+
+  // Expressions that are not supported by the kernels.
+  check([&]() { return orSprqlExpr(bound(x), isIriSprql(zVar)); }, false);
+  check([&]() { return andSprqlExpr(bound(x), notSprqlExpr(bound(y))); },
+        false);
+  check([&]() { return eqSprql(lang(zVar), literal("\"en\"", "@de")); },
+        false);
+}
+
+// _____________________________________________________________________________
+TEST(Filter, stripColumns) {
+  using namespace makeSparqlExpression;
+  QueryExecutionContext* qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+  auto I = ad_utility::testing::IntId;
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec,
+      makeIdTableFromVector({{1, 10, 5}, {2, 20, 1}, {3, 30, 7}, {4, 40, 2}},
+                            I),
+      std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"},
+                                           Variable{"?z"}},
+      false, std::vector<ColumnIndex>{0});
+  auto tree = ad_utility::makeExecutionTree<Filter>(
+      qec, subtree,
+      sparqlExpression::SparqlExpressionPimpl{
+          gtSprql(Variable{"?z"}, I(3)), "?z > 3"});
+
+  // The `?z` column is only needed by the filter, so it doesn't have to be
+  // copied to the result.
+  auto stripped = QueryExecutionTree::makeTreeWithStrippedColumns(
+      tree, {Variable{"?x"}, Variable{"?y"}});
+  auto filter =
+      std::dynamic_pointer_cast<const Filter>(stripped->getRootOperation());
+  ASSERT_NE(filter, nullptr);
+  EXPECT_EQ(filter->getSubtree(), subtree);
+  EXPECT_EQ(filter->getResultWidth(), 2u);
+  EXPECT_THAT(filter->getExternallyVisibleVariableColumns(),
+              ::testing::UnorderedElementsAre(
+                  ::testing::Pair(Variable{"?x"}, makeAlwaysDefinedColumn(0)),
+                  ::testing::Pair(Variable{"?y"}, makeAlwaysDefinedColumn(1))));
+  EXPECT_THAT(filter->resultSortedOn(), ElementsAre(0));
+  EXPECT_NE(filter->getCacheKey(), tree->getRootOperation()->getCacheKey());
+
+  for (auto mode : {ComputationMode::FULLY_MATERIALIZED,
+                    ComputationMode::LAZY_IF_SUPPORTED}) {
+    for (bool enableKernels : {true, false}) {
+      auto cleanup = setRuntimeParameterForTest<
+          &RuntimeParameters::enableFilterKernels_>(enableKernels);
+      qec->getQueryTreeCache().clearAll();
+      auto result = stripped->getResult(false, mode);
+      IdTable table{2, ad_utility::testing::makeAllocator()};
+      if (result->isFullyMaterialized()) {
+        table = result->idTable().clone();
+      } else {
+        for (auto& pair : result->idTables()) {
+          table.insertAtEnd(pair.idTable_);
+        }
+      }
+      EXPECT_EQ(table, makeIdTableFromVector({{1, 10}, {3, 30}}, I));
+    }
+  }
+
+  // The projection is part of the clone.
+  auto clone = filter->clone();
+  EXPECT_EQ(clone->getResultWidth(), 2u);
+  EXPECT_EQ(clone->getCacheKey(), filter->getCacheKey());
+}
+
+// _____________________________________________________________________________
+TEST(Filter, lazyEvaluationWithMultipleThreads) {
+  using namespace makeSparqlExpression;
+  QueryExecutionContext* qec = ad_utility::testing::getQec();
+  auto I = ad_utility::testing::IntId;
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::lazyPipelineNumThreads_>(
+          4);
+  for (bool isSorted : {true, false}) {
+    qec->getQueryTreeCache().clearAll();
+    std::vector<IdTable> idTables;
+    std::vector<IdTable> expected;
+    for (int64_t i = 0; i < 50; ++i) {
+      idTables.push_back(makeIdTableFromVector({{i}, {100 + i}}, I));
+      expected.push_back(makeIdTableFromVector({{i}}, I));
+    }
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(idTables),
+        std::vector<std::optional<Variable>>{Variable{"?x"}}, false,
+        isSorted ? std::vector<ColumnIndex>{0} : std::vector<ColumnIndex>{});
+    Filter filter{qec,
+                  std::move(subtree),
+                  {ltSprql(Variable{"?x"}, I(100)), "?x < 100"}};
+
+    auto result = filter.getResult(false, ComputationMode::LAZY_IF_SUPPORTED);
+    ASSERT_FALSE(result->isFullyMaterialized());
+    auto blocks = toVector(result->idTables());
+    // If the result is sorted, the order of the blocks is preserved, otherwise
+    // it is unspecified.
+    if (!isSorted) {
+      ql::ranges::sort(blocks, {}, [](const IdTable& table) {
+        return table(0, 0).getInt();
+      });
+    }
+    EXPECT_EQ(blocks, expected);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(Filter, fusedBinds) {
+  using namespace makeSparqlExpression;
+  using V = Variable;
+  QueryExecutionContext* qec = ad_utility::testing::getQec();
+  auto I = ad_utility::testing::IntId;
+  auto var = [](const std::string& name) {
+    return std::make_unique<sparqlExpression::VariableExpression>(V{name});
+  };
+  auto makeTree = [&](bool lazy) {
+    std::vector<IdTable> idTables;
+    idTables.push_back(makeIdTableFromVector({{1, 10}, {2, 20}}, I));
+    idTables.push_back(makeIdTableFromVector({{3, 30}, {4, 40}}, I));
+    auto values = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(idTables),
+        std::vector<std::optional<Variable>>{V{"?x"}, V{"?y"}}, false,
+        std::vector<ColumnIndex>{0});
+    if (!lazy) {
+      values = ad_utility::makeExecutionTree<ValuesForTesting>(
+          qec, makeIdTableFromVector({{1, 10}, {2, 20}, {3, 30}, {4, 40}}, I),
+          std::vector<std::optional<Variable>>{V{"?x"}, V{"?y"}}, false,
+          std::vector<ColumnIndex>{0});
+    }
+    // `BIND(?y AS ?b) BIND(?x + ?y AS ?a) FILTER(?a > 25)`, only `?a` is
+    // needed by the filter.
+    auto bindB = ad_utility::makeExecutionTree<Bind>(
+        qec, values, parsedQuery::Bind{{var("?y"), "?y"}, V{"?b"}});
+    auto bindA = ad_utility::makeExecutionTree<Bind>(
+        qec, bindB,
+        parsedQuery::Bind{
+            {sparqlExpression::makeAddExpression(var("?x"), var("?y")),
+             "?x + ?y"},
+            V{"?a"}});
+    return std::pair{values,
+                     ad_utility::makeExecutionTree<Filter>(
+                         qec, bindA,
+                         sparqlExpression::SparqlExpressionPimpl{
+                             gtSprql(V{"?a"}, I(25)), "?a > 25"})};
+  };
+
+  for (bool lazy : {true, false}) {
+    auto [values, tree] = makeTree(lazy);
+    auto filter =
+        std::dynamic_pointer_cast<const Filter>(tree->getRootOperation());
+    ASSERT_NE(filter, nullptr);
+    EXPECT_EQ(filter->getSubtree(), values);
+    ASSERT_EQ(filter->getBinds().size(), 2u);
+    // The `BIND` that is needed by the filter is evaluated first.
+    EXPECT_EQ(filter->getBinds()[0]._target, V{"?a"});
+    EXPECT_EQ(filter->getResultWidth(), 4u);
+    EXPECT_THAT(filter->getExternallyVisibleVariableColumns(),
+                ::testing::UnorderedElementsAre(
+                    ::testing::Pair(V{"?x"}, makeAlwaysDefinedColumn(0)),
+                    ::testing::Pair(V{"?y"}, makeAlwaysDefinedColumn(1)),
+                    ::testing::Pair(V{"?a"}, makePossiblyUndefinedColumn(2)),
+                    ::testing::Pair(V{"?b"}, makeAlwaysDefinedColumn(3))));
+    EXPECT_THAT(filter->resultSortedOn(), ElementsAre(0));
+    EXPECT_THAT(filter->getDescriptor(),
+                ::testing::HasSubstr("BIND (?x + ?y AS ?a)"));
+    auto clone = filter->clone();
+    EXPECT_EQ(clone->getCacheKey(), filter->getCacheKey());
+
+    for (auto mode : {ComputationMode::FULLY_MATERIALIZED,
+                      ComputationMode::LAZY_IF_SUPPORTED}) {
+      qec->getQueryTreeCache().clearAll();
+      auto result = tree->getResult(false, mode);
+      IdTable table{4, ad_utility::testing::makeAllocator()};
+      if (result->isFullyMaterialized()) {
+        table = result->idTable().clone();
+      } else {
+        for (auto& pair : result->idTables()) {
+          table.insertAtEnd(pair.idTable_);
+        }
+      }
+      EXPECT_EQ(table,
+                makeIdTableFromVector({{3, 30, 33, 30}, {4, 40, 44, 40}}, I));
+    }
+
+    // Only the `?b` column is stripped, the `?a` column is still needed.
+    auto stripped = QueryExecutionTree::makeTreeWithStrippedColumns(
+        tree, {V{"?x"}, V{"?b"}});
+    qec->getQueryTreeCache().clearAll();
+    EXPECT_EQ(stripped->getResult()->idTable(),
+              makeIdTableFromVector({{3, 30}, {4, 40}}, I));
+  }
+
+  // Without the fusion, the `BIND`s are separate operations.
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::enableBindFilterFusion_>(
+          false);
+  auto [values, tree] = makeTree(false);
+  auto filter =
+      std::dynamic_pointer_cast<const Filter>(tree->getRootOperation());
+  ASSERT_NE(filter, nullptr);
+  EXPECT_TRUE(filter->getBinds().empty());
+  EXPECT_NE(filter->getSubtree(), values);
+}
+
+// _____________________________________________________________________________
+TEST(Filter, parallelEvaluationOfMaterializedInput) {
+  using namespace makeSparqlExpression;
+  QueryExecutionContext* qec = ad_utility::testing::getQec();
+  auto I = ad_utility::testing::IntId;
+  auto numThreads =
+      setRuntimeParameterForTest<&RuntimeParameters::expressionNumThreads_>(4);
+  auto minRows = setRuntimeParameterForTest<
+      &RuntimeParameters::expressionMinRowsPerThread_>(3);
+  VectorTable input;
+  VectorTable expected;
+  for (int64_t i = 0; i < 20; ++i) {
+    input.push_back({i % 7, i, 0});
+    if (i % 7 > 2) {
+      expected.push_back({i % 7, i, 0});
+    }
+  }
+  for (bool enableKernels : {true, false}) {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::enableFilterKernels_>(
+            enableKernels);
+    EXPECT_EQ(computeFilter(qec, makeIdTableFromVector(input, I),
+                            gtSprql(Variable{"?x"}, I(2))),
+              makeIdTableFromVector(expected, I));
+  }
+}
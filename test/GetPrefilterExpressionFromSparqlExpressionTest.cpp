@@ -172,6 +172,61 @@ TEST(GetPrefilterExpressionFromSparqlExpression,
                        pr(gt(DoubleId(10.2)), var));
 }
 
+//______________________________________________________________________________
+// Check that comparisons of `geof:latitude(?x)` or of the distance between `?x`
+// and a constant point with a constant yield a `LatitudeRangeExpression`.
+TEST(GetPrefilterExpressionFromSparqlExpression,
+     getLatitudeRangePrefilterFromSparqlRelational) {
+  using prefilterExpressions::LatitudeRangeExpression;
+  auto* qec = ad_utility::testing::getQec();
+  auto evalAndEqualityCheck =
+      makeEvalAndEqualityCheck(qec->getLocalVocabContext());
+  const Variable var = Variable{"?x"};
+  auto latitude = [&var]() {
+    return makeLatitudeExpression(makeOptLiteralSparqlExpr(var));
+  };
+  auto range = [&var](double min, double max) {
+    return pr(std::make_unique<LatitudeRangeExpression>(min, max), var);
+  };
+  constexpr double eps = 1e-6;
+
+  // geof:latitude(?x) < 40, 40 > geof:latitude(?x) and similar.
+  evalAndEqualityCheck(ltSprql(latitude(), IntId(40)), range(-90, 40 + eps));
+  evalAndEqualityCheck(gtSprql(IntId(40), latitude()), range(-90, 40 + eps));
+  evalAndEqualityCheck(geSprql(latitude(), DoubleId(-12.5)),
+                       range(-12.5 - eps, 90));
+  evalAndEqualityCheck(eqSprql(latitude(), DoubleId(10)),
+                       range(10 - eps, 10 + eps));
+  // No prefilter for `!=`, for a non-numeric constant, or if the range is
+  // the full range of latitudes.
+  evalAndEqualityCheck(neqSprql(latitude(), IntId(40)));
+  evalAndEqualityCheck(ltSprql(latitude(), VocabId(40)));
+  evalAndEqualityCheck(leSprql(latitude(), IntId(90)));
+
+  // geof:distance(?x, POINT(7 48)) <= 10 (kilometers) and similar.
+  const Id point = Id::makeFromGeoPoint(GeoPoint{48, 7});
+  auto distance = [&var, &point]() {
+    return makeDistExpression(makeOptLiteralSparqlExpr(var),
+                              makeOptLiteralSparqlExpr(point));
+  };
+  auto distanceReversed = [&var, &point]() {
+    return makeMetricDistExpression(makeOptLiteralSparqlExpr(point),
+                                    makeOptLiteralSparqlExpr(var));
+  };
+  // The latitude of the point after the (lossy) encoding as an `Id`.
+  const double lat = point.getGeoPoint().getLat();
+  const double diff = LatitudeRangeExpression::maxLatitudeDifference(10'000);
+  evalAndEqualityCheck(leSprql(distance(), IntId(10)),
+                       range(lat - diff, lat + diff));
+  evalAndEqualityCheck(gtSprql(DoubleId(10'000), distanceReversed()),
+                       range(lat - diff, lat + diff));
+  // A lower bound for the distance doesn't restrict the latitude.
+  evalAndEqualityCheck(geSprql(distance(), IntId(10)));
+  // A distance of more than half of the circumference of the earth doesn't
+  // restrict the latitude either.
+  evalAndEqualityCheck(leSprql(distance(), IntId(30'000)));
+}
+
 //______________________________________________________________________________
 // More complex relational SparqlExpressions for which
 // getPrefilterExpressionForMetadata should yield a vector containing the actual
@@ -549,6 +604,45 @@ TEST(GetPrefilterExpressionFromSparqlExpression,
   evalAndEqualityCheck(isNumericSprql((IntId(-0.01))));
 }
 
+// Test PrefilterExpression creation for `LANG(?x) = "en"`,
+// `LANGMATCHES(LANG(?x), "en")` and `DATATYPE(?x) = <iri>`.
+//______________________________________________________________________________
+TEST(GetPrefilterExpressionFromSparqlExpression,
+     getPrefilterExprForLanguageTagAndDatatype) {
+  auto* qec = ad_utility::testing::getQec();
+  auto evalAndEqualityCheck =
+      makeEvalAndEqualityCheck(qec->getLocalVocabContext());
+  const auto varX = Variable{"?x"};
+  const auto varY = Variable{"?y"};
+  const std::string xsdDate = "http://www.w3.org/2001/XMLSchema#date";
+  evalAndEqualityCheck(eqSprql(langSprql(varX), L("\"en\"")),
+                       pr(languageTag("en"), varX));
+  evalAndEqualityCheck(eqSprql(L("\"de\""), langSprql(varY)),
+                       pr(languageTag("de"), varY));
+  evalAndEqualityCheck(notSprqlExpr(eqSprql(langSprql(varX), L("\"en\""))),
+                       pr(notExpr(languageTag("en")), varX));
+  evalAndEqualityCheck(langMatchesSprql(langSprql(varX), L("\"en\"")),
+                       pr(languageTag("*"), varX));
+  evalAndEqualityCheck(langMatchesSprql(langSprql(varX), L("\"*\"")),
+                       pr(languageTag("*"), varX));
+  evalAndEqualityCheck(
+      eqSprql(datatypeSprql(varX), I(absl::StrCat("<", xsdDate, ">"))),
+      pr(datatypeExpr(xsdDate), varX));
+  evalAndEqualityCheck(
+      eqSprql(I(absl::StrCat("<", xsdDate, ">")), datatypeSprql(varY)),
+      pr(datatypeExpr(xsdDate), varY));
+
+  // For the cases below, no prefilter procedure should be available.
+  evalAndEqualityCheck(neqSprql(langSprql(varX), L("\"en\"")));
+  evalAndEqualityCheck(eqSprql(langSprql(varX), varY));
+  evalAndEqualityCheck(eqSprql(langSprql(L("\"en\"")), L("\"en\"")));
+  evalAndEqualityCheck(langMatchesSprql(langSprql(varX), L("\"\"")));
+  evalAndEqualityCheck(langMatchesSprql(varX, L("\"en\"")));
+  evalAndEqualityCheck(eqSprql(datatypeSprql(varX), L("\"en\"")));
+  evalAndEqualityCheck(
+      neqSprql(datatypeSprql(varX), I(absl::StrCat("<", xsdDate, ">"))));
+}
+
 // Test PrefilterExpression creation for SparqlExpression InExpression
 //______________________________________________________________________________
 TEST(GetPrefilterExpressionFromSparqlExpression, getPrefilterExprIsIn) {
@@ -2,6 +2,7 @@
 // Chair of Algorithms and Data Structures
 // Authors: Julian Mundhahs <mundhahj@tf.uni-freiburg.de>
 
+#include <absl/cleanup/cleanup.h>
 #include <gmock/gmock.h>
 
 #include "./ServerTestHelpers.h"
@@ -431,6 +432,51 @@ TEST(GraphStoreProtocolTest, convertTriples) {
                                    iri("<g>"), iri("<a>")}});
 }
 
+// _____________________________________________________________________________________________
+TEST(GraphStoreProtocolTest, parseAndConvertTriples) {
+  auto index = ad_utility::testing::makeTestIndex(TestIndexConfig{});
+  Quads::BlankNodeAdder bn{{}, {}, index.getBlankNodeManager()};
+  // A body that consists of more than one block of the parallel parser.
+  std::string body = "@prefix ex: <http://example.org/> .\n";
+  size_t numTriples = 0;
+  while (body.size() <
+         2 * BLOCKSIZE_TURTLE_PARSING_OF_DATA_UPDATES.getBytes()) {
+    absl::StrAppend(&body, "ex:s", numTriples, " ex:p \"o", numTriples,
+                    "\" .\n");
+    ++numTriples;
+  }
+  auto expected = GraphStoreProtocol::convertTriples(
+      iri("<g>"),
+      GraphStoreProtocol::parseTriples(body, ad_utility::MediaType::turtle),
+      bn);
+  ASSERT_EQ(expected.triples_.size(), numTriples);
+
+  // Both the sequential and the parallel parsing yield the same triples.
+  for (size_t minSizeForParallelParsing : {size_t{0}, body.size() + 1}) {
+    auto& minSize = MIN_SIZE_FOR_PARALLEL_PARSING_OF_GSP_BODIES();
+    auto original = minSize.exchange(minSizeForParallelParsing);
+    absl::Cleanup cleanup{[&minSize, original]() { minSize = original; }};
+    auto converted = GraphStoreProtocol::parseAndConvertTriples(
+        body, ad_utility::MediaType::turtle, iri("<g>"), bn);
+    EXPECT_EQ(converted.triples_, expected.triples_);
+
+    AD_EXPECT_THROW_WITH_MESSAGE(
+        GraphStoreProtocol::parseAndConvertTriples(
+            body, ad_utility::MediaType::json, iri("<g>"), bn),
+        testing::HasSubstr("Mediatype \"application/json\" is not "
+                           "supported"));
+  }
+
+  // Errors in the body are reported also by the parallel parsing.
+  {
+    auto& minSize = MIN_SIZE_FOR_PARALLEL_PARSING_OF_GSP_BODIES();
+    auto original = minSize.exchange(0);
+    absl::Cleanup cleanup{[&minSize, original]() { minSize = original; }};
+    EXPECT_ANY_THROW(GraphStoreProtocol::parseAndConvertTriples(
+        "<a> <b>", ad_utility::MediaType::ntriples, DEFAULT{}, bn));
+  }
+}
+
 // _____________________________________________________________________________________________
 TEST(GraphStoreProtocolTest, EncodedIriManagerUsage) {
   // Create a simple index with default config for now
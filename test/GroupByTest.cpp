@@ -3,6 +3,7 @@
 // Authors: Florian Kramer (florian.kramer@mail.uni-freiburg.de)
 //          Johannes Kalmbach (kalmbach@cs.uni-freiburg.de)
 
+#include <absl/strings/str_cat.h>
 #include <absl/strings/str_join.h>
 #include <gmock/gmock.h>
 
@@ -589,6 +590,53 @@ TEST_F(GroupByOptimizations, checkIfHashMapOptimizationPossible) {
   ASSERT_EQ(aggregateInfo.expr_, avgXPimpl.getPimpl());
 }
 
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, costBasedChoiceOfHashMapOptimization) {
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::groupByHashMapEnabled_>(
+          false);
+  // Create a `GROUP BY ?x` on an unsorted input with `numRows` rows and the
+  // given `multiplicity` of the grouped variable, s.t. a `Sort` is required.
+  auto makeGroupBy = [this](size_t numRows, float multiplicity) {
+    IdTable input{2, ad_utility::testing::makeAllocator()};
+    input.resize(numRows);
+    ql::ranges::fill(input.getColumn(0), I(0));
+    ql::ranges::fill(input.getColumn(1), I(1));
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(input),
+        std::vector<std::optional<Variable>>{varX, varY}, false,
+        std::vector<ColumnIndex>{}, LocalVocab{}, multiplicity);
+    return GroupByImpl{qec, variablesOnlyX,
+                       {Alias{makeCountPimpl(varY), Variable{"?count"}}},
+                       std::move(subtree)};
+  };
+  std::vector<GroupByImpl::Aggregate> countAggregate = {{countYPimpl, 1}};
+
+  // Large input with few groups: The hash map is cheaper.
+  auto fewGroups = makeGroupBy(200'000, 1000);
+  EXPECT_TRUE(fewGroups.isHashMapEstimatedToBeCheaperThanSort());
+  EXPECT_TRUE(
+      fewGroups.checkIfHashMapOptimizationPossible(countAggregate).has_value());
+
+  // Large input with many groups: Sorting is cheaper.
+  auto manyGroups = makeGroupBy(200'000, 2);
+  EXPECT_FALSE(manyGroups.isHashMapEstimatedToBeCheaperThanSort());
+  EXPECT_FALSE(manyGroups.checkIfHashMapOptimizationPossible(countAggregate)
+                   .has_value());
+
+  // Small input: Sorting is cheap anyway.
+  auto smallInput = makeGroupBy(1000, 1000);
+  EXPECT_FALSE(smallInput.isHashMapEstimatedToBeCheaperThanSort());
+
+  // The cost-based choice can be disabled.
+  auto disableCostBased =
+      setRuntimeParameterForTest<&RuntimeParameters::groupByHashMapCostBased_>(
+          false);
+  EXPECT_FALSE(fewGroups.isHashMapEstimatedToBeCheaperThanSort());
+  EXPECT_FALSE(
+      fewGroups.checkIfHashMapOptimizationPossible(countAggregate).has_value());
+}
+
 // _____________________________________________________________________________
 TEST_F(GroupByOptimizations, correctResultForHashMapOptimization) {
   /* Setup query:
@@ -670,6 +718,168 @@ TEST_F(GroupByOptimizations, hashMapOptimizationLazyAndMaterializedInputs) {
   runTest(false);
 }
 
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, hashMapOptimizationParallelAggregation) {
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::groupByHashMapEnabled_>(
+          true);
+  // An input that is large enough to be split between three threads, with
+  // seven groups in the first column.
+  const size_t numRows = 3 * GROUP_BY_HASH_MAP_MIN_ROWS_PER_THREAD + 17;
+  IdTable input{2, ad_utility::testing::makeAllocator()};
+  input.resize(numRows);
+  for (size_t i = 0; i < numRows; ++i) {
+    input(i, 0) = I(static_cast<int64_t>((i * 13) % 7));
+    input(i, 1) = I(static_cast<int64_t>(i % 1000) - 500);
+  }
+
+  auto computeResult = [&](size_t numThreads) {
+    auto threadCleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::groupByHashMapNumThreads_>(numThreads);
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, input.clone(),
+        std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"}});
+    std::vector<Alias> aliases{
+        Alias{makeCountPimpl(varY), Variable{"?count"}},
+        Alias{makeSumPimpl(varY), Variable{"?sum"}},
+        Alias{makeAvgPimpl(varY), Variable{"?avg"}},
+        Alias{makeMinPimpl(varY), Variable{"?min"}},
+        Alias{makeMaxPimpl(varY), Variable{"?max"}},
+        Alias{makeSamplePimpl(varY), Variable{"?sample"}},
+        Alias{makeGroupConcatPimpl(varY, ","), Variable{"?concat"}}};
+    qec->getQueryTreeCache().clearAll();
+    GroupBy groupBy{qec, variablesOnlyX, aliases, std::move(subtree)};
+    return groupBy.computeResultOnlyForTesting();
+  };
+
+  // The parallel aggregation has to yield exactly the same result as the
+  // sequential one, including the order of the values in `GROUP_CONCAT` and
+  // the value chosen by `SAMPLE`. The `LocalVocabIndex` entries of the
+  // `GROUP_CONCAT` column are compared by their contents.
+  auto sequential = computeResult(1);
+  auto parallel = computeResult(4);
+  ASSERT_EQ(sequential.idTable().numRows(), 7);
+  EXPECT_EQ(parallel.idTable(), sequential.idTable());
+}
+
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, sortedGroupByParallelAggregation) {
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::groupByHashMapEnabled_>(
+          false);
+  // A sorted input that is large enough to be split between three threads,
+  // with groups of 1000 rows each.
+  const size_t numRows = 3 * GROUP_BY_SORTED_MIN_ROWS_PER_THREAD + 17;
+  IdTable input{2, ad_utility::testing::makeAllocator()};
+  input.resize(numRows);
+  for (size_t i = 0; i < numRows; ++i) {
+    input(i, 0) = I(static_cast<int64_t>(i / 1000));
+    input(i, 1) = I(static_cast<int64_t>((i * 7) % 1000) - 500);
+  }
+
+  // Compute the result with the given number of threads. If `lazy` is set,
+  // the input is split into two blocks in the middle of a group, and the
+  // blocks of the lazy result are concatenated.
+  auto computeResult = [&](size_t numThreads, bool lazy) {
+    auto threadCleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::groupBySortedNumThreads_>(numThreads);
+    std::vector<IdTable> tables;
+    if (lazy) {
+      const size_t split = numRows / 2 + 500;
+      tables.push_back(input.clone());
+      tables.back().resize(split);
+      IdTable second{2, ad_utility::testing::makeAllocator()};
+      second.insertAtEnd(input, split, numRows);
+      tables.push_back(std::move(second));
+    } else {
+      tables.push_back(input.clone());
+    }
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(tables),
+        std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"}},
+        false, std::vector<ColumnIndex>{0});
+    std::vector<Alias> aliases{
+        Alias{makeCountPimpl(varY), Variable{"?count"}},
+        Alias{makeSumPimpl(varY), Variable{"?sum"}},
+        Alias{makeAvgPimpl(varY), Variable{"?avg"}},
+        Alias{makeMinPimpl(varY), Variable{"?min"}},
+        Alias{makeSamplePimpl(varY), Variable{"?sample"}},
+        Alias{makeGroupConcatPimpl(varY, ","), Variable{"?concat"}}};
+    qec->getQueryTreeCache().clearAll();
+    GroupBy groupBy{qec, variablesOnlyX, aliases, std::move(subtree)};
+    auto result = groupBy.computeResultOnlyForTesting(lazy);
+    IdTable resultTable{aliases.size() + 1,
+                        ad_utility::testing::makeAllocator()};
+    std::vector<LocalVocab> localVocabs;
+    if (result.isFullyMaterialized()) {
+      resultTable.insertAtEnd(result.idTable());
+      localVocabs.push_back(result.localVocab().clone());
+    } else {
+      for (auto& [idTable, localVocab] : result.idTables()) {
+        resultTable.insertAtEnd(idTable);
+        localVocabs.push_back(std::move(localVocab));
+      }
+    }
+    return std::pair{std::move(resultTable), std::move(localVocabs)};
+  };
+
+  // The parallel aggregation has to yield exactly the same result as the
+  // sequential one, including the order of the groups and of the values in
+  // `GROUP_CONCAT`. The `LocalVocabIndex` entries of the `GROUP_CONCAT` column
+  // are compared by their contents.
+  for (bool lazy : {false, true}) {
+    auto sequential = computeResult(1, lazy);
+    auto parallel = computeResult(4, lazy);
+    ASSERT_EQ(sequential.first.numRows(), numRows / 1000 + 1);
+    EXPECT_EQ(parallel.first, sequential.first);
+  }
+}
+
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, groupConcatWithMoreValuesThanOneChunk) {
+  // Two groups, each of which has more values than the
+  // `GroupConcatExpression` converts at once. The input is sorted by the
+  // grouped column, so the order of the values in each group is fixed.
+  const size_t numRows = 2 * GroupConcatExpression::CHUNK_SIZE + 6;
+  IdTable input{2, ad_utility::testing::makeAllocator()};
+  input.resize(numRows);
+  for (size_t i = 0; i < numRows; ++i) {
+    input(i, 0) = I(static_cast<int64_t>(i < numRows / 2 ? 0 : 1));
+    input(i, 1) = I(static_cast<int64_t>(i));
+  }
+
+  // Return the result of the `GROUP_CONCAT` for each group as a string.
+  auto computeResult = [&](bool useHashMap) {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::groupByHashMapEnabled_>(
+            useHashMap);
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, input.clone(),
+        std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"}},
+        false, std::vector<ColumnIndex>{0});
+    std::vector<Alias> aliases{
+        Alias{makeGroupConcatPimpl(varY, ","), Variable{"?concat"}}};
+    qec->getQueryTreeCache().clearAll();
+    GroupBy groupBy{qec, variablesOnlyX, aliases, std::move(subtree)};
+    auto result = groupBy.computeResultOnlyForTesting();
+    std::vector<std::string> concatenations;
+    for (const auto& row : result.idTable()) {
+      concatenations.push_back(
+          row[1].getLocalVocabIndex()->toStringRepresentation());
+    }
+    return concatenations;
+  };
+
+  // The hash map optimization converts the values one by one, so it is the
+  // reference for the chunked conversion in the `GroupConcatExpression`.
+  auto chunked = computeResult(false);
+  ASSERT_EQ(chunked.size(), 2u);
+  EXPECT_EQ(chunked, computeResult(true));
+  EXPECT_THAT(chunked[0], ::testing::StartsWith("\"0,1,2,"));
+  EXPECT_THAT(chunked[1],
+              ::testing::EndsWith(absl::StrCat(",", numRows - 1, "\"")));
+}
+
 // _____________________________________________________________________________
 TEST_F(GroupByOptimizations, correctResultForHashMapOptimizationForCountStar) {
   /* Setup query:
@@ -1534,16 +1744,14 @@ TEST_F(GroupByOptimizations, computeGroupByForSingleIndexScan) {
     auto groupBy = GroupByImpl{qec, groupByVariables, aliases, indexScan};
     ASSERT_EQ(std::nullopt, groupBy.computeGroupByForSingleIndexScan());
   };
-  // The IndexScan has only one variable, this is currently not supported.
-  testFailure(emptyVariables, aliasesCountX, xScan);
-
   // Must have zero groupByVariables.
   testFailure(variablesOnlyX, aliasesCountX, xyzScanSortedByX);
 
   // Must (currently) have exactly one alias that is a count.
-  // A distinct count is only supported if the triple has three variables.
+  // A distinct count of a triple with two variables is only supported for the
+  // first variable of the permutation.
   testFailure(emptyVariables, emptyAliases, xyzScanSortedByX);
-  testFailure(emptyVariables, aliasesCountDistinctX, xyScan);
+  testFailure(emptyVariables, aliasesCountDistinctX, yxScan);
   testFailure(emptyVariables, aliasesXAsV, xyzScanSortedByX);
 
   // `chooseInterface == true` means "use the dedicated
@@ -1588,6 +1796,84 @@ TEST_F(GroupByOptimizations, computeGroupByForSingleIndexScan) {
     // <x>, <y>, <z>, <a>, <b> and <c>.
     ASSERT_THAT(optional, optionalHasTable({{I(6)}}));
   }
+  // Four of the triples with the predicate `<label>` have the subject `<x>`,
+  // the other one has the subject `<z>`.
+  {
+    auto groupBy = GroupByImpl{qec, emptyVariables, aliasesCountX, xScan};
+    auto optional = groupBy.computeGroupByForSingleIndexScan();
+    ASSERT_THAT(optional, optionalHasTable({{I(4)}}));
+  }
+  {
+    auto groupBy =
+        GroupByImpl{qec, emptyVariables, aliasesCountDistinctX, xScan};
+    auto optional = groupBy.computeGroupByForSingleIndexScan();
+    ASSERT_THAT(optional, optionalHasTable({{I(4)}}));
+  }
+  {
+    auto groupBy =
+        GroupByImpl{qec, emptyVariables, aliasesCountDistinctX, xyScan};
+    auto optional = groupBy.computeGroupByForSingleIndexScan();
+    ASSERT_THAT(optional, optionalHasTable({{I(2)}}));
+  }
+}
+
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, computeGroupByForSingleIndexScanWithGraphFilter) {
+  TestIndexConfig config;
+  config.indexType = qlever::Filetype::NQuad;
+  config.turtleInput =
+      "<s> <p> <o> <g1> . <s> <p> <o> <g2> . <s> <p> <o2> <g1> . "
+      "<s> <p> <o3> <g2> . <t> <p> <o> <g1> .";
+  auto* qecNquad = getQec(config);
+
+  // Return the result of the optimized and of the general computation of the
+  // `aliases` for a scan of the `triple` that is restricted to the `graphs`.
+  using GraphSet = ad_utility::HashSet<TripleComponent>;
+  auto computeBoth = [&](SparqlTripleSimple triple, const GraphSet& graphs,
+                         const std::vector<Alias>& aliases) {
+    auto scan = makeExecutionTree<IndexScan>(
+        qecNquad, Permutation::Enum::PSO, std::move(triple),
+        IndexScan::Graphs::Whitelist(graphs));
+    GroupByImpl groupBy{qecNquad, emptyVariables, aliases, scan};
+    auto optimized = groupBy.computeGroupByForSingleIndexScan();
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::groupByDisableIndexScanOptimizations_>(true);
+    qecNquad->getQueryTreeCache().clearAll();
+    GroupByImpl general{qecNquad, emptyVariables, aliases, scan};
+    return std::pair{std::move(optimized),
+                     general.computeResultOnlyForTesting().idTable().clone()};
+  };
+
+  GraphSet g1{TripleComponent{iri("<g1>")}};
+  GraphSet g1AndG2{TripleComponent{iri("<g1>")}, TripleComponent{iri("<g2>")}};
+  SparqlTripleSimple sTriple{iri("<s>"), iri("<p>"), Variable{"?x"}};
+  SparqlTripleSimple xyTriple{Variable{"?x"}, iri("<p>"), Variable{"?y"}};
+
+  // `<s> <p> ?x` in `<g1>`: `<o>` and `<o2>`; in `<g1>` and `<g2>`: `<o>`
+  // (only once), `<o2>`, and `<o3>`.
+  for (const auto& [graphs, expected] :
+       std::vector<std::pair<GraphSet, int64_t>>{{g1, 2}, {g1AndG2, 3}}) {
+    for (const auto* aliases : {&aliasesCountX, &aliasesCountDistinctX}) {
+      auto [optimized, general] = computeBoth(sTriple, graphs, *aliases);
+      EXPECT_THAT(optimized, optionalHasTable({{I(expected)}}));
+      EXPECT_THAT(general, matchesIdTableFromVector({{I(expected)}}));
+    }
+  }
+
+  // `?x <p> ?y` in `<g1>`: three triples with two distinct subjects.
+  {
+    auto [optimized, general] = computeBoth(xyTriple, g1, aliasesCountX);
+    EXPECT_THAT(optimized, optionalHasTable({{I(3)}}));
+    EXPECT_THAT(general, matchesIdTableFromVector({{I(3)}}));
+  }
+  // A distinct count of a scan with a graph restriction and two variables is
+  // not supported.
+  {
+    auto [optimized, general] =
+        computeBoth(xyTriple, g1, aliasesCountDistinctX);
+    EXPECT_EQ(optimized, std::nullopt);
+    EXPECT_THAT(general, matchesIdTableFromVector({{I(2)}}));
+  }
 }
 
 // _____________________________________________________________________________
@@ -1859,17 +2145,56 @@ struct QecWrapper {
   std::shared_ptr<MaterializedViewsManager> materializedViewsManager_ =
       std::make_shared<MaterializedViewsManager>();
 
-  QueryExecutionContext makeQec() {
+  QueryExecutionContext makeQec(
+      ad_utility::MemorySize memoryLimit = ad_utility::MemorySize::megabytes(
+          100)) {
     return QueryExecutionContext{
         index_,
         &cache_,
-        makeAllocator(ad_utility::MemorySize::megabytes(100)),
+        makeAllocator(memoryLimit),
         SortPerformanceEstimator{},
         &namedCache_,
         materializedViewsManager_};
   }
 };
 
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, hashMapFallsBackToSortIfMemoryLimitIsExceeded) {
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::groupByHashMapEnabled_>(
+          true);
+  // An unsorted input with 100'000 distinct groups. The hash map and the
+  // aggregation data together require more than 3 MB, while the result of the
+  // sort-based GROUP BY requires 1.6 MB. The input itself (and its sorted copy)
+  // don't count towards the memory limit, because they use a different
+  // allocator.
+  const size_t numRows = 100'000;
+  IdTable input{2, ad_utility::testing::makeAllocator()};
+  input.resize(numRows);
+  for (size_t i = 0; i < numRows; ++i) {
+    input(i, 0) = I(static_cast<int64_t>(numRows - i));
+    input(i, 1) = I(static_cast<int64_t>(i));
+  }
+  QecWrapper ctx{std::make_shared<Index>(makeTestIndex("<a> <p> <b> ."))};
+  auto limitedQec = ctx.makeQec(ad_utility::MemorySize::megabytes(3));
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      &limitedQec, std::move(input),
+      std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"}});
+  dynamic_cast<ValuesForTesting&>(*subtree->getRootOperation())
+      .forceFullyMaterialized() = true;
+  std::vector<Alias> aliases{Alias{makeCountPimpl(varY), Variable{"?count"}}};
+  GroupByImpl groupBy{&limitedQec, variablesOnlyX, aliases,
+                      std::move(subtree)};
+  auto result = groupBy.computeResultOnlyForTesting(false);
+  EXPECT_EQ(groupBy.runtimeInfo().details_["hash-map-exceeded-memory-limit"],
+            true);
+  const auto& table = result.idTable();
+  ASSERT_EQ(table.numRows(), numRows);
+  EXPECT_EQ(table(0, 0), I(1));
+  EXPECT_EQ(table(0, 1), I(1));
+  EXPECT_EQ(table(numRows - 1, 0), I(static_cast<int64_t>(numRows)));
+}
+
 // _____________________________________________________________________________
 TEST(GroupByOptimizationsDeltaTriples, singleIndexScanTotalCountAfterInsert) {
   QecWrapper ctx{
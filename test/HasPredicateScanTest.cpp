@@ -9,6 +9,7 @@
 
 #include "./util/IdTableHelpers.h"
 #include "./util/IdTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
 #include "./util/TripleComponentTestHelpers.h"
 #include "engine/CallFixedSize.h"
 #include "engine/CountAvailablePredicates.h"
@@ -161,6 +162,70 @@ TEST_F(HasPredicateScanTest, subtree) {
   runTest(scan, {{p3, y, p}, {p3, y, p3}});
 }
 
+// _____________________________________________________________
+TEST_F(HasPredicateScanTest, lazyFullScan) {
+  // Free the cache to get a fresh, lazy `IndexScan`.
+  qec->getQueryTreeCache().clearAll();
+  auto scan = HasPredicateScan{
+      qec, SparqlTriple{Variable{"?s"}, iri(HAS_PREDICATE_PREDICATE),
+                        Variable{"?p"}}};
+  auto result = scan.computeResultOnlyForTesting(true);
+  ASSERT_FALSE(result.isFullyMaterialized());
+  EXPECT_THAT(result.sortedBy(), ::testing::ElementsAre(0));
+  EXPECT_EQ(aggregateTables(result.idTables(), 2).first,
+            makeIdTableFromVector({{x, p}, {x, p2}, {y, p}, {y, p3}, {z, p3}}));
+}
+
+// _____________________________________________________________
+TEST_F(HasPredicateScanTest, lazySubtree) {
+  // The subjects are given in two blocks, the patterns are expanded block by
+  // block.
+  std::vector<IdTable> blocks;
+  blocks.push_back(makeIdTableFromVector({{x}, {y}}));
+  blocks.push_back(makeIdTableFromVector({{z}}));
+  auto values = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(blocks), std::vector<std::optional<V>>{V{"?x"}}, false,
+      std::vector<ColumnIndex>{0});
+  auto scan = HasPredicateScan{qec, values, 0, V{"?predicate"}};
+  VectorTable expected{{x, p}, {x, p2}, {y, p}, {y, p3}, {z, p3}};
+  auto result = scan.computeResultOnlyForTesting(true);
+  ASSERT_FALSE(result.isFullyMaterialized());
+  EXPECT_EQ(aggregateTables(result.idTables(), 2).first,
+            makeIdTableFromVector(expected));
+  runTest(scan, expected);
+}
+
+// _____________________________________________________________
+TEST_F(HasPredicateScanTest, expandPatternsInParallel) {
+  auto Voc = ad_utility::testing::VocabId;
+  const auto& patterns = qec->getIndex().getPatterns();
+  ASSERT_EQ(patterns.size(), 3);
+  // An input that is large enough to be split between threads. The pattern
+  // is in the middle column, and the other columns are repeated.
+  IdTable input{3, makeAllocator()};
+  IdTable expected{3, makeAllocator()};
+  for (size_t i = 0; i < 3 * HasPredicateScan::minNumRowsPerThread_ + 17;
+       ++i) {
+    size_t patternIndex = (i * 7) % patterns.size();
+    input.push_back({Voc(i), Int(patternIndex), Int(i)});
+    for (Id predicate : patterns[patternIndex]) {
+      expected.push_back({Voc(i), predicate, Int(i)});
+    }
+  }
+  for (size_t numThreads : {1, 2, 4}) {
+    EXPECT_EQ(HasPredicateScan::expandPatterns(input, 1, patterns, numThreads,
+                                               makeAllocator()),
+              expected);
+  }
+
+  // Empty inputs have empty results.
+  IdTable empty{2, makeAllocator()};
+  EXPECT_EQ(
+      HasPredicateScan::expandPatterns(empty, 0, patterns, 4, makeAllocator())
+          .numRows(),
+      0);
+}
+
 // ____________________________________________________________
 TEST_F(HasPredicateScanTest, patternTrickWithSubtree) {
   /* Manual setup of the operations for the following pattern trick
@@ -248,3 +313,50 @@ TEST_F(HasPredicateScanTest, patternTrickAllEntities) {
 
   runTestUnordered(patternTrick, {{p3, Int(2)}, {p2, Int(1)}, {p, Int(2)}});
 }
+
+// ____________________________________________________________
+TEST_F(HasPredicateScanTest, patternTrickLargeInputInParallel) {
+  auto I = ad_utility::testing::IntId;
+  auto Voc = ad_utility::testing::VocabId;
+  const auto& patterns = qec->getIndex().getPatterns();
+  ASSERT_EQ(patterns.size(), 3);
+  // A large input, where each subject occurs in two consecutive rows and every
+  // seventh subject has no pattern. This input is large enough to be split
+  // between threads, and the patterns are counted in a dense array.
+  IdTable input{2, makeAllocator()};
+  ad_utility::HashMap<Id, int64_t> expectedCounts;
+  for (size_t i = 0; i < 1'100'000; ++i) {
+    size_t subject = i / 2;
+    bool hasPattern = subject % 7 != 0;
+    size_t patternIndex = subject % patterns.size();
+    input.push_back({Voc(subject), hasPattern ? I(patternIndex)
+                                              : I(Pattern::NoPattern)});
+    if (hasPattern && i % 2 == 0) {
+      for (Id predicate : patterns[patternIndex]) {
+        ++expectedCounts[predicate];
+      }
+    }
+  }
+  VectorTable expected;
+  for (const auto& [predicate, count] : expectedCounts) {
+    expected.push_back({predicate, Int(count)});
+  }
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(input),
+      std::vector<std::optional<Variable>>{V{"?x"}, V{"?predicate"}}, false,
+      std::vector<ColumnIndex>{0});
+
+  for (size_t numThreads : {1, 4}) {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::patternTrickNumThreads_>(
+            numThreads);
+    auto patternTrick = CountAvailablePredicates(qec, subtree, 0,
+                                                 V{"?predicate"}, V{"?count"});
+    runTestUnordered(patternTrick, expected);
+    auto numThreadsUsed = patternTrick.runtimeInfo()
+                              .details_["numThreads"]
+                              .get<size_t>();
+    EXPECT_GE(numThreadsUsed, 1);
+    EXPECT_LE(numThreadsUsed, numThreads);
+  }
+}
@@ -134,16 +134,22 @@ TEST(HttpServer, HttpTest) {
     }
 
     // Also test the convenience function `sendHttpOrHttpsRequest` (which
-    // creates an own client for each request).
+    // reuses the connections of previous requests via the connection pool).
     {
+      HttpClient::connectionPool().clear();
       Url url{
           absl::StrCat("http://localhost:", httpServer.getPort(), "/target")};
       ASSERT_EQ(toString(sendHttpOrHttpsRequest(url, handle, verb::get).body_),
                 "GET\n/target\n");
+      // The connection is returned to the pool once the body has been read
+      // completely, and reused by the next request.
+      EXPECT_EQ(HttpClient::connectionPool().numIdleConnections(), 1);
       ASSERT_EQ(
           toString(
               sendHttpOrHttpsRequest(url, handle, verb::post, "body").body_),
           "POST\n/target\nbody");
+      EXPECT_EQ(HttpClient::connectionPool().numIdleConnections(), 1);
+      HttpClient::connectionPool().clear();
     }
 
     // Check that after shutting down, no more new connections are accepted.
@@ -388,6 +394,40 @@ TEST(HttpServer, RequestBodySizeLimit) {
   expectRequestSucceeds(5_MB);
 }
 
+// Test that a handler that takes a `ClientConnection` is notified when the
+// client closes the connection while the request is handled.
+TEST(HttpServer, ClientConnectionIsClosedOnDisconnect) {
+  std::promise<void> closed;
+  auto closedFuture = closed.get_future();
+  TestHttpServer httpServer(
+      [&closed](auto, auto&&, std::shared_ptr<ClientConnection> connection)
+          -> boost::asio::awaitable<void> {
+        bool callbackWasInvoked = false;
+        connection->onClose(
+            [&callbackWasInvoked]() { callbackWasInvoked = true; });
+        // Wait (without sending a response) until the client disconnects.
+        net::steady_timer timer{co_await net::this_coro::executor};
+        while (!connection->isClosed()) {
+          timer.expires_after(1ms);
+          co_await timer.async_wait(net::use_awaitable);
+        }
+        EXPECT_TRUE(callbackWasInvoked);
+        closed.set_value();
+      });
+  httpServer.runInOwnThread();
+
+  // Send a request and close the connection before receiving the response.
+  {
+    net::io_context ioContext;
+    tcp::socket socket{ioContext};
+    socket.connect({net::ip::make_address("127.0.0.1"), httpServer.getPort()});
+    http::request<http::string_body> request{verb::get, "/", 11};
+    request.set(field::host, "localhost");
+    http::write(socket, request);
+  }
+  EXPECT_EQ(closedFuture.wait_for(5s), std::future_status::ready);
+}
+
 // Test HTTP redirect handling in `sendHttpOrHttpsRequest`.
 TEST(HttpClient, Redirects) {
   using ::testing::AllOf;
@@ -496,3 +536,55 @@ TEST(HttpClient, Redirects) {
   }
   server.shutDown();
 }
+
+// Test that large bodies, which are read ahead in several chunks by a
+// separate thread, are received completely, and that abandoning a body early
+// doesn't wait for the rest of the body.
+TEST(HttpClient, BodyIsReadAhead) {
+  ad_utility::SharedCancellationHandle handle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  std::atomic<bool> stopStalling = false;
+  constexpr size_t numChunks = 100;
+  const std::string chunk(10'000, 'x');
+  TestHttpServer server([&stopStalling, &chunk](
+                            auto request,
+                            auto&& send) -> boost::asio::awaitable<void> {
+    bool stall = toStd(request.target()) == "/stall";
+    auto response = [](bool stall, const std::string& chunk,
+                       std::atomic<bool>& stopStalling)
+        -> cppcoro::generator<std::string> {
+      for (size_t i = 0; i < numChunks; ++i) {
+        co_yield chunk;
+        // After the first chunk, wait until the client has gone.
+        for (size_t j = 0; stall && !stopStalling && j < 2'000; ++j) {
+          std::this_thread::sleep_for(1ms);
+        }
+      }
+    }(stall, chunk, stopStalling);
+    co_return co_await send(createOkResponse(
+        std::move(response), request, ad_utility::MediaType::textPlain));
+  });
+  server.runInOwnThread();
+  HttpClient::connectionPool().clear();
+
+  // The complete body is received, and afterward the connection can be reused.
+  Url url{absl::StrCat("http://localhost:", server.getPort(), "/large")};
+  std::string body = toString(sendHttpOrHttpsRequest(url, handle).body_);
+  EXPECT_EQ(body.size(), numChunks * chunk.size());
+  EXPECT_TRUE(ql::ranges::all_of(body, [](char c) { return c == 'x'; }));
+  EXPECT_EQ(HttpClient::connectionPool().numIdleConnections(), 1);
+  HttpClient::connectionPool().clear();
+
+  // Abandon a body while the server stalls. The read that waits for the server
+  // is aborted, and the connection is not reused.
+  {
+    Url stallUrl{absl::StrCat("http://localhost:", server.getPort(), "/stall")};
+    auto response = sendHttpOrHttpsRequest(stallUrl, handle);
+    auto firstBytes = std::move(response).readResponseHead(10);
+    EXPECT_EQ(firstBytes, std::string(10, 'x'));
+  }
+  EXPECT_FALSE(handle->isCancelled());
+  EXPECT_EQ(HttpClient::connectionPool().numIdleConnections(), 0);
+  stopStalling = true;
+  server.shutDown();
+}
@@ -0,0 +1,104 @@
+// Copyright 2026, University of Freiburg,
+//                 Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+
+#include "util/HyperLogLog.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+
+using ad_utility::HyperLogLog;
+
+namespace {
+// Add the values `[begin, end)` to a new sketch and return it.
+HyperLogLog makeSketch(uint64_t begin, uint64_t end) {
+  HyperLogLog sketch;
+  for (uint64_t i = begin; i < end; ++i) {
+    sketch.add(i);
+  }
+  return sketch;
+}
+
+// The sketches have a relative standard error of about 4.6%, we allow for a
+// generous error of 15% to make the tests deterministic with respect to the
+// choice of the values.
+auto isCloseTo(double expected) {
+  return ::testing::DoubleNear(expected, 0.15 * expected + 1.0);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, estimate) {
+  EXPECT_EQ(HyperLogLog{}.estimate(), 0.0);
+  for (uint64_t numValues : {1, 10, 100, 1'000, 10'000, 100'000, 1'000'000}) {
+    EXPECT_THAT(makeSketch(0, numValues).estimate(), isCloseTo(numValues))
+        << numValues;
+  }
+}
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, duplicatesDontChangeTheEstimate) {
+  auto sketch = makeSketch(0, 5'000);
+  auto copy = sketch;
+  for (uint64_t i = 0; i < 5'000; i += 3) {
+    sketch.add(i);
+  }
+  EXPECT_EQ(sketch, copy);
+}
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, mergeAndUnion) {
+  auto a = makeSketch(0, 20'000);
+  auto b = makeSketch(10'000, 50'000);
+  EXPECT_THAT(HyperLogLog::estimateUnion(a, b), isCloseTo(50'000));
+  auto merged = a;
+  merged.merge(b);
+  EXPECT_EQ(merged, makeSketch(0, 50'000));
+  EXPECT_EQ(merged.estimate(), HyperLogLog::estimateUnion(a, b));
+}
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, estimateIntersection) {
+  auto a = makeSketch(0, 40'000);
+  auto b = makeSketch(20'000, 60'000);
+  EXPECT_THAT(HyperLogLog::estimateIntersection(a, b), isCloseTo(20'000));
+
+  // A subset.
+  auto c = makeSketch(0, 10'000);
+  EXPECT_THAT(HyperLogLog::estimateIntersection(a, c), isCloseTo(10'000));
+  EXPECT_LE(HyperLogLog::estimateIntersection(a, c), c.estimate());
+
+  // Disjoint sets, the estimate is never negative.
+  auto d = makeSketch(100'000, 140'000);
+  EXPECT_GE(HyperLogLog::estimateIntersection(a, d), 0.0);
+  EXPECT_LT(HyperLogLog::estimateIntersection(a, d), 0.15 * 40'000);
+  EXPECT_EQ(HyperLogLog::estimateIntersection(a, HyperLogLog{}), 0.0);
+}
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, serialization) {
+  auto sketch = makeSketch(0, 1'000);
+  ad_utility::serialization::ByteBufferWriteSerializer writer;
+  writer << sketch;
+  ad_utility::serialization::ByteBufferReadSerializer reader{
+      std::move(writer).data()};
+  HyperLogLog result;
+  reader >> result;
+  EXPECT_EQ(result, sketch);
+}
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, morePreciseSketch) {
+  using Sketch = ad_utility::BasicHyperLogLog<14>;
+  EXPECT_LT(Sketch::relativeStandardError(), 0.01);
+  EXPECT_GT(HyperLogLog::relativeStandardError(), 0.04);
+  for (uint64_t numValues : {1'000, 100'000, 1'000'000}) {
+    Sketch sketch;
+    for (uint64_t i = 0; i < numValues; ++i) {
+      sketch.add(i);
+    }
+    // Five times the relative standard error.
+    EXPECT_THAT(sketch.estimate(),
+                ::testing::DoubleNear(numValues, 0.04 * numValues))
+        << numValues;
+  }
+}
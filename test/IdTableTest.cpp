@@ -1053,6 +1053,24 @@ TEST(IdTable, setColumnSubset) {
   ASSERT_ANY_THROW(t.setColumnSubset(std::vector<ColumnIndex>{1, 2}));
 }
 
+TEST(IdTable, asRowRangeView) {
+  using IntTable = columnBasedIdTable::IdTable<int, 0>;
+  IntTable t{2};
+  t.push_back({0, 10});
+  t.push_back({1, 11});
+  t.push_back({2, 12});
+  auto view = t.asRowRangeView(1, 3);
+  ASSERT_EQ(2, view.numColumns());
+  ASSERT_EQ(2, view.numRows());
+  ASSERT_THAT(view.getColumn(0), ::testing::ElementsAre(1, 2));
+  ASSERT_THAT(view.getColumn(1), ::testing::ElementsAre(11, 12));
+  ASSERT_TRUE(t.asRowRangeView(2, 2).empty());
+  ASSERT_EQ(2, view.asRowRangeView(1, 2).getColumn(0)[0]);
+  // Invalid ranges.
+  ASSERT_ANY_THROW(t.asRowRangeView(2, 1));
+  ASSERT_ANY_THROW(t.asRowRangeView(0, 4));
+}
+
 TEST(IdTableStatic, setColumnSubset) {
   using IntTable = columnBasedIdTable::IdTable<int, 3>;
   IntTable t;
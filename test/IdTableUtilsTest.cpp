@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <random>
 
 #include "engine/idTable/IdTable.h"
 #include "index/IdTableUtils.h"
@@ -43,3 +44,79 @@ TEST(IdTableUtils, countDistinct) {
                                  ::testing::HasSubstr("must be sorted"));
   }
 }
+
+namespace {
+using Row = std::array<Id, 3>;
+
+// Create a table with `numRows` random rows. The first column contains values
+// of different datatypes, the other columns contain many duplicates.
+IdTable makeRandomTable(size_t numRows) {
+  using namespace ad_utility::testing;
+  std::mt19937_64 randomEngine{4242};
+  std::uniform_int_distribution<int64_t> dist{-50, 50};
+  IdTable table{3, makeAllocator()};
+  table.resize(numRows);
+  for (size_t i = 0; i < numRows; ++i) {
+    auto value = dist(randomEngine);
+    table(i, 0) = value % 3 == 0 ? IntId(value) : VocabId(value + 50);
+    table(i, 1) = IntId(dist(randomEngine) % 4);
+    table(i, 2) = VocabId(i);
+  }
+  return table;
+}
+
+// Return the rows of the `table`.
+std::vector<Row> toRows(const IdTable& table) {
+  std::vector<Row> rows;
+  for (const auto& row : table) {
+    rows.push_back({row[0], row[1], row[2]});
+  }
+  return rows;
+}
+
+// Return the rows of the `table` stably sorted by the `sortCols`.
+std::vector<Row> stableSortedRows(const IdTable& table,
+                                  const std::vector<ColumnIndex>& sortCols) {
+  auto rows = toRows(table);
+  std::stable_sort(rows.begin(), rows.end(), [&](const Row& a, const Row& b) {
+    for (auto col : sortCols) {
+      if (a[col] != b[col]) {
+        return a[col] < b[col];
+      }
+    }
+    return false;
+  });
+  return rows;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(IdTableUtils, radixSort) {
+  for (size_t numRows : {0, 1, 2, 17, 1000, 200'000}) {
+    for (std::vector<ColumnIndex> sortCols :
+         {std::vector<ColumnIndex>{0}, {1}, {2}, {1, 0}, {0, 1}, {1, 0, 2}}) {
+      auto table = makeRandomTable(numRows);
+      auto expected = stableSortedRows(table, sortCols);
+      IdTableUtils::radixSort(table, sortCols);
+      // The radix sort is stable, so the complete rows have to match.
+      EXPECT_EQ(toRows(table), expected);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(IdTableUtils, sortChoosesRadixSortOnlyIfApplicable) {
+  using namespace ad_utility::testing;
+  auto table = makeRandomTable(IdTableUtils::minNumRowsForRadixSort);
+  std::vector<ColumnIndex> sortCols{1, 0};
+  auto expected = stableSortedRows(table, sortCols);
+  IdTableUtils::sort(table, sortCols);
+  EXPECT_EQ(toRows(table), expected);
+
+  // With a `LocalVocabIndex` entry in a sort column, the comparison-based sort
+  // has to be used, which still sorts correctly.
+  table = makeRandomTable(IdTableUtils::minNumRowsForRadixSort);
+  table(42, 0) = LocalVocabId(3);
+  IdTableUtils::sort(table, {0});
+  EXPECT_TRUE(ql::ranges::is_sorted(table.getColumn(0)));
+}
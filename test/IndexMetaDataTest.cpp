@@ -94,6 +94,50 @@ TEST(IndexMetaDataTest, writeReadTest2Mmap) {
   ad_utility::deleteFile(mmapFilename);
 }
 
+// _____________________________________________________________________________
+TEST(IndexMetaDataTest, readFromFileContents) {
+  std::string imdFilename = "_testtmp.readFromFileContents.imd";
+  std::string mmapFilename = imdFilename + ".mmap";
+  CompressedRelationMetadata rmd{V(1), 3, 2.0, 42.0, 16};
+  std::vector<CompressedBlockMetadata> bs;
+  bs.push_back(CompressedBlockMetadata{{{{{12, 34}, {42, 17}}},
+                                        5,
+                                        {V(0), V(2), V(13), g},
+                                        {V(2), V(24), V(62), g},
+                                        std::vector{V(512)},
+                                        true},
+                                       17});
+  {
+    IndexMetaDataMmap imd;
+    imd.setup(mmapFilename, ad_utility::CreateTag{});
+    imd.add(rmd);
+    imd.blockData() = bs;
+    // The meta data is appended to a file that already contains the blocks.
+    ad_utility::File file{imdFilename, "w"};
+    file.write("someBlockData", 13);
+    imd.appendToFile(&file);
+  }
+
+  std::ifstream in{imdFilename, std::ios::binary};
+  std::string contents{std::istreambuf_iterator<char>{in},
+                       std::istreambuf_iterator<char>{}};
+  {
+    IndexMetaDataMmap imd;
+    imd.setup(mmapFilename, ad_utility::ReuseTag());
+    imd.readFromFileContents(contents);
+    EXPECT_EQ(imd.getMetaData(V(1)), rmd);
+    EXPECT_EQ(imd.blockData(), bs);
+  }
+  {
+    // Contents that are too short to contain the offset of the meta data.
+    IndexMetaDataMmap imd;
+    imd.setup(mmapFilename, ad_utility::ReuseTag());
+    EXPECT_ANY_THROW(imd.readFromFileContents("abc"));
+  }
+  ad_utility::deleteFile(imdFilename);
+  ad_utility::deleteFile(mmapFilename);
+}
+
 // _____________________________________________________________________________
 TEST(IndexMetaDataTest, exchangeMultiplicities) {
   std::string mmapFilenameA = "exchangeMultiplicities_tmp.imda.mmap";
@@ -423,6 +423,54 @@ TEST(IndexTest, scanTest) {
   testWithAndWithoutPrefixCompression(false);
 };
 
+// ______________________________________________________________
+TEST(IndexTest, writePermutationPairsConcurrently) {
+  std::string kb =
+      "<a> <p> <b> . <a> <p> <c> . <b> <q> <a> . <c> <q> \"x\" . "
+      "<b> <p> <c> . <c> <r> <a> . <a> <r> \"y\"@en .";
+  auto makeIndex = [&kb](bool concurrently) {
+    TestIndexConfig config{kb};
+    config.usePatterns = false;
+    config.writePermutationPairsConcurrently = concurrently;
+    return getQec(std::move(config));
+  };
+  const auto& sequentialQec = *makeIndex(false);
+  const auto& concurrentQec = *makeIndex(true);
+  const IndexImpl& sequential = sequentialQec.getIndex().getImpl();
+  const IndexImpl& concurrent = concurrentQec.getIndex().getImpl();
+
+  EXPECT_EQ(concurrent.numTriples(), sequential.numTriples());
+  EXPECT_EQ(concurrent.numDistinctSubjects(), sequential.numDistinctSubjects());
+  EXPECT_EQ(concurrent.numDistinctPredicates(),
+            sequential.numDistinctPredicates());
+  EXPECT_EQ(concurrent.numDistinctObjects(), sequential.numDistinctObjects());
+
+  // All the scans yield the same results (both indices have the same
+  // vocabulary, so the `Id`s can be compared directly).
+  auto scan = [](const IndexImpl& index, const QueryExecutionContext& qec,
+                 std::string_view c0, Permutation::Enum permutation) {
+    const auto& actualPermutation = index.getPermutation(permutation);
+    auto locatedTriplesSnapshot = qec.locatedTriplesState();
+    return actualPermutation.scan(
+        actualPermutation.getScanSpecAndBlocks(
+            ScanSpecificationAsTripleComponent{iri(c0), std::nullopt,
+                                               std::nullopt}
+                .toScanSpecification(index),
+            locatedTriplesSnapshot),
+        Permutation::ColumnIndicesRef{},
+        std::make_shared<ad_utility::CancellationHandle<>>(),
+        locatedTriplesSnapshot);
+  };
+  using enum Permutation::Enum;
+  for (auto permutation : {SPO, SOP, OSP, OPS, PSO, POS}) {
+    for (std::string_view c0 : {"<a>", "<b>", "<c>", "<p>", "<q>", "<r>"}) {
+      EXPECT_EQ(scan(concurrent, concurrentQec, c0, permutation),
+                scan(sequential, sequentialQec, c0, permutation));
+    }
+  }
+  EXPECT_EQ(scan(concurrent, concurrentQec, "<p>", PSO).numRows(), 3u);
+}
+
 // ______________________________________________________________
 TEST(IndexTest, emptyIndex) {
   const auto& qec = *makeQecWithOrWithoutCompression("", true);
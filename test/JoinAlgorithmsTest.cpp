@@ -11,6 +11,7 @@
 #include "./util/GTestHelpers.h"
 #include "util/IdTableHelpers.h"
 #include "util/JoinAlgorithms/JoinAlgorithms.h"
+#include "util/JoinAlgorithms/SimdZipperJoin.h"
 #include "util/TransparentFunctors.h"
 
 using namespace ad_utility;
@@ -985,3 +986,92 @@ TEST(JoinAlgorithms, SpecialOptionalJoinComplexCombination) {
   };
   testSpecialOptionalJoinWithSplits(leftTable, rightTable, expectedResult);
 }
+
+// _____________________________________________________________________________
+TEST(JoinAlgorithms, SimdZipperJoinFindFirstNotLess) {
+  using ad_utility::testing::VocabId;
+  using simdZipperJoin::findFirstNotLess;
+  std::vector<Id> values;
+  for (size_t i = 0; i < 200; ++i) {
+    values.push_back(VocabId(2 * i));
+  }
+  auto find = [&values](size_t begin, size_t end, size_t needle) {
+    return findFirstNotLess(values.data(), begin, end,
+                            VocabId(needle).getBits());
+  };
+  // Empty ranges.
+  EXPECT_EQ(find(0, 0, 17), 0);
+  EXPECT_EQ(find(13, 13, 0), 13);
+  // Matches in the range of the linear scan, including the unaligned tails of
+  // the vectorized loop.
+  EXPECT_EQ(find(0, 200, 0), 0);
+  EXPECT_EQ(find(0, 200, 6), 3);
+  EXPECT_EQ(find(0, 200, 7), 4);
+  EXPECT_EQ(find(1, 6, 9), 5);
+  EXPECT_EQ(find(1, 6, 10), 5);
+  EXPECT_EQ(find(1, 6, 8), 4);
+  // Matches that require the exponential search.
+  EXPECT_EQ(find(0, 200, 100), 50);
+  EXPECT_EQ(find(0, 200, 101), 51);
+  EXPECT_EQ(find(3, 200, 398), 199);
+  EXPECT_EQ(find(3, 150, 398), 150);
+  EXPECT_EQ(find(0, 200, 1000), 200);
+}
+
+// _____________________________________________________________________________
+TEST(JoinAlgorithms, SimdZipperJoinIsApplicable) {
+  using namespace ad_utility::testing;
+  using simdZipperJoin::isApplicable;
+  EXPECT_TRUE(isApplicable({}));
+  std::vector<Id> column{IntId(3), IntId(5), VocabId(1), VocabId(7)};
+  EXPECT_TRUE(isApplicable(column));
+  column.insert(column.begin(), UndefId());
+  EXPECT_FALSE(isApplicable(column));
+  column.erase(column.begin());
+  column.push_back(LocalVocabId(42));
+  EXPECT_FALSE(isApplicable(column));
+}
+
+// _____________________________________________________________________________
+TEST(JoinAlgorithms, SimdZipperJoinMatchesGenericZipperJoin) {
+  using ad_utility::testing::IntId;
+  std::mt19937_64 randomEngine{42};
+  auto makeInput = [&randomEngine](size_t size, int64_t maxValue) {
+    std::uniform_int_distribution<int64_t> dist{-maxValue, maxValue};
+    std::vector<Id> result;
+    for (size_t i = 0; i < size; ++i) {
+      result.push_back(IntId(dist(randomEngine)));
+    }
+    ql::ranges::sort(result);
+    return result;
+  };
+  using Matches = std::vector<std::pair<size_t, size_t>>;
+  for (auto [sizeLeft, sizeRight, maxValue] :
+       std::vector<std::tuple<size_t, size_t, int64_t>>{{0, 10, 10},
+                                                        {10, 0, 10},
+                                                        {1, 1, 0},
+                                                        {50, 50, 10},
+                                                        {100, 5000, 3000},
+                                                        {5000, 100, 3000},
+                                                        {2000, 2000, 500}}) {
+    auto left = makeInput(sizeLeft, maxValue);
+    auto right = makeInput(sizeRight, maxValue);
+    ql::span<const Id> l{left};
+    ql::span<const Id> r{right};
+    auto makeAction = [&l, &r](Matches& matches) {
+      return [&matches, &l, &r](auto itLeft, auto itRight) {
+        matches.emplace_back(itLeft - l.begin(), itRight - r.begin());
+      };
+    };
+    Matches expected;
+    [[maybe_unused]] auto numOutOfOrder =
+        zipperJoinWithUndef(l, r, ql::ranges::less{}, makeAction(expected),
+                            noop, noop);
+    Matches actual;
+    size_t numCancellationChecks = 0;
+    simdZipperJoin::zipperJoin(l, r, makeAction(actual),
+                               [&]() { ++numCancellationChecks; });
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(numCancellationChecks > 0, !l.empty() && !r.empty());
+  }
+}
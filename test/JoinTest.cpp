@@ -4,12 +4,15 @@
 // Co-Author: Andre Schlegel (November of 2022,
 // schlegea@informatik.uni-freiburg.de)
 
+#include <absl/cleanup/cleanup.h>
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <fstream>
 #include <sstream>
+#include <thread>
 #include <tuple>
 
 #include "./util/AllocatorTestHelpers.h"
@@ -941,6 +944,100 @@ TEST(JoinTest, clone) {
   EXPECT_EQ(clone->getDescriptor(), join.getDescriptor());
 }
 
+// _____________________________________________________________________________
+TEST(JoinTest, joinLargeInputsInParallel) {
+  auto qec = ad_utility::testing::getQec();
+  auto budgetCleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::threadBudget_>(4);
+  // Two inputs with duplicates in the join column (the first column), s.t.
+  // there are matching rows on both sides of the splitters.
+  auto makeInput = [&](size_t numRows, size_t numDuplicates, bool withUndef) {
+    IdTable table{2, qec->getAllocator()};
+    if (withUndef) {
+      table.push_back({Id::makeUndefined(), I(-1)});
+    }
+    for (size_t i = 0; i < numRows; ++i) {
+      auto value = static_cast<int64_t>(i);
+      table.push_back({I(value / static_cast<int64_t>(numDuplicates)),
+                       I(value)});
+    }
+    return table;
+  };
+  auto computeJoin = [&](bool withUndef, size_t numThreads) {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::joinNumThreads_>(
+            numThreads);
+    qec->clearCacheUnpinnedOnly();
+    auto left = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeInput(300'000, 3, withUndef),
+        Vars{Variable{"?s"}, Variable{"?a"}}, false,
+        std::vector<ColumnIndex>{0});
+    auto right = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeInput(200'000, 2, false), Vars{Variable{"?s"}, Variable{"?b"}},
+        false, std::vector<ColumnIndex>{0});
+    Join join{qec, left, right, 0, 0};
+    return join.computeResultOnlyForTesting().idTable().clone();
+  };
+  for (bool withUndef : {false, true}) {
+    auto expected = computeJoin(withUndef, 1);
+    // Each of the values `0..99'999` is contained three times in the left and
+    // twice in the right input, and the UNDEF value matches all the rows of
+    // the right input.
+    EXPECT_EQ(expected.numRows(), 600'000 + (withUndef ? 200'000 : 0));
+    EXPECT_EQ(computeJoin(withUndef, 4), expected);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(JoinTest, joinPartitionsInParallel) {
+  using qlever::joinHelpers::joinPartitionsInParallel;
+  auto budgetCleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::threadBudget_>(4);
+  auto joinCleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::joinNumThreads_>(4);
+  IdTable left{1, makeAllocator()};
+  IdTable right{1, makeAllocator()};
+  for (int64_t i = 0; i < 200'000; ++i) {
+    left.push_back({I(i / 10)});
+    right.push_back({I(i / 10 + 5'000)});
+  }
+  // Join the partitions by appending the rows of the left partition with
+  // join values that are contained in the right partition.
+  std::atomic<size_t> numPartitions = 0;
+  auto joinPartition = [&numPartitions](const IdTableView<0>& leftPart,
+                                        const IdTableView<0>& rightPart,
+                                        IdTable* result) {
+    ++numPartitions;
+    for (const auto& row : leftPart) {
+      if (ql::ranges::binary_search(rightPart.getColumn(0), row[0])) {
+        result->push_back({row[0]});
+      }
+    }
+  };
+  IdTable result{1, makeAllocator()};
+  ASSERT_TRUE(
+      joinPartitionsInParallel(left.asStaticView<0>(), right.asStaticView<0>(),
+                               0, 0, &result, joinPartition));
+  // The first partition of the left input has no matching partition in the
+  // right input, so it is skipped.
+  EXPECT_EQ(numPartitions, 3);
+  ASSERT_EQ(result.numRows(), 150'000);
+  EXPECT_TRUE(ql::ranges::is_sorted(result.getColumn(0)));
+  EXPECT_EQ(result(0, 0), I(5'000));
+
+  // UNDEF values and small inputs are not joined in parallel.
+  IdTable withUndef = left.clone();
+  withUndef(0, 0) = Id::makeUndefined();
+  EXPECT_FALSE(joinPartitionsInParallel(withUndef.asStaticView<0>(),
+                                        right.asStaticView<0>(), 0, 0, &result,
+                                        joinPartition));
+  EXPECT_FALSE(joinPartitionsInParallel(
+      left.asStaticView<0>().asRowRangeView(0, 1000),
+      right.asStaticView<0>().asRowRangeView(0, 1000), 0, 0, &result,
+      joinPartition));
+  EXPECT_EQ(numPartitions, 3);
+}
+
 // _____________________________________________________________________________
 TEST_P(JoinTestParametrized, columnOriginatesFromGraphOrUndef) {
   auto keepJoinCol = GetParam();
@@ -1079,6 +1176,88 @@ TEST(JoinTest, lazyJoinIndexScanDetails) {
   EXPECT_EQ(details2["num-elements-read"].get<size_t>(), 10);
 }
 
+// _____________________________________________________________________________
+TEST(JoinTest, prefetchLazyResult) {
+  using qlever::joinHelpers::prefetchLazyResult;
+  auto budgetCleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::threadBudget_>(8);
+  // Create a lazy result with three blocks that records the threads on which
+  // the blocks are computed.
+  std::vector<std::thread::id> threadIds;
+  auto makeLazyResult = [&threadIds]() {
+    size_t i = 0;
+    Result::LazyResult blocks{ad_utility::InputRangeFromGetCallable{
+        [i, &threadIds]() mutable -> std::optional<Result::IdTableVocabPair> {
+          if (i == 3) {
+            return std::nullopt;
+          }
+          threadIds.push_back(std::this_thread::get_id());
+          return Result::IdTableVocabPair{
+              makeIdTableFromVector({{I(static_cast<int64_t>(i++))}}),
+              LocalVocab{}};
+        }}};
+    return std::make_shared<const Result>(std::move(blocks),
+                                          std::vector<ColumnIndex>{0});
+  };
+
+  auto prefetched = prefetchLazyResult(makeLazyResult(), 2);
+  ASSERT_FALSE(prefetched->isFullyMaterialized());
+  EXPECT_EQ(prefetched->sortedBy(), std::vector<ColumnIndex>{0});
+  int64_t expected = 0;
+  for (auto& [idTable, localVocab] : prefetched->idTables()) {
+    EXPECT_EQ(idTable, makeIdTableFromVector({{I(expected++)}}));
+  }
+  EXPECT_EQ(expected, 3);
+  ASSERT_EQ(threadIds.size(), 3);
+  for (const auto& threadId : threadIds) {
+    EXPECT_NE(threadId, std::this_thread::get_id());
+  }
+
+  // Without a queue, the result is returned unchanged.
+  auto lazyResult = makeLazyResult();
+  EXPECT_EQ(prefetchLazyResult(lazyResult, 0), lazyResult);
+  std::shared_ptr<const Result> materialized = std::make_shared<const Result>(
+      makeIdTableFromVector({{I(0)}}), std::vector<ColumnIndex>{0},
+      LocalVocab{});
+  EXPECT_EQ(prefetchLazyResult(materialized, 2), materialized);
+}
+
+// _____________________________________________________________________________
+TEST(JoinTest, lazyInputsArePrefetched) {
+  auto qec = ad_utility::testing::getQec();
+  // The inputs are only prefetched if no websocket updates are sent.
+  bool websocketUpdatesEnabled = qec->areWebsocketUpdatesEnabled_;
+  qec->areWebsocketUpdatesEnabled_ = false;
+  absl::Cleanup restoreWebsocketUpdates{
+      [&]() { qec->areWebsocketUpdatesEnabled_ = websocketUpdatesEnabled; }};
+  auto budgetCleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::threadBudget_>(8);
+  auto materializationCleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::lazyIndexScanMaxSizeMaterialization_>(0);
+  auto queueCleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::lazyJoinPrefetchQueueSize_>(1);
+
+  auto makeTables = [](std::vector<int64_t> values) {
+    std::vector<IdTable> tables;
+    for (auto value : values) {
+      tables.push_back(makeIdTableFromVector({{I(value)}, {I(value + 1)}}));
+    }
+    return tables;
+  };
+  auto leftTree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeTables({0, 2, 4, 6}), Vars{Variable{"?s"}}, false,
+      std::vector<ColumnIndex>{0});
+  auto rightTree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeTables({1, 5, 9}), Vars{Variable{"?s"}}, false,
+      std::vector<ColumnIndex>{0});
+  Join join{qec, leftTree, rightTree, 0, 0, true};
+  qec->getQueryTreeCache().clearAll();
+  auto result = join.computeResultOnlyForTesting(false);
+  ASSERT_TRUE(result.isFullyMaterialized());
+  EXPECT_EQ(result.idTable(),
+            makeIdTableFromVector({{I(1)}, {I(2)}, {I(5)}, {I(6)}}));
+}
+
 // _____________________________________________________________________________
 INSTANTIATE_TEST_SUITE_P(JoinTestWithAndWithoutKeptJoinColumn,
                          JoinTestParametrized, ::testing::Values(true, false));
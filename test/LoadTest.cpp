@@ -237,6 +237,49 @@ TEST_F(LoadTest, computeResult) {
       {{Iri("<http://mundhahs.dev/rdf/bar>"), Iri("<is-a>"), Iri("<x>")}});
 }
 
+TEST_F(LoadTest, lazyResult) {
+  // With a tiny blocksize, the body is parsed in many small blocks.
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::loadParserBlocksize_>(
+          ad_utility::MemorySize::bytes(1));
+  std::string body = "<a> <b> <c> .\n<d> <e> <f> .\n<g> <h> \"i\" .\n";
+  auto getResult = getResultFunctionFactory(body);
+
+  Load load{testQec, pqLoad("https://mundhahs.dev"), getResult};
+  auto res = load.computeResultOnlyForTesting(true);
+  ASSERT_FALSE(res.isFullyMaterialized());
+  size_t numRows = 0;
+  for (const auto& pair : res.idTables()) {
+    EXPECT_EQ(pair.idTable_.numColumns(), 3);
+    numRows += pair.idTable_.numRows();
+  }
+  EXPECT_EQ(numRows, 3);
+
+  // The same triples are returned when a materialized result is requested.
+  Load materializedLoad{testQec, pqLoad("https://mundhahs.dev"), getResult};
+  auto materialized = materializedLoad.computeResultOnlyForTesting(false);
+  ASSERT_TRUE(materialized.isFullyMaterialized());
+  EXPECT_EQ(materialized.idTable().numRows(), 3);
+
+  // A `LOAD SILENT` is always computed completely, s.t. errors in the middle
+  // of the document don't lead to a partially loaded document.
+  Load silentLoad{testQec, pqLoad("https://mundhahs.dev", true),
+                  getResultFunctionFactory(body + "this is not turtle")};
+  auto silent = silentLoad.computeResultOnlyForTesting(true);
+  ASSERT_TRUE(silent.isFullyMaterialized());
+  EXPECT_THAT(silent.idTable(), testing::IsEmpty());
+
+  // Errors in the middle of a lazy `LOAD` are thrown during the iteration.
+  Load failingLoad{testQec, pqLoad("https://mundhahs.dev"),
+                   getResultFunctionFactory(body + "this is not turtle")};
+  auto failing = failingLoad.computeResultOnlyForTesting(true);
+  auto consume = [&failing]() {
+    for ([[maybe_unused]] const auto& pair : failing.idTables()) {
+    }
+  };
+  AD_EXPECT_THROW_WITH_MESSAGE(consume(), testing::HasSubstr("Parse error"));
+}
+
 TEST_F(LoadTest, getCacheKey) {
   {
     auto cleanup =
@@ -666,3 +666,69 @@ TEST(LocalVocab, reserveBlankNodeBlocksFromExplicitIndices_PreconditionCheck) {
       vocab.reserveBlankNodeBlocksFromExplicitIndices(indices, &bnm),
       ::testing::HasSubstr("Assertion"));
 }
+
+// _____________________________________________________________________________
+TEST(LocalVocab, wordSet) {
+  auto* qec = ad_utility::testing::getQec();
+  TestWords testWords =
+      getTestCollectionOfWords(1000, qec->getLocalVocabContext());
+  LocalVocabWordSet set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(set.begin(), set.end());
+
+  // Insert all the words and remember their addresses (which span several
+  // blocks of the arena).
+  std::vector<const LocalVocabEntry*> pointers;
+  for (const auto& word : testWords) {
+    auto [pointer, isNew] = set.insert(word);
+    EXPECT_TRUE(isNew);
+    EXPECT_EQ(*pointer, word);
+    pointers.push_back(pointer);
+  }
+  EXPECT_EQ(set.size(), testWords.size());
+
+  // Inserting the words again (also as rvalues) doesn't add them again and
+  // returns the original addresses.
+  for (size_t i = 0; i < testWords.size(); ++i) {
+    auto [pointer, isNew] = set.insert(LocalVocabEntry{testWords[i]});
+    EXPECT_FALSE(isNew);
+    EXPECT_EQ(pointer, pointers[i]);
+    EXPECT_EQ(set.find(testWords[i]), pointers[i]);
+  }
+  EXPECT_EQ(set.size(), testWords.size());
+  EXPECT_EQ(set.find(LocalVocabEntry::literalWithoutQuotes(
+                "notContained", qec->getLocalVocabContext())),
+            nullptr);
+
+  // Moving the set doesn't change the addresses, and the iteration is in the
+  // order of insertion.
+  auto moved = std::move(set);
+  std::vector<const LocalVocabEntry*> iterated;
+  for (const auto& entry : moved) {
+    iterated.push_back(&entry);
+  }
+  EXPECT_EQ(iterated, pointers);
+  EXPECT_EQ(moved.find(testWords.back()), pointers.back());
+}
+
+// _____________________________________________________________________________
+TEST(LocalVocab, computePositionsInVocab) {
+  auto* qec = ad_utility::testing::getQec();
+  const auto& context = qec->getLocalVocabContext();
+  // Enough words to be looked up in parallel, some of them twice.
+  TestWords words = getTestCollectionOfWords(5000, context);
+  TestWords expected = getTestCollectionOfWords(5000, context);
+  std::vector<const LocalVocabEntry*> pointers;
+  for (const auto& word : words) {
+    pointers.push_back(&word);
+  }
+  pointers.push_back(&words.front());
+  LocalVocabEntry::computePositionsInVocab(pointers);
+  for (size_t i = 0; i < words.size(); ++i) {
+    EXPECT_EQ(words[i].positionInVocab(), expected[i].positionInVocab());
+  }
+  // Calling the function again (or for no entries at all) is a no-op.
+  LocalVocabEntry::computePositionsInVocab(pointers);
+  LocalVocabEntry::computePositionsInVocab({});
+  EXPECT_EQ(words.back().positionInVocab(), expected.back().positionInVocab());
+}
@@ -718,6 +718,26 @@ TEST_F(LocatedTriplesTest, locatedTriple) {
                      LT(0, T4, false), LT(0, T5, false), LT(0, T6, false),
                      LT(0, T7, false), LT(1, T8, false)}));
   }
+
+  // Using a `BlockMetadataSearchIndex` for the blocks gives the same results.
+  for (const auto& blocks :
+       {Span{CBM(PT1, PT1), CBM(PT2, PT3), CBM(PT4, PT5), CBM(PT6, PT7),
+             CBM(PT8, PT8)},
+        Span{CBM(PT1, PT1), CBM(PT2, PT7), CBM(PT8, PT8)},
+        Span{CBM(PT1, PT8)}}) {
+    BlockMetadataSearchIndex searchIndex{blocks};
+    for (const auto& triples : {triplesToLocate, triplesToLocateReverse}) {
+      EXPECT_EQ(LT::locateTriplesInPermutation(triples, blocks, keyOrder, true,
+                                               handle, &searchIndex),
+                LT::locateTriplesInPermutation(triples, blocks, keyOrder, true,
+                                               handle));
+    }
+  }
+  // The search index has to belong to the blocks.
+  BlockMetadataSearchIndex searchIndex{Span{CBM(PT1, PT8)}};
+  EXPECT_ANY_THROW(LT::locateTriplesInPermutation(
+      triplesToLocate, Span{CBM(PT1, PT1), CBM(PT2, PT8)}, keyOrder, true,
+      handle, &searchIndex));
 }
 
 TEST_F(LocatedTriplesTest, augmentedMetadata) {
@@ -0,0 +1,85 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "util/LoserTree.h"
+#include "util/Random.h"
+
+namespace {
+using ad_utility::makeLoserTree;
+
+// Merge the `inputs` using a `LoserTree` and return the result.
+template <typename Comparator = std::less<>>
+auto mergeWithLoserTree(std::vector<std::vector<size_t>>& inputs,
+                        Comparator comparator = {}) {
+  auto tree = makeLoserTree(inputs, comparator);
+  std::vector<size_t> result;
+  while (!tree.empty()) {
+    result.push_back(tree.top());
+    tree.pop();
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+TEST(LoserTree, randomInputs) {
+  ad_utility::SlowRandomIntGenerator<size_t> sizeGen{0, 50};
+  ad_utility::FastRandomIntGenerator<uint64_t> valueGen;
+  // Also test numbers of inputs that are not powers of two.
+  for (size_t numInputs : {1, 2, 3, 5, 16, 17, 100, 257}) {
+    std::vector<std::vector<size_t>> inputs(numInputs);
+    std::vector<size_t> expected;
+    for (auto& input : inputs) {
+      input.resize(sizeGen());
+      // Use few distinct values to also have many duplicates.
+      ql::ranges::generate(input, [&valueGen]() { return valueGen() % 100; });
+      ql::ranges::sort(input);
+      ql::ranges::copy(input, std::back_inserter(expected));
+    }
+    ql::ranges::sort(expected);
+    EXPECT_THAT(mergeWithLoserTree(inputs),
+                ::testing::ElementsAreArray(expected));
+  }
+}
+
+// _____________________________________________________________________________
+TEST(LoserTree, emptyInputs) {
+  std::vector<std::vector<size_t>> inputs;
+  EXPECT_TRUE(mergeWithLoserTree(inputs).empty());
+  inputs.resize(3);
+  EXPECT_TRUE(mergeWithLoserTree(inputs).empty());
+  inputs[1] = {3, 4};
+  EXPECT_THAT(mergeWithLoserTree(inputs), ::testing::ElementsAre(3, 4));
+}
+
+// _____________________________________________________________________________
+TEST(LoserTree, stableAndCustomComparator) {
+  // Compare only by the tens, s.t. elements with the same tens are equal.
+  auto byTens = [](size_t a, size_t b) { return a / 10 < b / 10; };
+  std::vector<std::vector<size_t>> inputs{{12, 31}, {10, 30}, {11, 20}};
+  auto tree = makeLoserTree(inputs, byTens);
+  std::vector<std::pair<size_t, size_t>> result;
+  while (!tree.empty()) {
+    result.emplace_back(tree.top(), tree.topIndex());
+    tree.pop();
+  }
+  // Among equal elements, the ones from the inputs with smaller indices come
+  // first.
+  using P = std::pair<size_t, size_t>;
+  EXPECT_THAT(result, ::testing::ElementsAre(P{12, 0}, P{10, 1}, P{11, 2},
+                                             P{20, 2}, P{31, 0}, P{30, 1}));
+
+  // Descending order.
+  std::vector<std::vector<size_t>> descending{{5, 3, 1}, {6, 2}, {4}};
+  EXPECT_THAT(mergeWithLoserTree(descending, std::greater<>{}),
+              ::testing::ElementsAre(6, 5, 4, 3, 2, 1));
+}
+}  // namespace
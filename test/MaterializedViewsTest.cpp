@@ -18,6 +18,8 @@
 #include "./ServerTestHelpers.h"
 #include "./util/HttpRequestHelpers.h"
 #include "./util/RuntimeParametersTestHelpers.h"
+#include "engine/CountAvailablePredicates.h"
+#include "engine/GroupBy.h"
 #include "engine/GroupByImpl.h"
 #include "engine/IndexScan.h"
 #include "engine/MaterializedViews.h"
@@ -30,6 +32,8 @@
 #include "engine/VariableToColumnMap.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionPimpl.h"
+#include "global/SpecialIds.h"
+#include "index/DeltaTriples.h"
 #include "index/EncodedIriManager.h"
 #include "libqlever/Qlever.h"
 #include "parser/MaterializedViewQuery.h"
@@ -1658,6 +1662,63 @@ INSTANTIATE_TEST_SUITE_P(
         // query rewriting. Also uses a different sorting.
         RewriteTestParams{std::string{simpleChainRenamedPlusBind}, 1500}));
 
+// _____________________________________________________________________________
+TEST(MaterializedViewsRewriteTest, staleViewsAreNotUsed) {
+  const std::string onDiskBase = gtestCurrentTestName();
+  materializedViewsTestHelpers::makeTestIndex(
+      onDiskBase,
+      "<s1> <p1> <m1> . <m1> <p2> <o1> . <s2> <p3> <o2> . <m1> <p4> <o3> .");
+  auto cleanUp = absl::MakeCleanup(
+      [&]() { materializedViewsTestHelpers::removeTestIndex(onDiskBase); });
+  qlever::EngineConfig config;
+  config.baseName_ = onDiskBase;
+  config.persistUpdates_ = false;
+  qlever::Qlever qlv{config};
+  qlv.writeMaterializedView("testViewStale", std::string{simpleChain});
+  qlv.loadMaterializedView("testViewStale");
+  const auto view = qlv.materializedViewsManager()->getView("testViewStale");
+  auto chainView = std::bind_front(&viewScanSimple, "testViewStale");
+  auto regularJoin = h::Join(h::IndexScanFromStrings("?s", "<p1>", "?m"),
+                             h::IndexScanFromStrings("?m", "<p2>", "?o"));
+  auto isUnaffected = [&qlv, &view]() {
+    return view->isUnaffectedByUpdates(
+        qlv.createQueryExecutionContext().get());
+  };
+  EXPECT_TRUE(isUnaffected());
+  qpExpect(qlv, simpleChain, chainView("?s", "?m", "?o"));
+
+  auto getId = makeGetId(qlv.index());
+  auto g = qlever::specialIds().at(QLEVER_INTERNAL_GRAPH_IRI);
+  auto cancellationHandle =
+      std::make_shared<ad_utility::SharedCancellationHandle::element_type>();
+  auto insert = [&](std::string_view s, std::string_view p,
+                    std::string_view o) {
+    qlv.index().deltaTriplesManager().modify<void>(
+        [&](DeltaTriples& deltaTriples) {
+          deltaTriples.insertTriples(
+              cancellationHandle,
+              {IdTriple<0>{std::array{getId(std::string{s}),
+                                      getId(std::string{p}),
+                                      getId(std::string{o}), g}}});
+        });
+  };
+
+  // An update of a predicate that the view doesn't depend on doesn't make the
+  // view stale.
+  insert("<s1>", "<p3>", "<o1>");
+  EXPECT_TRUE(isUnaffected());
+  qpExpect(qlv, simpleChain, chainView("?s", "?m", "?o"));
+
+  // After an update of one of the predicates of the view, the view is no
+  // longer used for rewriting the query, because its rows are missing the
+  // result of the update.
+  insert("<s2>", "<p1>", "<m1>");
+  EXPECT_FALSE(isUnaffected());
+  qpExpect(qlv, simpleChain, regularJoin);
+  EXPECT_THAT(qlv.query(std::string{simpleChain}),
+              ::testing::HasSubstr("s2"));
+}
+
 // _____________________________________________________________________________
 TEST_F(MaterializedViewsTest, JoinBetweenLazyScansWithPlaceholderVars) {
   // Regression test for #2866.
@@ -1845,3 +1906,263 @@ TEST_F(MaterializedViewsTest,
   AD_EXPECT_NULLOPT(groupBy.getPermutationForThreeVariableTriple(
       *scanTree, V{"?o"}, V{"?s"}));
 }
+
+// _____________________________________________________________________________
+class MaterializedViewsTransitiveClosureTest : public MaterializedViewsTest {
+ protected:
+  std::string getDummyTurtle() const override {
+    return "<a> <sub> <b> . <b> <sub> <c> . <c> <sub> <a> . <c> <sub> <d> . "
+           "<e> <sub> <d> . <x> <other> <y> .";
+  }
+};
+
+// _____________________________________________________________________________
+TEST_F(MaterializedViewsTransitiveClosureTest, hullsFromPrecomputedClosure) {
+  using M = MaterializedViewsManager;
+  for (bool forward : {true, false}) {
+    qlv().writeMaterializedView(
+        M::getTransitiveClosureViewName("<sub>", forward),
+        M::getTransitiveClosureViewQuery("<sub>", forward));
+  }
+  EXPECT_NE(M::getTransitiveClosureViewName("<sub>", true),
+            M::getTransitiveClosureViewName("<sub>", false));
+  EXPECT_NE(M::getTransitiveClosureViewName("<sub>", true),
+            M::getTransitiveClosureViewName("<other>", true));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      M::getTransitiveClosureViewQuery("sub", true),
+      ::testing::HasSubstr("must be a full IRI in angle brackets"));
+
+  {
+    auto [qet, qec, parsed] = qlv().parseAndPlanQuery("SELECT * { ?s ?p ?o }");
+    const auto& manager = qec->materializedViewsManager();
+    EXPECT_NE(manager.getTransitiveClosureView("<sub>", true), nullptr);
+    EXPECT_NE(manager.getTransitiveClosureView("<sub>", false), nullptr);
+    EXPECT_EQ(manager.getTransitiveClosureView("<other>", true), nullptr);
+  }
+
+  // Return true iff the closure was used by any of the operations.
+  auto usesClosure = [](const RuntimeInformation& info, const auto& self) {
+    if (info.details_.contains("Precomputed closure")) {
+      return true;
+    }
+    return ql::ranges::any_of(info.children_, [&self](const auto& child) {
+      return self(*child, self);
+    });
+  };
+  auto getSortedRows = [this, &usesClosure](const std::string& query,
+                                            bool expectClosure) {
+    auto [qet, qec, parsed] = qlv().parseAndPlanQuery(query);
+    qec->clearCacheUnpinnedOnly();
+    auto result = qet->getResult(false);
+    EXPECT_EQ(usesClosure(qet->getRootOperation()->runtimeInfo(), usesClosure),
+              expectClosure)
+        << query;
+    std::vector<std::vector<Id>> rows;
+    for (const auto& row : result->idTable()) {
+      rows.emplace_back(row.begin(), row.end());
+    }
+    ql::ranges::sort(rows);
+    return rows;
+  };
+
+  // The results with and without the precomputed closure have to be the same.
+  for (std::string query :
+       {"SELECT ?x ?y { ?x <sub>+ ?y }", "SELECT ?x ?y { ?x <sub>* ?y }",
+        "SELECT ?y { <a> <sub>+ ?y }", "SELECT ?y { <d> <sub>* ?y }",
+        "SELECT ?x { ?x <sub>+ <d> }", "SELECT ?x { ?x <sub>* <a> }",
+        "SELECT ?x { ?x <sub>+ ?x }",
+        "SELECT ?x ?y { VALUES ?x { <a> <e> <x> } ?x <sub>* ?y }",
+        "SELECT ?x ?y { VALUES ?y { <d> <a> } ?x <sub>+ ?y }"}) {
+    auto expected = [&]() {
+      auto cleanup = setRuntimeParameterForTest<
+          &RuntimeParameters::usePrecomputedTransitiveClosures_>(false);
+      return getSortedRows(query, false);
+    }();
+    EXPECT_THAT(getSortedRows(query, true),
+                ::testing::ElementsAreArray(expected))
+        << query;
+  }
+
+  // Paths with an upper bound and paths of other predicates can't use the
+  // closure.
+  getSortedRows("SELECT ?x ?y { ?x <sub>? ?y }", false);
+  getSortedRows("SELECT ?x ?y { ?x <other>+ ?y }", false);
+}
+
+// _____________________________________________________________________________
+TEST(MaterializedViewsQueryAnalysisTest, analyzeFacetStatisticsQuery) {
+  using namespace materializedViewsQueryAnalysis;
+  using V = Variable;
+  auto analyze = [](const std::string& query) {
+    EncodedIriManager encodedIriManager;
+    return analyzeFacetStatisticsQuery(
+        SparqlParser::parseQuery(&encodedIriManager, query));
+  };
+  auto expectColumns = [&analyze](const std::string& query,
+                                  FacetStatistics statistics,
+                                  const std::vector<TripleComponent>& columns) {
+    auto facetQuery = analyze(query);
+    ASSERT_TRUE(facetQuery.has_value()) << query;
+    EXPECT_EQ(facetQuery->statistics_, statistics);
+    std::array<V, 3> viewColumns{
+        statistics == FacetStatistics::ClassPredicate ? V{"?class"}
+                                                      : V{"?predicate"},
+        statistics == FacetStatistics::ClassPredicate ? V{"?predicate"}
+                                                      : V{"?object"},
+        V{"?count"}};
+    ASSERT_EQ(facetQuery->columns_.size(), 3);
+    for (size_t i = 0; i < 3; ++i) {
+      EXPECT_EQ(facetQuery->columns_.at(viewColumns[i]), columns.at(i));
+    }
+  };
+
+  expectColumns(
+      "SELECT ?c ?p (COUNT(DISTINCT ?s) AS ?n) "
+      "{ ?s a ?c . ?s ?p ?o } GROUP BY ?p ?c ORDER BY DESC(?n)",
+      FacetStatistics::ClassPredicate, {V{"?c"}, V{"?p"}, V{"?n"}});
+  expectColumns(
+      "SELECT ?p (COUNT(DISTINCT ?s) AS ?n) "
+      "{ ?s ?p ?o . ?s a <C> } GROUP BY ?p",
+      FacetStatistics::ClassPredicate, {iri("<C>"), V{"?p"}, V{"?n"}});
+  expectColumns(
+      "SELECT ?p ?o (COUNT(?s) AS ?n) { ?s ?p ?o } GROUP BY ?p ?o",
+      FacetStatistics::PredicateObject, {V{"?p"}, V{"?o"}, V{"?n"}});
+  expectColumns(
+      "SELECT ?o (COUNT(?s) AS ?n) { ?s <p> ?o } GROUP BY ?o "
+      "ORDER BY DESC(?n) LIMIT 10",
+      FacetStatistics::PredicateObject, {iri("<p>"), V{"?o"}, V{"?n"}});
+
+  // Queries that don't match the precomputed statistics.
+  for (std::string query : {
+           // The wrong kind of count.
+           "SELECT ?c ?p (COUNT(?s) AS ?n) "
+           "{ ?s a ?c . ?s ?p ?o } GROUP BY ?c ?p",
+           "SELECT ?p ?o (COUNT(DISTINCT ?s) AS ?n) { ?s ?p ?o } "
+           "GROUP BY ?p ?o",
+           "SELECT ?p ?o (COUNT(?o) AS ?n) { ?s ?p ?o } GROUP BY ?p ?o",
+           "SELECT ?p ?o (COUNT(*) AS ?n) { ?s ?p ?o } GROUP BY ?p ?o",
+           // Another grouping.
+           "SELECT ?p (COUNT(DISTINCT ?s) AS ?n) "
+           "{ ?s a ?c . ?s ?p ?o } GROUP BY ?p",
+           "SELECT ?p (COUNT(?s) AS ?n) { ?s ?p ?o } GROUP BY ?p",
+           // Other graph patterns.
+           "SELECT ?p ?o (COUNT(?s) AS ?n) { ?s ?p ?o FILTER(?o != 3) } "
+           "GROUP BY ?p ?o",
+           "SELECT ?p ?o (COUNT(?s) AS ?n) { ?s ?p ?o . ?s <q> ?x } "
+           "GROUP BY ?p ?o",
+           "SELECT ?c ?p (COUNT(DISTINCT ?s) AS ?n) "
+           "{ ?s a ?c . ?x ?p ?o } GROUP BY ?c ?p",
+           "SELECT ?p (COUNT(?s) AS ?n) { ?s ?p ?p } GROUP BY ?p",
+           "SELECT ?o (COUNT(?s) AS ?n) { ?s <p>+ ?o } GROUP BY ?o",
+           // Additional aliases.
+           "SELECT ?p ?o (COUNT(?s) AS ?n) (MIN(?s) AS ?m) { ?s ?p ?o } "
+           "GROUP BY ?p ?o"}) {
+    AD_EXPECT_NULLOPT(analyze(query)) << query;
+  }
+}
+
+// _____________________________________________________________________________
+TEST(MaterializedViewsQueryAnalysisTest, extractDependentPredicates) {
+  using namespace materializedViewsQueryAnalysis;
+  using ::testing::UnorderedElementsAre;
+  auto extract = [](const std::string& query) {
+    EncodedIriManager encodedIriManager;
+    return extractDependentPredicates(
+        SparqlParser::parseQuery(&encodedIriManager, query));
+  };
+  auto predicates =
+      extract("SELECT * { ?s <p1> ?m . ?m <p2> ?o . ?o <p1> 3 . BIND(1 AS ?x) "
+              "VALUES ?y { 1 2 } FILTER(?o != 4) }");
+  ASSERT_TRUE(predicates.has_value());
+  EXPECT_THAT(predicates.value(), UnorderedElementsAre("<p1>", "<p2>"));
+
+  // Queries that might depend on arbitrary triples.
+  for (std::string query :
+       {"SELECT * { ?s ?p ?o }", "SELECT * { ?s <p1>+ ?o }",
+        "SELECT * { ?s <p1> ?o OPTIONAL { ?o <p2> ?x } }",
+        "SELECT * { { ?s <p1> ?o } UNION { ?s <p2> ?o } }",
+        "SELECT * { ?s <p1> ?o { SELECT ?o { ?o <p2> ?x } } }"}) {
+    AD_EXPECT_NULLOPT(extract(query)) << query;
+  }
+}
+
+// _____________________________________________________________________________
+class MaterializedViewsFacetStatisticsTest : public MaterializedViewsTest {
+ protected:
+  std::string getDummyTurtle() const override {
+    std::string type = "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type>";
+    return absl::StrCat("<a> ", type, " <C> . <a> <p> <x> . <a> <q> <y> . ",
+                        "<b> ", type, " <C> . <b> ", type, " <D> . ",
+                        "<b> <p> <x> . <c> ", type, " <D> . <c> <p> <z> . ",
+                        "<c> <p> <x> . <d> <q> <y> .");
+  }
+};
+
+// _____________________________________________________________________________
+TEST_F(MaterializedViewsFacetStatisticsTest, groupByFromPrecomputedStatistics) {
+  using M = MaterializedViewsManager;
+  for (auto statistics :
+       {FacetStatistics::ClassPredicate, FacetStatistics::PredicateObject}) {
+    qlv().writeMaterializedView(M::getFacetStatisticsViewName(statistics),
+                                M::getFacetStatisticsViewQuery(statistics));
+  }
+
+  // Return true iff the `GROUP BY` is computed at query time.
+  auto computesGroupBy = [](QueryExecutionTree& qet, const auto& self) -> bool {
+    auto* operation = qet.getRootOperation().get();
+    if (dynamic_cast<const GroupBy*>(operation) != nullptr ||
+        dynamic_cast<const CountAvailablePredicates*>(operation) != nullptr) {
+      return true;
+    }
+    return ql::ranges::any_of(
+        operation->getChildren(),
+        [&self](QueryExecutionTree* child) { return self(*child, self); });
+  };
+  auto getRows = [this, &computesGroupBy](const std::string& query,
+                                          bool expectGroupBy) {
+    auto [qet, qec, parsed] = qlv().parseAndPlanQuery(query);
+    EXPECT_EQ(computesGroupBy(*qet, computesGroupBy), expectGroupBy) << query;
+    qec->clearCacheUnpinnedOnly();
+    auto result = getQueryResultAsIdTable(query);
+    std::vector<std::vector<Id>> rows;
+    for (const auto& row : result) {
+      rows.emplace_back(row.begin(), row.end());
+    }
+    ql::ranges::sort(rows);
+    return rows;
+  };
+
+  // The results with and without the precomputed statistics have to be the
+  // same.
+  for (std::string query :
+       {"SELECT ?c ?p (COUNT(DISTINCT ?s) AS ?n) "
+        "{ ?s a ?c . ?s ?p ?o } GROUP BY ?c ?p",
+        "SELECT ?p (COUNT(DISTINCT ?s) AS ?n) { ?s a <D> . ?s ?p ?o } "
+        "GROUP BY ?p",
+        "SELECT ?p ?o (COUNT(?s) AS ?n) { ?s ?p ?o } GROUP BY ?p ?o",
+        "SELECT ?o (COUNT(?s) AS ?n) { ?s <p> ?o } GROUP BY ?o "
+        "ORDER BY DESC(?n) LIMIT 1",
+        "SELECT ?o (COUNT(?s) AS ?n) { ?s <q> ?o } GROUP BY ?o "
+        "HAVING (?n > 1)",
+        "SELECT ?o (COUNT(?s) AS ?n) { ?s <unknown> ?o } GROUP BY ?o"}) {
+    auto expected = [&]() {
+      auto cleanup = setRuntimeParameterForTest<
+          &RuntimeParameters::enableMaterializedViewQueryRewrite_>(false);
+      return getRows(query, true);
+    }();
+    EXPECT_EQ(getRows(query, false), expected) << query;
+  }
+  EXPECT_EQ(getRows("SELECT ?o (COUNT(?s) AS ?n) { ?s <p> ?o } GROUP BY ?o "
+                    "ORDER BY DESC(?n) LIMIT 1",
+                    false)
+                .size(),
+            1);
+
+  // Other `GROUP BY` queries are computed as usual.
+  getRows(
+      "SELECT ?c ?p (COUNT(?s) AS ?n) { ?s a ?c . ?s ?p ?o } GROUP BY ?c ?p",
+      true);
+  getRows("SELECT ?p ?o (COUNT(?s) AS ?n) FROM <g> { ?s ?p ?o } "
+          "GROUP BY ?p ?o",
+          true);
+}
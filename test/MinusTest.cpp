@@ -7,7 +7,9 @@
 #include <array>
 #include <vector>
 
+#include "./engine/LazyJoinTestHelpers.h"
 #include "./util/IdTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
 #include "engine/CallFixedSize.h"
 #include "engine/IndexScan.h"
 #include "engine/JoinHelpers.h"
@@ -857,3 +859,122 @@ TEST(Minus, resultSortedOn) {
   // Sort would be added if it's not already sorted enough.
   EXPECT_THAT(getSortOrder(biggerWithUndef, {0, 1, 2}), ElementsAre(0, 1, 2));
 }
+
+// Test fixture for the `MINUS` with an `IndexScan` as its right child. The
+// parameter determines whether the result is requested lazily.
+class MinusWithIndexScan : public ::testing::TestWithParam<bool>,
+                           public ad_utility::testing::LazyJoinTestHelper {
+ protected:
+  void SetUp() override {
+    // Using 8 bytes per column gives us a single triple per block.
+    std::string kg =
+        "<a> <p> <A> . <a> <p> <A2> . "
+        "<b> <p> <B> . <b> <p> <B2> . "
+        "<c> <p> <C> . <c> <p> <C2> . "
+        "<d> <p> <D> . "
+        "<e> <p> <E> . ";
+    setupQecWithKnowledgeGraph(kg, 8_B);
+  }
+
+  // Return the scan `?x <p> ?y` on the PSO permutation.
+  std::shared_ptr<QueryExecutionTree> makeIndexScan() const {
+    SparqlTripleSimple xpy{TripleComponent{Variable{"?x"}},
+                           ad_utility::testing::iri("<p>"),
+                           TripleComponent{Variable{"?y"}}};
+    return ad_utility::makeExecutionTree<IndexScan>(qec_, Permutation::PSO,
+                                                    xpy);
+  }
+
+  // Return a single column `?x` with the (sorted) `ids`. If `lazy` is true,
+  // each row is yielded as a separate block, otherwise the result is always
+  // fully materialized.
+  std::shared_ptr<QueryExecutionTree> makeLeftSide(std::vector<Id> ids,
+                                                   bool lazy) const {
+    ql::ranges::sort(ids);
+    std::vector<std::optional<Variable>> variables{Variable{"?x"}};
+    std::vector<IdTable> tables;
+    IdTable table{1, qec_->getAllocator()};
+    for (Id id : ids) {
+      table.push_back({id});
+      if (lazy) {
+        tables.push_back(std::move(table));
+        table = IdTable{1, qec_->getAllocator()};
+      }
+    }
+    if (lazy) {
+      return ad_utility::makeExecutionTree<ValuesForTesting>(
+          qec_, std::move(tables), std::move(variables), false,
+          std::vector<ColumnIndex>{0});
+    }
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec_, std::move(table), std::move(variables), false,
+        std::vector<ColumnIndex>{0}, LocalVocab{}, std::nullopt, true);
+  }
+
+  // Compute the `minus` (lazily iff the test parameter is true) and return
+  // the rows of the result.
+  IdTable computeMinus(Minus& minus) const {
+    qec_->getQueryTreeCache().clearAll();
+    bool requestLaziness = GetParam();
+    auto result = minus.computeResultOnlyForTesting(requestLaziness);
+    EXPECT_EQ(result.isFullyMaterialized(), !requestLaziness);
+    if (result.isFullyMaterialized()) {
+      return result.idTable().clone();
+    }
+    IdTable table{minus.getResultWidth(), qec_->getAllocator()};
+    for (auto& [idTable, localVocab] : result.idTables()) {
+      table.insertAtEnd(idTable);
+    }
+    return table;
+  }
+
+  // Return the number of blocks that were read by the right child of the
+  // `minus`, and the total number of blocks.
+  static std::pair<size_t, size_t> getBlockStats(Minus& minus) {
+    const auto& rti =
+        minus.getChildren().at(1)->getRootOperation()->runtimeInfo();
+    return {rti.details_["num-blocks-read"].get<size_t>(),
+            rti.details_["num-blocks-all"].get<size_t>()};
+  }
+};
+
+// _____________________________________________________________________________
+TEST_P(MinusWithIndexScan, onlyMatchingBlocksAreRead) {
+  using ad_utility::testing::iri;
+  auto a = toValueId(iri("<a>"));
+  auto c = toValueId(iri("<c>"));
+  auto upperA = toValueId(iri("<A>"));
+  auto p = toValueId(iri("<p>"));
+  auto expected = makeIdTableFromVector(
+      {{std::min(upperA, p)}, {std::max(upperA, p)}});
+  for (bool lazyLeft : {false, true}) {
+    Minus minus{qec_, makeLeftSide({a, c, upperA, p}, lazyLeft),
+                makeIndexScan()};
+    EXPECT_EQ(computeMinus(minus), expected);
+    // Only the four blocks for `<a>` and `<c>` are read.
+    EXPECT_EQ(getBlockStats(minus), std::pair(size_t{4}, size_t{8}));
+  }
+
+  // The optimization can be disabled.
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::prefilteredMinus_>(false);
+  Minus minus{qec_, makeLeftSide({a, c, upperA, p}, false), makeIndexScan()};
+  EXPECT_EQ(computeMinus(minus), expected);
+}
+
+// _____________________________________________________________________________
+TEST_P(MinusWithIndexScan, undefAndEmptyLeftSide) {
+  using ad_utility::testing::iri;
+  auto a = toValueId(iri("<a>"));
+  for (bool lazyLeft : {false, true}) {
+    // UNDEF values are never removed by a `MINUS`.
+    Minus minus{qec_, makeLeftSide({U, a}, lazyLeft), makeIndexScan()};
+    EXPECT_EQ(computeMinus(minus), makeIdTableFromVector({{U}}));
+
+    Minus emptyMinus{qec_, makeLeftSide({}, lazyLeft), makeIndexScan()};
+    EXPECT_TRUE(computeMinus(emptyMinus).empty());
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(MinusWithIndexScanSuite, MinusWithIndexScan,
+                         ::testing::Bool());
@@ -16,6 +16,7 @@
 #include "util/IdTestHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using ad_utility::testing::makeAllocator;
 namespace {
@@ -110,6 +111,50 @@ TEST(MultiColumnJoin, clone) {
   EXPECT_EQ(getVars(clone->getDescriptor()), getVars(join.getDescriptor()));
 }
 
+// _____________________________________________________________________________
+TEST(MultiColumnJoin, joinLargeInputsInParallel) {
+  auto* qec = ad_utility::testing::getQec();
+  auto I = ad_utility::testing::IntId;
+  auto U = Id::makeUndefined();
+  auto budgetCleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::threadBudget_>(4);
+  // Both inputs are sorted by the join columns 0 and 1. The second join
+  // column of the right input contains UNDEF values, which are handled within
+  // the partitions of the first join column.
+  IdTable a{3, makeAllocator()};
+  for (int64_t i = 0; i < 400'000; ++i) {
+    a.push_back({I(i / 4), I((i % 4) / 2), I(i)});
+  }
+  IdTable b{3, makeAllocator()};
+  for (int64_t i = 0; i < 200'000; ++i) {
+    b.push_back({I(i / 2), i % 2 == 0 ? U : I(1), I(-i)});
+  }
+  std::vector<std::array<ColumnIndex, 2>> joinColumns{{0, 0}, {1, 1}};
+  auto computeJoin = [&](size_t numThreads) {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::joinNumThreads_>(
+            numThreads);
+    IdTable result{4, makeAllocator()};
+    MultiColumnJoin{qec, idTableToExecutionTree(qec, a),
+                    idTableToExecutionTree(qec, b)}
+        .computeMultiColumnJoin(a.asStaticView<0>(), b.asStaticView<0>(),
+                                joinColumns, &result);
+    EXPECT_TRUE(ql::ranges::is_sorted(result.getColumn(0)));
+    // The order of rows with the same join values might be different.
+    std::vector<std::array<Id, 4>> rows;
+    for (const auto& row : result) {
+      rows.push_back({row[0], row[1], row[2], row[3]});
+    }
+    ql::ranges::sort(rows);
+    return rows;
+  };
+  auto expected = computeJoin(1);
+  // For each value of the first join column, the UNDEF value matches four rows
+  // and the value `1` matches two rows of the left input.
+  EXPECT_EQ(expected.size(), 600'000);
+  EXPECT_EQ(computeJoin(4), expected);
+}
+
 // _____________________________________________________________________________
 TEST(MultiColumnJoin, columnOriginatesFromGraphOrUndef) {
   using ad_utility::triple_component::Iri;
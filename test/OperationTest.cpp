@@ -683,6 +683,19 @@ QueryCacheKey makeQueryCacheKey(std::string s) {
 }
 }  // namespace
 
+// _____________________________________________________________________________
+TEST(QueryCacheKey, fingerprint) {
+  auto key = makeQueryCacheKey("SCAN ?x <p> ?y");
+  EXPECT_EQ(key.key_, "SCAN ?x <p> ?y");
+  EXPECT_EQ(key, makeQueryCacheKey("SCAN ?x <p> ?y"));
+  EXPECT_EQ(absl::HashOf(key), absl::HashOf(makeQueryCacheKey(key.key_)));
+  EXPECT_NE(key, makeQueryCacheKey("SCAN ?x <p> ?z"));
+  EXPECT_NE(key, (QueryCacheKey{key.key_, 3}));
+  // The same key for a different index.
+  EXPECT_NE(key, (QueryCacheKey{key.key_, 102394857, 1}));
+  EXPECT_NE(key.fingerprint_[0], key.fingerprint_[1]);
+}
+
 // _____________________________________________________________________________
 TEST(Operation, ensureLazyOperationIsCachedIfSmallEnough) {
   auto qec = getQec();
@@ -850,8 +863,8 @@ TEST(OperationTest, disableCachingForOperation) {
   ValuesForTesting valuesForTesting{
       qec, std::move(idTablesVector), {Variable{"?x"}, Variable{"?y"}}, true};
 
-  QueryCacheKey cacheKey{valuesForTesting.getCacheKey(),
-                         qec->locatedTriplesState().index_};
+  QueryCacheKey cacheKey =
+      qec->makeQueryCacheKey(valuesForTesting.getCacheKey());
 
   // By default, the result of `valuesForTesting` is cached because it is
   // sufficiently small, no matter if it was computed lazily or fully
@@ -893,8 +906,8 @@ TEST(OperationTest, disableCachingGlobally) {
 
   EXPECT_THAT(valuesForTesting.getCacheKey(), ::testing::IsEmpty());
 
-  QueryCacheKey cacheKey{valuesForTesting.getCacheKey(),
-                         qec->locatedTriplesState().index_};
+  QueryCacheKey cacheKey =
+      qec->makeQueryCacheKey(valuesForTesting.getCacheKey());
 
   // Initially not contained in the cache (because we cleared the cache).
   EXPECT_FALSE(qec->getQueryTreeCache().cacheContains(cacheKey));
@@ -5,11 +5,15 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <array>
+#include <limits>
+
 #include "./util/IdTableHelpers.h"
 #include "./util/IdTestHelpers.h"
 #include "engine/OrderBy.h"
 #include "engine/ValuesForTesting.h"
 #include "global/ValueIdComparators.h"
+#include "index/IdTableUtils.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
 
@@ -198,6 +202,62 @@ TEST(OrderBy, mixedDatatypes) {
               {true});
 }
 
+// _____________________________________________________________________________
+TEST(OrderBy, largeInputIsRadixSorted) {
+  auto I = ad_utility::testing::IntId;
+  auto V = ad_utility::testing::VocabId;
+  auto D = ad_utility::testing::DoubleId;
+  auto U = Id::makeUndefined();
+  auto qec = ad_utility::testing::getQec();
+
+  // Negative numbers, NaN, and undefined values in all the sort columns.
+  const size_t numRows = IdTableUtils::minNumRowsForRadixSort;
+  IdTable input{3, qec->getAllocator()};
+  input.resize(numRows);
+  for (size_t i = 0; i < numRows; ++i) {
+    auto r = static_cast<int64_t>((i * 7919) % 1009);
+    input(i, 0) = r % 13 == 0 ? U : I(r % 37 - 18);
+    input(i, 1) = r % 17 == 0 ? D(std::numeric_limits<double>::quiet_NaN())
+                              : D(static_cast<double>(r % 23) / 4.0 - 2.5);
+    input(i, 2) = r % 11 == 0 ? U : V(r);
+  }
+
+  auto compareColumn = [](Id a, Id b) {
+    using namespace valueIdComparators;
+    return toBoolNotUndef(
+        compareIds<ComparisonForIncompatibleTypes::CompareByType>(
+            a, b, Comparison::LT));
+  };
+  for (OrderBy::SortIndices sortColumns :
+       {OrderBy::SortIndices{{0, false}}, {{1, true}, {0, false}},
+        {{2, false}, {1, false}, {0, true}}}) {
+    std::vector<std::array<Id, 3>> expected;
+    for (const auto& row : input) {
+      expected.push_back({row[0], row[1], row[2]});
+    }
+    ql::ranges::stable_sort(expected, [&](const auto& a, const auto& b) {
+      for (auto [column, isDescending] : sortColumns) {
+        if (a[column] != b[column]) {
+          return isDescending ? compareColumn(b[column], a[column])
+                              : compareColumn(a[column], b[column]);
+        }
+      }
+      return false;
+    });
+
+    OrderBy orderBy = makeOrderBy(input.clone(), sortColumns);
+    auto result = orderBy.computeResultOnlyForTesting();
+    const auto& table = result.idTable();
+    ASSERT_EQ(table.numRows(), numRows);
+    for (size_t i = 0; i < numRows; ++i) {
+      for (auto [column, isDescending] : sortColumns) {
+        ASSERT_EQ(table(i, column), expected[i][column]) << i;
+      }
+    }
+    EXPECT_EQ(orderBy.runtimeInfo().details_["is-radix-sort"], true);
+  }
+}
+
 // _____________________________________________________________________________
 TEST(OrderBy, simpleMemberFunctions) {
   {
@@ -272,3 +332,79 @@ TEST(OrderBy, clone) {
   EXPECT_THAT(orderBy, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), orderBy.getDescriptor());
 }
+
+// _____________________________________________________________________________
+TEST(OrderBy, topKWithLimitAndOffset) {
+  auto* qec = ad_utility::testing::getQec();
+  // The values of the first column are a permutation of `[0, 1000)`.
+  VectorTable input;
+  for (int64_t i = 0; i < 1000; ++i) {
+    input.push_back({(i * 7) % 1000, i});
+  }
+  auto inputTable = makeIdTableFromVector(input, &Id::makeFromInt);
+  OrderBy::SortIndices sortIndices{{0, true}};
+
+  // The expected result is obtained by a full sort and then applying the
+  // `LIMIT` and `OFFSET`.
+  auto getExpected = [&](size_t limit, size_t offset) {
+    OrderBy fullSort = makeOrderBy(inputTable.clone(), sortIndices);
+    auto result = fullSort.getResult();
+    const auto& table = result->idTable();
+    IdTable expected{2, qec->getAllocator()};
+    size_t begin = std::min(offset, table.numRows());
+    size_t end = std::min(offset + limit, table.numRows());
+    expected.insertAtEnd(table, begin, end);
+    return expected;
+  };
+
+  // The input as multiple blocks of a lazy result.
+  auto makeLazyOrderBy = [&]() {
+    std::vector<IdTable> blocks;
+    for (size_t begin = 0; begin < inputTable.numRows(); begin += 137) {
+      IdTable block{2, qec->getAllocator()};
+      block.insertAtEnd(inputTable, begin,
+                        std::min(begin + 137, inputTable.numRows()));
+      blocks.push_back(std::move(block));
+    }
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(blocks),
+        std::vector<std::optional<Variable>>{Variable{"?0"}, Variable{"?1"}});
+    return OrderBy{qec, std::move(subtree), sortIndices};
+  };
+
+  for (auto [limit, offset] : std::vector<std::pair<size_t, size_t>>{
+           {10, 0}, {10, 5}, {1, 999}, {300, 100}, {2000, 0}, {5, 2000}}) {
+    auto expected = getExpected(limit, offset);
+    {
+      OrderBy orderBy = makeOrderBy(inputTable.clone(), sortIndices);
+      orderBy.applyLimitOffset({limit, offset});
+      auto result = orderBy.getResult();
+      EXPECT_EQ(result->idTable(), expected);
+    }
+    {
+      OrderBy orderBy = makeLazyOrderBy();
+      orderBy.applyLimitOffset({limit, offset});
+      auto result = orderBy.getResult();
+      EXPECT_EQ(result->idTable(), expected);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(OrderBy, handlesLimitOffset) {
+  VectorTable input{{3, 0}, {1, 1}, {2, 2}};
+  auto inputTable = makeIdTableFromVector(input, &Id::makeFromInt);
+  OrderBy orderBy = makeOrderBy(std::move(inputTable), {{0, false}});
+  EXPECT_EQ(orderBy.handlesLimitOffset(), LimitOffsetHandling::FULL);
+
+  // The `LIMIT` must not be propagated to the input.
+  orderBy.applyLimitOffset({0, 1});
+  EXPECT_TRUE(orderBy.getChildren()
+                  .at(0)
+                  ->getRootOperation()
+                  ->getLimitOffset()
+                  .isUnconstrained());
+  auto result = orderBy.getResult();
+  EXPECT_EQ(result->idTable().numRows(), 0);
+  EXPECT_EQ(result->idTable().numColumns(), 2);
+}
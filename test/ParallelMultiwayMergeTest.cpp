@@ -114,4 +114,7 @@ TEST(ParallelMultiwayMerge, randomInputs) {
   testRandomInts<13, 1, 40, 40>();
   testRandomInts<5, 2, 40, 50>();
   testRandomInts<1, 3, 30, 50>();
+  // Exactly the maximal number of inputs for a single loser tree, some of
+  // which are empty.
+  testRandomInts<7, 16, 0, 30>();
 }
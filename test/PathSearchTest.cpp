@@ -13,6 +13,7 @@
 #include "util/IdTestHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using ad_utility::testing::getQec;
 namespace {
@@ -648,6 +649,69 @@ TEST(PathSearchTest, multiSourceMultiTargetallPathsNotCartesian) {
               ::testing::UnorderedElementsAreArray(expected));
 }
 
+/**
+ * Graph:
+ *     i -> 1000 + i   (for i in [0, 100))
+ *     i -> 2000 -> 2001
+ *
+ * The paths from many sources are searched by multiple threads, the edges to
+ * the nodes `1000 + i` can't lead to the target and are pruned.
+ */
+TEST(PathSearchTest, manySourcesWithMultipleThreads) {
+  const int64_t numSources = 100;
+  VectorTable edges{{int64_t{2000}, int64_t{2001}}};
+  std::vector<Id> sources;
+  for (int64_t i = 0; i < numSources; i++) {
+    edges.push_back({i, 1000 + i});
+    edges.push_back({i, int64_t{2000}});
+    sources.push_back(V(i));
+  }
+  std::vector<Id> targets{V(2001)};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}};
+
+  for (size_t numThreads : {1, 2, 16}) {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::pathSearchNumThreads_>(
+            numThreads);
+    // With a target, only the two edges to the target are found per source.
+    // The paths are ordered by their source, independent of the threads.
+    {
+      VectorTable expected;
+      for (int64_t i = 0; i < numSources; i++) {
+        expected.push_back({V(i), V(2000), I(i), I(0)});
+        expected.push_back({V(2000), V(2001), I(i), I(1)});
+      }
+      PathSearchConfiguration config{PathSearchAlgorithm::ALL_PATHS,
+                                     sources,
+                                     targets,
+                                     Var{"?start"},
+                                     Var{"?end"},
+                                     Var{"?edgeIndex"},
+                                     Var{"?pathIndex"},
+                                     {}};
+      auto resultTable =
+          performPathSearch(config, makeIdTableFromVector(edges), vars);
+      ASSERT_THAT(resultTable.idTable(),
+                  ::testing::ElementsAreArray(makeIdTableFromVector(expected)));
+    }
+    // Without targets, the paths to all reachable nodes are found.
+    {
+      PathSearchConfiguration config{PathSearchAlgorithm::ALL_PATHS,
+                                     sources,
+                                     std::vector<Id>{},
+                                     Var{"?start"},
+                                     Var{"?end"},
+                                     Var{"?edgeIndex"},
+                                     Var{"?pathIndex"},
+                                     {}};
+      auto resultTable =
+          performPathSearch(config, makeIdTableFromVector(edges), vars);
+      // Per source: `i -> 1000 + i`, `i -> 2000` and `i -> 2000 -> 2001`.
+      ASSERT_EQ(resultTable.idTable().numRows(), 4 * numSources);
+    }
+  }
+}
+
 TEST(PathSearchTest, sourceBound) {
   auto sub = makeIdTableFromVector({{0, 1}, {1, 2}, {2, 3}, {3, 4}});
   auto sourceTable = makeIdTableFromVector({{0}});
@@ -1230,6 +1230,152 @@ TEST_F(PrefilterExpressionOnMetadataTest, testWithFewBlockMetadataValues) {
             std::vector<CompressedBlockMetadata>{});
 }
 
+//______________________________________________________________________________
+// Test the prefiltering using the per-block column statistics, which is used
+// for the columns by which the blocks are not sorted.
+TEST_F(PrefilterExpressionOnMetadataTest, testEvaluateWithColumnStatistics) {
+  using Stats = CompressedBlockMetadata::ColumnStatistics;
+  using StatsPerColumn = CompressedBlockMetadata::ColumnStatisticsPerColumn;
+  auto withStats = [this](CompressedBlockMetadata block,
+                          const std::vector<Id>& col1) {
+    block.columnStatistics_ = StatsPerColumn{
+        Stats::fromColumn(std::vector{VocabId10}), Stats::fromColumn(col1),
+        Stats::fromColumn(std::vector{undef})};
+    return block;
+  };
+  auto s1 = withStats(b6, {IntId(3), IntId(10), IntId(7)});
+  auto s2 = withStats(b7, {IntId(20), IntId(25)});
+  auto s3 = withStats(b8, {IntId(5), DoubleId(100.0), referenceDate1});
+  // This block has no statistics, so it can never be pruned.
+  auto s4 = b9;
+  auto s5 = withStats(b10, {DoubleId(1.5), DoubleId(2.5)});
+
+  const auto& stats1 = s1.columnStatistics_.value().at(1);
+  EXPECT_EQ(stats1.min_, IntId(3));
+  EXPECT_EQ(stats1.max_, IntId(10));
+  EXPECT_TRUE(stats1.containsDatatype(Datatype::Int));
+  EXPECT_FALSE(stats1.containsDatatype(Datatype::Double));
+  const auto& stats3 = s3.columnStatistics_.value().at(1);
+  EXPECT_TRUE(stats3.containsDatatype(Datatype::Double));
+  EXPECT_TRUE(stats3.containsDatatype(Datatype::Date));
+  EXPECT_FALSE(stats3.containsDatatype(Datatype::Bool));
+
+  std::vector<CompressedBlockMetadata> input{s1, s2, s3, s4, s5};
+  auto evaluate = [this, &input](const PrefilterExpression& expr) {
+    return toVec(expr.evaluateWithColumnStatistics(lvc, input, 1));
+  };
+  using Blocks = std::vector<CompressedBlockMetadata>;
+  EXPECT_EQ(evaluate(*gt(IntId(15))), (Blocks{s2, s3, s4}));
+  EXPECT_EQ(evaluate(*lt(IntId(4))), (Blocks{s1, s3, s4, s5}));
+  EXPECT_EQ(evaluate(*eq(referenceDate1)), (Blocks{s3, s4}));
+  EXPECT_EQ(evaluate(*andExpr(ge(IntId(8)), le(IntId(12)))),
+            (Blocks{s1, s3, s4}));
+  EXPECT_EQ(evaluate(*notExpr(lt(IntId(30)))), (Blocks{s3, s4}));
+}
+
+//______________________________________________________________________________
+// Test the `LatitudeRangeExpression` that is used by the `SpatialJoin`.
+TEST_F(PrefilterExpressionOnMetadataTest, testLatitudeRangeExpression) {
+  using Stats = CompressedBlockMetadata::ColumnStatistics;
+  using StatsPerColumn = CompressedBlockMetadata::ColumnStatisticsPerColumn;
+  auto withStats = [this](CompressedBlockMetadata block,
+                          const std::vector<Id>& col1) {
+    block.columnStatistics_ = StatsPerColumn{
+        Stats::fromColumn(std::vector{VocabId10}), Stats::fromColumn(col1),
+        Stats::fromColumn(std::vector{undef})};
+    return block;
+  };
+  auto point = [](double lat, double lng) {
+    return Id::makeFromGeoPoint(GeoPoint{lat, lng});
+  };
+  auto s1 = withStats(b6, {point(10, 170), point(20, -170)});
+  auto s2 = withStats(b7, {point(50, 0), point(60, 5)});
+  // Literals from the vocabulary might be WKT literals of any geometry.
+  auto s3 = withStats(b8, {IntId(3), vocabIdBerlin});
+  auto s4 = withStats(b9, {getVocabId("<x1>"), getVocabId("<x2>")});
+  auto s5 = withStats(b10, {point(-30, 20), point(-20, 20)});
+
+  std::vector<CompressedBlockMetadata> input{s1, s2, s3, s4, s5};
+  auto evaluate = [this, &input](const PrefilterExpression& expr) {
+    return toVec(expr.evaluateWithColumnStatistics(lvc, input, 1));
+  };
+  using Blocks = std::vector<CompressedBlockMetadata>;
+  LatitudeRangeExpression range{15, 55};
+  EXPECT_EQ(evaluate(range), (Blocks{s1, s2, s3}));
+  EXPECT_EQ(evaluate(LatitudeRangeExpression{-25, -21}), (Blocks{s3, s5}));
+  EXPECT_EQ(evaluate(LatitudeRangeExpression{-90, 90}),
+            (Blocks{s1, s2, s3, s5}));
+  EXPECT_EQ(evaluate(*range.logicalComplement()), input);
+
+  EXPECT_EQ(range, *range.clone());
+  EXPECT_FALSE(range == *range.logicalComplement());
+  EXPECT_FALSE(range == LatitudeRangeExpression(15, 50));
+  EXPECT_THAT(range.asString(0), ::testing::HasSubstr("[15, 55]"));
+  EXPECT_ANY_THROW(LatitudeRangeExpression(20, 10));
+  EXPECT_ANY_THROW(LatitudeRangeExpression(-91, 10));
+
+  // One degree of latitude is about 111 kilometers.
+  EXPECT_EQ(LatitudeRangeExpression::maxLatitudeDifference(0), 1e-6);
+  EXPECT_NEAR(LatitudeRangeExpression::maxLatitudeDifference(111'000), 1.0,
+              0.02);
+}
+
+//______________________________________________________________________________
+// Test the `LanguageTagExpression` and the `DatatypeExpression`.
+TEST_F(PrefilterExpressionOnMetadataTest,
+       testLanguageTagAndDatatypeExpression) {
+  using Stats = CompressedBlockMetadata::ColumnStatistics;
+  using StatsPerColumn = CompressedBlockMetadata::ColumnStatisticsPerColumn;
+  auto withStats = [this](CompressedBlockMetadata block,
+                          const std::vector<Id>& col1) {
+    block.columnStatistics_ = StatsPerColumn{
+        Stats::fromColumn(std::vector{VocabId10}), Stats::fromColumn(col1),
+        Stats::fromColumn(std::vector{undef})};
+    return block;
+  };
+  auto s1 = withStats(b6, {IntId(3), IntId(5)});
+  auto s2 = withStats(b7, {referenceDate1, referenceDate2});
+  auto s3 = withStats(b8, {vocabIdBerlin, vocabIdHamburg});
+  auto s4 = withStats(b9, {getVocabId("<x1>"), getVocabId("<x2>")});
+  auto s5 = withStats(b10, {falseId, trueId});
+
+  std::vector<CompressedBlockMetadata> input{s1, s2, s3, s4, s5};
+  auto evaluate = [this, &input](const PrefilterExpression& expr) {
+    return toVec(expr.evaluateWithColumnStatistics(lvc, input, 1));
+  };
+  using Blocks = std::vector<CompressedBlockMetadata>;
+  // Only literals from the vocabulary can have a language tag.
+  EXPECT_EQ(evaluate(*languageTag("en")), (Blocks{s3}));
+  EXPECT_EQ(evaluate(*languageTag("")), (Blocks{s1, s2, s3, s5}));
+  EXPECT_EQ(evaluate(*languageTag("en")->logicalComplement()), input);
+
+  const std::string xsd = "http://www.w3.org/2001/XMLSchema#";
+  EXPECT_EQ(evaluate(*datatypeExpr(absl::StrCat(xsd, "date"))),
+            (Blocks{s2, s3}));
+  EXPECT_EQ(evaluate(*datatypeExpr(absl::StrCat(xsd, "gYear"))),
+            (Blocks{s2, s3}));
+  EXPECT_EQ(evaluate(*datatypeExpr(absl::StrCat(xsd, "int"))),
+            (Blocks{s1, s3}));
+  EXPECT_EQ(evaluate(*datatypeExpr(absl::StrCat(xsd, "boolean"))),
+            (Blocks{s3, s5}));
+  EXPECT_EQ(evaluate(*datatypeExpr(absl::StrCat(xsd, "string"))),
+            (Blocks{s3}));
+  EXPECT_EQ(evaluate(*datatypeExpr(absl::StrCat(xsd, "date"))
+                          ->logicalComplement()),
+            input);
+
+  auto language = languageTag("en");
+  EXPECT_EQ(*language, *language->clone());
+  EXPECT_FALSE(*language == *language->logicalComplement());
+  EXPECT_FALSE(*language == *languageTag("de"));
+  EXPECT_THAT(language->asString(0), ::testing::HasSubstr("\"en\""));
+  auto datatype = datatypeExpr(absl::StrCat(xsd, "date"));
+  EXPECT_EQ(*datatype, *datatype->clone());
+  EXPECT_FALSE(*datatype == *datatype->logicalComplement());
+  EXPECT_FALSE(*datatype == *language);
+  EXPECT_THAT(datatype->asString(0), ::testing::HasSubstr("#date>"));
+}
+
 //______________________________________________________________________________
 // Test method clone. clone() creates a copy of the complete PrefilterExpression
 // tree.
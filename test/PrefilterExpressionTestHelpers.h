@@ -66,6 +66,20 @@ inline auto makePrefixRegexExpression =
       return std::make_unique<PrefixRegexExpression>(prefix, isNegated);
     };
 
+// Make LanguageTagExpression
+inline auto makeLanguageTagExpression = [](std::string language,
+                                           bool isNegated = false) {
+  return std::make_unique<LanguageTagExpression>(std::move(language),
+                                                 isNegated);
+};
+
+// Make DatatypeExpression
+inline auto makeDatatypePrefilterExpression = [](std::string datatypeIri,
+                                                bool isNegated = false) {
+  return std::make_unique<DatatypeExpression>(std::move(datatypeIri),
+                                              isNegated);
+};
+
 // Make PrefilterExpression
 //______________________________________________________________________________
 // instantiation relational
@@ -99,6 +113,10 @@ constexpr inline auto notExpr = notPrefilterExpression;
 constexpr inline auto inExpr = isInExpression;
 // PREFIX REGEX
 constexpr inline auto prefixRegex = makePrefixRegexExpression;
+// LANG(?var) = "language"
+constexpr inline auto languageTag = makeLanguageTagExpression;
+// DATATYPE(?var) = <datatypeIri>
+constexpr inline auto datatypeExpr = makeDatatypePrefilterExpression;
 
 namespace filterHelper {
 //______________________________________________________________________________
@@ -220,6 +238,26 @@ std::unique_ptr<SparqlExpression> makeStrSparqlExpression(
   return makeStrExpression(std::visit(getExpr, std::move(childVal)));
 }
 
+//______________________________________________________________________________
+std::unique_ptr<SparqlExpression> makeLangSparqlExpression(
+    VariantArgs childVal) {
+  return makeLangExpression(std::visit(getExpr, std::move(childVal)));
+}
+
+//______________________________________________________________________________
+std::unique_ptr<SparqlExpression> makeDatatypeSparqlExpression(
+    VariantArgs childVal) {
+  return sparqlExpression::makeDatatypeExpression(
+      std::visit(getExpr, std::move(childVal)));
+}
+
+//______________________________________________________________________________
+std::unique_ptr<SparqlExpression> makeLangMatchesSparqlExpression(
+    VariantArgs child0, VariantArgs child1) {
+  return makeLangMatchesExpression(std::visit(getExpr, std::move(child0)),
+                                   std::visit(getExpr, std::move(child1)));
+}
+
 //______________________________________________________________________________
 template <prefilterExpressions::IsDatatype Datatype>
 std::unique_ptr<SparqlExpression> makeIsDatatypeStartsWithExpression(
@@ -286,6 +324,12 @@ constexpr inline auto strStartsSprql = &makeStringStartsWithSparqlExpression;
 constexpr inline auto regexSparql = &makePrefixRegexExpression;
 // Create SparqlExpression `STR`
 constexpr inline auto strSprql = &makeStrSparqlExpression;
+// Create SparqlExpression `LANG`
+constexpr inline auto langSprql = &makeLangSparqlExpression;
+// Create SparqlExpression `DATATYPE`
+constexpr inline auto datatypeSprql = &makeDatatypeSparqlExpression;
+// Create SparqlExpression `LANGMATCHES`
+constexpr inline auto langMatchesSprql = &makeLangMatchesSparqlExpression;
 
 //______________________________________________________________________________
 // Create SparqlExpression `isIri`
@@ -3603,7 +3603,13 @@ TEST(QueryPlanner, correctFiltersHandling) {
                                                 Variable{"?unrelated"}))),
           h::Bind(h::Filter("?c >= 1",
                             h::Filter("?c < 5", scan("?x", "<b>", "?c"))),
-                  "42", Variable{"?unrelated"})));
+                  "42", Variable{"?unrelated"}),
+          // The `BIND` is evaluated as part of the `FILTER` above it.
+          h::Filter("?c >= 1 with BIND (42 AS ?unrelated)",
+                    h::Filter("?c < 5", scan("?x", "<b>", "?c"))),
+          h::Filter("?c >= 1",
+                    h::Filter("?c < 5 with BIND (42 AS ?unrelated)",
+                              scan("?x", "<b>", "?c")))));
 }
 
 // _____________________________________________________________________________
@@ -3977,3 +3983,67 @@ GROUP BY ?p
 )",
             h::_);
 }
+
+// _____________________________________________________________________________
+TEST(QueryPlanner, randomizedImprovementOfGreedyPlans) {
+  auto qec = ad_utility::testing::getQec(
+      "<a> <p> <b> . <b> <q> <c> . <c> <r> <d> . <d> <s> <e> . <a> <p> <c> . "
+      "<b> <q> <d> . <c> <r> <e> .");
+  std::string query =
+      "SELECT * { ?a <p> ?b . ?b <q> ?c . ?c <r> ?d . ?d <s> ?e . ?a <p> ?c . "
+      "?e <s> ?f }";
+  auto budgetCleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::queryPlanningBudget_>(0);
+  auto plan = [&]() {
+    static EncodedIriManager encodedIriManager;
+    ParsedQuery pq = SparqlParser::parseQuery(&encodedIriManager, query);
+    QueryPlanner qp{qec, std::make_shared<ad_utility::CancellationHandle<>>()};
+    auto qet = qp.createExecutionTree(pq);
+    return std::pair{qet.getCostEstimate(), qp.timeForPlanImprovement()};
+  };
+
+  // Without a time budget, only the deterministic greedy plan is computed.
+  auto [greedyCost, greedyTime] = plan();
+  EXPECT_EQ(greedyTime.count(), 0);
+
+  // The randomized planning uses up the time budget and never yields a plan
+  // that is more expensive than the greedy one.
+  auto timeCleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::queryPlanningImprovementTimeBudget_>(
+      std::chrono::milliseconds(20));
+  auto [improvedCost, improvedTime] = plan();
+  EXPECT_GE(improvedTime.count(), 20);
+  EXPECT_LE(improvedCost, greedyCost);
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanner, reoptimizationWithActualSizesOfChildren) {
+  auto qec = ad_utility::testing::getQec(
+      "<a> <q> 1 . <b> <q> 1 . <c> <q> 1 . <d> <q> 2 . <a> <p> <x> . "
+      "<b> <p> <y> .");
+  std::string query =
+      "SELECT * { ?x <p> ?o . "
+      "{ SELECT ?x { ?x <q> ?z FILTER(?z < 2) } } }";
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::reoptimizationThreshold_>(
+          1.0);
+  qec->clearCacheUnpinnedOnly();
+  auto qet = h::parseAndPlan(query, qec);
+
+  // Find the subtree for the subquery (possibly below a `Sort`).
+  std::optional<size_t> subquerySizeEstimate;
+  for (auto* child : qet.getRootOperation()->getChildren()) {
+    auto* tree = child;
+    if (dynamic_cast<const Sort*>(tree->getRootOperation().get())) {
+      tree = tree->getRootOperation()->getChildren().at(0);
+    }
+    if (!dynamic_cast<const IndexScan*>(tree->getRootOperation().get())) {
+      subquerySizeEstimate = tree->getSizeEstimate();
+    }
+  }
+  // The subquery has been computed during the planning, and its actual size
+  // is used as the size estimate.
+  ASSERT_TRUE(subquerySizeEstimate.has_value());
+  EXPECT_EQ(subquerySizeEstimate.value(), 3);
+  EXPECT_EQ(qet.getResult()->idTable().numRows(), 2);
+}
@@ -0,0 +1,182 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <map>
+#include <optional>
+
+#include "engine/QueryScheduler.h"
+#include "util/GTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
+
+using namespace ad_utility::memory_literals;
+using ad_utility::MemorySize;
+using ad_utility::websocket::QueryId;
+using Priority = QueryScheduler::Priority;
+using ::testing::ElementsAre;
+namespace net = boost::asio;
+
+namespace {
+// Submit queries to a `QueryScheduler` and record the order in which they are
+// admitted. Each query runs on its own strand, like in the `HttpServer`.
+struct SchedulerTester {
+  net::io_context ctx_;
+  MemorySize freeMemory_ = 1_GB;
+  QueryScheduler scheduler_;
+  std::vector<std::string> admitted_;
+  std::map<std::string, std::optional<QueryScheduler::Ticket>> tickets_;
+  std::map<std::string, std::exception_ptr> errors_;
+
+  explicit SchedulerTester(size_t maxNumRunning)
+      : scheduler_{maxNumRunning, [this]() { return freeMemory_; }} {}
+
+  // Submit the query with the given `name` and wait until it has either been
+  // admitted or is waiting.
+  void submit(const std::string& name, Priority priority,
+              MemorySize memory = 0_B,
+              ad_utility::SharedCancellationHandle handle =
+                  std::make_shared<ad_utility::CancellationHandle<>>()) {
+    auto impl = [this, name, priority, memory,
+                 handle]() -> net::awaitable<void> {
+      auto ticket = co_await scheduler_.admit(QueryId::idFromString(name),
+                                              name, priority, memory, handle);
+      admitted_.push_back(name);
+      tickets_.emplace(name, std::move(ticket));
+    };
+    net::co_spawn(net::make_strand(ctx_), impl(),
+                  [this, name](std::exception_ptr error) {
+                    if (error) {
+                      errors_[name] = error;
+                    }
+                  });
+    ctx_.restart();
+    ctx_.poll();
+  }
+
+  // Finish the query with the given `name`.
+  void finish(const std::string& name) {
+    tickets_.at(name).reset();
+    ctx_.restart();
+    ctx_.poll();
+  }
+
+  // The names of the waiting queries.
+  std::vector<std::string> queued() const {
+    std::vector<std::string> result;
+    for (const auto& info : scheduler_.getQueuedQueries()) {
+      result.push_back(info.query_);
+    }
+    return result;
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(QueryScheduler, priorityFromAndToString) {
+  for (auto priority :
+       {Priority::Interactive, Priority::Default, Priority::Background}) {
+    EXPECT_EQ(QueryScheduler::priorityFromString(
+                  QueryScheduler::toString(priority)),
+              priority);
+  }
+  AD_EXPECT_THROW_WITH_MESSAGE(QueryScheduler::priorityFromString("urgent"),
+                               ::testing::HasSubstr("Invalid value"));
+}
+
+// _____________________________________________________________________________
+TEST(QueryScheduler, higherPrioritiesAreAdmittedFirst) {
+  SchedulerTester t{1};
+  t.submit("a", Priority::Default);
+  t.submit("b", Priority::Background);
+  t.submit("c", Priority::Default);
+  t.submit("d", Priority::Interactive);
+  EXPECT_THAT(t.admitted_, ElementsAre("a"));
+  EXPECT_THAT(t.queued(), ElementsAre("b", "c", "d"));
+  EXPECT_EQ(t.scheduler_.numRunning(), 1);
+  EXPECT_EQ(t.scheduler_.numRunningWithoutLock(), 1);
+  EXPECT_EQ(t.scheduler_.numWaitingWithoutLock(), 3);
+
+  auto json = nlohmann::json(t.scheduler_.getQueuedQueries().at(0));
+  EXPECT_EQ(json["status"], "queued");
+  EXPECT_EQ(json["priority"], "background");
+  EXPECT_EQ(json["query"], "b");
+
+  t.finish("a");
+  EXPECT_THAT(t.admitted_, ElementsAre("a", "d"));
+  t.finish("d");
+  t.finish("c");
+  EXPECT_THAT(t.admitted_, ElementsAre("a", "d", "c", "b"));
+  EXPECT_TRUE(t.queued().empty());
+  t.finish("b");
+  EXPECT_EQ(t.scheduler_.numRunning(), 0);
+  EXPECT_EQ(t.scheduler_.numRunningWithoutLock(), 0);
+  EXPECT_EQ(t.scheduler_.numWaitingWithoutLock(), 0);
+}
+
+// _____________________________________________________________________________
+TEST(QueryScheduler, limitPerPriority) {
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::queryMaxRunningBackground_>(1);
+  SchedulerTester t{0};
+  t.submit("a", Priority::Background);
+  t.submit("b", Priority::Background);
+  // The waiting background query doesn't block the other priorities.
+  t.submit("c", Priority::Default);
+  t.submit("d", Priority::Interactive);
+  EXPECT_THAT(t.admitted_, ElementsAre("a", "c", "d"));
+  EXPECT_THAT(t.queued(), ElementsAre("b"));
+  t.finish("c");
+  EXPECT_THAT(t.queued(), ElementsAre("b"));
+  t.finish("a");
+  EXPECT_THAT(t.admitted_, ElementsAre("a", "c", "d", "b"));
+}
+
+// _____________________________________________________________________________
+TEST(QueryScheduler, memoryAwareAdmission) {
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::memoryAwareQueryAdmission_>(true);
+  SchedulerTester t{0};
+  t.freeMemory_ = 10_MB;
+  // A query is always admitted if no other query is running.
+  t.submit("a", Priority::Default, 20_MB);
+  t.submit("b", Priority::Default, 5_MB);
+  // The small query waits behind the large one.
+  t.submit("c", Priority::Background, 1_B);
+  EXPECT_THAT(t.admitted_, ElementsAre("a"));
+  t.finish("a");
+  EXPECT_THAT(t.admitted_, ElementsAre("a", "b", "c"));
+
+  // Without the runtime parameter, the memory is ignored.
+  auto cleanup2 = setRuntimeParameterForTest<
+      &RuntimeParameters::memoryAwareQueryAdmission_>(false);
+  t.submit("d", Priority::Default, 1_GB);
+  EXPECT_THAT(t.admitted_, ElementsAre("a", "b", "c", "d"));
+}
+
+// _____________________________________________________________________________
+TEST(QueryScheduler, cancellationWhileWaiting) {
+  SchedulerTester t{1};
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  t.submit("a", Priority::Default);
+  t.submit("b", Priority::Default, 0_B, handle);
+  t.submit("c", Priority::Default);
+  EXPECT_THAT(t.queued(), ElementsAre("b", "c"));
+  handle->cancel(ad_utility::CancellationState::MANUAL);
+  t.ctx_.restart();
+  while (!t.errors_.contains("b")) {
+    t.ctx_.run_one_for(std::chrono::milliseconds{200});
+  }
+  EXPECT_THROW(std::rethrow_exception(t.errors_.at("b")),
+               ad_utility::CancellationException);
+  EXPECT_THAT(t.queued(), ElementsAre("c"));
+  t.finish("a");
+  EXPECT_THAT(t.admitted_, ElementsAre("a", "c"));
+}
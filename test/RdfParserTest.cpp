@@ -1076,92 +1076,122 @@ TEST(RdfParserTest, exceptionPropagationFileBufferReading) {
     ad_utility::deleteFile(filename);
   };
   // Input, where the first triple fits into a 40_B buffer, but the second
-  // one does not.
+  // one does not. The Turtle parser joins the blocks in this case (see the
+  // `longStatementsInParallelParser` test below), but the N-Quad parser
+  // splits the input at `.` followed by a newline.
   std::string inputWithLongTriple =
       "<subject> <predicate> <object> . \n "
       "<veryLongSubject> <veryLongPredicate> "
       "<veryLongObject> .";
-  forAllParallelParsers(testWithParser, 40_B, inputWithLongTriple);
+  testWithParser(ti<RdfParallelParser<NQuadParser<Tokenizer>>>, true, 40_B,
+                 inputWithLongTriple);
+  testWithParser(ti<RdfParallelParser<NQuadParser<TokenizerCtre>>>, false,
+                 40_B, inputWithLongTriple);
 }
 
-// Test that in parallel parsing scattered prefixes or base declarations lead to
-// an exception
-TEST(RdfParserTest, exceptionOnScatteredPrefixOrBaseInParallelParser) {
-  std::string filename{"exceptionOnScatteredPrefixOrBaseInParallelParser.dat"};
+// Test that the parallel Turtle parser can handle statements that are longer
+// than the blocks of the underlying buffer.
+TEST(RdfParserTest, longStatementsInParallelParser) {
+  std::string filename{"longStatementsInParallelParser.dat"};
+  auto testWithParser = [&](auto t, bool useBatchInterface) {
+    using Parser = typename decltype(t)::type;
+    {
+      auto of = ad_utility::makeOfstream(filename);
+      of << "<subject> <predicate> <object> . \n "
+            "<veryLongSubject> <veryLongPredicate> "
+            "<veryLongObject> .";
+    }
+    EXPECT_THAT(parseFromFile<Parser>(filename, useBatchInterface, 40_B),
+                ::testing::UnorderedElementsAre(
+                    TurtleTriple{iri("<subject>"), iri("<predicate>"),
+                                 iri("<object>")},
+                    TurtleTriple{iri("<veryLongSubject>"),
+                                 iri("<veryLongPredicate>"),
+                                 iri("<veryLongObject>")}));
+    ad_utility::deleteFile(filename);
+  };
+  forAllParallelParsers(testWithParser);
+}
+
+// Test that in parallel parsing, scattered prefix and base declarations (also
+// redefinitions) are correctly applied to the following statements, even if
+// they are in different batches.
+TEST(RdfParserTest, scatteredPrefixOrBaseInParallelParser) {
+  std::string filename{"scatteredPrefixOrBaseInParallelParser.dat"};
   auto testWithParser = [&](auto t, bool useBatchInterface,
                             ad_utility::MemorySize bufferSize,
-                            std::string_view input) {
+                            std::string_view input,
+                            const std::vector<TurtleTriple>& expected) {
     using Parser = typename decltype(t)::type;
     {
       auto of = ad_utility::makeOfstream(filename);
       of << input;
     }
-    AD_EXPECT_THROW_WITH_MESSAGE(
-        (parseFromFile<Parser>(filename, useBatchInterface, bufferSize)),
-        ::testing::HasSubstr("'--parallel-parsing false'"));
+    EXPECT_THAT(parseFromFile<Parser>(filename, useBatchInterface, bufferSize),
+                ::testing::UnorderedElementsAreArray(expected));
     ad_utility::deleteFile(filename);
   };
-  // Redefinition
-  {
-    std::string_view inputWithScatteredPrefix =
-        "@prefix ex: <http://example.org/> . \n"
-        "<subject> <predicate> <object> . \n "
-        "@prefix ex: <http://other.example.org/> . \n";
-    forAllParallelParsers(testWithParser, 70_B, inputWithScatteredPrefix);
-    std::string_view inputWithScatteredSparqlPrefix =
-        "PREFIX ex: <http://example.org/> \n"
-        "<subject> <predicate> <object> . \n "
-        "PREFIX ex: <http://other.example.org/> \n";
-    forAllParallelParsers(testWithParser, 70_B, inputWithScatteredSparqlPrefix);
-    std::string_view inputWithScatteredBase =
-        "@base <http://example.org/> . \n"
-        "<subject> <predicate> <object> . \n "
-        "@base <http://other.example.org/> . \n";
-    forAllParallelParsers(testWithParser, 70_B, inputWithScatteredBase);
-    std::string_view inputWithScatteredSparqlBase =
-        "BASE <http://example.org/> \n"
-        "<subject> <predicate> <object> . \n "
-        "BASE <http://other.example.org/> \n";
-    forAllParallelParsers(testWithParser, 70_B, inputWithScatteredSparqlBase);
-  }
-  // New definition
-  {
-    std::string_view inputWithScatteredPrefix =
-        "@prefix ex: <http://example.org/> . \n"
-        "<subject> <predicate> <object> . \n "
-        "@prefix ex1: <http://example.org/> . \n";
-    forAllParallelParsers(testWithParser, 70_B, inputWithScatteredPrefix);
-    std::string_view inputWithScatteredSparqlPrefix =
-        "PREFIX ex: <http://example.org/> \n"
-        "<subject> <predicate> <object> . \n "
-        "PREFIX ex1: <http://example.org/> \n";
-    forAllParallelParsers(testWithParser, 70_B, inputWithScatteredSparqlPrefix);
-    std::string_view inputWithFirstBase =
-        "<subject> <predicate> <object> . \n "
-        "@base <http://example.org/> . \n";
-    forAllParallelParsers(testWithParser, 70_B, inputWithFirstBase);
-    std::string_view inputWithFirstSparqlBase =
-        "<subject> <predicate> <object> . \n "
-        "BASE <http://example.org/> \n";
-    forAllParallelParsers(testWithParser, 70_B, inputWithFirstSparqlBase);
-  }
-  // Same root, different relative base
-  {
-    std::string_view inputWithScatteredBase =
-        "@base <http://example.org/abc> . \n"
-        "<subject> <predicate> <object> . \n "
-        "@base <http://example.org/def> . \n";
-    forAllParallelParsers(testWithParser, 70_B, inputWithScatteredBase);
-    std::string_view inputWithScatteredSparqlBase =
-        "BASE <http://example.org/abc> \n"
-        "<subject> <predicate> <object> . \n "
-        "BASE <http://example.org/def> \n";
-    forAllParallelParsers(testWithParser, 70_B, inputWithScatteredSparqlBase);
+  auto triple = [](std::string_view s) {
+    return TurtleTriple{iri(s), iri("<http://x.org/p>"),
+                        iri("<http://x.org/o>")};
+  };
+  auto statement = [](std::string_view subject) {
+    return absl::StrCat(subject, " <http://x.org/p> <http://x.org/o> .\n");
+  };
+  // Enough statements to fill several batches (the IRIs are absolute, so
+  // they are not affected by the base IRI).
+  std::string filler;
+  std::vector<TurtleTriple> expectedForFiller;
+  for (size_t i = 0; i < 5; ++i) {
+    auto subject = absl::StrCat("<http://x.org/filler", i, ">");
+    filler += statement(subject);
+    expectedForFiller.push_back(triple(subject));
   }
+  auto expected = [&](std::string_view first, std::string_view second) {
+    std::vector<TurtleTriple> result = expectedForFiller;
+    result.push_back(triple(first));
+    result.push_back(triple(second));
+    return result;
+  };
+
+  // Redefinition of a prefix, in Turtle and SPARQL syntax.
+  forAllParallelParsers(
+      testWithParser, 70_B,
+      absl::StrCat("@prefix ex: <http://example.org/> .\n", statement("ex:a"),
+                   filler, "@prefix ex: <http://other.example.org/> .\n",
+                   statement("ex:a")),
+      expected("<http://example.org/a>", "<http://other.example.org/a>"));
+  forAllParallelParsers(
+      testWithParser, 70_B,
+      absl::StrCat("PREFIX ex: <http://example.org/>\n", statement("ex:a"),
+                   filler, "prefix ex: <http://other.example.org/>\n",
+                   statement("ex:a")),
+      expected("<http://example.org/a>", "<http://other.example.org/a>"));
+  // A new prefix in the middle of the input, also in the middle of a line.
+  forAllParallelParsers(
+      testWithParser, 70_B,
+      absl::StrCat(filler,
+                   "<http://x.org/a> <http://x.org/p> <http://x.org/o>. "
+                   "@prefix ex: <http://example.org/> . ",
+                   statement("ex:b")),
+      expected("<http://x.org/a>", "<http://example.org/b>"));
+  // Redefinition of the base IRI, in Turtle and SPARQL syntax.
+  forAllParallelParsers(
+      testWithParser, 70_B,
+      absl::StrCat("@base <http://example.org/abc/> .\n", statement("<a>"),
+                   filler, "@base <http://example.org/def/> .\n",
+                   statement("<b>")),
+      expected("<http://example.org/abc/a>", "<http://example.org/def/b>"));
+  forAllParallelParsers(
+      testWithParser, 70_B,
+      absl::StrCat("BASE <http://example.org/abc/>\n", statement("<a>"),
+                   filler, "BASE <http://example.org/def/>\n",
+                   statement("<b>")),
+      expected("<http://example.org/abc/a>", "<http://example.org/def/b>"));
 }
 
-// Test that in parallel parsing scattered prefixes or base declarations lead to
-// an exception
+// Test that in parallel parsing scattered redeclarations of the same prefixes
+// or base IRIs do not lead to an exception.
 TEST(RdfParserTest,
      noExceptionOnScatteredPrefixOrBaseRedeclarationInParallelParser) {
   std::string filename{
@@ -1200,30 +1230,43 @@ TEST(RdfParserTest,
   forAllParallelParsers(testWithParser, 70_B, inputWithScatteredSparqlBase);
 }
 
-// Test for better error message in parallel parser when encountering a string
-// literal parsing error.
-TEST(RdfParserTest, betterErrorMessageOnMultilineLiteralError) {
-  std::string filename{"betterErrorMessageOnMultilineLiteralError.dat"};
+// Test that the parallel parser correctly handles multiline string literals,
+// string literals and comments that contain a `.` (which might be mistaken
+// for the end of a statement), also across the boundaries of the blocks of
+// the underlying buffer.
+TEST(RdfParserTest, multilineLiteralsInParallelParser) {
+  std::string filename{"multilineLiteralsInParallelParser.dat"};
   auto testWithParser = [&filename](auto t, bool useBatchInterface,
                                     ad_utility::MemorySize bufferSize,
-                                    std::string_view input) {
+                                    std::string_view input,
+                                    const std::vector<TurtleTriple>& expected) {
     using Parser = typename decltype(t)::type;
     {
       auto of = ad_utility::makeOfstream(filename);
       of << input;
     }
-    AD_EXPECT_THROW_WITH_MESSAGE(
-        (parseFromFile<Parser>(filename, useBatchInterface, bufferSize)),
-        ::testing::AllOf(::testing::HasSubstr("`--parallel-parsing false`"),
-                         ::testing::HasSubstr("multiline string literal")));
+    EXPECT_THAT(parseFromFile<Parser>(filename, useBatchInterface, bufferSize),
+                ::testing::UnorderedElementsAreArray(expected));
     ad_utility::deleteFile(filename);
   };
-  // Redefinition
-  std::string_view inputWithMultilineString =
+  std::string_view input =
       "<subject1> <predicate1> <object1> . \n"
       "<subject2> <predicate2> \"\"\".\n\"\"\" . \n"
-      "<subject3> <predicate3> <object3> . \n";
-  forAllParallelParsers(testWithParser, 40_B, inputWithMultilineString);
+      "<subject3> <predicate3> '''a long literal with a # and a\n"
+      "<subject4> <predicate4> <object4> .\n''' . # a comment \" . \n"
+      "<subject5> <predicate5> \"a literal with a . and a ' \" . \n"
+      "<subject6> <predicate6> <object6> . \n";
+  std::vector<TurtleTriple> expected{
+      {iri("<subject1>"), iri("<predicate1>"), iri("<object1>")},
+      {iri("<subject2>"), iri("<predicate2>"), lit("\".\n\"")},
+      {iri("<subject3>"), iri("<predicate3>"),
+       lit("\"a long literal with a # and a\n"
+           "<subject4> <predicate4> <object4> .\n\"")},
+      {iri("<subject5>"), iri("<predicate5>"),
+       lit("\"a literal with a . and a ' \"")},
+      {iri("<subject6>"), iri("<predicate6>"), iri("<object6>")}};
+  forAllParallelParsers(testWithParser, 40_B, input, expected);
+  forAllParallelParsers(testWithParser, 1_kB, input, expected);
 }
 
 // Test that the parallel parser's destructor can be run quickly and without
@@ -0,0 +1,74 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Christoph Ullinger <ullingec@informatik.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "util/File.h"
+#include "util/GTestHelpers.h"
+#include "util/ReadOnlyMappedFile.h"
+
+using ad_utility::ReadOnlyMappedFile;
+
+namespace {
+// Write the `contents` to the file with the given `filename`.
+void writeFile(const std::string& filename, std::string_view contents) {
+  ad_utility::File file{filename, "w"};
+  file.write(contents.data(), contents.size());
+  file.close();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ReadOnlyMappedFile, mapAndUnmap) {
+  const std::string filename = "ReadOnlyMappedFileTest.mapAndUnmap.dat";
+  writeFile(filename, "hello world");
+
+  ReadOnlyMappedFile file{filename};
+  EXPECT_EQ(file.size(), 11);
+  EXPECT_EQ(file.view(), "hello world");
+
+  // A moved-from file is empty.
+  ReadOnlyMappedFile other{std::move(file)};
+  EXPECT_EQ(other.view(), "hello world");
+  EXPECT_EQ(file.data(), nullptr);
+  EXPECT_EQ(file.size(), 0);
+
+  // Move assignment removes the previous mapping.
+  writeFile(filename + ".2", "abc");
+  ReadOnlyMappedFile third{filename + ".2"};
+  third = std::move(other);
+  EXPECT_EQ(third.view(), "hello world");
+
+  third.unmap();
+  EXPECT_EQ(third.data(), nullptr);
+  EXPECT_TRUE(third.view().empty());
+  // Unmapping twice is allowed.
+  third.unmap();
+
+  // Remapping an object.
+  third.map(filename + ".2");
+  EXPECT_EQ(third.view(), "abc");
+  ad_utility::deleteFile(filename);
+  ad_utility::deleteFile(filename + ".2");
+}
+
+// _____________________________________________________________________________
+TEST(ReadOnlyMappedFile, emptyAndMissingFiles) {
+  const std::string filename = "ReadOnlyMappedFileTest.empty.dat";
+  writeFile(filename, "");
+  ReadOnlyMappedFile file{filename};
+  EXPECT_EQ(file.data(), nullptr);
+  EXPECT_EQ(file.size(), 0);
+  ad_utility::deleteFile(filename);
+
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      ReadOnlyMappedFile{"ReadOnlyMappedFileTest.doesNotExist.dat"},
+      ::testing::HasSubstr("Could not open the file "
+                           "\"ReadOnlyMappedFileTest.doesNotExist.dat\""));
+}
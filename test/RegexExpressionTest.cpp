@@ -9,6 +9,7 @@
 
 #include "./SparqlExpressionTestHelpers.h"
 #include "./util/GTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
 #include "./util/TripleComponentTestHelpers.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
@@ -309,6 +310,72 @@ TEST(RegexExpression, nonPrefixRegexWithFlags) {
                         {T, F, T, T, T, U, U}, true);
 }
 
+// _____________________________________________________________________________
+TEST(RegexExpression, getRequiredLiteral) {
+  using sparqlExpression::detail::getRequiredLiteral;
+  EXPECT_EQ(getRequiredLiteral("alpha"), "alpha");
+  EXPECT_EQ(getRequiredLiteral("^al.pha$"), "pha");
+  EXPECT_EQ(getRequiredLiteral("[abc]+xyz[^]]*uv"), "xyz");
+  EXPECT_EQ(getRequiredLiteral("[[:alpha:]]ab"), "ab");
+  EXPECT_EQ(getRequiredLiteral("(foo|bar)baz"), "baz");
+  EXPECT_EQ(getRequiredLiteral(R"(a\.b\d+cd)"), "a.b");
+  // Quantifiers make the last character optional, a `+` ends the literal.
+  EXPECT_EQ(getRequiredLiteral("abcd?"), "abc");
+  EXPECT_EQ(getRequiredLiteral("ab*c"), "a");
+  EXPECT_EQ(getRequiredLiteral("xabbbb+?c"), "xabbbb");
+  EXPECT_EQ(getRequiredLiteral("abc{2,3}d"), "ab");
+  EXPECT_EQ(getRequiredLiteral("äöü?x"), "äö");
+  // The flags of `REGEX` are only removed if they are case-sensitive.
+  EXPECT_EQ(getRequiredLiteral("(?s:al.pha)"), "pha");
+  EXPECT_EQ(getRequiredLiteral("(?i:alpha)"), std::nullopt);
+  EXPECT_EQ(getRequiredLiteral("(?i)alpha"), std::nullopt);
+  EXPECT_EQ(getRequiredLiteral("(?s:a)(b)"), std::nullopt);
+
+  EXPECT_EQ(getRequiredLiteral("a|b"), std::nullopt);
+  EXPECT_EQ(getRequiredLiteral("[a-z]*"), std::nullopt);
+  EXPECT_EQ(getRequiredLiteral(R"(\x41bc)"), std::nullopt);
+  EXPECT_EQ(getRequiredLiteral(R"(\pLx)"), std::nullopt);
+  EXPECT_EQ(getRequiredLiteral("ab\\"), std::nullopt);
+  EXPECT_EQ(getRequiredLiteral(""), std::nullopt);
+}
+
+// Test the evaluation of a constant regex on a variable with many distinct
+// values, which are matched by several threads.
+TEST(RegexExpression, manyDistinctValues) {
+  TestContext ctx;
+  ctx.varToColMap.clear();
+  ctx.varToColMap[Variable{"?string"}] = makeAlwaysDefinedColumn(0);
+  ctx.table.clear();
+  ctx.table.setNumColumns(1);
+  std::vector<Id> expected;
+  for (size_t i = 0; i < 50'000; ++i) {
+    auto id = Id::makeFromLocalVocabIndex(
+        ctx.localVocab.getIndexAndAddIfNotContained(
+            LocalVocabEntry::literalWithoutQuotes(
+                absl::StrCat("a", i, "b"), ctx.qec->getLocalVocabContext())));
+    // Each value occurs twice, and the values are not sorted.
+    for (size_t j = 0; j < 2; ++j) {
+      ctx.table.push_back({id});
+      expected.push_back(Id::makeFromBool(i % 10 == 7));
+    }
+    ctx.table.push_back({Id::makeFromInt(static_cast<int64_t>(i))});
+    expected.push_back(U);
+  }
+  ctx.context._inputTable = ctx.table.asStaticView<0>();
+  ctx.context._endIndex = ctx.table.numRows();
+  // The numbers with the last digit `7`, the required literal is `7b`.
+  auto regex = makeRegexExpression("?string", "^a[0-9]*7b$");
+  for (size_t numThreads : {1, 4}) {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::regexNumThreads_>(
+            numThreads);
+    auto result = regex->evaluate(&ctx.context);
+    ASSERT_TRUE(std::holds_alternative<VectorWithMemoryLimit<Id>>(result));
+    EXPECT_THAT(std::get<VectorWithMemoryLimit<Id>>(result),
+                ::testing::ElementsAreArray(expected));
+  }
+}
+
 namespace sparqlExpression {
 // Test the `getPrefixRegex` function (which returns `std::nullopt` if the regex
 // is not a simple prefix regex).
@@ -148,6 +148,9 @@ TEST(RuntimeInformation, toStringAndJson) {
   child.columnNames_.emplace_back("?x");
   child.columnNames_.emplace_back("?y");
   child.totalTime_ = 3ms;
+  child.cpuTime_ = 2ms;
+  child.numBytesRead_ = 100;
+  child.numBytesDecompressed_ = 400;
   child.cacheStatus_ = ad_utility::CacheStatus::cachedPinned;
   child.status_ = RuntimeInformation::Status::optimizedOut;
   child.addDetail("minor detail", 42);
@@ -158,6 +161,8 @@ TEST(RuntimeInformation, toStringAndJson) {
   parent.numRows_ = 4;
   parent.columnNames_.push_back("?alpha");
   parent.totalTime_ = 6ms;
+  parent.cpuTime_ = 5ms;
+  parent.peakMemoryUsage_ = ad_utility::MemorySize::bytes(2000);
   parent.cacheStatus_ = ad_utility::CacheStatus::computed;
   parent.status_ = RuntimeInformation::Status::fullyMaterializedCompleted;
 
@@ -171,6 +176,8 @@ TEST(RuntimeInformation, toStringAndJson) {
 │  columns: ?alpha
 │  total_time: 6 ms
 │  operation_time: 3 ms
+│  cpu_time: 5 ms
+│  peak_memory_usage: 2000 B
 │  status: fully materialized completed
 │  cache_status: computed
 │  ┬
@@ -180,6 +187,8 @@ TEST(RuntimeInformation, toStringAndJson) {
 │  │  columns: ?x, ?y
 │  │  total_time: 3 ms
 │  │  operation_time: 3 ms
+│  │  cpu_time: 2 ms
+│  │  bytes_read: 100, bytes_decompressed: 400
 │  │  status: optimized out
 │  │  cache_status: cached_pinned
 │  │  original_total_time: 0 ms
@@ -199,6 +208,15 @@ TEST(RuntimeInformation, toStringAndJson) {
 "operation_time": 3,
 "original_total_time": 0,
 "original_operation_time": 0,
+"cpu_time": 5,
+"operation_cpu_time": 3,
+"peak_memory_usage": 2000,
+"bytes_read": 0,
+"bytes_decompressed": 0,
+"subtree_bytes_read": 100,
+"subtree_bytes_decompressed": 400,
+"subtree_cache_hits": 1,
+"subtree_cache_misses": 1,
 "cache_status": "computed",
 "details": null,
 "estimated_total_cost": 0,
@@ -219,6 +237,15 @@ TEST(RuntimeInformation, toStringAndJson) {
         "operation_time": 3,
         "original_total_time": 0,
         "original_operation_time": 0,
+        "cpu_time": 2,
+        "operation_cpu_time": 2,
+        "peak_memory_usage": 0,
+        "bytes_read": 100,
+        "bytes_decompressed": 400,
+        "subtree_bytes_read": 100,
+        "subtree_bytes_decompressed": 400,
+        "subtree_cache_hits": 1,
+        "subtree_cache_misses": 0,
         "cache_status": "cached_pinned",
         "details": {
             "minor detail": 42
@@ -270,6 +270,8 @@ TEST(Serializer, ReadAndWriteDiffers) {
 TEST(Serializer, Concepts) {
   static_assert(ReadSerializer<ByteBufferReadSerializer>);
   static_assert(!WriteSerializer<ByteBufferReadSerializer>);
+  static_assert(
+      ReadSerializer<ad_utility::serialization::ByteBufferViewReadSerializer>);
   static_assert(WriteSerializer<ByteBufferWriteSerializer>);
   static_assert(!ReadSerializer<ByteBufferWriteSerializer>);
   static_assert(ReadSerializer<FileReadSerializer>);
@@ -311,6 +313,18 @@ auto testWithByteBuffer = [](auto testFunction) {
   testFunction(writer, makeReaderFromWriter);
 };
 
+auto testWithByteBufferView = [](auto testFunction) {
+  ByteBufferWriteSerializer writer;
+  // The reader doesn't own the buffer, so the buffer has to be stored here.
+  std::vector<char> buffer;
+  auto makeReaderFromWriter = [&writer, &buffer]() {
+    buffer = std::move(writer).data();
+    return ad_utility::serialization::ByteBufferViewReadSerializer{
+        std::string_view{buffer.data(), buffer.size()}};
+  };
+  testFunction(writer, makeReaderFromWriter);
+};
+
 auto testWithCallableSerializer = [](auto testFunction) {
   std::vector<char> buffer;
   auto write = [&buffer](const char* source, size_t numBytes) {
@@ -342,6 +356,7 @@ auto testWithFileSerialization = [](auto testFunction) {
 
 auto testWithAllSerializers = [](auto testFunction) {
   testWithByteBuffer(testFunction);
+  testWithByteBufferView(testFunction);
   testWithFileSerialization(testFunction);
   testWithCallableSerializer(testFunction);
   // TODO<joka921> Register new serializers here to apply all existing tests
@@ -52,6 +52,24 @@ TEST(ServerTest, determineResultPinning) {
       testing::Pair(false, false));
 }
 
+// _____________________________________________________________________________
+TEST(ServerTest, determineQueryPriority) {
+  using enum QueryScheduler::Priority;
+  EXPECT_EQ(Server::determineQueryPriority({}, false), Default);
+  EXPECT_EQ(Server::determineQueryPriority({{"priority", {"background"}}},
+                                           false),
+            Background);
+  EXPECT_EQ(Server::determineQueryPriority({{"priority", {"interactive"}}},
+                                           true),
+            Interactive);
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      Server::determineQueryPriority({{"priority", {"interactive"}}}, false),
+      testing::HasSubstr("requires a valid access token"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      Server::determineQueryPriority({{"priority", {"urgent"}}}, true),
+      testing::HasSubstr("Invalid value"));
+}
+
 // _____________________________________________________________________________
 TEST(ServerTest, determineMediaType) {
   auto MakeRequest = [](const std::optional<std::string>& accept,
@@ -748,3 +766,40 @@ TEST(ServerTest, queryEventLogRecordsFailedStatus) {
   EXPECT_EQ(end.at("qid").get<std::string>(),
             start.at("qid").get<std::string>());
 }
+
+// _____________________________________________________________________________
+TEST(ServerTest, queryWithCursor) {
+  auto qec = getQec(TestIndexConfig{"<a> <b> <c> . <a> <b> <d> ."});
+  SimulateHttpRequest simulateHttpRequest{qec->getIndex().getOnDiskBase()};
+  // `SELECT ?c { <a> <b> ?c } ORDER BY ?c`, URL-encoded.
+  std::string query =
+      "SELECT%20%3Fc%20%7B%20%3Ca%3E%20%3Cb%3E%20%3Fc%20%7D"
+      "%20ORDER%20BY%20%3Fc";
+  auto request = [](const std::string& target) {
+    auto get = makeGetRequest(target);
+    get.set(http::field::accept, "text/tab-separated-values");
+    return get;
+  };
+
+  // Only the first page is sent, together with the ID of the cursor.
+  auto response = simulateHttpRequest.processRaw(
+      request(absl::StrCat("/?query=", query, "&cursor-page-size=1")));
+  EXPECT_THAT(response, StatusIs(http::status::ok));
+  EXPECT_FALSE(response["QLever-Cursor"].empty());
+  EXPECT_EQ(SimulateHttpRequest::bodyToString(std::move(response.body())),
+            "?c\n<c>\n");
+
+  // The `OFFSET` of the query is respected, and there is no cursor if the
+  // first page is also the last one.
+  response = simulateHttpRequest.processRaw(request(
+      absl::StrCat("/?query=", query, "%20OFFSET%201&cursor-page-size=5")));
+  EXPECT_TRUE(response["QLever-Cursor"].empty());
+  EXPECT_EQ(SimulateHttpRequest::bodyToString(std::move(response.body())),
+            "?c\n<d>\n");
+
+  // Fetching from an unknown cursor fails.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      simulateHttpRequest.processRaw(
+          request("/?cmd=fetch-cursor&cursor=unknown&cursor-page-size=1")),
+      ::testing::HasSubstr("There is no cursor with ID \"unknown\""));
+}
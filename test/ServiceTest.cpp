@@ -25,6 +25,7 @@
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
 #include "util/RuntimeParametersTestHelpers.h"
+#include "util/Synchronized.h"
 #include "util/TripleComponentTestHelpers.h"
 #include "util/http/HttpUtils.h"
 
@@ -529,6 +530,251 @@ TEST_F(ServiceTest, computeResultNoVariables) {
   EXPECT_NO_THROW(serviceOperation.computeResultOnlyForTesting());
 }
 
+// Test the import of results in the binary format of QLever.
+TEST_F(ServiceTest, computeResultFromBinaryExport) {
+  namespace binary = qlever::binary_export;
+  using ad_utility::testing::IntId;
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::serviceBinaryResults_>(
+          true);
+  parsedQuery::Service parsedServiceClause{
+      {Variable{"?x"}, Variable{"?y"}},
+      TripleComponent::Iri::fromIriref("<http://localhorst/api>"),
+      "",
+      "{ }",
+      false};
+
+  // The remote result has the columns in a different order and an additional
+  // column. The blank node occurs in both batches.
+  const auto& index = testQec->getIndex();
+  LocalVocabEntry word =
+      LocalVocabEntry::fromStringRepresentation("<http://a>", index);
+  Id iri = Id::makeFromLocalVocabIndex(&word);
+  Id blankNode = Id::makeFromBlankNodeIndex(BlankNodeIndex::make(17));
+  auto remote =
+      makeIdTableFromVector({{iri, IntId(42), IntId(7)},
+                             {blankNode, blankNode, Id::makeUndefined()}});
+  std::string header = binary::makeHeader({"y", "x", "z"});
+  binary::IncrementalStringMapping dictionary;
+  std::string batches = absl::StrCat(
+      binary::makeBatch(dictionary, index, remote, {0, 1, 2}, 0, 1),
+      binary::makeBatch(dictionary, index, remote, {0, 1, 2}, 1, 2));
+
+  auto makeService = [&](std::string result) {
+    httpClientTestHelpers::RequestMatchers matchers{
+        .accept_ = testing::StartsWith(
+            "application/qlever-export+octet-stream, "
+            "application/sparql-results+json;q=")};
+    return Service{testQec, parsedServiceClause,
+                   httpClientTestHelpers::getResultFunctionFactory(
+                       std::move(result),
+                       "application/qlever-export+octet-stream",
+                       boost::beast::http::status::ok, matchers)};
+  };
+
+  auto checkResult = [&](const IdTable& idTable,
+                         const LocalVocab& localVocab) {
+    ASSERT_EQ(idTable.numRows(), 2);
+    EXPECT_EQ(idTable(0, 0), IntId(42));
+    ASSERT_EQ(idTable(0, 1).getDatatype(), Datatype::LocalVocabIndex);
+    EXPECT_EQ(idTable(0, 1).getLocalVocabIndex()->toStringRepresentation(),
+              "<http://a>");
+    // The blank node is mapped to the same new local blank node in all rows.
+    Id localBlankNode = idTable(1, 0);
+    ASSERT_EQ(localBlankNode.getDatatype(), Datatype::BlankNodeIndex);
+    EXPECT_EQ(idTable(1, 1), localBlankNode);
+    EXPECT_TRUE(localVocab.isBlankNodeIndexContained(
+        localBlankNode.getBlankNodeIndex()));
+  };
+
+  std::string complete =
+      absl::StrCat(header, batches, binary::makeEndMarker());
+  {
+    auto service = makeService(complete);
+    auto result = service.computeResultOnlyForTesting();
+    checkResult(result.idTable(), result.localVocab());
+  }
+  {
+    // The lazy result has one chunk per batch.
+    auto service = makeService(complete);
+    auto result = service.computeResultOnlyForTesting(true);
+    IdTable idTable{2, ad_utility::testing::makeAllocator()};
+    LocalVocab localVocab;
+    size_t numChunks = 0;
+    for (auto& pair : result.idTables()) {
+      idTable.insertAtEnd(pair.idTable_);
+      localVocab.mergeWith(pair.localVocab_);
+      ++numChunks;
+    }
+    EXPECT_EQ(numChunks, 2);
+    checkResult(idTable, localVocab);
+  }
+
+  // A stream without the end marker or with missing variables is an error.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      makeService(header + batches).computeResultOnlyForTesting(),
+      testing::HasSubstr("Binary result is incomplete"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      makeService(binary::makeHeader({"y"}) + binary::makeEndMarker())
+          .computeResultOnlyForTesting(),
+      testing::HasSubstr("does not contain the expected variable ?x"));
+}
+
+// Test the transfer of the IDs of the vocabulary as is between QLevers with the
+// same index.
+TEST_F(ServiceTest, binaryExportWithVocabIds) {
+  namespace binary = qlever::binary_export;
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::serviceBinaryResults_>(
+          true);
+  parsedQuery::Service parsedServiceClause{
+      {Variable{"?x"}},
+      TripleComponent::Iri::fromIriref("<http://localhorst/api>"),
+      "",
+      "{ }",
+      false};
+  const auto& index = testQec->getIndex();
+  Id vocabId = Id::makeFromVocabIndex(VocabIndex::make(0));
+  auto remote = makeIdTableFromVector({{vocabId}});
+  binary::IncrementalStringMapping dictionary;
+  std::string result = absl::StrCat(
+      binary::makeHeader({"x"}, true),
+      binary::makeBatch(dictionary, index, remote, {0}, 0, 1, true),
+      binary::makeEndMarker());
+
+  auto makeService = [&](testing::Matcher<std::string> url) {
+    httpClientTestHelpers::RequestMatchers matchers{.url_ = std::move(url)};
+    return Service{testQec, parsedServiceClause,
+                   httpClientTestHelpers::getResultFunctionFactory(
+                       result, "application/qlever-export+octet-stream",
+                       boost::beast::http::status::ok, matchers)};
+  };
+
+  // Without the runtime parameter, the index ID is not sent and the IDs of
+  // the vocabulary are not accepted.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      makeService(testing::Not(testing::HasSubstr("qlever-index-id")))
+          .computeResultOnlyForTesting(),
+      testing::HasSubstr("which were not requested"));
+
+  auto cleanup2 =
+      setRuntimeParameterForTest<&RuntimeParameters::serviceVocabularyIds_>(
+          true);
+  auto service = makeService(testing::HasSubstr("?qlever-index-id="));
+  auto idTable = service.computeResultOnlyForTesting().idTable().clone();
+  ASSERT_EQ(idTable.numRows(), 1);
+  EXPECT_EQ(idTable(0, 0), vocabId);
+
+  // An ID that is not part of the local vocabulary is an error.
+  auto invalid = makeIdTableFromVector({{Id::makeFromVocabIndex(
+      VocabIndex::make(index.getVocab().size()))}});
+  binary::IncrementalStringMapping otherDictionary;
+  result = absl::StrCat(
+      binary::makeHeader({"x"}, true),
+      binary::makeBatch(otherDictionary, index, invalid, {0}, 0, 1, true),
+      binary::makeEndMarker());
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      makeService(testing::_).computeResultOnlyForTesting(),
+      testing::HasSubstr("not part of the vocabulary"));
+}
+
+// Test that large sibling results are sent in batches (bind join).
+TEST_F(ServiceTest, bindJoin) {
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::serviceMaxValueRows_>(2);
+  auto iri = ad_utility::testing::iri;
+  using TC = TripleComponent;
+  std::vector<std::vector<TC>> rows;
+  for (size_t i = 0; i < 5; ++i) {
+    rows.push_back({TC(iri(absl::StrCat("<a", i, ">")))});
+  }
+  // A duplicate row, which is only sent once.
+  rows.push_back(rows.front());
+  auto sibling = std::make_shared<Values>(
+      testQec, parsedQuery::SparqlValues{{Variable{"?x"}}, std::move(rows)});
+
+  // The mock endpoint returns one row for each of the values of `?x` in the
+  // query, and records the queries that it has received.
+  auto queries =
+      std::make_shared<ad_utility::Synchronized<std::vector<std::string>>>();
+  SendRequestType mock = [queries](const ad_utility::httpUtils::Url&,
+                                   ad_utility::SharedCancellationHandle,
+                                   const boost::beast::http::verb&,
+                                   std::string_view postData, std::string_view,
+                                   std::string_view, size_t) {
+    queries->wlock()->emplace_back(postData);
+    std::vector<std::vector<std::string_view>> resultRows;
+    std::vector<std::string> values;
+    static const std::regex valueRegex{"<(a[0-9])>"};
+    std::string query{postData};
+    for (auto it = std::sregex_iterator(query.begin(), query.end(), valueRegex);
+         it != std::sregex_iterator(); ++it) {
+      values.push_back((*it)[1].str());
+    }
+    for (const auto& value : values) {
+      resultRows.push_back({value, "b"});
+    }
+    auto body =
+        [](std::string result) -> cppcoro::generator<ql::span<std::byte>> {
+      co_yield ql::as_writable_bytes(ql::span{result});
+    };
+    return HttpOrHttpsResponse{
+        .status_ = boost::beast::http::status::ok,
+        .contentType_ = "application/sparql-results+json",
+        .body_ = body(genJsonResult({"x", "y"}, resultRows))};
+  };
+
+  parsedQuery::Service parsedServiceClause{
+      {Variable{"?x"}, Variable{"?y"}},
+      TripleComponent::Iri::fromIriref("<http://localhorst/api>"),
+      "",
+      "{ ?x <p> ?y }",
+      false};
+  for (bool lazy : {false, true}) {
+    queries->wlock()->clear();
+    Service service{testQec, parsedServiceClause, mock};
+    service.siblingInfo_.emplace(siblingInfoFromOp(sibling));
+    auto result = service.computeResultOnlyForTesting(lazy);
+    std::vector<std::string> xValues;
+    auto addRows = [&](const IdTable& idTable) {
+      for (size_t i = 0; i < idTable.numRows(); ++i) {
+        Id x = idTable(i, 0);
+        ASSERT_EQ(x.getDatatype(), Datatype::LocalVocabIndex);
+        xValues.push_back(x.getLocalVocabIndex()->toStringRepresentation());
+      }
+    };
+    if (lazy) {
+      for (auto& pair : result.idTables()) {
+        addRows(pair.idTable_);
+      }
+    } else {
+      addRows(result.idTable());
+    }
+    // The requests may arrive in any order.
+    EXPECT_THAT(xValues, ::testing::UnorderedElementsAre(
+                             "<a0>", "<a1>", "<a2>", "<a3>", "<a4>"));
+    auto sentQueries = *queries->rlock();
+    ASSERT_EQ(sentQueries.size(), 3);
+    for (const auto& query : sentQueries) {
+      EXPECT_THAT(query, ::testing::HasSubstr("VALUES (?x)"));
+      EXPECT_THAT(query, ::testing::HasSubstr("?x <p> ?y"));
+    }
+  }
+
+  // A sibling result with more rows than `service-max-value-rows` is only
+  // used for a bind join if it has at most `service-bind-join-max-rows` rows.
+  auto service = std::make_shared<Service>(testQec, parsedServiceClause, mock);
+  {
+    auto cleanupMaxRows = setRuntimeParameterForTest<
+        &RuntimeParameters::serviceBindJoinMaxRows_>(5);
+    Service::precomputeSiblingResult(sibling, service, true, false);
+    EXPECT_FALSE(service->siblingInfo_.has_value());
+  }
+  sibling->precomputedResultBecauseSiblingOfService().reset();
+  Service::precomputeSiblingResult(sibling, service, true, false);
+  EXPECT_TRUE(service->siblingInfo_.has_value());
+}
+
 TEST_F(ServiceTest, getCacheKey) {
   // Base query to check cache-keys against.
   parsedQuery::Service parsedServiceClause{
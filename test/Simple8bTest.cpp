@@ -4,6 +4,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "util/Simple8bCode.h"
 
 using std::string;
@@ -208,4 +210,23 @@ TEST(Simple8bTest, testEncodeDecode242times0) {
   delete[] encoded;
   delete[] decoded;
 }
+// _____________________________________________________________________________
+TEST(Simple8bTest, testEncodeDecodeAllSelectors) {
+  // Runs of values of all the widths, s.t. every selector is used, and a
+  // transformation during the decoding.
+  std::vector<uint64_t> plain(250, 0);
+  for (size_t width = 1; width <= 60; ++width) {
+    for (size_t i = 0; i < 70; ++i) {
+      plain.push_back((uint64_t{1} << (width - 1)) + i % 2);
+    }
+  }
+  std::vector<uint64_t> encoded(plain.size());
+  Simple8bCode::encode(plain.data(), plain.size(), encoded.data());
+  std::vector<uint64_t> decoded(plain.size() + 239);
+  Simple8bCode::decode(encoded.data(), plain.size(), decoded.data(),
+                       [](uint64_t value) { return value + 1; });
+  for (size_t i = 0; i < plain.size(); ++i) {
+    ASSERT_EQ(plain[i] + 1, decoded[i]) << i;
+  }
+}
 }  // namespace ad_utility
@@ -426,6 +426,49 @@ TEST(Sort, inMemorySortMaterializedInput) {
   }
 }
 
+// Test that the in-memory sort falls back to the external sort if it exceeds
+// the memory limit.
+TEST(Sort, inMemorySortFallsBackToExternalSort) {
+  auto qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+
+  // The input (5000 rows × 3 cols × 8 bytes = 120 KB) is below the threshold
+  // for the in-memory sort, but its allocator only allows 300 KB: The input is
+  // stored by the `ValuesForTesting` and copied once for its result, so the
+  // copy for the in-memory sort exceeds the limit.
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::sortInMemoryThreshold_>(
+          ad_utility::MemorySize::megabytes(10));
+  VectorTable input;
+  for (int64_t i = 0; i < 5000; ++i) {
+    input.push_back({i % 13, i % 11, i + 2000});
+  }
+  IdTable inputTable{3, ad_utility::testing::makeAllocator(
+                            ad_utility::MemorySize::kilobytes(300))};
+  inputTable.insertAtEnd(makeIdTableFromVector(input, &Id::makeFromInt));
+
+  std::vector<std::optional<Variable>> vars = {Variable{"?0"}, Variable{"?1"},
+                                               Variable{"?2"}};
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(inputTable), vars, false, std::vector<ColumnIndex>{},
+      LocalVocab{}, std::nullopt, true);
+  Sort sort{qec, subtree, {0, 1, 2}};
+  auto result = sort.getResult();
+  EXPECT_EQ(sort.runtimeInfo().details_["is-external"], "true");
+  EXPECT_EQ(
+      sort.runtimeInfo().details_["in-memory-sort-exceeded-memory-limit"],
+      true);
+
+  const auto& table = result->idTable();
+  EXPECT_EQ(5000u, table.numRows());
+  for (size_t i = 1; i < table.numRows(); ++i) {
+    bool isLessOrEqual =
+        std::tie(table(i - 1, 0), table(i - 1, 1), table(i - 1, 2)) <=
+        std::tie(table(i, 0), table(i, 1), table(i, 2));
+    EXPECT_TRUE(isLessOrEqual) << "Row " << i << " is not in order";
+  }
+}
+
 // _____________________________________________________________________________
 TEST(Sort, limitOffsetIsPropagated) {
   auto qec = ad_utility::testing::getQec();
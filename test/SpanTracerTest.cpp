@@ -0,0 +1,150 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "util/SpanTracer.h"
+
+using ad_utility::timer::SpanTracer;
+using ad_utility::timer::TraceSpan;
+using ::testing::ElementsAre;
+
+namespace {
+// Return the names of the `spans`.
+std::vector<std::string> names(const std::vector<SpanTracer::Span>& spans) {
+  std::vector<std::string> result;
+  for (const auto& span : spans) {
+    result.push_back(span.name_);
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(SpanTracer, activation) {
+  EXPECT_EQ(SpanTracer::active(), nullptr);
+  SpanTracer tracer;
+  SpanTracer other;
+  {
+    SpanTracer::Activation activation{&tracer};
+    EXPECT_EQ(SpanTracer::active(), &tracer);
+    {
+      SpanTracer::Activation inner{&other};
+      EXPECT_EQ(SpanTracer::active(), &other);
+      TraceSpan span{"test", "inOther"};
+    }
+    EXPECT_EQ(SpanTracer::active(), &tracer);
+    {
+      // A nested activation of `nullptr` disables the tracing.
+      SpanTracer::Activation inner{nullptr};
+      TraceSpan span{"test", "notRecorded"};
+    }
+    TraceSpan outer{"test"};
+    TraceSpan inner{"test", "inner"};
+  }
+  EXPECT_EQ(SpanTracer::active(), nullptr);
+  // Spans without an active tracer are ignored.
+  TraceSpan ignored{"test", "ignored"};
+
+  auto spans = tracer.collectSpans();
+  ASSERT_EQ(spans.size(), 1);
+  EXPECT_EQ(spans[0].threadIndex_, SpanTracer::currentThreadIndex());
+  EXPECT_EQ(spans[0].numDropped_, 0);
+  // The spans are ordered by their end, and the name defaults to the
+  // category.
+  EXPECT_THAT(names(spans[0].spans_), ElementsAre("inner", "test"));
+  EXPECT_EQ(spans[0].spans_[0].category_, "test");
+  EXPECT_GE(spans[0].spans_[0].beginMicroseconds_,
+            spans[0].spans_[1].beginMicroseconds_);
+  EXPECT_GE(spans[0].spans_[1].durationMicroseconds_,
+            spans[0].spans_[0].durationMicroseconds_);
+
+  ASSERT_EQ(other.collectSpans().size(), 1);
+  EXPECT_THAT(names(other.collectSpans()[0].spans_), ElementsAre("inOther"));
+}
+
+// _____________________________________________________________________________
+TEST(SpanTracer, multipleThreads) {
+  SpanTracer tracer;
+  {
+    SpanTracer::Activation activation{&tracer};
+    TraceSpan span{"test", "main"};
+  }
+  size_t otherThreadIndex = 0;
+  std::thread thread{[&tracer, &otherThreadIndex]() {
+    SpanTracer::Activation activation{&tracer};
+    { TraceSpan span{"test", "worker1"}; }
+    { TraceSpan span{"test", "worker2"}; }
+    otherThreadIndex = SpanTracer::currentThreadIndex();
+  }};
+  thread.join();
+  EXPECT_NE(otherThreadIndex, SpanTracer::currentThreadIndex());
+
+  auto spans = tracer.collectSpans();
+  ASSERT_EQ(spans.size(), 2);
+  EXPECT_EQ(spans[0].threadIndex_, SpanTracer::currentThreadIndex());
+  EXPECT_THAT(names(spans[0].spans_), ElementsAre("main"));
+  EXPECT_EQ(spans[1].threadIndex_, otherThreadIndex);
+  EXPECT_THAT(names(spans[1].spans_), ElementsAre("worker1", "worker2"));
+}
+
+// _____________________________________________________________________________
+TEST(SpanTracer, ringBuffer) {
+  SpanTracer tracer{2};
+  SpanTracer::Activation activation{&tracer};
+  for (auto name : {"a", "b", "c", "d", "e"}) {
+    TraceSpan span{"test", name};
+  }
+  auto spans = tracer.collectSpans();
+  ASSERT_EQ(spans.size(), 1);
+  EXPECT_THAT(names(spans[0].spans_), ElementsAre("d", "e"));
+  EXPECT_EQ(spans[0].numDropped_, 3);
+}
+
+// _____________________________________________________________________________
+TEST(SpanTracer, chromeTrace) {
+  SpanTracer tracer{1};
+  {
+    SpanTracer::Activation activation{&tracer};
+    { TraceSpan span{"scan", "dropped"}; }
+    TraceSpan span{"scan", "readBlock"};
+  }
+  auto trace = tracer.toChromeTrace("query");
+  EXPECT_EQ(trace["displayTimeUnit"], "ms");
+  const auto& events = trace["traceEvents"];
+  ASSERT_EQ(events.size(), 3);
+  EXPECT_EQ(events[0]["ph"], "M");
+  EXPECT_EQ(events[0]["name"], "process_name");
+  EXPECT_EQ(events[0]["pid"], 1);
+  EXPECT_EQ(events[0]["args"]["name"], "query");
+  auto threadIndex = SpanTracer::currentThreadIndex();
+  EXPECT_EQ(events[1]["name"], "thread_name");
+  EXPECT_EQ(events[1]["tid"], threadIndex);
+  EXPECT_EQ(events[1]["args"]["name"],
+            absl::StrCat("thread ", threadIndex, " (1 spans dropped)"));
+  const auto& span = events[2];
+  EXPECT_EQ(span["ph"], "X");
+  EXPECT_EQ(span["name"], "readBlock");
+  EXPECT_EQ(span["cat"], "scan");
+  EXPECT_EQ(span["pid"], 1);
+  EXPECT_EQ(span["tid"], threadIndex);
+  EXPECT_GE(span["dur"].get<int64_t>(), 0);
+  EXPECT_GT(span["ts"].get<int64_t>(), 0);
+}
+
+// _____________________________________________________________________________
+TEST(SpanTracer, sample) {
+  EXPECT_FALSE(SpanTracer::sample(0.0));
+  EXPECT_FALSE(SpanTracer::sample(-1.0));
+  EXPECT_TRUE(SpanTracer::sample(1.0));
+}
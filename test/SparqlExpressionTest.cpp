@@ -27,6 +27,7 @@
 #include "engine/sparqlExpressions/SparqlExpressionTypes.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
 #include "engine/sparqlExpressions/StdevExpression.h"
+#include "engine/sparqlExpressions/VectorizedExpressionHelpers.h"
 #include "index/Index.h"
 #include "rdfTypes/GeoPoint.h"
 #include "rdfTypes/GeometryInfo.h"
@@ -604,6 +605,67 @@ TEST(SparqlExpression, arithmeticOperators) {
   testDivide(nanAndInf, divByZeroInputsInt, D(0));
 }
 
+// _____________________________________________________________________________
+TEST(SparqlExpression, vectorizedNumericExpressions) {
+  // The arithmetic and relational expressions on vectors of `Id`s are
+  // evaluated in batches. The inputs consist of a batch with only integers, a
+  // batch with only doubles, a batch with both, and an incomplete batch that
+  // also contains values that are not numeric.
+  constexpr size_t batchSize = detail::vectorized::BATCH_SIZE;
+  V<Id> x{alloc};
+  V<Id> sum{alloc};
+  V<Id> difference{alloc};
+  V<Id> product{alloc};
+  V<Id> quotient{alloc};
+  V<Id> lessThan{alloc};
+  for (size_t i = 0; i < 3 * batchSize + 17; ++i) {
+    auto value = static_cast<int64_t>(i) - 1500;
+    size_t batch = i / batchSize;
+    bool isInt = batch == 0 || (batch == 2 && i % 2 == 0) ||
+                 (batch == 3 && i % 3 == 0);
+    bool isDouble = batch == 1 || (batch == 2 && i % 2 == 1);
+    if (isInt) {
+      x.push_back(I(value));
+      sum.push_back(I(value + 3));
+      difference.push_back(I(value - 3));
+      product.push_back(I(value * 3));
+      quotient.push_back(D(static_cast<double>(value) / 3.0));
+      lessThan.push_back(B(value < 3));
+    } else if (isDouble) {
+      double d = static_cast<double>(value) * 0.5;
+      x.push_back(D(d));
+      sum.push_back(D(d + 3.0));
+      difference.push_back(D(d - 3.0));
+      product.push_back(D(d * 3.0));
+      quotient.push_back(D(d / 3.0));
+      lessThan.push_back(B(d < 3.0));
+    } else {
+      x.push_back(i % 3 == 1 ? U : Voc(4));
+      for (auto* result : {&sum, &difference, &product, &quotient, &lessThan}) {
+        result->push_back(U);
+      }
+    }
+  }
+  V<Id> three{alloc};
+  three.resize(x.size(), I(3));
+
+  auto makeLessThan = [](SparqlExpression::Ptr a, SparqlExpression::Ptr b) {
+    return std::make_unique<LessThanExpression>(
+        std::array<SparqlExpression::Ptr, 2>{std::move(a), std::move(b)});
+  };
+  // The second operand is both a constant and a vector.
+  testPlus(sum, x, I(3));
+  testPlus(sum, x, three);
+  testMinus(difference, x, I(3));
+  testMinus(difference, x, three);
+  testMultiply(product, x, I(3));
+  testMultiply(product, x, three);
+  testDivide(quotient, x, I(3));
+  testDivide(quotient, x, three);
+  testNaryExpression(makeLessThan, lessThan, x, I(3));
+  testNaryExpression(makeLessThan, lessThan, x, three);
+}
+
 // Test that the unary expression that is specified by the `makeFunction` yields
 // the `expected` result when being given the `operand`.
 template <auto makeFunction>
@@ -1694,3 +1694,84 @@ TEST(ParserTest, ensureTypeIriDoesntViolateAssertion) {
                                             "22-rdf-syntax-ns#type>")))}),
               TripleComponent{Variable{"?o"}}}}))));
 }
+
+// _____________________________________________________________________________
+TEST(ParserTest, dataUpdatesWithTurtleParser) {
+  ad_utility::BlankNodeManager bnm;
+  EncodedIriManager ev;
+  auto parseWithTurtle = [&bnm, &ev](std::string_view update) {
+    return SparqlParser::parseDataUpdateWithTurtleParser(&bnm, &ev, update);
+  };
+  // The updates in this test are small enough to be parsed by the SPARQL
+  // parser in `parseUpdate`.
+  auto parseWithSparql = [&bnm, &ev](std::string update) {
+    return ad_utility::getSingleElement(
+        SparqlParser::parseUpdate(&bnm, &ev, std::move(update)));
+  };
+  auto getTriples = [](const ParsedQuery& update, bool toInsert) {
+    const auto& op = update.updateClause().op_;
+    return toInsert ? op.toInsert_.triples_ : op.toDelete_.triples_;
+  };
+
+  // Both parsers yield the same result.
+  for (std::string update :
+       {"PREFIX ex: <http://example.org/> INSERT DATA { ex:a ex:b ex:c . "
+        "<d> <e> \"lit\", \"lang\"@en ; ex:f ex:g }",
+        "  delete data { <a> <b> <c> . } ", "INSERT DATA {}"}) {
+    auto turtle = parseWithTurtle(update);
+    ASSERT_TRUE(turtle.has_value()) << update;
+    auto sparql = parseWithSparql(update);
+    for (bool toInsert : {true, false}) {
+      EXPECT_EQ(getTriples(turtle.value(), toInsert),
+                getTriples(sparql, toInsert))
+          << update;
+    }
+    EXPECT_EQ(turtle->_originalString, sparql._originalString);
+  }
+
+  // Blank nodes in `INSERT DATA` become new blank nodes, the same label yields
+  // the same blank node.
+  {
+    auto turtle = parseWithTurtle("INSERT DATA { _:x <b> _:x . [] <b> _:y }");
+    ASSERT_TRUE(turtle.has_value());
+    auto triples = getTriples(turtle.value(), true);
+    ASSERT_EQ(triples.size(), 2);
+    const auto& subject = triples[0].s_;
+    ASSERT_TRUE(subject.isId());
+    EXPECT_EQ(subject.getId().getDatatype(), Datatype::BlankNodeIndex);
+    EXPECT_EQ(subject, triples[0].o_);
+    EXPECT_NE(subject, triples[1].s_);
+    EXPECT_NE(triples[1].s_, triples[1].o_);
+  }
+
+  // Updates that can't (or must not) be parsed by the Turtle parser.
+  for (std::string_view update :
+       {"INSERT DATA { GRAPH <g> { <a> <b> <c> } }",
+        "DELETE DATA { _:x <b> <c> }", "INSERT DATA { <a> <b> ?x }",
+        "INSERT DATA { <a> <b> <c> } ; INSERT DATA { <d> <e> <f> }",
+        "<x> <y> <z> . INSERT DATA { <a> <b> <c> }",
+        "INSERT { <a> <b> <c> } WHERE {}", "INSERT DATA { <a> <b> <c> ",
+        "INSERT DATA { <a> <b> \"\\u0041\" }", "SELECT * { ?s ?p ?o }"}) {
+    EXPECT_FALSE(parseWithTurtle(update).has_value()) << update;
+  }
+
+  // Large updates are parsed by the Turtle parser in `parseUpdate`, with the
+  // datasets from outside the update.
+  std::string largeUpdate = "INSERT DATA {";
+  size_t numTriples = 0;
+  while (largeUpdate.size() < MIN_SIZE_FOR_TURTLE_PARSING_OF_DATA_UPDATES()) {
+    absl::StrAppend(&largeUpdate, " <s", numTriples++, "> <p> <o> .");
+  }
+  largeUpdate.append("}");
+  auto updates = SparqlParser::parseUpdate(&bnm, &ev, largeUpdate,
+                                           {{{iri("<g>"), false}}});
+  ASSERT_EQ(updates.size(), 1);
+  auto triples = getTriples(updates[0], true);
+  ASSERT_EQ(triples.size(), numTriples);
+  EXPECT_EQ(triples.back(),
+            (SparqlTripleSimpleWithGraph{
+                iri(absl::StrCat("<s", numTriples - 1, ">")), iri("<p>"),
+                iri("<o>"), std::monostate{}}));
+  EXPECT_THAT(updates[0].datasetClauses_,
+              m::datasetClausesMatcher({{iri("<g>")}}, std::nullopt));
+}
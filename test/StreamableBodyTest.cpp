@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include "util/http/beast.h"
+#include "util/StringBufferPool.h"
 #include "util/http/streamable_body.h"
 
 using namespace ad_utility::httpUtils::httpStreams;
@@ -103,3 +104,25 @@ TEST(StreamableBody, GeneratorReturnsBufferedResults) {
   ASSERT_EQ(errorCode, boost::system::error_code());
   ASSERT_EQ(result3, boost::none);
 }
+
+// _____________________________________________________________________________
+TEST(StreamableBody, ConsumedBuffersAreRecycled) {
+  auto& pool = ad_utility::streams::httpResponseBufferPool();
+  auto generator = [&pool]() -> cppcoro::generator<std::string> {
+    auto buffer = pool.get();
+    buffer.append("chunk");
+    co_yield buffer;
+  }();
+  boost::beast::http::header<false, boost::beast::http::fields> header;
+  streamable_body::writer writer{header, generator};
+  boost::system::error_code errorCode;
+
+  auto result = writer.get(errorCode);
+  ASSERT_NE(result, boost::none);
+  ASSERT_EQ(toStringView(result->first), "chunk");
+  auto numBuffers = pool.numBuffers();
+  // The buffer of the first chunk is returned to the pool when the next chunk
+  // is requested.
+  ASSERT_EQ(writer.get(errorCode), boost::none);
+  ASSERT_EQ(pool.numBuffers(), numBuffers + 1);
+}
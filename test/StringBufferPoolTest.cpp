@@ -0,0 +1,64 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gtest/gtest.h>
+
+#include "util/StringBufferPool.h"
+
+using ad_utility::streams::StringBufferPool;
+
+// _____________________________________________________________________________
+TEST(StringBufferPool, getAndPut) {
+  StringBufferPool pool{100, 2};
+  auto buffer = pool.get();
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_GE(buffer.capacity(), 100);
+  EXPECT_EQ(pool.numBuffers(), 0);
+
+  // A returned buffer is reused (and cleared).
+  buffer.append("some content");
+  const char* data = buffer.data();
+  pool.put(std::move(buffer));
+  EXPECT_EQ(pool.numBuffers(), 1);
+  auto reused = pool.get();
+  EXPECT_TRUE(reused.empty());
+  EXPECT_EQ(reused.data(), data);
+  EXPECT_EQ(pool.numBuffers(), 0);
+
+  // At most two buffers are kept.
+  pool.put(pool.get());
+  pool.put(pool.get());
+  pool.put(pool.get());
+  EXPECT_EQ(pool.numBuffers(), 1);
+  auto a = pool.get();
+  auto b = pool.get();
+  auto c = pool.get();
+  pool.put(std::move(a));
+  pool.put(std::move(b));
+  pool.put(std::move(c));
+  EXPECT_EQ(pool.numBuffers(), 2);
+}
+
+// _____________________________________________________________________________
+TEST(StringBufferPool, buffersWithWrongCapacityAreFreed) {
+  StringBufferPool pool{100, 10};
+  pool.put(std::string{});
+  std::string small;
+  small.reserve(50);
+  pool.put(std::move(small));
+  std::string large;
+  large.reserve(1000);
+  pool.put(std::move(large));
+  EXPECT_EQ(pool.numBuffers(), 0);
+
+  std::string fitting;
+  fitting.reserve(150);
+  pool.put(std::move(fitting));
+  EXPECT_EQ(pool.numBuffers(), 1);
+}
@@ -238,6 +238,54 @@ TEST(StringSortComparatorTest, IsLessInTotalWithExternalFlag) {
                            Entry{"\"beta\"", false}));
 }
 
+// ______________________________________________________________________________________________
+TEST(StringSortComparatorTest, TotalSortKey) {
+  TripleComponentComparator comp("en", "US", false);
+  std::vector<std::string> words{"\"alpha\"",
+                                 "\"Alpha\"",
+                                 "\"alpha\"@en",
+                                 "\"alpha\"@de",
+                                 "\"alph\"",
+                                 "\"älpha\"",
+                                 "\"151\"",
+                                 "\"१५१\"",
+                                 "\"\"",
+                                 "\"alpha",
+                                 "\"a\"^^<x>",
+                                 "\"a\"^^<y>",
+                                 "\"Hannibal\"@af",
+                                 "\"hannibal\"@en",
+                                 "\"Hanni bal\"",
+                                 "<alpha>",
+                                 "<Alpha>",
+                                 "<alph>",
+                                 "@en@<alpha>",
+                                 "_:b1",
+                                 ""};
+  using Level = TripleComponentComparator::Level;
+  auto sign = [](int i) { return (i > 0) - (i < 0); };
+  // The bytewise comparison of the sort keys is consistent with the
+  // comparison on the `TOTAL` level.
+  for (const auto& a : words) {
+    auto aSortKey = comp.getTotalSortKey(a);
+    for (const auto& b : words) {
+      auto bSortKey = comp.getTotalSortKey(b);
+      EXPECT_EQ(sign(std::string_view{aSortKey}.compare(bSortKey)),
+                sign(comp.compare(a, b, Level::TOTAL)))
+          << a << ' ' << b;
+      for (bool aExt : {false, true}) {
+        for (bool bExt : {false, true}) {
+          EXPECT_EQ(
+              TripleComponentComparator::isLessInTotalWithExternalFlagBySortKey(
+                  aSortKey, aExt, bSortKey, bExt),
+              comp.isLessInTotalWithExternalFlag(a, aExt, b, bExt))
+              << a << ' ' << b;
+        }
+      }
+    }
+  }
+}
+
 // ______________________________________________________________________________________________
 TEST(StringSortComparatorTest, SimpleStringComparator) {
   SimpleStringComparator comp("en", "US", true);
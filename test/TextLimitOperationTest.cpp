@@ -223,6 +223,75 @@ TEST(TextLimit, computeResult) {
   compareIdTableWithExpectedContent(resultIdTable, expectedTable);
 }
 
+// _____________________________________________________________________________
+TEST(TextLimit, pruneTextRecordsWithoutEntities) {
+  /*
+  textRecord | score | random
+  ---------------------------
+  1          | 5     | 0
+  1          | 1     | 1
+  2          | 4     | 2
+  3          | 3     | 3
+  3          | 6     | 4
+  4          | 2     | 5
+
+  The two best pairs of (score, text record) are (6, 3) and (5, 1). All the
+  other rows can't be part of the result, so they are pruned before the
+  sorting.
+  */
+  IdTable inputTable = makeIdTableFromVector(
+      {{1, 5, 0}, {1, 1, 1}, {2, 4, 2}, {3, 3, 3}, {3, 6, 4}, {4, 2, 5}},
+      &Id::makeFromInt);
+  TextLimit textLimit = makeTextLimit(inputTable.clone(), 2, 0, {}, {1});
+  IdTable resultIdTable = textLimit.getResult()->idTable().clone();
+  compareIdTableWithExpectedContent(
+      resultIdTable,
+      makeIdTableFromVector({{3, 6, 4}, {1, 5, 0}}, &Id::makeFromInt));
+  EXPECT_EQ(textLimit.runtimeInfo().details_["num-pruned-rows"], 4);
+
+  // With a limit that is at least the number of pairs, nothing is pruned.
+  TextLimit textLimit6 = makeTextLimit(inputTable.clone(), 6, 0, {}, {1});
+  resultIdTable = textLimit6.getResult()->idTable().clone();
+  EXPECT_EQ(resultIdTable.numRows(), 6);
+  EXPECT_FALSE(textLimit6.runtimeInfo().details_.contains("num-pruned-rows"));
+}
+
+// _____________________________________________________________________________
+TEST(TextLimit, lazyInput) {
+  // textRecord | entity | score
+  std::vector<IdTable> blocks;
+  blocks.push_back(makeIdTableFromVector(
+      {{1, 2, 5}, {2, 1, 3}, {3, 2, 7}, {4, 1, 1}}, &Id::makeFromInt));
+  blocks.push_back(makeIdTableFromVector(
+      {{5, 1, 2}, {6, 2, 1}, {3, 2, 7}, {7, 1, 4}}, &Id::makeFromInt));
+  blocks.push_back(makeIdTableFromVector({{8, 2, 6}}, &Id::makeFromInt));
+  IdTable materialized{3, ad_utility::makeUnlimitedAllocator<Id>()};
+  for (const auto& block : blocks) {
+    materialized.insertAtEnd(block);
+  }
+  auto qec = ad_utility::testing::getQec();
+  std::vector<std::optional<Variable>> vars{Variable{"?t"}, Variable{"?e"},
+                                            Variable{"?s"}};
+  TextLimit lazyTextLimit{
+      qec,
+      2,
+      ad_utility::makeExecutionTree<ValuesForTesting>(qec, std::move(blocks),
+                                                      vars),
+      0,
+      {1},
+      {2}};
+  auto expected = makeIdTableFromVector(
+      {{7, 1, 4}, {2, 1, 3}, {3, 2, 7}, {3, 2, 7}, {8, 2, 6}},
+      &Id::makeFromInt);
+  auto result = lazyTextLimit.getResult();
+  EXPECT_THAT(result->idTable(), matchesIdTable(expected));
+  EXPECT_EQ(lazyTextLimit.runtimeInfo().details_["num-pruned-rows"], 4);
+
+  // The result is the same for a fully materialized input.
+  TextLimit textLimit = makeTextLimit(std::move(materialized), 2, 0, {1}, {2});
+  EXPECT_THAT(textLimit.getResult()->idTable(), matchesIdTable(expected));
+}
+
 // _____________________________________________________________________________
 TEST(TextLimit, computeResultMultipleEntities) {
   /*
@@ -0,0 +1,61 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <thread>
+
+#include "util/ThreadBudget.h"
+
+using ad_utility::ThreadBudget;
+
+// _____________________________________________________________________________
+TEST(ThreadBudget, reserveAndRelease) {
+  ThreadBudget budget{8};
+  {
+    // On an idle budget, the requested threads are granted.
+    auto first = budget.reserve(5);
+    EXPECT_EQ(first.numThreads(), 5);
+    // Under load, only the remaining threads are granted.
+    auto second = budget.reserve(5);
+    EXPECT_EQ(second.numThreads(), 3);
+    // An exhausted budget still grants the calling thread.
+    auto third = budget.reserve(5);
+    EXPECT_EQ(third.numThreads(), 1);
+    EXPECT_EQ(budget.numReserved(), 9);
+
+    // Moving a reservation doesn't release it twice.
+    std::optional<ThreadBudget::Reservation> moved{std::move(second)};
+    EXPECT_EQ(budget.numReserved(), 9);
+    moved.reset();
+    EXPECT_EQ(budget.numReserved(), 6);
+    auto fourth = budget.reserve(5);
+    EXPECT_EQ(fourth.numThreads(), 2);
+  }
+  EXPECT_EQ(budget.numReserved(), 0);
+  EXPECT_EQ(budget.reserve(0).numThreads(), 1);
+  EXPECT_EQ(budget.reserve(20).numThreads(), 8);
+}
+
+// _____________________________________________________________________________
+TEST(ThreadBudget, setCapacity) {
+  ThreadBudget budget{2};
+  auto first = budget.reserve(2);
+  budget.setCapacity(4);
+  EXPECT_EQ(budget.reserve(4).numThreads(), 2);
+
+  // A capacity of zero means the number of hardware threads.
+  budget.setCapacity(0);
+  size_t numHardwareThreads =
+      std::max(size_t{1}, size_t{std::thread::hardware_concurrency()});
+  EXPECT_EQ(budget.reserve(1000).numThreads(),
+            numHardwareThreads > 2 ? numHardwareThreads - 2 : 1);
+}
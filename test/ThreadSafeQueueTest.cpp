@@ -429,3 +429,55 @@ TEST(ThreadSafeQueue, queueManager) {
   runWithBothQueueTypes(
       std::bind_front(RunQueueManagerTest{}, bothThrowImmediately));
 }
+
+// ________________________________________________________________
+TEST(ThreadSafeQueue, parallelTransform) {
+  auto makeInput = []() {
+    return ad_utility::InputRangeTypeErased{
+        std::views::iota(size_t{0}, numValues)};
+  };
+  auto timesTwo = [](size_t& i) { return 2 * i; };
+  std::vector<size_t> expected;
+  for (size_t i = 0; i < numValues; ++i) {
+    expected.push_back(2 * i);
+  }
+
+  for (bool keepOrder : {true, false}) {
+    std::vector<size_t> result;
+    for (size_t value : parallelTransform(makeInput(), timesTwo, numThreads,
+                                          queueSize, keepOrder)) {
+      result.push_back(value);
+    }
+    // Without `keepOrder`, the order of the results is unspecified.
+    if (!keepOrder) {
+      ql::ranges::sort(result);
+    }
+    EXPECT_EQ(result, expected);
+  }
+
+  // An exception in one of the workers is propagated to the consumer.
+  auto throwAt42 = [](size_t& i) {
+    if (i == 42) {
+      throw std::runtime_error{"transformation failed"};
+    }
+    return i;
+  };
+  for (bool keepOrder : {true, false}) {
+    auto transformed = parallelTransform(makeInput(), throwAt42, numThreads,
+                                         queueSize, keepOrder);
+    auto consumeAll = [&transformed]() {
+      for ([[maybe_unused]] size_t value : transformed) {
+      }
+    };
+    AD_EXPECT_THROW_WITH_MESSAGE(consumeAll(),
+                                 ::testing::HasSubstr("transformation failed"));
+  }
+
+  // The consumer stops early, which must not lead to a deadlock.
+  {
+    auto transformed = parallelTransform(makeInput(), timesTwo, numThreads,
+                                         queueSize, true);
+    auto it = transformed.begin();
+    EXPECT_EQ(*it, 0u);
+  }
+}
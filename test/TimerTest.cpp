@@ -162,3 +162,19 @@ TEST(Timer, ThreadSafeTimerMultiThreaded) {
   EXPECT_GT(t.value(), singleThreadedTimer.value());
   testTime(t.value(), t.msecs(), 10ms);
 }
+
+// ____________________________________________________________________________
+TEST(Timer, currentThreadCpuTime) {
+#ifdef _QLEVER_NO_TIMING_TESTS
+  GTEST_SKIP_("because _QLEVER_NO_TIMING_TESTS defined");
+#endif
+  // Sleeping doesn't consume CPU time, but busy waiting does.
+  auto start = ad_utility::currentThreadCpuTime();
+  std::this_thread::sleep_for(50ms);
+  EXPECT_LT(ad_utility::currentThreadCpuTime() - start, 25ms);
+  start = ad_utility::currentThreadCpuTime();
+  Timer timer{Timer::Started};
+  while (timer.value() < 20ms) {
+  }
+  EXPECT_GE(ad_utility::currentThreadCpuTime() - start, 10ms);
+}
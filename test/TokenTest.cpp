@@ -8,6 +8,7 @@
 #include <string>
 
 #include "./TokenTestCtreHelper.h"
+#include "parser/FastTurtleTokens.h"
 #include "parser/Tokenizer.h"
 #include "parser/TokenizerCtre.h"
 #include "rdfTypes/RdfEscaping.h"
@@ -459,3 +460,57 @@ TEST(Escaping, unescapeIriref) {
                  ad_utility::Exception);
   }
 }
+
+// _____________________________________________________________________________
+TEST(TokenTest, FastTurtleTokens) {
+  // Check that the fast path either gives the same result as the regex of the
+  // `Tokenizer` or defers to it.
+  auto expectConsistent = [](auto id, std::string_view input,
+                             bool expectFastPath = true) {
+    static constexpr TurtleTokenId tokenId = decltype(id)::value;
+    Tokenizer tokenizer{input};
+    auto [success, match] = tokenizer.getNextToken<tokenId>();
+    auto length = fastTurtleTokens::match<tokenId>(input);
+    EXPECT_EQ(length.has_value(), expectFastPath) << input;
+    if (length.has_value()) {
+      EXPECT_EQ(length.value() > 0, success) << input;
+      EXPECT_EQ(input.substr(0, length.value()), success ? match : "")
+          << input;
+    }
+  };
+  using Id = TurtleTokenId;
+  auto iriref = std::integral_constant<Id, Id::Iriref>{};
+  expectConsistent(iriref, "<http://example.org/a> .");
+  expectConsistent(iriref, "<> .");
+  expectConsistent(iriref, "_:b .");
+  expectConsistent(iriref, "<http://example.org/\\u00E4>", false);
+  expectConsistent(iriref, "<http://example.org/\xC3\xA4>", false);
+  expectConsistent(iriref, "<http://example.org/a b>", false);
+  expectConsistent(iriref, "<http://example.org/a", false);
+
+  auto blankNode = std::integral_constant<Id, Id::BlankNodeLabel>{};
+  expectConsistent(blankNode, "_:b1 <p>");
+  expectConsistent(blankNode, "_:b.1-x_y.. .");
+  expectConsistent(blankNode, "_:0abc.");
+  expectConsistent(blankNode, "<b>");
+  expectConsistent(blankNode, "_:-b", false);
+  expectConsistent(blankNode, "_:b\xC3\xA4", false);
+
+  auto langtag = std::integral_constant<Id, Id::Langtag>{};
+  expectConsistent(langtag, "@en .");
+  expectConsistent(langtag, "@en-US-x1 .");
+  expectConsistent(langtag, "@en- .");
+  expectConsistent(langtag, "@1 .");
+  expectConsistent(langtag, "^^<int>");
+
+  auto dot = std::integral_constant<Id, Id::Dot>{};
+  expectConsistent(dot, ". <a>");
+  expectConsistent(dot, "<a>");
+  auto doubleCircumflex = std::integral_constant<Id, Id::DoubleCircumflex>{};
+  expectConsistent(doubleCircumflex, "^^<int>");
+  expectConsistent(doubleCircumflex, "^<int>");
+
+  // There is no fast path for the other tokens.
+  EXPECT_FALSE(
+      fastTurtleTokens::match<TurtleTokenId::Integer>("42").has_value());
+}
@@ -19,6 +19,7 @@
 #include "util/IdTableHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using ad_utility::testing::getQec;
 namespace {
@@ -1906,6 +1907,52 @@ TEST_P(TransitivePathTest, sortOrderGuaranteesWithBoundOperation) {
   }
 }
 
+// _____________________________________________________________________________
+TEST_P(TransitivePathTest, manyStartNodesWithMultipleThreads) {
+  // Many short chains `i -> i + n -> i + 2n`, with enough start nodes to be
+  // split into several batches when using multiple threads.
+  const int64_t n = 300;
+  VectorTable edges;
+  VectorTable expected;
+  VectorTable startNodes;
+  VectorTable expectedWithPayload;
+  for (int64_t i = 0; i < n; ++i) {
+    edges.push_back({i, i + n});
+    edges.push_back({i + n, i + 2 * n});
+    expected.push_back({i, i + n});
+    expected.push_back({i, i + 2 * n});
+    expected.push_back({i + n, i + 2 * n});
+    // The bound side additionally has a payload column.
+    startNodes.push_back({i, 2 * i});
+    expectedWithPayload.push_back({i, i + n, 2 * i});
+    expectedWithPayload.push_back({i, i + 2 * n, 2 * i});
+  }
+
+  for (size_t numThreads : {1, 2, 4, 16}) {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::transitivePathNumThreads_>(numThreads);
+    TransitivePathSide left(std::nullopt, 0, Variable{"?start"}, 0);
+    TransitivePathSide right(std::nullopt, 1, Variable{"?target"}, 1);
+    auto unbound = makePathUnbound(makeIdTableFromVector(edges),
+                                   {Variable{"?start"}, Variable{"?target"}},
+                                   left, right, 1,
+                                   std::numeric_limits<size_t>::max());
+    assertResultMatchesIdTable(
+        unbound->computeResultOnlyForTesting(requestLaziness()),
+        makeIdTableFromVector(expected));
+
+    auto bound = makePathBound(true, makeIdTableFromVector(edges),
+                               {Variable{"?start"}, Variable{"?target"}},
+                               makeIdTableFromVector(startNodes), 0,
+                               {Variable{"?start"}, Variable{"?payload"}},
+                               left, right, 1,
+                               std::numeric_limits<size_t>::max());
+    assertResultMatchesIdTable(
+        bound->computeResultOnlyForTesting(requestLaziness()),
+        makeIdTableFromVector(expectedWithPayload));
+  }
+}
+
 // _____________________________________________________________________________
 INSTANTIATE_TEST_SUITE_P(
     TransitivePathTestSuite, TransitivePathTest,
@@ -0,0 +1,137 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include "parser/TurtleStatementScanner.h"
+
+namespace {
+// Scan the complete `input` at once and return the prefix of the input until
+// the end of the last complete statement together with all the directives.
+std::pair<std::string, std::vector<std::string>> scanAtOnce(
+    std::string_view input) {
+  TurtleStatementScanner scanner;
+  scanner.scan(input, true);
+  std::string complete{input.substr(0, scanner.endOfLastStatement())};
+  std::vector<std::string> directives;
+  for (auto [begin, end] : scanner.consumeCompleteStatements()) {
+    directives.emplace_back(input.substr(begin, end - begin));
+  }
+  return {std::move(complete), std::move(directives)};
+}
+
+// Feed the `input` to the scanner byte by byte and consume the complete
+// statements as soon as they are found. Return the absolute positions of all
+// the found statement ends.
+std::vector<size_t> scanIncrementally(std::string_view input) {
+  TurtleStatementScanner scanner;
+  std::string buffer;
+  size_t offset = 0;
+  std::vector<size_t> ends;
+  auto consume = [&]() {
+    if (scanner.endOfLastStatement() == 0) {
+      return;
+    }
+    offset += scanner.endOfLastStatement();
+    ends.push_back(offset);
+    buffer.erase(0, scanner.endOfLastStatement());
+    scanner.consumeCompleteStatements();
+  };
+  for (char c : input) {
+    buffer.push_back(c);
+    scanner.scan(buffer, false);
+    consume();
+  }
+  scanner.scan(buffer, true);
+  consume();
+  return ends;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(TurtleStatementScanner, statementEnds) {
+  auto expectComplete = [](std::string_view input,
+                           std::string_view expectedComplete) {
+    EXPECT_EQ(scanAtOnce(input).first, expectedComplete) << input;
+    auto ends = scanIncrementally(input);
+    EXPECT_EQ(ends.empty() ? 0 : ends.back(), expectedComplete.size())
+        << input;
+  };
+  expectComplete("<a> <b> <c> .\n<d> <e> <f>", "<a> <b> <c> .");
+  expectComplete("<a> <b> <c>.<d> <e> <f>.", "<a> <b> <c>.<d> <e> <f>.");
+  // A `.` inside of an IRI, a string literal, or a comment, or as part of a
+  // prefixed name or a number doesn't end a statement.
+  expectComplete("<a> <b> <c.\n> ", "");
+  expectComplete("<a> <b> \"c.\" ", "");
+  expectComplete("<a> <b> 'c.' ", "");
+  expectComplete("<a> <b> <c> # .\n", "");
+  expectComplete("ex:a ex:b ex:c.d ", "");
+  expectComplete("<a> <b> 3.5 ", "");
+  // Escaped quotes don't end a string literal.
+  expectComplete("<a> <b> \"c\\\" . \" .", "<a> <b> \"c\\\" . \" .");
+  // Multiline literals.
+  expectComplete("<a> <b> \"\"\"c .\n\"\" . \"\"\" . <x>",
+                 "<a> <b> \"\"\"c .\n\"\" . \"\"\" .");
+  expectComplete("<a> <b> '''c .\n' ''' .", "<a> <b> '''c .\n' ''' .");
+  expectComplete("<a> <b> \"\"\"c .\n<d> <e> <f> .\n", "");
+  // `<<` starts a quoted triple, not an IRI.
+  expectComplete("<< <a> <b> <c> >> <d> <e> .", "<< <a> <b> <c> >> <d> <e> .");
+}
+
+// _____________________________________________________________________________
+TEST(TurtleStatementScanner, directives) {
+  using ::testing::ElementsAre;
+  auto [complete, directives] = scanAtOnce(
+      "@prefix ex: <http://example.org/> .\n"
+      "ex:a ex:b ex:c .\n"
+      "PREFIX ex2: <http://example2.org/>\n"
+      "<a> <b> \"prefix ex3: <x>\"@prefix .\n"
+      "base <http://example.org/> <a> <b> <c> .\n"
+      "@base <http://other.org/> . <a> <b> <c> .");
+  EXPECT_THAT(directives,
+              ElementsAre("@prefix ex: <http://example.org/> .",
+                          "PREFIX ex2: <http://example2.org/>",
+                          "base <http://example.org/>",
+                          "@base <http://other.org/> ."));
+
+  // A directive that is not yet complete is not reported.
+  auto [complete2, directives2] =
+      scanAtOnce("<a> <b> <c> . @prefix ex: <http://example.org/> ");
+  EXPECT_EQ(complete2, "<a> <b> <c> .");
+  EXPECT_TRUE(directives2.empty());
+  // A SPARQL-style directive doesn't need a `.`.
+  auto [complete3, directives3] = scanAtOnce("BASE <http://example.org/>");
+  EXPECT_EQ(complete3, "BASE <http://example.org/>");
+  EXPECT_THAT(directives3, ElementsAre("BASE <http://example.org/>"));
+}
+
+// _____________________________________________________________________________
+TEST(TurtleStatementScanner, consumeCompleteStatements) {
+  TurtleStatementScanner scanner;
+  std::string input = "<a> <b> <c> . @prefix ex: <x> . <d> <e> ";
+  scanner.scan(input, false);
+  EXPECT_EQ(input.substr(0, scanner.endOfLastStatement()),
+            "<a> <b> <c> . @prefix ex: <x> .");
+  auto directives = scanner.consumeCompleteStatements();
+  ASSERT_EQ(directives.size(), 1u);
+  auto [begin, end] = directives.at(0);
+  EXPECT_EQ(input.substr(begin, end - begin), "@prefix ex: <x> .");
+  EXPECT_EQ(scanner.endOfLastStatement(), 0u);
+
+  // Continue with the rest of the input, which is extended.
+  input = " <d> <e> \"f\" . BASE <y>";
+  scanner.scan(input, true);
+  EXPECT_EQ(input.substr(0, scanner.endOfLastStatement()), input);
+  directives = scanner.consumeCompleteStatements();
+  ASSERT_EQ(directives.size(), 1u);
+  std::tie(begin, end) = directives.at(0);
+  EXPECT_EQ(input.substr(begin, end - begin), "BASE <y>");
+}
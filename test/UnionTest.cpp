@@ -2,6 +2,7 @@
 // Chair of Algorithms and Data Structures.
 // Author: Florian Kramer (florian.kramer@mail.uni-freiburg.de)
 
+#include <absl/cleanup/cleanup.h>
 #include <gtest/gtest.h>
 
 #include <vector>
@@ -9,6 +10,7 @@
 #include "./engine/ValuesForTesting.h"
 #include "./util/IdTableHelpers.h"
 #include "./util/IdTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
 #include "engine/IndexScan.h"
 #include "engine/NeutralElementOperation.h"
 #include "engine/Sort.h"
@@ -236,6 +238,58 @@ TEST(Union, clone) {
   EXPECT_EQ(clone->getDescriptor(), unionOperation.getDescriptor());
 }
 
+// _____________________________________________________________________________
+TEST(Union, childrenAreComputedInParallel) {
+  auto* qec = ad_utility::testing::getQec();
+  // The children are only computed in parallel if no websocket updates are
+  // sent.
+  bool websocketUpdatesEnabled = qec->areWebsocketUpdatesEnabled_;
+  qec->areWebsocketUpdatesEnabled_ = false;
+  absl::Cleanup restoreWebsocketUpdates{
+      [&]() { qec->areWebsocketUpdatesEnabled_ = websocketUpdatesEnabled; }};
+  auto budgetCleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::threadBudget_>(8);
+
+  auto makeValues = [qec](const VectorTable& rows) {
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector(rows), Vars{Variable{"?x"}});
+  };
+  auto makeUnion = [qec, &makeValues]() {
+    auto left = ad_utility::makeExecutionTree<Union>(
+        qec, makeValues({{1}, {2}}), makeValues({{3}}));
+    auto right = ad_utility::makeExecutionTree<Union>(
+        qec, makeValues({{4}}), makeValues({{5}, {6}}));
+    return Union{qec, std::move(left), std::move(right)};
+  };
+  auto expected = makeIdTableFromVector({{1}, {2}, {3}, {4}, {5}, {6}});
+  auto computedInParallel = [](Union& u) {
+    return u.runtimeInfo().details_.contains("children-computed-in-parallel");
+  };
+
+  {
+    auto u = makeUnion();
+    qec->getQueryTreeCache().clearAll();
+    EXPECT_EQ(u.computeResultOnlyForTesting().idTable(), expected);
+    EXPECT_TRUE(computedInParallel(u));
+  }
+  {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::parallelUnion_>(false);
+    auto u = makeUnion();
+    qec->getQueryTreeCache().clearAll();
+    EXPECT_EQ(u.computeResultOnlyForTesting().idTable(), expected);
+    EXPECT_FALSE(computedInParallel(u));
+  }
+  {
+    qec->areWebsocketUpdatesEnabled_ = true;
+    auto u = makeUnion();
+    qec->getQueryTreeCache().clearAll();
+    EXPECT_EQ(u.computeResultOnlyForTesting().idTable(), expected);
+    EXPECT_FALSE(computedInParallel(u));
+    qec->areWebsocketUpdatesEnabled_ = false;
+  }
+}
+
 // _____________________________________________________________________________
 TEST(Union, cheapMergeIfOrderNotImportant) {
   using Var = Variable;
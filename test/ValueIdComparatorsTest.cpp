@@ -356,3 +356,23 @@ TEST_F(ValueIdComparators, contractViolations) {
   // The third argument must be >= the second.
   ASSERT_ANY_THROW((compareWithEqualIds(I(3), I(25), I(12), Comparison::LE)));
 }
+
+// _______________________________________________________________________
+TEST_F(ValueIdComparators, lessByBitsWithoutLocalVocab) {
+  using namespace ad_utility::testing;
+  std::vector<Id> ids{UndefId(),     IntId(-3),    IntId(0),
+                      IntId(42),     DoubleId(-1), DoubleId(2.5),
+                      VocabId(0),    VocabId(17),  BlankNodeId(3),
+                      BoolId(false), BoolId(true)};
+  EXPECT_TRUE(containsNoLocalVocabIndex(ids));
+  LessByBitsWithoutLocalVocab lessByBits;
+  for (auto a : ids) {
+    for (auto b : ids) {
+      EXPECT_EQ(lessByBits(a, b), a < b) << a << ' ' << b;
+    }
+  }
+
+  ids.push_back(LocalVocabId(4));
+  EXPECT_FALSE(containsNoLocalVocabIndex(ids));
+  EXPECT_TRUE(containsNoLocalVocabIndex(std::vector<Id>{}));
+}
@@ -14,6 +14,7 @@
 #include "engine/idTable/IdTable.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using TC = TripleComponent;
 using ValuesComponents = std::vector<std::vector<TripleComponent>>;
@@ -85,6 +86,69 @@ TEST(Values, computeResult) {
                 {{I(12), x}, {U, Id::makeFromLocalVocabIndex(l.value())}}));
 }
 
+// Check that VALUES clauses with at least `values-sort-min-num-rows` rows are
+// sorted on all their columns.
+TEST(Values, sortedResult) {
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::valuesSortMinNumRows_>(3);
+  auto testQec = ad_utility::testing::getQec("<x> <x> <x> .");
+  auto I = ad_utility::testing::IntId;
+  std::vector<Variable> variables{Variable{"?x"}, Variable{"?y"}};
+
+  Values small(testQec, {variables, {{TC{3}, TC{1}}, {TC{1}, TC{2}}}});
+  EXPECT_TRUE(small.resultSortedOn().empty());
+  EXPECT_EQ(small.getResult()->idTable(),
+            makeIdTableFromVector({{I(3), I(1)}, {I(1), I(2)}}));
+
+  // Duplicates are kept (VALUES has bag semantics).
+  ValuesComponents values{{TC{3}, TC{1}},
+                          {TC{1}, TC{2}},
+                          {TC{3}, TC{0}},
+                          {TC{1}, TC{2}}};
+  Values large(testQec, {variables, values});
+  EXPECT_THAT(large.resultSortedOn(), ::testing::ElementsAre(0, 1));
+  auto result = large.getResult();
+  EXPECT_EQ(result->idTable(),
+            makeIdTableFromVector(
+                {{I(1), I(2)}, {I(1), I(2)}, {I(3), I(0)}, {I(3), I(1)}}));
+  EXPECT_THAT(result->sortedBy(), ::testing::ElementsAre(0, 1));
+  EXPECT_THAT(large.getCacheKey(), ::testing::HasSubstr("SORTED"));
+  EXPECT_THAT(small.getCacheKey(),
+              ::testing::Not(::testing::HasSubstr("SORTED")));
+}
+
+// Check that the values of a VALUES clause that is large enough to be looked up
+// in parallel are converted correctly, and that equal values that are not
+// contained in the vocabulary get the same local vocab `Id`.
+TEST(Values, parallelLookup) {
+  auto noSort = setRuntimeParameterForTest<
+      &RuntimeParameters::valuesSortMinNumRows_>(
+      std::numeric_limits<size_t>::max());
+  auto testQec = ad_utility::testing::getQec("<x> <x> <x> .");
+  const size_t numRows = 4 * Values::minNumRowsPerThread_ + 17;
+  ValuesComponents values;
+  for (size_t i = 0; i < numRows; ++i) {
+    values.push_back({TC{static_cast<int64_t>(i)},
+                      TC{iri(i % 2 == 0 ? "<x>" : "<y>")},
+                      TC{iri(absl::StrCat("<z", i % 3, ">"))}});
+  }
+  Values valuesOperation(
+      testQec, {{Variable{"?i"}, Variable{"?a"}, Variable{"?b"}}, values});
+  auto result = valuesOperation.getResult();
+  const auto& table = result->idTable();
+  ASSERT_EQ(table.numRows(), numRows);
+  // `<y>`, `<z0>`, `<z1>` and `<z2>`.
+  EXPECT_EQ(result->localVocab().size(), 4u);
+  Id x = ad_utility::testing::makeGetId(testQec->getIndex())("<x>");
+  for (size_t i = 0; i < numRows; ++i) {
+    EXPECT_EQ(table(i, 0), ad_utility::testing::IntId(i));
+    EXPECT_EQ(table(i, 1), i % 2 == 0 ? x : table(1, 1));
+    EXPECT_EQ(table(i, 2), table(i % 3, 2));
+  }
+  EXPECT_EQ(table(1, 1).getDatatype(), Datatype::LocalVocabIndex);
+  EXPECT_NE(table(0, 2), table(1, 2));
+}
+
 // Check that if the number of variables and the number of values in each row
 // are not all equal, an exception is thrown.
 TEST(Values, illegalInput) {
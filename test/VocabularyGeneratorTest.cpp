@@ -268,6 +268,78 @@ TEST(MergeVocabulary, mergeVocabularyAssertion) {
       ::testing::HasSubstr("vocabulary order violated"), ad_utility::Exception);
 }
 
+// _____________________________________________________________________________
+TEST(MergeVocabulary, largeBatchesAreProcessedInParallel) {
+  // Enough words s.t. the order check and the writing of the ID maps are
+  // split between several threads.
+  constexpr size_t numWords = 2 * BATCH_SIZE_VOCABULARY_MERGING_OUTPUT + 17;
+  constexpr size_t numFiles = 3;
+  std::string basePath = "MergeVocabulary.largeBatchesAreProcessedInParallel";
+  auto word = [](size_t i) { return absl::StrFormat("\"w%09d\"", i); };
+
+  // File `f` contains the words with index `i % numFiles == f` and all words
+  // with `i % 10 == 0`, the latter occur in multiple files.
+  auto wordsOfFile = [&](size_t f) {
+    std::vector<size_t> words;
+    for (size_t i = 0; i < numWords; ++i) {
+      if (i % numFiles == f || i % 10 == 0) {
+        words.push_back(i);
+      }
+    }
+    return words;
+  };
+  auto writeFile = [&](size_t f, const std::vector<size_t>& words) {
+    ad_utility::serialization::FileWriteSerializer partialVocab(
+        absl::StrCat(basePath, PARTIAL_VOCAB_WORDS_INFIX, f));
+    partialVocab << words.size();
+    for (size_t localIdx = 0; localIdx < words.size(); ++localIdx) {
+      partialVocab << word(words[localIdx]);
+      partialVocab << false;
+      partialVocab << localIdx;
+    }
+  };
+  auto lessThan = [](std::string_view a, bool, std::string_view b, bool) {
+    return std::less{}(a, b);
+  };
+
+  for (size_t f = 0; f < numFiles; ++f) {
+    writeFile(f, wordsOfFile(f));
+  }
+  std::vector<std::string> mergedWords;
+  auto callback = [&mergedWords](const auto& w, bool) {
+    mergedWords.emplace_back(w);
+    return uint64_t{mergedWords.size() - 1};
+  };
+  mergeVocabulary(basePath, numFiles, lessThan, callback, 1_GB);
+  ASSERT_EQ(mergedWords.size(), numWords);
+  EXPECT_EQ(mergedWords.front(), word(0));
+  EXPECT_EQ(mergedWords.back(), word(numWords - 1));
+  for (size_t f = 0; f < numFiles; ++f) {
+    auto words = wordsOfFile(f);
+    std::vector<std::pair<Id, Id>> expected;
+    for (size_t localIdx = 0; localIdx < words.size(); ++localIdx) {
+      expected.emplace_back(V(localIdx), V(words[localIdx]));
+    }
+    EXPECT_EQ(getIdMapFromFile(
+                  absl::StrCat(basePath, PARTIAL_VOCAB_IDMAP_INFIX, f)),
+              expected);
+  }
+
+  // A violation of the order in the middle of one of the files is found.
+  auto words = wordsOfFile(1);
+  std::swap(words[words.size() / 2], words[words.size() / 2 + 1]);
+  writeFile(1, words);
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      mergeVocabulary(basePath, numFiles, lessThan, callback, 1_GB),
+      ::testing::HasSubstr("vocabulary order violated"), ad_utility::Exception);
+
+  for (size_t f = 0; f < numFiles; ++f) {
+    for (auto infix : {PARTIAL_VOCAB_WORDS_INFIX, PARTIAL_VOCAB_IDMAP_INFIX}) {
+      ad_utility::deleteFile(absl::StrCat(basePath, infix, f));
+    }
+  }
+}
+
 TEST(VocabularyGeneratorTest, createInternalMapping) {
   ItemVec input;
   using S = PartialVocabIndexWithExternalFlag;
@@ -0,0 +1,108 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <tuple>
+
+#include "index/VocabularyNgramIndex.h"
+#include "util/File.h"
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+namespace {
+// The vocabulary index, the content, and whether the literal has a datatype.
+using Literals = std::vector<std::tuple<uint64_t, std::string, bool>>;
+
+// Build the index for the `literals` and write it to the `filename`.
+void buildIndex(const Literals& literals, const std::string& filename) {
+  auto forEachLiteral =
+      [&literals](const VocabularyNgramIndex::LiteralCallback& callback) {
+        for (const auto& [index, content, hasDatatype] : literals) {
+          callback(index, content, hasDatatype);
+        }
+      };
+  VocabularyNgramIndex::build(forEachLiteral, filename);
+}
+
+// Delete the files of the index with the `filename`.
+void deleteIndex(const std::string& filename) {
+  ad_utility::deleteFile(filename);
+  ad_utility::deleteFile(filename + ".postings");
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(VocabularyNgramIndex, getDistinctNgrams) {
+  using N = VocabularyNgramIndex;
+  EXPECT_THAT(N::getDistinctNgrams(""), IsEmpty());
+  EXPECT_THAT(N::getDistinctNgrams("ab"), IsEmpty());
+  EXPECT_THAT(N::getDistinctNgrams("abc"), ElementsAre(0x616263));
+  // Duplicates are removed, and the result is sorted.
+  EXPECT_THAT(N::getDistinctNgrams("cabcab"),
+              ElementsAre(0x616263, 0x626361, 0x636162));
+  // Non-ASCII bytes are not sign-extended.
+  EXPECT_THAT(N::getDistinctNgrams("\xc3\xa4x"), ElementsAre(0xc3a478));
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyNgramIndex, getCandidates) {
+  const std::string filename = "vocabularyNgramIndexTest.ngrams";
+  buildIndex({{3, "berlin", false},
+              {4, "Berliner Mauer", false},
+              {7, "east berlin", false},
+              {8, "paris", false},
+              {9, "12", true},
+              {10, "berlin", true}},
+             filename);
+  VocabularyNgramIndex index;
+  index.setFilename(filename);
+  EXPECT_THAT(*index.getCandidates("berlin"), ElementsAre(3, 7, 10));
+  EXPECT_THAT(*index.getCandidates("erlin"), ElementsAre(3, 4, 7, 10));
+  EXPECT_THAT(*index.getCandidates("ari"), ElementsAre(8));
+  EXPECT_THAT(*index.getCandidates("erliner"), ElementsAre(4));
+  // "linerl" is no substring of any literal, but all of its trigrams are
+  // contained in "Berliner Mauer", so this candidate has to be verified.
+  EXPECT_THAT(*index.getCandidates("linerl"), ElementsAre(4));
+  EXPECT_THAT(*index.getCandidates("london"), IsEmpty());
+  EXPECT_THAT(*index.getCandidates("lin Mauer"), IsEmpty());
+
+  // Substrings that are too short can't rule out any literal.
+  EXPECT_EQ(index.getCandidates("be"), nullptr);
+  EXPECT_EQ(index.getCandidates(""), nullptr);
+
+  // The results are cached.
+  EXPECT_EQ(index.getCandidates("berlin"), index.getCandidates("berlin"));
+
+  EXPECT_TRUE(index.hasDatatype(9));
+  EXPECT_TRUE(index.hasDatatype(10));
+  EXPECT_FALSE(index.hasDatatype(3));
+  EXPECT_FALSE(index.hasDatatype(11));
+  deleteIndex(filename);
+
+  // An empty vocabulary.
+  buildIndex({}, filename);
+  VocabularyNgramIndex empty;
+  empty.setFilename(filename);
+  EXPECT_THAT(*empty.getCandidates("abc"), IsEmpty());
+  EXPECT_FALSE(empty.hasDatatype(0));
+  deleteIndex(filename);
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyNgramIndex, notAvailable) {
+  // Without a filename or without the file, there are no candidates.
+  VocabularyNgramIndex withoutFilename;
+  EXPECT_EQ(withoutFilename.getCandidates("berlin"), nullptr);
+  VocabularyNgramIndex withoutFile;
+  withoutFile.setFilename("vocabularyNgramIndexTestDoesNotExist.ngrams");
+  EXPECT_EQ(withoutFile.getCandidates("berlin"), nullptr);
+}
@@ -4,6 +4,9 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
+#include "util/CompressionUsingZstd/ZstdDictionary.h"
 #include "util/CompressionUsingZstd/ZstdWrapper.h"
 
 // _____________________________________________________________________________
@@ -26,3 +29,63 @@ TEST(CompressionTest, DecompressToBuffer) {
   ASSERT_EQ(x, decomp);
   ASSERT_EQ(4ul * sizeof(int), numBytesDecompressed);
 }
+
+// _____________________________________________________________________________
+TEST(CompressionTest, Dictionary) {
+  // Many small and similar samples.
+  std::vector<std::vector<char>> samples;
+  for (int i = 0; i < 200; ++i) {
+    std::string sample = "<http://example.org/subject/" + std::to_string(i) +
+                         "> <http://example.org/predicate>";
+    samples.emplace_back(sample.begin(), sample.end());
+  }
+  auto dictionary = ZstdDictionary::train(samples, 1024);
+  ASSERT_TRUE(dictionary.has_value());
+  EXPECT_LE(dictionary->bytes().size(), 1024u);
+
+  // Round trip, also with a dictionary that was restored from its bytes.
+  ZstdDictionary restored{dictionary->bytes()};
+  const auto& input = samples.at(42);
+  auto compressed = dictionary->compress(input.data(), input.size());
+  EXPECT_LT(compressed.size(),
+            ZstdWrapper::compress(input.data(), input.size()).size());
+  for (const auto* dict : {&dictionary.value(), &restored}) {
+    std::vector<char> decompressed(input.size());
+    auto numBytes =
+        dict->decompressToBuffer(compressed.data(), compressed.size(),
+                                 decompressed.data(), decompressed.size());
+    EXPECT_EQ(numBytes, input.size());
+    EXPECT_EQ(decompressed, input);
+  }
+
+  // Too few samples for training.
+  EXPECT_FALSE(ZstdDictionary::train({samples.at(0)}, 1024).has_value());
+
+  // Corrupt input.
+  std::vector<char> buffer(100);
+  EXPECT_ANY_THROW(dictionary->decompressToBuffer(
+      input.data(), input.size(), buffer.data(), buffer.size()));
+}
+
+// _____________________________________________________________________________
+TEST(CompressionTest, ContextsAreReusedPerThread) {
+  EXPECT_EQ(ZstdWrapper::compressionContext(),
+            ZstdWrapper::compressionContext());
+  EXPECT_EQ(ZstdWrapper::decompressionContext(),
+            ZstdWrapper::decompressionContext());
+  // Many round trips with different inputs and compression levels on the same
+  // contexts.
+  for (int i = 0; i < 50; ++i) {
+    std::vector<int> x(i * 10, i);
+    auto comp = ZstdWrapper::compress(x.data(), x.size() * sizeof(int), i % 5);
+    auto decomp =
+        ZstdWrapper::decompress<int>(comp.data(), comp.size(), x.size());
+    ASSERT_EQ(x, decomp);
+  }
+  // Another thread has its own contexts.
+  ZSTD_DCtx* otherContext = nullptr;
+  std::thread{[&otherContext]() {
+    otherContext = ZstdWrapper::decompressionContext();
+  }}.join();
+  EXPECT_NE(otherContext, ZstdWrapper::decompressionContext());
+}
@@ -0,0 +1,67 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "backports/atomic_shared_ptr.h"
+
+namespace {
+// Run the same tests for the backport and for the type that is actually used
+// (which might be the standard specialization).
+template <typename T>
+class AtomicSharedPtrTest : public ::testing::Test {};
+using Implementations =
+    ::testing::Types<ql::backports::atomic_shared_ptr<const int>,
+                     ql::atomic_shared_ptr<const int>>;
+TYPED_TEST_SUITE(AtomicSharedPtrTest, Implementations);
+}  // namespace
+
+// _____________________________________________________________________________
+TYPED_TEST(AtomicSharedPtrTest, LoadStoreExchange) {
+  TypeParam ptr{std::make_shared<const int>(42)};
+  auto loaded = ptr.load();
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(*loaded, 42);
+
+  ptr.store(std::make_shared<const int>(43));
+  EXPECT_EQ(*ptr.load(), 43);
+  // The previously loaded value remains valid.
+  EXPECT_EQ(*loaded, 42);
+
+  auto previous = ptr.exchange(std::make_shared<const int>(44));
+  EXPECT_EQ(*previous, 43);
+  EXPECT_EQ(*ptr.load(), 44);
+  EXPECT_EQ(previous.use_count(), 1);
+}
+
+// _____________________________________________________________________________
+TYPED_TEST(AtomicSharedPtrTest, ConcurrentLoadAndStore) {
+  TypeParam ptr{std::make_shared<const int>(0)};
+  static constexpr int numStores = 1000;
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i < 4; ++i) {
+    readers.emplace_back([&ptr]() {
+      int last = 0;
+      while (last < numStores) {
+        auto value = ptr.load();
+        // The values are published in ascending order.
+        EXPECT_GE(*value, last);
+        last = *value;
+      }
+    });
+  }
+  for (int i = 1; i <= numStores; ++i) {
+    ptr.store(std::make_shared<const int>(i));
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(*ptr.load(), numStores);
+}
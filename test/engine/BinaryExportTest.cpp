@@ -0,0 +1,241 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "engine/BinaryExport.h"
+
+using namespace qlever::binary_export;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+namespace {
+auto I = ad_utility::testing::IntId;
+auto D = ad_utility::testing::DoubleId;
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(BinaryExport, roundTrip) {
+  auto* qec = ad_utility::testing::getQec("<a> <b> <c> .");
+  const auto& index = qec->getIndex();
+  auto getId = ad_utility::testing::makeGetId(index);
+  LocalVocabEntry localWord =
+      LocalVocabEntry::fromStringRepresentation("\"abc\"@en", index);
+  Id local = Id::makeFromLocalVocabIndex(&localWord);
+  Id blankNode = Id::makeFromBlankNodeIndex(BlankNodeIndex::make(17));
+  auto table = makeIdTableFromVector(
+      {{getId("<a>"), I(3), local}, {D(1.5), blankNode, getId("<a>")}});
+
+  IncrementalStringMapping dictionary;
+  std::string stream = makeHeader({"x", "y", "z"});
+  stream += makeBatch(dictionary, index, table, {0, std::nullopt, 2}, 0, 2);
+  stream += makeBatch(dictionary, index, table, {1, 0, 1}, 1, 2);
+  stream += makeEndMarker();
+
+  // Feed the stream byte by byte to test the handling of incomplete parts.
+  StreamParser parser;
+  std::vector<Batch> batches;
+  for (char c : stream) {
+    EXPECT_FALSE(parser.isFinished());
+    parser.addBytes(std::string_view{&c, 1});
+    while (auto batch = parser.nextBatch()) {
+      batches.push_back(std::move(batch).value());
+    }
+  }
+  EXPECT_TRUE(parser.isFinished());
+  EXPECT_FALSE(parser.nextBatch().has_value());
+  ASSERT_TRUE(parser.columnNames().has_value());
+  EXPECT_THAT(parser.columnNames().value(), ElementsAre("x", "y", "z"));
+  ASSERT_EQ(batches.size(), 2);
+
+  // The strings of a batch are deduplicated, the trivial IDs and the blank
+  // nodes are transferred as is.
+  const auto& first = batches.at(0);
+  EXPECT_EQ(first.numRows_, 2);
+  EXPECT_FALSE(first.clearsDictionary_);
+  EXPECT_THAT(first.strings_, ElementsAre("<a>", "\"abc\"@en"));
+  EXPECT_EQ(stringIndex(first(0, 0)), 0);
+  EXPECT_EQ(first(1, 0), D(1.5));
+  EXPECT_TRUE(first(0, 1).isUndefined());
+  EXPECT_TRUE(first(1, 1).isUndefined());
+  EXPECT_EQ(stringIndex(first(0, 2)), 1);
+  EXPECT_EQ(stringIndex(first(1, 2)), 0);
+
+  const auto& second = batches.at(1);
+  EXPECT_EQ(second.numRows_, 1);
+  EXPECT_TRUE(second.strings_.empty());
+  EXPECT_EQ(second(0, 0).getBits(), blankNode.getBits());
+  EXPECT_EQ(second(0, 1), D(1.5));
+  EXPECT_EQ(second(0, 2).getBits(), blankNode.getBits());
+}
+
+// _____________________________________________________________________________
+TEST(BinaryExport, malformedStreams) {
+  auto* qec = ad_utility::testing::getQec("<a> <b> <c> .");
+  const auto& index = qec->getIndex();
+
+  auto parseAll = [](std::string_view stream) {
+    StreamParser parser;
+    parser.addBytes(stream);
+    while (parser.nextBatch().has_value()) {
+    }
+    return parser;
+  };
+
+  AD_EXPECT_THROW_WITH_MESSAGE(parseAll("SPARQL JSON"),
+                               HasSubstr("expected magic bytes"));
+
+  auto header = makeHeader({"x"});
+  auto complete = header + makeEndMarker();
+  EXPECT_TRUE(parseAll(complete).isFinished());
+  AD_EXPECT_THROW_WITH_MESSAGE(parseAll(complete + "x"),
+                               HasSubstr("after the end marker"));
+  StreamParser finished = parseAll(complete);
+  AD_EXPECT_THROW_WITH_MESSAGE(finished.addBytes("x"),
+                               HasSubstr("after the end marker"));
+
+  // A stream without the end marker is incomplete.
+  auto table = makeIdTableFromVector({{I(1)}});
+  IncrementalStringMapping dictionary;
+  auto withBatch = header + makeBatch(dictionary, index, table, {0}, 0, 1);
+  StreamParser incomplete = parseAll(withBatch);
+  EXPECT_FALSE(incomplete.isFinished());
+
+  // A batch with an ID that refers to a missing string.
+  auto invalid = makeIdTableFromVector({{Id::makeFromVocabIndex(
+      VocabIndex::make(0))}});
+  IncrementalStringMapping newDictionary;
+  auto batch = makeBatch(newDictionary, index, invalid, {0}, 0, 1);
+  // Remove the single string from the batch and set the number of strings to
+  // zero.
+  std::string withoutString = batch.substr(0, 16) + std::string(8, '\0') +
+                              batch.substr(batch.size() - 8);
+  AD_EXPECT_THROW_WITH_MESSAGE(parseAll(header + withoutString),
+                               HasSubstr("string that doesn't exist"));
+  // After the original batch, the string is contained in the dictionary.
+  EXPECT_NO_THROW(parseAll(header + batch + withoutString));
+
+  // An invalid flag for clearing the dictionary.
+  std::string invalidFlag =
+      batch.substr(0, 8) + std::string(1, '\x02') + batch.substr(9);
+  AD_EXPECT_THROW_WITH_MESSAGE(parseAll(header + invalidFlag),
+                               HasSubstr("neither 0 nor 1"));
+}
+
+// _____________________________________________________________________________
+TEST(BinaryExport, incrementalDictionary) {
+  auto* qec = ad_utility::testing::getQec("<a> <b> <c> .");
+  const auto& index = qec->getIndex();
+  auto getId = ad_utility::testing::makeGetId(index);
+  auto table = makeIdTableFromVector(
+      {{getId("<a>")}, {getId("<b>")}, {getId("<a>")}, {getId("<c>")}});
+
+  // Parse the `stream` and resolve the IDs of its single column to strings,
+  // like a receiver that only keeps the dictionary.
+  auto decode = [](std::string_view stream) {
+    StreamParser parser;
+    parser.addBytes(stream);
+    std::vector<std::string> dictionary;
+    std::vector<std::string> values;
+    std::vector<size_t> numNewStrings;
+    std::vector<bool> clearsDictionary;
+    while (auto batch = parser.nextBatch()) {
+      if (batch->clearsDictionary_) {
+        dictionary.clear();
+      }
+      numNewStrings.push_back(batch->strings_.size());
+      clearsDictionary.push_back(batch->clearsDictionary_);
+      ql::ranges::copy(batch->strings_, std::back_inserter(dictionary));
+      for (size_t row = 0; row < batch->numRows_; ++row) {
+        values.push_back(dictionary.at(stringIndex((*batch)(row, 0))));
+      }
+    }
+    EXPECT_TRUE(parser.isFinished());
+    return std::tuple{values, numNewStrings, clearsDictionary};
+  };
+
+  auto makeStream = [&](IncrementalStringMapping dictionary) {
+    std::string stream = makeHeader({"x"});
+    for (size_t row = 0; row < table.numRows(); ++row) {
+      stream += makeBatch(dictionary, index, table, {0}, row, row + 1);
+    }
+    return stream + makeEndMarker();
+  };
+
+  // Each string is only transferred once.
+  auto [values, numNewStrings, clearsDictionary] =
+      decode(makeStream(IncrementalStringMapping{}));
+  EXPECT_THAT(values, ElementsAre("<a>", "<b>", "<a>", "<c>"));
+  EXPECT_THAT(numNewStrings, ElementsAre(1, 1, 0, 1));
+  EXPECT_THAT(clearsDictionary, ElementsAre(false, false, false, false));
+
+  // With a tiny dictionary, it is cleared before each batch after the first.
+  using namespace ad_utility::memory_literals;
+  std::tie(values, numNewStrings, clearsDictionary) =
+      decode(makeStream(IncrementalStringMapping{1_B}));
+  EXPECT_THAT(values, ElementsAre("<a>", "<b>", "<a>", "<c>"));
+  EXPECT_THAT(numNewStrings, ElementsAre(1, 1, 1, 1));
+  EXPECT_THAT(clearsDictionary, ElementsAre(false, true, true, true));
+}
+
+// _____________________________________________________________________________
+TEST(BinaryExport, vocabIdsAsIs) {
+  auto* qec = ad_utility::testing::getQec("<a> <b> <c> .");
+  const auto& index = qec->getIndex();
+  auto getId = ad_utility::testing::makeGetId(index);
+  LocalVocabEntry localWord =
+      LocalVocabEntry::fromStringRepresentation("<local>", index);
+  Id local = Id::makeFromLocalVocabIndex(&localWord);
+  auto table = makeIdTableFromVector({{getId("<a>"), local}});
+
+  auto parse = [](std::string_view stream) {
+    StreamParser parser;
+    parser.addBytes(stream);
+    auto batch = parser.nextBatch();
+    EXPECT_TRUE(batch.has_value());
+    EXPECT_FALSE(parser.nextBatch().has_value());
+    EXPECT_TRUE(parser.isFinished());
+    return std::pair{parser.transfersVocabIds(), std::move(batch).value()};
+  };
+
+  // Only the local vocab entries are transferred as strings.
+  IncrementalStringMapping dictionary;
+  auto [transfersVocabIds, batch] =
+      parse(makeHeader({"x", "y"}, true) +
+            makeBatch(dictionary, index, table, {0, 1}, 0, 1, true) +
+            makeEndMarker());
+  EXPECT_TRUE(transfersVocabIds);
+  EXPECT_THAT(batch.strings_, ElementsAre("<local>"));
+  EXPECT_EQ(batch(0, 0), getId("<a>"));
+  EXPECT_EQ(stringIndex(batch(0, 1)), 0);
+
+  // Without the flag, the IDs of the vocabulary are resolved.
+  IncrementalStringMapping otherDictionary;
+  std::tie(transfersVocabIds, batch) =
+      parse(makeHeader({"x", "y"}) +
+            makeBatch(otherDictionary, index, table, {0, 1}, 0, 1) +
+            makeEndMarker());
+  EXPECT_FALSE(transfersVocabIds);
+  EXPECT_THAT(batch.strings_, ElementsAre("<a>", "<local>"));
+
+  // The IDs of the vocabulary are only valid if the header says so.
+  IncrementalStringMapping thirdDictionary;
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      parse(makeHeader({"x"}) +
+            makeBatch(thirdDictionary, index, table, {0}, 0, 1, true)),
+      HasSubstr("can't be exchanged"));
+
+  // An invalid flag in the header.
+  std::string header = makeHeader({"x"});
+  header[MAGIC.size()] = '\x02';
+  StreamParser parser;
+  parser.addBytes(header);
+  AD_EXPECT_THROW_WITH_MESSAGE(parser.nextBatch(), HasSubstr("neither 0 nor 1"));
+}
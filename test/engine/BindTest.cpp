@@ -7,6 +7,7 @@
 #include "../util/IdTableHelpers.h"
 #include "../util/IndexTestHelpers.h"
 #include "../util/OperationTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
 #include "./ValuesForTesting.h"
 #include "engine/Bind.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
@@ -134,6 +135,60 @@ TEST(
   }
 }
 
+// _____________________________________________________________________________
+TEST(Bind, parallelEvaluationOfMaterializedInput) {
+  auto* qec = ad_utility::testing::getQec();
+  auto numThreads =
+      setRuntimeParameterForTest<&RuntimeParameters::expressionNumThreads_>(4);
+  auto minRows = setRuntimeParameterForTest<
+      &RuntimeParameters::expressionMinRowsPerThread_>(3);
+  auto I = ad_utility::testing::IntId;
+  std::vector<std::vector<IntOrId>> input;
+  std::vector<std::vector<IntOrId>> expected;
+  for (int64_t i = 0; i < 14; ++i) {
+    input.push_back({i});
+    expected.push_back({i, i + 1});
+  }
+
+  auto valuesTree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector(input), Vars{Variable{"?a"}});
+  Bind plusOne{
+      qec,
+      valuesTree,
+      {SparqlExpressionPimpl{
+           makeAddExpression(
+               std::make_unique<VariableExpression>(Variable{"?a"}),
+               std::make_unique<IdExpression>(I(1))),
+           "?a + 1 as ?b"},
+       Variable{"?b"}}};
+  qec->getQueryTreeCache().clearAll();
+  auto result = plusOne.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+  ASSERT_TRUE(result->isFullyMaterialized());
+  EXPECT_EQ(result->idTable(), makeIdTableFromVector(expected));
+
+  // The words that are added to the local vocabs of the chunks are part of the
+  // local vocab of the result.
+  Bind constant{
+      qec,
+      valuesTree,
+      {SparqlExpressionPimpl{
+           std::make_unique<StringLiteralExpression>(
+               TripleComponent::Literal::literalWithoutQuotes("notInVocab")),
+           "\"notInVocab\" as ?b"},
+       Variable{"?b"}}};
+  qec->getQueryTreeCache().clearAll();
+  result = constant.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+  const auto& table = result->idTable();
+  ASSERT_EQ(table.numRows(), 14u);
+  EXPECT_FALSE(result->localVocab().empty());
+  for (size_t i = 0; i < table.numRows(); ++i) {
+    EXPECT_EQ(table(i, 0), I(static_cast<int64_t>(i)));
+    ASSERT_EQ(table(i, 1).getDatatype(), Datatype::LocalVocabIndex);
+    EXPECT_EQ(table(i, 1).getLocalVocabIndex()->toStringRepresentation(),
+              "\"notInVocab\"");
+  }
+}
+
 // _____________________________________________________________________________
 TEST(Bind, clone) {
   auto* qec = ad_utility::testing::getQec();
@@ -0,0 +1,98 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+#include "engine/CacheWarmup.h"
+#include "util/Synchronized.h"
+
+using ::testing::ElementsAre;
+
+namespace {
+std::vector<std::string> read(std::string input, size_t maxNumQueries = 0) {
+  std::istringstream stream{std::move(input)};
+  return CacheWarmup::readQueries(stream, maxNumQueries);
+}
+
+// Wait until the `warmup` has finished.
+void waitUntilFinished(const CacheWarmup& warmup) {
+  while (!warmup.progress().finished_) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(CacheWarmup, readQueriesFromBlocks) {
+  EXPECT_THAT(read("SELECT * {\n?s ?p ?o }\n\n\nASK {}\n"),
+              ElementsAre("SELECT * {\n?s ?p ?o }", "ASK {}"));
+  // Repeated queries are kept at the position of their last occurrence.
+  EXPECT_THAT(read("a\n\nb\n\na\n\nc"), ElementsAre("b", "a", "c"));
+  // Only the last queries are kept.
+  EXPECT_THAT(read("a\n\nb\n\na\n\nc", 2), ElementsAre("a", "c"));
+  EXPECT_TRUE(read("").empty());
+  EXPECT_TRUE(read("\n  \n").empty());
+}
+
+// _____________________________________________________________________________
+TEST(CacheWarmup, readQueriesFromEventLog) {
+  std::string log =
+      "{\"event\": \"start\", \"query\": \"SELECT 1\"}\n"
+      "{\"event\": \"end\", \"query-id\": 3}\n"
+      "{\"event\": \"start\", \"query\": \"ASK {}\"}\n"
+      "\n"
+      "{\"event\": \"start\", \"query\": \"SELECT 1\"}\n"
+      "{\"event\": \"start\", \"quer";
+  EXPECT_THAT(read(log), ElementsAre("ASK {}", "SELECT 1"));
+  EXPECT_THAT(read(log, 1), ElementsAre("SELECT 1"));
+}
+
+// _____________________________________________________________________________
+TEST(CacheWarmup, replayQueries) {
+  ad_utility::Synchronized<std::vector<std::string>> executed;
+  std::atomic<bool> idle = false;
+  CacheWarmup warmup{{"a", "fail", "b"},
+                     [&executed](const std::string& query) {
+                       if (query == "fail") {
+                         throw std::runtime_error{"failed"};
+                       }
+                       executed.wlock()->push_back(query);
+                     },
+                     [&idle]() { return idle.load(); }};
+  // Nothing is executed while the server is busy.
+  std::this_thread::sleep_for(2 * CacheWarmup::idlePollInterval_);
+  EXPECT_TRUE(executed.rlock()->empty());
+  EXPECT_EQ(warmup.progress().numDone_, 0);
+  EXPECT_FALSE(warmup.progress().finished_);
+
+  idle = true;
+  waitUntilFinished(warmup);
+  EXPECT_THAT(*executed.rlock(), ElementsAre("a", "b"));
+  auto progress = warmup.progress();
+  EXPECT_EQ(progress.numQueries_, 3);
+  EXPECT_EQ(progress.numDone_, 3);
+  EXPECT_EQ(progress.numFailed_, 1);
+  nlohmann::json json = progress;
+  EXPECT_EQ(json["num-failed"], 1);
+  EXPECT_EQ(json["finished"], true);
+}
+
+// _____________________________________________________________________________
+TEST(CacheWarmup, stopInDestructor) {
+  std::atomic<size_t> numExecuted = 0;
+  {
+    CacheWarmup warmup{{"a", "b"}, [&](const std::string&) { ++numExecuted; },
+                       []() { return false; }};
+  }
+  EXPECT_EQ(numExecuted, 0);
+}
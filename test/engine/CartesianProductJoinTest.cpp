@@ -15,6 +15,7 @@
 #include "../util/IdTableHelpers.h"
 #include "../util/IndexTestHelpers.h"
 #include "../util/OperationTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
 #include "engine/CartesianProductJoin.h"
 #include "engine/QueryExecutionTree.h"
 
@@ -624,6 +625,66 @@ TEST(CartesianProductJoinLazy, lazyTableTurnsOutEmptyWithEmptyGenerator) {
   ASSERT_EQ(generator.begin(), generator.end());
 }
 
+// _____________________________________________________________________________
+TEST(CartesianProductJoinLazy, lazyInputIsNotConsumedBeyondLimit) {
+  auto* qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+  using Vars = std::vector<std::optional<Variable>>;
+  CartesianProductJoin::Children children;
+  children.push_back(ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{1}, {2}}), Vars{Variable{"?a"}}));
+  std::vector<IdTable> lazyInput;
+  lazyInput.push_back(makeIdTableFromVector({{10}, {11}}));
+  lazyInput.push_back(makeIdTableFromVector({{12}}));
+  lazyInput.push_back(makeIdTableFromVector({{13}}));
+  children.push_back(ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(lazyInput), Vars{Variable{"?b"}}));
+  // Only the child with the largest size estimate is consumed lazily.
+  auto lazyChild = children.back()->getRootOperation();
+  std::dynamic_pointer_cast<ValuesForTesting>(lazyChild)->sizeEstimate() = 100;
+  CartesianProductJoin join{qec, std::move(children)};
+  join.applyLimitOffset({4});
+
+  auto result = join.computeResultOnlyForTesting(true);
+  ASSERT_FALSE(result.isFullyMaterialized());
+  IdTable actual{2, makeAllocator()};
+  for (const auto& pair : result.idTables()) {
+    actual.insertAtEnd(pair.idTable_);
+  }
+  EXPECT_EQ(actual,
+            makeIdTableFromVector({{1, 10}, {2, 10}, {1, 11}, {2, 11}}));
+  // The LIMIT is reached after the first table of the lazy input, so the
+  // remaining tables are not requested.
+  EXPECT_EQ(lazyChild->runtimeInfo().numRows_, 2);
+}
+
+// _____________________________________________________________________________
+TEST(CartesianProductJoin, parallelWriting) {
+  // A product with 300 * 500 = 150'000 rows, which is written by more than one
+  // thread.
+  VectorTable left;
+  VectorTable right;
+  for (int64_t i = 0; i < 300; ++i) {
+    left.push_back({i});
+  }
+  for (int64_t i = 0; i < 500; ++i) {
+    right.push_back({i, -i});
+  }
+  auto compute = [&](size_t numThreads, LimitOffsetClause limitOffset) {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::cartesianProductNumThreads_>(numThreads);
+    auto join = makeJoin({left, right});
+    join.applyLimitOffset(limitOffset);
+    return join.computeResultOnlyForTesting().idTable().clone();
+  };
+  for (auto limitOffset :
+       {LimitOffsetClause{}, LimitOffsetClause{140'000, 0, 7'777}}) {
+    auto expected = compute(1, limitOffset);
+    EXPECT_EQ(expected.numRows(), limitOffset._limit.value_or(150'000));
+    EXPECT_EQ(compute(4, limitOffset), expected);
+  }
+}
+
 // _____________________________________________________________________________
 
 using ::testing::Range;
@@ -0,0 +1,173 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/IndexTestHelpers.h"
+#include "engine/CostFactorCalibration.h"
+#include "engine/QueryPlanner.h"
+#include "parser/SparqlParser.h"
+#include "util/File.h"
+
+namespace {
+using Sample = CostFactorCalibration::JoinSample;
+using std::chrono::microseconds;
+
+// Record `n` joins with 1000 rows on each side and in the result, which take
+// `joinTime` each, and `n` hash joins with 100 build rows, 1000 probe rows,
+// and 1000 result rows, which take `hashJoinTime` each. The size estimates
+// are `sizeEstimate` with a correction factor of 0.5.
+void recordSamples(CostFactorCalibration& calibration, size_t n,
+                   microseconds joinTime, microseconds hashJoinTime,
+                   size_t sizeEstimate = 500) {
+  for (size_t i = 0; i < n; ++i) {
+    calibration.recordJoin(
+        Sample{false, joinTime, 1000, 1000, 1000, sizeEstimate, 0.5});
+    calibration.recordJoin(
+        Sample{true, hashJoinTime, 100, 1000, 1000, sizeEstimate, 0.5});
+  }
+}
+
+// The sum of the numbers of samples of all the operations in the `json` of
+// `CostFactorCalibration::toJson`.
+double totalNumSamples(const nlohmann::json& json) {
+  double result = 0;
+  for (const auto& [kind, operation] : json.at("operations").items()) {
+    result += operation.at("num-samples").get<double>();
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(CostFactorCalibration, fitHashJoinCosts) {
+  CostFactorCalibration calibration;
+  // Too few samples, nothing is fitted.
+  recordSamples(calibration, 5, microseconds{3000}, microseconds{5800});
+  EXPECT_TRUE(calibration.fittedCostFactors().empty());
+
+  // One microsecond per row of a join. With the default costs (4 per build
+  // row and 2 per probe row), the hash join has a cost of 2400 plus 1000 for
+  // the result, so twice the time means twice the costs per row.
+  recordSamples(calibration, 30, microseconds{3000}, microseconds{5800});
+  ad_utility::HashMap<std::string, double> factors;
+  for (const auto& [key, value] : calibration.fittedCostFactors()) {
+    factors[key] = value;
+  }
+  ASSERT_TRUE(factors.contains("HASH_JOIN_BUILD_COST_PER_ROW"));
+  ASSERT_TRUE(factors.contains("HASH_JOIN_PROBE_COST_PER_ROW"));
+  EXPECT_NEAR(factors["HASH_JOIN_BUILD_COST_PER_ROW"], 8.0, 1e-6);
+  EXPECT_NEAR(factors["HASH_JOIN_PROBE_COST_PER_ROW"], 4.0, 1e-6);
+  // The actual size (1000) is the uncorrected estimate (500 / 0.5).
+  EXPECT_NEAR(factors["JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR"], 1.0, 1e-6);
+
+  // The cost factors are applied, the others are kept.
+  QueryPlanningCostFactors costFactors;
+  auto filterPunish = costFactors.getCostFactor("FILTER_PUNISH");
+  calibration.applyTo(costFactors);
+  EXPECT_NEAR(costFactors.getCostFactor("HASH_JOIN_BUILD_COST_PER_ROW"), 8.0,
+              1e-6);
+  EXPECT_NEAR(costFactors.getCostFactor("HASH_JOIN_PROBE_COST_PER_ROW"), 4.0,
+              1e-6);
+  EXPECT_EQ(costFactors.getCostFactor("FILTER_PUNISH"), filterPunish);
+
+  calibration.clear();
+  EXPECT_TRUE(calibration.fittedCostFactors().empty());
+}
+
+// _____________________________________________________________________________
+TEST(CostFactorCalibration, fittedFactorsAreClamped) {
+  auto fitted = [](microseconds hashJoinTime, size_t sizeEstimate) {
+    CostFactorCalibration calibration;
+    recordSamples(calibration, 30, microseconds{3000}, hashJoinTime,
+                  sizeEstimate);
+    ad_utility::HashMap<std::string, double> factors;
+    for (const auto& [key, value] : calibration.fittedCostFactors()) {
+      factors[key] = value;
+    }
+    return factors;
+  };
+  // A very slow hash join, and a very small size estimate.
+  auto factors = fitted(microseconds{1'000'000'000}, 1);
+  EXPECT_NEAR(factors["HASH_JOIN_BUILD_COST_PER_ROW"], 40.0, 1e-6);
+  EXPECT_NEAR(factors["HASH_JOIN_PROBE_COST_PER_ROW"], 20.0, 1e-6);
+  EXPECT_NEAR(factors["JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR"], 2.0, 1e-6);
+  // A hash join that is faster than its result, and a very large estimate.
+  factors = fitted(microseconds{1}, 1'000'000'000);
+  EXPECT_NEAR(factors["HASH_JOIN_BUILD_COST_PER_ROW"], 0.4, 1e-6);
+  EXPECT_NEAR(factors["HASH_JOIN_PROBE_COST_PER_ROW"], 0.2, 1e-6);
+  EXPECT_NEAR(factors["JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR"], 0.1, 1e-6);
+}
+
+// _____________________________________________________________________________
+TEST(CostFactorCalibration, persistence) {
+  std::string filename = "costFactorCalibrationTest.json";
+  ad_utility::deleteFile(filename, false);
+  {
+    CostFactorCalibration calibration;
+    calibration.setPersistenceFile(filename);
+    recordSamples(calibration, 30, microseconds{3000}, microseconds{5800});
+    calibration.recordOperation("IndexScan", microseconds{100}, 50, 10, 20);
+    calibration.persist();
+  }
+  CostFactorCalibration calibration;
+  EXPECT_TRUE(calibration.fittedCostFactors().empty());
+  calibration.setPersistenceFile(filename);
+  EXPECT_EQ(calibration.fittedCostFactors().size(), 3);
+  auto json = calibration.toJson();
+  const auto& scan = json.at("operations").at("IndexScan");
+  EXPECT_DOUBLE_EQ(scan.at("num-samples").get<double>(), 1.0);
+  EXPECT_DOUBLE_EQ(scan.at("time-per-cost-unit-us").get<double>(), 2.0);
+  EXPECT_NEAR(scan.at("mean-actual-to-estimated-size").get<double>(),
+              21.0 / 11.0, 1e-6);
+  const auto& factors = json.at("fitted-cost-factors");
+  EXPECT_NEAR(factors.at("HASH_JOIN_BUILD_COST_PER_ROW").get<double>(), 8.0,
+              1e-6);
+
+  // A file that cannot be parsed is ignored.
+  ad_utility::makeOfstream(filename) << "not json" << std::endl;
+  CostFactorCalibration fromInvalidFile;
+  fromInvalidFile.setPersistenceFile(filename);
+  EXPECT_TRUE(fromInvalidFile.fittedCostFactors().empty());
+  ad_utility::deleteFile(filename);
+
+  // Without a persistence file, `persist` does nothing.
+  CostFactorCalibration{}.persist();
+}
+
+// _____________________________________________________________________________
+TEST(CostFactorCalibration, recordQuery) {
+  auto qec = ad_utility::testing::getQec(
+      "<a> <p> <b> . <b> <p> <c> . <c> <p> <d> . <b> <p> <d> .");
+  std::string query = "SELECT * { ?x <p> ?y . ?y <p> ?z }";
+  CostFactorCalibration calibration;
+  auto executeAndRecord = [&]() {
+    EncodedIriManager encodedIriManager;
+    auto parsedQuery = SparqlParser::parseQuery(&encodedIriManager, query);
+    QueryPlanner qp{qec,
+                    std::make_shared<ad_utility::CancellationHandle<>>()};
+    auto qet = qp.createExecutionTree(parsedQuery);
+    qet.getResult();
+    calibration.recordQuery(qet);
+  };
+
+  // Each computed operation is recorded at most once.
+  qec->clearCacheUnpinnedOnly();
+  executeAndRecord();
+  auto json = calibration.toJson();
+  for (const auto& [kind, operation] : json.at("operations").items()) {
+    EXPECT_DOUBLE_EQ(operation.at("num-samples").get<double>(), 1.0) << kind;
+  }
+  auto numSamples = totalNumSamples(json);
+
+  // The results that are read from the cache are not recorded.
+  executeAndRecord();
+  EXPECT_DOUBLE_EQ(totalNumSamples(calibration.toJson()), numSamples);
+}
@@ -4,6 +4,8 @@
 
 #include <gmock/gmock.h>
 
+#include <random>
+
 #include "engine/CountConnectedSubgraphs.h"
 #include "util/BitUtils.h"
 #include "util/Exception.h"
@@ -97,6 +99,42 @@ TEST(CountConnectedSubgraphs, limitedBudget) {
   EXPECT_EQ(countSubgraphs(makeClique(64), 100), 101);
 }
 
+// Test `countSubgraphs` for random graphs against a brute-force count of all
+// the connected subsets of the nodes.
+TEST(CountConnectedSubgraphs, randomGraphs) {
+  auto isConnected = [](const Graph& graph, uint64_t subset) {
+    uint64_t reached = subset & (~subset + 1);
+    uint64_t previous = 0;
+    while (reached != previous) {
+      previous = reached;
+      for (size_t i = 0; i < graph.size(); ++i) {
+        if (reached & (1ULL << i)) {
+          reached |= graph[i].neighbors_ & subset;
+        }
+      }
+    }
+    return reached == subset;
+  };
+  std::mt19937_64 rng{42};
+  for (size_t numNodes = 1; numNodes <= 12; ++numNodes) {
+    Graph graph(numNodes);
+    for (size_t i = 0; i < numNodes; ++i) {
+      for (size_t j = i + 1; j < numNodes; ++j) {
+        if (rng() % 3 == 0) {
+          graph[i].neighbors_ |= 1ULL << j;
+          graph[j].neighbors_ |= 1ULL << i;
+        }
+      }
+    }
+    size_t expected = 0;
+    for (uint64_t subset = 1; subset < (1ULL << numNodes); ++subset) {
+      expected += isConnected(graph, subset);
+    }
+    EXPECT_EQ(countSubgraphs(graph, 1'000'000), expected)
+        << "numNodes is " << numNodes;
+  }
+}
+
 // Test conversion of bitsets to strings.
 TEST(CountConnectedSubgraphs, bitsetToString) {
   EXPECT_EQ(toBitsetString(0), "0");
@@ -0,0 +1,227 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+
+#include "../util/IdTableHelpers.h"
+#include "../util/IdTestHelpers.h"
+#include "engine/CsrGraph.h"
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using NodeIndex = CsrGraph::NodeIndex;
+using ad_utility::MemorySize;
+
+namespace {
+auto V = ad_utility::testing::VocabId;
+
+// Return the graph with the given `edges` between the `VocabId`s.
+CsrGraph makeGraph(const std::vector<std::pair<int64_t, int64_t>>& edges) {
+  VectorTable table;
+  for (auto [source, target] : edges) {
+    table.push_back({source, target});
+  }
+  IdTable idTable = makeIdTableFromVector(table);
+  if (table.empty()) {
+    idTable.setNumColumns(2);
+  }
+  return CsrGraph{idTable, 0, 1};
+}
+
+// Convert a span of node indices to a sorted vector.
+std::vector<NodeIndex> sorted(ql::span<const NodeIndex> nodes) {
+  std::vector<NodeIndex> result(nodes.begin(), nodes.end());
+  ql::ranges::sort(result);
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(CsrGraph, construction) {
+  auto table = makeIdTableFromVector({{7, 3},
+                                      {3, 5},
+                                      {7, 5},
+                                      {5, 5},
+                                      {Id::makeUndefined(), 9},
+                                      {9, Id::makeUndefined()}});
+  // The columns can be given in any order.
+  CsrGraph graph{table, 1, 0};
+  // The `Id`s of rows with an undefined value are not nodes.
+  EXPECT_THAT(graph.nodes(), ElementsAre(V(3), V(5), V(7)));
+  EXPECT_EQ(graph.numNodes(), 3);
+  EXPECT_EQ(graph.numEdges(), 4);
+  EXPECT_EQ(graph.nodeId(1), V(5));
+  EXPECT_EQ(graph.findNode(V(7)), 2);
+  EXPECT_EQ(graph.findNode(V(4)), std::nullopt);
+  EXPECT_EQ(graph.findNode(V(9)), std::nullopt);
+
+  // The edges go from column 1 to column 0: 3 -> 7, 5 -> 3, 5 -> 7, 5 -> 5.
+  EXPECT_THAT(sorted(graph.successors(0)), ElementsAre(2));
+  EXPECT_THAT(sorted(graph.successors(1)), ElementsAre(0, 1, 2));
+  EXPECT_THAT(sorted(graph.successors(2)), IsEmpty());
+  EXPECT_THAT(sorted(graph.predecessors(0)), ElementsAre(1));
+  EXPECT_THAT(sorted(graph.predecessors(1)), ElementsAre(1));
+  EXPECT_THAT(sorted(graph.predecessors(2)), ElementsAre(0, 1));
+  EXPECT_GT(graph.memorySize(), MemorySize::bytes(sizeof(CsrGraph)));
+
+  CsrGraph empty;
+  EXPECT_EQ(empty.numNodes(), 0);
+  EXPECT_EQ(empty.numEdges(), 0);
+  EXPECT_EQ(empty.findNode(V(3)), std::nullopt);
+}
+
+// _____________________________________________________________________________
+TEST(CsrGraph, pageRank) {
+  // On a cycle, all the nodes have the same rank.
+  auto cycle = makeGraph({{0, 1}, {1, 2}, {2, 3}, {3, 0}});
+  for (size_t numThreads : {1, 3}) {
+    auto ranks = csrGraph::pageRank(cycle, 20, 0.85, numThreads);
+    ASSERT_EQ(ranks.size(), 4);
+    for (double rank : ranks) {
+      EXPECT_NEAR(rank, 0.25, 1e-9);
+    }
+  }
+
+  // A star, where the center has no outgoing edges, s.t. its rank is
+  // distributed to all the nodes. In the fixed point, each leaf has the rank
+  // `r = (1 - d) / 4 + d * c / 4` and the center `c = r + 3 * d * r`.
+  auto star = makeGraph({{1, 0}, {2, 0}, {3, 0}});
+  auto ranks = csrGraph::pageRank(star, 300, 0.85, 2);
+  ASSERT_EQ(ranks.size(), 4);
+  double sum = std::accumulate(ranks.begin(), ranks.end(), 0.0);
+  EXPECT_NEAR(sum, 1.0, 1e-9);
+  EXPECT_NEAR(ranks[0], ranks[1] * (1 + 3 * 0.85), 1e-9);
+  EXPECT_NEAR(ranks[1], ranks[2], 1e-12);
+  EXPECT_NEAR(ranks[1], ranks[3], 1e-12);
+
+  // The number of threads doesn't change the result (up to rounding), and
+  // zero iterations yield the initial ranks.
+  auto parallelRanks = csrGraph::pageRank(star, 300, 0.85, 7);
+  for (size_t i = 0; i < ranks.size(); ++i) {
+    EXPECT_NEAR(ranks[i], parallelRanks[i], 1e-12);
+  }
+  EXPECT_THAT(csrGraph::pageRank(star, 0, 0.85, 2),
+              ElementsAre(0.25, 0.25, 0.25, 0.25));
+  EXPECT_THAT(csrGraph::pageRank(CsrGraph{}, 20, 0.85, 2), IsEmpty());
+}
+
+// _____________________________________________________________________________
+TEST(CsrGraph, connectedComponents) {
+  // Two components, the direction of the edges doesn't matter.
+  auto graph = makeGraph({{4, 1}, {2, 1}, {3, 5}, {5, 6}, {0, 4}});
+  for (size_t numThreads : {1, 2, 5}) {
+    EXPECT_THAT(csrGraph::connectedComponents(graph, numThreads),
+                ElementsAre(0, 0, 0, 3, 0, 3, 3));
+  }
+  EXPECT_THAT(csrGraph::connectedComponents(CsrGraph{}, 4), IsEmpty());
+
+  // Compare the concurrent union-find with a sequential breadth-first search
+  // on random graphs.
+  std::mt19937 randomEngine{42};
+  for (size_t numEdges : {10, 100, 3000}) {
+    std::uniform_int_distribution<int64_t> distribution(0, numEdges);
+    std::vector<std::pair<int64_t, int64_t>> edges;
+    for (size_t i = 0; i < numEdges; ++i) {
+      edges.emplace_back(distribution(randomEngine),
+                         distribution(randomEngine));
+    }
+    auto randomGraph = makeGraph(edges);
+    const size_t numNodes = randomGraph.numNodes();
+    std::vector<NodeIndex> expected(numNodes, numNodes);
+    for (NodeIndex start = 0; start < numNodes; ++start) {
+      if (expected[start] != numNodes) {
+        continue;
+      }
+      std::vector<NodeIndex> queue{start};
+      expected[start] = start;
+      while (!queue.empty()) {
+        auto node = queue.back();
+        queue.pop_back();
+        for (auto neighbors : {randomGraph.successors(node),
+                               randomGraph.predecessors(node)}) {
+          for (auto neighbor : neighbors) {
+            if (expected[neighbor] == numNodes) {
+              expected[neighbor] = start;
+              queue.push_back(neighbor);
+            }
+          }
+        }
+      }
+    }
+    EXPECT_EQ(csrGraph::connectedComponents(randomGraph, 8), expected);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(CsrGraph, kHopNeighborhood) {
+  // 0 -> 1 -> 2 -> 3 -> 4, 5 -> 0, and 1 -> 3.
+  auto graph = makeGraph({{0, 1}, {1, 2}, {2, 3}, {3, 4}, {5, 0}, {1, 3}});
+  using O = std::optional<size_t>;
+  for (size_t numThreads : {1, 3}) {
+    EXPECT_THAT(csrGraph::kHopNeighborhood(graph, {0}, 2, numThreads),
+                ElementsAre(O{0}, O{1}, O{2}, O{2}, O{}, O{}));
+    EXPECT_THAT(csrGraph::kHopNeighborhood(graph, {0}, 10, numThreads),
+                ElementsAre(O{0}, O{1}, O{2}, O{2}, O{3}, O{}));
+    // The number of hops is counted from the closest start node, duplicate
+    // start nodes don't matter.
+    EXPECT_THAT(csrGraph::kHopNeighborhood(graph, {2, 5, 2}, 1, numThreads),
+                ElementsAre(O{1}, O{}, O{0}, O{1}, O{}, O{0}));
+    EXPECT_THAT(csrGraph::kHopNeighborhood(graph, {4}, 0, numThreads),
+                ElementsAre(O{}, O{}, O{}, O{}, O{0}, O{}));
+    EXPECT_THAT(csrGraph::kHopNeighborhood(graph, {}, 3, numThreads),
+                ElementsAre(O{}, O{}, O{}, O{}, O{}, O{}));
+  }
+}
+
+// _____________________________________________________________________________
+TEST(CsrGraphCache, lookupAndInsert) {
+  auto graph = makeGraph({{0, 1}, {1, 2}});
+  auto graphSize = graph.memorySize();
+  CsrGraphCache cache{MemorySize::bytes(3 * graphSize.getBytes())};
+  EXPECT_EQ(cache.lookup("a"), nullptr);
+
+  auto inserted = cache.insert("a", graph);
+  ASSERT_NE(inserted, nullptr);
+  EXPECT_EQ(inserted->numEdges(), 2);
+  EXPECT_EQ(cache.lookup("a"), inserted);
+  EXPECT_EQ(cache.numEntries(), 1);
+
+  // A graph for an existing key is not inserted again, the cached graph is
+  // returned instead.
+  EXPECT_EQ(cache.insert("a", makeGraph({{0, 1}})), inserted);
+  EXPECT_EQ(cache.lookup("a")->numEdges(), 2);
+
+  // When the cache is full, the least recently used graph is evicted.
+  cache.insert("b", graph);
+  cache.insert("c", graph);
+  EXPECT_EQ(cache.numEntries(), 3);
+  cache.lookup("a");
+  cache.insert("d", graph);
+  EXPECT_EQ(cache.numEntries(), 3);
+  EXPECT_NE(cache.lookup("a"), nullptr);
+  EXPECT_EQ(cache.lookup("b"), nullptr);
+
+  // Graphs that are too large are returned, but not cached.
+  cache.setMaxSize(MemorySize::bytes(graphSize.getBytes() - 1));
+  EXPECT_EQ(cache.numEntries(), 0);
+  auto tooLarge = cache.insert("e", graph);
+  ASSERT_NE(tooLarge, nullptr);
+  EXPECT_EQ(tooLarge->numNodes(), 3);
+  EXPECT_EQ(cache.lookup("e"), nullptr);
+
+  cache.setMaxSize(MemorySize::megabytes(1));
+  cache.insert("f", graph);
+  EXPECT_EQ(cache.numEntries(), 1);
+  cache.clear();
+  EXPECT_EQ(cache.numEntries(), 0);
+}
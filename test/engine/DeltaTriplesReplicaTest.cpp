@@ -0,0 +1,177 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "engine/DeltaTriplesReplica.h"
+#include "index/DeltaTriples.h"
+#include "index/IndexImpl.h"
+
+namespace {
+using namespace std::chrono_literals;
+
+// A primary and a replica which both use the same test index.
+struct PrimaryAndReplica {
+  QueryExecutionContext* qec =
+      ad_utility::testing::getQec("<a> <b> <c> . <d> <e> _:blubb");
+  DeltaTriplesManager primary{qec->getIndex()};
+  DeltaTriplesManager replicaManager{qec->getIndex()};
+  std::shared_ptr<ad_utility::CancellationHandle<>> cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  LocalVocab localVocab;
+
+  PrimaryAndReplica() {
+    primary.enableReplicationLog(ad_utility::MemorySize::megabytes(1));
+  }
+
+  // Fetch the records from the `primary` like the `Server` does.
+  DeltaTriplesReplica::FetchRecords fetchRecords() {
+    return [this](uint64_t sequenceNumber) {
+      return DeltaTriplesReplicationLog::serialize(
+          primary.replicationLog()->recordsSince(sequenceNumber).value());
+    };
+  }
+
+  // Return the triple with the given IRIs (or the `object`) in the default
+  // graph.
+  IdTriple<0> triple(std::string_view subject, std::string_view predicate,
+                     std::variant<std::string_view, Id> object) {
+    auto toId = [this](std::string_view iri) {
+      return TripleComponent{TripleComponent::Iri::fromIriref(iri)}.toValueId(
+          qec->getIndex().getImpl(), localVocab);
+    };
+    Id objectId = std::holds_alternative<Id>(object)
+                      ? std::get<Id>(object)
+                      : toId(std::get<std::string_view>(object));
+    return IdTriple<0>{std::array{toId(subject), toId(predicate), objectId,
+                                  toId(DEFAULT_GRAPH_IRI)}};
+  }
+
+  void insert(std::vector<IdTriple<0>> triples) {
+    primary.modify<void>([&](DeltaTriples& deltaTriples) {
+      deltaTriples.insertTriples(cancellationHandle, std::move(triples));
+    });
+  }
+
+  // Return the number of inserted and deleted triples of the `manager`.
+  static std::pair<int64_t, int64_t> counts(DeltaTriplesManager& manager) {
+    return manager.modify<std::pair<int64_t, int64_t>>(
+        [](DeltaTriples& deltaTriples) {
+          return std::pair{deltaTriples.numInserted(),
+                           deltaTriples.numDeleted()};
+        },
+        false, false);
+  }
+
+  static ad_utility::HashSet<Id::T> localBlankNodes(
+      DeltaTriplesManager& manager) {
+    return manager.modify<ad_utility::HashSet<Id::T>>(
+        [](DeltaTriples& deltaTriples) {
+          return deltaTriples.localBlankNodes();
+        },
+        false, false);
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(DeltaTriplesReplica, synchronize) {
+  PrimaryAndReplica p;
+  // The thread of the replica doesn't interfere with the calls to
+  // `synchronize` because of the long poll interval.
+  DeltaTriplesReplica replica{p.replicaManager, p.qec->getLocalVocabContext(),
+                              p.fetchRecords(), 1h};
+  EXPECT_EQ(replica.synchronize(), 0);
+
+  p.insert({p.triple("<a>", "<b>", "<new>"), p.triple("<a>", "<b>", "<c2>")});
+  p.primary.modify<void>([&p](DeltaTriples& deltaTriples) {
+    deltaTriples.deleteTriples(p.cancellationHandle,
+                               {p.triple("<a>", "<b>", "<c>")});
+  });
+  auto status = replica.status();
+  EXPECT_EQ(status.appliedSequenceNumber_, 0);
+  EXPECT_EQ(replica.synchronize(), 2);
+  status = replica.status();
+  EXPECT_EQ(status.appliedSequenceNumber_, 2);
+  EXPECT_EQ(status.primarySequenceNumber_, 2);
+  EXPECT_EQ(status.lag(), 0);
+  EXPECT_TRUE(status.error_.empty());
+  EXPECT_EQ(PrimaryAndReplica::counts(p.replicaManager), std::pair(2L, 1L));
+  EXPECT_EQ(replica.synchronize(), 0);
+
+  // A local blank node of the primary is consistently mapped to the same local
+  // blank node of the replica across several records.
+  auto blankNode = p.primary.modify<Id>(
+      [](DeltaTriples& deltaTriples) {
+        return deltaTriples.makeLocalBlankNode();
+      },
+      false, false);
+  p.insert({p.triple("<a>", "<b>", blankNode)});
+  p.insert({p.triple("<d>", "<b>", blankNode)});
+  EXPECT_EQ(replica.synchronize(), 2);
+  EXPECT_EQ(PrimaryAndReplica::counts(p.replicaManager), std::pair(4L, 1L));
+  auto replicaBlankNodes = PrimaryAndReplica::localBlankNodes(p.replicaManager);
+  ASSERT_EQ(replicaBlankNodes.size(), 1);
+  EXPECT_NE(*replicaBlankNodes.begin(), blankNode.getBits());
+
+  // Clearing the primary also clears the replica.
+  p.primary.clear();
+  EXPECT_EQ(replica.synchronize(), 1);
+  EXPECT_EQ(PrimaryAndReplica::counts(p.replicaManager), std::pair(0L, 0L));
+}
+
+// _____________________________________________________________________________
+TEST(DeltaTriplesReplica, unexpectedSequenceNumber) {
+  PrimaryAndReplica p;
+  p.insert({p.triple("<a>", "<b>", "<new>")});
+  // A broken primary that always sends all the records.
+  auto fetch = [&p](uint64_t) {
+    return DeltaTriplesReplicationLog::serialize(
+        p.primary.replicationLog()->recordsSince(0).value());
+  };
+  DeltaTriplesReplica replica{p.replicaManager, p.qec->getLocalVocabContext(),
+                              fetch, 1h};
+  EXPECT_EQ(replica.synchronize(), 1);
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      replica.synchronize(),
+      ::testing::HasSubstr("sequence number 1 instead of 2"));
+  // Nothing has been applied twice.
+  EXPECT_EQ(PrimaryAndReplica::counts(p.replicaManager), std::pair(1L, 0L));
+}
+
+// _____________________________________________________________________________
+TEST(DeltaTriplesReplica, backgroundThread) {
+  PrimaryAndReplica p;
+  p.insert({p.triple("<a>", "<b>", "<new>")});
+  {
+    DeltaTriplesReplica replica{p.replicaManager,
+                                p.qec->getLocalVocabContext(),
+                                p.fetchRecords(), 1ms};
+    while (replica.status().appliedSequenceNumber_ < 1) {
+      std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(PrimaryAndReplica::counts(p.replicaManager), std::pair(1L, 0L));
+  }
+
+  // After an error, the replication is stopped and the error is reported.
+  auto fetch = [](uint64_t) -> std::string {
+    throw std::runtime_error("primary not reachable");
+  };
+  DeltaTriplesReplica replica{p.replicaManager, p.qec->getLocalVocabContext(),
+                              fetch, 1ms};
+  while (replica.status().error_.empty()) {
+    std::this_thread::sleep_for(1ms);
+  }
+  EXPECT_EQ(replica.status().error_, "primary not reachable");
+}
@@ -7,6 +7,7 @@
 #include "../util/GTestHelpers.h"
 #include "../util/IndexTestHelpers.h"
 #include "../util/OperationTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
 #include "engine/Describe.h"
 #include "engine/IndexScan.h"
 #include "engine/NeutralElementOperation.h"
@@ -110,6 +111,66 @@ TEST(Describe, describeWithVariable) {
   EXPECT_THAT(table.getColumn(2), numUnique(5));
 }
 
+// Test that the result is computed lazily with one `IdTable` per round of the
+// expansion of the blank nodes, and that the parallel expansion of the
+// resources yields the same triples as the sequential one.
+TEST(Describe, lazyAndParallelExpansion) {
+  auto qec = getQec(
+      " <s> <p>   <o> ."
+      " <s> <p>  _:g1 ."
+      "_:g1 <p2> <o2> ."
+      "_:g1 <p2> _:g1 ."
+      "_:g1 <p2> _:g2 ."
+      "_:g2 <p>  <o4> ."
+      "<s2> <p>  _:g2 ."
+      "<s3> <p>  <o4> ."
+      "<o4> <p>   <o> .");
+  parsedQuery::Describe parsedDescribe;
+  parsedDescribe.resources_.push_back(Variable{"?x"});
+  SparqlTripleSimple triple{Variable{"?x"},
+                            TripleComponent::Iri::fromIriref("<p>"),
+                            Variable{"?y"}};
+  auto makeDescribe = [&]() {
+    return Describe{qec,
+                    ad_utility::makeExecutionTree<IndexScan>(
+                        qec, Permutation::Enum::PSO, triple),
+                    parsedDescribe};
+  };
+
+  // The resources are `<s>`, `<s2>`, `<s3>`, `<o4>`, and `_:g2`. The first
+  // round has the six triples of these resources, the second round the
+  // triples of the blank nodes `_:g1` and `_:g2`, which are objects in the
+  // first round. There are no new blank nodes in the second round.
+  auto describe = makeDescribe();
+  auto lazyResult = describe.computeResultOnlyForTesting(true);
+  ASSERT_FALSE(lazyResult.isFullyMaterialized());
+  std::vector<size_t> numRowsPerRound;
+  for (const auto& pair : lazyResult.idTables()) {
+    numRowsPerRound.push_back(pair.idTable_.numRows());
+  }
+  EXPECT_THAT(numRowsPerRound, ::testing::ElementsAre(6, 4));
+
+  auto sortedTriples = [](const Result& result) {
+    std::vector<std::array<Id, 3>> triples;
+    for (const auto& row : result.idTable()) {
+      triples.push_back({row[0], row[1], row[2]});
+    }
+    ql::ranges::sort(triples);
+    return triples;
+  };
+  auto sequential = makeDescribe().computeResultOnlyForTesting();
+  auto expected = sortedTriples(sequential);
+  EXPECT_EQ(expected.size(), 10);
+
+  // Expand each resource in its own chunk.
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::describeNumThreads_>(4);
+  auto parallelDescribe = makeDescribe();
+  parallelDescribe.setMinNumResourcesPerThreadForTesting(1);
+  auto parallel = parallelDescribe.computeResultOnlyForTesting();
+  EXPECT_EQ(sortedTriples(parallel), expected);
+}
+
 // Test DESCRIBE query with a variable but not WHERE clause (which should
 // return an empty result).
 TEST(Describe, describeWithVariableButNoWhereClause) {
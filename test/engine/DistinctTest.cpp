@@ -7,8 +7,10 @@
 #include "../util/IdTableHelpers.h"
 #include "../util/IndexTestHelpers.h"
 #include "../util/OperationTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
 #include "engine/Distinct.h"
 #include "engine/NeutralElementOperation.h"
+#include "engine/Sort.h"
 
 using ad_utility::testing::makeAllocator;
 using V = Variable;
@@ -237,3 +239,98 @@ TEST(Distinct, clone) {
   EXPECT_THAT(distinct, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), distinct.getDescriptor());
 }
+
+// _____________________________________________________________________________
+TEST(Distinct, hashDistinct) {
+  auto qec = ad_utility::testing::getQec();
+  std::vector<std::optional<Variable>> variables{
+      {V{"?a"}, V{"?b"}, V{"?c"}, V{"?d"}}};
+  auto makeLazyValues = [qec, &variables]() {
+    std::vector<IdTable> idTables{};
+    idTables.push_back(makeIdTableFromVector({{3, 6, 5, 4}, {1, 1, 3, 7}}));
+    idTables.push_back(
+        makeIdTableFromVector({{6, 1, 3, 6}, {2, 2, 3, 5}, {1, 6, 5, 1}}));
+    idTables.push_back(makeIdTableFromVector({{2, 6, 5, 2}}));
+    idTables.push_back(makeIdTableFromVector({{4, 0, 0, 4}, {5, 0, 0, 5}}));
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(idTables), variables);
+  };
+  // A fully materialized input with 6 rows and a multiplicity of 1 in all
+  // columns.
+  auto makeMaterializedValues = [qec, &variables]() {
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec,
+        makeIdTableFromVector({{3, 6, 5, 4},
+                               {1, 1, 3, 7},
+                               {6, 1, 3, 6},
+                               {2, 2, 3, 5},
+                               {1, 6, 5, 1},
+                               {4, 0, 0, 4}}),
+        variables, false, std::vector<ColumnIndex>{}, LocalVocab{}, 1.0f,
+        true);
+  };
+  auto isSort = [](Distinct& distinct) {
+    return dynamic_cast<const Sort*>(
+               distinct.getChildren().at(0)->getRootOperation().get()) !=
+           nullptr;
+  };
+
+  // By default, the unsorted input is sorted.
+  {
+    Distinct distinct{qec, makeLazyValues(), {1, 2}};
+    EXPECT_FALSE(distinct.usesHashDistinct());
+    EXPECT_TRUE(isSort(distinct));
+  }
+  // The estimated number of distinct rows (6) is too large.
+  {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::hashDistinctMaxNumRows_>(5);
+    Distinct distinct{qec, makeMaterializedValues(), {1, 2}};
+    EXPECT_FALSE(distinct.usesHashDistinct());
+  }
+
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::hashDistinctMaxNumRows_>(
+          6);
+  Distinct distinct{qec, makeLazyValues(), {1, 2}};
+  EXPECT_TRUE(distinct.usesHashDistinct());
+  EXPECT_FALSE(isSort(distinct));
+  EXPECT_TRUE(distinct.getResultSortedOn().empty());
+
+  // The rows that haven't been seen before are yielded immediately in the
+  // order of the input.
+  qec->getQueryTreeCache().clearAll();
+  auto result = distinct.getResult(false, ComputationMode::LAZY_IF_SUPPORTED);
+  ASSERT_FALSE(result->isFullyMaterialized());
+  auto m = matchesIdTable;
+  using ::testing::ElementsAre;
+  EXPECT_THAT(
+      toVector(result->idTables()),
+      ElementsAre(m(makeIdTableFromVector({{3, 6, 5, 4}, {1, 1, 3, 7}})),
+                  m(makeIdTableFromVector({{2, 2, 3, 5}})),
+                  m(makeIdTableFromVector({{4, 0, 0, 4}}))));
+
+  auto expected = makeIdTableFromVector(
+      {{3, 6, 5, 4}, {1, 1, 3, 7}, {2, 2, 3, 5}, {4, 0, 0, 4}});
+  qec->getQueryTreeCache().clearAll();
+  result = distinct.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+  ASSERT_TRUE(result->isFullyMaterialized());
+  EXPECT_EQ(result->idTable(), expected);
+
+  // A fully materialized input.
+  Distinct distinct2{qec, makeMaterializedValues(), {1, 2}};
+  ASSERT_TRUE(distinct2.usesHashDistinct());
+  qec->getQueryTreeCache().clearAll();
+  result = distinct2.getResult(false, ComputationMode::LAZY_IF_SUPPORTED);
+  ASSERT_TRUE(result->isFullyMaterialized());
+  EXPECT_EQ(result->idTable(), expected);
+
+  // A clone keeps the decision, even if the runtime parameter has changed.
+  auto cleanup2 =
+      setRuntimeParameterForTest<&RuntimeParameters::hashDistinctMaxNumRows_>(
+          0);
+  auto clone = distinct.clone();
+  ASSERT_TRUE(clone);
+  EXPECT_THAT(distinct, IsDeepCopy(*clone));
+  EXPECT_TRUE(dynamic_cast<const Distinct&>(*clone).usesHashDistinct());
+}
@@ -8,7 +8,9 @@
 #include "../util/IdTableHelpers.h"
 #include "../util/IndexTestHelpers.h"
 #include "../util/OperationTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
 #include "../util/TripleComponentTestHelpers.h"
+#include "./LazyJoinTestHelpers.h"
 #include "engine/ExistsJoin.h"
 #include "engine/IndexScan.h"
 #include "engine/JoinHelpers.h"
@@ -965,3 +967,123 @@ TEST(ExistsJoin, resultSortedOn) {
   // Sort would be added if it's not already sorted enough.
   EXPECT_THAT(getSortOrder(biggerWithUndef, {0, 1, 2}), ElementsAre(0, 1, 2));
 }
+
+// Test fixture for the `ExistsJoin` with an `IndexScan` as its right child.
+// The parameter determines whether the result is requested lazily.
+class ExistsJoinWithIndexScan : public ::testing::TestWithParam<bool>,
+                                public LazyJoinTestHelper {
+ protected:
+  void SetUp() override {
+    // Using 8 bytes per column gives us a single triple per block.
+    std::string kg =
+        "<a> <p> <A> . <a> <p> <A2> . "
+        "<b> <p> <B> . <b> <p> <B2> . "
+        "<c> <p> <C> . <c> <p> <C2> . "
+        "<d> <p> <D> . "
+        "<e> <p> <E> . ";
+    setupQecWithKnowledgeGraph(kg, 8_B);
+  }
+
+  // Return an `ExistsJoin` of a single column `?x` with the (sorted) `ids`
+  // and the scan `?x <p> ?y`. If `lazyLeft` is true, each row of the left
+  // side is yielded as a separate block.
+  ExistsJoin makeExistsJoin(std::vector<Id> ids, bool lazyLeft) const {
+    ql::ranges::sort(ids);
+    std::vector<std::optional<Variable>> variables{Variable{"?x"}};
+    std::shared_ptr<QueryExecutionTree> left;
+    if (lazyLeft) {
+      std::vector<IdTable> tables;
+      for (Id id : ids) {
+        tables.push_back(makeIdTableFromVector({{id}}));
+      }
+      left = ad_utility::makeExecutionTree<ValuesForTesting>(
+          qec_, std::move(tables), std::move(variables), false,
+          std::vector<ColumnIndex>{0});
+    } else {
+      IdTable table{1, qec_->getAllocator()};
+      for (Id id : ids) {
+        table.push_back({id});
+      }
+      left = ad_utility::makeExecutionTree<ValuesForTesting>(
+          qec_, std::move(table), std::move(variables), false,
+          std::vector<ColumnIndex>{0}, LocalVocab{}, std::nullopt, true);
+    }
+    SparqlTripleSimple xpy{TripleComponent{Variable{"?x"}}, iri("<p>"),
+                           TripleComponent{Variable{"?y"}}};
+    auto right =
+        ad_utility::makeExecutionTree<IndexScan>(qec_, Permutation::PSO, xpy);
+    return ExistsJoin{qec_, std::move(left), std::move(right),
+                      Variable{"?exists"}};
+  }
+
+  // Compute the `existsJoin` (lazily iff the test parameter is true) and
+  // return the rows of the result.
+  IdTable computeExistsJoin(ExistsJoin& existsJoin) const {
+    qec_->getQueryTreeCache().clearAll();
+    bool requestLaziness = GetParam();
+    auto result = existsJoin.computeResultOnlyForTesting(requestLaziness);
+    EXPECT_EQ(result.isFullyMaterialized(), !requestLaziness);
+    if (result.isFullyMaterialized()) {
+      return result.idTable().clone();
+    }
+    IdTable table{existsJoin.getResultWidth(), qec_->getAllocator()};
+    for (auto& [idTable, localVocab] : result.idTables()) {
+      table.insertAtEnd(idTable);
+    }
+    return table;
+  }
+
+  // Return the number of blocks that were read by the right child of the
+  // `existsJoin`, and the total number of blocks.
+  static std::pair<size_t, size_t> getBlockStats(ExistsJoin& existsJoin) {
+    const auto& rti =
+        existsJoin.getChildren().at(1)->getRootOperation()->runtimeInfo();
+    return {rti.details_["num-blocks-read"].get<size_t>(),
+            rti.details_["num-blocks-all"].get<size_t>()};
+  }
+};
+
+// _____________________________________________________________________________
+TEST_P(ExistsJoinWithIndexScan, onlyMatchingBlocksAreRead) {
+  std::vector<Id> ids{toValueId(iri("<a>")), toValueId(iri("<c>")),
+                      toValueId(iri("<A>")), toValueId(iri("<p>"))};
+  ql::ranges::sort(ids);
+  IdTable expected{2, makeAllocator()};
+  for (Id id : ids) {
+    bool exists = id == toValueId(iri("<a>")) || id == toValueId(iri("<c>"));
+    expected.push_back({id, Id::makeFromBool(exists)});
+  }
+  bool requestLaziness = GetParam();
+  for (bool lazyLeft : {false, true}) {
+    if (lazyLeft && !requestLaziness) {
+      // A lazy left side is only requested for a lazy result.
+      continue;
+    }
+    auto existsJoin = makeExistsJoin(ids, lazyLeft);
+    EXPECT_EQ(computeExistsJoin(existsJoin), expected);
+    // Only the four blocks for `<a>` and `<c>` are read.
+    EXPECT_EQ(getBlockStats(existsJoin), std::pair(size_t{4}, size_t{8}));
+  }
+
+  // The optimization can be disabled.
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::prefilteredExistsJoin_>(
+          false);
+  auto existsJoin = makeExistsJoin(ids, false);
+  EXPECT_EQ(computeExistsJoin(existsJoin), expected);
+}
+
+// _____________________________________________________________________________
+TEST_P(ExistsJoinWithIndexScan, undefAndEmptyLeftSide) {
+  auto a = toValueId(iri("<a>"));
+  // UNDEF values match every row of the right side.
+  auto existsJoin = makeExistsJoin({U, a}, GetParam());
+  EXPECT_EQ(computeExistsJoin(existsJoin),
+            makeIdTableFromVector({{U, T}, {a, T}}));
+
+  auto emptyExistsJoin = makeExistsJoin({}, false);
+  EXPECT_TRUE(computeExistsJoin(emptyExistsJoin).empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(ExistsJoinWithIndexScanSuite, ExistsJoinWithIndexScan,
+                         ::testing::Bool());
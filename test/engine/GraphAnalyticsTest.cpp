@@ -0,0 +1,221 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IdTestHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/OperationTestHelpers.h"
+#include "engine/CsrGraph.h"
+#include "engine/GraphAnalytics.h"
+#include "engine/QueryPlanner.h"
+#include "engine/ValuesForTesting.h"
+#include "parser/SparqlParser.h"
+
+using ::testing::HasSubstr;
+using Algorithm = GraphAnalyticsAlgorithm;
+
+namespace {
+auto V = ad_utility::testing::VocabId;
+auto I = ad_utility::testing::IntId;
+using Vars = std::vector<std::optional<Variable>>;
+
+// The configuration of the given `algorithm` for the edges from `?s` to `?t`.
+GraphAnalyticsConfiguration makeConfig(Algorithm algorithm) {
+  return {algorithm, Variable{"?s"}, Variable{"?t"}, Variable{"?node"},
+          Variable{"?value"}};
+}
+
+// A `GraphAnalytics` operation for the edges 0 -> 1 -> 2 -> 0 and 3 -> 4.
+GraphAnalytics makeOperation(GraphAnalyticsConfiguration config,
+                             LocalVocab localVocab = LocalVocab{}) {
+  auto qec = ad_utility::testing::getQec();
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{0, 1}, {1, 2}, {2, 0}, {3, 4}}),
+      Vars{Variable{"?s"}, Variable{"?t"}}, false, std::vector<ColumnIndex>{},
+      std::move(localVocab));
+  return {qec, std::move(subtree), std::move(config)};
+}
+
+// Parse and plan the `query` and return its result.
+std::shared_ptr<const Result> runQuery(QueryExecutionContext* qec,
+                                       const std::string& query) {
+  EncodedIriManager encodedIriManager;
+  auto parsedQuery = SparqlParser::parseQuery(&encodedIriManager, query);
+  QueryPlanner qp{qec, std::make_shared<ad_utility::CancellationHandle<>>()};
+  auto qet = qp.createExecutionTree(parsedQuery);
+  return qet.getResult();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(GraphAnalytics, basicMethods) {
+  auto op = makeOperation(makeConfig(Algorithm::PAGE_RANK));
+  EXPECT_EQ(op.getResultWidth(), 2);
+  EXPECT_THAT(op.resultSortedOn(), ::testing::ElementsAre(0));
+  EXPECT_EQ(op.getDescriptor(), "GraphAnalytics PageRank");
+  EXPECT_FALSE(op.knownEmptyResult());
+  EXPECT_EQ(op.getChildren().size(), 1);
+  EXPECT_THAT(op.getCacheKey(),
+              ::testing::AllOf(HasSubstr("GRAPH ANALYTICS"),
+                               HasSubstr("PageRank, iterations: 20"),
+                               HasSubstr("source column: 0")));
+  auto columns = op.getExternallyVisibleVariableColumns();
+  EXPECT_EQ(columns.at(Variable{"?node"}).columnIndex_, 0);
+  EXPECT_EQ(columns.at(Variable{"?value"}).columnIndex_, 1);
+
+  // Different parameters have different cache keys.
+  auto config = makeConfig(Algorithm::PAGE_RANK);
+  config.numIterations_ = 5;
+  EXPECT_NE(makeOperation(config).getCacheKey(), op.getCacheKey());
+  EXPECT_EQ(makeOperation(config).getGraphCacheKey(), op.getGraphCacheKey());
+
+  // Without start nodes, the k-hop neighborhood is empty.
+  auto kHop = makeOperation(makeConfig(Algorithm::K_HOP_NEIGHBORHOOD));
+  EXPECT_TRUE(kHop.knownEmptyResult());
+
+  // The edges have to be bound by the child.
+  config.source_ = Variable{"?notBound"};
+  AD_EXPECT_THROW_WITH_MESSAGE(makeOperation(config), HasSubstr("?notBound"));
+  config = makeConfig(Algorithm::PAGE_RANK);
+  config.value_ = config.node_;
+  AD_EXPECT_THROW_WITH_MESSAGE(makeOperation(config),
+                               HasSubstr("different variables"));
+}
+
+// _____________________________________________________________________________
+TEST(GraphAnalytics, algorithms) {
+  CsrGraphCache::get().clear();
+  auto components = makeOperation(makeConfig(Algorithm::CONNECTED_COMPONENTS));
+  auto result = components.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(),
+            makeIdTableFromVector({{0, 0}, {1, 0}, {2, 0}, {3, 3}, {4, 3}}));
+
+  auto config = makeConfig(Algorithm::K_HOP_NEIGHBORHOOD);
+  config.startNodes_ = {V(1), V(7)};
+  config.maxNumHops_ = 1;
+  auto kHop = makeOperation(config);
+  result = kHop.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(),
+            makeIdTableFromVector({{V(1), I(0)}, {V(2), I(1)}}));
+
+  auto pageRank = makeOperation(makeConfig(Algorithm::PAGE_RANK));
+  result = pageRank.computeResultOnlyForTesting();
+  const auto& table = result.idTable();
+  ASSERT_EQ(table.numRows(), 5);
+  double sum = 0;
+  for (size_t row = 0; row < table.numRows(); ++row) {
+    EXPECT_EQ(table(row, 0), V(row));
+    ASSERT_EQ(table(row, 1).getDatatype(), Datatype::Double);
+    sum += table(row, 1).getDouble();
+  }
+  EXPECT_NEAR(sum, 1.0, 1e-9);
+  // The nodes on the cycle have the same rank, the end of the edge `3 -> 4`
+  // has a larger rank than its start.
+  EXPECT_NEAR(table(0, 1).getDouble(), table(2, 1).getDouble(), 1e-12);
+  EXPECT_GT(table(4, 1).getDouble(), table(3, 1).getDouble());
+}
+
+// _____________________________________________________________________________
+TEST(GraphAnalytics, graphIsCached) {
+  auto& cache = CsrGraphCache::get();
+  cache.clear();
+  auto config = makeConfig(Algorithm::CONNECTED_COMPONENTS);
+  auto first = makeOperation(config);
+  first.computeResultOnlyForTesting();
+  EXPECT_EQ(first.runtimeInfo().details_["graph-from-cache"], false);
+  EXPECT_EQ(cache.numEntries(), 1);
+
+  // A different algorithm on the same edges doesn't compute the child again.
+  auto second = makeOperation(makeConfig(Algorithm::PAGE_RANK));
+  second.computeResultOnlyForTesting();
+  EXPECT_EQ(second.runtimeInfo().details_["graph-from-cache"], true);
+  EXPECT_EQ(second.getChildren()[0]->getRootOperation()->runtimeInfo().status_,
+            RuntimeInformation::Status::optimizedOut);
+  EXPECT_EQ(cache.numEntries(), 1);
+
+  // Graphs with a local vocabulary are not cached, and the result keeps the
+  // local vocabulary.
+  cache.clear();
+  LocalVocab localVocab;
+  localVocab.getIndexAndAddIfNotContained(
+      LocalVocabEntry::fromStringRepresentation(
+          "\"local\"",
+          ad_utility::testing::getQec()->getLocalVocabContext()));
+  auto withLocalVocab = makeOperation(config, std::move(localVocab));
+  auto result = withLocalVocab.computeResultOnlyForTesting();
+  EXPECT_EQ(result.localVocab().size(), 1);
+  EXPECT_EQ(cache.numEntries(), 0);
+}
+
+// _____________________________________________________________________________
+TEST(GraphAnalytics, service) {
+  CsrGraphCache::get().clear();
+  auto qec = ad_utility::testing::getQec(
+      "<a> <p> <b> . <b> <p> <c> . <d> <p> <e> . <e> <q> <a> .");
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  auto makeQuery = [](std::string_view parameters) {
+    return absl::StrCat(
+        "SELECT ?node ?value { SERVICE "
+        "<https://qlever.cs.uni-freiburg.de/graphAnalytics/> { [] ",
+        parameters,
+        " ; <source> ?s ; <target> ?t ; <node> ?node ; <value> ?value . "
+        "{ ?s <p> ?t } } }");
+  };
+
+  auto result = runQuery(qec, makeQuery("<algorithm> <connectedComponents>"));
+  auto a = getId("<a>");
+  auto d = getId("<d>");
+  auto expected = makeIdTableFromVector({{a, a},
+                                         {getId("<b>"), a},
+                                         {getId("<c>"), a},
+                                         {d, d},
+                                         {getId("<e>"), d}});
+  EXPECT_EQ(result->idTable(), expected);
+
+  result = runQuery(
+      qec, makeQuery("<algorithm> <kHopNeighborhood> ; <start> <a>, <x> ; "
+                     "<maxNumHops> 1"));
+  EXPECT_EQ(result->idTable(),
+            makeIdTableFromVector({{a, I(0)}, {getId("<b>"), I(1)}}));
+
+  result = runQuery(qec, makeQuery("<algorithm> <pageRank> ; "
+                                   "<numIterations> 3 ; <dampingFactor> 0.5"));
+  EXPECT_EQ(result->idTable().numRows(), 5);
+
+  // Invalid configurations.
+  auto expectError = [&qec](const std::string& query, std::string_view error) {
+    AD_EXPECT_THROW_WITH_MESSAGE(runQuery(qec, query), HasSubstr(error));
+  };
+  expectError(makeQuery("<algorithm> <shortestPaths>"),
+              "Unsupported algorithm in graph analytics: shortestPaths");
+  expectError(makeQuery("<algorithm> <pageRank> ; <foo> 3"),
+              "Unsupported argument <foo>");
+  expectError(makeQuery("<algorithm> <pageRank> ; <numIterations> -1"),
+              "expects a non-negative integer");
+  expectError(makeQuery("<algorithm> <pageRank> ; <dampingFactor> 2.0"),
+              "expects a number between 0 and 1");
+  expectError(makeQuery("<algorithm> <pageRank> ; <start> <a>"),
+              "only supported by the algorithm <kHopNeighborhood>");
+  expectError(makeQuery("<algorithm> <kHopNeighborhood> ; <maxNumHops> 2"),
+              "requires at least one <start> node");
+  expectError(makeQuery("<algorithm> <connectedComponents> ; "
+                        "<numIterations> 2"),
+              "only supported by the algorithm <pageRank>");
+  expectError(makeQuery("<maxNumHops> 2"), "Missing parameter <algorithm>");
+  expectError(
+      "SELECT * { SERVICE <https://qlever.cs.uni-freiburg.de/graphAnalytics/> "
+      "{ [] <algorithm> <pageRank> ; <source> ?s ; <target> ?t ; "
+      "<node> ?node ; <value> ?value . } }",
+      "requires a group graph pattern");
+}
@@ -7,6 +7,7 @@
 #include "../util/GTestHelpers.h"
 #include "../util/IdTableHelpers.h"
 #include "../util/IndexTestHelpers.h"
+#include "engine/sparqlExpressions/GroupConcatBuilder.h"
 #include "engine/sparqlExpressions/GroupConcatExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 
@@ -157,3 +158,42 @@ TEST(GroupConcatExpression, getCacheKey) {
   EXPECT_NE(expressionNonDistinct.getCacheKey(map),
             expressionDistinct.getCacheKey(map));
 }
+
+// _____________________________________________________________________________
+TEST(GroupConcatExpression, groupConcatBuilder) {
+  using detail::GroupConcatBuilder;
+  GroupConcatBuilder builder;
+  EXPECT_TRUE(builder.isEmpty());
+  std::vector<std::optional<tc::Literal>> literals{lit("\"a\""),
+                                                   lit("\"bc\"@en")};
+  builder.reserveFor(literals, ";");
+  for (const auto& literal : literals) {
+    EXPECT_TRUE(builder.append(literal, ";"));
+  }
+  EXPECT_FALSE(builder.isEmpty());
+
+  // Merge the results for two parts of the input.
+  GroupConcatBuilder later;
+  later.append(lit("\"d\""), ";");
+  builder.append(std::move(later), ";");
+  builder.append(GroupConcatBuilder{}, ";");
+  EXPECT_EQ(GroupConcatBuilder{builder}.finish(), lit("\"a;bc;d\""));
+
+  GroupConcatBuilder empty;
+  empty.append(std::move(builder), ";");
+  EXPECT_EQ(std::move(empty).finish(), lit("\"a;bc;d\""));
+
+  // An undefined value makes the result undefined, also after merging.
+  GroupConcatBuilder undefined;
+  EXPECT_FALSE(undefined.append(std::nullopt, ";"));
+  EXPECT_TRUE(undefined.isUndefined());
+  GroupConcatBuilder other;
+  other.append(lit("\"a\""), ";");
+  other.append(std::move(undefined), ";");
+  EXPECT_EQ(GroupConcatBuilder{other}.finish(), std::nullopt);
+
+  other.clear();
+  EXPECT_TRUE(other.isEmpty());
+  EXPECT_FALSE(other.isUndefined());
+  EXPECT_EQ(std::move(other).finish(), lit("\"\""));
+}
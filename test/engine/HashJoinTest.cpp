@@ -0,0 +1,208 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/OperationTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "engine/HashJoin.h"
+#include "engine/QueryPlanner.h"
+#include "engine/ValuesForTesting.h"
+#include "parser/SparqlParser.h"
+
+namespace {
+using V = Variable;
+using Vars = std::vector<std::optional<Variable>>;
+using ::testing::ElementsAre;
+
+// Return a `ValuesForTesting` with the given `rows`, `variables`, and
+// `sortedColumns`.
+std::shared_ptr<QueryExecutionTree> makeChild(
+    QueryExecutionContext* qec, const VectorTable& rows, Vars variables,
+    std::vector<ColumnIndex> sortedColumns = {}) {
+  return ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector(rows), std::move(variables), false,
+      std::move(sortedColumns));
+}
+
+// Return true iff the `tree` contains a `HashJoin`.
+bool containsHashJoin(QueryExecutionTree& tree) {
+  auto* operation = tree.getRootOperation().get();
+  if (dynamic_cast<const HashJoin*>(operation) != nullptr) {
+    return true;
+  }
+  return ql::ranges::any_of(operation->getChildren(), [](auto* child) {
+    return containsHashJoin(*child);
+  });
+}
+
+// Compute the result of the `query` and return its rows in sorted order.
+std::vector<std::vector<Id>> computeSortedRows(QueryExecutionContext* qec,
+                                               const std::string& query,
+                                               bool expectHashJoin) {
+  EncodedIriManager encodedIriManager;
+  auto parsedQuery = SparqlParser::parseQuery(&encodedIriManager, query);
+  QueryPlanner qp{qec, std::make_shared<ad_utility::CancellationHandle<>>()};
+  auto qet = qp.createExecutionTree(parsedQuery);
+  EXPECT_EQ(containsHashJoin(qet), expectHashJoin);
+  auto result = qet.getResult();
+  std::vector<std::vector<Id>> rows;
+  for (const auto& row : result->idTable()) {
+    rows.emplace_back(row.begin(), row.end());
+  }
+  ql::ranges::sort(rows);
+  return rows;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(HashJoin, basicJoin) {
+  auto qec = ad_utility::testing::getQec();
+  auto left = makeChild(qec, {{3, 10}, {1, 11}}, Vars{V{"?x"}, V{"?a"}});
+  auto right = makeChild(qec, {{20, 1}, {21, 2}, {22, 3}, {23, 1}, {24, 3}},
+                         Vars{V{"?b"}, V{"?x"}});
+
+  // The smaller left input is the build side, so the result is in the order
+  // of the right input.
+  HashJoin join{qec, left, right, 0, 1};
+  EXPECT_TRUE(join.leftIsBuildSide());
+  EXPECT_EQ(join.getResultWidth(), 3);
+  EXPECT_EQ(join.getDescriptor(), "HashJoin on ?x");
+  EXPECT_TRUE(join.getResultSortedOn().empty());
+  const auto& variableColumns = join.getExternallyVisibleVariableColumns();
+  EXPECT_EQ(variableColumns.at(V{"?x"}).columnIndex_, 0);
+  EXPECT_EQ(variableColumns.at(V{"?a"}).columnIndex_, 1);
+  EXPECT_EQ(variableColumns.at(V{"?b"}).columnIndex_, 2);
+  EXPECT_EQ(join.computeResultOnlyForTesting().idTable(),
+            makeIdTableFromVector(
+                {{1, 11, 20}, {3, 10, 22}, {1, 11, 23}, {3, 10, 24}}));
+
+  // The same join with the right input as the build side.
+  HashJoin swapped{qec, right, left, 1, 0};
+  EXPECT_FALSE(swapped.leftIsBuildSide());
+  EXPECT_NE(swapped.getCacheKey(), join.getCacheKey());
+  EXPECT_EQ(swapped.computeResultOnlyForTesting().idTable(),
+            makeIdTableFromVector(
+                {{20, 1, 11}, {22, 3, 10}, {23, 1, 11}, {24, 3, 10}}));
+
+  // A join with an empty input.
+  auto empty = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, IdTable{2, qec->getAllocator()}, Vars{V{"?x"}, V{"?c"}});
+  HashJoin emptyJoin{qec, empty, right, 0, 1};
+  EXPECT_TRUE(emptyJoin.knownEmptyResult());
+  EXPECT_TRUE(emptyJoin.computeResultOnlyForTesting().idTable().empty());
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, undefValues) {
+  auto qec = ad_utility::testing::getQec();
+  auto U = Id::makeUndefined();
+  auto left = makeChild(qec, {{U, 10}, {1, 11}}, Vars{V{"?x"}, V{"?a"}});
+  auto right = makeChild(qec, {{1, 20}, {U, 21}, {2, 22}},
+                         Vars{V{"?x"}, V{"?b"}});
+  HashJoin join{qec, left, right, 0, 0};
+  ASSERT_TRUE(join.leftIsBuildSide());
+  // UNDEF values match all the values of the other side.
+  EXPECT_EQ(join.computeResultOnlyForTesting().idTable(),
+            makeIdTableFromVector({{1, 11, 20},
+                                   {1, 10, 20},
+                                   {U, 10, 21},
+                                   {1, 11, 21},
+                                   {2, 10, 22}}));
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, lazyProbeSideAndSortedResult) {
+  auto qec = ad_utility::testing::getQec();
+  auto left = makeChild(qec, {{3, 30}, {1, 10}}, Vars{V{"?x"}, V{"?a"}});
+  std::vector<IdTable> blocks;
+  blocks.push_back(makeIdTableFromVector({{1, 3}, {2, 1}}));
+  blocks.push_back(makeIdTableFromVector({{3, 3}, {4, 2}}));
+  auto right = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(blocks), Vars{V{"?b"}, V{"?x"}}, false,
+      std::vector<ColumnIndex>{0});
+  HashJoin join{qec, left, right, 0, 1};
+  ASSERT_TRUE(join.leftIsBuildSide());
+  // The result is sorted by `?b` like the probe side.
+  EXPECT_THAT(join.getResultSortedOn(), ElementsAre(2));
+  auto expected = makeIdTableFromVector({{3, 30, 1}, {1, 10, 2}, {3, 30, 3}});
+
+  auto lazyResult = join.computeResultOnlyForTesting(true);
+  ASSERT_FALSE(lazyResult.isFullyMaterialized());
+  IdTable lazyTable{3, qec->getAllocator()};
+  for (auto& [idTable, localVocab] : lazyResult.idTables()) {
+    lazyTable.insertAtEnd(idTable);
+  }
+  EXPECT_EQ(lazyTable, expected);
+  qec->clearCacheUnpinnedOnly();
+  EXPECT_EQ(join.computeResultOnlyForTesting(false).idTable(), expected);
+
+  // A probe side that is sorted on the join column without UNDEF values keeps
+  // this order.
+  auto sortedOnJoinColumn =
+      makeChild(qec, {{5, 1}, {6, 3}}, Vars{V{"?c"}, V{"?x"}}, {1});
+  HashJoin join2{qec, left, sortedOnJoinColumn, 0, 1};
+  ASSERT_TRUE(join2.leftIsBuildSide());
+  EXPECT_THAT(join2.getResultSortedOn(), ElementsAre(0));
+  auto withUndef = makeChild(qec, {{5, Id::makeUndefined()}, {6, 3}},
+                             Vars{V{"?c"}, V{"?x"}}, {1, 0});
+  HashJoin join3{qec, left, withUndef, 0, 1};
+  EXPECT_TRUE(join3.getResultSortedOn().empty());
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, estimatesAndClone) {
+  auto qec = ad_utility::testing::getQec();
+  auto makeChildWithMultiplicity = [qec](const VectorTable& rows,
+                                         Vars variables) {
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector(rows), std::move(variables), false,
+        std::vector<ColumnIndex>{}, LocalVocab{}, 2.0f);
+  };
+  auto left =
+      makeChildWithMultiplicity({{1, 10}, {1, 11}}, Vars{V{"?x"}, V{"?a"}});
+  auto right = makeChildWithMultiplicity(
+      {{1, 20}, {1, 21}, {1, 22}, {2, 23}, {2, 24}}, Vars{V{"?x"}, V{"?b"}});
+  HashJoin join{qec, left, right, 0, 0};
+  // `0.7 * 2 * 2 * min(2 / 2, 5 / 2)`.
+  EXPECT_EQ(join.getSizeEstimate(), 2);
+  EXPECT_FLOAT_EQ(join.getMultiplicity(0), 2.8f);
+  // The estimate, `2 * 4` for the build side, `5 * 2` for the probe side, and
+  // the costs of the children.
+  EXPECT_EQ(join.getCostEstimate(), 2 + 8 + 10 + 2 + 5);
+
+  auto clone = join.clone();
+  ASSERT_TRUE(clone);
+  EXPECT_THAT(join, IsDeepCopy(*clone));
+  EXPECT_EQ(clone->getDescriptor(), join.getDescriptor());
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, queryPlanner) {
+  std::string kg =
+      "<a> <p> <b> . <b> <p> <c> . <c> <p> <d> . <d> <p> <a> . <a> <p> <c> .";
+  auto qec = ad_utility::testing::getQec(kg);
+  // An unsorted VALUES clause that is much larger than the index scan.
+  std::string values;
+  for (size_t i = 0; i < 64; ++i) {
+    values += absl::StrCat("(<", std::string(1, "abcd"[i % 4]), "> ", i, ") ");
+  }
+  std::string query = absl::StrCat("SELECT * { ?x <p> ?y . VALUES (?y ?z) { ",
+                                   values, "} }");
+  auto expected = computeSortedRows(qec, query, false);
+  EXPECT_EQ(expected.size(), 80);
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::useHashJoin_>(true);
+  qec->clearCacheUnpinnedOnly();
+  EXPECT_EQ(computeSortedRows(qec, query, true), expected);
+}
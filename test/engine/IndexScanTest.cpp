@@ -15,6 +15,7 @@
 #include "engine/IndexScan.h"
 #include "engine/MaterializedViews.h"
 #include "engine/NamedResultCache.h"
+#include "index/DecompressedBlockCache.h"
 #include "index/IndexImpl.h"
 #include "parser/ParsedQuery.h"
 
@@ -453,6 +454,45 @@ TEST(IndexScan, additionalColumn) {
   EXPECT_THAT(res.idTable(), ::testing::ElementsAreArray(exp));
 }
 
+// Test that stripped additional columns are not read, while the kept ones end
+// up in the correct column of the result.
+TEST(IndexScan, strippedAdditionalColumnsAreNotRead) {
+  auto qec = getQec("<x> <y> <z>.");
+  using V = Variable;
+  SparqlTripleSimple triple{V{"?x"}, iri("<y>"), V{"?z"}};
+  triple.additionalScanColumns_.emplace_back(
+      ADDITIONAL_COLUMN_INDEX_SUBJECT_PATTERN, V{"?xpattern"});
+  triple.additionalScanColumns_.emplace_back(
+      ADDITIONAL_COLUMN_INDEX_OBJECT_PATTERN, V{"?ypattern"});
+  auto scan = IndexScan{qec, Permutation::PSO, triple};
+  auto stripped =
+      scan.makeTreeWithStrippedColumns({V{"?x"}, V{"?ypattern"}}).value();
+  const auto& strippedScan =
+      dynamic_cast<const IndexScan&>(*stripped->getRootOperation());
+  ASSERT_EQ(strippedScan.getResultWidth(), 2);
+  auto col = makeAlwaysDefinedColumn;
+  VariableToColumnMap expected = {{V{"?x"}, col(0)}, {V("?ypattern"), col(1)}};
+  ASSERT_THAT(strippedScan.getExternallyVisibleVariableColumns(),
+              ::testing::UnorderedElementsAreArray(expected));
+
+  auto getId = makeGetId(qec->getIndex());
+  auto exp = makeIdTableFromVector({{getId("<x>"), IntId(Pattern::NoPattern)}});
+  for (bool requestLaziness : {false, true}) {
+    qec->clearCacheUnpinnedOnly();
+    auto res = stripped->getRootOperation()->computeResultOnlyForTesting(
+        requestLaziness);
+    if (res.isFullyMaterialized()) {
+      EXPECT_THAT(res.idTable(), ::testing::ElementsAreArray(exp));
+    } else {
+      IdTable table{2, ad_utility::testing::makeAllocator()};
+      for (const auto& pair : res.idTables()) {
+        table.insertAtEnd(pair.idTable_);
+      }
+      EXPECT_THAT(table, ::testing::ElementsAreArray(exp));
+    }
+  }
+}
+
 // Test that the graphs by which an `IndexScan` is to be filtered is correctly
 // reflected in its cache key and its `ScanSpecification`.
 TEST(IndexScan, namedGraphs) {
@@ -493,6 +533,32 @@ TEST(IndexScan, namedGraphs) {
               Eq(IndexScan::Graphs::Blacklist(defaultGraph)));
 }
 
+// _____________________________________________________________________________
+TEST(IndexScan, bytesReadAreStoredInRuntimeInfo) {
+  auto qec = getQec("<x> <p> <s1>, <s2>. <x> <p2> <s1>.");
+  for (auto mode : {ComputationMode::FULLY_MATERIALIZED,
+                    ComputationMode::LAZY_IF_SUPPORTED}) {
+    // Make sure that the blocks are actually read from the file.
+    qec->clearCacheUnpinnedOnly();
+    DecompressedBlockCache::get().clear();
+    IndexScan scan{qec, Permutation::Enum::PSO,
+                   SparqlTripleSimple{Var{"?x"}, Var{"?y"}, Var{"?z"}}};
+    auto result = scan.getResult(false, mode);
+    if (!result->isFullyMaterialized()) {
+      for ([[maybe_unused]] const auto& pair : result->idTables()) {
+      }
+    }
+    const auto& rti = scan.runtimeInfo();
+    EXPECT_GT(rti.numBytesRead_, 0);
+    // At least the three scanned columns of the three triples were
+    // decompressed.
+    EXPECT_GE(rti.numBytesDecompressed_, 3 * 3 * sizeof(Id));
+    auto counters = rti.getSubtreeCounters();
+    EXPECT_EQ(counters.numBytesRead_, rti.numBytesRead_);
+    EXPECT_EQ(counters.numCacheMisses_, 1);
+  }
+}
+
 // _____________________________________________________________________________
 TEST(IndexScan, getResultSizeOfScan) {
   auto qec = getQec("<x> <p> <s1>, <s2>. <x> <p2> <s1>.");
@@ -880,15 +946,15 @@ TEST(IndexScan, checkEvaluationWithPrefiltering) {
 
   // For the following tests, the first sorted column given the permutation
   // doesn't match with the corresponding column for the Variable of the
-  // <PrefilterExpression, Variable> pair. We expect that the provided prefilter
-  // is not applicable (and can't be set).
+  // <PrefilterExpression, Variable> pair. The prefilter is then applied using
+  // the per-block column statistics. None of the blocks contains matching
+  // values, so all of them are pruned.
+  testSetAndMakeScanWithPrefilterExpr(kg, triple, Permutation::PSO,
+                                      pr(gt(IntId(1000)), Variable{"?price"}),
+                                      {}, true);
   testSetAndMakeScanWithPrefilterExpr(
-      kg, triple, Permutation::PSO,
-      pr(andExpr(gt(DoubleId(12.00)), le(IntId(174))), Variable{"?price"}), {},
-      false);
-  testSetAndMakeScanWithPrefilterExpr(
-      kg, triple, Permutation::POS,
-      pr(andExpr(gt(VocabId(0)), lt(VocabId(100))), Variable{"?x"}), {}, false);
+      kg, triple, Permutation::POS, pr(lt(VocabId(0)), Variable{"?x"}), {},
+      true);
 
   // This knowledge graph yields an incomplete first and last block.
   std::string kgFirstAndLastIncomplete =
@@ -2141,6 +2207,35 @@ TEST_P(IndexScanWithLazyJoin, prefilterTablesDoesEventuallyPushDummyBlock) {
   }
 }
 
+// _____________________________________________________________________________
+TEST(IndexScan, costEstimateIncludesRowsOfPartialBlocks) {
+  using namespace ad_utility::memory_literals;
+  TestIndexConfig config;
+  config.turtleInput = "<x> <p> <s1>, <s2>. <x> <p2> <s1>.";
+  // All the triples of a permutation are stored in a single block.
+  config.blocksizePermutations = 1_MB;
+  auto* qec = getQec(std::move(config));
+  using V = Variable;
+  using I = TripleComponent::Iri;
+
+  // The result has two rows, but the complete block has to be decompressed.
+  IndexScan scan{qec, Permutation::Enum::PSO,
+                 SparqlTripleSimple{V{"?x"}, I::fromIriref("<p>"), V{"?y"}}};
+  EXPECT_EQ(scan.getExactSize(), 2);
+  EXPECT_EQ(scan.getCostEstimate(), 3);
+
+  // For a full scan, the block consists of exactly the result.
+  IndexScan fullScan{qec, Permutation::Enum::PSO,
+                     SparqlTripleSimple{V{"?x"}, V{"?y"}, V{"?z"}}};
+  EXPECT_EQ(fullScan.getCostEstimate(), fullScan.getSizeEstimate());
+
+  // The cost is never smaller than the size of the result.
+  IndexScan empty{
+      qec, Permutation::Enum::PSO,
+      SparqlTripleSimple{V{"?x"}, I::fromIriref("<notInIndex>"), V{"?y"}}};
+  EXPECT_EQ(empty.getCostEstimate(), 0);
+}
+
 // _____________________________________________________________________________
 TEST(IndexScan, additionalVariablesInDescriptor) {
   auto* qec = getQec();
@@ -2154,3 +2249,40 @@ TEST(IndexScan, additionalVariablesInDescriptor) {
           Var{"?s"}, Var{"?p"}, Var{"?o"}, {std::pair{3, Var{"?g"}}}}};
   EXPECT_EQ(scan2.getDescriptor(), "IndexScan PSO ?s ?p ?o ?g");
 }
+
+// _____________________________________________________________________________
+TEST(IndexScan, getDistinctValueSketch) {
+  auto* qec = getQec("<x> <p> <o1>, <o2>. <y> <p> <o1>. <z> <p2> <o3>.");
+  using I = TripleComponent::Iri;
+  auto p = I::fromIriref("<p>");
+  auto estimate = [](const ad_utility::HyperLogLog* sketch) {
+    EXPECT_NE(sketch, nullptr);
+    return sketch ? std::round(sketch->estimate()) : -1.0;
+  };
+
+  // For `?s <p> ?o` the sketches of the subjects and objects of `<p>` are
+  // returned, both contain two distinct values.
+  SparqlTripleSimple triple{Var{"?s"}, p, Var{"?o"}};
+  IndexScan pso{qec, Permutation::PSO, triple};
+  IndexScan pos{qec, Permutation::POS, triple};
+  EXPECT_EQ(estimate(pso.getDistinctValueSketch(0)), 2.0);
+  EXPECT_EQ(estimate(pso.getDistinctValueSketch(1)), 2.0);
+  EXPECT_EQ(pso.getDistinctValueSketch(0), pos.getDistinctValueSketch(1));
+  EXPECT_EQ(pso.getDistinctValueSketch(1), pos.getDistinctValueSketch(0));
+  EXPECT_NE(pso.getDistinctValueSketch(0), pso.getDistinctValueSketch(1));
+  EXPECT_EQ(pso.getDistinctValueSketch(2), nullptr);
+
+  // Scans with fewer or more variables, or with a predicate that is not
+  // contained in the index have no sketches.
+  IndexScan oneVariable{
+      qec, Permutation::PSO,
+      SparqlTripleSimple{Var{"?s"}, p, I::fromIriref("<o1>")}};
+  EXPECT_EQ(oneVariable.getDistinctValueSketch(0), nullptr);
+  IndexScan fullScan{qec, Permutation::PSO,
+                     SparqlTripleSimple{Var{"?s"}, Var{"?p"}, Var{"?o"}}};
+  EXPECT_EQ(fullScan.getDistinctValueSketch(0), nullptr);
+  IndexScan unknownPredicate{
+      qec, Permutation::PSO,
+      SparqlTripleSimple{Var{"?s"}, I::fromIriref("<notInIndex>"), Var{"?o"}}};
+  EXPECT_EQ(unknownPredicate.getDistinctValueSketch(0), nullptr);
+}
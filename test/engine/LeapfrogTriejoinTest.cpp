@@ -0,0 +1,225 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "engine/IndexScan.h"
+#include "engine/LeapfrogTriejoin.h"
+#include "engine/QueryPlanner.h"
+#include "engine/ValuesForTesting.h"
+#include "parser/SparqlParser.h"
+
+namespace {
+using V = Variable;
+using ::testing::ElementsAre;
+
+// Return a `ValuesForTesting` with the given `rows` and `variables`.
+std::shared_ptr<QueryExecutionTree> makeChild(QueryExecutionContext* qec,
+                                              const VectorTable& rows,
+                                              std::array<V, 2> variables) {
+  auto table = makeIdTableFromVector(rows);
+  table.setNumColumns(2);
+  return ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(table),
+      std::vector<std::optional<V>>{variables[0], variables[1]});
+}
+
+// Compute the result of the triangle query `?x <p> ?y . ?y <p> ?z . ?z <p> ?x`
+// on the `qec` and return it as sorted rows for the variables `?x ?y ?z`.
+std::vector<std::array<Id, 3>> computeTriangles(QueryExecutionContext* qec) {
+  EncodedIriManager encodedIriManager;
+  auto query = SparqlParser::parseQuery(
+      &encodedIriManager,
+      "SELECT ?x ?y ?z { ?x <p> ?y . ?y <p> ?z . ?z <p> ?x }");
+  QueryPlanner qp{qec, std::make_shared<ad_utility::CancellationHandle<>>()};
+  auto qet = qp.createExecutionTree(query);
+  auto result = qet.getResult();
+  const auto& idTable = result->idTable();
+  std::array<ColumnIndex, 3> columns{qet.getVariableColumn(V{"?x"}),
+                                     qet.getVariableColumn(V{"?y"}),
+                                     qet.getVariableColumn(V{"?z"})};
+  std::vector<std::array<Id, 3>> rows;
+  for (const auto& row : idTable) {
+    rows.push_back({row[columns[0]], row[columns[1]], row[columns[2]]});
+  }
+  ql::ranges::sort(rows);
+  return rows;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, triangle) {
+  auto qec = ad_utility::testing::getQec();
+  V a{"?a"};
+  V b{"?b"};
+  V c{"?c"};
+  // The third child has its variables in the reverse order and is unsorted,
+  // so it has to be sorted by the join.
+  LeapfrogTriejoin::Children children{
+      makeChild(qec, {{1, 2}, {1, 3}, {2, 3}, {4, 5}}, {a, b}),
+      makeChild(qec, {{2, 3}, {3, 1}, {3, 4}, {5, 4}}, {b, c}),
+      makeChild(qec, {{3, 1}, {1, 2}, {4, 4}, {4, 1}}, {c, a})};
+  LeapfrogTriejoin join{qec, std::move(children), {a, b, c}};
+  EXPECT_EQ(join.getResultWidth(), 3);
+  EXPECT_THAT(join.getResultSortedOn(), ElementsAre(0, 1, 2));
+  EXPECT_EQ(join.getExternallyVisibleVariableColumns().at(c).columnIndex_, 2);
+  EXPECT_THAT(join.getDescriptor(), ::testing::HasSubstr("?a ?b ?c"));
+
+  auto result = join.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(), makeIdTableFromVector({{1, 2, 3},
+                                                     {1, 3, 4},
+                                                     {2, 3, 1},
+                                                     {4, 5, 4}}));
+
+  // The clone computes the same result.
+  auto clone = join.clone();
+  EXPECT_EQ(clone->getCacheKey(), join.getCacheKey());
+  EXPECT_EQ(clone->computeResultOnlyForTesting().idTable(), result.idTable());
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, duplicatesAndEmptyInputs) {
+  auto qec = ad_utility::testing::getQec();
+  V a{"?a"};
+  V b{"?b"};
+  V c{"?c"};
+  // The rows `{1, 2}` and `{2, 3}` are contained twice, so the row
+  // `{1, 2, 3}` of the result is contained four times.
+  auto makeChildren = [&](VectorTable third) {
+    return LeapfrogTriejoin::Children{
+        makeChild(qec, {{1, 2}, {1, 2}, {1, 4}}, {a, b}),
+        makeChild(qec, {{2, 3}, {2, 3}, {4, 5}}, {b, c}),
+        makeChild(qec, std::move(third), {a, c})};
+  };
+  LeapfrogTriejoin join{qec, makeChildren({{1, 3}, {1, 5}}), {a, b, c}};
+  EXPECT_EQ(join.computeResultOnlyForTesting().idTable(),
+            makeIdTableFromVector({{1, 2, 3},
+                                   {1, 2, 3},
+                                   {1, 2, 3},
+                                   {1, 2, 3},
+                                   {1, 4, 5}}));
+
+  LeapfrogTriejoin emptyJoin{qec, makeChildren({}), {a, b, c}};
+  EXPECT_TRUE(emptyJoin.knownEmptyResult());
+  EXPECT_EQ(emptyJoin.getSizeEstimate(), 0);
+  EXPECT_TRUE(emptyJoin.computeResultOnlyForTesting().idTable().empty());
+
+  // There is no match for the second variable.
+  LeapfrogTriejoin noMatch{qec, makeChildren({{1, 7}}), {a, b, c}};
+  EXPECT_TRUE(noMatch.computeResultOnlyForTesting().idTable().empty());
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, invalidChildren) {
+  auto qec = ad_utility::testing::getQec();
+  V a{"?a"};
+  V b{"?b"};
+  auto makeChildren = [&]() {
+    return LeapfrogTriejoin::Children{makeChild(qec, {{1, 2}}, {a, b})};
+  };
+  // A variable of a child that is missing in the variable order.
+  EXPECT_ANY_THROW(LeapfrogTriejoin(qec, makeChildren(), {a}));
+  // A variable that is not contained in any child.
+  EXPECT_ANY_THROW(LeapfrogTriejoin(qec, makeChildren(), {a, b, V{"?c"}}));
+  // Duplicate variables.
+  EXPECT_ANY_THROW(LeapfrogTriejoin(qec, makeChildren(), {a, b, a}));
+  // A child with a single column.
+  auto singleColumn = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{1}}), std::vector<std::optional<V>>{a});
+  EXPECT_ANY_THROW(LeapfrogTriejoin(qec, {singleColumn}, {a}));
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, computeVariableOrder) {
+  V a{"?a"};
+  V b{"?b"};
+  V c{"?c"};
+  V d{"?d"};
+  // `?b` has the highest degree, `?d` has two relations to `?b`, and the tie
+  // between `?a` and `?c` is broken by the order of the first occurrence.
+  EXPECT_THAT(LeapfrogTriejoin::computeVariableOrder(
+                  {{a, b}, {b, c}, {c, a}, {b, d}, {d, b}}),
+              ElementsAre(b, d, a, c));
+  EXPECT_THAT(
+      LeapfrogTriejoin::computeVariableOrder({{a, b}, {b, c}, {c, a}}),
+      ElementsAre(a, b, c));
+  EXPECT_THAT(LeapfrogTriejoin::computeVariableOrder({{d, c}, {c, b}, {a, b}}),
+              ElementsAre(c, b, d, a));
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, sizeEstimate) {
+  auto qec = ad_utility::testing::getQec();
+  V a{"?a"};
+  V b{"?b"};
+  V c{"?c"};
+  VectorTable rows;
+  for (int64_t i = 0; i < 100; ++i) {
+    rows.push_back({i, i + 1});
+  }
+  // For a triangle each child gets the weight 1/2, so the estimate is
+  // `sqrt(100 * 100 * 100)`.
+  LeapfrogTriejoin triangle{qec,
+                            {makeChild(qec, rows, {a, b}),
+                             makeChild(qec, rows, {b, c}),
+                             makeChild(qec, rows, {c, a})},
+                            {a, b, c}};
+  EXPECT_NEAR(static_cast<double>(triangle.getSizeEstimate()), 1000.0, 1.0);
+  EXPECT_GE(triangle.getCostEstimate(), 1300);
+  EXPECT_GE(triangle.getMultiplicity(0), 1.0f);
+  EXPECT_FALSE(triangle.knownEmptyResult());
+
+  // For a path each child gets the weight 1.
+  LeapfrogTriejoin path{
+      qec, {makeChild(qec, rows, {a, b}), makeChild(qec, rows, {b, c})},
+      {a, b, c}};
+  EXPECT_NEAR(static_cast<double>(path.getSizeEstimate()), 10'000.0, 1.0);
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, indexScansAndQueryPlanner) {
+  std::string kg =
+      "<a> <p> <b> . <b> <p> <c> . <c> <p> <a> . <a> <p> <c> . <c> <p> <d> . "
+      "<d> <p> <a> . <b> <p> <d> .";
+  auto qec = ad_utility::testing::getQec(kg);
+  auto expected = [&]() {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::useWorstCaseOptimalJoin_>(false);
+    return computeTriangles(qec);
+  }();
+  EXPECT_EQ(expected.size(), 9);
+  {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::useWorstCaseOptimalJoin_>(true);
+    qec->clearCacheUnpinnedOnly();
+    EXPECT_EQ(computeTriangles(qec), expected);
+  }
+
+  // The join directly on index scans.
+  V x{"?x"};
+  V y{"?y"};
+  V z{"?z"};
+  auto makeScan = [&](V s, V o) {
+    return ad_utility::makeExecutionTree<IndexScan>(
+        qec, Permutation::PSO,
+        SparqlTripleSimple{s, TripleComponent::Iri::fromIriref("<p>"), o});
+  };
+  LeapfrogTriejoin join{
+      qec, {makeScan(x, y), makeScan(y, z), makeScan(z, x)}, {x, y, z}};
+  auto result = join.computeResultOnlyForTesting();
+  ASSERT_EQ(result.idTable().numRows(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    const auto& row = result.idTable()[i];
+    EXPECT_EQ((std::array{row[0], row[1], row[2]}), expected[i]);
+  }
+}
@@ -0,0 +1,88 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "engine/MaterializedViewAdvisor.h"
+#include "engine/QueryPlanner.h"
+#include "parser/SparqlParser.h"
+
+namespace {
+constexpr std::string_view query = "SELECT * { ?x <p> ?y . ?y <p> ?z }";
+
+// Plan and execute the `query` and record it in the `advisor`. Return the
+// cache key of the root of the query plan.
+std::string executeAndRecord(QueryExecutionContext* qec,
+                             MaterializedViewAdvisor& advisor) {
+  EncodedIriManager encodedIriManager;
+  auto parsedQuery =
+      SparqlParser::parseQuery(&encodedIriManager, std::string{query});
+  QueryPlanner qp{qec, std::make_shared<ad_utility::CancellationHandle<>>()};
+  auto qet = qp.createExecutionTree(parsedQuery);
+  qet.getResult();
+  advisor.recordQuery(qet, query);
+  return qet.getCacheKey();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(MaterializedViewAdvisor, recommendRecomputedSubtrees) {
+  auto qec = ad_utility::testing::getQec(
+      "<a> <p> <b> . <b> <p> <c> . <c> <p> <d> . <b> <p> <d> .");
+  qec->clearCacheUnpinnedOnly();
+  MaterializedViewAdvisor advisor;
+  auto budget = ad_utility::MemorySize::gigabytes(1);
+
+  // Only the join is recorded, the index scans are leaves. A subtree that was
+  // computed only once is not recommended.
+  auto cacheKey = executeAndRecord(qec, advisor);
+  EXPECT_EQ(advisor.numCandidates(), 1);
+  EXPECT_TRUE(advisor.recommendations(budget, 10).empty());
+
+  // The result of the second execution is read from the cache, so it doesn't
+  // count.
+  executeAndRecord(qec, advisor);
+  EXPECT_TRUE(advisor.recommendations(budget, 10).empty());
+
+  // After the result was evicted from the cache, it is computed again.
+  qec->clearCacheUnpinnedOnly();
+  EXPECT_EQ(executeAndRecord(qec, advisor), cacheKey);
+  auto recommendations = advisor.recommendations(budget, 10);
+  ASSERT_EQ(recommendations.size(), 1);
+  const auto& candidate = recommendations.front();
+  EXPECT_EQ(candidate.cacheKey_, cacheKey);
+  EXPECT_EQ(candidate.exampleQuery_, query);
+  EXPECT_EQ(candidate.numComputations_, 2);
+  EXPECT_EQ(candidate.numRows_, 3);
+  EXPECT_EQ(candidate.numCols_, 3);
+  EXPECT_EQ(candidate.estimatedSize(),
+            ad_utility::MemorySize::bytes(3 * 3 * sizeof(Id)));
+  EXPECT_LE(candidate.savedTime(), candidate.totalComputationTime_);
+  nlohmann::json json = candidate;
+  EXPECT_EQ(json["num-computations"], 2);
+  EXPECT_EQ(json["example-query"], std::string{query});
+
+  // The candidates have to fit into the budget, and their number is limited.
+  EXPECT_TRUE(
+      advisor.recommendations(ad_utility::MemorySize::bytes(10), 10).empty());
+  EXPECT_TRUE(advisor.recommendations(budget, 0).empty());
+
+  advisor.clear();
+  EXPECT_EQ(advisor.numCandidates(), 0);
+
+  // With a maximum of zero candidates, nothing is recorded.
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::materializedViewAdvisorMaxNumCandidates_>(0);
+  qec->clearCacheUnpinnedOnly();
+  executeAndRecord(qec, advisor);
+  EXPECT_EQ(advisor.numCandidates(), 0);
+}
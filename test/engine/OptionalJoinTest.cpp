@@ -707,6 +707,57 @@ TEST(OptionalJoin, lazyOptionalJoinWithOneMaterializedTable) {
   }
 }
 
+// _____________________________________________________________________________
+TEST(OptionalJoin, rightHasAtMostOneRow) {
+  // Materialized inputs.
+  testOptionalJoin(
+      makeIdTableFromVector({{1, 10}, {2, 11}, {3, 12}}),
+      makeIdTableFromVector({{2, 20}}), {{0, 0}},
+      makeIdTableFromVector({{1, 10, U}, {2, 11, 20}, {3, 12, U}}));
+  // An UNDEF value in the right row matches all the rows.
+  testOptionalJoin(makeIdTableFromVector({{U, 10}, {2, 11}}),
+                   makeIdTableFromVector({{U, 20}}), {{0, 0}},
+                   makeIdTableFromVector({{U, 10, 20}, {2, 11, 20}}));
+
+  // A lazy left input is processed block by block.
+  auto qec = ad_utility::testing::getQec();
+  std::vector<IdTable> rightTables;
+  rightTables.push_back(makeIdTableFromVector({{2, 20}}));
+  rightTables.push_back(makeIdTableFromVector({{U, 20}}));
+  rightTables.push_back(IdTable(2, makeAllocator()));
+  for (auto& rightTable : rightTables) {
+    std::vector<IdTable> leftTables;
+    leftTables.push_back(makeIdTableFromVector({{1, 10}, {2, 11}}));
+    leftTables.push_back(makeIdTableFromVector({{3, 12}}));
+    auto left = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(leftTables),
+        std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"}},
+        false, std::vector<ColumnIndex>{0});
+    auto isEmpty = rightTable.empty();
+    auto isUndef = !isEmpty && rightTable(0, 0).isUndefined();
+    auto right = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(rightTable),
+        std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?z"}},
+        false, std::vector<ColumnIndex>{0}, LocalVocab{}, std::nullopt, true);
+    OptionalJoin opt{qec, left, right};
+    qec->getQueryTreeCache().clearAll();
+
+    auto result = opt.computeResultOnlyForTesting(true);
+    ASSERT_FALSE(result.isFullyMaterialized());
+    std::vector<IdTable> actual;
+    for (auto& [idTable, _] : result.idTables()) {
+      actual.push_back(std::move(idTable));
+    }
+    Id z = Id::makeFromInt(20);
+    std::vector<IdTable> expected;
+    expected.push_back(makeIdTableFromVector(
+        {{1, 10, isUndef ? z : U}, {2, 11, isEmpty ? U : z}}));
+    expected.push_back(makeIdTableFromVector({{3, 12, isUndef ? z : U}}));
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(opt.runtimeInfo().details_["right-has-at-most-one-row"], true);
+  }
+}
+
 // _____________________________________________________________________________
 TEST(OptionalJoin, lazyOptionalJoinExceedingChunkSize) {
   std::vector<IdTable> expected;
@@ -0,0 +1,132 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <absl/strings/str_cat.h>
+
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "engine/QueryPlanCache.h"
+#include "engine/QueryPlanner.h"
+#include "parser/SparqlParser.h"
+
+namespace {
+ParsedQuery parseQuery(std::string query,
+                       const std::vector<DatasetClause>& datasets = {}) {
+  static EncodedIriManager encodedIriManager;
+  return SparqlParser::parseQuery(&encodedIriManager, std::move(query),
+                                  datasets);
+}
+
+// Create a new `QueryExecutionContext` that shares the index and the caches
+// with the context of `getQec()`.
+std::shared_ptr<QueryExecutionContext> makeQec() {
+  return std::make_shared<QueryExecutionContext>(
+      *ad_utility::testing::getQec());
+}
+
+const std::string query = "SELECT ?x ?y { ?x <x> ?y . ?y <x> ?z }";
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, isCacheable) {
+  EXPECT_TRUE(QueryPlanCache::isCacheable(query));
+  EXPECT_TRUE(QueryPlanCache::isCacheable("SELECT * { ?s <now> ?known }"));
+  EXPECT_TRUE(QueryPlanCache::isCacheable("SELECT * { ?s ?p ?o } ORDER BY ?o"));
+  EXPECT_TRUE(QueryPlanCache::isCacheable("SELECT (unknown(?x) AS ?y) {}"));
+  EXPECT_FALSE(QueryPlanCache::isCacheable("SELECT (NOW() AS ?x) {}"));
+  EXPECT_FALSE(QueryPlanCache::isCacheable("SELECT (rand () AS ?x) {}"));
+  EXPECT_FALSE(QueryPlanCache::isCacheable("SELECT (STRUUID() AS ?x) {}"));
+  EXPECT_FALSE(QueryPlanCache::isCacheable("SELECT (BNODE(?x) AS ?y) {}"));
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, keys) {
+  using Iri = TripleComponent::Iri;
+  auto key = QueryPlanCache::parseKey(query, {});
+  ASSERT_TRUE(key.has_value());
+  EXPECT_EQ(QueryPlanCache::parseKey(absl::StrCat("  ", query, "\n"), {}),
+            key);
+  std::vector<DatasetClause> datasets{
+      {Iri::fromIriref("<default>"), false}};
+  EXPECT_NE(QueryPlanCache::parseKey(query, datasets), key);
+  datasets.front().isNamed_ = true;
+  EXPECT_NE(QueryPlanCache::parseKey(query, datasets),
+            QueryPlanCache::parseKey(query, {}));
+  EXPECT_FALSE(QueryPlanCache::parseKey("SELECT (NOW() AS ?x) {}", {}));
+
+  // The plan key contains the dataset clauses from the URL parameters as well
+  // as the ones from the query.
+  auto planKey = QueryPlanCache::planKey(parseQuery(query));
+  ASSERT_TRUE(planKey.has_value());
+  EXPECT_EQ(QueryPlanCache::planKey(parseQuery(query)), planKey);
+  EXPECT_NE(QueryPlanCache::planKey(parseQuery(query, datasets)), planKey);
+  EXPECT_FALSE(QueryPlanCache::planKey(parseQuery("SELECT (NOW() AS ?x) {}")));
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, parsedQueries) {
+  QueryPlanCache cache{makeQec()};
+  EXPECT_FALSE(cache.getParsedQuery("key").has_value());
+  cache.storeParsedQuery("key", parseQuery(query));
+  auto cached = cache.getParsedQuery("key");
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->_originalString, query);
+  // Storing the same key twice is allowed.
+  cache.storeParsedQuery("key", parseQuery(query));
+
+  // With a maximal number of zero entries, nothing is cached.
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::queryPlanCacheMaxNumEntries_>(0);
+  cache.storeParsedQuery("other", parseQuery(query));
+  EXPECT_FALSE(cache.getParsedQuery("other").has_value());
+  EXPECT_FALSE(cache.getParsedQuery("key").has_value());
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, plans) {
+  QueryPlanCache cache{makeQec()};
+  auto qec = makeQec();
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  auto parsedQuery = parseQuery(query);
+  auto key = QueryPlanCache::planKey(parsedQuery).value();
+  EXPECT_FALSE(cache.getPlan(key, *qec).has_value());
+
+  QueryPlanner qp{qec.get(), handle};
+  auto tree = qp.createExecutionTree(parsedQuery);
+  cache.storePlan(key, parsedQuery, tree, *qec);
+  EXPECT_EQ(cache.numPlans(), 1);
+
+  // The plan can be reused by a different query with a different context.
+  auto otherQec = makeQec();
+  auto plan = cache.getPlan(key, *otherQec);
+  ASSERT_TRUE(plan.has_value());
+  auto& cachedTree = plan->queryExecutionTree_;
+  EXPECT_EQ(cachedTree.getCacheKey(), tree.getCacheKey());
+  EXPECT_EQ(cachedTree.getQec(), otherQec.get());
+  cachedTree.forAllDescendants([&otherQec](const QueryExecutionTree* child) {
+    EXPECT_EQ(child->getQec(), otherQec.get());
+    EXPECT_EQ(child->getRootOperation()->getExecutionContext(),
+              otherQec.get());
+  });
+  EXPECT_NE(cachedTree.getRootOperation(), tree.getRootOperation());
+  EXPECT_NE(cachedTree.getRootOperation()->getRuntimeInfoPointer(),
+            tree.getRootOperation()->getRuntimeInfoPointer());
+  EXPECT_EQ(plan->parsedQuery_._originalString, query);
+  EXPECT_EQ(cachedTree.getResult()->idTable(), tree.getResult()->idTable());
+
+  // A change of the named result cache invalidates the plan.
+  qec->namedResultCache().clear();
+  EXPECT_FALSE(cache.getPlan(key, *otherQec).has_value());
+  EXPECT_EQ(cache.numPlans(), 0);
+
+  cache.storePlan(key, parsedQuery, tree, *qec);
+  EXPECT_TRUE(cache.getPlan(key, *otherQec).has_value());
+  cache.clear();
+  EXPECT_FALSE(cache.getPlan(key, *otherQec).has_value());
+}
@@ -0,0 +1,127 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "engine/QueryResultDiskCache.h"
+
+using namespace ad_utility::memory_literals;
+
+namespace {
+class QueryResultDiskCacheTest : public ::testing::Test {
+ protected:
+  std::filesystem::path directory_ =
+      std::filesystem::temp_directory_path() / "QueryResultDiskCacheTest";
+  ad_utility::AllocatorWithLimit<Id> alloc_{
+      ad_utility::makeUnlimitedAllocator<Id>()};
+
+  void SetUp() override { std::filesystem::remove_all(directory_); }
+  void TearDown() override { std::filesystem::remove_all(directory_); }
+
+  Result makeResult(const VectorTable& rows,
+                    std::vector<ColumnIndex> sortedBy = {}) const {
+    return Result{makeIdTableFromVector(rows), std::move(sortedBy),
+                  LocalVocab{}};
+  }
+
+  size_t numFiles() const {
+    return static_cast<size_t>(
+        std::distance(std::filesystem::directory_iterator{directory_},
+                      std::filesystem::directory_iterator{}));
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST_F(QueryResultDiskCacheTest, storeAndLoad) {
+  QueryResultDiskCache cache{directory_, "index1"};
+  EXPECT_FALSE(cache.load("key1", alloc_).has_value());
+  EXPECT_EQ(cache.sizeOnDisk(), 0_B);
+
+  cache.store("key1", makeResult({{1, 2}, {3, 4}}, {0}), 1_GB);
+  cache.store("key2", makeResult({{5}}), 1_GB);
+  EXPECT_EQ(numFiles(), 2);
+  EXPECT_GT(cache.sizeOnDisk(), 0_B);
+
+  auto result = cache.load("key1", alloc_);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->idTable(), makeIdTableFromVector({{1, 2}, {3, 4}}));
+  EXPECT_THAT(result->sortedBy(), ::testing::ElementsAre(0));
+  EXPECT_TRUE(result->localVocab().empty());
+  EXPECT_EQ(cache.load("key2", alloc_)->idTable(),
+            makeIdTableFromVector({{5}}));
+  EXPECT_FALSE(cache.load("key3", alloc_).has_value());
+
+  // The results survive a restart.
+  QueryResultDiskCache restarted{directory_, "index1"};
+  ASSERT_TRUE(restarted.load("key1", alloc_).has_value());
+
+  // Results that were written for a different index are removed.
+  QueryResultDiskCache otherIndex{directory_, "index2"};
+  EXPECT_FALSE(otherIndex.load("key1", alloc_).has_value());
+  EXPECT_FALSE(restarted.load("key1", alloc_).has_value());
+  EXPECT_EQ(numFiles(), 1);
+
+  restarted.clear();
+  EXPECT_EQ(numFiles(), 0);
+  EXPECT_FALSE(restarted.load("key2", alloc_).has_value());
+}
+
+// _____________________________________________________________________________
+TEST_F(QueryResultDiskCacheTest, canBeStored) {
+  EXPECT_TRUE(QueryResultDiskCache::canBeStored(makeResult({{1}})));
+  LocalVocab localVocab;
+  localVocab.getIndexAndAddIfNotContained(LocalVocabEntry::fromIriref(
+      "<x>", ad_utility::testing::getQec()->getLocalVocabContext()));
+  Result withLocalVocab{makeIdTableFromVector({{1}}), {},
+                        std::move(localVocab)};
+  EXPECT_FALSE(QueryResultDiskCache::canBeStored(withLocalVocab));
+  QueryResultDiskCache cache{directory_, "index"};
+  EXPECT_ANY_THROW(cache.store("key", withLocalVocab, 1_GB));
+}
+
+// _____________________________________________________________________________
+TEST_F(QueryResultDiskCacheTest, corruptFilesAreRemoved) {
+  QueryResultDiskCache cache{directory_, "index"};
+  cache.store("key", makeResult({{1, 2}}), 1_GB);
+  ASSERT_EQ(numFiles(), 1);
+  auto path = std::filesystem::directory_iterator{directory_}->path();
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+  EXPECT_FALSE(cache.load("key", alloc_).has_value());
+  EXPECT_EQ(numFiles(), 0);
+
+  // After the removal, the result can be stored again.
+  cache.store("key", makeResult({{1, 2}}), 1_GB);
+  EXPECT_TRUE(cache.load("key", alloc_).has_value());
+}
+
+// _____________________________________________________________________________
+TEST_F(QueryResultDiskCacheTest, leastRecentlyUsedFilesAreRemoved) {
+  QueryResultDiskCache cache{directory_, "index"};
+  cache.store("key1", makeResult({{1, 2, 3}}), 1_GB);
+  auto sizeOfOneResult = cache.sizeOnDisk();
+  cache.store("key2", makeResult({{4, 5, 6}}), 1_GB);
+
+  // Make sure that `key1` was used more recently than `key2`.
+  auto now = std::filesystem::file_time_type::clock::now();
+  for (const auto& entry : std::filesystem::directory_iterator{directory_}) {
+    std::filesystem::last_write_time(entry.path(), now - std::chrono::hours(1));
+  }
+  ASSERT_TRUE(cache.load("key1", alloc_).has_value());
+
+  // Storing a third result with room for only two results removes `key2`.
+  cache.store("key3", makeResult({{7, 8, 9}}), sizeOfOneResult * 2);
+  EXPECT_EQ(numFiles(), 2);
+  EXPECT_TRUE(cache.load("key1", alloc_).has_value());
+  EXPECT_FALSE(cache.load("key2", alloc_).has_value());
+  EXPECT_TRUE(cache.load("key3", alloc_).has_value());
+}
@@ -0,0 +1,110 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "engine/ResultCursors.h"
+
+using ad_utility::MemorySize;
+using ::testing::HasSubstr;
+
+namespace {
+// A cursor result with a table of `numRows` rows and one column, the rows
+// `[beginRow, endRow)` of which belong to the result.
+ResultCursors::CursorResult makeResult(size_t numRows, size_t beginRow,
+                                       size_t endRow) {
+  VectorTable rows;
+  for (size_t i = 0; i < numRows; ++i) {
+    rows.push_back({static_cast<int64_t>(i)});
+  }
+  auto table = std::make_shared<const IdTable>(makeIdTableFromVector(rows));
+  return {ParsedQuery{}, std::move(table), {}, {}, LocalVocab{}, beginRow,
+          endRow};
+}
+
+constexpr auto budget = MemorySize::megabytes(1);
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ResultCursors, fetchPages) {
+  ResultCursors cursors;
+  auto id = cursors.create(makeResult(10, 2, 9), budget);
+  EXPECT_EQ(cursors.numCursors(), 1);
+  EXPECT_EQ(cursors.memoryInUse(), MemorySize::bytes(10 * sizeof(Id)));
+
+  auto page = cursors.fetch(id, 3);
+  EXPECT_EQ(page.beginRow_, 2);
+  EXPECT_EQ(page.endRow_, 5);
+  EXPECT_TRUE(page.hasMoreRows_);
+  EXPECT_EQ(page.result_->table_->numRows(), 10);
+
+  page = cursors.fetch(id, 3);
+  EXPECT_EQ(page.beginRow_, 5);
+  EXPECT_EQ(page.endRow_, 8);
+  EXPECT_TRUE(page.hasMoreRows_);
+
+  // The last page is shorter, and the cursor is removed afterwards.
+  page = cursors.fetch(id, 3);
+  EXPECT_EQ(page.beginRow_, 8);
+  EXPECT_EQ(page.endRow_, 9);
+  EXPECT_FALSE(page.hasMoreRows_);
+  EXPECT_EQ(cursors.numCursors(), 0);
+  EXPECT_EQ(cursors.memoryInUse(), MemorySize::bytes(0));
+  AD_EXPECT_THROW_WITH_MESSAGE(cursors.fetch(id, 3),
+                               HasSubstr("There is no cursor"));
+
+  // An empty result has a single empty page.
+  id = cursors.create(makeResult(4, 4, 4), budget);
+  page = cursors.fetch(id, 3);
+  EXPECT_EQ(page.beginRow_, page.endRow_);
+  EXPECT_FALSE(page.hasMoreRows_);
+  EXPECT_EQ(cursors.numCursors(), 0);
+}
+
+// _____________________________________________________________________________
+TEST(ResultCursors, closeAndRemoveIdleCursors) {
+  ResultCursors cursors;
+  auto id1 = cursors.create(makeResult(10, 0, 10), budget);
+  auto id2 = cursors.create(makeResult(10, 0, 10), budget);
+  EXPECT_NE(id1, id2);
+  EXPECT_EQ(cursors.numCursors(), 2);
+
+  EXPECT_TRUE(cursors.close(id1));
+  EXPECT_FALSE(cursors.close(id1));
+  EXPECT_EQ(cursors.numCursors(), 1);
+
+  // The remaining cursor has been used recently.
+  cursors.removeIdleCursors(std::chrono::hours(1));
+  EXPECT_EQ(cursors.numCursors(), 1);
+  cursors.removeIdleCursors(std::chrono::seconds(0));
+  EXPECT_EQ(cursors.numCursors(), 0);
+  EXPECT_EQ(cursors.memoryInUse(), MemorySize::bytes(0));
+}
+
+// _____________________________________________________________________________
+TEST(ResultCursors, memoryBudget) {
+  ResultCursors cursors;
+  auto smallBudget = MemorySize::bytes(15 * sizeof(Id));
+  auto id = cursors.create(makeResult(10, 0, 10), smallBudget);
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      cursors.create(makeResult(10, 0, 10), smallBudget),
+      HasSubstr("does not fit into the memory that is left for cursors"));
+  EXPECT_EQ(cursors.numCursors(), 1);
+  // After the first cursor has been closed, there is enough memory.
+  cursors.close(id);
+  cursors.create(makeResult(10, 0, 10), smallBudget);
+  EXPECT_EQ(cursors.numCursors(), 1);
+
+  // The rows of the result must be contained in the table.
+  EXPECT_ANY_THROW(cursors.create(makeResult(10, 5, 11), budget));
+  EXPECT_ANY_THROW(cursors.create(makeResult(10, 6, 5), budget));
+}
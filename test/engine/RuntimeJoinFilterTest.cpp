@@ -0,0 +1,164 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../PrefilterExpressionTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "engine/Filter.h"
+#include "engine/IndexScan.h"
+#include "engine/Join.h"
+#include "engine/RuntimeJoinFilter.h"
+#include "engine/ValuesForTesting.h"
+
+namespace {
+auto I = ad_utility::testing::IntId;
+using Vars = std::vector<std::optional<Variable>>;
+
+// Return a `RuntimeJoinFilter` for the sorted `keys`.
+RuntimeJoinFilter makeFilter(const std::vector<int64_t>& keys) {
+  VectorTable input;
+  for (auto key : keys) {
+    input.push_back({key});
+  }
+  auto result = std::make_shared<const Result>(
+      makeIdTableFromVector(input, &Id::makeFromInt),
+      std::vector<ColumnIndex>{0}, LocalVocab{});
+  return RuntimeJoinFilter{std::move(result), 0};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(RuntimeJoinFilter, containsAndFilterRows) {
+  auto filter = makeFilter({2, 3, 3, 7});
+  EXPECT_EQ(filter.keys().size(), 4);
+  EXPECT_TRUE(filter.contains(I(3)));
+  EXPECT_TRUE(filter.contains(I(7)));
+  EXPECT_FALSE(filter.contains(I(1)));
+  EXPECT_FALSE(filter.contains(I(5)));
+
+  auto table = makeIdTableFromVector(
+      {{1, 10}, {2, 20}, {3, 30}, {3, 31}, {4, 40}, {7, 70}, {8, 80}},
+      &Id::makeFromInt);
+  filter.filterRows(table, 0);
+  EXPECT_EQ(table,
+            makeIdTableFromVector({{2, 20}, {3, 30}, {3, 31}, {7, 70}},
+                                  &Id::makeFromInt));
+  // All the rows match.
+  filter.filterRows(table, 0);
+  EXPECT_EQ(table.numRows(), 4);
+  // No row matches.
+  filter.filterRows(table, 1);
+  EXPECT_TRUE(table.empty());
+
+  // UNDEF values are not allowed.
+  auto undefResult = std::make_shared<const Result>(
+      makeIdTableFromVector({{Id::makeUndefined()}}),
+      std::vector<ColumnIndex>{0}, LocalVocab{});
+  EXPECT_ANY_THROW(RuntimeJoinFilter(undefResult, 0));
+}
+
+// _____________________________________________________________________________
+TEST(RuntimeJoinFilter, isPushedThroughFilterIntoIndexScan) {
+  using namespace makeSparqlExpression;
+  std::string kg;
+  for (size_t i = 0; i < 100; ++i) {
+    kg += absl::StrCat("<s", i, "> <p> ", i, " .\n");
+  }
+  auto qec = ad_utility::testing::getQec(kg);
+  // Make sure that the `FILTER` is computed lazily.
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::lazyIndexScanMaxSizeMaterialization_>(1);
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+
+  auto test = [&](size_t maxSize, bool expectFilter) {
+    auto cleanup2 = setRuntimeParameterForTest<
+        &RuntimeParameters::runtimeJoinFilterMaxSize_>(maxSize);
+    qec->getQueryTreeCache().clearAll();
+    auto scan = ad_utility::makeExecutionTree<IndexScan>(
+        qec, Permutation::PSO,
+        SparqlTripleSimple{Variable{"?s"},
+                           TripleComponent::Iri::fromIriref("<p>"),
+                           Variable{"?o"}});
+    auto filterTree = ad_utility::makeExecutionTree<Filter>(
+        qec, scan,
+        sparqlExpression::SparqlExpressionPimpl{gtSprql(Variable{"?o"}, I(5)),
+                                                "?o > 5"});
+    auto filter =
+        std::dynamic_pointer_cast<const Filter>(filterTree->getRootOperation());
+    auto filteredScan = filter->getSubtree()->getRootOperation();
+
+    // `<s3>` is removed by the `FILTER`, `<s42>` and `<s7>` are not.
+    std::vector<Id> keys{getId("<s3>"), getId("<s42>"), getId("<s7>")};
+    ql::ranges::sort(keys);
+    IdTable left{1, ad_utility::testing::makeAllocator()};
+    for (auto key : keys) {
+      left.push_back({key});
+    }
+    auto valuesTree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(left), Vars{Variable{"?s"}}, false,
+        std::vector<ColumnIndex>{0}, LocalVocab{}, std::nullopt, true);
+
+    Join join{qec, valuesTree, filterTree, 0, 0, true, false};
+    auto result = join.getResult();
+    ASSERT_TRUE(result->isFullyMaterialized());
+    EXPECT_EQ(result->idTable(),
+              makeIdTableFromVector({{getId("<s42>"), I(42)},
+                                     {getId("<s7>"), I(7)}}));
+
+    const auto& scanDetails = filteredScan->runtimeInfo().details_;
+    EXPECT_EQ(join.runtimeInfo().details_.contains("runtime-join-filter-size"),
+              expectFilter);
+    EXPECT_EQ(scanDetails.contains("runtime-join-filter-size"), expectFilter);
+    // The results that are incomplete because of the filter are not cached.
+    EXPECT_EQ(filter->canResultBeCached(), !expectFilter);
+    EXPECT_EQ(filteredScan->canResultBeCached(), !expectFilter);
+    if (expectFilter) {
+      EXPECT_EQ(scanDetails["runtime-join-filter-size"].get<size_t>(), 3);
+      // Only the rows that match the filter are yielded by the scan.
+      EXPECT_EQ(filteredScan->runtimeInfo().numRows_, 3);
+    } else {
+      EXPECT_EQ(filteredScan->runtimeInfo().numRows_, 100);
+    }
+  };
+  test(100'000, true);
+  test(3, true);
+  test(2, false);
+  test(0, false);
+}
+
+// _____________________________________________________________________________
+TEST(RuntimeJoinFilter, isNotAppliedWithLimitOrForBoundVariable) {
+  auto qec = ad_utility::testing::getQec("<x> <p> <o> .");
+  auto filter = std::make_shared<const RuntimeJoinFilter>(makeFilter({1}));
+  auto makeScan = [&]() {
+    return ad_utility::makeExecutionTree<IndexScan>(
+        qec, Permutation::PSO,
+        SparqlTripleSimple{Variable{"?s"},
+                           TripleComponent::Iri::fromIriref("<p>"),
+                           Variable{"?o"}});
+  };
+  // The scan is only sorted by `?s`.
+  EXPECT_FALSE(
+      makeScan()->getRootOperation()->addRuntimeJoinFilter(Variable{"?o"},
+                                                           filter));
+  auto scan = makeScan();
+  scan->applyLimitOffset({1});
+  EXPECT_FALSE(
+      scan->getRootOperation()->addRuntimeJoinFilter(Variable{"?s"}, filter));
+  scan = makeScan();
+  EXPECT_TRUE(
+      scan->getRootOperation()->addRuntimeJoinFilter(Variable{"?s"}, filter));
+  // A second filter is not applied.
+  EXPECT_FALSE(
+      scan->getRootOperation()->addRuntimeJoinFilter(Variable{"?s"}, filter));
+}
@@ -0,0 +1,98 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "engine/ServerMetrics.h"
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+using namespace std::chrono_literals;
+
+// _____________________________________________________________________________
+TEST(LatencyHistogram, observeAndWrite) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.count(), 0);
+  histogram.observe(3ms);
+  // A duration that is equal to a bound belongs to the bucket of that bound.
+  histogram.observe(10ms);
+  histogram.observe(2s);
+  histogram.observe(1000s);
+  EXPECT_EQ(histogram.count(), 4);
+
+  std::ostringstream os;
+  histogram.write(os, "latency", "a=\"b\"");
+  auto output = os.str();
+  EXPECT_THAT(output, HasSubstr("latency_bucket{a=\"b\",le=\"0.005\"} 1\n"));
+  EXPECT_THAT(output, HasSubstr("latency_bucket{a=\"b\",le=\"0.01\"} 2\n"));
+  EXPECT_THAT(output, HasSubstr("latency_bucket{a=\"b\",le=\"1\"} 2\n"));
+  EXPECT_THAT(output, HasSubstr("latency_bucket{a=\"b\",le=\"2.5\"} 3\n"));
+  EXPECT_THAT(output, HasSubstr("latency_bucket{a=\"b\",le=\"300\"} 3\n"));
+  EXPECT_THAT(output, HasSubstr("latency_bucket{a=\"b\",le=\"+Inf\"} 4\n"));
+  EXPECT_THAT(output, HasSubstr("latency_sum{a=\"b\"} 1002.013000\n"));
+  EXPECT_THAT(output, HasSubstr("latency_count{a=\"b\"} 4\n"));
+
+  // Without labels.
+  std::ostringstream osWithoutLabels;
+  histogram.write(osWithoutLabels, "latency", "");
+  EXPECT_THAT(osWithoutLabels.str(),
+              HasSubstr("latency_bucket{le=\"+Inf\"} 4\n"));
+  EXPECT_THAT(osWithoutLabels.str(), HasSubstr("latency_count 4\n"));
+}
+
+// _____________________________________________________________________________
+TEST(ServerMetrics, write) {
+  ServerMetrics metrics;
+  metrics.recordRequest(ServerMetrics::OperationType::Query,
+                        ad_utility::MediaType::sparqlJson, 20ms);
+  metrics.recordRequest(ServerMetrics::OperationType::Update,
+                        ad_utility::MediaType::json, 20ms);
+  metrics.queryThreadPool_.numQueued_ = 3;
+  metrics.updateThreadPool_.numRunning_ = 1;
+
+  std::ostringstream os;
+  metrics.write(os);
+  auto output = os.str();
+  EXPECT_THAT(output,
+              HasSubstr("# TYPE qlever_request_duration_seconds histogram\n"));
+  EXPECT_THAT(output, HasSubstr("qlever_request_duration_seconds_count{"
+                                "operation=\"query\",media_type=\"application/"
+                                "sparql-results+json\"} 1\n"));
+  EXPECT_THAT(output, HasSubstr("qlever_request_duration_seconds_count{"
+                                "operation=\"update\",media_type=\"application/"
+                                "json\"} 1\n"));
+  // Only the combinations that occurred are written.
+  EXPECT_THAT(output, Not(HasSubstr("operation=\"query\",media_type=\"text/"
+                                    "csv\"")));
+  EXPECT_THAT(
+      output,
+      HasSubstr("qlever_thread_pool_queued_tasks{pool=\"query\"} 3\n"
+                "qlever_thread_pool_queued_tasks{pool=\"update\"} 0\n"));
+  EXPECT_THAT(
+      output,
+      HasSubstr("qlever_thread_pool_running_tasks{pool=\"query\"} 0\n"
+                "qlever_thread_pool_running_tasks{pool=\"update\"} 1\n"));
+}
+
+// _____________________________________________________________________________
+TEST(ServerMetrics, writeMetric) {
+  std::ostringstream os;
+  ServerMetrics::writeMetric(os, "qlever_x_total", "counter", "The x.", 42);
+  ServerMetrics::writeMetric(os, "qlever_y", "gauge", "The y.", 0.25);
+  EXPECT_EQ(os.str(),
+            "# HELP qlever_x_total The x.\n"
+            "# TYPE qlever_x_total counter\n"
+            "qlever_x_total 42\n"
+            "# HELP qlever_y The y.\n"
+            "# TYPE qlever_y gauge\n"
+            "qlever_y 0.25\n");
+}
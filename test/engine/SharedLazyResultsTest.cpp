@@ -0,0 +1,187 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "engine/SharedLazyResults.h"
+
+using namespace ad_utility::memory_literals;
+
+namespace {
+const QueryCacheKey key{"key", 0};
+
+// A lazy result with `numChunks` chunks, the `i`-th of which consists of the
+// single row `i`. `numPulls` counts the chunks that are computed.
+Result::LazyResult makeSource(int64_t numChunks,
+                              std::shared_ptr<std::atomic<size_t>> numPulls) {
+  return Result::LazyResult{ad_utility::InputRangeFromGetCallable{
+      [i = int64_t{0}, numChunks, numPulls]() mutable
+          -> std::optional<Result::IdTableVocabPair> {
+        if (i == numChunks) {
+          return std::nullopt;
+        }
+        ++*numPulls;
+        return Result::IdTableVocabPair{makeIdTableFromVector({{i++}}),
+                                        LocalVocab{}};
+      }}};
+}
+
+// Consume the `lazyResult` and return the single value of each chunk.
+std::vector<int64_t> consume(Result::LazyResult& lazyResult,
+                             size_t maxNumChunks = 1000) {
+  std::vector<int64_t> result;
+  while (result.size() < maxNumChunks) {
+    auto chunk = lazyResult.get();
+    if (!chunk.has_value()) {
+      break;
+    }
+    result.push_back(chunk->idTable_(0, 0).getInt());
+  }
+  return result;
+}
+
+using ::testing::ElementsAre;
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(SharedLazyResults, joinAndReplay) {
+  SharedLazyResults shared;
+  auto numPulls = std::make_shared<std::atomic<size_t>>(0);
+  EXPECT_FALSE(shared.join(key, nullptr).has_value());
+  auto owner = shared.share(key, makeSource(3, numPulls), 1_MB);
+  EXPECT_EQ(shared.numShared(), 1);
+
+  auto early = shared.join(key, nullptr);
+  ASSERT_TRUE(early.has_value());
+  EXPECT_THAT(consume(owner, 2), ElementsAre(0, 1));
+  // A consumer that joins later gets the complete result from the beginning.
+  auto late = shared.join(key, nullptr);
+  ASSERT_TRUE(late.has_value());
+  EXPECT_THAT(consume(late.value()), ElementsAre(0, 1, 2));
+  EXPECT_THAT(consume(early.value()), ElementsAre(0, 1, 2));
+  EXPECT_THAT(consume(owner), ElementsAre(2));
+  // The source has been read only once.
+  EXPECT_EQ(*numPulls, 3);
+  // Other keys are not affected.
+  EXPECT_FALSE(shared.join(QueryCacheKey{"key", 1}, nullptr).has_value());
+}
+
+// _____________________________________________________________________________
+TEST(SharedLazyResults, replayBufferIsBounded) {
+  SharedLazyResults shared;
+  auto numPulls = std::make_shared<std::atomic<size_t>>(0);
+  {
+    auto owner = shared.share(key, makeSource(3, numPulls), 1_B);
+    auto joined = shared.join(key, nullptr);
+    ASSERT_TRUE(joined.has_value());
+    EXPECT_THAT(consume(owner, 1), ElementsAre(0));
+    // The first chunk is larger than the replay buffer, so no consumer can
+    // join anymore, but the existing consumers still get all the chunks.
+    EXPECT_FALSE(shared.join(key, nullptr).has_value());
+    EXPECT_THAT(consume(owner), ElementsAre(1, 2));
+    EXPECT_THAT(consume(joined.value()), ElementsAre(0, 1, 2));
+  }
+  // All the consumers have been destroyed.
+  EXPECT_EQ(shared.numShared(), 0);
+  EXPECT_FALSE(shared.join(key, nullptr).has_value());
+}
+
+// _____________________________________________________________________________
+TEST(SharedLazyResults, ownerStopsEarly) {
+  SharedLazyResults shared;
+  auto numPulls = std::make_shared<std::atomic<size_t>>(0);
+  auto fallbackPulls = std::make_shared<std::atomic<size_t>>(0);
+  auto fallback = [fallbackPulls]() { return makeSource(3, fallbackPulls); };
+
+  std::optional<Result::LazyResult> started;
+  {
+    auto owner = shared.share(key, makeSource(3, numPulls), 1_MB);
+    started = shared.join(key, fallback);
+    ASSERT_TRUE(started.has_value());
+    EXPECT_THAT(consume(started.value(), 1), ElementsAre(0));
+    EXPECT_THAT(consume(owner, 2), ElementsAre(0, 1));
+  }
+  // The owner has been destroyed before the result was complete. The buffered
+  // chunks can still be read, ...
+  EXPECT_FALSE(shared.join(key, fallback).has_value());
+  EXPECT_THAT(consume(started.value(), 1), ElementsAre(1));
+  // ... but a consumer that has already yielded some chunks can't continue.
+  AD_EXPECT_THROW_WITH_MESSAGE(consume(started.value()),
+                               ::testing::HasSubstr("was stopped before"));
+  EXPECT_EQ(*fallbackPulls, 0);
+
+  // A consumer that hasn't yielded any chunk yet (because the owner has been
+  // destroyed before any chunk was computed) computes the result itself.
+  std::optional<Result::LazyResult> notStarted;
+  {
+    auto owner = shared.share(key, makeSource(3, numPulls), 1_MB);
+    notStarted = shared.join(key, fallback);
+    ASSERT_TRUE(notStarted.has_value());
+  }
+  EXPECT_THAT(consume(notStarted.value()), ElementsAre(0, 1, 2));
+  EXPECT_EQ(*fallbackPulls, 3);
+}
+
+// _____________________________________________________________________________
+TEST(SharedLazyResults, errorInSource) {
+  SharedLazyResults shared;
+  auto failingSource = []() -> Result::LazyResult {
+    return Result::LazyResult{ad_utility::InputRangeFromGetCallable{
+        []() -> std::optional<Result::IdTableVocabPair> {
+          throw std::runtime_error("source failed");
+        }}};
+  };
+  auto fallbackPulls = std::make_shared<std::atomic<size_t>>(0);
+  auto owner = shared.share(key, failingSource(), 1_MB);
+  auto joined = shared.join(key, [fallbackPulls]() {
+    return makeSource(2, fallbackPulls);
+  });
+  ASSERT_TRUE(joined.has_value());
+  // The consumer that is not the owner reads the source first, so the
+  // exception is not propagated to it, but it computes the result itself.
+  EXPECT_THAT(consume(joined.value()), ElementsAre(0, 1));
+  // The owner gets the original exception.
+  AD_EXPECT_THROW_WITH_MESSAGE(consume(owner),
+                               ::testing::HasSubstr("source failed"));
+}
+
+// _____________________________________________________________________________
+TEST(SharedLazyResults, concurrentConsumers) {
+  SharedLazyResults shared;
+  auto numPulls = std::make_shared<std::atomic<size_t>>(0);
+  constexpr int64_t numChunks = 200;
+  std::vector<int64_t> expected(numChunks);
+  std::iota(expected.begin(), expected.end(), 0);
+
+  auto owner = shared.share(key, makeSource(numChunks, numPulls), 1_MB);
+  std::vector<Result::LazyResult> consumers;
+  for (size_t i = 0; i < 4; ++i) {
+    auto joined = shared.join(key, nullptr);
+    ASSERT_TRUE(joined.has_value());
+    consumers.push_back(std::move(joined).value());
+  }
+  std::vector<std::vector<int64_t>> results(consumers.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < consumers.size(); ++i) {
+    threads.emplace_back(
+        [&, i]() { results.at(i) = consume(consumers.at(i)); });
+  }
+  EXPECT_EQ(consume(owner), expected);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& result : results) {
+    EXPECT_EQ(result, expected);
+  }
+  EXPECT_EQ(*numPulls, numChunks);
+}
@@ -1746,6 +1746,93 @@ TEST(SpatialJoin, NumberOfThreads) {
   testNumberOfThreads(hardwareThreads + 5, hardwareThreads);
 }
 
+// _____________________________________________________________________________
+TEST(SpatialJoin, S2IndexQueriesInParallel) {
+  // A dataset with enough points, s.t. the rows are probed in several chunks.
+  std::string kg;
+  for (size_t i = 0; i < 2500; ++i) {
+    kg += absl::StrCat("<p", i, "> <asWKT>",
+                       makePointLiteral(absl::StrCat(7 + (i % 50) * 0.01),
+                                        absl::StrCat(47 + (i / 50) * 0.01)),
+                       " .\n");
+  }
+  auto qec = buildQec(kg);
+
+  auto computeResult = [qec](size_t numThreads) {
+    auto cleanUp = setRuntimeParameterForTest<
+        &RuntimeParameters::spatialJoinMaxNumThreads_>(numThreads);
+    auto leftChild =
+        buildIndexScan(qec, {"?obj1", std::string{"<asWKT>"}, "?geo1"});
+    auto rightChild =
+        buildIndexScan(qec, {"?obj2", std::string{"<asWKT>"}, "?geo2"});
+    SpatialJoinConfiguration config{NearestNeighborsConfig{3},
+                                    Variable{"?geo1"}, Variable{"?geo2"}};
+    config.algo_ = SpatialJoinAlgorithm::S2_GEOMETRY;
+    std::shared_ptr<QueryExecutionTree> spatialJoinOperation =
+        ad_utility::makeExecutionTree<SpatialJoin>(qec, config, leftChild,
+                                                   rightChild);
+    auto spatialJoin = std::dynamic_pointer_cast<SpatialJoin>(
+        spatialJoinOperation->getRootOperation());
+    auto res = spatialJoin->computeResult(false);
+    auto details = spatialJoin->runtimeInfo().details_;
+    EXPECT_TRUE(details.contains("num-threads-for-index-queries"));
+    // There are three chunks of rows.
+    EXPECT_EQ(static_cast<size_t>(details["num-threads-for-index-queries"]),
+              std::min(SpatialJoinAlgorithms::getNumThreads(), size_t{3}));
+    return res.idTable().clone();
+  };
+  auto sequential = computeResult(1);
+  EXPECT_EQ(sequential.numRows(), 2500 * 3);
+  EXPECT_EQ(computeResult(3), sequential);
+  EXPECT_EQ(computeResult(0), sequential);
+}
+
+// _____________________________________________________________________________
+TEST(SpatialJoin, PrefilterIndexScanByLatitude) {
+  // Two points on the left and many points with different latitudes on the
+  // right, which are stored in many small blocks.
+  std::string kg;
+  kg += absl::StrCat("<l1> <left> ", makePointLiteral("7.8", "47.99"), " .\n",
+                     "<l2> <left> ", makePointLiteral("7.8", "48.5"), " .\n");
+  for (int i = 0; i <= 160; ++i) {
+    kg += absl::StrCat("<r", i, "> <right> ",
+                       makePointLiteral("7.8", absl::StrCat(-80 + i)), " .\n");
+  }
+  auto qec = ad_utility::testing::getQec(kg);
+
+  auto computeResult = [qec](bool prefilter, SpatialJoinAlgorithm algorithm) {
+    auto cleanUp = setRuntimeParameterForTest<
+        &RuntimeParameters::spatialJoinPrefilterIndexScans_>(prefilter);
+    auto leftChild =
+        buildIndexScan(qec, {"?obj1", std::string{"<left>"}, "?geo1"});
+    auto rightChild =
+        buildIndexScan(qec, {"?obj2", std::string{"<right>"}, "?geo2"});
+    SpatialJoinConfiguration config{MaxDistanceConfig{100'000},
+                                    Variable{"?geo1"}, Variable{"?geo2"}};
+    config.algo_ = algorithm;
+    std::shared_ptr<QueryExecutionTree> spatialJoinOperation =
+        ad_utility::makeExecutionTree<SpatialJoin>(qec, config, leftChild,
+                                                   rightChild);
+    auto spatialJoin = std::dynamic_pointer_cast<SpatialJoin>(
+        spatialJoinOperation->getRootOperation());
+    auto res = spatialJoin->computeResult(false);
+    EXPECT_EQ(spatialJoin->runtimeInfo().details_.contains(
+                  "prefilter-latitude-range"),
+              prefilter);
+    auto table = res.idTable().clone();
+    ql::ranges::sort(table, ql::ranges::lexicographical_compare);
+    return table;
+  };
+  for (auto algorithm :
+       {SpatialJoinAlgorithm::BASELINE, SpatialJoinAlgorithm::S2_GEOMETRY,
+        SpatialJoinAlgorithm::BOUNDING_BOX}) {
+    auto withoutPrefilter = computeResult(false, algorithm);
+    // The points with latitude 48 and 49 are within 100 km of the left points.
+    EXPECT_EQ(withoutPrefilter.numRows(), 3);
+    EXPECT_EQ(computeResult(true, algorithm), withoutPrefilter);
+  }
+}
+
 }  // namespace runtimeParameters
 
 namespace parsing {
@@ -90,3 +90,30 @@ TEST(StringMapping, flush) {
       mapping.flush(index),
       ::testing::ElementsAre("<a>", "<b>", "\"abc\"", "\"\"", "\"brown\""));
 }
+
+// _____________________________________________________________________________
+TEST(IncrementalStringMapping, add) {
+  using ::testing::ElementsAre;
+  using namespace ad_utility::memory_literals;
+  IncrementalStringMapping mapping{10_B};
+  auto delta = mapping.add({"<a>", "<b>"});
+  EXPECT_FALSE(delta.clearsDictionary_);
+  EXPECT_THAT(delta.newStrings_, ElementsAre("<a>", "<b>"));
+  EXPECT_THAT(delta.indices_, ElementsAre(0, 1));
+
+  // Only the new strings are returned, the others keep their index.
+  delta = mapping.add({"<c>", "<a>"});
+  EXPECT_FALSE(delta.clearsDictionary_);
+  EXPECT_THAT(delta.newStrings_, ElementsAre("<c>"));
+  EXPECT_THAT(delta.indices_, ElementsAre(2, 0));
+  EXPECT_EQ(mapping.size(), 3);
+
+  // The strings have a total size of 14 bytes, which exceeds the maximal
+  // size, so the dictionary is cleared before the next batch.
+  mapping.add({"<ddd>"});
+  delta = mapping.add({"<a>"});
+  EXPECT_TRUE(delta.clearsDictionary_);
+  EXPECT_THAT(delta.newStrings_, ElementsAre("<a>"));
+  EXPECT_THAT(delta.indices_, ElementsAre(0));
+  EXPECT_EQ(mapping.size(), 1);
+}
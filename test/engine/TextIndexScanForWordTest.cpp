@@ -16,6 +16,7 @@
 #include "./TextIndexScanTestHelpers.h"
 #include "engine/IndexScan.h"
 #include "engine/TextIndexScanForWord.h"
+#include "global/RuntimeParameters.h"
 #include "parser/ParsedQuery.h"
 
 using namespace ad_utility::testing;
@@ -385,6 +386,24 @@ TEST(TextIndexScanForWord, WordScanStarPrefix) {
   tr.checkListOfWords(words, startingIndex);
 }
 
+TEST(TextIndexScanForWord, WordScanPrefixConcurrentBlockReads) {
+  auto qec = getQecWithTextIndex();
+
+  // The blocks of a prefix are read concurrently, the result must be the same
+  // as for the sequential reads.
+  auto computeResult = [qec](std::string word, size_t numThreads) {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::textScanNumThreads_>(numThreads);
+    TextIndexScanForWord scan{qec, Variable{"?text1"}, std::move(word)};
+    return scan.computeResultOnlyForTesting().idTable().clone();
+  };
+  for (std::string word : {"*", "a*", "test*"}) {
+    auto sequential = computeResult(word, 1);
+    EXPECT_EQ(computeResult(word, 2), sequential);
+    EXPECT_EQ(computeResult(word, 16), sequential);
+  }
+}
+
 TEST(TextIndexScanForWord, WordScanBasic) {
   auto qec = getQecWithTextIndex();
 
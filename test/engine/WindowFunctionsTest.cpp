@@ -0,0 +1,302 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IdTestHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "engine/QueryPlanner.h"
+#include "engine/Sort.h"
+#include "engine/ValuesForTesting.h"
+#include "engine/WindowFunctions.h"
+#include "parser/SparqlParser.h"
+
+using ::testing::HasSubstr;
+using Function = WindowFunction;
+
+namespace {
+auto V = ad_utility::testing::VocabId;
+auto I = ad_utility::testing::IntId;
+auto D = ad_utility::testing::DoubleId;
+const Id U = Id::makeUndefined();
+using Vars = std::vector<std::optional<Variable>>;
+
+// The configuration with all the functions, partitioned by `?p`, ordered by
+// `?o`, and with the value `?v`.
+WindowFunctionsConfiguration makeConfig() {
+  WindowFunctionsConfiguration config{
+      {Variable{"?p"}}, {Variable{"?o"}}, Variable{"?v"}};
+  config.functions_ = {{Function::ROW_NUMBER, Variable{"?rowNumber"}},
+                       {Function::RANK, Variable{"?rank"}},
+                       {Function::RUNNING_SUM, Variable{"?sum"}},
+                       {Function::RUNNING_COUNT, Variable{"?count"}},
+                       {Function::LAG, Variable{"?lag"}},
+                       {Function::LEAD, Variable{"?lead"}}};
+  return config;
+}
+
+// The rows `(?p, ?o, ?v)` of the input, sorted by `?p` and `?o`.
+IdTable makeInput() {
+  return makeIdTableFromVector({{V(1), V(1), I(10)},
+                                {V(1), V(1), I(20)},
+                                {V(1), V(2), I(5)},
+                                {V(2), V(1), I(7)},
+                                {V(3), V(1), D(1.5)},
+                                {V(3), V(2), V(0)},
+                                {V(3), V(3), I(1)}});
+}
+
+// The result of all the functions of `makeConfig()` for `makeInput()`.
+IdTable makeExpected() {
+  return makeIdTableFromVector(
+      {{V(1), V(1), I(10), I(1), I(1), I(10), I(1), U, I(20)},
+       {V(1), V(1), I(20), I(2), I(1), I(30), I(2), I(10), I(5)},
+       {V(1), V(2), I(5), I(3), I(3), I(35), I(3), I(20), U},
+       {V(2), V(1), I(7), I(1), I(1), I(7), I(1), U, U},
+       {V(3), V(1), D(1.5), I(1), I(1), D(1.5), I(1), U, V(0)},
+       {V(3), V(2), V(0), I(2), I(2), U, I(2), D(1.5), I(1)},
+       {V(3), V(3), I(1), I(3), I(3), U, I(3), V(0), U}});
+}
+
+// A `WindowFunctions` operation for the `blocks` of the input, which are
+// sorted by `?p` and `?o`.
+WindowFunctions makeOperation(WindowFunctionsConfiguration config,
+                              std::vector<IdTable> blocks) {
+  auto qec = ad_utility::testing::getQec();
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(blocks),
+      Vars{Variable{"?p"}, Variable{"?o"}, Variable{"?v"}}, false,
+      std::vector<ColumnIndex>{0, 1});
+  return {qec, std::move(subtree), std::move(config)};
+}
+
+WindowFunctions makeOperation(WindowFunctionsConfiguration config) {
+  std::vector<IdTable> blocks;
+  blocks.push_back(makeInput());
+  return makeOperation(std::move(config), std::move(blocks));
+}
+
+// Compute the `operation` lazily and concatenate the blocks.
+IdTable computeLazily(WindowFunctions& operation) {
+  operation.getExecutionContext()->getQueryTreeCache().clearAll();
+  auto result = operation.computeResultOnlyForTesting(true);
+  EXPECT_FALSE(result.isFullyMaterialized());
+  IdTable table{operation.getResultWidth(),
+                ad_utility::testing::makeAllocator()};
+  for (auto& [idTable, localVocab] : result.idTables()) {
+    EXPECT_FALSE(idTable.empty());
+    table.insertAtEnd(idTable);
+  }
+  return table;
+}
+
+// Parse and plan the `query` and return the columns of `?s`, `?o` and
+// `?result` of its result.
+IdTable runQuery(QueryExecutionContext* qec, const std::string& query) {
+  EncodedIriManager encodedIriManager;
+  auto parsedQuery = SparqlParser::parseQuery(&encodedIriManager, query);
+  QueryPlanner qp{qec, std::make_shared<ad_utility::CancellationHandle<>>()};
+  auto qet = qp.createExecutionTree(parsedQuery);
+  auto result = qet.getResult();
+  std::vector<ColumnIndex> columns;
+  for (std::string_view name : {"?s", "?o", "?result"}) {
+    columns.push_back(qet.getVariableColumn(Variable{std::string{name}}));
+  }
+  IdTable table{columns.size(), ad_utility::testing::makeAllocator()};
+  table.insertAtEnd(result->idTable(), std::nullopt, std::nullopt, columns);
+  return table;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(WindowFunctions, basicMethods) {
+  auto op = makeOperation(makeConfig());
+  EXPECT_EQ(op.getResultWidth(), 9);
+  EXPECT_THAT(op.resultSortedOn(), ::testing::ElementsAre(0, 1));
+  EXPECT_EQ(op.getDescriptor(),
+            "WindowFunctions ROW_NUMBER, RANK, RUNNING_SUM, RUNNING_COUNT, "
+            "LAG, LEAD");
+  EXPECT_FALSE(op.knownEmptyResult());
+  EXPECT_EQ(op.getChildren().size(), 1);
+  EXPECT_THAT(op.getCacheKey(),
+              ::testing::AllOf(HasSubstr("WINDOW FUNCTIONS"),
+                               HasSubstr("key columns: 0 1"),
+                               HasSubstr("value column: 2")));
+  auto columns = op.getExternallyVisibleVariableColumns();
+  EXPECT_EQ(columns.at(Variable{"?rowNumber"}).columnIndex_, 3);
+  EXPECT_EQ(columns.at(Variable{"?lead"}).columnIndex_, 8);
+  using enum ColumnIndexAndTypeInfo::UndefStatus;
+  EXPECT_EQ(columns.at(Variable{"?rank"}).mightContainUndef_, AlwaysDefined);
+  EXPECT_EQ(columns.at(Variable{"?lag"}).mightContainUndef_,
+            PossiblyUndefined);
+
+  // Different offsets have different cache keys.
+  auto config = makeConfig();
+  config.offset_ = 2;
+  EXPECT_NE(makeOperation(config).getCacheKey(), op.getCacheKey());
+
+  // An unsorted input is sorted first.
+  auto qec = ad_utility::testing::getQec();
+  auto unsorted = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeInput(), Vars{Variable{"?p"}, Variable{"?o"}, Variable{"?v"}});
+  config = makeConfig();
+  config.partitionBy_.clear();
+  WindowFunctions withSort{qec, unsorted, config};
+  EXPECT_NE(dynamic_cast<const Sort*>(
+                withSort.getChildren()[0]->getRootOperation().get()),
+            nullptr);
+
+  // Invalid configurations.
+  auto expectError = [](WindowFunctionsConfiguration config,
+                        std::string_view error) {
+    AD_EXPECT_THROW_WITH_MESSAGE(makeOperation(std::move(config)),
+                                 HasSubstr(error));
+  };
+  config = makeConfig();
+  config.orderBy_.push_back(Variable{"?notBound"});
+  expectError(config, "?notBound of the window functions service is not bound");
+  config = makeConfig();
+  config.functions_.emplace_back(Function::RANK, Variable{"?rowNumber"});
+  expectError(config, "?rowNumber for the result of a window function");
+  config = makeConfig();
+  config.functions_.emplace_back(Function::ROW_NUMBER, Variable{"?v"});
+  expectError(config, "?v for the result of a window function");
+  config = makeConfig();
+  config.value_.reset();
+  expectError(config, "RUNNING_SUM requires the parameter <value>");
+  config = makeConfig();
+  config.functions_.clear();
+  expectError(config, "at least one function");
+  config = makeConfig();
+  config.offset_ = 0;
+  expectError(config, "must be positive");
+}
+
+// _____________________________________________________________________________
+TEST(WindowFunctions, computeResult) {
+  auto op = makeOperation(makeConfig());
+  auto result = op.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(), makeExpected());
+
+  // Everything in a single partition, with an offset of 2, and a
+  // `RUNNING_COUNT` that counts the rows.
+  WindowFunctionsConfiguration config{{}, {Variable{"?o"}}, Variable{"?v"}};
+  config.offset_ = 2;
+  config.functions_ = {{Function::LAG, Variable{"?lag"}},
+                       {Function::LEAD, Variable{"?lead"}}};
+  auto qec = ad_utility::testing::getQec();
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{V(1), I(1)}, {V(2), I(2)}, {V(3), I(3)}}),
+      Vars{Variable{"?o"}, Variable{"?v"}}, false, std::vector<ColumnIndex>{0});
+  WindowFunctions singlePartition{qec, subtree, config};
+  result = singlePartition.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(), makeIdTableFromVector({{V(1), I(1), U, I(3)},
+                                                     {V(2), I(2), U, U},
+                                                     {V(3), I(3), I(1), U}}));
+
+  config.value_.reset();
+  config.functions_ = {{Function::RUNNING_COUNT, Variable{"?count"}}};
+  WindowFunctions countRows{qec, subtree, config};
+  result = countRows.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(),
+            makeIdTableFromVector(
+                {{V(1), I(1), I(1)}, {V(2), I(2), I(2)}, {V(3), I(3), I(3)}}));
+}
+
+// _____________________________________________________________________________
+TEST(WindowFunctions, lazyResult) {
+  // The partitions and the `LEAD` values span several blocks.
+  auto input = makeInput();
+  auto split = [&input](std::vector<size_t> boundaries) {
+    std::vector<IdTable> blocks;
+    size_t begin = 0;
+    boundaries.push_back(input.numRows());
+    for (size_t end : boundaries) {
+      IdTable block{input.numColumns(), ad_utility::testing::makeAllocator()};
+      block.insertAtEnd(input, begin, end);
+      blocks.push_back(std::move(block));
+      begin = end;
+    }
+    return blocks;
+  };
+  for (auto boundaries : std::vector<std::vector<size_t>>{
+           {}, {1}, {1, 2, 3}, {2, 2, 5}, {1, 2, 3, 4, 5, 6}}) {
+    auto op = makeOperation(makeConfig(), split(boundaries));
+    EXPECT_EQ(computeLazily(op), makeExpected());
+
+    // Without `LAG` and `LEAD` the blocks are passed through one by one.
+    auto config = makeConfig();
+    config.functions_.erase(config.functions_.begin() + 4,
+                            config.functions_.end());
+    auto withoutLead = makeOperation(config, split(boundaries));
+    IdTable expected{7, ad_utility::testing::makeAllocator()};
+    expected.insertAtEnd(makeExpected(), std::nullopt, std::nullopt,
+                         std::vector<ColumnIndex>{0, 1, 2, 3, 4, 5, 6});
+    EXPECT_EQ(computeLazily(withoutLead), expected);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(WindowFunctions, service) {
+  auto qec = ad_utility::testing::getQec(
+      "<a> <p> 1 . <a> <p> 3 . <b> <p> 2 . <c> <p> 3 . <b> <q> 5 .");
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  auto makeQuery = [](std::string_view parameters) {
+    return absl::StrCat(
+        "SELECT ?s ?o ?result { SERVICE "
+        "<https://qlever.cs.uni-freiburg.de/windowFunctions/> { [] ",
+        parameters, " . { ?s <p> ?o } } }");
+  };
+  auto a = getId("<a>");
+  auto b = getId("<b>");
+  auto c = getId("<c>");
+
+  // The order of the rows with the same `?o` is not specified, so only the
+  // ranks are compared.
+  auto result = runQuery(qec, makeQuery("<orderBy> ?o ; <rank> ?result"));
+  ASSERT_EQ(result.numRows(), 4);
+  EXPECT_THAT(result.getColumn(1),
+              ::testing::ElementsAre(I(1), I(2), I(3), I(3)));
+  EXPECT_THAT(result.getColumn(2),
+              ::testing::ElementsAre(I(1), I(2), I(3), I(3)));
+
+  result = runQuery(qec, makeQuery("<partitionBy> ?s ; <orderBy> ?o ; "
+                                   "<value> ?o ; <runningSum> ?result"));
+  EXPECT_EQ(result, makeIdTableFromVector({{a, I(1), I(1)},
+                                           {a, I(3), I(4)},
+                                           {b, I(2), I(2)},
+                                           {c, I(3), I(3)}}));
+
+  result = runQuery(qec, makeQuery("<orderBy> ?o ; <orderBy> ?s ; "
+                                   "<value> ?s ; <offset> 2 ; <lead> ?result"));
+  EXPECT_EQ(result, makeIdTableFromVector({{a, I(1), a},
+                                           {b, I(2), c},
+                                           {a, I(3), U},
+                                           {c, I(3), U}}));
+
+  // Invalid configurations.
+  auto expectError = [&qec](const std::string& query, std::string_view error) {
+    AD_EXPECT_THROW_WITH_MESSAGE(runQuery(qec, query), HasSubstr(error));
+  };
+  expectError(makeQuery("<orderBy> ?o ; <foo> ?result"),
+              "Unsupported argument <foo>");
+  expectError(makeQuery("<orderBy> ?o ; <offset> 0 ; <lag> ?result"),
+              "expects a positive integer");
+  expectError(makeQuery("<orderBy> <o> ; <rank> ?result"),
+              "has to be a variable");
+  expectError(makeQuery("<orderBy> ?o"), "requires at least one of the");
+  expectError(
+      "SELECT * { SERVICE <https://qlever.cs.uni-freiburg.de/windowFunctions/> "
+      "{ [] <orderBy> ?o ; <rank> ?result . } }",
+      "requires a group graph pattern");
+}
@@ -186,6 +186,28 @@ TEST(CompressedExternalIdTable, sorterRandomInputs) {
   testExternalSorter<0>(NUM_COLS, 0, 1_MB);
 }
 
+// Test that the result of the merge phase is the same for different numbers of
+// merge threads (and therefore groups that are merged in parallel).
+TEST(CompressedExternalIdTable, sorterParallelMerge) {
+  std::string filename = "idTableCompressedSorter.parallelMerge.dat";
+  ad_utility::EXTERNAL_ID_TABLE_SORTER_IGNORE_MEMORY_LIMIT_FOR_TESTING = true;
+  CopyableIdTable<0> randomTable =
+      createRandomlyFilledIdTable(10'000, NUM_COLS);
+  CopyableIdTable<0> expected = randomTable;
+  ql::ranges::sort(expected, SortByOSP{});
+  for (size_t numMergeThreads : {0, 1, 2, 3, 7, 1000}) {
+    ad_utility::CompressedExternalIdTableSorter<SortByOSP, 0> sorter{
+        filename, NUM_COLS, 10_kB, ad_utility::testing::makeAllocator(), 5_kB};
+    sorter.numMergeThreads() = numMergeThreads;
+    for (const auto& row : randomTable) {
+      sorter.push(row);
+    }
+    auto result = idTableFromRowGenerator<0>(sorter.sortedView(), NUM_COLS);
+    EXPECT_THAT(result, ::testing::ElementsAreArray(expected))
+        << "numMergeThreads = " << numMergeThreads;
+  }
+}
+
 // Test that destroying the sorter while an async block-sorting task is still
 // running does not cause a use-after-free (caught by ASAN). This used to be a
 // bug, which was fixed by calling `waitForFuture()` in the destructor of
@@ -0,0 +1,155 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../../util/AllocatorTestHelpers.h"
+#include "../../util/IdTableHelpers.h"
+#include "../../util/IdTestHelpers.h"
+#include "engine/QueryExecutionContext.h"
+#include "engine/idTable/CompressedIdTable.h"
+#include "util/Random.h"
+
+using namespace ad_utility::testing;
+using Encoding = CompressedIdTable::Encoding;
+
+namespace {
+// Create an `IdTable` with a single column from the `ids`.
+IdTable makeColumn(const std::vector<Id>& ids) {
+  IdTable table{1, makeAllocator()};
+  table.resize(ids.size());
+  ql::ranges::copy(ids, table.getColumn(0).begin());
+  return table;
+}
+
+// Compress the `table`, check that it is decompressed correctly, and return
+// the encodings of the blocks.
+std::vector<Encoding> roundTrip(const IdTable& table) {
+  CompressedIdTable compressed{table};
+  EXPECT_EQ(compressed.numRows(), table.numRows());
+  EXPECT_EQ(compressed.numColumns(), table.numColumns());
+  EXPECT_EQ(compressed.decompress(), table);
+  std::vector<Encoding> encodings;
+  for (const auto& block : compressed.blocksForTesting()) {
+    encodings.push_back(block.encoding_);
+  }
+  return encodings;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(CompressedIdTable, chooseEncoding) {
+  using ::testing::ElementsAre;
+  // Sorted, but with large gaps between a few distinct values.
+  std::vector<Id> ids;
+  for (size_t i = 0; i < 1000; ++i) {
+    ids.push_back(VocabId(1'000'000 * (i / 100)));
+  }
+  EXPECT_THAT(roundTrip(makeColumn(ids)), ElementsAre(Encoding::Dictionary));
+
+  // Sorted with small gaps.
+  ids.clear();
+  for (size_t i = 0; i < 1000; ++i) {
+    ids.push_back(VocabId(3 * i));
+  }
+  EXPECT_THAT(roundTrip(makeColumn(ids)), ElementsAre(Encoding::Delta));
+
+  // Unsorted with many distinct values from a small range.
+  ql::ranges::reverse(ids);
+  EXPECT_THAT(roundTrip(makeColumn(ids)),
+              ElementsAre(Encoding::FrameOfReference));
+
+  // Random values of very different datatypes.
+  ids.clear();
+  ad_utility::SlowRandomIntGenerator<int64_t> random{0, int64_t{1} << 40};
+  for (size_t i = 0; i < 1000; ++i) {
+    ids.push_back(i % 2 == 0 ? IntId(random()) : BlankNodeId(random()));
+  }
+  ids.push_back(Id::makeUndefined());
+  EXPECT_THAT(roundTrip(makeColumn(ids)), ElementsAre(Encoding::Raw));
+
+  // A single value.
+  EXPECT_THAT(roundTrip(makeColumn({IntId(42)})), ElementsAre(Encoding::Delta));
+}
+
+// _____________________________________________________________________________
+TEST(CompressedIdTable, multipleBlocksAndColumns) {
+  const size_t numRows = 2 * CompressedIdTable::BLOCK_SIZE + 17;
+  IdTable table{3, makeAllocator()};
+  table.resize(numRows);
+  ad_utility::SlowRandomIntGenerator<int64_t> random{-1000, 1000};
+  for (size_t i = 0; i < numRows; ++i) {
+    table(i, 0) = VocabId(i);
+    table(i, 1) = IntId(random());
+    table(i, 2) = i % 3 == 0 ? Id::makeUndefined() : DoubleId(i % 7);
+  }
+  EXPECT_EQ(roundTrip(table).size(), 9);
+  CompressedIdTable compressed{table};
+  EXPECT_LT(compressed.size(), CacheValue::getSize(table) / 3);
+
+  // Empty tables.
+  EXPECT_TRUE(roundTrip(IdTable{2, makeAllocator()}).empty());
+  EXPECT_TRUE(roundTrip(IdTable{0, makeAllocator()}).empty());
+}
+
+// _____________________________________________________________________________
+TEST(CacheValue, compress) {
+  auto makeResult = []() {
+    std::vector<std::vector<IntOrId>> rows;
+    for (int64_t i = 0; i < 1000; ++i) {
+      rows.push_back({i, i % 5});
+    }
+    return Result{makeIdTableFromVector(rows), {0}, LocalVocab{}};
+  };
+  RuntimeInformation runtimeInfo;
+  CacheValue::SizeGetter sizeGetter;
+
+  // The query that computes the result gets the original, afterward it is
+  // decompressed.
+  {
+    CacheValue value{makeResult(), runtimeInfo};
+    auto uncompressedSize = sizeGetter(value);
+    const Result* original = &value.resultTable();
+    value.compress(true);
+    ASSERT_TRUE(value.isCompressed());
+    EXPECT_TRUE(value.isFullyMaterialized());
+    EXPECT_EQ(value.numRows(), 1000);
+    EXPECT_LT(sizeGetter(value), uncompressedSize);
+    EXPECT_ANY_THROW(value.resultTable());
+
+    auto first = value.resultTablePtr();
+    EXPECT_EQ(first.get(), original);
+    // While the result is still in use, it is not decompressed again.
+    EXPECT_EQ(value.resultTablePtr().get(), original);
+    first.reset();
+
+    auto decompressed = value.resultTablePtr();
+    EXPECT_EQ(decompressed->idTable(), makeResult().idTable());
+    EXPECT_THAT(decompressed->sortedBy(), ::testing::ElementsAre(0));
+    EXPECT_EQ(value.resultTablePtr(), decompressed);
+  }
+
+  // Without keeping the original.
+  {
+    CacheValue value{makeResult(), runtimeInfo};
+    value.compress(false);
+    ASSERT_TRUE(value.isCompressed());
+    EXPECT_EQ(value.resultTablePtr()->idTable(), makeResult().idTable());
+  }
+
+  // Tables that don't become smaller are not compressed.
+  {
+    CacheValue value{
+        Result{makeIdTableFromVector({{3, 4}}), {}, LocalVocab{}}, runtimeInfo};
+    value.compress(true);
+    EXPECT_FALSE(value.isCompressed());
+    EXPECT_EQ(value.numRows(), 1);
+  }
+}
@@ -0,0 +1,188 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+
+#include "../util/GTestHelpers.h"
+#include "index/ColumnCodec.h"
+#include "index/CompressedRelation.h"
+#include "util/BitPacking.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+
+using namespace qlever::columnCodec;
+
+namespace {
+std::vector<Id> makeColumn(const std::vector<uint64_t>& bits) {
+  std::vector<Id> column;
+  for (auto b : bits) {
+    column.push_back(Id::fromBits(b));
+  }
+  return column;
+}
+
+// Compare by the bits, because the random `Id`s might be of type
+// `LocalVocabIndex`, which can't be compared via `operator==`.
+std::vector<uint64_t> getBits(const std::vector<Id>& column) {
+  std::vector<uint64_t> bits;
+  for (auto id : column) {
+    bits.push_back(id.getBits());
+  }
+  return bits;
+}
+
+// Encode the `column` with the `codec`, decode it again, and check that the
+// result is the `column`.
+void testRoundTrip(ColumnCodec codec, const std::vector<Id>& column,
+                   ad_utility::source_location l =
+                       ad_utility::source_location::current()) {
+  auto t = generateLocationTrace(l);
+  auto bytes = encodeWith(codec, column, 3);
+  std::vector<Id> result(column.size());
+  decode(codec, bytes, result);
+  EXPECT_EQ(getBits(result), getBits(column));
+  // A wrong number of rows is detected.
+  std::vector<Id> tooLarge(column.size() + 1);
+  EXPECT_ANY_THROW(decode(codec, bytes, tooLarge));
+}
+
+const std::vector<ColumnCodec> allCodecs{
+    ColumnCodec::Zstd, ColumnCodec::RunLength, ColumnCodec::DeltaBitPacked,
+    ColumnCodec::FrameOfReference};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(BitPacking, packAndUnpack) {
+  for (uint8_t numBits : {0, 1, 3, 17, 63, 64}) {
+    std::vector<uint64_t> values;
+    for (size_t i = 0; i < 100; ++i) {
+      values.push_back((i * 0x9E3779B97F4A7C15) &
+                       ad_utility::bitMaskForLowerBits(numBits));
+    }
+    auto getValue = [&values](size_t i) { return values[i]; };
+    auto packed = ad_utility::bitPack(values.size(), numBits, getValue);
+    EXPECT_EQ(packed.size(),
+              ad_utility::numBitPackedWords(values.size(), numBits));
+    for (size_t i = 0; i < values.size(); ++i) {
+      EXPECT_EQ(ad_utility::bitUnpack(
+                    reinterpret_cast<const char*>(packed.data()), numBits, i),
+                values[i]);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(ColumnCodec, roundTrip) {
+  std::mt19937_64 generator{42};
+  std::vector<std::vector<Id>> columns{
+      makeColumn({42}),
+      makeColumn({0, 0, 0, 0}),
+      makeColumn({1, 2, 3, 7, 7, 8, 1000}),
+      // Decreasing values and the extreme values.
+      makeColumn({1000, 3, 2, 1, 0}),
+      makeColumn({0, std::numeric_limits<uint64_t>::max(), 0,
+                  std::numeric_limits<uint64_t>::max() - 1})};
+  std::vector<uint64_t> random;
+  for (size_t i = 0; i < 1000; ++i) {
+    random.push_back(generator());
+  }
+  columns.push_back(makeColumn(random));
+  for (const auto& column : columns) {
+    for (auto codec : allCodecs) {
+      testRoundTrip(codec, column);
+    }
+  }
+  // Empty columns can be encoded with `Zstd` and `RunLength`.
+  testRoundTrip(ColumnCodec::Zstd, {});
+  testRoundTrip(ColumnCodec::RunLength, {});
+}
+
+// _____________________________________________________________________________
+TEST(ColumnCodec, chooseCodec) {
+  auto chosenCodec = [](const std::vector<Id>& column) {
+    auto [codec, bytes] = encode(column, 3);
+    std::vector<Id> result(column.size());
+    decode(codec, bytes, result);
+    EXPECT_EQ(getBits(result), getBits(column));
+    return codec;
+  };
+  EXPECT_EQ(chosenCodec({}), ColumnCodec::Zstd);
+
+  // A constant column (e.g. the graph column).
+  std::vector<uint64_t> bits(10'000, 17);
+  EXPECT_EQ(chosenCodec(makeColumn(bits)), ColumnCodec::RunLength);
+
+  // A sorted column with small gaps.
+  for (size_t i = 0; i < bits.size(); ++i) {
+    bits[i] = (uint64_t{1} << 60) + 3 * i + i % 2;
+  }
+  EXPECT_EQ(chosenCodec(makeColumn(bits)), ColumnCodec::DeltaBitPacked);
+
+  // An unsorted column with values from a small range.
+  std::mt19937_64 generator{42};
+  for (auto& b : bits) {
+    b = (uint64_t{1} << 60) + generator() % 1000;
+  }
+  EXPECT_EQ(chosenCodec(makeColumn(bits)), ColumnCodec::FrameOfReference);
+
+  // Random values from the full range, interleaved with many repetitions of a
+  // few patterns, are compressed much better by `Zstd`.
+  std::vector<uint64_t> patterns;
+  for (size_t i = 0; i < 4; ++i) {
+    patterns.push_back(generator());
+  }
+  for (size_t i = 0; i < bits.size(); ++i) {
+    bits[i] = patterns[i % patterns.size()];
+  }
+  EXPECT_EQ(chosenCodec(makeColumn(bits)), ColumnCodec::Zstd);
+}
+
+// _____________________________________________________________________________
+TEST(ColumnCodec, serializeOffsetAndCompressedSize) {
+  using O = CompressedBlockMetadata::OffsetAndCompressedSize;
+  using namespace ad_utility::serialization;
+  O original{12, 345, ColumnCodec::DeltaBitPacked};
+  ByteBufferWriteSerializer writer;
+  writer << original;
+  ByteBufferReadSerializer reader{std::move(writer).data()};
+  O read{0, 0};
+  reader >> read;
+  EXPECT_EQ(read, original);
+
+  // Metadata that was written before the codecs were introduced consists of
+  // the plain offset and size, and is read as `Zstd`.
+  ByteBufferWriteSerializer oldWriter;
+  oldWriter << off_t{12};
+  oldWriter << size_t{345};
+  ByteBufferReadSerializer oldReader{std::move(oldWriter).data()};
+  oldReader >> read;
+  EXPECT_EQ(read, (O{12, 345, ColumnCodec::Zstd}));
+
+  // Sizes that overlap with the bits of the codec can't be serialized.
+  ByteBufferWriteSerializer tooLarge;
+  EXPECT_ANY_THROW(tooLarge << O{0, size_t{1} << 56});
+}
+
+// _____________________________________________________________________________
+TEST(ColumnCodec, corruptInput) {
+  auto column = makeColumn({1, 2, 3});
+  std::vector<Id> result(column.size());
+  // Truncated inputs.
+  for (auto codec : {ColumnCodec::RunLength, ColumnCodec::DeltaBitPacked,
+                     ColumnCodec::FrameOfReference}) {
+    auto bytes = encodeWith(codec, column, 3);
+    bytes.pop_back();
+    EXPECT_ANY_THROW(decode(codec, bytes, result));
+  }
+  // A codec from a newer version.
+  EXPECT_ANY_THROW(decode(static_cast<ColumnCodec>(17), {}, result));
+}
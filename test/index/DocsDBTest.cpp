@@ -0,0 +1,97 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "../util/GTestHelpers.h"
+#include "index/DocsDB.h"
+#include "util/File.h"
+
+namespace {
+auto T = [](size_t i) { return TextRecordIndex::make(i); };
+
+// Write the `texts` (with the given record indices) to a `DocsDB` with the
+// given `blockSize`, and open it.
+DocsDB makeDocsDB(const std::string& filename,
+                  const std::vector<std::pair<size_t, std::string>>& texts,
+                  size_t blockSize) {
+  {
+    DocsDB::Writer writer{filename, blockSize};
+    for (const auto& [recordIndex, text] : texts) {
+      writer.push(T(recordIndex), text);
+    }
+  }
+  DocsDB docsDB;
+  docsDB.init(filename);
+  return docsDB;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(DocsDB, writeAndRead) {
+  const std::string filename = "DocsDBTest.writeAndRead.docsDB";
+  // Test a block size that leads to one block per text, one that leads to
+  // several texts per block, and one that leads to a single block.
+  for (size_t blockSize : {1, 10, 1'000'000}) {
+    auto docsDB = makeDocsDB(
+        filename,
+        {{0, "first text"}, {1, "second"}, {4, "fifth text"}, {5, ""},
+         {6, "seventh"}},
+        blockSize);
+    EXPECT_EQ(docsDB.size(), 7);
+    EXPECT_EQ(docsDB.getTextExcerpt(T(0)), "first text");
+    EXPECT_EQ(docsDB.getTextExcerpt(T(1)), "second");
+    EXPECT_EQ(docsDB.getTextExcerpt(T(4)), "fifth text");
+    EXPECT_EQ(docsDB.getTextExcerpt(T(6)), "seventh");
+    // Missing and empty records yield the next nonempty text.
+    EXPECT_EQ(docsDB.getTextExcerpt(T(2)), "fifth text");
+    EXPECT_EQ(docsDB.getTextExcerpt(T(5)), "seventh");
+    EXPECT_ANY_THROW(docsDB.getTextExcerpt(T(7)));
+
+    // The batched retrieval works in any order and with duplicates.
+    std::vector<TextRecordIndex> cids{T(6), T(0), T(4), T(6), T(2), T(1)};
+    EXPECT_THAT(docsDB.getTextExcerpts(cids),
+                ::testing::ElementsAre("seventh", "first text", "fifth text",
+                                       "seventh", "fifth text", "second"));
+    EXPECT_TRUE(docsDB.getTextExcerpts({}).empty());
+  }
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(DocsDB, emptyAndInvalid) {
+  const std::string filename = "DocsDBTest.emptyAndInvalid.docsDB";
+  auto docsDB = makeDocsDB(filename, {}, DocsDB::DEFAULT_BLOCK_SIZE);
+  EXPECT_EQ(docsDB.size(), 0);
+  AD_EXPECT_THROW_WITH_MESSAGE(docsDB.getTextExcerpt(T(0)),
+                               ::testing::HasSubstr("not available"));
+
+  // A file in the old (uncompressed) format is rejected.
+  {
+    ad_utility::File file{filename, "w"};
+    std::string contents = "some text";
+    off_t offsets[] = {0, 9, 9};
+    file.write(contents.data(), contents.size());
+    file.write(offsets, sizeof(offsets));
+  }
+  AD_EXPECT_THROW_WITH_MESSAGE(docsDB.init(filename),
+                               ::testing::HasSubstr("rebuild the text index"));
+
+  // The records have to be added in ascending order.
+  {
+    DocsDB::Writer writer{filename};
+    writer.push(T(3), "text");
+    EXPECT_ANY_THROW(writer.push(T(2), "text"));
+  }
+  ad_utility::deleteFile(filename);
+}
@@ -259,4 +259,140 @@ TEST(EncodedIriManager, HardcodedPrefixesJson) {
   ASSERT_TRUE(id2.has_value());
 }
 
+// _____________________________________________________________________________
+TEST(EncodedIriManager, HexPrefixes) {
+  using V = std::vector<std::string>;
+  EncodedIriManager em{V{"http://example.org/decimal/"},
+                       V{"8:http://example.org/hex/", "13:z"}};
+  auto roundTrip = [&em](std::string_view iri) {
+    auto id = em.encode(iri);
+    ASSERT_TRUE(id.has_value()) << iri;
+    EXPECT_EQ(em.toString(id.value()), iri);
+  };
+  roundTrip("<http://example.org/hex/deadbeef>");
+  roundTrip("<http://example.org/hex/00000000>");
+  roundTrip("<http://example.org/hex/ffffffff>");
+  roundTrip("<z0123456789abc>");
+  roundTrip("<http://example.org/decimal/42>");
+
+  // Wrong width, uppercase or non-hex digits, missing `>`.
+  for (std::string_view iri : {"<http://example.org/hex/deadbee>",
+                                "<http://example.org/hex/deadbeef0>",
+                                "<http://example.org/hex/DEADBEEF>",
+                                "<http://example.org/hex/deadbeeg>",
+                                "<http://example.org/hex/deadbeef"}) {
+    EXPECT_FALSE(em.encode(iri).has_value()) << iri;
+  }
+
+  // The order of the encoded values is the lexical order of the IRIs.
+  std::vector<std::string> iris;
+  for (auto index : getRandomIndices(0, (1ULL << 32) - 1, 1'000)) {
+    iris.push_back(absl::StrCat("<http://example.org/hex/",
+                                absl::Hex(index, absl::kZeroPad8), ">"));
+  }
+  ql::ranges::sort(iris);
+  std::vector<uint64_t> bits;
+  for (const auto& iri : iris) {
+    bits.push_back(em.encode(iri).value().getBits());
+  }
+  EXPECT_TRUE(ql::ranges::is_sorted(bits));
+
+  // Roundtrip via JSON.
+  nlohmann::json j = em;
+  auto em2 = j.get<EncodedIriManager>();
+  EXPECT_EQ(em, em2);
+  auto id = em2.encode("<http://example.org/hex/deadbeef>");
+  ASSERT_TRUE(id.has_value());
+  EXPECT_EQ(em2.toString(id.value()), "<http://example.org/hex/deadbeef>");
+
+  // A JSON without the `hex-widths` (from an older index) only has decimal
+  // prefixes.
+  j.erase(EncodedIriManager::hexWidthsJsonKey_);
+  j[EncodedIriManager::jsonKey_] =
+      std::vector<std::string>{"<http://example.org/"};
+  auto em3 = j.get<EncodedIriManager>();
+  EXPECT_EQ(em3.toString(em3.encode("<http://example.org/123>").value()),
+            "<http://example.org/123>");
+}
+
+// _____________________________________________________________________________
+TEST(EncodedIriManager, illegalHexPrefixes) {
+  using V = std::vector<std::string>;
+  using namespace ::testing;
+  for (const auto& prefix :
+       {"http://example.org/", "0:http://example.org/", "14:h", "x:h", ":h"}) {
+    AD_EXPECT_THROW_WITH_MESSAGE(EncodedIriManager(V{}, V{prefix}),
+                                 HasSubstr("must have the form"));
+  }
+  // The same prefix with decimal and hexadecimal digits is not allowed.
+  AD_EXPECT_THROW_WITH_MESSAGE(EncodedIriManager(V{"blubb"}, V{"4:blubb"}),
+                               HasSubstr("may be a prefix"));
+  AD_EXPECT_THROW_WITH_MESSAGE(EncodedIriManager(V{}, V{"4:blubb", "5:blubb"}),
+                               HasSubstr("may be a prefix"));
+  EXPECT_NO_THROW(EncodedIriManager(V{}, V{"4:blubb", "4:blubb"}));
+  AD_EXPECT_THROW_WITH_MESSAGE(EncodedIriManager(V{}, V{"4:<blubb>"}),
+                               HasSubstr("enclosed in angle brackets"));
+}
+
+// _____________________________________________________________________________
+TEST(EncodedIriManager, ShortLiterals) {
+  using V = std::vector<std::string>;
+  EncodedIriManager em{V{"http://example.org/"}, V{}, true};
+  auto roundTrip = [&em](std::string_view literal) {
+    auto id = em.encode(literal);
+    ASSERT_TRUE(id.has_value()) << literal;
+    EXPECT_TRUE(em.isShortLiteral(id.value()));
+    EXPECT_EQ(em.toString(id.value()), literal);
+  };
+  roundTrip("\"\"");
+  roundTrip("\"a\"");
+  roundTrip("\"DE\"");
+  roundTrip("\"1234567\"");
+  roundTrip("\"a\"b\"");
+
+  // Encoded IRIs are not short literals.
+  auto iri = em.encode("<http://example.org/42>");
+  ASSERT_TRUE(iri.has_value());
+  EXPECT_FALSE(em.isShortLiteral(iri.value()));
+
+  // Too long, language tags, datatypes, and non-ASCII characters.
+  for (std::string_view literal :
+       {"\"12345678\"", "\"de\"@en",
+        "\"1\"^^<http://www.w3.org/2001/XMLSchema#string>", "\"\xc3\xa4\""}) {
+    EXPECT_FALSE(em.encode(literal).has_value()) << literal;
+  }
+
+  // Without the option, no literals are encoded.
+  EncodedIriManager withoutLiterals{V{"http://example.org/"}};
+  EXPECT_FALSE(withoutLiterals.encode("\"a\"").has_value());
+
+  // The order of the encoded values is the lexical order of the literals.
+  std::vector<std::string> literals{"\"\"",  "\"A\"",  "\"AB\"",  "\"Ab\"",
+                                    "\"B\"", "\"a\"",  "\"aa\"",  "\"ab\"",
+                                    "\"abc\"", "\"z\""};
+  ASSERT_TRUE(ql::ranges::is_sorted(literals));
+  std::vector<uint64_t> bits;
+  for (const auto& literal : literals) {
+    bits.push_back(em.encode(literal).value().getBits());
+  }
+  EXPECT_TRUE(ql::ranges::is_sorted(bits));
+
+  // Roundtrip via JSON, also for a JSON from an older index.
+  nlohmann::json j = em;
+  auto em2 = j.get<EncodedIriManager>();
+  EXPECT_EQ(em, em2);
+  EXPECT_EQ(em2.toString(em2.encode("\"DE\"").value()), "\"DE\"");
+  j.erase(EncodedIriManager::inlineShortLiteralsJsonKey_);
+  EXPECT_FALSE(j.get<EncodedIriManager>().encode("\"DE\"").has_value());
+
+  // The tag for the short literals cannot be used for a prefix.
+  V prefixes;
+  for (size_t i = 0; i < EncodedIriManager::maxNumPrefixes_ - 1; ++i) {
+    prefixes.push_back(absl::StrCat("http://example.org/", i, "/"));
+  }
+  EXPECT_NO_THROW(EncodedIriManager(prefixes, V{}, false));
+  AD_EXPECT_THROW_WITH_MESSAGE(EncodedIriManager(prefixes, V{}, true),
+                               ::testing::HasSubstr("too many"));
+}
+
 }  // namespace
@@ -65,6 +65,19 @@ std::vector<std::string> getVocabSuffixesForType(
               ".geometry.words.external.offsets",
               ".geometry.words.internal",
               ".geometry.words.internal.ids"};
+    case OnDiskFrontCoded:
+      return {"", ".blocks"};
+    case OnDiskCompressedLanguageSplit: {
+      std::vector<std::string> suffixes;
+      for (std::string_view partition :
+           {"", ".lang-en", ".lang-de", ".lang-fr", ".lang-es", ".lang-it",
+            ".lang-ru", ".lang-other"}) {
+        for (const auto& suffix : getVocabSuffixesForType(OnDiskCompressed)) {
+          suffixes.push_back(absl::StrCat(partition, suffix));
+        }
+      }
+      return suffixes;
+    }
     default:
       AD_FAIL();
   }
@@ -219,6 +232,30 @@ TEST(IndexRebuilder, remapVocabId) {
   EXPECT_EQ(remapVocabId(V(2), insertionPositionsB), V(4));
 }
 
+// _____________________________________________________________________________
+TEST(IndexRebuilder, VocabIdRemapper) {
+  auto expectSameAsRemapVocabId =
+      [](const InsertionPositions& insertionPositions, uint64_t maxIndex,
+         ad_utility::source_location l = AD_CURRENT_SOURCE_LOC()) {
+        auto trace = generateLocationTrace(l);
+        VocabIdRemapper remapper{insertionPositions};
+        for (uint64_t i = 0; i <= maxIndex; ++i) {
+          EXPECT_EQ(remapper(V(i)), remapVocabId(V(i), insertionPositions))
+              << i;
+        }
+      };
+  auto positions = [](std::vector<uint64_t> indices) {
+    return indices | ql::views::transform(&VocabIndex::make) |
+           ::ranges::to<InsertionPositions>;
+  };
+  expectSameAsRemapVocabId({}, 10);
+  expectSameAsRemapVocabId(positions({3, 5, 7}), 20);
+  expectSameAsRemapVocabId(positions({0, 1}), 5);
+  expectSameAsRemapVocabId(positions({0, 0, 0, 4, 4, 1000}), 1100);
+  expectSameAsRemapVocabId(positions({1023}), 1100);
+  expectSameAsRemapVocabId(positions({17, 17, 18, 500, 501, 502, 999}), 2000);
+}
+
 // _____________________________________________________________________________
 TEST(IndexRebuilder, remapBlankNodeId) {
   std::vector<uint64_t> blankNodeBlocks{4, 42, 77};
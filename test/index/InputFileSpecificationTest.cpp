@@ -7,13 +7,18 @@
 // You may not use this file except in compliance with the Apache 2.0 License,
 // which can be found in the `LICENSE` file at the root of the QLever project.
 
+#include <absl/strings/str_cat.h>
 #include <gmock/gmock.h>
 
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 #include <filesystem>
 #include <fstream>
 
 #include "index/InputFileSpecification.h"
 #include "parser/ParallelBuffer.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
 
 using namespace qlever;
 using namespace testing;
@@ -87,3 +92,71 @@ TEST(InputFileSpecification, GetParallelBufferFactoryBased) {
   EXPECT_EQ(receivedDescription, "my-desc");
   EXPECT_NE(buf, nullptr);
 }
+
+// _____________________________________________________________________________
+TEST(InputFileSpecification, CompressionFromFilename) {
+  EXPECT_EQ(compressionFromFilename("file.nt.gz"), InputCompression::Gzip);
+  EXPECT_EQ(compressionFromFilename("file.ttl.zst"), InputCompression::Zstd);
+  EXPECT_EQ(compressionFromFilename("file.ttl"), InputCompression::None);
+  EXPECT_EQ(compressionFromFilename("/dev/stdin"), InputCompression::None);
+}
+
+// _____________________________________________________________________________
+TEST(InputFileSpecification, GetParallelBufferCompressed) {
+  namespace io = boost::iostreams;
+  std::string content;
+  for (size_t i = 0; i < 1000; ++i) {
+    content += absl::StrCat("<s", i, "> <p> <o> .\n");
+  }
+  // Two concatenated gzip members.
+  auto gzip = [](std::string_view input) {
+    std::string result;
+    io::filtering_ostream stream;
+    stream.push(io::gzip_compressor());
+    stream.push(io::back_inserter(result));
+    stream.write(input.data(), input.size());
+    stream.reset();
+    return result;
+  };
+  std::string_view firstHalf{content.data(), content.size() / 2};
+  std::string_view secondHalf{content.data() + firstHalf.size(),
+                              content.size() - firstHalf.size()};
+  auto gzipped = absl::StrCat(gzip(firstHalf), gzip(secondHalf));
+  // Two concatenated zstd frames.
+  auto zstd = [](std::string_view input) {
+    auto compressed = ZstdWrapper::compress(input.data(), input.size());
+    return std::string{compressed.begin(), compressed.end()};
+  };
+  auto zstded = absl::StrCat(zstd(firstHalf), zstd(secondHalf));
+
+  auto readAll = [](const InputFileSpecification& spec, size_t blocksize) {
+    auto buffer = spec.getParallelBuffer(blocksize);
+    EXPECT_NE(dynamic_cast<ParallelDecompressingBuffer*>(buffer.get()),
+              nullptr);
+    std::string result;
+    while (auto block = buffer->getNextBlock()) {
+      result.append(block->begin(), block->end());
+    }
+    return result;
+  };
+  for (auto [filename, compressed, compression] :
+       {std::tuple{"qlever_ifs_test.nt.gz", gzipped, InputCompression::Gzip},
+        std::tuple{"qlever_ifs_test.nt.zst", zstded,
+                   InputCompression::Zstd}}) {
+    std::filesystem::path tmpFile =
+        std::filesystem::temp_directory_path() / filename;
+    std::ofstream{tmpFile, std::ios::binary} << compressed;
+    InputFileSpecification spec{tmpFile.string(), Filetype::Turtle,
+                                std::nullopt};
+    spec.compression_ = compression;
+    for (size_t blocksize : {16, 1000, 1'000'000}) {
+      EXPECT_EQ(readAll(spec, blocksize), content);
+    }
+
+    // Truncated input leads to an exception.
+    std::ofstream{tmpFile, std::ios::binary | std::ios::trunc}
+        << compressed.substr(0, compressed.size() - 5);
+    EXPECT_ANY_THROW(readAll(spec, 1000));
+    std::filesystem::remove(tmpFile);
+  }
+}
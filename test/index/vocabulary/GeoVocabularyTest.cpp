@@ -179,6 +179,37 @@ TEST(GeoVocabularyTest, InvalidGeometryInfoVersion) {
           "0, which is incompatible"));
 }
 
+// _____________________________________________________________________________
+TEST(GeoVocabularyTest, TruncatedGeometryInfoFile) {
+  const std::string lit =
+      "\"LINESTRING(1 1, 2 2, 3 3)\""
+      "^^<http://www.opengis.net/ont/geosparql#wktLiteral>";
+  const std::string fn = "GeoVocabularyTruncatedGeoInfo.dat";
+  {
+    AnyGeoVocab geoVocab;
+    auto wordWriter = geoVocab.makeDiskWriterPtr(fn);
+    (*wordWriter)(lit, true);
+    (*wordWriter)(lit, true);
+    wordWriter->finish();
+  }
+
+  // Overwrite the geoinfo file with a valid header, but only one record.
+  AnyGeoVocab geoVocab;
+  geoVocab.open(fn);
+  ASSERT_TRUE(geoVocab.getGeoInfo(1).has_value());
+  auto record = geoVocab.getGeoInfo(0).value();
+  geoVocab.close();
+  ad_utility::File geoInfoFile{AnyGeoVocab::getGeoInfoFilename(fn), "w"};
+  geoInfoFile.write(&GEOMETRY_INFO_VERSION, sizeof(GEOMETRY_INFO_VERSION));
+  geoInfoFile.write(&record, sizeof(record));
+  geoInfoFile.close();
+
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      geoVocab.open(fn),
+      ::testing::HasSubstr("GeoVocabularyTruncatedGeoInfo.dat.geoinfo has a "
+                           "size of"));
+}
+
 // _____________________________________________________________________________
 TEST(GeoVocabularyTest, WordWriterDestructor) {
   const std::string lit =
@@ -16,6 +16,7 @@ namespace splitVocabTestHelpers {
 using SGV =
     SplitGeoVocabulary<CompressedVocabulary<VocabularyInternalExternal>>;
 using VocabOnSGV = Vocabulary<SGV, TripleComponentComparator, VocabIndex>;
+using SLV = SplitLanguageVocabulary<VocabularyInMemory>;
 
 [[maybe_unused]] auto testSplitTwoFunction = [](std::string_view s) -> uint8_t {
   return ql::starts_with(s, "\"a");
@@ -60,6 +61,8 @@ using namespace splitVocabTestHelpers;
 using namespace ad_utility;
 const VocabularyType geoSplitVocabType{
     VocabularyType::Enum::OnDiskCompressedGeoSplit};
+const VocabularyType languageSplitVocabType{
+    VocabularyType::Enum::OnDiskCompressedLanguageSplit};
 
 // _____________________________________________________________________________
 TEST(Vocabulary, SplitGeoVocab) {
@@ -424,6 +427,70 @@ TEST(Vocabulary, SplitVocabularyWordWriterAndGetPosition) {
   ASSERT_EQ(u7, VocabIndex::make(4));
 }
 
+// _____________________________________________________________________________
+TEST(Vocabulary, SplitLanguageVocab) {
+  // Literals with one of the `LANGUAGE_SPLIT_TAGS` get their own vocabulary,
+  // all other language tags share the last one.
+  ASSERT_EQ(SLV::numberOfVocabs, 8);
+  ASSERT_EQ(SLV::getMarkerForWord("\"a\"@en"), 1);
+  ASSERT_EQ(SLV::getMarkerForWord("\"a\"@de"), 2);
+  ASSERT_EQ(SLV::getMarkerForWord("\"a\"@ru"), 6);
+  ASSERT_EQ(SLV::getMarkerForWord("\"a\"@nl"), 7);
+  ASSERT_EQ(SLV::getMarkerForWord("\"a\"@en-GB"), 7);
+  ASSERT_EQ(SLV::getMarkerForWord("\"a@en\"@fr"), 3);
+
+  // Everything else stays in the main vocabulary.
+  ASSERT_EQ(SLV::getMarkerForWord(""), 0);
+  ASSERT_EQ(SLV::getMarkerForWord("\"a\""), 0);
+  ASSERT_EQ(SLV::getMarkerForWord("\"a\"@"), 0);
+  ASSERT_EQ(SLV::getMarkerForWord("\"a@en\""), 0);
+  ASSERT_EQ(SLV::getMarkerForWord("<http://example.com/@en>"), 0);
+  ASSERT_EQ(SLV::getMarkerForWord("\"x\"^^<http://example.com/@en>"), 0);
+
+  // The main vocabulary has no language partitions.
+  RdfsVocabulary vocabulary;
+  vocabulary.resetToType(geoSplitVocabType);
+  ASSERT_FALSE(vocabulary.getIndexRangesForLanguageTag("en").has_value());
+
+  vocabulary.resetToType(languageSplitVocabType);
+  ASSERT_FALSE(vocabulary.isGeoInfoAvailable());
+  auto wordCallback = vocabulary.makeWordWriterPtr("vocTestLanguageSplit.dat");
+  ASSERT_EQ((*wordCallback)("\"a\"", true), 0);
+  ASSERT_EQ((*wordCallback)("\"a\"@de", true), SLV::addMarker(0, 2));
+  ASSERT_EQ((*wordCallback)("\"a\"@en", true), SLV::addMarker(0, 1));
+  ASSERT_EQ((*wordCallback)("\"a\"@nl", true), SLV::addMarker(0, 7));
+  ASSERT_EQ((*wordCallback)("\"b\"", true), 1);
+  ASSERT_EQ((*wordCallback)("\"b\"@en", true), SLV::addMarker(1, 1));
+  ASSERT_EQ((*wordCallback)("\"b\"@pt", true), SLV::addMarker(1, 7));
+  wordCallback->finish();
+  vocabulary.readFromFile("vocTestLanguageSplit.dat");
+
+  VocabIndex idx;
+  ASSERT_TRUE(vocabulary.getId("\"b\"@en", &idx));
+  ASSERT_EQ(idx.get(), SLV::addMarker(1, 1));
+  ASSERT_EQ(vocabulary[idx], "\"b\"@en");
+
+  using Ranges = std::vector<std::pair<VocabIndex, VocabIndex>>;
+  auto range = [](uint64_t begin, uint64_t end, uint8_t marker) {
+    return std::pair{VocabIndex::make(SLV::addMarker(begin, marker)),
+                     VocabIndex::make(SLV::addMarker(end, marker))};
+  };
+  // The literals without a language tag are not partitioned.
+  ASSERT_FALSE(vocabulary.getIndexRangesForLanguageTag("").has_value());
+  ASSERT_EQ(vocabulary.getIndexRangesForLanguageTag("en"),
+            (Ranges{range(0, 2, 1)}));
+  ASSERT_EQ(vocabulary.getIndexRangesForLanguageTag("de"),
+            (Ranges{range(0, 1, 2)}));
+  ASSERT_EQ(vocabulary.getIndexRangesForLanguageTag("fr"),
+            (Ranges{range(0, 0, 3)}));
+  ASSERT_EQ(vocabulary.getIndexRangesForLanguageTag("nl"),
+            (Ranges{range(0, 2, 7)}));
+  ASSERT_EQ(vocabulary.getIndexRangesForLanguageTag("*"),
+            (Ranges{range(0, 2, 1), range(0, 1, 2), range(0, 0, 3),
+                    range(0, 0, 4), range(0, 0, 5), range(0, 0, 6),
+                    range(0, 2, 7)}));
+}
+
 // _____________________________________________________________________________
 TEST(Vocabulary, SplitVocabularyWordWriterDestructor) {
   // Create a `SplitVocabulary::WordWriter` and destruct it without a call to
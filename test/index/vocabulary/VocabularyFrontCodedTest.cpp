@@ -0,0 +1,136 @@
+// Copyright 2026 The QLever Authors, in particular:
+//
+// 2026 Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>, UFR
+//
+// UFR = University of Freiburg, Chair of Algorithms and Data Structures
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/strings/str_cat.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "./VocabularyTestHelpers.h"
+#include "backports/algorithm.h"
+#include "index/vocabulary/VocabularyFrontCoded.h"
+#include "util/File.h"
+#include "util/Forward.h"
+
+namespace {
+using namespace vocabulary_test;
+
+// Store a `VocabularyFrontCoded` and read it back from file. For each instance
+// of `VocabularyCreator` that exists at the same time, a different filename
+// has to be chosen.
+class VocabularyCreator {
+ private:
+  std::string vocabFilename_;
+  uint64_t wordsPerBlock_;
+
+ public:
+  explicit VocabularyCreator(std::string filename, uint64_t wordsPerBlock)
+      : vocabFilename_{std::move(filename)}, wordsPerBlock_{wordsPerBlock} {}
+  ~VocabularyCreator() {
+    ad_utility::deleteFile(vocabFilename_, false);
+    ad_utility::deleteFile(vocabFilename_ + ".blocks", false);
+  }
+
+  // Create and return a `VocabularyFrontCoded` from words. The ids will be
+  // [0, .. words.size()).
+  auto createVocabulary(const std::vector<std::string>& words) {
+    {
+      VocabularyFrontCoded::WordWriter writer{vocabFilename_, wordsPerBlock_};
+      for (size_t i = 0; i < words.size(); ++i) {
+        EXPECT_EQ(writer(words[i], false), i);
+      }
+    }
+    VocabularyFrontCoded vocabulary;
+    vocabulary.open(vocabFilename_);
+    return vocabulary;
+  }
+};
+
+// Run the `testFunction` on a creator with very small blocks (s.t. the tests
+// cover many block boundaries) and on a creator with the default block size.
+template <typename F>
+void testWithDifferentBlockSizes(const std::string& filename, F testFunction) {
+  for (uint64_t wordsPerBlock :
+       {uint64_t{1}, uint64_t{3},
+        uint64_t{VocabularyFrontCoded::DEFAULT_WORDS_PER_BLOCK}}) {
+    testFunction([c = VocabularyCreator{filename, wordsPerBlock}](
+                     auto&&... args) mutable {
+      return c.createVocabulary(AD_FWD(args)...);
+    });
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(VocabularyFrontCoded, LowerUpperBoundStdLess) {
+  testWithDifferentBlockSizes("frontCodedLowerUpperBoundStdLess",
+                              [](auto creator) {
+                                testUpperAndLowerBoundWithStdLess(creator);
+                              });
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyFrontCoded, LowerUpperBoundNumeric) {
+  testWithDifferentBlockSizes(
+      "frontCodedLowerUpperBoundNumeric", [](auto creator) {
+        testUpperAndLowerBoundWithNumericComparator(creator);
+      });
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyFrontCoded, AccessOperator) {
+  testWithDifferentBlockSizes("frontCodedAccessOperator", [](auto creator) {
+    testAccessOperatorForUnorderedVocabulary(creator);
+  });
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyFrontCoded, LookupMany) {
+  testWithDifferentBlockSizes("frontCodedLookupMany", [](auto creator) {
+    testLookupManyForUnorderedVocabulary(creator);
+  });
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyFrontCoded, EmptyVocabulary) {
+  testWithDifferentBlockSizes("frontCodedEmptyVocabulary", [](auto creator) {
+    testEmptyVocabulary(creator);
+  });
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyFrontCoded, CompressionAndAlignment) {
+  // Words with long common prefixes (like IRIs of the same namespace) are
+  // stored much more compactly than uncompressed.
+  std::vector<std::string> words;
+  size_t totalSize = 0;
+  for (size_t i = 0; i < 1000; ++i) {
+    words.push_back(absl::StrCat("<http://www.example.org/entity/Q", 100000 + i,
+                                 ">"));
+    totalSize += words.back().size();
+  }
+  ql::ranges::sort(words);
+  std::string filename = "frontCodedCompressionAndAlignment";
+  VocabularyCreator creator{filename, 16};
+  auto vocabulary = creator.createVocabulary(words);
+  ASSERT_EQ(vocabulary.size(), words.size());
+  for (size_t i = 0; i < words.size(); ++i) {
+    EXPECT_EQ(vocabulary[i], words[i]);
+  }
+  auto payloadSize = std::filesystem::file_size(filename);
+  EXPECT_LT(payloadSize, totalSize / 2);
+  // All the blocks are padded to the alignment.
+  EXPECT_EQ(payloadSize % VocabularyFrontCoded::BLOCK_ALIGNMENT, 0);
+
+  // An exact match at and after a block boundary.
+  EXPECT_EQ(vocabulary.lower_bound(words[16], std::less<>{}).index(), 16);
+  EXPECT_EQ(vocabulary.lower_bound(words[17], std::less<>{}).index(), 17);
+  EXPECT_EQ(vocabulary.upper_bound(words[15], std::less<>{}).index(), 16);
+  EXPECT_TRUE(vocabulary.upper_bound(words.back(), std::less<>{}).isEnd());
+}
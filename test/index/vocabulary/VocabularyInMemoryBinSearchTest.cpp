@@ -138,3 +138,18 @@ TEST(VocabularyInMemoryBinSearch, ErrorOnNonAscendingIds) {
 TEST(VocabularyInMemoryBinSearch, EmptyVocabulary) {
   testEmptyVocabulary(createVocabulary("EmptyVocabulary"));
 }
+
+// _____________________________________________________________________________
+TEST(VocabularyInMemoryBinSearch, GetIndexOfExactWord) {
+  std::vector<std::string> words{"alpha", "beta", "delta", "gamma"};
+  std::vector<uint64_t> ids{2, 4, 17, 42};
+  VocabularyCreator creator{"GetIndexOfExactWord"};
+  auto vocab = creator.createVocabularyImpl(words, ids);
+  for (size_t i = 0; i < words.size(); ++i) {
+    EXPECT_EQ(vocab.getIndexOfExactWord(words[i]), ids[i]);
+  }
+  EXPECT_EQ(vocab.getIndexOfExactWord("alph"), std::nullopt);
+  EXPECT_EQ(vocab.getIndexOfExactWord(""), std::nullopt);
+  vocab.close();
+  EXPECT_EQ(vocab.getIndexOfExactWord("alpha"), std::nullopt);
+}
@@ -115,4 +115,42 @@ TEST(VocabularyInMemory, WordWriterDestructorBehavior) {
   ad_utility::deleteFile(filename);
 }
 
+// _____________________________________________________________________________
+TEST(VocabularyInMemory, GetPositionOfWord) {
+  std::vector<std::string> words;
+  for (size_t i = 0; i < 1000; ++i) {
+    words.push_back(absl::StrCat("<iri", 1000 + i, ">"));
+  }
+  auto comparator = std::less<>{};
+  auto checkPositions = [&words, &comparator](const Vocab& vocab) {
+    for (size_t i = 0; i < words.size(); ++i) {
+      EXPECT_EQ(vocab.getPositionOfWord(words[i], comparator),
+                (std::pair<uint64_t, uint64_t>{i, i + 1}));
+    }
+    // Words that are not contained have an empty range at the position where
+    // they would be inserted.
+    using P = std::pair<uint64_t, uint64_t>;
+    EXPECT_EQ(vocab.getPositionOfWord("<iri1000>x", comparator), (P{1, 1}));
+    EXPECT_EQ(vocab.getPositionOfWord("<a>", comparator), (P{0, 0}));
+    EXPECT_EQ(vocab.getPositionOfWord("<z>", comparator), (P{1000, 1000}));
+  };
+  checkPositions(createVocabulary(words));
+  Vocab::Words compactWords;
+  compactWords.build(words);
+  checkPositions(Vocab{std::move(compactWords)});
+
+  // The index is rebuilt after reading with a serializer.
+  ad_utility::serialization::ByteBufferWriteSerializer writeSerializer;
+  writeSerializer | createVocabulary(words);
+  Vocab readVocab;
+  ad_utility::serialization::ByteBufferReadSerializer readSerializer{
+      writeSerializer.data()};
+  readSerializer | readVocab;
+  checkPositions(readVocab);
+
+  readVocab.close();
+  EXPECT_EQ(readVocab.getPositionOfWord(words[0], comparator),
+            (std::pair<uint64_t, uint64_t>{0, 0}));
+}
+
 }  // namespace
@@ -111,6 +111,11 @@ TEST(VocabularyInternalExternal, AccessOperator) {
       createVocabularyFromDisk("AccessOperator2"));
 }
 
+TEST(VocabularyInternalExternal, LookupMany) {
+  testLookupManyForUnorderedVocabulary(createVocabulary("LookupMany1"));
+  testLookupManyForUnorderedVocabulary(createVocabularyFromDisk("LookupMany2"));
+}
+
 TEST(VocabularyInternalExternal, EmptyVocabulary) {
   testEmptyVocabulary(createVocabulary("EmptyVocabulary"));
 }
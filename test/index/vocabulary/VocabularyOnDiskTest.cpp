@@ -75,6 +75,10 @@ TEST(VocabularyOnDisk, AccessOperator) {
   testAccessOperatorForUnorderedVocabulary(createVocabulary("AccessOperator"));
 }
 
+TEST(VocabularyOnDisk, LookupMany) {
+  testLookupManyForUnorderedVocabulary(createVocabulary("LookupMany"));
+}
+
 TEST(VocabularyOnDisk, AccessOperatorWithNonContiguousIds) {
   std::vector<std::string> words{"game",  "4",      "nobody", "33",
                                  "alpha", "\n\1\t", "222",    "1111"};
@@ -7,6 +7,8 @@
 
 #include <gmock/gmock.h>
 
+#include <numeric>
+
 #include "../../util/GTestHelpers.h"
 #include "index/vocabulary/VocabularyTypes.h"
 #include "util/Exception.h"
@@ -269,6 +271,44 @@ auto testEmptyVocabulary(F createVocabulary) {
   testEmptyVocabularyWithComparator(createVocabulary, std::greater<>{});
 }
 
+// Check that the bulk lookups `ad_utility::vocabulary::lookupSorted` and
+// `ad_utility::vocabulary::lookupMany` return the same words as `operator[]`
+// for a vocabulary created via `createVocabulary(std::vector<std::string>)`.
+template <typename F>
+auto testLookupManyForUnorderedVocabulary(F createVocabulary) {
+  // Words of different sizes, including a word that is larger than the chunks
+  // in which the `VocabularyOnDisk` reads the words.
+  std::vector<std::string> words;
+  for (size_t i = 0; i < 300; ++i) {
+    words.push_back(std::string(i % 7, 'a') + std::to_string(i));
+  }
+  words[150] = std::string(100'000, 'x');
+  auto vocabulary = createVocabulary(words);
+  ASSERT_EQ(vocabulary.size(), words.size());
+
+  auto expectedWords = [&words](const std::vector<uint64_t>& indices) {
+    std::vector<std::string> result;
+    for (uint64_t index : indices) {
+      result.push_back(words[index]);
+    }
+    return result;
+  };
+  using namespace ad_utility::vocabulary;
+  // Sorted indices with small and large gaps, and with duplicates.
+  std::vector<uint64_t> sorted{0, 1, 1, 5, 100, 149, 150, 151, 250, 299};
+  EXPECT_EQ(lookupSorted(vocabulary, ql::span<const uint64_t>{sorted}),
+            expectedWords(sorted));
+  std::vector<uint64_t> all(words.size());
+  std::iota(all.begin(), all.end(), 0);
+  EXPECT_EQ(lookupSorted(vocabulary, ql::span<const uint64_t>{all}), words);
+
+  // Unsorted indices with duplicates are returned in the original order.
+  std::vector<uint64_t> unsorted{299, 3, 150, 3, 0, 298, 42, 299};
+  EXPECT_EQ(lookupMany(vocabulary, ql::span<const uint64_t>{unsorted}),
+            expectedWords(unsorted));
+  EXPECT_TRUE(lookupMany(vocabulary, ql::span<const uint64_t>{}).empty());
+}
+
 }  // namespace vocabulary_test
 
 #endif  // QLEVER_VOCABULARYTESTHELPERS_H
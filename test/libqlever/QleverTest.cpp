@@ -4,14 +4,19 @@
 //
 // UFR = University of Freiburg, Chair of Algorithms and Data Structures
 
+#include <absl/strings/str_cat.h>
 #include <gmock/gmock.h>
 
+#include <filesystem>
+
 #include "../util/GTestHelpers.h"
 #include "../util/IdTableHelpers.h"
 #include "../util/IndexTestHelpers.h"
 #include "../util/RuntimeParametersTestHelpers.h"
 #include "engine/ExternalValues.h"
 #include "libqlever/Qlever.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeString.h"
 
 using namespace qlever;
 using namespace testing;
@@ -233,6 +238,75 @@ TEST(LibQlever, loadIndexWithoutPermutations) {
       HasSubstr("permutation to be loaded"));
 }
 
+// _____________________________________________________________________________
+TEST(LibQlever, lazyLoadPermutations) {
+  std::string filename = "libQleverLazyLoadPermutations.ttl";
+  {
+    auto ofs = ad_utility::makeOfstream(filename);
+    ofs << "<s> <p> <o>. <s> <p2> \"literal\". <s2> <p> <o>.";
+  }
+
+  IndexBuilderConfig c;
+  c.inputFiles_.push_back({filename, Filetype::Turtle, std::nullopt});
+  c.baseName_ = "LibQlever.lazyLoadPermutations";
+  c.memoryLimit_ = std::nullopt;
+  EXPECT_NO_THROW(Qlever::buildIndex(c));
+
+  EngineConfig ec{c};
+  ec.lazyLoadPermutations_ = true;
+  Qlever engine{ec};
+  // The lazily loaded permutations count as loaded.
+  EXPECT_TRUE(engine.index().hasAllPermutations());
+
+  // These queries require the SPO or SOP and the OPS or OSP permutation.
+  EXPECT_EQ(engine.query("SELECT ?p ?o WHERE { <s> ?p ?o } ORDER BY ?p",
+                         ad_utility::MediaType::tsv),
+            "?p\t?o\n<p>\t<o>\n<p2>\t\"literal\"\n");
+  EXPECT_EQ(engine.query("SELECT ?s ?p WHERE { ?s ?p <o> } ORDER BY ?s",
+                         ad_utility::MediaType::tsv),
+            "?s\t?p\n<s>\t<p>\n<s2>\t<p>\n");
+  EXPECT_THAT(engine.query("SELECT (COUNT(*) AS ?c) WHERE { ?s ?p ?o }",
+                           ad_utility::MediaType::tsv),
+              HasSubstr("\n3"));
+}
+
+// _____________________________________________________________________________
+TEST(LibQlever, sharedResources) {
+  // Build two different indices.
+  auto buildIndex = [](const std::string& name, const std::string& triples) {
+    std::string filename = absl::StrCat("libQlever", name, ".ttl");
+    {
+      auto ofs = ad_utility::makeOfstream(filename);
+      ofs << triples;
+    }
+    IndexBuilderConfig c;
+    c.inputFiles_.push_back({filename, Filetype::Turtle, std::nullopt});
+    c.baseName_ = absl::StrCat("LibQlever.", name);
+    c.memoryLimit_ = std::nullopt;
+    EXPECT_NO_THROW(Qlever::buildIndex(c));
+    return EngineConfig{c};
+  };
+  auto config1 = buildIndex("sharedResources1", "<s> <p> <o1>.");
+  auto config2 = buildIndex("sharedResources2", "<s> <p> <o2>.");
+
+  auto resources =
+      Qlever::makeSharedResources(ad_utility::MemorySize::gigabytes(1));
+  Qlever engine1{config1, resources};
+  Qlever engine2{config2, resources};
+  EXPECT_EQ(&engine1.cache(), &engine2.cache());
+  // Both engines share the same memory limit.
+  EXPECT_TRUE(engine1.allocator() == engine2.allocator());
+
+  // The same query yields the result for the respective index, although both
+  // results are stored in the same cache.
+  engine1.cache().clearAll();
+  std::string query = "SELECT ?o WHERE { <s> <p> ?o }";
+  EXPECT_EQ(engine1.query(query, ad_utility::MediaType::tsv), "?o\n<o1>\n");
+  EXPECT_EQ(engine2.query(query, ad_utility::MediaType::tsv), "?o\n<o2>\n");
+  EXPECT_EQ(engine1.query(query, ad_utility::MediaType::tsv), "?o\n<o1>\n");
+  EXPECT_GE(resources.cache_->numNonPinnedEntries(), 2);
+}
+
 // _____________________________________________________________________________
 TEST(LibQlever, disableCaching) {
   std::string filename = "libQleverDisableCaching.ttl";
@@ -292,6 +366,66 @@ TEST(LibQlever, disableCaching) {
   }
 }
 
+// _____________________________________________________________________________
+TEST(LibQlever, persistNamedResults) {
+  std::string filename = "libQleverPersistNamedResults.ttl";
+  {
+    auto ofs = ad_utility::makeOfstream(filename);
+    ofs << "<s> <p> <o>. <s2> <p> <o2>.";
+  }
+  IndexBuilderConfig c;
+  c.inputFiles_.push_back({filename, Filetype::Turtle, std::nullopt});
+  c.baseName_ = "LibQlever.persistNamedResults";
+  EXPECT_NO_THROW(Qlever::buildIndex(c));
+  std::string snapshotFile = c.baseName_ + ".named-results";
+  std::filesystem::remove(snapshotFile);
+
+  EngineConfig ec{c};
+  ec.persistNamedResults_ = true;
+  std::string serviceQuery =
+      "SELECT ?s WHERE { SERVICE ql:cached-result-with-name-pin1 {}}";
+  auto notPinned =
+      ::testing::HasSubstr("is not contained in the named result cache");
+  {
+    Qlever engine{ec};
+    engine.queryAndPinResultWithName("pin1", "SELECT ?s { ?s <p> <o> }");
+    EXPECT_TRUE(std::filesystem::exists(snapshotFile));
+  }
+
+  // The pinned result is restored after a restart.
+  {
+    Qlever engine{ec};
+    EXPECT_EQ(engine.namedResultCache().numEntries(), 1);
+    EXPECT_EQ(engine.query(serviceQuery, ad_utility::MediaType::tsv),
+              "?s\n<s>\n");
+    engine.eraseResultWithName("pin1");
+  }
+  {
+    Qlever engine{ec};
+    AD_EXPECT_THROW_WITH_MESSAGE(engine.query(serviceQuery), notPinned);
+    engine.queryAndPinResultWithName("pin1", "SELECT ?s { ?s <p> <o> }");
+  }
+
+  // Without the option, the named results are not restored.
+  {
+    EngineConfig withoutPersistence{c};
+    Qlever engine{withoutPersistence};
+    EXPECT_EQ(engine.namedResultCache().numEntries(), 0);
+  }
+
+  // A snapshot that was written for a different index is ignored.
+  {
+    ad_utility::serialization::FileWriteSerializer serializer{snapshotFile};
+    serializer << std::string{"a different index id"};
+  }
+  {
+    Qlever engine{ec};
+    EXPECT_EQ(engine.namedResultCache().numEntries(), 0);
+    AD_EXPECT_THROW_WITH_MESSAGE(engine.query(serviceQuery), notPinned);
+  }
+  std::filesystem::remove(snapshotFile);
+}
+
 // _____________________________________________________________________________
 TEST(LibQlever, externallySpecifiedValues) {
   std::string filename = "libQleverExternalValues.ttl";
@@ -306,7 +440,8 @@ TEST(LibQlever, externallySpecifiedValues) {
   EXPECT_NO_THROW(Qlever::buildIndex(c));
 
   EngineConfig ec{c};
-  // Caching must be disabled for externally specified values.
+  // Without caching, the cache keys don't have to be updated after the values
+  // have been changed (see `QueryExecutionTree::updateCacheKeysRecursively`).
   ec.disableCaching_ = QueryExecutionContext::DisableCaching::True;
   Qlever engine{ec};
 
@@ -363,3 +498,191 @@ TEST(LibQlever, externallySpecifiedValues) {
     EXPECT_THAT(res->idTable(), matchesIdTable(expected));
   }
 }
+
+// _____________________________________________________________________________
+TEST(LibQlever, preparedQuery) {
+  std::string filename = "libQleverPreparedQuery.ttl";
+  {
+    auto ofs = ad_utility::makeOfstream(filename);
+    ofs << "<s1> <p> 1 . <s2> <p> 2 . <s3> <p> 3 . <s3> <q> 4 .";
+  }
+
+  IndexBuilderConfig c;
+  c.inputFiles_.push_back({filename, Filetype::Turtle, std::nullopt});
+  c.baseName_ = "testIndexForPreparedQuery";
+  EXPECT_NO_THROW(Qlever::buildIndex(c));
+  // The caching is enabled, the results for different values must still be
+  // different.
+  Qlever engine{EngineConfig{c}};
+
+  using TC = TripleComponent;
+  auto iri = [](std::string_view s) { return TC{TC::Iri::fromIriref(s)}; };
+  auto prepared = engine.prepare("SELECT ?o { ?x <p> ?o } ORDER BY ?o",
+                                 {Variable{"?x"}});
+  EXPECT_THAT(prepared.parameters(), ElementsAre(Variable{"?x"}));
+
+  auto getResult = [&engine, &prepared](
+                       std::vector<std::vector<TripleComponent>> values) {
+    auto plan = engine.bind(prepared, std::move(values));
+    auto& [qet, qec, parsedQuery] = plan;
+    EXPECT_FALSE(qec->disableCaching());
+    return qet->getResult()->idTable().clone();
+  };
+  auto i = &Id::makeFromInt;
+  EXPECT_THAT(getResult({{iri("<s1>")}}),
+              matchesIdTable(makeIdTableFromVector({{i(1)}})));
+  EXPECT_THAT(getResult({{iri("<s3>")}, {iri("<s2>")}}),
+              matchesIdTable(makeIdTableFromVector({{i(2)}, {i(3)}})));
+  EXPECT_EQ(getResult({{iri("<s4>")}}).numRows(), 0);
+  EXPECT_EQ(getResult({}).numRows(), 0);
+  EXPECT_THAT(getResult({{iri("<s1>")}}),
+              matchesIdTable(makeIdTableFromVector({{i(1)}})));
+
+  // For values that were already bound before, the result is read from the
+  // cache.
+  {
+    auto plan = engine.bind(prepared, {{iri("<s3>")}, {iri("<s2>")}});
+    auto& qet = std::get<0>(plan);
+    qet->getResult();
+    EXPECT_EQ(qet->getRootOperation()->runtimeInfo().cacheStatus_,
+              ad_utility::CacheStatus::cachedNotPinned);
+  }
+
+  // The result can also be exported.
+  auto result = engine.query(engine.bind(prepared, {{iri("<s2>")}}),
+                             ad_utility::MediaType::csv);
+  EXPECT_THAT(result, AllOf(HasSubstr("2"), Not(HasSubstr("3"))));
+
+  // Wrong number of values in a row.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      engine.bind(prepared, {{iri("<s1>"), iri("<s2>")}}),
+      HasSubstr("must contain 1 values"));
+  // Parameters that are not visible in the query body.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      engine.prepare("SELECT ?o { ?x <p> ?o }", {Variable{"?y"}}),
+      HasSubstr("not visible"));
+  AD_EXPECT_THROW_WITH_MESSAGE(engine.prepare("SELECT ?o { ?x <p> ?o }", {}),
+                               HasSubstr("at least one parameter"));
+}
+
+// _____________________________________________________________________________
+TEST(LibQlever, queryIdTables) {
+  std::string filename = "libQleverQueryIdTables.ttl";
+  {
+    auto ofs = ad_utility::makeOfstream(filename);
+    ofs << "<s1> <p> 1 . <s2> <p> 2.5 . "
+           "<s3> <p> \"2020-01-01\"^^<http://www.w3.org/2001/XMLSchema#date> . "
+           "<s4> <p> <o> . <s5> <p> \"lit\" .";
+  }
+
+  IndexBuilderConfig c;
+  c.inputFiles_.push_back({filename, Filetype::Turtle, std::nullopt});
+  c.baseName_ = "testIndexForQueryIdTables";
+  EXPECT_NO_THROW(Qlever::buildIndex(c));
+  Qlever engine{EngineConfig{c}};
+
+  // The LIMIT and OFFSET are applied, and the columns are in the order of the
+  // selected variables.
+  auto result = engine.queryIdTables(
+      "SELECT ?o ?s { ?s <p> ?o } ORDER BY ?s LIMIT 4 OFFSET 1");
+  EXPECT_THAT(result.variables(), ElementsAre(Variable{"?o"}, Variable{"?s"}));
+  std::vector<std::optional<int64_t>> ints;
+  std::vector<std::optional<double>> doubles;
+  std::vector<std::optional<DateYearOrDuration>> dates;
+  std::vector<std::optional<std::string>> strings;
+  std::vector<std::optional<std::string>> subjects;
+  auto append = [](auto& target, auto values) {
+    target.insert(target.end(), values.begin(), values.end());
+  };
+  for (const auto& block : result.blocks()) {
+    ASSERT_EQ(block.idTable_.numColumns(), 2);
+    append(ints, result.decodeInts(block, 0));
+    append(doubles, result.decodeDoubles(block, 0));
+    append(dates, result.decodeDates(block, 0));
+    append(strings, result.decodeStrings(block, 0));
+    append(subjects, result.decodeStrings(block, 1));
+  }
+  EXPECT_THAT(subjects, ElementsAre("<s2>", "<s3>", "<s4>", "<s5>"));
+  EXPECT_THAT(ints, ElementsAre(std::nullopt, std::nullopt, std::nullopt,
+                                std::nullopt));
+  EXPECT_THAT(doubles,
+              ElementsAre(2.5, std::nullopt, std::nullopt, std::nullopt));
+  EXPECT_THAT(dates, ElementsAre(std::nullopt,
+                                 DateYearOrDuration{Date{2020, 1, 1}},
+                                 std::nullopt, std::nullopt));
+  EXPECT_THAT(strings, ElementsAre("2.5", Optional(HasSubstr("2020-01-01")),
+                                   "<o>", "\"lit\""));
+
+  // Integers can also be decoded as doubles.
+  auto intResult = engine.queryIdTables("SELECT ?o { <s1> <p> ?o }");
+  for (const auto& block : intResult.blocks()) {
+    EXPECT_THAT(intResult.decodeInts(block, 0), ElementsAre(1));
+    EXPECT_THAT(intResult.decodeDoubles(block, 0), ElementsAre(1.0));
+  }
+
+  // The iteration can be cancelled.
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  auto cancelledResult = engine.queryIdTables(
+      engine.parseAndPlanQuery("SELECT ?s { ?s <p> ?o }"), handle);
+  handle->cancel(ad_utility::CancellationState::MANUAL);
+  EXPECT_THROW(
+      {
+        for ([[maybe_unused]] const auto& block : cancelledResult.blocks()) {
+        }
+      },
+      ad_utility::CancellationException);
+
+  AD_EXPECT_THROW_WITH_MESSAGE(engine.queryIdTables("ASK { ?s <p> ?o }"),
+                               HasSubstr("Only the results of SELECT"));
+}
+
+// _____________________________________________________________________________
+TEST(LibQlever, queryAsync) {
+  std::string filename = "libQleverQueryAsync.ttl";
+  {
+    auto ofs = ad_utility::makeOfstream(filename);
+    ofs << "<s1> <p> 1 . <s2> <p> 2 . <s3> <p> 3 .";
+  }
+
+  IndexBuilderConfig c;
+  c.inputFiles_.push_back({filename, Filetype::Turtle, std::nullopt});
+  c.baseName_ = "testIndexForQueryAsync";
+  EXPECT_NO_THROW(Qlever::buildIndex(c));
+  EngineConfig engineConfig{c};
+  engineConfig.numThreadsForAsyncQueries_ = 2;
+  Qlever engine{engineConfig};
+
+  // Several queries (more than there are threads) are executed concurrently.
+  AsyncQueryOptions csv{ad_utility::MediaType::csv};
+  std::vector<std::future<std::string>> futures;
+  for (int i = 1; i <= 5; ++i) {
+    futures.push_back(engine.queryAsync(
+        absl::StrCat("SELECT ?s { ?s <p> ", i % 3 + 1, " }"), csv));
+  }
+  for (int i = 1; i <= 5; ++i) {
+    EXPECT_THAT(futures[i - 1].get(), HasSubstr(absl::StrCat("s", i % 3 + 1)));
+  }
+
+  // A query that has already been planned, with a timeout that is not
+  // exceeded.
+  auto plan = engine.parseAndPlanQuery("SELECT ?s { ?s <p> 2 }");
+  AsyncQueryOptions withTimeout{ad_utility::MediaType::csv,
+                                std::chrono::minutes{1}};
+  EXPECT_THAT(engine.queryAsync(std::move(plan), withTimeout).get(),
+              AllOf(HasSubstr("s2"), Not(HasSubstr("s3"))));
+
+  // Manual cancellation, the exception is rethrown by the future.
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  handle->cancel(ad_utility::CancellationState::MANUAL);
+  auto cancelled = engine.queryAsync("SELECT ?s { ?s <p> ?o }",
+                                     {csv.mediaType_, std::nullopt, handle});
+  EXPECT_THROW(cancelled.get(), ad_utility::CancellationException);
+
+  // The same for the synchronous `query` function.
+  EXPECT_THROW(engine.query(engine.parseAndPlanQuery("SELECT ?s { ?s ?p ?o }"),
+                            ad_utility::MediaType::csv, handle),
+               ad_utility::CancellationException);
+
+  // Errors during the parsing are also reported by the future.
+  EXPECT_ANY_THROW(engine.queryAsync("SELECT nonsense").get());
+}
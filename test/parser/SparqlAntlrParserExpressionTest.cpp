@@ -9,6 +9,7 @@
 #include "../util/RuntimeParametersTestHelpers.h"
 #include "../util/TripleComponentTestHelpers.h"
 #include "./SparqlAntlrParserTestHelpers.h"
+#include "engine/sparqlExpressions/ApproxCountDistinctExpression.h"
 #include "engine/sparqlExpressions/BlankNodeExpression.h"
 #include "engine/sparqlExpressions/CountStarExpression.h"
 #include "engine/sparqlExpressions/GroupConcatExpression.h"
@@ -343,6 +344,8 @@ TEST(SparqlParser, FunctionCall) {
                      matchUnary(&makeEnvelopeLowerLeftExpression));
   expectFunctionCall(absl::StrCat(ql, "envelopeUpperRight>(?x)"),
                      matchUnary(&makeEnvelopeUpperRightExpression));
+  expectFunctionCall(absl::StrCat(ql, "approxCountDistinct>(?x)"),
+                     matchUnary(&makeApproxCountDistinctExpression));
   expectFunctionCall(
       absl::StrCat(ql,
                    "prefix-match>(?x, \"Prefix\""
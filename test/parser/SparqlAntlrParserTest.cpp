@@ -1780,3 +1780,44 @@ TEST(SparqlParser, EncodedIriManagerUsage) {
                 {{{encoded123, unencoded456, encoded789}}}))));
   }
 }
+
+// _____________________________________________________________________________
+TEST(SparqlParser, sllPredictionWithLlFallback) {
+  auto parse = [](const std::string& input, bool trySllPredictionFirst) {
+    static ad_utility::BlankNodeManager blankNodeManager;
+    ParserAndVisitor p{&blankNodeManager, encodedIriManager(), input};
+    p.trySllPredictionFirst_ = trySllPredictionFirst;
+    return std::move(p.parseTypesafe(&SparqlAutomaticParser::query)
+                         .resultOfParse_);
+  };
+
+  // The results with and without the `SLL` stage are the same.
+  std::string query =
+      "PREFIX ex: <http://example.org/> SELECT ?x ?y WHERE { ?x ex:p ?y . "
+      "OPTIONAL { ?y ex:q ?z } FILTER(?y > 3) VALUES ?x { ex:a ex:b } } "
+      "ORDER BY DESC(?y) LIMIT 10 OFFSET 5";
+  auto withSll = parse(query, true);
+  auto withoutSll = parse(query, false);
+  EXPECT_EQ(withSll.selectClause().getSelectedVariables(),
+            withoutSll.selectClause().getSelectedVariables());
+  EXPECT_EQ(withSll._limitOffset, withoutSll._limitOffset);
+  EXPECT_EQ(withSll._limitOffset._limit, 10);
+  EXPECT_EQ(withSll._limitOffset._offset, 5);
+  EXPECT_EQ(withSll._orderBy.size(), 1);
+  EXPECT_EQ(withSll.children().size(), withoutSll.children().size());
+
+  // Syntax errors are reported with the same message, regardless of whether
+  // the `SLL` stage was tried first.
+  std::string invalid = "SELECT ?x WHERE { ?x <p> }";
+  auto getMessage = [&](bool trySllPredictionFirst) -> std::string {
+    try {
+      parse(invalid, trySllPredictionFirst);
+    } catch (const InvalidSparqlQueryException& e) {
+      return e.what();
+    }
+    return "";
+  };
+  auto messageWithSll = getMessage(true);
+  EXPECT_FALSE(messageWithSll.empty());
+  EXPECT_EQ(messageWithSll, getMessage(false));
+}
@@ -53,6 +53,7 @@ std::vector<std::string> getAllIndexFilenames(
           indexBasename + ".index.osp",
           indexBasename + ".index.osp.meta",
           indexBasename + ".index.patterns",
+          indexBasename + ".index.predicate-statistics",
           indexBasename + ".meta-data.json",
           indexBasename + ".prefixes",
           indexBasename + ".vocabulary.internal",
@@ -220,6 +221,8 @@ Index makeTestIndex(const std::string& indexBasename, TestIndexConfig c) {
     index.setSettingsFile(inputFilename + ".settings.json");
     index.loadAllPermutations() = c.loadAllPermutations;
     index.addHasWordTriples() = c.addHasWordTriples;
+    index.getImpl().setWritePermutationPairsConcurrently(
+        c.writePermutationPairsConcurrently);
     qlever::InputFileSpecification spec{inputFilename, c.indexType,
                                         std::nullopt};
     // randomly choose one of the vocabulary implementations
@@ -72,6 +72,9 @@ struct TestIndexConfig {
   // If true, add `ql:has-word` triples for each word in each literal during
   // index building.
   bool addHasWordTriples = false;
+  // If true, the OSP/OPS and PSO/POS permutations are written concurrently
+  // (only relevant without patterns).
+  bool writePermutationPairsConcurrently = false;
 
   // A very typical use case is to only specify the turtle input, and leave all
   // the other members as the default. We therefore have a dedicated constructor
@@ -88,14 +91,16 @@ struct TestIndexConfig {
         c.usePrefixCompression, c.blocksizePermutations, c.createTextIndex,
         c.addWordsFromLiterals, c.contentsOfWordsFileAndDocsfile,
         c.parserBufferSize, c.scoringMetric, c.bAndKParam, c.indexType,
-        c.encodedPrefixesWithoutAngleBrackets, c.addHasWordTriples);
+        c.encodedPrefixesWithoutAngleBrackets, c.addHasWordTriples,
+        c.writePermutationPairsConcurrently);
   }
   QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(
       TestIndexConfig, turtleInput, loadAllPermutations, usePatterns,
       usePrefixCompression, blocksizePermutations, createTextIndex,
       addWordsFromLiterals, contentsOfWordsFileAndDocsfile, parserBufferSize,
       scoringMetric, bAndKParam, indexType, vocabularyType,
-      encodedPrefixesWithoutAngleBrackets, addHasWordTriples)
+      encodedPrefixesWithoutAngleBrackets, addHasWordTriples,
+      writePermutationPairsConcurrently)
 };
 
 // Create a test index at the given `indexBasename` and with the given `config`.